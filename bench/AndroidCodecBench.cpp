@@ -12,12 +12,17 @@
 #include "SkCommandLineFlags.h"
 #include "SkOSFile.h"
 
-AndroidCodecBench::AndroidCodecBench(SkString baseName, SkData* encoded, int sampleSize)
+AndroidCodecBench::AndroidCodecBench(SkString baseName, SkData* encoded, int sampleSize,
+                                     bool boxFilter)
     : fData(SkRef(encoded))
     , fSampleSize(sampleSize)
+    , fBoxFilter(boxFilter)
 {
     // Parse filename and the color type to give the benchmark a useful name
     fName.printf("AndroidCodec_%s_SampleSize%d", baseName.c_str(), sampleSize);
+    if (boxFilter) {
+        fName.append("_box");
+    }
 }
 
 const char* AndroidCodecBench::onGetName() {
@@ -45,6 +50,7 @@ void AndroidCodecBench::onDraw(int n, SkCanvas* canvas) {
     std::unique_ptr<SkAndroidCodec> codec;
     SkAndroidCodec::AndroidOptions options;
     options.fSampleSize = fSampleSize;
+    options.fBoxFilter = fBoxFilter;
     for (int i = 0; i < n; i++) {
         codec = SkAndroidCodec::MakeFromData(fData);
 #ifdef SK_DEBUG
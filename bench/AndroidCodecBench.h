@@ -21,7 +21,7 @@
 class AndroidCodecBench : public Benchmark {
 public:
     // Calls encoded->ref()
-    AndroidCodecBench(SkString basename, SkData* encoded, int sampleSize);
+    AndroidCodecBench(SkString basename, SkData* encoded, int sampleSize, bool boxFilter = false);
 
 protected:
     const char* onGetName() override;
@@ -33,6 +33,7 @@ private:
     SkString                fName;
     sk_sp<SkData>           fData;
     const int               fSampleSize;
+    const bool              fBoxFilter;
     SkImageInfo             fInfo;          // Set in onDelayedSetup.
     SkAutoMalloc            fPixelStorage;  // Set in onDelayedSetup.
     typedef Benchmark INHERITED;
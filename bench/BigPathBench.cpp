@@ -84,3 +84,38 @@ DEF_BENCH( return new BigPathBench(kRight_Align,    false); )
 DEF_BENCH( return new BigPathBench(kLeft_Align,     true); )
 DEF_BENCH( return new BigPathBench(kMiddle_Align,   true); )
 DEF_BENCH( return new BigPathBench(kRight_Align,    true); )
+
+// The same path, filled, so that path renderers that only fill (e.g. --pr skc) can be compared
+// against the ones that tessellate or count coverage (--pr tess, --pr ccpr).
+class BigPathFillBench : public Benchmark {
+    SkPath fPath;
+
+protected:
+    const char* onGetName() override {
+        return "bigpath_fill";
+    }
+
+    SkIPoint onGetSize() override {
+        return SkIPoint::Make(640, 100);
+    }
+
+    void onDelayedSetup() override {
+        sk_tool_utils::make_big_path(fPath);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        this->setupPaint(&paint);
+
+        canvas->translate(-fPath.getBounds().left(), 0);
+        for (int i = 0; i < loops; i++) {
+            canvas->drawPath(fPath, paint);
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new BigPathFillBench(); )
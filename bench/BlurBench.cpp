@@ -7,6 +7,8 @@
 #include "Benchmark.h"
 #include "SkBlurMask.h"
 #include "SkCanvas.h"
+#include "SkExecutor.h"
+#include "SkMaskBlurFilter.h"
 #include "SkMaskFilter.h"
 #include "SkPaint.h"
 #include "SkRandom.h"
@@ -18,6 +20,7 @@
 #define REAL    0.5f
 #define BIG     SkIntToScalar(10)
 #define REALBIG 100.5f
+#define GIANT   SkIntToScalar(200)
 // The value that produces a sigma of just over 2.
 #define CUTOVER 2.6f
 
@@ -31,12 +34,16 @@ static const char* gStyleName[] = {
 class BlurBench : public Benchmark {
     SkScalar    fRadius;
     SkBlurStyle fStyle;
+    int         fThreads;
     SkString    fName;
+    std::unique_ptr<SkExecutor> fExecutor;
 
 public:
-    BlurBench(SkScalar rad, SkBlurStyle bs) {
+    // With threads > 0, large CPU blurs run on a pool of that many threads.
+    BlurBench(SkScalar rad, SkBlurStyle bs, int threads = 0) {
         fRadius = rad;
         fStyle = bs;
+        fThreads = threads;
         const char* name = rad > 0 ? gStyleName[bs] : "none";
         const char* quality = "high_quality";
         if (SkScalarFraction(rad) != 0) {
@@ -44,6 +51,9 @@ public:
         } else {
             fName.printf("blur_%d_%s_%s", SkScalarRoundToInt(rad), name, quality);
         }
+        if (threads > 0) {
+            fName.appendf("_%dthreads", threads);
+        }
     }
 
 protected:
@@ -51,6 +61,20 @@ protected:
         return fName.c_str();
     }
 
+    void onDelayedSetup() override {
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        gSkMaskBlurExecutor = fExecutor.get();
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        gSkMaskBlurExecutor = nullptr;
+    }
+
     void onDraw(int loops, SkCanvas* canvas) override {
         SkPaint paint;
         this->setupPaint(&paint);
@@ -95,6 +119,15 @@ DEF_BENCH(return new BlurBench(REALBIG, kSolid_SkBlurStyle);)
 DEF_BENCH(return new BlurBench(REALBIG, kOuter_SkBlurStyle);)
 DEF_BENCH(return new BlurBench(REALBIG, kInner_SkBlurStyle);)
 
+DEF_BENCH(return new BlurBench(REALBIG, kNormal_SkBlurStyle, 2);)
+DEF_BENCH(return new BlurBench(REALBIG, kNormal_SkBlurStyle, 4);)
+DEF_BENCH(return new BlurBench(REALBIG, kNormal_SkBlurStyle, 8);)
+
+DEF_BENCH(return new BlurBench(GIANT, kNormal_SkBlurStyle);)
+DEF_BENCH(return new BlurBench(GIANT, kNormal_SkBlurStyle, 2);)
+DEF_BENCH(return new BlurBench(GIANT, kNormal_SkBlurStyle, 4);)
+DEF_BENCH(return new BlurBench(GIANT, kNormal_SkBlurStyle, 8);)
+
 DEF_BENCH(return new BlurBench(REAL, kNormal_SkBlurStyle);)
 DEF_BENCH(return new BlurBench(REAL, kSolid_SkBlurStyle);)
 DEF_BENCH(return new BlurBench(REAL, kOuter_SkBlurStyle);)
@@ -7,6 +7,8 @@
 
 #include "Benchmark.h"
 #include "SkCanvas.h"
+#include "SkExecutor.h"
+#include "SkMaskBlurFilter.h"
 #include "SkMaskFilter.h"
 #include "SkPaint.h"
 #include "SkPath.h"
@@ -72,9 +74,51 @@ private:
     typedef BlurRectsBench INHERITED;
 };
 
+// A large ring, with an inner rect too small for the nine-patch path, so the whole mask is blurred.
+// The CPU blur runs serially or on a pool of threads.
+class BlurRectsLargeBench: public BlurRectsBench {
+public:
+    BlurRectsLargeBench(int threads)
+        : INHERITED(SkRect::MakeXYWH(50, 50, 900, 700), SkRect::MakeXYWH(450, 350, 100, 100), 40)
+        , fThreads(threads) {
+        SkString name("blurrectslarge");
+        if (threads > 0) {
+            name.appendf("_%dthreads", threads);
+        }
+        this->setName(name);
+    }
+
+    SkIPoint onGetSize() override { return SkIPoint::Make(1000, 800); }
+
+    void onDelayedSetup() override {
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        gSkMaskBlurExecutor = fExecutor.get();
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        gSkMaskBlurExecutor = nullptr;
+    }
+
+private:
+    int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+    typedef BlurRectsBench INHERITED;
+};
+
 DEF_BENCH(return new BlurRectsNinePatchBench(SkRect::MakeXYWH(10, 10, 100, 100),
                                              SkRect::MakeXYWH(20, 20, 60, 60),
                                              2.3f);)
 DEF_BENCH(return new BlurRectsNonNinePatchBench(SkRect::MakeXYWH(10, 10, 100, 100),
                                                 SkRect::MakeXYWH(50, 50, 10, 10),
                                                 4.3f);)
+
+DEF_BENCH(return new BlurRectsLargeBench(0);)
+DEF_BENCH(return new BlurRectsLargeBench(2);)
+DEF_BENCH(return new BlurRectsLargeBench(4);)
+DEF_BENCH(return new BlurRectsLargeBench(8);)
@@ -86,3 +86,5 @@ DEF_BENCH(return new BlurRoundRectBench(100, 100, 6);)
 // Other radii options
 DEF_BENCH(return new BlurRoundRectBench(100, 100, 30);)
 DEF_BENCH(return new BlurRoundRectBench(100, 100, 90);)
+// No corners, so this is drawn as a blurred rect from the shared blur profile
+DEF_BENCH(return new BlurRoundRectBench(100, 100, 0);)
@@ -6,13 +6,17 @@
 */
 
 #include "Benchmark.h"
+#include "SkArenaAlloc.h"
 #include "SkColor.h"
 #include "SkColorSpaceXformer.h"
 #include "SkColorSpaceXformSteps.h"
 #include "SkMakeUnique.h"
 #include "SkRandom.h"
+#include "SkRasterPipeline.h"
 
-enum class Mode { steps, xformer };
+#include <functional>
+
+enum class Mode { steps, xformer, pipeline, pipeline_lut };
 
 struct ColorSpaceXformBench : public Benchmark {
     ColorSpaceXformBench(Mode mode) : fMode(mode) {}
@@ -22,10 +26,22 @@ struct ColorSpaceXformBench : public Benchmark {
     std::unique_ptr<SkColorSpaceXformSteps>  fSteps;
     std::unique_ptr<SkColorSpaceXformer>     fXformer;
 
+    // The pipeline modes convert a row of 8-bit Adobe RGB pixels to sRGB.
+    static constexpr int kPixels = 1024;
+    std::unique_ptr<SkColorSpaceXformSteps>  fRowSteps;
+    SkSTArenaAlloc<256>                      fAlloc;
+    std::function<void(size_t, size_t, size_t, size_t)> fRun;
+    uint32_t                   fSrcPixels[kPixels],
+                               fDstPixels[kPixels];
+    SkRasterPipeline_MemoryCtx fSrcCtx = { fSrcPixels, 0 },
+                               fDstCtx = { fDstPixels, 0 };
+
     const char* onGetName() override {
         switch (fMode) {
-            case Mode::steps  : return "ColorSpaceXformBench_steps";
-            case Mode::xformer: return "ColorSpaceXformBench_xformer";
+            case Mode::steps       : return "ColorSpaceXformBench_steps";
+            case Mode::xformer     : return "ColorSpaceXformBench_xformer";
+            case Mode::pipeline    : return "ColorSpaceXformBench_pipeline";
+            case Mode::pipeline_lut: return "ColorSpaceXformBench_pipeline_lut";
         }
         return "";
     }
@@ -40,9 +56,35 @@ struct ColorSpaceXformBench : public Benchmark {
         fSteps = skstd::make_unique<SkColorSpaceXformSteps>(src.get(), kOpaque_SkAlphaType,
                                                             dst.get(), kPremul_SkAlphaType);
         fXformer = SkColorSpaceXformer::Make(dst);  // src is implicitly sRGB, what we want anyway
+
+        sk_sp<SkColorSpace> adobe = SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2,
+                                                          SkNamedGamut::kAdobeRGB);
+        fRowSteps = skstd::make_unique<SkColorSpaceXformSteps>(adobe.get(), kOpaque_SkAlphaType,
+                                                               src.get(), kOpaque_SkAlphaType);
+        SkRandom rand;
+        for (uint32_t& pixel : fSrcPixels) {
+            pixel = rand.nextU() | 0xff000000;
+        }
+
+        SkRasterPipeline p(&fAlloc);
+        p.append(SkRasterPipeline::load_8888, &fSrcCtx);
+        if (fMode == Mode::pipeline_lut) {
+            fRowSteps->apply(&p, kRGBA_8888_SkColorType, &fAlloc);
+        } else {
+            fRowSteps->apply(&p, kRGBA_8888_SkColorType);
+        }
+        p.append(SkRasterPipeline::store_8888, &fDstCtx);
+        fRun = p.compile();
     }
 
     void onDraw(int n, SkCanvas* canvas) override {
+        if (fMode == Mode::pipeline || fMode == Mode::pipeline_lut) {
+            for (int i = 0; i < n; i++) {
+                fRun(0,0, kPixels,1);
+            }
+            return;
+        }
+
         volatile SkColor junk = 0;
         SkRandom rand;
 
@@ -59,6 +101,10 @@ struct ColorSpaceXformBench : public Benchmark {
                 case Mode::xformer: {
                     dst = fXformer->apply(src);
                 } break;
+
+                default: {
+                    dst = src;
+                } break;
             }
 
             if (false && i == 0) {
@@ -72,3 +118,5 @@ struct ColorSpaceXformBench : public Benchmark {
 
 DEF_BENCH(return new ColorSpaceXformBench{Mode::steps  };)
 DEF_BENCH(return new ColorSpaceXformBench{Mode::xformer};)
+DEF_BENCH(return new ColorSpaceXformBench{Mode::pipeline};)
+DEF_BENCH(return new ColorSpaceXformBench{Mode::pipeline_lut};)
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkCanvas.h"
+#include "SkFont.h"
+#include "SkImage.h"
+#include "SkPicture.h"
+#include "SkPictureRecorder.h"
+#include "SkString.h"
+#include "SkSurface.h"
+#include "sk_tool_utils.h"
+
+#include <thread>
+#include <vector>
+
+// Runs the same work on N threads at once, to catch contention in the shared caches (the strike
+// cache, the resource cache, the typeface cache...). Each loop does one unit of work on every
+// thread, so with perfect scaling the time per loop doesn't depend on the thread count. The
+// scaling efficiency at N threads is time(contention_<work>_1) / time(contention_<work>_N).
+class ContentionBench : public Benchmark {
+public:
+    static constexpr int kMaxThreads = 32;
+
+    ContentionBench(const char* work, int threads) : fThreads(threads) {
+        SkASSERT(threads >= 1 && threads <= kMaxThreads);
+        fName.printf("contention_%s_%d", work, threads);
+    }
+
+protected:
+    static constexpr int kSize = 256;
+
+    // Does one unit of work on 'canvas', which belongs to the calling thread.
+    virtual void work(int thread, SkCanvas* canvas) = 0;
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i < fThreads; ++i) {
+            fSurfaces[i] = SkSurface::MakeRasterN32Premul(kSize, kSize);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < fThreads; ++i) {
+            threads.emplace_back([this, i, loops] {
+                SkCanvas* canvas = fSurfaces[i]->getCanvas();
+                for (int loop = 0; loop < loops; ++loop) {
+                    this->work(i, canvas);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+private:
+    SkString         fName;
+    int              fThreads;
+    sk_sp<SkSurface> fSurfaces[kMaxThreads];
+
+    typedef Benchmark INHERITED;
+};
+
+// Text raster: every thread looks up glyphs in the strike cache for the same typefaces.
+class ContentionTextBench : public ContentionBench {
+public:
+    explicit ContentionTextBench(int threads) : INHERITED("text", threads) {}
+
+protected:
+    void onDelayedSetup() override {
+        INHERITED::onDelayedSetup();
+        fTypefaces[0] = sk_tool_utils::create_portable_typeface("serif", SkFontStyle());
+        fTypefaces[1] = sk_tool_utils::create_portable_typeface("sans-serif", SkFontStyle());
+    }
+
+    void work(int thread, SkCanvas* canvas) override {
+        static const char kText[] = "The quick brown fox jumps over the lazy dog.";
+        SkFont font(fTypefaces[thread % 2]);
+        SkPaint paint;
+        for (int size = 8; size <= 24; size += 4) {
+            font.setSize(size);
+            canvas->drawString(kText, 0, size * 2, font, paint);
+        }
+    }
+
+private:
+    sk_sp<SkTypeface> fTypefaces[2];
+
+    typedef ContentionBench INHERITED;
+};
+
+// Image decode/cache: every thread draws the same lazy image, so they all find its decoded
+// pixels and mips in the resource cache.
+class ContentionImageBench : public ContentionBench {
+public:
+    explicit ContentionImageBench(int threads) : INHERITED("image", threads) {}
+
+protected:
+    void onDelayedSetup() override {
+        INHERITED::onDelayedSetup();
+        auto surface = SkSurface::MakeRasterN32Premul(kSize, kSize);
+        SkPaint paint;
+        for (int i = 0; i < 16; ++i) {
+            paint.setColor(0xFF000000 | (i * 0x10305));
+            surface->getCanvas()->drawCircle(i * 16, i * 16, 24, paint);
+        }
+        fImage = SkImage::MakeFromEncoded(surface->makeImageSnapshot()->encodeToData());
+    }
+
+    void work(int, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setFilterQuality(kMedium_SkFilterQuality);
+        canvas->drawImageRect(fImage, SkRect::MakeWH(kSize / 3, kSize / 3), &paint);
+    }
+
+private:
+    sk_sp<SkImage> fImage;
+
+    typedef ContentionBench INHERITED;
+};
+
+// Picture playback: every thread plays back the same picture.
+class ContentionPictureBench : public ContentionBench {
+public:
+    explicit ContentionPictureBench(int threads) : INHERITED("picture", threads) {}
+
+protected:
+    void onDelayedSetup() override {
+        INHERITED::onDelayedSetup();
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(kSize, kSize);
+        SkFont font(sk_tool_utils::create_portable_typeface());
+        SkPaint paint;
+        for (int i = 0; i < 32; ++i) {
+            paint.setColor(0xFF000000 | (i * 0x70503));
+            canvas->drawRect(SkRect::MakeXYWH(i * 8, i * 4, 32, 16), paint);
+            canvas->drawString("picture", i * 4, i * 8, font, paint);
+        }
+        fPicture = recorder.finishRecordingAsPicture();
+    }
+
+    void work(int, SkCanvas* canvas) override { canvas->drawPicture(fPicture); }
+
+private:
+    sk_sp<SkPicture> fPicture;
+
+    typedef ContentionBench INHERITED;
+};
+
+#define DEF_CONTENTION_BENCHES(Bench)         \
+    DEF_BENCH( return new Bench(1); )         \
+    DEF_BENCH( return new Bench(2); )         \
+    DEF_BENCH( return new Bench(4); )         \
+    DEF_BENCH( return new Bench(8); )         \
+    DEF_BENCH( return new Bench(16); )        \
+    DEF_BENCH( return new Bench(32); )
+
+DEF_CONTENTION_BENCHES(ContentionTextBench)
+DEF_CONTENTION_BENCHES(ContentionImageBench)
+DEF_CONTENTION_BENCHES(ContentionPictureBench)
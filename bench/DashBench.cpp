@@ -177,10 +177,12 @@ class MakeDashBench : public Benchmark {
     SkString fName;
     SkPath   fPath;
     sk_sp<SkPathEffect> fPE;
+    bool     fAnimatePhase;
 
 public:
-    MakeDashBench(void (*proc)(SkPath*), const char name[])  {
-        fName.printf("makedash_%s", name);
+    MakeDashBench(void (*proc)(SkPath*), const char name[], bool animatePhase = false)
+        : fAnimatePhase(animatePhase) {
+        fName.printf("makedash_%s%s", name, animatePhase ? "_animated" : "");
         proc(&fPath);
 
         SkScalar vals[] = { SkIntToScalar(4), SkIntToScalar(4) };
@@ -197,6 +199,12 @@ protected:
         for (int i = 0; i < loops; ++i) {
             SkStrokeRec rec(SkStrokeRec::kHairline_InitStyle);
 
+            if (fAnimatePhase) {
+                // A few long dashes crawling along the same path, as in a marching-ants
+                // animation.
+                SkScalar vals[] = { SkIntToScalar(40), SkIntToScalar(200) };
+                fPE = SkDashPathEffect::Make(vals, 2, SkIntToScalar(i % 240));
+            }
             fPE->filterPath(&dst, fPath, &rec, nullptr);
             dst.rewind();
         }
@@ -450,6 +458,7 @@ DEF_BENCH( return new DashBench(PARAM(gDots), 4); )
 DEF_BENCH( return new MakeDashBench(make_poly, "poly"); )
 DEF_BENCH( return new MakeDashBench(make_quad, "quad"); )
 DEF_BENCH( return new MakeDashBench(make_cubic, "cubic"); )
+DEF_BENCH( return new MakeDashBench(make_cubic, "cubic", true); )
 DEF_BENCH( return new DashLineBench(0, false); )
 DEF_BENCH( return new DashLineBench(SK_Scalar1, false); )
 DEF_BENCH( return new DashLineBench(2 * SK_Scalar1, false); )
@@ -8,6 +8,7 @@
 #include "Benchmark.h"
 #include "Resources.h"
 #include "SkBitmap.h"
+#include "SkExecutor.h"
 #include "SkJpegEncoder.h"
 #include "SkPngEncoder.h"
 #include "SkWebpEncoder.h"
@@ -58,6 +59,14 @@ static bool encode_jpeg(SkWStream* dst, const SkPixmap& src) {
     return SkJpegEncoder::Encode(dst, src, opts);
 }
 
+static bool encode_jpeg_threaded(SkWStream* dst, const SkPixmap& src) {
+    static SkExecutor* gExecutor = SkExecutor::MakeFIFOThreadPool().release();
+    SkJpegEncoder::Options opts;
+    opts.fQuality = 90;
+    opts.fExecutor = gExecutor;
+    return SkJpegEncoder::Encode(dst, src, opts);
+}
+
 static bool encode_webp_lossy(SkWStream* dst, const SkPixmap& src) {
     SkWebpEncoder::Options opts;
     opts.fCompression = SkWebpEncoder::Compression::kLossy;
@@ -85,11 +94,28 @@ static bool encode_png(SkWStream* dst,
 #define PNG(FLAG, ZLIBLEVEL) [](SkWStream* d, const SkPixmap& s) { \
            return encode_png(d, s, SkPngEncoder::FilterFlag::FLAG, ZLIBLEVEL); }
 
+static bool encode_png_threaded(SkWStream* dst,
+                                const SkPixmap& src,
+                                SkPngEncoder::FilterFlag filters,
+                                int zlibLevel) {
+    static SkExecutor* gExecutor = SkExecutor::MakeFIFOThreadPool().release();
+    SkPngEncoder::Options opts;
+    opts.fFilterFlags = filters;
+    opts.fZLibLevel = zlibLevel;
+    opts.fExecutor = gExecutor;
+    return SkPngEncoder::Encode(dst, src, opts);
+}
+
+#define PNG_MT(FLAG, ZLIBLEVEL) [](SkWStream* d, const SkPixmap& s) { \
+           return encode_png_threaded(d, s, SkPngEncoder::FilterFlag::FLAG, ZLIBLEVEL); }
+
 static const char* srcs[2] = {"images/mandrill_512.png", "images/color_wheel.jpg"};
 
 // The Android Photos app uses a quality of 90 on JPEG encodes
 DEF_BENCH(return new EncodeBench(srcs[0], &encode_jpeg, "JPEG"));
 DEF_BENCH(return new EncodeBench(srcs[1], &encode_jpeg, "JPEG"));
+DEF_BENCH(return new EncodeBench(srcs[0], &encode_jpeg_threaded, "JPEG_mt"));
+DEF_BENCH(return new EncodeBench(srcs[1], &encode_jpeg_threaded, "JPEG_mt"));
 
 // TODO: What is the appropriate quality to use to benchmark WEBP encodes?
 DEF_BENCH(return new EncodeBench(srcs[0], encode_webp_lossy, "WEBP"));
@@ -122,4 +148,11 @@ DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 6), "PNG_6n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 3), "PNG_3n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 1), "PNG_1n"));
 
+// Filtered and deflated in bands on a thread pool.
+DEF_BENCH(return new EncodeBench(srcs[0], PNG_MT(kAll, 6), "PNG_mt"));
+DEF_BENCH(return new EncodeBench(srcs[0], PNG_MT(kSub, 1), "PNG_mt_1s"));
+DEF_BENCH(return new EncodeBench(srcs[1], PNG_MT(kAll, 6), "PNG_mt"));
+DEF_BENCH(return new EncodeBench(srcs[1], PNG_MT(kSub, 1), "PNG_mt_1s"));
+
+#undef PNG_MT
 #undef PNG
@@ -244,6 +244,41 @@ protected:
 };
 DEF_BENCH( return new ChopCubicAt; )
 
+// Evaluates 32 evenly spaced points along the curve, either one t at a time or batched.
+class EvalCurveAtManyBench : public QuadBenchBase {
+    bool fCubic, fBatched;
+    SkScalar fT[32];
+public:
+    EvalCurveAtManyBench(const char name[], bool cubic, bool batched)
+        : QuadBenchBase(name), fCubic(cubic), fBatched(batched) {
+        for (int i = 0; i < 32; ++i) {
+            fT[i] = (i + 1) / 33.0f;
+        }
+    }
+protected:
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPoint dst[32];
+        for (int outer = 0; outer < loops; ++outer) {
+            if (fBatched) {
+                fCubic ? SkEvalCubicAt(fPts, fT, dst, 32) : SkEvalQuadAt(fPts, fT, dst, 32);
+            } else {
+                for (int i = 0; i < 32; ++i) {
+                    if (fCubic) {
+                        SkEvalCubicAt(fPts, fT[i], &dst[i], nullptr, nullptr);
+                    } else {
+                        dst[i] = SkEvalQuadAt(fPts, fT[i]);
+                    }
+                }
+            }
+            this->virtualCallToFoilOptimizers((int)dst[outer & 31].fX);
+        }
+    }
+};
+DEF_BENCH( return new EvalCurveAtManyBench("evalquadat_x32", false, false); )
+DEF_BENCH( return new EvalCurveAtManyBench("evalquadat_x32_batch", false, true); )
+DEF_BENCH( return new EvalCurveAtManyBench("evalcubicat_x32", true, false); )
+DEF_BENCH( return new EvalCurveAtManyBench("evalcubicat_x32_batch", true, true); )
+
 #include "SkPath.h"
 
 class ConvexityBench : public Benchmark {
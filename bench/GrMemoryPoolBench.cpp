@@ -9,7 +9,10 @@
 
 #include "Benchmark.h"
 #include "GrMemoryPool.h"
+#include "ops/GrOp.h"
 #include "SkRandom.h"
+#include "SkString.h"
+#include "SkTArray.h"
 #include "SkTDArray.h"
 #include "SkTemplates.h"
 
@@ -170,8 +173,98 @@ private:
     typedef Benchmark INHERITED;
 };
 
+template <int N>
+class ChurnOp : public GrOp {
+public:
+    DEFINE_OP_CLASS_ID
+
+    const char* name() const override { return "ChurnOp"; }
+
+private:
+    friend class GrOpMemoryPool; // for ctor
+
+    ChurnOp() : INHERITED(ClassID()) {}
+
+    void onPrepare(GrOpFlushState*) override {}
+    void onExecute(GrOpFlushState*, const SkRect&) override {}
+
+    char fData[N];
+
+    typedef GrOp INHERITED;
+};
+
+/**
+ * This benchmark records ops of a handful of sizes the way an op list does: most new ops are
+ * merged into (and released right away) or replace one of the recent ops, the rest stay until the
+ * "flush" at the end of each recording releases them all. The pool outlives the recordings, as a
+ * context's or a DDL recorder's does.
+ */
+class GrOpMemoryPoolBenchChurn : public Benchmark {
+public:
+    GrOpMemoryPoolBenchChurn(int mergePercent) : fMergePercent(mergePercent) {
+        fName.printf("grmemorypool_op_churn_%d", mergePercent);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkRandom r;
+        enum {
+            kOpsPerRecording = 4 * (1 << 10),
+            kRecentOps = 16,
+        };
+        GrOpMemoryPool pool(16384, 16384);
+        SkTArray<std::unique_ptr<GrOp>> ops;
+        for (int i = 0; i < loops; i++) {
+            std::unique_ptr<GrOp> op = this->makeOp(&pool, &r);
+            if (r.nextULessThan(100) < (uint32_t)fMergePercent) {
+                pool.release(std::move(op));
+            } else if (ops.count() >= kRecentOps && r.nextBool()) {
+                int idx = ops.count() - 1 - r.nextULessThan(kRecentOps);
+                pool.release(std::move(ops[idx]));
+                ops[idx] = std::move(op);
+            } else {
+                ops.push_back(std::move(op));
+            }
+            if (ops.count() == kOpsPerRecording) {
+                for (auto& op : ops) {
+                    pool.release(std::move(op));
+                }
+                ops.reset();
+            }
+        }
+        for (auto& op : ops) {
+            pool.release(std::move(op));
+        }
+    }
+
+private:
+    std::unique_ptr<GrOp> makeOp(GrOpMemoryPool* pool, SkRandom* r) {
+        switch (r->nextULessThan(4)) {
+            case 0:  return pool->allocate<ChurnOp<48>>();
+            case 1:  return pool->allocate<ChurnOp<120>>();
+            case 2:  return pool->allocate<ChurnOp<200>>();
+            default: return pool->allocate<ChurnOp<480>>();
+        }
+    }
+
+    int      fMergePercent;
+    SkString fName;
+
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new GrMemoryPoolBenchStack(); )
 DEF_BENCH( return new GrMemoryPoolBenchRandom(); )
 DEF_BENCH( return new GrMemoryPoolBenchQueue(); )
+DEF_BENCH( return new GrOpMemoryPoolBenchChurn(50); )
+DEF_BENCH( return new GrOpMemoryPoolBenchChurn(90); )
@@ -10,15 +10,22 @@
 #include "SkImage.h"
 #include "SkPaint.h"
 #include "SkSurface.h"
+#include "SkTArray.h"
 
 class GrMipMapBench: public Benchmark {
-    sk_sp<SkSurface> fSurface;
+    SkTArray<sk_sp<SkSurface>> fSurfaces;
     SkString fName;
     const int fW, fH;
+    const int fCount;
 
 public:
-    GrMipMapBench(int w, int h) : fW(w), fH(h) {
+    // Each loop dirties and then samples count surfaces, so that they all need their mips
+    // regenerated within one flush.
+    GrMipMapBench(int w, int h, int count = 1) : fW(w), fH(h), fCount(count) {
         fName.printf("gr_mipmap_build_%dx%d", w, h);
+        if (count > 1) {
+            fName.appendf("_%dtextures", count);
+        }
     }
 
 protected:
@@ -29,7 +36,7 @@ protected:
     const char* onGetName() override { return fName.c_str(); }
 
     void onDraw(int loops, SkCanvas* canvas) override {
-        if (!fSurface) {
+        if (fSurfaces.empty()) {
             GrContext* context = canvas->getGrContext();
             if (nullptr == context) {
                 return;
@@ -39,31 +46,44 @@ protected:
                     SkImageInfo::Make(fW, fH, kRGBA_8888_SkColorType, kPremul_SkAlphaType, srgb);
             // We're benching the regeneration of the mip levels not the need to allocate them every
             // frame. Thus we create the surface with mips to begin with.
-            fSurface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info, 0,
-                                                   kBottomLeft_GrSurfaceOrigin, nullptr, true);
-
+            for (int i = 0; i < fCount; ++i) {
+                fSurfaces.push_back(SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info, 0,
+                                                                kBottomLeft_GrSurfaceOrigin,
+                                                                nullptr, true));
+                if (!fSurfaces.back()) {
+                    fSurfaces.reset();
+                    return;
+                }
+            }
         }
 
-        // Clear surface once:
-        fSurface->getCanvas()->clear(SK_ColorBLACK);
+        // Clear surfaces once:
+        for (const sk_sp<SkSurface>& surface : fSurfaces) {
+            surface->getCanvas()->clear(SK_ColorBLACK);
+        }
 
         SkPaint paint;
         paint.setFilterQuality(kMedium_SkFilterQuality);
         paint.setColor(SK_ColorWHITE);
         for (int i = 0; i < loops; i++) {
-            // Touch surface so mips are dirtied
-            fSurface->getCanvas()->drawPoint(0, 0, paint);
+            // Touch surfaces so mips are dirtied
+            for (const sk_sp<SkSurface>& surface : fSurfaces) {
+                surface->getCanvas()->drawPoint(0, 0, paint);
+            }
 
-            // Draw reduced version of surface to original canvas, to trigger mip generation
+            // Draw reduced versions of the surfaces to original canvas, to trigger mip generation
             canvas->save();
             canvas->scale(0.1f, 0.1f);
-            canvas->drawImage(fSurface->makeImageSnapshot(), 0, 0, &paint);
+            for (int j = 0; j < fSurfaces.count(); ++j) {
+                canvas->drawImage(fSurfaces[j]->makeImageSnapshot(), SkIntToScalar(j * fW), 0,
+                                  &paint);
+            }
             canvas->restore();
         }
     }
 
     void onPerCanvasPostDraw(SkCanvas*) override {
-        fSurface.reset(nullptr);
+        fSurfaces.reset();
     }
 
 private:
@@ -77,3 +97,7 @@ DEF_BENCH( return new GrMipMapBench(511, 511); )
 DEF_BENCH( return new GrMipMapBench(512, 511); )
 DEF_BENCH( return new GrMipMapBench(511, 512); )
 DEF_BENCH( return new GrMipMapBench(512, 512); )
+
+// Many textures dirtied and sampled in one flush, to exercise batched regeneration.
+DEF_BENCH( return new GrMipMapBench(128, 128, 16); )
+DEF_BENCH( return new GrMipMapBench(512, 512, 16); )
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkConvertPixels.h"
+#include "SkHalf.h"
+#include "SkString.h"
+#include "SkTemplates.h"
+
+// Measures the Sk4f <-> Sk4h conversions in SkHalf.h, one F16 pixel at a time.
+class HalfConvertBench : public Benchmark {
+public:
+    explicit HalfConvertBench(bool toHalf) : fToHalf(toHalf) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override {
+        return fToHalf ? "SkFloatToHalf_finite_ftz" : "SkHalfToFloat_finite_ftz";
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        static const int K = 1023; // Arbitrary, but nice to be a non-power-of-two to trip up SIMD.
+        uint64_t halfs[K];
+        float    floats[4*K];
+        for (int i = 0; i < K; i++) {
+            for (int j = 0; j < 4; j++) {
+                floats[4*i+j] = (i + j) * (1.0f / K);
+            }
+            SkFloatToHalf_finite_ftz(Sk4f::Load(floats + 4*i)).store(halfs + i);
+        }
+        while (loops --> 0) {
+            if (fToHalf) {
+                for (int i = 0; i < K; i++) {
+                    SkFloatToHalf_finite_ftz(Sk4f::Load(floats + 4*i)).store(halfs + i);
+                }
+            } else {
+                for (int i = 0; i < K; i++) {
+                    SkHalfToFloat_finite_ftz(halfs[i]).store(floats + 4*i);
+                }
+            }
+        }
+    }
+private:
+    bool fToHalf;
+};
+
+DEF_BENCH(return new HalfConvertBench(true));
+DEF_BENCH(return new HalfConvertBench(false));
+
+// Measures SkConvertPixels() to and from F16, which runs the load_f16 and store_f16 stages.
+class F16ConvertPixelsBench : public Benchmark {
+public:
+    F16ConvertPixelsBench(SkColorType other, bool fromF16) : fOther(other), fFromF16(fromF16) {
+        fName.printf("ConvertPixels_%s_%s", fromF16 ? "F16_to" : "to_F16",
+                     other == kRGBA_8888_SkColorType ? "8888" : "F32");
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return fName.c_str(); }
+    void onDelayedSetup() override {
+        fF16Info   = SkImageInfo::Make(kW, kH, kRGBA_F16_SkColorType, kPremul_SkAlphaType);
+        fOtherInfo = fF16Info.makeColorType(fOther);
+        fF16Pixels  .reset(fF16Info  .computeMinByteSize());
+        fOtherPixels.reset(fOtherInfo.computeMinByteSize());
+        sk_bzero(fF16Pixels  .get(), fF16Info  .computeMinByteSize());
+        sk_bzero(fOtherPixels.get(), fOtherInfo.computeMinByteSize());
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops --> 0) {
+            if (fFromF16) {
+                SkConvertPixels(fOtherInfo, fOtherPixels.get(), fOtherInfo.minRowBytes(),
+                                fF16Info,   fF16Pixels  .get(), fF16Info  .minRowBytes());
+            } else {
+                SkConvertPixels(fF16Info,   fF16Pixels  .get(), fF16Info  .minRowBytes(),
+                                fOtherInfo, fOtherPixels.get(), fOtherInfo.minRowBytes());
+            }
+        }
+    }
+private:
+    static constexpr int kW = 1023,
+                         kH = 16;
+
+    SkString               fName;
+    SkColorType            fOther;
+    bool                   fFromF16;
+    SkImageInfo            fF16Info,
+                           fOtherInfo;
+    SkAutoTMalloc<uint8_t> fF16Pixels,
+                           fOtherPixels;
+};
+
+DEF_BENCH(return new F16ConvertPixelsBench(kRGBA_8888_SkColorType, true));
+DEF_BENCH(return new F16ConvertPixelsBench(kRGBA_8888_SkColorType, false));
+DEF_BENCH(return new F16ConvertPixelsBench(kRGBA_F32_SkColorType,  true));
+DEF_BENCH(return new F16ConvertPixelsBench(kRGBA_F32_SkColorType,  false));
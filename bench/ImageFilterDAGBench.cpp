@@ -10,9 +10,14 @@
 #include "SkBlurImageFilter.h"
 #include "SkCanvas.h"
 #include "SkDisplacementMapEffect.h"
+#include "SkExecutor.h"
 #include "SkImage.h"
+#include "SkImageFilterPriv.h"
+#include "SkLightingImageFilter.h"
 #include "SkMergeImageFilter.h"
+#include "SkMorphologyImageFilter.h"
 #include "SkOffsetImageFilter.h"
+#include "SkPoint3.h"
 #include "SkXfermodeImageFilter.h"
 
 // Exercise a blur filter connected to 5 inputs of the same merge filter.
@@ -144,7 +149,81 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Exercise a DAG with a shared blur and morphology over a 4K layer, optionally lit. With
+// threads > 0, raster devices filter it in tiles, and its independent branches, on a pool of that
+// many threads. Lighting keeps the DAG from being tiled, but the branches still run in parallel.
+class ImageFilterLargeDAGBench : public Benchmark {
+public:
+    ImageFilterLargeDAGBench(bool lit, int threads) : fLit(lit), fThreads(threads) {
+        fName.printf("image_filter_large_dag%s", lit ? "_lit" : "");
+        if (threads > 0) {
+            fName.appendf("_%dthreads", threads);
+        }
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    SkIPoint onGetSize() override { return SkIPoint::Make(kWidth, kHeight); }
+
+    bool isSuitableFor(Backend backend) override { return kRaster_Backend == backend; }
+
+    void onDelayedSetup() override {
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        gSkImageFilterExecutor = fExecutor.get();
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        gSkImageFilterExecutor = nullptr;
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        const SkRect rect = SkRect::MakeXYWH(100, 100, kWidth - 200, kHeight - 200);
+
+        for (int j = 0; j < loops; j++) {
+            sk_sp<SkImageFilter> blur(SkBlurImageFilter::Make(8.0f, 8.0f, nullptr));
+            sk_sp<SkImageFilter> dilate(SkDilateImageFilter::Make(4, 4, blur));
+            sk_sp<SkImageFilter> inputs[] = {
+                SkXfermodeImageFilter::Make(SkBlendMode::kMultiply, dilate, blur, nullptr),
+                SkErodeImageFilter::Make(2, 2, blur),
+                SkOffsetImageFilter::Make(20.0f, 20.0f, blur),
+            };
+            sk_sp<SkImageFilter> merge(SkMergeImageFilter::Make(inputs, SK_ARRAY_COUNT(inputs)));
+
+            SkPaint paint;
+            paint.setColor(SK_ColorBLUE);
+            paint.setImageFilter(fLit ? SkLightingImageFilter::MakeDistantLitDiffuse(
+                                                SkPoint3::Make(1, 1, 1), SK_ColorWHITE, 2, 1, merge)
+                                      : merge);
+            canvas->drawRect(rect, paint);
+        }
+    }
+
+private:
+    static constexpr int kWidth = 3840;
+    static constexpr int kHeight = 2160;
+
+    bool fLit;
+    int fThreads;
+    SkString fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+    typedef Benchmark INHERITED;
+};
+
 DEF_BENCH(return new ImageFilterDAGBench;)
 DEF_BENCH(return new ImageMakeWithFilterDAGBench;)
 DEF_BENCH(return new ImageFilterDisplacedBlur;)
 DEF_BENCH(return new ImageFilterXfermodeIn;)
+
+DEF_BENCH(return new ImageFilterLargeDAGBench(false, 0);)
+DEF_BENCH(return new ImageFilterLargeDAGBench(false, 2);)
+DEF_BENCH(return new ImageFilterLargeDAGBench(false, 4);)
+DEF_BENCH(return new ImageFilterLargeDAGBench(false, 8);)
+DEF_BENCH(return new ImageFilterLargeDAGBench(true, 0);)
+DEF_BENCH(return new ImageFilterLargeDAGBench(true, 4);)
@@ -55,6 +55,47 @@ private:
 
 DEF_BENCH( return new JsonBench; )
 
+// Self-contained variant, exercising long strings and exponent numbers.
+class JsonSyntheticBench : public Benchmark {
+public:
+
+protected:
+    const char* onGetName() override { return "json_skjson_synthetic"; }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        SkDynamicMemoryWStream stream;
+        stream.writeText("[");
+        for (int i = 0; i < 1000; ++i) {
+            if (i) stream.writeText(",");
+            stream.writeText("{ \"nm\": \"Shape Layer with a fairly long name\", "
+                               "\"ty\": \"sh\", "
+                               "\"v\": [ 1.25e-3, -4.5E+2, 153.2734, 0.5, 1e2 ], "
+                               "\"escaped\": \"some \\\"quoted\\\" text\" }");
+        }
+        stream.writeText("]");
+        fData = stream.detachAsData();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            skjson::DOM dom(static_cast<const char*>(fData->data()), fData->size());
+            if (dom.root().is<skjson::NullValue>()) {
+                SkDebugf("!! Parsing failed.\n");
+                return;
+            }
+        }
+    }
+
+private:
+    sk_sp<SkData> fData;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new JsonSyntheticBench; )
+
 #if (0)
 
 #include "rapidjson/document.h"
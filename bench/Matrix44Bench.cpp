@@ -263,6 +263,42 @@ private:
     typedef Matrix44Bench INHERITED;
 };
 
+// Maps a batch of vectors, as a 3D card does with its corners or a mesh with its vertices.
+class Map4Matrix44Bench : public Matrix44Bench {
+public:
+    Map4Matrix44Bench(bool batched)
+        : INHERITED(batched ? "map4_batch" : "map4_mapscalars")
+        , fBatched(batched)
+    {
+        SkRandom rand;
+        for (int x = 0; x < 4; x++) {
+        for (int y = 0; y < 4; y++) {
+            fM.setFloat(x,y, rand.nextF());
+        }}
+        for (float& v : fSrc) {
+            v = rand.nextF();
+        }
+    }
+protected:
+    void performTest() override {
+        for (int i = 0; i < 100; ++i) {
+            if (fBatched) {
+                fM.map4(fSrc, kCount, fDst);
+            } else {
+                for (int n = 0; n < kCount; ++n) {
+                    fM.mapScalars(fSrc + 4*n, fDst + 4*n);
+                }
+            }
+        }
+    }
+private:
+    static constexpr int kCount = 256;
+    SkMatrix44 fM;
+    float      fSrc[4 * kCount], fDst[4 * kCount];
+    bool       fBatched;
+    typedef Matrix44Bench INHERITED;
+};
+
 class GetTypeMatrix44Bench : public Matrix44Bench {
 public:
     GetTypeMatrix44Bench()
@@ -294,3 +330,5 @@ DEF_BENCH( return new InvertTranslateMatrix44Bench(); )
 DEF_BENCH( return new SetConcatMatrix44Bench(true); )
 DEF_BENCH( return new SetConcatMatrix44Bench(false); )
 DEF_BENCH( return new GetTypeMatrix44Bench(); )
+DEF_BENCH( return new Map4Matrix44Bench(true); )
+DEF_BENCH( return new Map4Matrix44Bench(false); )
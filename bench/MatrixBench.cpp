@@ -269,6 +269,7 @@ DEF_BENCH( return new InvertMapRectMatrixBench(
 static SkMatrix make_trans() { return SkMatrix::MakeTrans(2, 3); }
 static SkMatrix make_scale() { SkMatrix m(make_trans()); m.postScale(1.5f, 0.5f); return m; }
 static SkMatrix make_afine() { SkMatrix m(make_trans()); m.postRotate(15); return m; }
+static SkMatrix make_persp() { SkMatrix m(make_afine()); m.setPerspX(0.001f); return m; }
 
 class MapPointsMatrixBench : public MatrixBench {
 protected:
@@ -297,6 +298,33 @@ DEF_BENCH( return new MapPointsMatrixBench("mappoints_identity", SkMatrix::I());
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_trans", make_trans()); )
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_scale", make_scale()); )
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_affine", make_afine()); )
+DEF_BENCH( return new MapPointsMatrixBench("mappoints_persp", make_persp()); )
+
+// Paths and quads map far more than 32 points at once, which is where the wide kernels pay off.
+class MapManyPointsMatrixBench : public MatrixBench {
+    SkMatrix fM;
+    enum {
+        N = 1024
+    };
+    SkPoint fSrc[N], fDst[N];
+public:
+    MapManyPointsMatrixBench(const char name[], const SkMatrix& m)
+        : MatrixBench(name), fM(m)
+    {
+        SkRandom rand;
+        for (int i = 0; i < N; ++i) {
+            fSrc[i].set(rand.nextSScalar1(), rand.nextSScalar1());
+        }
+    }
+
+    void performTest() override {
+        for (int i = 0; i < 32000; ++i) {
+            fM.mapPoints(fDst, fSrc, N);
+        }
+    }
+};
+DEF_BENCH( return new MapManyPointsMatrixBench("mappoints_1024_affine", make_afine()); )
+DEF_BENCH( return new MapManyPointsMatrixBench("mappoints_1024_persp", make_persp()); )
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -331,3 +359,30 @@ public:
 };
 DEF_BENCH( return new MapRectMatrixBench("maprect", false); )
 DEF_BENCH( return new MapRectMatrixBench("maprectscaletrans", true); )
+
+class MapRectsMatrixBench : public MatrixBench {
+    SkMatrix fM;
+    enum {
+        N = 64
+    };
+    SkRect fSrc[N], fDst[N];
+public:
+    MapRectsMatrixBench(const char name[], const SkMatrix& m)
+        : MatrixBench(name), fM(m)
+    {
+        SkRandom rand;
+        for (int i = 0; i < N; ++i) {
+            fSrc[i].setLTRB(rand.nextSScalar1(), rand.nextSScalar1(),
+                            rand.nextSScalar1(), rand.nextSScalar1());
+            fSrc[i].sort();
+        }
+    }
+
+    void performTest() override {
+        for (int i = 0; i < 100000; ++i) {
+            fM.mapRects(fDst, fSrc, N);
+        }
+    }
+};
+DEF_BENCH( return new MapRectsMatrixBench("maprects_scale", make_scale()); )
+DEF_BENCH( return new MapRectsMatrixBench("maprects_affine", make_afine()); )
@@ -22,10 +22,28 @@ static const char* name(SkMatrixConvolutionImageFilter::TileMode mode) {
 
 class MatrixConvolutionBench : public Benchmark {
 public:
-    MatrixConvolutionBench(SkMatrixConvolutionImageFilter::TileMode tileMode, bool convolveAlpha)
-        : fName(SkStringPrintf("matrixconvolution_%s%s",
+    MatrixConvolutionBench(SkMatrixConvolutionImageFilter::TileMode tileMode, bool convolveAlpha,
+                           bool separable = false)
+        : fName(SkStringPrintf("matrixconvolution_%s%s%s",
                                name(tileMode),
-                               convolveAlpha ? "" : "_noConvolveAlpha")) {
+                               convolveAlpha ? "" : "_noConvolveAlpha",
+                               separable ? "_separable" : "")) {
+        SkIPoint kernelOffset = SkIPoint::Make(1, 1);
+        if (separable) {
+            // A 7x7 binomial blur, which is the outer product of {1, 6, 15, 20, 15, 6, 1} / 64.
+            const SkScalar binomial[7] = { 1, 6, 15, 20, 15, 6, 1 };
+            SkScalar kernel[49];
+            for (int y = 0; y < 7; ++y) {
+                for (int x = 0; x < 7; ++x) {
+                    kernel[y * 7 + x] = binomial[y] * binomial[x] / 4096;
+                }
+            }
+            kernelOffset = SkIPoint::Make(3, 3);
+            fFilter = SkMatrixConvolutionImageFilter::Make(SkISize::Make(7, 7), kernel,
+                                                           SK_Scalar1, 0, kernelOffset,
+                                                           tileMode, convolveAlpha, nullptr);
+            return;
+        }
         SkISize kernelSize = SkISize::Make(3, 3);
         SkScalar kernel[9] = {
             SkIntToScalar( 1), SkIntToScalar( 1), SkIntToScalar( 1),
@@ -33,7 +51,6 @@ public:
             SkIntToScalar( 1), SkIntToScalar( 1), SkIntToScalar( 1),
         };
         SkScalar gain = 0.3f, bias = SkIntToScalar(100);
-        SkIPoint kernelOffset = SkIPoint::Make(1, 1);
         fFilter = SkMatrixConvolutionImageFilter::Make(kernelSize, kernel, gain, bias,
                                                        kernelOffset, tileMode, convolveAlpha,
                                                        nullptr);
@@ -68,3 +85,5 @@ DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kCl
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kRepeat_TileMode, true); )
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClampToBlack_TileMode, true); )
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClampToBlack_TileMode, false); )
+DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClamp_TileMode, true, true); )
+DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClampToBlack_TileMode, false, true); )
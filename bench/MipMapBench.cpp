@@ -7,6 +7,7 @@
 
 #include "Benchmark.h"
 #include "SkBitmap.h"
+#include "SkExecutor.h"
 #include "SkMipMap.h"
 
 class MipMapBench: public Benchmark {
@@ -14,15 +15,21 @@ class MipMapBench: public Benchmark {
     SkString fName;
     const int fW, fH;
     bool fHalfFoat;
+    int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
 
 public:
-    MipMapBench(int w, int h, bool halfFloat = false)
-        : fW(w), fH(h), fHalfFoat(halfFloat)
+    // With threads > 0, the largest levels are generated on a pool of that many threads.
+    MipMapBench(int w, int h, bool halfFloat = false, int threads = 0)
+        : fW(w), fH(h), fHalfFoat(halfFloat), fThreads(threads)
     {
         fName.printf("mipmap_build_%dx%d", w, h);
         if (halfFloat) {
             fName.append("_f16");
         }
+        if (threads > 0) {
+            fName.appendf("_%dthreads", threads);
+        }
     }
 
 protected:
@@ -38,12 +45,17 @@ protected:
                                              SkColorSpace::MakeSRGB());
         fBitmap.allocPixels(info);
         fBitmap.eraseColor(SK_ColorWHITE);  // so we don't read uninitialized memory
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
     }
 
     void onDraw(int loops, SkCanvas*) override {
+        gSkMipMapExecutor = fExecutor.get();
         for (int i = 0; i < loops * 4; i++) {
             SkMipMap::Build(fBitmap, nullptr)->unref();
         }
+        gSkMipMapExecutor = nullptr;
     }
 
 private:
@@ -65,3 +77,15 @@ DEF_BENCH( return new MipMapBench(2048, 2048); )
 DEF_BENCH( return new MipMapBench(2047, 2047); )
 DEF_BENCH( return new MipMapBench(2048, 2047); )
 DEF_BENCH( return new MipMapBench(2047, 2048); )
+
+// Multi-megapixel bases, as from a camera, serially and split over threads.
+DEF_BENCH( return new MipMapBench(4000, 3000); )
+DEF_BENCH( return new MipMapBench(4000, 3000, false, 4); )
+DEF_BENCH( return new MipMapBench(4096, 4096); )
+DEF_BENCH( return new MipMapBench(4096, 4096, false, 2); )
+DEF_BENCH( return new MipMapBench(4096, 4096, false, 4); )
+DEF_BENCH( return new MipMapBench(4096, 4096, false, 8); )
+DEF_BENCH( return new MipMapBench(4095, 4095); )
+DEF_BENCH( return new MipMapBench(4095, 4095, false, 4); )
+DEF_BENCH( return new MipMapBench(4096, 4096, true); )
+DEF_BENCH( return new MipMapBench(4096, 4096, true, 4); )
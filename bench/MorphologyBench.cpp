@@ -16,6 +16,9 @@
 #define SMALL   SkIntToScalar(2)
 #define REAL    1.5f
 #define BIG     SkIntToScalar(10)
+// Outline and glow effects use much larger radii.
+#define OUTLINE SkIntToScalar(20)
+#define GLOW    SkIntToScalar(60)
 
 enum MorphologyType {
     kErode_MT,
@@ -92,6 +95,12 @@ DEF_BENCH( return new MorphologyBench(SMALL, kDilate_MT); )
 DEF_BENCH( return new MorphologyBench(BIG, kErode_MT); )
 DEF_BENCH( return new MorphologyBench(BIG, kDilate_MT); )
 
+DEF_BENCH( return new MorphologyBench(OUTLINE, kErode_MT); )
+DEF_BENCH( return new MorphologyBench(OUTLINE, kDilate_MT); )
+
+DEF_BENCH( return new MorphologyBench(GLOW, kErode_MT); )
+DEF_BENCH( return new MorphologyBench(GLOW, kDilate_MT); )
+
 DEF_BENCH( return new MorphologyBench(REAL, kErode_MT); )
 DEF_BENCH( return new MorphologyBench(REAL, kDilate_MT); )
 
@@ -10,6 +10,9 @@
 #include "SkSpinlock.h"
 #include "SkString.h"
 
+#include <thread>
+#include <vector>
+
 template <typename Mutex>
 class MutexBench : public Benchmark {
 public:
@@ -65,3 +68,55 @@ DEF_BENCH( return new MutexBench<SkSharedMutex>(SkString("SkSharedMutex")); )
 DEF_BENCH( return new MutexBench<SkMutex>(SkString("SkMutex")); )
 DEF_BENCH( return new MutexBench<SkSpinlock>(SkString("SkSpinlock")); )
 DEF_BENCH( return new SharedBench; )
+
+// kThreads threads share one SkSharedMutex, mostly reading, with one acquisition in kWriteEvery
+// exclusive, like lookups in the typeface and strike caches.
+class SharedContendedBench : public Benchmark {
+public:
+    explicit SharedContendedBench(int threads)
+        : fThreads(threads)
+        , fName(SkStringPrintf("SkSharedMutexContended_%dThreads", threads)) {}
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        static const int kWriteEvery = 64;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < fThreads; t++) {
+            threads.emplace_back([this, loops] {
+                for (int i = 0; i < loops; i++) {
+                    if (i % kWriteEvery == 0) {
+                        fMu.acquire();
+                        fValue++;
+                        fMu.release();
+                    } else {
+                        fMu.acquireShared();
+                        fRead = fValue;
+                        fMu.releaseShared();
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+    int           fThreads;
+    SkString      fName;
+    SkSharedMutex fMu;
+    int           fValue = 0;
+    volatile int  fRead = 0;
+};
+
+DEF_BENCH( return new SharedContendedBench(8); )
+DEF_BENCH( return new SharedContendedBench(16); )
@@ -9,9 +9,11 @@
 
 #include "Resources.h"
 #include "SkAutoPixmapStorage.h"
+#include "SkColorPriv.h"
 #include "SkData.h"
 #include "SkExecutor.h"
 #include "SkFloatToDecimal.h"
+#include "SkFont.h"
 #include "SkGradientShader.h"
 #include "SkImage.h"
 #include "SkPDFUnion.h"
@@ -243,6 +245,59 @@ struct WritePDFTextBenchmark : public Benchmark {
     }
 };
 
+/** Writes kPageCount pages of text over a distinct raster image, so that page content
+    deflate, image encoding and font subsetting all have work to spread over the executor.
+    Pages per second is kPageCount divided by the time per loop. */
+struct PDFPagesBench : public Benchmark {
+    static constexpr int kPageCount = 16;
+    int fThreads;
+    SkString fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+    std::vector<sk_sp<SkImage>> fImages;
+
+    explicit PDFPagesBench(int threads)
+        : fThreads(threads), fName(SkStringPrintf("PDFPages_threads_%d", threads)) {}
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    void onDelayedSetup() override {
+        // One thread means no executor: everything runs on the calling thread.
+        fExecutor = fThreads > 1 ? SkExecutor::MakeFIFOThreadPool(fThreads) : nullptr;
+        SkRandom random;
+        for (int i = 0; i < kPageCount; ++i) {
+            SkAutoPixmapStorage pixmap;
+            pixmap.alloc(SkImageInfo::MakeN32Premul(256, 256));
+            for (int y = 0; y < pixmap.height(); ++y) {
+                for (int x = 0; x < pixmap.width(); ++x) {
+                    // Mostly smooth, with some noise, like a photo.
+                    *pixmap.writable_addr32(x, y) = SkPackARGB32(
+                            0xFF, SkToU8(x), SkToU8(y), SkToU8(i * 16 + (random.nextU() & 0xF)));
+                }
+            }
+            fImages.push_back(SkImage::MakeRasterCopy(pixmap));
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        SkFont font;
+        SkPaint paint;
+        while (loops-- > 0) {
+            SkNullWStream wStream;
+            SkPDF::Metadata metadata;
+            metadata.fExecutor = fExecutor.get();
+            auto doc = SkPDF::MakeDocument(&wStream, metadata);
+            for (int i = 0; i < kPageCount; ++i) {
+                SkCanvas* canvas = doc->beginPage(612, 792);
+                canvas->drawImageRect(fImages[i], SkRect{36, 36, 576, 756}, nullptr);
+                for (int line = 0; line < 50; ++line) {
+                    canvas->drawString(SkStringPrintf("Page %d, line %d: the quick brown fox "
+                                                      "jumps over the lazy dog.", i, line),
+                                       48, 60 + 14 * line, font, paint);
+                }
+            }
+            doc->close();
+        }
+    }
+};
+
 }  // namespace
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
@@ -250,6 +305,9 @@ DEF_BENCH(return new PDFCompressionBench;)
 DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WritePDFTextBenchmark;)
+DEF_BENCH(return new PDFPagesBench(1);)
+DEF_BENCH(return new PDFPagesBench(4);)
+DEF_BENCH(return new PDFPagesBench(16);)
 
 #ifdef SK_PDF_ENABLE_SLOW_TESTS
 #include "SkExecutor.h"
@@ -9,12 +9,15 @@
 #include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkColorPriv.h"
+#include "SkExecutor.h"
 #include "SkPaint.h"
 #include "SkPath.h"
 #include "SkRandom.h"
+#include "SkScan.h"
 #include "SkShader.h"
 #include "SkString.h"
 #include "SkTArray.h"
+#include "sk_tool_utils.h"
 
 enum Flags {
     kStroke_Flag = 1 << 0,
@@ -225,6 +228,109 @@ private:
     typedef PathBench INHERITED;
 };
 
+// Fills the same complex paths with analytic AA and with delta AA, so we can track the two raster
+// scan converters against each other. kDAABanded also hands DAA an executor for huge paths.
+class ScanConverterPathBench : public Benchmark {
+public:
+    enum class ScanConverter { kAAA, kDAA, kDAABanded };
+    enum class Shape { kChart, kStar, kBigPath, kMap };
+
+    ScanConverterPathBench(ScanConverter scanConverter, Shape shape)
+            : fScanConverter(scanConverter), fShape(shape) {
+        static const char* kShapeNames[] = { "chart", "star", "bigpath", "map" };
+        static const char* kScanConverterNames[] = { "aaa", "daa", "daa_banded" };
+        fName.printf("path_fill_%s_%s", kShapeNames[(int)shape],
+                     kScanConverterNames[(int)scanConverter]);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override { return backend == kRaster_Backend; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    SkIPoint onGetSize() override { return SkIPoint::Make(640, 480); }
+
+    void onDelayedSetup() override {
+        switch (fShape) {
+            case Shape::kChart: {
+                // An area chart: a long random polyline closed along the bottom edge.
+                SkRandom rand;
+                fPath.moveTo(0, 480);
+                for (int x = 0; x <= 640; x += 2) {
+                    fPath.lineTo(SkIntToScalar(x), rand.nextRangeScalar(40, 440));
+                }
+                fPath.lineTo(640, 480);
+                fPath.close();
+                break;
+            }
+            case Shape::kStar:
+                fPath = sk_tool_utils::make_star(SkRect::MakeWH(640, 480), 101, 37);
+                break;
+            case Shape::kBigPath: {
+                sk_tool_utils::make_big_path(fPath);
+                const SkRect& r = fPath.getBounds();
+                fPath.transform(SkMatrix::MakeRectToRect(r, SkRect::MakeWH(640, 480),
+                                                         SkMatrix::kFill_ScaleToFit));
+                break;
+            }
+            case Shape::kMap: {
+                // A map polygon: 100k short random steps around a circle.
+                SkRandom rand;
+                constexpr int kVerbCount = 100000;
+                for (int i = 0; i < kVerbCount; ++i) {
+                    SkScalar theta = 2 * SK_ScalarPI * i / kVerbCount;
+                    SkScalar r = 200 + rand.nextRangeScalar(-30, 30);
+                    SkPoint pt = {320 + r * SkScalarCos(theta), 240 + r * SkScalarSin(theta)};
+                    if (0 == i) {
+                        fPath.moveTo(pt);
+                    } else {
+                        fPath.lineTo(pt);
+                    }
+                }
+                fPath.close();
+                break;
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+
+        // Override whatever --analyticAA / --deltaAA asked for while we draw.
+        const bool useDeltaAA = gSkUseDeltaAA, forceDeltaAA = gSkForceDeltaAA;
+        const bool useAnalyticAA = gSkUseAnalyticAA, forceAnalyticAA = gSkForceAnalyticAA;
+        SkExecutor* const daaExecutor = gSkDAAExecutor;
+        bool aaa = ScanConverter::kAAA == fScanConverter;
+        gSkUseDeltaAA = gSkForceDeltaAA = !aaa;
+        gSkUseAnalyticAA = gSkForceAnalyticAA = aaa;
+        if (ScanConverter::kDAABanded == fScanConverter) {
+            static SkExecutor* gExecutor = SkExecutor::MakeFIFOThreadPool().release();
+            gSkDAAExecutor = gExecutor;
+        } else {
+            gSkDAAExecutor = nullptr;
+        }
+
+        for (int i = 0; i < loops; i++) {
+            canvas->drawPath(fPath, paint);
+        }
+
+        gSkUseDeltaAA = useDeltaAA;
+        gSkForceDeltaAA = forceDeltaAA;
+        gSkUseAnalyticAA = useAnalyticAA;
+        gSkForceAnalyticAA = forceAnalyticAA;
+        gSkDAAExecutor = daaExecutor;
+    }
+
+private:
+    const ScanConverter fScanConverter;
+    const Shape fShape;
+    SkString fName;
+    SkPath fPath;
+
+    typedef Benchmark INHERITED;
+};
+
 class SawToothPathBench : public PathBench {
 public:
     SawToothPathBench(Flags flags) : INHERITED(flags) {}
@@ -1147,6 +1253,25 @@ DEF_BENCH( return new AAAConcavePathBench(FLAGS10); )
 DEF_BENCH( return new AAAConvexPathBench(FLAGS00); )
 DEF_BENCH( return new AAAConvexPathBench(FLAGS10); )
 
+DEF_BENCH( return new ScanConverterPathBench(ScanConverterPathBench::ScanConverter::kAAA,
+                                                  ScanConverterPathBench::Shape::kChart); )
+DEF_BENCH( return new ScanConverterPathBench(ScanConverterPathBench::ScanConverter::kDAA,
+                                                  ScanConverterPathBench::Shape::kChart); )
+DEF_BENCH( return new ScanConverterPathBench(ScanConverterPathBench::ScanConverter::kAAA,
+                                                  ScanConverterPathBench::Shape::kStar); )
+DEF_BENCH( return new ScanConverterPathBench(ScanConverterPathBench::ScanConverter::kDAA,
+                                                  ScanConverterPathBench::Shape::kStar); )
+DEF_BENCH( return new ScanConverterPathBench(ScanConverterPathBench::ScanConverter::kAAA,
+                                                  ScanConverterPathBench::Shape::kBigPath); )
+DEF_BENCH( return new ScanConverterPathBench(ScanConverterPathBench::ScanConverter::kDAA,
+                                                  ScanConverterPathBench::Shape::kBigPath); )
+DEF_BENCH( return new ScanConverterPathBench(ScanConverterPathBench::ScanConverter::kAAA,
+                                                  ScanConverterPathBench::Shape::kMap); )
+DEF_BENCH( return new ScanConverterPathBench(ScanConverterPathBench::ScanConverter::kDAA,
+                                                  ScanConverterPathBench::Shape::kMap); )
+DEF_BENCH( return new ScanConverterPathBench(ScanConverterPathBench::ScanConverter::kDAABanded,
+                                                  ScanConverterPathBench::Shape::kMap); )
+
 DEF_BENCH( return new SawToothPathBench(FLAGS00); )
 DEF_BENCH( return new SawToothPathBench(FLAGS01); )
 
@@ -26,6 +26,11 @@ public:
         fPath2.addOval({-20, -10, 20, 10});
     }
 
+    PathOpsBench(const char suffix[], const SkPath& path1, const SkPath& path2, SkPathOp op)
+        : fPath1(path1), fPath2(path2), fOp(op) {
+        fName.printf("pathops_%s", suffix);
+    }
+
     bool isSuitableFor(Backend backend) override {
         return backend == kNonRendering_Backend;
     }
@@ -36,8 +41,10 @@ protected:
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
+        // Keep large inputs from taking seconds per loop.
+        const int count = SkTPin(64000 / (fPath1.countVerbs() + fPath2.countVerbs()), 1, 1000);
         for (int i = 0; i < loops; i++) {
-            for (int j = 0; j < 1000; ++j) {
+            for (int j = 0; j < count; ++j) {
                 SkPath result;
                 Op(fPath1, fPath2, fOp, &result);
             }
@@ -67,8 +74,9 @@ protected:
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
+        const int count = SkTPin(10000 / fPath.countVerbs(), 1, 100);
         for (int i = 0; i < loops; i++) {
-            for (int j = 0; j < 100; ++j) {
+            for (int j = 0; j < count; ++j) {
                 SkPath result;
                 Simplify(fPath, &result);
             }
@@ -96,3 +104,74 @@ static SkPath makerects() {
 }
 
 DEF_BENCH( return new PathOpsSimplifyBench("rects", makerects()); )
+
+class PathOpsBuilderBench : public Benchmark {
+    SkString        fName;
+    SkTArray<SkPath> fPaths;
+
+public:
+    PathOpsBuilderBench(const char suffix[], const SkTArray<SkPath>& paths) : fPaths(paths) {
+        fName.printf("pathops_builder_%s", suffix);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            SkOpBuilder builder;
+            for (const SkPath& path : fPaths) {
+                builder.add(path, kUnion_SkPathOp);
+            }
+            SkPath result;
+            builder.resolve(&result);
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
+// A closed polygon around (cx, cy) with a jagged edge, like a coastline or a country border.
+static SkPath makeoutline(SkRandom* rand, int count, SkScalar cx, SkScalar cy, SkScalar radius) {
+    SkPath path;
+    for (int i = 0; i < count; ++i) {
+        SkScalar angle = 2 * SK_ScalarPI * i / count;
+        SkScalar r = radius * (0.8f + 0.4f * rand->nextUScalar1());
+        SkPoint pt = {cx + r * SkScalarCos(angle), cy + r * SkScalarSin(angle)};
+        if (0 == i) {
+            path.moveTo(pt);
+        } else {
+            path.lineTo(pt);
+        }
+    }
+    path.close();
+    return path;
+}
+
+static SkPath makeoutline(int count, SkScalar cx, SkScalar cy) {
+    SkRandom rand(count);
+    return makeoutline(&rand, count, cx, cy, 100);
+}
+
+static SkTArray<SkPath> makeoutlines(int pathCount, int count) {
+    SkRandom rand;
+    SkTArray<SkPath> paths;
+    for (int i = 0; i < pathCount; ++i) {
+        paths.push_back(makeoutline(&rand, count, 15.f * i, 7.f * i, 40));
+    }
+    return paths;
+}
+
+DEF_BENCH( return new PathOpsBench("join_outline_1000", makeoutline(1000, 0, 0),
+                                   makeoutline(1000, 30, 10), kUnion_SkPathOp); )
+DEF_BENCH( return new PathOpsBench("sect_outline_4000", makeoutline(4000, 0, 0),
+                                   makeoutline(4000, 30, 10), kIntersect_SkPathOp); )
+DEF_BENCH( return new PathOpsSimplifyBench("outline_4000", makeoutline(4000, 0, 0)); )
+DEF_BENCH( return new PathOpsBuilderBench("outlines_8x1000", makeoutlines(8, 1000)); )
@@ -11,19 +11,20 @@
 
 class PerlinNoiseBench : public Benchmark {
     SkISize fSize;
+    bool    fStitchTiles;
 
 public:
-    PerlinNoiseBench()  {
+    PerlinNoiseBench(bool stitchTiles) : fStitchTiles(stitchTiles) {
         fSize = SkISize::Make(80, 80);
     }
 
 protected:
     const char* onGetName() override {
-        return "perlinnoise";
+        return fStitchTiles ? "perlinnoise_stitched" : "perlinnoise";
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
-        this->test(loops, canvas, 0, 0, 0.1f, 0.1f, 3, 0, false);
+        this->test(loops, canvas, 0, 0, 0.1f, 0.1f, 3, 0, fStitchTiles);
     }
 
 private:
@@ -55,4 +56,5 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////
 
-DEF_BENCH( return new PerlinNoiseBench(); )
+DEF_BENCH( return new PerlinNoiseBench(false); )
+DEF_BENCH( return new PerlinNoiseBench(true); )
@@ -95,6 +95,64 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Time how long it takes to cull a large tree against every tile of a tiled playback, either one
+// tile at a time or with all the tiles in one searchAll().
+class RTreeTiledQueryBench : public Benchmark {
+public:
+    RTreeTiledQueryBench(bool batched) : fBatched(batched) {
+        fName.printf("rtree_tiled_%s_query", batched ? "batched" : "serial");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+protected:
+    static const int kNumRects = 200000;
+    static const int kTilesX = 4, kTilesY = 4;
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+    void onDelayedSetup() override {
+        // Small rects in rows across a 4000x5000 page, in the order Blink would record them.
+        SkRandom rand;
+        SkAutoTMalloc<SkRect> rects(kNumRects);
+        for (int i = 0; i < kNumRects; ++i) {
+            rects[i] = SkRect::MakeXYWH(SkIntToScalar((i % 400) * 10),
+                                        SkIntToScalar((i / 400) * 10),
+                                        1 + rand.nextRangeF(0, 30), 1 + rand.nextRangeF(0, 30));
+        }
+        fTree.insert(rects.get(), kNumRects);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkRandom rand;
+        for (int i = 0; i < loops; ++i) {
+            // A viewport of 256x256 tiles somewhere on the page.
+            SkScalar x = rand.nextRangeF(0, 3000),
+                     y = rand.nextRangeF(0, 4000);
+            SkRect tiles[kTilesX * kTilesY];
+            for (int j = 0; j < kTilesX * kTilesY; ++j) {
+                tiles[j] = SkRect::MakeXYWH(x + 256 * (j % kTilesX), y + 256 * (j / kTilesX),
+                                            256, 256);
+            }
+            SkTDArray<int> hits[kTilesX * kTilesY];
+            if (fBatched) {
+                fTree.searchAll(tiles, kTilesX * kTilesY, hits);
+            } else {
+                for (int j = 0; j < kTilesX * kTilesY; ++j) {
+                    fTree.search(tiles[j], &hits[j]);
+                }
+            }
+        }
+    }
+private:
+    SkRTree fTree;
+    bool fBatched;
+    SkString fName;
+    typedef Benchmark INHERITED;
+};
+
 static inline SkRect make_XYordered_rects(SkRandom& rand, int index, int numRects) {
     SkRect out;
     out.fLeft   = SkIntToScalar(index % GRID_WIDTH);
@@ -136,3 +194,6 @@ DEF_BENCH(return new RTreeQueryBench("XY", &make_XYordered_rects));
 DEF_BENCH(return new RTreeQueryBench("YX", &make_YXordered_rects));
 DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects));
 DEF_BENCH(return new RTreeQueryBench("concentric", &make_concentric_rects));
+
+DEF_BENCH(return new RTreeTiledQueryBench(false));
+DEF_BENCH(return new RTreeTiledQueryBench(true));
@@ -21,16 +21,20 @@ DEFINE_int32(GPUbenchTileW, 1600, "Tile width  used for GPU SKP playback.");
 DEFINE_int32(GPUbenchTileH, 512, "Tile height used for GPU SKP playback.");
 
 SKPBench::SKPBench(const char* name, const SkPicture* pic, const SkIRect& clip, SkScalar scale,
-                   bool useMultiPictureDraw, bool doLooping)
+                   bool useMultiPictureDraw, bool doLooping, SkExecutor* mpdExecutor)
     : fPic(SkRef(pic))
     , fClip(clip)
     , fScale(scale)
     , fName(name)
     , fUseMultiPictureDraw(useMultiPictureDraw)
+    , fMPDExecutor(mpdExecutor)
     , fDoLooping(doLooping) {
     fUniqueName.printf("%s_%.2g", name, scale);  // Scale makes this unqiue for perf.skia.org traces.
     if (useMultiPictureDraw) {
         fUniqueName.append("_mpd");
+        if (mpdExecutor) {
+            fUniqueName.append("_threaded");
+        }
     }
 }
 
@@ -135,7 +139,7 @@ void SKPBench::drawMPDPicture() {
     }
 
     // We flush after each picture to more closely model how Chrome rasterizes tiles.
-    mpd.draw(/*flush = */ true);
+    mpd.draw(/*flush = */ true, fMPDExecutor);
 }
 
 void SKPBench::drawPicture() {
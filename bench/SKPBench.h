@@ -13,6 +13,7 @@
 #include "SkPicture.h"
 #include "SkTDArray.h"
 
+class SkExecutor;
 class SkSurface;
 
 /**
@@ -20,8 +21,9 @@ class SkSurface;
  */
 class SKPBench : public Benchmark {
 public:
+    // If non-null, 'mpdExecutor' runs the MultiPictureDraw playback instead of the default one.
     SKPBench(const char* name, const SkPicture*, const SkIRect& devClip, SkScalar scale,
-             bool useMultiPictureDraw, bool doLooping);
+             bool useMultiPictureDraw, bool doLooping, SkExecutor* mpdExecutor = nullptr);
     ~SKPBench() override;
 
     int calculateLoops(int defaultLoops) const override {
@@ -54,6 +56,7 @@ private:
     SkString fUniqueName;
 
     const bool fUseMultiPictureDraw;
+    SkExecutor* const fMPDExecutor;
     SkTArray<sk_sp<SkSurface>> fSurfaces;   // for MultiPictureDraw
     SkTDArray<SkIRect> fTileRects;     // for MultiPictureDraw
 
@@ -15,11 +15,13 @@ class ShadowBench : public Benchmark {
 // Draws a set of shadowed rrects filling the canvas, in various modes:
 // * opaque or transparent
 // * use analytic fast path or geometric tessellation
+// * rrects or hexagons
 public:
-    ShadowBench(bool transparent, bool forceGeometric)
+    ShadowBench(bool transparent, bool forceGeometric, bool polygons = false)
         : fTransparent(transparent)
-        , fForceGeometric(forceGeometric) {
-        computeName("shadows");
+        , fForceGeometric(forceGeometric)
+        , fPolygons(polygons) {
+        computeName(polygons ? "shadows_poly" : "shadows");
     }
 
 protected:
@@ -50,13 +52,32 @@ protected:
         for (int x = kRRSpace; x < kWidth - kRRStep; x += kRRStep) {
             for (int y = kRRSpace; y < kHeight - kRRStep; y += kRRStep) {
                 SkRect rect = SkRect::MakeXYWH(x, y, kRRSize, kRRSize);
-                fRRects[i].addRRect(SkRRect::MakeRectXY(rect, kRRRadius, kRRRadius));
+                if (fPolygons) {
+                    this->addHexagon(&fRRects[i], rect);
+                } else {
+                    fRRects[i].addRRect(SkRRect::MakeRectXY(rect, kRRRadius, kRRRadius));
+                }
                 ++i;
             }
         }
         SkASSERT(i == kNumRRects);
     }
 
+    static void addHexagon(SkPath* path, const SkRect& rect) {
+        SkScalar radius = rect.width() * 0.5f;
+        for (int i = 0; i < 6; ++i) {
+            SkScalar angle = i * SK_ScalarPI / 3;
+            SkPoint pt = SkPoint::Make(rect.centerX() + radius * SkScalarCos(angle),
+                                       rect.centerY() + radius * SkScalarSin(angle));
+            if (0 == i) {
+                path->moveTo(pt);
+            } else {
+                path->lineTo(pt);
+            }
+        }
+        path->close();
+    }
+
     const char* onGetName() override { return fBaseName.c_str(); }
 
     void onDelayedSetup() override {
@@ -94,6 +115,7 @@ private:
     SkDrawShadowRec fRec;
     int    fTransparent;
     int    fForceGeometric;
+    bool   fPolygons;
 
     typedef Benchmark INHERITED;
 };
@@ -102,4 +124,6 @@ DEF_BENCH(return new ShadowBench(false, false);)
 DEF_BENCH(return new ShadowBench(false, true);)
 DEF_BENCH(return new ShadowBench(true, false);)
 DEF_BENCH(return new ShadowBench(true, true);)
+DEF_BENCH(return new ShadowBench(false, false, true);)
+DEF_BENCH(return new ShadowBench(false, true, true);)
 
@@ -40,11 +40,13 @@ public:
         fFont.getXPos(&fGlyphs[0], fGlyphs.count(), fXPos.begin());
     }
 
-    sk_sp<SkTextBlob> makeBlob() {
-        const SkTextBlobBuilder::RunBuffer& run =
-            fBuilder.allocRunPosH(fFont, fGlyphs.count(), 10, nullptr);
-        memcpy(run.glyphs, &fGlyphs[0], fGlyphs.count() * sizeof(uint16_t));
-        memcpy(run.pos, &fXPos[0], fXPos.count() * sizeof(SkScalar));
+    sk_sp<SkTextBlob> makeBlob(int runCount = 1) {
+        for (int i = 0; i < runCount; i++) {
+            const SkTextBlobBuilder::RunBuffer& run =
+                fBuilder.allocRunPosH(fFont, fGlyphs.count(), 10 + 12 * i, nullptr);
+            memcpy(run.glyphs, &fGlyphs[0], fGlyphs.count() * sizeof(uint16_t));
+            memcpy(run.pos, &fXPos[0], fXPos.count() * sizeof(SkScalar));
+        }
         return fBuilder.make();
     }
 
@@ -75,6 +77,27 @@ class TextBlobCachedBench : public SkTextBlobBench {
 };
 DEF_BENCH( return new TextBlobCachedBench(); )
 
+/*
+ * Draws a blob of many short runs, which stresses the per run setup of the glyph run painter
+ * rather than the per glyph work.
+ */
+class TextBlobManyRunsBench : public SkTextBlobBench {
+    const char* onGetName() override {
+        return "TextBlobManyRunsBench";
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+
+        auto blob = this->makeBlob(32);
+        auto bigLoops = loops * 10;
+        for (int i = 0; i < bigLoops; i++) {
+            canvas->drawTextBlob(blob, 0, 0, paint);
+        }
+    }
+};
+DEF_BENCH( return new TextBlobManyRunsBench(); )
+
 class TextBlobFirstTimeBench : public SkTextBlobBench {
     const char* onGetName() override {
         return "TextBlobFirstTimeBench";
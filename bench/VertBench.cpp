@@ -32,6 +32,7 @@ class VertBench : public Benchmark {
     SkPoint fPts[PTS];
     SkColor fColors[PTS];
     uint16_t fIdx[IDX];
+    bool fIsVolatile;
 
     static void load_2_tris(uint16_t idx[], int x, int y, int rb) {
         int n = y * rb + x;
@@ -40,7 +41,7 @@ class VertBench : public Benchmark {
     }
 
 public:
-    VertBench() {
+    VertBench(bool isVolatile = true) : fIsVolatile(isVolatile) {
         const SkScalar dx = SkIntToScalar(W) / COL;
         const SkScalar dy = SkIntToScalar(H) / COL;
 
@@ -73,7 +74,7 @@ public:
             fColors[i] = rand.nextU() | (0xFF << 24);
         }
 
-        fName.set("verts");
+        fName.set(isVolatile ? "verts" : "verts_nonvolatile");
     }
 
 protected:
@@ -83,7 +84,8 @@ protected:
         this->setupPaint(&paint);
 
         auto verts = SkVertices::MakeCopy(SkVertices::kTriangles_VertexMode, PTS,
-                                          fPts, nullptr, fColors, IDX, fIdx);
+                                          fPts, nullptr, fColors, nullptr, nullptr,
+                                          IDX, fIdx, fIsVolatile);
         for (int i = 0; i < loops; i++) {
             canvas->drawVertices(verts, SkBlendMode::kModulate, paint);
         }
@@ -95,3 +97,4 @@ private:
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH(return new VertBench();)
+DEF_BENCH(return new VertBench(false);)
@@ -16,6 +16,7 @@
 #include "CodecBenchPriv.h"
 #include "CrashHandler.h"
 #include "GMBench.h"
+#include "PerfCounters.h"
 #include "ProcStats.h"
 #include "RecordingBench.h"
 #include "ResultsWriter.h"
@@ -34,12 +35,14 @@
 #include "SkData.h"
 #include "SkDebugfTracer.h"
 #include "SkEventTracingPriv.h"
+#include "SkExecutor.h"
 #include "SkGraphics.h"
 #include "SkJSONWriter.h"
 #include "SkLeanWindows.h"
 #include "SkOSFile.h"
 #include "SkOSPath.h"
 #include "SkPictureRecorder.h"
+#include "SkRasterPipeline.h"
 #include "SkScan.h"
 #include "SkString.h"
 #include "SkSurface.h"
@@ -52,6 +55,7 @@
 #include "SkSVGDOM.h"
 #endif  // SK_XML
 
+#include <limits>
 #include <stdlib.h>
 #include <thread>
 
@@ -124,6 +128,8 @@ DEFINE_string(zoom, "1.0,0", "Comma-separated zoomMax,zoomPeriodMs factors for a
 DEFINE_bool(bbh, true, "Build a BBH for SKPs?");
 DEFINE_bool(lite, false, "Use SkLiteRecorder in recording benchmarks?");
 DEFINE_bool(mpd, true, "Use MultiPictureDraw for the SKPs?");
+DEFINE_int32(mpdThreads, 0, "If > 0, also run each --mpd SKP with its raster tiles replayed "
+                            "on a pool of this many threads.");
 DEFINE_bool(loopSKP, true, "Loop SKPs like we do for micro benches?");
 DEFINE_int32(flushEvery, 10, "Flush --outResultsFile every Nth run.");
 DEFINE_bool(gpuStats, false, "Print GPU stats after each gpu benchmark?");
@@ -136,6 +142,10 @@ DEFINE_string(benchType,  "",
         "Apply usual --match rules to bench type: micro, recording, piping, playback, skcodec, etc.");
 
 DEFINE_bool(forceRasterPipeline, false, "sets gSkForceRasterPipelineBlitter");
+DEFINE_bool(pipelineStats, false, "Count the raster pipelines each bench builds in lowp and in "
+                                  "highp while sampling, and report them per loop.");
+DEFINE_bool(perfCounters, false, "Count hardware events while timing each sample and write "
+                                 "them per loop to --outResultsFile. Linux only.");
 
 static double now_ms() { return SkTime::GetNSecs() * 1e-6; }
 
@@ -238,7 +248,8 @@ struct GPUTarget : public Target {
     }
 };
 
-static double time(int loops, Benchmark* bench, Target* target) {
+static double time(int loops, Benchmark* bench, Target* target,
+                   sk_tools::PerfCounters* counters = nullptr) {
     SkCanvas* canvas = target->getCanvas();
     if (canvas) {
         canvas->clear(SK_ColorWHITE);
@@ -246,10 +257,16 @@ static double time(int loops, Benchmark* bench, Target* target) {
     bench->preDraw(canvas);
     double start = now_ms();
     canvas = target->beginTiming(canvas);
+    if (counters) {
+        counters->start();
+    }
     bench->draw(loops, canvas);
     if (canvas) {
         canvas->flush();
     }
+    if (counters) {
+        counters->stop();
+    }
     target->endTiming();
     double elapsed = now_ms() - start;
     bench->postDraw(canvas);
@@ -628,8 +645,15 @@ public:
 
         if (FLAGS_mpd) {
             fUseMPDs.push_back() = true;
+            fMPDExecutors.push_back() = nullptr;
+            if (FLAGS_mpdThreads > 0) {
+                fMPDThreadPool = SkExecutor::MakeFIFOThreadPool(FLAGS_mpdThreads);
+                fUseMPDs.push_back() = true;
+                fMPDExecutors.push_back() = fMPDThreadPool.get();
+            }
         }
         fUseMPDs.push_back() = false;
+        fMPDExecutors.push_back() = nullptr;
 
         // Prepare the images for decoding
         if (!CollectImages(FLAGS_images, &fImages)) {
@@ -776,8 +800,9 @@ public:
                     SkString name = SkOSPath::Basename(path.c_str());
                     fSourceType = "skp";
                     fBenchType = "playback";
+                    SkExecutor* mpdExecutor = fMPDExecutors[fCurrentUseMPD];
                     return new SKPBench(name.c_str(), pic.get(), fClip, fScales[fCurrentScale],
-                                        fUseMPDs[fCurrentUseMPD++], FLAGS_loopSKP);
+                                        fUseMPDs[fCurrentUseMPD++], FLAGS_loopSKP, mpdExecutor);
                 }
                 fCurrentUseMPD = 0;
                 fCurrentSKP++;
@@ -894,7 +919,12 @@ public:
         }
 
         // Run AndroidCodecBenches
-        const int sampleSizes[] = { 2, 4, 8 };
+        // libjpeg-turbo scales by 2, 4 and 8 itself, so 3 measures SkSampledCodec for jpegs too.
+        const struct {
+            int  fSampleSize;
+            bool fBoxFilter;
+        } sampleSizes[] = { { 2, false }, { 4, false }, { 8, false },
+                            { 3, false }, { 3, true  }, { 4, true  } };
         for (; fCurrentAndroidCodec < fImages.count(); fCurrentAndroidCodec++) {
             fSourceType = "image";
             fBenchType = "skandroidcodec";
@@ -912,15 +942,16 @@ public:
             }
 
             while (fCurrentSampleSize < (int) SK_ARRAY_COUNT(sampleSizes)) {
-                int sampleSize = sampleSizes[fCurrentSampleSize];
+                int sampleSize = sampleSizes[fCurrentSampleSize].fSampleSize;
+                bool boxFilter = sampleSizes[fCurrentSampleSize].fBoxFilter;
                 fCurrentSampleSize++;
                 if (10 * sampleSize > SkTMin(codec->getInfo().width(), codec->getInfo().height())) {
                     // Avoid benchmarking scaled decodes of already small images.
-                    break;
+                    continue;
                 }
 
                 return new AndroidCodecBench(SkOSPath::Basename(path.c_str()),
-                                             encoded.get(), sampleSize);
+                                             encoded.get(), sampleSize, boxFilter);
             }
             fCurrentSampleSize = 0;
         }
@@ -1022,9 +1053,13 @@ public:
             SkASSERT_RELEASE(fCurrentScale < fScales.count());  // debugging paranoia
             log.appendString("scale", SkStringPrintf("%.2g", fScales[fCurrentScale]).c_str());
             if (fCurrentUseMPD > 0) {
-                SkASSERT(1 == fCurrentUseMPD || 2 == fCurrentUseMPD);
+                SkASSERT(fCurrentUseMPD <= fUseMPDs.count());
                 log.appendString("multi_picture_draw",
                                  fUseMPDs[fCurrentUseMPD-1] ? "true" : "false");
+                if (fMPDExecutors[fCurrentUseMPD-1]) {
+                    log.appendString("mpd_threads",
+                                     SkStringPrintf("%d", FLAGS_mpdThreads).c_str());
+                }
             }
         }
     }
@@ -1056,6 +1091,8 @@ private:
     SkTArray<SkString> fSKPs;
     SkTArray<SkString> fSVGs;
     SkTArray<bool>     fUseMPDs;
+    SkTArray<SkExecutor*> fMPDExecutors;  // Parallel to fUseMPDs.
+    std::unique_ptr<SkExecutor> fMPDThreadPool;
     SkTArray<SkString> fImages;
     SkTArray<SkColorType, true> fColorTypes;
     SkScalar           fZoomMax;
@@ -1108,7 +1145,7 @@ int main(int argc, char** argv) {
 #endif
     SetupCrashHandler();
     SkAutoGraphics ag;
-    SkTaskGroup::Enabler enabled(FLAGS_threads);
+    SkTaskGroup::Enabler enabled(FLAGS_threads, FLAGS_workStealing);
 
     SetCtxOptionsFromCommonFlags(&grContextOpts);
 
@@ -1166,6 +1203,17 @@ int main(int argc, char** argv) {
 
     SkTArray<double> samples;
 
+    std::unique_ptr<sk_tools::PerfCounters> perfCounters;
+    // The minimum count per loop of each counter over a bench's samples.
+    double minCountsPerLoop[sk_tools::PerfCounters::kCount];
+    if (FLAGS_perfCounters) {
+        perfCounters.reset(new sk_tools::PerfCounters);
+        if (!perfCounters->isValid()) {
+            SkDebugf("WARNING: --perfCounters is not supported here, ignoring it.\n");
+            perfCounters.reset();
+        }
+    }
+
     if (kAutoTuneLoops != FLAGS_loops) {
         SkDebugf("Fixed number of loops; times would only be misleading so we won't print them.\n");
     } else if (FLAGS_quiet) {
@@ -1197,6 +1245,7 @@ int main(int argc, char** argv) {
     if (FLAGS_forceRasterPipeline) {
         gSkForceRasterPipelineBlitter = true;
     }
+    SkRasterPipeline::SetCountBuilds(FLAGS_pipelineStats);
 
     int runs = 0;
     BenchmarkStream benchStream;
@@ -1256,19 +1305,47 @@ int main(int argc, char** argv) {
                 } while (now_ms() < stop);
             }
 
+            for (double& count : minCountsPerLoop) {
+                count = std::numeric_limits<double>::quiet_NaN();
+            }
+            auto countSample = [&]() {
+                for (int c = 0; c < sk_tools::PerfCounters::kCount; ++c) {
+                    int64_t count = perfCounters->count((sk_tools::PerfCounters::Counter)c);
+                    if (count >= 0) {
+                        double countPerLoop = (double)count / loops;
+                        // NaN compares false, so the first sample always replaces it.
+                        if (!(countPerLoop >= minCountsPerLoop[c])) {
+                            minCountsPerLoop[c] = countPerLoop;
+                        }
+                    }
+                }
+            };
+
+            int lowpPipelines, highpPipelines;
+            SkRasterPipeline::GetBuildCounts(&lowpPipelines, &highpPipelines);  // Resets them.
+
             if (FLAGS_ms) {
                 samples.reset();
                 auto stop = now_ms() + FLAGS_ms;
                 do {
-                    samples.push_back(time(loops, bench.get(), target) / loops);
+                    samples.push_back(time(loops, bench.get(), target, perfCounters.get()) / loops);
+                    if (perfCounters) {
+                        countSample();
+                    }
                 } while (now_ms() < stop);
             } else {
                 samples.reset(FLAGS_samples);
                 for (int s = 0; s < FLAGS_samples; s++) {
-                    samples[s] = time(loops, bench.get(), target) / loops;
+                    samples[s] = time(loops, bench.get(), target, perfCounters.get()) / loops;
+                    if (perfCounters) {
+                        countSample();
+                    }
                 }
             }
 
+            SkRasterPipeline::GetBuildCounts(&lowpPipelines, &highpPipelines);
+            const double sampledLoops = (double)loops * samples.count();
+
             SkTArray<SkString> keys;
             SkTArray<double> values;
             bool gpuStatsDump = FLAGS_gpuStatsDump && Benchmark::kGPU_Backend == configs[i].backend;
@@ -1307,6 +1384,22 @@ int main(int argc, char** argv) {
                 log.appendDoubleDigits(sample, 16);
             }
             log.endArray(); // samples
+            if (perfCounters) {
+                // appendMetric() skips the counters that never got a count.
+                log.beginObject("perf_counters");
+                for (int c = 0; c < sk_tools::PerfCounters::kCount; ++c) {
+                    log.appendMetric(
+                            sk_tools::PerfCounters::Name((sk_tools::PerfCounters::Counter)c),
+                            minCountsPerLoop[c]);
+                }
+                log.endObject(); // perf_counters
+            }
+            if (FLAGS_pipelineStats) {
+                log.beginObject("raster_pipelines");
+                log.appendMetric("lowp_per_loop", lowpPipelines / sampledLoops);
+                log.appendMetric("highp_per_loop", highpPipelines / sampledLoops);
+                log.endObject(); // raster_pipelines
+            }
             benchStream.fillCurrentMetrics(log);
             if (gpuStatsDump) {
                 // dump to json, only SKPBench currently returns valid keys / values
@@ -1375,6 +1468,12 @@ int main(int argc, char** argv) {
                 target->dumpStats();
             }
 
+            if (FLAGS_pipelineStats) {
+                SkDebugf("raster pipelines per loop: %g lowp, %g highp\t%s\n",
+                         lowpPipelines / sampledLoops, highpPipelines / sampledLoops,
+                         bench->getUniqueName());
+            }
+
             if (FLAGS_verbose) {
                 SkDebugf("Samples:  ");
                 for (int i = 0; i < samples.count(); i++) {
@@ -1359,7 +1359,7 @@ int main(int argc, char** argv) {
 
     JsonWriter::DumpJson();  // It's handy for the bots to assume this is ~never missing.
     SkAutoGraphics ag;
-    SkTaskGroup::Enabler enabled(FLAGS_threads);
+    SkTaskGroup::Enabler enabled(FLAGS_threads, FLAGS_workStealing);
 
     if (nullptr == GetResourceAsData("images/color_wheel.png")) {
         info("Some resources are missing.  Do you need to set --resourcePath?\n");
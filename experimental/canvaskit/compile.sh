@@ -40,6 +40,15 @@ fi
 
 mkdir -p $BUILD_DIR
 
+# SIMD is off by default, since not every browser can load a WASM SIMD module yet.
+SIMD_CFLAGS="\"-DSKNX_NO_SIMD\","
+SIMD_CONF=""
+if [[ $@ == *simd* ]]; then
+  echo "Building with WASM SIMD; feature-detect it before loading this build"
+  SIMD_CFLAGS="\"-msimd128\","
+  SIMD_CONF="-msimd128"
+fi
+
 GN_GPU="skia_enable_gpu=true"
 GN_GPU_FLAGS="\"-DIS_WEBGL=1\", \"-DSK_DISABLE_LEGACY_SHADERCONTEXT\","
 WASM_GPU="-lEGL -lGLESv2 -DSK_SUPPORT_GPU=1 \
@@ -104,8 +113,9 @@ fi
 
 BUILTIN_FONT="$BASE_DIR/fonts/NotoMono-Regular.ttf.cpp"
 if [[ $@ == *no_font* ]]; then
-  echo "Omitting the built-in font(s)"
-  BUILTIN_FONT=""
+  echo "Omitting the built-in font(s); load fonts at runtime with SkFontMgr.FetchTypeface"
+  # The wasm font manager still wants an SK_EMBEDDED_FONTS table, so give it an empty one.
+  BUILTIN_FONT="$BASE_DIR/no_embedded_fonts.cpp"
 else
   # Generate the font's binary file (which is covered by .gitignore)
   python tools/embed_resources.py \
@@ -133,7 +143,7 @@ echo "Compiling bitcode"
   cxx=\"${EMCXX}\" \
   extra_cflags_cc=[\"-frtti\"] \
   extra_cflags=[\"-s\",\"USE_FREETYPE=1\",\"-s\",\"USE_LIBPNG=1\", \"-s\", \"WARN_UNALIGNED=1\",
-    \"-DSKNX_NO_SIMD\", \"-DSK_DISABLE_AAA\", \"-DSK_DISABLE_DAA\", \"-DSK_DISABLE_READBUFFER\",
+    ${SIMD_CFLAGS} \"-DSK_DISABLE_AAA\", \"-DSK_DISABLE_DAA\", \"-DSK_DISABLE_READBUFFER\",
     \"-DSK_DISABLE_EFFECT_DESERIALIZATION\",
     ${GN_GPU_FLAGS}
     ${EXTRA_CFLAGS}
@@ -180,6 +190,7 @@ echo "Generating final wasm"
 # Emscripten will use LLD, which may relax this requirement.
 ${EMCXX} \
     $RELEASE_CONF \
+    $SIMD_CONF \
     -Iexperimental \
     -Iinclude/c \
     -Iinclude/codec \
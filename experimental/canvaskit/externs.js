@@ -475,6 +475,8 @@ CanvasKit.SkCanvas.prototype.readPixels = function() {};
 CanvasKit.SkCanvas.prototype.writePixels = function() {};
 
 CanvasKit.SkFontMgr.prototype.MakeTypefaceFromData = function() {};
+/** @return {Promise} */
+CanvasKit.SkFontMgr.prototype.FetchTypeface = function() {};
 
 // Define StrokeOpts object
 var StrokeOpts = {};
@@ -490,6 +492,8 @@ HTMLCanvas.prototype.decodeImage = function() {};
 HTMLCanvas.prototype.dispose = function() {};
 HTMLCanvas.prototype.getContext = function() {};
 HTMLCanvas.prototype.loadFont = function() {};
+/** @return {Promise} */
+HTMLCanvas.prototype.loadFontFromURL = function() {};
 HTMLCanvas.prototype.makePath2D = function() {};
 HTMLCanvas.prototype.toDataURL = function() {};
 
@@ -32,6 +32,17 @@ function HTMLCanvas(skSurface) {
     addToFontCache(newFont, descriptors);
   }
 
+  // Like loadFont, but fetches the font from url first. Returns a Promise that
+  // resolves once the font can be used by name in context.font.
+  this.loadFontFromURL = function(url, descriptors) {
+    var self = this;
+    return fetch(url).then(function(resp) {
+      return resp.arrayBuffer();
+    }).then(function(buffer) {
+      self.loadFont(buffer, descriptors);
+    });
+  }
+
   this.makePath2D = function(path) {
     var p2d = new Path2D(path);
     this._toCleanup.push(p2d._getPath());
@@ -464,6 +464,21 @@
       return font;
     }
 
+    // Fetches the font at url and decodes it with MakeTypefaceFromData, so builds made
+    // with no_font only pay for the fonts a page actually uses.  Returns a Promise that
+    // resolves to the SkTypeface, or to null if the data was not a usable font.
+    CanvasKit.SkFontMgr.prototype.FetchTypeface = function(url) {
+      var fontMgr = this;
+      return fetch(url).then(function(resp) {
+        if (!resp.ok) {
+          throw 'Could not fetch font ' + url + ': ' + resp.status;
+        }
+        return resp.arrayBuffer();
+      }).then(function(buffer) {
+        return fontMgr.MakeTypefaceFromData(buffer);
+      });
+    }
+
     CanvasKit.SkTextBlob.MakeFromText = function(str, font) {
       // lengthBytesUTF8 and stringToUTF8Array are defined in the emscripten
       // JS.  See https://kripken.github.io/emscripten-site/docs/api_reference/preamble.js.html#stringToUTF8
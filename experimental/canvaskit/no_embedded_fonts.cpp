@@ -0,0 +1,18 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Linked in place of the generated fonts/*.ttf.cpp when building with no_font.
+// The embedded font manager sees zero entries and only has an empty default family;
+// clients fetch the fonts they need at runtime and hand them to
+// SkFontMgr.MakeTypefaceFromData (or SkFontMgr.FetchTypeface).
+struct SkEmbeddedResource { const uint8_t* data; size_t size; };
+struct SkEmbeddedResourceHeader { const SkEmbeddedResource* entries; int count; };
+
+extern "C" const SkEmbeddedResourceHeader SK_EMBEDDED_FONTS = { nullptr, 0 };
@@ -193,6 +193,7 @@ public:
             : fZeroInitialized(SkCodec::kNo_ZeroInitialized)
             , fSubset(nullptr)
             , fSampleSize(1)
+            , fBoxFilter(false)
         {}
 
         /**
@@ -222,6 +223,18 @@ public:
          *  The default is 1, representing no downscaling.
          */
         int fSampleSize;
+
+        /**
+         *  If true, a downscale that is implemented by sampling averages each block of
+         *  sampled pixels rather than keeping one pixel from it.  This avoids aliasing in
+         *  thumbnails, at the cost of decoding every row of the image.
+         *
+         *  Only supported for top-down scanline decodes to opaque or premultiplied
+         *  kRGBA_8888 or kBGRA_8888.  Other decodes point sample.
+         *
+         *  The default is false.
+         */
+        bool fBoxFilter;
     };
 
     /**
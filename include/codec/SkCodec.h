@@ -26,6 +26,7 @@
 
 class SkColorSpace;
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkPngChunkReader;
 class SkSampler;
@@ -257,6 +258,7 @@ public:
             , fSubset(nullptr)
             , fFrameIndex(0)
             , fPriorFrame(kNoFrame)
+            , fExecutor(nullptr)
         {}
 
         ZeroInitialized            fZeroInitialized;
@@ -300,6 +302,22 @@ public:
          *  If set to kNoFrame, the codec will decode any necessary required frame(s) first.
          */
         int                        fPriorFrame;
+
+        /**
+         *  If not NULL, getPixels may split the image into horizontal strips and
+         *  decode them concurrently on this executor, blocking until all of them
+         *  are done. This requires a stream that can be duplicated, and is only
+         *  attempted for full, unscaled, single-frame decodes of formats whose
+         *  rows can be produced independently (baseline JPEG, non-interlaced PNG).
+         *  Otherwise, or if any strip fails, the image is decoded on the calling
+         *  thread as usual.
+         *
+         *  WebP decodes instead let libwebp run its filtering on a worker thread of
+         *  its own, alongside the decode.
+         *
+         *  Ignored by scanline and incremental decodes.
+         */
+        SkExecutor*                fExecutor;
     };
 
     /**
@@ -890,6 +908,19 @@ private:
 
     virtual int onGetScanlines(void* /*dst*/, int /*countLines*/, size_t /*rowBytes*/) { return 0; }
 
+    /**
+     *  Return true if a fresh codec on a duplicate of the stream can decode any
+     *  band of rows on its own, either through scanline decoding or through an
+     *  incremental decode of a full-width fSubset.
+     */
+    virtual bool onCanDecodeInStrips() const { return false; }
+
+    /**
+     *  Try to decode the whole image in strips on options.fExecutor. Returns false,
+     *  with the contents of pixels unspecified, if the strips could not all be decoded.
+     */
+    bool decodeInStrips(const SkImageInfo&, void* pixels, size_t rowBytes, const Options&);
+
     /**
      * On an incomplete decode, getPixels() and getScanlines() will call this function
      * to fill any uinitialized memory.
@@ -224,6 +224,9 @@ private:
     SkColorSpace(const float transferFn[7],
                  const skcms_Matrix3x3& toXYZ);
 
+    // Returns an existing color space identical to cs if we have one, otherwise cs.
+    static sk_sp<SkColorSpace> Intern(sk_sp<SkColorSpace> cs);
+
     void computeLazyDstFields() const;
 
     uint32_t                            fTransferFnHash;
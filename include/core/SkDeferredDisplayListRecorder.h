@@ -19,6 +19,7 @@ class GrBackendTexture;
 class GrContext;
 class SkCanvas;
 class SkImage;
+class SkPromiseImageBatch;
 class SkPromiseImageTexture;
 class SkSurface;
 struct SkYUVAIndex;
@@ -50,7 +51,14 @@ public:
     // Note: ownership of the SkCanvas is not transferred via this call.
     SkCanvas* getCanvas();
 
-    std::unique_ptr<SkDeferredDisplayList> detach();
+    enum class Retain : bool { kNo = false, kYes = true };
+
+    // A retained DDL can be drawn into the same destination on any number of frames. Its ops are
+    // prepared when it is first flushed and their vertex and index data stay in GPU buffers, so
+    // later draws only reissue the draws. A DDL whose ops depend on state that changes between
+    // flushes (e.g., text and paths drawn through the atlases) is dropped after its first flush
+    // like any other, and SkSurface::draw() fails when it is drawn again.
+    std::unique_ptr<SkDeferredDisplayList> detach(Retain = Retain::kNo);
 
     using PromiseImageTextureContext = void*;
     using PromiseImageTextureFulfillProc =
@@ -58,6 +66,15 @@ public:
     using PromiseImageTextureReleaseProc = void (*)(PromiseImageTextureContext);
     using PromiseImageTextureDoneProc = void (*)(PromiseImageTextureContext);
 
+    using PromiseImageTextureBatchContext = void*;
+    // Sets textures[i] to the texture for textureContexts[i]. A null texture is treated like a
+    // null return from the textureFulfillProc.
+    using PromiseImageTextureBatchFulfillProc =
+            void (*)(PromiseImageTextureBatchContext,
+                     const PromiseImageTextureContext textureContexts[],
+                     sk_sp<SkPromiseImageTexture> textures[],
+                     int count);
+
     // Deprecated types. To be removed.
     using LegacyPromiseImageTextureFulfillProc = void (*)(PromiseImageTextureContext,
                                                           GrBackendTexture*);
@@ -195,8 +212,31 @@ public:
                 textureDoneProc, textureContexts, DelayReleaseCallback::kNo);
     }
 
+    /**
+        Makes the promise images created after this call (and each plane of the YUVA ones) be
+        fulfilled together. When the SkDeferredDisplayList detached from this recorder is drawn
+        with SkSurface::draw(), batchFulfillProc is called once with the textureContexts of
+        those images that aren't already fulfilled, before any of the DDL's work executes. The
+        images then use those textures instead of calling their textureFulfillProc. Their
+        textureReleaseProc and textureDoneProc are called as described above. A texture the
+        batch fulfilled for an image the DDL doesn't draw is kept for the image's next draw, or
+        released once the image, the DDL and this recorder are all deleted.
+
+        A promise image is fulfilled at most once per flush in either case, however many draws
+        of it the flush contains.
+
+        @param batchFulfillProc  function called to get the textures of all images at once
+        @param batchContext      state passed to batchFulfillProc
+     */
+    void setPromiseImageBatchFulfillProc(PromiseImageTextureBatchFulfillProc batchFulfillProc,
+                                         PromiseImageTextureBatchContext batchContext);
+
 private:
     bool init();
+#if SK_SUPPORT_GPU
+    // Returns null if there is no batch fulfill proc.
+    SkPromiseImageBatch* promiseImageBatch();
+#endif
 
     const SkSurfaceCharacterization             fCharacterization;
 
@@ -204,6 +244,9 @@ private:
     sk_sp<GrContext>                            fContext;
     sk_sp<SkDeferredDisplayList::LazyProxyData> fLazyProxyData;
     sk_sp<SkSurface>                            fSurface;
+    PromiseImageTextureBatchFulfillProc         fPromiseImageBatchFulfillProc = nullptr;
+    PromiseImageTextureBatchContext             fPromiseImageBatchContext = nullptr;
+    sk_sp<SkPromiseImageBatch>                  fPromiseImageBatch;
 #endif
 };
 
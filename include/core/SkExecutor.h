@@ -19,13 +19,27 @@ public:
     static std::unique_ptr<SkExecutor> MakeFIFOThreadPool(int threads = 0);
     static std::unique_ptr<SkExecutor> MakeLIFOThreadPool(int threads = 0);
 
+    // Like the thread pools above, but each thread keeps its own deque of work.  Work added
+    // from one of the pool's threads stays on that thread's deque, and idle threads steal.
+    static std::unique_ptr<SkExecutor> MakeWorkStealingThreadPool(int threads = 0);
+
     // There is always a default SkExecutor available by calling SkExecutor::GetDefault().
     static SkExecutor& GetDefault();
     static void SetDefault(SkExecutor*);  // Does not take ownership.  Not thread safe.
 
+    // Waiting work of higher priority runs before waiting work of lower priority.  Work that has
+    // already started is never interrupted.
+    enum class Priority { kLow, kNormal, kHigh };
+    static constexpr int kPriorityCount = 3;
+
     // Add work to execute.
     virtual void add(std::function<void(void)>) = 0;
 
+    // Add work to execute at the given priority.  By default priorities are ignored.
+    virtual void addWithPriority(std::function<void(void)> work, Priority) {
+        this->add(std::move(work));
+    }
+
     // If it makes sense for this executor, use this thread to execute work for a little while.
     virtual void borrow() {}
 };
@@ -151,6 +151,33 @@ public:
      */
     static void PurgeAllCaches();
 
+    /**
+     *  How short the system is on memory, from the client's point of view.
+     */
+    enum class MemoryPressureLevel {
+        kNone,
+        kModerate,  // Drop what is cheapest to recreate.
+        kHigh,      // Drop everything but what is most expensive to recreate.
+        kCritical,  // Drop everything that is not in use.
+    };
+
+    /**
+     *  Tells Skia the system is running low on memory, e.g. from Android's onTrimMemory(), Linux
+     *  PSI or a macOS memory pressure dispatch source. May be called on any thread.
+     *
+     *  Global caches are trimmed right away, in order of cost to recreate: glyph strikes first,
+     *  then image filter results, then decoded and scaled images. Each GrContext trims its own
+     *  caches (scratch resources, then coverage counting path masks and glyph atlases, then
+     *  uniquely keyed resources) the next time it is flushed or GrContext::performDeferredCleanup()
+     *  is called on its thread.
+     */
+    static void NotifyMemoryPressure(MemoryPressureLevel);
+
+    /**
+     *  Maps an Android ComponentCallbacks2.onTrimMemory() level to a MemoryPressureLevel.
+     */
+    static MemoryPressureLevel MemoryPressureLevelFromAndroidTrimLevel(int trimLevel);
+
     /**
      *  Applications with command line options may pass optional state, such
      *  as cache sizes, here, for instance:
@@ -177,13 +177,19 @@ public:
     static sk_sp<SkImage> MakeFromEncoded(sk_sp<SkData> encoded, const SkIRect* subset = nullptr);
 
     enum CompressionType {
-        kETC1_CompressionType, //!< compressed data uses ETC1 compression
+        kETC1_CompressionType,      //!< compressed data uses ETC1 compression
+        kETC2_RGBA_CompressionType, //!< compressed data uses ETC2 compression with EAC alpha
+        kASTC_4x4_CompressionType,  //!< compressed data uses ASTC LDR compression, 4x4 blocks
+        kBC1_CompressionType,       //!< compressed data uses BC1 (DXT1) compression, 1-bit alpha
+        kBC3_CompressionType,       //!< compressed data uses BC3 (DXT5) compression
+        kBC7_CompressionType,       //!< compressed data uses BC7 (BPTC) compression
     };
 
     /** Creates a GPU-backed SkImage from compressed data.
 
         SkImage is returned if format of the compressed data is supported.
-        Supported formats vary by platform.
+        Supported formats vary by platform. SkImage is opaque if type is kETC1_CompressionType,
+        and premultiplied otherwise.
 
         @param context  GPU context
         @param data     compressed data to store in SkImage
@@ -564,6 +570,28 @@ public:
             SkAlphaType alphaType = kPremul_SkAlphaType,
             sk_sp<SkColorSpace> colorSpace = nullptr,
             GrSurfaceOrigin surfaceOrigin = kTopLeft_GrSurfaceOrigin);
+
+    /** Creates raster SkImage that maps the pixels of Android hardware buffer, without copying.
+        The buffer is locked for CPU reads until the returned SkImage is deleted, and the
+        SkImage takes a reference on the buffer for that time.
+
+        Returns nullptr if the buffer was not allocated with one of the
+        AHARDWAREBUFFER_USAGE_CPU_READ usages, if its format has no matching SkColorType,
+        or if it cannot be locked.
+
+        Only available on Android, when __ANDROID_API__ is defined to be 26 or greater.
+
+        @param hardwareBuffer  AHardwareBuffer Android hardware buffer
+        @param alphaType       one of:
+                               kUnknown_SkAlphaType, kOpaque_SkAlphaType, kPremul_SkAlphaType,
+                               kUnpremul_SkAlphaType
+        @param colorSpace      range of colors; may be nullptr
+        @return                created SkImage, or nullptr
+    */
+    static sk_sp<SkImage> MakeRasterFromAHardwareBuffer(
+            AHardwareBuffer* hardwareBuffer,
+            SkAlphaType alphaType = kPremul_SkAlphaType,
+            sk_sp<SkColorSpace> colorSpace = nullptr);
 #endif
 
     /** Returns pixel count in each row.
@@ -916,6 +944,51 @@ public:
     sk_sp<SkImage> makeTextureImage(GrContext* context, SkColorSpace* dstColorSpace,
                                     GrMipMapped mipMapped = GrMipMapped::kNo) const;
 
+    /** User function called when the texture of an SkImage returned by makeTextureImageAsync()
+        has been uploaded.
+    */
+    typedef void (*TextureReadyProc)(ReleaseContext readyContext);
+
+    /** Like makeTextureImage(), but returns without decoding or uploading pixels. If context
+        was created with GrContextOptions::fExecutor, SkImage is decoded (if lazy) and converted
+        on that executor, and its pixels are uploaded during the first flush that draws the
+        returned SkImage. Otherwise, this is the same as makeTextureImage().
+
+        The returned SkImage may be drawn right away; the flush waits for the decode if it has
+        not finished. readyProc, if not nullptr, is called with readyContext once the upload has
+        been issued, or when the returned SkImage is deleted without ever being drawn. readyProc
+        is called right away if no work was deferred.
+
+        Returns nullptr if context is nullptr, or if SkImage was created with another
+        GrContext; readyProc is not called in that case.
+
+        @param context        GPU context
+        @param dstColorSpace  range of colors of matching SkSurface on GPU
+        @param readyProc      function called when the texture is uploaded; may be nullptr
+        @param readyContext   state passed to readyProc
+        @return               created SkImage, or nullptr
+    */
+    sk_sp<SkImage> makeTextureImageAsync(GrContext* context, SkColorSpace* dstColorSpace,
+                                         TextureReadyProc readyProc = nullptr,
+                                         ReleaseContext readyContext = nullptr) const;
+
+    /** Like makeTextureImageAsync(), but the texture is compressed on context's executor before
+        it is uploaded, which takes a quarter to a sixth of the GPU memory of an uncompressed
+        texture and is cheaper to sample. Only opaque SkImage is compressed, to ETC1, and only
+        if context supports ETC1 textures; otherwise, this is the same as makeTextureImageAsync().
+
+        Compression is lossy; use this for photographs and other images without sharp edges.
+
+        @param context        GPU context
+        @param dstColorSpace  range of colors of matching SkSurface on GPU
+        @param readyProc      function called when the texture is uploaded; may be nullptr
+        @param readyContext   state passed to readyProc
+        @return               created SkImage, or nullptr
+    */
+    sk_sp<SkImage> makeCompressedTextureImageAsync(GrContext* context, SkColorSpace* dstColorSpace,
+                                                   TextureReadyProc readyProc = nullptr,
+                                                   ReleaseContext readyContext = nullptr) const;
+
     /** Returns raster image or lazy image. Copies SkImage backed by GPU texture into
         CPU memory if needed. Returns original SkImage if decoded in raster bitmap,
         or if encoded in a stream.
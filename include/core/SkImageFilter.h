@@ -22,6 +22,7 @@ class GrContext;
 class GrFragmentProcessor;
 class SkColorFilter;
 class SkColorSpaceXformer;
+class SkExecutor;
 struct SkIPoint;
 class SkSpecialImage;
 class SkImageFilterCache;
@@ -58,11 +59,12 @@ public:
     class Context {
     public:
         Context(const SkMatrix& ctm, const SkIRect& clipBounds, SkImageFilterCache* cache,
-                const OutputProperties& outputProperties)
+                const OutputProperties& outputProperties, SkExecutor* executor = nullptr)
             : fCTM(ctm)
             , fClipBounds(clipBounds)
             , fCache(cache)
             , fOutputProperties(outputProperties)
+            , fExecutor(executor)
         {}
 
         const SkMatrix& ctm() const { return fCTM; }
@@ -70,6 +72,10 @@ public:
         SkImageFilterCache* cache() const { return fCache; }
         const OutputProperties& outputProperties() const { return fOutputProperties; }
 
+        // If non-null, filters working on raster images may spread their work over this
+        // executor, so the cache will be used from several threads at once.
+        SkExecutor* executor() const { return fExecutor; }
+
         /**
          *  Since a context can be build directly, its constructor has no chance to
          *  "return null" if it's given invalid or unsupported inputs. Call this to
@@ -85,6 +91,7 @@ public:
         SkIRect                fClipBounds;
         SkImageFilterCache*    fCache;
         OutputProperties       fOutputProperties;
+        SkExecutor*            fExecutor;
     };
 
     class CropRect {
@@ -245,6 +252,13 @@ public:
      */
     bool canHandleComplexCTM() const;
 
+    /**
+     *  Returns true if this filter and all of its (non-null) inputs produce the same pixels
+     *  inside a clip no matter where its edges fall, so that the output can be filtered in
+     *  separate tiles.
+     */
+    bool canFilterInTiles() const;
+
     /**
      * Return an imagefilter which transforms its input by the given matrix.
      */
@@ -380,6 +394,15 @@ protected:
                                       const Context&,
                                       SkIPoint* offset) const;
 
+    // Calls filterInput() for each of the first "count" inputs, storing the results and offsets.
+    // When the context has an executor and src is a raster image, distinct inputs are filtered
+    // in parallel. Inputs that are the same filter are only filtered once.
+    void filterInputs(int count,
+                      SkSpecialImage* src,
+                      const Context&,
+                      sk_sp<SkSpecialImage> results[],
+                      SkIPoint offsets[]) const;
+
     /**
      *  Return true (and return a ref'd colorfilter) if this node in the DAG is just a
      *  colorfilter w/o CropRect constraints.
@@ -388,12 +411,25 @@ protected:
         return false;
     }
 
+    /**
+     *  Override this to return a filter that produces this node's output drawn through cf,
+     *  without first rendering this node's output into an intermediate image, e.g. by folding cf
+     *  into a paint. cf never affects transparent black. Return null if there is no such filter.
+     */
+    virtual sk_sp<SkImageFilter> onMakeWithColorFilter(sk_sp<SkColorFilter>) const;
+
     /**
      *  Override this to describe the behavior of your subclass - as a leaf node. The caller will
      *  take care of calling your inputs (and return false if any of them could not handle it).
      */
     virtual bool onCanHandleComplexCTM() const { return false; }
 
+    /**
+     *  Override this to return false if, as a leaf node, your subclass's pixels depend on where
+     *  the clip bounds fall, e.g. because it treats the edges of its output as image edges.
+     */
+    virtual bool onCanFilterInTiles() const { return true; }
+
     /** Given a "srcBounds" rect, computes destination bounds for this filter.
      *  "dstBounds" are computed by transforming the crop rect by the context's
      *  CTM, applying it to the initial bounds, and intersecting the result with
@@ -456,6 +492,7 @@ protected:
 
 private:
     // For makeColorSpace().
+    friend class SkColorFilterImageFilter;
     friend class SkColorSpaceXformer;
 
     friend class SkGraphics;
@@ -1433,6 +1433,21 @@ public:
     */
     bool mapRect(SkRect* dst, const SkRect& src) const;
 
+    /** Sets each dst SkRect to bounds of the corresponding src corners mapped by SkMatrix.
+        Returns true if mapped corners are dst corners. Mapping many rects at once is
+        faster than calling mapRect() for each.
+
+        Returned value is the same as calling rectStaysRect().
+
+        src and dst may point to the same storage.
+
+        @param dst    storage for bounds of mapped SkPoint
+        @param src    SkRect array to map
+        @param count  number of SkRect to map
+        @return       true if each dst is equivalent to mapped src
+    */
+    bool mapRects(SkRect dst[], const SkRect src[], int count) const;
+
     /** Sets rect to bounds of rect corners mapped by SkMatrix.
         Returns true if mapped corners are computed rect corners.
 
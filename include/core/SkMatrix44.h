@@ -428,6 +428,15 @@ public:
     void map2(const float src2[], int count, float dst4[]) const;
     void map2(const double src2[], int count, double dst4[]) const;
 
+    /**
+     *  map an array of [x, y, z, w] through the matrix, as mapScalars() would map each one.
+     *
+     *  @param src4     array of [x, y, z, w] quads
+     *  @param count    number of quads in src4
+     *  @param dst4     array of [x', y', z', w'] quads as the output; may equal src4.
+     */
+    void map4(const float src4[], int count, float dst4[]) const;
+
     /** Returns true if transformating an axis-aligned square in 2d by this matrix
         will produce another 2d axis-aligned square; typically means the matrix
         is a scale with perhaps a 90-degree rotation. A 3d rotation through 90
@@ -12,6 +12,7 @@
 #include "SkMatrix.h"
 
 class SkCanvas;
+class SkExecutor;
 class SkPaint;
 class SkPicture;
 
@@ -47,8 +48,15 @@ public:
      *  Perform all the previously added draws. This will reset the state
      *  of this object. If flush is true, all canvases are flushed after
      *  draw.
+     *
+     *  Draws to raster canvases are run on 'executor' (or the default
+     *  SkExecutor if null), one task per canvas, so pictures landing on
+     *  different canvases replay in parallel. Draws to GPU canvases run on
+     *  the calling thread, grouped by canvas to limit render target switches.
+     *  Either way, the pictures added for one canvas are drawn in the order
+     *  they were added.
      */
-    void draw(bool flush = false);
+    void draw(bool flush = false, SkExecutor* executor = nullptr);
 
     /**
      *  Abandon all buffered draws and reset to the initial state.
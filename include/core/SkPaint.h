@@ -413,7 +413,7 @@ public:
 
         @return  SkShader if previously set, nullptr otherwise
     */
-    SkShader* getShader() const { return fShader.get(); }
+    SkShader* getShader() const { return fEffects ? fEffects->fShader.get() : nullptr; }
 
     /** Returns optional colors used when filling a path, such as a gradient.
 
@@ -437,7 +437,7 @@ public:
 
         @return  SkColorFilter if previously set, nullptr otherwise
     */
-    SkColorFilter* getColorFilter() const { return fColorFilter.get(); }
+    SkColorFilter* getColorFilter() const { return fEffects ? fEffects->fColorFilter.get() : nullptr; }
 
     /** Returns SkColorFilter if set, or nullptr.
         Increases SkColorFilter SkRefCnt by one.
@@ -480,7 +480,7 @@ public:
 
         @return  SkPathEffect if previously set, nullptr otherwise
     */
-    SkPathEffect* getPathEffect() const { return fPathEffect.get(); }
+    SkPathEffect* getPathEffect() const { return fEffects ? fEffects->fPathEffect.get() : nullptr; }
 
     /** Returns SkPathEffect if set, or nullptr.
         Increases SkPathEffect SkRefCnt by one.
@@ -503,7 +503,7 @@ public:
 
         @return  SkMaskFilter if previously set, nullptr otherwise
     */
-    SkMaskFilter* getMaskFilter() const { return fMaskFilter.get(); }
+    SkMaskFilter* getMaskFilter() const { return fEffects ? fEffects->fMaskFilter.get() : nullptr; }
 
     /** Returns SkMaskFilter if set, or nullptr.
 
@@ -528,7 +528,7 @@ public:
 
         @return  SkImageFilter if previously set, nullptr otherwise
     */
-    SkImageFilter* getImageFilter() const { return fImageFilter.get(); }
+    SkImageFilter* getImageFilter() const { return fEffects ? fEffects->fImageFilter.get() : nullptr; }
 
     /** Returns SkImageFilter if set, or nullptr.
         Increases SkImageFilter SkRefCnt by one.
@@ -552,7 +552,7 @@ public:
 
         @return  SkDrawLooper if previously set, nullptr otherwise
     */
-    SkDrawLooper* getDrawLooper() const { return fDrawLooper.get(); }
+    SkDrawLooper* getDrawLooper() const { return fEffects ? fEffects->fDrawLooper.get() : nullptr; }
 
     /** Returns SkDrawLooper if set, or nullptr.
         Increases SkDrawLooper SkRefCnt by one.
@@ -564,7 +564,7 @@ public:
     /** Deprecated.
         (see skbug.com/6259)
     */
-    SkDrawLooper* getLooper() const { return fDrawLooper.get(); }
+    SkDrawLooper* getLooper() const { return this->getDrawLooper(); }
 
     /** Sets SkDrawLooper to drawLooper, decreasing SkRefCnt of the previous
         drawLooper.  Pass nullptr to clear SkDrawLooper and leave SkDrawLooper effect on
@@ -667,12 +667,23 @@ public:
                                       Style style) const;
 
 private:
-    sk_sp<SkPathEffect>   fPathEffect;
-    sk_sp<SkShader>       fShader;
-    sk_sp<SkMaskFilter>   fMaskFilter;
-    sk_sp<SkColorFilter>  fColorFilter;
-    sk_sp<SkDrawLooper>   fDrawLooper;
-    sk_sp<SkImageFilter>  fImageFilter;
+    // The effects are immutable once shared: copies of a paint share them, and the first setter
+    // called on a copy gives it its own. fEffects is nullptr when the paint has no effects.
+    struct Effects : public SkNVRefCnt<Effects> {
+        sk_sp<SkPathEffect>   fPathEffect;
+        sk_sp<SkShader>       fShader;
+        sk_sp<SkMaskFilter>   fMaskFilter;
+        sk_sp<SkColorFilter>  fColorFilter;
+        sk_sp<SkDrawLooper>   fDrawLooper;
+        sk_sp<SkImageFilter>  fImageFilter;
+
+        bool isEmpty() const;
+    };
+
+    Effects* writableEffects();
+    template <typename T> void setEffect(sk_sp<T> Effects::* field, sk_sp<T> effect);
+
+    sk_sp<Effects>  fEffects;
 
     SkColor4f       fColor4f;
     SkScalar        fWidth;
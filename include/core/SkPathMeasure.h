@@ -108,6 +108,22 @@ private:
 
     static const Segment* NextSegment(const Segment*);
 
+    // These query one contour's segments, and are shared with SkMeasuredPath, which keeps the
+    // segments of every contour after measuring them once.
+    friend class SkMeasuredPath;
+
+    static const Segment* DistanceToSegment(const SkTDArray<Segment>&, SkScalar distance,
+                                            SkScalar* t);
+    static const Segment* InterpolateSegment(const SkTDArray<Segment>&, int index,
+                                             SkScalar distance, SkScalar* t);
+    static bool GetPosTan(const SkTDArray<Segment>&, const SkPoint pts[], SkScalar length,
+                          SkScalar distance, SkPoint* position, SkVector* tangent);
+    static bool GetPosTans(const SkTDArray<Segment>&, const SkPoint pts[], SkScalar length,
+                           const SkScalar distances[], int count, SkPoint positions[],
+                           SkVector tangents[]);
+    static bool GetSegment(const SkTDArray<Segment>&, const SkPoint pts[], SkScalar length,
+                           SkScalar startD, SkScalar stopD, SkPath* dst, bool startWithMoveTo);
+
     void     buildSegments();
     SkScalar compute_quad_segs(const SkPoint pts[3], SkScalar distance,
                                 int mint, int maxt, unsigned ptIndex);
@@ -116,7 +132,6 @@ private:
                                 int maxt, const SkPoint& maxPt, unsigned ptIndex);
     SkScalar compute_cubic_segs(const SkPoint pts[3], SkScalar distance,
                                 int mint, int maxt, unsigned ptIndex);
-    const Segment* distanceToSegment(SkScalar distance, SkScalar* t);
     bool quad_too_curvy(const SkPoint pts[3]);
     bool conic_too_curvy(const SkPoint& firstPt, const SkPoint& midTPt,const SkPoint& lastPt);
     bool cheap_dist_exceeds_limit(const SkPoint& pt, SkScalar x, SkScalar y);
@@ -39,6 +39,10 @@ public:
     };
 
     enum FinishFlags {
+        // Run extra optimization passes over the recording: culling draws that later opaque draws
+        // cover, merging runs of image draws, and dropping redundant matrix and clip changes.
+        // This makes finishing slower, and pays off for pictures that are played back many times.
+        kOptimizeForPlayback_FinishFlag     = 1 << 0,
     };
 
     /** Returns the canvas that records the drawing commands.
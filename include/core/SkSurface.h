@@ -418,6 +418,19 @@ public:
     */
     void notifyContentWillChange(ContentChangeMode mode);
 
+    /** Limits drawing to damage, for clients that redraw only the part of SkSurface that
+        changed. Pixels outside of damage keep their contents. All drawing through getCanvas() is
+        clipped to damage, which on GPU backends that have render areas (Vulkan) also restricts
+        the render passes, so only the damaged part of the surface is loaded and stored.
+
+        damage replaces the previous damage rect, and resets the clip of getCanvas(). Call this
+        before drawing a frame, when getCanvas() has no outstanding saves. Pass an empty rect to
+        draw to all of SkSurface again.
+
+        @param damage  part of SkSurface that will be drawn, in device coordinates
+    */
+    void setDamageRect(const SkIRect& damage);
+
     enum BackendHandleAccess {
         kFlushRead_BackendHandleAccess,    //!< back-end object is readable
         kFlushWrite_BackendHandleAccess,   //!< back-end object is writable
@@ -621,6 +634,56 @@ public:
     */
     bool readPixels(const SkBitmap& dst, int srcX, int srcY);
 
+    /** Client-provided context passed to the asyncReadPixels() callbacks. */
+    typedef void* ReadPixelsContext;
+
+    /** Receives the pixels read by asyncReadPixels(), or nullptr if the read failed. The pixels
+        are only valid for the duration of the call.
+    */
+    typedef void (*ReadPixelsCallback)(ReadPixelsContext context, const void* data,
+                                       size_t rowBytes);
+
+    /** Receives the Y, U and V planes read by asyncReadPixelsYUV420(), or nullptr data if the
+        read failed. The planes are only valid for the duration of the call.
+    */
+    typedef void (*ReadPixelsYUV420Callback)(ReadPixelsContext context, const void* data[3],
+                                             const size_t rowBytes[3]);
+
+    /** Reads the SkRect of pixels with corners (srcX, srcY) and
+        (srcX + dstInfo.width(), srcY + dstInfo.height()), converted to dstInfo, and passes them
+        to callback.
+
+        A raster SkSurface calls back before returning. A GPU SkSurface copies the pixels into a
+        transfer buffer without waiting for the GPU, and calls back from a later
+        GrContext::flush() or GrContext::checkAsyncWorkCompletion() once the copy has finished;
+        backends that can't do this read synchronously and call back before returning.
+
+        callback is always called exactly once. It receives nullptr data if the SkRect is not
+        contained in the SkSurface, the pixels can't be converted to dstInfo, or the GrContext
+        is abandoned or destroyed before the read finishes.
+
+        @param dstInfo   width, height, SkColorType, SkAlphaType and SkColorSpace of the pixels
+        @param srcX      offset into readable pixels on x-axis
+        @param srcY      offset into readable pixels on y-axis
+        @param callback  function to receive the pixels
+        @param context   passed to callback
+    */
+    void asyncReadPixels(const SkImageInfo& dstInfo, int srcX, int srcY,
+                         ReadPixelsCallback callback, ReadPixelsContext context);
+
+    /** Like asyncReadPixels(), but converts srcRect to YUV in yuvColorSpace and passes callback
+        three 8-bit planes: Y at srcRect's size, then U and V at half its width and height,
+        rounded up. Each U and V sample averages a 2x2 block of pixels. A GPU SkSurface does the
+        conversion and subsampling on the GPU, so only the planes are read back.
+
+        @param yuvColorSpace  YUV encoding to convert to
+        @param srcRect        SkRect of pixels to read; must be contained in the SkSurface
+        @param callback       function to receive the planes
+        @param context        passed to callback
+    */
+    void asyncReadPixelsYUV420(SkYUVColorSpace yuvColorSpace, const SkIRect& srcRect,
+                               ReadPixelsYUV420Callback callback, ReadPixelsContext context);
+
     /** Copies SkRect of pixels from the src SkPixmap to the SkSurface.
 
         Source SkRect corners are (0, 0) and (src.width(), src.height()).
@@ -729,8 +792,13 @@ public:
 
         raster surface returns false.
 
+        A deferredDisplayList may be drawn again after it has been flushed only if it was
+        detached with SkDeferredDisplayListRecorder::Retain::kYes, its ops could be retained,
+        and it is drawn into the same SkSurface; otherwise it has no effect and returns false.
+
         @param deferredDisplayList  drawing commands
-        @return                     false if deferredDisplayList is not compatible
+        @return                     false if deferredDisplayList is not compatible or was
+                                    consumed by an earlier flush
     */
     bool draw(SkDeferredDisplayList* deferredDisplayList);
 
@@ -398,6 +398,7 @@ private:
     SkAutoTMalloc<uint8_t> fStorage;
     size_t                 fStorageSize;
     size_t                 fStorageUsed;
+    size_t                 fStorageHint; // size of the last blob made, to presize the next
 
     SkRect                 fBounds;
     int                    fRunCount;
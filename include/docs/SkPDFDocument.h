@@ -142,6 +142,13 @@ struct Metadata {
     */
     int fEncodingQuality = 101;
 
+    /** If true, the compressed streams of images that cannot be embedded as
+        is are kept in the global resource cache, so that later documents
+        drawing the same image (the same SkImage, or an image from the same
+        encoded data) reuse them instead of compressing it again.
+    */
+    bool fCacheImageStreams = false;
+
     /** An optional tree of structured document tags that provide
         a semantic representation of the content. The caller
         should retain ownership.
@@ -28,6 +28,8 @@ protected:
     sk_sp<SkSpecialImage> onFilterImage(SkSpecialImage* source, const Context&,
                                         SkIPoint* offset) const override;
     sk_sp<SkImageFilter> onMakeColorSpace(SkColorSpaceXformer*) const override;
+    // The zoom and the lens are fitted to the output bounds.
+    bool onCanFilterInTiles() const override { return false; }
 
 private:
     SK_FLATTENABLE_HOOKS(SkMagnifierImageFilter)
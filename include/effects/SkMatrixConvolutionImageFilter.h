@@ -97,6 +97,10 @@ private:
     SkIPoint  fKernelOffset;
     TileMode  fTileMode;
     bool      fConvolveAlpha;
+    // When the kernel is the outer product of a row and a column, and it is big enough for that
+    // to be worth it, the row (width entries) followed by the column (height entries). Otherwise
+    // null.
+    SkScalar* fSeparableKernel;
 
     template <class PixelFetcher, bool convolveAlpha>
     void filterPixels(const SkBitmap& src,
@@ -110,6 +114,12 @@ private:
                       SkIVector& offset,
                       const SkIRect& rect,
                       const SkIRect& bounds) const;
+    template <bool convolveAlpha>
+    void filterSeparable(const SkBitmap& src,
+                         SkBitmap* result,
+                         SkIVector& offset,
+                         const SkIRect& rect,
+                         const SkIRect& bounds) const;
     void filterInteriorPixels(const SkBitmap& src,
                               SkBitmap* result,
                               SkIVector& offset,
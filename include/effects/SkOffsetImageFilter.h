@@ -27,6 +27,7 @@ protected:
     sk_sp<SkImageFilter> onMakeColorSpace(SkColorSpaceXformer*) const override;
     SkIRect onFilterNodeBounds(const SkIRect&, const SkMatrix& ctm,
                                MapDirection, const SkIRect* inputRect) const override;
+    sk_sp<SkImageFilter> onMakeWithColorFilter(sk_sp<SkColorFilter>) const override;
 
 private:
     SK_FLATTENABLE_HOOKS(SkOffsetImageFilter)
@@ -32,6 +32,7 @@ protected:
     sk_sp<SkSpecialImage> onFilterImage(SkSpecialImage* source, const Context&,
                                         SkIPoint* offset) const override;
     sk_sp<SkImageFilter> onMakeColorSpace(SkColorSpaceXformer* xformer) const override;
+    sk_sp<SkImageFilter> onMakeWithColorFilter(sk_sp<SkColorFilter>) const override;
 
 private:
     SK_FLATTENABLE_HOOKS(SkPaintImageFilter)
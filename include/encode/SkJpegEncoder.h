@@ -10,6 +10,7 @@
 
 #include "SkEncoder.h"
 
+class SkExecutor;
 class SkJpegEncoderMgr;
 class SkWStream;
 
@@ -61,6 +62,17 @@ public:
          *  In the second case, the encoder supports linear or legacy blending.
          */
         AlphaOption fAlphaOption = AlphaOption::kIgnore;
+
+        /**
+         *  If not null, Encode() splits the image into horizontal stripes, encodes them
+         *  concurrently on this executor, and stitches them into a single jpeg using restart
+         *  markers (one restart interval per row of MCUs).  The stripes share libjpeg-turbo's
+         *  standard Huffman tables rather than per-image optimized ones, so the output is
+         *  a few percent larger, but decodes to exactly the same pixels.
+         *
+         *  Ignored by Make() and EncodeYUV420().
+         */
+        SkExecutor* fExecutor = nullptr;
     };
 
     /**
@@ -71,6 +83,18 @@ public:
      */
     static bool Encode(SkWStream* dst, const SkPixmap& src, const Options& options);
 
+    /**
+     *  Encode already converted Y, U and V planes to the |dst| stream as a 4:2:0 jpeg, skipping
+     *  the RGB to YCbCr conversion and downsampling.  The planes must be kGray_8, use the
+     *  full range kJPEG_SkYUVColorSpace encoding, and U and V must be half the size of Y
+     *  (rounded up).
+     *
+     *  |options.fQuality| is honored, the other options are ignored.
+     *
+     *  Returns true on success.  Returns false on invalid or unsupported |planes|.
+     */
+    static bool EncodeYUV420(SkWStream* dst, const SkPixmap planes[3], const Options& options);
+
     /**
      *  Create a jpeg encoder that will encode the |src| pixels to the |dst| stream.
      *  |options| may be used to control the encoding behavior.
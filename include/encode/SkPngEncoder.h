@@ -12,6 +12,7 @@
 #include "SkDataTable.h"
 
 class SkPngEncoderMgr;
+class SkExecutor;
 class SkWStream;
 
 class SK_API SkPngEncoder : public SkEncoder {
@@ -59,6 +60,18 @@ public:
          *  and the (2i + 1)-th entry is the text for the i-th comment.
          */
         sk_sp<SkDataTable> fComments;
+
+        /**
+         *  If not null, Skia filters and compresses the rows itself instead of going through
+         *  libpng: each encodeRows() call is split into bands of rows that are filtered (with
+         *  SIMD where available) and deflated concurrently on this executor, then concatenated
+         *  into the IDAT stream.  This is much faster on large images, at the cost of slightly
+         *  larger files.  The output does not depend on the number of threads.
+         *
+         *  Only the kNone, kSub, kUp and kPaeth filters are used on this path; if
+         *  |fFilterFlags| selects none of them, libpng is used instead.
+         */
+        SkExecutor* fExecutor = nullptr;
     };
 
     /**
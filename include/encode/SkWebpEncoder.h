@@ -34,6 +34,12 @@ namespace SkWebpEncoder {
          */
         Compression fCompression = Compression::kLossy;
         float fQuality = 100.0f;
+
+        /**
+         *  If true, libwebp may use a worker thread of its own to speed up the encode.  The
+         *  encoded output is the same either way.
+         */
+        bool fUseThreads = false;
     };
 
     /**
@@ -8,6 +8,7 @@
 #ifndef GrContext_DEFINED
 #define GrContext_DEFINED
 
+#include "SkGraphics.h"
 #include "SkMatrix.h"
 #include "SkPathEffect.h"
 #include "SkTypes.h"
@@ -19,6 +20,7 @@
 // We shouldn't need this but currently Android is relying on this being include transitively.
 #include "SkUnPreMultiply.h"
 
+class GrAsyncReadbackManager;
 class GrAtlasManager;
 class GrBackendFormat;
 class GrBackendSemaphore;
@@ -38,6 +40,7 @@ class GrRenderTargetContext;
 class GrResourceCache;
 class GrResourceProvider;
 class GrSamplerState;
+class GrSharedShaderCache;
 class GrSkSLFPFactoryCache;
 class GrSurfaceProxy;
 class GrSwizzle;
@@ -47,6 +50,7 @@ class GrTextureProxy;
 struct GrVkBackendContext;
 
 class SkImage;
+class SkMemoryPressureObserver;
 class SkSurfaceProps;
 class SkTaskGroup;
 class SkTraceMemoryDump;
@@ -161,6 +165,31 @@ public:
      */
     void setResourceCacheLimits(int maxResources, size_t maxResourceBytes);
 
+    /**
+     *  Gives a category of cached resources a soft budget and an eviction weight. When the
+     *  cache is over its limits it first purges unlocked resources from categories that are
+     *  over their soft budgets, least recently used first. After that, it purges the unlocked
+     *  resource whose age divided by its category's eviction weight is greatest, so resources
+     *  that are expensive to recreate can be given a higher weight to keep them longer.
+     *
+     *  By default no category has a soft budget and all weights are 1, which is plain LRU.
+     *
+     *  @param softMaxBytes     Budgeted bytes the category may use before it is purged first.
+     *  @param evictionWeight   Must be greater than zero.
+     */
+    void setResourceCategoryBudget(GrResourceCategory, size_t softMaxBytes,
+                                   float evictionWeight = 1);
+
+    /**
+     *  Gets the current usage of a category of cached resources.
+     *
+     *  @param resourceCount If non-null, returns the number of budgeted resources in the
+     *                       category.
+     *  @param resourceBytes If non-null, returns the bytes of video memory they use.
+     */
+    void getResourceCategoryUsage(GrResourceCategory, int* resourceCount,
+                                  size_t* resourceBytes) const;
+
     /**
      * Frees GPU created by the context. Can be called to reduce GPU memory
      * pressure.
@@ -205,6 +234,17 @@ public:
      */
     void purgeUnlockedResources(bool scratchResourcesOnly);
 
+    /**
+     * Trims this context's caches for the given level of memory pressure, dropping what is
+     * cheapest to recreate first: unlocked scratch resources, then cached coverage counting path
+     * masks and glyph atlases, then uniquely keyed resources. kCritical is the same as
+     * freeGpuResources().
+     *
+     * SkGraphics::NotifyMemoryPressure() calls from any thread end up here as well, the next time
+     * this context is flushed or performDeferredCleanup() is called.
+     */
+    void trimForMemoryPressure(SkGraphics::MemoryPressureLevel);
+
     /**
      * Gets the maximum supported texture size.
      */
@@ -267,6 +307,13 @@ public:
     GrSemaphoresSubmitted flushAndSignalSemaphores(int numSemaphores,
                                                    GrBackendSemaphore signalSemaphores[]);
 
+    /**
+     * Calls back any asynchronous reads (e.g. SkSurface::asyncReadPixels) whose GPU work has
+     * finished. Never blocks. flush() and flushAndSignalSemaphores() also do this, so clients that
+     * flush every frame only need to call this when they're waiting on a read between frames.
+     */
+    void checkAsyncWorkCompletion();
+
     // Provides access to functions that aren't part of the public API.
     GrContextPriv contextPriv();
     const GrContextPriv contextPriv() const;
@@ -275,6 +322,38 @@ public:
     // Chrome is using this!
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
 
+    /**
+     * Dumps the maxCount largest cached GPU resources, largest first, with their category and
+     * owner. The dumps are named "skia/gpu_largest/<rank>" and their "resource_id" matches the
+     * resource's dump from dumpMemoryStatistics().
+     */
+    void dumpLargestResources(SkTraceMemoryDump* traceMemoryDump, int maxCount) const;
+
+    /**
+     * Counts of the work the context did. Unlike the stats printed for debugging, these are kept
+     * in release builds.
+     */
+    struct FrameStats {
+        int    fFlushes = 0;            //<! submissions of GPU work, as in flush().
+        int    fDraws = 0;              //<! draw calls issued to the backend.
+        int    fOpsMerged = 0;          //<! ops that were merged into others when recorded.
+        int    fProgramsCompiled = 0;   //<! programs (pipelines) whose shaders were compiled.
+        int    fShaderCacheHits = 0;    //<! draws whose program was already built.
+        int    fShaderCacheMisses = 0;  //<! draws that had to build their program.
+        int    fCompileStalls = 0;      //<! of those, draws that waited on a program the driver
+                                        //   was still compiling in parallel.
+        size_t fBytesUploaded = 0;      //<! texture pixels and vertex/index data written.
+        int    fAtlasFlushes = 0;       //<! draws that ended early because an atlas was full.
+        int    fResourcePurges = 0;     //<! resources the cache freed to stay in budget or when
+                                        //   asked to purge.
+    };
+
+    /**
+     * Returns the counts since the last call, or since the context was made. Calling it once per
+     * frame gives per-frame counts.
+     */
+    void readFrameStats(FrameStats*);
+
     bool supportsDistanceFieldText() const;
 
     void storeVkPipelineCacheData();
@@ -321,9 +400,20 @@ private:
 
     std::unique_ptr<GrDrawingManager>       fDrawingManager;
 
+    // Reads started by asyncReadSurfacePixels that are still waiting on the GPU.
+    std::unique_ptr<GrAsyncReadbackManager> fAsyncReadbacks;
+
     GrAuditTrail                            fAuditTrail;
 
     GrContextOptions::PersistentCache*      fPersistentCache;
+    // Stands in for fPersistentCache when GrContextOptions::fShareShaderCache is set.
+    std::unique_ptr<GrSharedShaderCache>    fSharedShaderCache;
+
+    // Picks up SkGraphics::NotifyMemoryPressure() calls; see checkMemoryPressure().
+    std::unique_ptr<SkMemoryPressureObserver> fMemoryPressureObserver;
+
+    // Applies any SkGraphics::NotifyMemoryPressure() calls made since the last check.
+    void checkMemoryPressure();
 
     // TODO: have the GrClipStackClip use renderTargetContexts and rm this friending
     friend class GrContextPriv;
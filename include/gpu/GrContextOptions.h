@@ -46,6 +46,13 @@ struct GrContextOptions {
         virtual sk_sp<SkData> load(const SkData& key) = 0;
 
         virtual void store(const SkData& key, const SkData& data) = 0;
+
+        /**
+         * Called when a GrContext using this cache is created, with that context's fExecutor
+         * (which may be null). Caches backed by slow storage may use the executor to read their
+         * contents in the background, so that the first calls to load() don't block on I/O.
+         */
+        virtual void prefetch(SkExecutor*) {}
     };
 
     GrContextOptions() {}
@@ -120,6 +127,14 @@ struct GrContextOptions {
      */
     float fGlyphsAsPathsFontSize = -1.f;
 
+    /**
+     * Filled paths whose bounds are no larger than this in local space may be drawn from the small
+     * path renderer's atlas, as long as they are also small enough in device space. Raising it
+     * lets medium sized shapes, e.g. icons, share distance fields across scales. A negative value
+     * means use the default threshold.
+     */
+    float fSmallPathMaxDimension = -1.f;
+
     /**
      * Can the glyph atlas use multiple textures. If allowed, the each texture's size is bound by
      * fGlypheCacheTextureMaximumBytes.
@@ -183,6 +198,31 @@ struct GrContextOptions {
      */
     PersistentCache* fPersistentCache = nullptr;
 
+    /**
+     * If true, the shaders this context compiles are also kept in an in-memory cache shared by
+     * every GrContext in the process that sets this option, and are looked up there before
+     * compiling. Only contexts on the same backend, device and driver share entries. Contexts
+     * that share should be created with the same options, since options that disable features
+     * change the generated shaders. The shared cache is consulted before fPersistentCache, which
+     * still receives every stored shader. Contexts may use it from different threads.
+     */
+    bool fShareShaderCache = false;
+
+    /**
+     * Cache in which to look up distance field glyph masks before generating them from the glyph
+     * outlines, and to store the ones that had to be generated. Its keys name the typeface by
+     * family name and style rather than by a per-process ID, so it may persist across runs of the
+     * app, but it should be cleared if the fonts installed on the system change.
+     */
+    PersistentCache* fDistanceFieldGlyphCache = nullptr;
+
+    /**
+     * Cache in which to look up the distance fields that the small path renderer draws paths with
+     * before generating them, and to store the ones that had to be generated. Its keys contain the
+     * path geometry rather than any per-process ID, so it may persist across runs of the app.
+     */
+    PersistentCache* fDistanceFieldPathCache = nullptr;
+
 #if GR_TEST_UTILS
     /**
      * Private options that are only meant for testing within Skia's tools.
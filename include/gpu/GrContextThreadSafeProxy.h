@@ -17,6 +17,7 @@ class GrContext;
 class GrContext_Base;
 class GrContextThreadSafeProxyPriv;
 class GrSkSLFPFactoryCache;
+class GrUploadStagingPool;
 struct SkImageInfo;
 class SkSurfaceCharacterization;
 
@@ -95,6 +96,7 @@ private:
     const GrBackendApi          fBackend;
     const GrContextOptions      fOptions;
     sk_sp<GrSkSLFPFactoryCache> fFPFactoryCache;
+    sk_sp<GrUploadStagingPool>  fUploadStagingPool;
 
     friend class GrDirectContext; // To construct this object
     friend class GrContextThreadSafeProxyPriv;
@@ -268,4 +268,19 @@ enum class GrSemaphoresSubmitted : bool {
     kYes = true
 };
 
+/**
+ * Broad categories of the resources held in a GrContext's resource cache. Each category can be
+ * given its own soft budget and eviction weight; see GrContext::setResourceCategoryBudget().
+ */
+enum class GrResourceCategory : int {
+    kScratch,   //!< Reused by description only, e.g. render targets and intermediate textures
+    kImage,     //!< Textures holding the contents of SkImages
+    kAtlas,     //!< Atlas textures
+    kPathMask,  //!< Cached path geometry and path, clip and blur masks
+    kOther,
+
+    kLast = kOther
+};
+static constexpr int kGrResourceCategoryCount = (int)GrResourceCategory::kLast + 1;
+
 #endif
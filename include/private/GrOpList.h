@@ -32,6 +32,10 @@ public:
     GrOpList(GrResourceProvider*, sk_sp<GrOpMemoryPool>, GrSurfaceProxy*, GrAuditTrail*);
     ~GrOpList() override;
 
+    // Called at flush time, before the methods below, possibly on a worker thread and concurrently
+    // with other GrOpLists. Lets the ops do CPU-only work ahead of prepare().
+    void prePrepare() { this->onPrePrepare(); }
+
     // These four methods are invoked at flush time
     bool instantiate(GrResourceProvider* resourceProvider);
     // Instantiates any "threaded" texture proxies that are being prepared elsewhere
@@ -59,6 +63,13 @@ public:
 
     bool isClosed() const { return this->isSetFlag(kClosed_Flag); }
 
+    /*
+     * A retained opList keeps its ops and target across flushes so it can be flushed again, as
+     * when a DDL is drawn on more than one frame. Its ops are only prepared on its first flush.
+     */
+    void makeRetained() { this->setFlag(kRetained_Flag); }
+    bool isRetained() const { return this->isSetFlag(kRetained_Flag); }
+
     /*
      * Notify this GrOpList that it relies on the contents of 'dependedOn'
      */
@@ -91,6 +102,9 @@ public:
 protected:
     bool isInstantiated() const;
 
+    // Called when the ops turn out not to be replayable. The opList is dropped after this flush.
+    void stopRetaining() { this->resetFlag(kRetained_Flag); }
+
     // In addition to just the GrSurface being allocated, has the stencil buffer been allocated (if
     // it is required)?
     bool isFullyInstantiated() const;
@@ -131,6 +145,8 @@ private:
 
         kWasOutput_Flag = 0x02,   //!< Flag for topological sorting
         kTempMark_Flag  = 0x04,   //!< Flag for topological sorting
+
+        kRetained_Flag  = 0x08,   //!< This GrOpList survives its flushes (see makeRetained)
     };
 
     void setFlag(uint32_t flag) {
@@ -169,6 +185,7 @@ private:
         }
     };
 
+    virtual void onPrePrepare() {}
     virtual void onPrepare(GrOpFlushState* flushState) = 0;
     virtual bool onExecute(GrOpFlushState* flushState) = 0;
 
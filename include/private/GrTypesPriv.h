@@ -52,6 +52,11 @@ enum GrPixelConfig {
     kAlpha_half_GrPixelConfig,
     kRGBA_half_GrPixelConfig,
     kRGB_ETC1_GrPixelConfig,
+    kRGBA_ETC2_GrPixelConfig,       // ETC2 RGB with EAC alpha.
+    kRGBA_ASTC_4x4_GrPixelConfig,   // ASTC LDR with 4x4 blocks.
+    kRGBA_BC1_GrPixelConfig,        // S3TC DXT1 with 1 bit alpha.
+    kRGBA_BC3_GrPixelConfig,        // S3TC DXT5.
+    kRGBA_BC7_GrPixelConfig,        // BPTC unorm.
 
     /** For internal usage. */
     kPrivateConfig1_GrPixelConfig,
@@ -930,8 +935,9 @@ enum class GpuPathRenderers {
     kAALinearizing     = 1 << 5,
     kSmall             = 1 << 6,
     kTessellating      = 1 << 7,
+    kSkc               = 1 << 8, // Only available in builds with skia_enable_skc.
 
-    kAll               = (kTessellating | (kTessellating - 1))
+    kAll               = (kSkc | (kSkc - 1))
 };
 
 /**
@@ -1000,6 +1006,11 @@ static inline GrSRGBEncoded GrPixelConfigIsSRGBEncoded(GrPixelConfig config) {
         case kAlpha_half_as_Red_GrPixelConfig:
         case kRGBA_half_GrPixelConfig:
         case kRGB_ETC1_GrPixelConfig:
+        case kRGBA_ETC2_GrPixelConfig:
+        case kRGBA_ASTC_4x4_GrPixelConfig:
+        case kRGBA_BC1_GrPixelConfig:
+        case kRGBA_BC3_GrPixelConfig:
+        case kRGBA_BC7_GrPixelConfig:
             return GrSRGBEncoded::kNo;
     }
     SK_ABORT("Invalid pixel config");
@@ -1040,6 +1051,11 @@ static inline size_t GrBytesPerPixel(GrPixelConfig config) {
             return 8;
         case kUnknown_GrPixelConfig:
         case kRGB_ETC1_GrPixelConfig:
+        case kRGBA_ETC2_GrPixelConfig:
+        case kRGBA_ASTC_4x4_GrPixelConfig:
+        case kRGBA_BC1_GrPixelConfig:
+        case kRGBA_BC3_GrPixelConfig:
+        case kRGBA_BC7_GrPixelConfig:
             return 0;
     }
     SK_ABORT("Invalid pixel config");
@@ -1057,6 +1073,11 @@ static inline bool GrPixelConfigIsOpaque(GrPixelConfig config) {
         case kRG_float_GrPixelConfig:
         case kRGB_ETC1_GrPixelConfig:
             return true;
+        case kRGBA_ETC2_GrPixelConfig:
+        case kRGBA_ASTC_4x4_GrPixelConfig:
+        case kRGBA_BC1_GrPixelConfig:
+        case kRGBA_BC3_GrPixelConfig:
+        case kRGBA_BC7_GrPixelConfig:
         case kAlpha_8_GrPixelConfig:
         case kAlpha_8_as_Alpha_GrPixelConfig:
         case kAlpha_8_as_Red_GrPixelConfig:
@@ -1102,6 +1123,11 @@ static inline bool GrPixelConfigIsAlphaOnly(GrPixelConfig config) {
         case kRG_float_GrPixelConfig:
         case kRGBA_half_GrPixelConfig:
         case kRGB_ETC1_GrPixelConfig:
+        case kRGBA_ETC2_GrPixelConfig:
+        case kRGBA_ASTC_4x4_GrPixelConfig:
+        case kRGBA_BC1_GrPixelConfig:
+        case kRGBA_BC3_GrPixelConfig:
+        case kRGBA_BC7_GrPixelConfig:
             return false;
     }
     SK_ABORT("Invalid pixel config.");
@@ -1127,6 +1153,11 @@ static inline bool GrPixelConfigIsFloatingPoint(GrPixelConfig config) {
         case kSBGRA_8888_GrPixelConfig:
         case kRGBA_1010102_GrPixelConfig:
         case kRGB_ETC1_GrPixelConfig:
+        case kRGBA_ETC2_GrPixelConfig:
+        case kRGBA_ASTC_4x4_GrPixelConfig:
+        case kRGBA_BC1_GrPixelConfig:
+        case kRGBA_BC3_GrPixelConfig:
+        case kRGBA_BC7_GrPixelConfig:
             return false;
         case kRGBA_float_GrPixelConfig:
         case kRG_float_GrPixelConfig:
@@ -1146,6 +1177,11 @@ static inline bool GrPixelConfigIsFloatingPoint(GrPixelConfig config) {
 static inline bool GrPixelConfigIsCompressed(GrPixelConfig config) {
     switch (config) {
         case kRGB_ETC1_GrPixelConfig:
+        case kRGBA_ETC2_GrPixelConfig:
+        case kRGBA_ASTC_4x4_GrPixelConfig:
+        case kRGBA_BC1_GrPixelConfig:
+        case kRGBA_BC3_GrPixelConfig:
+        case kRGBA_BC7_GrPixelConfig:
             return true;
         case kUnknown_GrPixelConfig:
         case kAlpha_8_GrPixelConfig:
@@ -1180,6 +1216,11 @@ static inline bool GrPixelConfigIsCompressed(GrPixelConfig config) {
 static inline GrPixelConfig GrMakePixelConfigUncompressed(GrPixelConfig config) {
     switch (config) {
         case kRGB_ETC1_GrPixelConfig:
+        case kRGBA_ETC2_GrPixelConfig:
+        case kRGBA_ASTC_4x4_GrPixelConfig:
+        case kRGBA_BC1_GrPixelConfig:
+        case kRGBA_BC3_GrPixelConfig:
+        case kRGBA_BC7_GrPixelConfig:
             return kRGBA_8888_GrPixelConfig;
         case kUnknown_GrPixelConfig:
         case kAlpha_8_GrPixelConfig:
@@ -1216,10 +1257,16 @@ static inline size_t GrCompressedFormatDataSize(GrPixelConfig config,
     SkASSERT(GrPixelConfigIsCompressed(config));
 
     switch (config) {
+        // All of these use 4x4 blocks. Partial blocks at the right and bottom edges take up as
+        // much room as whole ones.
         case kRGB_ETC1_GrPixelConfig:
-            SkASSERT((width & 3) == 0);
-            SkASSERT((height & 3) == 0);
-            return (width >> 2) * (height >> 2) * 8;
+        case kRGBA_BC1_GrPixelConfig:
+            return ((width + 3) >> 2) * ((height + 3) >> 2) * 8;
+        case kRGBA_ETC2_GrPixelConfig:
+        case kRGBA_ASTC_4x4_GrPixelConfig:
+        case kRGBA_BC3_GrPixelConfig:
+        case kRGBA_BC7_GrPixelConfig:
+            return ((width + 3) >> 2) * ((height + 3) >> 2) * 16;
 
         case kUnknown_GrPixelConfig:
         case kAlpha_8_GrPixelConfig:
@@ -1271,6 +1318,11 @@ static inline GrSLPrecision GrSLSamplerPrecision(GrPixelConfig config) {
         case kSRGBA_8888_GrPixelConfig:
         case kSBGRA_8888_GrPixelConfig:
         case kRGB_ETC1_GrPixelConfig:
+        case kRGBA_ETC2_GrPixelConfig:
+        case kRGBA_ASTC_4x4_GrPixelConfig:
+        case kRGBA_BC1_GrPixelConfig:
+        case kRGBA_BC3_GrPixelConfig:
+        case kRGBA_BC7_GrPixelConfig:
             return kLow_GrSLPrecision;
         case kRGBA_float_GrPixelConfig:
         case kRG_float_GrPixelConfig:
@@ -1307,7 +1359,13 @@ enum class GrColorType {
     kRGBA_F16,
     kRG_F32,
     kRGBA_F32,
-    kRGB_ETC1,   // This type doesn't appear in SkColorType at all.
+    // The compressed types don't appear in SkColorType at all.
+    kRGB_ETC1,
+    kRGBA_ETC2,
+    kRGBA_ASTC_4x4,
+    kRGBA_BC1,
+    kRGBA_BC3,
+    kRGBA_BC7,
 };
 
 static inline SkColorType GrColorTypeToSkColorType(GrColorType ct) {
@@ -1327,6 +1385,11 @@ static inline SkColorType GrColorTypeToSkColorType(GrColorType ct) {
         case GrColorType::kRG_F32:       return kUnknown_SkColorType;
         case GrColorType::kRGBA_F32:     return kRGBA_F32_SkColorType;
         case GrColorType::kRGB_ETC1:     return kUnknown_SkColorType;
+        case GrColorType::kRGBA_ETC2:    return kUnknown_SkColorType;
+        case GrColorType::kRGBA_ASTC_4x4: return kUnknown_SkColorType;
+        case GrColorType::kRGBA_BC1:     return kUnknown_SkColorType;
+        case GrColorType::kRGBA_BC3:     return kUnknown_SkColorType;
+        case GrColorType::kRGBA_BC7:     return kUnknown_SkColorType;
     }
     SK_ABORT("Invalid GrColorType");
     return kUnknown_SkColorType;
@@ -1370,6 +1433,11 @@ static inline uint32_t GrColorTypeComponentFlags(GrColorType ct) {
                                                 kGreen_SkColorTypeComponentFlag;
         case GrColorType::kRGBA_F32:     return kRGBA_SkColorTypeComponentFlags;
         case GrColorType::kRGB_ETC1:     return kRGB_SkColorTypeComponentFlags;
+        case GrColorType::kRGBA_ETC2:    return kRGBA_SkColorTypeComponentFlags;
+        case GrColorType::kRGBA_ASTC_4x4: return kRGBA_SkColorTypeComponentFlags;
+        case GrColorType::kRGBA_BC1:     return kRGBA_SkColorTypeComponentFlags;
+        case GrColorType::kRGBA_BC3:     return kRGBA_SkColorTypeComponentFlags;
+        case GrColorType::kRGBA_BC7:     return kRGBA_SkColorTypeComponentFlags;
     }
     SK_ABORT("Invalid GrColorType");
     return kUnknown_SkColorType;
@@ -1387,6 +1455,11 @@ static inline int GrColorTypeBytesPerPixel(GrColorType ct) {
     switch (ct) {
         case GrColorType::kUnknown:      return 0;
         case GrColorType::kRGB_ETC1:     return 0;
+        case GrColorType::kRGBA_ETC2:    return 0;
+        case GrColorType::kRGBA_ASTC_4x4: return 0;
+        case GrColorType::kRGBA_BC1:     return 0;
+        case GrColorType::kRGBA_BC3:     return 0;
+        case GrColorType::kRGBA_BC7:     return 0;
         case GrColorType::kAlpha_8:      return 1;
         case GrColorType::kRGB_565:      return 2;
         case GrColorType::kABGR_4444:    return 2;
@@ -1459,6 +1532,21 @@ static inline GrColorType GrPixelConfigToColorTypeAndEncoding(GrPixelConfig conf
         case kRGB_ETC1_GrPixelConfig:
             *srgbEncoded = GrSRGBEncoded::kNo;
             return GrColorType::kRGB_ETC1;
+        case kRGBA_ETC2_GrPixelConfig:
+            *srgbEncoded = GrSRGBEncoded::kNo;
+            return GrColorType::kRGBA_ETC2;
+        case kRGBA_ASTC_4x4_GrPixelConfig:
+            *srgbEncoded = GrSRGBEncoded::kNo;
+            return GrColorType::kRGBA_ASTC_4x4;
+        case kRGBA_BC1_GrPixelConfig:
+            *srgbEncoded = GrSRGBEncoded::kNo;
+            return GrColorType::kRGBA_BC1;
+        case kRGBA_BC3_GrPixelConfig:
+            *srgbEncoded = GrSRGBEncoded::kNo;
+            return GrColorType::kRGBA_BC3;
+        case kRGBA_BC7_GrPixelConfig:
+            *srgbEncoded = GrSRGBEncoded::kNo;
+            return GrColorType::kRGBA_BC7;
         case kAlpha_8_as_Alpha_GrPixelConfig:
             *srgbEncoded = GrSRGBEncoded::kNo;
             return GrColorType::kAlpha_8;
@@ -1543,6 +1631,26 @@ static inline GrPixelConfig GrColorTypeToPixelConfig(GrColorType config,
         case GrColorType::kRGB_ETC1:
             return (GrSRGBEncoded::kYes == srgbEncoded) ? kUnknown_GrPixelConfig
                                                         : kRGB_ETC1_GrPixelConfig;
+
+        case GrColorType::kRGBA_ETC2:
+            return (GrSRGBEncoded::kYes == srgbEncoded) ? kUnknown_GrPixelConfig
+                                                        : kRGBA_ETC2_GrPixelConfig;
+
+        case GrColorType::kRGBA_ASTC_4x4:
+            return (GrSRGBEncoded::kYes == srgbEncoded) ? kUnknown_GrPixelConfig
+                                                        : kRGBA_ASTC_4x4_GrPixelConfig;
+
+        case GrColorType::kRGBA_BC1:
+            return (GrSRGBEncoded::kYes == srgbEncoded) ? kUnknown_GrPixelConfig
+                                                        : kRGBA_BC1_GrPixelConfig;
+
+        case GrColorType::kRGBA_BC3:
+            return (GrSRGBEncoded::kYes == srgbEncoded) ? kUnknown_GrPixelConfig
+                                                        : kRGBA_BC3_GrPixelConfig;
+
+        case GrColorType::kRGBA_BC7:
+            return (GrSRGBEncoded::kYes == srgbEncoded) ? kUnknown_GrPixelConfig
+                                                        : kRGBA_BC7_GrPixelConfig;
     }
     SK_ABORT("Invalid GrColorType");
     return kUnknown_GrPixelConfig;
@@ -136,6 +136,9 @@ public:
     // Destroy all allocated objects, free any heap allocations.
     void reset();
 
+    // The number of bytes currently allocated from the heap, beyond the user-provided block.
+    size_t heapBytes() const { return fHeapBytes; }
+
 private:
     static void AssertRelease(bool cond) { if (!cond) { ::abort(); } }
     static uint32_t ToU32(size_t v) {
@@ -216,6 +219,7 @@ private:
     char* const    fFirstBlock;
     const uint32_t fFirstSize;
     const uint32_t fFirstHeapAllocationSize;
+    size_t         fHeapBytes {0};
 
     // Use the Fibonacci sequence as the growth factor for block size. The size of the block
     // allocated is fFib0 * fFirstHeapAllocationSize. Using 2 ^ n * fFirstHeapAllocationSize
@@ -18,6 +18,7 @@
 #endif
 
 class SkDeferredDisplayListPriv;
+class SkPromiseImageBatch;
 class SkSurface;
 /*
  * This class contains pre-processed gpu operations that can be replayed into
@@ -68,8 +69,12 @@ private:
 
     SkTArray<sk_sp<GrOpList>>    fOpLists;
     PendingPathsMap              fPendingPaths;  // This is the path data from CCPR.
+    // The recorder's promise images, if it had a batch fulfill proc.
+    sk_sp<SkPromiseImageBatch>   fPromiseImageBatch;
 #endif
     sk_sp<LazyProxyData>         fLazyProxyData;
+    // Whether the DDL can be drawn more than once (see SkDeferredDisplayListRecorder::detach).
+    bool                         fRetained = false;
 };
 
 #endif
@@ -11,6 +11,10 @@
 #include "SkNx.h"
 #include "SkTypes.h"
 
+#if !defined(SKNX_NO_SIMD) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    #include <immintrin.h>
+#endif
+
 // 16-bit floating point value
 // format is 1 bit sign, 5 bits exponent, 10 bits mantissa
 // only used for storage
@@ -37,6 +41,10 @@ static inline Sk4h SkFloatToHalf_finite_ftz(const Sk4f&);
 // https://fgiesen.wordpress.com/2012/03/28/half-to-float-done-quic/
 
 // GCC 4.9 lacks the intrinsics to use ARMv8 f16<->f32 instructions, so we use inline assembly.
+//
+// Builds targeting Haswell or later (including the hsw and skx SkOpts) use F16C.  Like the ARMv8
+// instructions, F16C keeps denormal halfs rather than flushing them to zero.  We convert to half
+// rounding toward zero to match the truncation of the portable code.
 
 static inline Sk4f SkHalfToFloat_finite_ftz(uint64_t rgba) {
     Sk4h hs = Sk4h::Load(&rgba);
@@ -46,6 +54,8 @@ static inline Sk4f SkHalfToFloat_finite_ftz(uint64_t rgba) {
         : [fs] "=w" (fs)                   // =w: write-only NEON register
         : [hs] "w" (hs.fVec));             //  w: read-only NEON register
     return fs;
+#elif !defined(SKNX_NO_SIMD) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    return _mm_cvtph_ps(hs.fVec);
 #else
     Sk4i bits     = SkNx_cast<int>(hs),  // Expand to 32 bit.
          sign     = bits & 0x00008000,   // Save the sign bit for later...
@@ -67,6 +77,8 @@ static inline Sk4h SkFloatToHalf_finite_ftz(const Sk4f& fs) {
     asm ("fcvtn %[vec].4h, %[vec].4s  \n"   // vcvt_f16_f32(vec)
         : [vec] "+w" (vec));                // +w: read-write NEON register
     return vreinterpret_u16_f32(vget_low_f32(vec));
+#elif !defined(SKNX_NO_SIMD) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    return _mm_cvtps_ph(fs.fVec, _MM_FROUND_TO_ZERO);
 #else
     Sk4i bits         = Sk4i::Load(&fs),
          sign         = bits & 0x80000000,      // Save the sign bit for later...
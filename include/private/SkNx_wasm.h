@@ -0,0 +1,277 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkNx_wasm_DEFINED
+#define SkNx_wasm_DEFINED
+
+// wasm-simd128 has no stable intrinsics header yet, but Clang lowers its vector extensions
+// straight to 128-bit wasm SIMD, so that's what we write these in.
+
+namespace {  // NOLINT(google-build-namespaces)
+
+typedef float    WasmF32x4 __attribute__((ext_vector_type(4)));
+typedef int32_t  WasmI32x4 __attribute__((ext_vector_type(4)));
+typedef uint32_t WasmU32x4 __attribute__((ext_vector_type(4)));
+
+// Comparisons of these vectors yield all-ones or all-zero int32 lanes.
+AI static WasmI32x4 wasm_select(WasmI32x4 c, WasmI32x4 t, WasmI32x4 e) {
+    return (t & c) | (e & ~c);
+}
+AI static WasmF32x4 wasm_select(WasmI32x4 c, WasmF32x4 t, WasmF32x4 e) {
+    return (WasmF32x4)wasm_select(c, (WasmI32x4)t, (WasmI32x4)e);
+}
+
+template <>
+class SkNx<4, float> {
+public:
+    AI SkNx(const WasmF32x4& vec) : fVec(vec) {}
+
+    AI SkNx() {}
+    AI SkNx(float val) : fVec(WasmF32x4{val, val, val, val}) {}
+    AI SkNx(float a, float b, float c, float d) : fVec(WasmF32x4{a, b, c, d}) {}
+
+    AI static SkNx Load(const void* ptr) {
+        WasmF32x4 vec;
+        memcpy(&vec, ptr, sizeof(vec));
+        return vec;
+    }
+    AI void store(void* ptr) const { memcpy(ptr, &fVec, sizeof(fVec)); }
+
+    AI static void Load2(const void* ptr, SkNx* x, SkNx* y) {
+        WasmF32x4 lo = Load((const float*)ptr + 0).fVec,
+                  hi = Load((const float*)ptr + 4).fVec;
+        *x = __builtin_shufflevector(lo, hi, 0, 2, 4, 6);
+        *y = __builtin_shufflevector(lo, hi, 1, 3, 5, 7);
+    }
+
+    AI static void Load4(const void* ptr, SkNx* r, SkNx* g, SkNx* b, SkNx* a) {
+        WasmF32x4 v0 = Load((const float*)ptr +  0).fVec,
+                  v1 = Load((const float*)ptr +  4).fVec,
+                  v2 = Load((const float*)ptr +  8).fVec,
+                  v3 = Load((const float*)ptr + 12).fVec;
+        WasmF32x4 rg01 = __builtin_shufflevector(v0, v1, 0, 4, 1, 5),
+                  ba01 = __builtin_shufflevector(v0, v1, 2, 6, 3, 7),
+                  rg23 = __builtin_shufflevector(v2, v3, 0, 4, 1, 5),
+                  ba23 = __builtin_shufflevector(v2, v3, 2, 6, 3, 7);
+        *r = __builtin_shufflevector(rg01, rg23, 0, 1, 4, 5);
+        *g = __builtin_shufflevector(rg01, rg23, 2, 3, 6, 7);
+        *b = __builtin_shufflevector(ba01, ba23, 0, 1, 4, 5);
+        *a = __builtin_shufflevector(ba01, ba23, 2, 3, 6, 7);
+    }
+    AI static void Store4(void* dst, const SkNx& r, const SkNx& g, const SkNx& b, const SkNx& a) {
+        WasmF32x4 rg01 = __builtin_shufflevector(r.fVec, g.fVec, 0, 4, 1, 5),
+                  rg23 = __builtin_shufflevector(r.fVec, g.fVec, 2, 6, 3, 7),
+                  ba01 = __builtin_shufflevector(b.fVec, a.fVec, 0, 4, 1, 5),
+                  ba23 = __builtin_shufflevector(b.fVec, a.fVec, 2, 6, 3, 7);
+        SkNx(__builtin_shufflevector(rg01, ba01, 0, 1, 4, 5)).store((float*)dst +  0);
+        SkNx(__builtin_shufflevector(rg01, ba01, 2, 3, 6, 7)).store((float*)dst +  4);
+        SkNx(__builtin_shufflevector(rg23, ba23, 0, 1, 4, 5)).store((float*)dst +  8);
+        SkNx(__builtin_shufflevector(rg23, ba23, 2, 3, 6, 7)).store((float*)dst + 12);
+    }
+
+    AI SkNx operator - () const { return -fVec; }
+
+    AI SkNx operator + (const SkNx& o) const { return fVec + o.fVec; }
+    AI SkNx operator - (const SkNx& o) const { return fVec - o.fVec; }
+    AI SkNx operator * (const SkNx& o) const { return fVec * o.fVec; }
+    AI SkNx operator / (const SkNx& o) const { return fVec / o.fVec; }
+
+    AI SkNx operator == (const SkNx& o) const { return (WasmF32x4)(fVec == o.fVec); }
+    AI SkNx operator != (const SkNx& o) const { return (WasmF32x4)(fVec != o.fVec); }
+    AI SkNx operator  < (const SkNx& o) const { return (WasmF32x4)(fVec <  o.fVec); }
+    AI SkNx operator  > (const SkNx& o) const { return (WasmF32x4)(fVec >  o.fVec); }
+    AI SkNx operator <= (const SkNx& o) const { return (WasmF32x4)(fVec <= o.fVec); }
+    AI SkNx operator >= (const SkNx& o) const { return (WasmF32x4)(fVec >= o.fVec); }
+
+    AI static SkNx Min(const SkNx& l, const SkNx& r) {
+        return wasm_select(l.fVec < r.fVec, l.fVec, r.fVec);
+    }
+    AI static SkNx Max(const SkNx& l, const SkNx& r) {
+        return wasm_select(l.fVec > r.fVec, l.fVec, r.fVec);
+    }
+
+    AI SkNx abs() const { return (WasmF32x4)((WasmI32x4)fVec & 0x7fffffff); }
+    AI SkNx floor() const {
+        // Roundtrip through integers via truncation, then subtract 1 if that rounded up.
+        WasmF32x4 roundtrip = __builtin_convertvector(__builtin_convertvector(fVec, WasmI32x4),
+                                                      WasmF32x4);
+        return roundtrip - wasm_select(roundtrip > fVec, WasmF32x4(1), WasmF32x4(0));
+    }
+
+    AI SkNx   sqrt() const {
+        // Clang turns this back into a single f32x4.sqrt.
+        return WasmF32x4{ sqrtf(fVec[0]), sqrtf(fVec[1]), sqrtf(fVec[2]), sqrtf(fVec[3]) };
+    }
+    AI SkNx  rsqrt() const { return 1.0f / this->sqrt().fVec; }
+    AI SkNx invert() const { return 1.0f / fVec; }
+
+    AI float operator[](int k) const {
+        SkASSERT(0 <= k && k < 4);
+        return fVec[k&3];
+    }
+
+    AI float min() const { return SkTMin(SkTMin(fVec[0], fVec[1]), SkTMin(fVec[2], fVec[3])); }
+    AI float max() const { return SkTMax(SkTMax(fVec[0], fVec[1]), SkTMax(fVec[2], fVec[3])); }
+
+    AI bool allTrue() const {
+        WasmI32x4 bits = (WasmI32x4)fVec;
+        return bits[0] && bits[1] && bits[2] && bits[3];
+    }
+    AI bool anyTrue() const {
+        WasmI32x4 bits = (WasmI32x4)fVec;
+        return bits[0] || bits[1] || bits[2] || bits[3];
+    }
+
+    AI SkNx thenElse(const SkNx& t, const SkNx& e) const {
+        return wasm_select((WasmI32x4)fVec, t.fVec, e.fVec);
+    }
+
+    WasmF32x4 fVec;
+};
+
+template <>
+class SkNx<4, int32_t> {
+public:
+    AI SkNx(const WasmI32x4& vec) : fVec(vec) {}
+
+    AI SkNx() {}
+    AI SkNx(int32_t val) : fVec(WasmI32x4{val, val, val, val}) {}
+    AI SkNx(int32_t a, int32_t b, int32_t c, int32_t d) : fVec(WasmI32x4{a, b, c, d}) {}
+
+    AI static SkNx Load(const void* ptr) {
+        WasmI32x4 vec;
+        memcpy(&vec, ptr, sizeof(vec));
+        return vec;
+    }
+    AI void store(void* ptr) const { memcpy(ptr, &fVec, sizeof(fVec)); }
+
+    AI SkNx operator + (const SkNx& o) const { return fVec + o.fVec; }
+    AI SkNx operator - (const SkNx& o) const { return fVec - o.fVec; }
+    AI SkNx operator * (const SkNx& o) const { return fVec * o.fVec; }
+
+    AI SkNx operator & (const SkNx& o) const { return fVec & o.fVec; }
+    AI SkNx operator | (const SkNx& o) const { return fVec | o.fVec; }
+    AI SkNx operator ^ (const SkNx& o) const { return fVec ^ o.fVec; }
+
+    AI SkNx operator << (int bits) const { return fVec << bits; }
+    AI SkNx operator >> (int bits) const { return fVec >> bits; }
+
+    AI SkNx operator == (const SkNx& o) const { return fVec == o.fVec; }
+    AI SkNx operator  < (const SkNx& o) const { return fVec <  o.fVec; }
+    AI SkNx operator  > (const SkNx& o) const { return fVec >  o.fVec; }
+
+    AI int32_t operator[](int k) const {
+        SkASSERT(0 <= k && k < 4);
+        return fVec[k&3];
+    }
+
+    AI SkNx thenElse(const SkNx& t, const SkNx& e) const {
+        return wasm_select(fVec, t.fVec, e.fVec);
+    }
+
+    AI SkNx abs() const { return wasm_select(fVec < 0, -fVec, fVec); }
+
+    AI static SkNx Min(const SkNx& x, const SkNx& y) {
+        return wasm_select(x.fVec < y.fVec, x.fVec, y.fVec);
+    }
+    AI static SkNx Max(const SkNx& x, const SkNx& y) {
+        return wasm_select(x.fVec > y.fVec, x.fVec, y.fVec);
+    }
+
+    WasmI32x4 fVec;
+};
+
+template <>
+class SkNx<4, uint32_t> {
+public:
+    AI SkNx(const WasmU32x4& vec) : fVec(vec) {}
+
+    AI SkNx() {}
+    AI SkNx(uint32_t val) : fVec(WasmU32x4{val, val, val, val}) {}
+    AI SkNx(uint32_t a, uint32_t b, uint32_t c, uint32_t d) : fVec(WasmU32x4{a, b, c, d}) {}
+
+    AI static SkNx Load(const void* ptr) {
+        WasmU32x4 vec;
+        memcpy(&vec, ptr, sizeof(vec));
+        return vec;
+    }
+    AI void store(void* ptr) const { memcpy(ptr, &fVec, sizeof(fVec)); }
+
+    AI SkNx operator + (const SkNx& o) const { return fVec + o.fVec; }
+    AI SkNx operator - (const SkNx& o) const { return fVec - o.fVec; }
+    AI SkNx operator * (const SkNx& o) const { return fVec * o.fVec; }
+
+    AI SkNx operator & (const SkNx& o) const { return fVec & o.fVec; }
+    AI SkNx operator | (const SkNx& o) const { return fVec | o.fVec; }
+    AI SkNx operator ^ (const SkNx& o) const { return fVec ^ o.fVec; }
+
+    AI SkNx operator << (int bits) const { return fVec << bits; }
+    AI SkNx operator >> (int bits) const { return fVec >> bits; }
+
+    AI SkNx operator == (const SkNx& o) const { return (WasmU32x4)(fVec == o.fVec); }
+    AI SkNx operator != (const SkNx& o) const { return (WasmU32x4)(fVec != o.fVec); }
+    AI SkNx operator  < (const SkNx& o) const { return (WasmU32x4)(fVec <  o.fVec); }
+
+    AI static SkNx Min(const SkNx& x, const SkNx& y) {
+        return (WasmU32x4)wasm_select(x.fVec < y.fVec, (WasmI32x4)x.fVec, (WasmI32x4)y.fVec);
+    }
+
+    AI uint32_t operator[](int k) const {
+        SkASSERT(0 <= k && k < 4);
+        return fVec[k&3];
+    }
+
+    AI SkNx thenElse(const SkNx& t, const SkNx& e) const {
+        return (WasmU32x4)wasm_select((WasmI32x4)fVec, (WasmI32x4)t.fVec, (WasmI32x4)e.fVec);
+    }
+
+    AI SkNx mulHi(SkNx m) const {
+        return SkNx((uint32_t)(((uint64_t)fVec[0] * m.fVec[0]) >> 32),
+                    (uint32_t)(((uint64_t)fVec[1] * m.fVec[1]) >> 32),
+                    (uint32_t)(((uint64_t)fVec[2] * m.fVec[2]) >> 32),
+                    (uint32_t)(((uint64_t)fVec[3] * m.fVec[3]) >> 32));
+    }
+
+    WasmU32x4 fVec;
+};
+
+// The other 4-lane types stay portable, so cast between them lane by lane.
+template <typename Dst, typename Src>
+AI static SkNx<4,Dst> SkNx_cast(const SkNx<4,Src>& v) {
+    return { static_cast<Dst>(v[0]), static_cast<Dst>(v[1]),
+             static_cast<Dst>(v[2]), static_cast<Dst>(v[3]) };
+}
+
+template<> AI /*static*/ Sk4f SkNx_cast<float, int32_t>(const Sk4i& src) {
+    return __builtin_convertvector(src.fVec, WasmF32x4);
+}
+template<> AI /*static*/ Sk4f SkNx_cast<float, uint32_t>(const Sk4u& src) {
+    return __builtin_convertvector(src.fVec, WasmF32x4);
+}
+template<> AI /*static*/ Sk4i SkNx_cast<int32_t, float>(const Sk4f& src) {
+    return __builtin_convertvector(src.fVec, WasmI32x4);
+}
+template<> AI /*static*/ Sk4u SkNx_cast<uint32_t, float>(const Sk4f& src) {
+    return __builtin_convertvector(src.fVec, WasmU32x4);
+}
+template<> AI /*static*/ Sk4i SkNx_cast<int32_t, uint32_t>(const Sk4u& src) {
+    return (WasmI32x4)src.fVec;
+}
+template<> AI /*static*/ Sk4u SkNx_cast<uint32_t, int32_t>(const Sk4i& src) {
+    return (WasmU32x4)src.fVec;
+}
+
+AI static Sk4i Sk4f_round(const Sk4f& x) {
+    return { (int) lrintf (x[0]),
+             (int) lrintf (x[1]),
+             (int) lrintf (x[2]),
+             (int) lrintf (x[3]), };
+}
+
+}  // namespace
+
+#endif//SkNx_wasm_DEFINED
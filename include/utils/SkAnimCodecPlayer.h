@@ -8,9 +8,13 @@
 #ifndef SkAnimCodecPlayer_DEFINED
 #define SkAnimCodecPlayer_DEFINED
 
+#include "../private/SkMutex.h"
 #include "SkCodec.h"
 
+class SkData;
+class SkExecutor;
 class SkImage;
+class SkTaskGroup;
 
 class SkAnimCodecPlayer {
 public:
@@ -44,16 +48,41 @@ public:
      */
     bool seek(uint32_t msec);
 
+    /**
+     *  Decodes up to frameCount frames following the current one on the executor, so that
+     *  seek() + getFrame() usually find their frame ready. Decoding is serialized on the codec,
+     *  pixel buffers released by evicted frames are reused, and frames are evicted (furthest
+     *  ahead first) to keep the decoded frames within memoryBudget bytes. The current frame,
+     *  the prefetched ones and the frames they are blended onto are always kept, so the budget
+     *  may be exceeded if it is too small to hold them.
+     *
+     *  Pass a null executor (or a frameCount of 0) to stop prefetching. The default is no
+     *  prefetching with an unlimited budget, i.e. every decoded frame stays cached.
+     */
+    void setPrefetch(SkExecutor*, int frameCount, size_t memoryBudget);
 
 private:
     std::unique_ptr<SkCodec>        fCodec;
     SkImageInfo                     fImageInfo;
     std::vector<SkCodec::FrameInfo> fFrameInfos;
     std::vector<sk_sp<SkImage> >    fImages;
+    // The pixels of each decoded frame, and released buffers waiting for reuse.
+    std::vector<sk_sp<SkData> >     fFrameData;
+    std::vector<sk_sp<SkData> >     fFreeData;
     int                             fCurrIndex = 0;
+    int                             fDecodedFrames = 0;
     uint32_t                        fTotalDuration;
 
+    int                             fPrefetchCount = 0;
+    size_t                          fMemoryBudget = SIZE_MAX;
+
+    // Guards the codec and the frame cache against the prefetch tasks.
+    SkMutex                         fMutex;
+    std::unique_ptr<SkTaskGroup>    fTaskGroup;
+
     sk_sp<SkImage> getFrameAt(int index);
+    void purgeFrames(int index);
+    void schedulePrefetch();
 };
 
 #endif
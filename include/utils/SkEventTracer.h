@@ -69,6 +69,17 @@ public:
         updateTraceEventDuration(const uint8_t* categoryEnabledFlag,
                                  const char* name,
                                  SkEventTracer::Handle handle) = 0;
+
+    /**
+     * Adds a complete event that was timed on the GPU. The GPU's clock isn't the CPU's, so the
+     * event is placed relative to the time of the call: it started 'startedNsAgo' nanoseconds
+     * before now and lasted 'durationNs'. Tracers should put these events on a track of their
+     * own. The default ignores them.
+     */
+    virtual void addGpuEvent(const uint8_t* categoryEnabledFlag,
+                             const char* name,
+                             uint64_t startedNsAgo,
+                             uint64_t durationNs) {}
 };
 
 #endif // SkEventTracer_DEFINED
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkReadAheadStream_DEFINED
+#define SkReadAheadStream_DEFINED
+
+#include "SkStream.h"
+
+class SkExecutor;
+
+/**
+ *  Specialized stream that reads the wrapped stream in chunks, fetching the
+ *  next chunk on an SkExecutor while the caller consumes the current one.
+ *  This lets a slow source (network storage, a blocking SkFILEStream) overlap
+ *  its IO with the work done by the reader, e.g. an SkCodec decoding rows.
+ *
+ *  The returned stream only supports reading forward; peek() sees at most the
+ *  rest of the current chunk. Streams that already live in memory (see
+ *  SkStream::MakeFromFile, which maps files when it can) gain nothing from
+ *  this and should be used directly so codecs can use getMemoryBase().
+ */
+class SK_API SkReadAheadStream {
+public:
+    static constexpr size_t kDefaultChunkSize = 64 * 1024;
+
+    /**
+     *  Creates a new stream that wraps and reads ahead of an SkStream.
+     *  @param stream SkStream to read from. If stream is NULL, NULL is
+     *      returned. On success the returned stream owns stream; it must not
+     *      be used directly from then on.
+     *  @param executor Runs the background reads. It must outlive the returned
+     *      stream. If NULL, SkExecutor::GetDefault() is used.
+     *  @param chunkSize Number of bytes fetched by each background read.
+     */
+    static std::unique_ptr<SkStream> Make(std::unique_ptr<SkStream> stream,
+                                          SkExecutor* executor = nullptr,
+                                          size_t chunkSize = kDefaultChunkSize);
+};
+#endif  // SkReadAheadStream_DEFINED
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSharedRaster_DEFINED
+#define SkSharedRaster_DEFINED
+
+#include "SkImageInfo.h"
+#include "SkMatrix.h"
+#include "SkRasterHandleAllocator.h"
+#include "SkRect.h"
+#include "SkRefCnt.h"
+
+class SkSurface;
+
+/**
+ *  Pixel memory that another process can map: a memfd on Linux, ashmem on Android, and a POSIX
+ *  shared memory object on other POSIX platforms.  Hand fd() to the other process (e.g. over a
+ *  unix socket with SCM_RIGHTS) and have it call MakeFromFD() to see the same pixels.
+ *
+ *  Shared memory is not available on every platform (e.g. Windows); Make() returns nullptr there.
+ */
+class SK_API SkSharedPixelMemory : public SkRefCnt {
+public:
+    /** Allocates and maps size bytes of zero-initialized shared memory. */
+    static sk_sp<SkSharedPixelMemory> Make(size_t size);
+
+    /**
+     *  Maps size bytes of shared memory received from another process, taking ownership of fd.
+     *  fd is closed if this fails.
+     */
+    static sk_sp<SkSharedPixelMemory> MakeFromFD(int fd, size_t size);
+
+    ~SkSharedPixelMemory() override;
+
+    int    fd()     const { return fFD;     }
+    void*  pixels() const { return fPixels; }
+    size_t size()   const { return fSize;   }
+
+    /**
+     *  Returns a raster surface drawing directly into this memory, or nullptr if info and rowBytes
+     *  do not fit.  The surface keeps this memory alive.  rowBytes of 0 means info.minRowBytes().
+     */
+    sk_sp<SkSurface> makeSurface(const SkImageInfo& info, size_t rowBytes = 0);
+
+private:
+    SkSharedPixelMemory(int fd, void* pixels, size_t size)
+        : fFD(fd), fPixels(pixels), fSize(size) {}
+
+    int    fFD;
+    void*  fPixels;
+    size_t fSize;
+};
+
+/**
+ *  An SkRasterHandleAllocator that places the base layer and every saveLayer() in shared memory.
+ *  SkCanvas::accessTopRasterHandle() returns a pointer to the allocator's Layer, which tracks the
+ *  canvas' matrix and device clip so they can be sent along with the layer's memory.
+ */
+class SK_API SkSharedRasterHandleAllocator : public SkRasterHandleAllocator {
+public:
+    struct Layer {
+        sk_sp<SkSharedPixelMemory> fMemory;
+        SkImageInfo                fInfo;
+        size_t                     fRowBytes;
+        SkMatrix                   fMatrix;
+        SkIRect                    fClip;
+    };
+
+    /** Returns a canvas whose pixels all come from shared memory, or nullptr if that fails. */
+    static std::unique_ptr<SkCanvas> MakeCanvas(const SkImageInfo&);
+
+    bool allocHandle(const SkImageInfo&, Rec*) override;
+    void updateHandle(Handle, const SkMatrix&, const SkIRect&) override;
+};
+
+/**
+ *  Double-buffered shared-memory frames for handing raster output to a compositor process.
+ *
+ *  The producer calls beginFrame() with the area it will redraw, draws into the returned
+ *  surface, then calls endFrame() to make that buffer the front buffer.  beginFrame() first
+ *  copies into the back buffer whatever the front buffer gained since the back buffer was last
+ *  drawn, so only the damaged area needs redrawing.  The surface's canvas is clipped to damage.
+ *
+ *  The consumer maps both buffers once (buffer(i).fd()) and for each frame then only needs the
+ *  index and damage returned by endFrame().  The producer must not call beginFrame() again until
+ *  the consumer has finished reading the buffer that is about to become the back buffer; how
+ *  that is signalled is up to the client's IPC.
+ */
+class SK_API SkSharedRasterSwapchain {
+public:
+    static constexpr int kBufferCount = 2;
+
+    static std::unique_ptr<SkSharedRasterSwapchain> Make(const SkImageInfo&);
+
+    const SkImageInfo& info() const { return fInfo; }
+    size_t rowBytes() const { return fInfo.minRowBytes(); }
+    const SkSharedPixelMemory& buffer(int index) const { return *fBuffers[index].fMemory; }
+
+    /** Returns the back buffer's surface, ready to redraw damage. */
+    SkSurface* beginFrame(const SkIRect& damage);
+
+    /**
+     *  Presents the back buffer, returning its index.  If damage is non-null, it is set to the
+     *  area that changed since the previous frame.
+     */
+    int endFrame(SkIRect* damage = nullptr);
+
+    /** Index of the buffer most recently returned by endFrame(), or -1 before the first frame. */
+    int frontIndex() const { return fFront; }
+
+private:
+    explicit SkSharedRasterSwapchain(const SkImageInfo& info) : fInfo(info) {}
+
+    struct Buffer {
+        sk_sp<SkSharedPixelMemory> fMemory;
+        sk_sp<SkSurface>           fSurface;
+        SkIRect                    fStale;     // what this buffer is missing from the front buffer
+    };
+
+    SkImageInfo fInfo;
+    Buffer      fBuffers[kBufferCount];
+    int         fFront     = -1;
+    int         fDrawing   = -1;
+    SkIRect     fDamage    = SkIRect::MakeEmpty();
+};
+
+#endif
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTiledPlayback_DEFINED
+#define SkTiledPlayback_DEFINED
+
+#include "SkTypes.h"
+
+class SkExecutor;
+class SkPicture;
+class SkSurface;
+
+class SK_API SkTiledPlayback {
+public:
+    /**
+     *  Plays back the picture into a raster surface's canvas, producing the same pixels as
+     *  picture->playback(surface->getCanvas()), but splits the surface into tiles of
+     *  tileW x tileH pixels and draws those tiles in parallel on the executor (or on
+     *  SkExecutor::GetDefault() if executor is null).
+     *
+     *  Each tile is drawn through its own canvas clipped to that tile, so pictures recorded
+     *  with an SkBBoxHierarchy (e.g. SkRTreeFactory) only play back the ops touching each tile.
+     *
+     *  The canvas' current matrix and clip are respected.  If the surface is not raster-backed,
+     *  its canvas has a non-rectangular clip, or it is inside a saveLayer, this falls back to
+     *  drawing the picture on the calling thread.
+     */
+    static void Draw(const SkPicture*, SkSurface*, SkExecutor* = nullptr,
+                     int tileW = kDefaultTileSize, int tileH = kDefaultTileSize);
+
+    static constexpr int kDefaultTileSize = 256;
+};
+
+#endif
@@ -8,6 +8,9 @@ set -ex
 
 BASE_DIR=`cd $(dirname ${BASH_SOURCE[0]}) && pwd`
 HTML_SHELL=$BASE_DIR/shell.html
+if [[ $@ == *simd* ]]; then
+  BUILD_DIR=${BUILD_DIR:="out/pathkit_simd"}
+fi
 BUILD_DIR=${BUILD_DIR:="out/pathkit"}
 mkdir -p $BUILD_DIR
 
@@ -37,6 +40,9 @@ if [[ $@ == *help* ]]; then
   echo "  test = Make a build suitable for running tests or profiling"
   echo "  debug = Make a build suitable for debugging (defines SK_DEBUG)"
   echo "  asm.js = Build for asm.js instead of WASM (very experimental)"
+  echo "  simd = Build for WASM with 128-bit SIMD (put in out/pathkit_simd by default)."
+  echo "         Only browsers with WASM SIMD can load it, so feature-detect before"
+  echo "         choosing it over the regular build."
   echo "  serve = starts a webserver allowing a user to navigate to"
   echo "          localhost:8000/pathkit.html to view the demo page."
   exit 0
@@ -68,6 +74,15 @@ if [[ $@ == *asm.js* ]]; then
   WASM_CONF="-s WASM=0 -s ALLOW_MEMORY_GROWTH=1"
 fi
 
+SIMD_CFLAGS=""
+SIMD_CONF=""
+if [[ $@ == *simd* ]]; then
+  echo "Building with WASM SIMD"
+  # SkNx and SkRasterPipeline pick their wasm SIMD implementations off of __wasm_simd128__.
+  SIMD_CFLAGS="\"-msimd128\","
+  SIMD_CONF="-msimd128"
+fi
+
 OUTPUT="-o $BUILD_DIR/pathkit.js"
 
 source $EMSDK/emsdk_env.sh
@@ -92,6 +107,7 @@ echo "Compiling bitcode"
   --args="cc=\"${EMCC}\" \
   cxx=\"${EMCXX}\" \
   extra_cflags=[\"-DSK_DISABLE_READBUFFER=1\",\"-s\", \"WARN_UNALIGNED=1\",
+    ${SIMD_CFLAGS}
     ${EXTRA_CFLAGS}
   ] \
   is_debug=false \
@@ -124,6 +140,7 @@ ${EMCXX} $RELEASE_CONF -std=c++14 \
 -DSK_DISABLE_READBUFFER=1 \
 -fno-rtti -fno-exceptions -DEMSCRIPTEN_HAS_UNBOUND_TYPE_NAMES=0 \
 $WASM_CONF \
+$SIMD_CONF \
 -s BINARYEN_IGNORE_IMPLICIT_TRAPS=1 \
 -s ERROR_ON_MISSING_LIBRARIES=1 \
 -s ERROR_ON_UNDEFINED_SYMBOLS=1 \
@@ -80,6 +80,18 @@ module.exports = function(config) {
     cfg.proxies = {
       '/pathkit/': '/base/npm-asmjs/bin/'
     };
+  } else if (process.env.WASM_SIMD) {
+    console.log('wasm with SIMD is under test');
+    cfg.files = [
+      { pattern: 'npm-wasm/bin/simd/pathkit.wasm', included:false, served:true},
+      'perf/perfReporter.js',
+      'npm-wasm/bin/simd/pathkit.js',
+      'perf/*.bench.js'
+    ];
+
+    cfg.proxies = {
+      '/pathkit/': '/base/npm-wasm/bin/simd/'
+    };
   } else {
     console.log('wasm is under test');
   }
@@ -24,7 +24,7 @@ class SkStream;
 
 namespace skjson { class ObjectValue; }
 
-namespace sksg { class Scene;  }
+namespace sksg { class InvalidationController; class Scene; }
 
 namespace skottie {
 
@@ -198,13 +198,29 @@ public:
      */
     void render(SkCanvas* canvas, const SkRect* dst = nullptr) const;
 
+    /**
+     * Draws the parts of the current animation frame which intersect |damage|, on top of the
+     * previous frame.  Scene nodes which fall entirely outside the damage are skipped.
+     *
+     * @param canvas   destination canvas
+     * @param dst      optional destination rect
+     * @param damage   area to repaint, in animation coordinates (see seek())
+     */
+    void render(SkCanvas* canvas, const SkRect* dst, const SkRect& damage) const;
+
     /**
      * Updates the animation state for |t|.
      *
-     * @param t   normalized [0..1] frame selector (0 -> first frame, 1 -> final frame)
+     * An animation is not thread safe: seek() and render() must not be called concurrently on
+     * the same instance.  Separate instances (e.g. built by several Builders from the same data)
+     * share no mutable state, so frames can be rendered in parallel with one instance per thread.
+     *
+     * @param t    normalized [0..1] frame selector (0 -> first frame, 1 -> final frame)
+     * @param ic   optional invalidation controller, which receives the areas (in animation
+     *             coordinates, i.e. relative to size()) that changed since the previous seek
      *
      */
-    void seek(SkScalar t);
+    void seek(SkScalar t, sksg::InvalidationController* ic = nullptr);
 
     /**
      * Returns the animation duration in seconds.
@@ -220,6 +236,8 @@ private:
     Animation(std::unique_ptr<sksg::Scene>, SkString ver, const SkSize& size,
               SkScalar inPoint, SkScalar outPoint, SkScalar duration);
 
+    void render(SkCanvas*, const SkRect* dst, const SkRect* damage) const;
+
     std::unique_ptr<sksg::Scene> fScene;
     const SkString               fVersion;
     const SkSize                 fSize;
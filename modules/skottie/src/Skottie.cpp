@@ -14,6 +14,7 @@
 #include "SkMakeUnique.h"
 #include "SkPaint.h"
 #include "SkPoint.h"
+#include "SkRegion.h"
 #include "SkSGColor.h"
 #include "SkSGInvalidationController.h"
 #include "SkSGOpacityEffect.h"
@@ -230,8 +231,16 @@ std::unique_ptr<sksg::Scene> AnimationBuilder::parse(const skjson::ObjectValue&
     this->parseAssets(jroot["assets"]);
     this->parseFonts(jroot["fonts"], jroot["chars"]);
 
+    // Precomp layers remap time for their children, but root layers are only ever ticked within
+    // the animation's [in..out] range.
+    const auto in_point  = ParseDefault<float>(jroot["ip"], 0.0f);
+    const LayerInfo active_range = {
+        in_point,
+        SkTMax(ParseDefault<float>(jroot["op"], SK_ScalarMax), in_point)
+    };
+
     AnimatorScope animators;
-    auto root = this->attachComposition(jroot, &animators);
+    auto root = this->attachComposition(jroot, &animators, &active_range);
 
     fStats->fAnimatorCount = animators.size();
 
@@ -490,6 +499,14 @@ void Animation::setShowInval(bool show) {
 }
 
 void Animation::render(SkCanvas* canvas, const SkRect* dstR) const {
+    this->render(canvas, dstR, nullptr);
+}
+
+void Animation::render(SkCanvas* canvas, const SkRect* dstR, const SkRect& damage) const {
+    this->render(canvas, dstR, &damage);
+}
+
+void Animation::render(SkCanvas* canvas, const SkRect* dstR, const SkRect* damage) const {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
     if (!fScene)
@@ -501,16 +518,23 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR) const {
         canvas->concat(SkMatrix::MakeRectToRect(srcR, *dstR, SkMatrix::kCenter_ScaleToFit));
     }
     canvas->clipRect(srcR);
+    if (damage) {
+        // Clip to whole device pixels, so that partially covered pixels at the edges of the
+        // damage are repainted completely.
+        SkRect devDamage;
+        canvas->getTotalMatrix().mapRect(&devDamage, *damage);
+        canvas->clipRegion(SkRegion(devDamage.roundOut()));
+    }
     fScene->render(canvas);
 }
 
-void Animation::seek(SkScalar t) {
+void Animation::seek(SkScalar t, sksg::InvalidationController* ic) {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
     if (!fScene)
         return;
 
-    fScene->animate(fInPoint + SkTPin(t, 0.0f, 1.0f) * (fOutPoint - fInPoint));
+    fScene->animate(fInPoint + SkTPin(t, 0.0f, 1.0f) * (fOutPoint - fInPoint), ic);
 }
 
 sk_sp<Animation> Animation::Make(const char* data, size_t length) {
@@ -587,8 +587,20 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachLayer(const skjson::ObjectValue*
     return std::move(controller_node);
 }
 
+// Layers are only rendered while active, i.e. within their [in..out] lifespan.  Mattes and matted
+// layers are attached in pairs though, so they are kept regardless.
+static bool is_active_in(const skjson::ObjectValue& jlayer, float in, float out) {
+    if (ParseDefault<bool>(jlayer["td"], false) || jlayer["tt"].is<skjson::NumberValue>()) {
+        return true;
+    }
+
+    return ParseDefault<float>(jlayer["op"], 0.0f) >= in &&
+           ParseDefault<float>(jlayer["ip"], 0.0f) <= out;
+}
+
 sk_sp<sksg::RenderNode> AnimationBuilder::attachComposition(const skjson::ObjectValue& comp,
-                                                            AnimatorScope* scope) const {
+                                                            AnimatorScope* scope,
+                                                            const LayerInfo* active_range) const {
     const skjson::ArrayValue* jlayers = comp["layers"];
     if (!jlayers) return nullptr;
 
@@ -596,7 +608,11 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachComposition(const skjson::Object
     AttachLayerContext                   layerCtx(*jlayers, scope);
 
     layers.reserve(jlayers->size());
-    for (const auto& l : *jlayers) {
+    for (const skjson::ObjectValue* l : *jlayers) {
+        if (l && active_range &&
+            !is_active_in(*l, active_range->fInPoint, active_range->fOutPoint)) {
+            continue;
+        }
         if (auto layer = this->attachLayer(l, &layerCtx)) {
             layers.push_back(std::move(layer));
         }
@@ -11,6 +11,7 @@
 #include "SkottieJson.h"
 #include "SkottieValue.h"
 #include "SkMakeUnique.h"
+#include "SkSGCacheEffect.h"
 #include "SkSGRenderNode.h"
 #include "SkSGScene.h"
 #include "SkTLazy.h"
@@ -83,7 +84,9 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachPrecompLayer(const skjson::Objec
         ascope->push_back(std::move(time_mapper));
     }
 
-    return precomp_layer;
+    // Precomps are often static, or only transformed/faded as a whole, so their content is worth
+    // caching once it stops changing.
+    return sksg::CacheEffect::Make(std::move(precomp_layer));
 }
 
 } // namespace internal
@@ -91,7 +91,10 @@ private:
 
     void dispatchMarkers(const skjson::ArrayValue*) const;
 
-    sk_sp<sksg::RenderNode> attachComposition(const skjson::ObjectValue&, AnimatorScope*) const;
+    // When |active_range| is specified, layers which are inactive throughout that range are not
+    // attached.
+    sk_sp<sksg::RenderNode> attachComposition(const skjson::ObjectValue&, AnimatorScope*,
+                                              const LayerInfo* active_range = nullptr) const;
     sk_sp<sksg::RenderNode> attachLayer(const skjson::ObjectValue*, AttachLayerContext*) const;
     sk_sp<sksg::RenderNode> attachLayerEffects(const skjson::ArrayValue& jeffects, AnimatorScope*,
                                                sk_sp<sksg::RenderNode>) const;
@@ -217,3 +217,31 @@ DEF_TEST(Skottie_Annotations, reporter) {
     REPORTER_ASSERT(reporter, std::get<1>(observer->fMarkers[1]) == 0.75f);
     REPORTER_ASSERT(reporter, std::get<2>(observer->fMarkers[1]) == 0.75f);
 }
+
+DEF_TEST(Skottie_InactiveLayers, reporter) {
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 100,
+                                     "h": 100,
+                                     "fr": 1,
+                                     "ip": 0,
+                                     "op": 10,
+                                     "layers": [
+                                       { "ty": 1, "sw": 10, "sh": 10, "sc": "#ffffff",
+                                         "ip": 0, "op": 10 },
+                                       { "ty": 1, "sw": 10, "sh": 10, "sc": "#ffffff",
+                                         "ip": 20, "op": 30 },
+                                       { "ty": 1, "sw": 10, "sh": 10, "sc": "#ffffff",
+                                         "ip": -10, "op": 0 }
+                                     ]
+                                   })";
+
+    SkMemoryStream stream(json, strlen(json));
+    Animation::Builder builder;
+    auto animation = builder.make(&stream);
+
+    REPORTER_ASSERT(reporter, animation);
+    // The layer outside the animation's [in..out] range is not attached, so it doesn't get a
+    // layer animator.
+    REPORTER_ASSERT(reporter, builder.getStats().fAnimatorCount == 2);
+}
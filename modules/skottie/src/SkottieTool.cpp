@@ -7,6 +7,7 @@
 
 #include "SkCanvas.h"
 #include "SkCommandLineFlags.h"
+#include "SkData.h"
 #include "SkGraphics.h"
 #include "SkMakeUnique.h"
 #include "SkOSFile.h"
@@ -16,6 +17,8 @@
 #include "SkPictureRecorder.h"
 #include "SkStream.h"
 #include "SkSurface.h"
+#include "SkTaskGroup.h"
+#include "SkTime.h"
 
 #include <vector>
 
@@ -30,6 +33,8 @@ DEFINE_double(fps, 30, "Decode frames per second.");
 DEFINE_int32(width , 800, "Render width.");
 DEFINE_int32(height, 600, "Render height.");
 
+DEFINE_int32(threads, 0, "Number of worker threads (0 -> render on the main thread).");
+
 namespace {
 
 class Sink {
@@ -154,6 +159,16 @@ private:
                           fWarnings;
 };
 
+std::unique_ptr<Sink> MakeSink(const char* format) {
+    if (0 == strcmp(format, "png")) {
+        return skstd::make_unique<PNGSink>();
+    }
+    if (0 == strcmp(format, "skp")) {
+        return skstd::make_unique<SKPSink>();
+    }
+    return nullptr;
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -174,23 +189,28 @@ int main(int argc, char** argv) {
         return 1;
     }
 
-    std::unique_ptr<Sink> sink;
-    if (0 == strcmp(FLAGS_format[0], "png")) {
-        sink = skstd::make_unique<PNGSink>();
-    } else if (0 == strcmp(FLAGS_format[0], "skp")) {
-        sink = skstd::make_unique<SKPSink>();
-    } else {
+    if (!MakeSink(FLAGS_format[0])) {
         SkDebugf("Unknown format: %s\n", FLAGS_format[0]);
         return 1;
     }
 
-    auto logger = sk_make_sp<Logger>();
+    auto data = SkData::MakeFromFileName(FLAGS_input[0]);
+    if (!data) {
+        SkDebugf("Could not read animation: '%s'.\n", FLAGS_input[0]);
+        return 1;
+    }
 
-    auto anim = skottie::Animation::Builder()
-            .setLogger(logger)
-            .setResourceProvider(
-                skottie_utils::FileResourceProvider::Make(SkOSPath::Dirname(FLAGS_input[0])))
-            .makeFromFile(FLAGS_input[0]);
+    auto resource_provider =
+            skottie_utils::FileResourceProvider::Make(SkOSPath::Dirname(FLAGS_input[0]));
+    const auto make_animation = [&](sk_sp<skottie::Logger> logger) {
+        return skottie::Animation::Builder()
+                .setLogger(std::move(logger))
+                .setResourceProvider(resource_provider)
+                .make(static_cast<const char*>(data->data()), data->size());
+    };
+
+    auto logger = sk_make_sp<Logger>();
+    auto anim = make_animation(logger);
     if (!anim) {
         SkDebugf("Could not load animation: '%s'.\n", FLAGS_input[0]);
         return 1;
@@ -203,11 +223,37 @@ int main(int argc, char** argv) {
                t1 = SkTPin(FLAGS_t1,  t0, 1.0),
                advance = 1 / std::min(anim->duration() * FLAGS_fps, kMaxFrames);
 
-    size_t frame_index = 0;
+    std::vector<double> frame_times;
     for (auto t = t0; t <= t1; t += advance) {
-        anim->seek(t);
-        sink->handleFrame(anim, frame_index++);
+        frame_times.push_back(t);
     }
 
+    // An animation's scene graph holds the state of its last seek, so each worker renders its
+    // share of the frames with its own animation instance, built from the same data.
+    const int worker_count = SkTMax(FLAGS_threads, 1);
+    SkTaskGroup::Enabler enabler(FLAGS_threads);
+
+    const auto start = SkTime::GetMSecs();
+    SkTaskGroup tg;
+    tg.batch(worker_count, [&](int worker) {
+        auto worker_anim = worker ? make_animation(nullptr) : anim;
+        auto sink = MakeSink(FLAGS_format[0]);
+        if (!worker_anim || !sink) {
+            SkDebugf("Could not set up worker %d.\n", worker);
+            return;
+        }
+
+        for (size_t i = worker; i < frame_times.size(); i += worker_count) {
+            worker_anim->seek(frame_times[i]);
+            sink->handleFrame(worker_anim, i);
+        }
+    });
+    tg.wait();
+    const auto elapsed = SkTime::GetMSecs() - start;
+
+    SkDebugf("Rendered %zu frames with %d thread%s in %.2f ms (%.2f fps).\n",
+             frame_times.size(), worker_count, worker_count == 1 ? "" : "s", elapsed,
+             elapsed > 0 ? frame_times.size() * 1000 / elapsed : 0.0);
+
     return 0;
 }
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSGCacheEffect_DEFINED
+#define SkSGCacheEffect_DEFINED
+
+#include "SkSGEffectNode.h"
+
+#include "SkPicture.h"
+
+namespace sksg {
+
+/**
+ * Caches the rendering of its descendants as an SkPicture, once they have remained unchanged for
+ * a number of frames.
+ *
+ * The picture is dropped whenever the sub-DAG is invalidated.  Since pictures are resolution
+ * independent, the cached content can be replayed under any ancestor transform, and ancestor
+ * opacity/color filter overrides are applied to it as a whole.
+ */
+class CacheEffect final : public EffectNode {
+public:
+    static sk_sp<CacheEffect> Make(sk_sp<RenderNode> child, int stable_frames = 2) {
+        return child ? sk_sp<CacheEffect>(new CacheEffect(std::move(child), stable_frames))
+                     : nullptr;
+    }
+
+protected:
+    CacheEffect(sk_sp<RenderNode>, int stable_frames);
+
+    void onRender(SkCanvas*, const RenderContext*) const override;
+
+    SkRect onRevalidate(InvalidationController*, const SkMatrix&) override;
+
+private:
+    const int                fStableFrames;
+
+    // Rendering state, updated by onRender().
+    mutable int              fUnchangedFrames = 0;
+    mutable sk_sp<SkPicture> fPicture;
+
+    typedef EffectNode INHERITED;
+};
+
+} // namespace sksg
+
+#endif // SkSGCacheEffect_DEFINED
@@ -18,6 +18,7 @@ class SkCanvas;
 
 namespace sksg {
 
+class InvalidationController;
 class RenderNode;
 
 /**
@@ -66,7 +67,11 @@ public:
     Scene& operator=(const Scene&) = delete;
 
     void render(SkCanvas*) const;
-    void animate(float t);
+
+    // Ticks the animators for |t|.  When |ic| is non-null, the scene is also revalidated and the
+    // areas which need to be repainted for the new frame are reported to |ic|: rendering only
+    // those, on top of the previous frame, draws the new frame.
+    void animate(float t, InvalidationController* ic = nullptr);
 
     void setShowInval(bool show) { fShowInval = show; }
 
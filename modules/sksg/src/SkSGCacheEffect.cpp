@@ -0,0 +1,49 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkSGCacheEffect.h"
+
+#include "SkCanvas.h"
+#include "SkPictureRecorder.h"
+
+namespace sksg {
+
+CacheEffect::CacheEffect(sk_sp<RenderNode> child, int stable_frames)
+    : INHERITED(std::move(child))
+    , fStableFrames(stable_frames) {}
+
+void CacheEffect::onRender(SkCanvas* canvas, const RenderContext* ctx) const {
+    if (!fPicture && ++fUnchangedFrames > fStableFrames) {
+        // Record without the paint overrides, so they can change without invalidating the
+        // picture.
+        SkPictureRecorder recorder;
+        this->INHERITED::onRender(recorder.beginRecording(this->bounds()), nullptr);
+        fPicture = recorder.finishRecordingAsPicture();
+    }
+
+    if (!fPicture) {
+        this->INHERITED::onRender(canvas, ctx);
+        return;
+    }
+
+    // The overrides are applied to the picture as a whole, like a group with several children
+    // would apply them.
+    const auto local_ctx = ScopedRenderContext(canvas, ctx).setIsolation(this->bounds(), true);
+    canvas->drawPicture(fPicture);
+}
+
+SkRect CacheEffect::onRevalidate(InvalidationController* ic, const SkMatrix& ctm) {
+    SkASSERT(this->hasInval());
+
+    // Something in the sub-DAG changed.
+    fPicture = nullptr;
+    fUnchangedFrames = 0;
+
+    return this->INHERITED::onRevalidate(ic, ctm);
+}
+
+} // namespace sksg
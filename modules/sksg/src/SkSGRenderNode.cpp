@@ -9,6 +9,7 @@
 
 #include "SkCanvas.h"
 #include "SkPaint.h"
+#include "SkRectPriv.h"
 
 namespace sksg {
 
@@ -16,6 +17,15 @@ RenderNode::RenderNode() : INHERITED(0) {}
 
 void RenderNode::render(SkCanvas* canvas, const RenderContext* ctx) const {
     SkASSERT(!this->hasInval());
+
+    // Skip nodes which are entirely clipped out (e.g. outside the damage area the caller is
+    // repainting).  "Infinite" bounds may not map to finite device bounds, so those are always
+    // rendered.
+    const auto& bounds = this->bounds();
+    if (SkRectPriv::MakeLargeS32().contains(bounds) && canvas->quickReject(bounds)) {
+        return;
+    }
+
     this->onRender(canvas, ctx);
 }
 
@@ -9,13 +9,17 @@
 
 #if !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "SkMakeUnique.h"
+#include "SkNoDrawCanvas.h"
 #include "SkRect.h"
 #include "SkRectPriv.h"
+#include "SkSGCacheEffect.h"
 #include "SkSGColor.h"
 #include "SkSGDraw.h"
 #include "SkSGGroup.h"
 #include "SkSGInvalidationController.h"
 #include "SkSGRect.h"
+#include "SkSGScene.h"
 #include "SkSGTransform.h"
 #include "SkTo.h"
 
@@ -209,4 +213,102 @@ DEF_TEST(SGInvalidation, reporter) {
     inval_group_remove(reporter);
 }
 
+namespace {
+
+class RectCountingCanvas final : public SkNoDrawCanvas {
+public:
+    RectCountingCanvas(int width, int height) : INHERITED(width, height) {}
+
+    int fRectCount    = 0,
+        fPictureCount = 0;
+
+protected:
+    void onDrawRect(const SkRect&, const SkPaint&) override { ++fRectCount; }
+    void onDrawPicture(const SkPicture*, const SkMatrix*, const SkPaint*) override {
+        ++fPictureCount;
+    }
+
+private:
+    using INHERITED = SkNoDrawCanvas;
+};
+
+class RectAnimator final : public sksg::Animator {
+public:
+    explicit RectAnimator(sk_sp<sksg::Rect> rect) : fRect(std::move(rect)) {}
+
+protected:
+    void onTick(float t) override {
+        fRect->setL(t);
+        fRect->setR(t + 100);
+    }
+
+private:
+    const sk_sp<sksg::Rect> fRect;
+};
+
+} // namespace
+
+DEF_TEST(SGDamageRender, reporter) {
+    auto color = sksg::Color::Make(SK_ColorBLACK);
+    auto r1    = sksg::Rect::Make(SkRect::MakeWH(100, 100)),
+         r2    = sksg::Rect::Make(SkRect::MakeLTRB(200, 0, 300, 100));
+    auto root  = sksg::Group::Make();
+    root->addChild(sksg::Draw::Make(r1, color));
+    root->addChild(sksg::Draw::Make(r2, color));
+
+    sksg::AnimatorList animators;
+    animators.push_back(skstd::make_unique<RectAnimator>(r2));
+    auto scene = sksg::Scene::Make(std::move(root), std::move(animators));
+
+    {
+        // The initial frame damages everything, and renders both rects.
+        sksg::InvalidationController ic;
+        scene->animate(200, &ic);
+        REPORTER_ASSERT(reporter, ic.bounds() == SkRectPriv::MakeLargeS32());
+
+        RectCountingCanvas canvas(400, 100);
+        scene->render(&canvas);
+        REPORTER_ASSERT(reporter, canvas.fRectCount == 2);
+    }
+
+    {
+        // Moving r2 only damages its old and new bounds, and nodes outside the damage are
+        // skipped.
+        sksg::InvalidationController ic;
+        scene->animate(250, &ic);
+        REPORTER_ASSERT(reporter, ic.bounds() == SkRect::MakeLTRB(200, 0, 350, 100));
+
+        RectCountingCanvas canvas(400, 100);
+        canvas.clipRect(ic.bounds());
+        scene->render(&canvas);
+        REPORTER_ASSERT(reporter, canvas.fRectCount == 1);
+    }
+}
+
+DEF_TEST(SGCacheEffect, reporter) {
+    auto color = sksg::Color::Make(SK_ColorBLACK);
+    auto root  = sksg::CacheEffect::Make(
+                     sksg::Draw::Make(sksg::Rect::Make(SkRect::MakeWH(100, 100)), color), 1);
+
+    const auto render_frame = [&]() {
+        sksg::InvalidationController ic;
+        root->revalidate(&ic, SkMatrix::I());
+
+        RectCountingCanvas canvas(100, 100);
+        root->render(&canvas);
+        return std::make_pair(canvas.fRectCount, canvas.fPictureCount);
+    };
+
+    // The content is drawn directly until it has been stable for one frame, and is replayed
+    // from a picture afterwards.
+    REPORTER_ASSERT(reporter, render_frame() == std::make_pair(1, 0));
+    REPORTER_ASSERT(reporter, render_frame() == std::make_pair(0, 1));
+    REPORTER_ASSERT(reporter, render_frame() == std::make_pair(0, 1));
+
+    // Changes to the content drop the picture.
+    color->setColor(SK_ColorRED);
+    REPORTER_ASSERT(reporter, render_frame() == std::make_pair(1, 0));
+    REPORTER_ASSERT(reporter, render_frame() == std::make_pair(0, 1));
+}
+
 #endif // !defined(SK_BUILD_FOR_GOOGLE3)
@@ -10,8 +10,11 @@
 #include "SkLoadICU.h"
 #include "SkMalloc.h"
 #include "SkOnce.h"
+#include "SkFloatBits.h"
 #include "SkFont.h"
 #include "SkFontMetrics.h"
+#include "SkLRUCache.h"
+#include "SkOpts.h"
 #include "SkPoint.h"
 #include "SkRefCnt.h"
 #include "SkScalar.h"
@@ -500,84 +503,88 @@ struct ShapedRunGlyphIterator {
 
 }  // namespace
 
-struct SkShaper::Impl {
-    HBFont fHarfBuzzFont;
-    HBBuffer fBuffer;
-    sk_sp<SkTypeface> fTypeface;
-    ICUBrk fBreakIterator;
+namespace {
+// Shaping results do not depend on the width, which only decides where lines break, so a text
+// shaped once can be laid out again at any width from the cache.
+struct ShapeCacheKey {
+    SkString fText;
+    SkFont fFont;
+    bool fLeftToRight;
+
+    bool operator==(const ShapeCacheKey& that) const {
+        return fLeftToRight == that.fLeftToRight && fFont == that.fFont && fText == that.fText;
+    }
+
+    struct Hash {
+        uint32_t operator()(const ShapeCacheKey& key) const {
+            uint32_t seed[] = {
+                key.fFont.getTypeface() ? key.fFont.getTypeface()->uniqueID() : 0,
+                SkFloat2Bits(key.fFont.getSize()),
+                SkFloat2Bits(key.fFont.getScaleX()),
+                key.fLeftToRight,
+            };
+            return SkOpts::hash_fn(key.fText.c_str(), key.fText.size(),
+                                   SkOpts::hash_fn(seed, sizeof(seed), 0));
+        }
+    };
 };
 
-SkShaper::SkShaper(sk_sp<SkTypeface> tf) : fImpl(new Impl) {
-    SkOnce once;
-    once([] { SkLoadICU(); });
+struct ShapedText {
+    SkString fText;
+    SkTArray<ShapedRun> fRuns;  // These point into fText.
+};
+}  // namespace
 
-    fImpl->fTypeface = tf ? std::move(tf) : SkTypeface::MakeDefault();
-    fImpl->fHarfBuzzFont = create_hb_font(fImpl->fTypeface.get());
-    if (!fImpl->fHarfBuzzFont) {
-        SkDebugf("create_hb_font failed!\n");
-    }
-    fImpl->fBuffer.reset(hb_buffer_create());
-    SkASSERT(fImpl->fBuffer);
+struct SkShaper::Impl {
+    static constexpr int kShapeCacheCount = 64;
 
-    UErrorCode status = U_ZERO_ERROR;
-    fImpl->fBreakIterator.reset(ubrk_open(UBRK_LINE, "th", nullptr, 0, &status));
-    if (U_FAILURE(status)) {
-        SkDebugf("Could not create break iterator: %s", u_errorName(status));
-        SK_ABORT("");
-    }
-}
+    Impl() : fShapeCache(kShapeCacheCount) {}
 
-SkShaper::~SkShaper() {}
+    // Itemizes and shapes utf8 into runs, and marks where lines may break.
+    bool shapeRuns(const SkFont& srcFont, const char* utf8, size_t utf8Bytes, bool leftToRight,
+                   SkTArray<ShapedRun>* runs);
 
-bool SkShaper::good() const {
-    return fImpl->fHarfBuzzFont &&
-           fImpl->fBuffer &&
-           fImpl->fTypeface &&
-           fImpl->fBreakIterator;
-}
+    HBFont fHarfBuzzFont;
+    HBBuffer fBuffer;
+    sk_sp<SkTypeface> fTypeface;
+    ICUBrk fBreakIterator;
+    SkLRUCache<ShapeCacheKey, ShapedText, ShapeCacheKey::Hash> fShapeCache;
+};
 
-SkPoint SkShaper::shape(RunHandler* handler,
-                        const SkFont& srcFont,
-                        const char* utf8,
-                        size_t utf8Bytes,
-                        bool leftToRight,
-                        SkPoint point,
-                        SkScalar width) const {
+bool SkShaper::Impl::shapeRuns(const SkFont& srcFont, const char* utf8, size_t utf8Bytes,
+                               bool leftToRight, SkTArray<ShapedRun>* runs) {
     sk_sp<SkFontMgr> fontMgr = SkFontMgr::RefDefault();
-    SkASSERT(handler);
     UBiDiLevel defaultLevel = leftToRight ? UBIDI_DEFAULT_LTR : UBIDI_DEFAULT_RTL;
     //hb_script_t script = ...
 
-    SkTArray<ShapedRun> runs;
-{
     RunIteratorQueue runSegmenter;
 
     SkTLazy<BiDiRunIterator> maybeBidi(BiDiRunIterator::Make(utf8, utf8Bytes, defaultLevel));
     BiDiRunIterator* bidi = maybeBidi.getMaybeNull();
     if (!bidi) {
-        return point;
+        return false;
     }
     runSegmenter.insert(bidi);
 
-    hb_unicode_funcs_t* hbUnicode = hb_buffer_get_unicode_funcs(fImpl->fBuffer.get());
+    hb_unicode_funcs_t* hbUnicode = hb_buffer_get_unicode_funcs(fBuffer.get());
     SkTLazy<ScriptRunIterator> maybeScript(ScriptRunIterator::Make(utf8, utf8Bytes, hbUnicode));
     ScriptRunIterator* script = maybeScript.getMaybeNull();
     if (!script) {
-        return point;
+        return false;
     }
     runSegmenter.insert(script);
 
     SkTLazy<FontRunIterator> maybeFont(FontRunIterator::Make(utf8, utf8Bytes,
-                                                             fImpl->fTypeface,
-                                                             fImpl->fHarfBuzzFont.get(),
+                                                             fTypeface,
+                                                             fHarfBuzzFont.get(),
                                                              std::move(fontMgr)));
     FontRunIterator* font = maybeFont.getMaybeNull();
     if (!font) {
-        return point;
+        return false;
     }
     runSegmenter.insert(font);
 
-    UBreakIterator& breakIterator = *fImpl->fBreakIterator;
+    UBreakIterator& breakIterator = *fBreakIterator;
     {
         UErrorCode status = U_ZERO_ERROR;
         UText utf8UText = UTEXT_INITIALIZER;
@@ -585,13 +592,13 @@ SkPoint SkShaper::shape(RunHandler* handler,
         std::unique_ptr<UText, SkFunctionWrapper<UText*, UText, utext_close>> autoClose(&utf8UText);
         if (U_FAILURE(status)) {
             SkDebugf("Could not create utf8UText: %s", u_errorName(status));
-            return point;
+            return false;
         }
         ubrk_setUText(&breakIterator, &utf8UText, &status);
         //utext_close(&utf8UText);
         if (U_FAILURE(status)) {
             SkDebugf("Could not setText on break iterator: %s", u_errorName(status));
-            return point;
+            return false;
         }
     }
 
@@ -601,7 +608,7 @@ SkPoint SkShaper::shape(RunHandler* handler,
         utf8Start = utf8End;
         utf8End = runSegmenter.endOfCurrentRun();
 
-        hb_buffer_t* buffer = fImpl->fBuffer.get();
+        hb_buffer_t* buffer = fBuffer.get();
         SkAutoTCallVProc<hb_buffer_t, hb_buffer_clear_contents> autoClearBuffer(buffer);
         hb_buffer_set_content_type(buffer, HB_BUFFER_CONTENT_TYPE_UNICODE);
         hb_buffer_set_cluster_level(buffer, HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
@@ -623,7 +630,7 @@ SkPoint SkShaper::shape(RunHandler* handler,
         size_t utf8runLength = utf8End - utf8Start;
         if (!SkTFitsIn<int>(utf8runLength)) {
             SkDebugf("Shaping error: utf8 too long");
-            return point;
+            return false;
         }
         hb_buffer_set_script(buffer, script->currentScript());
         hb_direction_t direction = is_LTR(bidi->currentLevel()) ? HB_DIRECTION_LTR:HB_DIRECTION_RTL;
@@ -650,13 +657,13 @@ SkPoint SkShaper::shape(RunHandler* handler,
 
         if (!SkTFitsIn<int>(len)) {
             SkDebugf("Shaping error: too many glyphs");
-            return point;
+            return false;
         }
 
         SkFont runFont(srcFont);
         runFont.setTypeface(sk_ref_sp(font->currentTypeface()));
-        ShapedRun& run = runs.emplace_back(utf8Start, utf8End, len, runFont, bidi->currentLevel(),
-                                           std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[len]));
+        ShapedRun& run = runs->emplace_back(utf8Start, utf8End, len, runFont, bidi->currentLevel(),
+                                            std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[len]));
         int scaleX, scaleY;
         hb_font_get_scale(font->currentHBFont(), &scaleX, &scaleY);
         double textSizeY = run.fFont.getSize() / scaleY;
@@ -694,15 +701,76 @@ SkPoint SkShaper::shape(RunHandler* handler,
             previousCluster = glyph.fCluster;
         }
     }
+    return true;
 }
 
+SkShaper::SkShaper(sk_sp<SkTypeface> tf) : fImpl(new Impl) {
+    SkOnce once;
+    once([] { SkLoadICU(); });
+
+    fImpl->fTypeface = tf ? std::move(tf) : SkTypeface::MakeDefault();
+    fImpl->fHarfBuzzFont = create_hb_font(fImpl->fTypeface.get());
+    if (!fImpl->fHarfBuzzFont) {
+        SkDebugf("create_hb_font failed!\n");
+    }
+    fImpl->fBuffer.reset(hb_buffer_create());
+    SkASSERT(fImpl->fBuffer);
+
+    UErrorCode status = U_ZERO_ERROR;
+    fImpl->fBreakIterator.reset(ubrk_open(UBRK_LINE, "th", nullptr, 0, &status));
+    if (U_FAILURE(status)) {
+        SkDebugf("Could not create break iterator: %s", u_errorName(status));
+        SK_ABORT("");
+    }
+}
+
+SkShaper::~SkShaper() {}
+
+bool SkShaper::good() const {
+    return fImpl->fHarfBuzzFont &&
+           fImpl->fBuffer &&
+           fImpl->fTypeface &&
+           fImpl->fBreakIterator;
+}
+
+SkPoint SkShaper::shape(RunHandler* handler,
+                        const SkFont& srcFont,
+                        const char* utf8,
+                        size_t utf8Bytes,
+                        bool leftToRight,
+                        SkPoint point,
+                        SkScalar width) const {
+    SkASSERT(handler);
+
+    ShapeCacheKey key{SkString(utf8, utf8Bytes), srcFont, leftToRight};
+    SkTArray<ShapedRun>* runs = nullptr;
+    if (ShapedText* cached = fImpl->fShapeCache.find(key)) {
+        // Line breaking below marks the shaped glyphs, so clear the marks left by the last
+        // layout of this text, which may have had another width.
+        runs = &cached->fRuns;
+        for (ShapedRun& run : *runs) {
+            for (int i = 0; i < run.fNumGlyphs; ++i) {
+                run.fGlyphs[i].fMustLineBreakBefore = false;
+            }
+        }
+    } else {
+        // The runs point into the text, so shape the copy that the cache will own.
+        ShapedText shaped;
+        shaped.fText = key.fText;
+        if (!fImpl->shapeRuns(srcFont, shaped.fText.c_str(), utf8Bytes, leftToRight,
+                              &shaped.fRuns)) {
+            return point;
+        }
+        runs = &fImpl->fShapeCache.insert(key, std::move(shaped))->fRuns;
+    }
+
 // Iterate over the glyphs in logical order to mark line endings.
 {
     SkScalar widthSoFar = 0;
     bool previousBreakValid = false; // Set when previousBreak is set to a valid candidate break.
     bool canAddBreakNow = false; // Disallow line breaks before the first glyph of a run.
-    ShapedRunGlyphIterator previousBreak(runs);
-    ShapedRunGlyphIterator glyphIterator(runs);
+    ShapedRunGlyphIterator previousBreak(*runs);
+    ShapedRunGlyphIterator glyphIterator(*runs);
     while (ShapedGlyph* glyph = glyphIterator.current()) {
         if (canAddBreakNow && glyph->fMayLineBreakBefore) {
             previousBreakValid = true;
@@ -741,8 +809,8 @@ SkPoint SkShaper::shape(RunHandler* handler,
 // Reorder the runs and glyphs per line and write them out.
     SkPoint currentPoint = point;
 {
-    ShapedRunGlyphIterator previousBreak(runs);
-    ShapedRunGlyphIterator glyphIterator(runs);
+    ShapedRunGlyphIterator previousBreak(*runs);
+    ShapedRunGlyphIterator glyphIterator(*runs);
     SkScalar maxAscent = 0;
     SkScalar maxDescent = 0;
     SkScalar maxLeading = 0;
@@ -755,7 +823,7 @@ SkPoint SkShaper::shape(RunHandler* handler,
 
         if (previousRunIndex != runIndex) {
             SkFontMetrics metrics;
-            runs[runIndex].fFont.getMetrics(&metrics);
+            (*runs)[runIndex].fFont.getMetrics(&metrics);
             maxAscent = SkTMin(maxAscent, metrics.fAscent);
             maxDescent = SkTMax(maxDescent, metrics.fDescent);
             maxLeading = SkTMax(maxLeading, metrics.fLeading);
@@ -772,7 +840,7 @@ SkPoint SkShaper::shape(RunHandler* handler,
         int numRuns = runIndex - previousBreak.fRunIndex + 1;
         SkAutoSTMalloc<4, UBiDiLevel> runLevels(numRuns);
         for (int i = 0; i < numRuns; ++i) {
-            runLevels[i] = runs[previousBreak.fRunIndex + i].fLevel;
+            runLevels[i] = (*runs)[previousBreak.fRunIndex + i].fLevel;
         }
         SkAutoSTMalloc<4, int32_t> logicalFromVisual(numRuns);
         ubidi_reorderVisual(runLevels, numRuns, logicalFromVisual);
@@ -785,9 +853,9 @@ SkPoint SkShaper::shape(RunHandler* handler,
                                 : 0;
             int endGlyphIndex = (logicalIndex == runIndex)
                               ? glyphIndex + 1
-                              : runs[logicalIndex].fNumGlyphs;
+                              : (*runs)[logicalIndex].fNumGlyphs;
 
-            const auto& run = runs[logicalIndex];
+            const auto& run = (*runs)[logicalIndex];
             const RunHandler::RunInfo info = {
                 lineIndex,
                 run.fAdvance,
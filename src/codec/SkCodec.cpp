@@ -10,6 +10,7 @@
 #include "SkCodecPriv.h"
 #include "SkColorSpace.h"
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkFrameHolder.h"
 #include "SkHalf.h"
 #ifdef SK_HAS_HEIF_LIBRARY
@@ -22,6 +23,7 @@
 #endif
 #include "SkRawCodec.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
 #include "SkWbmpCodec.h"
 #include "SkWebpCodec.h"
 #ifdef SK_HAS_WUFFS_LIBRARY
@@ -30,6 +32,8 @@
 #include "SkGifCodec.h"
 #endif
 
+#include <atomic>
+
 struct DecoderProc {
     bool (*IsFormat)(const void*, size_t);
     std::unique_ptr<SkCodec> (*MakeFromStream)(std::unique_ptr<SkStream>, SkCodec::Result*);
@@ -356,6 +360,12 @@ SkCodec::Result SkCodec::getPixels(const SkImageInfo& dstInfo, void* pixels, siz
     fDstInfo = info;
     fOptions = *options;
 
+    if (options->fExecutor && !options->fSubset && 0 == options->fFrameIndex
+            && info.dimensions() == this->dimensions() && this->onCanDecodeInStrips()
+            && this->decodeInStrips(info, pixels, rowBytes, *options)) {
+        return kSuccess;
+    }
+
     // On an incomplete decode, the subclass will specify the number of scanlines that it decoded
     // successfully.
     int rowsDecoded = 0;
@@ -380,6 +390,63 @@ SkCodec::Result SkCodec::getPixels(const SkImageInfo& dstInfo, void* pixels, siz
     return result;
 }
 
+// Each strip runs its own decoder from the start of the stream, so strips much shorter
+// than this spend more time repeating earlier work than they save.
+static constexpr int kMinRowsPerStrip = 128;
+static constexpr int kMaxStrips       = 8;
+
+static bool decode_strip(SkCodec* codec, const SkImageInfo& info, void* pixels, size_t rowBytes,
+                         const SkCodec::Options& options, int top, int bottom) {
+    void* dst = SkTAddOffset<void>(pixels, top * rowBytes);
+    SkCodec::Options stripOptions = options;
+    stripOptions.fExecutor = nullptr;
+
+    if (SkCodec::kSuccess == codec->startScanlineDecode(info, &stripOptions)) {
+        return codec->skipScanlines(top)
+            && codec->getScanlines(dst, bottom - top, rowBytes) == bottom - top;
+    }
+
+    const SkIRect subset = SkIRect::MakeLTRB(0, top, info.width(), bottom);
+    stripOptions.fSubset = &subset;
+    return SkCodec::kSuccess == codec->startIncrementalDecode(info, dst, rowBytes, &stripOptions)
+        && SkCodec::kSuccess == codec->incrementalDecode();
+}
+
+bool SkCodec::decodeInStrips(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                             const Options& options) {
+    const int stripCount = SkTMin(kMaxStrips, info.height() / kMinRowsPerStrip);
+    if (stripCount < 2 || !fStream) {
+        return false;
+    }
+
+    // Duplicating shares state with fStream, so do it here rather than on the executor.
+    std::unique_ptr<SkStream> streams[kMaxStrips];
+    for (int i = 0; i < stripCount; i++) {
+        streams[i] = fStream->duplicate();
+        if (!streams[i]) {
+            return false;
+        }
+    }
+
+    const int rowsPerStrip = info.height() / stripCount;
+    const SkEncodedImageFormat format = this->getEncodedFormat();
+    std::atomic<bool> failed{false};
+
+    SkTaskGroup strips(*options.fExecutor);
+    strips.batch(stripCount, [&](int i) {
+        const int top    = i * rowsPerStrip;
+        const int bottom = i == stripCount - 1 ? info.height() : top + rowsPerStrip;
+        std::unique_ptr<SkCodec> codec = MakeFromStream(std::move(streams[i]));
+        if (!codec || codec->getEncodedFormat() != format
+                || !decode_strip(codec.get(), info, pixels, rowBytes, options, top, bottom)) {
+            failed = true;
+        }
+    });
+    strips.wait();
+
+    return !failed;
+}
+
 SkCodec::Result SkCodec::startIncrementalDecode(const SkImageInfo& dstInfo, void* pixels,
         size_t rowBytes, const SkCodec::Options* options) {
     fStartedIncrementalDecode = false;
@@ -306,6 +306,8 @@ SkJpegCodec::SkJpegCodec(SkEncodedInfo&& info, std::unique_ptr<SkStream> stream,
     , fSwizzleSrcRow(nullptr)
     , fColorXformSrcRow(nullptr)
     , fSwizzlerSubset(SkIRect::MakeEmpty())
+    , fIncrementalDst(nullptr)
+    , fIncrementalRowBytes(0)
 {}
 
 /*
@@ -793,6 +795,12 @@ int SkJpegCodec::onGetScanlines(void* dst, int count, size_t dstRowBytes) {
     return rows;
 }
 
+bool SkJpegCodec::onCanDecodeInStrips() const {
+    // A progressive image would need every strip to buffer and decode the coefficients
+    // for the whole image, so only baseline images are worth splitting.
+    return !fDecoderMgr->dinfo()->progressive_mode;
+}
+
 bool SkJpegCodec::onSkipScanlines(int count) {
     // Set the jump location for libjpeg errors
     skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
@@ -803,6 +811,112 @@ bool SkJpegCodec::onSkipScanlines(int count) {
     return (uint32_t) count == jpeg_skip_scanlines(fDecoderMgr->dinfo(), count);
 }
 
+SkCodec::Result SkJpegCodec::onStartIncrementalDecode(const SkImageInfo& dstInfo, void* dst,
+        size_t rowBytes, const Options& options) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+
+    // Set the jump location for libjpeg errors
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return fDecoderMgr->returnFailure("setjmp", kInvalidInput);
+    }
+
+    // Baseline images arrive top to bottom, which the scanline decoder already handles.
+    if (options.fSubset || !jpeg_has_multiple_scans(dinfo)) {
+        return kUnimplemented;
+    }
+
+    setupJpegDecoding(dinfo);
+
+    // In buffered-image mode libjpeg keeps the coefficients of every scan it has read, so
+    // that we may output the image as of any completed scan.
+    dinfo->buffered_image = TRUE;
+    fDecoderMgr->sourceMgr()->startSuspendingInput();
+    if (!jpeg_start_decompress(dinfo)) {
+        return fDecoderMgr->returnFailure("startDecompress", kInvalidInput);
+    }
+
+    if (needs_swizzler_to_convert_from_cmyk(dinfo->out_color_space,
+                                            this->getEncodedInfo().profile(), this->colorXform())) {
+        this->initializeSwizzler(dstInfo, options, true);
+    }
+
+    this->allocateStorage(dstInfo);
+
+    fIncrementalDst = dst;
+    fIncrementalRowBytes = rowBytes;
+    return kSuccess;
+}
+
+SkCodec::Result SkJpegCodec::onIncrementalDecode(int* rowsDecoded) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+
+    // Set the jump location for libjpeg errors
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return fDecoderMgr->returnFailure("setjmp", kErrorInInput);
+    }
+
+    // Absorb all of the data that has arrived.
+    int status;
+    do {
+        status = jpeg_consume_input(dinfo);
+    } while (JPEG_REACHED_EOI != status &&
+             (JPEG_SUSPENDED != status || fDecoderMgr->sourceMgr()->readMoreInput()));
+    const bool reachedEOI = JPEG_REACHED_EOI == status;
+
+    // Block smoothing looks ahead into the next scan, so a scan is only shown once the next
+    // one has started, or the image is complete.
+    const int scan = reachedEOI ? dinfo->input_scan_number : dinfo->input_scan_number - 1;
+    if (scan > dinfo->output_scan_number && !this->outputScan(scan)) {
+        return fDecoderMgr->returnFailure("outputScan", kErrorInInput);
+    }
+
+    if (reachedEOI) {
+        return kSuccess;
+    }
+
+    if (rowsDecoded) {
+        // Each output pass writes every row, so the preview is either all there or not yet.
+        *rowsDecoded = dinfo->output_scan_number > 0 ? this->dstInfo().height() : 0;
+    }
+    return kIncompleteInput;
+}
+
+bool SkJpegCodec::outputScan(int scan) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+
+    // The previous output pass is left open until now, since finishing it may wait on
+    // input.  A later scan has started by now, so this will not.
+    if (dinfo->output_scan_number > 0 && !jpeg_finish_output(dinfo)) {
+        return false;
+    }
+    if (!jpeg_start_output(dinfo, scan)) {
+        return false;
+    }
+
+    const int height = (int) dinfo->output_height;
+    const int sampleY = fSwizzler ? fSwizzler->sampleY() : 1;
+    if (1 == sampleY) {
+        return height == this->readRows(this->dstInfo(), fIncrementalDst, fIncrementalRowBytes,
+                                        height, this->options());
+    }
+
+    void* dst = fIncrementalDst;
+    const int dstHeight = get_scaled_dimension(height, sampleY);
+    for (int i = 0; i < dstHeight; i++) {
+        const JDIMENSION skip = get_start_coord(sampleY) + i * sampleY - dinfo->output_scanline;
+        if (skip > 0 && skip != jpeg_skip_scanlines(dinfo, skip)) {
+            return false;
+        }
+        if (1 != this->readRows(this->dstInfo(), dst, fIncrementalRowBytes, 1, this->options())) {
+            return false;
+        }
+        dst = SkTAddOffset<void>(dst, fIncrementalRowBytes);
+    }
+    return true;
+}
+
 static bool is_yuv_supported(jpeg_decompress_struct* dinfo) {
     // Scaling is not supported in raw data mode.
     SkASSERT(dinfo->scale_num == dinfo->scale_denom);
@@ -131,6 +131,17 @@ private:
             const Options& options) override;
     int onGetScanlines(void* dst, int count, size_t rowBytes) override;
     bool onSkipScanlines(int count) override;
+    bool onCanDecodeInStrips() const override;
+
+    /*
+     * Incremental decoding of progressive images.  Each call absorbs whatever data has
+     * arrived and, if another scan is complete, writes the image as of that scan to dst,
+     * so that a low-resolution preview is refined in place as more data arrives.
+     */
+    Result onStartIncrementalDecode(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+            const Options&) override;
+    Result onIncrementalDecode(int* rowsDecoded) override;
+    bool outputScan(int scan);
 
     std::unique_ptr<JpegDecoderMgr>    fDecoderMgr;
 
@@ -150,6 +161,10 @@ private:
 
     std::unique_ptr<SkSwizzler>        fSwizzler;
 
+    // Destination of an incremental decode.
+    void*                              fIncrementalDst;
+    size_t                             fIncrementalRowBytes;
+
     friend class SkRawCodec;
 
     typedef SkCodec INHERITED;
@@ -58,6 +58,11 @@ public:
      */
     skjpeg_error_mgr* errorMgr() { return &fErrorMgr; }
 
+    /*
+     * Get the skjpeg_source_mgr in order to switch to suspending input
+     */
+    skjpeg_source_mgr* sourceMgr() { return &fSrcMgr; }
+
     /*
      * Get function for the decompress info struct
      */
@@ -88,6 +88,32 @@ static void sk_term_source(j_decompress_ptr dinfo)
     // need to modify SkJpegCodec to call jpeg_finish_decompress().
 }
 
+// Functions for suspending sources //
+
+/*
+ * Suspend instead of reading: readMoreInput() refills the buffer between calls into libjpeg
+ */
+static boolean sk_fill_suspending_input_buffer(j_decompress_ptr dinfo) {
+    return false;
+}
+
+/*
+ * Skip what we have now, and the rest of the bytes once they arrive
+ */
+static void sk_skip_suspending_input_data(j_decompress_ptr dinfo, long numBytes) {
+    skjpeg_source_mgr* src = (skjpeg_source_mgr*) dinfo->src;
+    size_t bytes = (size_t) numBytes;
+
+    if (bytes > src->bytes_in_buffer) {
+        src->fBytesToSkip += bytes - src->bytes_in_buffer;
+        src->next_input_byte += src->bytes_in_buffer;
+        src->bytes_in_buffer = 0;
+    } else {
+        src->next_input_byte += numBytes;
+        src->bytes_in_buffer -= numBytes;
+    }
+}
+
 // Functions for memory backed sources //
 
 /*
@@ -123,6 +149,8 @@ static boolean sk_fill_mem_input_buffer (j_decompress_ptr cinfo) {
  */
 skjpeg_source_mgr::skjpeg_source_mgr(SkStream* stream)
     : fStream(stream)
+    , fSuspendingBufferSize(0)
+    , fBytesToSkip(0)
 {
     if (stream->hasLength() && stream->getMemoryBase()) {
         init_source = sk_init_mem_source;
@@ -140,3 +168,49 @@ skjpeg_source_mgr::skjpeg_source_mgr(SkStream* stream)
         term_source = sk_term_source;
     }
 }
+
+void skjpeg_source_mgr::startSuspendingInput() {
+    if (fill_input_buffer != sk_fill_buffered_input_buffer) {
+        return;
+    }
+
+    // Carry over what is left of the data read for the header.
+    fSuspendingBufferSize = kBufferSize;
+    fSuspendingBuffer.reset(fSuspendingBufferSize);
+    if (bytes_in_buffer > 0) {
+        memcpy(fSuspendingBuffer.get(), next_input_byte, bytes_in_buffer);
+    }
+    next_input_byte = (const JOCTET*) fSuspendingBuffer.get();
+
+    fill_input_buffer = sk_fill_suspending_input_buffer;
+    skip_input_data = sk_skip_suspending_input_data;
+}
+
+bool skjpeg_source_mgr::readMoreInput() {
+    if (fill_input_buffer != sk_fill_suspending_input_buffer) {
+        return false;
+    }
+
+    if (fBytesToSkip > 0) {
+        fBytesToSkip -= fStream->skip(fBytesToSkip);
+        if (fBytesToSkip > 0) {
+            return false;
+        }
+    }
+
+    // Keep the bytes after libjpeg's restart point at the front of the buffer, and make
+    // sure there is room for a useful amount of new data after them.
+    const size_t unread = bytes_in_buffer;
+    if (unread > 0) {
+        memmove(fSuspendingBuffer.get(), next_input_byte, unread);
+    }
+    if (fSuspendingBufferSize - unread < kBufferSize) {
+        fSuspendingBufferSize = 2 * fSuspendingBufferSize;
+        fSuspendingBuffer.realloc(fSuspendingBufferSize);
+    }
+
+    size_t bytes = fStream->read(fSuspendingBuffer.get() + unread, fSuspendingBufferSize - unread);
+    next_input_byte = (const JOCTET*) fSuspendingBuffer.get();
+    bytes_in_buffer = unread + bytes;
+    return bytes > 0;
+}
@@ -11,6 +11,7 @@
 
 #include "SkJpegPriv.h"
 #include "SkStream.h"
+#include "SkTemplates.h"
 
 #include <setjmp.h>
 // stdio is needed for jpeglib
@@ -32,6 +33,22 @@ void skjpeg_err_exit(j_common_ptr cinfo);
 struct skjpeg_source_mgr : jpeg_source_mgr {
     skjpeg_source_mgr(SkStream* stream);
 
+    /*
+     * Switch to libjpeg's suspending input mode, used for incremental decoding.
+     * Instead of blocking on the stream, libjpeg suspends when it runs out of
+     * data, backing up to the start of whatever it was reading, and
+     * readMoreInput() supplies the rest once the stream has it.
+     * Memory backed sources already hold all of their data, so this only
+     * affects buffered sources.
+     */
+    void startSuspendingInput();
+
+    /*
+     * Append the data that the stream has received since libjpeg suspended.
+     * Returns false if there is nothing new.
+     */
+    bool readMoreInput();
+
     SkStream* fStream; // unowned
     enum {
         // TODO (msarett): Experiment with different buffer sizes.
@@ -39,6 +56,13 @@ struct skjpeg_source_mgr : jpeg_source_mgr {
         kBufferSize = 1024
     };
     uint8_t fBuffer[kBufferSize];
+
+    // When suspending, libjpeg may back up to any byte that it has not yet
+    // marked as consumed, so unread data is kept here and the buffer grows
+    // as needed to hold a whole MCU or marker.
+    SkAutoTMalloc<uint8_t> fSuspendingBuffer;
+    size_t                 fSuspendingBufferSize;
+    size_t                 fBytesToSkip;
 };
 
 #endif
@@ -555,6 +555,10 @@ private:
         fDst = SkTAddOffset<void>(fDst, fRowBytes);
     }
 
+    // Rows before a strip still have to be inflated and unfiltered, but only the rows
+    // in the strip are swizzled and color transformed.
+    bool onCanDecodeInStrips() const override { return true; }
+
     void setRange(int firstRow, int lastRow, void* dst, size_t rowBytes) override {
         png_set_progressive_read_fn(this->png_ptr(), this, nullptr, RowCallback, nullptr);
         fFirstRow = firstRow;
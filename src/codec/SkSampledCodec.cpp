@@ -9,6 +9,7 @@
 #include "SkCodecPriv.h"
 #include "SkMath.h"
 #include "SkMathPriv.h"
+#include "SkNx.h"
 #include "SkSampledCodec.h"
 #include "SkSampler.h"
 #include "SkTemplates.h"
@@ -213,6 +214,15 @@ SkCodec::Result SkSampledCodec::sampledDecode(const SkImageInfo& info, void* pix
 
     const SkImageInfo nativeInfo = info.makeWH(nativeSize.width(), nativeSize.height());
 
+    if (options.fBoxFilter) {
+        SkCodec::Result result = this->boxFilterDecode(info, pixels, rowBytes, options,
+                                                       nativeInfo, sampledOptions, subsetY,
+                                                       subsetWidth, sampleX, sampleY);
+        if (SkCodec::kUnimplemented != result) {
+            return result;
+        }
+    }
+
     {
         // Although startScanlineDecode expects the bottom and top to match the
         // SkImageInfo, startIncrementalDecode uses them to determine which rows to
@@ -350,3 +360,82 @@ SkCodec::Result SkSampledCodec::sampledDecode(const SkImageInfo& info, void* pix
             return SkCodec::kUnimplemented;
     }
 }
+
+// Adds each sampleX wide run of 8888 pixels in src to the per channel sums of one dst pixel.
+static void box_filter_accumulate(float* sums, const uint32_t* src, int dstWidth, int sampleX) {
+    for (int x = 0; x < dstWidth; x++) {
+        Sk4f sum = Sk4f::Load(sums);
+        for (int i = 0; i < sampleX; i++) {
+            sum = sum + SkNx_cast<float>(Sk4b::Load(src++));
+        }
+        sum.store(sums);
+        sums += 4;
+    }
+}
+
+static void box_filter_store(uint32_t* dst, const float* sums, int dstWidth, float scale) {
+    for (int x = 0; x < dstWidth; x++) {
+        SkNx_cast<uint8_t>(Sk4f::Load(sums) * scale + 0.5f).store(dst++);
+        sums += 4;
+    }
+}
+
+SkCodec::Result SkSampledCodec::boxFilterDecode(const SkImageInfo& info, void* pixels,
+        size_t rowBytes, const AndroidOptions& options, const SkImageInfo& nativeInfo,
+        const SkCodec::Options& codecOptions, int subsetY, int subsetWidth,
+        int sampleX, int sampleY) {
+    // Averaging unpremultiplied colors would bleed the colors of transparent pixels.
+    if ((kRGBA_8888_SkColorType != info.colorType() &&
+         kBGRA_8888_SkColorType != info.colorType()) ||
+            kUnpremul_SkAlphaType == info.alphaType() ||
+            SkCodec::kTopDown_SkScanlineOrder != this->codec()->getScanlineOrder()) {
+        return SkCodec::kUnimplemented;
+    }
+
+    SkCodec::Result result = this->codec()->startScanlineDecode(nativeInfo, &codecOptions);
+    if (SkCodec::kIncompleteInput == result || SkCodec::kErrorInInput == result) {
+        return SkCodec::kInvalidInput;
+    } else if (SkCodec::kSuccess != result) {
+        return result;
+    }
+
+    // Decode whole rows of the subset, and let the blocks drop any remainder.
+    SkSampler* sampler = this->codec()->getSampler(true);
+    if (!sampler) {
+        return SkCodec::kUnimplemented;
+    }
+    if (sampler->setSampleX(1) != subsetWidth) {
+        return SkCodec::kInvalidScale;
+    }
+
+    // this->codec() would fill the full width of its rows, so we fill the rest ourselves.
+    const int dstWidth = info.width(),
+              dstHeight = info.height();
+    auto fillRemainingRows = [&](int y) {
+        SkSampler::Fill(info.makeWH(dstWidth, dstHeight - y),
+                        SkTAddOffset<void>(pixels, y * rowBytes), rowBytes,
+                        options.fZeroInitialized);
+        return SkCodec::kIncompleteInput;
+    };
+
+    SkASSERT(dstWidth * sampleX <= subsetWidth);
+    if (!this->codec()->skipScanlines(subsetY)) {
+        return fillRemainingRows(0);
+    }
+
+    SkAutoTMalloc<uint32_t> row(subsetWidth);
+    SkAutoTMalloc<float> sums(4 * dstWidth);
+    const float scale = 1.0f / (sampleX * sampleY);
+    for (int y = 0; y < dstHeight; y++) {
+        sk_bzero(sums.get(), 4 * dstWidth * sizeof(float));
+        for (int i = 0; i < sampleY; i++) {
+            if (1 != this->codec()->getScanlines(row.get(), 1, 0)) {
+                return fillRemainingRows(y);
+            }
+            box_filter_accumulate(sums.get(), row.get(), dstWidth, sampleX);
+        }
+        box_filter_store(SkTAddOffset<uint32_t>(pixels, y * rowBytes), sums.get(), dstWidth,
+                         scale);
+    }
+    return SkCodec::kSuccess;
+}
@@ -54,6 +54,18 @@ private:
     SkCodec::Result sampledDecode(const SkImageInfo& info, void* pixels, size_t rowBytes,
             const AndroidOptions& options);
 
+    /**
+     *  Called by sampledDecode() for AndroidOptions::fBoxFilter.  Decodes every row of
+     *  the (native scaled) subset and averages each sampleX by sampleY block of it.
+     *
+     *  Returns kUnimplemented if fCodec cannot provide the rows, in which case the
+     *  caller should point sample instead.
+     */
+    SkCodec::Result boxFilterDecode(const SkImageInfo& info, void* pixels, size_t rowBytes,
+            const AndroidOptions& options, const SkImageInfo& nativeInfo,
+            const SkCodec::Options& codecOptions, int subsetY, int subsetWidth,
+            int sampleX, int sampleY);
+
     typedef SkAndroidCodec INHERITED;
 };
 #endif // SkSampledCodec_DEFINED
@@ -1172,6 +1172,7 @@ SkSwizzler::SkSwizzler(RowProc fastProc, RowProc proc, const SkPMColor* ctable,
     : fFastProc(fastProc)
     , fSlowProc(proc)
     , fActualProc(fFastProc ? fFastProc : fSlowProc)
+    , fGatherSamples(false)
     , fColorTable(ctable)
     , fSrcOffset(srcOffset)
     , fDstOffset(dstOffset)
@@ -1218,9 +1219,14 @@ int SkSwizzler::onSetSampleX(int sampleX) {
         }
     }
 
-    // The optimized swizzler functions do not support sampling.  Sampled swizzles
-    // are already fast because they skip pixels.  We haven't seen a situation
-    // where speeding up sampling has a significant impact on total decode time.
+    // The optimized swizzler functions do not support sampling, but thumbnail decodes spend
+    // most of their swizzling time converting and premultiplying the samples, so we gather
+    // them for the optimized functions.  Plain copies already run at the speed of the gather.
+    const bool slowProcIsCopy = fSlowProc == &sample1 || fSlowProc == &sample2 ||
+                                fSlowProc == &sample4 || fSlowProc == &sample6 ||
+                                fSlowProc == &sample8 ||
+                                fSlowProc == &SkipLeading8888ZerosThen<sample4>;
+    fGatherSamples = fSampleX > 1 && fFastProc && !slowProcIsCopy && fSrcBPP <= 4;
     if (1 == fSampleX && fFastProc) {
         fActualProc = fFastProc;
     } else {
@@ -1230,8 +1236,44 @@ int SkSwizzler::onSetSampleX(int sampleX) {
     return fAllocatedWidth;
 }
 
+template <int kBPP>
+static void gather(uint8_t* SK_RESTRICT dst, const uint8_t* SK_RESTRICT src, int count,
+                   int deltaSrc) {
+    for (int i = 0; i < count; i++) {
+        memcpy(dst, src, kBPP);
+        dst += kBPP;
+        src += deltaSrc;
+    }
+}
+
+void SkSwizzler::gatherAndSwizzle(void* dst, const uint8_t* SK_RESTRICT src) {
+    // Small enough to stay in L1 between the gather and the swizzle.
+    static constexpr int kMaxRun = 256;
+    uint8_t run[kMaxRun * 4];
+
+    const int deltaSrc = fSampleX * fSrcBPP;
+    src += fSrcOffsetUnits;
+    for (int x = 0; x < fSwizzleWidth; x += kMaxRun) {
+        const int count = SkTMin(kMaxRun, fSwizzleWidth - x);
+        switch (fSrcBPP) {
+            case 1: gather<1>(run, src, count, deltaSrc); break;
+            case 2: gather<2>(run, src, count, deltaSrc); break;
+            case 3: gather<3>(run, src, count, deltaSrc); break;
+            case 4: gather<4>(run, src, count, deltaSrc); break;
+            default: SkASSERT(false); return;
+        }
+        fFastProc(dst, run, count, fSrcBPP, fSrcBPP, 0, fColorTable);
+        src += count * deltaSrc;
+        dst = SkTAddOffset<void>(dst, count * fDstBPP);
+    }
+}
+
 void SkSwizzler::swizzle(void* dst, const uint8_t* SK_RESTRICT src) {
     SkASSERT(nullptr != dst && nullptr != src);
+    if (fGatherSamples) {
+        this->gatherAndSwizzle(SkTAddOffset<void>(dst, fDstOffsetBytes), src);
+        return;
+    }
     fActualProc(SkTAddOffset<void>(dst, fDstOffsetBytes), src, fSwizzleWidth, fSrcBPP,
             fSampleX * fSrcBPP, fSrcOffsetUnits, fColorTable);
 }
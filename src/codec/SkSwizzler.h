@@ -116,6 +116,10 @@ private:
     static void SkipLeadingGrayAlphaZerosThen(void* dst, const uint8_t* src, int width, int bpp,
                                               int deltaSrc, int offset, const SkPMColor ctable[]);
 
+    // Gathers the sampled pixels of src into short contiguous runs and swizzles each run with
+    // fFastProc, so that sampled decodes still convert and premultiply with SIMD.
+    void gatherAndSwizzle(void* dst, const uint8_t* SK_RESTRICT src);
+
     // May be NULL.  We have not implemented optimized functions for all supported transforms.
     const RowProc       fFastProc;
     // Always non-NULL.  Supports sampling.
@@ -123,6 +127,8 @@ private:
     // The actual RowProc we are using.  This depends on if fFastProc is non-NULL and
     // whether or not we are sampling.
     RowProc             fActualProc;
+    // True if we are sampling, and gather the samples for fFastProc rather than use fSlowProc.
+    bool                fGatherSamples;
 
     const SkPMColor*    fColorTable;      // Unowned pointer
 
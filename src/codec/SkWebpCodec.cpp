@@ -496,6 +496,8 @@ SkCodec::Result SkWebpCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
     config.output.colorspace = webp_decode_mode(webpInfo.colorType(),
             frame.has_alpha && dstInfo.alphaType() == kPremul_SkAlphaType && !this->colorXform());
     config.output.is_external_memory = 1;
+    // libwebp owns its worker thread, so the executor only signals that threading is welcome.
+    config.options.use_threads = options.fExecutor ? 1 : 0;
 
     config.output.u.RGBA.rgba = reinterpret_cast<uint8_t*>(webpDst.getAddr(dstX, dstY));
     config.output.u.RGBA.stride = static_cast<int>(webpDst.rowBytes());
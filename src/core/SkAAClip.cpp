@@ -10,6 +10,7 @@
 #include "SkBlitter.h"
 #include "SkColorData.h"
 #include "SkMacros.h"
+#include "SkNx.h"
 #include "SkPath.h"
 #include "SkRectPriv.h"
 #include "SkScan.h"
@@ -1141,6 +1142,18 @@ private:
     }
 
     static void AppendRun(SkTDArray<uint8_t>& data, U8CPU alpha, int count) {
+        // Scan converters often hand us neighboring runs of the same alpha (e.g. the zeros
+        // between spans, or a span split at a supersample boundary), so top up the last run
+        // before starting a new one. Fewer runs make every later op and blit on this row cheaper.
+        int n = data.count();
+        if (n > 0 && data[n - 1] == alpha && data[n - 2] < 255) {
+            int room = SkMin32(255 - data[n - 2], count);
+            data[n - 2] += room;
+            count -= room;
+            if (0 == count) {
+                return;
+            }
+        }
         do {
             int n = count;
             if (n > 255) {
@@ -1998,6 +2011,30 @@ static inline uint16_t mergeOne(uint16_t value, unsigned alpha) {
                        SkMulDiv255Round(b, alpha));
 }
 
+// Scales n coverage values by alpha, 8 at a time. This is SkMulDiv255Round() exactly: neither
+// v*a + 128 nor that plus its high byte can overflow 16 bits.
+static void merge_span(const uint8_t* SK_RESTRICT src, int n, unsigned alpha,
+                       uint8_t* SK_RESTRICT dst) {
+    const Sk8h alpha8(alpha);
+    while (n >= 8) {
+        Sk8h prod = SkNx_cast<uint16_t>(Sk8b::Load(src)) * alpha8 + Sk8h(128);
+        SkNx_cast<uint8_t>((prod + (prod >> 8)) >> 8).store(dst);
+        src += 8;
+        dst += 8;
+        n -= 8;
+    }
+    for (int i = 0; i < n; ++i) {
+        dst[i] = mergeOne(src[i], alpha);
+    }
+}
+
+static void merge_span(const uint16_t* SK_RESTRICT src, int n, unsigned alpha,
+                       uint16_t* SK_RESTRICT dst) {
+    for (int i = 0; i < n; ++i) {
+        dst[i] = mergeOne(src[i], alpha);
+    }
+}
+
 template <typename T>
 void mergeT(const void* inSrc, int srcN, const uint8_t* SK_RESTRICT row, int rowN, void* inDst) {
     const T* SK_RESTRICT src = static_cast<const T*>(inSrc);
@@ -2013,9 +2050,7 @@ void mergeT(const void* inSrc, int srcN, const uint8_t* SK_RESTRICT row, int row
         } else if (0 == rowA) {
             small_bzero(dst, n * sizeof(T));
         } else {
-            for (int i = 0; i < n; ++i) {
-                dst[i] = mergeOne(src[i], rowA);
-            }
+            merge_span(src, n, rowA, dst);
         }
 
         if (0 == (srcN -= n)) {
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkArenaAllocPool.h"
+#include "SkTLS.h"
+#include "SkTo.h"
+
+#include <algorithm>
+
+namespace {
+
+struct ThreadPool {
+    // Arenas nest (a draw may draw), so keep a block for each of the first few levels.
+    static constexpr int kMaxFreeBlocks = 4;
+
+    char*    fFreeBlocks[kMaxFreeBlocks];
+    int      fFreeCount = 0;
+    uint32_t fBlockSize = SkArenaAllocPool::kMinBlockSize;
+    int      fHeapAllocations = 0;
+
+    ~ThreadPool() { this->freeBlocks(); }
+
+    void freeBlocks() {
+        for (int i = 0; i < fFreeCount; i++) {
+            delete[] fFreeBlocks[i];
+        }
+        fFreeCount = 0;
+    }
+};
+
+}  // namespace
+
+static void* create_thread_pool() { return new ThreadPool; }
+static void delete_thread_pool(void* pool) { delete static_cast<ThreadPool*>(pool); }
+
+static ThreadPool* get_thread_pool() {
+    return static_cast<ThreadPool*>(SkTLS::Get(create_thread_pool, delete_thread_pool));
+}
+
+SkArenaAllocPool::Block::Block() {
+    ThreadPool* pool = get_thread_pool();
+    fSize = pool->fBlockSize;
+    if (pool->fFreeCount > 0) {
+        fStorage = pool->fFreeBlocks[--pool->fFreeCount];
+    } else {
+        fStorage = new char[fSize];
+        pool->fHeapAllocations++;
+    }
+}
+
+SkArenaAllocPool::Block::~Block() {
+    ThreadPool* pool = get_thread_pool();
+    if (fOverflow > 0) {
+        pool->fHeapAllocations++;
+        // Grow so that next time everything fits in the block, rounded up to whole pages.
+        size_t wanted = std::min<size_t>((size_t)fSize + fOverflow, kMaxBlockSize);
+        uint32_t size = SkToU32((wanted + 4095) & ~(size_t)4095);
+        if (size > pool->fBlockSize) {
+            pool->fBlockSize = size;
+            pool->freeBlocks();
+        }
+    }
+    if (fSize == pool->fBlockSize && pool->fFreeCount < ThreadPool::kMaxFreeBlocks) {
+        pool->fFreeBlocks[pool->fFreeCount++] = fStorage;
+    } else {
+        delete[] fStorage;
+    }
+}
+
+int SkArenaAllocPool::HeapAllocations() {
+    return get_thread_pool()->fHeapAllocations;
+}
+
+size_t SkArenaAllocPool::BlockSize() {
+    return get_thread_pool()->fBlockSize;
+}
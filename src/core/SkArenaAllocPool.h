@@ -0,0 +1,60 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkArenaAllocPool_DEFINED
+#define SkArenaAllocPool_DEFINED
+
+#include "SkArenaAlloc.h"
+#include "SkNoncopyable.h"
+#include "SkTypes.h"
+
+/**
+ * Each thread keeps a few blocks of scratch memory for the arenas that draws build on the stack
+ * (blitters, shader contexts, raster pipelines). When an arena outgrows its block, the thread's
+ * block size grows to cover everything the arena needed, so a thread that keeps drawing the same
+ * kinds of things soon stops touching the heap.
+ */
+class SkArenaAllocPool {
+public:
+    /** A block of the calling thread's scratch memory, returned to the pool when destroyed. */
+    class Block : SkNoncopyable {
+    public:
+        Block();
+        ~Block();
+
+    protected:
+        char*    fStorage;
+        uint32_t fSize;
+        size_t   fOverflow = 0;  // How far past fSize the arena using this block had to go.
+    };
+
+    /** The number of times pooled arenas on this thread went to the heap, be it for a new block
+        or because an arena overflowed its block. In steady state this stops increasing. */
+    static int HeapAllocations();
+
+    /** The size of the blocks this thread currently hands out. */
+    static size_t BlockSize();
+
+    static constexpr uint32_t kMinBlockSize = 4 * 1024;
+    static constexpr uint32_t kMaxBlockSize = 256 * 1024;
+};
+
+/**
+ * An SkArenaAlloc whose first block is borrowed from SkArenaAllocPool. Use this in place of an
+ * SkSTArenaAlloc for per-draw scratch allocations.
+ */
+class SkPooledArenaAlloc : private SkArenaAllocPool::Block, public SkArenaAlloc {
+public:
+    SkPooledArenaAlloc() : SkArenaAlloc(fStorage, fSize, fSize) {}
+
+    ~SkPooledArenaAlloc() {
+        // Block's destructor runs after SkArenaAlloc's, once the objects in fStorage are gone.
+        fOverflow = this->heapBytes();
+    }
+};
+
+#endif
@@ -8,7 +8,7 @@
 #ifndef SkAutoBlitterChoose_DEFINED
 #define SkAutoBlitterChoose_DEFINED
 
-#include "SkArenaAlloc.h"
+#include "SkArenaAllocPool.h"
 #include "SkBlitter.h"
 #include "SkDraw.h"
 #include "SkMacros.h"
@@ -49,7 +49,7 @@ private:
     // Owned by fAlloc, which will handle the delete.
     SkBlitter* fBlitter = nullptr;
 
-    SkSTArenaAlloc<kSkBlitterContextSize> fAlloc;
+    SkPooledArenaAlloc fAlloc;
 };
 #define SkAutoBlitterChoose(...) SK_REQUIRE_LOCAL_VAR(SkAutoBlitterChoose)
 
@@ -31,6 +31,16 @@ public:
      */
     virtual void search(const SkRect& query, SkTDArray<int>* results) const = 0;
 
+    /**
+     * Populate results[i] with the indices of bounding boxes intersecting queries[i], as if by
+     * calling search() once for each query. Subclasses may share one walk of the hierarchy.
+     */
+    virtual void searchAll(const SkRect queries[], int count, SkTDArray<int> results[]) const {
+        for (int i = 0; i < count; ++i) {
+            this->search(queries[i], &results[i]);
+        }
+    }
+
     virtual size_t bytesUsed() const = 0;
 
     // Get the root bound.
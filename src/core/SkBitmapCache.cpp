@@ -291,7 +291,8 @@ const SkMipMap* SkMipMapCache::AddAndRef(const SkBitmapProvider& provider,
         return nullptr;
     }
 
-    SkMipMap* mipmap = SkMipMap::Build(src, get_fact(localCache));
+    // The sampler only asks for the levels it needs, so generate those on demand.
+    SkMipMap* mipmap = SkMipMap::Build(src, get_fact(localCache), true);
     if (mipmap) {
         MipMapRec* rec = new MipMapRec(provider.makeCacheDesc(), mipmap);
         CHECK_LOCAL(localCache, add, Add, rec);
@@ -10,6 +10,7 @@
 #include "SkGlyphRun.h"
 #include "SkImageFilter.h"
 #include "SkImageFilterCache.h"
+#include "SkImageFilterPriv.h"
 #include "SkMakeUnique.h"
 #include "SkMatrix.h"
 #include "SkPaint.h"
@@ -629,9 +630,10 @@ void SkBitmapDevice::drawSpecial(SkSpecialImage* src, int x, int y, const SkPain
         const SkIRect clipBounds = fRCStack.rc().getBounds().makeOffset(-x, -y);
         sk_sp<SkImageFilterCache> cache(this->getImageFilterCache());
         SkImageFilter::OutputProperties outputProperties(fBitmap.colorType(), fBitmap.colorSpace());
-        SkImageFilter::Context ctx(matrix, clipBounds, cache.get(), outputProperties);
+        SkImageFilter::Context ctx(matrix, clipBounds, cache.get(), outputProperties,
+                                   gSkImageFilterExecutor.load(std::memory_order_relaxed));
 
-        filteredImage = filter->filterImage(src, ctx, &offset);
+        filteredImage = SkFilterImageInTiles(filter, src, ctx, &offset);
         if (!filteredImage) {
             return;
         }
@@ -774,6 +774,13 @@ bool SkBlitter::UseRasterPipelineBlitter(const SkPixmap& device, const SkPaint&
         return true;
     }
 
+    // Filtered images sample faster in the raster pipeline's fused bilerp_*_8888 stages than
+    // through SkBitmapProcState, whatever the tile modes.
+    if (paint.getFilterQuality() != kNone_SkFilterQuality &&
+        paint.getShader() && paint.getShader()->isAImage()) {
+        return true;
+    }
+
     // All the real legacy fast paths are for shaders and SrcOver.
     // Choosing SkRasterPipelineBlitter will also let us to hit its single-color memset path.
     if (!paint.getShader() && paint.getBlendMode() != SkBlendMode::kSrcOver) {
@@ -781,6 +788,10 @@ bool SkBlitter::UseRasterPipelineBlitter(const SkPixmap& device, const SkPaint&
     }
 
     // Only kN32 and 565 are handled by legacy blitters now, 565 mostly just for Android.
+    // A8 has a legacy blitter for solid colors, which are all SrcOver by now.
+    if (device.colorType() == kAlpha_8_SkColorType) {
+        return paint.getShader() != nullptr;
+    }
     return device.colorType() != kN32_SkColorType
         && device.colorType() != kRGB_565_SkColorType;
 #endif
@@ -842,10 +853,12 @@ SkBlitter* SkBlitter::Choose(const SkPixmap& device,
         return blitter;
     }
 
-    // Everything but legacy kN32_SkColorType and kRGB_565_SkColorType should already be handled.
+    // Everything but legacy kN32_SkColorType, kRGB_565_SkColorType and kAlpha_8_SkColorType
+    // solid colors should already be handled.
     SkASSERT(!device.colorSpace());
     SkASSERT(device.colorType() == kN32_SkColorType ||
-             device.colorType() == kRGB_565_SkColorType);
+             device.colorType() == kRGB_565_SkColorType ||
+             (device.colorType() == kAlpha_8_SkColorType && !paint->getShader()));
 
     // And we should either have a shader, be blending with SrcOver, or both.
     SkASSERT(paint->getShader() || paint->getBlendMode() == SkBlendMode::kSrcOver);
@@ -853,9 +866,11 @@ SkBlitter* SkBlitter::Choose(const SkPixmap& device,
     // Legacy blitters keep their shader state on a shader context.
     SkShaderBase::Context* shaderContext = nullptr;
     if (paint->getShader()) {
-        shaderContext = as_SB(paint->getShader())->makeContext(
-                {*paint, matrix, nullptr, device.colorType(), device.colorSpace()},
-                alloc);
+        SkShaderBase::ContextRec rec(*paint, matrix, nullptr,
+                                     device.colorType(), device.colorSpace());
+        const SkIRect dstBounds = device.bounds();
+        rec.fDstBounds = &dstBounds;
+        shaderContext = as_SB(paint->getShader())->makeContext(rec, alloc);
 
         // Creating the context isn't always possible... we'll just fall back to raster pipeline.
         if (!shaderContext) {
@@ -880,10 +895,15 @@ SkBlitter* SkBlitter::Choose(const SkPixmap& device,
         case kRGB_565_SkColorType:
             if (shaderContext && SkRGB565_Shader_Blitter::Supports(device, *paint)) {
                 return alloc->make<SkRGB565_Shader_Blitter>(device, *paint, shaderContext);
+            } else if (!shaderContext && SkRGB565_Blitter::Supports(device, *paint)) {
+                return alloc->make<SkRGB565_Blitter>(device, *paint);
             } else {
                 return SkCreateRasterPipelineBlitter(device, *paint, matrix, alloc);
             }
 
+        case kAlpha_8_SkColorType:
+            return alloc->make<SkA8_Blitter>(device, *paint);
+
         default:
             SkASSERT(false);
             return alloc->make<SkNullBlitter>();
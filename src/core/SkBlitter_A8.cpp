@@ -7,6 +7,7 @@
 
 #include "SkCoreBlitters.h"
 #include "SkColorData.h"
+#include "SkNx.h"
 #include "SkShader.h"
 #include "SkXfermodePriv.h"
 
@@ -92,3 +93,152 @@ void SkA8_Coverage_Blitter::blitMask(const SkMask& mask, const SkIRect& clip) {
 const SkPixmap* SkA8_Coverage_Blitter::justAnOpaqueColor(uint32_t*) {
     return nullptr;
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Sk8h version of SkMulDiv255Round(); x * y must fit in 16 bits.
+static inline Sk8h mul_div255_round(const Sk8h& x, const Sk8h& y) {
+    Sk8h prod = x * y + Sk8h(128);
+    return (prod + (prod >> 8)) >> 8;
+}
+
+static inline unsigned srcover_a8(unsigned src, unsigned dst) {
+    return src + SkMulDiv255Round(dst, 255 - src);
+}
+
+static void A8_srcover_alpha(uint8_t dst[], int count, unsigned src) {
+    if (src == 0xFF) {
+        memset(dst, 0xFF, count);
+        return;
+    }
+    if (src == 0) {
+        return;
+    }
+
+    Sk8h sa(src),
+         isa(255 - src);
+    for (; count >= 8; count -= 8, dst += 8) {
+        Sk8h d = SkNx_cast<uint16_t>(Sk8b::Load(dst));
+        SkNx_cast<uint8_t>(sa + mul_div255_round(d, isa)).store(dst);
+    }
+    for (int i = 0; i < count; ++i) {
+        dst[i] = srcover_a8(src, dst[i]);
+    }
+}
+
+static void A8_srcover_alpha_A8(uint8_t dst[], const uint8_t mask[], int count, unsigned src) {
+    Sk8h sa(src);
+    for (; count >= 8; count -= 8, dst += 8, mask += 8) {
+        uint64_t coverage;
+        memcpy(&coverage, mask, 8);
+        if (coverage == 0) {
+            continue;
+        }
+        Sk8h s = mul_div255_round(sa, SkNx_cast<uint16_t>(Sk8b::Load(mask))),
+             d = SkNx_cast<uint16_t>(Sk8b::Load(dst));
+        SkNx_cast<uint8_t>(s + mul_div255_round(d, Sk8h(255) - s)).store(dst);
+    }
+    for (int i = 0; i < count; ++i) {
+        if (mask[i]) {
+            dst[i] = srcover_a8(SkMulDiv255Round(src, mask[i]), dst[i]);
+        }
+    }
+}
+
+SkA8_Blitter::SkA8_Blitter(const SkPixmap& device, const SkPaint& paint)
+    : INHERITED(device)
+    , fSrcA(paint.getAlpha()) {
+    SkASSERT(device.colorType() == kAlpha_8_SkColorType);
+    SkASSERT(nullptr == paint.getShader());
+    SkASSERT(paint.isSrcOver());
+}
+
+void SkA8_Blitter::blitH(int x, int y, int width) {
+    SkASSERT(x >= 0 && y >= 0 && x + width <= fDevice.width());
+    A8_srcover_alpha(fDevice.writable_addr8(x, y), width, fSrcA);
+}
+
+void SkA8_Blitter::blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) {
+    uint8_t* device = fDevice.writable_addr8(x, y);
+
+    for (;;) {
+        int count = runs[0];
+        SkASSERT(count >= 0);
+        if (count == 0) {
+            return;
+        }
+        if (antialias[0]) {
+            A8_srcover_alpha(device, count, SkMulDiv255Round(fSrcA, antialias[0]));
+        }
+        runs += count;
+        antialias += count;
+        device += count;
+    }
+}
+
+void SkA8_Blitter::blitV(int x, int y, int height, SkAlpha alpha) {
+    unsigned src = SkMulDiv255Round(fSrcA, alpha);
+    if (0 == src) {
+        return;
+    }
+
+    uint8_t* dst = fDevice.writable_addr8(x, y);
+    const size_t dstRB = fDevice.rowBytes();
+    while (--height >= 0) {
+        *dst = srcover_a8(src, *dst);
+        dst += dstRB;
+    }
+}
+
+void SkA8_Blitter::blitRect(int x, int y, int width, int height) {
+    uint8_t* dst = fDevice.writable_addr8(x, y);
+    const size_t dstRB = fDevice.rowBytes();
+    while (--height >= 0) {
+        A8_srcover_alpha(dst, width, fSrcA);
+        dst += dstRB;
+    }
+}
+
+void SkA8_Blitter::blitMask(const SkMask& mask, const SkIRect& clip) {
+    SkASSERT(mask.fBounds.contains(clip));
+
+    int x = clip.fLeft,
+        y = clip.fTop,
+        width = clip.width(),
+        height = clip.height();
+
+    uint8_t* dst = fDevice.writable_addr8(x, y);
+    const size_t dstRB = fDevice.rowBytes();
+
+    switch (mask.fFormat) {
+        case SkMask::kA8_Format: {
+            const uint8_t* src = mask.getAddr8(x, y);
+            while (--height >= 0) {
+                A8_srcover_alpha_A8(dst, src, width, fSrcA);
+                dst += dstRB;
+                src += mask.fRowBytes;
+            }
+        } break;
+
+        case SkMask::kLCD16_Format: {
+            // Like the raster pipeline, cover alpha with the largest of the three channels.
+            const uint16_t* src = mask.getAddrLCD16(x, y);
+            while (--height >= 0) {
+                for (int i = 0; i < width; ++i) {
+                    unsigned coverage = SkTMax(SkPacked16ToR32(src[i]),
+                                        SkTMax(SkPacked16ToG32(src[i]),
+                                               SkPacked16ToB32(src[i])));
+                    if (coverage) {
+                        dst[i] = srcover_a8(SkMulDiv255Round(fSrcA, coverage), dst[i]);
+                    }
+                }
+                dst += dstRB;
+                src = (const uint16_t*)((const char*)src + mask.fRowBytes);
+            }
+        } break;
+
+        default:
+            this->INHERITED::blitMask(mask, clip);
+            break;
+    }
+}
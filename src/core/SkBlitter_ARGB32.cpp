@@ -1414,82 +1414,72 @@ static void blend_row_A8_opaque(SkPMColor* dst, const void* vmask, const SkPMCol
 #endif
 }
 
-static void blend_row_lcd16(SkPMColor* dst, const void* vmask, const SkPMColor* src, int n) {
-    auto src_alpha_blend = [](int s, int d, int sa, int m) {
-        return d + SkAlphaMul(s - SkAlphaMul(sa, d), m);
-    };
-
-    auto upscale_31_to_255 = [](int v) {
-        return (v << 3) | (v >> 2);
+// Expands 4 LCD16 coverage values into 8-bit per-channel coverage laid out like SkPMColors,
+// with full coverage in the alpha channel.  Like the scalar LCD blits, we ignore the least
+// significant bit of green.
+static Sk4px lcd16_to_coverage(const uint16_t mask[4]) {
+    Sk4u m(mask[0], mask[1], mask[2], mask[3]);
+
+    auto channel = [&](int shift16, int bits16, int shift32) {
+        Sk4u v = (m >> (shift16 + bits16 - 5)) & 31;
+        return ((v << 3) | (v >> 2)) << shift32;
     };
+    Sk4u cov = channel(SK_R16_SHIFT, SK_R16_BITS, SK_R32_SHIFT)
+             | channel(SK_G16_SHIFT, SK_G16_BITS, SK_G32_SHIFT)
+             | channel(SK_B16_SHIFT, SK_B16_BITS, SK_B32_SHIFT)
+             | Sk4u(0xFF << SK_A32_SHIFT);
+
+    uint32_t px[4];
+    cov.store(px);
+    return Sk4px::Load4(px);
+}
 
-    auto mask = (const uint16_t*)vmask;
-    for (int i = 0; i < n; ++i) {
-        uint16_t m = mask[i];
-        if (0 == m) {
-            continue;
+// Maps fn(dst, src, coverage) over n pixels, 4 at a time, skipping runs of zero coverage.
+template <typename Fn>
+static void map_dst_src_lcd16(int n, SkPMColor* dst, const SkPMColor* src,
+                              const uint16_t* mask, const Fn& fn) {
+    while (n >= 4) {
+        uint64_t m;
+        memcpy(&m, mask, sizeof(m));
+        if (m) {
+            fn(Sk4px::Load4(dst), Sk4px::Load4(src), lcd16_to_coverage(mask)).store4(dst);
         }
+        dst  += 4;
+        src  += 4;
+        mask += 4;
+        n    -= 4;
+    }
+    if (n > 0) {
+        SkPMColor d[4], s[4];
+        uint16_t  m[4] = {0,0,0,0};
+        memcpy(d, dst, n*sizeof(SkPMColor));
+        memcpy(s, src, n*sizeof(SkPMColor));
+        memcpy(m, mask, n*sizeof(uint16_t));
+        fn(Sk4px::Load4(d), Sk4px::Load4(s), lcd16_to_coverage(m)).store4(d);
+        memcpy(dst, d, n*sizeof(SkPMColor));
+    }
+}
 
-        SkPMColor s = src[i];
-        SkPMColor d = dst[i];
-
-        int srcA = SkGetPackedA32(s);
-        int srcR = SkGetPackedR32(s);
-        int srcG = SkGetPackedG32(s);
-        int srcB = SkGetPackedB32(s);
-
-        srcA += srcA >> 7;
-
-        // We're ignoring the least significant bit of the green coverage channel here.
-        int maskR = SkGetPackedR16(m) >> (SK_R16_BITS - 5);
-        int maskG = SkGetPackedG16(m) >> (SK_G16_BITS - 5);
-        int maskB = SkGetPackedB16(m) >> (SK_B16_BITS - 5);
-
-        // Scale up to 8-bit coverage to work with SkAlphaMul() in src_alpha_blend().
-        maskR = upscale_31_to_255(maskR);
-        maskG = upscale_31_to_255(maskG);
-        maskB = upscale_31_to_255(maskB);
+static void blend_row_lcd16(SkPMColor* dst, const void* vmask, const SkPMColor* src, int n) {
+    auto mask = (const uint16_t*)vmask;
+    map_dst_src_lcd16(n, dst, src, mask, [](const Sk4px& d, const Sk4px& s, const Sk4px& cov) {
+        // Src-over, with each channel's coverage applied to the src and its alpha.
+        const auto s_aa = s.approxMulDiv255(cov),
+                   a_aa = s.alphas().approxMulDiv255(cov);
 
         // This LCD blit routine only works if the destination is opaque.
-        dst[i] = SkPackARGB32(0xFF,
-                              src_alpha_blend(srcR, SkGetPackedR32(d), srcA, maskR),
-                              src_alpha_blend(srcG, SkGetPackedG32(d), srcA, maskG),
-                              src_alpha_blend(srcB, SkGetPackedB32(d), srcA, maskB));
-    }
+        const auto alpha = Sk4px::DupPMColor(SK_A32_MASK << SK_A32_SHIFT);
+        return alpha.thenElse(alpha, s_aa + d.approxMulDiv255(a_aa.inv()));
+    });
 }
 
 static void blend_row_LCD16_opaque(SkPMColor* dst, const void* vmask, const SkPMColor* src, int n) {
     auto mask = (const uint16_t*)vmask;
-
-    for (int i = 0; i < n; ++i) {
-        uint16_t m = mask[i];
-        if (0 == m) {
-            continue;
-        }
-
-        SkPMColor s = src[i];
-        SkPMColor d = dst[i];
-
-        int srcR = SkGetPackedR32(s);
-        int srcG = SkGetPackedG32(s);
-        int srcB = SkGetPackedB32(s);
-
-        // We're ignoring the least significant bit of the green coverage channel here.
-        int maskR = SkGetPackedR16(m) >> (SK_R16_BITS - 5);
-        int maskG = SkGetPackedG16(m) >> (SK_G16_BITS - 5);
-        int maskB = SkGetPackedB16(m) >> (SK_B16_BITS - 5);
-
-        // Now upscale them to 0..32, so we can use blend_32.
-        maskR = upscale_31_to_32(maskR);
-        maskG = upscale_31_to_32(maskG);
-        maskB = upscale_31_to_32(maskB);
-
+    map_dst_src_lcd16(n, dst, src, mask, [](const Sk4px& d, const Sk4px& s, const Sk4px& cov) {
         // This LCD blit routine only works if the destination is opaque.
-        dst[i] = SkPackARGB32(0xFF,
-                              blend_32(srcR, SkGetPackedR32(d), maskR),
-                              blend_32(srcG, SkGetPackedG32(d), maskG),
-                              blend_32(srcB, SkGetPackedB32(d), maskB));
-    }
+        // Full coverage in alpha leaves the (opaque) src alpha.
+        return (s * cov + d * cov.inv()).div255();
+    });
 }
 
 void SkARGB32_Shader_Blitter::blitMask(const SkMask& mask, const SkIRect& clip) {
@@ -9,6 +9,7 @@
 #include "SkColorData.h"
 #include "SkShader.h"
 #include "SkUTF.h"
+#include "SkUtils.h"
 #include "SkXfermodePriv.h"
 #include "SkColorData.h"
 
@@ -137,3 +138,209 @@ void SkRGB565_Shader_Blitter::blitAntiH(int x, int y, const SkAlpha coverage[],
         x += count;
     }
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SrcOver of premul 8-bit src components onto eight 565 pixels, exactly as SkSrcOver32To16().
+// isa is 255 - src alpha.  Every intermediate fits in 16 bits.
+static Sk8h srcover_565(const Sk8h& d,
+                        const Sk8h& sr, const Sk8h& sg, const Sk8h& sb, const Sk8h& isa) {
+    auto mul_shift_round = [&isa](const Sk8h& x, int bits) {   // SkMul16ShiftRound(x, isa, bits)
+        Sk8h prod = x * isa + Sk8h(1 << (bits - 1));
+        return (prod + (prod >> bits)) >> bits;
+    };
+    Sk8h dr = (d >> SK_R16_SHIFT) & Sk8h(SK_R16_MASK),
+         dg = (d >> SK_G16_SHIFT) & Sk8h(SK_G16_MASK),
+         db = (d >> SK_B16_SHIFT) & Sk8h(SK_B16_MASK);
+
+    dr = (sr + mul_shift_round(dr, SK_R16_BITS)) >> (8 - SK_R16_BITS);
+    dg = (sg + mul_shift_round(dg, SK_G16_BITS)) >> (8 - SK_G16_BITS);
+    db = (sb + mul_shift_round(db, SK_B16_BITS)) >> (8 - SK_B16_BITS);
+
+    return (dr << SK_R16_SHIFT) | (dg << SK_G16_SHIFT) | (db << SK_B16_SHIFT);
+}
+
+static void D16_srcover_color(uint16_t dst[], int count, SkPMColor src) {
+    if (SkGetPackedA32(src) == 0xFF) {
+        sk_memset16(dst, SkPixel32ToPixel16(src), count);
+        return;
+    }
+    if (src == 0) {
+        return;
+    }
+
+    Sk8h sr(SkGetPackedR32(src)),
+         sg(SkGetPackedG32(src)),
+         sb(SkGetPackedB32(src)),
+         isa(255 - SkGetPackedA32(src));
+    for (; count >= 8; count -= 8, dst += 8) {
+        srcover_565(Sk8h::Load(dst), sr, sg, sb, isa).store(dst);
+    }
+    for (int i = 0; i < count; ++i) {
+        dst[i] = SkSrcOver32To16(src, dst[i]);
+    }
+}
+
+static void D16_srcover_color_A8(uint16_t dst[], const uint8_t mask[], int count,
+                                 SkPMColor src) {
+    Sk8h sa(SkGetPackedA32(src)),
+         sr(SkGetPackedR32(src)),
+         sg(SkGetPackedG32(src)),
+         sb(SkGetPackedB32(src));
+    for (; count >= 8; count -= 8, dst += 8, mask += 8) {
+        uint64_t coverage;
+        memcpy(&coverage, mask, 8);
+        if (coverage == 0) {
+            continue;
+        }
+        // Same per-component scaling as SkAlphaMulQ(src, coverage + (coverage >> 7)).
+        Sk8h m = SkNx_cast<uint16_t>(Sk8b::Load(mask)),
+             scale = m + (m >> 7);
+        srcover_565(Sk8h::Load(dst),
+                    (sr * scale) >> 8,
+                    (sg * scale) >> 8,
+                    (sb * scale) >> 8,
+                    Sk8h(255) - ((sa * scale) >> 8)).store(dst);
+    }
+    for (int i = 0; i < count; ++i) {
+        if (unsigned aa = mask[i]) {
+            dst[i] = SkSrcOver32To16(SkAlphaMulQ(src, aa + (aa >> 7)), dst[i]);
+        }
+    }
+}
+
+static inline int upscale_31_to_32(int value) {
+    SkASSERT((unsigned)value <= 31);
+    return value + (value >> 4);
+}
+
+static inline int blend_32(int src, int dst, int scale) {
+    SkASSERT((unsigned)src <= 0xFF);
+    SkASSERT((unsigned)dst <= 0xFF);
+    SkASSERT((unsigned)scale <= 32);
+    return dst + ((src - dst) * scale >> 5);
+}
+
+// The 565 twin of blend_lcd16() in SkBlitter_ARGB32.cpp; srcA has been upscaled to 256.
+static inline uint16_t blend_lcd16_565(int srcA, int srcR, int srcG, int srcB,
+                                       uint16_t dst, uint16_t mask) {
+    if (mask == 0) {
+        return dst;
+    }
+
+    int maskR = upscale_31_to_32(SkGetPackedR16(mask) >> (SK_R16_BITS - 5)) * srcA >> 8;
+    int maskG = upscale_31_to_32(SkGetPackedG16(mask) >> (SK_G16_BITS - 5)) * srcA >> 8;
+    int maskB = upscale_31_to_32(SkGetPackedB16(mask) >> (SK_B16_BITS - 5)) * srcA >> 8;
+
+    return SkPack888ToRGB16(blend_32(srcR, SkPacked16ToR32(dst), maskR),
+                            blend_32(srcG, SkPacked16ToG32(dst), maskG),
+                            blend_32(srcB, SkPacked16ToB32(dst), maskB));
+}
+
+bool SkRGB565_Blitter::Supports(const SkPixmap& device, const SkPaint& paint) {
+    return device.colorType() == kRGB_565_SkColorType
+        && !device.colorSpace()
+        && !paint.getShader()
+        && paint.getBlendMode() == SkBlendMode::kSrcOver
+        && !paint.isDither();
+}
+
+SkRGB565_Blitter::SkRGB565_Blitter(const SkPixmap& device, const SkPaint& paint)
+    : INHERITED(device)
+    , fColor(paint.getColor())
+    , fPMColor(SkPreMultiplyColor(paint.getColor()))
+{
+    SkASSERT(Supports(device, paint));
+}
+
+void SkRGB565_Blitter::blitH(int x, int y, int width) {
+    SkASSERT(x >= 0 && y >= 0 && x + width <= fDevice.width());
+    D16_srcover_color(fDevice.writable_addr16(x, y), width, fPMColor);
+}
+
+void SkRGB565_Blitter::blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) {
+    uint16_t* device = fDevice.writable_addr16(x, y);
+
+    for (;;) {
+        int count = *runs;
+        if (count <= 0) {
+            break;
+        }
+        unsigned aa = *antialias;
+        if (aa == 0xFF) {
+            D16_srcover_color(device, count, fPMColor);
+        } else if (aa) {
+            D16_srcover_color(device, count, SkAlphaMulQ(fPMColor, aa + (aa >> 7)));
+        }
+        device += count;
+        runs += count;
+        antialias += count;
+    }
+}
+
+void SkRGB565_Blitter::blitV(int x, int y, int height, SkAlpha alpha) {
+    if (alpha == 0) {
+        return;
+    }
+    SkPMColor src = alpha == 0xFF ? fPMColor : SkAlphaMulQ(fPMColor, alpha + (alpha >> 7));
+
+    uint16_t* device = fDevice.writable_addr16(x, y);
+    const size_t deviceRB = fDevice.rowBytes();
+    while (--height >= 0) {
+        *device = SkSrcOver32To16(src, *device);
+        device = (uint16_t*)((char*)device + deviceRB);
+    }
+}
+
+void SkRGB565_Blitter::blitRect(int x, int y, int width, int height) {
+    SkASSERT(x >= 0 && y >= 0 && x + width <= fDevice.width() && y + height <= fDevice.height());
+
+    uint16_t* device = fDevice.writable_addr16(x, y);
+    const size_t deviceRB = fDevice.rowBytes();
+    while (--height >= 0) {
+        D16_srcover_color(device, width, fPMColor);
+        device = (uint16_t*)((char*)device + deviceRB);
+    }
+}
+
+void SkRGB565_Blitter::blitMask(const SkMask& mask, const SkIRect& clip) {
+    SkASSERT(mask.fBounds.contains(clip));
+
+    int x = clip.fLeft,
+        y = clip.fTop,
+        width = clip.width(),
+        height = clip.height();
+
+    uint16_t* device = fDevice.writable_addr16(x, y);
+    const size_t deviceRB = fDevice.rowBytes();
+
+    switch (mask.fFormat) {
+        case SkMask::kA8_Format: {
+            const uint8_t* src = mask.getAddr8(x, y);
+            while (--height >= 0) {
+                D16_srcover_color_A8(device, src, width, fPMColor);
+                device = (uint16_t*)((char*)device + deviceRB);
+                src += mask.fRowBytes;
+            }
+        } break;
+
+        case SkMask::kLCD16_Format: {
+            int srcA = SkAlpha255To256(SkColorGetA(fColor)),
+                srcR = SkColorGetR(fColor),
+                srcG = SkColorGetG(fColor),
+                srcB = SkColorGetB(fColor);
+            const uint16_t* src = mask.getAddrLCD16(x, y);
+            while (--height >= 0) {
+                for (int i = 0; i < width; ++i) {
+                    device[i] = blend_lcd16_565(srcA, srcR, srcG, srcB, device[i], src[i]);
+                }
+                device = (uint16_t*)((char*)device + deviceRB);
+                src = (const uint16_t*)((const char*)src + mask.fRowBytes);
+            }
+        } break;
+
+        default:
+            this->INHERITED::blitMask(mask, clip);
+            break;
+    }
+}
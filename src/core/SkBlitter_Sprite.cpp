@@ -137,7 +137,9 @@ public:
         }
 
         bool is_opaque = fSource.isOpaque() && fPaintColor.fA == 1.0f;
-        fBlitter = SkCreateRasterPipelineBlitter(fDst, paint, p, is_opaque, fAlloc);
+        // Our pipeline reads (x,y) only to load from fSource.
+        fBlitter = SkCreateRasterPipelineBlitter(fDst, paint, p, is_opaque, fAlloc,
+                                                 fSource.rowBytesAsPixels());
     }
 
     void blitRect(int x, int y, int width, int height) override {
@@ -9,6 +9,7 @@
 
 #include "SkColorPriv.h"
 #include "SkEndian.h"
+#include "SkMaskCache.h"
 #include "SkMaskBlurFilter.h"
 #include "SkMath.h"
 #include "SkMathPriv.h"
@@ -348,9 +349,24 @@ void SkBlurMask::ComputeBlurProfile(uint8_t* profile, int size, SkScalar sigma)
     }
 }
 
-// TODO MAYBE: Maintain a profile cache to avoid recomputing this for
-// commonly used radii.  Consider baking some of the most common blur radii
-// directly in as static data?
+SkCachedData* SkBlurMask::RefBlurProfile(SkScalar sigma) {
+    int size = SkScalarCeilToInt(6*sigma);
+    if (size <= 0) {
+        return nullptr;
+    }
+
+    if (SkCachedData* profile = SkMaskCache::FindAndRefBlurProfile(sigma)) {
+        return profile;
+    }
+
+    SkCachedData* profile = SkResourceCache::NewCachedData(size);
+    if (!profile) {
+        return nullptr;
+    }
+    ComputeBlurProfile((uint8_t*)profile->writable_data(), size, sigma);
+    SkMaskCache::AddBlurProfile(sigma, profile);
+    return profile;
+}
 
 // Implementation adapted from Michael Herf's approach:
 // http://stereopsis.com/shadowrect/
@@ -427,15 +443,17 @@ bool SkBlurMask::BlurRect(SkScalar sigma, SkMask *dst,
         return true;
     }
 
-    SkAutoTMalloc<uint8_t> profile(profileSize);
-
-    ComputeBlurProfile(profile, profileSize, sigma);
-
     size_t dstSize = dst->computeImageSize();
     if (0 == dstSize) {
         return false;   // too big to allocate, abort
     }
 
+    SkCachedData* profileData = RefBlurProfile(sigma);
+    if (!profileData) {
+        return false;
+    }
+    const uint8_t* profile = (const uint8_t*)profileData->data();
+
     uint8_t*        dp = SkMask::AllocImage(dstSize);
 
     dst->fImage = dp;
@@ -450,6 +468,7 @@ bool SkBlurMask::BlurRect(SkScalar sigma, SkMask *dst,
 
     ComputeBlurredScanline(horizontalScanline, profile, dstWidth, sigma);
     ComputeBlurredScanline(verticalScanline, profile, dstHeight, sigma);
+    profileData->unref();
 
     for (int y = 0 ; y < dstHeight ; ++y) {
         for (int x = 0 ; x < dstWidth ; x++) {
@@ -9,6 +9,7 @@
 #define SkBlurMask_DEFINED
 
 #include "SkBlurTypes.h"
+#include "SkCachedData.h"
 #include "SkShader.h"
 #include "SkMask.h"
 #include "SkRRect.h"
@@ -68,6 +69,13 @@ public:
     */
     static void ComputeBlurProfile(uint8_t* profile, int size, SkScalar sigma);
 
+    /** Return a ref to the ceil(6*sigma) byte profile for sigma, computing it with
+        ComputeBlurProfile and adding it to SkMaskCache if it is not cached yet.
+        Returns nullptr if sigma is too small to blur or the data could not be allocated.
+        The caller must unref() the result.
+    */
+    static SkCachedData* RefBlurProfile(SkScalar sigma);
+
     /** Compute an entire scanline of a blurred step function.  This is a 1D helper that
         will produce both the horizontal and vertical profiles of the blurry rectangle.
         @param pixels Location to store the resulting pixel data; allocated and managed by caller
@@ -824,8 +824,31 @@ void SkClipStack::pushElement(const Element& element) {
     newElement->updateBoundAndGenID(prior);
 }
 
+bool SkClipStack::quickIntersectIsNoop(const SkRect& rect, const SkMatrix& matrix,
+                                       bool doAA) const {
+    const Element* top = (const Element*) fDeque.back();
+    if (!top || !top->fIsIntersectionOfRects || !matrix.rectStaysRect()) {
+        return false;
+    }
+    // The clip is exactly top's bound, so it is unchanged if the new rect covers every pixel that
+    // the bound touches.
+    SkRect devRect;
+    matrix.mapRect(&devRect, rect);
+    SkIRect touched = top->getBounds().roundOut();
+    if (!doAA) {
+        SkIRect ir;
+        devRect.round(&ir);
+        return ir.contains(touched);
+    }
+    return devRect.contains(SkRect::Make(touched));
+}
+
 void SkClipStack::clipRRect(const SkRRect& rrect, const SkMatrix& matrix, SkClipOp op,
                             bool doAA) {
+    if (kIntersect_SkClipOp == op && rrect.isRect() &&
+        this->quickIntersectIsNoop(rrect.rect(), matrix, doAA)) {
+        return;
+    }
     Element element(fSaveCount, rrect, matrix, op, doAA);
     this->pushElement(element);
     if (this->hasClipRestriction(op)) {
@@ -837,6 +860,9 @@ void SkClipStack::clipRRect(const SkRRect& rrect, const SkMatrix& matrix, SkClip
 
 void SkClipStack::clipRect(const SkRect& rect, const SkMatrix& matrix, SkClipOp op,
                            bool doAA) {
+    if (kIntersect_SkClipOp == op && this->quickIntersectIsNoop(rect, matrix, doAA)) {
+        return;
+    }
     Element element(fSaveCount, rect, matrix, op, doAA);
     this->pushElement(element);
     if (this->hasClipRestriction(op)) {
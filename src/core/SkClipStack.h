@@ -498,6 +498,12 @@ private:
     bool internalQuickContains(const SkRect& devRect) const;
     bool internalQuickContains(const SkRRect& devRRect) const;
 
+    /**
+     * Returns true if intersecting with rect, mapped by matrix, cannot change the clip, because
+     * the clip is a rect that the new one covers. Such clips are not recorded at all.
+     */
+    bool quickIntersectIsNoop(const SkRect& rect, const SkMatrix& matrix, bool doAA) const;
+
     /**
      * Helper for clipDevPath, etc.
      */
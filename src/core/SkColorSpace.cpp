@@ -8,6 +8,7 @@
 #include "SkColorSpace.h"
 #include "SkColorSpacePriv.h"
 #include "SkData.h"
+#include "SkMutex.h"
 #include "SkOpts.h"
 #include "../../third_party/skcms/skcms.h"
 
@@ -58,7 +59,33 @@ sk_sp<SkColorSpace> SkColorSpace::MakeRGB(const skcms_TransferFunction& transfer
         tf = &SkNamedTransferFn::kLinear.g;
     }
 
-    return sk_sp<SkColorSpace>(new SkColorSpace(tf, toXYZ));
+    return SkColorSpace::Intern(sk_sp<SkColorSpace>(new SkColorSpace(tf, toXYZ)));
+}
+
+// Decoders make a new SkColorSpace for every image, but images from one camera or app tend to
+// carry the same profile.  We keep the most recently made color spaces around and hand those
+// back out for identical profiles, so those images share one instance (and its lazily computed
+// inverse fields), and Equals() on them returns at its pointer compare.
+static constexpr int kInternedColorSpaceCount = 16;
+SK_DECLARE_STATIC_MUTEX(gInternedColorSpacesMutex);
+static SkColorSpace* gInternedColorSpaces[kInternedColorSpaceCount];  // Each holds a ref.
+static int gNextInternedColorSpace;
+
+sk_sp<SkColorSpace> SkColorSpace::Intern(sk_sp<SkColorSpace> cs) {
+    SkAutoMutexAcquire lock(gInternedColorSpacesMutex);
+    for (SkColorSpace* interned : gInternedColorSpaces) {
+        if (interned && interned->hash() == cs->hash() &&
+            0 == memcmp(interned->fTransferFn, cs->fTransferFn, sizeof(fTransferFn)) &&
+            0 == memcmp(interned->fToXYZD50_3x3, cs->fToXYZD50_3x3, sizeof(fToXYZD50_3x3))) {
+            return sk_ref_sp(interned);
+        }
+    }
+
+    SkColorSpace*& slot = gInternedColorSpaces[gNextInternedColorSpace];
+    gNextInternedColorSpace = (gNextInternedColorSpace + 1) % kInternedColorSpaceCount;
+    SkSafeUnref(slot);
+    slot = SkRef(cs.get());
+    return cs;
 }
 
 class SkColorSpaceSingletonFactory {
@@ -6,6 +6,7 @@
  */
 
 #include "SkColorSpaceXformSteps.h"
+#include "SkArenaAlloc.h"
 #include "SkColorSpacePriv.h"
 #include "SkRasterPipeline.h"
 #include "../../third_party/skcms/skcms.h"
@@ -174,3 +175,51 @@ void SkColorSpaceXformSteps::apply(SkRasterPipeline* p, bool src_is_normalized)
     }
     if (flags.premul) { p->append(SkRasterPipeline::premul); }
 }
+
+static constexpr int kLinearizeEntries = 256,
+                     kEncodeEntries    = 1024;
+static_assert(sizeof(SkRasterPipeline_XformLUTCtx::linearize) == sizeof(float)*kLinearizeEntries,
+              "");
+static_assert(sizeof(SkRasterPipeline_XformLUTCtx::encode) == sizeof(float)*kEncodeEntries, "");
+
+// A lerped table of tf is only accurate if tf's slope is finite at 0: tf must either be linear
+// over the table's first interval or have an exponent of at least 1.
+static bool lerps_well(const skcms_TransferFunction& tf, int entries) {
+    return tf.d * (entries - 1) >= 1 || tf.g >= 1;
+}
+
+void SkColorSpaceXformSteps::apply(SkRasterPipeline* p, SkColorType srcCT,
+                                   SkArenaAlloc* alloc) const {
+    bool is8Bit = srcCT == kRGBA_8888_SkColorType ||
+                  srcCT == kRGB_888x_SkColorType  ||
+                  srcCT == kBGRA_8888_SkColorType ||
+                  srcCT == kGray_8_SkColorType;
+
+    // from_srgb and to_srgb are already cheap, so the tables only replace parametric and gamma.
+    if (!is8Bit || !flags.linearize || !flags.encode || (srcTF_is_sRGB && dstTF_is_sRGB) ||
+        !lerps_well(srcTF, kLinearizeEntries) || !lerps_well(dstTFInv, kEncodeEntries)) {
+        this->apply(p, srcCT);
+        return;
+    }
+
+    auto ctx = alloc->make<SkRasterPipeline_XformLUTCtx>();
+    skcms_TransferFunction tf;
+    memcpy(&tf, &srcTF, 7*sizeof(float));
+    for (int i = 0; i < kLinearizeEntries; i++) {
+        ctx->linearize[i] = skcms_TransferFunction_eval(&tf, i * (1.0f / (kLinearizeEntries - 1)));
+    }
+    memcpy(&tf, &dstTFInv, 7*sizeof(float));
+    for (int i = 0; i < kEncodeEntries; i++) {
+        ctx->encode[i] = skcms_TransferFunction_eval(&tf, i * (1.0f / (kEncodeEntries - 1)));
+    }
+    if (flags.gamut_transform) {
+        memcpy(ctx->matrix, src_to_dst_matrix, sizeof(ctx->matrix));
+    } else {
+        const float identity[9] = { 1,0,0, 0,1,0, 0,0,1 };
+        memcpy(ctx->matrix, identity, sizeof(ctx->matrix));
+    }
+
+    if (flags.unpremul) { p->append(SkRasterPipeline::unpremul); }
+    p->append(SkRasterPipeline::xform_lut, ctx);
+    if (flags.premul)   { p->append(SkRasterPipeline::premul); }
+}
@@ -11,6 +11,7 @@
 #include "SkColorSpace.h"
 #include "SkImageInfo.h"
 
+class SkArenaAlloc;
 class SkRasterPipeline;
 
 struct SkColorSpaceXformSteps {
@@ -40,6 +41,12 @@ struct SkColorSpaceXformSteps {
         this->apply(p, srcCT < kRGBA_F16_SkColorType);
     }
 
+    // Like apply(p, srcCT), but 8-bit sources may instead get one xform_lut stage, with lookup
+    // tables built in alloc.  Building them costs about as much as converting a few hundred
+    // pixels, so this is for callers converting many pixels at once.  Results past 1 are only
+    // approximate, so the destination should be normalized.
+    void apply(SkRasterPipeline*, SkColorType srcCT, SkArenaAlloc*) const;
+
     Flags flags;
 
     bool srcTF_is_sRGB,
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "SkArenaAlloc.h"
 #include "SkColorData.h"
 #include "SkColorSpacePriv.h"
 #include "SkColorSpaceXformSteps.h"
@@ -13,6 +14,7 @@
 #include "SkImageInfoPriv.h"
 #include "SkOpts.h"
 #include "SkRasterPipeline.h"
+#include "SkTaskGroup.h"
 
 static bool rect_memcpy(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
                         const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
@@ -167,9 +169,16 @@ static void convert_with_pipeline(const SkImageInfo& dstInfo, void* dstRow, size
     SkRasterPipeline_MemoryCtx src = { (void*)srcRow, (int)(srcRB / srcInfo.bytesPerPixel()) },
                                dst = { (void*)dstRow, (int)(dstRB / dstInfo.bytesPerPixel()) };
 
-    SkRasterPipeline_<256> pipeline;
+    SkSTArenaAlloc<256> alloc;
+    SkRasterPipeline pipeline(&alloc);
     pipeline.append_load(srcInfo.colorType(), &src);
-    steps.apply(&pipeline, srcInfo.colorType());
+    // Lookup tables only pay for themselves over enough pixels.
+    if (dstInfo.colorType() < kRGBA_F16_SkColorType &&
+        (int64_t)srcInfo.width() * srcInfo.height() >= 1024) {
+        steps.apply(&pipeline, srcInfo.colorType(), &alloc);
+    } else {
+        steps.apply(&pipeline, srcInfo.colorType());
+    }
 
     pipeline.append_gamut_clamp_if_normalized(dstInfo);
 
@@ -205,3 +214,29 @@ void SkConvertPixels(const SkImageInfo& dstInfo,       void* dstPixels, size_t d
     }
     convert_with_pipeline(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, steps);
 }
+
+std::atomic<SkExecutor*> gSkConvertPixelsExecutor{nullptr};
+
+// Conversions of at least this many pixels are split into bands of rows on the executor.
+static constexpr int kMinParallelArea = 512 * 512;
+static constexpr int kRowsPerTask = 64;
+
+void SkConvertPixels(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
+                     const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
+                     SkExecutor* executor) {
+    const int height = srcInfo.height();
+    if (!executor || (int64_t)srcInfo.width() * height < kMinParallelArea) {
+        SkConvertPixels(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB);
+        return;
+    }
+
+    const int bands = (height + kRowsPerTask - 1) / kRowsPerTask;
+    SkTaskGroup(*executor).batch(bands, [&](int band) {
+        int top = band * kRowsPerTask,
+            rows = SkTMin(kRowsPerTask, height - top);
+        SkConvertPixels(dstInfo.makeWH(dstInfo.width(), rows),
+                        SkTAddOffset<void>(dstPixels, top * dstRB), dstRB,
+                        srcInfo.makeWH(srcInfo.width(), rows),
+                        SkTAddOffset<const void>(srcPixels, top * srcRB), srcRB);
+    });
+}
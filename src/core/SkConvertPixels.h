@@ -11,11 +11,23 @@
 #include "SkImageInfo.h"
 #include "SkTemplates.h"
 
+#include <atomic>
+
 class SkColorTable;
+class SkExecutor;
 
 void SkConvertPixels(const SkImageInfo& dstInfo, void* dstPixels, size_t dstRowBytes,
                      const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRowBytes);
 
+// Like SkConvertPixels(), but large conversions are split into bands of rows that are converted
+// in parallel on executor, if it's non-null.
+void SkConvertPixels(const SkImageInfo& dstInfo, void* dstPixels, size_t dstRowBytes,
+                     const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRowBytes,
+                     SkExecutor* executor);
+
+// If set, SkPixmap::readPixels() and SkBitmap::writePixels() convert pixels on this executor.
+extern std::atomic<SkExecutor*> gSkConvertPixelsExecutor;
+
 static inline void SkRectMemcpy(void* dst, size_t dstRB, const void* src, size_t srcRB,
                                 size_t trimRowBytes, int rowCount) {
     SkASSERT(trimRowBytes <= dstRB);
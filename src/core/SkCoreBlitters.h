@@ -66,6 +66,22 @@ private:
     typedef SkRasterBlitter INHERITED;
 };
 
+// SrcOver with a solid color into an A8 device.
+class SkA8_Blitter : public SkRasterBlitter {
+public:
+    SkA8_Blitter(const SkPixmap& device, const SkPaint& paint);
+    void blitH(int x, int y, int width) override;
+    void blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) override;
+    void blitV(int x, int y, int height, SkAlpha alpha) override;
+    void blitRect(int x, int y, int width, int height) override;
+    void blitMask(const SkMask&, const SkIRect&) override;
+
+private:
+    unsigned fSrcA;
+
+    typedef SkRasterBlitter INHERITED;
+};
+
 ////////////////////////////////////////////////////////////////
 
 class SkARGB32_Blitter : public SkRasterBlitter {
@@ -162,16 +178,38 @@ private:
     typedef SkShaderBlitter INHERITED;
 };
 
+// SrcOver with a solid color into a 565 device, without dithering.
+class SkRGB565_Blitter : public SkRasterBlitter {
+public:
+    SkRGB565_Blitter(const SkPixmap& device, const SkPaint&);
+    void blitH(int x, int y, int width) override;
+    void blitAntiH(int x, int y, const SkAlpha[], const int16_t[]) override;
+    void blitV(int x, int y, int height, SkAlpha alpha) override;
+    void blitRect(int x, int y, int width, int height) override;
+    void blitMask(const SkMask&, const SkIRect&) override;
+
+    static bool Supports(const SkPixmap& device, const SkPaint&);
+
+private:
+    SkColor     fColor;
+    SkPMColor   fPMColor;
+
+    typedef SkRasterBlitter INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 // Neither of these ever returns nullptr, but this first factory may return a SkNullBlitter.
 SkBlitter* SkCreateRasterPipelineBlitter(const SkPixmap&, const SkPaint&, const SkMatrix& ctm,
                                          SkArenaAlloc*);
 // Use this if you've pre-baked a shader pipeline, including modulating with paint alpha.
-// This factory never returns an SkNullBlitter.
+// If the shader pipeline reads (x,y) only to address memory with a row stride of shader_stride
+// pixels, pass that stride; it lets blitRect() run rects that are contiguous in both the shader's
+// memory and the dst as a single long row.  This factory never returns an SkNullBlitter.
 SkBlitter* SkCreateRasterPipelineBlitter(const SkPixmap&, const SkPaint&,
                                          const SkRasterPipeline& shaderPipeline,
                                          bool shader_is_opaque,
-                                         SkArenaAlloc*);
+                                         SkArenaAlloc*,
+                                         int shader_stride = -1);
 
 #endif
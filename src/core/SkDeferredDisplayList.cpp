@@ -10,6 +10,10 @@
 #include "SkCanvas.h"
 #include "SkSurface.h"
 
+#if SK_SUPPORT_GPU
+#include "SkPromiseImageBatch.h"
+#endif
+
 SkDeferredDisplayList::SkDeferredDisplayList(const SkSurfaceCharacterization& characterization,
                                              sk_sp<LazyProxyData> lazyProxyData)
         : fCharacterization(characterization)
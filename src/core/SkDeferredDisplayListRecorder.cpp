@@ -20,7 +20,9 @@ bool SkDeferredDisplayListRecorder::init() { return false; }
 
 SkCanvas* SkDeferredDisplayListRecorder::getCanvas() { return nullptr; }
 
-std::unique_ptr<SkDeferredDisplayList> SkDeferredDisplayListRecorder::detach() { return nullptr; }
+std::unique_ptr<SkDeferredDisplayList> SkDeferredDisplayListRecorder::detach(Retain) {
+    return nullptr;
+}
 
 sk_sp<SkImage> SkDeferredDisplayListRecorder::makePromiseTexture(
         const GrBackendFormat& backendFormat,
@@ -56,6 +58,9 @@ sk_sp<SkImage> SkDeferredDisplayListRecorder::makeYUVAPromiseTexture(
     return nullptr;
 }
 
+void SkDeferredDisplayListRecorder::setPromiseImageBatchFulfillProc(
+        PromiseImageTextureBatchFulfillProc, PromiseImageTextureBatchContext) {}
+
 #else
 
 #include "GrContextPriv.h"
@@ -66,6 +71,7 @@ sk_sp<SkImage> SkDeferredDisplayListRecorder::makeYUVAPromiseTexture(
 #include "SkImage_Gpu.h"
 #include "SkImage_GpuYUVA.h"
 #include "SkMakeUnique.h"
+#include "SkPromiseImageBatch.h"
 #include "SkPromiseImageTexture.h"
 #include "SkSurface_Gpu.h"
 #include "SkYUVASizeInfo.h"
@@ -188,7 +194,7 @@ SkCanvas* SkDeferredDisplayListRecorder::getCanvas() {
     return fSurface->getCanvas();
 }
 
-std::unique_ptr<SkDeferredDisplayList> SkDeferredDisplayListRecorder::detach() {
+std::unique_ptr<SkDeferredDisplayList> SkDeferredDisplayListRecorder::detach(Retain retain) {
     if (!fContext) {
         return nullptr;
     }
@@ -201,6 +207,8 @@ std::unique_ptr<SkDeferredDisplayList> SkDeferredDisplayListRecorder::detach() {
 
     auto ddl = std::unique_ptr<SkDeferredDisplayList>(
                            new SkDeferredDisplayList(fCharacterization, std::move(fLazyProxyData)));
+    ddl->fRetained = Retain::kYes == retain;
+    ddl->fPromiseImageBatch = std::move(fPromiseImageBatch);
 
     fContext->contextPriv().moveOpListsToDDL(ddl.get());
 
@@ -210,6 +218,26 @@ std::unique_ptr<SkDeferredDisplayList> SkDeferredDisplayListRecorder::detach() {
     return ddl;
 }
 
+void SkDeferredDisplayListRecorder::setPromiseImageBatchFulfillProc(
+        PromiseImageTextureBatchFulfillProc batchFulfillProc,
+        PromiseImageTextureBatchContext batchContext) {
+    fPromiseImageBatchFulfillProc = batchFulfillProc;
+    fPromiseImageBatchContext = batchContext;
+    // Images made from here on join a new batch.
+    fPromiseImageBatch = nullptr;
+}
+
+SkPromiseImageBatch* SkDeferredDisplayListRecorder::promiseImageBatch() {
+    if (!fPromiseImageBatchFulfillProc) {
+        return nullptr;
+    }
+    if (!fPromiseImageBatch) {
+        fPromiseImageBatch = sk_make_sp<SkPromiseImageBatch>(fPromiseImageBatchFulfillProc,
+                                                             fPromiseImageBatchContext);
+    }
+    return fPromiseImageBatch.get();
+}
+
 sk_sp<SkImage> SkDeferredDisplayListRecorder::makePromiseTexture(
         const GrBackendFormat& backendFormat,
         int width,
@@ -241,7 +269,8 @@ sk_sp<SkImage> SkDeferredDisplayListRecorder::makePromiseTexture(
                                            textureReleaseProc,
                                            textureDoneProc,
                                            textureContext,
-                                           delayReleaseCallback);
+                                           delayReleaseCallback,
+                                           this->promiseImageBatch());
 }
 
 sk_sp<SkImage> SkDeferredDisplayListRecorder::makeYUVAPromiseTexture(
@@ -275,7 +304,8 @@ sk_sp<SkImage> SkDeferredDisplayListRecorder::makeYUVAPromiseTexture(
                                                    textureReleaseProc,
                                                    textureDoneProc,
                                                    textureContexts,
-                                                   delayReleaseCallback);
+                                                   delayReleaseCallback,
+                                                   this->promiseImageBatch());
 }
 
 #endif
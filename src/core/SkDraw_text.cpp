@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "SkArenaAllocPool.h"
 #include "SkDraw.h"
 #include "SkFontPriv.h"
 #include "SkPaintPriv.h"
@@ -38,8 +39,7 @@ bool SkDraw::ShouldDrawTextAsPaths(const SkFont& font, const SkPaint& paint,
 
 void SkDraw::paintMasks(SkSpan<const SkMask> masks, const SkPaint& paint) const {
 
-    // The size used for a typical blitter.
-    SkSTArenaAlloc<3308> alloc;
+    SkPooledArenaAlloc alloc;
     SkBlitter* blitter = SkBlitter::Choose(fDst, *fMatrix, paint, &alloc, false);
     if (fCoverage) {
         blitter = alloc.make<SkPairBlitter>(
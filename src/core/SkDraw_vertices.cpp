@@ -150,6 +150,28 @@ static SkPMColor4f* convert_colors(const SkColor src[], int count, SkColorSpace*
     return dst;
 }
 
+// Returns a blitter whose shader stages read their matrix through *updater, or null if the
+// paint's shader can't do that.
+static SkBlitter* make_updatable_texture_blitter(const SkPixmap& dst, const SkPaint& paint,
+                                                 const SkMatrix& ctm, SkArenaAlloc* alloc,
+                                                 SkStageUpdater** updater) {
+    SkRasterPipeline_<256> shaderPipeline;
+    SkShaderBase::StageRec rec = {
+        &shaderPipeline, alloc, dst.colorType(), dst.colorSpace(), paint, nullptr, ctm, nullptr
+    };
+    *updater = as_SB(paint.getShader())->appendUpdatableStages(rec);
+    if (!*updater) {
+        return nullptr;
+    }
+
+    float alpha = paint.getColor4f().fA;
+    if (alpha != 1.0f) {
+        shaderPipeline.append(SkRasterPipeline::scale_1_float, alloc->make<float>(alpha));
+    }
+    bool is_opaque = paint.getShader()->isOpaque() && alpha == 1.0f;
+    return SkCreateRasterPipelineBlitter(dst, paint, shaderPipeline, is_opaque, alloc);
+}
+
 static bool compute_is_opaque(const SkColor colors[], int count) {
     uint32_t c = ~0;
     for (int i = 0; i < count; ++i) {
@@ -288,6 +310,15 @@ void SkDraw::drawVertices(SkVertices::VertexMode vmode, int vertexCount,
         SkPaint p(paint);
         p.setShader(sk_ref_sp(shader));
 
+        // Textured triangles without colors differ only in how they map the shader.  If its
+        // stages can be updated with each triangle's matrix, they can all share one blitter.
+        SkStageUpdater* updater = nullptr;
+        SkBlitter* texturedBlitter = nullptr;
+        if (textures && !matrix43) {
+            texturedBlitter = make_updatable_texture_blitter(fDst, p, *fMatrix, &outerAlloc,
+                                                             &updater);
+        }
+
         if (!textures) {    // only tricolor shader
             SkASSERT(matrix43);
             auto blitter = SkCreateRasterPipelineBlitter(fDst, p, *fMatrix, &outerAlloc);
@@ -303,6 +334,19 @@ void SkDraw::drawVertices(SkVertices::VertexMode vmode, int vertexCount,
                 };
                 SkScan::FillTriangle(tmp, *fRC, blitter);
             }
+        } else if (texturedBlitter) {
+            while (vertProc(&state)) {
+                SkMatrix localM;
+                if (!texture_to_matrix(state, vertices, textures, &localM) ||
+                    !updater->update(SkMatrix::Concat(*fMatrix, localM), nullptr)) {
+                    continue;
+                }
+
+                SkPoint tmp[] = {
+                    devVerts[state.f0], devVerts[state.f1], devVerts[state.f2]
+                };
+                SkScan::FillTriangle(tmp, *fRC, texturedBlitter);
+            }
         } else {
             while (vertProc(&state)) {
                 SkSTArenaAlloc<2048> innerAlloc;
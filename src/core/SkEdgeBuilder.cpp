@@ -11,6 +11,7 @@
 #include "SkEdgeClipper.h"
 #include "SkGeometry.h"
 #include "SkLineClipper.h"
+#include "SkNx.h"
 #include "SkPath.h"
 #include "SkPathPriv.h"
 #include "SkSafeMath.h"
@@ -226,6 +227,81 @@ SkEdgeBuilder::Combine SkBezierEdgeBuilder::addPolyLine(SkPoint pts[],
     return SkEdgeBuilder::kPartial_Combine;  // As above.
 }
 
+char** SkBasicEdgeBuilder::addPolygon(const SkPath& path, char* arg_edge, char** arg_edgePtr) {
+#ifdef SK_RASTERIZE_EVEN_ROUNDING
+    return nullptr;
+#else
+    // Convert all the points to FDot6 up front, four coordinates at a time, exactly as
+    // SkEdge::setLine() would one line at a time.
+    const int coordCount = 2 * path.countPoints();
+    const SkScalar* coords = &SkPathPriv::PointData(path)->fX;
+    SkFDot6* fdot6 = fAlloc.makeArrayDefault<SkFDot6>(coordCount);
+
+    const float scale = float(1 << (fClipShift + 6));
+    int i = 0;
+    for (; i + 4 <= coordCount; i += 4) {
+        SkNx_cast<int>(Sk4f::Load(coords + i) * scale).store(fdot6 + i);
+    }
+    for (; i < coordCount; i++) {
+        fdot6[i] = int(coords[i] * scale);
+    }
+
+    auto edge    = (SkEdge*) arg_edge;
+    auto edgePtr = (SkEdge**)arg_edgePtr;
+
+    auto add_line = [&](int p0, int p1) {
+        if (edge->setLine(fdot6[2*p0], fdot6[2*p0 + 1], fdot6[2*p1], fdot6[2*p1 + 1])) {
+            Combine combine = is_vertical(edge) && edgePtr > (SkEdge**)fEdgeList
+                ? this->combineVertical(edge, edgePtr[-1])
+                : kNo_Combine;
+
+            switch (combine) {
+                case kTotal_Combine:   edgePtr--;            break;
+                case kPartial_Combine:                       break;
+                case kNo_Combine:      *edgePtr++ = edge++;  break;
+            }
+        }
+    };
+
+    // Walk the verbs the way SkPath::Iter(path, true) would, closing every contour.
+    int  moveTo = 0,
+         pt = 0;
+    bool needClose = false;
+    auto close_contour = [&] {
+        if (needClose) {
+            add_line(pt - 1, moveTo);
+            needClose = false;
+        }
+    };
+
+    // Verbs are stored backwards.
+    const uint8_t* verbs = SkPathPriv::VerbData(path);
+    for (int v = path.countVerbs() - 1; v >= 0; v--) {
+        switch (verbs[v]) {
+            case SkPath::kMove_Verb:
+                close_contour();
+                moveTo = pt++;
+                break;
+            case SkPath::kLine_Verb:
+                add_line(pt - 1, pt);
+                pt++;
+                needClose = true;
+                break;
+            case SkPath::kClose_Verb:
+                close_contour();
+                break;
+            default:
+                SkDEBUGFAIL("unexpected verb");
+                break;
+        }
+    }
+    close_contour();
+    SkASSERT(2 * pt == coordCount);
+
+    return (char**)edgePtr;
+#endif
+}
+
 SkRect SkBasicEdgeBuilder::recoverClip(const SkIRect& src) const {
     return { SkIntToScalar(src.fLeft   >> fClipShift),
              SkIntToScalar(src.fTop    >> fClipShift),
@@ -306,6 +382,8 @@ int SkEdgeBuilder::buildPoly(const SkPath& path, const SkIRect* iclip, bool canC
                     break;
             }
         }
+    } else if (char** end = this->addPolygon(path, edge, edgePtr)) {
+        edgePtr = end;
     } else {
         while ((verb = iter.next(pts, false)) != SkPath::kDone_Verb) {
             switch (verb) {
@@ -8,7 +8,7 @@
 #define SkEdgeBuilder_DEFINED
 
 #include "SkAnalyticEdge.h"
-#include "SkArenaAlloc.h"
+#include "SkArenaAllocPool.h"
 #include "SkEdge.h"
 #include "SkRect.h"
 #include "SkTDArray.h"
@@ -28,7 +28,7 @@ protected:
     // In polygon mode we preallocated edges contiguously in fAlloc and fEdgeList points there.
     void**              fEdgeList = nullptr;
     SkTDArray<void*>    fList;
-    SkSTArenaAlloc<512> fAlloc;
+    SkPooledArenaAlloc  fAlloc;
 
     enum Combine {
         kNo_Combine,
@@ -48,6 +48,12 @@ private:
     virtual void addQuad (const SkPoint pts[]) = 0;
     virtual void addCubic(const SkPoint pts[]) = 0;
     virtual Combine addPolyLine(SkPoint pts[], char* edge, char** edgePtr) = 0;
+
+    // Adds every line of an unclipped all-line path at once, returning the new end of the edge
+    // pointers, or nullptr to have buildPoly() call addPolyLine() for each line instead.
+    virtual char** addPolygon(const SkPath&, char* /*edge*/, char** /*edgePtr*/) {
+        return nullptr;
+    }
 };
 
 class SkBasicEdgeBuilder final : public SkEdgeBuilder {
@@ -67,6 +73,7 @@ private:
     void addQuad (const SkPoint pts[]) override;
     void addCubic(const SkPoint pts[]) override;
     Combine addPolyLine(SkPoint pts[], char* edge, char** edgePtr) override;
+    char** addPolygon(const SkPath&, char* edge, char** edgePtr) override;
 
     const int fClipShift;
 };
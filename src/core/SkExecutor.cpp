@@ -8,9 +8,11 @@
 #include "SkExecutor.h"
 #include "SkMakeUnique.h"
 #include "SkMutex.h"
+#include "SkNoncopyable.h"
 #include "SkSemaphore.h"
 #include "SkSpinlock.h"
 #include "SkTArray.h"
+#include <atomic>
 #include <deque>
 #include <thread>
 
@@ -60,6 +62,7 @@ static inline std::function<void(void)> pop(SkTArray<std::function<void(void)>>*
 }
 
 // An SkThreadPool is an executor that runs work on a fixed pool of OS threads.
+// It keeps a separate WorkList for each priority.
 template <typename WorkList>
 class SkThreadPool final : public SkExecutor {
 public:
@@ -70,9 +73,9 @@ public:
     }
 
     ~SkThreadPool() override {
-        // Signal each thread that it's time to shut down.
+        // Signal each thread that it's time to shut down, once it runs out of other work.
         for (int i = 0; i < fThreads.count(); i++) {
-            this->add(nullptr);
+            this->addWithPriority(nullptr, Priority::kLow);
         }
         // Wait for each thread to shut down.
         for (int i = 0; i < fThreads.count(); i++) {
@@ -81,10 +84,14 @@ public:
     }
 
     virtual void add(std::function<void(void)> work) override {
+        this->addWithPriority(std::move(work), Priority::kNormal);
+    }
+
+    virtual void addWithPriority(std::function<void(void)> work, Priority priority) override {
         // Add some work to our pile of work to do.
         {
             SkAutoExclusive lock(fWorkLock);
-            fWork.emplace_back(std::move(work));
+            fWork[(int)priority].emplace_back(std::move(work));
         }
         // Tell the Loop() threads to pick it up.
         fWorkAvailable.signal(1);
@@ -103,8 +110,12 @@ private:
         std::function<void(void)> work;
         {
             SkAutoExclusive lock(fWorkLock);
-            SkASSERT(!fWork.empty());        // TODO: if (fWork.empty()) { return true; } ?
-            work = pop(&fWork);
+            int priority = kPriorityCount - 1;
+            while (priority > 0 && fWork[priority].empty()) {
+                priority--;
+            }
+            SkASSERT(!fWork[priority].empty());  // TODO: if (fWork.empty()) { return true; } ?
+            work = pop(&fWork[priority]);
         }
 
         if (!work) {
@@ -126,11 +137,272 @@ private:
     using Lock = SkMutex;
 
     SkTArray<std::thread> fThreads;
-    WorkList              fWork;
+    WorkList              fWork[kPriorityCount];
     Lock                  fWorkLock;
     SkSemaphore           fWorkAvailable;
 };
 
+// A single-owner, multi-thief double-ended queue of work, after Chase and Lev's
+//     'Dynamic Circular Work-Stealing Deque'
+// using the C11 memory orderings from Lê, Pop, Cohen and Zappa Nardelli's
+//     'Correct and Efficient Work-Stealing for Weak Memory Models'.
+//
+// Only the owning thread may push() and pop(), both at the bottom.  Any thread may steal()
+// from the top.  We store heap-allocated work so each slot fits in a single atomic word.
+class SkWorkStealingDeque : SkNoncopyable {
+public:
+    using Work = std::function<void(void)>;
+
+    SkWorkStealingDeque() : fTop(0), fBottom(0), fArray(new Array(kInitialLogSize)) {
+        fRetired.emplace_back(fArray.load(std::memory_order_relaxed));
+    }
+
+    ~SkWorkStealingDeque() {
+        Work* work;
+        while (this->pop(&work)) {
+            delete work;
+        }
+    }
+
+    // Owner only.
+    void push(Work* work) {
+        int64_t b = fBottom.load(std::memory_order_relaxed),
+                t = fTop   .load(std::memory_order_acquire);
+        Array* a = fArray.load(std::memory_order_relaxed);
+        if (b - t > a->mask()) {
+            a = this->grow(a, t, b);
+        }
+        a->put(b, work);
+        std::atomic_thread_fence(std::memory_order_release);
+        fBottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only.  Returns false if the deque is empty.
+    bool pop(Work** work) {
+        int64_t b = fBottom.load(std::memory_order_relaxed) - 1;
+        Array* a = fArray.load(std::memory_order_relaxed);
+        fBottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = fTop.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // Empty.
+            fBottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        *work = a->get(b);
+        if (t == b) {
+            // This is the last element, so we race any thieves for it.
+            bool won = fTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                              std::memory_order_relaxed);
+            fBottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread.  Returns false if the deque is empty or if we lost a race with another thread.
+    bool steal(Work** work) {
+        int64_t t = fTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = fBottom.load(std::memory_order_acquire);
+
+        if (t >= b) {
+            return false;
+        }
+        // Arrays are never freed before the deque, so it's safe to read from a stale one.
+        Array* a = fArray.load(std::memory_order_acquire);
+        *work = a->get(t);
+        return fTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                      std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr int kInitialLogSize = 6;
+
+    class Array {
+    public:
+        explicit Array(int logSize)
+            : fMask((int64_t(1) << logSize) - 1)
+            , fLogSize(logSize)
+            , fSlots(new std::atomic<Work*>[(size_t)1 << logSize]) {}
+
+        int64_t mask() const { return fMask; }
+        int logSize() const { return fLogSize; }
+
+        Work* get(int64_t i) const { return fSlots[i & fMask].load(std::memory_order_relaxed); }
+        void  put(int64_t i, Work* w) { fSlots[i & fMask].store(w, std::memory_order_relaxed); }
+
+    private:
+        int64_t                          fMask;
+        int                              fLogSize;
+        std::unique_ptr<std::atomic<Work*>[]> fSlots;
+    };
+
+    Array* grow(Array* a, int64_t t, int64_t b) {
+        Array* bigger = new Array(a->logSize() + 1);
+        for (int64_t i = t; i < b; i++) {
+            bigger->put(i, a->get(i));
+        }
+        // Thieves may still be reading from a, so we keep it around until we're destroyed.
+        fRetired.emplace_back(bigger);
+        fArray.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    std::atomic<int64_t>               fTop;
+    std::atomic<int64_t>               fBottom;
+    std::atomic<Array*>                fArray;
+    SkTArray<std::unique_ptr<Array>>   fRetired;  // Owner only.
+};
+
+// An SkWorkStealingThreadPool gives each of its OS threads its own SkWorkStealingDeque.
+// Work added from one of those threads stays on that thread's deque, and idle threads steal
+// from the others.  Work added from any other thread, or with other than normal priority, goes
+// through a shared, locked queue for its priority.
+class SkWorkStealingThreadPool final : public SkExecutor {
+public:
+    explicit SkWorkStealingThreadPool(int threads) : fWorkers(threads) {
+        // Every Worker must exist before any thread starts looking for work to steal.
+        for (int i = 0; i < threads; i++) {
+            fWorkers.push_back(skstd::make_unique<Worker>());
+        }
+        for (int i = 0; i < threads; i++) {
+            fWorkers[i]->fThread = std::thread(&Loop, this, i);
+        }
+    }
+
+    ~SkWorkStealingThreadPool() override {
+        // Signal each thread that it's time to shut down, once it runs out of other work.
+        for (int i = 0; i < fWorkers.count(); i++) {
+            this->addWithPriority(nullptr, Priority::kLow);
+        }
+        // Wait for each thread to shut down.
+        for (int i = 0; i < fWorkers.count(); i++) {
+            fWorkers[i]->fThread.join();
+        }
+    }
+
+    void add(std::function<void(void)> work) override {
+        this->addWithPriority(std::move(work), Priority::kNormal);
+    }
+
+    void addWithPriority(std::function<void(void)> work, Priority priority) override {
+        int self = this->currentWorker();
+        if (self >= 0 && priority == Priority::kNormal) {
+            fWorkers[self]->fDeque.push(new Work(std::move(work)));
+        } else {
+            SkAutoExclusive lock(fSharedLock);
+            fShared[(int)priority].emplace_back(std::move(work));
+            fSharedCount[(int)priority].fetch_add(1, std::memory_order_relaxed);
+        }
+        fWorkAvailable.signal(1);
+    }
+
+    void borrow() override {
+        // If there is work waiting, do it.
+        if (fWorkAvailable.try_wait()) {
+            SkAssertResult(this->do_work(this->currentWorker()));
+        }
+    }
+
+private:
+    using Work = SkWorkStealingDeque::Work;
+
+    struct Worker {
+        SkWorkStealingDeque fDeque;
+        std::thread         fThread;
+    };
+
+    // Returns the index of the calling thread in fWorkers, or -1 if it's not one of ours.
+    int currentWorker() const {
+        std::thread::id id = std::this_thread::get_id();
+        for (int i = 0; i < fWorkers.count(); i++) {
+            if (fWorkers[i]->fThread.get_id() == id) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // This method should be called only when fWorkAvailable indicates there's work to do.
+    bool do_work(int self) {
+        // Each successful wait() on fWorkAvailable accounts for exactly one piece of work,
+        // so we will find it eventually, though steals may transiently fail under contention.
+        Work work;
+        for (int attempt = 0; !this->find_work(self, attempt, &work); attempt++) {
+            std::this_thread::yield();
+        }
+
+        if (!work) {
+            return false;  // This is Loop()'s signal to shut down.
+        }
+
+        work();
+        return true;
+    }
+
+    bool find_work(int self, int attempt, Work* work) {
+        Work* found;
+        // First any high priority work, then our own work, most recent first, then normal
+        // priority work waiting in the shared queue...
+        if (this->take_shared(Priority::kHigh, work)) {
+            return true;
+        }
+        if (self >= 0 && fWorkers[self]->fDeque.pop(&found)) {
+            return this->take(found, work);
+        }
+        if (this->take_shared(Priority::kNormal, work)) {
+            return true;
+        }
+        // ... then the oldest work from other threads, starting at a different victim each time,
+        // and only once there's nothing else, low priority work.
+        const int n = fWorkers.count();
+        for (int i = 0; i < n; i++) {
+            int victim = (SkTMax(self, 0) + attempt + i + 1) % n;
+            if (victim != self && fWorkers[victim]->fDeque.steal(&found)) {
+                return this->take(found, work);
+            }
+        }
+        return this->take_shared(Priority::kLow, work);
+    }
+
+    bool take_shared(Priority priority, Work* work) {
+        // Peek without the lock, so that looking for high priority work is cheap when there's none.
+        if (fSharedCount[(int)priority].load(std::memory_order_relaxed) == 0) {
+            return false;
+        }
+        SkAutoExclusive lock(fSharedLock);
+        std::deque<Work>& shared = fShared[(int)priority];
+        if (shared.empty()) {
+            return false;
+        }
+        *work = std::move(shared.front());
+        shared.pop_front();
+        fSharedCount[(int)priority].fetch_add(-1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool take(Work* found, Work* work) {
+        *work = std::move(*found);
+        delete found;
+        return true;
+    }
+
+    static void Loop(SkWorkStealingThreadPool* pool, int self) {
+        do {
+            pool->fWorkAvailable.wait();
+        } while (pool->do_work(self));
+    }
+
+    SkTArray<std::unique_ptr<Worker>> fWorkers;
+    std::deque<Work>                  fShared[kPriorityCount];
+    std::atomic<int>                  fSharedCount[kPriorityCount] = {{0}, {0}, {0}};
+    SkMutex                           fSharedLock;
+    SkSemaphore                       fWorkAvailable;
+};
+
 std::unique_ptr<SkExecutor> SkExecutor::MakeFIFOThreadPool(int threads) {
     using WorkList = std::deque<std::function<void(void)>>;
     return skstd::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores());
@@ -139,3 +411,6 @@ std::unique_ptr<SkExecutor> SkExecutor::MakeLIFOThreadPool(int threads) {
     using WorkList = SkTArray<std::function<void(void)>>;
     return skstd::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores());
 }
+std::unique_ptr<SkExecutor> SkExecutor::MakeWorkStealingThreadPool(int threads) {
+    return skstd::make_unique<SkWorkStealingThreadPool>(threads > 0 ? threads : num_cores());
+}
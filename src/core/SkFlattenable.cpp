@@ -10,6 +10,7 @@
 #include "SkReadBuffer.h"
 
 #include <algorithm>
+#include <functional>
 
 SkNamedFactorySet::SkNamedFactorySet() : fNextAddedFactory(0) {}
 
@@ -69,13 +70,32 @@ struct EntryComparator {
     }
 };
 
+struct FactoryComparator {
+    bool operator()(const Entry* a, const Entry* b) const {
+        return std::less<SkFlattenable::Factory>()(a->fFactory, b->fFactory);
+    }
+    bool operator()(const Entry* a, SkFlattenable::Factory b) const {
+        return std::less<SkFlattenable::Factory>()(a->fFactory, b);
+    }
+    bool operator()(SkFlattenable::Factory a, const Entry* b) const {
+        return std::less<SkFlattenable::Factory>()(a, b->fFactory);
+    }
+};
+
 int gCount = 0;
 Entry gEntries[128];
+// gEntries again, sorted by factory, so FactoryToName() can binary search too.
+const Entry* gEntriesByFactory[SK_ARRAY_COUNT(gEntries)];
 
 }  // namespace
 
 void SkFlattenable::Finalize() {
     std::sort(gEntries, gEntries + gCount, EntryComparator());
+    for (int i = 0; i < gCount; ++i) {
+        gEntriesByFactory[i] = &gEntries[i];
+    }
+    // Stable, so a factory registered under several names keeps them in name order.
+    std::stable_sort(gEntriesByFactory, gEntriesByFactory + gCount, FactoryComparator());
 }
 
 void SkFlattenable::Register(const char name[], Factory factory) {
@@ -102,13 +122,14 @@ SkFlattenable::Factory SkFlattenable::NameToFactory(const char name[]) {
 const char* SkFlattenable::FactoryToName(Factory fact) {
     RegisterFlattenablesIfNeeded();
 
-    const Entry* entries = gEntries;
-    for (int i = gCount - 1; i >= 0; --i) {
-        if (entries[i].fFactory == fact) {
-            return entries[i].fName;
-        }
+    SkASSERT(std::is_sorted(gEntriesByFactory, gEntriesByFactory + gCount, FactoryComparator()));
+    auto pair = std::equal_range(gEntriesByFactory, gEntriesByFactory + gCount, fact,
+                                 FactoryComparator());
+    if (pair.first == pair.second) {
+        return nullptr;
     }
-    return nullptr;
+    // As before, prefer the last of its names.
+    return (*(pair.second - 1))->fName;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -124,6 +124,35 @@ SkPoint SkEvalQuadAt(const SkPoint src[3], SkScalar t) {
     return to_point(SkQuadCoeff(src).eval(t));
 }
 
+// The batched evals below put two t values in each Sk4s, laid out as x0 y0 x1 y1, so each lane
+// does exactly the arithmetic of the one-t Sk2s eval() it replaces.
+static Sk4s dup_lanes(const Sk2s& v) {
+    return Sk4s(v[0], v[1], v[0], v[1]);
+}
+
+static Sk4s load_two_t(const SkScalar t[2]) {
+    return Sk4s(t[0], t[0], t[1], t[1]);
+}
+
+void SkEvalQuadAt(const SkPoint src[3], const SkScalar t[], SkPoint dst[], int count) {
+    SkASSERT(src);
+    SkASSERT((t && dst) || count == 0);
+
+    SkQuadCoeff coeff(src);
+    Sk4s A = dup_lanes(coeff.fA),
+         B = dup_lanes(coeff.fB),
+         C = dup_lanes(coeff.fC);
+    for (; count >= 2; count -= 2) {
+        Sk4s tt = load_two_t(t);
+        ((A * tt + B) * tt + C).store(dst);
+        t   += 2;
+        dst += 2;
+    }
+    if (count > 0) {
+        *dst = to_point(coeff.eval(*t));
+    }
+}
+
 SkVector SkEvalQuadTangentAt(const SkPoint src[3], SkScalar t) {
     // The derivative equation is 2(b - a +(a - 2b +c)t). This returns a
     // zero tangent vector when t is 0 or 1, and the control point is equal
@@ -359,6 +388,26 @@ void SkEvalCubicAt(const SkPoint src[4], SkScalar t, SkPoint* loc,
     }
 }
 
+void SkEvalCubicAt(const SkPoint src[4], const SkScalar t[], SkPoint dst[], int count) {
+    SkASSERT(src);
+    SkASSERT((t && dst) || count == 0);
+
+    SkCubicCoeff coeff(src);
+    Sk4s A = dup_lanes(coeff.fA),
+         B = dup_lanes(coeff.fB),
+         C = dup_lanes(coeff.fC),
+         D = dup_lanes(coeff.fD);
+    for (; count >= 2; count -= 2) {
+        Sk4s tt = load_two_t(t);
+        (((A * tt + B) * tt + C) * tt + D).store(dst);
+        t   += 2;
+        dst += 2;
+    }
+    if (count > 0) {
+        *dst = to_point(coeff.eval(*t));
+    }
+}
+
 /** Cubic'(t) = At^2 + Bt + C, where
     A = 3(-a + 3(b - c) + d)
     B = 6(a - 2b + c)
@@ -1107,6 +1156,27 @@ SkPoint SkConic::evalAt(SkScalar t) const {
     return to_point(SkConicCoeff(*this).eval(t));
 }
 
+void SkConic::evalAt(const SkScalar t[], SkPoint dst[], int count) const {
+    SkASSERT((t && dst) || count == 0);
+
+    SkConicCoeff coeff(*this);
+    Sk4s nA = dup_lanes(coeff.fNumer.fA),
+         nB = dup_lanes(coeff.fNumer.fB),
+         nC = dup_lanes(coeff.fNumer.fC),
+         dA = dup_lanes(coeff.fDenom.fA),
+         dB = dup_lanes(coeff.fDenom.fB),
+         dC = dup_lanes(coeff.fDenom.fC);
+    for (; count >= 2; count -= 2) {
+        Sk4s tt = load_two_t(t);
+        (((nA * tt + nB) * tt + nC) / ((dA * tt + dB) * tt + dC)).store(dst);
+        t   += 2;
+        dst += 2;
+    }
+    if (count > 0) {
+        *dst = to_point(coeff.eval(*t));
+    }
+}
+
 SkVector SkConic::evalTangentAt(SkScalar t) const {
     // The derivative equation returns a zero tangent vector when t is 0 or 1,
     // and the control point is equal to the end point.
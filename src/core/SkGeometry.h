@@ -40,6 +40,12 @@ SkPoint SkEvalQuadTangentAt(const SkPoint src[3], SkScalar t);
 */
 void SkEvalQuadAt(const SkPoint src[3], SkScalar t, SkPoint* pt, SkVector* tangent = nullptr);
 
+/** Evaluates the src quad at each of count t values, writing the points to dst. The results
+    match calling SkEvalQuadAt(src, t[i]) for each i, but share the coefficients and evaluate
+    two t values at a time.
+*/
+void SkEvalQuadAt(const SkPoint src[3], const SkScalar t[], SkPoint dst[], int count);
+
 /** Given a src quadratic bezier, chop it at the specified t value,
     where 0 < t < 1, and return the two new quadratics in dst:
     dst[0..2] and dst[2..4]
@@ -99,6 +105,11 @@ SK_API void SkConvertQuadToCubic(const SkPoint src[3], SkPoint dst[4]);
 void SkEvalCubicAt(const SkPoint src[4], SkScalar t, SkPoint* locOrNull,
                    SkVector* tangentOrNull, SkVector* curvatureOrNull);
 
+/** Evaluates the src cubic at each of count t values, writing the points to dst. The results
+    match calling SkEvalCubicAt() for each t, two t values at a time.
+*/
+void SkEvalCubicAt(const SkPoint src[4], const SkScalar t[], SkPoint dst[], int count);
+
 /** Given a src cubic bezier, chop it at the specified t value,
     where 0 < t < 1, and return the two new cubics in dst:
     dst[0..3] and dst[3..6]
@@ -266,6 +277,8 @@ struct SkConic {
     void chop(SkConic dst[2]) const;
 
     SkPoint evalAt(SkScalar t) const;
+    // Evaluates count t values into dst, as evalAt(t[i]) would.
+    void evalAt(const SkScalar t[], SkPoint dst[], int count) const;
     SkVector evalTangentAt(SkScalar t) const;
 
     void computeAsQuadError(SkVector* err) const;
@@ -27,7 +27,7 @@
 #include "SkRemoteGlyphCacheImpl.h"
 #include "SkStrike.h"
 #include "SkStrikeCache.h"
-#include "SkTDArray.h"
+#include "SkTHash.h"
 #include "SkTraceEvent.h"
 
 // -- SkGlyphCacheCommon ---------------------------------------------------------------------------
@@ -178,8 +178,7 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
                                 pathFont, pathPaint, props,
                                 fScalerContextFlags, SkMatrix::I());
 
-            SkTDArray<PathAndPos> pathsAndPositions;
-            pathsAndPositions.setReserve(runSize);
+            fBitmapPaths.clear();
             SkPoint* positionCursor = fPositions;
             for (auto glyphID : glyphRun.glyphsIDs()) {
                 SkPoint position = *positionCursor++;
@@ -188,7 +187,7 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
                     if (!glyph.isEmpty()) {
                         const SkPath* path = pathCache->findPath(glyph);
                         if (path != nullptr) {
-                            pathsAndPositions.push_back(PathAndPos{path, position});
+                            fBitmapPaths.push_back(PathAndPos{path, position});
                         }
                     }
                 }
@@ -199,9 +198,7 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
             pathPaint = runPaint;
             pathPaint.setAntiAlias(runFont.hasSomeAntiAliasing());
 
-            bitmapDevice->paintPaths(
-                    SkSpan<const PathAndPos>{pathsAndPositions.begin(), pathsAndPositions.size()},
-                    textScale, pathPaint);
+            bitmapDevice->paintPaths(SkSpan<const PathAndPos>{fBitmapPaths}, textScale, pathPaint);
         } else {
             auto cache = SkStrikeCache::FindOrCreateStrikeExclusive(
                                         runFont, runPaint, props,
@@ -214,8 +211,7 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
             matrix.postTranslate(rounding.x(), rounding.y());
             matrix.mapPoints(fPositions, glyphRun.positions().data(), runSize);
 
-            SkTDArray<SkMask> masks;
-            masks.setReserve(runSize);
+            fBitmapMasks.clear();
             const SkPoint* positionCursor = fPositions;
             for (auto glyphID : glyphRun.glyphsIDs()) {
                 auto position = *positionCursor++;
@@ -223,11 +219,11 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
                     const SkGlyph& glyph = cache->getGlyphMetrics(glyphID, position);
                     const void* image;
                     if (!glyph.isEmpty() && (image = cache->findImage(glyph))) {
-                        masks.push_back(create_mask(glyph, position, image));
+                        fBitmapMasks.push_back(create_mask(glyph, position, image));
                     }
                 }
             }
-            bitmapDevice->paintMasks(SkSpan<const SkMask>{masks.begin(), masks.size()}, runPaint);
+            bitmapDevice->paintMasks(SkSpan<const SkMask>{fBitmapMasks}, runPaint);
         }
     }
 }
@@ -253,9 +249,10 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
 //   transformations from the view matrix. Calculate a text scale based on that reduction. This
 //   scale factor is used to increase the size of the destination rectangles. The destination
 //   rectangles are then scaled, rotated, etc. by the GPU using the view matrix.
+template <typename ARGBFallbackT>
 void SkGlyphRunListPainter::processARGBFallback(
         SkScalar maxGlyphDimension, const SkPaint& runPaint, const SkFont& runFont,
-        const SkMatrix& viewMatrix, SkScalar textScale, ARGBFallback argbFallback) {
+        const SkMatrix& viewMatrix, SkScalar textScale, ARGBFallbackT&& argbFallback) {
     SkASSERT(!fARGBGlyphsIDs.empty());
 
     SkScalar maxScale = viewMatrix.getMaxScale();
@@ -331,11 +328,11 @@ void SkGlyphRunListPainter::processARGBFallback(
 
 // Beware! The following code will end up holding two glyph caches at the same time, but they
 // will not be the same cache (which would cause two separate caches to be created).
-template <typename PerEmptyT, typename PerPathT>
+template <typename PerEmptyT, typename PerPathT, typename ARGBFallbackT>
 void SkGlyphRunListPainter::drawGlyphRunAsPathWithARGBFallback(
         SkStrikeInterface* pathCache, const SkGlyphRun& glyphRun,
         SkPoint origin, const SkPaint& runPaint, const SkMatrix& viewMatrix, SkScalar textScale,
-        PerEmptyT&& perEmpty, PerPathT&& perPath, ARGBFallback&& argbFallback) {
+        PerEmptyT&& perEmpty, PerPathT&& perPath, ARGBFallbackT&& argbFallback) {
     fARGBGlyphsIDs.clear();
     fARGBPositions.clear();
     SkScalar maxFallbackDimension{-SK_ScalarInfinity};
@@ -363,7 +360,7 @@ void SkGlyphRunListPainter::drawGlyphRunAsPathWithARGBFallback(
     if (!fARGBGlyphsIDs.empty()) {
         this->processARGBFallback(
                 maxFallbackDimension, runPaint, glyphRun.font(), viewMatrix, textScale,
-                std::move(argbFallback));
+                std::forward<ARGBFallbackT>(argbFallback));
 
     }
 }
@@ -372,7 +369,8 @@ template <typename EmptiesT, typename MasksT, typename PathsT>
 void SkGlyphRunListPainter::drawGlyphRunAsBMPWithPathFallback(
         SkStrikeInterface* cache, const SkGlyphRun& glyphRun,
         SkPoint origin, const SkMatrix& deviceMatrix,
-        EmptiesT&& processEmpties, MasksT&& processMasks, PathsT&& processPaths) {
+        EmptiesT&& processEmpties, MasksT&& processMasks, PathsT&& processPaths,
+        SkExecutor* executor) {
     ScopedBuffers _ = this->ensureBuffers(glyphRun);
 
     int glyphCount = 0;
@@ -407,16 +405,23 @@ void SkGlyphRunListPainter::drawGlyphRunAsBMPWithPathFallback(
                     emptyGlyphs.push_back(&glyph);
                 }
             } else {
-                if (cache->hasImage(glyph)) {
-                    fMasks[glyphCount++] = {&glyph, mappedPt};
-                } else {
-                    // In practice, this never happens.
-                    emptyGlyphs.push_back(&glyph);
-                }
+                fMasks[glyphCount++] = {&glyph, mappedPt};
             }
         }
     }
 
+    this->prepareMaskImages(cache, glyphCount, executor);
+    int maskCount = 0;
+    for (int i = 0; i < glyphCount; ++i) {
+        if (cache->hasImage(*fMasks[i].glyph)) {
+            fMasks[maskCount++] = fMasks[i];
+        } else {
+            // In practice, this never happens.
+            emptyGlyphs.push_back(fMasks[i].glyph);
+        }
+    }
+    glyphCount = maskCount;
+
     if (!emptyGlyphs.empty()) {
         processEmpties(SkSpan<const SkGlyph*>{emptyGlyphs.data(), emptyGlyphs.size()});
     }
@@ -429,15 +434,18 @@ void SkGlyphRunListPainter::drawGlyphRunAsBMPWithPathFallback(
     }
 }
 
-template <typename PerEmptyT, typename PerSDFT, typename PerPathT>
+template <typename PerEmptyT, typename PerSDFT, typename PerPathT, typename ARGBFallbackT>
 void SkGlyphRunListPainter::drawGlyphRunAsSDFWithARGBFallback(
         SkStrikeInterface* cache, const SkGlyphRun& glyphRun,
         SkPoint origin, const SkPaint& runPaint, const SkMatrix& viewMatrix, SkScalar textScale,
-        PerEmptyT&& perEmpty, PerSDFT&& perSDF, PerPathT&& perPath, ARGBFallback&& argbFallback) {
+        PerEmptyT&& perEmpty, PerSDFT&& perSDF, PerPathT&& perPath, ARGBFallbackT&& argbFallback,
+        SkExecutor* executor) {
+    ScopedBuffers _ = this->ensureBuffers(glyphRun);
     fARGBGlyphsIDs.clear();
     fARGBPositions.clear();
     SkScalar maxFallbackDimension{-SK_ScalarInfinity};
 
+    int sdfCount = 0;
     const SkPoint* positionCursor = glyphRun.positions().data();
     for (auto glyphID : glyphRun.glyphsIDs()) {
         const SkGlyph& glyph = cache->getGlyphMetrics(glyphID, {0, 0});
@@ -446,12 +454,7 @@ void SkGlyphRunListPainter::drawGlyphRunAsSDFWithARGBFallback(
             perEmpty(glyph, glyphPos);
         } else if (glyph.fMaskFormat == SkMask::kSDF_Format) {
             if (!SkStrikeCommon::GlyphTooBigForAtlas(glyph)) {
-                // TODO: this check is probably not needed. Remove when proven.
-                if (cache->hasImage(glyph)) {
-                    perSDF(glyph, glyphPos);
-                } else {
-                    perEmpty(glyph, glyphPos);
-                }
+                fMasks[sdfCount++] = {&glyph, glyphPos};
             } else {
                 if (cache->hasPath(glyph)) {
                     perPath(glyph, glyphPos);
@@ -468,13 +471,36 @@ void SkGlyphRunListPainter::drawGlyphRunAsSDFWithARGBFallback(
         }
     }
 
+    this->prepareMaskImages(cache, sdfCount, executor);
+    for (int i = 0; i < sdfCount; ++i) {
+        const SkGlyph& glyph = *fMasks[i].glyph;
+        // TODO: this check is probably not needed. Remove when proven.
+        if (cache->hasImage(glyph)) {
+            perSDF(glyph, fMasks[i].position);
+        } else {
+            perEmpty(glyph, fMasks[i].position);
+        }
+    }
+
     if (!fARGBGlyphsIDs.empty()) {
         this->processARGBFallback(
                 maxFallbackDimension, runPaint, glyphRun.font(), viewMatrix, textScale,
-                std::move(argbFallback));
+                std::forward<ARGBFallbackT>(argbFallback));
     }
 }
 
+void SkGlyphRunListPainter::prepareMaskImages(
+        SkStrikeInterface* cache, int count, SkExecutor* executor) {
+    if (executor == nullptr || count == 0) {
+        return;
+    }
+    fImageGlyphs.clear();
+    for (int i = 0; i < count; ++i) {
+        fImageGlyphs.push_back(fMasks[i].glyph);
+    }
+    cache->prepareImages(SkSpan<const SkGlyph*>{fImageGlyphs}, executor);
+}
+
 SkGlyphRunListPainter::ScopedBuffers
 SkGlyphRunListPainter::ensureBuffers(const SkGlyphRunList& glyphRunList) {
     size_t size = 0;
@@ -503,6 +529,89 @@ SkPMColor4f generate_filtered_color(const SkPaint& paint, const GrColorSpaceInfo
     return filteredColor.premul();
 }
 
+namespace {
+// Loads the distance field images missing from a strike out of a persistent cache before the
+// run is painted, and stores afterwards the images that the strike had to generate.
+class PersistentSDFGlyphs {
+public:
+    PersistentSDFGlyphs(GrContextOptions::PersistentCache* persistentCache, SkStrike* strike)
+            : fPersistentCache{persistentCache}
+            , fStrike{strike} {
+        if (fPersistentCache == nullptr) {
+            return;
+        }
+        // The typeface's unique ID is only meaningful within this process, so name it by its
+        // family, style and a few of its metrics instead.
+        SkScalerContext* scaler = fStrike->getScalerContext();
+        SkScalerContextRec rec = scaler->getRec();
+        rec.fFontID = 0;
+        const SkTypeface* typeface = scaler->getTypeface();
+        SkString familyName;
+        typeface->getFamilyName(&familyName);
+        SkFontStyle style = typeface->fontStyle();
+
+        fKeyPrefix.write32(kVersion);
+        fKeyPrefix.write(&rec, sizeof(rec));
+        fKeyPrefix.write32(style.weight());
+        fKeyPrefix.write32(style.width());
+        fKeyPrefix.write32(style.slant());
+        fKeyPrefix.write32(typeface->countGlyphs());
+        fKeyPrefix.write32(typeface->getUnitsPerEm());
+        fKeyPrefix.writeText(familyName.c_str());
+    }
+
+    void load(SkSpan<const SkGlyphID> glyphIDs) {
+        if (fPersistentCache == nullptr) {
+            return;
+        }
+        for (SkGlyphID glyphID : glyphIDs) {
+            SkGlyph* glyph = const_cast<SkGlyph*>(&fStrike->getGlyphIDMetrics(glyphID));
+            if (glyph->isEmpty() || glyph->fImage != nullptr
+                || glyph->fMaskFormat != SkMask::kSDF_Format
+                || SkStrikeCommon::GlyphTooBigForAtlas(*glyph)
+                || fMissIDs.contains(glyphID)) {
+                continue;
+            }
+            sk_sp<SkData> data = fPersistentCache->load(*this->key(*glyph));
+            if (data && data->size() == glyph->computeImageSize()) {
+                fStrike->initializeImage(data->data(), data->size(), glyph);
+            } else {
+                fMissIDs.add(glyphID);
+                fMisses.push_back(glyph);
+            }
+        }
+    }
+
+    void storeGenerated() {
+        for (const SkGlyph* glyph : fMisses) {
+            if (glyph->fImage != nullptr) {
+                fPersistentCache->store(*this->key(*glyph),
+                                        *SkData::MakeWithoutCopy(glyph->fImage,
+                                                                 glyph->computeImageSize()));
+            }
+        }
+    }
+
+private:
+    static constexpr uint32_t kVersion = 1;
+
+    sk_sp<SkData> key(const SkGlyph& glyph) const {
+        size_t prefixSize = fKeyPrefix.bytesWritten();
+        sk_sp<SkData> key = SkData::MakeUninitialized(prefixSize + sizeof(uint32_t));
+        fKeyPrefix.copyTo(key->writable_data());
+        uint32_t packedID = glyph.getPackedID().value();
+        memcpy(SkTAddOffset<void>(key->writable_data(), prefixSize), &packedID, sizeof(packedID));
+        return key;
+    }
+
+    GrContextOptions::PersistentCache* const fPersistentCache;
+    SkStrike* const fStrike;
+    SkDynamicMemoryWStream fKeyPrefix;
+    SkTHashSet<SkGlyphID> fMissIDs;
+    std::vector<const SkGlyph*> fMisses;
+};
+}  // namespace
+
 void GrTextContext::drawGlyphRunList(
         GrContext* context, GrTextTarget* target, const GrClip& clip,
         const SkMatrix& viewMatrix, const SkSurfaceProps& props,
@@ -708,6 +817,16 @@ void GrTextBlob::generateFromGlyphRunList(GrStrikeCache* glyphCache,
 
             SkASSERT(strike != nullptr);
             subRun->setStrike(strike);
+            // The images of these glyphs are otherwise only made when the atlas is filled at
+            // flush, so make them here while the executor can share the work.
+            if (fExecutor != nullptr) {
+                std::vector<const SkGlyph*> glyphs;
+                glyphs.reserve(glyphIDs.size());
+                for (auto glyphID : glyphIDs) {
+                    glyphs.push_back(&fallbackCache->getGlyphIDMetrics(glyphID));
+                }
+                fallbackCache->prepareImages(SkSpan<const SkGlyph*>{glyphs}, fExecutor);
+            }
             const SkPoint* glyphPos = positions.data();
             if (needsTransform == SkGlyphRunListPainter::kTransformDone) {
                 for (auto glyphID : glyphIDs) {
@@ -727,6 +846,7 @@ void GrTextBlob::generateFromGlyphRunList(GrStrikeCache* glyphCache,
         const SkSurfaceProps& fProps;
         const SkScalerContextFlags fScalerContextFlags;
         GrStrikeCache* const fGrStrikeCache;
+        SkExecutor* const fExecutor;
     };
 
     SkPoint origin = glyphRunList.origin();
@@ -789,12 +909,18 @@ void GrTextBlob::generateFromGlyphRunList(GrStrikeCache* glyphCache,
                     };
 
                 ARGBFallbackHelper argbFallback{this, run, props, scalerContextFlags,
-                                                glyphCache};
+                                                glyphCache, options.fExecutor};
+
+                PersistentSDFGlyphs persistentGlyphs{options.fDistanceFieldGlyphCache,
+                                                     cache.get()};
+                persistentGlyphs.load(glyphRun.glyphsIDs());
 
                 glyphPainter->drawGlyphRunAsSDFWithARGBFallback(
                     cache.get(), glyphRun, origin, runPaint, viewMatrix, textScale,
                     std::move(perEmpty), std::move(perSDF), std::move(perPath),
-                    std::move(argbFallback));
+                    std::move(argbFallback), options.fExecutor);
+
+                persistentGlyphs.storeGenerated();
             }
 
         } else if (SkGlyphRunListPainter::ShouldDrawAsPath(runPaint, runFont, viewMatrix)) {
@@ -823,7 +949,8 @@ void GrTextBlob::generateFromGlyphRunList(GrStrikeCache* glyphCache,
                 }
             };
 
-            ARGBFallbackHelper argbFallback{this, run, props, scalerContextFlags, glyphCache};
+            ARGBFallbackHelper argbFallback{this, run, props, scalerContextFlags, glyphCache,
+                                            options.fExecutor};
 
             glyphPainter->drawGlyphRunAsPathWithARGBFallback(
                 pathCache.get(), glyphRun, origin, runPaint, viewMatrix, textScale,
@@ -864,7 +991,8 @@ void GrTextBlob::generateFromGlyphRunList(GrStrikeCache* glyphCache,
 
             glyphPainter->drawGlyphRunAsBMPWithPathFallback(
                     cache.get(), glyphRun, origin, viewMatrix,
-                    std::move(processEmpties), std::move(processMasks), std::move(processPaths));
+                    std::move(processEmpties), std::move(processMasks), std::move(processPaths),
+                    options.fExecutor);
         }
     }
 }
@@ -1110,6 +1238,9 @@ SkGlyphRunListPainter::ScopedBuffers::ScopedBuffers(SkGlyphRunListPainter* paint
 
 SkGlyphRunListPainter::ScopedBuffers::~ScopedBuffers() {
     fPainter->fPaths.clear();
+    fPainter->fImageGlyphs.clear();
+    fPainter->fBitmapMasks.clear();
+    fPainter->fBitmapPaths.clear();
     fPainter->fARGBGlyphsIDs.clear();
     fPainter->fARGBPositions.clear();
 
@@ -1118,6 +1249,9 @@ SkGlyphRunListPainter::ScopedBuffers::~ScopedBuffers() {
         fPainter->fPositions.reset();
         fPainter->fMasks.reset();
         fPainter->fPaths.shrink_to_fit();
+        fPainter->fImageGlyphs.shrink_to_fit();
+        fPainter->fBitmapMasks.shrink_to_fit();
+        fPainter->fBitmapPaths.shrink_to_fit();
         fPainter->fARGBGlyphsIDs.shrink_to_fit();
         fPainter->fARGBPositions.shrink_to_fit();
     }
@@ -18,6 +18,7 @@
 class GrColorSpaceInfo;
 class GrRenderTargetContext;
 #endif
+class SkExecutor;
 
 class SkStrikeInterface {
 public:
@@ -26,6 +27,10 @@ public:
     virtual const SkGlyph& getGlyphMetrics(SkGlyphID glyphID, SkPoint position) = 0;
     virtual bool hasImage(const SkGlyph& glyph) = 0;
     virtual bool hasPath(const SkGlyph& glyph) = 0;
+
+    // Makes the images of glyphs available ahead of the hasImage calls for them, rasterizing
+    // several at once on executor if it is not null.
+    virtual void prepareImages(SkSpan<const SkGlyph*> glyphs, SkExecutor* executor) {}
 };
 
 class SkStrikeCommon {
@@ -82,36 +87,40 @@ public:
     void drawGlyphRunAsBMPWithPathFallback(
             SkStrikeInterface* cache, const SkGlyphRun& glyphRun,
             SkPoint origin, const SkMatrix& deviceMatrix,
-            EmptiesT&& processEmpties, MasksT&& processMasks, PathsT&& processPaths);
+            EmptiesT&& processEmpties, MasksT&& processMasks, PathsT&& processPaths,
+            SkExecutor* executor = nullptr);
 
     enum NeedsTransform : bool { kTransformDone = false, kDoTransform = true };
 
-    using ARGBFallback =
-    std::function<void(const SkPaint& fallbackPaint, // The run paint maybe with a new text size
-                       const SkFont& fallbackFont,
-                       SkSpan<const SkGlyphID> fallbackGlyphIDs, // Colored glyphs
-                       SkSpan<const SkPoint> fallbackPositions,  // Positions of above glyphs
-                       SkScalar fallbackTextScale,               // Scale factor for glyph
-                       const SkMatrix& glyphCacheMatrix,         // Matrix of glyph cache
-                       NeedsTransform handleTransformLater)>;    // Positions / glyph transformed
+    // The ARGB fallbacks below are called as
+    //   argbFallback(const SkPaint& fallbackPaint,       // The run paint maybe with a new text size
+    //                const SkFont& fallbackFont,
+    //                SkSpan<const SkGlyphID> fallbackGlyphIDs, // Colored glyphs
+    //                SkSpan<const SkPoint> fallbackPositions,  // Positions of above glyphs
+    //                SkScalar fallbackTextScale,               // Scale factor for glyph
+    //                const SkMatrix& glyphCacheMatrix,         // Matrix of glyph cache
+    //                NeedsTransform handleTransformLater);     // Positions / glyph transformed
+    // They are template parameters rather than std::functions so that passing one per run does
+    // not allocate.
 
     // Draw glyphs as paths with fallback to scaled ARGB glyphs if color is needed.
     // PerPath - perPath(const SkGlyph&, SkPoint position)
-    // FallbackARGB - fallbackARGB(SkSpan<const SkGlyphID>, SkSpan<const SkPoint>)
+    // ARGBFallbackT - fallbackARGB as above
     // For each glyph that is not ARGB call perPath. If the glyph is ARGB then store the glyphID
     // and the position in fallback vectors. After all the glyphs are processed, pass the
     // fallback glyphIDs and positions to fallbackARGB.
-    template <typename PerEmptyT, typename PerPath>
+    template <typename PerEmptyT, typename PerPath, typename ARGBFallbackT>
     void drawGlyphRunAsPathWithARGBFallback(
             SkStrikeInterface* cache, const SkGlyphRun& glyphRun,
             SkPoint origin, const SkPaint& paint, const SkMatrix& viewMatrix, SkScalar textScale,
-            PerEmptyT&& perEmpty, PerPath&& perPath, ARGBFallback&& fallbackARGB);
+            PerEmptyT&& perEmpty, PerPath&& perPath, ARGBFallbackT&& fallbackARGB);
 
-    template <typename PerEmptyT, typename PerSDFT, typename PerPathT>
+    template <typename PerEmptyT, typename PerSDFT, typename PerPathT, typename ARGBFallbackT>
     void drawGlyphRunAsSDFWithARGBFallback(
             SkStrikeInterface* cache, const SkGlyphRun& glyphRun,
             SkPoint origin, const SkPaint& runPaint, const SkMatrix& viewMatrix, SkScalar textRatio,
-            PerEmptyT&& perEmpty, PerSDFT&& perSDF, PerPathT&& perPath, ARGBFallback&& perFallback);
+            PerEmptyT&& perEmpty, PerSDFT&& perSDF, PerPathT&& perPath, ARGBFallbackT&& perFallback,
+            SkExecutor* executor = nullptr);
 
     // TODO: Make this the canonical check for Skia.
     static bool ShouldDrawAsPath(const SkPaint& paint, const SkFont& font, const SkMatrix& matrix);
@@ -128,9 +137,13 @@ private:
     // TODO: Remove once I can hoist ensureBuffers above the list for loop in all cases.
     ScopedBuffers SK_WARN_UNUSED_RESULT ensureBuffers(const SkGlyphRun& glyphRun);
 
+    // Asks cache to prepare the images of the first count glyphs in fMasks on executor.
+    void prepareMaskImages(SkStrikeInterface* cache, int count, SkExecutor* executor);
+
+    template <typename ARGBFallbackT>
     void processARGBFallback(
             SkScalar maxGlyphDimension, const SkPaint& fallbackPaint, const SkFont& fallbackFont,
-            const SkMatrix& viewMatrix, SkScalar textScale, ARGBFallback argbFallback);
+            const SkMatrix& viewMatrix, SkScalar textScale, ARGBFallbackT&& argbFallback);
 
     // The props as on the actual device.
     const SkSurfaceProps fDeviceProps;
@@ -145,6 +158,13 @@ private:
 
     std::vector<GlyphAndPos> fPaths;
 
+    // The masks and paths of a run drawn by drawForBitmapDevice.
+    std::vector<SkMask> fBitmapMasks;
+    std::vector<PathAndPos> fBitmapPaths;
+
+    // The glyphs of fMasks, for prepareMaskImages.
+    std::vector<const SkGlyph*> fImageGlyphs;
+
     // Vectors for tracking ARGB fallback information.
     std::vector<SkGlyphID> fARGBGlyphsIDs;
     std::vector<SkPoint>   fARGBPositions;
@@ -14,6 +14,7 @@
 #include "SkImageFilter.h"
 #include "SkMath.h"
 #include "SkMatrix.h"
+#include "SkMemoryPressure.h"
 #include "SkOpts.h"
 #include "SkPath.h"
 #include "SkPathEffect.h"
@@ -61,6 +62,54 @@ void SkGraphics::PurgeAllCaches() {
     SkImageFilter::PurgeCache();
 }
 
+void SkGraphics::NotifyMemoryPressure(MemoryPressureLevel level) {
+    // GrContexts can only be touched on their own threads, so they pick this up when they poll.
+    SkMemoryPressureObserver::Signal(level);
+
+    switch (level) {
+        case MemoryPressureLevel::kNone:
+            break;
+        case MemoryPressureLevel::kModerate: {
+            SkStrikeCache* strikeCache = SkStrikeCache::GlobalStrikeCache();
+            strikeCache->purgeBytes(strikeCache->getTotalMemoryUsed() / 2);
+            break;
+        }
+        case MemoryPressureLevel::kHigh: {
+            SkStrikeCache::GlobalStrikeCache()->purgeAll();
+            SkImageFilter::PurgeCache();
+            // Decoded images are the most expensive to recreate, so only trim those by half.
+            size_t limit = SkResourceCache::GetTotalByteLimit();
+            SkResourceCache::SetTotalByteLimit(SkResourceCache::GetTotalBytesUsed() / 2);
+            SkResourceCache::SetTotalByteLimit(limit);
+            break;
+        }
+        case MemoryPressureLevel::kCritical:
+            SkGraphics::PurgeAllCaches();
+            break;
+    }
+}
+
+SkGraphics::MemoryPressureLevel SkGraphics::MemoryPressureLevelFromAndroidTrimLevel(int trimLevel) {
+    // From android.content.ComponentCallbacks2.
+    enum {
+        TRIM_MEMORY_RUNNING_MODERATE = 5,
+        TRIM_MEMORY_RUNNING_LOW      = 10,
+        TRIM_MEMORY_RUNNING_CRITICAL = 15,
+        TRIM_MEMORY_MODERATE         = 60,
+    };
+    if (trimLevel >= TRIM_MEMORY_MODERATE || trimLevel == TRIM_MEMORY_RUNNING_CRITICAL) {
+        return MemoryPressureLevel::kCritical;
+    }
+    if (trimLevel >= TRIM_MEMORY_RUNNING_LOW) {
+        // Includes TRIM_MEMORY_UI_HIDDEN and TRIM_MEMORY_BACKGROUND.
+        return MemoryPressureLevel::kHigh;
+    }
+    if (trimLevel >= TRIM_MEMORY_RUNNING_MODERATE) {
+        return MemoryPressureLevel::kModerate;
+    }
+    return MemoryPressureLevel::kNone;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static const char kFontCacheLimitStr[] = "font-cache-limit";
@@ -8,8 +8,11 @@
 #include "SkImageFilter.h"
 
 #include "SkCanvas.h"
+#include "SkColorFilter.h"
+#include "SkExecutor.h"
 #include "SkFuzzLogging.h"
 #include "SkImageFilterCache.h"
+#include "SkImageFilterPriv.h"
 #include "SkLocalMatrixImageFilter.h"
 #include "SkMatrixImageFilter.h"
 #include "SkReadBuffer.h"
@@ -17,6 +20,7 @@
 #include "SkSafe32.h"
 #include "SkSpecialImage.h"
 #include "SkSpecialSurface.h"
+#include "SkTaskGroup.h"
 #include "SkValidationUtils.h"
 #include "SkWriteBuffer.h"
 #if SK_SUPPORT_GPU
@@ -285,6 +289,10 @@ bool SkImageFilter::asAColorFilter(SkColorFilter** filterPtr) const {
     return true;
 }
 
+sk_sp<SkImageFilter> SkImageFilter::onMakeWithColorFilter(sk_sp<SkColorFilter>) const {
+    return nullptr;
+}
+
 bool SkImageFilter::canHandleComplexCTM() const {
     if (!this->onCanHandleComplexCTM()) {
         return false;
@@ -299,6 +307,20 @@ bool SkImageFilter::canHandleComplexCTM() const {
     return true;
 }
 
+bool SkImageFilter::canFilterInTiles() const {
+    if (!this->onCanFilterInTiles()) {
+        return false;
+    }
+    const int count = this->countInputs();
+    for (int i = 0; i < count; ++i) {
+        SkImageFilter* input = this->getInput(i);
+        if (input && !input->canFilterInTiles()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool SkImageFilter::applyCropRect(const Context& ctx, const SkIRect& srcBounds,
                                   SkIRect* dstBounds) const {
     SkIRect tmpDst = this->onFilterNodeBounds(srcBounds, ctx.ctm(), kForward_MapDirection, nullptr);
@@ -431,7 +453,7 @@ SkImageFilter::Context SkImageFilter::mapContext(const Context& ctx) const {
     SkIRect clipBounds = this->onFilterNodeBounds(ctx.clipBounds(), ctx.ctm(),
                                                   MapDirection::kReverse_MapDirection,
                                                   &ctx.clipBounds());
-    return Context(ctx.ctm(), clipBounds, ctx.cache(), ctx.outputProperties());
+    return Context(ctx.ctm(), clipBounds, ctx.cache(), ctx.outputProperties(), ctx.executor());
 }
 
 sk_sp<SkImageFilter> SkImageFilter::MakeMatrixFilter(const SkMatrix& matrix,
@@ -464,6 +486,156 @@ sk_sp<SkSpecialImage> SkImageFilter::filterInput(int index,
     return result;
 }
 
+void SkImageFilter::filterInputs(int count,
+                                 SkSpecialImage* src,
+                                 const Context& ctx,
+                                 sk_sp<SkSpecialImage> results[],
+                                 SkIPoint offsets[]) const {
+    SkASSERT(count <= this->countInputs());
+
+    // unique[i] is the first input that is the same filter as input i.
+    SkAutoSTArray<8, int> unique(count);
+    int uniqueCount = 0;
+    for (int i = 0; i < count; ++i) {
+        unique[i] = i;
+        for (int j = 0; j < i; ++j) {
+            if (this->getInput(j) == this->getInput(i)) {
+                unique[i] = j;
+                break;
+            }
+        }
+        uniqueCount += unique[i] == i;
+    }
+
+    auto filter = [&](int i) {
+        offsets[i] = SkIPoint::Make(0, 0);
+        results[i] = this->filterInput(i, src, ctx, &offsets[i]);
+    };
+    if (ctx.executor() && !src->isTextureBacked() && uniqueCount > 1) {
+        SkTaskGroup tasks(*ctx.executor());
+        for (int i = 0; i < count; ++i) {
+            if (unique[i] == i) {
+                tasks.add([&filter, i] { filter(i); });
+            }
+        }
+        tasks.wait();
+    } else {
+        for (int i = 0; i < count; ++i) {
+            if (unique[i] == i) {
+                filter(i);
+            }
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        if (unique[i] != i) {
+            results[i] = results[unique[i]];
+            offsets[i] = offsets[unique[i]];
+        }
+    }
+}
+
+std::atomic<SkExecutor*> gSkImageFilterExecutor{nullptr};
+
+// Output tiles are this many pixels on a side.
+static constexpr int kFilterTileSize = 512;
+
+// We don't tile if the tiles would need, all together, more than this many times the source
+// pixels that the whole output does. Their inputs overlap by the reach of the filter, e.g. the
+// radius of a blur, and each tile re-filters its overlap.
+static constexpr int kMaxTiledSourceOverdraw = 2;
+
+sk_sp<SkSpecialImage> SkFilterImageInTiles(const SkImageFilter* filter, SkSpecialImage* src,
+                                           const SkImageFilter::Context& ctx,
+                                           SkIPoint* offset) {
+    SkASSERT(filter && src && offset);
+    const SkIRect& clipBounds = ctx.clipBounds();
+    const int cols = (clipBounds.width()  + kFilterTileSize - 1) / kFilterTileSize,
+              rows = (clipBounds.height() + kFilterTileSize - 1) / kFilterTileSize;
+    if (!ctx.executor() || src->isTextureBacked() || !ctx.isValid() || cols * rows < 2 ||
+        !filter->canFilterInTiles()) {
+        return filter->filterImage(src, ctx, offset);
+    }
+
+    // Plan the tiles, and work out which part of the source each of them reads.
+    auto sourceArea = [&](const SkIRect& dstRect) -> int64_t {
+        SkIRect srcRect = filter->filterBounds(dstRect, ctx.ctm(),
+                                               SkImageFilter::kReverse_MapDirection, &dstRect);
+        if (!srcRect.intersect(SkIRect::MakeWH(src->width(), src->height()))) {
+            return 0;
+        }
+        return (int64_t)srcRect.width() * srcRect.height();
+    };
+    SkTArray<SkIRect> tiles(cols * rows);
+    int64_t tiledSourceArea = 0;
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            SkIRect tile = SkIRect::MakeXYWH(clipBounds.fLeft + x * kFilterTileSize,
+                                             clipBounds.fTop  + y * kFilterTileSize,
+                                             kFilterTileSize, kFilterTileSize);
+            SkAssertResult(tile.intersect(clipBounds));
+            tiledSourceArea += sourceArea(tile);
+            tiles.push_back(tile);
+        }
+    }
+    if (tiledSourceArea > kMaxTiledSourceOverdraw * sourceArea(clipBounds)) {
+        return filter->filterImage(src, ctx, offset);
+    }
+
+    // Filter each tile with the tile as its clip. The DAG maps that back through each node, so
+    // every node only produces what the tile needs.
+    SkTArray<sk_sp<SkSpecialImage>> images(tiles.count());
+    SkTArray<SkIPoint> offsets(tiles.count());
+    images.push_back_n(tiles.count());
+    offsets.push_back_n(tiles.count(), SkIPoint::Make(0, 0));
+    SkTaskGroup tasks(*ctx.executor());
+    tasks.batch(tiles.count(), [&](int i) {
+        SkImageFilter::Context tileCtx(ctx.ctm(), tiles[i], ctx.cache(), ctx.outputProperties(),
+                                       ctx.executor());
+        images[i] = filter->filterImage(src, tileCtx, &offsets[i]);
+    });
+    tasks.wait();
+
+    // Only the part of each result inside its tile is meant to be complete, so stitch just those.
+    SkIRect bounds = SkIRect::MakeEmpty();
+    for (int i = 0; i < tiles.count(); ++i) {
+        if (images[i]) {
+            SkIRect imageBounds = SkIRect::MakeXYWH(offsets[i].fX, offsets[i].fY,
+                                                    images[i]->width(), images[i]->height());
+            if (imageBounds.intersect(tiles[i])) {
+                bounds.join(imageBounds);
+            }
+        }
+    }
+    if (bounds.isEmpty()) {
+        return nullptr;
+    }
+
+    sk_sp<SkSpecialSurface> surf(src->makeSurface(ctx.outputProperties(), bounds.size()));
+    if (!surf) {
+        return nullptr;
+    }
+    SkCanvas* canvas = surf->getCanvas();
+    SkASSERT(canvas);
+    canvas->clear(0x0);
+
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+    for (int i = 0; i < tiles.count(); ++i) {
+        if (!images[i]) {
+            continue;
+        }
+        canvas->save();
+        canvas->clipRect(SkRect::Make(tiles[i].makeOffset(-bounds.fLeft, -bounds.fTop)));
+        images[i]->draw(canvas, SkIntToScalar(offsets[i].fX - bounds.fLeft),
+                        SkIntToScalar(offsets[i].fY - bounds.fTop), &paint);
+        canvas->restore();
+    }
+
+    *offset = SkIPoint::Make(bounds.fLeft, bounds.fTop);
+    return surf->makeImageSnapshot();
+}
+
 void SkImageFilter::PurgeCache() {
     SkImageFilterCache::Get()->purge();
 }
@@ -10,6 +10,10 @@
 
 #include "SkImageFilter.h"
 
+#include <atomic>
+
+class SkExecutor;
+
 /**
  *  Helper to unflatten the common data, and return nullptr if we fail.
  */
@@ -21,4 +25,19 @@
         }                                                           \
     } while (0)
 
+/**
+ *  If set, raster devices evaluate image filters with this executor in their Context.
+ */
+extern std::atomic<SkExecutor*> gSkImageFilterExecutor;
+
+/**
+ *  Like filter->filterImage(), but when the context has an executor and the source is raster,
+ *  this may split the clip bounds into tiles and filter them in parallel. Each tile is filtered
+ *  with its own clip bounds, so that the DAG only produces the input region that tile needs, and
+ *  the tiles are then stitched into one image. Tiling is skipped when those input regions
+ *  overlap too much, as they do for large blurs.
+ */
+sk_sp<SkSpecialImage> SkFilterImageInTiles(const SkImageFilter*, SkSpecialImage* src,
+                                           const SkImageFilter::Context&, SkIPoint* offset);
+
 #endif
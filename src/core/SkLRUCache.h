@@ -69,6 +69,16 @@ public:
         return fMap.count();
     }
 
+    void remove(const K& key) {
+        Entry** value = fMap.find(key);
+        SkASSERT(value);
+        Entry* entry = *value;
+        SkASSERT(key == entry->fKey);
+        fMap.remove(key);
+        fLRU.remove(entry);
+        delete entry;
+    }
+
     template <typename Fn>  // f(V*)
     void foreach(Fn&& fn) {
         typename SkTInternalLList<Entry>::Iter iter;
@@ -97,16 +107,6 @@ private:
         }
     };
 
-    void remove(const K& key) {
-        Entry** value = fMap.find(key);
-        SkASSERT(value);
-        Entry* entry = *value;
-        SkASSERT(key == entry->fKey);
-        fMap.remove(key);
-        fLRU.remove(entry);
-        delete entry;
-    }
-
     int                             fMaxCount;
     SkTHashTable<Entry*, K, Traits> fMap;
     SkTInternalLList<Entry>         fLRU;
@@ -473,6 +473,7 @@ void* SkLiteDL::push(size_t pod, Args&&... args) {
     }
     SkASSERT(fUsed + skip <= fReserved);
     auto op = (T*)(fBytes.get() + fUsed);
+    fLastOp = fUsed;
     fUsed += skip;
     new (op) T{ std::forward<Args>(args)... };
     op->type = (uint32_t)T::kType;
@@ -636,6 +637,12 @@ void SkLiteDL::drawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) {
     this->push<DrawShadowRec>(0, path, rec);
 }
 
+void SkLiteDL::setLastOpBounds(const SkRect& bounds) {
+    SkASSERT(fUsed > 0);
+    SkASSERT(fBounds.isEmpty() || fBounds.top().offset < fLastOp);
+    fBounds.push_back({fLastOp, bounds});
+}
+
 typedef void(*draw_fn)(const void*,  SkCanvas*, const SkMatrix&);
 typedef void(*void_fn)(const void*);
 
@@ -656,7 +663,29 @@ static const void_fn dtor_fns[] = { TYPES(M) };
 
 void SkLiteDL::draw(SkCanvas* canvas) const {
     SkAutoCanvasRestore acr(canvas, false);
-    this->map(draw_fns, canvas, canvas->getTotalMatrix());
+    const SkMatrix original = canvas->getTotalMatrix();
+    if (fBounds.isEmpty()) {
+        this->map(draw_fns, canvas, original);
+        return;
+    }
+
+    // Clips recorded in the display list only shrink this, so it's safe to test against.
+    const SkRect clip = canvas->getLocalClipBounds();
+
+    const OpBounds* next = fBounds.begin();
+    const uint8_t* start = fBytes.get();
+    for (const uint8_t* ptr = start; ptr < start + fUsed; ) {
+        auto op = (const Op*)ptr;
+        bool visible = true;
+        if (next != fBounds.end() && next->offset == (size_t)(ptr - start)) {
+            visible = next->bounds.intersects(clip);
+            next++;
+        }
+        if (visible) {
+            draw_fns[op->type](op, canvas, original);
+        }
+        ptr += op->skip;
+    }
 }
 
 SkLiteDL::~SkLiteDL() {
@@ -668,4 +697,6 @@ void SkLiteDL::reset() {
 
     // Leave fBytes and fReserved alone.
     fUsed   = 0;
+    fLastOp = 0;
+    fBounds.rewind();
 }
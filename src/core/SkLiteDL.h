@@ -20,6 +20,9 @@ class SkLiteDL final {
 public:
     ~SkLiteDL();
 
+    // Skips ops given bounds with setLastOpBounds() that fall outside the canvas' clip.
+    // draw() doesn't modify the SkLiteDL, so it may be called on several threads at once,
+    // each with its own canvas, as long as the ops' objects (e.g. drawables) allow that too.
     void draw(SkCanvas* canvas) const;
 
     void reset();
@@ -76,6 +79,10 @@ public:
                    SkBlendMode, const SkRect*, const SkPaint*);
     void drawShadowRec(const SkPath&, const SkDrawShadowRec&);
 
+    // Promises that the last op recorded draws only inside these bounds, in the space of the
+    // canvas passed to draw().  Ops without bounds are always drawn.
+    void setLastOpBounds(const SkRect&);
+
 private:
     template <typename T, typename... Args>
     void* push(size_t, Args&&...);
@@ -83,9 +90,16 @@ private:
     template <typename Fn, typename... Args>
     void map(const Fn[], Args...) const;
 
+    struct OpBounds {
+        size_t offset;  // Of the op in fBytes.
+        SkRect bounds;
+    };
+
     SkAutoTMalloc<uint8_t> fBytes;
     size_t                 fUsed = 0;
     size_t                 fReserved = 0;
+    size_t                 fLastOp = 0;
+    SkTDArray<OpBounds>    fBounds;  // Sorted by offset.
 };
 
 #endif//SkLiteDL_DEFINED
@@ -5,9 +5,14 @@
  * found in the LICENSE file.
  */
 
+#include "SkClipOpPriv.h"
 #include "SkLiteDL.h"
 #include "SkLiteRecorder.h"
+#include "SkPicture.h"
+#include "SkRegion.h"
 #include "SkSurface.h"
+#include "SkTextBlob.h"
+#include "SkVertices.h"
 
 SkLiteRecorder::SkLiteRecorder()
     : INHERITED(1, 1)
@@ -16,6 +21,29 @@ SkLiteRecorder::SkLiteRecorder()
 void SkLiteRecorder::reset(SkLiteDL* dl, const SkIRect& bounds) {
     this->resetCanvas(bounds.right(), bounds.bottom());
     fDL = dl;
+    fUnbounded = false;
+    fSaveUnbounded.rewind();
+}
+
+void SkLiteRecorder::bound(const SkRect& local, const SkPaint* paint) {
+    const SkMatrix& ctm = this->getTotalMatrix();
+    if (fUnbounded || ctm.hasPerspective()) {
+        return;
+    }
+    SkRect bounds = local;
+    if (paint) {
+        if (!paint->canComputeFastBounds()) {
+            return;
+        }
+        SkRect storage;
+        bounds = paint->computeFastBounds(local, &storage);
+    }
+    bounds = ctm.mapRect(bounds);
+    // Leave room for hairlines and anti-aliasing.
+    bounds.outset(1, 1);
+    if (bounds.isFinite()) {
+        fDL->setLastOpBounds(bounds);
+    }
 }
 
 sk_sp<SkSurface> SkLiteRecorder::onNewSurface(const SkImageInfo&, const SkSurfaceProps&) {
@@ -24,17 +52,38 @@ sk_sp<SkSurface> SkLiteRecorder::onNewSurface(const SkImageInfo&, const SkSurfac
 
 void SkLiteRecorder::onFlush() { fDL->flush(); }
 
-void SkLiteRecorder::willSave() { fDL->save(); }
+void SkLiteRecorder::willSave() {
+    fSaveUnbounded.push_back(fUnbounded);
+    fDL->save();
+}
 SkCanvas::SaveLayerStrategy SkLiteRecorder::getSaveLayerStrategy(const SaveLayerRec& rec) {
+    fSaveUnbounded.push_back(fUnbounded);
+    if (rec.fPaint && rec.fPaint->getImageFilter()) {
+        fUnbounded = true;
+    }
     fDL->saveLayer(rec.fBounds, rec.fPaint, rec.fBackdrop, rec.fClipMask, rec.fClipMatrix,
                    rec.fSaveLayerFlags);
     return SkCanvas::kNoLayer_SaveLayerStrategy;
 }
 bool SkLiteRecorder::onDoSaveBehind(const SkRect* subset) {
+    fSaveUnbounded.push_back(fUnbounded);
     fDL->saveBehind(subset);
     return false;
 }
-void SkLiteRecorder::willRestore() { fDL->restore(); }
+void SkLiteRecorder::willRestore() {
+    if (!fSaveUnbounded.isEmpty()) {
+        fSaveUnbounded.pop(&fUnbounded);
+    }
+    fDL->restore();
+}
+
+void SkLiteRecorder::didClip(SkClipOp op) {
+    // Expanding clips can reach past the clip draw() starts with, so nothing up to the matching
+    // restore can be culled against it.
+    if (op != kIntersect_SkClipOp && op != kDifference_SkClipOp) {
+        fUnbounded = true;
+    }
+}
 
 void SkLiteRecorder::didConcat   (const SkMatrix& matrix)   { fDL->   concat(matrix); }
 void SkLiteRecorder::didSetMatrix(const SkMatrix& matrix)   { fDL->setMatrix(matrix); }
@@ -42,18 +91,22 @@ void SkLiteRecorder::didTranslate(SkScalar dx, SkScalar dy) { fDL->translate(dx,
 
 void SkLiteRecorder::onClipRect(const SkRect& rect, SkClipOp op, ClipEdgeStyle style) {
     fDL->clipRect(rect, op, style==kSoft_ClipEdgeStyle);
+    this->didClip(op);
     this->INHERITED::onClipRect(rect, op, style);
 }
 void SkLiteRecorder::onClipRRect(const SkRRect& rrect, SkClipOp op, ClipEdgeStyle style) {
     fDL->clipRRect(rrect, op, style==kSoft_ClipEdgeStyle);
+    this->didClip(op);
     this->INHERITED::onClipRRect(rrect, op, style);
 }
 void SkLiteRecorder::onClipPath(const SkPath& path, SkClipOp op, ClipEdgeStyle style) {
     fDL->clipPath(path, op, style==kSoft_ClipEdgeStyle);
+    this->didClip(op);
     this->INHERITED::onClipPath(path, op, style);
 }
 void SkLiteRecorder::onClipRegion(const SkRegion& region, SkClipOp op) {
     fDL->clipRegion(region, op);
+    this->didClip(op);
     this->INHERITED::onClipRegion(region, op);
 }
 
@@ -62,29 +115,39 @@ void SkLiteRecorder::onDrawPaint(const SkPaint& paint) {
 }
 void SkLiteRecorder::onDrawPath(const SkPath& path, const SkPaint& paint) {
     fDL->drawPath(path, paint);
+    if (!path.isInverseFillType()) {
+        this->bound(path.getBounds(), &paint);
+    }
 }
 void SkLiteRecorder::onDrawRect(const SkRect& rect, const SkPaint& paint) {
     fDL->drawRect(rect, paint);
+    this->bound(rect, &paint);
 }
 void SkLiteRecorder::onDrawEdgeAARect(const SkRect& rect, SkCanvas::QuadAAFlags aa, SkColor color,
                                       SkBlendMode mode) {
     fDL->drawEdgeAARect(rect, aa, color, mode);
+    this->bound(rect, nullptr);
 }
 void SkLiteRecorder::onDrawRegion(const SkRegion& region, const SkPaint& paint) {
     fDL->drawRegion(region, paint);
+    this->bound(SkRect::Make(region.getBounds()), &paint);
 }
 void SkLiteRecorder::onDrawOval(const SkRect& oval, const SkPaint& paint) {
     fDL->drawOval(oval, paint);
+    this->bound(oval, &paint);
 }
 void SkLiteRecorder::onDrawArc(const SkRect& oval, SkScalar startAngle, SkScalar sweepAngle,
                                bool useCenter, const SkPaint& paint) {
     fDL->drawArc(oval, startAngle, sweepAngle, useCenter, paint);
+    this->bound(oval, &paint);
 }
 void SkLiteRecorder::onDrawRRect(const SkRRect& rrect, const SkPaint& paint) {
     fDL->drawRRect(rrect, paint);
+    this->bound(rrect.getBounds(), &paint);
 }
 void SkLiteRecorder::onDrawDRRect(const SkRRect& out, const SkRRect& in, const SkPaint& paint) {
     fDL->drawDRRect(out, in, paint);
+    this->bound(out.getBounds(), &paint);
 }
 
 void SkLiteRecorder::onDrawDrawable(SkDrawable* drawable, const SkMatrix* matrix) {
@@ -94,6 +157,11 @@ void SkLiteRecorder::onDrawPicture(const SkPicture* picture,
                                    const SkMatrix* matrix,
                                    const SkPaint* paint) {
     fDL->drawPicture(picture, matrix, paint);
+    SkRect cull = picture->cullRect();
+    if (matrix) {
+        cull = matrix->mapRect(cull);
+    }
+    this->bound(cull, paint);
 }
 void SkLiteRecorder::onDrawAnnotation(const SkRect& rect, const char key[], SkData* val) {
     fDL->drawAnnotation(rect, key, val);
@@ -103,69 +171,97 @@ void SkLiteRecorder::onDrawTextBlob(const SkTextBlob* blob,
                                     SkScalar x, SkScalar y,
                                     const SkPaint& paint) {
     fDL->drawTextBlob(blob, x,y, paint);
+    this->bound(blob->bounds().makeOffset(x,y), &paint);
 }
 
 void SkLiteRecorder::onDrawBitmap(const SkBitmap& bm,
                                   SkScalar x, SkScalar y,
                                   const SkPaint* paint) {
     fDL->drawImage(SkImage::MakeFromBitmap(bm), x,y, paint);
+    this->bound(SkRect::MakeXYWH(x,y, bm.width(), bm.height()), paint);
 }
 void SkLiteRecorder::onDrawBitmapNine(const SkBitmap& bm,
                                       const SkIRect& center, const SkRect& dst,
                                       const SkPaint* paint) {
     fDL->drawImageNine(SkImage::MakeFromBitmap(bm), center, dst, paint);
+    this->bound(dst, paint);
 }
 void SkLiteRecorder::onDrawBitmapRect(const SkBitmap& bm,
                                       const SkRect* src, const SkRect& dst,
                                       const SkPaint* paint, SrcRectConstraint constraint) {
     fDL->drawImageRect(SkImage::MakeFromBitmap(bm), src, dst, paint, constraint);
+    this->bound(dst, paint);
 }
 void SkLiteRecorder::onDrawBitmapLattice(const SkBitmap& bm,
                                          const SkCanvas::Lattice& lattice, const SkRect& dst,
                                          const SkPaint* paint) {
     fDL->drawImageLattice(SkImage::MakeFromBitmap(bm), lattice, dst, paint);
+    this->bound(dst, paint);
 }
 
 void SkLiteRecorder::onDrawImage(const SkImage* img,
                                   SkScalar x, SkScalar y,
                                   const SkPaint* paint) {
     fDL->drawImage(sk_ref_sp(img), x,y, paint);
+    this->bound(SkRect::MakeXYWH(x,y, img->width(), img->height()), paint);
 }
 void SkLiteRecorder::onDrawImageNine(const SkImage* img,
                                       const SkIRect& center, const SkRect& dst,
                                       const SkPaint* paint) {
     fDL->drawImageNine(sk_ref_sp(img), center, dst, paint);
+    this->bound(dst, paint);
 }
 void SkLiteRecorder::onDrawImageRect(const SkImage* img,
                                       const SkRect* src, const SkRect& dst,
                                       const SkPaint* paint, SrcRectConstraint constraint) {
     fDL->drawImageRect(sk_ref_sp(img), src, dst, paint, constraint);
+    this->bound(dst, paint);
 }
 void SkLiteRecorder::onDrawImageLattice(const SkImage* img,
                                         const SkCanvas::Lattice& lattice, const SkRect& dst,
                                         const SkPaint* paint) {
     fDL->drawImageLattice(sk_ref_sp(img), lattice, dst, paint);
+    this->bound(dst, paint);
 }
 
 void SkLiteRecorder::onDrawImageSet(const ImageSetEntry set[], int count,
                                     SkFilterQuality filterQuality, SkBlendMode mode) {
     fDL->drawImageSet(set, count, filterQuality, mode);
+    SkRect bounds = SkRect::MakeEmpty();
+    for (int i = 0; i < count; ++i) {
+        bounds.join(set[i].fDstRect);
+    }
+    this->bound(bounds, nullptr);
 }
 
 void SkLiteRecorder::onDrawPatch(const SkPoint cubics[12],
                                  const SkColor colors[4], const SkPoint texCoords[4],
                                  SkBlendMode bmode, const SkPaint& paint) {
     fDL->drawPatch(cubics, colors, texCoords, bmode, paint);
+    SkRect bounds;
+    bounds.setBounds(cubics, 12);
+    this->bound(bounds, &paint);
 }
 void SkLiteRecorder::onDrawPoints(SkCanvas::PointMode mode,
                                   size_t count, const SkPoint pts[],
                                   const SkPaint& paint) {
     fDL->drawPoints(mode, count, pts, paint);
+    if (count > 0) {
+        SkRect bounds;
+        bounds.setBounds(pts, SkToInt(count));
+        SkRect storage;
+        if (paint.canComputeFastBounds()) {
+            this->bound(paint.computeFastStrokeBounds(bounds, &storage), nullptr);
+        }
+    }
 }
 void SkLiteRecorder::onDrawVerticesObject(const SkVertices* vertices,
                                           const SkVertices::Bone bones[], int boneCount,
                                           SkBlendMode mode, const SkPaint& paint) {
     fDL->drawVertices(vertices, bones, boneCount, mode, paint);
+    if (boneCount == 0) {
+        this->bound(vertices->bounds(), &paint);
+    }
 }
 void SkLiteRecorder::onDrawAtlas(const SkImage* atlas,
                                  const SkRSXform xforms[],
@@ -176,6 +272,9 @@ void SkLiteRecorder::onDrawAtlas(const SkImage* atlas,
                                  const SkRect* cull,
                                  const SkPaint* paint) {
     fDL->drawAtlas(atlas, xforms, texs, colors, count, bmode, cull, paint);
+    if (cull) {
+        this->bound(*cull, paint);
+    }
 }
 void SkLiteRecorder::onDrawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) {
     fDL->drawShadowRec(path, rec);
@@ -10,6 +10,7 @@
 
 #include "SkCanvasVirtualEnforcer.h"
 #include "SkNoDrawCanvas.h"
+#include "SkTDArray.h"
 
 class SkLiteDL;
 
@@ -78,7 +79,13 @@ public:
 private:
     typedef SkCanvasVirtualEnforcer<SkNoDrawCanvas> INHERITED;
 
-    SkLiteDL* fDL;
+    // Gives the op just recorded the device bounds of 'local' drawn with 'paint', when we can.
+    void bound(const SkRect& local, const SkPaint* paint);
+    void didClip(SkClipOp);
+
+    SkLiteDL*       fDL;
+    bool            fUnbounded = false;  // Under an image filter layer or an expanding clip.
+    SkTDArray<bool> fSaveUnbounded;      // fUnbounded for each open save.
 };
 
 #endif//SkLiteRecorder_DEFINED
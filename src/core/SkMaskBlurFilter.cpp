@@ -12,6 +12,8 @@
 #include "SkGaussFilter.h"
 #include "SkMalloc.h"
 #include "SkNx.h"
+#include "SkOpts.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkTo.h"
 
@@ -27,6 +29,7 @@ public:
         auto possibleWindow = static_cast<int>(floor(sigma * 3 * sqrt(2 * kPi) / 4 + 0.5));
         auto window = std::max(1, possibleWindow);
 
+        fWindow = window;
         fPass0Size = window - 1;
         fPass1Size = window - 1;
         fPass2Size = (window & 1) == 1 ? window - 1 : window;
@@ -89,6 +92,18 @@ public:
 
     int    border()     const { return fBorder; }
 
+    // The eight row kernel needs at least one value in each buffer, and a 32-bit weight.
+    bool canBlur8Rows() const { return fWindow > 1; }
+
+    // Blurs eight A8 rows, srcRowBytes apart, into dst exactly like Scan::blur does one row.
+    // buffer must hold 8 * bufferSize() values.
+    void blur8Rows(const uint8_t* src, size_t srcRowBytes, int srcWidth,
+                   uint8_t* dst, size_t dstStride, int dstWidth, uint32_t* buffer) const {
+        SkASSERT(this->canBlur8Rows());
+        SkOpts::box_blur_8_rows(src, srcRowBytes, srcWidth, dst, dstStride, dstWidth,
+                                fWindow, SkTo<uint32_t>(fWeight), buffer);
+    }
+
 public:
     class Scan {
     public:
@@ -227,6 +242,7 @@ public:
     }
 
     uint64_t fWeight;
+    int      fWindow;
     int      fBorder;
     int      fSlidingWindow;
     int      fPass0Size;
@@ -949,6 +965,198 @@ static SkIPoint small_blur(double sigmaX, double sigmaY, const SkMask& src, SkMa
     return {radiusX, radiusY};
 }
 
+std::atomic<SkExecutor*> gSkMaskBlurExecutor{nullptr};
+
+// Passes over fewer values than this run serially; splitting them up costs more than it saves.
+static constexpr int kMinParallelBlurArea = 256 * 256;
+
+// Each task blurs this many rows. It is a multiple of eight so only the last band of a pass can
+// have rows left over for the scalar scan.
+static constexpr int kBlurRowsPerTask = 64;
+
+// Blurs with a larger sigma than this are run on a mask scaled down by a power of two, and scaled
+// back up afterwards, as SkGpuBlurUtils does. Such a blur leaves no detail for the lower
+// resolution to lose.
+static constexpr double kMaxFullResolutionSigma = 64.0;
+
+// Calls blurRows(rowBegin, rowEnd, buffer) to cover the rows [0, rowCount) of a pass, with a
+// buffer of bufferSize values. When there is an executor and the pass is large, bands of rows run
+// on it in parallel, each with a buffer of its own.
+template <typename BlurRows>
+static void blur_row_bands(int rowCount, int rowWidth, size_t bufferSize, BlurRows&& blurRows) {
+    SkExecutor* executor = gSkMaskBlurExecutor.load(std::memory_order_relaxed);
+    int bandCount = (rowCount + kBlurRowsPerTask - 1) / kBlurRowsPerTask;
+    if (!executor || bandCount < 2 || (int64_t)rowCount * rowWidth < kMinParallelBlurArea) {
+        SkAutoTMalloc<uint32_t> buffer(bufferSize);
+        blurRows(0, rowCount, buffer.get());
+        return;
+    }
+
+    SkTaskGroup tasks(*executor);
+    tasks.batch(bandCount, [&](int band) {
+        SkAutoTMalloc<uint32_t> buffer(bufferSize);
+        int rowBegin = band * kBlurRowsPerTask;
+        blurRows(rowBegin, std::min(rowCount, rowBegin + kBlurRowsPerTask), buffer.get());
+    });
+    tasks.wait();
+}
+
+// Blurs the rows [rowBegin, rowEnd) of an A8 image and transposes them: value x of row y lands in
+// dst[x * dstStride + y]. Groups of eight rows go through the SIMD kernel, and the rest through
+// the scalar scan.
+static void blur_a8_rows(const PlanGauss& plan,
+                         const uint8_t* src, size_t srcRowBytes, int srcWidth,
+                         int rowBegin, int rowEnd,
+                         uint8_t* dst, size_t dstStride, int dstWidth,
+                         uint32_t* buffer) {
+    int y = rowBegin;
+    if (plan.canBlur8Rows()) {
+        for (; y + 8 <= rowEnd; y += 8) {
+            plan.blur8Rows(src + y * srcRowBytes, srcRowBytes, srcWidth,
+                           dst + y, dstStride, dstWidth, buffer);
+        }
+    }
+
+    const PlanGauss::Scan& scan = plan.makeBlurScan(srcWidth, buffer);
+    for (; y < rowEnd; ++y) {
+        const uint8_t* row = src + y * srcRowBytes;
+        uint8_t* dstStart = dst + y;
+        scan.blur(row, row + srcWidth, dstStart, SkToInt(dstStride), dstStart + dstWidth * dstStride);
+    }
+}
+
+// Converts row y of a mask to A8.
+static void row_to_a8(const SkMask& src, int y, uint8_t* a8) {
+    const uint8_t* row = src.fImage + y * src.fRowBytes;
+    const int width = src.fBounds.width();
+    switch (src.fFormat) {
+        case SkMask::kBW_Format: {
+            auto alpha = SkMask::AlphaIter<SkMask::kBW_Format>(row, 0);
+            for (int x = 0; x < width; ++x, ++alpha) {
+                a8[x] = *alpha;
+            }
+        } break;
+        case SkMask::kA8_Format:
+            memcpy(a8, row, width);
+            break;
+        case SkMask::kARGB32_Format: {
+            auto alpha = SkMask::AlphaIter<SkMask::kARGB32_Format>(
+                    reinterpret_cast<const uint32_t*>(row));
+            for (int x = 0; x < width; ++x, ++alpha) {
+                a8[x] = *alpha;
+            }
+        } break;
+        case SkMask::kLCD16_Format: {
+            auto alpha = SkMask::AlphaIter<SkMask::kLCD16_Format>(
+                    reinterpret_cast<const uint16_t*>(row));
+            for (int x = 0; x < width; ++x, ++alpha) {
+                a8[x] = *alpha;
+            }
+        } break;
+        default:
+            SK_ABORT("Unhandled format.");
+    }
+}
+
+// Averages each scale x scale block of src into one pixel of the A8 mask small. Blocks hanging
+// off the right or bottom of src count the missing pixels as zero.
+static void downsample(const SkMask& src, int scale, SkMask* small) {
+    const int srcW = src.fBounds.width(),
+              srcH = src.fBounds.height(),
+              smallW = small->fBounds.width(),
+              smallH = small->fBounds.height();
+    const uint32_t area = scale * scale;
+
+    SkAutoTMalloc<uint8_t> a8(srcW);
+    SkAutoTMalloc<uint32_t> sums(smallW);
+    for (int sy = 0; sy < smallH; ++sy) {
+        sk_bzero(sums.get(), smallW * sizeof(uint32_t));
+        for (int y = sy * scale; y < std::min(srcH, (sy + 1) * scale); ++y) {
+            row_to_a8(src, y, a8.get());
+            for (int x = 0; x < srcW; ++x) {
+                sums[x / scale] += a8[x];
+            }
+        }
+        uint8_t* smallRow = small->fImage + sy * small->fRowBytes;
+        for (int sx = 0; sx < smallW; ++sx) {
+            smallRow[sx] = SkTo<uint8_t>((sums[sx] + area / 2) / area);
+        }
+    }
+}
+
+// Scales the blurred small mask up by scale into dst with bilinear filtering. dst's border is
+// scale times small's, so the pixels of small sit at the centers of scale x scale blocks of dst.
+static void upsample(const SkMask& small, int scale, SkMask* dst) {
+    const int smallW = small.fBounds.width(),
+              smallH = small.fBounds.height(),
+              dstW = dst->fBounds.width(),
+              dstH = dst->fBounds.height();
+
+    auto sample = [&](int sx, int sy) -> int {
+        return 0 <= sx && sx < smallW && 0 <= sy && sy < smallH
+               ? small.fImage[sy * small.fRowBytes + sx] : 0;
+    };
+
+    // dst pixel x sits at (x + 0.5) / scale - 0.5 in small, or 2x + 1 - scale in units of
+    // 1 / (2 * scale). We add one whole pixel to keep it positive while splitting it up.
+    const int denom = 2 * scale;
+    auto split = [&](int x, int* whole, int* fraction) {
+        int position = 2 * x + 1 - scale + denom;
+        *whole = position / denom - 1;
+        *fraction = position % denom;
+    };
+
+    for (int y = 0; y < dstH; ++y) {
+        int sy, fy;
+        split(y, &sy, &fy);
+        uint8_t* dstRow = dst->fImage + y * dst->fRowBytes;
+        for (int x = 0; x < dstW; ++x) {
+            int sx, fx;
+            split(x, &sx, &fx);
+            int top    = sample(sx, sy    ) * (denom - fx) + sample(sx + 1, sy    ) * fx,
+                bottom = sample(sx, sy + 1) * (denom - fx) + sample(sx + 1, sy + 1) * fx;
+            dstRow[x] = SkTo<uint8_t>((top * (denom - fy) + bottom * fy + denom * denom / 2)
+                                      / (denom * denom));
+        }
+    }
+}
+
+// Blurs src scaled down by scale with the correspondingly smaller sigmas, and scales the result
+// back up into dst.
+static SkIPoint downsampled_blur(double sigmaW, double sigmaH, int scale,
+                                 const SkMask& src, SkMask* dst) {
+    SkMask small;
+    small.fBounds.set(0, 0, (src.fBounds.width()  + scale - 1) / scale,
+                            (src.fBounds.height() + scale - 1) / scale);
+    small.fRowBytes = small.fBounds.width();
+    small.fFormat = SkMask::kA8_Format;
+    small.fImage = nullptr;
+    if (src.fImage != nullptr) {
+        small.fImage = SkMask::AllocImage(small.computeImageSize());
+        downsample(src, scale, &small);
+    }
+    SkAutoMaskFreeImage autoFreeSmall(small.fImage);
+
+    SkMask smallDst;
+    SkIPoint smallBorder = SkMaskBlurFilter{sigmaW / scale, sigmaH / scale}.blur(small, &smallDst);
+    SkAutoMaskFreeImage autoFreeSmallDst(smallDst.fImage);
+
+    SkIPoint border = {smallBorder.fX * scale, smallBorder.fY * scale};
+    *dst = SkMask::PrepareDestination(border.fX, border.fY, src);
+    if (src.fImage == nullptr) {
+        return border;
+    }
+    if (dst->fImage == nullptr || smallDst.fImage == nullptr) {
+        SkMask::FreeImage(dst->fImage);
+        dst->fImage = nullptr;
+        dst->fBounds.setEmpty();
+        return {0, 0};
+    }
+
+    upsample(smallDst, scale, dst);
+    return border;
+}
+
 // TODO: assuming sigmaW = sigmaH. Allow different sigmas. Right now the
 // API forces the sigmas to be the same.
 SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
@@ -957,6 +1165,15 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
         return small_blur(fSigmaW, fSigmaH, src, dst);
     }
 
+    double maxSigma = std::max(fSigmaW, fSigmaH);
+    if (maxSigma > kMaxFullResolutionSigma) {
+        int scale = 2;
+        while (maxSigma / scale > kMaxFullResolutionSigma) {
+            scale *= 2;
+        }
+        return downsampled_blur(fSigmaW, fSigmaH, scale, src, dst);
+    }
+
     // 1024 is a place holder guess until more analysis can be done.
     SkSTArenaAlloc<1024> alloc;
 
@@ -982,8 +1199,8 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
         dstH = dst->fBounds.height();
     SkASSERT(srcW >= 0 && srcH >= 0 && dstW >= 0 && dstH >= 0);
 
-    auto bufferSize = std::max(planW.bufferSize(), planH.bufferSize());
-    auto buffer = alloc.makeArrayDefault<uint32_t>(bufferSize);
+    // Enough for the eight row kernel, which also leaves room for the scalar scan.
+    auto bufferSize = 8 * std::max(planW.bufferSize(), planH.bufferSize());
 
     // Blur both directions.
     int tmpW = srcH,
@@ -992,58 +1209,48 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
     auto tmp = alloc.makeArrayDefault<uint8_t>(tmpW * tmpH);
 
     // Blur horizontally, and transpose.
-    const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer);
-    switch (src.fFormat) {
-        case SkMask::kBW_Format: {
-            const uint8_t* bwStart = src.fImage;
-            auto start = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart, 0);
-            auto end = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart + (srcW / 8), srcW % 8);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kA8_Format: {
-            const uint8_t* a8Start = src.fImage;
-            auto start = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start);
-            auto end = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kARGB32_Format: {
-            const uint32_t* argbStart = reinterpret_cast<const uint32_t*>(src.fImage);
-            auto start = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart);
-            auto end = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kLCD16_Format: {
-            const uint16_t* lcdStart = reinterpret_cast<const uint16_t*>(src.fImage);
-            auto start = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart);
-            auto end = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
+    blur_row_bands(srcH, srcW, bufferSize, [&](int rowBegin, int rowEnd, uint32_t* buffer) {
+        if (src.fFormat == SkMask::kA8_Format) {
+            blur_a8_rows(planW, src.fImage, src.fRowBytes, srcW, rowBegin, rowEnd,
+                         tmp, tmpW, tmpH, buffer);
+            return;
+        }
+
+        const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer);
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            const uint8_t* row = src.fImage + y * src.fRowBytes;
+            auto tmpStart = &tmp[y];
+            auto tmpEnd = tmpStart + tmpW * tmpH;
+            switch (src.fFormat) {
+                case SkMask::kBW_Format: {
+                    auto start = SkMask::AlphaIter<SkMask::kBW_Format>(row, 0);
+                    auto end = SkMask::AlphaIter<SkMask::kBW_Format>(row + (srcW / 8), srcW % 8);
+                    scanW.blur(start, end, tmpStart, tmpW, tmpEnd);
+                } break;
+                case SkMask::kARGB32_Format: {
+                    const uint32_t* argbStart = reinterpret_cast<const uint32_t*>(row);
+                    auto start = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart);
+                    auto end = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart + srcW);
+                    scanW.blur(start, end, tmpStart, tmpW, tmpEnd);
+                } break;
+                case SkMask::kLCD16_Format: {
+                    const uint16_t* lcdStart = reinterpret_cast<const uint16_t*>(row);
+                    auto start = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart);
+                    auto end = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart + srcW);
+                    scanW.blur(start, end, tmpStart, tmpW, tmpEnd);
+                } break;
+                default:
+                    SK_ABORT("Unhandled format.");
             }
-        } break;
-        default:
-            SK_ABORT("Unhandled format.");
-    }
+        }
+    });
 
     // Blur vertically (scan in memory order because of the transposition),
     // and transpose back to the original orientation.
-    const PlanGauss::Scan& scanH = planH.makeBlurScan(tmpW, buffer);
-    for (int y = 0; y < tmpH; y++) {
-        auto tmpStart = &tmp[y * tmpW];
-        auto dstStart = &dst->fImage[y];
-
-        scanH.blur(tmpStart, tmpStart + tmpW,
-                   dstStart, dst->fRowBytes, dstStart + dst->fRowBytes * dstH);
-    }
+    blur_row_bands(tmpH, tmpW, bufferSize, [&](int rowBegin, int rowEnd, uint32_t* buffer) {
+        blur_a8_rows(planH, tmp, tmpW, tmpW, rowBegin, rowEnd,
+                     dst->fImage, dst->fRowBytes, dstH, buffer);
+    });
 
     return {SkTo<int32_t>(borderW), SkTo<int32_t>(borderH)};
 }
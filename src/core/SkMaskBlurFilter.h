@@ -9,12 +9,18 @@
 #define SkMaskBlurFilter_DEFINED
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <tuple>
 
 #include "SkMask.h"
 #include "SkTypes.h"
 
+class SkExecutor;
+
+// If set, large blurs split their passes into bands of rows that are blurred on this executor.
+extern std::atomic<SkExecutor*> gSkMaskBlurExecutor;
+
 // Implement a single channel Gaussian blur. The specifics for implementation are taken from:
 // https://drafts.fxtf.org/filters/#feGaussianBlurElement
 class SkMaskBlurFilter {
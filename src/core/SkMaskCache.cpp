@@ -183,3 +183,71 @@ void SkMaskCache::Add(SkScalar sigma, SkBlurStyle style,
     RectsBlurKey key(sigma, style, rects, count);
     return CHECK_LOCAL(localCache, add, Add, new RectsBlurRec(key, mask, data));
 }
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+static unsigned gBlurProfileKeyNamespaceLabel;
+
+struct BlurProfileKey : public SkResourceCache::Key {
+public:
+    BlurProfileKey(SkScalar sigma)
+        : fSigma(sigma)
+    {
+        this->init(&gBlurProfileKeyNamespaceLabel, 0, sizeof(fSigma));
+    }
+
+    SkScalar    fSigma;
+};
+
+struct BlurProfileRec : public SkResourceCache::Rec {
+    BlurProfileRec(BlurProfileKey key, SkCachedData* data)
+        : fKey(key)
+        , fData(data)
+    {
+        fData->attachToCacheAndRef();
+    }
+    ~BlurProfileRec() override {
+        fData->detachFromCacheAndUnref();
+    }
+
+    BlurProfileKey  fKey;
+    SkCachedData*   fData;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fData->size(); }
+    const char* getCategory() const override { return "blur-profile"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override {
+        return fData->diagnostic_only_getDiscardable();
+    }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const BlurProfileRec& rec = static_cast<const BlurProfileRec&>(baseRec);
+        SkCachedData** result = static_cast<SkCachedData**>(contextData);
+
+        SkCachedData* tmpData = rec.fData;
+        tmpData->ref();
+        if (nullptr == tmpData->data()) {
+            tmpData->unref();
+            return false;
+        }
+        *result = tmpData;
+        return true;
+    }
+};
+} // namespace
+
+SkCachedData* SkMaskCache::FindAndRefBlurProfile(SkScalar sigma, SkResourceCache* localCache) {
+    SkCachedData* result = nullptr;
+    BlurProfileKey key(sigma);
+    if (!CHECK_LOCAL(localCache, find, Find, key, BlurProfileRec::Visitor, &result)) {
+        return nullptr;
+    }
+    return result;
+}
+
+void SkMaskCache::AddBlurProfile(SkScalar sigma, SkCachedData* data,
+                                 SkResourceCache* localCache) {
+    BlurProfileKey key(sigma);
+    return CHECK_LOCAL(localCache, add, Add, new BlurProfileRec(key, data));
+}
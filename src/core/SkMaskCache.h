@@ -39,6 +39,15 @@ public:
     static void Add(SkScalar sigma, SkBlurStyle style,
                     const SkRect rects[], int count, const SkMask& mask, SkCachedData* data,
                     SkResourceCache* localCache = nullptr);
+
+    /**
+     * The 1D profiles made by SkBlurMask::ComputeBlurProfile, keyed by sigma. These are shared by
+     * the raster rect blur and the GPU's rect blur profile textures.
+     */
+    static SkCachedData* FindAndRefBlurProfile(SkScalar sigma,
+                                               SkResourceCache* localCache = nullptr);
+    static void AddBlurProfile(SkScalar sigma, SkCachedData* data,
+                               SkResourceCache* localCache = nullptr);
 };
 
 #endif
@@ -11,6 +11,7 @@
 #include "SkMathPriv.h"
 #include "SkMatrixPriv.h"
 #include "SkNx.h"
+#include "SkOpts.h"
 #include "SkPaint.h"
 #include "SkPoint3.h"
 #include "SkRSXform.h"
@@ -971,58 +972,12 @@ void SkMatrix::Scale_pts(const SkMatrix& m, SkPoint dst[], const SkPoint src[],
 void SkMatrix::Persp_pts(const SkMatrix& m, SkPoint dst[],
                          const SkPoint src[], int count) {
     SkASSERT(m.hasPerspective());
-
-    if (count > 0) {
-        do {
-            SkScalar sy = src->fY;
-            SkScalar sx = src->fX;
-            src += 1;
-
-            SkScalar x = sdot(sx, m.fMat[kMScaleX], sy, m.fMat[kMSkewX])  + m.fMat[kMTransX];
-            SkScalar y = sdot(sx, m.fMat[kMSkewY],  sy, m.fMat[kMScaleY]) + m.fMat[kMTransY];
-#ifdef SK_LEGACY_MATRIX_MATH_ORDER
-            SkScalar z = sx * m.fMat[kMPersp0] + (sy * m.fMat[kMPersp1] + m.fMat[kMPersp2]);
-#else
-            SkScalar z = sdot(sx, m.fMat[kMPersp0], sy, m.fMat[kMPersp1]) + m.fMat[kMPersp2];
-#endif
-            if (z) {
-                z = 1 / z;
-            }
-
-            dst->fY = y * z;
-            dst->fX = x * z;
-            dst += 1;
-        } while (--count);
-    }
+    SkOpts::matrix_map_persp(m.fMat, dst, src, count);
 }
 
 void SkMatrix::Affine_vpts(const SkMatrix& m, SkPoint dst[], const SkPoint src[], int count) {
     SkASSERT(m.getType() != SkMatrix::kPerspective_Mask);
-    if (count > 0) {
-        SkScalar tx = m.getTranslateX();
-        SkScalar ty = m.getTranslateY();
-        SkScalar sx = m.getScaleX();
-        SkScalar sy = m.getScaleY();
-        SkScalar kx = m.getSkewX();
-        SkScalar ky = m.getSkewY();
-        if (count & 1) {
-            dst->set(src->fX * sx + src->fY * kx + tx,
-                     src->fX * ky + src->fY * sy + ty);
-            src += 1;
-            dst += 1;
-        }
-        Sk4s trans4(tx, ty, tx, ty);
-        Sk4s scale4(sx, sy, sx, sy);
-        Sk4s  skew4(kx, ky, kx, ky);    // applied to swizzle of src4
-        count >>= 1;
-        for (int i = 0; i < count; ++i) {
-            Sk4s src4 = Sk4s::Load(src);
-            Sk4s swz4 = SkNx_shuffle<1,0,3,2>(src4);  // y0 x0, y1 x1
-            (src4 * scale4 + swz4 * skew4 + trans4).store(dst);
-            src += 2;
-            dst += 2;
-        }
-    }
+    SkOpts::matrix_map_affine(m.fMat, dst, src, count);
 }
 
 const SkMatrix::MapPtsProc SkMatrix::gMapPtsProcs[] = {
@@ -1153,6 +1108,37 @@ bool SkMatrix::mapRect(SkRect* dst, const SkRect& src) const {
     }
 }
 
+bool SkMatrix::mapRects(SkRect dst[], const SkRect src[], int count) const {
+    SkASSERT((dst && src && count > 0) || 0 == count);
+
+    if (this->isScaleTranslate()) {
+        Sk4f scale(fMat[kMScaleX], fMat[kMScaleY], fMat[kMScaleX], fMat[kMScaleY]),
+             trans(fMat[kMTransX], fMat[kMTransY], fMat[kMTransX], fMat[kMTransY]);
+        for (int i = 0; i < count; ++i) {
+            sort_as_rect(Sk4f::Load(&src[i].fLeft) * scale + trans).store(&dst[i].fLeft);
+        }
+        return true;
+    }
+
+    // Map the corners of several rects with one call, so the point procs get long runs.
+    constexpr int kRectsPerBatch = 8;
+    SkPoint quads[4 * kRectsPerBatch];
+    while (count > 0) {
+        int n = SkTMin(count, kRectsPerBatch);
+        for (int i = 0; i < n; ++i) {
+            src[i].toQuad(quads + 4*i);
+        }
+        this->mapPoints(quads, 4*n);
+        for (int i = 0; i < n; ++i) {
+            dst[i].setBoundsNoCheck(quads + 4*i, 4);
+        }
+        src   += n;
+        dst   += n;
+        count -= n;
+    }
+    return this->rectStaysRect();
+}
+
 SkScalar SkMatrix::mapRadius(SkScalar radius) const {
     SkVector    vec[2];
 
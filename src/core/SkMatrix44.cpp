@@ -6,6 +6,7 @@
  */
 
 #include "SkMatrix44.h"
+#include "SkNx.h"
 #include <utility>
 
 static inline bool eq4(const SkMScalar* SK_RESTRICT a,
@@ -404,6 +405,18 @@ void SkMatrix44::setConcat(const SkMatrix44& a, const SkMatrix44& b) {
         result[14] = a.fMat[2][2] * b.fMat[3][2] + a.fMat[3][2];
         result[15] = 1;
     } else {
+#ifdef SK_MSCALAR_IS_FLOAT
+        // fMat is column-major, so each column of the result is a's columns weighted by
+        // the matching column of b.
+        Sk4f c0 = Sk4f::Load(a.fMat[0]),
+             c1 = Sk4f::Load(a.fMat[1]),
+             c2 = Sk4f::Load(a.fMat[2]),
+             c3 = Sk4f::Load(a.fMat[3]);
+        for (int j = 0; j < 4; j++) {
+            (c0 * b.fMat[j][0] + c1 * b.fMat[j][1] +
+             c2 * b.fMat[j][2] + c3 * b.fMat[j][3]).store(result + 4*j);
+        }
+#else
         for (int j = 0; j < 4; j++) {
             for (int i = 0; i < 4; i++) {
                 double value = 0;
@@ -413,6 +426,7 @@ void SkMatrix44::setConcat(const SkMatrix44& a, const SkMatrix44& b) {
                 *result++ = SkDoubleToMScalar(value);
             }
         }
+#endif
     }
 
     if (useStorage) {
@@ -708,6 +722,30 @@ void SkMatrix44::transpose() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+#ifdef SK_MSCALAR_IS_FLOAT
+
+void SkMatrix44::mapScalars(const SkScalar src[4], SkScalar dst[4]) const {
+    // Reading all of src before storing makes src == dst safe.
+    (Sk4f::Load(fMat[0]) * src[0] + Sk4f::Load(fMat[1]) * src[1] +
+     Sk4f::Load(fMat[2]) * src[2] + Sk4f::Load(fMat[3]) * src[3]).store(dst);
+}
+
+void SkMatrix44::map4(const float src4[], int count, float dst4[]) const {
+    SkASSERT((src4 && dst4) || count == 0);
+
+    Sk4f c0 = Sk4f::Load(fMat[0]),
+         c1 = Sk4f::Load(fMat[1]),
+         c2 = Sk4f::Load(fMat[2]),
+         c3 = Sk4f::Load(fMat[3]);
+    for (int n = 0; n < count; ++n) {
+        (c0 * src4[0] + c1 * src4[1] + c2 * src4[2] + c3 * src4[3]).store(dst4);
+        src4 += 4;
+        dst4 += 4;
+    }
+}
+
+#else
+
 void SkMatrix44::mapScalars(const SkScalar src[4], SkScalar dst[4]) const {
     SkScalar storage[4];
     SkScalar* result = (src == dst) ? storage : dst;
@@ -725,6 +763,16 @@ void SkMatrix44::mapScalars(const SkScalar src[4], SkScalar dst[4]) const {
     }
 }
 
+void SkMatrix44::map4(const float src4[], int count, float dst4[]) const {
+    for (int n = 0; n < count; ++n) {
+        this->mapScalars(src4, dst4);
+        src4 += 4;
+        dst4 += 4;
+    }
+}
+
+#endif
+
 #ifdef SK_MSCALAR_IS_DOUBLE
 
 void SkMatrix44::mapMScalars(const SkMScalar src[4], SkMScalar dst[4]) const {
@@ -825,6 +873,35 @@ static void map2_sd(const SkMScalar mat[][4], const double* SK_RESTRICT src2,
     }
 }
 
+#ifdef SK_MSCALAR_IS_FLOAT
+
+static void map2_af(const SkMScalar mat[][4], const float* SK_RESTRICT src2,
+                    int count, float* SK_RESTRICT dst4) {
+    Sk4f c0 = Sk4f::Load(mat[0]),
+         c1 = Sk4f::Load(mat[1]),
+         c3 = Sk4f::Load(mat[3]);
+    for (int n = 0; n < count; ++n) {
+        (c0 * src2[0] + c1 * src2[1] + c3).store(dst4);
+        dst4[3] = 1;
+        src2 += 2;
+        dst4 += 4;
+    }
+}
+
+static void map2_pf(const SkMScalar mat[][4], const float* SK_RESTRICT src2,
+                    int count, float* SK_RESTRICT dst4) {
+    Sk4f c0 = Sk4f::Load(mat[0]),
+         c1 = Sk4f::Load(mat[1]),
+         c3 = Sk4f::Load(mat[3]);
+    for (int n = 0; n < count; ++n) {
+        (c0 * src2[0] + c1 * src2[1] + c3).store(dst4);
+        src2 += 2;
+        dst4 += 4;
+    }
+}
+
+#else
+
 static void map2_af(const SkMScalar mat[][4], const float* SK_RESTRICT src2,
                     int count, float* SK_RESTRICT dst4) {
     SkMScalar r;
@@ -843,20 +920,6 @@ static void map2_af(const SkMScalar mat[][4], const float* SK_RESTRICT src2,
     }
 }
 
-static void map2_ad(const SkMScalar mat[][4], const double* SK_RESTRICT src2,
-                    int count, double* SK_RESTRICT dst4) {
-    for (int n = 0; n < count; ++n) {
-        double sx = src2[0];
-        double sy = src2[1];
-        dst4[0] = mat[0][0] * sx + mat[1][0] * sy + mat[3][0];
-        dst4[1] = mat[0][1] * sx + mat[1][1] * sy + mat[3][1];
-        dst4[2] = mat[0][2] * sx + mat[1][2] * sy + mat[3][2];
-        dst4[3] = 1;
-        src2 += 2;
-        dst4 += 4;
-    }
-}
-
 static void map2_pf(const SkMScalar mat[][4], const float* SK_RESTRICT src2,
                     int count, float* SK_RESTRICT dst4) {
     SkMScalar r;
@@ -872,6 +935,22 @@ static void map2_pf(const SkMScalar mat[][4], const float* SK_RESTRICT src2,
     }
 }
 
+#endif
+
+static void map2_ad(const SkMScalar mat[][4], const double* SK_RESTRICT src2,
+                    int count, double* SK_RESTRICT dst4) {
+    for (int n = 0; n < count; ++n) {
+        double sx = src2[0];
+        double sy = src2[1];
+        dst4[0] = mat[0][0] * sx + mat[1][0] * sy + mat[3][0];
+        dst4[1] = mat[0][1] * sx + mat[1][1] * sy + mat[3][1];
+        dst4[2] = mat[0][2] * sx + mat[1][2] * sy + mat[3][2];
+        dst4[3] = 1;
+        src2 += 2;
+        dst4 += 4;
+    }
+}
+
 static void map2_pd(const SkMScalar mat[][4], const double* SK_RESTRICT src2,
                     int count, double* SK_RESTRICT dst4) {
     for (int n = 0; n < count; ++n) {
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkMeasuredPath.h"
+
+#include "SkPathPriv.h"
+#include "SkResourceCache.h"
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+namespace {
+static unsigned gMeasuredPathKeyNamespaceLabel;
+
+static uint64_t make_shared_id(uint32_t pathGenID) {
+    uint64_t sharedID = SkSetFourByteTag('p', 'm', 'e', 's');
+    return (sharedID << 32) | pathGenID;
+}
+
+struct MeasuredPathKey : public SkResourceCache::Key {
+    MeasuredPathKey(uint32_t genID, bool forceClosed, SkScalar resScale)
+        : fGenID(genID)
+        , fForceClosed(forceClosed)
+        , fResScale(resScale)
+    {
+        this->init(&gMeasuredPathKeyNamespaceLabel, make_shared_id(genID),
+                   sizeof(fGenID) + sizeof(fForceClosed) + sizeof(fResScale));
+    }
+
+    uint32_t fGenID;
+    uint32_t fForceClosed;
+    SkScalar fResScale;
+};
+
+struct MeasuredPathRec : public SkResourceCache::Rec {
+    MeasuredPathRec(const MeasuredPathKey& key, sk_sp<SkMeasuredPath> measure)
+        : fKey(key)
+        , fMeasure(std::move(measure)) {}
+
+    MeasuredPathKey        fKey;
+    sk_sp<SkMeasuredPath>  fMeasure;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fMeasure->bytesUsed(); }
+    const char* getCategory() const override { return "path-measure"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const MeasuredPathRec& rec = static_cast<const MeasuredPathRec&>(baseRec);
+        *static_cast<sk_sp<SkMeasuredPath>*>(contextData) = rec.fMeasure;
+        return true;
+    }
+};
+
+// Purges a path's measurements once it changes or is deleted.
+class MeasuredPathInvalidator : public SkPathRef::GenIDChangeListener {
+public:
+    explicit MeasuredPathInvalidator(uint32_t genID) : fGenID(genID) {}
+
+private:
+    void onChange() override { SkResourceCache::PostPurgeSharedID(make_shared_id(fGenID)); }
+
+    const uint32_t fGenID;
+};
+} // namespace
+
+SkMeasuredPath::SkMeasuredPath(const SkPath& path, bool forceClosed, SkScalar resScale) {
+    SkPathMeasure meas(path, forceClosed, resScale);
+    do {
+        Contour& contour = fContours.push_back();
+        contour.fLength = meas.getLength();
+        contour.fIsClosed = meas.isClosed();
+        contour.fSegments.swap(meas.fSegments);
+        fTotalLength += contour.fLength;
+    } while (meas.nextContour());
+    fPts.swap(meas.fPts);
+}
+
+sk_sp<SkMeasuredPath> SkMeasuredPath::Make(const SkPath& path, bool forceClosed, SkScalar resScale,
+                                           SkResourceCache* localCache) {
+    if (path.isVolatile()) {
+        return sk_sp<SkMeasuredPath>(new SkMeasuredPath(path, forceClosed, resScale));
+    }
+
+    const uint32_t genID = path.getGenerationID();
+    MeasuredPathKey key(genID, forceClosed, resScale);
+    sk_sp<SkMeasuredPath> measure;
+    if (CHECK_LOCAL(localCache, find, Find, key, MeasuredPathRec::Visitor, &measure)) {
+        return measure;
+    }
+
+    measure.reset(new SkMeasuredPath(path, forceClosed, resScale));
+    CHECK_LOCAL(localCache, add, Add, new MeasuredPathRec(key, measure));
+    SkPathPriv::AddGenIDChangeListener(path, sk_make_sp<MeasuredPathInvalidator>(genID));
+    return measure;
+}
+
+size_t SkMeasuredPath::bytesUsed() const {
+    size_t bytes = sizeof(*this) + fPts.reserved() * sizeof(SkPoint);
+    for (const Contour& contour : fContours) {
+        bytes += sizeof(Contour) + contour.fSegments.reserved() * sizeof(SkPathMeasure::Segment);
+    }
+    return bytes;
+}
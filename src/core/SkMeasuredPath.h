@@ -0,0 +1,86 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMeasuredPath_DEFINED
+#define SkMeasuredPath_DEFINED
+
+#include "SkPathMeasure.h"
+#include "SkRefCnt.h"
+#include "SkTArray.h"
+
+class SkResourceCache;
+
+/**
+ * The segment tables SkPathMeasure builds for every contour of a path, kept so they can be queried
+ * again without measuring the path again. Once made it is immutable, so it can be shared across
+ * threads, and Make() shares it through SkResourceCache between everyone measuring the same path.
+ *
+ * The contours are the ones SkPathMeasure visits with nextContour(), in the same order.
+ */
+class SkMeasuredPath : public SkNVRefCnt<SkMeasuredPath> {
+public:
+    /**
+     * Returns the measurement of path, made with SkPathMeasure's forceClosed and resScale. Unless
+     * the path is volatile, the result is found in (or added to) the cache by the path's
+     * generation ID, and removed again once the path changes or is deleted.
+     */
+    static sk_sp<SkMeasuredPath> Make(const SkPath& path, bool forceClosed, SkScalar resScale = 1,
+                                      SkResourceCache* localCache = nullptr);
+
+    int contourCount() const { return fContours.count(); }
+    SkScalar length(int contour) const { return fContours[contour].fLength; }
+    bool isClosed(int contour) const { return fContours[contour].fIsClosed; }
+
+    /** The sum of the lengths of every contour. */
+    SkScalar totalLength() const { return fTotalLength; }
+
+    /** As SkPathMeasure::getPosTan(), on the given contour. */
+    bool SK_WARN_UNUSED_RESULT getPosTan(int contour, SkScalar distance, SkPoint* position,
+                                         SkVector* tangent) const {
+        const Contour& c = fContours[contour];
+        return SkPathMeasure::GetPosTan(c.fSegments, fPts.begin(), c.fLength, distance, position,
+                                        tangent);
+    }
+
+    /**
+     * Computes the position and tangent at each of count distances along the contour; either
+     * output may be null. Distances are pinned to the contour as getPosTan() pins them, and NaN
+     * distances are treated as 0. Queries in increasing order are the cheapest. Returns false,
+     * and leaves the outputs unchanged, if the contour has zero length.
+     */
+    bool getPosTans(int contour, const SkScalar distances[], int count, SkPoint positions[],
+                    SkVector tangents[]) const {
+        const Contour& c = fContours[contour];
+        return SkPathMeasure::GetPosTans(c.fSegments, fPts.begin(), c.fLength, distances, count,
+                                         positions, tangents);
+    }
+
+    /** As SkPathMeasure::getSegment(), on the given contour. */
+    bool getSegment(int contour, SkScalar startD, SkScalar stopD, SkPath* dst,
+                    bool startWithMoveTo) const {
+        const Contour& c = fContours[contour];
+        return SkPathMeasure::GetSegment(c.fSegments, fPts.begin(), c.fLength, startD, stopD, dst,
+                                         startWithMoveTo);
+    }
+
+    size_t bytesUsed() const;
+
+private:
+    SkMeasuredPath(const SkPath&, bool forceClosed, SkScalar resScale);
+
+    struct Contour {
+        SkTDArray<SkPathMeasure::Segment> fSegments;
+        SkScalar fLength;
+        bool fIsClosed;
+    };
+
+    SkTArray<Contour> fContours;
+    SkTDArray<SkPoint> fPts;  // shared by every contour's segments
+    SkScalar fTotalLength = 0;
+};
+
+#endif
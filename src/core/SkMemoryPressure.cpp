@@ -0,0 +1,38 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkMemoryPressure.h"
+
+#include <atomic>
+
+// How many times each level has been signalled. Observers compare against their own copy, so a
+// signal is never lost even if several arrive between polls.
+static std::atomic<uint32_t> gSignals[(int)SkGraphics::MemoryPressureLevel::kCritical + 1];
+
+SkMemoryPressureObserver::SkMemoryPressureObserver() {
+    for (int i = 0; i < kLevelCount; ++i) {
+        fSeen[i] = gSignals[i].load(std::memory_order_relaxed);
+    }
+}
+
+SkMemoryPressureObserver::Level SkMemoryPressureObserver::poll() {
+    Level level = Level::kNone;
+    for (int i = 0; i < kLevelCount; ++i) {
+        uint32_t signals = gSignals[i].load(std::memory_order_relaxed);
+        if (signals != fSeen[i]) {
+            fSeen[i] = signals;
+            level = (Level)i;
+        }
+    }
+    return level;
+}
+
+void SkMemoryPressureObserver::Signal(Level level) {
+    if (level != Level::kNone) {
+        gSignals[(int)level].fetch_add(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMemoryPressure_DEFINED
+#define SkMemoryPressure_DEFINED
+
+#include "SkGraphics.h"
+
+/**
+ *  Lets an owner that is tied to one thread (e.g. a GrContext) find out about
+ *  SkGraphics::NotifyMemoryPressure() calls made on any thread, and trim its caches when it next
+ *  gets a chance.
+ */
+class SkMemoryPressureObserver {
+public:
+    using Level = SkGraphics::MemoryPressureLevel;
+
+    // Starts out caught up: pressure notified before construction is not reported.
+    SkMemoryPressureObserver();
+
+    // Returns the most severe level notified since the last poll(), or kNone.
+    Level poll();
+
+    // Called by SkGraphics::NotifyMemoryPressure().
+    static void Signal(Level);
+
+private:
+    static constexpr int kLevelCount = (int)Level::kCritical + 1;
+
+    uint32_t fSeen[kLevelCount];
+};
+
+#endif
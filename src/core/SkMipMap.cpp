@@ -13,6 +13,8 @@
 #include "SkImageInfoPriv.h"
 #include "SkMathPriv.h"
 #include "SkNx.h"
+#include "SkOpts.h"
+#include "SkTaskGroup.h"
 #include "SkTo.h"
 #include "SkTypes.h"
 #include <new>
@@ -311,17 +313,91 @@ size_t SkMipMap::AllocLevelsSize(int levelCount, size_t pixelSize) {
     return SkTo<int32_t>(size);
 }
 
-SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
-    typedef void FilterProc(void*, const void* srcPtr, size_t srcRB, int count);
+std::atomic<SkExecutor*> gSkMipMapExecutor{nullptr};
 
-    FilterProc* proc_1_2 = nullptr;
-    FilterProc* proc_1_3 = nullptr;
-    FilterProc* proc_2_1 = nullptr;
-    FilterProc* proc_2_2 = nullptr;
-    FilterProc* proc_2_3 = nullptr;
-    FilterProc* proc_3_1 = nullptr;
-    FilterProc* proc_3_2 = nullptr;
-    FilterProc* proc_3_3 = nullptr;
+// Levels with at least this many pixels are generated in bands of rows on gSkMipMapExecutor.
+static constexpr int kMinParallelLevelArea = 512 * 512;
+static constexpr int kLevelRowsPerTask = 64;
+
+void SkMipMap::Downsample(const Downsamplers& downsamplers, const SkPixmap& src,
+                          const SkPixmap& dst) {
+    const int width = src.width(),
+              height = src.height();
+
+    FilterProc* proc;
+    if (height & 1) {
+        if (height == 1) {        // src-height is 1
+            if (width & 1) {      // src-width is 3
+                proc = downsamplers.proc_3_1;
+            } else {              // src-width is 2
+                proc = downsamplers.proc_2_1;
+            }
+        } else {                  // src-height is 3
+            if (width & 1) {
+                if (width == 1) { // src-width is 1
+                    proc = downsamplers.proc_1_3;
+                } else {          // src-width is 3
+                    proc = downsamplers.proc_3_3;
+                }
+            } else {              // src-width is 2
+                proc = downsamplers.proc_2_3;
+            }
+        }
+    } else {                      // src-height is 2
+        if (width & 1) {
+            if (width == 1) {     // src-width is 1
+                proc = downsamplers.proc_1_2;
+            } else {              // src-width is 3
+                proc = downsamplers.proc_3_2;
+            }
+        } else {                  // src-width is 2
+            proc = downsamplers.proc_2_2;
+        }
+    }
+
+    const size_t srcRB = src.rowBytes();
+    auto downsampleRows = [&](int top, int bottom) {
+        const char* srcBasePtr = (const char*)src.addr() + top * srcRB * 2;
+        char* dstBasePtr = (char*)dst.writable_addr() + top * dst.rowBytes();
+        for (int y = top; y < bottom; y++) {
+            proc(dstBasePtr, srcBasePtr, srcRB, dst.width());
+            srcBasePtr += srcRB * 2; // jump two rows
+            dstBasePtr += dst.rowBytes();
+        }
+    };
+
+    SkExecutor* executor = gSkMipMapExecutor.load(std::memory_order_relaxed);
+    if (executor && (int64_t)dst.width() * dst.height() >= kMinParallelLevelArea) {
+        const int bands = (dst.height() + kLevelRowsPerTask - 1) / kLevelRowsPerTask;
+        SkTaskGroup(*executor).batch(bands, [&](int band) {
+            downsampleRows(band * kLevelRowsPerTask,
+                           SkTMin((band + 1) * kLevelRowsPerTask, dst.height()));
+        });
+    } else {
+        downsampleRows(0, dst.height());
+    }
+}
+
+bool SkMipMap::ensureLevels(int count) const {
+    SkASSERT(count <= fCount);
+    if (fBuiltCount.load(std::memory_order_acquire) >= count) {
+        return fLevels != nullptr;
+    }
+
+    SkAutoMutexAcquire lock(fBuildMutex);
+    if (nullptr == fLevels) {
+        return false;
+    }
+    // The first level is always built from the source by Build().
+    for (int i = SkTMax(1, fBuiltCount.load(std::memory_order_relaxed)); i < count; ++i) {
+        Downsample(fDownsamplers, fLevels[i - 1].fPixmap, fLevels[i].fPixmap);
+        fBuiltCount.store(i + 1, std::memory_order_release);
+    }
+    return true;
+}
+
+SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact, bool buildLazily) {
+    Downsamplers downsamplers;
 
     const SkColorType ct = src.colorType();
     const SkAlphaType at = src.alphaType();
@@ -329,55 +405,55 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
     switch (ct) {
         case kRGBA_8888_SkColorType:
         case kBGRA_8888_SkColorType:
-            proc_1_2 = downsample_1_2<ColorTypeFilter_8888>;
-            proc_1_3 = downsample_1_3<ColorTypeFilter_8888>;
-            proc_2_1 = downsample_2_1<ColorTypeFilter_8888>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8888>;
-            proc_2_3 = downsample_2_3<ColorTypeFilter_8888>;
-            proc_3_1 = downsample_3_1<ColorTypeFilter_8888>;
-            proc_3_2 = downsample_3_2<ColorTypeFilter_8888>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_8888>;
+            downsamplers.proc_1_2 = downsample_1_2<ColorTypeFilter_8888>;
+            downsamplers.proc_1_3 = downsample_1_3<ColorTypeFilter_8888>;
+            downsamplers.proc_2_1 = downsample_2_1<ColorTypeFilter_8888>;
+            downsamplers.proc_2_2 = SkOpts::downsample_2_2_8888;
+            downsamplers.proc_2_3 = downsample_2_3<ColorTypeFilter_8888>;
+            downsamplers.proc_3_1 = downsample_3_1<ColorTypeFilter_8888>;
+            downsamplers.proc_3_2 = downsample_3_2<ColorTypeFilter_8888>;
+            downsamplers.proc_3_3 = downsample_3_3<ColorTypeFilter_8888>;
             break;
         case kRGB_565_SkColorType:
-            proc_1_2 = downsample_1_2<ColorTypeFilter_565>;
-            proc_1_3 = downsample_1_3<ColorTypeFilter_565>;
-            proc_2_1 = downsample_2_1<ColorTypeFilter_565>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_565>;
-            proc_2_3 = downsample_2_3<ColorTypeFilter_565>;
-            proc_3_1 = downsample_3_1<ColorTypeFilter_565>;
-            proc_3_2 = downsample_3_2<ColorTypeFilter_565>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_565>;
+            downsamplers.proc_1_2 = downsample_1_2<ColorTypeFilter_565>;
+            downsamplers.proc_1_3 = downsample_1_3<ColorTypeFilter_565>;
+            downsamplers.proc_2_1 = downsample_2_1<ColorTypeFilter_565>;
+            downsamplers.proc_2_2 = downsample_2_2<ColorTypeFilter_565>;
+            downsamplers.proc_2_3 = downsample_2_3<ColorTypeFilter_565>;
+            downsamplers.proc_3_1 = downsample_3_1<ColorTypeFilter_565>;
+            downsamplers.proc_3_2 = downsample_3_2<ColorTypeFilter_565>;
+            downsamplers.proc_3_3 = downsample_3_3<ColorTypeFilter_565>;
             break;
         case kARGB_4444_SkColorType:
-            proc_1_2 = downsample_1_2<ColorTypeFilter_4444>;
-            proc_1_3 = downsample_1_3<ColorTypeFilter_4444>;
-            proc_2_1 = downsample_2_1<ColorTypeFilter_4444>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_4444>;
-            proc_2_3 = downsample_2_3<ColorTypeFilter_4444>;
-            proc_3_1 = downsample_3_1<ColorTypeFilter_4444>;
-            proc_3_2 = downsample_3_2<ColorTypeFilter_4444>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_4444>;
+            downsamplers.proc_1_2 = downsample_1_2<ColorTypeFilter_4444>;
+            downsamplers.proc_1_3 = downsample_1_3<ColorTypeFilter_4444>;
+            downsamplers.proc_2_1 = downsample_2_1<ColorTypeFilter_4444>;
+            downsamplers.proc_2_2 = downsample_2_2<ColorTypeFilter_4444>;
+            downsamplers.proc_2_3 = downsample_2_3<ColorTypeFilter_4444>;
+            downsamplers.proc_3_1 = downsample_3_1<ColorTypeFilter_4444>;
+            downsamplers.proc_3_2 = downsample_3_2<ColorTypeFilter_4444>;
+            downsamplers.proc_3_3 = downsample_3_3<ColorTypeFilter_4444>;
             break;
         case kAlpha_8_SkColorType:
         case kGray_8_SkColorType:
-            proc_1_2 = downsample_1_2<ColorTypeFilter_8>;
-            proc_1_3 = downsample_1_3<ColorTypeFilter_8>;
-            proc_2_1 = downsample_2_1<ColorTypeFilter_8>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8>;
-            proc_2_3 = downsample_2_3<ColorTypeFilter_8>;
-            proc_3_1 = downsample_3_1<ColorTypeFilter_8>;
-            proc_3_2 = downsample_3_2<ColorTypeFilter_8>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_8>;
+            downsamplers.proc_1_2 = downsample_1_2<ColorTypeFilter_8>;
+            downsamplers.proc_1_3 = downsample_1_3<ColorTypeFilter_8>;
+            downsamplers.proc_2_1 = downsample_2_1<ColorTypeFilter_8>;
+            downsamplers.proc_2_2 = downsample_2_2<ColorTypeFilter_8>;
+            downsamplers.proc_2_3 = downsample_2_3<ColorTypeFilter_8>;
+            downsamplers.proc_3_1 = downsample_3_1<ColorTypeFilter_8>;
+            downsamplers.proc_3_2 = downsample_3_2<ColorTypeFilter_8>;
+            downsamplers.proc_3_3 = downsample_3_3<ColorTypeFilter_8>;
             break;
         case kRGBA_F16_SkColorType:
-            proc_1_2 = downsample_1_2<ColorTypeFilter_F16>;
-            proc_1_3 = downsample_1_3<ColorTypeFilter_F16>;
-            proc_2_1 = downsample_2_1<ColorTypeFilter_F16>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_F16>;
-            proc_2_3 = downsample_2_3<ColorTypeFilter_F16>;
-            proc_3_1 = downsample_3_1<ColorTypeFilter_F16>;
-            proc_3_2 = downsample_3_2<ColorTypeFilter_F16>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_F16>;
+            downsamplers.proc_1_2 = downsample_1_2<ColorTypeFilter_F16>;
+            downsamplers.proc_1_3 = downsample_1_3<ColorTypeFilter_F16>;
+            downsamplers.proc_2_1 = downsample_2_1<ColorTypeFilter_F16>;
+            downsamplers.proc_2_2 = SkOpts::downsample_2_2_f16;
+            downsamplers.proc_2_3 = downsample_2_3<ColorTypeFilter_F16>;
+            downsamplers.proc_3_1 = downsample_3_1<ColorTypeFilter_F16>;
+            downsamplers.proc_3_2 = downsample_3_2<ColorTypeFilter_F16>;
+            downsamplers.proc_3_3 = downsample_3_3<ColorTypeFilter_F16>;
             break;
         default:
             return nullptr;
@@ -422,43 +498,12 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
     int         width = src.width();
     int         height = src.height();
     uint32_t    rowBytes;
-    SkPixmap    srcPM(src);
 
     // Depending on architecture and other factors, the pixel data alignment may need to be as
     // large as 8 (for F16 pixels). See the comment on SkMipMap::Level.
     SkASSERT(SkIsAlign8((uintptr_t)addr));
 
     for (int i = 0; i < countLevels; ++i) {
-        FilterProc* proc;
-        if (height & 1) {
-            if (height == 1) {        // src-height is 1
-                if (width & 1) {      // src-width is 3
-                    proc = proc_3_1;
-                } else {              // src-width is 2
-                    proc = proc_2_1;
-                }
-            } else {                  // src-height is 3
-                if (width & 1) {
-                    if (width == 1) { // src-width is 1
-                        proc = proc_1_3;
-                    } else {          // src-width is 3
-                        proc = proc_3_3;
-                    }
-                } else {              // src-width is 2
-                    proc = proc_2_3;
-                }
-            }
-        } else {                      // src-height is 2
-            if (width & 1) {
-                if (width == 1) {     // src-width is 1
-                    proc = proc_1_2;
-                } else {              // src-width is 3
-                    proc = proc_3_2;
-                }
-            } else {                  // src-width is 2
-                proc = proc_2_2;
-            }
-        }
         width = SkTMax(1, width >> 1);
         height = SkTMax(1, height >> 1);
         rowBytes = SkToU32(SkColorTypeMinRowBytes(ct, width));
@@ -469,22 +514,17 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
         new (&levels[i].fPixmap) SkPixmap(SkImageInfo::Make(width, height, ct, at), addr, rowBytes);
         levels[i].fScale  = SkSize::Make(SkIntToScalar(width)  / src.width(),
                                          SkIntToScalar(height) / src.height());
-
-        const SkPixmap& dstPM = levels[i].fPixmap;
-        const void* srcBasePtr = srcPM.addr();
-        void* dstBasePtr = dstPM.writable_addr();
-
-        const size_t srcRB = srcPM.rowBytes();
-        for (int y = 0; y < height; y++) {
-            proc(dstBasePtr, srcBasePtr, srcRB, width);
-            srcBasePtr = (char*)srcBasePtr + srcRB * 2; // jump two rows
-            dstBasePtr = (char*)dstBasePtr + dstPM.rowBytes();
-        }
-        srcPM = dstPM;
         addr += height * rowBytes;
     }
     SkASSERT(addr == baseAddr + size);
 
+    Downsample(downsamplers, src, levels[0].fPixmap);
+    mipmap->fDownsamplers = downsamplers;
+    mipmap->fBuiltCount.store(1, std::memory_order_relaxed);
+    if (!buildLazily) {
+        mipmap->ensureLevels(countLevels);
+    }
+
     SkASSERT(mipmap->fLevels);
     return mipmap;
 }
@@ -584,6 +624,9 @@ bool SkMipMap::extractLevel(const SkSize& scaleSize, Level* levelPtr) const {
     if (level > fCount) {
         level = fCount;
     }
+    if (!this->ensureLevels(level)) {
+        return false;
+    }
     if (levelPtr) {
         *levelPtr = fLevels[level - 1];
         // need to augment with our colorspace
@@ -594,12 +637,12 @@ bool SkMipMap::extractLevel(const SkSize& scaleSize, Level* levelPtr) const {
 
 // Helper which extracts a pixmap from the src bitmap
 //
-SkMipMap* SkMipMap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact) {
+SkMipMap* SkMipMap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact, bool buildLazily) {
     SkPixmap srcPixmap;
     if (!src.peekPixels(&srcPixmap)) {
         return nullptr;
     }
-    return Build(srcPixmap, fact);
+    return Build(srcPixmap, fact, buildLazily);
 }
 
 int SkMipMap::countLevels() const {
@@ -616,6 +659,9 @@ bool SkMipMap::getLevel(int index, Level* levelPtr) const {
     if (index > fCount - 1) {
         return false;
     }
+    if (!this->ensureLevels(index + 1)) {
+        return false;
+    }
     if (levelPtr) {
         *levelPtr = fLevels[index];
     }
@@ -10,16 +10,23 @@
 
 #include "SkCachedData.h"
 #include "SkImageInfoPriv.h"
+#include "SkMutex.h"
 #include "SkPixmap.h"
 #include "SkScalar.h"
 #include "SkSize.h"
 #include "SkShaderBase.h"
 
+#include <atomic>
+
 class SkBitmap;
 class SkDiscardableMemory;
+class SkExecutor;
 
 typedef SkDiscardableMemory* (*SkDiscardableFactoryProc)(size_t bytes);
 
+// If non-null, SkMipMap splits the rows of its largest levels over this executor.
+extern std::atomic<SkExecutor*> gSkMipMapExecutor;
+
 /*
  * SkMipMap will generate mipmap levels when given a base mipmap level image.
  *
@@ -29,8 +36,13 @@ typedef SkDiscardableMemory* (*SkDiscardableFactoryProc)(size_t bytes);
  */
 class SkMipMap : public SkCachedData {
 public:
-    static SkMipMap* Build(const SkPixmap& src, SkDiscardableFactoryProc);
-    static SkMipMap* Build(const SkBitmap& src, SkDiscardableFactoryProc);
+    // If buildLazily is true, only the first level is generated up front. Each of the others is
+    // generated, along with any levels above it, the first time extractLevel() or getLevel()
+    // asks for it. The first level is built from src, so src need not outlive the SkMipMap.
+    static SkMipMap* Build(const SkPixmap& src, SkDiscardableFactoryProc,
+                           bool buildLazily = false);
+    static SkMipMap* Build(const SkBitmap& src, SkDiscardableFactoryProc,
+                           bool buildLazily = false);
 
     // Determines how many levels a SkMipMap will have without creating that mipmap.
     // This does not include the base mipmap level that the user provided when
@@ -67,15 +79,39 @@ protected:
     }
 
 private:
+    typedef void FilterProc(void*, const void* srcPtr, size_t srcRB, int count);
+
+    // The filters for each WxH source footprint, for our color type.
+    struct Downsamplers {
+        FilterProc* proc_1_2;
+        FilterProc* proc_1_3;
+        FilterProc* proc_2_1;
+        FilterProc* proc_2_2;
+        FilterProc* proc_2_3;
+        FilterProc* proc_3_1;
+        FilterProc* proc_3_2;
+        FilterProc* proc_3_3;
+    };
+
     sk_sp<SkColorSpace> fCS;
     Level*              fLevels;    // managed by the baseclass, may be null due to onDataChanged.
     int                 fCount;
 
+    Downsamplers             fDownsamplers;
+    mutable SkMutex          fBuildMutex;
+    mutable std::atomic<int> fBuiltCount{0};  // fLevels[0 .. fBuiltCount-1] are generated.
+
     SkMipMap(void* malloc, size_t size) : INHERITED(malloc, size) {}
     SkMipMap(size_t size, SkDiscardableMemory* dm) : INHERITED(size, dm) {}
 
     static size_t AllocLevelsSize(int levelCount, size_t pixelSize);
 
+    // Fills dst, which is half the size of src (rounded down), by filtering src.
+    static void Downsample(const Downsamplers&, const SkPixmap& src, const SkPixmap& dst);
+
+    // Generates the first count levels if they aren't yet. Returns false if our pixels are gone.
+    bool ensureLevels(int count) const;
+
     typedef SkCachedData INHERITED;
 };
 
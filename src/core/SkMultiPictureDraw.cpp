@@ -7,8 +7,10 @@
 
 #include "SkCanvas.h"
 #include "SkCanvasPriv.h"
+#include "SkExecutor.h"
 #include "SkMultiPictureDraw.h"
 #include "SkPicture.h"
+#include "SkTArray.h"
 #include "SkTaskGroup.h"
 
 void SkMultiPictureDraw::DrawData::draw() {
@@ -73,35 +75,69 @@ public:
     ~AutoMPDReset() { fMPD->reset(); }
 };
 
+// Groups the indices of the draws by canvas, with canvases in the order they first appear and
+// each canvas' draws in the order they were added.
+static SkTArray<SkTDArray<int>> group_by_canvas(const SkTDArray<SkCanvas*>& canvases) {
+    SkTArray<SkTDArray<int>> groups;
+    SkTDArray<SkCanvas*> seen;
+    for (int i = 0; i < canvases.count(); ++i) {
+        int group = seen.find(canvases[i]);
+        if (group < 0) {
+            group = seen.count();
+            seen.push_back(canvases[i]);
+            groups.push_back();
+        }
+        groups[group].push_back(i);
+    }
+    return groups;
+}
+
+template <typename T>
+static SkTDArray<SkCanvas*> canvases_of(const SkTDArray<T>& data) {
+    SkTDArray<SkCanvas*> canvases;
+    canvases.setReserve(data.count());
+    for (int i = 0; i < data.count(); ++i) {
+        canvases.push_back(data[i].fCanvas);
+    }
+    return canvases;
+}
+
 //#define FORCE_SINGLE_THREAD_DRAWING_FOR_TESTING
 
-void SkMultiPictureDraw::draw(bool flush) {
+void SkMultiPictureDraw::draw(bool flush, SkExecutor* executor) {
     AutoMPDReset mpdreset(this);
 
+    // A canvas can only be drawn to by one thread at a time, so each task owns a canvas.
+    const SkTArray<SkTDArray<int>> cpuGroups = group_by_canvas(canvases_of(fThreadSafeDrawData));
+    auto drawCPUGroup = [&](int g) {
+        for (int i : cpuGroups[g]) {
+            fThreadSafeDrawData[i].draw();
+        }
+        if (flush) {
+            fThreadSafeDrawData[cpuGroups[g][0]].fCanvas->flush();
+        }
+    };
 #ifdef FORCE_SINGLE_THREAD_DRAWING_FOR_TESTING
-    for (int i = 0; i < fThreadSafeDrawData.count(); ++i) {
-        fThreadSafeDrawData[i].draw();
+    for (int g = 0; g < cpuGroups.count(); ++g) {
+        drawCPUGroup(g);
     }
 #else
-    SkTaskGroup().batch(fThreadSafeDrawData.count(), [&](int i) {
-        fThreadSafeDrawData[i].draw();
-    });
+    SkTaskGroup(executor ? *executor : SkExecutor::GetDefault()).batch(cpuGroups.count(),
+                                                                       drawCPUGroup);
 #endif
 
     // N.B. we could get going on any GPU work from this main thread while the CPU work runs.
     // But in practice, we've either got GPU work or CPU work, not both.
 
-    const int count = fGPUDrawData.count();
-    if (0 == count) {
+    if (fGPUDrawData.isEmpty()) {
         return;
     }
 
-    for (int i = 0; i < count; ++i) {
-        const DrawData& data = fGPUDrawData[i];
-        SkCanvas* canvas = data.fCanvas;
-        const SkPicture* picture = data.fPicture;
-
-        canvas->drawPicture(picture, &data.fMatrix, data.fPaint);
+    for (const SkTDArray<int>& group : group_by_canvas(canvases_of(fGPUDrawData))) {
+        SkCanvas* canvas = fGPUDrawData[group[0]].fCanvas;
+        for (int i : group) {
+            fGPUDrawData[i].draw();
+        }
         if (flush) {
             canvas->flush();
         }
@@ -13,6 +13,7 @@
 #include "SkXfermodePriv.h"
 
 struct SkBitmapProcState;
+struct SkPoint;
 
 namespace SkOpts {
     // Call to replace pointers to portable functions with pointers to CPU-specific functions.
@@ -47,6 +48,19 @@ namespace SkOpts {
     extern void SK_API (*memset32)(uint32_t[], uint32_t, int);
     extern void (*memset64)(uint64_t[], uint64_t, int);
 
+    // SkMaskBlurFilter's three box blur passes over eight rows of A8 at a time.
+    extern void (*box_blur_8_rows)(const uint8_t* src, size_t srcRowBytes, int srcWidth,
+                                   uint8_t* dst, size_t dstStride, int dstWidth,
+                                   int window, uint32_t weight, uint32_t* buffer);
+
+    // SkMipMap's 2x2 box filters for 8888 and F16, writing count pixels from two source rows.
+    extern void (*downsample_2_2_8888)(void* dst, const void* src, size_t srcRB, int count);
+    extern void (*downsample_2_2_f16 )(void* dst, const void* src, size_t srcRB, int count);
+
+    // SkMatrix's bulk point mapping for affine and perspective matrices; m is in get9() order.
+    extern void (*matrix_map_affine)(const float m[9], SkPoint dst[], const SkPoint src[], int);
+    extern void (*matrix_map_persp )(const float m[9], SkPoint dst[], const SkPoint src[], int);
+
     // The fastest high quality 32-bit hash we can provide on this platform.
     extern uint32_t (*hash_fn)(const void*, size_t, uint32_t seed);
     static inline uint32_t hash(const void* data, size_t bytes, uint32_t seed=0) {
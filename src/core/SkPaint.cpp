@@ -59,12 +59,7 @@ SkPaint::SkPaint() {
 
 SkPaint::SkPaint(const SkPaint& src)
 #define COPY(field) field(src.field)
-    : COPY(fPathEffect)
-    , COPY(fShader)
-    , COPY(fMaskFilter)
-    , COPY(fColorFilter)
-    , COPY(fDrawLooper)
-    , COPY(fImageFilter)
+    : COPY(fEffects)
     , COPY(fColor4f)
     , COPY(fWidth)
     , COPY(fMiterLimit)
@@ -74,12 +69,7 @@ SkPaint::SkPaint(const SkPaint& src)
 
 SkPaint::SkPaint(SkPaint&& src) {
 #define MOVE(field) field = std::move(src.field)
-    MOVE(fPathEffect);
-    MOVE(fShader);
-    MOVE(fMaskFilter);
-    MOVE(fColorFilter);
-    MOVE(fDrawLooper);
-    MOVE(fImageFilter);
+    MOVE(fEffects);
     MOVE(fColor4f);
     MOVE(fWidth);
     MOVE(fMiterLimit);
@@ -95,12 +85,7 @@ SkPaint& SkPaint::operator=(const SkPaint& src) {
     }
 
 #define ASSIGN(field) field = src.field
-    ASSIGN(fPathEffect);
-    ASSIGN(fShader);
-    ASSIGN(fMaskFilter);
-    ASSIGN(fColorFilter);
-    ASSIGN(fDrawLooper);
-    ASSIGN(fImageFilter);
+    ASSIGN(fEffects);
     ASSIGN(fColor4f);
     ASSIGN(fWidth);
     ASSIGN(fMiterLimit);
@@ -116,12 +101,7 @@ SkPaint& SkPaint::operator=(SkPaint&& src) {
     }
 
 #define MOVE(field) field = std::move(src.field)
-    MOVE(fPathEffect);
-    MOVE(fShader);
-    MOVE(fMaskFilter);
-    MOVE(fColorFilter);
-    MOVE(fDrawLooper);
-    MOVE(fImageFilter);
+    MOVE(fEffects);
     MOVE(fColor4f);
     MOVE(fWidth);
     MOVE(fMiterLimit);
@@ -133,12 +113,17 @@ SkPaint& SkPaint::operator=(SkPaint&& src) {
 
 bool operator==(const SkPaint& a, const SkPaint& b) {
 #define EQUAL(field) (a.field == b.field)
-    return EQUAL(fPathEffect)
-        && EQUAL(fShader)
-        && EQUAL(fMaskFilter)
-        && EQUAL(fColorFilter)
-        && EQUAL(fDrawLooper)
-        && EQUAL(fImageFilter)
+    bool sameEffects = EQUAL(fEffects);
+    if (!sameEffects && a.fEffects && b.fEffects) {
+        // Paints without effects have no Effects at all, so only two sets of effects can match.
+        sameEffects = EQUAL(fEffects->fPathEffect)
+                   && EQUAL(fEffects->fShader)
+                   && EQUAL(fEffects->fMaskFilter)
+                   && EQUAL(fEffects->fColorFilter)
+                   && EQUAL(fEffects->fDrawLooper)
+                   && EQUAL(fEffects->fImageFilter);
+    }
+    return sameEffects
         && EQUAL(fColor4f)
         && EQUAL(fWidth)
         && EQUAL(fMiterLimit)
@@ -147,7 +132,9 @@ bool operator==(const SkPaint& a, const SkPaint& b) {
 #undef EQUAL
 }
 
-#define DEFINE_REF_FOO(type)    sk_sp<Sk##type> SkPaint::ref##type() const { return f##type; }
+#define DEFINE_REF_FOO(type)    sk_sp<Sk##type> SkPaint::ref##type() const { \
+    return sk_ref_sp(this->get##type());                                         \
+}
 DEFINE_REF_FOO(ColorFilter)
 DEFINE_REF_FOO(DrawLooper)
 DEFINE_REF_FOO(ImageFilter)
@@ -237,7 +224,42 @@ void SkPaint::setStrokeJoin(Join jt) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-#define MOVE_FIELD(Field) void SkPaint::set##Field(sk_sp<Sk##Field> f) { f##Field = std::move(f); }
+bool SkPaint::Effects::isEmpty() const {
+    return !fPathEffect && !fShader && !fMaskFilter && !fColorFilter && !fDrawLooper &&
+           !fImageFilter;
+}
+
+SkPaint::Effects* SkPaint::writableEffects() {
+    if (!fEffects) {
+        fEffects = sk_make_sp<Effects>();
+    } else if (!fEffects->unique()) {
+        sk_sp<Effects> copy = sk_make_sp<Effects>();
+        copy->fPathEffect  = fEffects->fPathEffect;
+        copy->fShader      = fEffects->fShader;
+        copy->fMaskFilter  = fEffects->fMaskFilter;
+        copy->fColorFilter = fEffects->fColorFilter;
+        copy->fDrawLooper  = fEffects->fDrawLooper;
+        copy->fImageFilter = fEffects->fImageFilter;
+        fEffects = std::move(copy);
+    }
+    return fEffects.get();
+}
+
+template <typename T>
+void SkPaint::setEffect(sk_sp<T> Effects::* field, sk_sp<T> effect) {
+    if (fEffects ? (fEffects.get()->*field == effect) : !effect) {
+        return;
+    }
+    Effects* effects = this->writableEffects();
+    effects->*field = std::move(effect);
+    if (effects->isEmpty()) {
+        fEffects = nullptr;
+    }
+}
+
+#define MOVE_FIELD(Field) void SkPaint::set##Field(sk_sp<Sk##Field> f) {    \
+    this->setEffect(&Effects::f##Field, std::move(f));                      \
+}
 MOVE_FIELD(ImageFilter)
 MOVE_FIELD(Shader)
 MOVE_FIELD(ColorFilter)
@@ -245,7 +267,7 @@ MOVE_FIELD(PathEffect)
 MOVE_FIELD(MaskFilter)
 MOVE_FIELD(DrawLooper)
 #undef MOVE_FIELD
-void SkPaint::setLooper(sk_sp<SkDrawLooper> looper) { fDrawLooper = std::move(looper); }
+void SkPaint::setLooper(sk_sp<SkDrawLooper> looper) { this->setDrawLooper(std::move(looper)); }
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -521,7 +543,8 @@ bool SkPaint::getFillPath(const SkPath& src, SkPath* dst, const SkRect* cullRect
     const SkPath* srcPtr = &src;
     SkPath tmpPath;
 
-    if (fPathEffect && fPathEffect->filterPath(&tmpPath, src, &rec, cullRect)) {
+    SkPathEffect* pathEffect = this->getPathEffect();
+    if (pathEffect && pathEffect->filterPath(&tmpPath, src, &rec, cullRect)) {
         srcPtr = &tmpPath;
     }
 
@@ -602,7 +625,7 @@ static bool affects_alpha(const SkImageFilter* imf) {
 }
 
 bool SkPaint::nothingToDraw() const {
-    if (fDrawLooper) {
+    if (this->getDrawLooper()) {
         return false;
     }
     switch (this->getBlendMode()) {
@@ -612,7 +635,8 @@ bool SkPaint::nothingToDraw() const {
         case SkBlendMode::kDstOver:
         case SkBlendMode::kPlus:
             if (0 == this->getAlpha()) {
-                return !affects_alpha(fColorFilter.get()) && !affects_alpha(fImageFilter.get());
+                return !affects_alpha(this->getColorFilter()) &&
+                       !affects_alpha(this->getImageFilter());
             }
             break;
         case SkBlendMode::kDst:
@@ -624,10 +648,20 @@ bool SkPaint::nothingToDraw() const {
 }
 
 uint32_t SkPaint::getHash() const {
-    // We're going to hash 6 pointers and 6 floats, finishing up with fBitfields,
-    // so fBitfields should be 6 pointers and 6 floats from the start.
-    static_assert(offsetof(SkPaint, fBitfieldsUInt) == 6 * sizeof(void*) + 6 * sizeof(float),
-                  "SkPaint_notPackedTightly");
-    return SkOpts::hash(reinterpret_cast<const uint32_t*>(this),
-                        offsetof(SkPaint, fBitfieldsUInt) + sizeof(fBitfieldsUInt));
+    // Hash the effects themselves rather than fEffects, so that equal paints hash equally even
+    // when they do not share their Effects.
+    struct {
+        const void* fEffects[6];
+        SkColor4f   fColor4f;
+        SkScalar    fWidth;
+        SkScalar    fMiterLimit;
+        uint32_t    fBitfieldsUInt;
+        uint32_t    fPad;
+    } key = {
+        { this->getPathEffect(), this->getShader(), this->getMaskFilter(),
+          this->getColorFilter(), this->getDrawLooper(), this->getImageFilter() },
+        fColor4f, fWidth, fMiterLimit, fBitfieldsUInt, 0,
+    };
+    static_assert(sizeof(key) == 6 * sizeof(void*) + 8 * sizeof(float), "key_notPackedTightly");
+    return SkOpts::hash(&key, sizeof(key));
 }
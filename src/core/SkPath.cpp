@@ -3838,9 +3838,7 @@ static int compute_quad_extremas(const SkPoint src[3], SkPoint extremas[3]) {
     int n  = SkFindQuadExtrema(src[0].fX, src[1].fX, src[2].fX, ts);
         n += SkFindQuadExtrema(src[0].fY, src[1].fY, src[2].fY, &ts[n]);
     SkASSERT(n >= 0 && n <= 2);
-    for (int i = 0; i < n; ++i) {
-        extremas[i] = SkEvalQuadAt(src, ts[i]);
-    }
+    SkEvalQuadAt(src, ts, extremas, n);
     extremas[n] = src[2];
     return n + 1;
 }
@@ -3851,9 +3849,7 @@ static int compute_conic_extremas(const SkPoint src[3], SkScalar w, SkPoint extr
     int n  = conic.findXExtrema(ts);
         n += conic.findYExtrema(&ts[n]);
     SkASSERT(n >= 0 && n <= 2);
-    for (int i = 0; i < n; ++i) {
-        extremas[i] = conic.evalAt(ts[i]);
-    }
+    conic.evalAt(ts, extremas, n);
     extremas[n] = src[2];
     return n + 1;
 }
@@ -3863,9 +3859,7 @@ static int compute_cubic_extremas(const SkPoint src[3], SkPoint extremas[5]) {
     int n  = SkFindCubicExtrema(src[0].fX, src[1].fX, src[2].fX, src[3].fX, ts);
         n += SkFindCubicExtrema(src[0].fY, src[1].fY, src[2].fY, src[3].fY, &ts[n]);
     SkASSERT(n >= 0 && n <= 4);
-    for (int i = 0; i < n; ++i) {
-        SkEvalCubicAt(src, ts[i], &extremas[i], nullptr, nullptr);
-    }
+    SkEvalCubicAt(src, ts, extremas, n);
     extremas[n] = src[3];
     return n + 1;
 }
@@ -572,18 +572,23 @@ int SkTKSearch(const T base[], int count, const K& key) {
     return hi;
 }
 
-const SkPathMeasure::Segment* SkPathMeasure::distanceToSegment(
-                                            SkScalar distance, SkScalar* t) {
-    SkDEBUGCODE(SkScalar length = ) this->getLength();
-    SkASSERT(distance >= 0 && distance <= length);
+const SkPathMeasure::Segment* SkPathMeasure::DistanceToSegment(const SkTDArray<Segment>& segments,
+                                                               SkScalar distance, SkScalar* t) {
+    SkASSERT(distance >= 0 && !segments.isEmpty());
 
-    const Segment*  seg = fSegments.begin();
-    int             count = fSegments.count();
+    const Segment*  seg = segments.begin();
+    int             count = segments.count();
 
     int index = SkTKSearch<Segment, SkScalar>(seg, count, distance);
     // don't care if we hit an exact match or not, so we xor index if it is negative
     index ^= (index >> 31);
-    seg = &seg[index];
+    return InterpolateSegment(segments, index, distance, t);
+}
+
+const SkPathMeasure::Segment* SkPathMeasure::InterpolateSegment(
+                                            const SkTDArray<Segment>& segments, int index,
+                                            SkScalar distance, SkScalar* t) {
+    const Segment* seg = &segments[index];
 
     // now interpolate t-values with the prev segment (if possible)
     SkScalar    startT = 0, startD = 0;
@@ -605,8 +610,14 @@ const SkPathMeasure::Segment* SkPathMeasure::distanceToSegment(
 }
 
 bool SkPathMeasure::getPosTan(SkScalar distance, SkPoint* pos, SkVector* tangent) {
-    SkScalar    length = this->getLength(); // call this to force computing it
-    int         count = fSegments.count();
+    SkScalar length = this->getLength(); // call this to force computing it
+    return GetPosTan(fSegments, fPts.begin(), length, distance, pos, tangent);
+}
+
+bool SkPathMeasure::GetPosTan(const SkTDArray<Segment>& segments, const SkPoint pts[],
+                              SkScalar length, SkScalar distance, SkPoint* pos,
+                              SkVector* tangent) {
+    int count = segments.count();
 
     if (count == 0 || length == 0 || SkScalarIsNaN(distance)) {
         return false;
@@ -620,12 +631,53 @@ bool SkPathMeasure::getPosTan(SkScalar distance, SkPoint* pos, SkVector* tangent
     }
 
     SkScalar        t;
-    const Segment*  seg = this->distanceToSegment(distance, &t);
+    const Segment*  seg = DistanceToSegment(segments, distance, &t);
     if (SkScalarIsNaN(t)) {
         return false;
     }
 
-    compute_pos_tan(&fPts[seg->fPtIndex], seg->fType, t, pos, tangent);
+    compute_pos_tan(&pts[seg->fPtIndex], seg->fType, t, pos, tangent);
+    return true;
+}
+
+bool SkPathMeasure::GetPosTans(const SkTDArray<Segment>& segments, const SkPoint pts[],
+                               SkScalar length, const SkScalar distances[], int count,
+                               SkPoint positions[], SkVector tangents[]) {
+    if (segments.isEmpty() || length == 0) {
+        return false;
+    }
+
+    // Sorted distances walk forward from the previous segment instead of searching again, so
+    // sampling a whole contour in order costs about one step per query.
+    const int kMaxSteps = 8;
+    const int last = segments.count() - 1;
+    int index = 0;
+    SkScalar prevDistance = 0;
+    for (int i = 0; i < count; ++i) {
+        SkScalar distance = SkScalarIsNaN(distances[i]) ? 0 : SkTPin(distances[i], 0.f, length);
+        if (distance < prevDistance) {
+            index = 0;
+        }
+        int steps = 0;
+        while (index < last && segments[index].fDistance < distance && steps < kMaxSteps) {
+            ++index;
+            ++steps;
+        }
+        if (index < last && segments[index].fDistance < distance) {
+            int found = SkTKSearch<Segment, SkScalar>(&segments[index], segments.count() - index,
+                                                      distance);
+            index = SkTMin(index + (found ^ (found >> 31)), last);
+        }
+        prevDistance = distance;
+
+        SkScalar t;
+        const Segment* seg = InterpolateSegment(segments, index, distance, &t);
+        if (SkScalarIsNaN(t)) {
+            t = 0;
+        }
+        compute_pos_tan(&pts[seg->fPtIndex], seg->fType, t,
+                        positions ? &positions[i] : nullptr, tangents ? &tangents[i] : nullptr);
+    }
     return true;
 }
 
@@ -652,9 +704,14 @@ bool SkPathMeasure::getMatrix(SkScalar distance, SkMatrix* matrix,
 
 bool SkPathMeasure::getSegment(SkScalar startD, SkScalar stopD, SkPath* dst,
                                bool startWithMoveTo) {
-    SkASSERT(dst);
-
     SkScalar length = this->getLength();    // ensure we have built our segments
+    return GetSegment(fSegments, fPts.begin(), length, startD, stopD, dst, startWithMoveTo);
+}
+
+bool SkPathMeasure::GetSegment(const SkTDArray<Segment>& segments, const SkPoint pts[],
+                               SkScalar length, SkScalar startD, SkScalar stopD, SkPath* dst,
+                               bool startWithMoveTo) {
+    SkASSERT(dst);
 
     if (startD < 0) {
         startD = 0;
@@ -665,35 +722,35 @@ bool SkPathMeasure::getSegment(SkScalar startD, SkScalar stopD, SkPath* dst,
     if (!(startD <= stopD)) {   // catch NaN values as well
         return false;
     }
-    if (!fSegments.count()) {
+    if (!segments.count()) {
         return false;
     }
 
     SkPoint  p;
     SkScalar startT, stopT;
-    const Segment* seg = this->distanceToSegment(startD, &startT);
+    const Segment* seg = DistanceToSegment(segments, startD, &startT);
     if (!SkScalarIsFinite(startT)) {
         return false;
     }
-    const Segment* stopSeg = this->distanceToSegment(stopD, &stopT);
+    const Segment* stopSeg = DistanceToSegment(segments, stopD, &stopT);
     if (!SkScalarIsFinite(stopT)) {
         return false;
     }
     SkASSERT(seg <= stopSeg);
     if (startWithMoveTo) {
-        compute_pos_tan(&fPts[seg->fPtIndex], seg->fType, startT, &p, nullptr);
+        compute_pos_tan(&pts[seg->fPtIndex], seg->fType, startT, &p, nullptr);
         dst->moveTo(p);
     }
 
     if (seg->fPtIndex == stopSeg->fPtIndex) {
-        SkPathMeasure_segTo(&fPts[seg->fPtIndex], seg->fType, startT, stopT, dst);
+        SkPathMeasure_segTo(&pts[seg->fPtIndex], seg->fType, startT, stopT, dst);
     } else {
         do {
-            SkPathMeasure_segTo(&fPts[seg->fPtIndex], seg->fType, startT, SK_Scalar1, dst);
+            SkPathMeasure_segTo(&pts[seg->fPtIndex], seg->fType, startT, SK_Scalar1, dst);
             seg = SkPathMeasure::NextSegment(seg);
             startT = 0;
         } while (seg->fPtIndex < stopSeg->fPtIndex);
-        SkPathMeasure_segTo(&fPts[seg->fPtIndex], seg->fType, 0, stopT, dst);
+        SkPathMeasure_segTo(&pts[seg->fPtIndex], seg->fType, 0, stopT, dst);
     }
 
     return true;
@@ -41,7 +41,11 @@ SkPathRef::Editor::Editor(sk_sp<SkPathRef>* pathRef,
         pathRef->reset(copy);
     }
     fPathRef = pathRef->get();
-    fPathRef->callGenIDChangeListeners();
+    // Listeners are only added once there is a generation ID, and are called and cleared when it
+    // is reset, so a path being built up edit by edit skips the listener lock.
+    if (fPathRef->fGenerationID != 0) {
+        fPathRef->callGenIDChangeListeners();
+    }
     fPathRef->fGenerationID = 0;
     fPathRef->fBoundsIsDirty = true;
     SkDEBUGCODE(fPathRef->fEditorsAttached++;)
@@ -707,6 +711,7 @@ void SkPathRef::addGenIDChangeListener(sk_sp<GenIDChangeListener> listener) {
     if (nullptr == listener || this == gEmpty) {
         return;
     }
+    (void)this->genID();  // Editors only call listeners of paths that have an ID.
 
     SkAutoMutexAcquire lock(fGenIDChangeListenersMutex);
 
@@ -132,7 +132,7 @@ sk_sp<SkPicture> SkPicture::Forwardport(const SkPictInfo& info,
 }
 
 sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialProcs* procs) {
-    return MakeFromStream(stream, procs, nullptr);
+    return MakeFromStream(stream, procs, nullptr, nullptr, nullptr);
 }
 
 sk_sp<SkPicture> SkPicture::MakeFromData(const void* data, size_t size,
@@ -141,7 +141,7 @@ sk_sp<SkPicture> SkPicture::MakeFromData(const void* data, size_t size,
         return nullptr;
     }
     SkMemoryStream stream(data, size);
-    return MakeFromStream(&stream, procs, nullptr);
+    return MakeFromStream(&stream, procs, nullptr, nullptr, nullptr);
 }
 
 sk_sp<SkPicture> SkPicture::MakeFromData(const SkData* data, const SkDeserialProcs* procs) {
@@ -149,11 +149,22 @@ sk_sp<SkPicture> SkPicture::MakeFromData(const SkData* data, const SkDeserialPro
         return nullptr;
     }
     SkMemoryStream stream(data->data(), data->size());
-    return MakeFromStream(&stream, procs, nullptr);
+    return MakeFromStream(&stream, procs, nullptr, nullptr, nullptr);
+}
+
+sk_sp<SkPicture> SkPicture::MakeFromDataWithoutCopy(sk_sp<SkData> data,
+                                                    const SkDeserialProcs* procs) {
+    if (!data) {
+        return nullptr;
+    }
+    SkMemoryStream stream(data);
+    return MakeFromStream(&stream, procs, nullptr, nullptr, data.get());
 }
 
 sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialProcs* procsPtr,
-                                           SkTypefacePlayback* typefaces) {
+                                           SkTypefacePlayback* typefaces,
+                                           SkImagePlayback* images,
+                                           const SkData* sharedData) {
     SkPictInfo info;
     if (!StreamIsSKP(stream, &info)) {
         return nullptr;
@@ -169,7 +180,8 @@ sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialPro
     switch (trailingStreamByteAfterPictInfo) {
         case kPictureData_TrailingStreamByteAfterPictInfo: {
             std::unique_ptr<SkPictureData> data(
-                    SkPictureData::CreateFromStream(stream, info, procs, typefaces));
+                    SkPictureData::CreateFromStream(stream, info, procs, typefaces, images,
+                                                    sharedData));
             return Forwardport(info, data.get(), nullptr);
         }
         case kCustom_TrailingStreamByteAfterPictInfo: {
@@ -223,12 +235,12 @@ SkPictureData* SkPicture::backport() const {
 }
 
 void SkPicture::serialize(SkWStream* stream, const SkSerialProcs* procs) const {
-    this->serialize(stream, procs, nullptr);
+    this->serialize(stream, procs, nullptr, nullptr);
 }
 
 sk_sp<SkData> SkPicture::serialize(const SkSerialProcs* procs) const {
     SkDynamicMemoryWStream stream;
-    this->serialize(&stream, procs, nullptr);
+    this->serialize(&stream, procs, nullptr, nullptr);
     return stream.detachAsData();
 }
 
@@ -258,7 +270,7 @@ static bool write_pad32(SkWStream* stream, const void* data, size_t size) {
 }
 
 void SkPicture::serialize(SkWStream* stream, const SkSerialProcs* procsPtr,
-                          SkRefCntSet* typefaceSet) const {
+                          SkRefCntSet* typefaceSet, SkRefCntSet* imageSet) const {
     SkSerialProcs procs;
     if (procsPtr) {
         procs = *procsPtr;
@@ -282,7 +294,7 @@ void SkPicture::serialize(SkWStream* stream, const SkSerialProcs* procsPtr,
     std::unique_ptr<SkPictureData> data(this->backport());
     if (data) {
         stream->write8(kPictureData_TrailingStreamByteAfterPictInfo);
-        data->serialize(stream, procs, typefaceSet);
+        data->serialize(stream, procs, typefaceSet, imageSet);
     } else {
         stream->write8(kFailure_TrailingStreamByteAfterPictInfo);
     }
@@ -7,12 +7,14 @@
 
 #include "SkPictureData.h"
 
-#include "SkAutoMalloc.h"
 #include "SkImageGenerator.h"
+#include "SkImagePriv.h"
 #include "SkMakeUnique.h"
+#include "SkOpts.h"
 #include "SkPictureRecord.h"
 #include "SkPicturePriv.h"
 #include "SkReadBuffer.h"
+#include "SkTHash.h"
 #include "SkTextBlobPriv.h"
 #include "SkTypeface.h"
 #include "SkWriteBuffer.h"
@@ -144,6 +146,64 @@ void SkPictureData::WriteTypefaces(SkWStream* stream, const SkRefCntSet& rec,
     }
 }
 
+// Each entry is 0 followed by the image (as SkWriteBuffer::writeImage() would write it), or the
+// base-1 index of an earlier entry that encoded to the same bytes. Distinct SkImages often share
+// content (e.g. the same file decoded for each page of a document), so this catches more than
+// the pointer dedup done by the SkRefCntSet.
+void SkPictureData::WriteImages(SkWStream* stream, const SkRefCntSet& rec,
+                                const SkSerialProcs& procs) {
+    int count = rec.count();
+
+    SkAutoSTMalloc<16, SkImage*> storage(count);
+    SkImage** array = (SkImage**)storage.get();
+    rec.copyToArray((SkRefCnt**)array);
+
+    SkTArray<sk_sp<SkData>> encoded(count);
+    SkTArray<SkIRect> bounds(count);
+    SkTHashMap<uint32_t, int> firstWithHash;
+
+    SkBinaryWriteBuffer buffer;
+    for (int i = 0; i < count; i++) {
+        sk_sp<SkData> data;
+        if (procs.fImageProc) {
+            data = procs.fImageProc(array[i], procs.fImageCtx);
+        }
+        if (!data) {
+            data = array[i]->encodeToData();
+        }
+        if (data && !SkTFitsIn<int32_t>(data->size())) {
+            data = nullptr;   // too big to store
+        }
+        encoded.push_back(data);
+        bounds.push_back(SkImage_getSubset(array[i]));
+
+        if (data) {
+            uint32_t hash = SkOpts::hash(data->data(), data->size());
+            if (int* first = firstWithHash.find(hash)) {
+                const sk_sp<SkData>& other = encoded[*first];
+                if (bounds[*first] == bounds[i] && other->equals(data.get())) {
+                    buffer.writeInt(*first + 1);
+                    continue;
+                }
+            } else {
+                firstWithHash.set(hash, i);
+            }
+        }
+
+        buffer.writeInt(0);
+        buffer.writeIRect(bounds[i]);
+        int32_t size = data ? SkToS32(data->size()) : 0;
+        buffer.write32(size);   // writing 0 signals failure
+        if (size) {
+            buffer.writePad32(data->data(), size);
+        }
+    }
+
+    write_tag_size(stream, SK_PICT_IMAGE_TAG, count);
+    stream->write32(SkToU32(buffer.bytesWritten()));
+    buffer.writeToStream(stream);
+}
+
 void SkPictureData::flattenToBuffer(SkWriteBuffer& buffer) const {
     int i, n;
 
@@ -197,7 +257,8 @@ static SkSerialProcs skip_typeface_proc(const SkSerialProcs& procs) {
 }
 
 void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
-                              SkRefCntSet* topLevelTypeFaceSet) const {
+                              SkRefCntSet* topLevelTypeFaceSet,
+                              SkRefCntSet* topLevelImageSet) const {
     // This can happen at pretty much any time, so might as well do it first.
     write_tag_size(stream, SK_PICT_READER_TAG, fOpData->size());
     stream->write(fOpData->bytes(), fOpData->size());
@@ -206,6 +267,10 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     SkRefCntSet localTypefaceSet;
     SkRefCntSet* typefaceSet = topLevelTypeFaceSet ? topLevelTypeFaceSet : &localTypefaceSet;
 
+    // Likewise images, so that pages or sub-pictures drawing the same image only encode it once.
+    SkRefCntSet localImageSet;
+    SkRefCntSet* imageSet = topLevelImageSet ? topLevelImageSet : &localImageSet;
+
     // We delay serializing the bulk of our data until after we've serialized
     // factories and typefaces by first serializing to an in-memory write buffer.
     SkFactorySet factSet;  // buffer refs factSet, so factSet must come first.
@@ -213,10 +278,12 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     buffer.setFactoryRecorder(sk_ref_sp(&factSet));
     buffer.setSerialProcs(skip_typeface_proc(procs));
     buffer.setTypefaceRecorder(sk_ref_sp(typefaceSet));
+    buffer.setImageRecorder(sk_ref_sp(imageSet));
     this->flattenToBuffer(buffer);
 
     // Dummy serialize our sub-pictures for the side effect of filling
-    // typefaceSet with typefaces from sub-pictures.
+    // typefaceSet and imageSet with typefaces and images from sub-pictures.
+    // Since images are only recorded, this pass does not encode any of them.
     struct DevNull: public SkWStream {
         DevNull() : fBytesWritten(0) {}
         size_t fBytesWritten;
@@ -224,7 +291,7 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
         size_t bytesWritten() const override { return fBytesWritten; }
     } devnull;
     for (const auto& pic : fPictures) {
-        pic->serialize(&devnull, nullptr, typefaceSet);
+        pic->serialize(&devnull, nullptr, typefaceSet, imageSet);
     }
 
     // We need to write factories before we write the buffer.
@@ -236,6 +303,9 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
         // paints would just write indices into our typeface set.
         WriteTypefaces(stream, *typefaceSet, procs);
     }
+    if (imageSet == &localImageSet && imageSet->count() > 0) {
+        WriteImages(stream, *imageSet, procs);
+    }
 
     // Write the buffer.
     write_tag_size(stream, SK_PICT_BUFFER_SIZE_TAG, buffer.bytesWritten());
@@ -245,7 +315,7 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     if (!fPictures.empty()) {
         write_tag_size(stream, SK_PICT_PICTURE_TAG, fPictures.count());
         for (const auto& pic : fPictures) {
-            pic->serialize(stream, &procs, typefaceSet);
+            pic->serialize(stream, &procs, typefaceSet, imageSet);
         }
     }
 
@@ -277,15 +347,31 @@ void SkPictureData::flatten(SkWriteBuffer& buffer) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Reads size bytes from stream, referencing them in sharedData when we're reading from it.
+static sk_sp<SkData> read_data(SkStream* stream, size_t size, const SkData* sharedData) {
+    if (!sharedData) {
+        return SkData::MakeFromStream(stream, size);
+    }
+    SkASSERT(stream->getMemoryBase() == sharedData->data());
+    const size_t offset = stream->getPosition();
+    if (offset > sharedData->size() || size > sharedData->size() - offset ||
+        stream->skip(size) != size) {
+        return nullptr;
+    }
+    return SkData::MakeSubset(sharedData, offset, size);
+}
+
 bool SkPictureData::parseStreamTag(SkStream* stream,
                                    uint32_t tag,
                                    uint32_t size,
                                    const SkDeserialProcs& procs,
-                                   SkTypefacePlayback* topLevelTFPlayback) {
+                                   SkTypefacePlayback* topLevelTFPlayback,
+                                   SkImagePlayback* topLevelImagePlayback,
+                                   const SkData* sharedData) {
     switch (tag) {
         case SK_PICT_READER_TAG:
             SkASSERT(nullptr == fOpData);
-            fOpData = SkData::MakeFromStream(stream, size);
+            fOpData = read_data(stream, size, sharedData);
             if (!fOpData) {
                 return false;
             }
@@ -316,12 +402,50 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
                 fTFPlayback[i] = std::move(tf);
             }
         } break;
+        case SK_PICT_IMAGE_TAG: {
+            uint32_t length;
+            if (!stream->readU32(&length) || !SkIsAlign4(length)) { return false; }
+            sk_sp<SkData> shared = read_data(stream, length, sharedData);
+            if (!shared) {
+                return false;
+            }
+            sk_sp<SkData> storage = shared;
+            if (!SkIsAlign4((uintptr_t)storage->data())) {
+                storage = SkData::MakeWithCopy(shared->data(), length);
+            }
+
+            SkReadBuffer buffer(storage->data(), length);
+            buffer.setVersion(fInfo.getVersion());
+            buffer.setDeserialProcs(procs);
+            if (sharedData) {
+                buffer.setBackingData(std::move(shared));
+            }
+            if (!buffer.validate(size <= buffer.available() / sizeof(int32_t))) {
+                return false;
+            }
+            fImagePlayback.setCount(size);
+            for (uint32_t i = 0; i < size; ++i) {
+                int32_t alias = buffer.readInt();
+                if (alias != 0) {
+                    if (!buffer.validate(alias > 0 && SkToU32(alias) <= i)) {
+                        return false;
+                    }
+                    fImagePlayback[i] = fImagePlayback[alias - 1];
+                    continue;
+                }
+                fImagePlayback[i] = buffer.readImage();
+                if (!buffer.isValid() || !fImagePlayback[i]) {
+                    return false;
+                }
+            }
+        } break;
         case SK_PICT_PICTURE_TAG: {
             SkASSERT(fPictures.empty());
             fPictures.reserve(SkToInt(size));
 
             for (uint32_t i = 0; i < size; i++) {
-                auto pic = SkPicture::MakeFromStream(stream, &procs, topLevelTFPlayback);
+                auto pic = SkPicture::MakeFromStream(stream, &procs, topLevelTFPlayback,
+                                                     topLevelImagePlayback, sharedData);
                 if (!pic) {
                     return false;
                 }
@@ -329,13 +453,22 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             }
         } break;
         case SK_PICT_BUFFER_SIZE_TAG: {
-            SkAutoMalloc storage(size);
-            if (stream->read(storage.get(), size) != size) {
+            sk_sp<SkData> shared = read_data(stream, size, sharedData);
+            if (!shared) {
                 return false;
             }
+            sk_sp<SkData> storage = shared;
+            if (!SkIsAlign4((uintptr_t)storage->data())) {
+                // SkReadBuffer needs aligned memory, so parse a temporary copy. What we
+                // keep from it can still reference the shared bytes.
+                storage = SkData::MakeWithCopy(shared->data(), size);
+            }
 
-            SkReadBuffer buffer(storage.get(), size);
+            SkReadBuffer buffer(storage->data(), size);
             buffer.setVersion(fInfo.getVersion());
+            if (sharedData) {
+                buffer.setBackingData(std::move(shared));
+            }
 
             if (!fFactoryPlayback) {
                 return false;
@@ -350,6 +483,9 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
                 // Newer .skp files serialize all typefaces with the top picture.
                 topLevelTFPlayback->setupBuffer(buffer);
             }
+            if (topLevelImagePlayback->count() > 0) {
+                topLevelImagePlayback->setupBuffer(buffer);
+            }
 
             while (!buffer.eof() && buffer.isValid()) {
                 tag = buffer.readUInt();
@@ -444,8 +580,8 @@ void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t
             if (!buffer.validateCanReadN<uint8_t>(size)) {
                 return;
             }
-            auto data(SkData::MakeUninitialized(size));
-            if (!buffer.readByteArray(data->writable_data(), size) ||
+            auto data = buffer.readByteArrayAsData();
+            if (!buffer.validate(data && data->size() == size) ||
                 !buffer.validate(nullptr == fOpData)) {
                 return;
             }
@@ -467,13 +603,19 @@ void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t
 SkPictureData* SkPictureData::CreateFromStream(SkStream* stream,
                                                const SkPictInfo& info,
                                                const SkDeserialProcs& procs,
-                                               SkTypefacePlayback* topLevelTFPlayback) {
+                                               SkTypefacePlayback* topLevelTFPlayback,
+                                               SkImagePlayback* topLevelImagePlayback,
+                                               const SkData* sharedData) {
     std::unique_ptr<SkPictureData> data(new SkPictureData(info));
     if (!topLevelTFPlayback) {
         topLevelTFPlayback = &data->fTFPlayback;
     }
+    if (!topLevelImagePlayback) {
+        topLevelImagePlayback = &data->fImagePlayback;
+    }
 
-    if (!data->parseStream(stream, procs, topLevelTFPlayback)) {
+    if (!data->parseStream(stream, procs, topLevelTFPlayback, topLevelImagePlayback,
+                           sharedData)) {
         return nullptr;
     }
     return data.release();
@@ -492,7 +634,9 @@ SkPictureData* SkPictureData::CreateFromBuffer(SkReadBuffer& buffer,
 
 bool SkPictureData::parseStream(SkStream* stream,
                                 const SkDeserialProcs& procs,
-                                SkTypefacePlayback* topLevelTFPlayback) {
+                                SkTypefacePlayback* topLevelTFPlayback,
+                                SkImagePlayback* topLevelImagePlayback,
+                                const SkData* sharedData) {
     for (;;) {
         uint32_t tag;
         if (!stream->readU32(&tag)) { return false; }
@@ -502,7 +646,8 @@ bool SkPictureData::parseStream(SkStream* stream,
 
         uint32_t size;
         if (!stream->readU32(&size)) { return false; }
-        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback)) {
+        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback,
+                                  topLevelImagePlayback, sharedData)) {
             return false; // we're invalid
         }
     }
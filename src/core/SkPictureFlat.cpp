@@ -19,3 +19,8 @@ void SkTypefacePlayback::setCount(size_t count) {
     fCount = count;
     fArray.reset(new sk_sp<SkTypeface>[count]);
 }
+
+void SkImagePlayback::setCount(size_t count) {
+    fCount = count;
+    fArray.reset(new sk_sp<SkImage>[count]);
+}
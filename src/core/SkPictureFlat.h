@@ -186,6 +186,29 @@ protected:
     std::unique_ptr<sk_sp<SkTypeface>[]> fArray;
 };
 
+// Images shared by a stream-format picture and all of its sub-pictures.
+class SkImagePlayback {
+public:
+    SkImagePlayback() : fCount(0), fArray(nullptr) {}
+
+    void setCount(size_t count);
+
+    size_t count() const { return fCount; }
+
+    sk_sp<SkImage>& operator[](size_t index) {
+        SkASSERT(index < fCount);
+        return fArray[index];
+    }
+
+    void setupBuffer(SkReadBuffer& buffer) const {
+        buffer.setImageArray(fArray.get(), fCount);
+    }
+
+private:
+    size_t fCount;
+    std::unique_ptr<sk_sp<SkImage>[]> fArray;
+};
+
 class SkFactoryPlayback {
 public:
     SkFactoryPlayback(int count) : fCount(count) { fArray = new SkFlattenable::Factory[count]; }
@@ -803,7 +803,12 @@ void SkPictureRecord::addMatrix(const SkMatrix& matrix) {
 
 void SkPictureRecord::addPaintPtr(const SkPaint* paint) {
     if (paint) {
+        if (int* n = fPaintIndices.find(*paint)) {
+            this->addInt(*n);
+            return;
+        }
         fPaints.push_back(*paint);
+        fPaintIndices.set(*paint, fPaints.count());
         this->addInt(fPaints.count());
     } else {
         this->addInt(0);
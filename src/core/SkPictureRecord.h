@@ -241,6 +241,12 @@ protected:
 private:
     SkTArray<SkPaint>  fPaints;
 
+    // Paints are recorded once; later draws with an equal paint refer back to the same index.
+    struct PaintHash {
+        uint32_t operator()(const SkPaint& p) { return p.getHash(); }
+    };
+    SkTHashMap<SkPaint, int, PaintHash> fPaintIndices;
+
     struct PathHash {
         uint32_t operator()(const SkPath& p) { return p.getGenerationID(); }
     };
@@ -64,7 +64,11 @@ sk_sp<SkPicture> SkPictureRecorder::finishRecordingAsPicture(uint32_t finishFlag
     }
 
     // TODO: delay as much of this work until just before first playback?
-    SkRecordOptimize(fRecord.get());
+    if (finishFlags & kOptimizeForPlayback_FinishFlag) {
+        SkRecordOptimizeForPlayback(fRecord.get(), fCullRect);
+    } else {
+        SkRecordOptimize(fRecord.get());
+    }
 
     SkDrawableList* drawableList = fRecorder->getDrawableList();
     SkBigPicture::SnapshotArray* pictList =
@@ -118,7 +122,11 @@ sk_sp<SkDrawable> SkPictureRecorder::finishRecordingAsDrawable(uint32_t finishFl
     fRecorder->flushMiniRecorder();
     fRecorder->restoreToCount(1);  // If we were missing any restores, add them now.
 
-    SkRecordOptimize(fRecord.get());
+    if (finishFlags & kOptimizeForPlayback_FinishFlag) {
+        SkRecordOptimizeForPlayback(fRecord.get(), fCullRect);
+    } else {
+        SkRecordOptimize(fRecord.get());
+    }
 
     if (fBBH.get()) {
         SkAutoTMalloc<SkRect> bounds(fRecord->count());
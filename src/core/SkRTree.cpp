@@ -6,13 +6,16 @@
  */
 
 #include "SkRTree.h"
+#include "SkMathPriv.h"
+#include "SkNx.h"
 
 SkRTree::SkRTree(SkScalar aspectRatio)
-    : fCount(0), fAspectRatio(isfinite(aspectRatio) ? aspectRatio : 1) {}
+    : fCount(0), fDepth(0), fFirstLeaf(0)
+    , fAspectRatio(isfinite(aspectRatio) ? aspectRatio : 1) {}
 
 SkRect SkRTree::getRootBound() const {
     if (fCount) {
-        return fRoot.fBounds;
+        return fRootBounds;
     } else {
         return SkRect::MakeEmpty();
     }
@@ -37,20 +40,64 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
 
     fCount = branches.count();
     if (fCount) {
+        Branch root;
         if (1 == fCount) {
             fNodes.setReserve(1);
             Node* n = this->allocateNodeAtLevel(0);
             n->fNumChildren = 1;
             n->fChildren[0] = branches[0];
-            fRoot.fSubtree = n;
-            fRoot.fBounds  = branches[0].fBounds;
+            root.fSubtree = n;
+            root.fBounds  = branches[0].fBounds;
         } else {
             fNodes.setReserve(CountNodes(fCount, fAspectRatio));
-            fRoot = this->bulkLoad(&branches);
+            root = this->bulkLoad(&branches);
         }
+        fRootBounds = root.fBounds;
+        fDepth = root.fSubtree->fLevel + 1;
+        this->pack(root.fSubtree);
+        fNodes.reset();
     }
 }
 
+void SkRTree::pack(const Node* root) {
+    fPackedNodes.setReserve(fNodes.count());
+
+    // Visiting the nodes breadth first packs each node's children next to each other, after the
+    // nodes of all the levels above them.
+    SkTDArray<const Node*> queue;
+    queue.setReserve(fNodes.count());
+    queue.push_back(root);
+    for (int i = 0; i < queue.count(); ++i) {
+        const Node* node = queue[i];
+        if (0 == node->fLevel && 0 != queue[fFirstLeaf]->fLevel) {
+            fFirstLeaf = i;
+        }
+        PackedNode* packed = fPackedNodes.append();
+        packed->fNumChildren = node->fNumChildren;
+        packed->fLevel = node->fLevel;
+        for (int k = 0; k < kLanes; ++k) {
+            if (k < node->fNumChildren) {
+                const Branch& child = node->fChildren[k];
+                packed->fLeft[k]   = child.fBounds.fLeft;
+                packed->fTop[k]    = child.fBounds.fTop;
+                packed->fRight[k]  = child.fBounds.fRight;
+                packed->fBottom[k] = child.fBounds.fBottom;
+                if (0 == node->fLevel) {
+                    packed->fChildren[k] = child.fOpIndex;
+                } else {
+                    packed->fChildren[k] = queue.count();
+                    queue.push_back(child.fSubtree);
+                }
+            } else {
+                packed->fLeft[k]   = packed->fTop[k]    =  SK_ScalarInfinity;
+                packed->fRight[k]  = packed->fBottom[k] = -SK_ScalarInfinity;
+                packed->fChildren[k] = -1;
+            }
+        }
+    }
+    SkASSERT(fPackedNodes.count() == fNodes.count());
+}
+
 SkRTree::Node* SkRTree::allocateNodeAtLevel(uint16_t level) {
     SkDEBUGCODE(Node* p = fNodes.begin());
     Node* out = fNodes.push();
@@ -162,28 +209,151 @@ SkRTree::Branch SkRTree::bulkLoad(SkTDArray<Branch>* branches, int level) {
     return this->bulkLoad(branches, level + 1);
 }
 
+// Returns a mask of the lanes where both x and y are true.
+static uint32_t both_true(const Sk4f& x, const Sk4f& y) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE1
+    return _mm_movemask_ps(_mm_and_ps(x.fVec, y.fVec));
+#else
+    uint32_t xBits[4], yBits[4];
+    x.store(xBits);
+    y.store(yBits);
+    uint32_t mask = 0;
+    for (int k = 0; k < 4; ++k) {
+        mask |= ((xBits[k] & yBits[k]) ? 1u : 0u) << k;
+    }
+    return mask;
+#endif
+}
+
+// Returns a mask with bit k set if the query intersects child k, testing four children at a time
+// the same way SkRect::Intersects() does. Unused lanes are inside out and never intersect.
+template <typename PackedNode, int kLanes>
+static uint32_t intersecting_children(const PackedNode& node, const SkRect& query) {
+    const Sk4f ql(query.fLeft), qt(query.fTop), qr(query.fRight), qb(query.fBottom);
+    uint32_t mask = 0;
+    for (int i = 0; i < kLanes; i += 4) {
+        Sk4f x = Sk4f::Max(Sk4f::Load(node.fLeft + i), ql) <
+                 Sk4f::Min(Sk4f::Load(node.fRight + i), qr),
+             y = Sk4f::Max(Sk4f::Load(node.fTop + i), qt) <
+                 Sk4f::Min(Sk4f::Load(node.fBottom + i), qb);
+        mask |= both_true(x, y) << i;
+    }
+    return mask;
+}
+
+// Returns the index of the lowest set bit of a non-zero mask.
+static int lowest_bit(uint32_t mask) {
+    SkASSERT(mask);
+    return 31 - SkCLZ(mask & (0u - mask));
+}
+
+// Does the query cover so much of the tree that nearly every leaf will be reached?
+static bool covers_most_of(const SkRect& query, const SkRect& root) {
+    SkRect overlap;
+    if (!overlap.intersect(query, root)) {
+        return false;
+    }
+    return 4 * overlap.width() * overlap.height() >= 3 * root.width() * root.height();
+}
+
 void SkRTree::search(const SkRect& query, SkTDArray<int>* results) const {
-    if (fCount > 0 && SkRect::Intersects(fRoot.fBounds, query)) {
-        this->search(fRoot.fSubtree, query, results);
+    if (fCount > 0 && SkRect::Intersects(fRootBounds, query)) {
+        if (covers_most_of(query, fRootBounds)) {
+            this->searchLeaves(query, results);
+        } else {
+            this->search(fPackedNodes[0], query, results);
+        }
     }
 }
 
-void SkRTree::search(Node* node, const SkRect& query, SkTDArray<int>* results) const {
-    for (int i = 0; i < node->fNumChildren; ++i) {
-        if (SkRect::Intersects(node->fChildren[i].fBounds, query)) {
-            if (0 == node->fLevel) {
-                results->push_back(node->fChildren[i].fOpIndex);
-            } else {
-                this->search(node->fChildren[i].fSubtree, query, results);
+void SkRTree::searchLeaves(const SkRect& query, SkTDArray<int>* results) const {
+    // The leaves are packed last, in op order, so sweeping them finds the same ops as walking
+    // the tree, with none of the inner nodes' tests or the recursion.  Nearly every op will be
+    // hit, so make room for all of them up front and write the hits straight into the array.
+    int* hits = results->append(fCount);
+    for (int i = fFirstLeaf; i < fPackedNodes.count(); ++i) {
+        const PackedNode& leaf = fPackedNodes[i];
+        SkASSERT(0 == leaf.fLevel);
+        for (uint32_t mask = intersecting_children<PackedNode, kLanes>(leaf, query); mask;
+             mask &= mask - 1) {
+            *hits++ = leaf.fChildren[lowest_bit(mask)];
+        }
+    }
+    results->setCount(SkToInt(hits - results->begin()));
+}
+
+void SkRTree::search(const PackedNode& node, const SkRect& query,
+                     SkTDArray<int>* results) const {
+    for (uint32_t mask = intersecting_children<PackedNode, kLanes>(node, query); mask;
+         mask &= mask - 1) {
+        int child = node.fChildren[lowest_bit(mask)];
+        if (0 == node.fLevel) {
+            results->push_back(child);
+        } else {
+            this->search(fPackedNodes[child], query, results);
+        }
+    }
+}
+
+void SkRTree::searchAll(const SkRect queries[], int count, SkTDArray<int> results[]) const {
+    if (0 == fCount) {
+        return;
+    }
+    // Each walk of the tree carries up to 32 queries, as a mask of those that reach each node.
+    for (int base = 0; base < count; base += 32) {
+        int n = SkTMin(count - base, 32);
+        uint32_t queryMask = 0;
+        for (int i = 0; i < n; ++i) {
+            if (SkRect::Intersects(fRootBounds, queries[base + i])) {
+                queryMask |= 1u << i;
             }
         }
+        if (queryMask) {
+            this->searchAll(fPackedNodes[0], queries + base, queryMask, results + base);
+        }
+    }
+}
+
+void SkRTree::searchAll(const PackedNode& node, const SkRect queries[], uint32_t queryMask,
+                        SkTDArray<int> results[]) const {
+    if (0 == node.fLevel) {
+        for (uint32_t mask = queryMask; mask; mask &= mask - 1) {
+            int q = lowest_bit(mask);
+            for (uint32_t children = intersecting_children<PackedNode, kLanes>(node, queries[q]);
+                 children; children &= children - 1) {
+                results[q].push_back(node.fChildren[lowest_bit(children)]);
+            }
+        }
+        return;
+    }
+    if (0 == (queryMask & (queryMask - 1))) {
+        // Only one query is left on this branch.
+        int q = lowest_bit(queryMask);
+        this->search(node, queries[q], &results[q]);
+        return;
+    }
+
+    // childQueries[k] is the mask of queries that intersect child k.
+    uint32_t childQueries[kLanes] = {};
+    uint32_t anyChildren = 0;
+    for (uint32_t mask = queryMask; mask; mask &= mask - 1) {
+        int q = lowest_bit(mask);
+        uint32_t children = intersecting_children<PackedNode, kLanes>(node, queries[q]);
+        anyChildren |= children;
+        for (; children; children &= children - 1) {
+            childQueries[lowest_bit(children)] |= 1u << q;
+        }
+    }
+    for (; anyChildren; anyChildren &= anyChildren - 1) {
+        int k = lowest_bit(anyChildren);
+        this->searchAll(fPackedNodes[node.fChildren[k]], queries, childQueries[k], results);
     }
 }
 
 size_t SkRTree::bytesUsed() const {
     size_t byteCount = sizeof(SkRTree);
 
-    byteCount += fNodes.reserved() * sizeof(Node);
+    byteCount += fPackedNodes.reserved() * sizeof(PackedNode);
 
     return byteCount;
 }
@@ -23,6 +23,11 @@
  * which groups rects by position on the Hilbert curve, is probably worth a look). There also
  * exist top-down bulk load variants (VAMSplit, TopDownGreedy, etc).
  *
+ * After the bulk load the tree is flattened into breadth-first order, with each node's child
+ * bounds stored as separate left, top, right and bottom arrays, so a search tests all of a node's
+ * children against the query with a few SIMD compares.  Since the leaves end up last and in
+ * insertion order, a query covering most of the tree skips the walk and sweeps them instead.
+ *
  * For more details see:
  *
  *  Beckmann, N.; Kriegel, H. P.; Schneider, R.; Seeger, B. (1990). "The R*-tree:
@@ -42,12 +47,13 @@ public:
 
     void insert(const SkRect[], int N) override;
     void search(const SkRect& query, SkTDArray<int>* results) const override;
+    void searchAll(const SkRect queries[], int count, SkTDArray<int> results[]) const override;
     size_t bytesUsed() const override;
 
     // Methods and constants below here are only public for tests.
 
     // Return the depth of the tree structure.
-    int getDepth() const { return fCount ? fRoot.fSubtree->fLevel + 1 : 0; }
+    int getDepth() const { return fCount ? fDepth : 0; }
     // Insertion count (not overall node count, which may be greater).
     int getCount() const { return fCount; }
 
@@ -61,6 +67,7 @@ public:
 private:
     struct Node;
 
+    // Branches and Nodes only exist while bulk loading.
     struct Branch {
         union {
             Node* fSubtree;
@@ -75,7 +82,22 @@ private:
         Branch fChildren[kMaxChildren];
     };
 
-    void search(Node* root, const SkRect& query, SkTDArray<int>* results) const;
+    // The searchable form of a Node. Children are the indices of nodes in fPackedNodes, or the op
+    // indices at level 0. Unused lanes have bounds that can't intersect anything.
+    static const int kLanes = 12;
+    static_assert(kMaxChildren <= kLanes && kLanes % 4 == 0, "");
+    struct PackedNode {
+        float fLeft[kLanes], fTop[kLanes], fRight[kLanes], fBottom[kLanes];
+        int32_t fChildren[kLanes];
+        uint16_t fNumChildren;
+        uint16_t fLevel;
+    };
+
+    void search(const PackedNode&, const SkRect& query, SkTDArray<int>* results) const;
+    // For queries that cover most of the tree: tests every leaf in turn instead.
+    void searchLeaves(const SkRect& query, SkTDArray<int>* results) const;
+    void searchAll(const PackedNode&, const SkRect queries[], uint32_t queryMask,
+                   SkTDArray<int> results[]) const;
 
     // Consumes the input array.
     Branch bulkLoad(SkTDArray<Branch>* branches, int level = 0);
@@ -85,11 +107,17 @@ private:
 
     Node* allocateNodeAtLevel(uint16_t level);
 
+    // Copies the tree under root into fPackedNodes, breadth first.
+    void pack(const Node* root);
+
     // This is the count of data elements (rather than total nodes in the tree)
     int fCount;
+    int fDepth;
+    int fFirstLeaf;  // Index of the first level 0 node in fPackedNodes.
     SkScalar fAspectRatio;
-    Branch fRoot;
+    SkRect fRootBounds;
     SkTDArray<Node> fNodes;
+    SkTDArray<PackedNode> fPackedNodes;
 
     typedef SkBBoxHierarchy INHERITED;
 };
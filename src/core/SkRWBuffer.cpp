@@ -9,6 +9,8 @@
 
 #include "SkMakeUnique.h"
 #include "SkMalloc.h"
+#include "SkMutex.h"
+#include "SkSpinlock.h"
 #include "SkStream.h"
 #include "SkTo.h"
 
@@ -18,6 +20,28 @@
 // Force small chunks to be a page's worth
 static const size_t kMinAllocSize = 4096;
 
+// Minimum-sized blocks are by far the most common (streaming appends are small), so finished
+// buffers hand theirs back to a small process-wide pool for the next append to reuse.
+static const int kMaxPooledBlocks = 64;
+
+static SkSpinlock gBlockPoolLock;
+static void*      gBlockPool[kMaxPooledBlocks];
+static int        gBlockPoolCount = 0;
+
+static void* acquire_pooled_block() {
+    SkAutoExclusive lock(gBlockPoolLock);
+    return gBlockPoolCount > 0 ? gBlockPool[--gBlockPoolCount] : nullptr;
+}
+
+static bool release_pooled_block(void* block) {
+    SkAutoExclusive lock(gBlockPoolLock);
+    if (gBlockPoolCount < kMaxPooledBlocks) {
+        gBlockPool[gBlockPoolCount++] = block;
+        return true;
+    }
+    return false;
+}
+
 struct SkBufferBlock {
     SkBufferBlock*  fNext;      // updated by the writer
     size_t          fUsed;      // updated by the writer
@@ -32,10 +56,23 @@ struct SkBufferBlock {
 
     static SkBufferBlock* Alloc(size_t length) {
         size_t capacity = LengthToCapacity(length);
-        void* buffer = sk_malloc_throw(sizeof(SkBufferBlock) + capacity);
+        void* buffer = nullptr;
+        if (capacity == PooledCapacity()) {
+            buffer = acquire_pooled_block();
+        }
+        if (!buffer) {
+            buffer = sk_malloc_throw(sizeof(SkBufferBlock) + capacity);
+        }
         return new (buffer) SkBufferBlock(capacity);
     }
 
+    static void Free(SkBufferBlock* block) {
+        if (block->fCapacity == PooledCapacity() && release_pooled_block(block)) {
+            return;
+        }
+        sk_free(block);
+    }
+
     // Return number of bytes actually appended. Important that we always completely this block
     // before spilling into the next, since the reader uses fCapacity to know how many it can read.
     //
@@ -58,8 +95,11 @@ struct SkBufferBlock {
     }
 
 private:
+    // Capacity of a minimum-sized block, the only size that is pooled.
+    static size_t PooledCapacity() { return kMinAllocSize - sizeof(SkBufferBlock); }
+
     static size_t LengthToCapacity(size_t length) {
-        const size_t minSize = kMinAllocSize - sizeof(SkBufferBlock);
+        const size_t minSize = PooledCapacity();
         return SkTMax(length, minSize);
     }
 };
@@ -96,7 +136,7 @@ struct SkBufferHead {
             sk_free((void*)this);
             while (block) {
                 SkBufferBlock* next = block->fNext;
-                sk_free(block);
+                SkBufferBlock::Free(block);
                 block = next;
             }
         }
@@ -314,10 +354,34 @@ public:
         return bytesRead;
     }
 
+    size_t peek(void* dst, size_t request) const override {
+        SkROBuffer::Iter iter = fIter;
+        size_t offset = fLocalOffset;
+        size_t bytesPeeked = 0;
+        while (bytesPeeked < request) {
+            size_t avail = SkTMin(iter.size() - offset, request - bytesPeeked);
+            if (avail > 0) {
+                memcpy((char*)dst + bytesPeeked, (const char*)iter.data() + offset, avail);
+                bytesPeeked += avail;
+            }
+            offset = 0;
+            if (bytesPeeked < request && !iter.next()) {
+                break;
+            }
+        }
+        return bytesPeeked;
+    }
+
     bool isAtEnd() const override {
         return fBuffer->size() == fGlobalOffset;
     }
 
+    // When everything fits in the first block, codecs can read it in place.
+    const void* getMemoryBase() override {
+        SkROBuffer::Iter iter(fBuffer);
+        return iter.size() == fBuffer->size() ? iter.data() : nullptr;
+    }
+
     size_t getPosition() const override {
         return fGlobalOffset;
     }
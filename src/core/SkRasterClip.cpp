@@ -243,6 +243,10 @@ bool SkRasterClip::setPath(const SkPath& path, const SkRegion& clip, bool doAA)
 
 bool SkRasterClip::op(const SkRRect& rrect, const SkMatrix& matrix, const SkIRect& devBounds,
                       SkRegion::Op op, bool doAA) {
+    if (rrect.isRect()) {
+        return this->op(rrect.rect(), matrix, devBounds, op, doAA);
+    }
+
     SkIRect bounds(devBounds);
     this->applyClipRestriction(op, &bounds);
 
@@ -399,6 +403,25 @@ bool SkRasterClip::op(const SkRect& localRect, const SkMatrix& matrix, const SkI
     return this->updateCacheAndReturnNonEmpty();
 }
 
+bool SkRasterClip::quickIntersectIsNoop(const SkRect& localRect, const SkMatrix& matrix,
+                                        bool doAA) const {
+    if (fIsEmpty) {
+        return true;
+    }
+    if (!fIsBW || !fIsRect || !matrix.isScaleTranslate()) {
+        return false;
+    }
+    SkRect devRect;
+    matrix.mapRect(&devRect, localRect);
+    if (!doAA) {
+        SkIRect ir;
+        devRect.round(&ir);
+        return ir.contains(fBW.getBounds());
+    }
+    // Every pixel of the clip lies inside an antialiased devRect, so keeps full coverage.
+    return devRect.contains(SkRect::Make(fBW.getBounds()));
+}
+
 void SkRasterClip::translate(int dx, int dy, SkRasterClip* dst) const {
     if (nullptr == dst) {
         return;
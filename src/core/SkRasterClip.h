@@ -98,6 +98,13 @@ public:
     bool op(const SkRRect&, const SkMatrix& matrix, const SkIRect&, SkRegion::Op, bool doAA);
     bool op(const SkPath&, const SkMatrix& matrix, const SkIRect&, SkRegion::Op, bool doAA);
 
+    /**
+     *  Returns true if intersecting with localRect, mapped by matrix, would leave this clip as it
+     *  is, e.g. when the rect contains a rectangular clip. Callers can then skip the op, and any
+     *  copy of the clip they would have made to apply it to.
+     */
+    bool quickIntersectIsNoop(const SkRect& localRect, const SkMatrix& matrix, bool doAA) const;
+
     void translate(int dx, int dy, SkRasterClip* dst) const;
     void translate(int dx, int dy) {
         this->translate(dx, dy, this);
@@ -10,6 +10,7 @@
 
 #include "SkClipOp.h"
 #include "SkDeque.h"
+#include "SkRRect.h"
 #include "SkRasterClip.h"
 #include <new>
 
@@ -100,12 +101,20 @@ public:
     }
 
     void clipRect(const SkMatrix& ctm, const SkRect& rect, SkClipOp op, bool aa) {
+        if (SkClipOp::kIntersect == op && this->rc().quickIntersectIsNoop(rect, ctm, aa)) {
+            // The clip does not change, so a deferred save can stay deferred.
+            return;
+        }
         this->writable_rc().op(rect, ctm, fRootBounds, (SkRegion::Op)op, aa);
         this->trimIfExpanding(op);
         this->validate();
     }
 
     void clipRRect(const SkMatrix& ctm, const SkRRect& rrect, SkClipOp op, bool aa) {
+        if (rrect.isRect()) {
+            this->clipRect(ctm, rrect.rect(), op, aa);
+            return;
+        }
         this->writable_rc().op(rrect, ctm, fRootBounds, (SkRegion::Op)op, aa);
         this->trimIfExpanding(op);
         this->validate();
@@ -7,7 +7,22 @@
 
 #include "SkRasterPipeline.h"
 #include "SkOpts.h"
+#include "SkTArray.h"
 #include <algorithm>
+#include <atomic>
+
+static std::atomic<bool> gCountBuilds{false};
+static std::atomic<int>  gLowpBuilds{0};
+static std::atomic<int>  gHighpBuilds{0};
+
+void SkRasterPipeline::SetCountBuilds(bool count) {
+    gCountBuilds.store(count, std::memory_order_relaxed);
+}
+
+void SkRasterPipeline::GetBuildCounts(int* lowp, int* highp) {
+    *lowp  =  gLowpBuilds.exchange(0, std::memory_order_relaxed);
+    *highp = gHighpBuilds.exchange(0, std::memory_order_relaxed);
+}
 
 SkRasterPipeline::SkRasterPipeline(SkArenaAlloc* alloc) : fAlloc(alloc) {
     this->reset();
@@ -255,13 +270,121 @@ void SkRasterPipeline::append_gamut_clamp_if_normalized(const SkImageInfo& dstIn
     }
 }
 
-SkRasterPipeline::StartPipelineFn SkRasterPipeline::build_pipeline(void** ip) const {
+const SkRasterPipeline::StageList* SkRasterPipeline::fuse(int* slotsNeeded) const {
+    *slotsNeeded = fSlotsNeeded;
+
+    // Walk the stages front to back.
+    SkSTArray<32, const StageList*> stages;
+    for (const StageList* st = fStages; st; st = st->prev) {
+        stages.push_back(st);
+    }
+    std::reverse(stages.begin(), stages.end());
+    const int n = stages.count();
+
+    auto is = [&](int i, StockStage stage) {
+        return i < n && !stages[i]->rawFunction && stages[i]->stage == (uint64_t)stage;
+    };
+
+    SkSTArray<32, StageList> fused;
+    auto emit = [&](StockStage stage, void* ctx) {
+        fused.push_back(StageList{nullptr, (uint64_t)stage, ctx, false});
+    };
+
+    bool changed = false;
+    for (int i = 0; i < n; ) {
+        const int rest = n - i;
+
+        // seed_shader, matrix_{translate,scale_translate,2x3} -> seed_shader_matrix_2x3.
+        // The translate and scale-translate forms are exactly a 2x3 with zeros and ones.
+        if (is(i, seed_shader) && (is(i+1, matrix_2x3) ||
+                                   is(i+1, matrix_scale_translate) ||
+                                   is(i+1, matrix_translate))) {
+            auto src = (const float*)stages[i+1]->ctx;
+            float* m;
+            if (is(i+1, matrix_2x3)) {
+                m = (float*)stages[i+1]->ctx;
+            } else if (is(i+1, matrix_scale_translate)) {
+                m = fAlloc->makeArray<float>(6);
+                m[0] = src[0]; m[3] = src[1];
+                m[4] = src[2]; m[5] = src[3];
+            } else {
+                m = fAlloc->makeArray<float>(6);
+                m[0] = m[3] = 1;
+                m[4] = src[0]; m[5] = src[1];
+            }
+            emit(seed_shader_matrix_2x3, m);
+            i += 2;
+            changed = true;
+            continue;
+        }
+
+        // The compound srcover stages leave dst in [0,255] and src unclamped, so we only use
+        // them when their store ends the pipeline and nothing can observe the difference.
+        auto srcover_8888_at = [&](int j, int* len) {
+            if (is(j, load_8888_dst) && is(j+1, srcover) && is(j+2, store_8888) &&
+                stages[j]->ctx == stages[j+2]->ctx && j+3 == n) {
+                *len = 3;
+                return true;
+            }
+            return false;
+        };
+
+        // [scale_u8,] load_8888_dst, srcover, store_8888 -> [scale_u8_]srcover_rgba_8888.
+        int len;
+        if (is(i, scale_u8) && srcover_8888_at(i+1, &len)) {
+            auto ctx = fAlloc->make<SkRasterPipeline_MaskedMemoryCtx>();
+            ctx->mask = (const SkRasterPipeline_MemoryCtx*)stages[i]->ctx;
+            ctx->dst  = (const SkRasterPipeline_MemoryCtx*)stages[i+1]->ctx;
+            emit(scale_u8_srcover_rgba_8888, ctx);
+            i += 1 + len;
+            changed = true;
+            continue;
+        }
+        if (srcover_8888_at(i, &len)) {
+            emit(srcover_rgba_8888, stages[i]->ctx);
+            i += len;
+            changed = true;
+            continue;
+        }
+
+        // BGRA dst: load_8888_dst, swap_rb_dst, srcover, swap_rb, store_8888
+        //        -> swap_rb, srcover_rgba_8888.
+        if (rest == 5 && is(i, load_8888_dst) && is(i+1, swap_rb_dst) && is(i+2, srcover) &&
+                         is(i+3, swap_rb) && is(i+4, store_8888) &&
+                         stages[i]->ctx == stages[i+4]->ctx) {
+            emit(swap_rb, nullptr);
+            emit(srcover_rgba_8888, stages[i]->ctx);
+            i += 5;
+            changed = true;
+            continue;
+        }
+
+        fused.push_back(*stages[i]);
+        i += 1;
+    }
+
+    if (!changed) {
+        return fStages;
+    }
+
+    auto list = fAlloc->makeArrayDefault<StageList>(fused.count());
+    *slotsNeeded = 1;  // just_return()
+    for (int i = 0; i < fused.count(); i++) {
+        list[i]      = fused[i];
+        list[i].prev = i > 0 ? &list[i-1] : nullptr;
+        *slotsNeeded += list[i].ctx ? 2 : 1;
+    }
+    return &list[fused.count() - 1];
+}
+
+SkRasterPipeline::StartPipelineFn SkRasterPipeline::BuildPipeline(const StageList* stages,
+                                                                  void** ip) {
     // We'll try to build a lowp pipeline, but if that fails fallback to a highp float pipeline.
     void** reset_point = ip;
 
-    // Stages are stored backwards in fStages, so we reverse here, back to front.
+    // Stages are stored backwards in the list, so we reverse here, back to front.
     *--ip = (void*)SkOpts::just_return_lowp;
-    for (const StageList* st = fStages; st; st = st->prev) {
+    for (const StageList* st = stages; st; st = st->prev) {
         SkOpts::StageFn fn;
         if (!st->rawFunction && (fn = SkOpts::stages_lowp[st->stage])) {
             if (st->ctx) {
@@ -274,11 +397,18 @@ SkRasterPipeline::StartPipelineFn SkRasterPipeline::build_pipeline(void** ip) co
         }
     }
     if (ip != reset_point) {
+        if (gCountBuilds.load(std::memory_order_relaxed)) {
+            gLowpBuilds.fetch_add(1, std::memory_order_relaxed);
+        }
         return SkOpts::start_pipeline_lowp;
     }
 
+    if (gCountBuilds.load(std::memory_order_relaxed)) {
+        gHighpBuilds.fetch_add(1, std::memory_order_relaxed);
+    }
+
     *--ip = (void*)SkOpts::just_return_highp;
-    for (const StageList* st = fStages; st; st = st->prev) {
+    for (const StageList* st = stages; st; st = st->prev) {
         if (st->ctx) {
             *--ip = st->ctx;
         }
@@ -297,9 +427,10 @@ void SkRasterPipeline::run(size_t x, size_t y, size_t w, size_t h) const {
     }
 
     // Best to not use fAlloc here... we can't bound how often run() will be called.
+    // That also means no fusion, which may need to allocate.
     SkAutoSTMalloc<64, void*> program(fSlotsNeeded);
 
-    auto start_pipeline = this->build_pipeline(program.get() + fSlotsNeeded);
+    auto start_pipeline = BuildPipeline(fStages, program.get() + fSlotsNeeded);
     start_pipeline(x,y,x+w,y+h, program.get());
 }
 
@@ -308,9 +439,12 @@ std::function<void(size_t, size_t, size_t, size_t)> SkRasterPipeline::compile()
         return [](size_t, size_t, size_t, size_t) {};
     }
 
-    void** program = fAlloc->makeArray<void*>(fSlotsNeeded);
+    int slotsNeeded;
+    const StageList* stages = this->fuse(&slotsNeeded);
+
+    void** program = fAlloc->makeArray<void*>(slotsNeeded);
 
-    auto start_pipeline = this->build_pipeline(program + fSlotsNeeded);
+    auto start_pipeline = BuildPipeline(stages, program + slotsNeeded);
     return [=](size_t x, size_t y, size_t w, size_t h) {
         start_pipeline(x,y,x+w,y+h, program);
     };
@@ -50,7 +50,8 @@
     M(load_8888) M(load_8888_dst) M(store_8888) M(gather_8888)     \
     M(load_1010102) M(load_1010102_dst) M(store_1010102) M(gather_1010102) \
     M(alpha_to_gray) M(alpha_to_gray_dst) M(luminance_to_alpha)    \
-    M(bilerp_clamp_8888)                                           \
+    M(bilerp_clamp_8888) M(bilerp_tiled_8888)                      \
+    M(bicubic_8888) M(bicubic_f16)                                 \
     M(store_u16_be)                                                \
     M(load_rgba) M(store_rgba)                                     \
     M(scale_u8) M(scale_565) M(scale_1_float)                      \
@@ -61,11 +62,12 @@
     M(colorburn) M(colordodge) M(darken) M(difference)             \
     M(exclusion) M(hardlight) M(lighten) M(overlay) M(softlight)   \
     M(hue) M(saturation) M(color) M(luminosity)                    \
-    M(srcover_rgba_8888)                                           \
+    M(srcover_rgba_8888) M(scale_u8_srcover_rgba_8888)             \
+    M(seed_shader_matrix_2x3)                                      \
     M(matrix_translate) M(matrix_scale_translate)                  \
     M(matrix_2x3) M(matrix_3x3) M(matrix_3x4) M(matrix_4x5) M(matrix_4x3) \
     M(matrix_perspective)                                          \
-    M(parametric) M(gamma)                                         \
+    M(parametric) M(gamma) M(xform_lut)                            \
     M(mirror_x)   M(repeat_x)                                      \
     M(mirror_y)   M(repeat_y)                                      \
     M(decal_x)    M(decal_y)   M(decal_x_and_y)                    \
@@ -79,6 +81,8 @@
     M(evenly_spaced_gradient)                                      \
     M(gradient)                                                    \
     M(evenly_spaced_2_stop_gradient)                               \
+    M(gradient_lut_8888)                                           \
+    M(perlin_noise)                                                \
     M(xy_to_unit_angle)                                            \
     M(xy_to_radius)                                                \
     M(xy_to_2pt_conical_strip)                                     \
@@ -127,6 +131,16 @@ struct SkRasterPipeline_TileCtx {
     float invScale; // cache of 1/scale
 };
 
+// The fused bilerp_tiled_8888 and bicubic_* samplers tile each sample point on its own before
+// gathering it.
+struct SkRasterPipeline_TiledGatherCtx {
+    enum TileMode { kClamp, kRepeat, kMirror };
+
+    SkRasterPipeline_GatherCtx gather;
+    SkRasterPipeline_TileCtx   tileX, tileY;
+    TileMode                   tileModeX, tileModeY;
+};
+
 struct SkRasterPipeline_DecalTileCtx {
     uint32_t mask[SkRasterPipeline_kMaxStride];
     float    limit_x;
@@ -156,6 +170,25 @@ struct SkRasterPipeline_EvenlySpaced2StopGradientCtx {
     bool interpolatedInPremul;
 };
 
+// Samples t in [0,1] from a 1 x N 8888 LUT the way a GPU filters a texture, lerping the two
+// entries whose centers are nearest t.
+struct SkRasterPipeline_GradientLUTCtx {
+    const uint32_t* lut;
+    float           scale;  // N
+    float           limit;  // N - 1, the index of the last entry
+};
+
+// Evaluates SkPerlinNoiseShader's fractal noise or turbulence at whole pixels.
+struct SkRasterPipeline_PerlinNoiseCtx {
+    const uint8_t* latticeSelector;  // 256 entries
+    const float*   gradients;        // 4 channels x 256 entries x (x,y)
+    const int*     stitch;           // wrapX, width, wrapY, height per octave, or null
+    float          offsetX, offsetY; // from device space to the noise's pixel grid
+    float          baseFrequencyX, baseFrequencyY;
+    int            numOctaves;
+    bool           fractalNoise;     // otherwise turbulence
+};
+
 struct SkRasterPipeline_2PtConicalCtx {
     uint32_t fMask[SkRasterPipeline_kMaxStride];
     float    fP0,
@@ -167,6 +200,20 @@ struct SkRasterPipeline_UniformColorCtx {
     uint16_t rgba[4];  // [0,255] in a 16-bit lane.
 };
 
+// Used by xform_lut, fused from linearize, matrix_3x3, and encode.  Both tables are lerped,
+// extrapolating past 1, and like parametric they mirror negative values.
+struct SkRasterPipeline_XformLUTCtx {
+    float linearize[256];  // srcTF at i/255
+    float encode[1024];    // dstTFInv at i/1023
+    float matrix[9];       // column-major gamut transform
+};
+
+// Used by scale_u8_srcover_rgba_8888, fused from scale_u8 and srcover_rgba_8888.
+struct SkRasterPipeline_MaskedMemoryCtx {
+    const SkRasterPipeline_MemoryCtx* mask;
+    const SkRasterPipeline_MemoryCtx* dst;
+};
+
 struct SkRasterPipeline_EmbossCtx {
     SkRasterPipeline_MemoryCtx mul,
                                add;
@@ -235,6 +282,11 @@ public:
 
     bool empty() const { return fStages == nullptr; }
 
+    // While counting is on, tallies every pipeline built by run() or compile() by the precision
+    // it ended up in, so tools can tell which work fell back from lowp to highp.  Off by default.
+    static void SetCountBuilds(bool);
+    // Reads and resets the tallies.
+    static void GetBuildCounts(int* lowp, int* highp);
 
 private:
     struct StageList {
@@ -245,7 +297,11 @@ private:
     };
 
     using StartPipelineFn = void(*)(size_t,size_t,size_t,size_t, void** program);
-    StartPipelineFn build_pipeline(void**) const;
+    static StartPipelineFn BuildPipeline(const StageList*, void**);
+
+    // Returns fStages with common runs of stages replaced by equivalent compound stages,
+    // allocating any new list and contexts in fAlloc.  Sets *slotsNeeded for the result.
+    const StageList* fuse(int* slotsNeeded) const;
 
     void unchecked_append(StockStage, void*);
 
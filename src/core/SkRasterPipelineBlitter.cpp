@@ -25,7 +25,7 @@ public:
     // This is our common entrypoint for creating the blitter once we've sorted out shaders.
     static SkBlitter* Create(const SkPixmap&, const SkPaint&, SkArenaAlloc*,
                              const SkRasterPipeline& shaderPipeline,
-                             bool is_opaque, bool is_constant);
+                             bool is_opaque, bool is_constant, int shader_stride);
 
     SkRasterPipelineBlitter(SkPixmap dst,
                             SkBlendMode blend,
@@ -62,6 +62,11 @@ private:
     void   (*fMemset2D)(SkPixmap*, int x,int y, int w,int h, uint64_t color) = nullptr;
     uint64_t fMemsetColor = 0;   // Big enough for largest memsettable dst format, F16.
 
+    // If the color pipeline reads (x,y) only to address memory with this row stride in pixels,
+    // a rect exactly that wide is contiguous there, and in the dst if it's that wide too.
+    // 0 means the color pipeline doesn't read (x,y) at all, -1 that it uses them otherwise.
+    int fColorStride = -1;
+
     // Built lazily on first use.
     std::function<void(size_t, size_t, size_t, size_t)> fBlitRect,
                                                         fBlitAntiH,
@@ -103,19 +108,23 @@ SkBlitter* SkCreateRasterPipelineBlitter(const SkPixmap& dst,
         bool is_opaque    = paintColor.fA == 1.0f,
              is_constant  = true;
         return SkRasterPipelineBlitter::Create(dst, paint, alloc,
-                                               shaderPipeline, is_opaque, is_constant);
+                                               shaderPipeline, is_opaque, is_constant,
+                                               /*shader_stride=*/0);
     }
 
     bool is_opaque    = shader->isOpaque() && paintColor.fA == 1.0f;
     bool is_constant  = shader->isConstant();
 
-    if (shader->appendStages({&shaderPipeline, alloc, dstCT, dstCS, paint, nullptr, ctm})) {
+    const SkIRect dstBounds = dst.bounds();
+    if (shader->appendStages({&shaderPipeline, alloc, dstCT, dstCS, paint, nullptr, ctm,
+                              &dstBounds})) {
         if (paintColor.fA != 1.0f) {
             shaderPipeline.append(SkRasterPipeline::scale_1_float,
                                   alloc->make<float>(paintColor.fA));
         }
         return SkRasterPipelineBlitter::Create(dst, paint, alloc,
-                                               shaderPipeline, is_opaque, is_constant);
+                                               shaderPipeline, is_opaque, is_constant,
+                                               /*shader_stride=*/-1);
     }
 
     // The shader has opted out of drawing anything.
@@ -126,10 +135,11 @@ SkBlitter* SkCreateRasterPipelineBlitter(const SkPixmap& dst,
                                          const SkPaint& paint,
                                          const SkRasterPipeline& shaderPipeline,
                                          bool is_opaque,
-                                         SkArenaAlloc* alloc) {
+                                         SkArenaAlloc* alloc,
+                                         int shader_stride) {
     bool is_constant = false;  // If this were the case, it'd be better to just set a paint color.
     return SkRasterPipelineBlitter::Create(dst, paint, alloc,
-                                           shaderPipeline, is_opaque, is_constant);
+                                           shaderPipeline, is_opaque, is_constant, shader_stride);
 }
 
 SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
@@ -137,7 +147,8 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
                                            SkArenaAlloc* alloc,
                                            const SkRasterPipeline& shaderPipeline,
                                            bool is_opaque,
-                                           bool is_constant) {
+                                           bool is_constant,
+                                           int shader_stride) {
     auto blitter = alloc->make<SkRasterPipelineBlitter>(dst,
                                                         paint.getBlendMode(),
                                                         alloc);
@@ -176,6 +187,11 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
     }
     is_constant = is_constant && (blitter->fDitherRate == 0.0f);
 
+    // Color filters don't read (x,y), but dithering does.
+    if (blitter->fDitherRate == 0.0f) {
+        blitter->fColorStride = is_constant ? 0 : shader_stride;
+    }
+
     // We're logically done here.  The code between here and return blitter is all optimization.
 
     // A pipeline that's still constant here can collapse back into a constant color.
@@ -308,6 +324,12 @@ void SkRasterPipelineBlitter::blitRect(int x, int y, int w, int h) {
         fBlitRect = p.compile();
     }
 
+    // When these rows are contiguous in all the memory the pipeline touches,
+    // run them as one long row, saving the per-row setup and all but one tail.
+    if (h > 1 && w == fDstPtr.stride && (fColorStride == 0 || fColorStride == w)) {
+        fBlitRect(x,y, (size_t)w*h,1);
+        return;
+    }
     fBlitRect(x,y,w,h);
 }
 
@@ -5,7 +5,6 @@
  * found in the LICENSE file.
  */
 
-#include "SkAutoMalloc.h"
 #include "SkBitmap.h"
 #include "SkData.h"
 #include "SkImage.h"
@@ -45,6 +44,9 @@ SkReadBuffer::SkReadBuffer() {
     fTFArray = nullptr;
     fTFCount = 0;
 
+    fImageArray = nullptr;
+    fImageCount = 0;
+
     fFactoryArray = nullptr;
     fFactoryCount = 0;
 }
@@ -56,6 +58,9 @@ SkReadBuffer::SkReadBuffer(const void* data, size_t size) {
     fTFArray = nullptr;
     fTFCount = 0;
 
+    fImageArray = nullptr;
+    fImageCount = 0;
+
     fFactoryArray = nullptr;
     fFactoryCount = 0;
 }
@@ -95,6 +100,19 @@ void SkReadBuffer::setDeserialProcs(const SkDeserialProcs& procs) {
     fProcs = procs;
 }
 
+void SkReadBuffer::setBackingData(sk_sp<SkData> data) {
+    SkASSERT(!data || data->size() == fReader.size());
+    fBackingData = std::move(data);
+}
+
+sk_sp<SkData> SkReadBuffer::shareOrCopy(const void* src, size_t size) const {
+    if (fBackingData) {
+        return SkData::MakeSubset(fBackingData.get(),
+                                  (const uint8_t*)src - (const uint8_t*)fReader.base(), size);
+    }
+    return SkData::MakeWithCopy(src, size);
+}
+
 bool SkReadBuffer::readBool() {
     uint32_t value = this->readUInt();
     // Boolean value should be either 0 or 1
@@ -257,12 +275,9 @@ sk_sp<SkData> SkReadBuffer::readByteArrayAsData() {
         return nullptr;
     }
 
-    SkAutoMalloc buffer(numBytes);
-    if (!this->readByteArray(buffer.get(), numBytes)) {
-        return nullptr;
-    }
-
-    return SkData::MakeFromMalloc(buffer.release(), numBytes);
+    (void)this->readUInt();
+    const void* src = this->skip(numBytes);
+    return src ? this->shareOrCopy(src, numBytes) : nullptr;
 }
 
 uint32_t SkReadBuffer::getArrayCount() {
@@ -278,6 +293,15 @@ uint32_t SkReadBuffer::getArrayCount() {
  *  data [ encoded, with raw width/height ]
  */
 sk_sp<SkImage> SkReadBuffer::readImage() {
+    if (fImageArray) {
+        // The picture wrote its images once, up front; this is a base-1 index into them.
+        int32_t index = this->read32();
+        if (!this->validate(index > 0 && index <= fImageCount)) {
+            return nullptr;
+        }
+        return fImageArray[index - 1];
+    }
+
     SkIRect bounds;
     if (this->isVersionLT(kStoreImageBounds_Version)) {
         bounds.fLeft = bounds.fTop = 0;
@@ -319,11 +343,12 @@ sk_sp<SkImage> SkReadBuffer::readImage() {
         return nullptr;
     }
 
-    sk_sp<SkData> data = SkData::MakeUninitialized(size);
-    if (!this->readPad32(data->writable_data(), size)) {
+    const void* src = this->skip(size);
+    if (!src) {
         this->validate(false);
         return nullptr;
     }
+    sk_sp<SkData> data = this->shareOrCopy(src, size);
     if (this->isVersionLT(kDontNegateImageSize_Version)) {
         (void)this->read32();   // originX
         (void)this->read32();   // originY
@@ -391,7 +416,7 @@ SkFlattenable* SkReadBuffer::readFlattenable(SkFlattenable::Type ft) {
             this->readString(&name);
 
             factory = SkFlattenable::NameToFactory(name.c_str());
-            fFlattenableDict.set(fFlattenableDict.count() + 1, factory);
+            fFlattenableDict.push_back(factory);
         } else {
             // Read the index.  We are guaranteed that the first byte
             // is zeroed, so we must shift down a byte.
@@ -400,8 +425,8 @@ SkFlattenable* SkReadBuffer::readFlattenable(SkFlattenable::Type ft) {
                 return nullptr; // writer failed to give us the flattenable
             }
 
-            if (SkFlattenable::Factory* found = fFlattenableDict.find(index)) {
-                factory = *found;
+            if (index <= (uint32_t)fFlattenableDict.count()) {
+                factory = fFlattenableDict[index - 1];
             }
         }
 
@@ -21,6 +21,7 @@
 #include "SkReader32.h"
 #include "SkRefCnt.h"
 #include "SkShaderBase.h"
+#include "SkTDArray.h"
 #include "SkWriteBuffer.h"
 
 class SkData;
@@ -47,6 +48,7 @@ public:
         kSaveBehind_Version                = 66,
         kSerializeFonts_Version            = 67,
         kPaintDoesntSerializeFonts_Version = 68,
+        kSharedImages_Version              = 69,
     };
 
     /**
@@ -156,6 +158,15 @@ public:
         fTFCount = count;
     }
 
+    /**
+     *  Call this with the images shared by a stream-format picture and its sub-pictures.
+     *  readImage() then reads an index into this array instead of an encoded image.
+     */
+    void setImageArray(sk_sp<SkImage> array[], int count) {
+        fImageArray = array;
+        fImageCount = count;
+    }
+
     /**
      *  Call this with a pre-loaded array of Factories, in the same order as
      *  were created/written by the writer. SkPicture uses this.
@@ -168,6 +179,13 @@ public:
     void setDeserialProcs(const SkDeserialProcs& procs);
     const SkDeserialProcs& getDeserialProcs() const { return fProcs; }
 
+    /**
+     *  Call this if data holds the same bytes as the memory being read (it may even be that
+     *  memory). Encoded images and byte arrays will then reference data instead of making
+     *  copies of their own.
+     */
+    void setBackingData(sk_sp<SkData> data);
+
     /**
      *  If isValid is false, sets the buffer to be "invalid". Returns true if the buffer
      *  is still valid.
@@ -211,17 +229,24 @@ private:
     void setInvalid();
     bool readArray(void* value, size_t size, size_t elementSize);
     void setMemory(const void*, size_t);
+    // Returns the size bytes at src, shared from fBackingData if there is one.
+    sk_sp<SkData> shareOrCopy(const void* src, size_t size) const;
 
     SkReader32 fReader;
+    sk_sp<SkData> fBackingData;
 
-    // Only used if we do not have an fFactoryArray.
-    SkTHashMap<uint32_t, SkFlattenable::Factory> fFlattenableDict;
+    // Only used if we do not have an fFactoryArray. The writer numbers factory names as it
+    // first writes them, so the factory for index i is simply at [i - 1].
+    SkTDArray<SkFlattenable::Factory> fFlattenableDict;
 
     int fVersion;
 
     sk_sp<SkTypeface>* fTFArray;
     int                fTFCount;
 
+    sk_sp<SkImage>*    fImageArray;
+    int                fImageCount;
+
     SkFlattenable::Factory* fFactoryArray;
     int                     fFactoryCount;
 
@@ -255,6 +280,7 @@ public:
         kSaveBehind_Version                = 66,
         kSerializeFonts_Version            = 67,
         kPaintDoesntSerializeFonts_Version = 68,
+        kSharedImages_Version              = 69,
     };
 
     bool isVersionLT(Version) const { return false; }
@@ -337,8 +363,10 @@ public:
     SkFilterQuality checkFilterQuality() { return SkFilterQuality::kNone_SkFilterQuality; }
 
     void setTypefaceArray(sk_sp<SkTypeface>[], int)        {}
+    void setImageArray(sk_sp<SkImage>[], int)              {}
     void setFactoryPlayback(SkFlattenable::Factory[], int) {}
     void setDeserialProcs(const SkDeserialProcs&)          {}
+    void setBackingData(sk_sp<SkData>)                     {}
 
     const SkDeserialProcs& getDeserialProcs() const {
         static const SkDeserialProcs procs;
@@ -8,8 +8,12 @@
 #include "SkRecordOpts.h"
 
 #include "SkCanvasPriv.h"
+#include "SkImage.h"
+#include "SkPaintPriv.h"
+#include "SkRecordDraw.h"
 #include "SkRecordPattern.h"
 #include "SkRecords.h"
+#include "SkTArray.h"
 #include "SkTDArray.h"
 
 using namespace SkRecords;
@@ -289,6 +293,363 @@ void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord* record) {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Follows the matrix and clip set up by the commands of a record, relative to the canvas the record
+// is played back into. The clip is only followed while it's an intersection of rects in device
+// space; the playback canvas's own clip is always intersected with it.
+class StateTracker {
+public:
+    enum class Clip {
+        kNone,     // The record hasn't clipped.
+        kRect,     // The record's clips intersect to fClipRect.
+        kComplex,  // We don't know.
+    };
+
+    StateTracker() { fStack.push_back({false, Clip::kNone, SkRect::MakeEmpty()}); }
+
+    const SkMatrix& ctm() const { return fCTM; }
+    Clip clip() const { return fStack.back().fClip; }
+    const SkRect& clipRect() const { return fStack.back().fClipRect; }
+    // Is the current command drawing into a layer?
+    bool inLayer() const { return fLayerDepth > 0; }
+
+    // Returns true if the clip would be the same after intersecting it with rect.
+    bool clipContains(const SkRect& rect, const SkRecords::ClipOpAndAA& opAA) const {
+        if (opAA.op() != SkClipOp::kIntersect || this->clip() != Clip::kRect ||
+            !fCTM.rectStaysRect()) {
+            return false;
+        }
+        // Round out so that it doesn't matter whether either clip is anti-aliased.
+        SkRect bounds = fCTM.mapRect(rect);
+        return bounds.contains(SkRect::Make(this->clipRect().roundOut()));
+    }
+
+    template <typename T> void operator()(const T&) {}
+
+    void operator()(const SkRecords::Save&) { this->push(false); }
+    void operator()(const SkRecords::SaveLayer&) { this->push(true); }
+    void operator()(const SkRecords::SaveBehind&) { this->push(false); }
+    void operator()(const SkRecords::Restore& op) {
+        if (fStack.count() > 1) {
+            fLayerDepth -= fStack.back().fIsLayer ? 1 : 0;
+            fStack.pop_back();
+        }
+        fCTM = op.matrix;
+    }
+
+    void operator()(const SkRecords::SetMatrix& op) { fCTM = op.matrix; }
+    void operator()(const SkRecords::Concat& op) { fCTM.preConcat(op.matrix); }
+    void operator()(const SkRecords::Translate& op) { fCTM.preTranslate(op.dx, op.dy); }
+
+    void operator()(const SkRecords::ClipRect& op) {
+        State& state = fStack.back();
+        if (op.opAA.op() != SkClipOp::kIntersect || !fCTM.rectStaysRect()) {
+            state.fClip = Clip::kComplex;
+            return;
+        }
+        SkRect bounds = fCTM.mapRect(op.rect);
+        if (state.fClip == Clip::kNone) {
+            state.fClip = Clip::kRect;
+            state.fClipRect = bounds;
+        } else if (state.fClip == Clip::kRect && !state.fClipRect.intersect(bounds)) {
+            state.fClipRect.setEmpty();
+        }
+    }
+    void operator()(const SkRecords::ClipRRect&)  { fStack.back().fClip = Clip::kComplex; }
+    void operator()(const SkRecords::ClipPath&)   { fStack.back().fClip = Clip::kComplex; }
+    void operator()(const SkRecords::ClipRegion&) { fStack.back().fClip = Clip::kComplex; }
+
+private:
+    struct State {
+        bool fIsLayer;
+        Clip fClip;
+        SkRect fClipRect;
+    };
+
+    void push(bool isLayer) {
+        State state = fStack.back();
+        state.fIsLayer = isLayer;
+        fStack.push_back(state);
+        fLayerDepth += isLayer ? 1 : 0;
+    }
+
+    SkMatrix fCTM = SkMatrix::I();
+    SkSTArray<8, State, true> fStack;
+    int fLayerDepth = 0;
+};
+
+// Noops SetMatrix, Concat and Translate commands that leave the matrix as it was, and ClipRects
+// that contain the clip already in effect.
+struct RedundantStateNooper {
+    template <typename T> bool operator()(const T&) const { return false; }
+
+    bool operator()(const SkRecords::SetMatrix& op) const { return op.matrix == fState.ctm(); }
+    bool operator()(const SkRecords::Concat& op) const { return op.matrix.isIdentity(); }
+    bool operator()(const SkRecords::Translate& op) const { return 0 == op.dx && 0 == op.dy; }
+    bool operator()(const SkRecords::ClipRect& op) const {
+        return fState.clipContains(op.rect, op.opAA);
+    }
+
+    const StateTracker& fState;
+};
+
+void SkRecordNoopRedundantStateChanges(SkRecord* record) {
+    StateTracker state;
+    for (int i = 0; i < record->count(); i++) {
+        if (record->visit(i, RedundantStateNooper{state})) {
+            record->replace<NoOp>(i);
+        } else {
+            record->visit(i, state);
+        }
+    }
+}
+
+// A paint that overwrites everything under the geometry it covers, without changing its shape.
+static bool paint_covers_geometry(const SkPaint* paint, bool opaqueShader) {
+    if (paint && (paint->getStyle() != SkPaint::kFill_Style || paint->getPathEffect() ||
+                  paint->getMaskFilter() || paint->getImageFilter() || paint->getLooper())) {
+        return false;
+    }
+    return SkPaintPriv::Overwrites(paint, opaqueShader ? SkPaintPriv::kOpaque_ShaderOverrideOpacity
+                                                       : SkPaintPriv::kNone_ShaderOverrideOpacity);
+}
+
+// Finds the device space rect that a draw is sure to overwrite, if it's an opaque rect.
+struct OccluderFinder {
+    template <typename T> bool operator()(const T&) const { return false; }
+
+    bool operator()(const SkRecords::DrawPaint& op) const {
+        if (!paint_covers_geometry(&op.paint, false)) {
+            return false;
+        }
+        // Only the clip bounds a DrawPaint.
+        if (fState.clip() != StateTracker::Clip::kRect) {
+            return false;
+        }
+        *fCovered = fState.clipRect();
+        return true;
+    }
+    bool operator()(const SkRecords::DrawRect& op) const {
+        return paint_covers_geometry(&op.paint, false) && this->mapRect(op.rect);
+    }
+    bool operator()(const SkRecords::DrawImage& op) const {
+        return op.image->isOpaque() && paint_covers_geometry(op.paint, true) &&
+               this->mapRect(SkRect::MakeXYWH(op.left, op.top, op.image->width(),
+                                              op.image->height()));
+    }
+    bool operator()(const SkRecords::DrawImageRect& op) const {
+        return op.image->isOpaque() && paint_covers_geometry(op.paint, true) &&
+               this->mapRect(op.dst);
+    }
+
+    bool mapRect(const SkRect& rect) const {
+        if (!fState.ctm().rectStaysRect() || fState.clip() == StateTracker::Clip::kComplex) {
+            return false;
+        }
+        *fCovered = fState.ctm().mapRect(rect);
+        fCovered->sort();
+        return fState.clip() == StateTracker::Clip::kNone || fCovered->intersect(fState.clipRect());
+    }
+
+    const StateTracker& fState;
+    SkRect* fCovered;
+};
+
+// Which draws may be culled. Annotations, drawables and pictures can do more than draw pixels.
+struct IsCullable {
+    template <typename T>
+    SK_WHEN(T::kTags & kDraw_Tag, bool) operator()(const T&) const { return true; }
+    template <typename T>
+    SK_WHEN(!(T::kTags & kDraw_Tag), bool) operator()(const T&) const { return false; }
+
+    bool operator()(const DrawAnnotation&) const { return false; }
+    bool operator()(const DrawDrawable&)   const { return false; }
+    bool operator()(const DrawPicture&)    const { return false; }
+};
+
+// Commands that make the draws before them matter to the draws after, however much is covered.
+struct IsOcclusionBarrier {
+    template <typename T> bool operator()(const T&) const { return false; }
+
+    bool operator()(const SaveLayer&)  const { return true; }   // A backdrop may read them.
+    bool operator()(const SaveBehind&) const { return true; }
+    bool operator()(const Restore&)    const { return fState.inLayer(); }  // May end a layer.
+
+    const StateTracker& fState;
+};
+
+void SkRecordCullOccludedDraws(SkRecord* record, const SkRect& cullRect) {
+    SkAutoTMalloc<SkRect> bounds(record->count());
+    SkRecordFillBounds(cullRect, *record, bounds);
+
+    // The most recent draws that may still be covered. Checking each occluder against every
+    // earlier draw would be quadratic, so we only look back this far.
+    static constexpr int kMaxCandidates = 1024;
+    SkTDArray<int> candidates;
+
+    StateTracker state;
+    for (int i = 0; i < record->count(); i++) {
+        if (record->visit(i, IsOcclusionBarrier{state})) {
+            candidates.rewind();
+        }
+        SkRect covered;
+        if (!candidates.isEmpty() && record->visit(i, OccluderFinder{state, &covered})) {
+            // Leave a pixel of margin, so that anti-aliased edges on either draw still count as
+            // covered when played back at any scale down to 1:1.
+            covered.inset(1, 1);
+            int kept = 0;
+            for (int candidate : candidates) {
+                if (covered.contains(bounds[candidate])) {
+                    record->replace<NoOp>(candidate);
+                } else {
+                    candidates[kept++] = candidate;
+                }
+            }
+            candidates.setCount(kept);
+        }
+        if (record->visit(i, IsCullable())) {
+            if (candidates.count() == kMaxCandidates) {
+                candidates.remove(0);
+            }
+            candidates.push_back(i);
+        }
+        record->visit(i, state);
+    }
+}
+
+// Is it safe to shrink a layer with this paint to the bounds of what is drawn into it?
+static bool layer_paint_is_bounded_by_contents(const SkPaint* paint) {
+    if (!paint) {
+        return true;
+    }
+    // Image filters can move pixels around, and color filters can color transparent black.
+    if (paint->getImageFilter() || paint->getColorFilter()) {
+        return false;
+    }
+    // These modes change the destination even where the layer is transparent.
+    switch (paint->getBlendMode()) {
+        case SkBlendMode::kClear:
+        case SkBlendMode::kSrc:
+        case SkBlendMode::kSrcIn:
+        case SkBlendMode::kDstIn:
+        case SkBlendMode::kSrcOut:
+        case SkBlendMode::kDstATop:
+        case SkBlendMode::kModulate:
+            return false;
+        default:
+            return true;
+    }
+}
+
+struct GetUnboundedSaveLayer {
+    template <typename T> SaveLayer* operator()(T*) { return nullptr; }
+    SaveLayer* operator()(SaveLayer* op) {
+        bool canBound = !op->bounds && !op->backdrop && !op->clipMask &&
+                        layer_paint_is_bounded_by_contents(op->paint);
+        return canBound ? op : nullptr;
+    }
+};
+
+void SkRecordBoundSaveLayers(SkRecord* record, const SkRect& cullRect) {
+    SkAutoTMalloc<SkRect> bounds(record->count());
+    SkRecordFillBounds(cullRect, *record, bounds);
+
+    StateTracker state;
+    for (int i = 0; i < record->count(); i++) {
+        // A SaveLayer's bounds are the union of the (device space) bounds of the ops it contains.
+        SkMatrix inverse;
+        if (SaveLayer* op = record->mutate(i, GetUnboundedSaveLayer())) {
+            if (state.ctm().invert(&inverse)) {
+                // bounds is null, so there's nothing to destroy before replacing it.
+                new (&op->bounds) Optional<SkRect>(
+                        new (record->alloc<SkRect>()) SkRect(inverse.mapRect(bounds[i])));
+            }
+        }
+        record->visit(i, state);
+    }
+}
+
+// Merges runs of consecutive DrawImageRects, whose paints only set alpha, filtering, blending and
+// anti-aliasing the same way, into single DrawImageSets.
+struct ImageRectMerger {
+    // Returns true if op can be an entry in image set, with the same filtering and blending as
+    // first.
+    static bool CanMerge(const DrawImageRect& op, const DrawImageRect* first) {
+        const SkPaint* paint = op.paint;
+        if (op.constraint != SkCanvas::kFast_SrcRectConstraint || op.image->isAlphaOnly()) {
+            return false;
+        }
+        if (op.src && !SkRect::Make(op.image->bounds()).contains(*op.src)) {
+            return false;  // Image sets don't define what happens outside the image.
+        }
+        if (paint && (paint->getShader() || paint->getColorFilter() || paint->getMaskFilter() ||
+                      paint->getImageFilter() || paint->getLooper() || paint->getPathEffect() ||
+                      paint->isDither() || paint->getFilterQuality() > kLow_SkFilterQuality)) {
+            return false;
+        }
+        if (!first || first == &op) {
+            return true;
+        }
+        const SkPaint* firstPaint = first->paint;
+        return Quality(paint) == Quality(firstPaint) && Mode(paint) == Mode(firstPaint);
+    }
+
+    static SkFilterQuality Quality(const SkPaint* paint) {
+        return paint ? paint->getFilterQuality() : kNone_SkFilterQuality;
+    }
+    static SkBlendMode Mode(const SkPaint* paint) {
+        return paint ? paint->getBlendMode() : SkBlendMode::kSrcOver;
+    }
+
+    static void Merge(SkRecord* record, int begin, int end) {
+        SkAutoTArray<SkCanvas::ImageSetEntry> set(end - begin);
+        SkFilterQuality quality = kNone_SkFilterQuality;
+        SkBlendMode mode = SkBlendMode::kSrcOver;
+        for (int i = begin; i < end; i++) {
+            auto op = static_cast<DrawImageRect*>(record->mutate(i, GetDrawImageRect()));
+            const SkPaint* paint = op->paint;
+            SkCanvas::ImageSetEntry& entry = set[i - begin];
+            entry.fImage   = op->image;
+            entry.fSrcRect = op->src ? *op->src : SkRect::Make(op->image->bounds());
+            entry.fDstRect = op->dst;
+            entry.fAlpha   = paint ? paint->getAlpha() / 255.0f : 1.0f;
+            entry.fAAFlags = paint && paint->isAntiAlias() ? SkCanvas::kAll_QuadAAFlags
+                                                           : SkCanvas::kNone_QuadAAFlags;
+            quality = Quality(paint);
+            mode = Mode(paint);
+        }
+        for (int i = begin + 1; i < end; i++) {
+            record->replace<NoOp>(i);
+        }
+        new (record->replace<DrawImageSet>(begin)) DrawImageSet{std::move(set), end - begin,
+                                                                 quality, mode};
+    }
+
+    struct GetDrawImageRect {
+        template <typename T> void* operator()(T*) { return nullptr; }
+        void* operator()(DrawImageRect* op) { return op; }
+    };
+};
+
+void SkRecordMergeImageRects(SkRecord* record) {
+    ImageRectMerger::GetDrawImageRect get;
+    int begin = 0;
+    const DrawImageRect* first = nullptr;
+    for (int i = 0; i <= record->count(); i++) {
+        auto op = i < record->count()
+                ? static_cast<const DrawImageRect*>(record->mutate(i, get)) : nullptr;
+        if (op && first && ImageRectMerger::CanMerge(*op, first)) {
+            continue;  // Extend the current run.
+        }
+        if (first && i - begin > 1) {
+            ImageRectMerger::Merge(record, begin, i);
+        }
+        begin = i;
+        first = op && ImageRectMerger::CanMerge(*op, nullptr) ? op : nullptr;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 void SkRecordOptimize(SkRecord* record) {
     // This might be useful  as a first pass in the future if we want to weed
     // out junk for other optimization passes.  Right now, nothing needs it,
@@ -321,3 +682,18 @@ void SkRecordOptimize2(SkRecord* record) {
 
     record->defrag();
 }
+
+void SkRecordOptimizeForPlayback(SkRecord* record, const SkRect& cullRect) {
+    multiple_set_matrices(record);
+    SkRecordNoopRedundantStateChanges(record);
+    // See why we turn this off in SkRecordOptimize above.
+#ifndef SK_BUILD_FOR_ANDROID_FRAMEWORK
+    SkRecordNoopSaveLayerDrawRestores(record);
+#endif
+    SkRecordMergeSvgOpacityAndFilterLayers(record);
+    SkRecordMergeImageRects(record);
+    SkRecordCullOccludedDraws(record, cullRect);
+    SkRecordBoundSaveLayers(record, cullRect);
+
+    record->defrag();
+}
@@ -26,7 +26,26 @@ void SkRecordNoopSaveLayerDrawRestores(SkRecord*);
 // the alpha of the first SaveLayer to the second SaveLayer.
 void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord*);
 
+// Turns SetMatrix, Concat and Translate commands that don't change the matrix, and ClipRects that
+// contain the clip already in effect, into no-ops.
+void SkRecordNoopRedundantStateChanges(SkRecord*);
+
+// Turns draws that are sure to be covered by later opaque rect and image draws into no-ops,
+// comparing the bounds SkRecordFillBounds() computes with the rects that cover them.
+void SkRecordCullOccludedDraws(SkRecord*, const SkRect& cullRect);
+
+// Gives SaveLayers without bounds the bounds of what they draw, when their paint cannot draw
+// outside of that, so that playback allocates smaller layers.
+void SkRecordBoundSaveLayers(SkRecord*, const SkRect& cullRect);
+
+// Merges runs of consecutive DrawImageRects that can share a paint into single DrawImageSets.
+void SkRecordMergeImageRects(SkRecord*);
+
 // Experimental optimizers
 void SkRecordOptimize2(SkRecord*);
 
+// Runs SkRecordOptimize's passes plus the heavier ones above. Recording takes longer, which pays
+// off for pictures that are played back many times.
+void SkRecordOptimizeForPlayback(SkRecord*, const SkRect& cullRect);
+
 #endif//SkRecordOpts_DEFINED
@@ -51,6 +51,9 @@ public:
     SkDrawableList* getDrawableList() const { return fDrawableList.get(); }
     std::unique_ptr<SkDrawableList> detachDrawableList() { return std::move(fDrawableList); }
 
+    // Record into another SkRecord from here on, keeping the current matrix, clip and saves.
+    void swapRecord(SkRecord* record) { fRecord = record; }
+
     // Make SkRecorder forget entirely about its SkRecord*; all calls to SkRecorder will fail.
     void forgetRecord();
 
@@ -776,11 +776,29 @@ static int operate_on_span(const SkRegionPriv::RunType a_runs[],
                            const SkRegionPriv::RunType b_runs[],
                            RunArray* array, int dstOffset,
                            int min, int max) {
+    const int a_count = distance_to_sentinel(a_runs);
+    const int b_count = distance_to_sentinel(b_runs);
     // This is a worst-case for this span plus two for TWO terminating sentinels.
-    array->resizeToAtLeast(
-            dstOffset + distance_to_sentinel(a_runs) + distance_to_sentinel(b_runs) + 2);
+    array->resizeToAtLeast(dstOffset + a_count + b_count + 2);
     SkRegionPriv::RunType* dst = &(*array)[dstOffset]; // get pointer AFTER resizing.
 
+    // Where only one operand has intervals on this span (common for bands of two regions that
+    // do not overlap in Y), the op either keeps all of them or none. A region's intervals are
+    // already sorted and disjoint, so they can be copied in one go instead of merged pairwise.
+    if (0 == a_count || 0 == b_count) {
+        if (a_count != b_count) {
+            const int inside = 0 == b_count ? 1 : 2;
+            if ((unsigned)(inside - min) <= (unsigned)(max - min)) {
+                const SkRegionPriv::RunType* runs = 0 == b_count ? a_runs : b_runs;
+                const int count = a_count + b_count;
+                memcpy(dst, runs, count * sizeof(SkRegionPriv::RunType));
+                dst += count;
+            }
+        }
+        *dst++ = SkRegion_kRunTypeSentinel;
+        return dst - &(*array)[0];
+    }
+
     spanRec rec;
     bool    firstInterval = true;
 
@@ -16,6 +16,8 @@
 #include "SkDevice.h"
 #include "SkDraw.h"
 #include "SkGlyphRun.h"
+#include "SkOpts.h"
+#include "SkPackBits.h"
 #include "SkRemoteGlyphCacheImpl.h"
 #include "SkStrike.h"
 #include "SkStrikeCache.h"
@@ -72,6 +74,14 @@ static const SkDescriptor* create_descriptor(
 
 size_t pad(size_t size, size_t alignment) { return (size + (alignment - 1)) & ~(alignment - 1); }
 
+// How a glyph image is sent. Identical images are only sent once per buffer; a later glyph
+// refers to the first by its index among the images sent so far.
+enum ImageEncoding : uint32_t {
+    kRaw_ImageEncoding,
+    kPackBits_ImageEncoding,
+    kDuplicate_ImageEncoding,
+};
+
 class Serializer {
 public:
     Serializer(std::vector<uint8_t>* buffer) : fBuffer{buffer} { }
@@ -106,8 +116,40 @@ public:
         return &(*fBuffer)[aligned];
     }
 
+    void writeGlyphImage(const void* image, size_t size, size_t alignment) {
+        uint32_t hash = SkOpts::hash(image, size);
+        if (const uint32_t* index = fImageIndices.find(hash)) {
+            const sk_sp<SkData>& sent = fImages[*index];
+            if (sent->size() == size && 0 == memcmp(sent->data(), image, size)) {
+                this->write<uint32_t>(kDuplicate_ImageEncoding);
+                this->write<uint32_t>(*index);
+                return;
+            }
+        }
+        fImageIndices.set(hash, SkToU32(fImages.size()));
+        fImages.push_back(SkData::MakeWithCopy(image, size));
+
+        // Masks are mostly runs of 0x00 and 0xFF, so they usually pack well.
+        size_t maxPackedSize = SkPackBits::ComputeMaxSize8(size);
+        SkAutoSTMalloc<1024, uint8_t> packed(maxPackedSize);
+        size_t packedSize = SkPackBits::Pack8(static_cast<const uint8_t*>(image), size,
+                                              packed.get(), maxPackedSize);
+        if (packedSize + sizeof(uint32_t) < size) {
+            this->write<uint32_t>(kPackBits_ImageEncoding);
+            this->write<uint32_t>(SkToU32(packedSize));
+            memcpy(this->allocate(packedSize, 1), packed.get(), packedSize);
+        } else {
+            this->write<uint32_t>(kRaw_ImageEncoding);
+            memcpy(this->allocate(size, alignment), image, size);
+        }
+    }
+
 private:
     std::vector<uint8_t>* fBuffer;
+
+    // The images written to fBuffer, and their indices by hash.
+    std::vector<sk_sp<SkData>> fImages;
+    SkTHashMap<uint32_t, uint32_t> fImageIndices;
 };
 
 // -- Deserializer -------------------------------------------------------------------------------
@@ -142,6 +184,42 @@ public:
       return this->ensureAtLeast(size, alignment);
     }
 
+    // Returns a copy of the next glyph image, or null if the data is invalid. The copy lives as
+    // long as the Deserializer, so later glyphs can refer back to it.
+    const void* readGlyphImage(size_t size, size_t alignment) {
+        uint32_t encoding;
+        if (!this->read<uint32_t>(&encoding)) return nullptr;
+
+        if (encoding == kDuplicate_ImageEncoding) {
+            uint32_t index;
+            if (!this->read<uint32_t>(&index)) return nullptr;
+            if (index >= fImages.size() || fImages[index].size != size) return nullptr;
+            return fImages[index].image;
+        }
+
+        auto* image = fAlloc.makeArrayDefault<uint8_t>(size);
+        if (encoding == kRaw_ImageEncoding) {
+            auto* src = this->ensureAtLeast(size, alignment);
+            if (!src) return nullptr;
+            memcpy(image, const_cast<const char*>(src), size);
+        } else if (encoding == kPackBits_ImageEncoding) {
+            uint32_t packedSize;
+            if (!this->read<uint32_t>(&packedSize)) return nullptr;
+            auto* src = this->ensureAtLeast(packedSize, 1);
+            if (!src) return nullptr;
+
+            SkAutoSTMalloc<1024, uint8_t> packed(packedSize);
+            memcpy(packed.get(), const_cast<const char*>(src), packedSize);
+            if (SkPackBits::Unpack8(packed.get(), packedSize, image, size) != (int)size) {
+                return nullptr;
+            }
+        } else {
+            return nullptr;
+        }
+        fImages.push_back({image, size});
+        return image;
+    }
+
 private:
     const volatile char* ensureAtLeast(size_t size, size_t alignment) {
         size_t padded = pad(fBytesRead, alignment);
@@ -158,6 +236,13 @@ private:
     const volatile char* fMemory;
     size_t fMemorySize;
     size_t fBytesRead = 0u;
+
+    struct Image {
+        const void* image;
+        size_t size;
+    };
+    std::vector<Image> fImages;
+    SkArenaAlloc fAlloc{4096};
 };
 
 // Paths use a SkWriter32 which requires 4 byte alignment.
@@ -302,6 +387,45 @@ void SkStrikeServer::writeStrikeData(std::vector<uint8_t>* memory) {
     fLockedDescs.clear();
 }
 
+bool SkStrikeServer::readCacheMissHints(const volatile void* memory, size_t memorySize) {
+    Deserializer deserializer(static_cast<const volatile char*>(memory), memorySize);
+
+    SkTHashMap<SkDiscardableHandleId, const SkDescriptor*> descsByHandle;
+    for (const auto& entry : fRemoteGlyphStateMap) {
+        descsByHandle.set(entry.second->discardableHandleId(), entry.first);
+    }
+
+    uint64_t deletedCount = 0u;
+    if (!deserializer.read<uint64_t>(&deletedCount)) return false;
+    for (size_t i = 0; i < deletedCount; ++i) {
+        SkDiscardableHandleId id;
+        if (!deserializer.read<SkDiscardableHandleId>(&id)) return false;
+
+        const SkDescriptor** desc = descsByHandle.find(id);
+        // A deleted handle can't be locked, but a bad hint shouldn't pull a locked strike away.
+        if (desc && fLockedDescs.find(*desc) == fLockedDescs.end()) {
+            auto it = fRemoteGlyphStateMap.find(*desc);
+            descsByHandle.remove(id);
+            fRemoteGlyphStateMap.erase(it);
+        }
+    }
+
+    uint64_t missCount = 0u;
+    if (!deserializer.read<uint64_t>(&missCount)) return false;
+    for (size_t i = 0; i < missCount; ++i) {
+        WireCacheMiss miss;
+        if (!deserializer.read<WireCacheMiss>(&miss)) return false;
+
+        // Misses in strikes we no longer track will be sent in full with a new strike anyway.
+        if (const SkDescriptor** desc = descsByHandle.find(miss.discardableHandleId)) {
+            auto it = fRemoteGlyphStateMap.find(*desc);
+            SkASSERT(it != fRemoteGlyphStateMap.end());
+            it->second->addHintedGlyph(miss.glyphID, miss.asPath != 0);
+        }
+    }
+    return true;
+}
+
 SkStrikeServer::SkGlyphCacheState* SkStrikeServer::getOrCreateCache(
         const SkPaint& paint,
         const SkFont& font,
@@ -471,18 +595,39 @@ void SkStrikeServer::SkGlyphCacheState::writePendingGlyphs(Serializer* serialize
 
     // Write glyphs images.
     serializer->emplace<uint64_t>(fPendingGlyphImages.size());
+    // Generate all the images in one go, so the scaler context can share its setup between them.
+    SkSTArray<32, SkGlyph> glyphs;
+    SkSTArray<32, const SkGlyph*> glyphsWithImages;
+    size_t imagesSize = 0;
     for (const auto& glyphID : fPendingGlyphImages) {
-        SkGlyph glyph{glyphID};
+        SkGlyph& glyph = glyphs.emplace_back(glyphID);
         fContext->getMetrics(&glyph);
+        imagesSize += SkAlign8(glyph.computeImageSize());
+    }
+    SkAutoSTMalloc<4096, uint8_t> images(imagesSize);
+    uint8_t* nextImage = images.get();
+    for (SkGlyph& glyph : glyphs) {
+        size_t imageSize = glyph.computeImageSize();
+        if (imageSize) {
+            glyph.fImage = nextImage;
+            nextImage += SkAlign8(imageSize);
+            glyphsWithImages.push_back(&glyph);
+        }
+    }
+    fContext->getImages(
+            SkSpan<const SkGlyph*>(glyphsWithImages.begin(), glyphsWithImages.count()));
+
+    for (SkGlyph& glyph : glyphs) {
+        void* image = glyph.fImage;
+        glyph.fImage = nullptr;
         writeGlyph(&glyph, serializer);
 
         auto imageSize = glyph.computeImageSize();
         if (imageSize == 0u) continue;
 
-        glyph.fImage = serializer->allocate(imageSize, glyph.formatAlignment());
-        fContext->getImage(glyph);
         // TODO: Generating the image can change the mask format, do we need to update it in the
         // serialized glyph?
+        serializer->writeGlyphImage(image, imageSize, glyph.formatAlignment());
     }
     fPendingGlyphImages.clear();
 
@@ -510,6 +655,17 @@ const SkGlyph& SkStrikeServer::SkGlyphCacheState::findGlyph(SkPackedGlyphID glyp
     return *glyphPtr;
 }
 
+void SkStrikeServer::SkGlyphCacheState::addHintedGlyph(SkPackedGlyphID glyphID, bool asPath) {
+    // The client says it doesn't have the glyph, whatever we believed we sent.
+    if (asPath) {
+        fCachedGlyphPaths.remove(glyphID);
+        fHintedGlyphPaths.push_back(glyphID);
+    } else {
+        fCachedGlyphImages.remove(glyphID);
+        fHintedGlyphImages.push_back(glyphID);
+    }
+}
+
 void SkStrikeServer::SkGlyphCacheState::ensureScalerContext() {
     if (fContext == nullptr) {
         auto tf = fFont->getTypefaceOrDefault();
@@ -526,6 +682,15 @@ void SkStrikeServer::SkGlyphCacheState::setFontAndEffects(
         const SkFont& font, SkScalerContextEffects effects) {
     fFont = &font;
     fEffects = effects;
+
+    for (SkPackedGlyphID glyphID : fHintedGlyphImages) {
+        this->addGlyph(glyphID, false);
+    }
+    fHintedGlyphImages.clear();
+    for (SkPackedGlyphID glyphID : fHintedGlyphPaths) {
+        this->addGlyph(glyphID, true);
+    }
+    fHintedGlyphPaths.clear();
 }
 
 SkVector SkStrikeServer::SkGlyphCacheState::rounding() const {
@@ -567,23 +732,52 @@ void SkStrikeServer::SkGlyphCacheState::writeGlyphPath(const SkPackedGlyphID& gl
 class SkStrikeClient::DiscardableStrikePinner : public SkStrikePinner {
 public:
     DiscardableStrikePinner(SkDiscardableHandleId discardableHandleId,
-                            sk_sp<DiscardableHandleManager> manager)
-            : fDiscardableHandleId(discardableHandleId), fManager(std::move(manager)) {}
+                            sk_sp<DiscardableHandleManager> manager,
+                            sk_sp<CacheMissHints> hints)
+            : fDiscardableHandleId(discardableHandleId)
+            , fManager(std::move(manager))
+            , fHints(std::move(hints)) {}
 
     ~DiscardableStrikePinner() override = default;
-    bool canDelete() override { return fManager->deleteHandle(fDiscardableHandleId); }
+    bool canDelete() override {
+        if (!fManager->deleteHandle(fDiscardableHandleId)) return false;
+        fHints->addDeletedStrike(fDiscardableHandleId);
+        return true;
+    }
 
 private:
     const SkDiscardableHandleId fDiscardableHandleId;
     sk_sp<DiscardableHandleManager> fManager;
+    sk_sp<CacheMissHints> fHints;
 };
 
+void SkStrikeClient::CacheMissHints::addMiss(SkDiscardableHandleId discardableHandleId,
+                                             SkPackedGlyphID glyphID, bool asPath) {
+    SkAutoMutexAcquire lock(fMutex);
+    fMisses.push_back({discardableHandleId, glyphID, asPath ? 1u : 0u});
+}
+
+void SkStrikeClient::CacheMissHints::addDeletedStrike(SkDiscardableHandleId discardableHandleId) {
+    SkAutoMutexAcquire lock(fMutex);
+    fDeletedStrikes.push_back(discardableHandleId);
+}
+
+void SkStrikeClient::CacheMissHints::takeAll(std::vector<WireCacheMiss>* misses,
+                                             std::vector<SkDiscardableHandleId>* deleted) {
+    SkAutoMutexAcquire lock(fMutex);
+    misses->swap(fMisses);
+    deleted->swap(fDeletedStrikes);
+    fMisses.clear();
+    fDeletedStrikes.clear();
+}
+
 SkStrikeClient::SkStrikeClient(sk_sp<DiscardableHandleManager> discardableManager,
                                bool isLogging,
                                SkStrikeCache* strikeCache)
         : fDiscardableHandleManager(std::move(discardableManager))
         , fStrikeCache{strikeCache ? strikeCache : SkStrikeCache::GlobalStrikeCache()}
-        , fIsLogging{isLogging} {}
+        , fIsLogging{isLogging}
+        , fCacheMissHints{sk_make_sp<CacheMissHints>()} {}
 
 SkStrikeClient::~SkStrikeClient() = default;
 
@@ -664,9 +858,11 @@ bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySi
             strike = fStrikeCache->createStrikeExclusive(
                     *client_desc, std::move(scaler), &fontMetrics,
                     skstd::make_unique<DiscardableStrikePinner>(spec.discardableHandleId,
-                                                                fDiscardableHandleManager));
+                                                                fDiscardableHandleManager,
+                                                                fCacheMissHints));
             auto proxyContext = static_cast<SkScalerContextProxy*>(strike->getScalerContext());
             proxyContext->initCache(strike.get(), fStrikeCache);
+            proxyContext->setCacheMissHints(spec.discardableHandleId, fCacheMissHints);
         }
 
         uint64_t glyphImagesCount = 0u;
@@ -688,7 +884,8 @@ bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySi
             auto imageSize = glyph->computeImageSize();
             if (imageSize == 0u) continue;
 
-            auto* image = deserializer.read(imageSize, allocatedGlyph->formatAlignment());
+            auto* image = deserializer.readGlyphImage(imageSize,
+                                                      allocatedGlyph->formatAlignment());
             if (!image) READ_FAILURE
             strike->initializeImage(image, imageSize, allocatedGlyph);
         }
@@ -716,6 +913,21 @@ bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySi
     return true;
 }
 
+void SkStrikeClient::writeCacheMissHints(std::vector<uint8_t>* memory) {
+    std::vector<WireCacheMiss> misses;
+    std::vector<SkDiscardableHandleId> deleted;
+    fCacheMissHints->takeAll(&misses, &deleted);
+    if (misses.empty() && deleted.empty()) {
+        return;
+    }
+
+    Serializer serializer(memory);
+    serializer.emplace<uint64_t>(deleted.size());
+    for (SkDiscardableHandleId id : deleted) serializer.write<SkDiscardableHandleId>(id);
+    serializer.emplace<uint64_t>(misses.size());
+    for (const WireCacheMiss& miss : misses) serializer.write<WireCacheMiss>(miss);
+}
+
 sk_sp<SkTypeface> SkStrikeClient::deserializeTypeface(const void* buf, size_t len) {
     WireTypeface wire;
     if (len != sizeof(wire)) return nullptr;
@@ -122,6 +122,11 @@ public:
     // unlocked after this call.
     void writeStrikeData(std::vector<uint8_t>* memory);
 
+    // Reads the hints written by SkStrikeClient::writeCacheMissHints. Glyphs the client missed
+    // are sent the next time their strike is used, and strikes the client has deleted are
+    // forgotten. Returns false if the data is invalid.
+    bool readCacheMissHints(const volatile void* memory, size_t memorySize);
+
     // Methods used internally in skia ------------------------------------------
     class SkGlyphCacheState;
 
@@ -200,6 +205,14 @@ public:
     // Returns false if the data is invalid.
     bool readStrikeData(const volatile void* memory, size_t memorySize);
 
+    // Writes the glyphs which missed, and the strikes which were deleted, since the last call.
+    // These are meant to be read by SkStrikeServer::readCacheMissHints. Nothing is written if
+    // there is nothing to report.
+    void writeCacheMissHints(std::vector<uint8_t>* memory);
+
+    // Methods used internally in skia ------------------------------------------
+    class CacheMissHints;
+
 private:
     class DiscardableStrikePinner;
 
@@ -209,6 +222,7 @@ private:
     sk_sp<DiscardableHandleManager> fDiscardableHandleManager;
     SkStrikeCache* const fStrikeCache;
     const bool fIsLogging;
+    sk_sp<CacheMissHints> fCacheMissHints;
 };
 
 #endif  // SkRemoteGlyphCache_DEFINED
@@ -12,6 +12,7 @@
 #include "SkDescriptor.h"
 #include "SkGlyphRun.h"
 #include "SkGlyphRunPainter.h"
+#include "SkMutex.h"
 #include "SkRemoteGlyphCache.h"
 
 class SkStrikeServer::SkGlyphCacheState : public SkStrikeInterface {
@@ -39,6 +40,9 @@ public:
 
     const SkGlyph& findGlyph(SkPackedGlyphID);
 
+    // A glyph the client missed. It is sent the next time this strike is used.
+    void addHintedGlyph(SkPackedGlyphID, bool asPath);
+
     void setFontAndEffects(const SkFont& font, SkScalerContextEffects effects);
 
     SkVector rounding() const override;
@@ -67,6 +71,11 @@ private:
     std::vector<SkPackedGlyphID> fPendingGlyphImages;
     std::vector<SkPackedGlyphID> fPendingGlyphPaths;
 
+    // Glyphs the client reported missing. These can only be added to the pending glyphs once
+    // setFontAndEffects() lets us make a scaler context again.
+    std::vector<SkPackedGlyphID> fHintedGlyphImages;
+    std::vector<SkPackedGlyphID> fHintedGlyphPaths;
+
     // The device descriptor is used to create the scaler context. The glyphs to have the
     // correct device rendering. The key descriptor is used for communication. The GPU side will
     // create descriptors with out the device filtering, thus matching the key descriptor.
@@ -104,6 +113,28 @@ private:
     SkArenaAlloc fAlloc{256};
 };
 
+// A glyph missing from a strike on the client.
+struct WireCacheMiss {
+    SkDiscardableHandleId discardableHandleId;
+    SkPackedGlyphID glyphID;
+    uint32_t asPath;
+};
+
+// Collects the cache misses and strike deletions on the client between calls to
+// SkStrikeClient::writeCacheMissHints. Strikes may be used and deleted on any thread.
+class SkStrikeClient::CacheMissHints : public SkRefCnt {
+public:
+    void addMiss(SkDiscardableHandleId, SkPackedGlyphID, bool asPath);
+    void addDeletedStrike(SkDiscardableHandleId);
+
+    void takeAll(std::vector<WireCacheMiss>* misses, std::vector<SkDiscardableHandleId>* deleted);
+
+private:
+    SkMutex fMutex;
+    std::vector<WireCacheMiss> fMisses;
+    std::vector<SkDiscardableHandleId> fDeletedStrikes;
+};
+
 class SkTextBlobCacheDiffCanvas::TrackLayerDevice : public SkNoPixelsDevice {
 public:
     TrackLayerDevice(const SkIRect& bounds, const SkSurfaceProps& props, SkStrikeServer* server,
@@ -11,6 +11,7 @@
 #include "SkMessageBus.h"
 #include "SkMipMap.h"
 #include "SkMutex.h"
+#include "SkOnce.h"
 #include "SkOpts.h"
 #include "SkTo.h"
 #include "SkTraceMemoryDump.h"
@@ -77,12 +78,19 @@ class SkResourceCache::Hash :
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Once the cache is over budget, purging goes on until it is under by this fraction of the
+// budget, so that the adds that follow don't each have to purge again.
+static constexpr int kPurgeBatchDivisor = 16;
+
 void SkResourceCache::init() {
-    fHead = nullptr;
-    fTail = nullptr;
-    fHash = new Hash;
+    for (Shard& shard : fShards) {
+        shard.fHead = nullptr;
+        shard.fTail = nullptr;
+        shard.fHash = new Hash;
+    }
     fTotalBytesUsed = 0;
     fCount = 0;
+    fUseCounter = 0;
     fSingleAllocationByteLimit = 0;
 
     // One of these should be explicit set by the caller after we return.
@@ -101,13 +109,15 @@ SkResourceCache::SkResourceCache(size_t byteLimit) {
 }
 
 SkResourceCache::~SkResourceCache() {
-    Rec* rec = fHead;
-    while (rec) {
-        Rec* next = rec->fNext;
-        delete rec;
-        rec = next;
+    for (Shard& shard : fShards) {
+        Rec* rec = shard.fHead;
+        while (rec) {
+            Rec* next = rec->fNext;
+            delete rec;
+            rec = next;
+        }
+        delete shard.fHash;
     }
-    delete fHash;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -115,13 +125,15 @@ SkResourceCache::~SkResourceCache() {
 bool SkResourceCache::find(const Key& key, FindVisitor visitor, void* context) {
     this->checkMessages();
 
-    if (auto found = fHash->find(key)) {
+    Shard* shard = this->shardFor(key);
+    SkAutoMutexAcquire lock(shard->fMutex);
+    if (auto found = shard->fHash->find(key)) {
         Rec* rec = *found;
         if (visitor(*rec, context)) {
-            this->moveToHead(rec);  // for our LRU
+            this->moveToHead(shard, rec);  // for our LRU
             return true;
         } else {
-            this->remove(rec);  // stale
+            this->remove(shard, rec);  // stale
             return false;
         }
     }
@@ -144,43 +156,48 @@ void SkResourceCache::add(Rec* rec, void* payload) {
     this->checkMessages();
 
     SkASSERT(rec);
-    // See if we already have this key (racy inserts, etc.)
-    if (Rec** preexisting = fHash->find(rec->getKey())) {
-        Rec* prev = *preexisting;
-        if (prev->canBePurged()) {
-            // if it can be purged, the install may fail, so we have to remove it
-            this->remove(prev);
-        } else {
-            // if it cannot be purged, we reuse it and delete the new one
-            prev->postAddInstall(payload);
-            delete rec;
-            return;
+    {
+        Shard* shard = this->shardFor(rec->getKey());
+        SkAutoMutexAcquire lock(shard->fMutex);
+
+        // See if we already have this key (racy inserts, etc.)
+        if (Rec** preexisting = shard->fHash->find(rec->getKey())) {
+            Rec* prev = *preexisting;
+            if (prev->canBePurged()) {
+                // if it can be purged, the install may fail, so we have to remove it
+                this->remove(shard, prev);
+            } else {
+                // if it cannot be purged, we reuse it and delete the new one
+                prev->postAddInstall(payload);
+                delete rec;
+                return;
+            }
         }
-    }
 
-    this->addToHead(rec);
-    fHash->set(rec);
-    rec->postAddInstall(payload);
+        this->addToHead(shard, rec);
+        shard->fHash->set(rec);
+        rec->postAddInstall(payload);
 
-    if (gDumpCacheTransactions) {
-        SkString bytesStr, totalStr;
-        make_size_str(rec->bytesUsed(), &bytesStr);
-        make_size_str(fTotalBytesUsed, &totalStr);
-        SkDebugf("RC:    add %5s %12p key %08x -- total %5s, count %d\n",
-                 bytesStr.c_str(), rec, rec->getHash(), totalStr.c_str(), fCount);
+        if (gDumpCacheTransactions) {
+            SkString bytesStr, totalStr;
+            make_size_str(rec->bytesUsed(), &bytesStr);
+            make_size_str(fTotalBytesUsed, &totalStr);
+            SkDebugf("RC:    add %5s %12p key %08x -- total %5s, count %d\n",
+                     bytesStr.c_str(), rec, rec->getHash(), totalStr.c_str(), fCount.load());
+        }
     }
 
     // since the new rec may push us over-budget, we perform a purge check now
     this->purgeAsNeeded();
 }
 
-void SkResourceCache::remove(Rec* rec) {
+void SkResourceCache::remove(Shard* shard, Rec* rec) {
     SkASSERT(rec->canBePurged());
     size_t used = rec->bytesUsed();
     SkASSERT(used <= fTotalBytesUsed);
 
-    this->release(rec);
-    fHash->remove(rec->getKey());
+    this->release(shard, rec);
+    shard->fHash->remove(rec->getKey());
 
     fTotalBytesUsed -= used;
     fCount -= 1;
@@ -192,7 +209,7 @@ void SkResourceCache::remove(Rec* rec) {
         make_size_str(used, &bytesStr);
         make_size_str(fTotalBytesUsed, &totalStr);
         SkDebugf("RC: remove %5s %12p key %08x -- total %5s, count %d\n",
-                 bytesStr.c_str(), rec, rec->getHash(), totalStr.c_str(), fCount);
+                 bytesStr.c_str(), rec, rec->getHash(), totalStr.c_str(), fCount.load());
     }
 
     delete rec;
@@ -210,17 +227,43 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
         byteLimit = fTotalByteLimit;
     }
 
-    Rec* rec = fTail;
-    while (rec) {
-        if (!forcePurge && fTotalBytesUsed < byteLimit && fCount < countLimit) {
+    if (!forcePurge && fTotalBytesUsed < byteLimit && fCount < countLimit) {
+        return;
+    }
+    const size_t byteTarget  = byteLimit  - byteLimit  / kPurgeBatchDivisor;
+    const int    countTarget = countLimit - countLimit / kPurgeBatchDivisor;
+
+    SkAutoMutexAcquire purgeLock(fPurgeMutex);
+    for (Shard& shard : fShards) {
+        shard.fMutex.acquire();
+    }
+
+    // Each shard's tail is its least recently used rec, so the oldest of those is the least
+    // recently used rec in the whole cache.
+    Rec* cursors[kShardCount];
+    for (int i = 0; i < kShardCount; ++i) {
+        cursors[i] = fShards[i].fTail;
+    }
+    while (forcePurge || fTotalBytesUsed >= byteTarget || fCount >= countTarget) {
+        int oldest = -1;
+        for (int i = 0; i < kShardCount; ++i) {
+            if (cursors[i] && (oldest < 0 || cursors[i]->fLastUse < cursors[oldest]->fLastUse)) {
+                oldest = i;
+            }
+        }
+        if (oldest < 0) {
             break;
         }
 
-        Rec* prev = rec->fPrev;
+        Rec* rec = cursors[oldest];
+        cursors[oldest] = rec->fPrev;
         if (rec->canBePurged()) {
-            this->remove(rec);
+            this->remove(&fShards[oldest], rec);
         }
-        rec = prev;
+    }
+
+    for (Shard& shard : fShards) {
+        shard.fMutex.release();
     }
 }
 
@@ -240,22 +283,25 @@ void SkResourceCache::purgeSharedID(uint64_t sharedID) {
     gPurgeCallCounter += 1;
     bool found = false;
 #endif
-    // go backwards, just like purgeAsNeeded, just to make the code similar.
-    // could iterate either direction and still be correct.
-    Rec* rec = fTail;
-    while (rec) {
-        Rec* prev = rec->fPrev;
-        if (rec->getKey().getSharedID() == sharedID) {
-            // even though the "src" is now dead, caches could still be in-flight, so
-            // we have to check if it can be removed.
-            if (rec->canBePurged()) {
-                this->remove(rec);
-            }
+    for (Shard& shard : fShards) {
+        SkAutoMutexAcquire lock(shard.fMutex);
+        // go backwards, just like purgeAsNeeded, just to make the code similar.
+        // could iterate either direction and still be correct.
+        Rec* rec = shard.fTail;
+        while (rec) {
+            Rec* prev = rec->fPrev;
+            if (rec->getKey().getSharedID() == sharedID) {
+                // even though the "src" is now dead, caches could still be in-flight, so
+                // we have to check if it can be removed.
+                if (rec->canBePurged()) {
+                    this->remove(&shard, rec);
+                }
 #ifdef SK_TRACK_PURGE_SHAREDID_HITRATE
-            found = true;
+                found = true;
 #endif
+            }
+            rec = prev;
         }
-        rec = prev;
     }
 
 #ifdef SK_TRACK_PURGE_SHAREDID_HITRATE
@@ -269,20 +315,22 @@ void SkResourceCache::purgeSharedID(uint64_t sharedID) {
 }
 
 void SkResourceCache::visitAll(Visitor visitor, void* context) {
-    // go backwards, just like purgeAsNeeded, just to make the code similar.
-    // could iterate either direction and still be correct.
-    Rec* rec = fTail;
-    while (rec) {
-        visitor(*rec, context);
-        rec = rec->fPrev;
+    for (Shard& shard : fShards) {
+        SkAutoMutexAcquire lock(shard.fMutex);
+        // go backwards, just like purgeAsNeeded, just to make the code similar.
+        // could iterate either direction and still be correct.
+        Rec* rec = shard.fTail;
+        while (rec) {
+            visitor(*rec, context);
+            rec = rec->fPrev;
+        }
     }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 size_t SkResourceCache::setTotalByteLimit(size_t newLimit) {
-    size_t prevLimit = fTotalByteLimit;
-    fTotalByteLimit = newLimit;
+    size_t prevLimit = fTotalByteLimit.exchange(newLimit);
     if (newLimit < prevLimit) {
         this->purgeAsNeeded();
     }
@@ -302,19 +350,19 @@ SkCachedData* SkResourceCache::newCachedData(size_t bytes) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void SkResourceCache::release(Rec* rec) {
+void SkResourceCache::release(Shard* shard, Rec* rec) {
     Rec* prev = rec->fPrev;
     Rec* next = rec->fNext;
 
     if (!prev) {
-        SkASSERT(fHead == rec);
-        fHead = next;
+        SkASSERT(shard->fHead == rec);
+        shard->fHead = next;
     } else {
         prev->fNext = next;
     }
 
     if (!next) {
-        fTail = prev;
+        shard->fTail = prev;
     } else {
         next->fPrev = prev;
     }
@@ -322,101 +370,107 @@ void SkResourceCache::release(Rec* rec) {
     rec->fNext = rec->fPrev = nullptr;
 }
 
-void SkResourceCache::moveToHead(Rec* rec) {
-    if (fHead == rec) {
+void SkResourceCache::moveToHead(Shard* shard, Rec* rec) {
+    this->validate(shard);
+
+    // The shard's lock keeps its stamps in list order, whichever thread takes them.
+    rec->fLastUse = fUseCounter.fetch_add(1, std::memory_order_relaxed);
+    if (shard->fHead == rec) {
         return;
     }
 
-    SkASSERT(fHead);
-    SkASSERT(fTail);
+    SkASSERT(shard->fHead);
+    SkASSERT(shard->fTail);
 
-    this->validate();
+    this->release(shard, rec);
 
-    this->release(rec);
+    shard->fHead->fPrev = rec;
+    rec->fNext = shard->fHead;
+    shard->fHead = rec;
 
-    fHead->fPrev = rec;
-    rec->fNext = fHead;
-    fHead = rec;
-
-    this->validate();
+    this->validate(shard);
 }
 
-void SkResourceCache::addToHead(Rec* rec) {
-    this->validate();
+void SkResourceCache::addToHead(Shard* shard, Rec* rec) {
+    this->validate(shard);
 
+    rec->fLastUse = fUseCounter.fetch_add(1, std::memory_order_relaxed);
     rec->fPrev = nullptr;
-    rec->fNext = fHead;
-    if (fHead) {
-        fHead->fPrev = rec;
+    rec->fNext = shard->fHead;
+    if (shard->fHead) {
+        shard->fHead->fPrev = rec;
     }
-    fHead = rec;
-    if (!fTail) {
-        fTail = rec;
+    shard->fHead = rec;
+    if (!shard->fTail) {
+        shard->fTail = rec;
     }
     fTotalBytesUsed += rec->bytesUsed();
     fCount += 1;
 
-    this->validate();
+    this->validate(shard);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifdef SK_DEBUG
-void SkResourceCache::validate() const {
-    if (nullptr == fHead) {
-        SkASSERT(nullptr == fTail);
-        SkASSERT(0 == fTotalBytesUsed);
+void SkResourceCache::validate(const Shard* shard) const {
+    if (nullptr == shard->fHead) {
+        SkASSERT(nullptr == shard->fTail);
         return;
     }
 
-    if (fHead == fTail) {
-        SkASSERT(nullptr == fHead->fPrev);
-        SkASSERT(nullptr == fHead->fNext);
-        SkASSERT(fHead->bytesUsed() == fTotalBytesUsed);
-        return;
-    }
+    SkASSERT(nullptr == shard->fHead->fPrev);
+    SkASSERT(nullptr == shard->fTail->fNext);
 
-    SkASSERT(nullptr == fHead->fPrev);
-    SkASSERT(fHead->fNext);
-    SkASSERT(nullptr == fTail->fNext);
-    SkASSERT(fTail->fPrev);
-
-    size_t used = 0;
     int count = 0;
-    const Rec* rec = fHead;
+    const Rec* rec = shard->fHead;
     while (rec) {
         count += 1;
-        used += rec->bytesUsed();
-        SkASSERT(used <= fTotalBytesUsed);
+        SkASSERT(!rec->fNext || rec->fNext->fLastUse < rec->fLastUse);
         rec = rec->fNext;
     }
-    SkASSERT(fCount == count);
 
-    rec = fTail;
+    rec = shard->fTail;
     while (rec) {
         SkASSERT(count > 0);
         count -= 1;
-        SkASSERT(used >= rec->bytesUsed());
-        used -= rec->bytesUsed();
         rec = rec->fPrev;
     }
-
     SkASSERT(0 == count);
-    SkASSERT(0 == used);
+}
+
+// Must be called with every shard's lock held.
+void SkResourceCache::validate() const {
+    size_t used = 0;
+    int count = 0;
+    for (const Shard& shard : fShards) {
+        this->validate(&shard);
+        for (const Rec* rec = shard.fHead; rec; rec = rec->fNext) {
+            count += 1;
+            used += rec->bytesUsed();
+        }
+    }
+    SkASSERT(fCount == count);
+    SkASSERT(fTotalBytesUsed == used);
 }
 #endif
 
 void SkResourceCache::dump() const {
+    for (const Shard& shard : fShards) {
+        shard.fMutex.acquire();
+    }
     this->validate();
 
-    SkDebugf("SkResourceCache: count=%d bytes=%d %s\n",
-             fCount, fTotalBytesUsed, fDiscardableFactory ? "discardable" : "malloc");
+    SkDebugf("SkResourceCache: count=%d bytes=%zu %s\n",
+             fCount.load(), fTotalBytesUsed.load(), fDiscardableFactory ? "discardable" : "malloc");
+
+    for (const Shard& shard : fShards) {
+        shard.fMutex.release();
+    }
 }
 
 size_t SkResourceCache::setSingleAllocationByteLimit(size_t newLimit) {
-    size_t oldLimit = fSingleAllocationByteLimit;
-    fSingleAllocationByteLimit = newLimit;
-    return oldLimit;
+    return fSingleAllocationByteLimit.exchange(newLimit);
 }
 
 size_t SkResourceCache::getSingleAllocationByteLimit() const {
@@ -430,10 +484,11 @@ size_t SkResourceCache::getEffectiveSingleAllocationByteLimit() const {
     // if we're not discardable (i.e. we are fixed-budget) then cap the single-limit
     // to our budget.
     if (nullptr == fDiscardableFactory) {
+        size_t totalLimit = fTotalByteLimit;
         if (0 == limit) {
-            limit = fTotalByteLimit;
+            limit = totalLimit;
         } else {
-            limit = SkTMin(limit, fTotalByteLimit);
+            limit = SkTMin(limit, totalLimit);
         }
     }
     return limit;
@@ -449,85 +504,69 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-SK_DECLARE_STATIC_MUTEX(gMutex);
-static SkResourceCache* gResourceCache = nullptr;
-
-/** Must hold gMutex when calling. */
+// The cache does its own locking, so the global instance only needs to be created once.
 static SkResourceCache* get_cache() {
-    // gMutex is always held when this is called, so we don't need to be fancy in here.
-    gMutex.assertHeld();
-    if (nullptr == gResourceCache) {
+    static SkOnce once;
+    static SkResourceCache* cache;
+    once([] {
 #ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
+        cache = new SkResourceCache(SkDiscardableMemory::Create);
 #else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+        cache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
 #endif
-    }
-    return gResourceCache;
+    });
+    return cache;
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->getTotalBytesUsed();
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->getTotalByteLimit();
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->setTotalByteLimit(newLimit);
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->discardableFactory();
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->newCachedData(bytes);
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexAcquire am(gMutex);
     get_cache()->dump();
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->setSingleAllocationByteLimit(size);
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->getSingleAllocationByteLimit();
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->getEffectiveSingleAllocationByteLimit();
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->purgeAll();
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->find(key, visitor, context);
 }
 
 void SkResourceCache::Add(Rec* rec, void* payload) {
-    SkAutoMutexAcquire am(gMutex);
     get_cache()->add(rec, payload);
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
     get_cache()->visitAll(visitor, context);
 }
 
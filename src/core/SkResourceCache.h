@@ -10,8 +10,11 @@
 
 #include "SkBitmap.h"
 #include "SkMessageBus.h"
+#include "SkMutex.h"
 #include "SkTDArray.h"
 
+#include <atomic>
+
 class SkCachedData;
 class SkDiscardableMemory;
 class SkTraceMemoryDump;
@@ -19,12 +22,12 @@ class SkTraceMemoryDump;
 /**
  *  Cache object for bitmaps (with possible scale in X Y as part of the key).
  *
- *  Multiple caches can be instantiated, but each instance is not implicitly
- *  thread-safe, so if a given instance is to be shared across threads, the
- *  caller must manage the access itself (e.g. via a mutex).
+ *  Multiple caches can be instantiated, and each instance is thread-safe. Recs are spread by
+ *  key hash over independently locked shards, so threads finding or adding different keys
+ *  rarely contend; the byte and count budgets are still enforced across the whole cache.
  *
- *  As a convenience, a global instance is also defined, which can be safely
- *  access across threads via the static methods (e.g. FindAndLock, etc.).
+ *  As a convenience, a global instance is also defined, which can be accessed via the static
+ *  methods (e.g. Find, Add, etc.).
  */
 class SkResourceCache {
 public:
@@ -105,6 +108,9 @@ public:
     private:
         Rec*    fNext;
         Rec*    fPrev;
+        // When this was added or last found, used to purge the least recently used recs first
+        // across all the shards.
+        uint64_t fLastUse;
 
         friend class SkResourceCache;
     };
@@ -220,8 +226,8 @@ public:
     void add(Rec*, void* payload = nullptr);
     void visitAll(Visitor, void* context);
 
-    size_t getTotalBytesUsed() const { return fTotalBytesUsed; }
-    size_t getTotalByteLimit() const { return fTotalByteLimit; }
+    size_t getTotalBytesUsed() const { return fTotalBytesUsed.load(std::memory_order_relaxed); }
+    size_t getTotalByteLimit() const { return fTotalByteLimit.load(std::memory_order_relaxed); }
 
     /**
      *  This is respected by SkBitmapProcState::possiblyScaleImage.
@@ -257,35 +263,51 @@ public:
     void dump() const;
 
 private:
-    Rec*    fHead;
-    Rec*    fTail;
-
     class Hash;
-    Hash*   fHash;
+
+    static constexpr int kShardCount = 16;
+
+    // Each shard's lock guards its LRU list, its hash, and the recs in them.
+    struct Shard {
+        mutable SkMutex fMutex;
+        Rec*            fHead;
+        Rec*            fTail;
+        Hash*           fHash;
+    };
+
+    Shard* shardFor(const Key& key) { return &fShards[key.hash() % kShardCount]; }
+
+    Shard   fShards[kShardCount];
 
     DiscardableFactory  fDiscardableFactory;
 
-    size_t  fTotalBytesUsed;
-    size_t  fTotalByteLimit;
-    size_t  fSingleAllocationByteLimit;
-    int     fCount;
+    std::atomic<size_t>   fTotalBytesUsed;
+    std::atomic<size_t>   fTotalByteLimit;
+    std::atomic<size_t>   fSingleAllocationByteLimit;
+    std::atomic<int>      fCount;
+    std::atomic<uint64_t> fUseCounter;
+
+    // Only one thread purges at a time.
+    SkMutex fPurgeMutex;
 
     SkMessageBus<PurgeSharedIDMessage>::Inbox fPurgeSharedIDInbox;
 
     void checkMessages();
     void purgeAsNeeded(bool forcePurge = false);
 
-    // linklist management
-    void moveToHead(Rec*);
-    void addToHead(Rec*);
-    void release(Rec*);
-    void remove(Rec*);
+    // These methods can only be called when the shard's lock is already held.
+    void moveToHead(Shard*, Rec*);
+    void addToHead(Shard*, Rec*);
+    void release(Shard*, Rec*);
+    void remove(Shard*, Rec*);
 
     void init();    // called by constructors
 
 #ifdef SK_DEBUG
+    void validate(const Shard*) const;
     void validate() const;
 #else
+    void validate(const Shard*) const {}
     void validate() const {}
 #endif
 };
@@ -457,6 +457,23 @@ static void generateMask(const SkMask& mask, const SkPath& path,
     }
 }
 
+void SkScalerContext::getImages(SkSpan<const SkGlyph*> glyphs) {
+    // Mask filters and glyphs drawn from paths need the per glyph work in getImage().
+    if (fMaskFilter || fGenerateImageFromPath) {
+        for (const SkGlyph* glyph : glyphs) {
+            this->getImage(*glyph);
+        }
+        return;
+    }
+    this->generateImages(glyphs);
+}
+
+void SkScalerContext::generateImages(SkSpan<const SkGlyph*> glyphs) {
+    for (const SkGlyph* glyph : glyphs) {
+        this->generateImage(*glyph);
+    }
+}
+
 void SkScalerContext::getImage(const SkGlyph& origGlyph) {
     const SkGlyph*  glyph = &origGlyph;
     SkGlyph  tmpGlyph{origGlyph.getPackedID()};
@@ -19,6 +19,7 @@
 #include "SkMaskGamma.h"
 #include "SkMatrix.h"
 #include "SkPaint.h"
+#include "SkSpan.h"
 #include "SkSurfacePriv.h"
 #include "SkTypeface.h"
 #include "SkWriteBuffer.h"
@@ -289,6 +290,8 @@ public:
     void        getAdvance(SkGlyph*);
     void        getMetrics(SkGlyph*);
     void        getImage(const SkGlyph&);
+    // Same as calling getImage() for each glyph, but lets the port set up once for all of them.
+    void        getImages(SkSpan<const SkGlyph*>);
     bool SK_WARN_UNUSED_RESULT getPath(SkPackedGlyphID, SkPath*);
     void        getFontMetrics(SkFontMetrics*);
 
@@ -387,6 +390,12 @@ protected:
      */
     virtual void generateImage(const SkGlyph& glyph) = 0;
 
+    /** Generates the images of several glyphs, as if by generateImage() on each one in turn.
+     *  Ports override this when they can share work, such as locking and sizing the face, across
+     *  the glyphs.
+     */
+    virtual void generateImages(SkSpan<const SkGlyph*> glyphs);
+
     /** Sets the passed path to the glyph outline.
      *  If this cannot be done the path is set to empty;
      *  @return false if this glyph does not have any path.
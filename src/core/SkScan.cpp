@@ -16,6 +16,8 @@ std::atomic<bool> gSkForceAnalyticAA{false};
 std::atomic<bool> gSkUseDeltaAA{true};
 std::atomic<bool> gSkForceDeltaAA{false};
 
+std::atomic<SkExecutor*> gSkDAAExecutor{nullptr};
+
 static inline void blitrect(SkBlitter* blitter, const SkIRect& r) {
     blitter->blitRect(r.fLeft, r.fTop, r.width(), r.height());
 }
@@ -14,6 +14,7 @@
 #include "SkRect.h"
 #include <atomic>
 
+class SkExecutor;
 class SkRasterClip;
 class SkRegion;
 class SkBlitter;
@@ -29,6 +30,10 @@ extern std::atomic<bool> gSkForceDeltaAA;
 extern std::atomic<bool> gSkUseAnalyticAA;
 extern std::atomic<bool> gSkForceAnalyticAA;
 
+// If set, DAA splits the coverage deltas of very large paths into horizontal bands, generates them
+// on this executor, and blits the bands in order on the drawing thread. Not owned.
+extern std::atomic<SkExecutor*> gSkDAAExecutor;
+
 class AdditiveBlitter;
 
 class SkScan {
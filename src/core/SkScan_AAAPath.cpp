@@ -12,6 +12,7 @@
 #include "SkEdge.h"
 #include "SkEdgeBuilder.h"
 #include "SkGeometry.h"
+#include "SkNx.h"
 #include "SkPath.h"
 #include "SkQuadClipper.h"
 #include "SkRasterClip.h"
@@ -22,6 +23,7 @@
 #include "SkTemplates.h"
 #include "SkTo.h"
 #include "SkUTF.h"
+#include "SkUtils.h"
 
 #include <utility>
 
@@ -103,6 +105,51 @@ static inline void safelyAddAlpha(SkAlpha* alpha, SkAlpha delta) {
     *alpha = SkTMin(0xFF, *alpha + (int)delta);
 }
 
+// The span helpers below work on 16 alphas at a time with Sk16b. A saturating add is exactly
+// safelyAddAlpha(), and also matches addAlpha(), whose sums never go past 256.
+static SK_ALWAYS_INLINE void add_alphas(SkAlpha* alphas, const SkAlpha* deltas, int len) {
+    for (; len >= 16; alphas += 16, deltas += 16, len -= 16) {
+        Sk16b::Load(alphas).saturatedAdd(Sk16b::Load(deltas)).store(alphas);
+    }
+    for (int i = 0; i < len; ++i) {
+        safelyAddAlpha(&alphas[i], deltas[i]);
+    }
+}
+
+static SK_ALWAYS_INLINE void add_alpha(SkAlpha* alphas, SkAlpha delta, int len) {
+    const Sk16b delta16(delta);
+    for (; len >= 16; alphas += 16, len -= 16) {
+        Sk16b::Load(alphas).saturatedAdd(delta16).store(alphas);
+    }
+    for (int i = 0; i < len; ++i) {
+        safelyAddAlpha(&alphas[i], delta);
+    }
+}
+
+// alphas[i] = max(alphas[i] - deltas[i], 0)
+static SK_ALWAYS_INLINE void subtract_alphas(SkAlpha* alphas, const SkAlpha* deltas, int len) {
+    for (; len >= 16; alphas += 16, deltas += 16, len -= 16) {
+        Sk16b a = Sk16b::Load(alphas);
+        (a - Sk16b::Min(a, Sk16b::Load(deltas))).store(alphas);
+    }
+    for (int i = 0; i < len; ++i) {
+        alphas[i] = alphas[i] > deltas[i] ? alphas[i] - deltas[i] : 0;
+    }
+}
+
+// alphas[i] = (alpha16 + i * dY) >> 8, four pixels of the edge at a time.
+static SK_ALWAYS_INLINE void ramp_alphas(SkAlpha* alphas, SkFixed alpha16, SkFixed dY, int len) {
+    Sk4i ramp = Sk4i(alpha16) + Sk4i(0, 1, 2, 3) * Sk4i(dY);
+    const Sk4i step(4 * dY);
+    for (; len >= 4; alphas += 4, len -= 4) {
+        SkNx_cast<uint8_t>((ramp >> 8) & 0xFF).store(alphas);
+        ramp = ramp + step;
+    }
+    for (int i = 0; i < len; ++i) {
+        alphas[i] = ramp[i] >> 8;
+    }
+}
+
 class AdditiveBlitter : public SkBlitter {
 public:
     ~AdditiveBlitter() override {}
@@ -246,10 +293,7 @@ void MaskAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha alpha) {
 
 void MaskAdditiveBlitter::blitAntiH(int x, int y, int width, const SkAlpha alpha) {
     SkASSERT(x >= fMask.fBounds.fLeft -1);
-    uint8_t* row = this->getRow(y);
-    for (int i = 0; i < width; ++i) {
-        addAlpha(&row[x + i], alpha);
-    }
+    add_alpha(this->getRow(y) + x, alpha, width);
 }
 
 void MaskAdditiveBlitter::blitV(int x, int y, int height, SkAlpha alpha) {
@@ -445,9 +489,7 @@ void RunBasedAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha antialias[],
         }
         fRuns.fRuns[x + i] = 1;
     }
-    for (int i = 0; i < len; ++i) {
-        addAlpha(&fRuns.fAlpha[x + i], antialias[i]);
-    }
+    add_alphas(fRuns.fAlpha + x, antialias, len);
 }
 void RunBasedAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha alpha) {
     checkY(y);
@@ -513,9 +555,7 @@ void SafeRLEAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha antialias[],
         }
         fRuns.fRuns[x + i] = 1;
     }
-    for (int i = 0; i < len; ++i) {
-        safelyAddAlpha(&fRuns.fAlpha[x + i], antialias[i]);
-    }
+    add_alphas(fRuns.fAlpha + x, antialias, len);
 }
 
 void SafeRLEAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha alpha) {
@@ -611,10 +651,7 @@ static inline void computeAlphaAboveLine(SkAlpha* alphas, SkFixed l, SkFixed r,
         SkFixed firstH = SkFixedMul(first, dY); // vertical edge of the left-most triangle
         alphas[0] = SkFixedMul(first, firstH) >> 9; // triangle alpha
         SkFixed alpha16 = firstH + (dY >> 1); // rectangle plus triangle
-        for (int i = 1; i < R - 1; ++i) {
-            alphas[i] = alpha16 >> 8;
-            alpha16 += dY;
-        }
+        ramp_alphas(alphas + 1, alpha16, dY, R - 2);
         alphas[R - 1] = fullAlpha - partialTriangleToAlpha(last, dY);
     }
 }
@@ -635,10 +672,8 @@ static inline void computeAlphaBelowLine(
         SkFixed lastH = SkFixedMul(last, dY); // vertical edge of the right-most triangle
         alphas[R-1] = SkFixedMul(last, lastH) >> 9; // triangle alpha
         SkFixed alpha16 = lastH + (dY >> 1); // rectangle plus triangle
-        for (int i = R - 2; i > 0; i--) {
-            alphas[i] = alpha16 >> 8;
-            alpha16 += dY;
-        }
+        // alphas[R - 2] gets alpha16, and each pixel to the left gets dY more coverage.
+        ramp_alphas(alphas + 1, alpha16 + (R - 3) * dY, -dY, R - 2);
         alphas[0] = fullAlpha - partialTriangleToAlpha(first, dY);
     }
 }
@@ -690,13 +725,7 @@ static SK_ALWAYS_INLINE void blit_full_alpha(AdditiveBlitter* blitter, int y, in
                             SkAlpha fullAlpha, SkAlpha* maskRow, bool isUsingMask,
                             bool noRealBlitter, bool needSafeCheck) {
     if (isUsingMask) {
-        for (int i = 0; i < len; ++i) {
-            if (needSafeCheck) {
-                safelyAddAlpha(&maskRow[x + i], fullAlpha);
-            } else {
-                addAlpha(&maskRow[x + i], fullAlpha);
-            }
-        }
+        add_alpha(maskRow + x, fullAlpha, len);
     } else {
         if (fullAlpha == 0xFF && !noRealBlitter) {
             blitter->getRealBlitter()->blitH(x, y, len);
@@ -737,10 +766,8 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter, int y,
     SkAlpha* tempAlphas = alphas + len + 1;
     int16_t* runs = (int16_t*)(alphas + (len + 1) * 2);
 
-    for (int i = 0; i < len; ++i) {
-        runs[i] = 1;
-        alphas[i] = fullAlpha;
-    }
+    sk_memset16(reinterpret_cast<uint16_t*>(runs), 1, len);
+    memset(alphas, fullAlpha, len);
     runs[len] = 0;
 
     int uL = SkFixedFloorToInt(ul);
@@ -755,13 +782,7 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter, int y,
     } else {
         computeAlphaBelowLine(tempAlphas + uL - L, ul - SkIntToFixed(uL), ll - SkIntToFixed(uL),
                 lDY, fullAlpha);
-        for (int i = uL; i < lL; ++i) {
-            if (alphas[i - L] > tempAlphas[i - L]) {
-                alphas[i - L] -= tempAlphas[i - L];
-            } else {
-                alphas[i - L] = 0;
-            }
-        }
+        subtract_alphas(alphas + uL - L, tempAlphas + uL - L, lL - uL);
     }
 
     int uR = SkFixedFloorToInt(ur);
@@ -776,23 +797,11 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter, int y,
     } else {
         computeAlphaAboveLine(tempAlphas + uR - L, ur - SkIntToFixed(uR), lr - SkIntToFixed(uR),
                 rDY, fullAlpha);
-        for (int i = uR; i < lR; ++i) {
-            if (alphas[i - L] > tempAlphas[i - L]) {
-                alphas[i - L] -= tempAlphas[i - L];
-            } else {
-                alphas[i - L] = 0;
-            }
-        }
+        subtract_alphas(alphas + uR - L, tempAlphas + uR - L, lR - uR);
     }
 
     if (isUsingMask) {
-        for (int i = 0; i < len; ++i) {
-            if (needSafeCheck) {
-                safelyAddAlpha(&maskRow[L + i], alphas[i]);
-            } else {
-                addAlpha(&maskRow[L + i], alphas[i]);
-            }
-        }
+        add_alphas(maskRow + L, alphas, len);
     } else {
         if (fullAlpha == 0xFF && !noRealBlitter) {
             // Real blitter is faster than RunBasedAdditiveBlitter
@@ -915,8 +924,11 @@ static bool operator<(const SkAnalyticEdge& a, const SkAnalyticEdge& b) {
     return valuea < valueb;
 }
 
-static SkAnalyticEdge* sort_edges(SkAnalyticEdge* list[], int count, SkAnalyticEdge** last) {
-    SkTQSort(list, list + count - 1);
+static SkAnalyticEdge* sort_edges(SkAnalyticEdge* list[], int count, SkAnalyticEdge** last, bool isConvex) {
+    // A convex path's edges come out of the builder in (cyclic) order, rising then falling.
+    if (!isConvex || !SkTSortCyclicBitonic(list, count)) {
+        SkTQSort(list, list + count - 1);
+    }
 
     // now make the edges linked in sorted order
     for (int i = 1; i < count; ++i) {
@@ -1623,7 +1635,7 @@ static SK_ALWAYS_INLINE void aaa_fill_path(const SkPath& path, const SkIRect& cl
 
     SkAnalyticEdge headEdge, tailEdge, *last;
     // this returns the first and last edge after they're sorted into a dlink list
-    SkAnalyticEdge* edge = sort_edges(list, count, &last);
+    SkAnalyticEdge* edge = sort_edges(list, count, &last, path.isConvex());
 
     headEdge.fRiteE = nullptr;
     headEdge.fPrev = nullptr;
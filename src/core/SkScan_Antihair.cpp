@@ -11,6 +11,7 @@
 #include "SkColorData.h"
 #include "SkFDot6.h"
 #include "SkLineClipper.h"
+#include "SkMask.h"
 #include "SkRasterClip.h"
 #include "SkTo.h"
 
@@ -251,6 +252,86 @@ public:
     }
 };
 
+/*  Records the calls the SkAntiHairBlitters make into a small A8 mask, so that instead of a
+    blitter call or two per pixel column, the real blitter sees a single blitMask(), which its
+    (vectorized) mask procs blend in one pass. Only the pixels that were actually drawn are
+    blitted, so the mask never reaches past what the per-pixel calls would have touched.
+ */
+class HairMaskBlitter final : public SkBlitter {
+public:
+    static constexpr int kStorageSize = 4096;
+    static constexpr int kMaxThickness = 8;  // rows (or columns) across the line's direction
+
+    static bool Fits(const SkIRect& bounds) {
+        return SkTMin(bounds.width(), bounds.height()) <= kMaxThickness &&
+               bounds.width() * bounds.height() <= kStorageSize;
+    }
+
+    explicit HairMaskBlitter(const SkIRect& bounds) {
+        SkASSERT(Fits(bounds));
+        fMask.fImage    = fStorage;
+        fMask.fBounds   = bounds;
+        fMask.fRowBytes = bounds.width();
+        fMask.fFormat   = SkMask::kA8_Format;
+        memset(fStorage, 0, fMask.computeImageSize());
+        fDrawn.setEmpty();
+    }
+
+    // Blits what was drawn, clipped to clip if there is one.
+    void blitTo(SkBlitter* blitter, const SkIRect* clip) const {
+        SkIRect r = fDrawn;
+        if (clip && !r.intersect(*clip)) {
+            return;
+        }
+        if (!r.isEmpty()) {
+            blitter->blitMask(fMask, r);
+        }
+    }
+
+    void blitH(int x, int y, int width) override {
+        memset(this->addr(x, y, width, 1), 0xFF, width);
+    }
+
+    void blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) override {
+        for (int n = runs[0]; n > 0; n = runs[0]) {
+            memset(this->addr(x, y, n, 1), aa[0], n);
+            x += n;
+            runs += n;
+            aa += n;
+        }
+    }
+
+    void blitV(int x, int y, int height, SkAlpha alpha) override {
+        uint8_t* dst = this->addr(x, y, 1, height);
+        for (int i = 0; i < height; i++) {
+            dst[i * fMask.fRowBytes] = alpha;
+        }
+    }
+
+    void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override {
+        uint8_t* dst = this->addr(x, y, 2, 1);
+        dst[0] = SkToU8(a0);
+        dst[1] = SkToU8(a1);
+    }
+
+    void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override {
+        uint8_t* dst = this->addr(x, y, 1, 2);
+        dst[0] = SkToU8(a0);
+        dst[fMask.fRowBytes] = SkToU8(a1);
+    }
+
+private:
+    uint8_t* addr(int x, int y, int width, int height) {
+        SkASSERT(fMask.fBounds.contains(SkIRect::MakeXYWH(x, y, width, height)));
+        fDrawn.join(x, y, x + width, y + height);
+        return fStorage + (y - fMask.fBounds.fTop) * fMask.fRowBytes + (x - fMask.fBounds.fLeft);
+    }
+
+    SkMask  fMask;
+    SkIRect fDrawn;
+    uint8_t fStorage[kStorageSize];
+};
+
 static inline SkFixed fastfixdiv(SkFDot6 a, SkFDot6 b) {
     SkASSERT((SkLeftShift(a, 16) >> 16) == a);
     SkASSERT(b != 0);
@@ -304,6 +385,9 @@ static int contribution_64(SkFDot6 ordinate) {
     return result;
 }
 
+static void draw_anti_hairline(SkAntiHairBlitter*, int istart, int istop,
+                               SkFixed fstart, SkFixed slope, int scaleStart, int scaleStop);
+
 static void do_anti_hairline(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1,
                              const SkIRect* clip, SkBlitter* blitter) {
     // check for integer NaN (0x80000000) which we can't handle (can't negate it)
@@ -344,7 +428,8 @@ static void do_anti_hairline(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1,
     Vertish_SkAntiHairBlitter   vertish_blitter;
     SkAntiHairBlitter*          hairBlitter = nullptr;
 
-    if (SkAbs32(x1 - x0) > SkAbs32(y1 - y0)) {   // mostly horizontal
+    const bool horizontal = SkAbs32(x1 - x0) > SkAbs32(y1 - y0);
+    if (horizontal) {   // mostly horizontal
         if (x0 > x1) {    // we want to go left-to-right
             using std::swap;
             swap(x0, x1);
@@ -497,22 +582,46 @@ static void do_anti_hairline(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1,
         }
     }
 
+#ifdef SK_DEBUG
+    if (scaleStart > 0 && scaleStop > 0) {
+        // be sure we don't draw twice in the same pixel
+        SkASSERT(istart < istop - 1);
+    }
+#endif
+
+    // Every pixel drawn is one of the two on either side of fstart + i * slope (the cross
+    // ordinate at step i, offset by 1/2), for i in [0, istop - istart).
+    SkFixed crossFirst = fstart + SK_FixedHalf,
+            crossLast  = fstart + (istop - istart - 1) * slope + SK_FixedHalf;
+    if (crossFirst > crossLast) {
+        using std::swap;
+        swap(crossFirst, crossLast);
+    }
+    SkIRect bounds = horizontal
+        ? SkIRect::MakeLTRB(istart, (crossFirst >> 16) - 1, istop, (crossLast >> 16) + 1)
+        : SkIRect::MakeLTRB((crossFirst >> 16) - 1, istart, (crossLast >> 16) + 1, istop);
+
+    SkASSERT(hairBlitter);
+    if (HairMaskBlitter::Fits(bounds)) {
+        HairMaskBlitter maskBlitter(bounds);
+        hairBlitter->setup(&maskBlitter);
+        draw_anti_hairline(hairBlitter, istart, istop, fstart, slope, scaleStart, scaleStop);
+        maskBlitter.blitTo(blitter, clip);
+        return;
+    }
+
     SkRectClipBlitter   rectClipper;
     if (clip) {
         rectClipper.init(blitter, *clip);
         blitter = &rectClipper;
     }
 
-    SkASSERT(hairBlitter);
     hairBlitter->setup(blitter);
+    draw_anti_hairline(hairBlitter, istart, istop, fstart, slope, scaleStart, scaleStop);
+}
 
-#ifdef SK_DEBUG
-    if (scaleStart > 0 && scaleStop > 0) {
-        // be sure we don't draw twice in the same pixel
-        SkASSERT(istart < istop - 1);
-    }
-#endif
-
+static void draw_anti_hairline(SkAntiHairBlitter* hairBlitter, int istart, int istop,
+                               SkFixed fstart, SkFixed slope, int scaleStart, int scaleStop) {
     fstart = hairBlitter->drawCap(istart, fstart, slope, scaleStart);
     istart += 1;
     int fullSpans = istop - istart - (scaleStop > 0);
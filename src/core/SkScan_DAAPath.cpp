@@ -20,7 +20,9 @@
 #include "SkRegion.h"
 #include "SkScan.h"
 #include "SkScanPriv.h"
+#include "SkTArray.h"
 #include "SkTSort.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkUTF.h"
 
@@ -156,82 +158,38 @@ public:
     }
 };
 
-template<class Deltas> static SK_ALWAYS_INLINE
-void gen_alpha_deltas(const SkPath& path, const SkIRect& clippedIR, const SkIRect& clipBounds,
-        Deltas& result, SkBlitter* blitter, bool skipRect, bool pathContainedInClip) {
-    // 1. Build edges
-    SkBezierEdgeBuilder builder;
-    // We have to use clipBounds instead of clippedIR to build edges because of "canCullToTheRight":
-    // if the builder finds a right edge past the right clip, it won't build that right edge.
-    int  count = builder.buildEdges(path, pathContainedInClip ? nullptr : &clipBounds);
-
-    if (count == 0) {
-        return;
-    }
-    SkBezier** list = builder.bezierList();
-
-    // 2. Try to find the rect part because blitAntiRect is so much faster than blitCoverageDeltas
-    int rectTop = clippedIR.fBottom;   // the rect is initialized to be empty as top = bot
-    int rectBot = clippedIR.fBottom;
-    if (skipRect) {             // only find that rect is skipRect == true
-        YLessThan lessThan;     // sort edges in YX order
-        SkTQSort(list, list + count - 1, lessThan);
-        for(int i = 0; i < count - 1; ++i) {
-            SkBezier* lb = list[i];
-            SkBezier* rb = list[i + 1];
-
-            // fCount == 2 ensures that lb and rb are lines instead of quads or cubics.
-            bool lDX0 = lb->fP0.fX == lb->fP1.fX && lb->fCount == 2;
-            bool rDX0 = rb->fP0.fX == rb->fP1.fX && rb->fCount == 2;
-            if (!lDX0 || !rDX0) { // make sure that the edges are vertical
-                continue;
-            }
-
-            SkAnalyticEdge l, r;
-            if (!l.setLine(lb->fP0, lb->fP1) || !r.setLine(rb->fP0, rb->fP1)) {
-                continue;
-            }
-
-            SkFixed xorUpperY = l.fUpperY ^ r.fUpperY;
-            SkFixed xorLowerY = l.fLowerY ^ r.fLowerY;
-            if ((xorUpperY | xorLowerY) == 0) { // equal upperY and lowerY
-                rectTop = SkFixedCeilToInt(l.fUpperY);
-                rectBot = SkFixedFloorToInt(l.fLowerY);
-                if (rectBot > rectTop) { // if bot == top, the rect is too short for blitAntiRect
-                    int L = SkFixedCeilToInt(l.fUpperX);
-                    int R = SkFixedFloorToInt(r.fUpperX);
-                    if (L <= R) {
-                        SkAlpha la = (SkIntToFixed(L) - l.fUpperX) >> 8;
-                        SkAlpha ra = (r.fUpperX - SkIntToFixed(R)) >> 8;
-                        result.setAntiRect(L - 1, rectTop, R - L, rectBot - rectTop, la, ra);
-                    } else { // too thin to use blitAntiRect; reset the rect region to be emtpy
-                        rectTop = rectBot = clippedIR.fBottom;
-                    }
-                }
-                break;
-            }
-
-        }
-    }
-
-    // 3. Sort edges in x so we may need less sorting for delta based on x. This only helps
-    //    SkCoverageDeltaList. And we don't want to sort more than SORT_THRESHOLD edges where
-    //    the log(count) factor of the quick sort may become a bottleneck; when there are so
-    //    many edges, we're unlikely to make deltas sorted anyway.
-    constexpr int SORT_THRESHOLD = 256;
-    if (std::is_same<Deltas, SkCoverageDeltaList>::value && count < SORT_THRESHOLD) {
-        XLessThan lessThan;
-        SkTQSort(list, list + count - 1, lessThan);
+// Returns true if none of the bezier's rows can be in [top, bottom). The curve is inside the hull
+// of its control points; the extra row covers the fixed point rounding of its edges.
+static bool bezier_misses_band(const SkBezier* bezier, int top, int bottom) {
+    SkScalar minY = SkTMin(bezier->fP0.fY, bezier->fP1.fY);
+    SkScalar maxY = SkTMax(bezier->fP0.fY, bezier->fP1.fY);
+    if (bezier->fCount == 3) {
+        const SkQuad* quad = static_cast<const SkQuad*>(bezier);
+        minY = SkTMin(minY, quad->fP2.fY);
+        maxY = SkTMax(maxY, quad->fP2.fY);
+    } else if (bezier->fCount == 4) {
+        const SkCubic* cubic = static_cast<const SkCubic*>(bezier);
+        minY = SkTMin(minY, SkTMin(cubic->fP2.fY, cubic->fP3.fY));
+        maxY = SkTMax(maxY, SkTMax(cubic->fP2.fY, cubic->fP3.fY));
     }
+    return maxY < top - 1 || minY >= bottom + 1;
+}
 
-    // Future todo: parallize and SIMD the following code.
-    // 4. iterate through edges and generate deltas
+// Generates the deltas of all edges for the rows in clippedIR, skipping the rect part in
+// [rectTop, rectBot). If isBand, clippedIR is one horizontal band of the path and the edges extend
+// above and below it, so every row is checked against the band.
+template<bool isBand, class Deltas> static SK_ALWAYS_INLINE
+void gen_edge_deltas(SkBezier* const* list, int count, const SkIRect& clippedIR, int rectTop,
+                     int rectBot, Deltas& result) {
     for(int index = 0; index < count; ++index) {
         SkAnalyticCubicEdge storage;
         SkASSERT(sizeof(SkAnalyticQuadraticEdge) >= sizeof(SkAnalyticEdge));
         SkASSERT(sizeof(SkAnalyticCubicEdge) >= sizeof(SkAnalyticQuadraticEdge));
 
         SkBezier* bezier        = list[index];
+        if (isBand && bezier_misses_band(bezier, clippedIR.fTop, clippedIR.fBottom)) {
+            continue;
+        }
         SkAnalyticEdge* currE   = &storage;
         bool edgeSet            = false;
 
@@ -265,6 +223,10 @@ void gen_alpha_deltas(const SkPath& path, const SkIRect& clippedIR, const SkIRec
         }
 
         do {
+            if (isBand && (currE->fLowerY <= SkIntToFixed(clippedIR.fTop) ||
+                           currE->fUpperY >= SkIntToFixed(clippedIR.fBottom))) {
+                continue;
+            }
             currE->fX =  currE->fUpperX;
 
             SkFixed upperFloor  = SkFixedFloorToFixed(currE->fUpperY);
@@ -285,14 +247,27 @@ void gen_alpha_deltas(const SkPath& path, const SkIRect& clippedIR, const SkIRec
             SkFixed nextX;
             if (rowHeight != SK_Fixed1) {   // it's a partial row
                 nextX = currE->fX + SkFixedMul(currE->fDX, rowHeight);
-                add_coverage_delta_segment<true>(iy, rowHeight, currE, nextX, &result);
+                if (!isBand || iy >= clippedIR.fTop) {
+                    add_coverage_delta_segment<true>(iy, rowHeight, currE, nextX, &result);
+                }
             } else {                        // it's a full row so we can leave it to the while loop
                 iy--;                       // compensate the iy++ in the while loop
                 nextX = currE->fX;
             }
 
+            if (isBand && iy + 1 < clippedIR.fTop) {
+                // Jump to the band's first row. Adding up fDX for the skipped rows gives exactly
+                // the same nextX as stepping through them.
+                int skippedRows = clippedIR.fTop - (iy + 1);
+                nextX += currE->fDX * skippedRows;
+                iy += skippedRows;
+            }
+
             while (true) { // process the full rows in the middle
                 iy++;
+                if (isBand && iy >= clippedIR.fBottom) {
+                    break; // the rest of this edge is below the band
+                }
                 SkFixed y = SkIntToFixed(iy);
                 currE->fX = nextX;
                 nextX += currE->fDX;
@@ -324,6 +299,132 @@ void gen_alpha_deltas(const SkPath& path, const SkIRect& clippedIR, const SkIRec
     }
 }
 
+template<class Deltas> static SK_ALWAYS_INLINE
+void gen_alpha_deltas(const SkPath& path, const SkIRect& clippedIR, const SkIRect& clipBounds,
+        Deltas& result, SkBlitter* blitter, bool skipRect, bool pathContainedInClip) {
+    // 1. Build edges
+    SkBezierEdgeBuilder builder;
+    // We have to use clipBounds instead of clippedIR to build edges because of "canCullToTheRight":
+    // if the builder finds a right edge past the right clip, it won't build that right edge.
+    int  count = builder.buildEdges(path, pathContainedInClip ? nullptr : &clipBounds);
+
+    if (count == 0) {
+        return;
+    }
+    SkBezier** list = builder.bezierList();
+
+    // 2. Try to find the rect part because blitAntiRect is so much faster than blitCoverageDeltas
+    int rectTop = clippedIR.fBottom;   // the rect is initialized to be empty as top = bot
+    int rectBot = clippedIR.fBottom;
+    if (skipRect) {             // only find that rect is skipRect == true
+        YLessThan lessThan;     // sort edges in YX order
+        SkTQSort(list, list + count - 1, lessThan);
+        for(int i = 0; i < count - 1; ++i) {
+            SkBezier* lb = list[i];
+            SkBezier* rb = list[i + 1];
+
+            // fCount == 2 ensures that lb and rb are lines instead of quads or cubics.
+            bool lDX0 = lb->fP0.fX == lb->fP1.fX && lb->fCount == 2;
+            bool rDX0 = rb->fP0.fX == rb->fP1.fX && rb->fCount == 2;
+            if (!lDX0 || !rDX0) { // make sure that the edges are vertical
+                continue;
+            }
+
+            SkAnalyticEdge l, r;
+            if (!l.setLine(lb->fP0, lb->fP1) || !r.setLine(rb->fP0, rb->fP1)) {
+                continue;
+            }
+
+            SkFixed xorUpperY = l.fUpperY ^ r.fUpperY;
+            SkFixed xorLowerY = l.fLowerY ^ r.fLowerY;
+            if ((xorUpperY | xorLowerY) == 0) { // equal upperY and lowerY
+                rectTop = SkFixedCeilToInt(l.fUpperY);
+                rectBot = SkFixedFloorToInt(l.fLowerY);
+                if (rectBot > rectTop) { // if bot == top, the rect is too short for blitAntiRect
+                    int L = SkFixedCeilToInt(l.fUpperX);
+                    int R = SkFixedFloorToInt(r.fUpperX);
+                    if (L <= R) {
+                        SkAlpha la = (SkIntToFixed(L) - l.fUpperX) >> 8;
+                        SkAlpha ra = (r.fUpperX - SkIntToFixed(R)) >> 8;
+                        result.setAntiRect(L - 1, rectTop, R - L, rectBot - rectTop, la, ra);
+                    } else { // too thin to use blitAntiRect; reset the rect region to be emtpy
+                        rectTop = rectBot = clippedIR.fBottom;
+                    }
+                }
+                break;
+            }
+
+        }
+    }
+
+    // 3. Sort edges in x so we may need less sorting for delta based on x. This only helps
+    //    SkCoverageDeltaList. And we don't want to sort more than SORT_THRESHOLD edges where
+    //    the log(count) factor of the quick sort may become a bottleneck; when there are so
+    //    many edges, we're unlikely to make deltas sorted anyway.
+    constexpr int SORT_THRESHOLD = 256;
+    if (std::is_same<Deltas, SkCoverageDeltaList>::value && count < SORT_THRESHOLD) {
+        XLessThan lessThan;
+        SkTQSort(list, list + count - 1, lessThan);
+    }
+
+    // 4. iterate through edges and generate deltas
+    gen_edge_deltas<false>(list, count, clippedIR, rectTop, rectBot, result);
+}
+
+// Paths with at least this many verbs are split into bands when gSkDAAExecutor is set.
+static constexpr int kMinBandedVerbCount = 16384;
+static constexpr int kMinBandHeight      = 32;
+static constexpr int kMaxBandCount       = 32;
+
+static bool should_fill_in_bands(const SkPath& path, const SkIRect& clippedIR) {
+    return path.countVerbs() >= kMinBandedVerbCount &&
+           clippedIR.height() >= 2 * kMinBandHeight &&
+           !SkCoverageDeltaMask::Suitable(clippedIR);
+}
+
+// Splits clippedIR into horizontal bands and generates each band's coverage deltas on the
+// executor, all from one shared edge list. The bands are then blitted in order on this thread.
+static void fill_path_in_bands(const SkPath& path, SkBlitter* blitter, const SkIRect& clippedIR,
+                               const SkIRect& clipBounds, bool forceRLE, bool isEvenOdd,
+                               bool isConvex, bool containedInClip, SkExecutor* executor) {
+    SkBezierEdgeBuilder builder;
+    int count = builder.buildEdges(path, containedInClip ? nullptr : &clipBounds);
+    if (count == 0) {
+        return;
+    }
+    SkBezier* const* list = builder.bezierList();
+
+    int bandCount = SkTMin(kMaxBandCount, clippedIR.height() / kMinBandHeight);
+    int bandHeight = (clippedIR.height() + bandCount - 1) / bandCount;
+
+    // SkArenaAlloc isn't thread safe, so every band allocates its deltas from its own arena.
+    SkTArray<std::unique_ptr<SkArenaAlloc>> allocs(bandCount);
+    SkSTArray<kMaxBandCount, SkCoverageDeltaList*> bandDeltas;
+    for (int i = 0; i < bandCount; ++i) {
+        allocs.emplace_back(new SkArenaAlloc(32 << 10));
+        bandDeltas.push_back(nullptr);
+    }
+
+    SkTaskGroup(*executor).batch(bandCount, [&](int i) {
+        SkIRect band = clippedIR;
+        band.fTop = clippedIR.fTop + i * bandHeight;
+        band.fBottom = SkTMin(clippedIR.fBottom, band.fTop + bandHeight);
+        if (band.isEmpty()) {
+            return;
+        }
+        SkCoverageDeltaList* deltas = allocs[i]->make<SkCoverageDeltaList>(allocs[i].get(), band,
+                                                                          forceRLE);
+        gen_edge_deltas<true>(list, count, band, band.fBottom, band.fBottom, *deltas);
+        bandDeltas[i] = deltas;
+    });
+
+    for (SkCoverageDeltaList* deltas : bandDeltas) {
+        if (deltas) {
+            blitter->blitCoverageDeltas(deltas, clipBounds, isEvenOdd, false, isConvex);
+        }
+    }
+}
+
 void SkScan::DAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& ir,
                          const SkIRect& clipBounds, bool forceRLE, SkDAARecord* record) {
     bool containedInClip = clipBounds.contains(ir);
@@ -336,6 +437,17 @@ void SkScan::DAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect&
     SkIRect clippedIR = ir;
     clippedIR.intersect(clipBounds);
 
+    // Recorded fills already run on the threaded backend's own threads.
+    if (!record && !isInverse) {
+        if (SkExecutor* executor = gSkDAAExecutor.load(std::memory_order_relaxed)) {
+            if (should_fill_in_bands(path, clippedIR)) {
+                fill_path_in_bands(path, blitter, clippedIR, clipBounds, forceRLE, isEvenOdd,
+                                   isConvex, containedInClip, executor);
+                return;
+            }
+        }
+    }
+
     // The overhead of even constructing SkCoverageDeltaList/Mask is too big.
     // So TryBlitFatAntiRect and return if it's successful.
     if (!isInverse && TryBlitFatAntiRect(blitter, path, clipBounds)) {
@@ -234,23 +234,20 @@ static void hair_quad(const SkPoint pts[3], const SkRegion* clip,
                      SkBlitter* blitter, int level, SkScan::HairRgnProc lineproc) {
     SkASSERT(level <= kMaxQuadSubdivideLevel);
 
-    SkQuadCoeff coeff(pts);
-
     const int lines = 1 << level;
-    Sk2s t(0);
-    Sk2s dt(SK_Scalar1 / lines);
+    const SkScalar dt = SK_Scalar1 / lines;
 
     SkPoint tmp[(1 << kMaxQuadSubdivideLevel) + 1];
+    SkScalar ts[(1 << kMaxQuadSubdivideLevel)];
     SkASSERT((unsigned)lines < SK_ARRAY_COUNT(tmp));
 
-    tmp[0] = pts[0];
-    Sk2s A = coeff.fA;
-    Sk2s B = coeff.fB;
-    Sk2s C = coeff.fC;
+    SkScalar t = 0;
     for (int i = 1; i < lines; ++i) {
-        t = t + dt;
-        ((A * t + B) * t + C).store(&tmp[i]);
+        t += dt;
+        ts[i - 1] = t;
     }
+    tmp[0] = pts[0];
+    SkEvalQuadAt(pts, ts, &tmp[1], lines - 1);
     tmp[lines] = pts[2];
     lineproc(tmp, lines + 1, clip, blitter);
 }
@@ -349,13 +346,6 @@ static bool quick_cubic_niceness_check(const SkPoint pts[4]) {
            lt_90(pts[2], pts[3], pts[0]);
 }
 
-typedef SkNx<2, uint32_t> Sk2x32;
-
-static inline Sk2x32 sk2s_is_finite(const Sk2s& x) {
-    const Sk2x32 exp_mask = Sk2x32(0xFF << 23);
-    return (Sk2x32::Load(&x) & exp_mask) != exp_mask;
-}
-
 static void hair_cubic(const SkPoint pts[4], const SkRegion* clip, SkBlitter* blitter,
                        SkScan::HairRgnProc lineproc) {
     const int lines = compute_cubic_segs(pts);
@@ -366,27 +356,20 @@ static void hair_cubic(const SkPoint pts[4], const SkRegion* clip, SkBlitter* bl
         return;
     }
 
-    SkCubicCoeff coeff(pts);
-
-    const Sk2s dt(SK_Scalar1 / lines);
-    Sk2s t(0);
+    const SkScalar dt = SK_Scalar1 / lines;
 
     SkPoint tmp[(1 << kMaxCubicSubdivideLevel) + 1];
+    SkScalar ts[(1 << kMaxCubicSubdivideLevel)];
     SkASSERT((unsigned)lines < SK_ARRAY_COUNT(tmp));
 
-    tmp[0] = pts[0];
-    Sk2s A = coeff.fA;
-    Sk2s B = coeff.fB;
-    Sk2s C = coeff.fC;
-    Sk2s D = coeff.fD;
-    Sk2x32 is_finite(~0);   // start out as true
+    SkScalar t = 0;
     for (int i = 1; i < lines; ++i) {
-        t = t + dt;
-        Sk2s p = ((A * t + B) * t + C) * t + D;
-        is_finite &= sk2s_is_finite(p);
-        p.store(&tmp[i]);
+        t += dt;
+        ts[i - 1] = t;
     }
-    if (is_finite.allTrue()) {
+    tmp[0] = pts[0];
+    SkEvalCubicAt(pts, ts, &tmp[1], lines - 1);
+    if (SkScalarsAreFinite(&tmp[1].fX, 2 * (lines - 1))) {
         tmp[lines] = pts[3];
         lineproc(tmp, lines + 1, clip, blitter);
     } // else some point(s) are non-finite, so don't draw
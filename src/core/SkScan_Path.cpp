@@ -379,8 +379,11 @@ static bool operator<(const SkEdge& a, const SkEdge& b) {
     return valuea < valueb;
 }
 
-static SkEdge* sort_edges(SkEdge* list[], int count, SkEdge** last) {
-    SkTQSort(list, list + count - 1);
+static SkEdge* sort_edges(SkEdge* list[], int count, SkEdge** last, bool isConvex) {
+    // A convex path's edges come out of the builder in (cyclic) order, rising then falling.
+    if (!isConvex || !SkTSortCyclicBitonic(list, count)) {
+        SkTQSort(list, list + count - 1);
+    }
 
     // now make the edges linked in sorted order
     for (int i = 1; i < count; i++) {
@@ -434,7 +437,7 @@ void sk_fill_path(const SkPath& path, const SkIRect& clipRect, SkBlitter* blitte
 
     SkEdge headEdge, tailEdge, *last;
     // this returns the first and last edge after they're sorted into a dlink list
-    SkEdge* edge = sort_edges(list, count, &last);
+    SkEdge* edge = sort_edges(list, count, &last, path.isConvex());
 
     headEdge.fPrev = nullptr;
     headEdge.fNext = edge;
@@ -713,7 +716,7 @@ static void sk_fill_triangle(const SkPoint pts[], const SkIRect* clipRect,
     SkEdge headEdge, tailEdge, *last;
 
     // this returns the first and last edge after they're sorted into a dlink list
-    SkEdge* edge = sort_edges(list, count, &last);
+    SkEdge* edge = sort_edges(list, count, &last, true);
 
     headEdge.fPrev = nullptr;
     headEdge.fNext = edge;
@@ -57,6 +57,57 @@
         }
         void wait() { WaitForSingleObject(fSemaphore, INFINITE/*timeout in ms*/); }
     };
+#elif defined(__linux__)
+    // On Linux we park threads on a futex over our own count of signals, rather than use a sem_t.
+    // That lets a waiter spin before parking and lets signal() skip the kernel when nobody sleeps.
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <thread>
+    #include <unistd.h>
+
+    struct SkBaseSemaphore::OSSemaphore {
+        static_assert(sizeof(std::atomic<int>) == sizeof(int), "futexes are plain ints");
+
+        // Signals not yet consumed by a wait(), and how many threads are asleep waiting for one.
+        std::atomic<int> fTokens{0};
+        std::atomic<int> fSleepers{0};
+
+        // signal() usually follows soon after a thread decides it must wait, so spin this many
+        // times before going to sleep.  That only helps if the signaling thread can run meanwhile.
+        static int SpinCount() {
+            static const int kSpinCount = std::thread::hardware_concurrency() > 1 ? 1024 : 0;
+            return kSpinCount;
+        }
+
+        int* futex() { return reinterpret_cast<int*>(&fTokens); }
+
+        void signal(int n) {
+            // Both of these are seq_cst, pairing with wait(): either we see its sleeper, or its
+            // FUTEX_WAIT sees our tokens and doesn't sleep.
+            fTokens.fetch_add(n);
+            if (fSleepers.load() > 0) {
+                syscall(SYS_futex, this->futex(), FUTEX_WAKE_PRIVATE, n, nullptr, nullptr, 0);
+            }
+        }
+        void wait() {
+            const int spinCount = SpinCount();
+            for (int spin = 0; ; spin++) {
+                int tokens = fTokens.load(std::memory_order_relaxed);
+                if (tokens > 0) {
+                    if (fTokens.compare_exchange_weak(tokens, tokens - 1,
+                                                      std::memory_order_acquire,
+                                                      std::memory_order_relaxed)) {
+                        return;
+                    }
+                } else if (spin >= spinCount) {
+                    // This only sleeps if fTokens is still 0, and may wake spuriously.
+                    fSleepers.fetch_add(1);
+                    syscall(SYS_futex, this->futex(), FUTEX_WAIT_PRIVATE, 0, nullptr, nullptr, 0);
+                    fSleepers.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    };
 #else
     // It's important we test for Mach before this.  This code will compile but not work there.
     #include <errno.h>
@@ -10,6 +10,8 @@
 #include "SkTypes.h"
 #include "SkSemaphore.h"
 
+#include <thread>
+
 #if !defined(__has_feature)
     #define __has_feature(x) 0
 #endif
@@ -261,9 +263,29 @@
         kWaitingSharedMask     = ((1 << kLogThreadCount) - 1) << kWaitingSharedOffset,
     };
 
+    // Locks are usually held only briefly, so before queuing up behind the current holders (and
+    // probably sleeping), try this many times to take the lock as if it were uncontended.  That
+    // only helps if the holders can run meanwhile.
+    static int spin_count() {
+        static const int kSpinCount = std::thread::hardware_concurrency() > 1 ? 64 : 0;
+        return kSpinCount;
+    }
+
     SkSharedMutex::SkSharedMutex() : fQueueCounts(0) { ANNOTATE_RWLOCK_CREATE(this); }
     SkSharedMutex::~SkSharedMutex() {  ANNOTATE_RWLOCK_DESTROY(this); }
     void SkSharedMutex::acquire() {
+        // The lock is free only if nobody holds or waits for it in any way.
+        for (int spin = 0, spinCount = spin_count(); spin < spinCount; spin++) {
+            int32_t oldQueueCounts = 0;
+            if (fQueueCounts.load(std::memory_order_relaxed) == 0 &&
+                fQueueCounts.compare_exchange_weak(oldQueueCounts, 1 << kWaitingExlusiveOffset,
+                                                   std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+                ANNOTATE_RWLOCK_ACQUIRED(this, 1);
+                return;
+            }
+        }
+
         // Increment the count of exclusive queue waiters.
         int32_t oldQueueCounts = fQueueCounts.fetch_add(1 << kWaitingExlusiveOffset,
                                                         std::memory_order_acquire);
@@ -318,7 +340,13 @@
     }
 
     void SkSharedMutex::acquireShared() {
+        // Readers can run alongside each other whenever no exclusive lock is held or waited for.
         int32_t oldQueueCounts = fQueueCounts.load(std::memory_order_relaxed);
+        for (int spin = 0, spinCount = spin_count();
+             spin < spinCount && (oldQueueCounts & kWaitingExclusiveMask) > 0; spin++) {
+            oldQueueCounts = fQueueCounts.load(std::memory_order_relaxed);
+        }
+
         int32_t newQueueCounts;
         do {
             newQueueCounts = oldQueueCounts;
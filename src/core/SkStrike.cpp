@@ -12,6 +12,7 @@
 #include "SkMutex.h"
 #include "SkOnce.h"
 #include "SkPath.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkTypeface.h"
 #include <cctype>
@@ -427,6 +428,61 @@ bool SkStrike::hasPath(const SkGlyph& glyph) {
     return !glyph.isEmpty() && this->findPath(glyph) != nullptr;
 }
 
+void SkStrike::prepareImages(SkSpan<const SkGlyph*> glyphs, SkExecutor* executor) {
+    // Splitting fewer glyphs than this across threads costs more in scaler context creation than
+    // it saves in rasterization.
+    static constexpr int kMinGlyphsPerTask = 16;
+    static constexpr int kMaxTasks = 8;
+
+    // Only this thread may use fAlloc, so allocate every missing image before fanning out.
+    SkSTArray<64, const SkGlyph*> missing;
+    for (const SkGlyph* glyph : glyphs) {
+        if (nullptr == glyph->fImage && glyph->fWidth > 0 && glyph->fWidth < kMaxGlyphWidth) {
+            size_t size = const_cast<SkGlyph*>(glyph)->allocImage(&fAlloc);
+            // check that alloc() actually succeeded
+            if (glyph->fImage) {
+                fMemoryUsed += size;
+                missing.push_back(glyph);
+            }
+        }
+    }
+
+    int taskCount = executor ? SkTMin(missing.count() / kMinGlyphsPerTask, kMaxTasks) : 0;
+    if (taskCount < 2) {
+        fScalerContext->getImages(SkSpan<const SkGlyph*>(missing.begin(), missing.count()));
+        return;
+    }
+
+    // A scaler context is not thread safe, so every task but the first, which runs here with
+    // fScalerContext, makes its own from our descriptor. Each task owns a contiguous range of the
+    // glyphs, and writes only into images allocated above.
+    auto rasterize = [&missing, taskCount](int task, SkScalerContext* context) {
+        int begin = missing.count() * task / taskCount;
+        int end = missing.count() * (task + 1) / taskCount;
+        context->getImages(SkSpan<const SkGlyph*>(missing.begin() + begin, end - begin));
+    };
+    SkAutoTArray<bool> rasterized(taskCount);
+    auto runTask = [&](int task) {
+        std::unique_ptr<SkScalerContext> scaler = fScalerContext->getTypeface()->
+                createScalerContext(fScalerContext->getEffects(), fDesc.getDesc(), true);
+        if ((rasterized[task] = scaler != nullptr)) {
+            rasterize(task, scaler.get());
+        }
+    };
+
+    SkTaskGroup tasks(*executor);
+    tasks.batch(taskCount - 1, [&runTask](int i) { runTask(i + 1); });
+    rasterize(0, fScalerContext.get());
+    tasks.wait();
+
+    // Fall back to our own scaler context for any task that could not make one.
+    for (int task = 1; task < taskCount; ++task) {
+        if (!rasterized[task]) {
+            rasterize(task, fScalerContext.get());
+        }
+    }
+}
+
 #ifdef SK_DEBUG
 void SkStrike::forceValidate() const {
     size_t memoryUsed = sizeof(*this);
@@ -14,7 +14,7 @@
 #include "SkGlyph.h"
 #include "SkGlyphRunPainter.h"
 #include "SkPaint.h"
-#include "SkTHash.h"
+#include "SkTFlatHash.h"
 #include "SkScalerContext.h"
 #include "SkTemplates.h"
 #include <memory>
@@ -131,6 +131,8 @@ public:
 
     bool hasPath(const SkGlyph& glyph) override;
 
+    void prepareImages(SkSpan<const SkGlyph*> glyphs, SkExecutor* executor) override;
+
     /** Return the approx RAM usage for this cache. */
     size_t getMemoryUsed() const { return fMemoryUsed; }
 
@@ -217,7 +219,7 @@ private:
     // Map from a combined GlyphID and sub-pixel position to a SkGlyph*.
     // The actual glyph is stored in the fAlloc. This structure provides an
     // unchanging pointer as long as the cache is alive.
-    SkTHashTable<SkGlyph*, SkPackedGlyphID, GlyphMapHashTraits> fGlyphMap;
+    SkTFlatHashTable<SkGlyph*, SkPackedGlyphID, GlyphMapHashTraits> fGlyphMap;
 
     // so we don't grow our arrays a lot
     static constexpr size_t kMinGlyphCount = 8;
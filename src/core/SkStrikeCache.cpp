@@ -113,11 +113,13 @@ bool operator == (decltype(nullptr), const SkStrikeCache::ExclusiveStrikePtr& rh
 }
 
 SkStrikeCache::~SkStrikeCache() {
-    Node* node = fHead;
-    while (node) {
-        Node* next = node->fNext;
-        delete node;
-        node = next;
+    for (Shard& shard : fShards) {
+        Node* node = shard.fHead;
+        while (node) {
+            Node* next = node->fNext;
+            delete node;
+            node = next;
+        }
     }
 }
 
@@ -283,13 +285,20 @@ void SkStrikeCache::attachNode(Node* node) {
     if (node == nullptr) {
         return;
     }
-    SkAutoExclusive ac(fLock);
-
-    this->validate();
     node->fCache.validate();
 
-    this->internalAttachToHead(node);
-    this->internalPurge();
+    {
+        Shard* shard = this->shardFor(node->fCache.getDescriptor());
+        SkAutoExclusive ac(shard->fLock);
+        this->internalAttachToHead(shard, node);
+    }
+
+    if (fTotalMemoryUsed.load(std::memory_order_relaxed) >
+            fCacheSizeLimit.load(std::memory_order_relaxed) ||
+        fCacheCount.load(std::memory_order_relaxed) >
+            fCacheCountLimit.load(std::memory_order_relaxed)) {
+        this->internalPurge();
+    }
 }
 
 SkExclusiveStrikePtr SkStrikeCache::findStrikeExclusive(const SkDescriptor& desc) {
@@ -297,11 +306,12 @@ SkExclusiveStrikePtr SkStrikeCache::findStrikeExclusive(const SkDescriptor& desc
 }
 
 auto SkStrikeCache::findAndDetachStrike(const SkDescriptor& desc) -> Node* {
-    SkAutoExclusive ac(fLock);
+    Shard* shard = this->shardFor(desc);
+    SkAutoExclusive ac(shard->fLock);
 
-    for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
+    for (Node* node = shard->fHead; node != nullptr; node = node->fNext) {
         if (node->fCache.getDescriptor() == desc) {
-            this->internalDetachCache(node);
+            this->internalDetachCache(shard, node);
             return node;
         }
     }
@@ -338,28 +348,31 @@ static bool loose_compare(const SkDescriptor& lhs, const SkDescriptor& rhs) {
 
 bool SkStrikeCache::desperationSearchForImage(const SkDescriptor& desc, SkGlyph* glyph,
                                               SkStrike* targetCache) {
-    SkAutoExclusive ac(fLock);
-
     SkGlyphID glyphID = glyph->getGlyphID();
     SkFixed targetSubX = glyph->getSubXFixed(),
             targetSubY = glyph->getSubYFixed();
 
-    for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
-        if (loose_compare(node->fCache.getDescriptor(), desc)) {
-            auto targetGlyphID = SkPackedGlyphID(glyphID, targetSubX, targetSubY);
-            if (node->fCache.isGlyphCached(glyphID, targetSubX, targetSubY)) {
-                SkGlyph* fallback = node->fCache.getRawGlyphByID(targetGlyphID);
-                // This desperate-match node may disappear as soon as we drop fLock, so we
-                // need to copy the glyph from node into this strike, including a
-                // deep copy of the mask.
-                targetCache->initializeGlyphFromFallback(glyph, *fallback);
-                return true;
-            }
+    // Loosely matching descriptors can have any checksum, so we have to search every shard.
+    for (Shard& shard : fShards) {
+        SkAutoExclusive ac(shard.fLock);
+
+        for (Node* node = shard.fHead; node != nullptr; node = node->fNext) {
+            if (loose_compare(node->fCache.getDescriptor(), desc)) {
+                auto targetGlyphID = SkPackedGlyphID(glyphID, targetSubX, targetSubY);
+                if (node->fCache.isGlyphCached(glyphID, targetSubX, targetSubY)) {
+                    SkGlyph* fallback = node->fCache.getRawGlyphByID(targetGlyphID);
+                    // This desperate-match node may disappear as soon as we drop the shard
+                    // lock, so we need to copy the glyph from node into this strike,
+                    // including a deep copy of the mask.
+                    targetCache->initializeGlyphFromFallback(glyph, *fallback);
+                    return true;
+                }
 
-            // Look for any sub-pixel pos for this glyph, in case there is a pos mismatch.
-            if (const auto* fallback = node->fCache.getCachedGlyphAnySubPix(glyphID)) {
-                targetCache->initializeGlyphFromFallback(glyph, *fallback);
-                return true;
+                // Look for any sub-pixel pos for this glyph, in case there is a pos mismatch.
+                if (const auto* fallback = node->fCache.getCachedGlyphAnySubPix(glyphID)) {
+                    targetCache->initializeGlyphFromFallback(glyph, *fallback);
+                    return true;
+                }
             }
         }
     }
@@ -369,23 +382,25 @@ bool SkStrikeCache::desperationSearchForImage(const SkDescriptor& desc, SkGlyph*
 
 bool SkStrikeCache::desperationSearchForPath(
         const SkDescriptor& desc, SkGlyphID glyphID, SkPath* path) {
-    SkAutoExclusive ac(fLock);
-
     // The following is wrong there is subpixel positioning with paths...
     // Paths are only ever at sub-pixel position (0,0), so we can just try that directly rather
     // than try our packed position first then search all others on failure like for masks.
     //
     // This will have to search the sub-pixel positions too.
     // There is also a problem with accounting for cache size with shared path data.
-    for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
-        if (loose_compare(node->fCache.getDescriptor(), desc)) {
-            if (node->fCache.isGlyphCached(glyphID, 0, 0)) {
-                SkGlyph* from = node->fCache.getRawGlyphByID(SkPackedGlyphID(glyphID));
-                if (from->fPathData != nullptr) {
-                    // We can just copy the path out by value here, so no need to worry
-                    // about the lifetime of this desperate-match node.
-                    *path = from->fPathData->fPath;
-                    return true;
+    for (Shard& shard : fShards) {
+        SkAutoExclusive ac(shard.fLock);
+
+        for (Node* node = shard.fHead; node != nullptr; node = node->fNext) {
+            if (loose_compare(node->fCache.getDescriptor(), desc)) {
+                if (node->fCache.isGlyphCached(glyphID, 0, 0)) {
+                    SkGlyph* from = node->fCache.getRawGlyphByID(SkPackedGlyphID(glyphID));
+                    if (from->fPathData != nullptr) {
+                        // We can just copy the path out by value here, so no need to worry
+                        // about the lifetime of this desperate-match node.
+                        *path = from->fPathData->fPath;
+                        return true;
+                    }
                 }
             }
         }
@@ -429,23 +444,23 @@ auto SkStrikeCache::createStrike(
 }
 
 void SkStrikeCache::purgeAll() {
-    SkAutoExclusive ac(fLock);
-    this->internalPurge(fTotalMemoryUsed);
+    this->internalPurge(fTotalMemoryUsed.load(std::memory_order_relaxed));
+}
+
+void SkStrikeCache::purgeBytes(size_t bytes) {
+    this->internalPurge(bytes);
 }
 
 size_t SkStrikeCache::getTotalMemoryUsed() const {
-    SkAutoExclusive ac(fLock);
-    return fTotalMemoryUsed;
+    return fTotalMemoryUsed.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::getCacheCountUsed() const {
-    SkAutoExclusive ac(fLock);
-    return fCacheCount;
+    return fCacheCount.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::getCacheCountLimit() const {
-    SkAutoExclusive ac(fLock);
-    return fCacheCountLimit;
+    return fCacheCountLimit.load(std::memory_order_relaxed);
 }
 
 size_t SkStrikeCache::setCacheSizeLimit(size_t newLimit) {
@@ -454,17 +469,13 @@ size_t SkStrikeCache::setCacheSizeLimit(size_t newLimit) {
         newLimit = minLimit;
     }
 
-    SkAutoExclusive ac(fLock);
-
-    size_t prevLimit = fCacheSizeLimit;
-    fCacheSizeLimit = newLimit;
+    size_t prevLimit = fCacheSizeLimit.exchange(newLimit, std::memory_order_relaxed);
     this->internalPurge();
     return prevLimit;
 }
 
 size_t  SkStrikeCache::getCacheSizeLimit() const {
-    SkAutoExclusive ac(fLock);
-    return fCacheSizeLimit;
+    return fCacheSizeLimit.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::setCacheCountLimit(int newCount) {
@@ -472,17 +483,13 @@ int SkStrikeCache::setCacheCountLimit(int newCount) {
         newCount = 0;
     }
 
-    SkAutoExclusive ac(fLock);
-
-    int prevCount = fCacheCountLimit;
-    fCacheCountLimit = newCount;
+    int prevCount = fCacheCountLimit.exchange(newCount, std::memory_order_relaxed);
     this->internalPurge();
     return prevCount;
 }
 
 int SkStrikeCache::getCachePointSizeLimit() const {
-    SkAutoExclusive ac(fLock);
-    return fPointSizeLimit;
+    return fPointSizeLimit.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::setCachePointSizeLimit(int newLimit) {
@@ -490,41 +497,47 @@ int SkStrikeCache::setCachePointSizeLimit(int newLimit) {
         newLimit = 0;
     }
 
-    SkAutoExclusive ac(fLock);
-
-    int prevLimit = fPointSizeLimit;
-    fPointSizeLimit = newLimit;
-    return prevLimit;
+    return fPointSizeLimit.exchange(newLimit, std::memory_order_relaxed);
 }
 
 void SkStrikeCache::forEachStrike(std::function<void(const SkStrike&)> visitor) const {
-    SkAutoExclusive ac(fLock);
-
     this->validate();
 
-    for (Node* node = this->internalGetHead(); node != nullptr; node = node->fNext) {
-        visitor(node->fCache);
+    for (const Shard& shard : fShards) {
+        SkAutoExclusive ac(shard.fLock);
+
+        for (Node* node = shard.fHead; node != nullptr; node = node->fNext) {
+            visitor(node->fCache);
+        }
     }
 }
 
 size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
+    // Only one thread purges at a time, so concurrent attaches don't all purge the same excess.
+    SkAutoExclusive purging(fPurgeLock);
+
     this->validate();
 
+    size_t totalMemoryUsed = fTotalMemoryUsed.load(std::memory_order_relaxed),
+           cacheSizeLimit  = fCacheSizeLimit .load(std::memory_order_relaxed);
+    int    cacheCount      = fCacheCount     .load(std::memory_order_relaxed),
+           cacheCountLimit = fCacheCountLimit.load(std::memory_order_relaxed);
+
     size_t bytesNeeded = 0;
-    if (fTotalMemoryUsed > fCacheSizeLimit) {
-        bytesNeeded = fTotalMemoryUsed - fCacheSizeLimit;
+    if (totalMemoryUsed > cacheSizeLimit) {
+        bytesNeeded = totalMemoryUsed - cacheSizeLimit;
     }
     bytesNeeded = SkTMax(bytesNeeded, minBytesNeeded);
     if (bytesNeeded) {
         // no small purges!
-        bytesNeeded = SkTMax(bytesNeeded, fTotalMemoryUsed >> 2);
+        bytesNeeded = SkTMax(bytesNeeded, totalMemoryUsed >> 2);
     }
 
     int countNeeded = 0;
-    if (fCacheCount > fCacheCountLimit) {
-        countNeeded = fCacheCount - fCacheCountLimit;
+    if (cacheCount > cacheCountLimit) {
+        countNeeded = cacheCount - cacheCountLimit;
         // no small purges!
-        countNeeded = SkMax32(countNeeded, fCacheCount >> 2);
+        countNeeded = SkMax32(countNeeded, cacheCount >> 2);
     }
 
     // early exit
@@ -535,20 +548,37 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
     size_t  bytesFreed = 0;
     int     countFreed = 0;
 
-    // Start at the tail and proceed backwards deleting; the list is in LRU
-    // order, with unimportant entries at the tail.
-    Node* node = this->internalGetTail();
-    while (node != nullptr && (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
-        Node* prev = node->fPrev;
-
-        // Only delete if the strike is not pinned.
-        if (node->fPinner == nullptr || node->fPinner->canDelete()) {
-            bytesFreed += node->fCache.getMemoryUsed();
-            countFreed += 1;
-            this->internalDetachCache(node);
-            delete node;
+    // Each shard is its own LRU list, with unimportant entries at the tail.  Work backwards
+    // from the tail of a shard, deleting until we have freed up to the given totals.
+    auto purgeShard = [&](Shard* shard, size_t bytesGoal, int countGoal) {
+        SkAutoExclusive ac(shard->fLock);
+
+        Node* node = shard->fTail;
+        while (node != nullptr && (bytesFreed < bytesGoal || countFreed < countGoal)) {
+            Node* prev = node->fPrev;
+
+            // Only delete if the strike is not pinned.
+            if (node->fPinner == nullptr || node->fPinner->canDelete()) {
+                bytesFreed += node->fCache.getMemoryUsed();
+                countFreed += 1;
+                this->internalDetachCache(shard, node);
+                delete node;
+            }
+            node = prev;
         }
-        node = prev;
+    };
+
+    // First take an even share from each shard's tail, approximating a global LRU.
+    // Then make up any shortfall from whichever shards still have strikes to give.
+    for (int i = 0; i < kShardCount; i++) {
+        purgeShard(&fShards[i], bytesNeeded / kShardCount * (i+1),
+                                countNeeded / kShardCount * (i+1));
+    }
+    for (Shard& shard : fShards) {
+        if (bytesFreed >= bytesNeeded && countFreed >= countNeeded) {
+            break;
+        }
+        purgeShard(&shard, bytesNeeded, countNeeded);
     }
 
     this->validate();
@@ -563,36 +593,36 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
     return bytesFreed;
 }
 
-void SkStrikeCache::internalAttachToHead(Node* node) {
+void SkStrikeCache::internalAttachToHead(Shard* shard, Node* node) {
     SkASSERT(nullptr == node->fPrev && nullptr == node->fNext);
-    if (fHead) {
-        fHead->fPrev = node;
-        node->fNext = fHead;
+    if (shard->fHead) {
+        shard->fHead->fPrev = node;
+        node->fNext = shard->fHead;
     }
-    fHead = node;
+    shard->fHead = node;
 
-    if (fTail == nullptr) {
-        fTail = node;
+    if (shard->fTail == nullptr) {
+        shard->fTail = node;
     }
 
-    fCacheCount += 1;
-    fTotalMemoryUsed += node->fCache.getMemoryUsed();
+    fCacheCount.fetch_add(1, std::memory_order_relaxed);
+    fTotalMemoryUsed.fetch_add(node->fCache.getMemoryUsed(), std::memory_order_relaxed);
 }
 
-void SkStrikeCache::internalDetachCache(Node* node) {
-    SkASSERT(fCacheCount > 0);
-    fCacheCount -= 1;
-    fTotalMemoryUsed -= node->fCache.getMemoryUsed();
+void SkStrikeCache::internalDetachCache(Shard* shard, Node* node) {
+    SkASSERT(fCacheCount.load(std::memory_order_relaxed) > 0);
+    fCacheCount.fetch_sub(1, std::memory_order_relaxed);
+    fTotalMemoryUsed.fetch_sub(node->fCache.getMemoryUsed(), std::memory_order_relaxed);
 
     if (node->fPrev) {
         node->fPrev->fNext = node->fNext;
     } else {
-        fHead = node->fNext;
+        shard->fHead = node->fNext;
     }
     if (node->fNext) {
         node->fNext->fPrev = node->fPrev;
     } else {
-        fTail = node->fPrev;
+        shard->fTail = node->fPrev;
     }
     node->fPrev = node->fNext = nullptr;
 }
@@ -613,20 +643,35 @@ void SkStrikeCache::validateGlyphCacheDataSize() const {
 
 #ifdef SK_DEBUG
 void SkStrikeCache::validate() const {
+    // Hold every shard lock so the totals can't change under us.  Shard locks are only ever
+    // taken one at a time elsewhere, so taking them all in order here cannot deadlock.
+    for (const Shard& shard : fShards) {
+        shard.fLock.acquire();
+    }
+
     size_t computedBytes = 0;
     int computedCount = 0;
 
-    const Node* node = fHead;
-    while (node != nullptr) {
-        computedBytes += node->fCache.getMemoryUsed();
-        computedCount += 1;
-        node = node->fNext;
+    for (const Shard& shard : fShards) {
+        const Node* node = shard.fHead;
+        while (node != nullptr) {
+            computedBytes += node->fCache.getMemoryUsed();
+            computedCount += 1;
+            node = node->fNext;
+        }
+    }
+
+    int    cacheCount      = fCacheCount.load(std::memory_order_relaxed);
+    size_t totalMemoryUsed = fTotalMemoryUsed.load(std::memory_order_relaxed);
+
+    for (const Shard& shard : fShards) {
+        shard.fLock.release();
     }
 
-    SkASSERTF(fCacheCount == computedCount, "fCacheCount: %d, computedCount: %d", fCacheCount,
+    SkASSERTF(cacheCount == computedCount, "fCacheCount: %d, computedCount: %d", cacheCount,
               computedCount);
-    SkASSERTF(fTotalMemoryUsed == computedBytes, "fTotalMemoryUsed: %d, computedBytes: %d",
-              fTotalMemoryUsed, computedBytes);
+    SkASSERTF(totalMemoryUsed == computedBytes, "fTotalMemoryUsed: %d, computedBytes: %d",
+              totalMemoryUsed, computedBytes);
 }
 #endif
 
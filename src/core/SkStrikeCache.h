@@ -8,10 +8,12 @@
 #ifndef SkStrikeCache_DEFINED
 #define SkStrikeCache_DEFINED
 
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "SkDescriptor.h"
+#include "SkMutex.h"
 #include "SkStrike.h"
 #include "SkSpinlock.h"
 #include "SkTemplates.h"
@@ -149,6 +151,7 @@ public:
     void attachNode(Node* node);
 
     void purgeAll(); // does not change budget
+    void purgeBytes(size_t bytes); // frees at least bytes if it can; does not change budget
 
     int getCacheCountLimit() const;
     int setCacheCountLimit(int limit);
@@ -172,28 +175,39 @@ public:
 #endif
 
 private:
+    // Strikes are spread by descriptor checksum over independently locked LRU lists, so
+    // threads looking up different strikes rarely contend.  The budget is still global.
+    static constexpr int kShardCount = 16;
+
+    struct Shard {
+        mutable SkSpinlock fLock;
+        Node*              fHead{nullptr};
+        Node*              fTail{nullptr};
+    };
+
+    Shard* shardFor(const SkDescriptor& desc) {
+        return &fShards[desc.getChecksum() % kShardCount];
+    }
 
-    // The following methods can only be called when mutex is already held.
-    Node* internalGetHead() const { return fHead; }
-    Node* internalGetTail() const { return fTail; }
-    void internalDetachCache(Node*);
-    void internalAttachToHead(Node*);
+    // The following methods can only be called when the shard's lock is already held.
+    void internalDetachCache(Shard*, Node*);
+    void internalAttachToHead(Shard*, Node*);
 
     // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
-    // and attempt to purge caches to match.
+    // and attempt to purge caches to match.  Takes the shard locks as needed, so it
+    // must be called without any held.
     // Returns number of bytes freed.
     size_t internalPurge(size_t minBytesNeeded = 0);
 
     void forEachStrike(std::function<void(const SkStrike&)> visitor) const;
 
-    mutable SkSpinlock fLock;
-    Node*              fHead{nullptr};
-    Node*              fTail{nullptr};
-    size_t             fTotalMemoryUsed{0};
-    size_t             fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
-    int32_t            fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
-    int32_t            fCacheCount{0};
-    int32_t            fPointSizeLimit{SK_DEFAULT_FONT_CACHE_POINT_SIZE_LIMIT};
+    Shard                fShards[kShardCount];
+    SkMutex              fPurgeLock;
+    std::atomic<size_t>  fTotalMemoryUsed{0};
+    std::atomic<size_t>  fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
+    std::atomic<int32_t> fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
+    std::atomic<int32_t> fCacheCount{0};
+    std::atomic<int32_t> fPointSizeLimit{SK_DEFAULT_FONT_CACHE_POINT_SIZE_LIMIT};
 };
 
 using SkExclusiveStrikePtr = SkStrikeCache::ExclusiveStrikePtr;
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkStrokeCache.h"
+
+#include "SkPathPriv.h"
+#include "SkResourceCache.h"
+#include "SkStrokeRec.h"
+#include <cmath>
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+namespace {
+static unsigned gStrokeKeyNamespaceLabel;
+
+static uint64_t make_shared_id(uint32_t pathGenID) {
+    uint64_t sharedID = SkSetFourByteTag('s', 't', 'r', 'k');
+    return (sharedID << 32) | pathGenID;
+}
+
+struct StrokeKey : public SkResourceCache::Key {
+    StrokeKey(const SkPath& src, const SkStrokeRec& rec)
+        : fGenID(src.getGenerationID())
+        , fWidth(rec.getWidth())
+        , fMiterLimit(rec.getMiter())
+        , fResScale(SkStrokeCache::BucketResScale(rec.getResScale()))
+        , fFlags(rec.getCap() | (rec.getJoin() << 2) | (rec.getStyle() << 4) |
+                 (src.isInverseFillType() << 6))
+    {
+        this->init(&gStrokeKeyNamespaceLabel, make_shared_id(fGenID),
+                   sizeof(fGenID) + sizeof(fWidth) + sizeof(fMiterLimit) + sizeof(fResScale) +
+                   sizeof(fFlags));
+    }
+
+    uint32_t fGenID;
+    SkScalar fWidth;
+    SkScalar fMiterLimit;
+    SkScalar fResScale;
+    uint32_t fFlags;
+};
+
+struct StrokeCacheRec : public SkResourceCache::Rec {
+    StrokeCacheRec(const StrokeKey& key, const SkPath& path) : fKey(key), fPath(path) {}
+
+    StrokeKey fKey;
+    SkPath    fPath;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fPath.countPoints() * sizeof(SkPoint) + fPath.countVerbs();
+    }
+    const char* getCategory() const override { return "stroke"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const StrokeCacheRec& rec = static_cast<const StrokeCacheRec&>(baseRec);
+        *static_cast<SkPath*>(contextData) = rec.fPath;
+        return true;
+    }
+};
+
+// Purges a path's stroked outlines once it changes or is deleted.
+class StrokeInvalidator : public SkPathRef::GenIDChangeListener {
+public:
+    explicit StrokeInvalidator(uint32_t genID) : fGenID(genID) {}
+
+private:
+    void onChange() override { SkResourceCache::PostPurgeSharedID(make_shared_id(fGenID)); }
+
+    const uint32_t fGenID;
+};
+} // namespace
+
+SkScalar SkStrokeCache::BucketResScale(SkScalar resScale) {
+    SkASSERT(resScale > 0);
+    int exp;
+    SkScalar mantissa = std::frexp(resScale, &exp);  // resScale = [.5..1) * 2^exp
+    return 0.5f == mantissa ? resScale : std::ldexp(SK_Scalar1, exp);
+}
+
+bool SkStrokeCache::CanCache(const SkPath& src, const SkStrokeRec& rec) {
+    SkScalar resScale = rec.getResScale();
+    return !src.isVolatile() && src.countPoints() >= kMinPointCount && rec.getWidth() > 0 &&
+           SkScalarIsFinite(resScale) && resScale > 0;
+}
+
+bool SkStrokeCache::Find(const SkPath& src, const SkStrokeRec& rec, SkPath* dst,
+                         SkResourceCache* localCache) {
+    SkASSERT(CanCache(src, rec));
+    StrokeKey key(src, rec);
+    return CHECK_LOCAL(localCache, find, Find, key, StrokeCacheRec::Visitor, dst);
+}
+
+void SkStrokeCache::Add(const SkPath& src, const SkStrokeRec& rec, const SkPath& dst,
+                        SkResourceCache* localCache) {
+    SkASSERT(CanCache(src, rec));
+    StrokeKey key(src, rec);
+    CHECK_LOCAL(localCache, add, Add, new StrokeCacheRec(key, dst));
+    SkPathPriv::AddGenIDChangeListener(src, sk_make_sp<StrokeInvalidator>(key.fGenID));
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkStrokeCache_DEFINED
+#define SkStrokeCache_DEFINED
+
+#include "SkPath.h"
+
+class SkResourceCache;
+class SkStrokeRec;
+
+/**
+ * Stroked outlines, kept in SkResourceCache so paths redrawn every frame with the same stroke
+ * are only stroked once. Entries are keyed by the source path's generation ID, the stroke
+ * parameters and a power-of-two bucket of the stroke's resolution scale, and are removed once
+ * the path changes or is deleted.
+ */
+class SkStrokeCache {
+public:
+    // Paths with fewer points than this are cheaper to stroke again than to look up.
+    static constexpr int kMinPointCount = 32;
+
+    /**
+     * Returns the scale to stroke with so the result can be shared by every scale in the same
+     * bucket: the smallest power of two at least as large as resScale, which strokes at least
+     * as precisely.
+     */
+    static SkScalar BucketResScale(SkScalar resScale);
+
+    /**
+     * Returns true if stroking src with rec can go through the cache: src is not volatile, has
+     * at least kMinPointCount points, and rec is a stroke with a finite, positive resScale.
+     */
+    static bool CanCache(const SkPath& src, const SkStrokeRec& rec);
+
+    /**
+     * If src has been stroked with rec at BucketResScale(rec.getResScale()), sets dst to the
+     * stroked outline and returns true.
+     */
+    static bool Find(const SkPath& src, const SkStrokeRec& rec, SkPath* dst,
+                     SkResourceCache* localCache = nullptr);
+
+    /** Adds dst as the outline from stroking src with rec at the bucket's scale. */
+    static void Add(const SkPath& src, const SkStrokeRec& rec, const SkPath& dst,
+                    SkResourceCache* localCache = nullptr);
+};
+
+#endif
@@ -95,6 +95,7 @@ void SkStrokeRec::setStrokeStyle(SkScalar width, bool strokeAndFill) {
 }
 
 #include "SkStroke.h"
+#include "SkStrokeCache.h"
 
 #ifdef SK_DEBUG
     // enables tweaking these values at runtime from Viewer
@@ -107,18 +108,34 @@ bool SkStrokeRec::applyToPath(SkPath* dst, const SkPath& src) const {
         return false;
     }
 
+    SkScalar resScale = fResScale;
+    bool useCache = SkStrokeCache::CanCache(src, *this);
+#ifdef SK_DEBUG
+    if (gDebugStrokerErrorSet) {
+        resScale = gDebugStrokerError;
+        useCache = false;
+    }
+#endif
+    SkPath cacheSrc;  // src itself may be dst
+    if (useCache) {
+        if (SkStrokeCache::Find(src, *this, dst)) {
+            return true;
+        }
+        cacheSrc = src;
+        resScale = SkStrokeCache::BucketResScale(resScale);
+    }
+
     SkStroke stroker;
     stroker.setCap((SkPaint::Cap)fCap);
     stroker.setJoin((SkPaint::Join)fJoin);
     stroker.setMiterLimit(fMiterLimit);
     stroker.setWidth(fWidth);
     stroker.setDoFill(fStrokeAndFill);
-#ifdef SK_DEBUG
-    stroker.setResScale(gDebugStrokerErrorSet ? gDebugStrokerError : fResScale);
-#else
-    stroker.setResScale(fResScale);
-#endif
+    stroker.setResScale(resScale);
     stroker.strokePath(src, dst);
+    if (useCache) {
+        SkStrokeCache::Add(cacheSrc, *this, *dst);
+    }
     return true;
 }
 
@@ -0,0 +1,257 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTFlatHash_DEFINED
+#define SkTFlatHash_DEFINED
+
+#include "SkMathPriv.h"
+#include "SkTemplates.h"
+#include "SkTypes.h"
+#include <new>
+#include <string.h>
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#elif defined(SK_ARM_HAS_NEON)
+    #include <arm_neon.h>
+#endif
+
+// SkTFlatHashTable has the same interface and Traits as SkTHashTable, but keeps a separate array
+// of one-byte control tags (7 bits of hash, or empty / deleted) next to its slots.  Lookups check
+// a group of 16 tags at a time with SIMD and only touch the slots whose tag matches, so it pays
+// off for hot tables whose keys are expensive to compare or whose T is a pointer to the key.
+//
+// Unlike SkTHashTable, removal leaves tombstones behind, so prefer SkTHashTable for tables that
+// see a lot of churn and few lookups.
+template <typename T, typename K, typename Traits = T>
+class SkTFlatHashTable {
+public:
+    SkTFlatHashTable() : fCount(0), fDeleted(0), fCapacity(0) {}
+    SkTFlatHashTable(SkTFlatHashTable&& other)
+        : fCount(other.fCount)
+        , fDeleted(other.fDeleted)
+        , fCapacity(other.fCapacity)
+        , fCtrl(std::move(other.fCtrl))
+        , fSlots(std::move(other.fSlots)) { other.fCount = other.fDeleted = other.fCapacity = 0; }
+
+    SkTFlatHashTable& operator=(SkTFlatHashTable&& other) {
+        if (this != &other) {
+            this->~SkTFlatHashTable();
+            new (this) SkTFlatHashTable(std::move(other));
+        }
+        return *this;
+    }
+
+    // Clear the table.
+    void reset() { *this = SkTFlatHashTable(); }
+
+    // How many entries are in the table?
+    int count() const { return fCount; }
+
+    // Approximately how many bytes of memory do we use beyond sizeof(*this)?
+    size_t approxBytesUsed() const { return fCapacity * (sizeof(T) + 1); }
+
+    // As with SkTHashTable, do not change an entry's key through the pointers handed out by set(),
+    // find() or foreach().  Pointers from set() and find() are valid only until the next set().
+
+    // Copy val into the hash table, returning a pointer to the copy now in the table.
+    // If there already is an entry in the table with the same key, we overwrite it.
+    T* set(T val) {
+        uint32_t hash = Traits::Hash(Traits::GetKey(val));
+        int index = this->indexOf(Traits::GetKey(val), hash);
+        if (index >= 0) {
+            fSlots[index] = std::move(val);
+            return &fSlots[index];
+        }
+        if (8 * (fCount + fDeleted + 1) > 7 * fCapacity) {
+            // Double when mostly full of live entries, otherwise just sweep out the tombstones.
+            this->resize(fCapacity == 0              ? kGroupWidth
+                       : 2 * (fCount + 1) > fCapacity ? 2 * fCapacity
+                                                      : fCapacity);
+        }
+        return this->uncheckedSet(std::move(val), hash);
+    }
+
+    // If there is an entry in the table with this key, return a pointer to it.  If not, null.
+    T* find(const K& key) const {
+        int index = this->indexOf(key, Traits::Hash(key));
+        return index >= 0 ? &fSlots[index] : nullptr;
+    }
+
+    // If there is an entry in the table with this key, return it.  If not, null.
+    // This only works for pointer type T, and cannot be used to find an nullptr entry.
+    T findOrNull(const K& key) const {
+        if (T* p = this->find(key)) {
+            return *p;
+        }
+        return nullptr;
+    }
+
+    // Remove the value with this key from the hash table.
+    void remove(const K& key) {
+        int index = this->indexOf(key, Traits::Hash(key));
+        SkASSERT(index >= 0);
+
+        // A search only stops at a group holding an empty slot, so if this group already has one,
+        // no probe sequence runs through it and the slot can go straight back to empty.
+        uint8_t* group = fCtrl.get() + (index & ~(kGroupWidth - 1));
+        if (Match(group, kEmpty)) {
+            fCtrl[index] = kEmpty;
+        } else {
+            fCtrl[index] = kDeleted;
+            fDeleted++;
+        }
+        fSlots[index] = T();
+        fCount--;
+    }
+
+    // Call fn on every entry in the table.  You may mutate the entries, but be very careful.
+    template <typename Fn>  // f(T*)
+    void foreach(Fn&& fn) {
+        for (int i = 0; i < fCapacity; i++) {
+            if (IsFull(fCtrl[i])) {
+                fn(&fSlots[i]);
+            }
+        }
+    }
+
+    // Call fn on every entry in the table.  You may not mutate anything.
+    template <typename Fn>  // f(T) or f(const T&)
+    void foreach(Fn&& fn) const {
+        for (int i = 0; i < fCapacity; i++) {
+            if (IsFull(fCtrl[i])) {
+                fn(fSlots[i]);
+            }
+        }
+    }
+
+private:
+    // Control tags: full slots hold the low 7 bits of their hash, so anything with the high
+    // bit set is free.
+    static constexpr uint8_t kEmpty   = 0x80;
+    static constexpr uint8_t kDeleted = 0xfe;
+    static constexpr int     kGroupWidth = 16;
+
+    static bool IsFull(uint8_t ctrl) { return ctrl < 0x80; }
+    static uint8_t Tag(uint32_t hash) { return hash & 0x7f; }
+
+    // Returns a mask with bit i set if group[i] == tag.
+    static uint32_t Match(const uint8_t group[kGroupWidth], uint8_t tag) {
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)tag)));
+    #elif defined(SK_ARM_HAS_NEON)
+        static const uint8_t kBits[kGroupWidth] = { 1, 2, 4, 8, 16, 32, 64, 128,
+                                                    1, 2, 4, 8, 16, 32, 64, 128 };
+        uint8x16_t bits = vandq_u8(vceqq_u8(vld1q_u8(group), vdupq_n_u8(tag)), vld1q_u8(kBits));
+        uint8x8_t sum = vpadd_u8(vget_low_u8(bits), vget_high_u8(bits));
+        sum = vpadd_u8(sum, sum);
+        sum = vpadd_u8(sum, sum);
+        return vget_lane_u16(vreinterpret_u16_u8(sum), 0);
+    #else
+        uint32_t mask = 0;
+        for (int i = 0; i < kGroupWidth; i++) {
+            mask |= (uint32_t)(group[i] == tag) << i;
+        }
+        return mask;
+    #endif
+    }
+
+    // Returns a mask with bit i set if group[i] is empty or deleted.
+    static uint32_t MatchFree(const uint8_t group[kGroupWidth]) {
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+    #else
+        uint32_t mask = 0;
+        for (int i = 0; i < kGroupWidth; i++) {
+            mask |= (uint32_t)!IsFull(group[i]) << i;
+        }
+        return mask;
+    #endif
+    }
+
+    static int LowestBit(uint32_t mask) {
+        SkASSERT(mask);
+        return 31 - SkCLZ(mask & (0 - mask));
+    }
+
+    // Groups are probed quadratically (by triangular numbers), which visits each group once.
+    int firstGroup(uint32_t hash) const { return (hash >> 7) & (fCapacity / kGroupWidth - 1); }
+    int nextGroup(int group, int n) const { return (group + n) & (fCapacity / kGroupWidth - 1); }
+
+    int indexOf(const K& key, uint32_t hash) const {
+        const int groups = fCapacity / kGroupWidth;
+        const uint8_t tag = Tag(hash);
+        int group = this->firstGroup(hash);
+        for (int n = 1; n <= groups; n++) {
+            const uint8_t* ctrl = fCtrl.get() + group * kGroupWidth;
+            for (uint32_t mask = Match(ctrl, tag); mask; mask &= mask - 1) {
+                int index = group * kGroupWidth + LowestBit(mask);
+                if (key == Traits::GetKey(fSlots[index])) {
+                    return index;
+                }
+            }
+            if (Match(ctrl, kEmpty)) {
+                return -1;
+            }
+            group = this->nextGroup(group, n);
+        }
+        return -1;
+    }
+
+    // Adds val, known not to be in the table yet, to the first free slot on its probe sequence.
+    T* uncheckedSet(T&& val, uint32_t hash) {
+        const int groups = fCapacity / kGroupWidth;
+        int group = this->firstGroup(hash);
+        for (int n = 1; n <= groups; n++) {
+            if (uint32_t mask = MatchFree(fCtrl.get() + group * kGroupWidth)) {
+                int index = group * kGroupWidth + LowestBit(mask);
+                if (fCtrl[index] == kDeleted) {
+                    fDeleted--;
+                }
+                fCtrl[index]  = Tag(hash);
+                fSlots[index] = std::move(val);
+                fCount++;
+                return &fSlots[index];
+            }
+            group = this->nextGroup(group, n);
+        }
+        SkASSERT(false);
+        return nullptr;
+    }
+
+    void resize(int capacity) {
+        SkASSERT(capacity % kGroupWidth == 0 && SkIsPow2(capacity));
+        int oldCapacity = fCapacity;
+        SkDEBUGCODE(int oldCount = fCount);
+
+        fCount = fDeleted = 0;
+        fCapacity = capacity;
+        SkAutoTMalloc<uint8_t> oldCtrl = std::move(fCtrl);
+        SkAutoTArray<T> oldSlots = std::move(fSlots);
+        fCtrl.reset(capacity);
+        memset(fCtrl.get(), kEmpty, capacity);
+        fSlots = SkAutoTArray<T>(capacity);
+
+        for (int i = 0; i < oldCapacity; i++) {
+            if (IsFull(oldCtrl[i])) {
+                this->uncheckedSet(std::move(oldSlots[i]),
+                                   Traits::Hash(Traits::GetKey(oldSlots[i])));
+            }
+        }
+        SkASSERT(fCount == oldCount);
+    }
+
+    int fCount, fDeleted, fCapacity;
+    SkAutoTMalloc<uint8_t> fCtrl;
+    SkAutoTArray<T> fSlots;
+
+    SkTFlatHashTable(const SkTFlatHashTable&) = delete;
+    SkTFlatHashTable& operator=(const SkTFlatHashTable&) = delete;
+};
+
+#endif
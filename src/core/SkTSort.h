@@ -9,6 +9,7 @@
 #define SkTSort_DEFINED
 
 #include "SkMathPriv.h"
+#include "SkTemplates.h"
 #include "SkTo.h"
 #include "SkTypes.h"
 
@@ -213,4 +214,52 @@ template <typename T> void SkTQSort(T** left, T** right) {
     SkTQSort(left, right, SkTPointerCompareLT<T>());
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+/** Sorts the array of size count using comparator lessThan in linear time, if read around in a
+ *  circle from some point its entries first rise then fall, as the tops of the edges of a convex
+ *  polygon do in path order. Otherwise returns false and leaves the array untouched.
+ */
+template <typename T, typename C> bool SkTSortCyclicBitonic(T array[], int count, C lessThan) {
+    // Read from the first smallest entry, so the rising run comes first.
+    int lo = 0;
+    for (int i = 1; i < count; ++i) {
+        if (lessThan(array[i], array[lo])) {
+            lo = i;
+        }
+    }
+    auto at = [array, count, lo](int i) -> const T& {
+        i += lo;
+        return array[i < count ? i : i - count];
+    };
+
+    int peak = 0;
+    while (peak + 1 < count && !lessThan(at(peak + 1), at(peak))) {
+        ++peak;
+    }
+    for (int i = peak + 1; i + 1 < count; ++i) {
+        if (lessThan(at(i), at(i + 1))) {
+            return false;
+        }
+    }
+
+    // Merge the rising run [0, peak] with the falling run (peak, count) read backwards.
+    SkAutoSTMalloc<64, T> sorted(count);
+    for (int i = 0, a = 0, b = count - 1; i < count; ++i) {
+        if (b > peak && (a > peak || lessThan(at(b), at(a)))) {
+            sorted[i] = at(b--);
+        } else {
+            sorted[i] = at(a++);
+        }
+    }
+    for (int i = 0; i < count; ++i) {
+        array[i] = std::move(sorted[i]);
+    }
+    return true;
+}
+
+template <typename T> bool SkTSortCyclicBitonic(T** array, int count) {
+    return SkTSortCyclicBitonic(array, count, SkTPointerCompareLT<T>());
+}
+
 #endif
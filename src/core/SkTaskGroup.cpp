@@ -6,27 +6,93 @@
  */
 
 #include "SkExecutor.h"
+#include "SkMutex.h"
 #include "SkTaskGroup.h"
 
-SkTaskGroup::SkTaskGroup(SkExecutor& executor) : fPending(0), fExecutor(executor) {}
+// The tasks added between two then() calls share a Barrier.  It counts those that haven't
+// finished, plus one until the second then() closes it, after which the last of them to finish
+// starts fNext (the second then()'s task).
+struct SkTaskGroup::Barrier : public SkNVRefCnt<Barrier> {
+    explicit Barrier(SkExecutor* executor) : fCount(1), fExecutor(executor) {}
 
-void SkTaskGroup::add(std::function<void(void)> fn) {
-    fPending.fetch_add(+1, std::memory_order_relaxed);
-    fExecutor.add([=] {
-        fn();
+    void arrive() {
+        if (fCount.fetch_add(-1, std::memory_order_acq_rel) == 1) {
+            fExecutor->addWithPriority(std::move(fNext), fNextPriority);
+        }
+    }
+
+    std::atomic<int32_t>      fCount;
+    SkExecutor*               fExecutor;
+    std::function<void(void)> fNext;
+    Priority                  fNextPriority = Priority::kNormal;
+};
+
+SkTaskGroup::SkTaskGroup(SkExecutor& executor)
+    : fPending(0), fCancellations(0), fExecutor(executor) {}
+
+SkTaskGroup::~SkTaskGroup() {
+    this->wait();
+}
+
+sk_sp<SkTaskGroup::Barrier> SkTaskGroup::currentBarrier(int32_t tasks) {
+    SkAutoExclusive lock(fBarrierLock);
+    if (!fBarrier) {
+        fBarrier = sk_make_sp<Barrier>(&fExecutor);
+    }
+    fBarrier->fCount.fetch_add(tasks, std::memory_order_relaxed);
+    return fBarrier;
+}
+
+std::function<void(void)> SkTaskGroup::makeTask(std::function<void(void)> fn,
+                                                sk_sp<Barrier> barrier) {
+    int32_t cancellations = fCancellations.load(std::memory_order_relaxed);
+    return [this, fn = std::move(fn), cancellations, barrier = std::move(barrier)] {
+        if (fCancellations.load(std::memory_order_relaxed) == cancellations) {
+            fn();
+        }
+        barrier->arrive();
         fPending.fetch_add(-1, std::memory_order_release);
-    });
+    };
 }
 
-void SkTaskGroup::batch(int N, std::function<void(int)> fn) {
+void SkTaskGroup::add(std::function<void(void)> fn, Priority priority) {
+    fPending.fetch_add(+1, std::memory_order_relaxed);
+    fExecutor.addWithPriority(this->makeTask(std::move(fn), this->currentBarrier(1)), priority);
+}
+
+void SkTaskGroup::batch(int N, std::function<void(int)> fn, Priority priority) {
     // TODO: I really thought we had some sort of more clever chunking logic.
+    if (N <= 0) {
+        return;
+    }
     fPending.fetch_add(+N, std::memory_order_relaxed);
+    sk_sp<Barrier> barrier = this->currentBarrier(N);
     for (int i = 0; i < N; i++) {
-        fExecutor.add([=] {
-            fn(i);
-            fPending.fetch_add(-1, std::memory_order_release);
-        });
+        fExecutor.addWithPriority(this->makeTask([=] { fn(i); }, barrier), priority);
+    }
+}
+
+void SkTaskGroup::then(std::function<void(void)> fn, Priority priority) {
+    fPending.fetch_add(+1, std::memory_order_relaxed);
+
+    // fn joins a new barrier, so that later then() tasks also wait for it.
+    sk_sp<Barrier> closing;
+    std::function<void(void)> next;
+    {
+        SkAutoExclusive lock(fBarrierLock);
+        closing = fBarrier ? std::move(fBarrier) : sk_make_sp<Barrier>(&fExecutor);
+        fBarrier = sk_make_sp<Barrier>(&fExecutor);
+        fBarrier->fCount.fetch_add(1, std::memory_order_relaxed);
+        next = this->makeTask(std::move(fn), fBarrier);
     }
+    // Nothing can start fNext until we drop the count we held while closing was current.
+    closing->fNext = std::move(next);
+    closing->fNextPriority = priority;
+    closing->arrive();
+}
+
+void SkTaskGroup::cancel() {
+    fCancellations.fetch_add(+1, std::memory_order_relaxed);
 }
 
 bool SkTaskGroup::done() const {
@@ -43,9 +109,10 @@ void SkTaskGroup::wait() {
     }
 }
 
-SkTaskGroup::Enabler::Enabler(int threads) {
+SkTaskGroup::Enabler::Enabler(int threads, bool workStealing) {
     if (threads) {
-        fThreadPool = SkExecutor::MakeLIFOThreadPool(threads);
+        fThreadPool = workStealing ? SkExecutor::MakeWorkStealingThreadPool(threads)
+                                   : SkExecutor::MakeLIFOThreadPool(threads);
         SkExecutor::SetDefault(fThreadPool.get());
     }
 }
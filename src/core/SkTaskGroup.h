@@ -10,6 +10,8 @@
 
 #include "SkExecutor.h"
 #include "SkNoncopyable.h"
+#include "SkRefCnt.h"
+#include "SkSpinlock.h"
 #include "SkTypes.h"
 #include <atomic>
 #include <functional>
@@ -18,13 +20,24 @@ class SkTaskGroup : SkNoncopyable {
 public:
     // Tasks added to this SkTaskGroup will run on its executor.
     explicit SkTaskGroup(SkExecutor& executor = SkExecutor::GetDefault());
-    ~SkTaskGroup() { this->wait(); }
+    ~SkTaskGroup();
+
+    using Priority = SkExecutor::Priority;
 
     // Add a task to this SkTaskGroup.
-    void add(std::function<void(void)> fn);
+    void add(std::function<void(void)> fn, Priority = Priority::kNormal);
 
     // Add a batch of N tasks, all calling fn with different arguments.
-    void batch(int N, std::function<void(int)> fn);
+    void batch(int N, std::function<void(int)> fn, Priority = Priority::kNormal);
+
+    // Add a task that runs once every task previously added to this SkTaskGroup has run,
+    // including earlier then() tasks.  No thread is blocked waiting for them in the meantime.
+    void then(std::function<void(void)> fn, Priority = Priority::kNormal);
+
+    // Tasks added to this SkTaskGroup before cancel() that have not started will not run, though
+    // they still count towards done() and then() as if they had.  Tasks already running finish
+    // normally, and tasks added after cancel() run as usual.
+    void cancel();
 
     // Returns true if all Tasks previously add()ed to this SkTaskGroup have run.
     // It is safe to reuse this SkTaskGroup once done().
@@ -35,13 +48,23 @@ public:
 
     // A convenience for testing tools.
     // Creates and owns a thread pool, and passes it to SkExecutor::SetDefault().
+    // If workStealing is true, that thread pool is SkExecutor::MakeWorkStealingThreadPool().
     struct Enabler {
-        explicit Enabler(int threads = -1);  // -1 -> num_cores, 0 -> noop
+        explicit Enabler(int threads = -1,          // -1 -> num_cores, 0 -> noop
+                         bool workStealing = false);
         std::unique_ptr<SkExecutor> fThreadPool;
     };
 
 private:
+    struct Barrier;
+
+    std::function<void(void)> makeTask(std::function<void(void)> fn, sk_sp<Barrier>);
+    sk_sp<Barrier> currentBarrier(int32_t tasks);
+
     std::atomic<int32_t> fPending;
+    std::atomic<int32_t> fCancellations;
+    SkSpinlock           fBarrierLock;
+    sk_sp<Barrier>       fBarrier;     // The tasks the next then() task will wait for.
     SkExecutor&          fExecutor;
 };
 
@@ -242,6 +242,7 @@ bool SkTextBlobRunIterator::isLCD() const {
 SkTextBlobBuilder::SkTextBlobBuilder()
     : fStorageSize(0)
     , fStorageUsed(0)
+    , fStorageHint(0)
     , fRunCount(0)
     , fDeferredBounds(false)
     , fLastRun(0) {
@@ -394,7 +395,12 @@ void SkTextBlobBuilder::reserve(size_t size) {
         fStorageUsed = SkAlignPtr(sizeof(SkTextBlob));
     }
 
-    fStorageSize = safe.add(fStorageUsed, size);
+    // Grow geometrically, so a blob made of many small runs does not realloc for every one.
+    // Callers tend to build similar blobs back to back, so the first allocation also starts
+    // out as big as the last blob made. make() trims whatever ends up unused.
+    size_t needed = safe.add(fStorageUsed, size);
+    size_t grown  = 0 == fRunCount ? fStorageHint : safe.add(fStorageSize, fStorageSize / 2);
+    fStorageSize  = SkTMax(needed, grown);
 
     // FYI: This relies on everything we store being relocatable, particularly SkPaint.
     //      Also, this is counting on the underlying realloc to throw when passed max().
@@ -591,6 +597,13 @@ sk_sp<SkTextBlob> SkTextBlobBuilder::make() {
     auto* lastRun = reinterpret_cast<SkTextBlob::RunRecord*>(fStorage.get() + fLastRun);
     lastRun->fFlags |= SkTextBlob::RunRecord::kLast_Flag;
 
+    // The blob keeps the storage, so give back any slack left over from growing it.
+    if (fStorageUsed < fStorageSize) {
+        fStorage.realloc(fStorageUsed);
+        fStorageSize = fStorageUsed;
+    }
+    fStorageHint = fStorageUsed;
+
     SkTextBlob* blob = new (fStorage.release()) SkTextBlob(fBounds);
     SkDEBUGCODE(const_cast<SkTextBlob*>(blob)->fStorageSize = fStorageSize;)
 
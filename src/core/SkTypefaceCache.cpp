@@ -7,43 +7,109 @@
 
 #include "SkTypefaceCache.h"
 #include "SkMutex.h"
+#include "SkTDArray.h"
+#include <algorithm>
 #include <atomic>
 
 #define TYPEFACE_CACHE_LIMIT    1024
 
-SkTypefaceCache::SkTypefaceCache() {}
+SkTypefaceCache::SkTypefaceCache() : fClock(0) {}
 
 void SkTypefaceCache::add(SkTypeface* face) {
+    this->addEntry(face, 0, false);
+}
+
+void SkTypefaceCache::add(SkTypeface* face, uint32_t hash) {
+    this->addEntry(face, hash, true);
+}
+
+void SkTypefaceCache::addEntry(SkTypeface* face, uint32_t hash, bool hashed) {
     if (fTypefaces.count() >= TYPEFACE_CACHE_LIMIT) {
         this->purge(TYPEFACE_CACHE_LIMIT >> 2);
     }
 
-    fTypefaces.emplace_back(SkRef(face));
+    Entry& entry = fTypefaces.push_back();
+    entry.fTypeface = sk_ref_sp(face);
+    entry.fHash = hash;
+    entry.fHashed = hashed;
+    entry.fNextWithHash = -1;
+    entry.fLastUse = fClock++;
+    if (hashed) {
+        if (int* newest = fNewestWithHash.find(hash)) {
+            entry.fNextWithHash = *newest;
+        }
+        fNewestWithHash.set(hash, fTypefaces.count() - 1);
+    }
+}
+
+SkTypeface* SkTypefaceCache::ref(int index) const {
+    fTypefaces[index].fLastUse = fClock++;
+    return SkRef(fTypefaces[index].fTypeface.get());
 }
 
 SkTypeface* SkTypefaceCache::findByProcAndRef(FindProc proc, void* ctx) const {
-    for (const sk_sp<SkTypeface>& typeface : fTypefaces) {
-        if (proc(typeface.get(), ctx)) {
-            return SkRef(typeface.get());
+    for (int i = 0; i < fTypefaces.count(); ++i) {
+        if (proc(fTypefaces[i].fTypeface.get(), ctx)) {
+            return this->ref(i);
+        }
+    }
+    return nullptr;
+}
+
+SkTypeface* SkTypefaceCache::findByProcAndRef(FindProc proc, void* ctx, uint32_t hash) const {
+    const int* newest = fNewestWithHash.find(hash);
+    for (int i = newest ? *newest : -1; i >= 0; i = fTypefaces[i].fNextWithHash) {
+        if (proc(fTypefaces[i].fTypeface.get(), ctx)) {
+            return this->ref(i);
         }
     }
     return nullptr;
 }
 
 void SkTypefaceCache::purge(int numToPurge) {
-    int count = fTypefaces.count();
-    int i = 0;
-    while (i < count) {
-        if (fTypefaces[i]->unique()) {
-            fTypefaces.removeShuffle(i);
-            --count;
-            if (--numToPurge == 0) {
-                return;
+    // Of the typefaces only the cache still owns, drop the ones least recently added or found.
+    SkTDArray<int> unused;
+    for (int i = 0; i < fTypefaces.count(); ++i) {
+        if (fTypefaces[i].fTypeface->unique()) {
+            unused.push_back(i);
+        }
+    }
+    if (unused.count() > numToPurge) {
+        auto lessRecentlyUsed = [this](int a, int b) {
+            return fTypefaces[a].fLastUse < fTypefaces[b].fLastUse;
+        };
+        std::nth_element(unused.begin(), unused.begin() + numToPurge, unused.end(),
+                         lessRecentlyUsed);
+        unused.setCount(numToPurge);
+    }
+    if (unused.isEmpty()) {
+        return;
+    }
+    for (int i : unused) {
+        fTypefaces[i].fTypeface.reset();
+    }
+
+    // Close the gaps, keeping the entries in the order they were added, and rebuild the chains.
+    fNewestWithHash.reset();
+    int count = 0;
+    for (int i = 0; i < fTypefaces.count(); ++i) {
+        if (!fTypefaces[i].fTypeface) {
+            continue;
+        }
+        if (count != i) {
+            fTypefaces[count] = std::move(fTypefaces[i]);
+        }
+        Entry& entry = fTypefaces[count];
+        entry.fNextWithHash = -1;
+        if (entry.fHashed) {
+            if (int* newest = fNewestWithHash.find(entry.fHash)) {
+                entry.fNextWithHash = *newest;
             }
-        } else {
-            ++i;
+            fNewestWithHash.set(entry.fHash, count);
         }
+        ++count;
     }
+    fTypefaces.pop_back_n(fTypefaces.count() - count);
 }
 
 void SkTypefaceCache::purgeAll() {
@@ -69,11 +135,21 @@ void SkTypefaceCache::Add(SkTypeface* face) {
     Get().add(face);
 }
 
+void SkTypefaceCache::Add(SkTypeface* face, uint32_t hash) {
+    SkAutoMutexAcquire ama(gMutex);
+    Get().add(face, hash);
+}
+
 SkTypeface* SkTypefaceCache::FindByProcAndRef(FindProc proc, void* ctx) {
     SkAutoMutexAcquire ama(gMutex);
     return Get().findByProcAndRef(proc, ctx);
 }
 
+SkTypeface* SkTypefaceCache::FindByProcAndRef(FindProc proc, void* ctx, uint32_t hash) {
+    SkAutoMutexAcquire ama(gMutex);
+    return Get().findByProcAndRef(proc, ctx, hash);
+}
+
 void SkTypefaceCache::PurgeAll() {
     SkAutoMutexAcquire ama(gMutex);
     Get().purgeAll();
@@ -11,6 +11,7 @@
 #define SkTypefaceCache_DEFINED
 
 #include "SkRefCnt.h"
+#include "SkTHash.h"
 #include "SkTypeface.h"
 #include "SkTArray.h"
 
@@ -33,6 +34,13 @@ public:
      */
     void add(SkTypeface*);
 
+    /**
+     *  Same as add(), but also files the typeface under hash, a hash of
+     *  whatever the FindProc for this cache compares (e.g. the platform font
+     *  or its family and style). Typefaces that match must have equal hashes.
+     */
+    void add(SkTypeface*, uint32_t hash);
+
     /**
      *  Iterate through the cache, calling proc(typeface, ctx) with each
      *  typeface. If proc returns true, then we return that typeface (this
@@ -40,9 +48,17 @@ public:
      */
     SkTypeface* findByProcAndRef(FindProc proc, void* ctx) const;
 
+    /**
+     *  Same as findByProcAndRef(proc, ctx), but only calls proc with the
+     *  typefaces that were added with this hash, so lookups stay fast no
+     *  matter how many typefaces are cached.
+     */
+    SkTypeface* findByProcAndRef(FindProc proc, void* ctx, uint32_t hash) const;
+
     /**
      *  This will unref all of the typefaces in the cache for which the cache
-     *  is the only owner. Normally this is handled automatically as needed.
+     *  is the only owner. Normally this is handled automatically as needed,
+     *  dropping the typefaces that were least recently added or found first.
      *  This function is exposed for clients that explicitly want to purge the
      *  cache (e.g. to look for leaks).
      */
@@ -57,7 +73,9 @@ public:
     // These are static wrappers around a global instance of a cache.
 
     static void Add(SkTypeface*);
+    static void Add(SkTypeface*, uint32_t hash);
     static SkTypeface* FindByProcAndRef(FindProc proc, void* ctx);
+    static SkTypeface* FindByProcAndRef(FindProc proc, void* ctx, uint32_t hash);
     static void PurgeAll();
 
     /**
@@ -69,8 +87,20 @@ private:
     static SkTypefaceCache& Get();
 
     void purge(int count);
-
-    SkTArray<sk_sp<SkTypeface>> fTypefaces;
+    void addEntry(SkTypeface*, uint32_t hash, bool hashed);
+    SkTypeface* ref(int index) const;
+
+    struct Entry {
+        sk_sp<SkTypeface> fTypeface;
+        uint32_t fHash;
+        bool fHashed;
+        int fNextWithHash;          // Index of the next older entry with the same hash, or -1.
+        mutable uint64_t fLastUse;  // When this was last added or found, for purge().
+    };
+
+    SkTArray<Entry> fTypefaces;
+    SkTHashMap<uint32_t, int> fNewestWithHash;
+    mutable uint64_t fClock;
 };
 
 #endif
@@ -8,6 +8,7 @@
 #include "SkTypeface_remote.h"
 #include "SkPaint.h"
 #include "SkRemoteGlyphCache.h"
+#include "SkRemoteGlyphCacheImpl.h"
 #include "SkStrike.h"
 #include "SkStrikeCache.h"
 #include "SkTraceEvent.h"
@@ -27,6 +28,12 @@ void SkScalerContextProxy::initCache(SkStrike* cache, SkStrikeCache* strikeCache
     fStrikeCache = strikeCache;
 }
 
+void SkScalerContextProxy::setCacheMissHints(SkDiscardableHandleId discardableHandleId,
+                                             sk_sp<SkStrikeClient::CacheMissHints> hints) {
+    fDiscardableHandleId = discardableHandleId;
+    fCacheMissHints = std::move(hints);
+}
+
 unsigned SkScalerContextProxy::generateGlyphCount()  {
     SK_ABORT("Should never be called.");
     return 0;
@@ -71,6 +78,9 @@ void SkScalerContextProxy::generateMetrics(SkGlyph* glyph) {
 
     glyph->zeroMetrics();
     fDiscardableManager->notifyCacheMiss(SkStrikeClient::CacheMissType::kGlyphMetrics);
+    if (fCacheMissHints) {
+        fCacheMissHints->addMiss(fDiscardableHandleId, glyph->getPackedID(), false);
+    }
 }
 
 void SkScalerContextProxy::generateImage(const SkGlyph& glyph) {
@@ -82,6 +92,9 @@ void SkScalerContextProxy::generateImage(const SkGlyph& glyph) {
     // There is no desperation search here, because if there was an image to be found it was
     // copied over with the metrics search.
     fDiscardableManager->notifyCacheMiss(SkStrikeClient::CacheMissType::kGlyphImage);
+    if (fCacheMissHints) {
+        fCacheMissHints->addMiss(fDiscardableHandleId, glyph.getPackedID(), false);
+    }
 }
 
 bool SkScalerContextProxy::generatePath(SkGlyphID glyphID, SkPath* path) {
@@ -97,6 +110,9 @@ bool SkScalerContextProxy::generatePath(SkGlyphID glyphID, SkPath* path) {
     fDiscardableManager->notifyCacheMiss(foundPath
                                                  ? SkStrikeClient::CacheMissType::kGlyphPathFallback
                                                  : SkStrikeClient::CacheMissType::kGlyphPath);
+    if (!foundPath && fCacheMissHints) {
+        fCacheMissHints->addMiss(fDiscardableHandleId, SkPackedGlyphID(glyphID), true);
+    }
     return foundPath;
 }
 
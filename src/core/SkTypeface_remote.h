@@ -29,6 +29,9 @@ public:
 
     void initCache(SkStrike*, SkStrikeCache*);
 
+    // Glyphs this context has to make up are reported to the client's hints for the server.
+    void setCacheMissHints(SkDiscardableHandleId, sk_sp<SkStrikeClient::CacheMissHints>);
+
 protected:
     unsigned generateGlyphCount() override;
     uint16_t generateCharToGlyph(SkUnichar) override;
@@ -43,6 +46,8 @@ private:
     sk_sp<SkStrikeClient::DiscardableHandleManager> fDiscardableManager;
     SkStrike* fCache = nullptr;
     SkStrikeCache* fStrikeCache = nullptr;
+    SkDiscardableHandleId fDiscardableHandleId = 0u;
+    sk_sp<SkStrikeClient::CacheMissHints> fCacheMissHints;
     typedef SkScalerContext INHERITED;
 };
 
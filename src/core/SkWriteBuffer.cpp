@@ -20,12 +20,14 @@
 
 SkBinaryWriteBuffer::SkBinaryWriteBuffer()
     : fFactorySet(nullptr)
-    , fTFSet(nullptr) {
+    , fTFSet(nullptr)
+    , fImageSet(nullptr) {
 }
 
 SkBinaryWriteBuffer::SkBinaryWriteBuffer(void* storage, size_t storageSize)
     : fFactorySet(nullptr)
     , fTFSet(nullptr)
+    , fImageSet(nullptr)
     , fWriter(storage, storageSize)
 {}
 
@@ -141,6 +143,11 @@ bool SkBinaryWriteBuffer::writeToStream(SkWStream* stream) const {
  *  data [ encoded, with raw width/height ]
  */
 void SkBinaryWriteBuffer::writeImage(const SkImage* image) {
+    if (fImageSet) {
+        this->write32(fImageSet->add(const_cast<SkImage*>(image)));
+        return;
+    }
+
     const SkIRect bounds = SkImage_getSubset(image);
     this->writeIRect(bounds);
 
@@ -201,6 +208,10 @@ void SkBinaryWriteBuffer::setTypefaceRecorder(sk_sp<SkRefCntSet> rec) {
     fTFSet = std::move(rec);
 }
 
+void SkBinaryWriteBuffer::setImageRecorder(sk_sp<SkRefCntSet> rec) {
+    fImageSet = std::move(rec);
+}
+
 void SkBinaryWriteBuffer::writeFlattenable(const SkFlattenable* flattenable) {
     if (nullptr == flattenable) {
         this->write32(0);
@@ -125,10 +125,14 @@ public:
 
     void setFactoryRecorder(sk_sp<SkFactorySet>);
     void setTypefaceRecorder(sk_sp<SkRefCntSet>);
+    // When set, writeImage() only records the image and writes its (base-1) index in the set;
+    // the owner is responsible for writing the images themselves.
+    void setImageRecorder(sk_sp<SkRefCntSet>);
 
 private:
     sk_sp<SkFactorySet> fFactorySet;
     sk_sp<SkRefCntSet> fTFSet;
+    sk_sp<SkRefCntSet> fImageSet;
 
     SkWriter32 fWriter;
 
@@ -5,7 +5,7 @@
  * found in the LICENSE file.
  */
 
-#include "SkPathMeasure.h"
+#include "SkMeasuredPath.h"
 #include "SkTrimPathEffect.h"
 #include "SkTrimPE.h"
 #include "SkReadBuffer.h"
@@ -15,19 +15,20 @@ namespace {
 
 class Segmentator : public SkNoncopyable {
 public:
-    Segmentator(const SkPath& src, SkPath* dst)
-        : fMeasure(src, false)
+    Segmentator(const SkMeasuredPath& measure, SkPath* dst)
+        : fMeasure(measure)
         , fDst(dst) {}
 
     void add(SkScalar start, SkScalar stop) {
         SkASSERT(start < stop);
 
         // TODO: we appear to skip zero-length contours.
-        do {
-            const auto nextOffset = fCurrentSegmentOffset + fMeasure.getLength();
+        for (; fContour < fMeasure.contourCount(); ++fContour) {
+            const auto nextOffset = fCurrentSegmentOffset + fMeasure.length(fContour);
 
             if (start < nextOffset) {
-                fMeasure.getSegment(start - fCurrentSegmentOffset,
+                fMeasure.getSegment(fContour,
+                                    start - fCurrentSegmentOffset,
                                     stop  - fCurrentSegmentOffset,
                                     fDst, true);
 
@@ -36,13 +37,14 @@ public:
             }
 
             fCurrentSegmentOffset = nextOffset;
-        } while (fMeasure.nextContour());
+        }
     }
 
 private:
-    SkPathMeasure fMeasure;
-    SkPath*       fDst;
+    const SkMeasuredPath& fMeasure;
+    SkPath*               fDst;
 
+    int      fContour = 0;
     SkScalar fCurrentSegmentOffset = 0;
 
     using INHERITED = SkNoncopyable;
@@ -60,18 +62,14 @@ bool SkTrimPE::onFilterPath(SkPath* dst, const SkPath& src, SkStrokeRec* rec,
         return true;
     }
 
-    // First pass: compute the total len.
-    SkScalar len = 0;
-    SkPathMeasure meas(src, false);
-    do {
-        len += meas.getLength();
-    } while (meas.nextContour());
+    // Animated trims cut the same path every frame, so its measurement comes from the cache.
+    sk_sp<SkMeasuredPath> measure = SkMeasuredPath::Make(src, false);
+    const SkScalar len = measure->totalLength();
 
     const auto arcStart = len * fStartT,
                arcStop  = len * fStopT;
 
-    // Second pass: actually add segments.
-    Segmentator segmentator(src, dst);
+    Segmentator segmentator(*measure, dst);
     if (fMode == SkTrimPathEffect::Mode::kNormal) {
         if (arcStart < arcStop) segmentator.add(arcStart, arcStop);
     } else {
@@ -35,6 +35,14 @@ sk_sp<SkImageFilter> SkColorFilterImageFilter::Make(sk_sp<SkColorFilter> cf,
         }
     }
 
+    // Otherwise try to fold an uncropped color filter into its input, e.g. into the paint of an
+    // SkPaintImageFilter, or past an offset where it may meet another color filter.
+    if (input && (!cropRect || !cropRect->flags()) && !cf->affectsTransparentBlack()) {
+        if (sk_sp<SkImageFilter> folded = input->onMakeWithColorFilter(cf)) {
+            return folded;
+        }
+    }
+
     return sk_sp<SkImageFilter>(new SkColorFilterImageFilter(std::move(cf),
                                                              std::move(input),
                                                              cropRect));
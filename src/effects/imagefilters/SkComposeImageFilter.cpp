@@ -6,6 +6,7 @@
  */
 
 #include "SkComposeImageFilter.h"
+#include "SkColorFilterImageFilter.h"
 #include "SkColorSpaceXformer.h"
 #include "SkImageFilterPriv.h"
 #include "SkReadBuffer.h"
@@ -20,6 +21,12 @@ sk_sp<SkImageFilter> SkComposeImageFilter::Make(sk_sp<SkImageFilter> outer,
     if (!inner) {
         return outer;
     }
+    // A color filter over the inner filter's output is just a color filter with that input, which
+    // may then fold into the inner filter.
+    SkColorFilter* outerCF;
+    if (!outer->getInput(0) && outer->isColorFilterNode(&outerCF)) {
+        return SkColorFilterImageFilter::Make(sk_sp<SkColorFilter>(outerCF), std::move(inner));
+    }
     sk_sp<SkImageFilter> inputs[2] = { std::move(outer), std::move(inner) };
     return sk_sp<SkImageFilter>(new SkComposeImageFilter(inputs));
 }
@@ -40,7 +47,8 @@ sk_sp<SkSpecialImage> SkComposeImageFilter::onFilterImage(SkSpecialImage* source
     SkIRect innerClipBounds;
     innerClipBounds = this->getInput(0)->filterBounds(ctx.clipBounds(), ctx.ctm(),
                                                       kReverse_MapDirection, &ctx.clipBounds());
-    Context innerContext(ctx.ctm(), innerClipBounds, ctx.cache(), ctx.outputProperties());
+    Context innerContext(ctx.ctm(), innerClipBounds, ctx.cache(), ctx.outputProperties(),
+                         ctx.executor());
     SkIPoint innerOffset = SkIPoint::Make(0, 0);
     sk_sp<SkSpecialImage> inner(this->filterInput(1, source, innerContext, &innerOffset));
     if (!inner) {
@@ -51,7 +59,8 @@ sk_sp<SkSpecialImage> SkComposeImageFilter::onFilterImage(SkSpecialImage* source
     outerMatrix.postTranslate(SkIntToScalar(-innerOffset.x()), SkIntToScalar(-innerOffset.y()));
     SkIRect clipBounds = ctx.clipBounds();
     clipBounds.offset(-innerOffset.x(), -innerOffset.y());
-    Context outerContext(outerMatrix, clipBounds, ctx.cache(), ctx.outputProperties());
+    Context outerContext(outerMatrix, clipBounds, ctx.cache(), ctx.outputProperties(),
+                         ctx.executor());
 
     SkIPoint outerOffset = SkIPoint::Make(0, 0);
     sk_sp<SkSpecialImage> outer(this->filterInput(0, inner.get(), outerContext, &outerOffset));
@@ -10,9 +10,12 @@
 #include "SkColorData.h"
 #include "SkColorSpaceXformer.h"
 #include "SkImageFilterPriv.h"
+#include "SkNx.h"
 #include "SkPoint3.h"
 #include "SkReadBuffer.h"
 #include "SkSpecialImage.h"
+#include "SkTaskGroup.h"
+#include "SkTemplates.h"
 #include "SkTypes.h"
 #include "SkWriteBuffer.h"
 
@@ -57,16 +60,6 @@ static void setUniformNormal3(const GrGLSLProgramDataManager& pdman, UniformHand
 }
 #endif
 
-// Shift matrix components to the left, as we advance pixels to the right.
-static inline void shiftMatrixLeft(int m[9]) {
-    m[0] = m[1];
-    m[3] = m[4];
-    m[6] = m[7];
-    m[1] = m[2];
-    m[4] = m[5];
-    m[7] = m[8];
-}
-
 static inline void fast_normalize(SkPoint3* vector) {
     // add a tiny bit so we don't have to worry about divide-by-zero
     SkScalar magSq = vector->dot(*vector) + SK_ScalarNearlyZero;
@@ -76,6 +69,13 @@ static inline void fast_normalize(SkPoint3* vector) {
     vector->fZ *= scale;
 }
 
+static inline void fast_normalize(Sk4f* x, Sk4f* y, Sk4f* z) {
+    Sk4f scale = (*x * *x + *y * *y + *z * *z + SK_ScalarNearlyZero).rsqrt();
+    *x = *x * scale;
+    *y = *y * scale;
+    *z = *z * scale;
+}
+
 static SkPoint3 read_point3(SkReadBuffer& buffer) {
     SkPoint3 point;
     point.fX = buffer.readScalar();
@@ -93,6 +93,14 @@ static void write_point3(const SkPoint3& point, SkWriteBuffer& buffer) {
     buffer.writeScalar(point.fZ);
 };
 
+// The CPU path lights a row at a time. Each vector quantity is kept as three arrays of floats,
+// one per component, padded to a multiple of four pixels so the lighting runs as Sk4f.
+struct LightingRow {
+    float* fNormal[3];
+    float* fSurfaceToLight[3];
+    float* fLightColor[3];
+};
+
 class GrGLLight;
 class SkImageFilterLight : public SkRefCnt {
 public:
@@ -117,8 +125,10 @@ public:
     void flattenLight(SkWriteBuffer& buffer) const;
     static SkImageFilterLight* UnflattenLight(SkReadBuffer& buffer);
 
-    virtual SkPoint3 surfaceToLight(int x, int y, int z, SkScalar surfaceScale) const = 0;
-    virtual SkPoint3 lightColor(const SkPoint3& surfaceToLight) const = 0;
+    // Fills in row's surface-to-light vectors and light colors for count (a multiple of four)
+    // pixels starting at (x, y), whose heights are z[].
+    virtual void lightRow(int x, int y, const float z[], int count, SkScalar surfaceScale,
+                          LightingRow* row) const = 0;
 
 protected:
     SkImageFilterLight(SkColor color) {
@@ -145,227 +155,206 @@ public:
     BaseLightingType() {}
     virtual ~BaseLightingType() {}
 
-    virtual SkPMColor light(const SkPoint3& normal, const SkPoint3& surfaceTolight,
-                            const SkPoint3& lightColor) const= 0;
+    // Lights count (a multiple of four) pixels of row, writing the first dstCount to dst.
+    virtual void light(const LightingRow& row, int count, SkPMColor dst[], int dstCount) const = 0;
 };
 
+static inline void store_lit_pixels(const Sk4f& a, const Sk4f& r, const Sk4f& g, const Sk4f& b,
+                                    SkPMColor dst[], int dstCount) {
+    auto component = [](const Sk4f& c, int shift) {
+        // Same as SkClampMax(SkScalarRoundToInt(c), 255).
+        return SkNx_cast<int>(Sk4f::Min(Sk4f::Max(c, 0.0f), 255.0f) + 0.5f) << shift;
+    };
+    Sk4i pixels = component(a, SK_A32_SHIFT) | component(r, SK_R32_SHIFT) |
+                  component(g, SK_G32_SHIFT) | component(b, SK_B32_SHIFT);
+    if (dstCount >= 4) {
+        pixels.store(dst);
+    } else {
+        for (int i = 0; i < dstCount; ++i) {
+            dst[i] = pixels[i];
+        }
+    }
+}
+
 class DiffuseLightingType : public BaseLightingType {
 public:
     DiffuseLightingType(SkScalar kd)
         : fKD(kd) {}
-    SkPMColor light(const SkPoint3& normal, const SkPoint3& surfaceTolight,
-                    const SkPoint3& lightColor) const override {
-        SkScalar colorScale = fKD * normal.dot(surfaceTolight);
-        colorScale = SkScalarClampMax(colorScale, SK_Scalar1);
-        SkPoint3 color = lightColor.makeScale(colorScale);
-        return SkPackARGB32(255,
-                            SkClampMax(SkScalarRoundToInt(color.fX), 255),
-                            SkClampMax(SkScalarRoundToInt(color.fY), 255),
-                            SkClampMax(SkScalarRoundToInt(color.fZ), 255));
+    void light(const LightingRow& row, int count, SkPMColor dst[], int dstCount) const override {
+        for (int i = 0; i < count; i += 4, dstCount -= 4) {
+            Sk4f dot = Sk4f::Load(row.fNormal[0] + i) * Sk4f::Load(row.fSurfaceToLight[0] + i) +
+                       Sk4f::Load(row.fNormal[1] + i) * Sk4f::Load(row.fSurfaceToLight[1] + i) +
+                       Sk4f::Load(row.fNormal[2] + i) * Sk4f::Load(row.fSurfaceToLight[2] + i);
+            Sk4f colorScale = Sk4f::Min(Sk4f::Max(dot * fKD, 0.0f), 1.0f);
+            store_lit_pixels(255.0f,
+                             Sk4f::Load(row.fLightColor[0] + i) * colorScale,
+                             Sk4f::Load(row.fLightColor[1] + i) * colorScale,
+                             Sk4f::Load(row.fLightColor[2] + i) * colorScale,
+                             dst + i, dstCount);
+        }
     }
 private:
     SkScalar fKD;
 };
 
-static SkScalar max_component(const SkPoint3& p) {
-    return p.x() > p.y() ? (p.x() > p.z() ? p.x() : p.z()) : (p.y() > p.z() ? p.y() : p.z());
-}
-
 class SpecularLightingType : public BaseLightingType {
 public:
     SpecularLightingType(SkScalar ks, SkScalar shininess)
         : fKS(ks), fShininess(shininess) {}
-    SkPMColor light(const SkPoint3& normal, const SkPoint3& surfaceTolight,
-                    const SkPoint3& lightColor) const override {
-        SkPoint3 halfDir(surfaceTolight);
-        halfDir.fZ += SK_Scalar1;        // eye position is always (0, 0, 1)
-        fast_normalize(&halfDir);
-        SkScalar colorScale = fKS * SkScalarPow(normal.dot(halfDir), fShininess);
-        colorScale = SkScalarClampMax(colorScale, SK_Scalar1);
-        SkPoint3 color = lightColor.makeScale(colorScale);
-        return SkPackARGB32(SkClampMax(SkScalarRoundToInt(max_component(color)), 255),
-                            SkClampMax(SkScalarRoundToInt(color.fX), 255),
-                            SkClampMax(SkScalarRoundToInt(color.fY), 255),
-                            SkClampMax(SkScalarRoundToInt(color.fZ), 255));
+    void light(const LightingRow& row, int count, SkPMColor dst[], int dstCount) const override {
+        for (int i = 0; i < count; i += 4, dstCount -= 4) {
+            Sk4f hx = Sk4f::Load(row.fSurfaceToLight[0] + i),
+                 hy = Sk4f::Load(row.fSurfaceToLight[1] + i),
+                 hz = Sk4f::Load(row.fSurfaceToLight[2] + i) + 1.0f;  // eye is always (0, 0, 1)
+            fast_normalize(&hx, &hy, &hz);
+            Sk4f dot = Sk4f::Load(row.fNormal[0] + i) * hx +
+                       Sk4f::Load(row.fNormal[1] + i) * hy +
+                       Sk4f::Load(row.fNormal[2] + i) * hz;
+
+            // There's no Sk4f pow, so that part is done a lane at a time.
+            float pows[4];
+            dot.store(pows);
+            for (float& p : pows) {
+                p = SkScalarPow(p, fShininess);
+            }
+            Sk4f colorScale = Sk4f::Min(Sk4f::Max(Sk4f::Load(pows) * fKS, 0.0f), 1.0f);
+
+            Sk4f r = Sk4f::Load(row.fLightColor[0] + i) * colorScale,
+                 g = Sk4f::Load(row.fLightColor[1] + i) * colorScale,
+                 b = Sk4f::Load(row.fLightColor[2] + i) * colorScale;
+            store_lit_pixels(Sk4f::Max(r, Sk4f::Max(g, b)), r, g, b, dst + i, dstCount);
+        }
     }
 private:
     SkScalar fKS;
     SkScalar fShininess;
 };
 
-static inline SkScalar sobel(int a, int b, int c, int d, int e, int f, SkScalar scale) {
-    return (-a + b - 2 * c + 2 * d -e + f) * scale;
-}
-
-static inline SkPoint3 pointToNormal(SkScalar x, SkScalar y, SkScalar surfaceScale) {
-    SkPoint3 vector = SkPoint3::Make(-x * surfaceScale, -y * surfaceScale, 1);
-    fast_normalize(&vector);
-    return vector;
-}
-
-static inline SkPoint3 topLeftNormal(int m[9], SkScalar surfaceScale) {
-    return pointToNormal(sobel(0, 0, m[4], m[5], m[7], m[8], gTwoThirds),
-                         sobel(0, 0, m[4], m[7], m[5], m[8], gTwoThirds),
-                         surfaceScale);
-}
-
-static inline SkPoint3 topNormal(int m[9], SkScalar surfaceScale) {
-    return pointToNormal(sobel(   0,    0, m[3], m[5], m[6], m[8], gOneThird),
-                         sobel(m[3], m[6], m[4], m[7], m[5], m[8], gOneHalf),
-                         surfaceScale);
-}
-
-static inline SkPoint3 topRightNormal(int m[9], SkScalar surfaceScale) {
-    return pointToNormal(sobel(   0,    0, m[3], m[4], m[6], m[7], gTwoThirds),
-                         sobel(m[3], m[6], m[4], m[7],    0,    0, gTwoThirds),
-                         surfaceScale);
-}
-
-static inline SkPoint3 leftNormal(int m[9], SkScalar surfaceScale) {
-    return pointToNormal(sobel(m[1], m[2], m[4], m[5], m[7], m[8], gOneHalf),
-                         sobel(   0,    0, m[1], m[7], m[2], m[8], gOneThird),
-                         surfaceScale);
-}
-
-
-static inline SkPoint3 interiorNormal(int m[9], SkScalar surfaceScale) {
-    return pointToNormal(sobel(m[0], m[2], m[3], m[5], m[6], m[8], gOneQuarter),
-                         sobel(m[0], m[6], m[1], m[7], m[2], m[8], gOneQuarter),
-                         surfaceScale);
-}
-
-static inline SkPoint3 rightNormal(int m[9], SkScalar surfaceScale) {
-    return pointToNormal(sobel(m[0], m[1], m[3], m[4], m[6], m[7], gOneHalf),
-                         sobel(m[0], m[6], m[1], m[7],    0,    0, gOneThird),
-                         surfaceScale);
-}
-
-static inline SkPoint3 bottomLeftNormal(int m[9], SkScalar surfaceScale) {
-    return pointToNormal(sobel(m[1], m[2], m[4], m[5],    0,    0, gTwoThirds),
-                         sobel(   0,    0, m[1], m[4], m[2], m[5], gTwoThirds),
-                         surfaceScale);
-}
-
-static inline SkPoint3 bottomNormal(int m[9], SkScalar surfaceScale) {
-    return pointToNormal(sobel(m[0], m[2], m[3], m[5],    0,    0, gOneThird),
-                         sobel(m[0], m[3], m[1], m[4], m[2], m[5], gOneHalf),
-                         surfaceScale);
-}
-
-static inline SkPoint3 bottomRightNormal(int m[9], SkScalar surfaceScale) {
-    return pointToNormal(sobel(m[0], m[1], m[3], m[4], 0,  0, gTwoThirds),
-                         sobel(m[0], m[3], m[1], m[4], 0,  0, gTwoThirds),
-                         surfaceScale);
-}
-
-
-class UncheckedPixelFetcher {
-public:
-    static inline uint32_t Fetch(const SkBitmap& src, int x, int y, const SkIRect& bounds) {
-        return SkGetPackedA32(*src.getAddr32(x, y));
-    }
-};
-
-// The DecalPixelFetcher is used when the destination crop rect exceeds the input bitmap bounds.
-class DecalPixelFetcher {
-public:
-    static inline uint32_t Fetch(const SkBitmap& src, int x, int y, const SkIRect& bounds) {
-        if (x < bounds.fLeft || x >= bounds.fRight || y < bounds.fTop || y >= bounds.fBottom) {
-            return 0;
-        } else {
-            return SkGetPackedA32(*src.getAddr32(x, y));
-        }
-    }
-};
+// Loads count alpha values from row y of src, starting at x, as floats. Pixels outside src read
+// as transparent, as the DecalPixelFetcher used to do when the crop rect exceeds the input.
+static void fetch_alpha_row(const SkBitmap& src, int x, int y, int count, float dst[]) {
+    int start = SkTMax(x, 0), end = SkTMin(x + count, src.width());
+    if (y < 0 || y >= src.height() || start >= end) {
+        sk_bzero(dst, count * sizeof(float));
+        return;
+    }
+    for (int i = x; i < start; ++i) {
+        dst[i - x] = 0;
+    }
+    const SkPMColor* row = src.getAddr32(0, y);
+    for (int i = start; i < end; ++i) {
+        dst[i - x] = SkGetPackedA32(row[i]);
+    }
+    for (int i = end; i < x + count; ++i) {
+        dst[i - x] = 0;
+    }
+}
+
+// Computes the surface normals for one row of width pixels from the heights of the rows above,
+// at, and below it. At the edges of the bounds the Sobel kernels only use the pixels inside, as
+// described in the SVG spec: above or below is then null, and left/right use the pixel itself.
+static void compute_normals(const float* above, const float* center, const float* below,
+                            int width, int count, SkScalar surfaceScale, LightingRow* row) {
+    // Missing rows get no weight in the X gradient and are replaced by the center row in the Y
+    // gradient, which then spans one row instead of two.
+    const float wA = above ? 1 : 0,
+                wB = below ? 1 : 0;
+    const float* A = above ? above : center;
+    const float* B = below ? below : center;
+    const float* C = center;
+
+    float* nx = row->fNormal[0];
+    float* ny = row->fNormal[1];
+    float* nz = row->fNormal[2];
+
+    // Interior pixels (whatever lands in the first and last columns is replaced below). The
+    // height rows have one readable pixel of padding on each side.
+    const float fx = 1.0f / (wA + 2 + wB),
+                fy = 1.0f / (2 * (wA + wB));
+    for (int i = 0; i < count; i += 4) {
+        Sk4f gx = (wA   * (Sk4f::Load(A + i + 1) - Sk4f::Load(A + i - 1)) +
+                   2.0f * (Sk4f::Load(C + i + 1) - Sk4f::Load(C + i - 1)) +
+                   wB   * (Sk4f::Load(B + i + 1) - Sk4f::Load(B + i - 1))) * fx;
+        Sk4f gy = (       (Sk4f::Load(B + i - 1) - Sk4f::Load(A + i - 1)) +
+                   2.0f * (Sk4f::Load(B + i    ) - Sk4f::Load(A + i    )) +
+                          (Sk4f::Load(B + i + 1) - Sk4f::Load(A + i + 1))) * fy;
+        Sk4f x = gx * -surfaceScale,
+             y = gy * -surfaceScale,
+             z = 1.0f;
+        fast_normalize(&x, &y, &z);
+        x.store(nx + i);
+        y.store(ny + i);
+        z.store(nz + i);
+    }
+
+    // The first and last columns only span one column in X and have no weight beyond the edge
+    // in Y.
+    const float ex = 2.0f / (wA + 2 + wB),
+                ey = 2.0f / (3 * (wA + wB));
+    auto edge = [&](int i, int l, int r, int outer) {
+        float gx = (wA * (A[r] - A[l]) + 2 * (C[r] - C[l]) + wB * (B[r] - B[l])) * ex;
+        float gy = (2 * (B[i] - A[i]) + (B[outer] - A[outer])) * ey;
+        SkPoint3 normal = SkPoint3::Make(-gx * surfaceScale, -gy * surfaceScale, 1);
+        fast_normalize(&normal);
+        nx[i] = normal.fX;
+        ny[i] = normal.fY;
+        nz[i] = normal.fZ;
+    };
+    edge(0, 0, 1, 1);
+    edge(width - 1, width - 2, width - 1, width - 2);
+}
+
+// Lights dst's rows [top, bottom). The rows only depend on src, so any band can be lit
+// independently of the others.
+static void light_rows(const BaseLightingType& lightingType,
+                       const SkImageFilterLight* light,
+                       const SkBitmap& src,
+                       SkBitmap* dst,
+                       SkScalar surfaceScale,
+                       const SkIRect& bounds,
+                       int top, int bottom) {
+    const int width = bounds.width(),
+              count = SkAlign4(width);
+
+    // Three rows of heights, each with a pixel of padding on either side, then the row itself.
+    const int stride = count + 2;
+    SkAutoTMalloc<float> storage(3 * stride + 9 * count);
+    float* heights[3] = { storage.get() + 1, storage.get() + 1 + stride,
+                          storage.get() + 1 + 2 * stride };
+    float* rowStorage = storage.get() + 3 * stride;
+    LightingRow row;
+    for (int i = 0; i < 3; ++i) {
+        row.fNormal[i]         = rowStorage + (0 + i) * count;
+        row.fSurfaceToLight[i] = rowStorage + (3 + i) * count;
+        row.fLightColor[i]     = rowStorage + (6 + i) * count;
+    }
+
+    auto fetch = [&](float* heightRow, int y) {
+        heightRow[-1] = heightRow[count] = 0;
+        fetch_alpha_row(src, bounds.left(), bounds.top() + y, count, heightRow);
+    };
 
-template <class PixelFetcher>
-static void lightBitmap(const BaseLightingType& lightingType,
-                 const SkImageFilterLight* l,
-                 const SkBitmap& src,
-                 SkBitmap* dst,
-                 SkScalar surfaceScale,
-                 const SkIRect& bounds) {
-    SkASSERT(dst->width() == bounds.width() && dst->height() == bounds.height());
-    int left = bounds.left(), right = bounds.right();
-    int bottom = bounds.bottom();
-    int y = bounds.top();
-    SkIRect srcBounds = src.bounds();
-    SkPMColor* dptr = dst->getAddr32(0, 0);
-    {
-        int x = left;
-        int m[9];
-        m[4] = PixelFetcher::Fetch(src, x,     y,     srcBounds);
-        m[5] = PixelFetcher::Fetch(src, x + 1, y,     srcBounds);
-        m[7] = PixelFetcher::Fetch(src, x,     y + 1, srcBounds);
-        m[8] = PixelFetcher::Fetch(src, x + 1, y + 1, srcBounds);
-        SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-        *dptr++ = lightingType.light(topLeftNormal(m, surfaceScale), surfaceToLight,
-                                     l->lightColor(surfaceToLight));
-        for (++x; x < right - 1; ++x)
-        {
-            shiftMatrixLeft(m);
-            m[5] = PixelFetcher::Fetch(src, x + 1, y,     srcBounds);
-            m[8] = PixelFetcher::Fetch(src, x + 1, y + 1, srcBounds);
-            surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-            *dptr++ = lightingType.light(topNormal(m, surfaceScale), surfaceToLight,
-                                         l->lightColor(surfaceToLight));
-        }
-        shiftMatrixLeft(m);
-        surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-        *dptr++ = lightingType.light(topRightNormal(m, surfaceScale), surfaceToLight,
-                                     l->lightColor(surfaceToLight));
-    }
-
-    for (++y; y < bottom - 1; ++y) {
-        int x = left;
-        int m[9];
-        m[1] = PixelFetcher::Fetch(src, x,     y - 1, srcBounds);
-        m[2] = PixelFetcher::Fetch(src, x + 1, y - 1, srcBounds);
-        m[4] = PixelFetcher::Fetch(src, x,     y,     srcBounds);
-        m[5] = PixelFetcher::Fetch(src, x + 1, y,     srcBounds);
-        m[7] = PixelFetcher::Fetch(src, x,     y + 1, srcBounds);
-        m[8] = PixelFetcher::Fetch(src, x + 1, y + 1, srcBounds);
-        SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-        *dptr++ = lightingType.light(leftNormal(m, surfaceScale), surfaceToLight,
-                                     l->lightColor(surfaceToLight));
-        for (++x; x < right - 1; ++x) {
-            shiftMatrixLeft(m);
-            m[2] = PixelFetcher::Fetch(src, x + 1, y - 1, srcBounds);
-            m[5] = PixelFetcher::Fetch(src, x + 1, y,     srcBounds);
-            m[8] = PixelFetcher::Fetch(src, x + 1, y + 1, srcBounds);
-            surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-            *dptr++ = lightingType.light(interiorNormal(m, surfaceScale), surfaceToLight,
-                                         l->lightColor(surfaceToLight));
+    float* above  = heights[0];
+    float* center = heights[1];
+    float* below  = heights[2];
+    if (top > 0) {
+        fetch(above, top - 1);
+    }
+    fetch(center, top);
+    for (int y = top; y < bottom; ++y) {
+        const bool hasBelow = y + 1 < bounds.height();
+        if (hasBelow) {
+            fetch(below, y + 1);
         }
-        shiftMatrixLeft(m);
-        surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-        *dptr++ = lightingType.light(rightNormal(m, surfaceScale), surfaceToLight,
-                                     l->lightColor(surfaceToLight));
-    }
+        compute_normals(y > 0 ? above : nullptr, center, hasBelow ? below : nullptr,
+                        width, count, surfaceScale, &row);
+        light->lightRow(bounds.left(), bounds.top() + y, center, count, surfaceScale, &row);
+        lightingType.light(row, count, dst->getAddr32(0, y), width);
 
-    {
-        int x = left;
-        int m[9];
-        m[1] = PixelFetcher::Fetch(src, x,     bottom - 2, srcBounds);
-        m[2] = PixelFetcher::Fetch(src, x + 1, bottom - 2, srcBounds);
-        m[4] = PixelFetcher::Fetch(src, x,     bottom - 1, srcBounds);
-        m[5] = PixelFetcher::Fetch(src, x + 1, bottom - 1, srcBounds);
-        SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-        *dptr++ = lightingType.light(bottomLeftNormal(m, surfaceScale), surfaceToLight,
-                                     l->lightColor(surfaceToLight));
-        for (++x; x < right - 1; ++x)
-        {
-            shiftMatrixLeft(m);
-            m[2] = PixelFetcher::Fetch(src, x + 1, bottom - 2, srcBounds);
-            m[5] = PixelFetcher::Fetch(src, x + 1, bottom - 1, srcBounds);
-            surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-            *dptr++ = lightingType.light(bottomNormal(m, surfaceScale), surfaceToLight,
-                                         l->lightColor(surfaceToLight));
-        }
-        shiftMatrixLeft(m);
-        surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-        *dptr++ = lightingType.light(bottomRightNormal(m, surfaceScale), surfaceToLight,
-                                     l->lightColor(surfaceToLight));
+        float* recycled = above;
+        above  = center;
+        center = below;
+        below  = recycled;
     }
 }
 
@@ -375,13 +364,21 @@ static void lightBitmap(const BaseLightingType& lightingType,
                  SkBitmap* dst,
                  SkScalar surfaceScale,
                  const SkIRect& bounds) {
-    if (src.bounds().contains(bounds)) {
-        lightBitmap<UncheckedPixelFetcher>(
-            lightingType, light, src, dst, surfaceScale, bounds);
-    } else {
-        lightBitmap<DecalPixelFetcher>(
-            lightingType, light, src, dst, surfaceScale, bounds);
+    SkASSERT(dst->width() == bounds.width() && dst->height() == bounds.height());
+    SkASSERT(bounds.width() >= 2 && bounds.height() >= 2);
+
+    // Bands of rows can run in parallel if the default executor is a thread pool.
+    static constexpr int kRowsPerBand = 64;
+    const int bandCount = (bounds.height() + kRowsPerBand - 1) / kRowsPerBand;
+    if (bandCount == 1) {
+        light_rows(lightingType, light, src, dst, surfaceScale, bounds, 0, bounds.height());
+        return;
     }
+    SkTaskGroup().batch(bandCount, [&](int band) {
+        int top = band * kRowsPerBand;
+        light_rows(lightingType, light, src, dst, surfaceScale, bounds,
+                   top, SkTMin(top + kRowsPerBand, bounds.height()));
+    });
 }
 
 enum BoundaryMode {
@@ -419,6 +416,9 @@ protected:
             const SkIRect* srcBounds,
             BoundaryMode boundaryMode) const = 0;
 #endif
+    // The normals along the edges of the output are computed as if they were image edges.
+    bool onCanFilterInTiles() const override { return false; }
+
 private:
 #if SK_SUPPORT_GPU
     void drawRect(GrRenderTargetContext*,
@@ -831,16 +831,41 @@ static SkColor xform_color(const SkPoint3& color, SkColorSpaceXformer* xformer)
     return xformer->apply(origColor);
 }
 
+static void fill_row(float* const row[3], const SkPoint3& value, int count) {
+    for (int i = 0; i < count; ++i) {
+        row[0][i] = value.fX;
+        row[1][i] = value.fY;
+        row[2][i] = value.fZ;
+    }
+}
+
+// The normalized vectors from each pixel of the row, at its height, to location.
+static void surface_to_point_row(const SkPoint3& location, int x, int y, const float z[],
+                                 int count, SkScalar surfaceScale, LightingRow* row) {
+    const Sk4f dy = location.fY - SkIntToScalar(y);
+    Sk4f px = Sk4f(0, 1, 2, 3) + SkIntToScalar(x);
+    for (int i = 0; i < count; i += 4, px = px + 4) {
+        Sk4f lx = location.fX - px,
+             ly = dy,
+             lz = location.fZ - Sk4f::Load(z + i) * surfaceScale;
+        fast_normalize(&lx, &ly, &lz);
+        lx.store(row->fSurfaceToLight[0] + i);
+        ly.store(row->fSurfaceToLight[1] + i);
+        lz.store(row->fSurfaceToLight[2] + i);
+    }
+}
+
 class SkDistantLight : public SkImageFilterLight {
 public:
     SkDistantLight(const SkPoint3& direction, SkColor color)
       : INHERITED(color), fDirection(direction) {
     }
 
-    SkPoint3 surfaceToLight(int x, int y, int z, SkScalar surfaceScale) const override {
-        return fDirection;
+    void lightRow(int x, int y, const float z[], int count, SkScalar surfaceScale,
+                  LightingRow* row) const override {
+        fill_row(row->fSurfaceToLight, fDirection, count);
+        fill_row(row->fLightColor, this->color(), count);
     }
-    SkPoint3 lightColor(const SkPoint3&) const override { return this->color(); }
     LightType type() const override { return kDistant_LightType; }
     const SkPoint3& direction() const { return fDirection; }
     GrGLLight* createGLLight() const override {
@@ -894,14 +919,11 @@ public:
     SkPointLight(const SkPoint3& location, SkColor color)
      : INHERITED(color), fLocation(location) {}
 
-    SkPoint3 surfaceToLight(int x, int y, int z, SkScalar surfaceScale) const override {
-        SkPoint3 direction = SkPoint3::Make(fLocation.fX - SkIntToScalar(x),
-                                            fLocation.fY - SkIntToScalar(y),
-                                            fLocation.fZ - SkIntToScalar(z) * surfaceScale);
-        fast_normalize(&direction);
-        return direction;
+    void lightRow(int x, int y, const float z[], int count, SkScalar surfaceScale,
+                  LightingRow* row) const override {
+        surface_to_point_row(fLocation, x, y, z, count, surfaceScale, row);
+        fill_row(row->fLightColor, this->color(), count);
     }
-    SkPoint3 lightColor(const SkPoint3&) const override { return this->color(); }
     LightType type() const override { return kPoint_LightType; }
     const SkPoint3& location() const { return fLocation; }
     GrGLLight* createGLLight() const override {
@@ -1008,23 +1030,28 @@ public:
                                color());
     }
 
-    SkPoint3 surfaceToLight(int x, int y, int z, SkScalar surfaceScale) const override {
-        SkPoint3 direction = SkPoint3::Make(fLocation.fX - SkIntToScalar(x),
-                                            fLocation.fY - SkIntToScalar(y),
-                                            fLocation.fZ - SkIntToScalar(z) * surfaceScale);
-        fast_normalize(&direction);
-        return direction;
-    }
-    SkPoint3 lightColor(const SkPoint3& surfaceToLight) const override {
-        SkScalar cosAngle = -surfaceToLight.dot(fS);
-        SkScalar scale = 0;
-        if (cosAngle >= fCosOuterConeAngle) {
-            scale = SkScalarPow(cosAngle, fSpecularExponent);
-            if (cosAngle < fCosInnerConeAngle) {
-                scale *= (cosAngle - fCosOuterConeAngle) * fConeScale;
+    void lightRow(int x, int y, const float z[], int count, SkScalar surfaceScale,
+                  LightingRow* row) const override {
+        surface_to_point_row(fLocation, x, y, z, count, surfaceScale, row);
+        const SkPoint3& color = this->color();
+        for (int i = 0; i < count; i += 4) {
+            Sk4f cosAngle = -(Sk4f::Load(row->fSurfaceToLight[0] + i) * fS.fX +
+                              Sk4f::Load(row->fSurfaceToLight[1] + i) * fS.fY +
+                              Sk4f::Load(row->fSurfaceToLight[2] + i) * fS.fZ);
+
+            // Only the cone's falloff needs pow, which we have to do a lane at a time.
+            float scales[4];
+            cosAngle.store(scales);
+            for (float& scale : scales) {
+                scale = scale >= fCosOuterConeAngle ? SkScalarPow(scale, fSpecularExponent) : 0;
             }
+            Sk4f edge = (cosAngle - fCosOuterConeAngle) * fConeScale;
+            Sk4f scale = (cosAngle < fCosInnerConeAngle).thenElse(Sk4f::Load(scales) * edge,
+                                                                  Sk4f::Load(scales));
+            (scale * color.fX).store(row->fLightColor[0] + i);
+            (scale * color.fY).store(row->fLightColor[1] + i);
+            (scale * color.fZ).store(row->fLightColor[2] + i);
         }
-        return this->color().makeScale(scale);
     }
     GrGLLight* createGLLight() const override {
 #if SK_SUPPORT_GPU
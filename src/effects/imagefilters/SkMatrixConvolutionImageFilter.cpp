@@ -10,10 +10,12 @@
 #include "SkColorData.h"
 #include "SkColorSpaceXformer.h"
 #include "SkImageFilterPriv.h"
+#include "SkNx.h"
 #include "SkReadBuffer.h"
 #include "SkSpecialImage.h"
 #include "SkWriteBuffer.h"
 #include "SkRect.h"
+#include "SkTemplates.h"
 #include "SkUnPreMultiply.h"
 
 #if SK_SUPPORT_GPU
@@ -26,6 +28,50 @@
 // by the size of a scalar to know how many scalars we can read.
 static const int32_t gMaxKernelSize = SK_MaxS32 / sizeof(SkScalar);
 
+// Returns the row and column (see fSeparableKernel) whose outer product is kernel, or null if it
+// has rank > 1 or is too small for two 1D passes to pay off. Every row of a rank-1 kernel is a
+// multiple of the row through its largest entry, the multiples being that entry's column
+// divided by it, so we only have to check that this reproduces the kernel.
+static SkScalar* make_separable_kernel(const SkISize& kernelSize, const SkScalar* kernel) {
+    const int w = kernelSize.width(), h = kernelSize.height();
+    if (w * h <= 2 * (w + h)) {
+        return nullptr;
+    }
+
+    int pivot = 0;
+    for (int i = 1; i < w * h; ++i) {
+        if (SkScalarAbs(kernel[i]) > SkScalarAbs(kernel[pivot])) {
+            pivot = i;
+        }
+    }
+    const SkScalar maxAbs = SkScalarAbs(kernel[pivot]);
+    if (maxAbs == 0 || !SkScalarIsFinite(maxAbs)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SkScalar[]> separable(new SkScalar[w + h]);
+    SkScalar* row = separable.get();
+    SkScalar* col = separable.get() + w;
+    for (int x = 0; x < w; ++x) {
+        row[x] = kernel[pivot / w * w + x];
+    }
+    for (int y = 0; y < h; ++y) {
+        col[y] = kernel[y * w + pivot % w] / kernel[pivot];
+    }
+
+    // Allow for the rounding of a kernel that was computed as an outer product in floats.
+    const SkScalar tolerance = maxAbs * 1e-6f;
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            // Written so that NaNs fail.
+            if (!(SkScalarAbs(col[y] * row[x] - kernel[y * w + x]) <= tolerance)) {
+                return nullptr;
+            }
+        }
+    }
+    return separable.release();
+}
+
 SkMatrixConvolutionImageFilter::SkMatrixConvolutionImageFilter(const SkISize& kernelSize,
                                                                const SkScalar* kernel,
                                                                SkScalar gain,
@@ -41,10 +87,12 @@ SkMatrixConvolutionImageFilter::SkMatrixConvolutionImageFilter(const SkISize& ke
     , fBias(bias)
     , fKernelOffset(kernelOffset)
     , fTileMode(tileMode)
-    , fConvolveAlpha(convolveAlpha) {
+    , fConvolveAlpha(convolveAlpha)
+    , fSeparableKernel(nullptr) {
     size_t size = (size_t) sk_64_mul(fKernelSize.width(), fKernelSize.height());
     fKernel = new SkScalar[size];
     memcpy(fKernel, kernel, size * sizeof(SkScalar));
+    fSeparableKernel = make_separable_kernel(fKernelSize, fKernel);
     SkASSERT(kernelSize.fWidth >= 1 && kernelSize.fHeight >= 1);
     SkASSERT(kernelOffset.fX >= 0 && kernelOffset.fX < kernelSize.fWidth);
     SkASSERT(kernelOffset.fY >= 0 && kernelOffset.fY < kernelSize.fHeight);
@@ -128,6 +176,7 @@ void SkMatrixConvolutionImageFilter::flatten(SkWriteBuffer& buffer) const {
 
 SkMatrixConvolutionImageFilter::~SkMatrixConvolutionImageFilter() {
     delete[] fKernel;
+    delete[] fSeparableKernel;
 }
 
 class UncheckedPixelFetcher {
@@ -172,6 +221,28 @@ public:
     }
 };
 
+// The pixel's components as floats, in memory order.
+static inline Sk4f load_pixel(SkPMColor c) {
+    return SkNx_cast<float>(Sk4b::Load(&c));
+}
+
+template <bool convolveAlpha>
+static inline SkPMColor pack_convolved(const Sk4f& sum, SkScalar gain, SkScalar bias,
+                                       U8CPU srcAlpha) {
+    float c[4];
+    (sum * gain + bias).store(c);
+    int a = convolveAlpha
+          ? SkClampMax(SkScalarFloorToInt(c[SK_A32_SHIFT / 8]), 255)
+          : 255;
+    int r = SkClampMax(SkScalarFloorToInt(c[SK_R32_SHIFT / 8]), a);
+    int g = SkClampMax(SkScalarFloorToInt(c[SK_G32_SHIFT / 8]), a);
+    int b = SkClampMax(SkScalarFloorToInt(c[SK_B32_SHIFT / 8]), a);
+    if (!convolveAlpha) {
+        return SkPreMultiplyARGB(srcAlpha, r, g, b);
+    }
+    return SkPackARGB32(a, r, g, b);
+}
+
 template<class PixelFetcher, bool convolveAlpha>
 void SkMatrixConvolutionImageFilter::filterPixels(const SkBitmap& src,
                                                   SkBitmap* result,
@@ -185,34 +256,113 @@ void SkMatrixConvolutionImageFilter::filterPixels(const SkBitmap& src,
     for (int y = rect.fTop; y < rect.fBottom; ++y) {
         SkPMColor* dptr = result->getAddr32(rect.fLeft - offset.fX, y - offset.fY);
         for (int x = rect.fLeft; x < rect.fRight; ++x) {
-            SkScalar sumA = 0, sumR = 0, sumG = 0, sumB = 0;
+            Sk4f sum = 0.0f;
             for (int cy = 0; cy < fKernelSize.fHeight; cy++) {
                 for (int cx = 0; cx < fKernelSize.fWidth; cx++) {
                     SkPMColor s = PixelFetcher::fetch(src,
                                                       x + cx - fKernelOffset.fX,
                                                       y + cy - fKernelOffset.fY,
                                                       bounds);
-                    SkScalar k = fKernel[cy * fKernelSize.fWidth + cx];
-                    if (convolveAlpha) {
-                        sumA += SkGetPackedA32(s) * k;
-                    }
-                    sumR += SkGetPackedR32(s) * k;
-                    sumG += SkGetPackedG32(s) * k;
-                    sumB += SkGetPackedB32(s) * k;
+                    sum = sum + load_pixel(s) * fKernel[cy * fKernelSize.fWidth + cx];
+                }
+            }
+            U8CPU srcAlpha = convolveAlpha
+                           ? 0
+                           : SkGetPackedA32(PixelFetcher::fetch(src, x, y, bounds));
+            *dptr++ = pack_convolved<convolveAlpha>(sum, fGain, fBias, srcAlpha);
+        }
+    }
+}
+
+// Maps a sample coordinate into [lo, hi) as the tile mode does, or returns -1 for transparent
+// black. Each tile mode treats x and y independently, which is what lets a separable kernel be
+// applied as two 1D passes.
+static int tile_coord(int c, int lo, int hi, SkMatrixConvolutionImageFilter::TileMode tileMode) {
+    switch (tileMode) {
+        case SkMatrixConvolutionImageFilter::kClamp_TileMode:
+            return SkTPin(c, lo, hi - 1);
+        case SkMatrixConvolutionImageFilter::kRepeat_TileMode:
+            c = (c - lo) % (hi - lo) + lo;
+            return c < lo ? c + (hi - lo) : c;
+        case SkMatrixConvolutionImageFilter::kClampToBlack_TileMode:
+            return (c >= lo && c < hi) ? c : -1;
+    }
+    return -1;
+}
+
+template<bool convolveAlpha>
+void SkMatrixConvolutionImageFilter::filterSeparable(const SkBitmap& src,
+                                                     SkBitmap* result,
+                                                     SkIVector& offset,
+                                                     const SkIRect& r,
+                                                     const SkIRect& bounds) const {
+    SkIRect rect(r);
+    if (!rect.intersect(bounds)) {
+        return;
+    }
+    const int kernelWidth = fKernelSize.fWidth, kernelHeight = fKernelSize.fHeight;
+    const SkScalar* kernelX = fSeparableKernel;
+    const SkScalar* kernelY = fSeparableKernel + kernelWidth;
+    const int width = rect.width();
+
+    // The source column (or row) that each sample column (or row) reads, after tiling.
+    const int sampleCols = width + kernelWidth - 1,
+              sampleRows = rect.height() + kernelHeight - 1;
+    SkAutoTMalloc<int> cols(sampleCols), rows(sampleRows);
+    for (int i = 0; i < sampleCols; ++i) {
+        cols[i] = tile_coord(rect.fLeft - fKernelOffset.fX + i, bounds.fLeft, bounds.fRight,
+                             fTileMode);
+    }
+    for (int i = 0; i < sampleRows; ++i) {
+        rows[i] = tile_coord(rect.fTop - fKernelOffset.fY + i, bounds.fTop, bounds.fBottom,
+                             fTileMode);
+    }
+
+    // The horizontal pass over the last kernelHeight sample rows, one Sk4f per pixel.
+    SkAutoTMalloc<float> ring(4 * width * kernelHeight);
+    auto convolveRow = [&](int sampleRow) {
+        float* dst = ring.get() + 4 * width * (sampleRow % kernelHeight);
+        if (rows[sampleRow] < 0) {
+            sk_bzero(dst, 4 * width * sizeof(float));
+            return;
+        }
+        const SkPMColor* srcRow = src.getAddr32(0, rows[sampleRow]);
+        for (int x = 0; x < width; ++x) {
+            Sk4f sum = 0.0f;
+            for (int cx = 0; cx < kernelWidth; ++cx) {
+                int sx = cols[x + cx];
+                if (sx >= 0) {
+                    sum = sum + load_pixel(srcRow[sx]) * kernelX[cx];
                 }
             }
-            int a = convolveAlpha
-                  ? SkClampMax(SkScalarFloorToInt(sumA * fGain + fBias), 255)
-                  : 255;
-            int r = SkClampMax(SkScalarFloorToInt(sumR * fGain + fBias), a);
-            int g = SkClampMax(SkScalarFloorToInt(sumG * fGain + fBias), a);
-            int b = SkClampMax(SkScalarFloorToInt(sumB * fGain + fBias), a);
+            sum.store(dst + 4 * x);
+        }
+    };
+
+    SkAutoSTMalloc<16, const float*> taps(kernelHeight);
+    for (int i = 0; i < kernelHeight - 1; ++i) {
+        convolveRow(i);
+    }
+    for (int y = rect.fTop; y < rect.fBottom; ++y) {
+        const int firstRow = y - rect.fTop;
+        convolveRow(firstRow + kernelHeight - 1);
+        for (int cy = 0; cy < kernelHeight; ++cy) {
+            taps[cy] = ring.get() + 4 * width * ((firstRow + cy) % kernelHeight);
+        }
+
+        SkPMColor* dptr = result->getAddr32(rect.fLeft - offset.fX, y - offset.fY);
+        for (int x = 0; x < width; ++x) {
+            Sk4f sum = 0.0f;
+            for (int cy = 0; cy < kernelHeight; ++cy) {
+                sum = sum + Sk4f::Load(taps[cy] + 4 * x) * kernelY[cy];
+            }
+            U8CPU srcAlpha = 0;
             if (!convolveAlpha) {
-                a = SkGetPackedA32(PixelFetcher::fetch(src, x, y, bounds));
-                *dptr++ = SkPreMultiplyARGB(a, r, g, b);
-            } else {
-                *dptr++ = SkPackARGB32(a, r, g, b);
+                int sx = cols[x + fKernelOffset.fX],
+                    sy = rows[firstRow + fKernelOffset.fY];
+                srcAlpha = (sx >= 0 && sy >= 0) ? SkGetPackedA32(*src.getAddr32(sx, sy)) : 0;
             }
+            *dptr++ = pack_convolved<convolveAlpha>(sum, fGain, fBias, srcAlpha);
         }
     }
 }
@@ -426,11 +576,21 @@ sk_sp<SkSpecialImage> SkMatrixConvolutionImageFilter::onFilterImage(SkSpecialIma
 
     SkIVector dstContentOffset = { offset->fX - inputOffset.fX, offset->fY - inputOffset.fY };
 
-    this->filterBorderPixels(inputBM, &dst, dstContentOffset, top, srcBounds);
-    this->filterBorderPixels(inputBM, &dst, dstContentOffset, left, srcBounds);
-    this->filterInteriorPixels(inputBM, &dst, dstContentOffset, interior, srcBounds);
-    this->filterBorderPixels(inputBM, &dst, dstContentOffset, right, srcBounds);
-    this->filterBorderPixels(inputBM, &dst, dstContentOffset, bottom, srcBounds);
+    if (fSeparableKernel) {
+        // The 1D passes handle the tile mode themselves, so there's no need to split out the
+        // border.
+        if (fConvolveAlpha) {
+            this->filterSeparable<true>(inputBM, &dst, dstContentOffset, dstBounds, srcBounds);
+        } else {
+            this->filterSeparable<false>(inputBM, &dst, dstContentOffset, dstBounds, srcBounds);
+        }
+    } else {
+        this->filterBorderPixels(inputBM, &dst, dstContentOffset, top, srcBounds);
+        this->filterBorderPixels(inputBM, &dst, dstContentOffset, left, srcBounds);
+        this->filterInteriorPixels(inputBM, &dst, dstContentOffset, interior, srcBounds);
+        this->filterBorderPixels(inputBM, &dst, dstContentOffset, right, srcBounds);
+        this->filterBorderPixels(inputBM, &dst, dstContentOffset, bottom, srcBounds);
+    }
 
     return SkSpecialImage::MakeFromRaster(SkIRect::MakeWH(dstBounds.width(), dstBounds.height()),
                                           dst);
@@ -11,9 +11,11 @@
 #include "SkColorData.h"
 #include "SkColorSpaceXformer.h"
 #include "SkImageFilterPriv.h"
+#include "SkNx.h"
 #include "SkReadBuffer.h"
 #include "SkRect.h"
 #include "SkSpecialImage.h"
+#include "SkTemplates.h"
 #include "SkWriteBuffer.h"
 
 #if SK_SUPPORT_GPU
@@ -119,6 +121,10 @@ sk_sp<SkFlattenable> SkDilateImageFilter::CreateProc(SkReadBuffer& buffer) {
  * component-wise min (Erode_Type) or max (Dilate_Type) of all pixels in the
  * kernel is selected as the new color. The new color is modulated by the input
  * color.
+ *
+ * The kernel's taps are step texels apart. A pass with radius r and step s applied to the result
+ * of a pass with radius r0 (s <= 2 * r0 + 1) has the same effect as one pass with radius
+ * r0 + r * s, which is how large radii are built up from a few cheap passes.
  */
 class GrMorphologyEffect : public GrFragmentProcessor {
 public:
@@ -126,15 +132,16 @@ public:
     enum class Type { kErode, kDilate };
 
     static std::unique_ptr<GrFragmentProcessor> Make(sk_sp<GrTextureProxy> proxy, Direction dir,
-                                                     int radius, Type type) {
+                                                     int radius, Type type, int step = 1) {
         return std::unique_ptr<GrFragmentProcessor>(
-                new GrMorphologyEffect(std::move(proxy), dir, radius, type, nullptr));
+                new GrMorphologyEffect(std::move(proxy), dir, radius, type, nullptr, step));
     }
 
     static std::unique_ptr<GrFragmentProcessor> Make(sk_sp<GrTextureProxy> proxy, Direction dir,
-                                                     int radius, Type type, const float bounds[2]) {
+                                                     int radius, Type type, const float bounds[2],
+                                                     int step = 1) {
         return std::unique_ptr<GrFragmentProcessor>(
-                new GrMorphologyEffect(std::move(proxy), dir, radius, type, bounds));
+                new GrMorphologyEffect(std::move(proxy), dir, radius, type, bounds, step));
     }
 
     Type type() const { return fType; }
@@ -143,6 +150,7 @@ public:
     Direction direction() const { return fDirection; }
     int radius() const { return fRadius; }
     int width() const { return 2 * fRadius + 1; }
+    int step() const { return fStep; }
 
     const char* name() const override { return "Morphology"; }
 
@@ -155,6 +163,7 @@ private:
     TextureSampler fTextureSampler;
     Direction fDirection;
     int fRadius;
+    int fStep;
     Type fType;
     bool fUseRange;
     float fRange[2];
@@ -167,7 +176,8 @@ private:
 
     const TextureSampler& onTextureSampler(int i) const override { return fTextureSampler; }
 
-    GrMorphologyEffect(sk_sp<GrTextureProxy>, Direction, int radius, Type, const float range[2]);
+    GrMorphologyEffect(sk_sp<GrTextureProxy>, Direction, int radius, Type, const float range[2],
+                       int step);
     explicit GrMorphologyEffect(const GrMorphologyEffect&);
 
     GR_DECLARE_FRAGMENT_PROCESSOR_TEST
@@ -289,7 +299,8 @@ void GrGLMorphologyEffect::onSetData(const GrGLSLProgramDataManager& pdman,
         default:
             SK_ABORT("Unknown filter direction.");
     }
-    pdman.set1f(fPixelSizeUni, pixelSize);
+    // The shader walks the taps by PixelSize, so spread them out by the step.
+    pdman.set1f(fPixelSizeUni, pixelSize * m.step());
 
     if (m.useRange()) {
         const float* range = m.range();
@@ -308,15 +319,20 @@ GrMorphologyEffect::GrMorphologyEffect(sk_sp<GrTextureProxy> proxy,
                                        Direction direction,
                                        int radius,
                                        Type type,
-                                       const float range[2])
+                                       const float range[2],
+                                       int step)
         : INHERITED(kGrMorphologyEffect_ClassID,
                     ModulateForClampedSamplerOptFlags(proxy->config()))
         , fCoordTransform(proxy.get())
         , fTextureSampler(std::move(proxy))
         , fDirection(direction)
         , fRadius(radius)
+        , fStep(step)
         , fType(type)
         , fUseRange(SkToBool(range)) {
+    // The radius shares the processor key with the type and direction bits.
+    SkASSERT(radius >= 0 && radius < 256);
+    SkASSERT(step >= 1);
     // Make sure the sampler's ctor uses the clamp wrap mode
     SkASSERT(fTextureSampler.samplerState().wrapModeX() == GrSamplerState::WrapMode::kClamp &&
              fTextureSampler.samplerState().wrapModeY() == GrSamplerState::WrapMode::kClamp);
@@ -334,6 +350,7 @@ GrMorphologyEffect::GrMorphologyEffect(const GrMorphologyEffect& that)
         , fTextureSampler(that.fTextureSampler)
         , fDirection(that.fDirection)
         , fRadius(that.fRadius)
+        , fStep(that.fStep)
         , fType(that.fType)
         , fUseRange(that.fUseRange) {
     this->addCoordTransform(&fCoordTransform);
@@ -355,6 +372,7 @@ GrGLSLFragmentProcessor* GrMorphologyEffect::onCreateGLSLInstance() const {
 bool GrMorphologyEffect::onIsEqual(const GrFragmentProcessor& sBase) const {
     const GrMorphologyEffect& s = sBase.cast<GrMorphologyEffect>();
     return (this->radius() == s.radius() &&
+            this->step() == s.step() &&
             this->direction() == s.direction() &&
             this->useRange() == s.useRange() &&
             this->type() == s.type());
@@ -386,13 +404,14 @@ static void apply_morphology_rect(GrRenderTargetContext* renderTargetContext,
                                   const SkIRect& srcRect,
                                   const SkIRect& dstRect,
                                   int radius,
+                                  int step,
                                   GrMorphologyEffect::Type morphType,
                                   const float bounds[2],
                                   GrMorphologyEffect::Direction direction) {
     GrPaint paint;
     paint.addColorFragmentProcessor(GrMorphologyEffect::Make(std::move(proxy),
                                                              direction, radius, morphType,
-                                                             bounds));
+                                                             bounds, step));
     paint.setPorterDuffXPFactory(SkBlendMode::kSrc);
     renderTargetContext->fillRectToRect(clip, std::move(paint), GrAA::kNo, SkMatrix::I(),
                                         SkRect::Make(dstRect), SkRect::Make(srcRect));
@@ -404,11 +423,12 @@ static void apply_morphology_rect_no_bounds(GrRenderTargetContext* renderTargetC
                                             const SkIRect& srcRect,
                                             const SkIRect& dstRect,
                                             int radius,
+                                            int step,
                                             GrMorphologyEffect::Type morphType,
                                             GrMorphologyEffect::Direction direction) {
     GrPaint paint;
     paint.addColorFragmentProcessor(GrMorphologyEffect::Make(std::move(proxy),
-                                                             direction, radius, morphType));
+                                                             direction, radius, morphType, step));
     paint.setPorterDuffXPFactory(SkBlendMode::kSrc);
     renderTargetContext->fillRectToRect(clip, std::move(paint), GrAA::kNo, SkMatrix::I(),
                                         SkRect::Make(dstRect), SkRect::Make(srcRect));
@@ -420,8 +440,11 @@ static void apply_morphology_pass(GrRenderTargetContext* renderTargetContext,
                                   const SkIRect& srcRect,
                                   const SkIRect& dstRect,
                                   int radius,
+                                  int step,
                                   GrMorphologyEffect::Type morphType,
                                   GrMorphologyEffect::Direction direction) {
+    // The margins are wherever the outermost taps can fall outside srcRect.
+    const int reach = radius * step;
     float bounds[2] = { 0.0f, 1.0f };
     SkIRect lowerSrcRect = srcRect, lowerDstRect = dstRect;
     SkIRect middleSrcRect = srcRect, middleDstRect = dstRect;
@@ -429,35 +452,85 @@ static void apply_morphology_pass(GrRenderTargetContext* renderTargetContext,
     if (direction == GrMorphologyEffect::Direction::kX) {
         bounds[0] = SkIntToScalar(srcRect.left()) + 0.5f;
         bounds[1] = SkIntToScalar(srcRect.right()) - 0.5f;
-        lowerSrcRect.fRight = srcRect.left() + radius;
-        lowerDstRect.fRight = dstRect.left() + radius;
-        upperSrcRect.fLeft = srcRect.right() - radius;
-        upperDstRect.fLeft = dstRect.right() - radius;
-        middleSrcRect.inset(radius, 0);
-        middleDstRect.inset(radius, 0);
+        lowerSrcRect.fRight = srcRect.left() + reach;
+        lowerDstRect.fRight = dstRect.left() + reach;
+        upperSrcRect.fLeft = srcRect.right() - reach;
+        upperDstRect.fLeft = dstRect.right() - reach;
+        middleSrcRect.inset(reach, 0);
+        middleDstRect.inset(reach, 0);
     } else {
         bounds[0] = SkIntToScalar(srcRect.top()) + 0.5f;
         bounds[1] = SkIntToScalar(srcRect.bottom()) - 0.5f;
-        lowerSrcRect.fBottom = srcRect.top() + radius;
-        lowerDstRect.fBottom = dstRect.top() + radius;
-        upperSrcRect.fTop = srcRect.bottom() - radius;
-        upperDstRect.fTop = dstRect.bottom() - radius;
-        middleSrcRect.inset(0, radius);
-        middleDstRect.inset(0, radius);
-    }
-    if (middleSrcRect.width() <= 0) {
+        lowerSrcRect.fBottom = srcRect.top() + reach;
+        lowerDstRect.fBottom = dstRect.top() + reach;
+        upperSrcRect.fTop = srcRect.bottom() - reach;
+        upperDstRect.fTop = dstRect.bottom() - reach;
+        middleSrcRect.inset(0, reach);
+        middleDstRect.inset(0, reach);
+    }
+    if (middleSrcRect.width() <= 0 || middleSrcRect.height() <= 0) {
         // radius covers srcRect; use bounds over entire draw
         apply_morphology_rect(renderTargetContext, clip, std::move(textureProxy),
-                              srcRect, dstRect, radius, morphType, bounds, direction);
+                              srcRect, dstRect, radius, step, morphType, bounds, direction);
     } else {
         // Draw upper and lower margins with bounds; middle without.
         apply_morphology_rect(renderTargetContext, clip, textureProxy,
-                              lowerSrcRect, lowerDstRect, radius, morphType, bounds, direction);
+                              lowerSrcRect, lowerDstRect, radius, step, morphType, bounds,
+                              direction);
         apply_morphology_rect(renderTargetContext, clip, textureProxy,
-                              upperSrcRect, upperDstRect, radius, morphType, bounds, direction);
+                              upperSrcRect, upperDstRect, radius, step, morphType, bounds,
+                              direction);
         apply_morphology_rect_no_bounds(renderTargetContext, clip, std::move(textureProxy),
-                                        middleSrcRect, middleDstRect, radius, morphType, direction);
+                                        middleSrcRect, middleDstRect, radius, step, morphType,
+                                        direction);
+    }
+}
+
+// Radii up to this are drawn with a single pass that reads every texel in the kernel.
+static constexpr int kMaxContiguousMorphologyRadius = 8;
+
+// Applies the morphology along one direction, leaving the result in the returned render target
+// context. Larger radii start with a contiguous pass of kMaxContiguousMorphologyRadius and then
+// add three-tap passes whose step is as wide as the kernel covered so far, so the kernel (nearly)
+// triples with each pass and the number of texel reads grows with log(radius) instead of radius.
+static sk_sp<GrRenderTargetContext> apply_morphology_direction(
+                                                     GrContext* context,
+                                                     const GrClip& clip,
+                                                     sk_sp<GrTextureProxy> srcTexture,
+                                                     SkIRect srcRect,
+                                                     const SkIRect& dstRect,
+                                                     int radius,
+                                                     GrMorphologyEffect::Type morphType,
+                                                     GrMorphologyEffect::Direction direction,
+                                                     const GrBackendFormat& format,
+                                                     GrPixelConfig config,
+                                                     sk_sp<SkColorSpace> colorSpace) {
+    sk_sp<GrRenderTargetContext> dstRTContext;
+    int covered = 0;
+    while (covered < radius) {
+        int passRadius, step;
+        if (covered == 0) {
+            passRadius = SkTMin(radius, kMaxContiguousMorphologyRadius);
+            step = 1;
+        } else {
+            passRadius = 1;
+            step = SkTMin(2 * covered + 1, radius - covered);
+        }
+
+        dstRTContext = context->contextPriv().makeDeferredRenderTargetContext(
+                format, SkBackingFit::kApprox, dstRect.width(), dstRect.height(), config,
+                colorSpace);
+        if (!dstRTContext) {
+            return nullptr;
+        }
+        apply_morphology_pass(dstRTContext.get(), clip, std::move(srcTexture), srcRect, dstRect,
+                              passRadius, step, morphType, direction);
+
+        covered += passRadius * step;
+        srcTexture = dstRTContext->asTextureProxyRef();
+        srcRect = dstRect;
     }
+    return dstRTContext;
 }
 
 static sk_sp<SkSpecialImage> apply_morphology(
@@ -485,14 +558,14 @@ static sk_sp<SkSpecialImage> apply_morphology(
 
     if (radius.fWidth > 0) {
         sk_sp<GrRenderTargetContext> dstRTContext(
-            context->contextPriv().makeDeferredRenderTargetContext(
-                format, SkBackingFit::kApprox, rect.width(), rect.height(), config, colorSpace));
+            apply_morphology_direction(context, clip, std::move(srcTexture), srcRect, dstRect,
+                                       radius.fWidth, morphType,
+                                       GrMorphologyEffect::Direction::kX, format, config,
+                                       colorSpace));
         if (!dstRTContext) {
             return nullptr;
         }
 
-        apply_morphology_pass(dstRTContext.get(), clip, std::move(srcTexture), srcRect, dstRect,
-                              radius.fWidth, morphType, GrMorphologyEffect::Direction::kX);
         SkIRect clearRect = SkIRect::MakeXYWH(dstRect.fLeft, dstRect.fBottom,
                                               dstRect.width(), radius.fHeight);
         SkPMColor4f clearColor = GrMorphologyEffect::Type::kErode == morphType
@@ -504,15 +577,14 @@ static sk_sp<SkSpecialImage> apply_morphology(
     }
     if (radius.fHeight > 0) {
         sk_sp<GrRenderTargetContext> dstRTContext(
-            context->contextPriv().makeDeferredRenderTargetContext(
-                format, SkBackingFit::kApprox, rect.width(), rect.height(), config, colorSpace));
+            apply_morphology_direction(context, clip, std::move(srcTexture), srcRect, dstRect,
+                                       radius.fHeight, morphType,
+                                       GrMorphologyEffect::Direction::kY, format, config,
+                                       colorSpace));
         if (!dstRTContext) {
             return nullptr;
         }
 
-        apply_morphology_pass(dstRTContext.get(), clip, std::move(srcTexture), srcRect, dstRect,
-                              radius.fHeight, morphType, GrMorphologyEffect::Direction::kY);
-
         srcTexture = dstRTContext->asTextureProxyRef();
     }
 
@@ -528,72 +600,41 @@ namespace {
     enum MorphType { kDilate, kErode };
     enum class MorphDirection { kX, kY };
 
-#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
-    template<MorphType type, MorphDirection direction>
-    static void morph(const SkPMColor* src, SkPMColor* dst,
-                      int radius, int width, int height, int srcStride, int dstStride) {
-        const int srcStrideX = direction == MorphDirection::kX ? 1 : srcStride;
-        const int dstStrideX = direction == MorphDirection::kX ? 1 : dstStride;
-        const int srcStrideY = direction == MorphDirection::kX ? srcStride : 1;
-        const int dstStrideY = direction == MorphDirection::kX ? dstStride : 1;
-        radius = SkMin32(radius, width - 1);
-        const SkPMColor* upperSrc = src + radius * srcStrideX;
-        for (int x = 0; x < width; ++x) {
-            const SkPMColor* lp = src;
-            const SkPMColor* up = upperSrc;
-            SkPMColor* dptr = dst;
-            for (int y = 0; y < height; ++y) {
-                __m128i extreme = (type == kDilate) ? _mm_setzero_si128()
-                                                    : _mm_set1_epi32(0xFFFFFFFF);
-                for (const SkPMColor* p = lp; p <= up; p += srcStrideX) {
-                    __m128i src_pixel = _mm_cvtsi32_si128(*p);
-                    extreme = (type == kDilate) ? _mm_max_epu8(src_pixel, extreme)
-                                                : _mm_min_epu8(src_pixel, extreme);
-                }
-                *dptr = _mm_cvtsi128_si32(extreme);
-                dptr += dstStrideY;
-                lp += srcStrideY;
-                up += srcStrideY;
-            }
-            if (x >= radius) { src += srcStrideX; }
-            if (x + radius < width - 1) { upperSrc += srcStrideX; }
-            dst += dstStrideX;
+    // Each Sk16b holds the same pixel from up to four adjacent lines, so that we filter four
+    // lines at once.  Along Y those lines are adjacent columns and load as one vector.
+    static inline Sk16b load_lines(const SkPMColor* src, int lineStride, int lines) {
+        if (lines == 4 && lineStride == 1) {
+            return Sk16b::Load(src);
         }
+        uint32_t px[4] = { 0, 0, 0, 0 };
+        for (int k = 0; k < lines; ++k) {
+            px[k] = src[k * lineStride];
+        }
+        return Sk16b::Load(px);
     }
 
-#elif defined(SK_ARM_HAS_NEON)
-    template<MorphType type, MorphDirection direction>
-    static void morph(const SkPMColor* src, SkPMColor* dst,
-                      int radius, int width, int height, int srcStride, int dstStride) {
-        const int srcStrideX = direction == MorphDirection::kX ? 1 : srcStride;
-        const int dstStrideX = direction == MorphDirection::kX ? 1 : dstStride;
-        const int srcStrideY = direction == MorphDirection::kX ? srcStride : 1;
-        const int dstStrideY = direction == MorphDirection::kX ? dstStride : 1;
-        radius = SkMin32(radius, width - 1);
-        const SkPMColor* upperSrc = src + radius * srcStrideX;
-        for (int x = 0; x < width; ++x) {
-            const SkPMColor* lp = src;
-            const SkPMColor* up = upperSrc;
-            SkPMColor* dptr = dst;
-            for (int y = 0; y < height; ++y) {
-                uint8x8_t extreme = vdup_n_u8(type == kDilate ? 0 : 255);
-                for (const SkPMColor* p = lp; p <= up; p += srcStrideX) {
-                    uint8x8_t src_pixel = vreinterpret_u8_u32(vdup_n_u32(*p));
-                    extreme = (type == kDilate) ? vmax_u8(src_pixel, extreme)
-                                                : vmin_u8(src_pixel, extreme);
-                }
-                *dptr = vget_lane_u32(vreinterpret_u32_u8(extreme), 0);
-                dptr += dstStrideY;
-                lp += srcStrideY;
-                up += srcStrideY;
-            }
-            if (x >= radius) src += srcStrideX;
-            if (x + radius < width - 1) upperSrc += srcStrideX;
-            dst += dstStrideX;
+    static inline void store_lines(const Sk16b& v, SkPMColor* dst, int lineStride, int lines) {
+        if (lines == 4 && lineStride == 1) {
+            v.store(dst);
+            return;
+        }
+        uint32_t px[4];
+        v.store(px);
+        for (int k = 0; k < lines; ++k) {
+            dst[k * lineStride] = px[k];
         }
     }
 
-#else
+    template<MorphType type>
+    static inline Sk16b extreme(const Sk16b& a, const Sk16b& b) {
+        return type == kDilate ? Sk16b::Max(a, b) : Sk16b::Min(a, b);
+    }
+
+    // van Herk/Gil-Werman: pad each line with radius identity pixels on both ends (which is the
+    // same as clamping the window to the line) and split it into blocks of the window size,
+    // 2*radius+1.  Any window then covers the tail of one block and the head of the next, so it
+    // is the extreme of one block suffix and one block prefix.  That costs three min/max per
+    // pixel whatever the radius.
     template<MorphType type, MorphDirection direction>
     static void morph(const SkPMColor* src, SkPMColor* dst,
                       int radius, int width, int height, int srcStride, int dstStride) {
@@ -602,43 +643,51 @@ namespace {
         const int srcStrideY = direction == MorphDirection::kX ? srcStride : 1;
         const int dstStrideY = direction == MorphDirection::kX ? dstStride : 1;
         radius = SkMin32(radius, width - 1);
-        const SkPMColor* upperSrc = src + radius * srcStrideX;
-        for (int x = 0; x < width; ++x) {
-            const SkPMColor* lp = src;
-            const SkPMColor* up = upperSrc;
-            SkPMColor* dptr = dst;
-            for (int y = 0; y < height; ++y) {
-                // If we're maxing (dilate), start from 0; if minning (erode), start from 255.
-                const int start = (type == kDilate) ? 0 : 255;
-                int B = start, G = start, R = start, A = start;
-                for (const SkPMColor* p = lp; p <= up; p += srcStrideX) {
-                    int b = SkGetPackedB32(*p),
-                        g = SkGetPackedG32(*p),
-                        r = SkGetPackedR32(*p),
-                        a = SkGetPackedA32(*p);
-                    if (type == kDilate) {
-                        B = SkTMax(b, B);
-                        G = SkTMax(g, G);
-                        R = SkTMax(r, R);
-                        A = SkTMax(a, A);
-                    } else {
-                        B = SkTMin(b, B);
-                        G = SkTMin(g, G);
-                        R = SkTMin(r, R);
-                        A = SkTMin(a, A);
-                    }
+        const int window = 2 * radius + 1,
+                  padded = width + 2 * radius;
+        const Sk16b identity(type == kDilate ? 0 : 255);
+
+        // Block prefixes and suffixes of the padded line, as 4 pixels (16 bytes) per entry.
+        SkAutoTMalloc<uint32_t> storage(8 * padded);
+        uint32_t* prefix = storage.get();
+        uint32_t* suffix = prefix + 4 * padded;
+
+        for (int y = 0; y < height; y += 4) {
+            const int lines = SkMin32(4, height - y);
+
+            Sk16b run = identity;
+            for (int i = 0, inBlock = 0; i < padded; ++i) {
+                const int x = i - radius;
+                Sk16b v = (x >= 0 && x < width) ? load_lines(src + x * srcStrideX, srcStrideY, lines)
+                                                : identity;
+                run = (inBlock == 0) ? v : extreme<type>(run, v);
+                run.store(prefix + 4 * i);
+                v.store(suffix + 4 * i);
+                if (++inBlock == window) {
+                    inBlock = 0;
+                }
+            }
+
+            run = identity;
+            for (int i = padded - 1, inBlock = (padded - 1) % window; i >= 0; --i) {
+                Sk16b v = Sk16b::Load(suffix + 4 * i);
+                run = (inBlock == window - 1 || i == padded - 1) ? v : extreme<type>(run, v);
+                run.store(suffix + 4 * i);
+                if (--inBlock < 0) {
+                    inBlock = window - 1;
                 }
-                *dptr = SkPackARGB32(A, R, G, B);
-                dptr += dstStrideY;
-                lp += srcStrideY;
-                up += srcStrideY;
             }
-            if (x >= radius) { src += srcStrideX; }
-            if (x + radius < width - 1) { upperSrc += srcStrideX; }
-            dst += dstStrideX;
+
+            for (int x = 0; x < width; ++x) {
+                Sk16b v = extreme<type>(Sk16b::Load(suffix + 4 * x),
+                                        Sk16b::Load(prefix + 4 * (x + 2 * radius)));
+                store_lines(v, dst + x * dstStrideX, dstStrideY, lines);
+            }
+
+            src += 4 * srcStrideY;
+            dst += 4 * dstStrideY;
         }
     }
-#endif
 }  // namespace
 
 sk_sp<SkSpecialImage> SkMorphologyImageFilter::onFilterImage(SkSpecialImage* source,
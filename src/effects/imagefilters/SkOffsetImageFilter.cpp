@@ -6,6 +6,7 @@
  */
 
 #include "SkOffsetImageFilter.h"
+#include "SkColorFilterImageFilter.h"
 #include "SkColorSpaceXformer.h"
 #include "SkCanvas.h"
 #include "SkImageFilterPriv.h"
@@ -79,6 +80,17 @@ sk_sp<SkSpecialImage> SkOffsetImageFilter::onFilterImage(SkSpecialImage* source,
     }
 }
 
+sk_sp<SkImageFilter> SkOffsetImageFilter::onMakeWithColorFilter(sk_sp<SkColorFilter> cf) const {
+    if (this->cropRectIsSet()) {
+        return nullptr;
+    }
+    // A color filter that leaves transparent black alone commutes with a translation, so move it
+    // below the offset, where it may fold into our input.
+    return SkOffsetImageFilter::Make(fOffset.fX, fOffset.fY,
+                                     SkColorFilterImageFilter::Make(std::move(cf),
+                                                                    sk_ref_sp(this->getInput(0))));
+}
+
 sk_sp<SkImageFilter> SkOffsetImageFilter::onMakeColorSpace(SkColorSpaceXformer* xformer) const {
     SkASSERT(1 == this->countInputs());
 
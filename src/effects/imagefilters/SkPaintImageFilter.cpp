@@ -80,6 +80,24 @@ sk_sp<SkImageFilter> SkPaintImageFilter::onMakeColorSpace(SkColorSpaceXformer* x
     return this->refMe();
 }
 
+sk_sp<SkImageFilter> SkPaintImageFilter::onMakeWithColorFilter(sk_sp<SkColorFilter> cf) const {
+    // We draw into a transparent surface, so as long as the paint covers every pixel it touches
+    // and writes its color unchanged, filtering that color in the paint gives the same result.
+    if (fPaint.isAntiAlias() || fPaint.getMaskFilter() || fPaint.getImageFilter() ||
+        fPaint.getDrawLooper() ||
+        (fPaint.getBlendMode() != SkBlendMode::kSrcOver &&
+         fPaint.getBlendMode() != SkBlendMode::kSrc)) {
+        return nullptr;
+    }
+    SkPaint paint(fPaint);
+    paint.setColorFilter(fPaint.getColorFilter() ? cf->makeComposed(fPaint.refColorFilter())
+                                                 : std::move(cf));
+    if (!paint.getColorFilter()) {
+        return nullptr;
+    }
+    return SkPaintImageFilter::Make(paint, this->getCropRectIfSet());
+}
+
 bool SkPaintImageFilter::affectsTransparentBlack() const {
     return true;
 }
@@ -25,6 +25,7 @@
 #include "GrResourceProviderPriv.h"
 #include "GrTexture.h"
 #include "GrTextureProxy.h"
+#include "SkImage.h"
 #include "SkMessageBus.h"
 #include "gl/GrGLDefines.h"
 #include "gl/GrGLTypes.h"
@@ -651,10 +652,34 @@ sk_sp<GrTextureProxy> GrAHardwareBufferImageGenerator::onGenerateTexture(
 
 bool GrAHardwareBufferImageGenerator::onIsValid(GrContext* context) const {
     if (nullptr == context) {
-        return false; //CPU backend is not supported, because hardware buffer can be swizzled
+        // The CPU backend maps the buffer, so it needs a CPU-readable buffer.  The GPU may have
+        // swizzled any other kind.
+        return this->canMapPixels();
     }
     return GrBackendApi::kOpenGL == context->backend() ||
            GrBackendApi::kVulkan == context->backend();
 }
 
+bool GrAHardwareBufferImageGenerator::canMapPixels() const {
+    // Locked buffers are always top-down in memory.
+    if (kTopLeft_GrSurfaceOrigin != fSurfaceOrigin) {
+        return false;
+    }
+    AHardwareBuffer_Desc bufferDesc;
+    AHardwareBuffer_describe(fHardwareBuffer, &bufferDesc);
+    return 0 != (bufferDesc.usage & AHARDWAREBUFFER_USAGE_CPU_READ_MASK);
+}
+
+bool GrAHardwareBufferImageGenerator::onGetPixels(const SkImageInfo& info, void* pixels,
+                                                  size_t rowBytes, const Options&) {
+    if (!this->canMapPixels()) {
+        return false;
+    }
+    const SkImageInfo& bufferInfo = this->getInfo();
+    sk_sp<SkImage> mapped = SkImage::MakeRasterFromAHardwareBuffer(fHardwareBuffer,
+                                                                   bufferInfo.alphaType(),
+                                                                   bufferInfo.refColorSpace());
+    return mapped && mapped->readPixels(info, pixels, rowBytes, 0, 0);
+}
+
 #endif //SK_BUILD_FOR_ANDROID_FRAMEWORK
@@ -27,6 +27,8 @@ extern "C" {
  *  contexts.
  *  To implement certain features like tiling, Skia may copy the texture to
  *  avoid OpenGL API limitations.
+ *  Buffers that also have a CPU_READ usage can be drawn without a GPU context;
+ *  their pixels are read by locking the buffer.
  */
 class GrAHardwareBufferImageGenerator : public SkImageGenerator {
 public:
@@ -48,6 +50,9 @@ protected:
 
     bool onIsValid(GrContext*) const override;
 
+    // Reads CPU-readable buffers by locking them, for raster consumers.
+    bool onGetPixels(const SkImageInfo&, void* pixels, size_t rowBytes, const Options&) override;
+
     TexGenType onCanGenerateTexture() const override { return TexGenType::kCheap; }
     sk_sp<GrTextureProxy> onGenerateTexture(GrContext*, const SkImageInfo&, const SkIPoint&,
                                             bool willNeedMipMaps) override;
@@ -60,6 +65,8 @@ private:
 
     void releaseTextureRef();
 
+    bool canMapPixels() const;
+
     static void ReleaseRefHelper_TextureReleaseProc(void* ctx);
 
     AHardwareBuffer* fHardwareBuffer;
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrAsyncReadbackManager.h"
+
+#include "GrGpu.h"
+#include "SkAutoPixmapStorage.h"
+
+static void deliver(const GrAsyncReadbackManager::Read& read) {
+    const void* data = read.fBuffer->map();
+    if (!data) {
+        read.fCallback(read.fContext, nullptr, 0);
+        return;
+    }
+
+    SkPixmap pixels(read.fBufferInfo, data, read.fBufferInfo.minRowBytes());
+    SkAutoPixmapStorage flipped;
+    if (read.fFlip) {
+        flipped.alloc(read.fBufferInfo);
+        size_t trimRowBytes = read.fBufferInfo.minRowBytes();
+        int height = read.fBufferInfo.height();
+        for (int y = 0; y < height; ++y) {
+            memcpy(flipped.writable_addr(0, y), pixels.addr(0, height - 1 - y), trimRowBytes);
+        }
+        pixels = flipped;
+    }
+
+    SkAutoPixmapStorage converted;
+    if (read.fDstInfo != read.fBufferInfo) {
+        if (!converted.tryAlloc(read.fDstInfo) || !pixels.readPixels(converted)) {
+            read.fBuffer->unmap();
+            read.fCallback(read.fContext, nullptr, 0);
+            return;
+        }
+        pixels = converted;
+    }
+
+    read.fCallback(read.fContext, pixels.addr(), pixels.rowBytes());
+    read.fBuffer->unmap();
+}
+
+void GrAsyncReadbackManager::process(GrGpu* gpu) {
+    // The callbacks may start more reads, so each read leaves the queue before it's delivered.
+    while (!fReads.empty() && gpu->waitFence(fReads.front().fFence, 0)) {
+        Read read = std::move(fReads.front());
+        fReads.pop_front();
+        gpu->deleteFence(read.fFence);
+        deliver(read);
+    }
+}
+
+void GrAsyncReadbackManager::failAll(GrGpu* gpu, bool deleteFences) {
+    while (!fReads.empty()) {
+        Read read = std::move(fReads.front());
+        fReads.pop_front();
+        if (deleteFences) {
+            gpu->deleteFence(read.fFence);
+        }
+        read.fCallback(read.fContext, nullptr, 0);
+    }
+}
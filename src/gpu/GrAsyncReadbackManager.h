@@ -0,0 +1,63 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrAsyncReadbackManager_DEFINED
+#define GrAsyncReadbackManager_DEFINED
+
+#include "GrBuffer.h"
+#include "GrTypes.h"
+#include "SkImageInfo.h"
+#include "SkRefCnt.h"
+
+#include <deque>
+
+class GrGpu;
+
+/**
+ * Tracks reads that GrGpu::transferPixelsFrom has started into transfer buffers. Each read waits
+ * on a fence inserted after its transfer. Once the fence signals, the buffer is mapped, flipped
+ * and converted to the requested SkImageInfo if needed, and handed to the read's callback.
+ */
+class GrAsyncReadbackManager {
+public:
+    typedef void (*Callback)(void* context, const void* data, size_t rowBytes);
+
+    struct Read {
+        sk_sp<GrBuffer> fBuffer;
+        GrFence         fFence;
+        // Describes the tightly packed pixels the transfer wrote into fBuffer.
+        SkImageInfo     fBufferInfo;
+        // True if the rows in fBuffer are bottom first.
+        bool            fFlip;
+        SkImageInfo     fDstInfo;
+        Callback        fCallback;
+        void*           fContext;
+    };
+
+    ~GrAsyncReadbackManager() { SkASSERT(fReads.empty()); }
+
+    void add(Read&& read) { fReads.push_back(std::move(read)); }
+
+    bool empty() const { return fReads.empty(); }
+
+    /**
+     * Delivers each read whose fence has signaled, without blocking. Reads finish in the order
+     * they were added, so this stops at the first that is still in flight.
+     */
+    void process(GrGpu*);
+
+    /**
+     * Calls back with null data for every pending read. The fences are only deleted if
+     * deleteFences is true, i.e. the 3D context is still usable.
+     */
+    void failAll(GrGpu*, bool deleteFences);
+
+private:
+    std::deque<Read> fReads;
+};
+
+#endif
@@ -23,7 +23,7 @@
 #include "gl/GrGLTexture.h"
 
 GrBackendTextureImageGenerator::RefHelper::~RefHelper() {
-    SkASSERT(nullptr == fBorrowedTexture);
+    SkASSERT(fBorrows.empty());
 
     // Generator has been freed, and no one is borrowing the texture. Notify the original cache
     // that it can free the last ref, so it happens on the correct thread.
@@ -79,13 +79,50 @@ GrBackendTextureImageGenerator::~GrBackendTextureImageGenerator() {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+GrBackendTextureImageGenerator::RefHelper::Borrow*
+GrBackendTextureImageGenerator::RefHelper::findBorrow(uint32_t contextID) {
+    for (Borrow& borrow : fBorrows) {
+        if (borrow.fContextID == contextID) {
+            return &borrow;
+        }
+    }
+    return nullptr;
+}
+
+void GrBackendTextureImageGenerator::RefHelper::removeBorrow(uint32_t contextID) {
+    for (int i = 0; i < fBorrows.count(); ++i) {
+        if (fBorrows[i].fContextID == contextID) {
+            fBorrows.removeShuffle(i);
+            return;
+        }
+    }
+    SkDEBUGFAIL("Releasing a texture that was never borrowed.");
+}
+
+namespace {
+// Passed to the release proc of each borrowing context's wrapped texture.
+struct BorrowReleaseContext {
+    void*    fRefHelper;
+    uint32_t fContextID;
+};
+}  // anonymous namespace
+
+// GL sync objects may be waited on by any number of contexts. A Vulkan semaphore can only be
+// waited on once, so there the texture is only lent to one context at a time.
+static bool supports_shared_borrows(GrBackendApi api) {
+    return GrBackendApi::kOpenGL == api || GrBackendApi::kMock == api;
+}
+
 void GrBackendTextureImageGenerator::ReleaseRefHelper_TextureReleaseProc(void* ctx) {
-    RefHelper* refHelper = static_cast<RefHelper*>(ctx);
+    BorrowReleaseContext* releaseContext = static_cast<BorrowReleaseContext*>(ctx);
+    RefHelper* refHelper = static_cast<RefHelper*>(releaseContext->fRefHelper);
     SkASSERT(refHelper);
 
-    refHelper->fBorrowedTexture = nullptr;
-    refHelper->fBorrowingContextReleaseProc = nullptr;
-    refHelper->fBorrowingContextID = SK_InvalidGenID;
+    refHelper->fBorrowingMutex.acquire();
+    refHelper->removeBorrow(releaseContext->fContextID);
+    refHelper->fBorrowingMutex.release();
+
+    delete releaseContext;
     refHelper->unref();
 }
 
@@ -101,31 +138,29 @@ sk_sp<GrTextureProxy> GrBackendTextureImageGenerator::onGenerateTexture(
     }
 
     auto proxyProvider = context->contextPriv().proxyProvider();
+    const uint32_t contextID = context->contextPriv().contextID();
 
-    fBorrowingMutex.acquire();
+    RefHelper* refHelper = fRefHelper;
+    refHelper->fBorrowingMutex.acquire();
     sk_sp<GrReleaseProcHelper> releaseProcHelper;
-    if (SK_InvalidGenID != fRefHelper->fBorrowingContextID) {
-        if (fRefHelper->fBorrowingContextID != context->contextPriv().contextID()) {
-            fBorrowingMutex.release();
-            return nullptr;
-        } else {
-            SkASSERT(fRefHelper->fBorrowingContextReleaseProc);
-            // Ref the release proc to be held by the proxy we make below
-            releaseProcHelper = sk_ref_sp(fRefHelper->fBorrowingContextReleaseProc);
-        }
+    if (RefHelper::Borrow* borrow = refHelper->findBorrow(contextID)) {
+        SkASSERT(borrow->fReleaseProc);
+        // Ref the release proc to be held by the proxy we make below
+        releaseProcHelper = sk_ref_sp(borrow->fReleaseProc);
+    } else if (!refHelper->fBorrows.empty() &&
+               !supports_shared_borrows(fBackendTexture.backend())) {
+        refHelper->fBorrowingMutex.release();
+        return nullptr;
     } else {
-        SkASSERT(!fRefHelper->fBorrowingContextReleaseProc);
-        // The ref we add to fRefHelper here will be passed into and owned by the
+        // The ref we add to refHelper here will be passed into and owned by the
         // GrReleaseProcHelper.
-        fRefHelper->ref();
+        refHelper->ref();
         releaseProcHelper.reset(new GrReleaseProcHelper(ReleaseRefHelper_TextureReleaseProc,
-                                                        fRefHelper));
-        fRefHelper->fBorrowingContextReleaseProc = releaseProcHelper.get();
+                                                        new BorrowReleaseContext{refHelper,
+                                                                                 contextID}));
+        refHelper->fBorrows.push_back({contextID, nullptr, releaseProcHelper.get()});
     }
-    fRefHelper->fBorrowingContextID = context->contextPriv().contextID();
-    fBorrowingMutex.release();
-
-    SkASSERT(fRefHelper->fBorrowingContextID == context->contextPriv().contextID());
+    refHelper->fBorrowingMutex.release();
 
     GrSurfaceDesc desc;
     desc.fWidth = fBackendTexture.width();
@@ -137,14 +172,13 @@ sk_sp<GrTextureProxy> GrBackendTextureImageGenerator::onGenerateTexture(
     // be deleted before we actuallly execute the lambda.
     sk_sp<GrSemaphore> semaphore = fSemaphore;
     GrBackendTexture backendTexture = fBackendTexture;
-    RefHelper* refHelper = fRefHelper;
 
     GrBackendFormat format = backendTexture.getBackendFormat();
     SkASSERT(format.isValid());
 
     sk_sp<GrTextureProxy> proxy = proxyProvider->createLazyProxy(
-            [refHelper, releaseProcHelper, semaphore,
-             backendTexture](GrResourceProvider* resourceProvider) {
+            [refHelper, releaseProcHelper, semaphore, backendTexture,
+             contextID](GrResourceProvider* resourceProvider) {
                 if (!resourceProvider) {
                     return sk_sp<GrTexture>();
                 }
@@ -153,14 +187,18 @@ sk_sp<GrTextureProxy> GrBackendTextureImageGenerator::onGenerateTexture(
                     resourceProvider->priv().gpu()->waitSemaphore(semaphore);
                 }
 
-                sk_sp<GrTexture> tex;
-                if (refHelper->fBorrowedTexture) {
+                // Our proxy holds a ref on the release proc, so this context's Borrow stays put.
+                refHelper->fBorrowingMutex.acquire();
+                RefHelper::Borrow* borrow = refHelper->findBorrow(contextID);
+                SkASSERT(borrow);
+                sk_sp<GrTexture> tex = sk_ref_sp(borrow->fBorrowedTexture);
+                refHelper->fBorrowingMutex.release();
+
+                if (tex) {
                     // If a client re-draws the same image multiple times, the texture we return
                     // will be cached and re-used. If they draw a subset, though, we may be
                     // re-called. In that case, we want to re-use the borrowed texture we've
                     // previously created.
-                    tex = sk_ref_sp(refHelper->fBorrowedTexture);
-                    SkASSERT(tex);
                 } else {
                     // We just gained access to the texture. If we're on the original context, we
                     // could use the original texture, but we'd have no way of detecting that it's
@@ -175,7 +213,9 @@ sk_sp<GrTextureProxy> GrBackendTextureImageGenerator::onGenerateTexture(
                     if (!tex) {
                         return sk_sp<GrTexture>();
                     }
-                    refHelper->fBorrowedTexture = tex.get();
+                    refHelper->fBorrowingMutex.acquire();
+                    refHelper->findBorrow(contextID)->fBorrowedTexture = tex.get();
+                    refHelper->fBorrowingMutex.release();
 
                     tex->setRelease(releaseProcHelper);
                 }
@@ -11,20 +11,24 @@
 
 #include "GrBackendSurface.h"
 #include "SkMutex.h"
+#include "SkTArray.h"
 
 class GrSemaphore;
 
 /*
  * This ImageGenerator is used to wrap a texture in one GrContext and can then be used as a source
- * in another GrContext. It holds onto a semaphore which the producing GrContext will signal and the
- * consuming GrContext will wait on before using the texture. Only one GrContext can ever be used
- * as a consumer (this is mostly because Vulkan can't allow multiple things to wait on the same
- * semaphore).
+ * in other GrContexts. It holds onto a semaphore which the producing GrContext will signal and the
+ * consuming GrContexts will wait on before using the texture.
  *
  * In practice, this capability is used by clients to create backend-specific texture resources in
- * one thread (with, say, GrContext-A) and then ship them over to another GrContext (say,
- * GrContext-B) which will then use the texture as a source for draws. GrContext-A uses the
- * semaphore to notify GrContext-B when the shared texture is ready to use.
+ * one thread (with, say, GrContext-A) and then ship them over to other GrContexts (say,
+ * GrContext-B and GrContext-C) which will then use the texture as a source for draws. GrContext-A
+ * uses the semaphore to notify the consumers when the shared texture is ready to use.
+ *
+ * Where the backend's semaphores can be waited on more than once (GL sync objects), any number of
+ * consuming GrContexts can borrow the texture at the same time, each wrapping it once and waiting
+ * on the semaphore itself. Otherwise (Vulkan can't allow multiple things to wait on the same
+ * semaphore) only one GrContext can borrow the texture at a time.
  */
 class GrBackendTextureImageGenerator : public SkImageGenerator {
 public:
@@ -54,34 +58,39 @@ private:
     public:
         RefHelper(GrTexture* texture, uint32_t owningContextID)
             : fOriginalTexture(texture)
-            , fOwningContextID(owningContextID)
-            , fBorrowedTexture(nullptr)
-            , fBorrowingContextReleaseProc(nullptr)
-            , fBorrowingContextID(SK_InvalidGenID) {}
+            , fOwningContextID(owningContextID) {}
 
         ~RefHelper();
 
+        // One of these exists for each GrContext currently borrowing the texture.
+        struct Borrow {
+            uint32_t             fContextID;
+            // There is never a ref associated with this pointer. We rely on our bookkeeping with
+            // the context ID to know when this pointer is valid and safe to use. This lets us
+            // avoid releasing a ref from another thread, or get into races during context
+            // shutdown.
+            GrTexture*           fBorrowedTexture;
+            // For the same reason as the fBorrowedTexture, there is no ref associated with this
+            // pointer. The release proc is used to make sure all uses of the wrapped texture are
+            // finished on the borrowing context before its Borrow is removed. In general a ref to
+            // this release proc is owned by all proxies and gpu uses of the backend texture.
+            GrReleaseProcHelper* fReleaseProc;
+        };
+
+        // These must be called with fBorrowingMutex held.
+        Borrow* findBorrow(uint32_t contextID);
+        void removeBorrow(uint32_t contextID);
+
         GrTexture*          fOriginalTexture;
         uint32_t            fOwningContextID;
 
-        // There is never a ref associated with this pointer. We rely on our atomic bookkeeping
-        // with the context ID to know when this pointer is valid and safe to use. This lets us
-        // avoid releasing a ref from another thread, or get into races during context shutdown.
-        GrTexture*           fBorrowedTexture;
-        // For the same reason as the fBorrowedTexture, there is no ref associated with this
-        // pointer. The fBorrowingContextReleaseProc is used to make sure all uses of the wrapped
-        // texture are finished on the borrowing context before we open this back up to other
-        // contexts. In general a ref to this release proc is owned by all proxies and gpu uses of
-        // the backend texture.
-        GrReleaseProcHelper* fBorrowingContextReleaseProc;
-        uint32_t             fBorrowingContextID;
+        // This Mutex guards fBorrows. It lives here rather than in the generator because the
+        // borrowing contexts' release procs may run after the generator has been deleted.
+        SkMutex             fBorrowingMutex;
+        SkSTArray<1, Borrow, true> fBorrows;
     };
 
     RefHelper*           fRefHelper;
-    // This Mutex is used to guard the borrowing of the texture to one GrContext at a time as well
-    // as the creation of the fBorrowingContextReleaseProc. The latter happening if two threads with
-    // the same consuming GrContext try to generate a texture at the same time.
-    SkMutex              fBorrowingMutex;
 
     sk_sp<GrSemaphore>   fSemaphore;
 
@@ -99,6 +99,27 @@ sk_sp<GrTextureProxy> GrBitmapTextureMaker::refOriginalTextureProxy(bool willBeM
     return nullptr;
 }
 
+sk_sp<GrTextureProxy> GrBitmapTextureMaker::refCachedOriginalTextureProxy(bool willBeMipped) {
+    if (!fOriginalKey.isValid()) {
+        return nullptr;
+    }
+    GrProxyProvider* proxyProvider = this->context()->contextPriv().proxyProvider();
+    auto proxy = proxyProvider->findOrCreateProxyByUniqueKey(fOriginalKey,
+                                                             kTopLeft_GrSurfaceOrigin);
+    if (proxy && (!willBeMipped || GrMipMapped::kYes == proxy->mipMapped())) {
+        return proxy;
+    }
+    return nullptr;
+}
+
+bool GrBitmapTextureMaker::getDownscaleSourcePixels(SkBitmap* bitmap) {
+    if (!fOriginalKey.isValid() || !fBitmap.getPixels()) {
+        return false;
+    }
+    *bitmap = fBitmap;
+    return true;
+}
+
 void GrBitmapTextureMaker::makeCopyKey(const CopyParams& copyParams, GrUniqueKey* copyKey) {
     // Destination color space is irrelevant - we always upload the bitmap's contents as-is
     if (fOriginalKey.isValid()) {
@@ -21,6 +21,8 @@ public:
 protected:
     sk_sp<GrTextureProxy> refOriginalTextureProxy(bool willBeMipped,
                                                   AllowedTexGenType onlyIfFast) override;
+    sk_sp<GrTextureProxy> refCachedOriginalTextureProxy(bool willBeMipped) override;
+    bool getDownscaleSourcePixels(SkBitmap*) override;
 
     void makeCopyKey(const CopyParams& copyParams, GrUniqueKey* copyKey) override;
     void didCacheCopy(const GrUniqueKey& copyKey, uint32_t contextUniqueID) override;
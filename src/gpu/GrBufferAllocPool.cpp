@@ -32,12 +32,90 @@ do {
                          "percent_unwritten",                                             \
                          (float)((block).fBytesFree) / (block).fBuffer->gpuMemorySize()); \
     (block).fBuffer->unmap();                                                             \
+    fGpu->frameStats()->fBytesUploaded += (block).fBuffer->gpuMemorySize() -              \
+                                          (block).fBytesFree;                             \
 } while (false)
 
+constexpr int GrBufferRing::kMaxFencedBatches;
+constexpr int GrBufferRing::kMaxFreeBuffers;
+
+GrBufferRing::~GrBufferRing() {
+    // An abandoned context can no longer delete its fences.
+    bool abandoned = fGpu->getContext()->abandoned();
+    while (fFencedBatchCount) {
+        if (!abandoned) {
+            fGpu->deleteFence(fFencedBatches[fOldestBatch].fFence);
+        }
+        this->popOldestBatch(false);
+    }
+}
+
+void GrBufferRing::popOldestBatch(bool reuseBuffers) {
+    SkASSERT(fFencedBatchCount);
+    FencedBatch& batch = fFencedBatches[fOldestBatch];
+    if (reuseBuffers) {
+        for (sk_sp<GrBuffer>& buffer : batch.fBuffers) {
+            if (fFreeBuffers.count() < kMaxFreeBuffers) {
+                fFreeBuffers.push_back(std::move(buffer));
+            }
+        }
+    }
+    batch.fBuffers.reset();
+    fOldestBatch = (fOldestBatch + 1) % kMaxFencedBatches;
+    --fFencedBatchCount;
+}
+
+sk_sp<GrBuffer> GrBufferRing::getBuffer() {
+    // The GPU finishes the batches in the order they were fenced.
+    while (fFencedBatchCount && fGpu->waitFence(fFencedBatches[fOldestBatch].fFence, 0)) {
+        fGpu->deleteFence(fFencedBatches[fOldestBatch].fFence);
+        this->popOldestBatch(true);
+    }
+    while (!fFreeBuffers.empty()) {
+        sk_sp<GrBuffer> buffer = std::move(fFreeBuffers.back());
+        fFreeBuffers.pop_back();
+        if (!buffer->wasDestroyed()) {
+            return buffer;
+        }
+    }
+    auto resourceProvider = fGpu->getContext()->contextPriv().resourceProvider();
+    return resourceProvider->createBuffer(GrBufferAllocPool::kDefaultBufferSize, fBufferType,
+                                          kStream_GrAccessPattern,
+                                          GrResourceProvider::Flags::kNone);
+}
+
+void GrBufferRing::retire(sk_sp<GrBuffer> buffer) {
+    SkASSERT(buffer && !buffer->isMapped());
+    fRetiredBuffers.push_back(std::move(buffer));
+}
+
+void GrBufferRing::insertFence() {
+    if (fRetiredBuffers.empty()) {
+        return;
+    }
+    if (kMaxFencedBatches == fFencedBatchCount) {
+        // Rather than stall, let the oldest batch's buffers go. They are deleted once the GPU is
+        // done with them.
+        fGpu->deleteFence(fFencedBatches[fOldestBatch].fFence);
+        this->popOldestBatch(false);
+    }
+    FencedBatch& batch = fFencedBatches[(fOldestBatch + fFencedBatchCount) % kMaxFencedBatches];
+    batch.fFence = fGpu->insertFence();
+    batch.fBuffers.swap(fRetiredBuffers);
+    ++fFencedBatchCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 constexpr size_t GrBufferAllocPool::kDefaultBufferSize;
 
-GrBufferAllocPool::GrBufferAllocPool(GrGpu* gpu, GrBufferType bufferType, void* initialBuffer)
-        : fBlocks(8), fGpu(gpu), fBufferType(bufferType), fInitialCpuData(initialBuffer) {
+GrBufferAllocPool::GrBufferAllocPool(GrGpu* gpu, GrBufferType bufferType, void* initialBuffer,
+                                     GrBufferRing* ring)
+        : fBlocks(8)
+        , fGpu(gpu)
+        , fBufferType(bufferType)
+        , fRing(ring)
+        , fInitialCpuData(initialBuffer) {
     if (fInitialCpuData) {
         fCpuDataSize = kDefaultBufferSize;
         fCpuData = fInitialCpuData;
@@ -69,6 +147,9 @@ void GrBufferAllocPool::reset() {
     VALIDATE();
     fBytesInUse = 0;
     this->deleteBlocks();
+    if (fRing) {
+        fRing->insertFence();
+    }
     this->resetCpuData(0);
     VALIDATE();
 }
@@ -278,7 +359,8 @@ bool GrBufferAllocPool::createBlock(size_t requestSize) {
 
     BufferBlock& block = fBlocks.push_back();
 
-    block.fBuffer = this->getBuffer(size);
+    block.fFromRing = fRing && kDefaultBufferSize == size;
+    block.fBuffer = block.fFromRing ? fRing->getBuffer() : this->getBuffer(size);
     if (!block.fBuffer) {
         fBlocks.pop_back();
         return false;
@@ -298,10 +380,10 @@ bool GrBufferAllocPool::createBlock(size_t requestSize) {
 
     SkASSERT(!fBufferPtr);
 
-    // If the buffer is CPU-backed we map it because it is free to do so and saves a copy.
-    // Otherwise when buffer mapping is supported we map if the buffer size is greater than the
-    // threshold.
-    bool attemptMap = block.fBuffer->isCPUBacked();
+    // If the buffer is CPU-backed or persistently mapped we map it because it is free to do so and
+    // saves a copy. Otherwise when buffer mapping is supported we map if the buffer size is greater
+    // than the threshold.
+    bool attemptMap = block.fBuffer->isCPUBacked() || block.fFromRing;
     if (!attemptMap && GrCaps::kNone_MapFlags != fGpu->caps()->mapBufferFlags()) {
         attemptMap = size > fGpu->caps()->bufferMapThreshold();
     }
@@ -322,6 +404,9 @@ bool GrBufferAllocPool::createBlock(size_t requestSize) {
 void GrBufferAllocPool::destroyBlock() {
     SkASSERT(!fBlocks.empty());
     SkASSERT(!fBlocks.back().fBuffer->isMapped());
+    if (fBlocks.back().fFromRing) {
+        fRing->retire(std::move(fBlocks.back().fBuffer));
+    }
     fBlocks.pop_back();
     fBufferPtr = nullptr;
 }
@@ -362,6 +447,7 @@ void GrBufferAllocPool::flushCpuData(const BufferBlock& block, size_t flushSize)
         }
     }
     buffer->updateData(fBufferPtr, flushSize);
+    fGpu->frameStats()->fBytesUploaded += flushSize;
     VALIDATE(true);
 }
 
@@ -374,8 +460,9 @@ sk_sp<GrBuffer> GrBufferAllocPool::getBuffer(size_t size) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-GrVertexBufferAllocPool::GrVertexBufferAllocPool(GrGpu* gpu, void* initialCpuBuffer)
-        : GrBufferAllocPool(gpu, kVertex_GrBufferType, initialCpuBuffer) {}
+GrVertexBufferAllocPool::GrVertexBufferAllocPool(GrGpu* gpu, void* initialCpuBuffer,
+                                                 GrBufferRing* ring)
+        : GrBufferAllocPool(gpu, kVertex_GrBufferType, initialCpuBuffer, ring) {}
 
 void* GrVertexBufferAllocPool::makeSpace(size_t vertexSize,
                                          int vertexCount,
@@ -427,8 +514,9 @@ void* GrVertexBufferAllocPool::makeSpaceAtLeast(size_t vertexSize, int minVertex
 
 ////////////////////////////////////////////////////////////////////////////////
 
-GrIndexBufferAllocPool::GrIndexBufferAllocPool(GrGpu* gpu, void* initialCpuBuffer)
-        : GrBufferAllocPool(gpu, kIndex_GrBufferType, initialCpuBuffer) {}
+GrIndexBufferAllocPool::GrIndexBufferAllocPool(GrGpu* gpu, void* initialCpuBuffer,
+                                               GrBufferRing* ring)
+        : GrBufferAllocPool(gpu, kIndex_GrBufferType, initialCpuBuffer, ring) {}
 
 void* GrIndexBufferAllocPool::makeSpace(int indexCount, sk_sp<const GrBuffer>* buffer,
                                         int* startIndex) {
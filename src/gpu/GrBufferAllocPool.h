@@ -17,6 +17,52 @@
 class GrBuffer;
 class GrGpu;
 
+/**
+ * Recycles persistently mapped GrBufferAllocPool::kDefaultBufferSize buffers across flushes, so
+ * that a pool writes vertices straight into GPU visible memory without mapping, orphaning or
+ * reallocating a buffer each time. The buffers a pool is done with are retired, and handed out
+ * again once a fence inserted after the draws that read them has signaled. Only used when
+ * GrCaps::persistentlyMappedBufferSupport() is true.
+ */
+class GrBufferRing : SkNoncopyable {
+public:
+    GrBufferRing(GrGpu* gpu, GrBufferType bufferType) : fGpu(gpu), fBufferType(bufferType) {}
+
+    ~GrBufferRing();
+
+    /** Returns a buffer the GPU is no longer reading, or a new one if there is none. */
+    sk_sp<GrBuffer> getBuffer();
+
+    /** Takes back a buffer from getBuffer() that draws issued before the next fence may read. */
+    void retire(sk_sp<GrBuffer>);
+
+    /**
+     * Fences the buffers retired since the last call. Must be called after all the draws that read
+     * them have been issued.
+     */
+    void insertFence();
+
+private:
+    static constexpr int kMaxFencedBatches = 4;
+    static constexpr int kMaxFreeBuffers = 16;
+
+    struct FencedBatch {
+        GrFence fFence;
+        SkTArray<sk_sp<GrBuffer>> fBuffers;
+    };
+
+    void popOldestBatch(bool reuseBuffers);
+
+    GrGpu* fGpu;
+    GrBufferType fBufferType;
+    SkTArray<sk_sp<GrBuffer>> fFreeBuffers;
+    SkTArray<sk_sp<GrBuffer>> fRetiredBuffers;
+    // A ring of fFencedBatchCount batches starting at fOldestBatch, in the order they were fenced.
+    FencedBatch fFencedBatches[kMaxFencedBatches];
+    int fOldestBatch = 0;
+    int fFencedBatchCount = 0;
+};
+
 /**
  * A pool of geometry buffers tied to a GrGpu.
  *
@@ -58,8 +104,11 @@ protected:
      * @param initialBuffer         If non-null this should be a kDefaultBufferSize byte allocation.
      *                              This parameter can be used to avoid malloc/free when all
      *                              usages can be satisfied with default-sized buffers.
+     * @param ring                  If non-null, default-sized buffers come from and are returned
+     *                              to this ring, which must outlive the pool.
      */
-    GrBufferAllocPool(GrGpu* gpu, GrBufferType bufferType, void* initialBuffer);
+    GrBufferAllocPool(GrGpu* gpu, GrBufferType bufferType, void* initialBuffer,
+                      GrBufferRing* ring);
 
     virtual ~GrBufferAllocPool();
 
@@ -122,6 +171,7 @@ private:
     struct BufferBlock {
         size_t fBytesFree;
         sk_sp<GrBuffer> fBuffer;
+        bool fFromRing;
     };
 
     bool createBlock(size_t requestSize);
@@ -137,6 +187,7 @@ private:
     SkTArray<BufferBlock> fBlocks;
     GrGpu* fGpu;
     GrBufferType fBufferType;
+    GrBufferRing* fRing;
     void* fInitialCpuData = nullptr;
     void* fCpuData = nullptr;
     size_t fCpuDataSize = 0;
@@ -155,8 +206,9 @@ public:
      * @param initialBuffer         If non-null this should be a kDefaultBufferSize byte allocation.
      *                              This parameter can be used to avoid malloc/free when all
      *                              usages can be satisfied with default-sized buffers.
+     * @param ring                  If non-null, default-sized buffers are recycled through it.
      */
-    GrVertexBufferAllocPool(GrGpu* gpu, void* initialBuffer);
+    GrVertexBufferAllocPool(GrGpu* gpu, void* initialBuffer, GrBufferRing* ring = nullptr);
 
     /**
      * Returns a block of memory to hold vertices. A buffer designated to hold
@@ -234,8 +286,9 @@ public:
      * @param initialBuffer         If non-null this should be a kDefaultBufferSize byte allocation.
      *                              This parameter can be used to avoid malloc/free when all
      *                              usages can be satisfied with default-sized buffers.
+     * @param ring                  If non-null, default-sized buffers are recycled through it.
      */
-    GrIndexBufferAllocPool(GrGpu* gpu, void* initialBuffer);
+    GrIndexBufferAllocPool(GrGpu* gpu, void* initialBuffer, GrBufferRing* ring = nullptr);
 
     /**
      * Returns a block of memory to hold indices. A buffer designated to hold
@@ -36,11 +36,13 @@ GrCaps::GrCaps(const GrContextOptions& options) {
     fSupportsAHardwareBufferImages = false;
     fFenceSyncSupport = false;
     fCrossContextTextureSupport = false;
+    fPersistentlyMappedBufferSupport = false;
     fHalfFloatVertexAttributeSupport = false;
     fDynamicStateArrayGeometryProcessorTextureSupport = false;
     fPerformPartialClearsAsDraws = false;
     fPerformColorClearsAsDraws = false;
     fPerformStencilClearsAsDraws = false;
+    fDiscardStencilValuesAfterRenderPass = false;
 
     fBlendEquationSupport = kBasic_BlendEquationSupport;
     fAdvBlendEqBlacklist = 0;
@@ -83,6 +85,12 @@ GrCaps::GrCaps(const GrContextOptions& options) {
 
 void GrCaps::applyOptionsOverrides(const GrContextOptions& options) {
     this->onApplyOptionsOverrides(options);
+    if (fMaxClipAnalyticFPs > 0 && fShaderCaps->floatIs32Bits() && fShaderCaps->integerSupport()) {
+        // GPUs with full float precision can afford a few more analytic FPs, which lets typical UI
+        // clip stacks (a few nested rounded rects, each maybe with a difference) avoid the stencil
+        // and mask paths and keep their ops batchable.
+        fMaxClipAnalyticFPs = SkTMax(fMaxClipAnalyticFPs, 8);
+    }
     if (options.fDisableDriverCorrectnessWorkarounds) {
         // We always blacklist coverage counting on Vulkan currently. TODO: Either stop doing that
         // or disambiguate blacklisting from incomplete implementation.
@@ -101,6 +109,11 @@ void GrCaps::applyOptionsOverrides(const GrContextOptions& options) {
         fPerformColorClearsAsDraws = true;
         fPerformStencilClearsAsDraws = true;
     }
+    if (fPerformStencilClearsAsDraws) {
+        // Then the stencil is only cleared the first time the render target needs it, so later
+        // opLists rely on the values stored by earlier ones.
+        fDiscardStencilValuesAfterRenderPass = false;
+    }
 
     fMaxTextureSize = SkTMin(fMaxTextureSize, options.fMaxTextureSizeOverride);
     fMaxTileSize = fMaxTextureSize;
@@ -149,6 +162,11 @@ static const char* pixel_config_name(GrPixelConfig config) {
         case kAlpha_half_as_Red_GrPixelConfig: return "AlphaHalf_asRed";
         case kRGBA_half_GrPixelConfig: return "RGBAHalf";
         case kRGB_ETC1_GrPixelConfig: return "RGBETC1";
+        case kRGBA_ETC2_GrPixelConfig: return "RGBAETC2";
+        case kRGBA_ASTC_4x4_GrPixelConfig: return "RGBAASTC4x4";
+        case kRGBA_BC1_GrPixelConfig: return "RGBABC1";
+        case kRGBA_BC3_GrPixelConfig: return "RGBABC3";
+        case kRGBA_BC7_GrPixelConfig: return "RGBABC7";
     }
     SK_ABORT("Invalid pixel config");
     return "<invalid>";
@@ -198,12 +216,15 @@ void GrCaps::dumpJSON(SkJSONWriter* writer) const {
     writer->appendBool("Supports importing AHardwareBuffers", fSupportsAHardwareBufferImages);
     writer->appendBool("Fence sync support", fFenceSyncSupport);
     writer->appendBool("Cross context texture support", fCrossContextTextureSupport);
+    writer->appendBool("Persistently mapped buffer support", fPersistentlyMappedBufferSupport);
     writer->appendBool("Half float vertex attribute support", fHalfFloatVertexAttributeSupport);
     writer->appendBool("Specify GeometryProcessor textures as a dynamic state array",
                        fDynamicStateArrayGeometryProcessorTextureSupport);
     writer->appendBool("Use draws for partial clears", fPerformPartialClearsAsDraws);
     writer->appendBool("Use draws for color clears", fPerformColorClearsAsDraws);
     writer->appendBool("Use draws for stencil clip clears", fPerformStencilClearsAsDraws);
+    writer->appendBool("Discard stencil values after render pass",
+                       fDiscardStencilValuesAfterRenderPass);
     writer->appendBool("Clamp-to-border", fClampToBorderSupport);
 
     writer->appendBool("Blacklist Coverage Counting Path Renderer [workaround]",
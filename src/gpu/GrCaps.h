@@ -243,6 +243,14 @@ public:
 
     bool fenceSyncSupport() const { return fFenceSyncSupport; }
     bool crossContextTextureSupport() const { return fCrossContextTextureSupport; }
+
+    /**
+     * Are vertex and index buffers created with kStream_GrAccessPattern mapped once for their
+     * whole lifetime, making map() and unmap() free? The GPU may still be reading a previous use
+     * of the buffer's contents, so the caller must wait on a fence before writing to it again.
+     */
+    bool persistentlyMappedBufferSupport() const { return fPersistentlyMappedBufferSupport; }
+
     /**
      * Returns whether or not we will be able to do a copy given the passed in params
      */
@@ -271,6 +279,13 @@ public:
         return fPerformStencilClearsAsDraws;
     }
 
+    /// True if the stencil values can be discarded at the end of each opList's render pass. This
+    /// relies on every opList that uses the stencil clearing it with its load op, so it is never
+    /// true when performStencilClearsAsDraws() is.
+    bool discardStencilValuesAfterRenderPass() const {
+        return fDiscardStencilValuesAfterRenderPass;
+    }
+
     /**
      * This is can be called before allocating a texture to be a dst for copySurface. This is only
      * used for doing dst copies needed in blends, thus the src is always a GrRenderTargetProxy. It
@@ -351,6 +366,7 @@ protected:
     bool fPerformPartialClearsAsDraws                : 1;
     bool fPerformColorClearsAsDraws                  : 1;
     bool fPerformStencilClearsAsDraws                : 1;
+    bool fDiscardStencilValuesAfterRenderPass        : 1;
 
     // Driver workaround
     bool fBlacklistCoverageCounting                  : 1;
@@ -366,6 +382,9 @@ protected:
     // Requires fence sync support in GL.
     bool fCrossContextTextureSupport                 : 1;
 
+    // Requires fence sync and buffer storage support in GL.
+    bool fPersistentlyMappedBufferSupport            : 1;
+
     // Not (yet) implemented in VK backend.
     bool fDynamicStateArrayGeometryProcessorTextureSupport : 1;
 
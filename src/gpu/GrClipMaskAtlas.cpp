@@ -0,0 +1,186 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrClipMaskAtlas.h"
+
+#include "GrCaps.h"
+#include "GrClipStackClip.h"
+#include "GrDeferredProxyUploader.h"
+#include "GrProxyProvider.h"
+#include "GrRectanizer_skyline.h"
+#include "GrSWMaskHelper.h"
+#include "GrTextureProxy.h"
+#include "SkTaskGroup.h"
+#include "SkTraceEvent.h"
+
+namespace {
+
+/**
+ * Rasterizes the masks of one page into its pixels. Unlike the uploaders of single masks, the
+ * work isn't started until the page is closed, since masks are added to it until then.
+ */
+class PageUploader : public GrDeferredProxyUploader {
+public:
+    ~PageUploader() override {
+        if (!fClosed) {
+            // The page was dropped before a flush closed it, so nothing will signal us.
+            this->signalAndFreeData();
+        }
+        // Don't free the masks while a worker thread is drawing them.
+        this->wait();
+    }
+
+    void addMask(const GrReducedClip& reducedClip, const SkIPoint& location) {
+        SkASSERT(!fClosed);
+        fMasks.push_back(skstd::make_unique<Mask>(reducedClip, location));
+    }
+
+    void close(SkTaskGroup* taskGroup) {
+        SkASSERT(!fClosed);
+        fClosed = true;
+        if (taskGroup) {
+            taskGroup->add([this] { this->drawMasks(); });
+        } else {
+            this->drawMasks();
+        }
+    }
+
+private:
+    struct Mask {
+        Mask(const GrReducedClip& reducedClip, const SkIPoint& location)
+                : fScissor(reducedClip.scissor())
+                , fInitialState(reducedClip.initialState())
+                , fLocation(location) {
+            for (GrReducedClip::ElementList::Iter iter(reducedClip.maskElements()); iter.get();
+                 iter.next()) {
+                fElements.addToTail(*iter.get());
+            }
+        }
+
+        SkIRect                     fScissor;
+        GrReducedClip::InitialState fInitialState;
+        GrReducedClip::ElementList  fElements;
+        SkIPoint                    fLocation;
+    };
+
+    void drawMasks() {
+        TRACE_EVENT0("skia", "SW Clip Mask Atlas Render");
+        SkAutoPixmapStorage* pixels = this->getPixels();
+        if (pixels->tryAlloc(SkImageInfo::MakeA8(GrClipMaskAtlas::kPageSize,
+                                                 GrClipMaskAtlas::kPageSize))) {
+            pixels->erase(0);
+            for (const std::unique_ptr<Mask>& mask : fMasks) {
+                SkAutoPixmapStorage maskPixels;
+                GrSWMaskHelper helper(&maskPixels);
+                if (!helper.init(SkIRect::MakeWH(mask->fScissor.width(),
+                                                 mask->fScissor.height()))) {
+                    SkDEBUGFAIL("Unable to allocate SW clip mask.");
+                    continue;
+                }
+                GrClipStackClip::DrawElementsToMask(helper, mask->fElements, mask->fScissor,
+                                                    mask->fInitialState);
+                SkPixmap dst;
+                SkAssertResult(pixels->extractSubset(&dst, SkIRect::MakeXYWH(
+                        mask->fLocation.fX, mask->fLocation.fY, maskPixels.width(),
+                        maskPixels.height())));
+                maskPixels.readPixels(dst);
+            }
+        } else {
+            SkDEBUGFAIL("Unable to allocate SW clip mask atlas page.");
+        }
+        this->signalAndFreeData();
+    }
+
+    void freeData() override { fMasks.reset(); }
+
+    SkTArray<std::unique_ptr<Mask>> fMasks;
+    bool                            fClosed = false;
+};
+
+}  // namespace
+
+class GrClipMaskAtlas::Page {
+public:
+    Page(sk_sp<GrTextureProxy> proxy, PageUploader* uploader)
+            : fProxy(std::move(proxy))
+            , fUploader(uploader)
+            , fRectanizer(kPageSize, kPageSize) {}
+
+    sk_sp<GrTextureProxy> fProxy;
+    // Owned by fProxy until its upload is done.
+    PageUploader*         fUploader;
+    GrRectanizerSkyline   fRectanizer;
+};
+
+GrClipMaskAtlas::GrClipMaskAtlas(GrProxyProvider* proxyProvider, SkTaskGroup* taskGroup)
+        : fProxyProvider(proxyProvider)
+        , fTaskGroup(taskGroup) {}
+
+GrClipMaskAtlas::~GrClipMaskAtlas() {}
+
+GrClipMaskAtlas::Page* GrClipMaskAtlas::makePage() {
+    GrSurfaceDesc desc;
+    desc.fWidth = kPageSize;
+    desc.fHeight = kPageSize;
+    desc.fConfig = kAlpha_8_GrPixelConfig;
+
+    GrBackendFormat format =
+            fProxyProvider->caps()->getBackendFormatFromColorType(kAlpha_8_SkColorType);
+
+    // Like the single SW clip masks, the page is filled by an ASAP upload (which is out of order
+    // wrt to ops), so it can't have any pending IO. Its size never changes, so the page of every
+    // flush can reuse the same scratch texture.
+    sk_sp<GrTextureProxy> proxy = fProxyProvider->createProxy(
+            format, desc, kTopLeft_GrSurfaceOrigin, SkBackingFit::kExact, SkBudgeted::kYes,
+            GrInternalSurfaceFlags::kNoPendingIO);
+    if (!proxy) {
+        return nullptr;
+    }
+
+    auto uploader = skstd::make_unique<PageUploader>();
+    PageUploader* uploaderRaw = uploader.get();
+    proxy->texPriv().setDeferredUploader(std::move(uploader));
+    fOpenPages.push_back(skstd::make_unique<Page>(std::move(proxy), uploaderRaw));
+    return fOpenPages.back().get();
+}
+
+sk_sp<GrTextureProxy> GrClipMaskAtlas::addMask(const GrUniqueKey& maskKey,
+                                               const GrReducedClip& reducedClip,
+                                               SkIPoint* location) {
+    int width = reducedClip.width(), height = reducedClip.height();
+    if (width > kMaxMaskSize || height > kMaxMaskSize) {
+        return nullptr;
+    }
+
+    if (const MaskLocation* found = fMaskLocations.find(maskKey)) {
+        *location = found->fLocation;
+        return found->fPage->fProxy;
+    }
+
+    SkIPoint16 loc;
+    Page* page = fOpenPages.empty() ? nullptr : fOpenPages.back().get();
+    if (!page || !page->fRectanizer.addRect(width, height, &loc)) {
+        page = this->makePage();
+        if (!page || !page->fRectanizer.addRect(width, height, &loc)) {
+            return nullptr;
+        }
+    }
+
+    location->set(loc.fX, loc.fY);
+    page->fUploader->addMask(reducedClip, *location);
+    fMaskLocations.set(maskKey, {page, *location});
+    return page->fProxy;
+}
+
+void GrClipMaskAtlas::preFlush(GrOnFlushResourceProvider*, const uint32_t*, int,
+                               SkTArray<sk_sp<GrRenderTargetContext>>*) {
+    for (const std::unique_ptr<Page>& page : fOpenPages) {
+        page->fUploader->close(fTaskGroup);
+    }
+    fOpenPages.reset();
+    fMaskLocations.reset();
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrClipMaskAtlas_DEFINED
+#define GrClipMaskAtlas_DEFINED
+
+#include "GrOnFlushResourceProvider.h"
+#include "GrReducedClip.h"
+#include "GrResourceKey.h"
+#include "SkTHash.h"
+
+class GrProxyProvider;
+class GrTextureProxy;
+class SkTaskGroup;
+
+/**
+ * Packs the small software clip masks of a flush into shared A8 pages, so many small complex
+ * clips don't each allocate a texture and an upload. addMask() only reserves the mask's spot in
+ * a page. When the flush starts, the masks of each page are rasterized (on the context's task
+ * group if it has one) and the page is uploaded once. A mask that is added again before then,
+ * like a clip shared by many draws, reuses its spot.
+ */
+class GrClipMaskAtlas : public GrOnFlushCallbackObject {
+public:
+    // Masks larger than this in either dimension still get their own textures.
+    static constexpr int kMaxMaskSize = 256;
+    static constexpr int kPageSize = 512;
+
+    GrClipMaskAtlas(GrProxyProvider*, SkTaskGroup*);
+    ~GrClipMaskAtlas() override;
+
+    /**
+     * Reserves a spot for the reduced clip's mask, which is identified by maskKey. Returns the
+     * page and sets 'location' to the mask's top left corner in it. Returns null if the mask is
+     * too big or a page couldn't be made.
+     */
+    sk_sp<GrTextureProxy> addMask(const GrUniqueKey& maskKey, const GrReducedClip&,
+                                  SkIPoint* location);
+
+    // Starts rasterizing the masks of every open page. New masks then go in new pages.
+    void preFlush(GrOnFlushResourceProvider*, const uint32_t* opListIDs, int numOpListIDs,
+                  SkTArray<sk_sp<GrRenderTargetContext>>* results) override;
+
+    // The pages are owned by the clip FPs that sample them, so there's nothing to free.
+    bool retainOnFreeGpuResources() override { return true; }
+
+private:
+    class Page;
+
+    struct MaskLocation {
+        Page*    fPage;
+        SkIPoint fLocation;
+    };
+
+    struct KeyHash {
+        uint32_t operator()(const GrUniqueKey& key) const { return key.hash(); }
+    };
+
+    Page* makePage();
+
+    GrProxyProvider*                  fProxyProvider;
+    SkTaskGroup*                      fTaskGroup;
+    SkTArray<std::unique_ptr<Page>>   fOpenPages;
+    SkTHashMap<GrUniqueKey, MaskLocation, KeyHash> fMaskLocations;
+};
+
+#endif
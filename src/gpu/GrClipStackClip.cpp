@@ -7,6 +7,7 @@
 
 #include "GrClipStackClip.h"
 #include "GrAppliedClip.h"
+#include "GrClipMaskAtlas.h"
 #include "GrContextPriv.h"
 #include "GrDeferredProxyUploader.h"
 #include "GrDrawingManager.h"
@@ -14,6 +15,7 @@
 #include "GrGpuResourcePriv.h"
 #include "GrProxyProvider.h"
 #include "GrRenderTargetContextPriv.h"
+#include "GrRenderTargetOpList.h"
 #include "GrSWMaskHelper.h"
 #include "GrShape.h"
 #include "GrStencilAttachment.h"
@@ -77,11 +79,16 @@ void GrClipStackClip::getConservativeBounds(int width, int height, SkIRect* devR
 
 ////////////////////////////////////////////////////////////////////////////////
 // set up the draw state to enable the aa clipping mask.
+// 'maskLocation' is the top left corner of the mask in its texture, which is not at the origin
+// when the mask is in an atlas page.
 static std::unique_ptr<GrFragmentProcessor> create_fp_for_mask(sk_sp<GrTextureProxy> mask,
-                                                               const SkIRect& devBound) {
-    SkIRect domainTexels = SkIRect::MakeWH(devBound.width(), devBound.height());
-    return GrDeviceSpaceTextureDecalFragmentProcessor::Make(std::move(mask), domainTexels,
-                                                            {devBound.fLeft, devBound.fTop});
+                                                               const SkIRect& devBound,
+                                                               const SkIPoint& maskLocation) {
+    SkIRect domainTexels = SkIRect::MakeXYWH(maskLocation.fX, maskLocation.fY, devBound.width(),
+                                             devBound.height());
+    return GrDeviceSpaceTextureDecalFragmentProcessor::Make(
+            std::move(mask), domainTexels,
+            {devBound.fLeft - maskLocation.fX, devBound.fTop - maskLocation.fY});
 }
 
 // Does the path in 'element' require SW rendering? If so, return true (and,
@@ -186,6 +193,68 @@ bool GrClipStackClip::UseSWOnlyPath(GrContext* context,
     return false;
 }
 
+// Returns the opList's reduction of the stack for the whole render target, making it if the last
+// one was for another clip or budget.
+static const GrRenderTargetOpList::AnalyticClip& find_or_reduce_analytic_clip(
+        const SkClipStack& stack, GrContext* context, GrRenderTargetContext* renderTargetContext,
+        uint32_t opListID, int maxWindowRectangles, int maxAnalyticFPs) {
+    GrRenderTargetOpList::AnalyticClip* clip = renderTargetContext->priv().lastAnalyticClip();
+    uint32_t genID = stack.getTopmostGenID();
+    if (clip->fClipStackGenID == genID && clip->fMaxWindowRectangles == maxWindowRectangles &&
+        clip->fMaxAnalyticFPs == maxAnalyticFPs) {
+        return *clip;
+    }
+
+    *clip = GrRenderTargetOpList::AnalyticClip();
+    clip->fClipStackGenID = genID;
+    clip->fMaxWindowRectangles = maxWindowRectangles;
+    clip->fMaxAnalyticFPs = maxAnalyticFPs;
+
+    // CCPR clip paths are made for each draw, so they can't be shared. Such paths are left in the
+    // mask elements here, and the draws reduce the clip themselves.
+    int rtWidth = renderTargetContext->width(), rtHeight = renderTargetContext->height();
+    GrReducedClip reducedClip(stack, SkRect::MakeIWH(rtWidth, rtHeight),
+                              context->contextPriv().caps(), maxWindowRectangles, maxAnalyticFPs);
+    if (!reducedClip.maskElements().isEmpty()) {
+        return *clip;
+    }
+
+    clip->fIsAnalytic = true;
+    clip->fClipsEverything = InitialState::kAllOut == reducedClip.initialState();
+    clip->fHasScissor = reducedClip.hasScissor();
+    if (clip->fHasScissor) {
+        clip->fScissor = reducedClip.scissor();
+    }
+    clip->fWindowRectangles = reducedClip.windowRectangles();
+    clip->fFP = reducedClip.finishAndDetachAnalyticFPs(nullptr, opListID, rtWidth, rtHeight);
+    return *clip;
+}
+
+static bool apply_analytic_clip(const GrRenderTargetOpList::AnalyticClip& clip,
+                                const SkRect& devBounds, GrAppliedClip* out, SkRect* bounds) {
+    SkASSERT(clip.fIsAnalytic);
+    if (clip.fClipsEverything) {
+        return false;
+    }
+
+    if (clip.fHasScissor && !GrClip::IsInsideClip(clip.fScissor, devBounds)) {
+        // Unlike a reduction for the draw itself, the scissor may not touch the draw.
+        if (!out->hardClip().addScissor(clip.fScissor, bounds)) {
+            return false;
+        }
+    }
+
+    if (!clip.fWindowRectangles.empty()) {
+        out->hardClip().addWindowRectangles(clip.fWindowRectangles,
+                                            GrWindowRectsState::Mode::kExclusive);
+    }
+
+    if (clip.fFP) {
+        out->addCoverageFP(clip.fFP->clone());
+    }
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // sort out what kind of clip mask needs to be created: alpha, stencil,
 // scissor, or entirely software
@@ -213,6 +282,13 @@ bool GrClipStackClip::apply(GrContext* context, GrRenderTargetContext* renderTar
         // We disable MSAA when avoiding stencil.
         SkASSERT(!context->contextPriv().caps()->avoidStencilBuffers());
     }
+    const GrRenderTargetOpList::AnalyticClip& analyticClip = find_or_reduce_analytic_clip(
+            *fStack, context, renderTargetContext, renderTargetContext->getOpList()->uniqueID(),
+            maxWindowRectangles, maxAnalyticFPs);
+    if (analyticClip.fIsAnalytic) {
+        return apply_analytic_clip(analyticClip, devBounds, out, bounds);
+    }
+
     auto* ccpr = context->contextPriv().drawingManager()->getCoverageCountingPathRenderer();
 
     GrReducedClip reducedClip(*fStack, devBounds, context->contextPriv().caps(),
@@ -265,10 +341,12 @@ bool GrClipStackClip::applyClipMask(GrContext* context, GrRenderTargetContext* r
         context->contextPriv().caps()->avoidStencilBuffers() ||
         renderTargetContext->wrapsVkSecondaryCB()) {
         sk_sp<GrTextureProxy> result;
+        SkIPoint maskLocation = {0, 0};
         if (UseSWOnlyPath(context, hasUserStencilSettings, renderTargetContext, reducedClip)) {
             // The clip geometry is complex enough that it will be more efficient to create it
             // entirely in software
-            result = this->createSoftwareClipMask(context, reducedClip, renderTargetContext);
+            result = this->createSoftwareClipMask(context, reducedClip, renderTargetContext,
+                                                  &maskLocation);
         } else {
             result = this->createAlphaClipMask(context, reducedClip);
         }
@@ -276,7 +354,8 @@ bool GrClipStackClip::applyClipMask(GrContext* context, GrRenderTargetContext* r
         if (result) {
             // The mask's top left coord should be pinned to the rounded-out top left corner of
             // the clip's device space bounds.
-            out->addCoverageFP(create_fp_for_mask(std::move(result), reducedClip.scissor()));
+            out->addCoverageFP(create_fp_for_mask(std::move(result), reducedClip.scissor(),
+                                                  maskLocation));
             return true;
         }
 
@@ -412,8 +491,8 @@ private:
 
 }
 
-static void draw_clip_elements_to_mask_helper(GrSWMaskHelper& helper, const ElementList& elements,
-                                              const SkIRect& scissor, InitialState initialState) {
+void GrClipStackClip::DrawElementsToMask(GrSWMaskHelper& helper, const ElementList& elements,
+                                         const SkIRect& scissor, InitialState initialState) {
     // Set the matrix so that rendered clip elements are transformed to mask space from clip space.
     SkMatrix translate;
     translate.setTranslate(SkIntToScalar(-scissor.left()), SkIntToScalar(-scissor.top()));
@@ -458,7 +537,9 @@ static void draw_clip_elements_to_mask_helper(GrSWMaskHelper& helper, const Elem
 
 sk_sp<GrTextureProxy> GrClipStackClip::createSoftwareClipMask(
         GrContext* context, const GrReducedClip& reducedClip,
-        GrRenderTargetContext* renderTargetContext) const {
+        GrRenderTargetContext* renderTargetContext, SkIPoint* maskLocation) const {
+    maskLocation->set(0, 0);
+
     GrUniqueKey key;
     create_clip_mask_key(reducedClip.maskGenID(), reducedClip.scissor(),
                          reducedClip.numAnalyticFPs(), &key);
@@ -471,6 +552,17 @@ sk_sp<GrTextureProxy> GrClipStackClip::createSoftwareClipMask(
         return proxy;
     }
 
+    // Small masks go in this flush's atlas instead of their own textures. Those are only found
+    // again within the flush, so they don't get unique keys. The atlas isn't used when recording
+    // a DDL, since the pages would never be rasterized.
+    if (renderTargetContext && context->contextPriv().getGpu()) {
+        GrClipMaskAtlas* atlas = context->contextPriv().drawingManager()->getClipMaskAtlas();
+        proxy = atlas->addMask(key, reducedClip, maskLocation);
+        if (proxy) {
+            return proxy;
+        }
+    }
+
     // The mask texture may be larger than necessary. We round out the clip bounds and pin the top
     // left corner of the resulting rect to the top left of the texture.
     SkIRect maskSpaceIBounds = SkIRect::MakeWH(reducedClip.width(), reducedClip.height());
@@ -498,9 +590,9 @@ sk_sp<GrTextureProxy> GrClipStackClip::createSoftwareClipMask(
             TRACE_EVENT0("skia", "Threaded SW Clip Mask Render");
             GrSWMaskHelper helper(uploaderRaw->getPixels());
             if (helper.init(maskSpaceIBounds)) {
-                draw_clip_elements_to_mask_helper(helper, uploaderRaw->data().elements(),
-                                                  uploaderRaw->data().scissor(),
-                                                  uploaderRaw->data().initialState());
+                DrawElementsToMask(helper, uploaderRaw->data().elements(),
+                                   uploaderRaw->data().scissor(),
+                                   uploaderRaw->data().initialState());
             } else {
                 SkDEBUGFAIL("Unable to allocate SW clip mask.");
             }
@@ -515,8 +607,8 @@ sk_sp<GrTextureProxy> GrClipStackClip::createSoftwareClipMask(
             return nullptr;
         }
 
-        draw_clip_elements_to_mask_helper(helper, reducedClip.maskElements(), reducedClip.scissor(),
-                                          reducedClip.initialState());
+        DrawElementsToMask(helper, reducedClip.maskElements(), reducedClip.scissor(),
+                           reducedClip.initialState());
 
         proxy = helper.toTextureProxy(context, SkBackingFit::kApprox);
     }
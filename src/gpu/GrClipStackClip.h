@@ -12,6 +12,7 @@
 #include "SkClipStack.h"
 
 class GrPathRenderer;
+class GrSWMaskHelper;
 class GrTextureProxy;
 
 /**
@@ -36,6 +37,11 @@ public:
     sk_sp<GrTextureProxy> testingOnly_createClipMask(GrContext*) const;
     static const char kMaskTestTag[];
 
+    // Rasterizes the elements of a reduced clip into helper, whose mask covers 'scissor' (in
+    // device space) with its top left corner at the mask's origin.
+    static void DrawElementsToMask(GrSWMaskHelper&, const GrReducedClip::ElementList&,
+                                   const SkIRect& scissor, GrReducedClip::InitialState);
+
 private:
     static bool PathNeedsSWRenderer(GrContext* context,
                                     const SkIRect& scissorRect,
@@ -54,8 +60,11 @@ private:
     sk_sp<GrTextureProxy> createAlphaClipMask(GrContext*, const GrReducedClip&) const;
 
     // Similar to createAlphaClipMask but it rasterizes in SW and uploads to the result texture.
+    // The mask may be in an atlas page, in which case 'maskLocation' is set to its top left corner
+    // in the page. Otherwise it is set to (0, 0).
     sk_sp<GrTextureProxy> createSoftwareClipMask(GrContext*, const GrReducedClip&,
-                                                 GrRenderTargetContext*) const;
+                                                 GrRenderTargetContext*,
+                                                 SkIPoint* maskLocation) const;
 
     static bool UseSWOnlyPath(GrContext*,
                               bool hasUserStencilSettings,
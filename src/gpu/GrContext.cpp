@@ -6,10 +6,12 @@
  */
 
 #include "GrContext.h"
+#include "GrAsyncReadbackManager.h"
 #include "GrBackendSemaphore.h"
 #include "GrClip.h"
 #include "GrContextOptions.h"
 #include "GrContextPriv.h"
+#include "GrContextThreadSafeProxyPriv.h"
 #include "GrDrawingManager.h"
 #include "GrGpu.h"
 #include "GrMemoryPool.h"
@@ -19,6 +21,7 @@
 #include "GrResourceCache.h"
 #include "GrResourceProvider.h"
 #include "GrSemaphore.h"
+#include "GrSharedShaderCache.h"
 #include "GrSoftwarePathRenderer.h"
 #include "GrSurfaceContext.h"
 #include "GrSurfacePriv.h"
@@ -31,6 +34,7 @@
 #include "SkGr.h"
 #include "SkImageInfoPriv.h"
 #include "SkMakeUnique.h"
+#include "SkMemoryPressure.h"
 #include "SkSurface_Gpu.h"
 #include "SkTaskGroup.h"
 #include "SkTraceMemoryDump.h"
@@ -65,6 +69,7 @@ GrContext::GrContext(GrBackendApi backend, int32_t id)
     fResourceProvider = nullptr;
     fProxyProvider = nullptr;
     fGlyphCache = nullptr;
+    fMemoryPressureObserver.reset(new SkMemoryPressureObserver);
 }
 
 bool GrContext::initCommon(const GrContextOptions& options) {
@@ -87,12 +92,18 @@ bool GrContext::initCommon(const GrContextOptions& options) {
         fResourceCache->setProxyProvider(fProxyProvider);
     }
 
+    if (fGpu) {
+        fAsyncReadbacks.reset(new GrAsyncReadbackManager);
+    }
+
     fDisableGpuYUVConversion = options.fDisableGpuYUVConversion;
     fSharpenMipmappedTextures = options.fSharpenMipmappedTextures;
     fDidTestPMConversions = false;
 
     GrPathRendererChain::Options prcOptions;
     prcOptions.fAllowPathMaskCaching = options.fAllowPathMaskCaching;
+    prcOptions.fSmallPathMaxDimension = options.fSmallPathMaxDimension;
+    prcOptions.fDistanceFieldPathCache = options.fDistanceFieldPathCache;
 #if GR_TEST_UTILS
     prcOptions.fGpuPathRenderers = options.fGpuPathRenderers;
 #endif
@@ -115,6 +126,8 @@ bool GrContext::initCommon(const GrContextOptions& options) {
     textContextOptions.fMaxDistanceFieldFontSize = options.fGlyphsAsPathsFontSize;
     textContextOptions.fMinDistanceFieldFontSize = options.fMinDistanceFieldFontSize;
     textContextOptions.fDistanceFieldVerticesAlwaysHaveW = false;
+    textContextOptions.fExecutor = options.fExecutor;
+    textContextOptions.fDistanceFieldGlyphCache = options.fDistanceFieldGlyphCache;
 #if SK_SUPPORT_ATLAS_TEXT
     if (GrContextOptions::Enable::kYes == options.fDistanceFieldGlyphVerticesAlwaysHaveW) {
         textContextOptions.fDistanceFieldVerticesAlwaysHaveW = true;
@@ -140,6 +153,15 @@ bool GrContext::initCommon(const GrContextOptions& options) {
     }
 
     fPersistentCache = options.fPersistentCache;
+    if (options.fShareShaderCache && fGpu) {
+        if (uint32_t scope = fGpu->shaderCacheScope()) {
+            fSharedShaderCache = skstd::make_unique<GrSharedShaderCache>(scope, fPersistentCache);
+            fPersistentCache = fSharedShaderCache.get();
+        }
+    }
+    if (fPersistentCache) {
+        fPersistentCache->prefetch(options.fExecutor);
+    }
 
     return true;
 }
@@ -147,6 +169,12 @@ bool GrContext::initCommon(const GrContextOptions& options) {
 GrContext::~GrContext() {
     ASSERT_SINGLE_OWNER
 
+    if (fAsyncReadbacks) {
+        fAsyncReadbacks->failAll(fGpu.get(), !this->abandoned());
+    }
+    if (fGpu) {
+        fThreadSafeProxy->priv().uploadStagingPool()->releaseAll(this->abandoned());
+    }
     if (fDrawingManager) {
         fDrawingManager->cleanup();
     }
@@ -180,6 +208,14 @@ void GrContext::abandonContext() {
 
     fGlyphCache->freeAll();
     fTextBlobCache->freeAll();
+
+    // The fences went with the 3D context, so this just tells the clients their reads failed.
+    if (fAsyncReadbacks) {
+        fAsyncReadbacks->failAll(fGpu.get(), false);
+    }
+    if (fGpu) {
+        fThreadSafeProxy->priv().uploadStagingPool()->releaseAll(true);
+    }
 }
 
 bool GrContext::abandoned() const {
@@ -194,6 +230,12 @@ void GrContext::releaseResourcesAndAbandonContext() {
     if (this->abandoned()) {
         return;
     }
+    if (fAsyncReadbacks) {
+        fAsyncReadbacks->failAll(fGpu.get(), true);
+    }
+    if (fGpu) {
+        fThreadSafeProxy->priv().uploadStagingPool()->releaseAll(false);
+    }
     fProxyProvider->abandon();
     fResourceProvider->abandon();
 
@@ -222,6 +264,10 @@ void GrContext::freeGpuResources() {
 
     fDrawingManager->freeGpuResources();
 
+    if (fOpMemoryPool) {
+        fOpMemoryPool->purgeFreeLists();
+    }
+
     fResourceCache->purgeAllUnlocked();
 }
 
@@ -235,6 +281,8 @@ void GrContext::purgeUnlockedResources(bool scratchResourcesOnly) {
 void GrContext::performDeferredCleanup(std::chrono::milliseconds msNotUsed) {
     ASSERT_SINGLE_OWNER
 
+    this->checkMemoryPressure();
+
     auto purgeTime = GrStdSteadyClock::now() - msNotUsed;
 
     fResourceCache->purgeAsNeeded();
@@ -252,6 +300,46 @@ void GrContext::purgeUnlockedResources(size_t bytesToPurge, bool preferScratchRe
     fResourceCache->purgeUnlockedResources(bytesToPurge, preferScratchResources);
 }
 
+void GrContext::trimForMemoryPressure(SkGraphics::MemoryPressureLevel level) {
+    ASSERT_SINGLE_OWNER
+    RETURN_IF_ABANDONED
+
+    using Level = SkGraphics::MemoryPressureLevel;
+    if (Level::kNone == level) {
+        return;
+    }
+    if (Level::kCritical == level) {
+        this->freeGpuResources();
+        return;
+    }
+
+    // Scratch resources only cost a reallocation.
+    fResourceCache->purgeUnlockedResources(true);
+    fTextBlobCache->purgeStaleBlobs();
+    if (Level::kModerate == level) {
+        return;
+    }
+
+    // Cached path masks and glyphs have to be rendered and uploaded again. Flush first so no
+    // pending op still refers to the atlases.
+    this->flush();
+    if (auto ccpr = fDrawingManager->getCoverageCountingPathRenderer()) {
+        ccpr->purgeCacheEntriesOlderThan(fProxyProvider, GrStdSteadyClock::now());
+    }
+    if (GrAtlasManager* atlasManager = this->onGetAtlasManager()) {
+        atlasManager->freeAll();
+        fGlyphCache->freeAll();
+        fTextBlobCache->freeAll();
+    }
+
+    // Uniquely keyed resources (e.g. uploaded images) are the most expensive, so keep half.
+    fResourceCache->purgeUnlockedResources(fResourceCache->getPurgeableBytes() / 2, false);
+}
+
+void GrContext::checkMemoryPressure() {
+    this->trimForMemoryPressure(fMemoryPressureObserver->poll());
+}
+
 void GrContext::getResourceCacheUsage(int* resourceCount, size_t* resourceBytes) const {
     ASSERT_SINGLE_OWNER
 
@@ -303,6 +391,8 @@ void GrContext::flush() {
     RETURN_IF_ABANDONED
 
     fDrawingManager->flush(nullptr);
+    this->checkAsyncWorkCompletion();
+    this->checkMemoryPressure();
 }
 
 GrSemaphoresSubmitted GrContext::flushAndSignalSemaphores(int numSemaphores,
@@ -310,7 +400,20 @@ GrSemaphoresSubmitted GrContext::flushAndSignalSemaphores(int numSemaphores,
     ASSERT_SINGLE_OWNER
     if (fDrawingManager->wasAbandoned()) { return GrSemaphoresSubmitted::kNo; }
 
-    return fDrawingManager->flush(nullptr, numSemaphores, signalSemaphores);
+    GrSemaphoresSubmitted submitted =
+            fDrawingManager->flush(nullptr, numSemaphores, signalSemaphores);
+    this->checkAsyncWorkCompletion();
+    this->checkMemoryPressure();
+    return submitted;
+}
+
+void GrContext::checkAsyncWorkCompletion() {
+    ASSERT_SINGLE_OWNER
+    RETURN_IF_ABANDONED
+
+    if (fAsyncReadbacks) {
+        fAsyncReadbacks->process(fGpu.get());
+    }
 }
 
 void GrContextPriv::flush(GrSurfaceProxy* proxy) {
@@ -352,6 +455,11 @@ static bool valid_premul_config(GrPixelConfig config) {
         case kAlpha_half_GrPixelConfig:         return false;
         case kRGBA_half_GrPixelConfig:          return true;
         case kRGB_ETC1_GrPixelConfig:           return false;
+        case kRGBA_ETC2_GrPixelConfig:          return false;
+        case kRGBA_ASTC_4x4_GrPixelConfig:      return false;
+        case kRGBA_BC1_GrPixelConfig:           return false;
+        case kRGBA_BC3_GrPixelConfig:           return false;
+        case kRGBA_BC7_GrPixelConfig:           return false;
         case kAlpha_8_as_Alpha_GrPixelConfig:   return false;
         case kAlpha_8_as_Red_GrPixelConfig:     return false;
         case kAlpha_half_as_Red_GrPixelConfig:  return false;
@@ -379,6 +487,11 @@ static bool valid_premul_color_type(GrColorType ct) {
         case GrColorType::kRG_F32:       return false;
         case GrColorType::kRGBA_F32:     return true;
         case GrColorType::kRGB_ETC1:     return false;
+        case GrColorType::kRGBA_ETC2:    return false;
+        case GrColorType::kRGBA_ASTC_4x4: return false;
+        case GrColorType::kRGBA_BC1:     return false;
+        case GrColorType::kRGBA_BC3:     return false;
+        case GrColorType::kRGBA_BC7:     return false;
     }
     SK_ABORT("Invalid GrColorType");
     return false;
@@ -775,6 +888,171 @@ bool GrContextPriv::readSurfacePixels(GrSurfaceContext* src, int left, int top,
     return true;
 }
 
+// Starts the transfer for asyncReadSurfacePixels. Returns false, having queued nothing, if it must
+// fall back to a synchronous read.
+static bool start_async_read(GrContext* context, GrSurfaceContext* src, int left, int top,
+                             const SkImageInfo& dstInfo, GrContextPriv::AsyncReadCallback callback,
+                             void* callbackContext, GrAsyncReadbackManager* readbacks) {
+    const GrCaps* caps = context->contextPriv().caps();
+    if (!readbacks || !caps->fenceSyncSupport() ||
+        !(caps->mapBufferFlags() & GrCaps::kCanMap_MapFlag)) {
+        return false;
+    }
+
+    GrSurfaceProxy* srcProxy = src->asSurfaceProxy();
+    if (!srcProxy->instantiate(context->contextPriv().resourceProvider())) {
+        return false;
+    }
+    GrSurface* srcSurface = srcProxy->peekSurface();
+    int width = dstInfo.width();
+    int height = dstInfo.height();
+    if (!SkIRect::MakeWH(srcProxy->width(), srcProxy->height())
+                 .contains(SkIRect::MakeXYWH(left, top, width, height)) ||
+        !caps->surfaceSupportsReadPixels(srcSurface)) {
+        return false;
+    }
+
+    GrColorType dstColorType = SkColorTypeToGrColorType(dstInfo.colorType());
+    if (GrColorType::kUnknown == dstColorType) {
+        return false;
+    }
+    GrColorType bufferColorType = caps->supportedReadPixelsColorType(srcProxy->config(),
+                                                                     dstColorType);
+    SkColorType bufferSkColorType = GrColorTypeToSkColorType(bufferColorType);
+    if (kUnknown_SkColorType == bufferSkColorType) {
+        return false;
+    }
+
+    // Opaque pixels are equally valid as premul or unpremul, so only leave the alpha type different
+    // from dstInfo's when the pixels need converting.
+    SkAlphaType bufferAlphaType = kPremul_SkAlphaType;
+    if (SkColorTypeIsAlwaysOpaque(bufferSkColorType) ||
+        GrPixelConfigIsOpaque(srcProxy->config())) {
+        bufferAlphaType = SkColorTypeIsAlwaysOpaque(dstInfo.colorType()) ? kOpaque_SkAlphaType
+                                                                         : dstInfo.alphaType();
+    }
+    sk_sp<SkColorSpace> srcColorSpace = src->colorSpaceInfo().refColorSpace();
+    SkImageInfo bufferInfo = SkImageInfo::Make(width, height, bufferSkColorType, bufferAlphaType,
+                                               srcColorSpace);
+    // "Legacy" mode - no color space conversions.
+    SkImageInfo finalDstInfo = srcColorSpace ? dstInfo : dstInfo.makeColorSpace(nullptr);
+    if (!SkImageInfoValidConversion(finalDstInfo, bufferInfo)) {
+        return false;
+    }
+
+    sk_sp<GrBuffer> buffer = context->contextPriv().resourceProvider()->createBuffer(
+            bufferInfo.computeMinByteSize(), kXferGpuToCpu_GrBufferType, kStream_GrAccessPattern,
+            GrResourceProvider::Flags::kNoPendingIO);
+    if (!buffer) {
+        return false;
+    }
+
+    bool flip = srcProxy->origin() == kBottomLeft_GrSurfaceOrigin;
+    int transferTop = flip ? srcSurface->height() - top - height : top;
+
+    if (srcSurface->surfacePriv().hasPendingWrite()) {
+        context->contextPriv().flush(nullptr);  // MDB TODO: tighten this
+    }
+
+    GrGpu* gpu = context->contextPriv().getGpu();
+    if (!gpu->transferPixelsFrom(srcSurface, left, transferTop, width, height, bufferColorType,
+                                 buffer.get(), 0)) {
+        return false;
+    }
+    GrFence fence = gpu->insertFence();
+    readbacks->add({std::move(buffer), fence, bufferInfo, flip, finalDstInfo, callback,
+                    callbackContext});
+    return true;
+}
+
+void GrContextPriv::asyncReadSurfacePixels(GrSurfaceContext* src, int left, int top,
+                                           const SkImageInfo& dstInfo, AsyncReadCallback callback,
+                                           void* context) {
+    ASSERT_SINGLE_OWNER_PRIV
+    SkASSERT(src);
+    SkASSERT(callback);
+    ASSERT_OWNED_PROXY_PRIV(src->asSurfaceProxy());
+    GR_CREATE_TRACE_MARKER_CONTEXT("GrContextPriv", "asyncReadSurfacePixels", fContext);
+
+    if (fContext->abandoned() || dstInfo.isEmpty()) {
+        callback(context, nullptr, 0);
+        return;
+    }
+    if (start_async_read(fContext, src, left, top, dstInfo, callback, context,
+                         fContext->fAsyncReadbacks.get())) {
+        return;
+    }
+
+    SkAutoPixmapStorage pixels;
+    if (pixels.tryAlloc(dstInfo) &&
+        src->readPixels(dstInfo, pixels.writable_addr(), pixels.rowBytes(), left, top)) {
+        callback(context, pixels.addr(), pixels.rowBytes());
+    } else {
+        callback(context, nullptr, 0);
+    }
+}
+
+int GrContextPriv::stageUploadBuffers(int count, size_t size) {
+    ASSERT_SINGLE_OWNER_PRIV
+    if (fContext->abandoned() || !(this->caps()->mapBufferFlags() & GrCaps::kCanMap_MapFlag)) {
+        return 0;
+    }
+    GrUploadStagingPool* pool = fContext->fThreadSafeProxy->priv().uploadStagingPool();
+    int staged = 0;
+    for (; staged < count; ++staged) {
+        sk_sp<GrBuffer> buffer = this->resourceProvider()->createBuffer(
+                size, kXferCpuToGpu_GrBufferType, kDynamic_GrAccessPattern,
+                GrResourceProvider::Flags::kNoPendingIO);
+        if (!buffer || !pool->add(std::move(buffer))) {
+            break;
+        }
+    }
+    return staged;
+}
+
+sk_sp<GrTextureProxy> GrContextPriv::makeTextureFromStagedUpload(
+        std::unique_ptr<GrStagedUpload> upload, SkBudgeted budgeted) {
+    ASSERT_SINGLE_OWNER_PRIV
+    SkASSERT(upload);
+    GR_CREATE_TRACE_MARKER_CONTEXT("GrContextPriv", "makeTextureFromStagedUpload", fContext);
+
+    sk_sp<GrBuffer> buffer;
+    if (upload->inTransferBuffer()) {
+        SkASSERT(upload->fPool.get() == fContext->fThreadSafeProxy->priv().uploadStagingPool());
+        buffer = upload->fPool->take(upload->fSlot);
+        upload->fPool.reset();
+    }
+    if (fContext->abandoned()) {
+        return nullptr;
+    }
+
+    const SkPixmap& pixels = upload->pixels();
+    GrSurfaceDesc desc;
+    desc.fWidth = pixels.width();
+    desc.fHeight = pixels.height();
+    desc.fConfig = upload->config();
+    GrBackendFormat format = this->caps()->getBackendFormatFromColorType(
+            GrColorTypeToSkColorType(GrPixelConfigToColorType(upload->config())));
+    sk_sp<GrTextureProxy> proxy = this->proxyProvider()->createProxy(
+            format, desc, kTopLeft_GrSurfaceOrigin, SkBackingFit::kExact, budgeted);
+    if (!proxy || !proxy->instantiate(this->resourceProvider())) {
+        return nullptr;
+    }
+
+    GrGpu* gpu = this->getGpu();
+    GrTexture* texture = proxy->peekTexture();
+    if (buffer) {
+        if (!gpu->transferPixels(texture, 0, 0, pixels.width(), pixels.height(),
+                                 upload->colorType(), buffer.get(), 0, pixels.rowBytes())) {
+            return nullptr;
+        }
+    } else if (!gpu->writePixels(texture, 0, 0, pixels.width(), pixels.height(),
+                                 upload->colorType(), pixels.addr(), pixels.rowBytes())) {
+        return nullptr;
+    }
+    return proxy;
+}
+
 void GrContextPriv::prepareSurfaceForExternalIO(GrSurfaceProxy* proxy) {
     ASSERT_SINGLE_OWNER_PRIV
     RETURN_IF_ABANDONED_PRIV
@@ -952,13 +1230,17 @@ void GrContextPriv::addOnFlushCallbackObject(GrOnFlushCallbackObject* onFlushCBO
     fContext->fDrawingManager->addOnFlushCallbackObject(onFlushCBObject);
 }
 
+void GrContextPriv::setFlushTimer(GrFlushTimer* flushTimer) {
+    fContext->fDrawingManager->setFlushTimer(flushTimer);
+}
+
 void GrContextPriv::moveOpListsToDDL(SkDeferredDisplayList* ddl) {
     fContext->fDrawingManager->moveOpListsToDDL(ddl);
 }
 
-void GrContextPriv::copyOpListsFromDDL(const SkDeferredDisplayList* ddl,
+bool GrContextPriv::copyOpListsFromDDL(const SkDeferredDisplayList* ddl,
                                        GrRenderTargetProxy* newDest) {
-    fContext->fDrawingManager->copyOpListsFromDDL(ddl, newDest);
+    return fContext->fDrawingManager->copyOpListsFromDDL(ddl, newDest);
 }
 
 static inline GrPixelConfig GrPixelConfigFallback(GrPixelConfig config) {
@@ -1120,14 +1402,43 @@ void GrContext::setResourceCacheLimits(int maxResources, size_t maxResourceBytes
     fResourceCache->setLimits(maxResources, maxResourceBytes);
 }
 
+void GrContext::setResourceCategoryBudget(GrResourceCategory category, size_t softMaxBytes,
+                                          float evictionWeight) {
+    ASSERT_SINGLE_OWNER
+    fResourceCache->setCategoryBudget(category, softMaxBytes, evictionWeight);
+}
+
+void GrContext::getResourceCategoryUsage(GrResourceCategory category, int* resourceCount,
+                                         size_t* resourceBytes) const {
+    ASSERT_SINGLE_OWNER
+    fResourceCache->getCategoryUsage(category, resourceCount, resourceBytes);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 void GrContext::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
     ASSERT_SINGLE_OWNER
     fResourceCache->dumpMemoryStatistics(traceMemoryDump);
+    fProxyProvider->dumpMemoryStatistics(traceMemoryDump);
     traceMemoryDump->dumpNumericValue("skia/gr_text_blob_cache", "size", "bytes",
                                       fTextBlobCache->usedBytes());
 }
 
+void GrContext::dumpLargestResources(SkTraceMemoryDump* traceMemoryDump, int maxCount) const {
+    ASSERT_SINGLE_OWNER
+    fResourceCache->dumpLargestResources(traceMemoryDump, maxCount);
+}
+
+void GrContext::readFrameStats(FrameStats* stats) {
+    ASSERT_SINGLE_OWNER
+    *stats = FrameStats();
+    if (fGpu) {
+        *stats = *fGpu->frameStats();
+        *fGpu->frameStats() = FrameStats();
+    }
+    stats->fResourcePurges = fResourceCache->numPurges();
+    fResourceCache->resetNumPurges();
+}
+
 //////////////////////////////////////////////////////////////////////////////
 #ifdef SK_ENABLE_DUMP_GPU
 #include "SkJSONWriter.h"
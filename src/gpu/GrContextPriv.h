@@ -14,10 +14,12 @@
 
 class GrBackendFormat;
 class GrBackendRenderTarget;
+class GrFlushTimer;
 class GrOpMemoryPool;
 class GrOnFlushCallbackObject;
 class GrSemaphore;
 class GrSkSLFPFactory;
+class GrStagedUpload;
 class GrSurfaceProxy;
 class GrTextureContext;
 
@@ -110,6 +112,12 @@ public:
 
     void testingOnly_flushAndRemoveOnFlushCallbackObject(GrOnFlushCallbackObject*);
 
+    /**
+     * Times the phases and ops of every following flush with 'flushTimer' (see GrFlushTimer).
+     * Like the onFlush callback objects, it is tracked as a raw pointer. Pass null to stop.
+     */
+    void setFlushTimer(GrFlushTimer* flushTimer);
+
     /**
      * After this returns any pending writes to the surface will have been issued to the
      * backend 3D API.
@@ -169,6 +177,39 @@ public:
                            GrColorType dstColorType, SkColorSpace* dstColorSpace, void* buffer,
                            size_t rowBytes = 0, uint32_t pixelOpsFlags = 0);
 
+    typedef void (*AsyncReadCallback)(void* context, const void* data, size_t rowBytes);
+
+    /**
+     * Reads the rectangle of src at (left, top) with dstInfo's dimensions, converted to dstInfo,
+     * without waiting for the GPU. The read is copied into a transfer buffer behind a fence, and
+     * callback receives the mapped pixels from a later GrContext::checkAsyncWorkCompletion() once
+     * the fence signals. The data is only valid during the callback.
+     *
+     * If the backend can't transfer from src (no fences, mappable transfer buffers or
+     * GrGpu::transferPixelsFrom) this falls back to readSurfacePixels and calls back before
+     * returning. Failures, including abandoning the context with the read in flight, call back
+     * with null data. callback is always called exactly once.
+     */
+    void asyncReadSurfacePixels(GrSurfaceContext* src, int left, int top,
+                                const SkImageInfo& dstInfo, AsyncReadCallback callback,
+                                void* context);
+
+    /**
+     * Creates and maps up to count transfer buffers of at least size bytes each, for
+     * GrContextThreadSafeProxyPriv::stageUpload() to write texture data into from other threads.
+     * Returns how many were staged, which is zero if the backend has no mappable transfer buffers.
+     */
+    int stageUploadBuffers(int count, size_t size);
+
+    /**
+     * Makes a texture from an upload staged by GrContextThreadSafeProxyPriv::stageUpload(). If the
+     * pixels are in a staged transfer buffer this only issues the buffer to texture transfer;
+     * otherwise it writes them from CPU memory. Every staged upload holding a transfer buffer must
+     * be passed here or destroyed before the context is destroyed or abandoned.
+     */
+    sk_sp<GrTextureProxy> makeTextureFromStagedUpload(std::unique_ptr<GrStagedUpload>,
+                                                      SkBudgeted);
+
     /**
      * Writes a rectangle of pixels to a surface.
      *
@@ -212,7 +253,7 @@ public:
     }
 
     void moveOpListsToDDL(SkDeferredDisplayList*);
-    void copyOpListsFromDDL(const SkDeferredDisplayList*, GrRenderTargetProxy* newDest);
+    bool copyOpListsFromDDL(const SkDeferredDisplayList*, GrRenderTargetProxy* newDest);
 
     /**
      * Purge all the unlocked resources from the cache.
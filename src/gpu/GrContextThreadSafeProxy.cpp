@@ -12,6 +12,7 @@
 #include "GrCaps.h"
 #include "GrContext.h"
 #include "GrSkSLFPFactoryCache.h"
+#include "SkGr.h"
 #include "SkSurface_Gpu.h"
 #include "SkSurfaceCharacterization.h"
 
@@ -23,7 +24,8 @@ GrContextThreadSafeProxy::GrContextThreadSafeProxy(sk_sp<const GrCaps> caps, uin
         , fContextID(contextID)
         , fBackend(backend)
         , fOptions(options)
-        , fFPFactoryCache(std::move(cache)) {}
+        , fFPFactoryCache(std::move(cache))
+        , fUploadStagingPool(sk_make_sp<GrUploadStagingPool>()) {}
 
 GrContextThreadSafeProxy::~GrContextThreadSafeProxy() = default;
 
@@ -92,3 +94,38 @@ SkSurfaceCharacterization GrContextThreadSafeProxy::createCharacterization(
 sk_sp<GrSkSLFPFactoryCache> GrContextThreadSafeProxyPriv::fpFactoryCache() const {
     return fProxy->fFPFactoryCache;
 }
+
+std::unique_ptr<GrStagedUpload> GrContextThreadSafeProxyPriv::stageUpload(
+        const SkPixmap& pixmap) const {
+    const GrCaps* caps = this->caps();
+    GrPixelConfig config = SkImageInfo2GrPixelConfig(pixmap.info());
+    if (!pixmap.addr() || kUnknown_GrPixelConfig == config ||
+        !caps->isConfigTexturable(config)) {
+        return nullptr;
+    }
+    GrColorType srcColorType = SkColorTypeToGrColorType(pixmap.colorType());
+    GrColorType colorType = caps->supportedWritePixelsColorType(config, srcColorType);
+    SkColorType stagedColorType = GrColorTypeToSkColorType(colorType);
+    if (kUnknown_SkColorType == stagedColorType) {
+        return nullptr;
+    }
+    SkImageInfo stagedInfo = pixmap.info().makeColorType(stagedColorType);
+    size_t rowBytes = stagedInfo.minRowBytes();
+
+    std::unique_ptr<GrStagedUpload> upload(new GrStagedUpload);
+    upload->fConfig = config;
+    upload->fColorType = colorType;
+    GrUploadStagingPool* pool = this->uploadStagingPool();
+    if (pool->acquire(stagedInfo.computeByteSize(rowBytes), &upload->fSlot)) {
+        upload->fPool = sk_ref_sp(pool);
+        upload->fPixels.reset(stagedInfo, upload->fSlot.fData, rowBytes);
+    } else if (upload->fCPUPixels.tryAlloc(stagedInfo)) {
+        upload->fPixels = upload->fCPUPixels;
+    } else {
+        return nullptr;
+    }
+    if (!pixmap.readPixels(upload->fPixels)) {
+        return nullptr;
+    }
+    return upload;
+}
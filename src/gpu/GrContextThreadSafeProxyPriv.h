@@ -9,6 +9,7 @@
 #define GrContextThreadSafeProxyPriv_DEFINED
 
 #include "GrContextThreadSafeProxy.h"
+#include "GrStagedUpload.h"
 
 /**
  * Class that adds methods to GrContextThreadSafeProxy that are only intended for use internal to
@@ -25,6 +26,16 @@ public:
     GrBackendApi backend() const { return fProxy->fBackend; }
     sk_sp<GrSkSLFPFactoryCache> fpFactoryCache() const;
 
+    GrUploadStagingPool* uploadStagingPool() const { return fProxy->fUploadStagingPool.get(); }
+
+    /**
+     * Callable from any thread. Converts pixmap to the layout its texture would be uploaded from,
+     * writing it into one of the transfer buffers staged by GrContextPriv::stageUploadBuffers()
+     * when one is big enough, and into CPU memory otherwise. Returns null if the context can't
+     * make a texture of pixmap's color type.
+     */
+    std::unique_ptr<GrStagedUpload> stageUpload(const SkPixmap& pixmap) const;
+
 private:
     explicit GrContextThreadSafeProxyPriv(GrContextThreadSafeProxy* proxy) : fProxy(proxy) {}
     GrContextThreadSafeProxyPriv(const GrContextThreadSafeProxy&) = delete;
@@ -9,11 +9,14 @@
 
 #include "GrContext.h"
 #include "GrContextPriv.h"
+#include "GrGpu.h"
 #include "GrOnFlushResourceProvider.h"
 #include "GrOpFlushState.h"
 #include "GrRectanizer.h"
 #include "GrProxyProvider.h"
 #include "GrResourceProvider.h"
+#include "GrResourceProviderPriv.h"
+#include "GrShaderCaps.h"
 #include "GrSurfaceProxyPriv.h"
 #include "GrTexture.h"
 #include "GrTracing.h"
@@ -31,6 +34,27 @@ void GrDrawOpAtlas::instantiate(GrOnFlushResourceProvider* onFlushResourceProvid
         // All the atlas pages are now instantiated at flush time in the activeNewPage method.
         SkASSERT(fProxies[i] && fProxies[i]->isInstantiated());
     }
+
+    // Upload the plots that compact() moved since the last flush, before any op reads them.
+    if (fPlotsToUpload.count()) {
+        GrDeferredTextureUploadWritePixelsFn writePixels =
+                [onFlushResourceProvider](GrTextureProxy* proxy, int left, int top, int width,
+                                          int height, GrColorType colorType, const void* buffer,
+                                          size_t rowBytes) {
+                    return onFlushResourceProvider->writePixels(proxy, left, top, width, height,
+                                                                colorType, buffer, rowBytes);
+                };
+        for (const sk_sp<Plot>& plot : fPlotsToUpload) {
+            uint32_t pageIdx = plot->fPageIndex;
+            // Skip plots that were reset, replaced or deactivated after they were relocated.
+            if (pageIdx >= fNumActivePages || plot != fPages[pageIdx].fPlotArray[plot->index()] ||
+                plot->fDirtyRect.isEmpty()) {
+                continue;
+            }
+            plot->uploadToTexture(writePixels, fProxies[pageIdx].get());
+        }
+        fPlotsToUpload.reset();
+    }
 }
 
 std::unique_ptr<GrDrawOpAtlas> GrDrawOpAtlas::Make(GrProxyProvider* proxyProvider,
@@ -38,7 +62,8 @@ std::unique_ptr<GrDrawOpAtlas> GrDrawOpAtlas::Make(GrProxyProvider* proxyProvide
                                                    GrPixelConfig config, int width,
                                                    int height, int plotWidth, int plotHeight,
                                                    AllowMultitexturing allowMultitexturing,
-                                                   GrDrawOpAtlas::EvictionFunc func, void* data) {
+                                                   GrDrawOpAtlas::EvictionFunc func, void* data,
+                                                   GrDrawOpAtlas::RelocationFunc relocationFunc) {
     std::unique_ptr<GrDrawOpAtlas> atlas(new GrDrawOpAtlas(proxyProvider, format, config, width,
                                                            height, plotWidth, plotHeight,
                                                            allowMultitexturing));
@@ -46,7 +71,7 @@ std::unique_ptr<GrDrawOpAtlas> GrDrawOpAtlas::Make(GrProxyProvider* proxyProvide
         return nullptr;
     }
 
-    atlas->registerEvictionCallback(func, data);
+    atlas->registerEvictionCallback(func, data, relocationFunc);
     return atlas;
 }
 
@@ -179,6 +204,16 @@ void GrDrawOpAtlas::Plot::resetRects() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Multitextured atlases use up to half of the fragment samplers, which leaves the rest to the
+// paint, but always get the four pages they used to be limited to.
+static uint32_t max_pages(const GrCaps* caps, GrDrawOpAtlas::AllowMultitexturing allow) {
+    if (GrDrawOpAtlas::AllowMultitexturing::kNo == allow) {
+        return 1;
+    }
+    int maxSamplers = caps->shaderCaps()->maxFragmentSamplers();
+    return SkTMin(GrDrawOpAtlas::kMaxMultitexturePages, SkTMax(4, maxSamplers / 2));
+}
+
 GrDrawOpAtlas::GrDrawOpAtlas(GrProxyProvider* proxyProvider, const GrBackendFormat& format,
                              GrPixelConfig config, int width, int height,
                              int plotWidth, int plotHeight, AllowMultitexturing allowMultitexturing)
@@ -190,7 +225,7 @@ GrDrawOpAtlas::GrDrawOpAtlas(GrProxyProvider* proxyProvider, const GrBackendForm
         , fPlotHeight(plotHeight)
         , fAtlasGeneration(kInvalidAtlasGeneration + 1)
         , fPrevFlushToken(GrDeferredUploadToken::AlreadyFlushedToken())
-        , fMaxPages(AllowMultitexturing::kYes == allowMultitexturing ? kMaxMultitexturePages : 1)
+        , fMaxPages(max_pages(proxyProvider->caps(), allowMultitexturing))
         , fNumActivePages(0) {
     int numPlotsX = width/plotWidth;
     int numPlotsY = height/plotHeight;
@@ -334,6 +369,8 @@ GrDrawOpAtlas::ErrorCode GrDrawOpAtlas::addToAtlas(GrResourceProvider* resourceP
     // continue past this branch and prepare an inline upload that will occur after the enqueued
     // draw which references the plot's pre-upload content.
     if (!plot) {
+        resourceProvider->priv().gpu()->stats()->incAtlasFlushes();
+        ++resourceProvider->priv().gpu()->frameStats()->fAtlasFlushes;
         return ErrorCode::kTryAgain;
     }
 
@@ -477,15 +514,21 @@ void GrDrawOpAtlas::compact(GrDeferredUploadToken startTokenForNextFlush) {
         // large need.
         if (availablePlots.count() && usedPlots && usedPlots <= fNumPlots / 4) {
             plotIter.init(fPages[lastPageIndex].fPlotList, PlotList::Iter::kHead_IterStart);
+            bool canRelocate = this->canRelocate();
             while (Plot* plot = plotIter.get()) {
                 // If this plot was used recently
                 if (plot->flushesSinceLastUsed() <= kRecentlyUsedCount) {
-                    // See if there's room in an earlier page and if so evict.
+                    // See if there's room in an earlier page and if so move the plot's data there,
+                    // or evict it if the clients can't follow the move.
                     // We need to be somewhat harsh here so that a handful of plots that are
                     // consistently in use don't end up locking the page in memory.
                     if (availablePlots.count() > 0) {
-                        this->processEvictionAndResetRects(plot);
-                        this->processEvictionAndResetRects(availablePlots.back());
+                        if (canRelocate && plot->fData) {
+                            this->relocatePlot(plot, availablePlots.back());
+                        } else {
+                            this->processEvictionAndResetRects(plot);
+                            this->processEvictionAndResetRects(availablePlots.back());
+                        }
                         availablePlots.pop_back();
                         --usedPlots;
                     }
@@ -511,6 +554,48 @@ void GrDrawOpAtlas::compact(GrDeferredUploadToken startTokenForNextFlush) {
     fPrevFlushToken = startTokenForNextFlush;
 }
 
+bool GrDrawOpAtlas::canRelocate() const {
+    for (int i = 0; i < fEvictionCallbacks.count(); i++) {
+        if (!fEvictionCallbacks[i].fRelocationFunc) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void GrDrawOpAtlas::relocatePlot(Plot* plot, Plot* dst) {
+    SkASSERT(plot->fWidth == dst->fWidth && plot->fHeight == dst->fHeight);
+    SkASSERT(plot->fPageIndex != dst->fPageIndex);
+    this->processEvictionAndResetRects(dst);
+
+    AtlasID oldID = plot->id();
+    GrDeferredUploadToken lastUse = plot->lastUseToken();
+    int flushesSinceLastUse = plot->flushesSinceLastUsed();
+
+    // Trade backing stores, so dst gets plot's data and subimage layout while plot is left with
+    // dst's empty ones. Resetting plot then retires its old ID.
+    std::swap(plot->fData, dst->fData);
+    std::swap(plot->fRects, dst->fRects);
+    plot->resetRects();
+
+    // The whole plot is uploaded to its new location by the next call to instantiate().
+    dst->fDirtyRect.setXYWH(0, 0, dst->fWidth, dst->fHeight);
+    SkDEBUGCODE(dst->fDirty = true;)
+    dst->setLastUseToken(lastUse);
+    dst->fFlushesSinceLastUse = flushesSinceLastUse;
+    this->makeMRU(dst, dst->fPageIndex);
+    fPlotsToUpload.push_back(sk_ref_sp(dst));
+
+    AtlasID newID = dst->id();
+    int dx = dst->fOffset.fX - plot->fOffset.fX;
+    int dy = dst->fOffset.fY - plot->fOffset.fY;
+    for (int i = 0; i < fEvictionCallbacks.count(); i++) {
+        (*fEvictionCallbacks[i].fRelocationFunc)(oldID, newID, dx, dy,
+                                                 fEvictionCallbacks[i].fData);
+    }
+    ++fAtlasGeneration;
+}
+
 bool GrDrawOpAtlas::createPages(GrProxyProvider* proxyProvider) {
     SkASSERT(SkIsPow2(fTextureWidth) && SkIsPow2(fTextureHeight));
 
@@ -652,4 +737,5 @@ SkISize GrDrawOpAtlasConfig::plotDimensions(GrMaskFormat type) const {
     }
 }
 
+constexpr int GrDrawOpAtlas::kMaxMultitexturePages;
 constexpr int GrDrawOpAtlasConfig::kMaxAtlasDim;
@@ -15,6 +15,7 @@
 #include "SkSize.h"
 #include "SkTDArray.h"
 #include "SkTInternalLList.h"
+#include "SkTo.h"
 
 #include "ops/GrDrawOp.h"
 
@@ -46,17 +47,23 @@ class GrRectanizer;
  * solution is to make the client a subclass of GrOnFlushCallbackObject, register it with the
  * GrContext via addOnFlushCallbackObject(), and the client's postFlush() method calls compact()
  * and passes in the given GrDrawUploadToken.
+ *
+ * If every client registered a RelocationFunc, compaction moves the data of plots that are still in
+ * use out of a sparsely used last page into aged out plots of earlier pages, rather than evicting
+ * it. The moved data comes from the plot's CPU backing store and is uploaded to its new location by
+ * instantiate() at the start of the next flush, so the clients never have to regenerate it.
  */
 class GrDrawOpAtlas {
-private:
-    static constexpr auto kMaxMultitexturePages = 4;
-
-
 public:
     /** Is the atlas allowed to use more than one texture? */
     enum class AllowMultitexturing : bool { kNo, kYes };
 
-    static constexpr int kMaxPlots = 32; // restricted by the fPlotAlreadyUpdated bitfield
+    // The most pages an atlas can have. This is restricted by the page index bits packed into the
+    // texel coordinates (see PackU() and PackV()), and the geometry processors that read from the
+    // atlas must be able to sample this many textures.
+    static constexpr int kMaxMultitexturePages = 8;
+
+    static constexpr int kMaxPlots = 64; // restricted by the fPlotAlreadyUpdated bitfield
                                          // in BulkUseTokenUpdater
 
     /**
@@ -74,6 +81,15 @@ public:
      */
     typedef void (*EvictionFunc)(GrDrawOpAtlas::AtlasID, void*);
 
+    /**
+     * A function pointer for use as a callback during compaction. Whenever GrDrawOpAtlas moves the
+     * data of a plot, it will call all of the registered listeners with the plot's old and new
+     * AtlasIDs. Every subimage that had the old ID now has the new ID, and its location in the
+     * backing texture is offset by (dx, dy).
+     */
+    typedef void (*RelocationFunc)(GrDrawOpAtlas::AtlasID oldID, GrDrawOpAtlas::AtlasID newID,
+                                   int dx, int dy, void*);
+
     /**
      * Returns a GrDrawOpAtlas. This function can be called anywhere, but the returned atlas
      * should only be used inside of GrMeshDrawOp::onPrepareDraws.
@@ -89,6 +105,8 @@ public:
      *                          evict data
      *  @param data             User supplied data which will be passed into func whenever an
      *                          eviction occurs
+     *  @param relocationFunc   An optional function which will be called whenever compaction
+     *                          moves data, with the same user supplied data
      *  @return                 An initialized GrDrawOpAtlas, or nullptr if creation fails
      */
     static std::unique_ptr<GrDrawOpAtlas> Make(GrProxyProvider*,
@@ -97,7 +115,9 @@ public:
                                                int width, int height,
                                                int plotWidth, int plotHeight,
                                                AllowMultitexturing allowMultitexturing,
-                                               GrDrawOpAtlas::EvictionFunc func, void* data);
+                                               GrDrawOpAtlas::EvictionFunc func, void* data,
+                                               GrDrawOpAtlas::RelocationFunc relocationFunc
+                                                                                    = nullptr);
 
     /**
      * Adds a width x height subimage to the atlas. Upon success it returns 'kSucceeded' and returns
@@ -152,9 +172,11 @@ public:
         plot->setLastUseToken(token);
     }
 
-    inline void registerEvictionCallback(EvictionFunc func, void* userData) {
+    inline void registerEvictionCallback(EvictionFunc func, void* userData,
+                                         RelocationFunc relocationFunc = nullptr) {
         EvictionData* data = fEvictionCallbacks.append();
         data->fFunc = func;
+        data->fRelocationFunc = relocationFunc;
         data->fData = userData;
     }
 
@@ -162,8 +184,7 @@ public:
 
     /**
      * A class which can be handed back to GrDrawOpAtlas for updating last use tokens in bulk.  The
-     * current max number of plots per page the GrDrawOpAtlas can handle is 32. If in the future
-     * this is insufficient then we can move to a 64 bit int.
+     * current max number of plots per page the GrDrawOpAtlas can handle is 64.
      */
     class BulkUseTokenUpdater {
     public:
@@ -204,14 +225,13 @@ public:
 
         void set(int pageIdx, int index) {
             SkASSERT(!this->find(pageIdx, index));
-            fPlotAlreadyUpdated[pageIdx] |= (1 << index);
+            fPlotAlreadyUpdated[pageIdx] |= (uint64_t(1) << index);
             fPlotsToUpdate.push_back(PlotData(pageIdx, index));
         }
 
         static constexpr int kMinItems = 4;
         SkSTArray<kMinItems, PlotData, true> fPlotsToUpdate;
-        uint32_t fPlotAlreadyUpdated[kMaxMultitexturePages]; // TODO: increase this to uint64_t
-                                                             //       to allow more plots per page
+        uint64_t fPlotAlreadyUpdated[kMaxMultitexturePages];
 
         friend class GrDrawOpAtlas;
     };
@@ -236,6 +256,23 @@ public:
         return id & 0xff;
     }
 
+    /**
+     * Subimages' texel coordinates carry their page index in their low bits: the top two bits of
+     * the index are in u and the bottom bit is in v. append_index_uv_varyings() in
+     * GrAtlasedShaderHelpers.h unpacks them in the vertex shader.
+     */
+    static uint16_t PackU(int u, uint32_t pageIdx) {
+        SkASSERT(pageIdx < kMaxMultitexturePages);
+        return SkToU16(u << 2 | (pageIdx >> 1));
+    }
+    static uint16_t PackV(int v, uint32_t pageIdx) {
+        SkASSERT(pageIdx < kMaxMultitexturePages);
+        return SkToU16(v << 1 | (pageIdx & 0x1));
+    }
+    static int UnpackU(uint16_t u) { return u >> 2; }
+    static int UnpackV(uint16_t v) { return v >> 1; }
+    static uint32_t UnpackPageIndex(uint16_t u, uint16_t v) { return (u & 0x3) << 1 | (v & 0x1); }
+
     void instantiate(GrOnFlushResourceProvider*);
 
     uint32_t maxPages() const {
@@ -384,6 +421,10 @@ private:
         plot->resetRects();
     }
 
+    bool canRelocate() const;
+    // Moves the data of plot into dst, which must hold no data that is still in use.
+    void relocatePlot(Plot* plot, Plot* dst);
+
     GrBackendFormat       fFormat;
     GrPixelConfig         fPixelConfig;
     int                   fTextureWidth;
@@ -398,10 +439,13 @@ private:
 
     struct EvictionData {
         EvictionFunc fFunc;
+        RelocationFunc fRelocationFunc;
         void* fData;
     };
 
     SkTDArray<EvictionData> fEvictionCallbacks;
+    // Plots whose relocated data will be uploaded by the next call to instantiate()
+    SkTArray<sk_sp<Plot>> fPlotsToUpload;
 
     struct Page {
         // allocated array of Plots
@@ -7,13 +7,17 @@
 
 #include "GrDrawingManager.h"
 #include "GrBackendSemaphore.h"
+#include "GrClipMaskAtlas.h"
 #include "GrContext.h"
 #include "GrContextPriv.h"
+#include "GrFlushTimer.h"
 #include "GrGpu.h"
 #include "GrMemoryPool.h"
 #include "GrOnFlushResourceProvider.h"
 #include "GrOpList.h"
+#include "GrRenderTarget.h"
 #include "GrRenderTargetContext.h"
+#include "GrRenderTargetOpList.h"
 #include "GrRenderTargetProxy.h"
 #include "GrResourceAllocator.h"
 #include "GrResourceProvider.h"
@@ -27,8 +31,10 @@
 #include "GrTextureProxyPriv.h"
 #include "GrTracing.h"
 #include "SkDeferredDisplayList.h"
+#include "SkPromiseImageBatch.h"
 #include "SkSurface_Gpu.h"
 #include "SkTTopoSort.h"
+#include "SkTaskGroup.h"
 #include "ccpr/GrCoverageCountingPathRenderer.h"
 #include "text/GrTextContext.h"
 
@@ -94,6 +100,7 @@ void GrDrawingManager::OpListDAG::prepForFlush() {
     if (fSortOpLists) {
         SkDEBUGCODE(bool result =) SkTTopoSort<GrOpList, GrOpList::TopoSortTraits>(&fOpLists);
         SkASSERT(result);
+        this->mergeRenderTargetOpLists();
     }
 
 #ifdef SK_DEBUG
@@ -103,8 +110,13 @@ void GrDrawingManager::OpListDAG::prepForFlush() {
         GrRenderTargetOpList* prevOpList = fOpLists[0]->asRenderTargetOpList();
         for (int i = 1; i < fOpLists.count(); ++i) {
             GrRenderTargetOpList* curOpList = fOpLists[i]->asRenderTargetOpList();
+            if (curOpList && curOpList->isEmpty()) {
+                // Possibly merged into an earlier opList.
+                continue;
+            }
 
-            if (prevOpList && curOpList) {
+            // Retained opLists keep their own ops so they can't be merged.
+            if (prevOpList && curOpList && !prevOpList->isRetained() && !curOpList->isRetained()) {
                 SkASSERT(prevOpList->fTarget.get() != curOpList->fTarget.get());
             }
 
@@ -114,6 +126,48 @@ void GrDrawingManager::OpListDAG::prepForFlush() {
 #endif
 }
 
+void GrDrawingManager::OpListDAG::mergeRenderTargetOpLists() {
+    for (int i = 0; i < fOpLists.count(); ++i) {
+        GrRenderTargetOpList* dst = fOpLists[i] ? fOpLists[i]->asRenderTargetOpList() : nullptr;
+        if (!dst) {
+            continue;
+        }
+        GrSurfaceProxy* target = dst->fTarget.get();
+        // The opLists whose ops now execute as part of 'dst', and the ones being moved past.
+        SkSTArray<4, const GrOpList*, true> merged;
+        SkSTArray<8, const GrOpList*, true> skipped;
+        merged.push_back(dst);
+        for (int j = i + 1; j < fOpLists.count(); ++j) {
+            GrOpList* opList = fOpLists[j].get();
+            if (!opList) {
+                continue;
+            }
+            if (opList->fTarget.get() == target) {
+                // The writes of an opList on this target can't move past the ones it reads.
+                GrRenderTargetOpList* src = opList->asRenderTargetOpList();
+                bool canMove = SkToBool(src);
+                for (int k = 0; canMove && k < skipped.count(); ++k) {
+                    canMove = !opList->dependsOn(skipped[k]);
+                }
+                if (!canMove || !dst->appendOpsFrom(src)) {
+                    break;
+                }
+                merged.push_back(src);
+                continue;
+            }
+            // Later writes to the target can't move before an opList that reads it.
+            bool readsTarget = false;
+            for (int k = 0; !readsTarget && k < merged.count(); ++k) {
+                readsTarget = opList->dependsOn(merged[k]);
+            }
+            if (readsTarget) {
+                break;
+            }
+            skipped.push_back(opList);
+        }
+    }
+}
+
 void GrDrawingManager::OpListDAG::closeAll(const GrCaps* caps) {
     for (int i = 0; i < fOpLists.count(); ++i) {
         if (fOpLists[i]) {
@@ -180,6 +234,10 @@ void GrDrawingManager::cleanup() {
     fSoftwarePathRenderer = nullptr;
 
     fOnFlushCBObjects.reset();
+    fClipMaskAtlas = nullptr;
+
+    fVertexBufferRing = nullptr;
+    fIndexBufferRing = nullptr;
 }
 
 GrDrawingManager::~GrDrawingManager() {
@@ -202,6 +260,9 @@ void GrDrawingManager::freeGpuResources() {
     // a path renderer may be holding onto resources
     fPathRendererChain = nullptr;
     fSoftwarePathRenderer = nullptr;
+
+    fVertexBufferRing = nullptr;
+    fIndexBufferRing = nullptr;
 }
 
 // MDB TODO: make use of the 'proxy' parameter.
@@ -234,9 +295,17 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy*,
         fVertexBufferSpace.reset(new char[GrBufferAllocPool::kDefaultBufferSize]());
         fIndexBufferSpace.reset(new char[GrBufferAllocPool::kDefaultBufferSize]());
     }
+    if (!fVertexBufferRing && gpu->caps()->persistentlyMappedBufferSupport()) {
+        fVertexBufferRing.reset(new GrBufferRing(gpu, kVertex_GrBufferType));
+        fIndexBufferRing.reset(new GrBufferRing(gpu, kIndex_GrBufferType));
+    }
 
     GrOpFlushState flushState(gpu, fContext->contextPriv().resourceProvider(), &fTokenTracker,
-                              fVertexBufferSpace.get(), fIndexBufferSpace.get());
+                              fVertexBufferSpace.get(), fIndexBufferSpace.get(),
+                              fVertexBufferRing.get(), fIndexBufferRing.get());
+    flushState.setFlushTimer(fFlushTimer);
+    // Ends before finishFlush() so that, in Vulkan, it ends in the command buffer that submits.
+    gpu->beginTraceSpan("GrDrawingManager::flush");
 
     GrOnFlushResourceProvider onFlushProvider(this);
     // TODO: AFAICT the only reason fFlushState is on GrDrawingManager rather than on the
@@ -244,6 +313,7 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy*,
 
     // Prepare any onFlush op lists (e.g. atlases).
     if (!fOnFlushCBObjects.empty()) {
+        GrFlushTimer::AutoPhase timePhase(fFlushTimer, GrFlushTimer::Phase::kPrepare);
         fDAG.gatherIDs(&fFlushingOpListIDs);
 
         SkSTArray<4, sk_sp<GrRenderTargetContext>> renderTargetContexts;
@@ -259,7 +329,7 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy*,
 #ifdef SK_DEBUG
                 // OnFlush callbacks are already invoked during flush, and are therefore expected to
                 // handle resource allocation & usage on their own. (No deferred or lazy proxies!)
-                onFlushOpList->visitProxies_debugOnly([](GrSurfaceProxy* p) {
+                onFlushOpList->visitProxies([](GrSurfaceProxy* p) {
                     SkASSERT(!p->asTextureProxy() || !p->asTextureProxy()->texPriv().isDeferred());
                     SkASSERT(GrSurfaceProxy::LazyState::kNot == p->lazyInstantiationState());
                 });
@@ -311,6 +381,8 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy*,
                 flushed = true;
             }
         }
+        gpu->stats()->recordTransientBytes(alloc.peakTransientBytes(),
+                                           alloc.allocatedTransientBytes());
     }
 
 #ifdef SK_DEBUG
@@ -332,7 +404,13 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy*,
     opMemoryPool->isEmpty();
 #endif
 
-    GrSemaphoresSubmitted result = gpu->finishFlush(numSemaphores, backendSemaphores);
+    gpu->endTraceSpan();
+
+    GrSemaphoresSubmitted result;
+    {
+        GrFlushTimer::AutoPhase timePhase(fFlushTimer, GrFlushTimer::Phase::kSubmit);
+        result = gpu->finishFlush(numSemaphores, backendSemaphores);
+    }
 
     flushState.deinstantiateProxyTracker()->deinstantiateAllProxies();
 
@@ -350,6 +428,37 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy*,
     return result;
 }
 
+void GrDrawingManager::regenerateSampledMipMaps(GrOpList* opList, GrGpu* gpu) {
+    GrRenderTargetOpList* rtOpList = opList->asRenderTargetOpList();
+    if (!rtOpList || !gpu->caps()->mipMapSupport()) {
+        return;
+    }
+    // Earlier opLists in this flush may have dirtied these, so this has to wait until just before
+    // the opList executes.
+    GrSurface* target = opList->fTarget.get() ? opList->fTarget.get()->peekSurface() : nullptr;
+    SkSTArray<16, GrTexture*> textures;
+    rtOpList->visitProxies([&](GrSurfaceProxy* proxy) {
+        GrTextureProxy* texProxy = proxy->asTextureProxy();
+        GrTexture* texture = texProxy ? texProxy->peekTexture() : nullptr;
+        if (!texture || texture == target || texture->readOnly() ||
+            texture->texturePriv().mipMapped() == GrMipMapped::kNo ||
+            !texture->texturePriv().mipMapsAreDirty()) {
+            return;
+        }
+        // Leave MSAA textures that still need a resolve to the draws that bind them.
+        if (texture->asRenderTarget() && texture->asRenderTarget()->needsResolve()) {
+            return;
+        }
+        if (std::find(textures.begin(), textures.end(), texture) == textures.end()) {
+            textures.push_back(texture);
+        }
+    });
+    // A single texture gains nothing from batching, so leave it to the draw that samples it.
+    if (textures.count() > 1) {
+        gpu->regenerateMipMapLevels(textures.begin(), textures.count());
+    }
+}
+
 bool GrDrawingManager::executeOpLists(int startIndex, int stopIndex, GrOpFlushState* flushState,
                                       int* numOpListsExecuted) {
     SkASSERT(startIndex <= stopIndex && stopIndex <= fDAG.numOpLists());
@@ -367,6 +476,31 @@ bool GrDrawingManager::executeOpLists(int startIndex, int stopIndex, GrOpFlushSt
     GrResourceProvider* resourceProvider = fContext->contextPriv().resourceProvider();
     bool anyOpListsExecuted = false;
 
+    if (fFlushTimer) {
+        fFlushTimer->beginPhase(GrFlushTimer::Phase::kPrepare);
+    }
+
+    // Let the ops do their CPU-only work first. That work doesn't depend on other opLists, so
+    // when we have an executor we spread it across threads, one opList per task. Everything that
+    // touches the flush state or GPU resources still happens serially on this thread below.
+    {
+        SkSTArray<16, GrOpList*> opLists;
+        for (int i = startIndex; i < stopIndex; ++i) {
+            if (fDAG.opList(i)) {
+                opLists.push_back(fDAG.opList(i));
+            }
+        }
+        SkTaskGroup* taskGroup = fContext->contextPriv().getTaskGroup();
+        if (taskGroup && opLists.count() > 1) {
+            taskGroup->batch(opLists.count(), [&opLists](int i) { opLists[i]->prePrepare(); });
+            taskGroup->wait();
+        } else {
+            for (GrOpList* opList : opLists) {
+                opList->prePrepare();
+            }
+        }
+    }
+
     for (int i = startIndex; i < stopIndex; ++i) {
         if (!fDAG.opList(i)) {
              continue;
@@ -396,6 +530,11 @@ bool GrDrawingManager::executeOpLists(int startIndex, int stopIndex, GrOpFlushSt
     // Upload all data to the GPU
     flushState->preExecuteDraws();
 
+    if (fFlushTimer) {
+        fFlushTimer->endPhase(GrFlushTimer::Phase::kPrepare);
+        fFlushTimer->beginPhase(GrFlushTimer::Phase::kExecute);
+    }
+
     // For Vulkan, if we have too many oplists to be flushed we end up allocating a lot of resources
     // for each command buffer associated with the oplists. If this gets too large we can cause the
     // devices to go OOM. In practice we usually only hit this case in our tests, but to be safe we
@@ -424,6 +563,7 @@ bool GrDrawingManager::executeOpLists(int startIndex, int stopIndex, GrOpFlushSt
             continue;
         }
 
+        this->regenerateSampledMipMaps(fDAG.opList(i), flushState->gpu());
         if (fDAG.opList(i)->execute(flushState)) {
             anyOpListsExecuted = true;
         }
@@ -434,6 +574,10 @@ bool GrDrawingManager::executeOpLists(int startIndex, int stopIndex, GrOpFlushSt
         }
     }
 
+    if (fFlushTimer) {
+        fFlushTimer->endPhase(GrFlushTimer::Phase::kExecute);
+    }
+
     SkASSERT(!flushState->commandBuffer());
     SkASSERT(fTokenTracker.nextDrawToken() == fTokenTracker.nextTokenToFlush());
 
@@ -503,13 +647,40 @@ void GrDrawingManager::moveOpListsToDDL(SkDeferredDisplayList* ddl) {
         }
     }
 
+    // Only render target opLists can be retained, and CCPR's atlases are built for each flush.
+    if (ddl->fRetained) {
+        ddl->fRetained = ddl->fPendingPaths.empty();
+        for (int i = 0; ddl->fRetained && i < ddl->fOpLists.count(); ++i) {
+            ddl->fRetained = SkToBool(ddl->fOpLists[i]->asRenderTargetOpList());
+        }
+    }
+    if (ddl->fRetained) {
+        for (const sk_sp<GrOpList>& opList : ddl->fOpLists) {
+            opList->makeRetained();
+        }
+    }
+
     SkDEBUGCODE(this->validate());
 }
 
-void GrDrawingManager::copyOpListsFromDDL(const SkDeferredDisplayList* ddl,
+bool GrDrawingManager::copyOpListsFromDDL(const SkDeferredDisplayList* ddl,
                                           GrRenderTargetProxy* newDest) {
     SkDEBUGCODE(this->validate());
 
+    for (const sk_sp<GrOpList>& opList : ddl->fOpLists) {
+        // OpLists that weren't retained dropped their ops and targets when they were flushed.
+        GrSurfaceProxy* target = opList->fTarget.get();
+        if (!target) {
+            return false;
+        }
+        // A retained DDL keeps the render target it was first drawn into. Its opLists hold
+        // pending writes on it, so it can't be switched to another destination.
+        if (target->priv().hasMultipleUseLazyCallback() &&
+            target->peekSurface() != newDest->peekSurface()) {
+            return false;
+        }
+    }
+
     if (fActiveOpList) {
         // This is  a temporary fix for the partial-MDB world. In that world we're not
         // reordering so ops that (in the single opList world) would've just glommed onto the
@@ -523,6 +694,11 @@ void GrDrawingManager::copyOpListsFromDDL(const SkDeferredDisplayList* ddl,
     // The lazy proxy that references it (in the copied opLists) will steal its GrTexture.
     ddl->fLazyProxyData->fReplayDest = newDest;
 
+    if (ddl->fPromiseImageBatch) {
+        // Get the textures of all the DDL's promise images before any of them are instantiated.
+        ddl->fPromiseImageBatch->fulfill();
+    }
+
     if (ddl->fPendingPaths.size()) {
         GrCoverageCountingPathRenderer* ccpr = this->getCoverageCountingPathRenderer();
 
@@ -532,6 +708,7 @@ void GrDrawingManager::copyOpListsFromDDL(const SkDeferredDisplayList* ddl,
     fDAG.add(ddl->fOpLists);
 
     SkDEBUGCODE(this->validate());
+    return true;
 }
 
 #ifdef SK_DEBUG
@@ -683,6 +860,15 @@ GrPathRenderer* GrDrawingManager::getSoftwarePathRenderer() {
     return fSoftwarePathRenderer.get();
 }
 
+GrClipMaskAtlas* GrDrawingManager::getClipMaskAtlas() {
+    if (!fClipMaskAtlas) {
+        fClipMaskAtlas.reset(new GrClipMaskAtlas(fContext->contextPriv().proxyProvider(),
+                                                 fContext->contextPriv().getTaskGroup()));
+        this->addOnFlushCallbackObject(fClipMaskAtlas.get());
+    }
+    return fClipMaskAtlas.get();
+}
+
 GrCoverageCountingPathRenderer* GrDrawingManager::getCoverageCountingPathRenderer() {
     if (!fPathRendererChain) {
         fPathRendererChain.reset(new GrPathRendererChain(fContext, fOptionsForPathRendererChain));
@@ -15,9 +15,12 @@
 #include "SkTArray.h"
 #include "text/GrTextContext.h"
 
+class GrClipMaskAtlas;
 class GrContext;
 class GrCoverageCountingPathRenderer;
+class GrFlushTimer;
 class GrOnFlushCallbackObject;
+class GrBufferRing;
 class GrOpFlushState;
 class GrRenderTargetContext;
 class GrRenderTargetProxy;
@@ -68,6 +71,9 @@ public:
     // supported and turned on.
     GrCoverageCountingPathRenderer* getCoverageCountingPathRenderer();
 
+    // Returns the atlas that this flush's small software clip masks are packed into.
+    GrClipMaskAtlas* getClipMaskAtlas();
+
     void flushIfNecessary();
 
     static bool ProgramUnitTest(GrContext* context, int maxStages, int maxLevels);
@@ -79,8 +85,12 @@ public:
     void addOnFlushCallbackObject(GrOnFlushCallbackObject*);
     void testingOnly_removeOnFlushCallbackObject(GrOnFlushCallbackObject*);
 
+    // The timer isn't owned. Pass null to stop timing.
+    void setFlushTimer(GrFlushTimer* flushTimer) { fFlushTimer = flushTimer; }
+
     void moveOpListsToDDL(SkDeferredDisplayList* ddl);
-    void copyOpListsFromDDL(const SkDeferredDisplayList*, GrRenderTargetProxy* newDest);
+    // Returns false if the DDL was drawn and flushed before and could not be retained.
+    bool copyOpListsFromDDL(const SkDeferredDisplayList*, GrRenderTargetProxy* newDest);
 
 private:
     // This class encapsulates maintenance and manipulation of the drawing manager's DAG of opLists.
@@ -127,6 +137,10 @@ private:
         bool sortingOpLists() const { return fSortOpLists; }
 
     private:
+        // Moves the ops of each render target opList to an earlier opList on the same target when
+        // the opLists in between don't depend on either, so they share a render pass.
+        void mergeRenderTargetOpLists();
+
         SkTArray<sk_sp<GrOpList>> fOpLists;
         bool                      fSortOpLists;
     };
@@ -142,6 +156,10 @@ private:
     // return true if any opLists were actually executed; false otherwise
     bool executeOpLists(int startIndex, int stopIndex, GrOpFlushState*, int* numOpListsExecuted);
 
+    // Regenerates, in one batch, the dirty mip levels of every texture the opList samples, rather
+    // than one texture at a time as each draw binds them.
+    void regenerateSampledMipMaps(GrOpList*, GrGpu*);
+
     GrSemaphoresSubmitted flush(GrSurfaceProxy* proxy,
                                 int numSemaphores = 0,
                                 GrBackendSemaphore backendSemaphores[] = nullptr);
@@ -161,6 +179,9 @@ private:
 
     std::unique_ptr<char[]>           fVertexBufferSpace;
     std::unique_ptr<char[]>           fIndexBufferSpace;
+    // Only created when GrCaps::persistentlyMappedBufferSupport() is true.
+    std::unique_ptr<GrBufferRing>     fVertexBufferRing;
+    std::unique_ptr<GrBufferRing>     fIndexBufferRing;
     // In debug builds we guard against improper thread handling
     GrSingleOwner*                    fSingleOwner;
 
@@ -176,12 +197,14 @@ private:
 
     std::unique_ptr<GrPathRendererChain> fPathRendererChain;
     sk_sp<GrSoftwarePathRenderer>     fSoftwarePathRenderer;
+    std::unique_ptr<GrClipMaskAtlas>  fClipMaskAtlas;
 
     GrTokenTracker                    fTokenTracker;
     bool                              fFlushing;
     bool                              fReduceOpListSplitting;
 
     SkTArray<GrOnFlushCallbackObject*> fOnFlushCBObjects;
+    GrFlushTimer*                      fFlushTimer = nullptr;
 };
 
 #endif
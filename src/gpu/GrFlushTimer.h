@@ -0,0 +1,60 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrFlushTimer_DEFINED
+#define GrFlushTimer_DEFINED
+
+#include "SkTypes.h"
+
+class GrOp;
+
+/**
+ * Lets a tool attribute the time of a flush. When one is set with GrContextPriv::setFlushTimer(),
+ * the drawing manager brackets each phase of a flush with it, and the render target opLists
+ * bracket each op chain they execute. The timer is called on the flushing thread.
+ */
+class GrFlushTimer {
+public:
+    enum class Phase {
+        kPrepare,  //<! the ops' CPU work and uploads, including that of the onFlush callbacks.
+        kExecute,  //<! encoding the ops into command buffers.
+        kSubmit,   //<! handing the command buffers to the GPU.
+    };
+
+    virtual ~GrFlushTimer() {}
+
+    virtual void beginPhase(Phase) = 0;
+    virtual void endPhase(Phase) = 0;
+
+    /**
+     * Called around the execution of an op chain, which is identified by its head op. On backends
+     * that issue commands as they are encoded (GL), the GPU work of the chain is issued between
+     * the two calls. Elsewhere only its CPU encoding is.
+     */
+    virtual void beginOp(const GrOp& head, uint32_t opListID) = 0;
+    virtual void endOp(const GrOp& head, uint32_t opListID) = 0;
+
+    class AutoPhase {
+    public:
+        AutoPhase(GrFlushTimer* timer, Phase phase) : fTimer(timer), fPhase(phase) {
+            if (fTimer) {
+                fTimer->beginPhase(fPhase);
+            }
+        }
+        ~AutoPhase() {
+            if (fTimer) {
+                fTimer->endPhase(fPhase);
+            }
+        }
+
+    private:
+        GrFlushTimer* fTimer;
+        Phase         fPhase;
+    };
+};
+
+#endif
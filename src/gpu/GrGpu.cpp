@@ -28,6 +28,7 @@
 #include "GrTexturePriv.h"
 #include "GrTextureProxyPriv.h"
 #include "GrTracing.h"
+#include "SkEventTracer.h"
 #include "SkJSONWriter.h"
 #include "SkMathPriv.h"
 
@@ -102,6 +103,18 @@ bool GrGpu::IsACopyNeededForMips(const GrCaps* caps, const GrTextureProxy* texPr
     return false;
 }
 
+// The bytes of pixels in a write of mip levels, which may have row padding that isn't counted.
+static size_t texels_size(const GrMipLevel texels[], int mipLevelCount, int width, int height,
+                          size_t bpp) {
+    size_t size = 0;
+    for (int i = 0; i < mipLevelCount; ++i) {
+        if (texels[i].fPixels) {
+            size += (size_t)SkTMax(width >> i, 1) * SkTMax(height >> i, 1) * bpp;
+        }
+    }
+    return size;
+}
+
 sk_sp<GrTexture> GrGpu::createTexture(const GrSurfaceDesc& origDesc, SkBudgeted budgeted,
                                       const GrMipLevel texels[], int mipLevelCount) {
     GR_CREATE_TRACE_MARKER_CONTEXT("GrGpu", "createTexture", fContext);
@@ -137,6 +150,8 @@ sk_sp<GrTexture> GrGpu::createTexture(const GrSurfaceDesc& origDesc, SkBudgeted
         if (mipLevelCount) {
             if (texels[0].fPixels) {
                 fStats.incTextureUploads();
+                fFrameStats.fBytesUploaded += texels_size(texels, mipLevelCount, desc.fWidth,
+                                                          desc.fHeight, GrBytesPerPixel(desc.fConfig));
             }
         }
     }
@@ -297,6 +312,8 @@ bool GrGpu::writePixels(GrSurface* surface, int left, int top, int width, int he
         SkIRect rect = SkIRect::MakeXYWH(left, top, width, height);
         this->didWriteToSurface(surface, kTopLeft_GrSurfaceOrigin, &rect, mipLevelCount);
         fStats.incTextureUploads();
+        fFrameStats.fBytesUploaded += texels_size(texels, mipLevelCount, width, height,
+                                                  GrColorTypeBytesPerPixel(srcColorType));
         return true;
     }
     return false;
@@ -325,7 +342,34 @@ bool GrGpu::transferPixels(GrTexture* texture, int left, int top, int width, int
         SkIRect rect = SkIRect::MakeXYWH(left, top, width, height);
         this->didWriteToSurface(texture, kTopLeft_GrSurfaceOrigin, &rect);
         fStats.incTransfersToTexture();
+        fFrameStats.fBytesUploaded += rowBytes * height;
+
+        return true;
+    }
+    return false;
+}
+
+bool GrGpu::transferPixelsFrom(GrSurface* surface, int left, int top, int width, int height,
+                               GrColorType bufferColorType, GrBuffer* transferBuffer,
+                               size_t offset) {
+    SkASSERT(surface);
+    SkASSERT(transferBuffer);
+
+    // We require that the read region is contained in the surface
+    SkIRect subRect = SkIRect::MakeXYWH(left, top, width, height);
+    SkIRect bounds = SkIRect::MakeWH(surface->width(), surface->height());
+    if (!bounds.contains(subRect)) {
+        return false;
+    }
+
+    if (GrPixelConfigIsCompressed(surface->config())) {
+        return false;
+    }
 
+    this->handleDirtyContext();
+    if (this->onTransferPixelsFrom(surface, left, top, width, height, bufferColorType,
+                                   transferBuffer, offset)) {
+        fStats.incTransfersFromSurface();
         return true;
     }
     return false;
@@ -347,6 +391,38 @@ bool GrGpu::regenerateMipMapLevels(GrTexture* texture) {
     return false;
 }
 
+void GrGpu::regenerateMipMapLevels(GrTexture* const textures[], int count) {
+    SkASSERT(this->caps()->mipMapSupport());
+    SkSTArray<16, GrTexture*> writable;
+    for (int i = 0; i < count; ++i) {
+        SkASSERT(textures[i]->texturePriv().mipMapped() == GrMipMapped::kYes);
+        SkASSERT(textures[i]->texturePriv().mipMapsAreDirty());
+        SkASSERT(!textures[i]->asRenderTarget() ||
+                 !textures[i]->asRenderTarget()->needsResolve());
+        if (!textures[i]->readOnly()) {
+            writable.push_back(textures[i]);
+        }
+    }
+    if (writable.empty()) {
+        return;
+    }
+    SkAutoSTMalloc<16, bool> regenerated(writable.count());
+    sk_bzero(regenerated.get(), writable.count() * sizeof(bool));
+    this->onBatchRegenerateMipMapLevels(writable.begin(), writable.count(), regenerated.get());
+    for (int i = 0; i < writable.count(); ++i) {
+        if (regenerated[i]) {
+            writable[i]->texturePriv().markMipMapsClean();
+        }
+    }
+}
+
+void GrGpu::onBatchRegenerateMipMapLevels(GrTexture* const textures[], int count,
+                                          bool regenerated[]) {
+    for (int i = 0; i < count; ++i) {
+        regenerated[i] = this->onRegenerateMipMapLevels(textures[i]);
+    }
+}
+
 void GrGpu::resolveRenderTarget(GrRenderTarget* target) {
     SkASSERT(target);
     this->handleDirtyContext();
@@ -378,6 +454,7 @@ void GrGpu::didWriteToSurface(GrSurface* surface, GrSurfaceOrigin origin, const
 GrSemaphoresSubmitted GrGpu::finishFlush(int numSemaphores,
                                          GrBackendSemaphore backendSemaphores[]) {
     this->stats()->incNumFinishFlushes();
+    ++fFrameStats.fFlushes;
     GrResourceProvider* resourceProvider = fContext->contextPriv().resourceProvider();
 
     if (this->caps()->fenceSyncSupport()) {
@@ -402,6 +479,26 @@ GrSemaphoresSubmitted GrGpu::finishFlush(int numSemaphores,
                                             : GrSemaphoresSubmitted::kNo;
 }
 
+void GrGpu::beginTraceSpan(const char* name) {
+    bool tracing;
+    TRACE_EVENT_CATEGORY_GROUP_ENABLED("skia.gpu", &tracing);
+    fTraceSpansTimed.push_back(tracing && this->onBeginTraceSpan(name));
+}
+
+void GrGpu::endTraceSpan() {
+    SkASSERT(!fTraceSpansTimed.empty());
+    if (fTraceSpansTimed.back()) {
+        this->onEndTraceSpan();
+    }
+    fTraceSpansTimed.pop_back();
+}
+
+void GrGpu::ReportTraceSpan(const char* name, uint64_t startedNsAgo, uint64_t durationNs) {
+    SkEventTracer* tracer = SkEventTracer::GetInstance();
+    tracer->addGpuEvent(tracer->getCategoryGroupEnabled(TRACE_CATEGORY_PREFIX "skia.gpu"), name,
+                        startedNsAgo, durationNs);
+}
+
 #ifdef SK_ENABLE_DUMP_GPU
 void GrGpu::dumpJSON(SkJSONWriter* writer) const {
     writer->beginObject();
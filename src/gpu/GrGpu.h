@@ -9,6 +9,7 @@
 #define GrGpu_DEFINED
 
 #include "GrCaps.h"
+#include "GrContext.h"
 #include "GrGpuCommandBuffer.h"
 #include "GrProgramDesc.h"
 #include "GrSwizzle.h"
@@ -23,7 +24,6 @@
 class GrBackendRenderTarget;
 class GrBackendSemaphore;
 class GrBuffer;
-class GrContext;
 struct GrContextOptions;
 class GrGLContext;
 class GrMesh;
@@ -39,6 +39,7 @@ class GrStencilAttachment;
 class GrStencilSettings;
 class GrSurface;
 class GrTexture;
+class GrTextureProxy;
 class SkJSONWriter;
 
 class GrGpu : public SkRefCnt {
@@ -153,6 +154,12 @@ public:
      */
     bool regenerateMipMapLevels(GrTexture*);
 
+    /**
+     * Regenerates the mip levels of several textures at once, so that backends can set up the
+     * work once and share barriers between them. Textures that fail stay dirty.
+     */
+    void regenerateMipMapLevels(GrTexture* const textures[], int count);
+
     /**
      * Reads a rectangle of pixels from a render target. No sRGB/linear conversions are performed.
      *
@@ -220,6 +227,27 @@ public:
                         GrColorType bufferColorType, GrBuffer* transferBuffer, size_t offset,
                         size_t rowBytes);
 
+    /**
+     * Starts copying the pixels in a rectangle of a surface into a buffer, without waiting for
+     * the copy to finish. The rows are tightly packed and in the surface's own orientation, so
+     * bottom-left origin surfaces produce rows bottom first. Insert a fence and wait for it before
+     * mapping the buffer.
+     *
+     * @param surface          The surface to read from.
+     * @param left             left edge of the rectangle to read (inclusive)
+     * @param top              top edge of the rectangle to read (inclusive)
+     * @param width            width of rectangle to read in pixels.
+     * @param height           height of rectangle to read in pixels.
+     * @param bufferColorType  the color type to write into the buffer
+     * @param transferBuffer   GrBuffer to write pixels to (type must be "kXferGpuToCpu")
+     * @param offset           offset from the start of the buffer
+     *
+     * @return false if the backend can't transfer from this surface, in which case callers should
+     *         fall back to readPixels().
+     */
+    bool transferPixelsFrom(GrSurface* surface, int left, int top, int width, int height,
+                            GrColorType bufferColorType, GrBuffer* transferBuffer, size_t offset);
+
     // After the client interacts directly with the 3D context state the GrGpu
     // must resync its internal state and assumptions about 3D context state.
     // Each time this occurs the GrGpu bumps a timestamp.
@@ -283,6 +311,25 @@ public:
      */
     virtual sk_sp<GrSemaphore> prepareTextureForCrossContextUsage(GrTexture*) = 0;
 
+    /**
+     * Brackets GPU work with timestamps so that the time the GPU spent on it shows up in the trace
+     * on a "GPU" track, next to the CPU events (see SkEventTracer::addGpuEvent()). 'name' should
+     * be that of the CPU scope the work was issued from, and must be a string literal. Spans nest.
+     * They do nothing unless the "skia.gpu" category is being traced and the backend can write
+     * timestamps. The results are reported once the GPU has finished, during a later flush.
+     */
+    void beginTraceSpan(const char* name);
+    void endTraceSpan();
+
+    class AutoTraceSpan {
+    public:
+        AutoTraceSpan(GrGpu* gpu, const char* name) : fGpu(gpu) { fGpu->beginTraceSpan(name); }
+        ~AutoTraceSpan() { fGpu->endTraceSpan(); }
+
+    private:
+        GrGpu* fGpu;
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     // Debugging and Stats
 
@@ -297,10 +344,17 @@ public:
             fTextureCreates = 0;
             fTextureUploads = 0;
             fTransfersToTexture = 0;
+            fTransfersFromSurface = 0;
             fStencilAttachmentCreates = 0;
             fNumDraws = 0;
             fNumFailedDraws = 0;
             fNumFinishFlushes = 0;
+            fSkippedStateChanges = 0;
+            fAtlasFlushes = 0;
+            fTransientPeakBytes = 0;
+            fTransientAllocatedBytes = 0;
+            fMaxTransientPeakBytes = 0;
+            fVertexUploadBytes = 0;
         }
 
         int renderTargetBinds() const { return fRenderTargetBinds; }
@@ -313,10 +367,33 @@ public:
         void incTextureUploads() { fTextureUploads++; }
         int transfersToTexture() const { return fTransfersToTexture; }
         void incTransfersToTexture() { fTransfersToTexture++; }
+        int transfersFromSurface() const { return fTransfersFromSurface; }
+        void incTransfersFromSurface() { fTransfersFromSurface++; }
         void incStencilAttachmentCreates() { fStencilAttachmentCreates++; }
         void incNumDraws() { fNumDraws++; }
         void incNumFailedDraws() { ++fNumFailedDraws; }
         void incNumFinishFlushes() { ++fNumFinishFlushes; }
+        // Counts backend calls that were not made because they would not have changed the state
+        // the backend already had.
+        int skippedStateChanges() const { return fSkippedStateChanges; }
+        void incSkippedStateChanges() { ++fSkippedStateChanges; }
+        // Counts draws that ops had to end early because a GrDrawOpAtlas was full.
+        int atlasFlushes() const { return fAtlasFlushes; }
+        void incAtlasFlushes() { ++fAtlasFlushes; }
+        // The GrResourceAllocator's peak and allocated transient surface memory for the last
+        // flush, and the largest peak of any flush.
+        size_t transientPeakBytes() const { return fTransientPeakBytes; }
+        size_t transientAllocatedBytes() const { return fTransientAllocatedBytes; }
+        size_t maxTransientPeakBytes() const { return fMaxTransientPeakBytes; }
+        void recordTransientBytes(size_t peak, size_t allocated) {
+            fTransientPeakBytes = peak;
+            fTransientAllocatedBytes = allocated;
+            fMaxTransientPeakBytes = SkTMax(fMaxTransientPeakBytes, peak);
+        }
+        // Counts the vertex and index bytes that GrDrawVerticesOp wrote for SkVertices. Draws of
+        // non-volatile SkVertices whose buffers are cached write none.
+        size_t vertexUploadBytes() const { return fVertexUploadBytes; }
+        void incVertexUploadBytes(size_t bytes) { fVertexUploadBytes += bytes; }
         void dump(SkString*);
         void dumpKeyValuePairs(SkTArray<SkString>* keys, SkTArray<double>* values);
         int numDraws() const { return fNumDraws; }
@@ -328,10 +405,17 @@ public:
         int fTextureCreates;
         int fTextureUploads;
         int fTransfersToTexture;
+        int fTransfersFromSurface;
         int fStencilAttachmentCreates;
         int fNumDraws;
         int fNumFailedDraws;
         int fNumFinishFlushes;
+        int fSkippedStateChanges;
+        int fAtlasFlushes;
+        size_t fTransientPeakBytes;
+        size_t fTransientAllocatedBytes;
+        size_t fMaxTransientPeakBytes;
+        size_t fVertexUploadBytes;
 #else
         void dump(SkString*) {}
         void dumpKeyValuePairs(SkTArray<SkString>*, SkTArray<double>*) {}
@@ -340,14 +424,23 @@ public:
         void incTextureCreates() {}
         void incTextureUploads() {}
         void incTransfersToTexture() {}
+        void incTransfersFromSurface() {}
         void incStencilAttachmentCreates() {}
         void incNumDraws() {}
         void incNumFailedDraws() {}
         void incNumFinishFlushes() {}
+        void incSkippedStateChanges() {}
+        void incAtlasFlushes() {}
+        void recordTransientBytes(size_t, size_t) {}
+        void incVertexUploadBytes(size_t) {}
 #endif
     };
 
     Stats* stats() { return &fStats; }
+
+    // The counts for GrContext::readFrameStats(), except for the resource purges that the cache
+    // counts. Unlike Stats, they are kept in every build.
+    GrContext::FrameStats* frameStats() { return &fFrameStats; }
     void dumpJSON(SkJSONWriter*) const;
 
 #if GR_TEST_UTILS
@@ -429,20 +522,48 @@ public:
         return 0;
     }
 
+    /**
+     * Like getExtraSamplerKeyForProgram(), but for samplers whose texture is not known when the
+     * program key is made, which can't need a sampler conversion. Non-zero if the backend bakes
+     * samplers with this state into its pipelines.
+     */
+    virtual uint32_t getImmutableSamplerKeyForProgram(const GrSamplerState&) { return 0; }
+
     virtual void storeVkPipelineCacheData() {}
 
+    /**
+     * Returns a value that two GrGpus share only if each can use the shaders the other puts in
+     * the persistent cache (same backend, device and driver). Zero means this GrGpu's shaders
+     * shouldn't be shared with other contexts at all.
+     */
+    virtual uint32_t shaderCacheScope() const { return 0; }
+
+    /**
+     * Called for each draw as ops are prepared, before any of them is executed. A backend whose
+     * driver can compile shaders in the background may start building the draw's program here so
+     * that it is ready, or nearly so, by the time the draw is executed.
+     */
+    virtual void willUseProgram(GrRenderTarget*, GrSurfaceOrigin, const GrPrimitiveProcessor&,
+                                const GrTextureProxy* const primProcProxies[], const GrPipeline&,
+                                bool willDrawPoints) {}
+
 protected:
     // Handles cases where a surface will be updated without a call to flushRenderTarget.
     void didWriteToSurface(GrSurface* surface, GrSurfaceOrigin origin, const SkIRect* bounds,
                            uint32_t mipLevels = 1) const;
 
     Stats                            fStats;
+    GrContext::FrameStats            fFrameStats;
     std::unique_ptr<GrPathRendering> fPathRendering;
     // Subclass must initialize this in its constructor.
     sk_sp<const GrCaps>              fCaps;
 
     typedef SkTArray<SkPoint, true> SamplePattern;
 
+    // Hands a span that the GPU has finished to the tracer. 'startedNsAgo' is how long before now
+    // the GPU started the span's work.
+    static void ReportTraceSpan(const char* name, uint64_t startedNsAgo, uint64_t durationNs);
+
 private:
     // called when the 3D context state is unknown. Subclass should emit any
     // assumed 3D context state and dirty any state cache.
@@ -483,12 +604,25 @@ private:
                                   GrColorType colorType, GrBuffer* transferBuffer, size_t offset,
                                   size_t rowBytes) = 0;
 
+    // overridden by backend-specific derived class to perform the surface to buffer transfer. The
+    // default reports that the backend doesn't support it.
+    virtual bool onTransferPixelsFrom(GrSurface*, int left, int top, int width, int height,
+                                      GrColorType, GrBuffer* transferBuffer, size_t offset) {
+        return false;
+    }
+
     // overridden by backend-specific derived class to perform the resolve
     virtual void onResolveRenderTarget(GrRenderTarget* target) = 0;
 
     // overridden by backend specific derived class to perform mip map level regeneration.
     virtual bool onRegenerateMipMapLevels(GrTexture*) = 0;
 
+    // overridden by backend specific derived class to regenerate the mip levels of several
+    // textures together. Sets regenerated[i] for each texture that succeeded; the default
+    // regenerates them one at a time.
+    virtual void onBatchRegenerateMipMapLevels(GrTexture* const textures[], int count,
+                                               bool regenerated[]);
+
     // overridden by backend specific derived class to perform the copy surface
     virtual bool onCopySurface(GrSurface* dst, GrSurfaceOrigin dstOrigin,
                                GrSurface* src, GrSurfaceOrigin srcOrigin,
@@ -497,6 +631,11 @@ private:
 
     virtual void onFinishFlush(bool insertedSemaphores) = 0;
 
+    // Writes the timestamp at the start of a span. Returns false if the backend can't time this
+    // span, in which case onEndTraceSpan() won't be called for it.
+    virtual bool onBeginTraceSpan(const char* name) { return false; }
+    virtual void onEndTraceSpan() {}
+
 #ifdef SK_ENABLE_DUMP_GPU
     virtual void onDumpJSON(SkJSONWriter*) const {}
 #endif
@@ -509,6 +648,8 @@ private:
 
     ResetTimestamp fResetTimestamp;
     uint32_t fResetBits;
+    // For each open trace span, whether the backend is timing it.
+    SkTArray<bool, true> fTraceSpansTimed;
     // The context owns us, not vice-versa, so this ptr is not ref'ed by Gpu.
     GrContext* fContext;
 
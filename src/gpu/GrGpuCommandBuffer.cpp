@@ -93,5 +93,6 @@ bool GrGpuRTCommandBuffer::draw(const GrPrimitiveProcessor& primProc, const GrPi
     }
     this->onDraw(primProc, pipeline, fixedDynamicState, dynamicStateArrays, meshes, meshCount,
                  bounds);
+    this->gpu()->frameStats()->fDraws += meshCount;
     return true;
 }
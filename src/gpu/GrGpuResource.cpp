@@ -86,6 +86,9 @@ void GrGpuResource::dumpMemoryStatisticsPriv(SkTraceMemoryDump* traceMemoryDump,
     traceMemoryDump->dumpNumericValue(resourceName.c_str(), "size", "bytes", size);
     traceMemoryDump->dumpStringValue(resourceName.c_str(), "type", type);
     traceMemoryDump->dumpStringValue(resourceName.c_str(), "category", tag);
+    GrResourceCategory category = GrResourceCache::CategoryOf(this);
+    traceMemoryDump->dumpStringValue(resourceName.c_str(), "budget_category",
+                                     GrResourceCache::CategoryName(category));
     if (this->isPurgeable()) {
         traceMemoryDump->dumpNumericValue(resourceName.c_str(), "purgeable_size", "bytes", size);
     }
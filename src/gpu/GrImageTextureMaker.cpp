@@ -27,6 +27,19 @@ sk_sp<GrTextureProxy> GrImageTextureMaker::refOriginalTextureProxy(bool willBeMi
                                     willBeMipped, onlyIfFast);
 }
 
+sk_sp<GrTextureProxy> GrImageTextureMaker::refCachedOriginalTextureProxy(bool willBeMipped) {
+    return fImage->lockTextureProxy(this->context(), fOriginalKey, fCachingHint,
+                                    willBeMipped, AllowedTexGenType::kCheap);
+}
+
+bool GrImageTextureMaker::getDownscaleSourcePixels(SkBitmap* bitmap) {
+    // Generators that make their own textures would have to be rasterized on the CPU instead.
+    if (SkImage::kAllow_CachingHint != fCachingHint || fImage->generatesTexture()) {
+        return false;
+    }
+    return fImage->getROPixels(bitmap, fCachingHint);
+}
+
 void GrImageTextureMaker::makeCopyKey(const CopyParams& stretch, GrUniqueKey* paramsCopyKey) {
     if (fOriginalKey.isValid() && SkImage::kAllow_CachingHint == fCachingHint) {
         GrUniqueKey cacheKey;
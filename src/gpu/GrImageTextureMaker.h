@@ -26,6 +26,8 @@ protected:
     //          GrTexture* generateTextureForParams(const CopyParams&) override;
     sk_sp<GrTextureProxy> refOriginalTextureProxy(bool willBeMipped,
                                                   AllowedTexGenType onlyIfFast) override;
+    sk_sp<GrTextureProxy> refCachedOriginalTextureProxy(bool willBeMipped) override;
+    bool getDownscaleSourcePixels(SkBitmap*) override;
 
     void makeCopyKey(const CopyParams& stretch, GrUniqueKey* paramsCopyKey) override;
     void didCacheCopy(const GrUniqueKey& copyKey, uint32_t contextUniqueID) override {}
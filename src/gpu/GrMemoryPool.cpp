@@ -18,11 +18,56 @@
     #define VALIDATE
 #endif
 
+GrOpMemoryPool::~GrOpMemoryPool() {
+    SkASSERT(this->isEmpty());
+    this->purgeFreeLists();
+}
+
+void* GrOpMemoryPool::allocate(size_t size) {
+    static_assert(sizeof(Header) == 8, "Header must preserve GrMemoryPool's 8-byte alignment");
+    size_t sizeClass = SkTMax<size_t>((size + kSizeClassBytes - 1) / kSizeClassBytes, 1);
+    if (sizeClass >= kNumSizeClasses) {
+        return this->allocateForClass(0, size);
+    }
+    if (FreeNode* node = fFreeLists[sizeClass]) {
+        fFreeLists[sizeClass] = node->fNext;
+        ++fLiveCount;
+        return node;
+    }
+    return this->allocateForClass(SkToInt(sizeClass), sizeClass * kSizeClassBytes);
+}
+
+void* GrOpMemoryPool::allocateForClass(int sizeClass, size_t size) {
+    Header* header = (Header*) fMemoryPool.allocate(sizeof(Header) + size);
+    header->fSizeClass = sizeClass;
+    ++fLiveCount;
+    return header + 1;
+}
+
 void GrOpMemoryPool::release(std::unique_ptr<GrOp> op) {
     GrOp* tmp = op.release();
     SkASSERT(tmp);
     tmp->~GrOp();
-    fMemoryPool.release(tmp);
+    SkASSERT(fLiveCount > 0);
+    --fLiveCount;
+    Header* header = reinterpret_cast<Header*>(tmp) - 1;
+    if (0 == header->fSizeClass) {
+        fMemoryPool.release(header);
+        return;
+    }
+    SkASSERT(header->fSizeClass < kNumSizeClasses);
+    FreeNode* node = reinterpret_cast<FreeNode*>(tmp);
+    node->fNext = fFreeLists[header->fSizeClass];
+    fFreeLists[header->fSizeClass] = node;
+}
+
+void GrOpMemoryPool::purgeFreeLists() {
+    for (FreeNode*& list : fFreeLists) {
+        while (FreeNode* node = list) {
+            list = node->fNext;
+            fMemoryPool.release(reinterpret_cast<Header*>(node) - 1);
+        }
+    }
 }
 
 constexpr size_t GrMemoryPool::kSmallestMinAllocSize;
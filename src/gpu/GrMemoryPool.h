@@ -126,6 +126,12 @@ protected:
 
 class GrOp;
 
+/**
+ * Allocates ops out of a GrMemoryPool. Released op storage goes onto a free list for its size
+ * class, instead of back to the GrMemoryPool, so that later ops of a similar size reuse it even
+ * while the rest of its block is still in use. This keeps long-lived recordings, where ops are
+ * created and merged away continually, from growing the pool block by block.
+ */
 // DDL TODO: for the DLL use case this could probably be the non-intrinsic-based style of
 // ref counting
 class GrOpMemoryPool : public SkRefCnt {
@@ -134,22 +140,53 @@ public:
             : fMemoryPool(preallocSize, minAllocSize) {
     }
 
+    ~GrOpMemoryPool() override;
+
     template <typename Op, typename... OpArgs>
     std::unique_ptr<Op> allocate(OpArgs&&... opArgs) {
-        char* mem = (char*) fMemoryPool.allocate(sizeof(Op));
+        char* mem = (char*) this->allocate(sizeof(Op));
         return std::unique_ptr<Op>(new (mem) Op(std::forward<OpArgs>(opArgs)...));
     }
 
-    void* allocate(size_t size) {
-        return fMemoryPool.allocate(size);
-    }
+    void* allocate(size_t size);
 
     void release(std::unique_ptr<GrOp> op);
 
-    bool isEmpty() const { return fMemoryPool.isEmpty(); }
+    /**
+     * Returns true if there are no ops that have not been released.
+     */
+    bool isEmpty() const { return 0 == fLiveCount; }
+
+    /**
+     * Returns the total allocated size of the underlying GrMemoryPool minus any preallocated
+     * amount. Storage on the free lists counts as allocated.
+     */
+    size_t size() const { return fMemoryPool.size(); }
+
+    /**
+     * Returns the storage on the free lists to the underlying GrMemoryPool.
+     */
+    void purgeFreeLists();
 
 private:
+    // Allocations are tagged with their size class, in units of kSizeClassBytes. Class 0 is for
+    // allocations too large to be worth keeping on a free list.
+    struct Header {
+        uint32_t fSizeClass;
+        uint32_t fPad;
+    };
+    struct FreeNode {
+        FreeNode* fNext;
+    };
+
+    static constexpr size_t kSizeClassBytes = 16;
+    static constexpr int    kNumSizeClasses = 64;
+
+    void* allocateForClass(int sizeClass, size_t size);
+
     GrMemoryPool fMemoryPool;
+    FreeNode*    fFreeLists[kNumSizeClasses] = {};
+    int          fLiveCount = 0;
 };
 
 #endif
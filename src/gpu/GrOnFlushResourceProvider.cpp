@@ -9,6 +9,7 @@
 #include "GrContext.h"
 #include "GrContextPriv.h"
 #include "GrDrawingManager.h"
+#include "GrGpu.h"
 #include "GrProxyProvider.h"
 #include "GrRenderTargetContext.h"
 #include "GrSurfaceProxy.h"
@@ -73,6 +74,20 @@ bool GrOnFlushResourceProvider::instatiateProxy(GrSurfaceProxy* proxy) {
     return proxy->instantiate(resourceProvider);
 }
 
+bool GrOnFlushResourceProvider::writePixels(GrTextureProxy* proxy, int left, int top, int width,
+                                            int height, GrColorType srcColorType,
+                                            const void* buffer, size_t rowBytes) {
+    GrGpu* gpu = fDrawingMgr->getContext()->contextPriv().getGpu();
+    GrSurface* dstSurface = proxy->peekSurface();
+    SkASSERT(dstSurface);
+    if (!gpu->caps()->surfaceSupportsWritePixels(dstSurface) &&
+        gpu->caps()->supportedWritePixelsColorType(dstSurface->config(), srcColorType) !=
+                srcColorType) {
+        return false;
+    }
+    return gpu->writePixels(dstSurface, left, top, width, height, srcColorType, buffer, rowBytes);
+}
+
 sk_sp<GrBuffer> GrOnFlushResourceProvider::makeBuffer(GrBufferType intendedType, size_t size,
                                                       const void* data) {
     auto resourceProvider = fDrawingMgr->getContext()->contextPriv().resourceProvider();
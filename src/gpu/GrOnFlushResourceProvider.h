@@ -85,6 +85,11 @@ public:
 
     bool instatiateProxy(GrSurfaceProxy*);
 
+    // Writes pixel data directly to an instantiated texture proxy. The data lands before any of the
+    // flush's ops execute, like an ASAP upload.
+    bool writePixels(GrTextureProxy*, int left, int top, int width, int height,
+                     GrColorType srcColorType, const void* buffer, size_t rowBytes);
+
     // Creates a GPU buffer with a "dynamic" access pattern.
     sk_sp<GrBuffer> makeBuffer(GrBufferType, size_t, const void* data = nullptr);
 
@@ -16,9 +16,10 @@
 //////////////////////////////////////////////////////////////////////////////
 
 GrOpFlushState::GrOpFlushState(GrGpu* gpu, GrResourceProvider* resourceProvider,
-                               GrTokenTracker* tokenTracker, void* vertexSpace, void* indexSpace)
-        : fVertexPool(gpu, vertexSpace)
-        , fIndexPool(gpu, indexSpace)
+                               GrTokenTracker* tokenTracker, void* vertexSpace, void* indexSpace,
+                               GrBufferRing* vertexRing, GrBufferRing* indexRing)
+        : fVertexPool(gpu, vertexSpace, vertexRing)
+        , fIndexPool(gpu, indexSpace, indexRing)
         , fGpu(gpu)
         , fResourceProvider(resourceProvider)
         , fTokenTracker(tokenTracker) {}
@@ -88,11 +89,13 @@ void GrOpFlushState::doUpload(GrDeferredTextureUploadFn& upload) {
 }
 
 GrDeferredUploadToken GrOpFlushState::addInlineUpload(GrDeferredTextureUploadFn&& upload) {
+    fRetainedRecordingFailed |= SkToBool(fRetainedDraws);
     return fInlineUploads.append(&fArena, std::move(upload), fTokenTracker->nextDrawToken())
             .fUploadBeforeToken;
 }
 
 GrDeferredUploadToken GrOpFlushState::addASAPUpload(GrDeferredTextureUploadFn&& upload) {
+    fRetainedRecordingFailed |= SkToBool(fRetainedDraws);
     fASAPUploads.append(&fArena, std::move(upload));
     return fTokenTracker->nextTokenToFlush();
 }
@@ -103,6 +106,31 @@ void GrOpFlushState::draw(sk_sp<const GrGeometryProcessor> gp, const GrPipeline*
                           const GrMesh meshes[], int meshCnt) {
     SkASSERT(fOpArgs);
     SkASSERT(fOpArgs->fOp);
+    if (fRetainedDraws) {
+        fRetainedDraws->fDraws.push_back({gp, pipeline, fixedDynamicState, dynamicStateArrays,
+                                          meshes, meshCnt});
+    }
+    // Give the backend the whole prepare phase to build any program this draw needs.
+    const GrTextureProxy* const* primProcProxies = nullptr;
+    if (dynamicStateArrays && dynamicStateArrays->fPrimitiveProcessorTextures) {
+        primProcProxies = dynamicStateArrays->fPrimitiveProcessorTextures;
+    } else if (fixedDynamicState) {
+        primProcProxies = fixedDynamicState->fPrimitiveProcessorTextures;
+    }
+    bool willDrawPoints = false;
+    for (int i = 0; i < meshCnt; ++i) {
+        willDrawPoints |= GrPrimitiveType::kPoints == meshes[i].primitiveType();
+    }
+    fGpu->willUseProgram(fOpArgs->renderTarget(), fOpArgs->origin(), *gp, primProcProxies,
+                         *pipeline, willDrawPoints);
+    this->addDraw(std::move(gp), pipeline, fixedDynamicState, dynamicStateArrays, meshes, meshCnt,
+                  fOpArgs->fOp);
+}
+
+void GrOpFlushState::addDraw(sk_sp<const GrGeometryProcessor> gp, const GrPipeline* pipeline,
+                             const GrPipeline::FixedDynamicState* fixedDynamicState,
+                             const GrPipeline::DynamicStateArrays* dynamicStateArrays,
+                             const GrMesh meshes[], int meshCnt, const GrOp* op) {
     bool firstDraw = fDraws.begin() == fDraws.end();
     auto& draw = fDraws.append(&fArena);
     GrDeferredUploadToken token = fTokenTracker->issueDrawToken();
@@ -123,42 +151,79 @@ void GrOpFlushState::draw(sk_sp<const GrGeometryProcessor> gp, const GrPipeline*
     draw.fDynamicStateArrays = dynamicStateArrays;
     draw.fMeshes = meshes;
     draw.fMeshCnt = meshCnt;
-    draw.fOp = fOpArgs->fOp;
+    draw.fOp = op;
     if (firstDraw) {
         fBaseDrawToken = token;
     }
 }
 
+void GrOpFlushState::beginRetainedRecording(GrRetainedDraws* retained) {
+    SkASSERT(!fRetainedDraws && retained);
+    fRetainedDraws = retained;
+    fRetainedVertexPool.reset(new GrVertexBufferAllocPool(fGpu, nullptr));
+    fRetainedIndexPool.reset(new GrIndexBufferAllocPool(fGpu, nullptr));
+    fRetainedRecordingFailed = false;
+}
+
+bool GrOpFlushState::endRetainedRecording() {
+    SkASSERT(fRetainedDraws);
+    // Unmapping writes any data the pools staged in CPU memory to the buffers before the pools
+    // drop their refs.
+    fRetainedVertexPool->unmap();
+    fRetainedIndexPool->unmap();
+    fRetainedVertexPool.reset();
+    fRetainedIndexPool.reset();
+    fRetainedDraws = nullptr;
+    return !fRetainedRecordingFailed;
+}
+
+void GrOpFlushState::replayRetainedDraws(const GrRetainedDraws& retained, int start, int end,
+                                         const GrOp* op) {
+    SkASSERT(!fRetainedDraws);
+    SkASSERT(0 <= start && start <= end && end <= retained.count());
+    for (int i = start; i < end; ++i) {
+        const GrRetainedDraws::Draw& draw = retained.fDraws[i];
+        this->addDraw(draw.fGeometryProcessor, draw.fPipeline, draw.fFixedDynamicState,
+                      draw.fDynamicStateArrays, draw.fMeshes, draw.fMeshCnt, op);
+    }
+}
+
 void* GrOpFlushState::makeVertexSpace(size_t vertexSize, int vertexCount,
                                       sk_sp<const GrBuffer>* buffer, int* startVertex) {
-    return fVertexPool.makeSpace(vertexSize, vertexCount, buffer, startVertex);
+    GrVertexBufferAllocPool* pool = fRetainedDraws ? fRetainedVertexPool.get() : &fVertexPool;
+    return pool->makeSpace(vertexSize, vertexCount, buffer, startVertex);
 }
 
 uint16_t* GrOpFlushState::makeIndexSpace(int indexCount, sk_sp<const GrBuffer>* buffer,
                                          int* startIndex) {
-    return reinterpret_cast<uint16_t*>(fIndexPool.makeSpace(indexCount, buffer, startIndex));
+    GrIndexBufferAllocPool* pool = fRetainedDraws ? fRetainedIndexPool.get() : &fIndexPool;
+    return reinterpret_cast<uint16_t*>(pool->makeSpace(indexCount, buffer, startIndex));
 }
 
 void* GrOpFlushState::makeVertexSpaceAtLeast(size_t vertexSize, int minVertexCount,
                                              int fallbackVertexCount, sk_sp<const GrBuffer>* buffer,
                                              int* startVertex, int* actualVertexCount) {
-    return fVertexPool.makeSpaceAtLeast(vertexSize, minVertexCount, fallbackVertexCount, buffer,
-                                        startVertex, actualVertexCount);
+    GrVertexBufferAllocPool* pool = fRetainedDraws ? fRetainedVertexPool.get() : &fVertexPool;
+    return pool->makeSpaceAtLeast(vertexSize, minVertexCount, fallbackVertexCount, buffer,
+                                  startVertex, actualVertexCount);
 }
 
 uint16_t* GrOpFlushState::makeIndexSpaceAtLeast(int minIndexCount, int fallbackIndexCount,
                                                 sk_sp<const GrBuffer>* buffer, int* startIndex,
                                                 int* actualIndexCount) {
-    return reinterpret_cast<uint16_t*>(fIndexPool.makeSpaceAtLeast(
+    GrIndexBufferAllocPool* pool = fRetainedDraws ? fRetainedIndexPool.get() : &fIndexPool;
+    return reinterpret_cast<uint16_t*>(pool->makeSpaceAtLeast(
             minIndexCount, fallbackIndexCount, buffer, startIndex, actualIndexCount));
 }
 
 void GrOpFlushState::putBackIndices(int indexCount) {
-    fIndexPool.putBack(indexCount * sizeof(uint16_t));
+    GrIndexBufferAllocPool* pool = fRetainedDraws ? fRetainedIndexPool.get() : &fIndexPool;
+    pool->putBack(indexCount * sizeof(uint16_t));
 }
 
 void GrOpFlushState::putBackVertices(int vertices, size_t vertexStride) {
-    fVertexPool.putBack(vertices * vertexStride);
+    GrVertexBufferAllocPool* pool = fRetainedDraws ? fRetainedVertexPool.get() : &fVertexPool;
+    pool->putBack(vertices * vertexStride);
 }
 
 GrAppliedClip GrOpFlushState::detachAppliedClip() {
@@ -166,10 +231,12 @@ GrAppliedClip GrOpFlushState::detachAppliedClip() {
 }
 
 GrStrikeCache* GrOpFlushState::glyphCache() const {
+    fRetainedRecordingFailed |= SkToBool(fRetainedDraws);
     return fGpu->getContext()->contextPriv().getGlyphCache();
 }
 
 GrAtlasManager* GrOpFlushState::atlasManager() const {
+    fRetainedRecordingFailed |= SkToBool(fRetainedDraws);
     return fGpu->getContext()->contextPriv().getAtlasManager();
 }
 
@@ -16,21 +16,50 @@
 #include "GrRenderTargetProxy.h"
 #include "SkArenaAlloc.h"
 #include "SkArenaAllocList.h"
+#include "SkTArray.h"
 #include "ops/GrMeshDrawOp.h"
 
+class GrFlushTimer;
 class GrGpu;
 class GrGpuCommandBuffer;
 class GrGpuRTCommandBuffer;
 class GrResourceProvider;
 
+/**
+ * The draws that the ops of a retained opList prepared on its first flush. Their pipelines and
+ * meshes live in this object's arena and the meshes hold refs on the vertex and index buffers,
+ * so the draws can be issued again on later flushes without preparing the ops again.
+ */
+class GrRetainedDraws {
+public:
+    int count() const { return fDraws.count(); }
+
+private:
+    friend class GrOpFlushState;
+
+    struct Draw {
+        sk_sp<const GrGeometryProcessor> fGeometryProcessor;
+        const GrPipeline* fPipeline;
+        const GrPipeline::FixedDynamicState* fFixedDynamicState;
+        const GrPipeline::DynamicStateArrays* fDynamicStateArrays;
+        const GrMesh* fMeshes;
+        int fMeshCnt;
+    };
+
+    SkArenaAlloc fArena{sizeof(GrPipeline) * 16};
+    SkTArray<Draw> fDraws;
+};
+
 /** Tracks the state across all the GrOps (really just the GrDrawOps) in a GrOpList flush. */
 class GrOpFlushState final : public GrDeferredUploadTarget, public GrMeshDrawOp::Target {
 public:
     // vertexSpace and indexSpace may either be null or an alloation of size
     // GrBufferAllocPool::kDefaultBufferSize. If the latter, then CPU memory is only allocated for
-    // vertices/indices when a buffer larger than kDefaultBufferSize is required.
+    // vertices/indices when a buffer larger than kDefaultBufferSize is required. vertexRing and
+    // indexRing, if not null, recycle the pools' default-sized buffers across flushes.
     GrOpFlushState(GrGpu*, GrResourceProvider*, GrTokenTracker*, void* vertexSpace,
-                   void* indexSpace);
+                   void* indexSpace, GrBufferRing* vertexRing = nullptr,
+                   GrBufferRing* indexRing = nullptr);
 
     ~GrOpFlushState() final { this->reset(); }
 
@@ -66,6 +95,10 @@ public:
 
     void setOpArgs(OpArgs* opArgs) { fOpArgs = opArgs; }
 
+    // The timer that the opLists bracket their ops with, if any.
+    void setFlushTimer(GrFlushTimer* flushTimer) { fFlushTimer = flushTimer; }
+    GrFlushTimer* flushTimer() const { return fFlushTimer; }
+
     const OpArgs& drawOpArgs() const {
         SkASSERT(fOpArgs);
         SkASSERT(fOpArgs->fOp);
@@ -99,7 +132,10 @@ public:
     GrRenderTargetProxy* proxy() const final { return fOpArgs->fProxy; }
     GrAppliedClip detachAppliedClip() final;
     const GrXferProcessor::DstProxy& dstProxy() const final { return fOpArgs->fDstProxy; }
-    GrDeferredUploadTarget* deferredUploadTarget() final { return this; }
+    GrDeferredUploadTarget* deferredUploadTarget() final {
+        fRetainedRecordingFailed |= SkToBool(fRetainedDraws);
+        return this;
+    }
     const GrCaps& caps() const final;
     GrResourceProvider* resourceProvider() const final { return fResourceProvider; }
 
@@ -111,9 +147,28 @@ public:
 
     GrDeinstantiateProxyTracker* deinstantiateProxyTracker() { return &fDeinstantiateProxyTracker; }
 
+    /**
+     * While recording, the ops being prepared allocate their pipelines and meshes from 'retained'
+     * and write their vertices and indices to buffers that are not recycled at the end of the
+     * flush, and their draws are added to 'retained' as well as to this flush. Recording fails if
+     * an op uses the atlases or schedules uploads, because its draws then depend on state that
+     * changes between flushes; endRetainedRecording() returns false in that case.
+     */
+    void beginRetainedRecording(GrRetainedDraws* retained);
+    bool endRetainedRecording();
+
+    /** Adds draws [start, end) of 'retained' to this flush for 'op', which isn't prepared again. */
+    void replayRetainedDraws(const GrRetainedDraws&, int start, int end, const GrOp* op);
+
 private:
+    void addDraw(sk_sp<const GrGeometryProcessor>, const GrPipeline*,
+                 const GrPipeline::FixedDynamicState*, const GrPipeline::DynamicStateArrays*,
+                 const GrMesh[], int meshCnt, const GrOp*);
+
     /** GrMeshDrawOp::Target override. */
-    SkArenaAlloc* pipelineArena() override { return &fArena; }
+    SkArenaAlloc* pipelineArena() override {
+        return fRetainedDraws ? &fRetainedDraws->fArena : &fArena;
+    }
 
     struct InlineUpload {
         InlineUpload(GrDeferredTextureUploadFn&& upload, GrDeferredUploadToken token)
@@ -157,6 +212,8 @@ private:
     // an op is not currently preparing of executing.
     OpArgs* fOpArgs = nullptr;
 
+    GrFlushTimer* fFlushTimer = nullptr;
+
     GrGpu* fGpu;
     GrResourceProvider* fResourceProvider;
     GrTokenTracker* fTokenTracker;
@@ -168,6 +225,13 @@ private:
 
     // Used to track the proxies that need to be deinstantiated after we finish a flush
     GrDeinstantiateProxyTracker fDeinstantiateProxyTracker;
+
+    // Set between beginRetainedRecording() and endRetainedRecording(). The pools' buffers outlive
+    // them through the refs held by the retained meshes.
+    GrRetainedDraws* fRetainedDraws = nullptr;
+    std::unique_ptr<GrVertexBufferAllocPool> fRetainedVertexPool;
+    std::unique_ptr<GrIndexBufferAllocPool> fRetainedIndexPool;
+    mutable bool fRetainedRecordingFailed = false;
 };
 
 #endif
@@ -63,7 +63,13 @@ void GrOpList::endFlush() {
         fTarget.get()->setLastOpList(nullptr);
     }
 
-    fTarget.reset();
+    // The deferred proxies were uploaded by this flush. A retained opList keeps its target for the
+    // next flush, which sorts the opLists again.
+    if (this->isRetained()) {
+        this->resetFlag(kWasOutput_Flag);
+    } else {
+        fTarget.reset();
+    }
     fDeferredProxies.reset();
     fAuditTrail = nullptr;
 }
@@ -21,6 +21,7 @@
 #include "ops/GrDefaultPathRenderer.h"
 #include "ops/GrStencilAndCoverPathRenderer.h"
 #include "ops/GrTessellatingPathRenderer.h"
+#include "skc/GrSkcPathRenderer.h"
 
 GrPathRendererChain::GrPathRendererChain(GrContext* context, const Options& options) {
     const GrCaps& caps = *context->contextPriv().caps();
@@ -37,6 +38,12 @@ GrPathRendererChain::GrPathRendererChain(GrContext* context, const Options& opti
     if (options.fGpuPathRenderers & GpuPathRenderers::kAAConvex) {
         fChain.push_back(sk_make_sp<GrAAConvexPathRenderer>());
     }
+    // skc only takes paths that are too big for the others to draw well, so it goes ahead of them.
+    if (options.fGpuPathRenderers & GpuPathRenderers::kSkc) {
+        if (auto skc = GrSkcPathRenderer::CreateIfSupported(caps)) {
+            fChain.push_back(std::move(skc));
+        }
+    }
     if (options.fGpuPathRenderers & GpuPathRenderers::kCoverageCounting) {
         using AllowCaching = GrCoverageCountingPathRenderer::AllowCaching;
         if (auto ccpr = GrCoverageCountingPathRenderer::CreateIfSupported(
@@ -54,7 +61,8 @@ GrPathRendererChain::GrPathRendererChain(GrContext* context, const Options& opti
         fChain.push_back(sk_make_sp<GrAALinearizingConvexPathRenderer>());
     }
     if (options.fGpuPathRenderers & GpuPathRenderers::kSmall) {
-        auto spr = sk_make_sp<GrSmallPathRenderer>();
+        auto spr = sk_make_sp<GrSmallPathRenderer>(options.fSmallPathMaxDimension,
+                                                   options.fDistanceFieldPathCache);
         context->contextPriv().addOnFlushCallbackObject(spr.get());
         fChain.push_back(std::move(spr));
     }
@@ -8,6 +8,7 @@
 #ifndef GrPathRendererChain_DEFINED
 #define GrPathRendererChain_DEFINED
 
+#include "GrContextOptions.h"
 #include "GrPathRenderer.h"
 
 #include "GrTypesPriv.h"
@@ -29,6 +30,8 @@ public:
     struct Options {
         bool fAllowPathMaskCaching = false;
         GpuPathRenderers fGpuPathRenderers = GpuPathRenderers::kAll;
+        float fSmallPathMaxDimension = -1.f;
+        GrContextOptions::PersistentCache* fDistanceFieldPathCache = nullptr;
     };
     GrPathRendererChain(GrContext* context, const Options&);
 
@@ -65,7 +65,6 @@ static void add_sampler_keys(GrProcessorKeyBuilder* b, const GrFragmentProcessor
         uint32_t extraSamplerKey = gpu->getExtraSamplerKeyForProgram(
                 sampler.samplerState(), sampler.proxy()->backendFormat());
         if (extraSamplerKey) {
-            SkASSERT(sampler.proxy()->textureType() == GrTextureType::kExternal);
             // We first mark the normal sampler key with last bit to flag that it has an extra
             // sampler key. We then add all the extraSamplerKeys to the end of the normal ones.
             SkASSERT((k16[i] & (1 << 15)) == 0);
@@ -80,7 +79,7 @@ static void add_sampler_keys(GrProcessorKeyBuilder* b, const GrFragmentProcessor
 }
 
 static void add_sampler_keys(GrProcessorKeyBuilder* b, const GrPrimitiveProcessor& pp,
-                             const GrShaderCaps& caps) {
+                             GrGpu* gpu, const GrShaderCaps& caps) {
     int numTextureSamplers = pp.numTextureSamplers();
     // Need two bytes per key.
     int word32Count = (numTextureSamplers + 1) / 2;
@@ -92,8 +91,10 @@ static void add_sampler_keys(GrProcessorKeyBuilder* b, const GrPrimitiveProcesso
         const GrPrimitiveProcessor::TextureSampler& sampler = pp.textureSampler(i);
         k16[i] = sampler_key(sampler.textureType(), sampler.config(), caps);
         uint32_t extraSamplerKey = sampler.extraSamplerKey();
+        if (!extraSamplerKey) {
+            extraSamplerKey = gpu->getImmutableSamplerKeyForProgram(sampler.samplerState());
+        }
         if (extraSamplerKey) {
-            SkASSERT(sampler.textureType() == GrTextureType::kExternal);
             // We first mark the normal sampler key with last bit to flag that it has an extra
             // sampler key. We then add all the extraSamplerKeys to the end of the normal ones.
             SkASSERT((k16[i] & (1 << 15)) == 0);
@@ -139,6 +140,7 @@ static bool gen_meta_key(const GrFragmentProcessor& fp,
 }
 
 static bool gen_meta_key(const GrPrimitiveProcessor& pp,
+                         GrGpu* gpu,
                          const GrShaderCaps& shaderCaps,
                          uint32_t transformKey,
                          GrProcessorKeyBuilder* b) {
@@ -151,7 +153,7 @@ static bool gen_meta_key(const GrPrimitiveProcessor& pp,
         return false;
     }
 
-    add_sampler_keys(b, pp, shaderCaps);
+    add_sampler_keys(b, pp, gpu, shaderCaps);
 
     uint32_t* key = b->add32n(2);
     key[0] = (classID << 16) | SkToU32(processorKeySize);
@@ -214,7 +216,7 @@ bool GrProgramDesc::Build(GrProgramDesc* desc,
 
     primProc.getGLSLProcessorKey(shaderCaps, &b);
     primProc.getAttributeKey(&b);
-    if (!gen_meta_key(primProc, shaderCaps, 0, &b)) {
+    if (!gen_meta_key(primProc, gpu, shaderCaps, 0, &b)) {
         desc->key().reset();
         return false;
     }
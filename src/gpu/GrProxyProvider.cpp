@@ -26,6 +26,7 @@
 #include "SkImagePriv.h"
 #include "SkMipMap.h"
 #include "SkTraceEvent.h"
+#include "SkTraceMemoryDump.h"
 
 #define ASSERT_SINGLE_OWNER \
     SkDEBUGCODE(GrSingleOwner::AutoEnforce debug_SingleOwner(fSingleOwner);)
@@ -766,6 +767,30 @@ void GrProxyProvider::orphanAllUniqueKeys() {
     }
 }
 
+void GrProxyProvider::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
+    if (SkTraceMemoryDump::kObjectsBreakdowns_LevelOfDetail !=
+        traceMemoryDump->getRequestedDetails()) {
+        return;
+    }
+    for (UniquelyKeyedProxyHash::ConstIter iter(&fUniquelyKeyedProxies); !iter.done(); ++iter) {
+        const GrTextureProxy& proxy = *iter;
+
+        SkString dumpName("skia/gpu_proxies/proxy_");
+        dumpName.appendU32(proxy.uniqueID().asUInt());
+        const char* tag = proxy.getUniqueKey().tag();
+        traceMemoryDump->dumpStringValue(dumpName.c_str(), "owner", tag ? tag : "Other");
+        if (GrSurface* surface = proxy.peekSurface()) {
+            traceMemoryDump->dumpNumericValue(dumpName.c_str(), "total_size", "bytes",
+                                              surface->gpuMemorySize());
+            traceMemoryDump->dumpNumericValue(dumpName.c_str(), "resource_id", "id",
+                                              surface->uniqueID().asUInt());
+        } else if (GrSurfaceProxy::LazyState::kFully != proxy.lazyInstantiationState()) {
+            traceMemoryDump->dumpNumericValue(dumpName.c_str(), "estimated_size", "bytes",
+                                              proxy.gpuMemorySize());
+        }
+    }
+}
+
 void GrProxyProvider::removeAllUniqueKeys() {
     UniquelyKeyedProxyHash::Iter iter(&fUniquelyKeyedProxies);
     for (UniquelyKeyedProxyHash::Iter iter(&fUniquelyKeyedProxies); !iter.done(); ++iter) {
@@ -20,6 +20,7 @@ class GrSingleOwner;
 class GrBackendRenderTarget;
 class SkBitmap;
 class SkImage;
+class SkTraceMemoryDump;
 
 /*
  * A factory for creating GrSurfaceProxy-derived objects.
@@ -234,6 +235,11 @@ public:
 
     int numUniqueKeyProxies_TestOnly() const;
 
+    // Dumps the uniquely keyed proxies as "skia/gpu_proxies/proxy_<id>". A proxy's size is its
+    // estimated size until it is instantiated; after that its dump names the resource it wraps.
+    // Only dumped for kObjectsBreakdowns_LevelOfDetail.
+    void dumpMemoryStatistics(SkTraceMemoryDump*) const;
+
     // This is called on a DDL's proxyprovider when the DDL is finished. The uniquely keyed
     // proxies need to keep their unique key but cannot hold on to the proxy provider unique
     // pointer.
@@ -51,6 +51,7 @@
 #include "ops/GrOvalOpFactory.h"
 #include "ops/GrRegionOp.h"
 #include "ops/GrSemaphoreOp.h"
+#include "ops/GrShadowConvexOp.h"
 #include "ops/GrShadowRRectOp.h"
 #include "ops/GrStencilPathOp.h"
 #include "ops/GrStrokeRectOp.h"
@@ -1163,28 +1164,29 @@ bool GrRenderTargetContext::drawFastShadow(const GrClip& clip,
     bool tiltZPlane = SkToBool(!SkScalarNearlyZero(rec.fZPlaneParams.fX) ||
                                !SkScalarNearlyZero(rec.fZPlaneParams.fY));
     bool skipAnalytic = SkToBool(rec.fFlags & SkShadowFlags::kGeometricOnly_ShadowFlag);
-    if (tiltZPlane || skipAnalytic || !viewMatrix.rectStaysRect() || !viewMatrix.isSimilarity()) {
+    if (tiltZPlane || skipAnalytic || !viewMatrix.isSimilarity()) {
         return false;
     }
 
     SkRRect rrect;
     SkRect rect;
     // we can only handle rects, circles, and rrects with circular corners
-    bool isRRect = path.isRRect(&rrect) && SkRRectPriv::IsSimpleCircular(rrect) &&
+    bool rectStaysRect = viewMatrix.rectStaysRect();
+    bool isRRect = rectStaysRect && path.isRRect(&rrect) && SkRRectPriv::IsSimpleCircular(rrect) &&
         rrect.radii(SkRRect::kUpperLeft_Corner).fX > SK_ScalarNearlyZero;
-    if (!isRRect &&
+    if (!isRRect && rectStaysRect &&
         path.isOval(&rect) && SkScalarNearlyEqual(rect.width(), rect.height()) &&
         rect.width() > SK_ScalarNearlyZero) {
         rrect.setOval(rect);
         isRRect = true;
     }
-    if (!isRRect && path.isRect(&rect)) {
+    if (!isRRect && rectStaysRect && path.isRect(&rect)) {
         rrect.setRect(rect);
         isRRect = true;
     }
 
     if (!isRRect) {
-        return false;
+        return this->drawFastConvexShadow(clip, viewMatrix, path, rec);
     }
 
     if (rrect.isEmpty()) {
@@ -1339,6 +1341,75 @@ bool GrRenderTargetContext::drawFastShadow(const GrClip& clip,
     return true;
 }
 
+bool GrRenderTargetContext::drawFastConvexShadow(const GrClip& clip,
+                                                 const SkMatrix& viewMatrix,
+                                                 const SkPath& path,
+                                                 const SkDrawShadowRec& rec) {
+    // Only polygons: the curves of other convex paths are left to the tessellator.
+    if (!path.isConvex() || path.isInverseFillType() ||
+        SkPath::kLine_SegmentMask != path.getSegmentMasks()) {
+        return false;
+    }
+    int count = path.countPoints();
+    // A closed polygon may repeat its first point.
+    if (count < 3 || count > GrShadowConvexOp::kMaxEdges + 1) {
+        return false;
+    }
+    SkAutoSTMalloc<GrShadowConvexOp::kMaxEdges + 1, SkPoint> points(count);
+    SkAutoSTMalloc<GrShadowConvexOp::kMaxEdges + 1, SkPoint> devPoints(count);
+    path.getPoints(points.get(), count);
+
+    SkScalar occluderHeight = rec.fZPlaneParams.fZ;
+
+    // Make both ops before adding either, so a failure can still fall back to the tessellator.
+    std::unique_ptr<GrDrawOp> ambientOp;
+    if (SkColorGetA(rec.fAmbientColor) > 0) {
+        SkScalar devSpaceInsetWidth = SkDrawShadowMetrics::AmbientBlurRadius(occluderHeight);
+        const SkScalar umbraRecipAlpha = SkDrawShadowMetrics::AmbientRecipAlpha(occluderHeight);
+        const SkScalar devSpaceAmbientBlur = devSpaceInsetWidth * umbraRecipAlpha;
+
+        viewMatrix.mapPoints(devPoints.get(), points.get(), count);
+        ambientOp = GrShadowConvexOp::Make(fContext, SkColorToPremulGrColor(rec.fAmbientColor),
+                                           devPoints.get(), count, devSpaceInsetWidth,
+                                           devSpaceAmbientBlur);
+        if (!ambientOp) {
+            return false;
+        }
+    }
+
+    std::unique_ptr<GrDrawOp> spotOp;
+    if (SkColorGetA(rec.fSpotColor) > 0) {
+        SkPoint3 devLightPos = map(viewMatrix, rec.fLightPos);
+        SkScalar devSpaceSpotBlur;
+        SkScalar spotScale;
+        SkVector spotOffset;
+        SkDrawShadowMetrics::GetSpotParams(occluderHeight, devLightPos.fX, devLightPos.fY,
+                                           devLightPos.fZ, rec.fLightRadius,
+                                           &devSpaceSpotBlur, &spotScale, &spotOffset);
+
+        // The spot shadow is the occluder scaled about the device origin and then offset.
+        SkMatrix shadowMatrix = viewMatrix;
+        shadowMatrix.postScale(spotScale, spotScale);
+        shadowMatrix.postTranslate(spotOffset.fX, spotOffset.fY);
+        shadowMatrix.mapPoints(devPoints.get(), points.get(), count);
+        spotOp = GrShadowConvexOp::Make(fContext, SkColorToPremulGrColor(rec.fSpotColor),
+                                        devPoints.get(), count, devSpaceSpotBlur,
+                                        2.0f * devSpaceSpotBlur);
+        if (!spotOp) {
+            return false;
+        }
+    }
+
+    AutoCheckFlush acf(this->drawingManager());
+    if (ambientOp) {
+        this->addDrawOp(clip, std::move(ambientOp));
+    }
+    if (spotOp) {
+        this->addDrawOp(clip, std::move(spotOp));
+    }
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 bool GrRenderTargetContext::drawFilledDRRect(const GrClip& clip,
@@ -2024,6 +2095,7 @@ bool GrRenderTargetContext::setupDstProxy(GrRenderTargetProxy* rtProxy, const Gr
         clippedRect.outset(1, 1);
         clippedRect.intersect(SkIRect::MakeWH(rtProxy->width(), rtProxy->height()));
     }
+    SkIRect clipBounds = clippedRect;
     SkIRect opIBounds;
     opBounds.roundOut(&opIBounds);
     if (!clippedRect.intersect(opIBounds)) {
@@ -2033,6 +2105,16 @@ bool GrRenderTargetContext::setupDstProxy(GrRenderTargetProxy* rtProxy, const Gr
         return false;
     }
 
+    // Each copy closes the current opList, so draws that read the dst share a copy when they can.
+    // That also lets their ops be combined.
+    GrRenderTargetOpList* opList = fOpList && !fOpList->isClosed() ? fOpList.get() : nullptr;
+    if (opList && opList->findDstCopy(clippedRect, dstProxy)) {
+        return true;
+    }
+    // If this opList already started with a copy, the draws are likely to keep reading the dst, so
+    // copy everything within the clip for the draws that follow to share.
+    bool copyClipBounds = opList && opList->hasDstCopy();
+
     // MSAA consideration: When there is support for reading MSAA samples in the shader we could
     // have per-sample dst values by making the copy multisampled.
     GrSurfaceDesc desc;
@@ -2047,7 +2129,7 @@ bool GrRenderTargetContext::setupDstProxy(GrRenderTargetProxy* rtProxy, const Gr
     }
 
     if (!disallowSubrect) {
-        copyRect = clippedRect;
+        copyRect = copyClipBounds ? clipBounds : clippedRect;
     }
 
     SkIPoint dstPoint, dstOffset;
@@ -2083,5 +2165,9 @@ bool GrRenderTargetContext::setupDstProxy(GrRenderTargetProxy* rtProxy, const Gr
 
     dstProxy->setProxy(sContext->asTextureProxyRef());
     dstProxy->setOffset(dstOffset);
+    opList = this->getRTOpList();
+    if (opList->isEmpty()) {
+        opList->setDstCopy(*dstProxy, copyRect);
+    }
     return true;
 }
@@ -488,6 +488,11 @@ private:
     void drawShapeUsingPathRenderer(const GrClip&, GrPaint&&, GrAA, const SkMatrix&,
                                     const GrShape&);
 
+    // drawFastShadow() for convex polygons. Returns false, without drawing, if the path isn't
+    // one or its shadow can't be drawn analytically.
+    bool drawFastConvexShadow(const GrClip&, const SkMatrix& viewMatrix, const SkPath&,
+                              const SkDrawShadowRec&);
+
     // Allows caller of addDrawOp to know which op list an op will be added to.
     using WillAddOpFn = void(GrOp*, uint32_t opListID);
     // These perform processing specific to GrDrawOp-derived ops before recording them into an
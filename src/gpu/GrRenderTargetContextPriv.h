@@ -43,6 +43,11 @@ public:
                opList->fLastClipNumAnalyticFPs != numClipAnalyticFPs;
     }
 
+    // The clip that GrClipStackClip last reduced for the whole render target in the current opList.
+    GrRenderTargetOpList::AnalyticClip* lastAnalyticClip() {
+        return &fRenderTargetContext->getRTOpList()->fLastAnalyticClip;
+    }
+
     using CanClearFullscreen = GrRenderTargetContext::CanClearFullscreen;
 
     void clear(const GrFixedClip&, const SkPMColor4f&, CanClearFullscreen);
@@ -8,15 +8,18 @@
 #include "GrRenderTargetOpList.h"
 #include "GrAuditTrail.h"
 #include "GrCaps.h"
+#include "GrFlushTimer.h"
 #include "GrGpu.h"
 #include "GrGpuCommandBuffer.h"
 #include "GrMemoryPool.h"
+#include "GrOpFlushState.h"
 #include "GrRect.h"
 #include "GrRenderTargetContext.h"
 #include "GrResourceAllocator.h"
 #include "SkExchange.h"
 #include "SkRectPriv.h"
 #include "SkTraceEvent.h"
+#include <algorithm>
 #include "ops/GrClearOp.h"
 #include "ops/GrCopySurfaceOp.h"
 
@@ -25,6 +28,8 @@
 // Experimentally we have found that most combining occurs within the first 10 comparisons.
 static const int kMaxOpMergeDistance = 10;
 static const int kMaxOpChainDistance = 10;
+// Past kMaxOpChainDistance only chains of the op's class are tried, and only this many of them.
+static const int kMaxDistantChainCandidates = 10;
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -346,6 +351,99 @@ inline void GrRenderTargetOpList::OpChain::validate() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void GrRenderTargetOpList::ChainIndex::activate(const SkISize& targetSize, const OpChain chains[],
+                                                int count) {
+    SkASSERT(!this->isActive());
+    fCells.reset(new SkTDArray<int>[kGridSize * kGridSize]);
+    fCellsPerPixelX = (SkScalar)kGridSize / SkTMax(targetSize.width(), 1);
+    fCellsPerPixelY = (SkScalar)kGridSize / SkTMax(targetSize.height(), 1);
+    for (int i = 0; i < count; ++i) {
+        this->addChain(i, chains[i]);
+    }
+}
+
+void GrRenderTargetOpList::ChainIndex::reset() {
+    fCells.reset();
+    fPrevWithSameClassID.reset();
+    fLastWithClassID.reset();
+}
+
+SkIRect GrRenderTargetOpList::ChainIndex::cellsForBounds(const SkRect& bounds) const {
+    // Bounds that stick out of the target land in the edge cells.
+    return SkIRect::MakeLTRB(
+            SkTPin(SkScalarFloorToInt(bounds.fLeft * fCellsPerPixelX), 0, kGridSize - 1),
+            SkTPin(SkScalarFloorToInt(bounds.fTop * fCellsPerPixelY), 0, kGridSize - 1),
+            SkTPin(SkScalarFloorToInt(bounds.fRight * fCellsPerPixelX), 0, kGridSize - 1),
+            SkTPin(SkScalarFloorToInt(bounds.fBottom * fCellsPerPixelY), 0, kGridSize - 1));
+}
+
+void GrRenderTargetOpList::ChainIndex::addChain(int index, const OpChain& chain) {
+    SkASSERT(this->isActive());
+    SkASSERT(index == fPrevWithSameClassID.count());
+    uint32_t classID = chain.head()->classID();
+    while (fLastWithClassID.count() <= (int)classID) {
+        fLastWithClassID.push_back(-1);
+    }
+    fPrevWithSameClassID.push_back(fLastWithClassID[classID]);
+    fLastWithClassID[classID] = index;
+
+    SkIRect cells = this->cellsForBounds(chain.bounds());
+    for (int y = cells.fTop; y <= cells.fBottom; ++y) {
+        for (int x = cells.fLeft; x <= cells.fRight; ++x) {
+            SkTDArray<int>& cell = fCells[y * kGridSize + x];
+            SkASSERT(cell.isEmpty() || cell.top() < index);
+            cell.push_back(index);
+        }
+    }
+}
+
+void GrRenderTargetOpList::ChainIndex::updateBounds(int index, const SkRect& bounds) {
+    SkASSERT(this->isActive());
+    SkIRect cells = this->cellsForBounds(bounds);
+    for (int y = cells.fTop; y <= cells.fBottom; ++y) {
+        for (int x = cells.fLeft; x <= cells.fRight; ++x) {
+            SkTDArray<int>& cell = fCells[y * kGridSize + x];
+            int* pos = std::lower_bound(cell.begin(), cell.end(), index);
+            if (pos == cell.end() || *pos != index) {
+                *cell.insert(SkToInt(pos - cell.begin())) = index;
+            }
+        }
+    }
+}
+
+int GrRenderTargetOpList::ChainIndex::lastOverlapping(const SkRect& bounds,
+                                                      const OpChain chains[], int end) const {
+    SkASSERT(this->isActive());
+    int last = -1;
+    SkIRect cells = this->cellsForBounds(bounds);
+    for (int y = cells.fTop; y <= cells.fBottom; ++y) {
+        for (int x = cells.fLeft; x <= cells.fRight; ++x) {
+            const SkTDArray<int>& cell = fCells[y * kGridSize + x];
+            for (int i = cell.count() - 1; i >= 0 && cell[i] > last; --i) {
+                if (cell[i] < end && !can_reorder(chains[cell[i]].bounds(), bounds)) {
+                    last = cell[i];
+                    break;
+                }
+            }
+        }
+    }
+    return last;
+}
+
+int GrRenderTargetOpList::ChainIndex::lastWithClassID(uint32_t classID, int end) const {
+    SkASSERT(this->isActive());
+    if ((int)classID >= fLastWithClassID.count()) {
+        return -1;
+    }
+    int index = fLastWithClassID[classID];
+    while (index >= end) {
+        index = fPrevWithSameClassID[index];
+    }
+    return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 GrRenderTargetOpList::GrRenderTargetOpList(GrResourceProvider* resourceProvider,
                                            sk_sp<GrOpMemoryPool> opMemoryPool,
                                            GrRenderTargetProxy* proxy,
@@ -360,6 +458,9 @@ void GrRenderTargetOpList::deleteOps() {
         chain.deleteOps(fOpMemoryPool.get());
     }
     fOpChains.reset();
+    fChainIndex.reset();
+    fRetainedDraws.reset();
+    fRetainedDrawEnds.reset();
 }
 
 GrRenderTargetOpList::~GrRenderTargetOpList() {
@@ -393,13 +494,25 @@ void GrRenderTargetOpList::dump(bool printDependencies) const {
     }
 }
 
-void GrRenderTargetOpList::visitProxies_debugOnly(const GrOp::VisitProxyFunc& func) const {
+#endif
+
+void GrRenderTargetOpList::visitProxies(const GrOp::VisitProxyFunc& func) const {
     for (const OpChain& chain : fOpChains) {
         chain.visitProxies(func, GrOp::VisitorType::kOther);
     }
 }
 
-#endif
+void GrRenderTargetOpList::onPrePrepare() {
+    SkASSERT(this->isClosed());
+    if (fRetainedDraws) {
+        return;
+    }
+    for (const auto& chain : fOpChains) {
+        for (GrOp* op = chain.head(); op; op = op->nextInChain()) {
+            op->prePrepare();
+        }
+    }
+}
 
 void GrRenderTargetOpList::onPrepare(GrOpFlushState* flushState) {
     SkASSERT(fTarget.get()->peekRenderTarget());
@@ -408,6 +521,35 @@ void GrRenderTargetOpList::onPrepare(GrOpFlushState* flushState) {
     TRACE_EVENT0("skia", TRACE_FUNC);
 #endif
 
+    // A retained opList that was flushed before issues the draws its ops recorded then.
+    if (fRetainedDraws) {
+        SkASSERT(fRetainedDrawEnds.count() == fOpChains.count());
+        int start = 0;
+        for (int i = 0; i < fOpChains.count(); ++i) {
+            if (const GrOp* head = fOpChains[i].head()) {
+                flushState->replayRetainedDraws(*fRetainedDraws, start, fRetainedDrawEnds[i], head);
+            }
+            start = fRetainedDrawEnds[i];
+        }
+        return;
+    }
+
+    bool record = this->isRetained();
+    for (int i = 0; record && i < fOpChains.count(); ++i) {
+        for (const GrOp* op = fOpChains[i].head(); op; op = op->nextInChain()) {
+            if (!op->canExecuteRepeatedly()) {
+                record = false;
+                break;
+            }
+        }
+    }
+    if (record) {
+        fRetainedDraws.reset(new GrRetainedDraws);
+        flushState->beginRetainedRecording(fRetainedDraws.get());
+    } else {
+        this->stopRetaining();
+    }
+
     // Loop over the ops that haven't yet been prepared.
     for (const auto& chain : fOpChains) {
         if (chain.head()) {
@@ -424,6 +566,15 @@ void GrRenderTargetOpList::onPrepare(GrOpFlushState* flushState) {
             chain.head()->prepare(flushState);
             flushState->setOpArgs(nullptr);
         }
+        if (record) {
+            fRetainedDrawEnds.push_back(fRetainedDraws->count());
+        }
+    }
+
+    // The draws recorded so far still have to execute in this flush, so they are kept until
+    // endFlush() even if the opList can't be retained.
+    if (record && !flushState->endRetainedRecording()) {
+        this->stopRetaining();
     }
 }
 
@@ -433,7 +584,8 @@ static GrGpuRTCommandBuffer* create_command_buffer(GrGpu* gpu,
                                                    const SkRect& bounds,
                                                    GrLoadOp colorLoadOp,
                                                    const SkPMColor4f& loadClearColor,
-                                                   GrLoadOp stencilLoadOp) {
+                                                   GrLoadOp stencilLoadOp,
+                                                   GrStoreOp stencilStoreOp) {
     const GrGpuRTCommandBuffer::LoadAndStoreInfo kColorLoadStoreInfo {
         colorLoadOp,
         GrStoreOp::kStore,
@@ -447,7 +599,7 @@ static GrGpuRTCommandBuffer* create_command_buffer(GrGpu* gpu,
     // lower level (inside the VK command buffer).
     const GrGpuRTCommandBuffer::StencilLoadAndStoreInfo stencilLoadAndStoreInfo {
         stencilLoadOp,
-        GrStoreOp::kStore,
+        stencilStoreOp,
     };
 
     return gpu->getCommandBuffer(rt, origin, bounds, kColorLoadStoreInfo, stencilLoadAndStoreInfo);
@@ -470,15 +622,25 @@ bool GrRenderTargetOpList::onExecute(GrOpFlushState* flushState) {
 
     SkASSERT(fTarget.get()->peekRenderTarget());
     TRACE_EVENT0("skia", TRACE_FUNC);
-
-    // TODO: at the very least, we want the stencil store op to always be discard (at this
-    // level). In Vulkan, sub-command buffers would still need to load & store the stencil buffer.
+    GrGpu::AutoTraceSpan traceSpan(flushState->gpu(), TRACE_FUNC);
 
     // Make sure load ops are not kClear if the GPU needs to use draws for clears
     SkASSERT(fColorLoadOp != GrLoadOp::kClear ||
              !flushState->gpu()->caps()->performColorClearsAsDraws());
     SkASSERT(fStencilLoadOp != GrLoadOp::kClear ||
              !flushState->gpu()->caps()->performStencilClearsAsDraws());
+
+    // Every opList that uses the stencil clears it first, so when the backend allows it we neither
+    // load the values a previous opList left behind nor store ours. In Vulkan, the render passes
+    // within one opList still load & store the stencil buffer between them.
+    GrLoadOp stencilLoadOp = fStencilLoadOp;
+    GrStoreOp stencilStoreOp = GrStoreOp::kStore;
+    if (flushState->gpu()->caps()->discardStencilValuesAfterRenderPass()) {
+        if (GrLoadOp::kLoad == stencilLoadOp) {
+            stencilLoadOp = GrLoadOp::kDiscard;
+        }
+        stencilStoreOp = GrStoreOp::kDiscard;
+    }
     GrGpuRTCommandBuffer* commandBuffer = create_command_buffer(
                                                     flushState->gpu(),
                                                     fTarget.get()->peekRenderTarget(),
@@ -486,15 +648,20 @@ bool GrRenderTargetOpList::onExecute(GrOpFlushState* flushState) {
                                                     fTarget.get()->getBoundsRect(),
                                                     fColorLoadOp,
                                                     fLoadClearColor,
-                                                    fStencilLoadOp);
+                                                    stencilLoadOp,
+                                                    stencilStoreOp);
     flushState->setCommandBuffer(commandBuffer);
     commandBuffer->begin();
 
     // Draw all the generated geometry.
+    int numOps = 0;
     for (const auto& chain : fOpChains) {
         if (!chain.head()) {
             continue;
         }
+        for (const GrOp* op = chain.head(); op; op = op->nextInChain()) {
+            ++numOps;
+        }
 #ifdef SK_BUILD_FOR_ANDROID_FRAMEWORK
         TRACE_EVENT0("skia", chain.head()->name());
 #endif
@@ -507,7 +674,13 @@ bool GrRenderTargetOpList::onExecute(GrOpFlushState* flushState) {
         };
 
         flushState->setOpArgs(&opArgs);
-        chain.head()->execute(flushState, chain.bounds());
+        if (GrFlushTimer* timer = flushState->flushTimer()) {
+            timer->beginOp(*chain.head(), this->uniqueID());
+            chain.head()->execute(flushState, chain.bounds());
+            timer->endOp(*chain.head(), this->uniqueID());
+        } else {
+            chain.head()->execute(flushState, chain.bounds());
+        }
         flushState->setOpArgs(nullptr);
     }
 
@@ -515,22 +688,55 @@ bool GrRenderTargetOpList::onExecute(GrOpFlushState* flushState) {
     flushState->gpu()->submit(commandBuffer);
     flushState->setCommandBuffer(nullptr);
 
+    // The rest were merged into these. A retained opList that executes again merged none.
+    flushState->gpu()->frameStats()->fOpsMerged += SkTMax(fNumRecordedOps - numOps, 0);
+    fNumRecordedOps = numOps;
+
     return true;
 }
 
 void GrRenderTargetOpList::endFlush() {
     fLastClipStackGenID = SK_InvalidUniqueID;
-    this->deleteOps();
-    fClipAllocator.reset();
+    fLastAnalyticClip = AnalyticClip();
+    fDstCopy = DstProxy();
+    if (!this->isRetained()) {
+        this->deleteOps();
+        fClipAllocator.reset();
+    }
     INHERITED::endFlush();
 }
 
+bool GrRenderTargetOpList::appendOpsFrom(GrRenderTargetOpList* that) {
+    SkASSERT(this->isClosed() && that->isClosed());
+    SkASSERT(fTarget.get() == that->fTarget.get());
+    if (GrLoadOp::kLoad != that->fColorLoadOp || GrLoadOp::kLoad != that->fStencilLoadOp) {
+        return false;
+    }
+    // A retained opList's ops must stay with the draws it recorded for them.
+    if (this->isRetained() || that->isRetained()) {
+        return false;
+    }
+    // The ops must go back to the pool they came from, which differs for DDL opLists.
+    if (fOpMemoryPool != that->fOpMemoryPool) {
+        return false;
+    }
+    for (OpChain& chain : that->fOpChains) {
+        fOpChains.emplace_back(std::move(chain));
+    }
+    that->fOpChains.reset();
+    // The moved ops may upload to these before they execute.
+    fDeferredProxies.push_back_n(that->fDeferredProxies.count(), that->fDeferredProxies.begin());
+    that->fDeferredProxies.reset();
+    return true;
+}
+
 void GrRenderTargetOpList::discard() {
     // Discard calls to in-progress opLists are ignored. Calls at the start update the
     // opLists' color & stencil load ops.
     if (this->isEmpty()) {
         fColorLoadOp = GrLoadOp::kDiscard;
         fStencilLoadOp = GrLoadOp::kDiscard;
+        fDstCopy = DstProxy();
     }
 }
 
@@ -541,6 +747,26 @@ void GrRenderTargetOpList::setStencilLoadOp(GrLoadOp op) {
 void GrRenderTargetOpList::setColorLoadOp(GrLoadOp op, const SkPMColor4f& color) {
     fColorLoadOp = op;
     fLoadClearColor = color;
+    if (GrLoadOp::kLoad != op) {
+        // The target's old contents are gone.
+        fDstCopy = DstProxy();
+    }
+}
+
+void GrRenderTargetOpList::setDstCopy(const DstProxy& dstCopy, const SkIRect& copyRect) {
+    SkASSERT(this->isEmpty() && GrLoadOp::kLoad == fColorLoadOp);
+    fDstCopy = dstCopy;
+    fDstCopyRect = copyRect;
+    fDstCopyDirtyBounds.setEmpty();
+}
+
+bool GrRenderTargetOpList::findDstCopy(const SkIRect& readRect, DstProxy* dstProxy) const {
+    if (!fDstCopy.proxy() || !fDstCopyRect.contains(readRect) ||
+        SkIRect::Intersects(fDstCopyDirtyBounds, readRect)) {
+        return false;
+    }
+    *dstProxy = fDstCopy;
+    return true;
 }
 
 bool GrRenderTargetOpList::resetForFullscreenClear() {
@@ -549,6 +775,7 @@ bool GrRenderTargetOpList::resetForFullscreenClear() {
     // after a regular clear(), we could end up with a clear load op and a real clear op in the list
     // if the load op were not reset here.
     fColorLoadOp = GrLoadOp::kDiscard;
+    fDstCopy = DstProxy();
 
     // Regardless of how the clear is implemented (native clear or a fullscreen quad), all prior ops
     // would be overwritten, so discard them entirely. The one exception is if the opList is marked
@@ -656,6 +883,14 @@ void GrRenderTargetOpList::recordOp(
         fOpMemoryPool->release(std::move(op));
         return;
     }
+    ++fNumRecordedOps;
+    if (fDstCopy.proxy()) {
+        SkRect opBounds = op->bounds();
+        if (op->hasAABloat() || op->hasZeroArea()) {
+            opBounds.outset(0.5f, 0.5f);
+        }
+        fDstCopyDirtyBounds.join(opBounds.roundOut());
+    }
 
     // Check if there is an op we can combine with by linearly searching back until we either
     // 1) check every op
@@ -679,6 +914,9 @@ void GrRenderTargetOpList::recordOp(
             op = candidate.appendOp(std::move(op), processorAnalysis, dstProxy, clip, caps,
                                     fOpMemoryPool.get(), fAuditTrail);
             if (!op) {
+                if (fChainIndex.isActive()) {
+                    fChainIndex.updateBounds(fOpChains.count() - 1 - i, candidate.bounds());
+                }
                 return;
             }
             // Stop going backwards if we would cause a painter's order violation.
@@ -689,6 +927,13 @@ void GrRenderTargetOpList::recordOp(
             }
             if (++i == maxCandidates) {
                 GrOP_INFO("\t\tBackward: Reached max lookback or beginning of op array %d\n", i);
+                if (i < fOpChains.count()) {
+                    op = this->appendToDistantChain(std::move(op), processorAnalysis, clip,
+                                                    dstProxy, caps, fOpChains.count() - i);
+                    if (!op) {
+                        return;
+                    }
+                }
                 break;
             }
         }
@@ -700,11 +945,42 @@ void GrRenderTargetOpList::recordOp(
         SkDEBUGCODE(fNumClips++;)
     }
     fOpChains.emplace_back(std::move(op), processorAnalysis, clip, dstProxy);
+    if (fChainIndex.isActive()) {
+        fChainIndex.addChain(fOpChains.count() - 1, fOpChains.back());
+    }
+}
+
+std::unique_ptr<GrOp> GrRenderTargetOpList::appendToDistantChain(
+        std::unique_ptr<GrOp> op, GrProcessorSet::Analysis processorAnalysis, GrAppliedClip* clip,
+        const DstProxy* dstProxy, const GrCaps& caps, int end) {
+    if (!fChainIndex.isActive()) {
+        fChainIndex.activate(SkISize::Make(fTarget.get()->width(), fTarget.get()->height()),
+                             fOpChains.begin(), fOpChains.count());
+    }
+    // The op can move back past any chain after the last one it overlaps.
+    int barrier = fChainIndex.lastOverlapping(op->bounds(), fOpChains.begin(), end);
+    int numCandidates = 0;
+    for (int i = fChainIndex.lastWithClassID(op->classID(), end);
+         i > barrier && numCandidates < kMaxDistantChainCandidates;
+         i = fChainIndex.prevWithSameClassID(i), ++numCandidates) {
+        OpChain& candidate = fOpChains[i];
+        op = candidate.appendOp(std::move(op), processorAnalysis, dstProxy, clip, caps,
+                                fOpMemoryPool.get(), fAuditTrail);
+        if (!op) {
+            GrOP_INFO("\t\tBackward: Combined with distant chain %d (%s, head opID: %u)\n", i,
+                      candidate.head()->name(), candidate.head()->uniqueID());
+            fChainIndex.updateBounds(i, candidate.bounds());
+            return nullptr;
+        }
+    }
+    return op;
 }
 
 void GrRenderTargetOpList::forwardCombine(const GrCaps& caps) {
     SkASSERT(!this->isClosed());
     GrOP_INFO("opList: %d ForwardCombine %d ops:\n", this->uniqueID(), fOpChains.count());
+    // No more ops will be recorded.
+    fChainIndex.reset();
 
     for (int i = 0; i < fOpChains.count() - 1; ++i) {
         OpChain& chain = fOpChains[i];
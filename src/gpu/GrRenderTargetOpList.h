@@ -20,6 +20,7 @@
 #include "SkStringUtils.h"
 #include "SkStrokeRec.h"
 #include "SkTArray.h"
+#include "SkTDArray.h"
 #include "SkTLazy.h"
 #include "SkTypes.h"
 
@@ -27,6 +28,7 @@ class GrAuditTrail;
 class GrClearOp;
 class GrCaps;
 class GrRenderTargetProxy;
+class GrRetainedDraws;
 
 class GrRenderTargetOpList final : public GrOpList {
 private:
@@ -59,6 +61,7 @@ public:
      * Together these two functions flush all queued up draws to GrCommandBuffer. The return value
      * of executeOps() indicates whether any commands were actually issued to the GPU.
      */
+    void onPrePrepare() override;
     void onPrepare(GrOpFlushState* flushState) override;
     bool onExecute(GrOpFlushState* flushState) override;
 
@@ -110,7 +113,33 @@ public:
 
     SkDEBUGCODE(void dump(bool printDependencies) const override;)
     SkDEBUGCODE(int numClips() const override { return fNumClips; })
-    SkDEBUGCODE(void visitProxies_debugOnly(const GrOp::VisitProxyFunc&) const;)
+
+    // Visits every proxy read by the recorded ops, their dst copies and their clips.
+    void visitProxies(const GrOp::VisitProxyFunc&) const;
+
+    // Moves the ops of 'that', a later closed opList on the same target, to the end of this one so
+    // that they execute in the same render pass. The caller must ensure that no opList in between
+    // reads the target or is read by 'that'. Fails if 'that' doesn't start by loading the
+    // target's contents or allocates its ops from another pool. The moved ops' clips are still
+    // owned by 'that', so it must not be flushed before this opList.
+    bool appendOpsFrom(GrRenderTargetOpList* that);
+
+    // GrClipStackClip's reduction of the last clip stack it applied in this opList, made for the
+    // whole render target. When that needs no mask, later draws with the same clip reuse it. That
+    // saves reducing the stack for each draw and gives their ops equal clips, so they can still be
+    // combined.
+    struct AnalyticClip {
+        uint32_t                             fClipStackGenID = SK_InvalidUniqueID;
+        int                                  fMaxWindowRectangles = 0;
+        int                                  fMaxAnalyticFPs = 0;
+        // False if the clip needs a mask or stencil. Then each draw reduces the clip itself.
+        bool                                 fIsAnalytic = false;
+        bool                                 fClipsEverything = false;
+        bool                                 fHasScissor = false;
+        SkIRect                              fScissor;
+        GrWindowRectangles                   fWindowRectangles;
+        std::unique_ptr<GrFragmentProcessor> fFP;
+    };
 
 private:
     friend class GrRenderTargetContextPriv; // for stencil clip state. TODO: this is invasive
@@ -131,6 +160,15 @@ private:
         this->setColorLoadOp(op, kDefaultClearColor);
     }
 
+    // Records the dst copy that the RTC made of the target just before this opList was started.
+    // 'copyRect' is the part of the target, in device space, that the copy holds.
+    void setDstCopy(const DstProxy&, const SkIRect& copyRect);
+    // Returns true and sets 'dstProxy' if the dst copy still holds the target's contents over
+    // 'readRect', i.e. the copy covers it and no op since the copy has drawn into it. Then draws that
+    // read the dst can share one copy, and their ops can be combined.
+    bool findDstCopy(const SkIRect& readRect, DstProxy* dstProxy) const;
+    bool hasDstCopy() const { return SkToBool(fDstCopy.proxy()); }
+
     // Perform book-keeping for a fullscreen clear, regardless of how the clear is implemented later
     // (i.e. setColorLoadOp(), adding a ClearOp, or adding a GrFillRectOp that covers the device).
     // Returns true if the clear can be converted into a load op (barring device caps).
@@ -142,6 +180,7 @@ private:
     public:
         OpChain(const OpChain&) = delete;
         OpChain& operator=(const OpChain&) = delete;
+        OpChain(OpChain&&) = default;
         OpChain(std::unique_ptr<GrOp>, GrProcessorSet::Analysis, GrAppliedClip*, const DstProxy*);
 
         ~OpChain() {
@@ -209,6 +248,42 @@ private:
         SkRect fBounds;
     };
 
+    // Indexes the recorded chains so that recordOp() can find merge candidates further back than
+    // kMaxOpChainDistance. The target is divided into a grid and each cell lists, in increasing
+    // order, the chains whose bounds touch it, which finds the latest chain an op would have to be
+    // reordered across without visiting every chain since. Chains are also linked to the previous
+    // chain of the same op class, since only those can merge.
+    class ChainIndex {
+    public:
+        bool isActive() const { return SkToBool(fCells); }
+
+        // Starts indexing on a target of the given size, beginning with the chains recorded so far.
+        void activate(const SkISize& targetSize, const OpChain chains[], int count);
+        void reset();
+
+        // Must be called with each new chain's index, which must be the number of chains so far.
+        void addChain(int index, const OpChain&);
+        // Must be called after the bounds of a chain grow.
+        void updateBounds(int index, const SkRect& bounds);
+
+        // Returns the latest chain before 'end' whose bounds overlap 'bounds', or -1.
+        int lastOverlapping(const SkRect& bounds, const OpChain chains[], int end) const;
+        // Returns the latest chain before 'end' whose ops have the given class ID, or -1.
+        int lastWithClassID(uint32_t classID, int end) const;
+        int prevWithSameClassID(int index) const { return fPrevWithSameClassID[index]; }
+
+    private:
+        static constexpr int kGridSize = 16;
+
+        SkIRect cellsForBounds(const SkRect& bounds) const;
+
+        std::unique_ptr<SkTDArray<int>[]> fCells;
+        SkScalar fCellsPerPixelX = 0;
+        SkScalar fCellsPerPixelY = 0;
+        SkTDArray<int> fPrevWithSameClassID;
+        SkTDArray<int> fLastWithClassID;
+    };
+
     void purgeOpsWithUninstantiatedProxies() override;
 
     void gatherProxyIntervals(GrResourceAllocator*) const override;
@@ -216,20 +291,43 @@ private:
     void recordOp(std::unique_ptr<GrOp>, GrProcessorSet::Analysis, GrAppliedClip*, const DstProxy*,
                   const GrCaps& caps);
 
+    // Called when the recent chains neither overlap nor accept the op. Tries the chains before
+    // 'end' that the op could move back to without a painter's order violation. Returns 'op' to
+    // the caller upon failure, otherwise null.
+    std::unique_ptr<GrOp> appendToDistantChain(std::unique_ptr<GrOp>, GrProcessorSet::Analysis,
+                                               GrAppliedClip*, const DstProxy*, const GrCaps&,
+                                               int end);
+
     void forwardCombine(const GrCaps&);
 
     uint32_t                       fLastClipStackGenID;
     SkIRect                        fLastDevClipBounds;
     int                            fLastClipNumAnalyticFPs;
 
+    AnalyticClip                   fLastAnalyticClip;
+
+    DstProxy                       fDstCopy;
+    SkIRect                        fDstCopyRect;
+    // Device space bounds of the ops recorded since fDstCopy was made.
+    SkIRect                        fDstCopyDirtyBounds;
+
     // For ops/opList we have mean: 5 stdDev: 28
     SkSTArray<25, OpChain, true> fOpChains;
+    // The ops recorded since the last execute, so it can count how many were merged into others.
+    int                          fNumRecordedOps = 0;
+    // Only active while recording op lists with more than kMaxOpChainDistance chains.
+    ChainIndex                     fChainIndex;
 
     // MDB TODO: 4096 for the first allocation of the clip space will be huge overkill.
     // Gather statistics to determine the correct size.
     SkArenaAlloc                   fClipAllocator{4096};
     SkDEBUGCODE(int                fNumClips;)
 
+    // Recorded on the first flush of a retained opList. The draws of chain i end at
+    // fRetainedDrawEnds[i].
+    std::unique_ptr<GrRetainedDraws> fRetainedDraws;
+    SkTDArray<int>                 fRetainedDrawEnds;
+
     typedef GrOpList INHERITED;
 };
 
@@ -239,7 +239,8 @@ void GrResourceAllocator::recycleSurface(sk_sp<GrSurface> surface) {
 // First try to reuse one of the recently allocated/used GrSurfaces in the free pool.
 // If we can't find a useable one, create a new one.
 sk_sp<GrSurface> GrResourceAllocator::findSurfaceFor(const GrSurfaceProxy* proxy,
-                                                     bool needsStencil) {
+                                                     bool needsStencil, bool* fromFreePool) {
+    *fromFreePool = false;
 
     if (proxy->asTextureProxy() && proxy->asTextureProxy()->getUniqueKey().isValid()) {
         // First try to reattach to a cached version if the proxy is uniquely keyed
@@ -277,6 +278,7 @@ sk_sp<GrSurface> GrResourceAllocator::findSurfaceFor(const GrSurfaceProxy* proxy
             return nullptr;
         }
         SkASSERT(!surface->getUniqueKey().isValid());
+        *fromFreePool = true;
         return surface;
     }
 
@@ -293,6 +295,8 @@ void GrResourceAllocator::expire(unsigned int curIndex) {
 
         if (temp->wasAssignedSurface()) {
             sk_sp<GrSurface> surface = temp->detachSurface();
+            SkASSERT(fLiveTransientBytes >= surface->gpuMemorySize());
+            fLiveTransientBytes -= surface->gpuMemorySize();
 
             // If the proxy has an actual live ref on it that means someone wants to retain its
             // contents. In that case we cannot recycle it (until the external holder lets
@@ -372,6 +376,7 @@ bool GrResourceAllocator::assign(int* startIndex, int* stopIndex, AssignError* o
             continue;
         }
 
+        bool fromFreePool;
         if (GrSurfaceProxy::LazyState::kNot != cur->proxy()->lazyInstantiationState()) {
             if (!cur->proxy()->priv().doLazyInstantiation(fResourceProvider)) {
                 *outError = AssignError::kFailedProxyInstantiation;
@@ -381,7 +386,8 @@ bool GrResourceAllocator::assign(int* startIndex, int* stopIndex, AssignError* o
                     fDeinstantiateTracker->addProxy(cur->proxy());
                 }
             }
-        } else if (sk_sp<GrSurface> surface = this->findSurfaceFor(cur->proxy(), needsStencil)) {
+        } else if (sk_sp<GrSurface> surface = this->findSurfaceFor(cur->proxy(), needsStencil,
+                                                                   &fromFreePool)) {
             // TODO: make getUniqueKey virtual on GrSurfaceProxy
             GrTextureProxy* texProxy = cur->proxy()->asTextureProxy();
 
@@ -399,6 +405,13 @@ bool GrResourceAllocator::assign(int* startIndex, int* stopIndex, AssignError* o
                  cur->proxy()->uniqueID().asUInt());
 #endif
 
+            size_t size = surface->gpuMemorySize();
+            if (!fromFreePool) {
+                fAllocatedTransientBytes += size;
+            }
+            fLiveTransientBytes += size;
+            fPeakTransientBytes = SkTMax(fPeakTransientBytes, fLiveTransientBytes);
+
             cur->assign(std::move(surface));
         } else {
             SkASSERT(!cur->proxy()->isInstantiated());
@@ -78,6 +78,13 @@ public:
 
     void markEndOfOpList(int opListIndex);
 
+    // The most GPU memory held at once by the surfaces assigned to intervals, and the total memory
+    // of the surfaces that didn't come from the free pool. The peak is what the flush would need
+    // if every pair of intervals that don't overlap could alias the same memory; the excess of
+    // the total over it is memory the free pool couldn't reuse because the descriptors differed.
+    size_t peakTransientBytes() const { return fPeakTransientBytes; }
+    size_t allocatedTransientBytes() const { return fAllocatedTransientBytes; }
+
 #if GR_ALLOCATION_SPEW
     void dumpIntervals();
 #endif
@@ -90,7 +97,8 @@ private:
 
     // These two methods wrap the interactions with the free pool
     void recycleSurface(sk_sp<GrSurface> surface);
-    sk_sp<GrSurface> findSurfaceFor(const GrSurfaceProxy* proxy, bool needsStencil);
+    sk_sp<GrSurface> findSurfaceFor(const GrSurfaceProxy* proxy, bool needsStencil,
+                                    bool* fromFreePool);
 
     struct FreePoolTraits {
         static const GrScratchKey& GetKey(const GrSurface& s) {
@@ -224,6 +232,10 @@ private:
     SkTArray<unsigned int>       fEndOfOpListOpIndices;
     int                          fCurOpListIndex = 0;
 
+    size_t                       fLiveTransientBytes = 0;
+    size_t                       fPeakTransientBytes = 0;
+    size_t                       fAllocatedTransientBytes = 0;
+
     SkDEBUGCODE(bool             fAssigned = false;)
 
     char                         fStorage[kInitialArenaSize];
@@ -7,6 +7,7 @@
 
 #include "GrResourceCache.h"
 #include <atomic>
+#include <cfloat>
 #include "GrCaps.h"
 #include "GrGpuResourceCacheAccess.h"
 #include "GrProxyProvider.h"
@@ -19,8 +20,10 @@
 #include "SkOpts.h"
 #include "SkRandom.h"
 #include "SkScopeExit.h"
+#include "SkTHash.h"
 #include "SkTSort.h"
 #include "SkTo.h"
+#include "SkTraceMemoryDump.h"
 
 DECLARE_SKMESSAGEBUS_MESSAGE(GrUniqueKeyInvalidatedMessage);
 
@@ -105,6 +108,88 @@ void GrResourceCache::setLimits(int count, size_t bytes) {
     this->purgeAsNeeded();
 }
 
+void GrResourceCache::setCategoryBudget(GrResourceCategory category, size_t softMaxBytes,
+                                        float evictionWeight) {
+    SkASSERT(evictionWeight > 0);
+    fCategoryBudgets[(int)category] = {softMaxBytes, SkTMax(evictionWeight, FLT_MIN)};
+
+    fHasCategoryBudgets = false;
+    for (const CategoryBudget& budget : fCategoryBudgets) {
+        if (budget.fSoftMaxBytes != SIZE_MAX || budget.fEvictionWeight != 1) {
+            fHasCategoryBudgets = true;
+        }
+    }
+    this->purgeAsNeeded();
+}
+
+void GrResourceCache::getCategoryUsage(GrResourceCategory category, int* count,
+                                       size_t* bytes) const {
+    int categoryCount = 0;
+    size_t categoryBytes = 0;
+    auto add = [&](const GrGpuResource* resource) {
+        if (GrBudgetedType::kBudgeted == resource->resourcePriv().budgetedType() &&
+            CategoryOf(resource) == category) {
+            ++categoryCount;
+            categoryBytes += resource->gpuMemorySize();
+        }
+    };
+    for (int i = 0; i < fNonpurgeableResources.count(); ++i) {
+        add(fNonpurgeableResources[i]);
+    }
+    for (int i = 0; i < fPurgeableQueue.count(); ++i) {
+        add(fPurgeableQueue.at(i));
+    }
+    if (count) {
+        *count = categoryCount;
+    }
+    if (bytes) {
+        *bytes = categoryBytes;
+    }
+}
+
+GrResourceCategory GrResourceCache::CategoryOf(const GrGpuResource* resource) {
+    const GrUniqueKey& key = resource->getUniqueKey();
+    if (!key.isValid()) {
+        return GrResourceCategory::kScratch;
+    }
+    // Unique keys don't otherwise say what they're for, but their tags do.
+    static const struct {
+        const char*        fTag;
+        GrResourceCategory fCategory;
+    } kTagCategories[] = {
+        { "Image",               GrResourceCategory::kImage    },
+        { "promise",             GrResourceCategory::kImage    },
+        { "CCPR Atlas",          GrResourceCategory::kAtlas    },
+        { "Path",                GrResourceCategory::kPathMask },
+        { "SW Path Mask",        GrResourceCategory::kPathMask },
+        { "Mask Filtered Masks", GrResourceCategory::kPathMask },
+        { "Rect Blur Mask",      GrResourceCategory::kPathMask },
+        { "RoundRect Blur Mask", GrResourceCategory::kPathMask },
+        { "1-D Circular Blur",   GrResourceCategory::kPathMask },
+        { "clip_mask",           GrResourceCategory::kPathMask },
+    };
+    if (const char* tag = key.tag()) {
+        for (const auto& entry : kTagCategories) {
+            if (0 == strcmp(tag, entry.fTag)) {
+                return entry.fCategory;
+            }
+        }
+    }
+    return GrResourceCategory::kOther;
+}
+
+const char* GrResourceCache::CategoryName(GrResourceCategory category) {
+    switch (category) {
+        case GrResourceCategory::kScratch:  return "scratch";
+        case GrResourceCategory::kImage:    return "image";
+        case GrResourceCategory::kAtlas:    return "atlas";
+        case GrResourceCategory::kPathMask: return "path_mask";
+        case GrResourceCategory::kOther:    return "other";
+    }
+    SkDEBUGFAIL("Unknown resource category");
+    return "";
+}
+
 void GrResourceCache::insertResource(GrGpuResource* resource) {
     ASSERT_SINGLE_OWNER
     SkASSERT(resource);
@@ -309,7 +394,7 @@ void GrResourceCache::removeUniqueKey(GrGpuResource* resource) {
     // Someone has a ref to this resource in order to have removed the key. When the ref count
     // reaches zero we will get a ref cnt notification and figure out what to do with it.
     if (resource->getUniqueKey().isValid()) {
-        SkASSERT(resource == fUniqueHash.find(resource->getUniqueKey()));
+        SkASSERT(resource == fUniqueHash.findOrNull(resource->getUniqueKey()));
         fUniqueHash.remove(resource->getUniqueKey());
     }
     resource->cacheAccess().removeUniqueKey();
@@ -331,7 +416,7 @@ void GrResourceCache::changeUniqueKey(GrGpuResource* resource, const GrUniqueKey
 
     // If another resource has the new key, remove its key then install the key on this resource.
     if (newKey.isValid()) {
-        if (GrGpuResource* old = fUniqueHash.find(newKey)) {
+        if (GrGpuResource* old = fUniqueHash.findOrNull(newKey)) {
             // If the old resource using the key is purgeable and is unreachable, then remove it.
             if (!old->resourcePriv().getScratchKey().isValid() &&
                 old->resourcePriv().isPurgeable()) {
@@ -341,13 +426,13 @@ void GrResourceCache::changeUniqueKey(GrGpuResource* resource, const GrUniqueKey
                 this->removeUniqueKey(sk_ref_sp(old).get());
             }
         }
-        SkASSERT(nullptr == fUniqueHash.find(newKey));
+        SkASSERT(nullptr == fUniqueHash.findOrNull(newKey));
 
         // Remove the entry for this resource if it already has a unique key.
         if (resource->getUniqueKey().isValid()) {
-            SkASSERT(resource == fUniqueHash.find(resource->getUniqueKey()));
+            SkASSERT(resource == fUniqueHash.findOrNull(resource->getUniqueKey()));
             fUniqueHash.remove(resource->getUniqueKey());
-            SkASSERT(nullptr == fUniqueHash.find(resource->getUniqueKey()));
+            SkASSERT(nullptr == fUniqueHash.findOrNull(resource->getUniqueKey()));
         } else {
             // 'resource' didn't have a valid unique key before so it is switching sides. Remove it
             // from the ScratchMap
@@ -357,7 +442,7 @@ void GrResourceCache::changeUniqueKey(GrGpuResource* resource, const GrUniqueKey
         }
 
         resource->cacheAccess().setUniqueKey(newKey);
-        fUniqueHash.add(resource);
+        fUniqueHash.set(resource);
     } else {
         this->removeUniqueKey(resource);
     }
@@ -450,6 +535,7 @@ void GrResourceCache::notifyCntReachedZero(GrGpuResource* resource, uint32_t fla
     }
 
     SkDEBUGCODE(int beforeCount = this->getResourceCount();)
+    ++fNumPurges;
     resource->cacheAccess().release();
     // We should at least free this resource, perhaps dependent resources as well.
     SkASSERT(this->getResourceCount() < beforeCount);
@@ -502,10 +588,15 @@ void GrResourceCache::purgeAsNeeded() {
 
     this->processFreedGpuResources();
 
+    if (fHasCategoryBudgets && this->overBudget()) {
+        this->purgeByCategory();
+    }
+
     bool stillOverbudget = this->overBudget();
     while (stillOverbudget && fPurgeableQueue.count()) {
         GrGpuResource* resource = fPurgeableQueue.peek();
         SkASSERT(resource->resourcePriv().isPurgeable());
+        ++fNumPurges;
         resource->cacheAccess().release();
         stillOverbudget = this->overBudget();
     }
@@ -513,6 +604,64 @@ void GrResourceCache::purgeAsNeeded() {
     this->validate();
 }
 
+void GrResourceCache::purgeByCategory() {
+    size_t categoryBytes[kGrResourceCategoryCount] = {};
+    for (int i = 0; i < fNonpurgeableResources.count(); ++i) {
+        const GrGpuResource* resource = fNonpurgeableResources[i];
+        if (GrBudgetedType::kBudgeted == resource->resourcePriv().budgetedType()) {
+            categoryBytes[(int)CategoryOf(resource)] += resource->gpuMemorySize();
+        }
+    }
+
+    // Split the purgeable resources into per-category lists, each in LRU order. Releasing a
+    // purgeable resource never frees another one, so these stay valid while we purge.
+    fPurgeableQueue.sort();
+    SkTDArray<GrGpuResource*> candidates[kGrResourceCategoryCount];
+    for (int i = 0; i < fPurgeableQueue.count(); ++i) {
+        GrGpuResource* resource = fPurgeableQueue.at(i);
+        int category = (int)CategoryOf(resource);
+        *candidates[category].append() = resource;
+        if (GrBudgetedType::kBudgeted == resource->resourcePriv().budgetedType()) {
+            categoryBytes[category] += resource->gpuMemorySize();
+        }
+    }
+
+    int next[kGrResourceCategoryCount] = {};
+    while (this->overBudget()) {
+        // Categories over their soft budgets go first, oldest resource first. Otherwise pick
+        // the resource that is oldest relative to the cost of recreating it.
+        int victim = -1;
+        bool victimOverSoftBudget = false;
+        float victimScore = 0;
+        for (int c = 0; c < kGrResourceCategoryCount; ++c) {
+            if (next[c] == candidates[c].count()) {
+                continue;
+            }
+            const GrGpuResource* resource = candidates[c][next[c]];
+            bool overSoftBudget = categoryBytes[c] > fCategoryBudgets[c].fSoftMaxBytes;
+            float age = (float)(fTimestamp - resource->cacheAccess().timestamp()) + 1;
+            float score = overSoftBudget ? -(float)resource->cacheAccess().timestamp()
+                                         : age / fCategoryBudgets[c].fEvictionWeight;
+            if (victim < 0 || (overSoftBudget && !victimOverSoftBudget) ||
+                (overSoftBudget == victimOverSoftBudget && score > victimScore)) {
+                victim = c;
+                victimOverSoftBudget = overSoftBudget;
+                victimScore = score;
+            }
+        }
+        if (victim < 0) {
+            break;
+        }
+        GrGpuResource* resource = candidates[victim][next[victim]++];
+        SkASSERT(resource->resourcePriv().isPurgeable());
+        if (GrBudgetedType::kBudgeted == resource->resourcePriv().budgetedType()) {
+            categoryBytes[victim] -= resource->gpuMemorySize();
+        }
+        ++fNumPurges;
+        resource->cacheAccess().release();
+    }
+}
+
 void GrResourceCache::purgeUnlockedResources(bool scratchResourcesOnly) {
     if (!scratchResourcesOnly) {
         // We could disable maintaining the heap property here, but it would add a lot of
@@ -520,6 +669,7 @@ void GrResourceCache::purgeUnlockedResources(bool scratchResourcesOnly) {
         while (fPurgeableQueue.count()) {
             GrGpuResource* resource = fPurgeableQueue.peek();
             SkASSERT(resource->resourcePriv().isPurgeable());
+            ++fNumPurges;
             resource->cacheAccess().release();
         }
     } else {
@@ -539,6 +689,7 @@ void GrResourceCache::purgeUnlockedResources(bool scratchResourcesOnly) {
         // Delete the scratch resources. This must be done as a separate pass
         // to avoid messing up the sorted order of the queue
         for (int i = 0; i < scratchResources.count(); i++) {
+            ++fNumPurges;
             scratchResources.getAt(i)->cacheAccess().release();
         }
     }
@@ -560,6 +711,7 @@ void GrResourceCache::purgeResourcesNotUsedSince(GrStdSteadyClock::time_point pu
         }
         GrGpuResource* resource = fPurgeableQueue.peek();
         SkASSERT(resource->resourcePriv().isPurgeable());
+        ++fNumPurges;
         resource->cacheAccess().release();
     }
 }
@@ -589,6 +741,7 @@ void GrResourceCache::purgeUnlockedResources(size_t bytesToPurge, bool preferScr
         // Delete the scratch resources. This must be done as a separate pass
         // to avoid messing up the sorted order of the queue
         for (int i = 0; i < scratchResources.count(); i++) {
+            ++fNumPurges;
             scratchResources.getAt(i)->cacheAccess().release();
         }
         stillOverbudget = tmpByteBudget < fBytes;
@@ -708,12 +861,110 @@ uint32_t GrResourceCache::getNextTimestamp() {
     return fTimestamp++;
 }
 
+namespace {
+struct MemoryTotals {
+    int    fCount = 0;
+    size_t fBytes = 0;
+    size_t fPurgeableBytes = 0;
+
+    void add(const GrGpuResource* resource) {
+        size_t size = resource->gpuMemorySize();
+        ++fCount;
+        fBytes += size;
+        if (resource->resourcePriv().isPurgeable()) {
+            fPurgeableBytes += size;
+        }
+    }
+
+    void dump(SkTraceMemoryDump* traceMemoryDump, const char* dumpName) const {
+        traceMemoryDump->dumpNumericValue(dumpName, "total_size", "bytes", fBytes);
+        traceMemoryDump->dumpNumericValue(dumpName, "total_purgeable_size", "bytes",
+                                          fPurgeableBytes);
+        traceMemoryDump->dumpNumericValue(dumpName, "resources", "objects", fCount);
+    }
+};
+
+// The owner of a resource is what its unique key is for, as named by the key's tag.
+const char* owner_of(const GrGpuResource* resource) {
+    const GrUniqueKey& key = resource->getUniqueKey();
+    if (!key.isValid()) {
+        return "Scratch";
+    }
+    return key.tag() ? key.tag() : "Other";
+}
+}
+
 void GrResourceCache::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
+    MemoryTotals categoryTotals[kGrResourceCategoryCount];
+    SkTHashMap<SkString, MemoryTotals> ownerTotals;
+    auto dump = [&](const GrGpuResource* resource) {
+        resource->dumpMemoryStatistics(traceMemoryDump);
+        if (resource->resourcePriv().refsWrappedObjects() &&
+            !traceMemoryDump->shouldDumpWrappedObjects()) {
+            return;
+        }
+        categoryTotals[(int)CategoryOf(resource)].add(resource);
+        SkString owner(owner_of(resource));
+        if (MemoryTotals* totals = ownerTotals.find(owner)) {
+            totals->add(resource);
+        } else {
+            ownerTotals.set(owner, MemoryTotals())->add(resource);
+        }
+    };
     for (int i = 0; i < fNonpurgeableResources.count(); ++i) {
-        fNonpurgeableResources[i]->dumpMemoryStatistics(traceMemoryDump);
+        dump(fNonpurgeableResources[i]);
     }
     for (int i = 0; i < fPurgeableQueue.count(); ++i) {
-        fPurgeableQueue.at(i)->dumpMemoryStatistics(traceMemoryDump);
+        dump(fPurgeableQueue.at(i));
+    }
+
+    for (int i = 0; i < kGrResourceCategoryCount; ++i) {
+        SkString dumpName("skia/gpu_categories/");
+        dumpName.append(CategoryName((GrResourceCategory)i));
+        categoryTotals[i].dump(traceMemoryDump, dumpName.c_str());
+    }
+    ownerTotals.foreach([traceMemoryDump](const SkString& owner, MemoryTotals* totals) {
+        SkString dumpName("skia/gpu_owners/");
+        dumpName.append(owner);
+        totals->dump(traceMemoryDump, dumpName.c_str());
+    });
+}
+
+void GrResourceCache::dumpLargestResources(SkTraceMemoryDump* traceMemoryDump,
+                                           int maxCount) const {
+    if (maxCount <= 0) {
+        return;
+    }
+    SkTDArray<GrGpuResource*> resources;
+    resources.setReserve(this->getResourceCount());
+    for (int i = 0; i < fNonpurgeableResources.count(); ++i) {
+        *resources.append() = fNonpurgeableResources[i];
+    }
+    for (int i = 0; i < fPurgeableQueue.count(); ++i) {
+        *resources.append() = fPurgeableQueue.at(i);
+    }
+    if (resources.isEmpty()) {
+        return;
+    }
+    SkTQSort(resources.begin(), resources.end() - 1,
+             [](const GrGpuResource* a, const GrGpuResource* b) {
+                 return a->gpuMemorySize() > b->gpuMemorySize();
+             });
+
+    int count = SkTMin(maxCount, resources.count());
+    for (int i = 0; i < count; ++i) {
+        const GrGpuResource* resource = resources[i];
+        SkString dumpName("skia/gpu_largest/");
+        dumpName.appendS32(i);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "total_size", "bytes",
+                                          resource->gpuMemorySize());
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "resource_id", "id",
+                                          resource->uniqueID().asUInt());
+        traceMemoryDump->dumpStringValue(dumpName.c_str(), "budget_category",
+                                         CategoryName(CategoryOf(resource)));
+        traceMemoryDump->dumpStringValue(dumpName.c_str(), "owner", owner_of(resource));
+        bool budgeted = GrBudgetedType::kBudgeted == resource->resourcePriv().budgetedType();
+        traceMemoryDump->dumpStringValue(dumpName.c_str(), "budgeted", budgeted ? "yes" : "no");
     }
 }
 
@@ -769,7 +1020,7 @@ void GrResourceCache::validate() const {
             }
             if (uniqueKey.isValid()) {
                 ++fContent;
-                SkASSERT(fUniqueHash->find(uniqueKey) == resource);
+                SkASSERT(fUniqueHash->findOrNull(uniqueKey) == resource);
                 SkASSERT(GrBudgetedType::kBudgeted == resource->resourcePriv().budgetedType() ||
                          resource->resourcePriv().refsWrappedObjects());
 
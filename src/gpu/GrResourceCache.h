@@ -16,6 +16,7 @@
 #include "SkRefCnt.h"
 #include "SkTArray.h"
 #include "SkTDPQueue.h"
+#include "SkTFlatHash.h"
 #include "SkTInternalLList.h"
 #include "SkTMultiMap.h"
 
@@ -73,6 +74,18 @@ public:
     /** Sets the cache limits in terms of number of resources and max gpu memory byte size. */
     void setLimits(int count, size_t bytes);
 
+    /** Sets a soft budget and eviction weight for a category. See GrContext. */
+    void setCategoryBudget(GrResourceCategory, size_t softMaxBytes, float evictionWeight);
+
+    /** Returns the number of budgeted resources in a category, and the bytes they use. */
+    void getCategoryUsage(GrResourceCategory, int* count, size_t* bytes) const;
+
+    /** Which category a resource belongs to, judged by its keys. */
+    static GrResourceCategory CategoryOf(const GrGpuResource*);
+
+    /** A short, stable name for a category, used in memory dumps. */
+    static const char* CategoryName(GrResourceCategory);
+
     /**
      * Returns the number of resources.
      */
@@ -95,6 +108,10 @@ public:
      */
     size_t getPurgeableBytes() const { return fPurgeableBytes; }
 
+    // The number of resources freed by purges, for GrContext::readFrameStats().
+    int numPurges() const { return fNumPurges; }
+    void resetNumPurges() { fNumPurges = 0; }
+
     /**
      * Returns the number of bytes consumed by budgeted resources.
      */
@@ -147,7 +164,7 @@ public:
      * Find a resource that matches a unique key.
      */
     GrGpuResource* findAndRefUniqueResource(const GrUniqueKey& key) {
-        GrGpuResource* resource = fUniqueHash.find(key);
+        GrGpuResource* resource = fUniqueHash.findOrNull(key);
         if (resource) {
             this->refAndMakeResourceMRU(resource);
         }
@@ -245,9 +262,16 @@ public:
     // This function is for unit testing and is only defined in test tools.
     void changeTimestamp(uint32_t newTimestamp);
 
-    // Enumerates all cached resources and dumps their details to traceMemoryDump.
+    // Enumerates all cached resources and dumps their details to traceMemoryDump, followed by
+    // their totals per category ("skia/gpu_categories/<name>") and per owner, i.e. unique key tag
+    // ("skia/gpu_owners/<tag>"). The totals use "total_size" rather than "size" so that embedders
+    // which sum "size" over all the dumps don't count the resources twice.
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
 
+    // Dumps the maxCount largest resources, largest first, as "skia/gpu_largest/<rank>", each
+    // naming the resource's own dump.
+    void dumpLargestResources(SkTraceMemoryDump* traceMemoryDump, int maxCount) const;
+
     void setProxyProvider(GrProxyProvider* proxyProvider) { fProxyProvider = proxyProvider; }
 
 private:
@@ -274,6 +298,9 @@ private:
 
     uint32_t getNextTimestamp();
 
+    // Purges according to fCategoryBudgets until we're within budget or nothing is purgeable.
+    void purgeByCategory();
+
 #ifdef SK_DEBUG
     bool isInCache(const GrGpuResource* r) const;
     void validate() const;
@@ -296,11 +323,13 @@ private:
     typedef SkTMultiMap<GrGpuResource, GrScratchKey, ScratchMapTraits> ScratchMap;
 
     struct UniqueHashTraits {
-        static const GrUniqueKey& GetKey(const GrGpuResource& r) { return r.getUniqueKey(); }
+        static const GrUniqueKey& GetKey(const GrGpuResource* r) { return r->getUniqueKey(); }
 
         static uint32_t Hash(const GrUniqueKey& key) { return key.hash(); }
     };
-    typedef SkTDynamicHash<GrGpuResource, GrUniqueKey, UniqueHashTraits> UniqueHash;
+    // Looked up on every findAndRefUniqueResource(), so the keys' hashes are kept out of line in
+    // the table rather than read through each resource.
+    typedef SkTFlatHashTable<GrGpuResource*, const GrUniqueKey&, UniqueHashTraits> UniqueHash;
 
     static bool CompareTimestamp(GrGpuResource* const& a, GrGpuResource* const& b) {
         return a->cacheAccess().timestamp() < b->cacheAccess().timestamp();
@@ -332,6 +361,14 @@ private:
     int                                 fMaxCount;
     size_t                              fMaxBytes;
 
+    struct CategoryBudget {
+        size_t fSoftMaxBytes = SIZE_MAX;
+        float  fEvictionWeight = 1;
+    };
+    CategoryBudget                      fCategoryBudgets[kGrResourceCategoryCount];
+    // Whether any category has a non-default budget. If not, we purge in plain LRU order.
+    bool                                fHasCategoryBudgets = false;
+
 #if GR_CACHE_STATS
     int                                 fHighWaterCount;
     size_t                              fHighWaterBytes;
@@ -347,6 +384,7 @@ private:
     int                                 fBudgetedCount;
     size_t                              fBudgetedBytes;
     size_t                              fPurgeableBytes;
+    int                                 fNumPurges = 0;
 
     InvalidUniqueKeyInbox               fInvalidUniqueKeyInbox;
     FreedGpuResourceInbox               fFreedGpuResourceInbox;
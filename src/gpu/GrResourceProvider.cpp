@@ -30,6 +30,24 @@ GR_DECLARE_STATIC_UNIQUE_KEY(gQuadIndexBufferKey);
 
 const uint32_t GrResourceProvider::kMinScratchTextureSize = 16;
 
+int GrResourceProvider::MakeApprox(int value) {
+    static const int kMagicTol = 1024;
+
+    value = SkTMax((int)kMinScratchTextureSize, value);
+    if (SkIsPow2(value)) {
+        return value;
+    }
+
+    int ceilPow2 = GrNextPow2(value);
+    if (value <= kMagicTol) {
+        return ceilPow2;
+    }
+
+    int floorPow2 = ceilPow2 >> 1;
+    int mid = floorPow2 + (floorPow2 >> 1);
+    return value <= mid ? mid : ceilPow2;
+}
+
 #ifdef SK_DISABLE_EXPLICIT_GPU_RESOURCE_ALLOCATION
 static const bool kDefaultExplicitlyAllocateGPUResources = false;
 #else
@@ -189,8 +207,8 @@ sk_sp<GrTexture> GrResourceProvider::createApproxTexture(const GrSurfaceDesc& de
     if (!SkToBool(desc.fFlags & kPerformInitialClear_GrSurfaceFlag) &&
         (fGpu->caps()->reuseScratchTextures() || (desc.fFlags & kRenderTarget_GrSurfaceFlag))) {
         GrSurfaceDesc* wdesc = copyDesc.writable();
-        wdesc->fWidth  = SkTMax(kMinScratchTextureSize, GrNextPow2(desc.fWidth));
-        wdesc->fHeight = SkTMax(kMinScratchTextureSize, GrNextPow2(desc.fHeight));
+        wdesc->fWidth  = MakeApprox(desc.fWidth);
+        wdesc->fHeight = MakeApprox(desc.fHeight);
     }
 
     if (auto tex = this->refScratchTexture(*copyDesc, flags)) {
@@ -135,6 +135,13 @@ public:
 
     static const uint32_t kMinScratchTextureSize;
 
+    /**
+     * Returns the dimension that an approx-fit texture of the given width or height is bucketed
+     * into.  Up to 1024 this is the next power of two; above it, buckets are also placed halfway
+     * between powers of two so large layers overshoot by at most 50% in each dimension.
+     */
+    static int MakeApprox(int value);
+
     /**
      * Either finds and refs, or creates a static buffer with the given parameters and contents.
      *
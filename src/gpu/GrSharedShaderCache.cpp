@@ -0,0 +1,77 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrSharedShaderCache.h"
+
+#include "SkLRUCache.h"
+#include "SkMutex.h"
+#include "SkString.h"
+
+namespace {
+// Keys are the scope followed by the backend's key bytes.
+using SharedTable = SkLRUCache<SkString, sk_sp<SkData>>;
+
+SK_DECLARE_STATIC_MUTEX(gSharedTableMutex);
+
+SharedTable* shared_table() {
+    static SharedTable* gTable = new SharedTable(GrSharedShaderCache::kMaxEntries);
+    return gTable;
+}
+
+// SkLRUCache::insert() doesn't replace an existing entry.
+void set_entry(const SkString& tableKey, sk_sp<SkData> data) {
+    if (sk_sp<SkData>* existing = shared_table()->find(tableKey)) {
+        *existing = std::move(data);
+    } else {
+        shared_table()->insert(tableKey, std::move(data));
+    }
+}
+
+SkString make_key(uint32_t scope, const SkData& key) {
+    SkString tableKey(sizeof(scope) + key.size());
+    char* bytes = tableKey.writable_str();
+    memcpy(bytes, &scope, sizeof(scope));
+    memcpy(bytes + sizeof(scope), key.data(), key.size());
+    return tableKey;
+}
+} // namespace
+
+sk_sp<SkData> GrSharedShaderCache::load(const SkData& key) {
+    SkString tableKey = make_key(fScope, key);
+    {
+        SkAutoMutexAcquire lock(gSharedTableMutex);
+        if (sk_sp<SkData>* data = shared_table()->find(tableKey)) {
+            return *data;
+        }
+    }
+    if (!fClientCache) {
+        return nullptr;
+    }
+    // Lift the client's entry into the table so the other contexts don't have to reload it.
+    sk_sp<SkData> data = fClientCache->load(key);
+    if (data) {
+        SkAutoMutexAcquire lock(gSharedTableMutex);
+        set_entry(tableKey, data);
+    }
+    return data;
+}
+
+void GrSharedShaderCache::store(const SkData& key, const SkData& data) {
+    {
+        SkAutoMutexAcquire lock(gSharedTableMutex);
+        set_entry(make_key(fScope, key), SkData::MakeWithCopy(data.data(), data.size()));
+    }
+    if (fClientCache) {
+        fClientCache->store(key, data);
+    }
+}
+
+void GrSharedShaderCache::prefetch(SkExecutor* executor) {
+    if (fClientCache) {
+        fClientCache->prefetch(executor);
+    }
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrSharedShaderCache_DEFINED
+#define GrSharedShaderCache_DEFINED
+
+#include "GrContextOptions.h"
+#include "SkData.h"
+
+/**
+ * The PersistentCache that a GrContext uses when GrContextOptions::fShareShaderCache is set. It
+ * keeps what the backend stores (GLSL, program binaries, SPIR-V, ...) in a process-wide table
+ * that every GrContext with the same scope (see GrGpu::shaderCacheScope()) reads, so identical
+ * programs are compiled once per process. The table is consulted before the client's cache,
+ * which still receives every store. Safe to use from several threads at once.
+ */
+class GrSharedShaderCache : public GrContextOptions::PersistentCache {
+public:
+    // The table holds at most this many entries, dropping the least recently used.
+    static constexpr int kMaxEntries = 4096;
+
+    // 'clientCache' may be null.
+    GrSharedShaderCache(uint32_t scope, GrContextOptions::PersistentCache* clientCache)
+            : fScope(scope)
+            , fClientCache(clientCache) {
+        SkASSERT(scope);
+    }
+
+    sk_sp<SkData> load(const SkData& key) override;
+    void store(const SkData& key, const SkData& data) override;
+    void prefetch(SkExecutor*) override;
+
+private:
+    uint32_t fScope;
+    GrContextOptions::PersistentCache* fClientCache;
+};
+
+#endif
@@ -286,6 +286,30 @@ bool GrSoftwarePathRenderer::onDrawPath(const DrawPathArgs& args) {
         }
     }
 
+    // The matrix the mask is rasterized with.
+    SkMatrix maskViewMatrix = *args.fViewMatrix;
+#ifndef SK_BUILD_FOR_ANDROID_FRAMEWORK
+    static constexpr int kSubpixelBuckets = 4;
+    SkIRect snappedDevShapeBounds;
+    if (useCache) {
+        // Like subpixel glyphs, cached masks are rasterized at the nearest quarter pixel, so that a
+        // mask is reused by any translation that lands in the same bucket (e.g. when scrolling by
+        // fractional amounts). The mask bounds come from the snapped matrix too, so that every
+        // draw in a bucket places the mask at the same offset from the shape.
+        maskViewMatrix.setTranslateX(SkScalarRoundToScalar(
+                args.fViewMatrix->get(SkMatrix::kMTransX) * kSubpixelBuckets) / kSubpixelBuckets);
+        maskViewMatrix.setTranslateY(SkScalarRoundToScalar(
+                args.fViewMatrix->get(SkMatrix::kMTransY) * kSubpixelBuckets) / kSubpixelBuckets);
+        if (get_unclipped_shape_dev_bounds(*args.fShape, maskViewMatrix, &snappedDevShapeBounds)) {
+            boundsForMask = &snappedDevShapeBounds;
+        } else {
+            useCache = false;
+            boundsForMask = &clippedDevShapeBounds;
+            maskViewMatrix = *args.fViewMatrix;
+        }
+    }
+#endif
+
     GrUniqueKey maskKey;
     if (useCache) {
         // We require the upper left 2x2 of the matrix to match exactly for a cache hit.
@@ -300,14 +324,13 @@ bool GrSoftwarePathRenderer::onDrawPath(const DrawPathArgs& args) {
         // Fractional translate does not affect caching on Android. This is done for better cache
         // hit ratio and speed, but it is matching HWUI behavior, which doesn't consider the matrix
         // at all when caching paths.
-        SkFixed fracX = 0;
-        SkFixed fracY = 0;
+        uint32_t subpixelBits = 0;
 #else
-        SkScalar tx = args.fViewMatrix->get(SkMatrix::kMTransX);
-        SkScalar ty = args.fViewMatrix->get(SkMatrix::kMTransY);
-        // Allow 8 bits each in x and y of subpixel positioning.
-        SkFixed fracX = SkScalarToFixed(SkScalarFraction(tx)) & 0x0000FF00;
-        SkFixed fracY = SkScalarToFixed(SkScalarFraction(ty)) & 0x0000FF00;
+        // Allow 2 bits each in x and y of subpixel positioning.
+        SkScalar tx = maskViewMatrix.get(SkMatrix::kMTransX);
+        SkScalar ty = maskViewMatrix.get(SkMatrix::kMTransY);
+        uint32_t subpixelBits = ((SkScalarFloorToInt(tx * kSubpixelBuckets) & 0x3) << 2) |
+                                 (SkScalarFloorToInt(ty * kSubpixelBuckets) & 0x3);
 #endif
         builder[0] = SkFloat2Bits(sx);
         builder[1] = SkFloat2Bits(sy);
@@ -319,7 +342,7 @@ bool GrSoftwarePathRenderer::onDrawPath(const DrawPathArgs& args) {
         // all cases we might see.
         uint32_t styleBits = args.fShape->style().isSimpleHairline() ?
                              ((args.fShape->style().strokeRec().getCap() << 1) | 1) : 0;
-        builder[4] = fracX | (fracY >> 8) | (styleBits << 16);
+        builder[4] = subpixelBits | (styleBits << 16);
         args.fShape->writeUnstyledKey(&builder[5]);
     }
 
@@ -341,7 +364,7 @@ bool GrSoftwarePathRenderer::onDrawPath(const DrawPathArgs& args) {
             }
 
             auto uploader = skstd::make_unique<GrTDeferredProxyUploader<SoftwarePathData>>(
-                    *boundsForMask, *args.fViewMatrix, *args.fShape, aa);
+                    *boundsForMask, maskViewMatrix, *args.fShape, aa);
             GrTDeferredProxyUploader<SoftwarePathData>* uploaderRaw = uploader.get();
 
             auto drawAndUploadMask = [uploaderRaw] {
@@ -363,7 +386,7 @@ bool GrSoftwarePathRenderer::onDrawPath(const DrawPathArgs& args) {
             if (!helper.init(*boundsForMask)) {
                 return false;
             }
-            helper.drawShape(*args.fShape, *args.fViewMatrix, SkRegion::kReplace_Op, aa, 0xFF);
+            helper.drawShape(*args.fShape, maskViewMatrix, SkRegion::kReplace_Op, aa, 0xFF);
             proxy = helper.toTextureProxy(args.fContext, fit);
         }
 
@@ -32,6 +32,18 @@ public:
                                       SkIRect* clippedDevShapeBounds,
                                       SkIRect* devClipBounds);
 
+    // This utility draws a path mask using a provided paint. The rectangle is drawn in device
+    // space. The 'viewMatrix' will be used to ensure the correct local coords are provided to
+    // any fragment processors in the paint.
+    static void DrawToTargetWithShapeMask(sk_sp<GrTextureProxy> proxy,
+                                          GrRenderTargetContext* renderTargetContext,
+                                          GrPaint&& paint,
+                                          const GrUserStencilSettings& userStencilSettings,
+                                          const GrClip& clip,
+                                          const SkMatrix& viewMatrix,
+                                          const SkIPoint& textureOriginInDeviceSpace,
+                                          const SkIRect& deviceSpaceRectToDraw);
+
 private:
     static void DrawNonAARect(GrRenderTargetContext* renderTargetContext,
                               GrPaint&& paint,
@@ -48,18 +60,6 @@ private:
                                   const SkIRect& devClipBounds,
                                   const SkIRect& devPathBounds);
 
-    // This utility draws a path mask using a provided paint. The rectangle is drawn in device
-    // space. The 'viewMatrix' will be used to ensure the correct local coords are provided to
-    // any fragment processors in the paint.
-    static void DrawToTargetWithShapeMask(sk_sp<GrTextureProxy> proxy,
-                                          GrRenderTargetContext* renderTargetContext,
-                                          GrPaint&& paint,
-                                          const GrUserStencilSettings& userStencilSettings,
-                                          const GrClip& clip,
-                                          const SkMatrix& viewMatrix,
-                                          const SkIPoint& textureOriginInDeviceSpace,
-                                          const SkIRect& deviceSpaceRectToDraw);
-
     StencilSupport onGetStencilSupport(const GrShape&) const override {
         return GrPathRenderer::kNoSupport_StencilSupport;
     }
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrStagedUpload.h"
+
+bool GrUploadStagingPool::acquire(size_t size, Slot* slot) {
+    SkAutoMutexAcquire lock(fMutex);
+    if (fReleased) {
+        return false;
+    }
+    int best = -1;
+    for (int i = 0; i < fFreeSlots.count(); ++i) {
+        if (fFreeSlots[i].fSize >= size &&
+            (best < 0 || fFreeSlots[i].fSize < fFreeSlots[best].fSize)) {
+            best = i;
+        }
+    }
+    if (best < 0) {
+        return false;
+    }
+    *slot = fFreeSlots[best];
+    fFreeSlots.removeShuffle(best);
+    ++fOutstandingSlots;
+    return true;
+}
+
+void GrUploadStagingPool::recycle(const Slot& slot) {
+    SkAutoMutexAcquire lock(fMutex);
+    SkASSERT(fOutstandingSlots > 0);
+    --fOutstandingSlots;
+    if (!fReleased) {
+        fFreeSlots.push_back(slot);
+    }
+}
+
+bool GrUploadStagingPool::add(sk_sp<GrBuffer> buffer) {
+    SkASSERT(buffer && !buffer->isCPUBacked());
+    void* data = buffer->map();
+    if (!data) {
+        return false;
+    }
+    Slot slot = {fBuffers.count(), data, buffer->sizeInBytes()};
+    fBuffers.push_back(std::move(buffer));
+
+    SkAutoMutexAcquire lock(fMutex);
+    fReleased = false;
+    fFreeSlots.push_back(slot);
+    return true;
+}
+
+sk_sp<GrBuffer> GrUploadStagingPool::take(const Slot& slot) {
+    {
+        SkAutoMutexAcquire lock(fMutex);
+        SkASSERT(fOutstandingSlots > 0);
+        --fOutstandingSlots;
+    }
+    sk_sp<GrBuffer> buffer = std::move(fBuffers[slot.fIndex]);
+    SkASSERT(buffer && buffer->isMapped());
+    buffer->unmap();
+    return buffer;
+}
+
+void GrUploadStagingPool::releaseAll(bool abandoned) {
+    {
+        SkAutoMutexAcquire lock(fMutex);
+        SkASSERT(!fOutstandingSlots);
+        fReleased = true;
+        fFreeSlots.reset();
+    }
+    for (sk_sp<GrBuffer>& buffer : fBuffers) {
+        if (buffer && !abandoned) {
+            buffer->unmap();
+        }
+    }
+    fBuffers.reset();
+}
+
+GrStagedUpload::~GrStagedUpload() {
+    if (fPool) {
+        fPool->recycle(fSlot);
+    }
+}
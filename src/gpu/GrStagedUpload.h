@@ -0,0 +1,101 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrStagedUpload_DEFINED
+#define GrStagedUpload_DEFINED
+
+#include "GrBuffer.h"
+#include "GrTypesPriv.h"
+#include "SkAutoPixmapStorage.h"
+#include "SkMutex.h"
+#include "SkRefCnt.h"
+#include "SkTArray.h"
+
+class GrCaps;
+
+/**
+ * Transfer buffers that the owning GrContext's thread creates and maps ahead of time, so that other
+ * threads can write texture data straight into them. Shared through GrContextThreadSafeProxy.
+ *
+ * The GrBuffers themselves are only touched on the owning thread, since GrGpuResource refs
+ * aren't thread safe. Other threads only see the mapped pointers.
+ */
+class GrUploadStagingPool : public SkNVRefCnt<GrUploadStagingPool> {
+public:
+    struct Slot {
+        int    fIndex;
+        void*  fData;
+        size_t fSize;
+    };
+
+    GrUploadStagingPool() : fOutstandingSlots(0), fReleased(false) {}
+    ~GrUploadStagingPool() { SkASSERT(fBuffers.empty()); }
+
+    // Any thread.
+
+    /**
+     * Takes the smallest mapped buffer of at least size bytes. Returns false if there is none, or
+     * the context has released the pool.
+     */
+    bool acquire(size_t size, Slot*);
+    /** Returns a slot whose buffer ended up unused. */
+    void recycle(const Slot&);
+
+    // Owning context's thread only.
+
+    /** Maps buffer and offers it to acquire(). Returns false if it couldn't be mapped. */
+    bool add(sk_sp<GrBuffer> buffer);
+    /** Unmaps and returns the buffer of an acquired slot. */
+    sk_sp<GrBuffer> take(const Slot&);
+    /**
+     * Unmaps and drops all the buffers, unless abandoned. Every acquired slot must have been
+     * taken or recycled first, so no other thread is still writing to a buffer.
+     */
+    void releaseAll(bool abandoned);
+
+private:
+    SkMutex                      fMutex;
+    SkTArray<Slot>               fFreeSlots;         // guarded by fMutex
+    int                          fOutstandingSlots;  // guarded by fMutex
+    bool                         fReleased;          // guarded by fMutex
+
+    SkTArray<sk_sp<GrBuffer>>    fBuffers;           // owning thread only
+};
+
+/**
+ * Pixels converted to the layout the context uploads them in, ready to become a texture with
+ * GrContextPriv::makeTextureFromStagedUpload(). Made on any thread by
+ * GrContextThreadSafeProxyPriv::stageUpload(). The pixels are in a staged transfer buffer when one
+ * was free, or else in CPU memory.
+ */
+class GrStagedUpload {
+public:
+    ~GrStagedUpload();
+
+    /** The texture's config, and the info of the pixels as staged. */
+    GrPixelConfig config() const { return fConfig; }
+    const SkPixmap& pixels() const { return fPixels; }
+    GrColorType colorType() const { return fColorType; }
+
+    bool inTransferBuffer() const { return SkToBool(fPool); }
+
+private:
+    GrStagedUpload() : fConfig(kUnknown_GrPixelConfig), fColorType(GrColorType::kUnknown) {}
+
+    GrPixelConfig                   fConfig;
+    GrColorType                     fColorType;
+    SkPixmap                        fPixels;
+    // Set while the pixels are in fSlot's buffer.
+    sk_sp<GrUploadStagingPool>      fPool;
+    GrUploadStagingPool::Slot       fSlot;
+    SkAutoPixmapStorage             fCPUPixels;
+
+    friend class GrContextPriv;                 // to take the slot
+    friend class GrContextThreadSafeProxyPriv;  // to make these
+};
+
+#endif
@@ -7,6 +7,83 @@
 
 #include "GrStyle.h"
 #include "SkDashPathPriv.h"
+#include "SkPathPriv.h"
+#include "SkResourceCache.h"
+#include "SkStrokeCache.h"
+
+namespace {
+static unsigned gDashKeyNamespaceLabel;
+
+static uint64_t make_dash_shared_id(uint32_t pathGenID) {
+    uint64_t sharedID = SkSetFourByteTag('d', 'a', 's', 'h');
+    return (sharedID << 32) | pathGenID;
+}
+
+// Dashes with more intervals than this are rare enough to not be worth a bigger key.
+static constexpr int kMaxCachedDashIntervals = 8;
+
+// Identifies the result of dashing a path with the GrStyle's intervals. The strokeRec isn't
+// applied by the dasher, but it is part of the key since it controls how the path is measured.
+struct DashKey : public SkResourceCache::Key {
+    DashKey(const SkPath& src, const SkStrokeRec& rec, SkScalar phase, const SkScalar intervals[],
+            int intervalCnt)
+            : fGenID(src.getGenerationID())
+            , fWidth(rec.getWidth())
+            , fMiterLimit(rec.getMiter())
+            , fResScale(SkStrokeCache::BucketResScale(rec.getResScale()))
+            , fPhase(phase)
+            , fFlags(rec.getCap() | (rec.getJoin() << 2) | (rec.getStyle() << 4) |
+                     (src.isInverseFillType() << 6) | (intervalCnt << 8)) {
+        SkASSERT(intervalCnt <= kMaxCachedDashIntervals);
+        sk_bzero(fIntervals, sizeof(fIntervals));
+        memcpy(fIntervals, intervals, intervalCnt * sizeof(SkScalar));
+        this->init(&gDashKeyNamespaceLabel, make_dash_shared_id(fGenID),
+                   sizeof(fGenID) + sizeof(fWidth) + sizeof(fMiterLimit) + sizeof(fResScale) +
+                   sizeof(fPhase) + sizeof(fFlags) + sizeof(fIntervals));
+    }
+
+    uint32_t fGenID;
+    SkScalar fWidth;
+    SkScalar fMiterLimit;
+    SkScalar fResScale;
+    SkScalar fPhase;
+    uint32_t fFlags;
+    SkScalar fIntervals[kMaxCachedDashIntervals];
+};
+
+struct DashCacheRec : public SkResourceCache::Rec {
+    DashCacheRec(const DashKey& key, const SkPath& path) : fKey(key), fPath(path) {}
+
+    DashKey fKey;
+    SkPath  fPath;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fPath.countPoints() * sizeof(SkPoint) + fPath.countVerbs();
+    }
+    const char* getCategory() const override { return "dash"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const DashCacheRec& rec = static_cast<const DashCacheRec&>(baseRec);
+        *static_cast<SkPath*>(contextData) = rec.fPath;
+        return true;
+    }
+};
+
+// Purges a path's dashed results once it changes or is deleted.
+class DashInvalidator : public SkPathRef::GenIDChangeListener {
+public:
+    explicit DashInvalidator(uint32_t genID) : fGenID(genID) {}
+
+private:
+    void onChange() override {
+        SkResourceCache::PostPurgeSharedID(make_dash_shared_id(fGenID));
+    }
+
+    const uint32_t fGenID;
+};
+}  // namespace
 
 int GrStyle::KeySize(const GrStyle &style, Apply apply, uint32_t flags) {
     GR_STATIC_ASSERT(sizeof(uint32_t) == sizeof(SkScalar));
@@ -142,10 +219,31 @@ bool GrStyle::applyPathEffect(SkPath* dst, SkStrokeRec* strokeRec, const SkPath&
         SkScalar intervalLength;
         SkDashPath::CalcDashParameters(phase, intervals, intervalCnt, &initialLength,
                                        &initialIndex, &intervalLength);
-        if (!SkDashPath::InternalFilter(dst, src, strokeRec,
-                                        nullptr, intervals, intervalCnt,
-                                        initialLength, initialIndex, intervalLength,
-                                        SkDashPath::StrokeRecApplication::kDisallow)) {
+        // Paths that are redrawn with the same dash, like dashed chart grids, keep their dashed
+        // geometry in SkResourceCache. As with cached strokes, the path is measured at the
+        // bucketed res scale so nearby scales share the result. The dasher doesn't change the
+        // strokeRec when it isn't allowed to apply it, so only the path needs to be cached.
+        SkScalar resScale = strokeRec->getResScale();
+        bool canCache = !src.isVolatile() && intervalCnt <= kMaxCachedDashIntervals &&
+                        SkScalarIsFinite(resScale) && resScale > 0;
+        if (canCache) {
+            DashKey key(src, *strokeRec, phase, intervals, intervalCnt);
+            if (!SkResourceCache::Find(key, DashCacheRec::Visitor, dst)) {
+                SkStrokeRec bucketRec = *strokeRec;
+                bucketRec.setResScale(key.fResScale);
+                if (!SkDashPath::InternalFilter(dst, src, &bucketRec,
+                                                nullptr, intervals, intervalCnt,
+                                                initialLength, initialIndex, intervalLength,
+                                                SkDashPath::StrokeRecApplication::kDisallow)) {
+                    return false;
+                }
+                SkResourceCache::Add(new DashCacheRec(key, *dst));
+                SkPathPriv::AddGenIDChangeListener(src, sk_make_sp<DashInvalidator>(key.fGenID));
+            }
+        } else if (!SkDashPath::InternalFilter(dst, src, strokeRec,
+                                               nullptr, intervals, intervalCnt,
+                                               initialLength, initialIndex, intervalLength,
+                                               SkDashPath::StrokeRecApplication::kDisallow)) {
             return false;
         }
     } else if (!fPathEffect->filterPath(dst, src, strokeRec, nullptr)) {
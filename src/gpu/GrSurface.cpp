@@ -20,10 +20,10 @@ size_t GrSurface::WorstCaseSize(const GrSurfaceDesc& desc, bool useNextPow2) {
     size_t size;
 
     int width = useNextPow2
-                ? SkTMax(GrResourceProvider::kMinScratchTextureSize, GrNextPow2(desc.fWidth))
+                ? GrResourceProvider::MakeApprox(desc.fWidth)
                 : desc.fWidth;
     int height = useNextPow2
-                ? SkTMax(GrResourceProvider::kMinScratchTextureSize, GrNextPow2(desc.fHeight))
+                ? GrResourceProvider::MakeApprox(desc.fHeight)
                 : desc.fHeight;
 
     bool isRenderTarget = SkToBool(desc.fFlags & kRenderTarget_GrSurfaceFlag);
@@ -67,10 +67,10 @@ size_t GrSurface::ComputeSize(GrPixelConfig config,
     size_t colorSize;
 
     width = useNextPow2
-            ? SkTMax(GrResourceProvider::kMinScratchTextureSize, GrNextPow2(width))
+            ? GrResourceProvider::MakeApprox(width)
             : width;
     height = useNextPow2
-            ? SkTMax(GrResourceProvider::kMinScratchTextureSize, GrNextPow2(height))
+            ? GrResourceProvider::MakeApprox(height)
             : height;
 
     SkASSERT(kUnknown_GrPixelConfig != config);
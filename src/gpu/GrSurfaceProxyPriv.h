@@ -66,6 +66,14 @@ public:
                GrSurfaceProxy::LazyInstantiationType::kDeinstantiate == lazyInstantiationType();
     }
 
+    // Whether the proxy was instantiated by a lazy callback that may be called again, like the
+    // proxy that a DDL records into.
+    bool hasMultipleUseLazyCallback() const {
+        return SkToBool(fProxy->fTarget) &&
+               SkToBool(fProxy->fLazyInstantiateCallback) &&
+               GrSurfaceProxy::LazyInstantiationType::kMultipleUse == lazyInstantiationType();
+    }
+
     static bool SK_WARN_UNUSED_RESULT AttachStencilIfNeeded(GrResourceProvider*, GrSurface*,
                                                             bool needsStencil);
 
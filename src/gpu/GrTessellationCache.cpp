@@ -0,0 +1,146 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrTessellationCache.h"
+
+#include "GrShape.h"
+#include <cmath>
+
+// Linear tessellations don't depend on the tolerance, so they all share one bucket.
+static constexpr uint32_t kLinearBucket = ~0u;
+
+// Removes a shape's tessellations from the cache once its path changes or is deleted. The listener
+// can fire on any thread, and holds a ref on the cache to stay safe if it outlives the context.
+class GrTessellationCache::Invalidator : public SkPathRef::GenIDChangeListener {
+public:
+    Invalidator(const GrUniqueKey& key, sk_sp<GrTessellationCache> cache)
+            : fKey(key), fCache(std::move(cache)) {}
+
+private:
+    void onChange() override { fCache->invalidate(fKey); }
+
+    const GrUniqueKey fKey;
+    const sk_sp<GrTessellationCache> fCache;
+};
+
+GrTessellationCache::~GrTessellationCache() {
+    this->purgeAll();
+}
+
+SkScalar GrTessellationCache::BucketTolerance(SkScalar tolerance) {
+    SkASSERT(tolerance > 0);
+    int exp;
+    std::frexp(tolerance, &exp);  // tolerance = [.5..1) * 2^exp
+    return std::ldexp(SK_Scalar1, exp - 1);
+}
+
+bool GrTessellationCache::MakeKey(const GrShape& shape, SkScalar tolerance, bool isLinear,
+                                  GrUniqueKey* key) {
+    int shapeKeyDataCnt = shape.unstyledKeySize();
+    if (shapeKeyDataCnt < 0) {
+        return false;
+    }
+    static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
+    GrUniqueKey::Builder builder(key, kDomain, shapeKeyDataCnt + 1, "Tessellation");
+    shape.writeUnstyledKey(&builder[0]);
+    if (isLinear) {
+        builder[shapeKeyDataCnt] = kLinearBucket;
+    } else {
+        int exp;
+        std::frexp(tolerance, &exp);
+        builder[shapeKeyDataCnt] = static_cast<uint32_t>(exp);
+    }
+    return true;
+}
+
+bool GrTessellationCache::find(const GrShape& shape, SkScalar tolerance, size_t vertexStride,
+                               Tessellation* tess) {
+    GrUniqueKey linearKey, bucketKey;
+    if (!MakeKey(shape, tolerance, true, &linearKey) ||
+        !MakeKey(shape, tolerance, false, &bucketKey)) {
+        return false;
+    }
+    SkAutoMutexAcquire lock(fMutex);
+    Entry* entry = this->internalFind(linearKey);
+    if (!entry) {
+        entry = this->internalFind(bucketKey);
+    }
+    if (!entry || entry->fTessellation.fVertexStride != vertexStride) {
+        return false;
+    }
+    fLRU.remove(entry);
+    fLRU.addToHead(entry);
+    *tess = entry->fTessellation;
+    return true;
+}
+
+void GrTessellationCache::add(const GrShape& shape, SkScalar tolerance, const Tessellation& tess) {
+    SkASSERT(tess.fVertices);
+    size_t size = tess.fVertices->size();
+    if (size > fByteBudget / 4) {
+        return;
+    }
+    GrUniqueKey key;
+    if (!MakeKey(shape, tolerance, tess.fIsLinear, &key)) {
+        return;
+    }
+    {
+        SkAutoMutexAcquire lock(fMutex);
+        if (Entry* existing = this->internalFind(key)) {
+            // Another op tessellated the same shape during this flush.
+            this->internalRemove(existing);
+        }
+        Entry* entry = new Entry{key, tess};
+        fHashTable.set(key, entry);
+        fLRU.addToHead(entry);
+        fBytesUsed += size;
+        while (fBytesUsed > fByteBudget) {
+            this->internalRemove(fLRU.tail());
+        }
+    }
+    // Outside the lock: if the path is already gone, the listener fires immediately.
+    shape.addGenIDChangeListener(sk_make_sp<Invalidator>(key, sk_ref_sp(this)));
+}
+
+void GrTessellationCache::purgeAll() {
+    SkAutoMutexAcquire lock(fMutex);
+    while (Entry* entry = fLRU.head()) {
+        this->internalRemove(entry);
+    }
+    SkASSERT(0 == fHashTable.count());
+    SkASSERT(0 == fBytesUsed);
+}
+
+int GrTessellationCache::count() const {
+    SkAutoMutexAcquire lock(fMutex);
+    return fHashTable.count();
+}
+
+size_t GrTessellationCache::bytesUsed() const {
+    SkAutoMutexAcquire lock(fMutex);
+    return fBytesUsed;
+}
+
+GrTessellationCache::Entry* GrTessellationCache::internalFind(const GrUniqueKey& key) {
+    Entry** entry = fHashTable.find(key);
+    return entry ? *entry : nullptr;
+}
+
+void GrTessellationCache::internalRemove(Entry* entry) {
+    SkASSERT(fBytesUsed >= entry->fTessellation.fVertices->size());
+    fBytesUsed -= entry->fTessellation.fVertices->size();
+    fLRU.remove(entry);
+    fHashTable.remove(entry->fKey);
+    delete entry;
+}
+
+void GrTessellationCache::invalidate(const GrUniqueKey& key) {
+    SkAutoMutexAcquire lock(fMutex);
+    if (Entry* entry = this->internalFind(key)) {
+        this->internalRemove(entry);
+    }
+}
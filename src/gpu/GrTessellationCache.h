@@ -0,0 +1,87 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrTessellationCache_DEFINED
+#define GrTessellationCache_DEFINED
+
+#include "GrResourceKey.h"
+#include "SkData.h"
+#include "SkMutex.h"
+#include "SkRefCnt.h"
+#include "SkTHash.h"
+#include "SkTInternalLList.h"
+
+class GrShape;
+
+/**
+ * A CPU-side LRU cache of non-AA GrTessellator triangulations. These are generated in path space,
+ * so the same vertices can be uploaded again under any view matrix that calls for a similar
+ * tolerance, without re-running the sweep. Entries are keyed by the shape's unstyled key plus a
+ * power-of-two tolerance bucket, and are removed when the shape's path changes or goes away.
+ *
+ * The cache is thread safe: ops look it up from prePrepare(), which may run on a worker thread.
+ */
+class GrTessellationCache : public SkRefCnt {
+public:
+    static constexpr size_t kDefaultByteBudget = 4 * 1024 * 1024;
+
+    GrTessellationCache(size_t byteBudget = kDefaultByteBudget) : fByteBudget(byteBudget) {}
+    ~GrTessellationCache() override;
+
+    struct Tessellation {
+        sk_sp<SkData> fVertices;
+        int fVertexCount = 0;
+        size_t fVertexStride = 0;
+        bool fIsLinear = false;
+    };
+
+    // Returns the tolerance from the bucket containing 'tolerance'. Tessellating with it is at
+    // least as precise as 'tolerance', and at most twice as precise.
+    static SkScalar BucketTolerance(SkScalar tolerance);
+
+    // Returns true and fills out 'tess' if there is a tessellation of 'shape' with the given vertex
+    // stride that is precise enough for 'tolerance'.
+    bool find(const GrShape&, SkScalar tolerance, size_t vertexStride, Tessellation* tess);
+
+    // Adds a tessellation of 'shape' that was made with BucketTolerance(tolerance). Does nothing if
+    // the shape has no unstyled key, or if the tessellation is larger than a quarter of the budget.
+    void add(const GrShape&, SkScalar tolerance, const Tessellation&);
+
+    void purgeAll();
+
+    int count() const;
+    size_t bytesUsed() const;
+
+private:
+    class Invalidator;
+
+    struct Entry {
+        GrUniqueKey fKey;
+        Tessellation fTessellation;
+        SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
+    };
+
+    struct KeyHash {
+        uint32_t operator()(const GrUniqueKey& key) const { return key.hash(); }
+    };
+
+    static bool MakeKey(const GrShape&, SkScalar tolerance, bool isLinear, GrUniqueKey*);
+
+    // These methods are only called with fMutex held.
+    Entry* internalFind(const GrUniqueKey&);
+    void internalRemove(Entry*);
+
+    void invalidate(const GrUniqueKey&);
+
+    const size_t fByteBudget;
+    mutable SkMutex fMutex;
+    SkTHashMap<GrUniqueKey, Entry*, KeyHash> fHashTable;
+    SkTInternalLList<Entry> fLRU;
+    size_t fBytesUsed = 0;
+};
+
+#endif
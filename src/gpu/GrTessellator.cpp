@@ -706,8 +706,19 @@ void append_quadratic_to_contour(const SkPoint pts[3], SkScalar toleranceSqd, Ve
         }
         nPoints++;
     }
-    for (int j = 1; j <= nPoints; j++) {
-        append_point_to_contour(to_point(quad.eval(j * u)), contour, alloc);
+    // Evaluate the points in small batches, so the t values share SIMD lanes.
+    constexpr int kBatch = 16;
+    SkScalar ts[kBatch];
+    SkPoint points[kBatch];
+    for (int j = 1; j <= nPoints; j += kBatch) {
+        int n = SkTMin(kBatch, nPoints - j + 1);
+        for (int i = 0; i < n; ++i) {
+            ts[i] = (j + i) * u;
+        }
+        SkEvalQuadAt(pts, ts, points, n);
+        for (int i = 0; i < n; ++i) {
+            append_point_to_contour(points[i], contour, alloc);
+        }
     }
 }
 
@@ -12,6 +12,9 @@
 #include "GrContextPriv.h"
 #include "GrGpu.h"
 #include "GrProxyProvider.h"
+#include "SkBitmap.h"
+#include "SkGr.h"
+#include "SkMipMap.h"
 
 sk_sp<GrTextureProxy> GrTextureMaker::onRefTextureProxyForParams(const GrSamplerState& params,
                                                                  bool willBeMipped,
@@ -103,6 +106,99 @@ sk_sp<GrTextureProxy> GrTextureMaker::onRefTextureProxyForParams(const GrSampler
     return result;
 }
 
+// Returns the smallest mip level of a width x height image that is still at least maxScale times
+// its size in each dimension, so that sampling it at maxScale never magnifies it. Level 0 means
+// the original should be used; so does a non-positive maxScale, which comes from perspective.
+static int downscale_level(int width, int height, SkScalar maxScale) {
+    if (!(maxScale > 0) || maxScale >= SK_ScalarHalf) {
+        return 0;
+    }
+    int level = 0;
+    while (width >> level > 1 || height >> level > 1) {
+        int levelWidth = SkTMax(width >> (level + 1), 1);
+        int levelHeight = SkTMax(height >> (level + 1), 1);
+        if (levelWidth < maxScale * width || levelHeight < maxScale * height) {
+            break;
+        }
+        ++level;
+    }
+    return level;
+}
+
+static GrTextureProducer::CopyParams downscale_copy_params(int width, int height, int level) {
+    // Downscaled copies share the keys of GPU copies to the same size. Those are only ever
+    // stretched up, for repeat wrap modes, so they can't collide.
+    return { GrSamplerState::Filter::kBilerp, SkTMax(width >> level, 1),
+             SkTMax(height >> level, 1) };
+}
+
+sk_sp<GrTextureProxy> GrTextureMaker::refDownscaledTextureProxy(int level, bool willBeMipped) {
+    SkASSERT(level > 0);
+    if (auto original = this->refCachedOriginalTextureProxy(willBeMipped)) {
+        return original;
+    }
+
+    GrProxyProvider* proxyProvider = fContext->contextPriv().proxyProvider();
+
+    // Any level at least as large as the one asked for will do. Copies made for earlier, larger
+    // draws are reused rather than uploading a smaller one next to them.
+    CopyParams copyParams = downscale_copy_params(this->width(), this->height(), level);
+    GrUniqueKey copyKey;
+    this->makeCopyKey(copyParams, &copyKey);
+    if (!copyKey.isValid()) {
+        // The copy couldn't be cached, so it would be redone on every draw.
+        return nullptr;
+    }
+    sk_sp<GrTextureProxy> cachedProxy;
+    for (int l = level; l > 0; --l) {
+        GrUniqueKey key;
+        this->makeCopyKey(downscale_copy_params(this->width(), this->height(), l), &key);
+        auto proxy = proxyProvider->findOrCreateProxyByUniqueKey(key, kTopLeft_GrSurfaceOrigin);
+        if (proxy && (!willBeMipped || GrMipMapped::kYes == proxy->mipMapped())) {
+            return proxy;
+        }
+        if (l == level) {
+            cachedProxy = std::move(proxy);
+        }
+    }
+
+    SkBitmap src;
+    if (!this->getDownscaleSourcePixels(&src)) {
+        return nullptr;
+    }
+    SkASSERT(src.width() == this->width() && src.height() == this->height());
+    SkBitmap scaled;
+    if (!scaled.tryAllocPixels(src.info().makeWH(copyParams.fWidth, copyParams.fHeight)) ||
+        !src.pixmap().scalePixels(scaled.pixmap(), kMedium_SkFilterQuality)) {
+        return nullptr;
+    }
+    scaled.setImmutable();
+
+    sk_sp<GrTextureProxy> result;
+    if (willBeMipped) {
+        result = proxyProvider->createMipMapProxyFromBitmap(scaled);
+        if (!result && cachedProxy) {
+            // We already have this level without mips; let the backend fall back to bilerp.
+            return cachedProxy;
+        }
+    }
+    if (!result) {
+        result = GrUploadBitmapToTextureProxy(proxyProvider, scaled);
+    }
+    if (!result) {
+        return nullptr;
+    }
+    SkASSERT(result->origin() == kTopLeft_GrSurfaceOrigin);
+    if (cachedProxy) {
+        // The cached copy lacked the mips we need. Steal its key, as with copies made on the GPU.
+        SkASSERT(cachedProxy->getUniqueKey() == copyKey);
+        proxyProvider->removeUniqueKeyFromProxy(cachedProxy.get());
+    }
+    proxyProvider->assignUniqueKeyToProxy(copyKey, result.get());
+    this->didCacheCopy(copyKey, proxyProvider->contextUniqueID());
+    return result;
+}
+
 std::unique_ptr<GrFragmentProcessor> GrTextureMaker::createFragmentProcessor(
         const SkMatrix& textureMatrix,
         const SkRect& constraintRect,
@@ -129,16 +225,43 @@ std::unique_ptr<GrFragmentProcessor> GrTextureMaker::createFragmentProcessor(
         samplerState = GrSamplerState::ClampNearest();
     }
     SkScalar scaleAdjust[2] = { 1.0f, 1.0f };
-    sk_sp<GrTextureProxy> proxy(this->refTextureProxyForParams(samplerState, scaleAdjust));
+    sk_sp<GrTextureProxy> proxy;
+    // When every draw samples us at a fraction of our size, a filtered draw can use a downscaled
+    // copy rather than the full resolution original. Nearest and bicubic draws always get the
+    // original, since downscaling would change what they show.
+    int level = 0;
+    if (filterOrNullForBicubic && GrSamplerState::Filter::kNearest != *filterOrNullForBicubic) {
+        level = downscale_level(this->width(), this->height(), this->maxSampleScale());
+    }
+    if (level > 0) {
+        bool willBeMipped = GrSamplerState::Filter::kMipMap == *filterOrNullForBicubic &&
+                            fContext->contextPriv().caps()->mipMapSupport();
+        proxy = this->refDownscaledTextureProxy(level, willBeMipped);
+        if (proxy) {
+            scaleAdjust[0] = proxy->width() / SkIntToScalar(this->width());
+            scaleAdjust[1] = proxy->height() / SkIntToScalar(this->height());
+        }
+    }
     if (!proxy) {
-        return nullptr;
+        proxy = this->refTextureProxyForParams(samplerState, scaleAdjust);
+        if (!proxy) {
+            return nullptr;
+        }
     }
     SkMatrix adjustedMatrix = textureMatrix;
     adjustedMatrix.postScale(scaleAdjust[0], scaleAdjust[1]);
+    SkRect adjustedConstraintRect = constraintRect;
+    if (scaleAdjust[0] != 1 || scaleAdjust[1] != 1) {
+        adjustedConstraintRect = SkRect::MakeLTRB(constraintRect.fLeft * scaleAdjust[0],
+                                                  constraintRect.fTop * scaleAdjust[1],
+                                                  constraintRect.fRight * scaleAdjust[0],
+                                                  constraintRect.fBottom * scaleAdjust[1]);
+    }
     SkRect domain;
     DomainMode domainMode =
-        DetermineDomainMode(constraintRect, filterConstraint, coordsLimitedToConstraintRect,
-                            proxy.get(), fmForDetermineDomain, &domain);
+        DetermineDomainMode(adjustedConstraintRect, filterConstraint,
+                            coordsLimitedToConstraintRect, proxy.get(), fmForDetermineDomain,
+                            &domain);
     SkASSERT(kTightCopy_DomainMode != domainMode);
     return CreateFragmentProcessorForDomainAndFilter(std::move(proxy), adjustedMatrix, domainMode,
                                                      domain, filterOrNullForBicubic);
@@ -10,6 +10,8 @@
 
 #include "GrTextureProducer.h"
 
+class SkBitmap;
+
 /**
  * Base class for sources that start out as something other than a texture (encoded image,
  * picture, ...).
@@ -39,6 +41,23 @@ protected:
     virtual sk_sp<GrTextureProxy> refOriginalTextureProxy(bool willBeMipped,
                                                           AllowedTexGenType genType) = 0;
 
+    /**
+     *  Return the maker's original texture if it is already cached (or is trivial to construct),
+     *  without generating it. This is checked before uploading a downscaled copy, since that would
+     *  only add to the memory used by the original.
+     */
+    virtual sk_sp<GrTextureProxy> refCachedOriginalTextureProxy(bool willBeMipped) {
+        return nullptr;
+    }
+
+    /**
+     *  Return the maker's content as CPU pixels, from which a downscaled copy is made when draws
+     *  only sample a fraction of its resolution. Makers that can't cache that copy, or for which
+     *  reading back pixels is expensive (e.g. content drawn into a render target), should return
+     *  false; they are always uploaded at full resolution.
+     */
+    virtual bool getDownscaleSourcePixels(SkBitmap*) { return false; }
+
     GrContext* context() const { return fContext; }
 
 private:
@@ -46,6 +65,11 @@ private:
                                                      bool willBeMipped,
                                                      SkScalar scaleAdjust[2]) override;
 
+    // Returns a copy of the content downscaled by 2^level (or a cached copy with a level between 1
+    // and 'level'), or the original if that is already cached. Returns nullptr if the maker does
+    // not support downscaling.
+    sk_sp<GrTextureProxy> refDownscaledTextureProxy(int level, bool willBeMipped);
+
     typedef GrTextureProducer INHERITED;
 };
 
@@ -15,6 +15,7 @@
 #include "GrResourceAllocator.h"
 #include "GrTextureProxy.h"
 #include "SkStringUtils.h"
+#include "SkTraceEvent.h"
 #include "ops/GrCopySurfaceOp.h"
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -99,6 +100,8 @@ bool GrTextureOpList::onExecute(GrOpFlushState* flushState) {
     }
 
     SkASSERT(fTarget.get()->peekTexture());
+    TRACE_EVENT0("skia", TRACE_FUNC);
+    GrGpu::AutoTraceSpan traceSpan(flushState->gpu(), TRACE_FUNC);
 
     GrGpuTextureCommandBuffer* commandBuffer(
                          flushState->gpu()->getCommandBuffer(fTarget.get()->peekTexture(),
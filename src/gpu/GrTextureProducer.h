@@ -111,6 +111,14 @@ public:
     virtual SkColorSpace* colorSpace() const = 0;
     virtual SkColorSpace* targetColorSpace() const { return nullptr; }
 
+    /**
+     * Hint for the largest scale, in destination pixels per texel, at which the caller will sample
+     * this producer. Texture makers may use a scale below 1/2 to upload a downscaled copy of their
+     * content rather than the full resolution original. Defaults to 1.
+     */
+    void setMaxSampleScale(SkScalar scale) { fMaxSampleScale = scale; }
+    SkScalar maxSampleScale() const { return fMaxSampleScale; }
+
 protected:
     friend class GrTextureProducer_TestAccess;
 
@@ -118,7 +126,8 @@ protected:
         : fContext(context)
         , fWidth(width)
         , fHeight(height)
-        , fIsAlphaOnly(isAlphaOnly) {}
+        , fIsAlphaOnly(isAlphaOnly)
+        , fMaxSampleScale(SK_Scalar1) {}
 
     /** Helper for creating a key for a copy from an original key. */
     static void MakeCopyKeyFromOrigKey(const GrUniqueKey& origKey,
@@ -185,6 +194,7 @@ private:
     const int   fWidth;
     const int   fHeight;
     const bool  fIsAlphaOnly;
+    SkScalar    fMaxSampleScale;
 
     typedef SkNoncopyable INHERITED;
 };
@@ -287,6 +287,9 @@ void SkGpuDevice::drawTextureProducerImpl(GrTextureProducer* producer,
         }
         textureMatrix = &tempMatrix;
     }
+    // Lets texture makers upload a downscaled copy when this draw only samples a fraction of the
+    // texels. Perspective gives a negative scale, which keeps the original.
+    producer->setMaxSampleScale(SkMatrix::Concat(viewMatrix, srcToDstMatrix).getMaxScale());
     auto fp = producer->createFragmentProcessor(*textureMatrix, clippedSrcRect, constraintMode,
                                                 coordsAllInsideSrcRect, filterMode);
     SkColorSpace* rtColorSpace = fRenderTargetContext->colorSpaceInfo().colorSpace();
@@ -359,6 +359,11 @@ static inline int32_t dither_range_type_for_config(GrPixelConfig dstConfig) {
         case kRG_float_GrPixelConfig:
         case kRGBA_half_GrPixelConfig:
         case kRGB_ETC1_GrPixelConfig:
+        case kRGBA_ETC2_GrPixelConfig:
+        case kRGBA_ASTC_4x4_GrPixelConfig:
+        case kRGBA_BC1_GrPixelConfig:
+        case kRGBA_BC3_GrPixelConfig:
+        case kRGBA_BC7_GrPixelConfig:
         case kAlpha_8_GrPixelConfig:
         case kAlpha_8_as_Alpha_GrPixelConfig:
         case kAlpha_8_as_Red_GrPixelConfig:
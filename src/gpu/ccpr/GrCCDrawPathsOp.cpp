@@ -232,10 +232,12 @@ void GrCCDrawPathsOp::SingleDraw::accountForOwnPath(
     if (fCacheEntry) {
         if (const GrCCCachedAtlas* cachedAtlas = fCacheEntry->cachedAtlas()) {
             SkASSERT(cachedAtlas->getOnFlushProxy());
-            if (CoverageType::kA8_LiteralCoverage == cachedAtlas->coverageType()) {
+            if (CoverageType::kA8_LiteralCoverage == cachedAtlas->coverageType() &&
+                !pathCache->reserveCompaction(*fCacheEntry)) {
                 ++specs->fNumCachedPaths;
             } else {
-                // Suggest that this path be copied to a literal coverage atlas, to save memory.
+                // Suggest that this path be copied to a literal coverage atlas, to save memory (or
+                // out of a compacting one, to keep it from getting purged).
                 // (The client may decline this copy via DoCopiesToA8Coverage::kNo.)
                 int idx = (fShape.style().strokeRec().isFillStyle())
                         ? GrCCPerFlushResourceSpecs::kFillIdx
@@ -33,6 +33,12 @@ static inline bool SkShouldPostMessageToBus(
 // The maximum number of cache entries we allow in our own cache.
 static constexpr int kMaxCacheCount = 1 << 16;
 
+// When the cache is full, we evict the least-hit entry among this many least recently used ones.
+static constexpr int kNumEvictionCandidates = 8;
+
+// The most pixels we will copy out of compacting atlases in a single flush.
+static constexpr int kMaxCompactionPixelsPerFlush = 512 * 512;
+
 
 GrCCPathCache::MaskTransform::MaskTransform(const SkMatrix& m, SkIVector* shift)
         : fMatrix2x2{m.getScaleX(), m.getSkewX(), m.getSkewY(), m.getScaleY()} {
@@ -198,9 +204,10 @@ GrCCPathCache::OnFlushEntryRef GrCCPathCache::find(
 
     if (!entry) {
         if (fHashTable.count() >= kMaxCacheCount) {
-            SkDEBUGCODE(HashNode* node = fHashTable.find(*fLRU.tail()->fCacheKey));
-            SkASSERT(node && node->entry() == fLRU.tail());
-            this->evict(*fLRU.tail()->fCacheKey);  // We've exceeded our limit.
+            GrCCPathCacheEntry* victim = this->chooseEntryToEvict();
+            SkDEBUGCODE(HashNode* node = fHashTable.find(*victim->fCacheKey));
+            SkASSERT(node && node->entry() == victim);
+            this->evict(*victim->fCacheKey, victim);  // We've exceeded our limit.
         }
 
         // Create a new entry in the cache.
@@ -254,16 +261,45 @@ void GrCCPathCache::evict(const GrCCPathCache::Key& key, GrCCPathCacheEntry* ent
     SkASSERT(*entry->fCacheKey == key);
     SkASSERT(!entry->hasBeenEvicted());
     entry->fCacheKey->markShouldUnregisterFromPath();  // Unregister the path listener.
-    entry->releaseCachedAtlas(this);
+    entry->releaseCachedAtlas(this, GrCCPathCacheEntry::ReleaseAtlasReason::kEvicted);
     fLRU.remove(entry);
     fHashTable.remove(key);
 }
 
+GrCCPathCacheEntry* GrCCPathCache::chooseEntryToEvict() {
+    SkASSERT(!fLRU.isEmpty());
+    // Paths that keep getting drawn are worth more than the ones that only showed up once or twice,
+    // even if they haven't been drawn quite as recently.
+    GrCCPathCacheEntry* victim = fLRU.tail();
+    GrCCPathCacheEntry* entry = victim->fPrev;
+    for (int i = 1; i < kNumEvictionCandidates && entry; ++i, entry = entry->fPrev) {
+        if (entry->fHitCount < victim->fHitCount) {
+            victim = entry;
+        }
+    }
+    return victim;
+}
+
 void GrCCPathCache::doPreFlushProcessing() {
     this->evictInvalidatedCacheKeys();
 
     // Mark the per-flush timestamp as needing to be updated with a newer clock reading.
     fPerFlushTimestamp = GrStdSteadyClock::time_point::min();
+
+    fCompactionPixelsRemaining = kMaxCompactionPixelsPerFlush;
+}
+
+bool GrCCPathCache::reserveCompaction(const GrCCPathCacheEntry& entry) {
+    SkASSERT(entry.fCachedAtlas);
+    if (!entry.fCachedAtlas->isCompacting()) {
+        return false;
+    }
+    int numPixels = entry.height() * entry.width();
+    if (numPixels > fCompactionPixelsRemaining) {
+        return false;  // Try again next flush.
+    }
+    fCompactionPixelsRemaining -= numPixels;
+    return true;
 }
 
 void GrCCPathCache::purgeEntriesOlderThan(GrProxyProvider* proxyProvider,
@@ -381,7 +417,8 @@ GrCCPathCacheEntry::ReleaseAtlasResult GrCCPathCacheEntry::upgradeToLiteralCover
     SkASSERT(!this->hasBeenEvicted());
     SkASSERT(fOnFlushRefCnt > 0);
     SkASSERT(fCachedAtlas);
-    SkASSERT(GrCCAtlas::CoverageType::kFP16_CoverageCount == fCachedAtlas->coverageType());
+    SkASSERT(GrCCAtlas::CoverageType::kFP16_CoverageCount == fCachedAtlas->coverageType() ||
+             fCachedAtlas->isCompacting());
 
     ReleaseAtlasResult releaseAtlasResult = this->releaseCachedAtlas(pathCache);
 
@@ -394,10 +431,11 @@ GrCCPathCacheEntry::ReleaseAtlasResult GrCCPathCacheEntry::upgradeToLiteralCover
 }
 
 GrCCPathCacheEntry::ReleaseAtlasResult GrCCPathCacheEntry::releaseCachedAtlas(
-        GrCCPathCache* pathCache) {
+        GrCCPathCache* pathCache, ReleaseAtlasReason reason) {
     ReleaseAtlasResult result = ReleaseAtlasResult::kNone;
     if (fCachedAtlas) {
-        result = fCachedAtlas->invalidatePathPixels(pathCache, this->height() * this->width());
+        result = fCachedAtlas->invalidatePathPixels(pathCache, this->height() * this->width(),
+                                                    reason);
         if (fOnFlushRefCnt) {
             SkASSERT(fOnFlushRefCnt > 0);
             fCachedAtlas->decrOnFlushRefCnt(fOnFlushRefCnt);
@@ -408,11 +446,21 @@ GrCCPathCacheEntry::ReleaseAtlasResult GrCCPathCacheEntry::releaseCachedAtlas(
 }
 
 GrCCPathCacheEntry::ReleaseAtlasResult GrCCCachedAtlas::invalidatePathPixels(
-        GrCCPathCache* pathCache, int numPixels) {
+        GrCCPathCache* pathCache, int numPixels, ReleaseAtlasReason reason) {
     // Mark the pixels invalid in the cached atlas texture.
     fNumInvalidatedPathPixels += numPixels;
     SkASSERT(fNumInvalidatedPathPixels <= fNumPathPixels);
-    if (!fIsInvalidatedFromResourceCache && fNumInvalidatedPathPixels >= fNumPathPixels / 2) {
+    if (ReleaseAtlasReason::kEvicted == reason) {
+        fNumEvictedPathPixels += numPixels;
+        if (GrCCAtlas::CoverageType::kA8_LiteralCoverage == fCoverageType &&
+            !fIsInvalidatedFromResourceCache && fNumEvictedPathPixels * 4 >= fNumPathPixels) {
+            // Evicted paths are fragmenting this atlas. Move the rest of its paths out as they
+            // get drawn, instead of purging it at 50% and re-rendering all the survivors.
+            fIsCompacting = true;
+        }
+    }
+    int numPixelsToPurge = fIsCompacting ? fNumPathPixels : fNumPathPixels / 2;
+    if (!fIsInvalidatedFromResourceCache && fNumInvalidatedPathPixels >= numPixelsToPurge) {
         // Too many invalidated pixels: purge the atlas texture from the resource cache.
         if (fOnFlushProxy) {
             // Don't clear (or std::move) fOnFlushProxy. Other path cache entries might still have a
@@ -111,6 +111,10 @@ public:
 
     void doPreFlushProcessing();
 
+    // Reserves room in this flush's compaction budget to move the given entry out of a compacting
+    // atlas (see GrCCCachedAtlas). Returns false if the entry should stay where it is for now.
+    bool reserveCompaction(const GrCCPathCacheEntry&);
+
     void purgeEntriesOlderThan(GrProxyProvider*, const GrStdSteadyClock::time_point& purgeTime);
 
     // As we evict entries from our local path cache, we accumulate a list of invalidated atlas
@@ -160,6 +164,9 @@ private:
 
     void evict(const GrCCPathCache::Key&, GrCCPathCacheEntry* = nullptr);
 
+    // Picks an entry to evict when the cache is full: the least-hit of the least recently used few.
+    GrCCPathCacheEntry* chooseEntryToEvict();
+
     // Evicts all the cache entries whose keys have been queued up in fInvalidatedKeysInbox via
     // SkPath listeners.
     void evictInvalidatedCacheKeys();
@@ -175,6 +182,9 @@ private:
     // excessive clock reads for cache timestamps that might degrade performance.
     GrStdSteadyClock::time_point fPerFlushTimestamp = GrStdSteadyClock::time_point::min();
 
+    // How many more pixels may be moved out of compacting atlases during the current flush.
+    int fCompactionPixelsRemaining = 0;
+
     // As we evict entries from our local path cache, we accumulate lists of invalidated atlas
     // textures in these two members. We hold these until we purge them from the GrResourceCache
     // (e.g. via purgeInvalidatedAtlasTextures().)
@@ -226,6 +236,13 @@ public:
         kDidInvalidateFromCache
     };
 
+    // Why an entry is giving up its atlas. Pixels of paths that left the cache altogether are
+    // what fragments an atlas; a path whose matrix changed is re-rendered and cached anew.
+    enum class ReleaseAtlasReason : bool {
+        kReplaced,
+        kEvicted
+    };
+
     // Called once our path has been rendered into the mainline CCPR (fp16, coverage count) atlas.
     // The caller will stash this atlas texture away after drawing, and during the next flush,
     // recover it and attempt to copy any paths that got reused into permanent 8-bit atlases.
@@ -233,8 +250,9 @@ public:
                                const SkRect& devBounds, const SkRect& devBounds45,
                                const SkIRect& devIBounds, const SkIVector& maskShift);
 
-    // Called once our path mask has been copied into a permanent, 8-bit atlas. This method points
-    // the entry at the new atlas and updates the GrCCCCachedAtlas data.
+    // Called once our path mask has been copied into a permanent, 8-bit atlas (either from a
+    // coverage count atlas, or out of a compacting 8-bit atlas). This method points the entry at
+    // the new atlas and updates the GrCCCCachedAtlas data.
     ReleaseAtlasResult upgradeToLiteralCoverageAtlas(GrCCPathCache*, GrOnFlushResourceProvider*,
                                                      GrCCAtlas*, const SkIVector& newAtlasOffset);
 
@@ -249,7 +267,8 @@ private:
 
     // Resets this entry back to not having an atlas, and purges its previous atlas texture from the
     // resource cache if needed.
-    ReleaseAtlasResult releaseCachedAtlas(GrCCPathCache*);
+    ReleaseAtlasResult releaseCachedAtlas(GrCCPathCache*,
+                                          ReleaseAtlasReason = ReleaseAtlasReason::kReplaced);
 
     sk_sp<GrCCPathCache::Key> fCacheKey;
     GrStdSteadyClock::time_point fTimestamp;
@@ -282,12 +301,19 @@ public:
  * potentially be reused (i.e., those which still represent an extant path). When the percentage
  * of useful pixels drops below 50%, we purge the entire texture from the resource cache.
  *
+ * Literal coverage atlases are long-lived, so that rule would throw away the masks of paths that
+ * are still on screen whenever their neighbors get evicted. Instead, once a quarter of an 8-bit
+ * atlas's pixels belong to evicted paths, the atlas starts "compacting": the paths still in it are
+ * copied into a new 8-bit atlas as they get drawn, a budgeted amount per flush, and the texture is
+ * purged once nothing refers to it.
+ *
  * This object also holds a ref on the atlas's actual texture proxy during flush. When
  * fOnFlushRefCnt decrements back down to zero, we release fOnFlushProxy and reset it back to null.
  */
 class GrCCCachedAtlas : public GrNonAtomicRef<GrCCCachedAtlas> {
 public:
     using ReleaseAtlasResult = GrCCPathCacheEntry::ReleaseAtlasResult;
+    using ReleaseAtlasReason = GrCCPathCacheEntry::ReleaseAtlasReason;
 
     GrCCCachedAtlas(GrCCAtlas::CoverageType type, const GrUniqueKey& textureKey,
                     sk_sp<GrTextureProxy> onFlushProxy)
@@ -311,7 +337,9 @@ public:
     }
 
     void addPathPixels(int numPixels) { fNumPathPixels += numPixels; }
-    ReleaseAtlasResult invalidatePathPixels(GrCCPathCache*, int numPixels);
+    ReleaseAtlasResult invalidatePathPixels(GrCCPathCache*, int numPixels, ReleaseAtlasReason);
+
+    bool isCompacting() const { return fIsCompacting; }
 
     int peekOnFlushRefCnt() const { return fOnFlushRefCnt; }
     void incrOnFlushRefCnt(int count = 1) const {
@@ -327,6 +355,8 @@ private:
 
     int fNumPathPixels = 0;
     int fNumInvalidatedPathPixels = 0;
+    int fNumEvictedPathPixels = 0;
+    bool fIsCompacting = false;
     bool fIsInvalidatedFromResourceCache = false;
 
     mutable sk_sp<GrTextureProxy> fOnFlushProxy;
@@ -51,7 +51,8 @@ protected:
     const sk_sp<const GrCCPerFlushResources> fResources;
 };
 
-// Copies paths from a cached coverage count atlas into an 8-bit literal-coverage atlas.
+// Copies paths from a cached coverage count atlas (or from a compacting 8-bit atlas) into an 8-bit
+// literal-coverage atlas.
 class CopyAtlasOp : public AtlasOp {
 public:
     DEFINE_OP_CLASS_ID
@@ -200,9 +201,10 @@ void GrCCPerFlushResources::upgradeEntryToLiteralCoverageAtlas(
     SkASSERT(cachedAtlas);
     SkASSERT(cachedAtlas->getOnFlushProxy());
 
-    if (GrCCAtlas::CoverageType::kA8_LiteralCoverage == cachedAtlas->coverageType()) {
-        // This entry has already been upgraded to literal coverage. The path must have been drawn
-        // multiple times during the flush.
+    if (GrCCAtlas::CoverageType::kA8_LiteralCoverage == cachedAtlas->coverageType() &&
+        !cachedAtlas->isCompacting()) {
+        // This entry has already been upgraded to literal coverage (or moved out of a compacting
+        // atlas). The path must have been drawn multiple times during the flush.
         SkDEBUGCODE(--fEndCopyInstance);
         return;
     }
@@ -220,9 +222,12 @@ void GrCCPerFlushResources::upgradeEntryToLiteralCoverageAtlas(
 
     sk_sp<GrTexture> previousAtlasTexture =
             sk_ref_sp(cachedAtlas->getOnFlushProxy()->peekTexture());
+    bool previousAtlasIsCoverageCount =
+            GrCCAtlas::CoverageType::kFP16_CoverageCount == cachedAtlas->coverageType();
     GrCCAtlas* newAtlas = &fCopyAtlasStack.current();
     if (ReleaseAtlasResult::kDidInvalidateFromCache ==
-            entry->upgradeToLiteralCoverageAtlas(pathCache, onFlushRP, newAtlas, newAtlasOffset)) {
+            entry->upgradeToLiteralCoverageAtlas(pathCache, onFlushRP, newAtlas, newAtlasOffset) &&
+        previousAtlasIsCoverageCount) {
         // This texture just got booted out of the cache. Keep it around, in case we might be able
         // to recycle it for a new atlas. We can recycle it because copying happens before rendering
         // new paths, and every path from the atlas that we're planning to use this flush will be
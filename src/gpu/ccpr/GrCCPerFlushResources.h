@@ -70,7 +70,8 @@ public:
     bool isMapped() const { return SkToBool(fPathInstanceData); }
 
     // Copies a coverage-counted path out of the given texture proxy, and into a cached, 8-bit,
-    // literal coverage atlas. Updates the cache entry to reference the new atlas.
+    // literal coverage atlas. Paths already in a compacting 8-bit atlas get copied into a fresh
+    // one the same way. Updates the cache entry to reference the new atlas.
     void upgradeEntryToLiteralCoverageAtlas(GrCCPathCache*, GrOnFlushResourceProvider*,
                                             GrCCPathCacheEntry*, GrCCPathProcessor::DoEvenOddFill);
 
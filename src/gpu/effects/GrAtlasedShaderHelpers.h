@@ -11,6 +11,7 @@
 #include "GrShaderCaps.h"
 #include "glsl/GrGLSLPrimitiveProcessor.h"
 #include "glsl/GrGLSLFragmentShaderBuilder.h"
+#include "glsl/GrGLSLUniformHandler.h"
 #include "glsl/GrGLSLVarying.h"
 #include "glsl/GrGLSLVertexGeoBuilder.h"
 
@@ -23,18 +24,19 @@ static void append_index_uv_varyings(GrGLSLPrimitiveProcessor::EmitArgs& args,
     using Interpolation = GrGLSLVaryingHandler::Interpolation;
 
     // This extracts the texture index and texel coordinates from the same variable
-    // Packing structure: texel coordinates are multiplied by 2 (or shifted left 1)
-    //                    texture index is stored as lower bits of both x and y
+    // Packing structure (see GrDrawOpAtlas::PackU/PackV): x is shifted left 2 and y is shifted
+    //                    left 1. The texture index's top two bits are the lower bits of x, and
+    //                    its bottom bit is the lower bit of y.
     if (args.fShaderCaps->integerSupport()) {
         args.fVertBuilder->codeAppendf("int2 signedCoords = int2(%s.x, %s.y);",
                                        inTexCoordsName, inTexCoordsName);
-        args.fVertBuilder->codeAppend("int texIdx = 2*(signedCoords.x & 0x1) + (signedCoords.y & 0x1);");
-        args.fVertBuilder->codeAppend("float2 unormTexCoords = float2(signedCoords.x/2, signedCoords.y/2);");
+        args.fVertBuilder->codeAppend("int texIdx = 2*(signedCoords.x & 0x3) + (signedCoords.y & 0x1);");
+        args.fVertBuilder->codeAppend("float2 unormTexCoords = float2(signedCoords.x/4, signedCoords.y/2);");
     } else {
         args.fVertBuilder->codeAppendf("float2 indexTexCoords = float2(%s.x, %s.y);",
                                        inTexCoordsName, inTexCoordsName);
-        args.fVertBuilder->codeAppend("float2 unormTexCoords = floor(0.5*indexTexCoords);");
-        args.fVertBuilder->codeAppend("float2 diff = indexTexCoords - 2.0*unormTexCoords;");
+        args.fVertBuilder->codeAppend("float2 unormTexCoords = floor(float2(0.25, 0.5)*indexTexCoords);");
+        args.fVertBuilder->codeAppend("float2 diff = indexTexCoords - float2(4.0, 2.0)*unormTexCoords;");
         args.fVertBuilder->codeAppend("float texIdx = 2.0*diff.x + diff.y;");
     }
 
@@ -71,4 +73,23 @@ static void append_multitexture_lookup(GrGLSLPrimitiveProcessor::EmitArgs& args,
     args.fFragBuilder->codeAppend("; }");
 }
 
+// Sets the vertex position to the position attribute offset by a translation uniform, which lets
+// text vertices uploaded for an earlier draw be drawn again somewhere else. Perspective positions
+// are never offset and get no uniform.
+static void append_translated_position(GrGLSLPrimitiveProcessor::EmitArgs& args,
+                                       const GrPrimitiveProcessor::Attribute& inPosition,
+                                       GrGLSLUniformHandler::UniformHandle* translateUniform,
+                                       GrShaderVar* positionVar) {
+    if (kFloat2_GrSLType != inPosition.gpuType()) {
+        *positionVar = inPosition.asShaderVar();
+        return;
+    }
+    const char* translateName;
+    *translateUniform = args.fUniformHandler->addUniform(kVertex_GrShaderFlag, kFloat2_GrSLType,
+                                                         "Translate", &translateName);
+    args.fVertBuilder->codeAppendf("float2 translatedPosition = %s + %s;", inPosition.name(),
+                                   translateName);
+    positionVar->set(kFloat2_GrSLType, "translatedPosition");
+}
+
 #endif
@@ -20,7 +20,8 @@
 
 class GrGLBitmapTextGeoProc : public GrGLSLGeometryProcessor {
 public:
-    GrGLBitmapTextGeoProc() : fColor(SK_PMColor4fILLEGAL), fAtlasSize({0,0}) {}
+    GrGLBitmapTextGeoProc()
+            : fColor(SK_PMColor4fILLEGAL), fAtlasSize({0,0}), fTranslate({SK_ScalarNaN, 0}) {}
 
     void onEmitCode(EmitArgs& args, GrGPArgs* gpArgs) override {
         const GrBitmapTextGeoProc& btgp = args.fGP.cast<GrBitmapTextGeoProc>();
@@ -55,13 +56,14 @@ public:
         }
 
         // Setup position
-        gpArgs->fPositionVar = btgp.inPosition().asShaderVar();
+        append_translated_position(args, btgp.inPosition(), &fTranslateUniform,
+                                   &gpArgs->fPositionVar);
 
         // emit transforms
         this->emitTransforms(vertBuilder,
                              varyingHandler,
                              uniformHandler,
-                             btgp.inPosition().asShaderVar(),
+                             gpArgs->fPositionVar,
                              btgp.localMatrix(),
                              args.fFPCoordTransformHandler);
 
@@ -93,6 +95,10 @@ public:
             pdman.set2f(fAtlasSizeInvUniform, 1.0f / atlasSize.fWidth, 1.0f / atlasSize.fHeight);
             fAtlasSize = atlasSize;
         }
+        if (fTranslateUniform.isValid() && fTranslate != btgp.translation()) {
+            pdman.set2f(fTranslateUniform, btgp.translation().fX, btgp.translation().fY);
+            fTranslate = btgp.translation();
+        }
         this->setTransformDataHelper(btgp.localMatrix(), pdman, &transformIter);
     }
 
@@ -114,6 +120,9 @@ private:
     SkISize       fAtlasSize;
     UniformHandle fAtlasSizeInvUniform;
 
+    SkVector      fTranslate;
+    UniformHandle fTranslateUniform;
+
     typedef GrGLSLGeometryProcessor INHERITED;
 };
 
@@ -129,6 +138,7 @@ GrBitmapTextGeoProc::GrBitmapTextGeoProc(const GrShaderCaps& caps,
         : INHERITED(kGrBitmapTextGeoProc_ClassID)
         , fColor(color)
         , fLocalMatrix(localMatrix)
+        , fTranslation({0, 0})
         , fUsesW(usesW)
         , fMaskFormat(format) {
     SkASSERT(numActiveProxies <= kMaxTextures);
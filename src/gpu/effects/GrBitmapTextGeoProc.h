@@ -21,7 +21,7 @@ class GrInvariantOutput;
  */
 class GrBitmapTextGeoProc : public GrGeometryProcessor {
 public:
-    static constexpr int kMaxTextures = 4;
+    static constexpr int kMaxTextures = 8;
 
     static sk_sp<GrGeometryProcessor> Make(const GrShaderCaps& caps,
                                            const SkPMColor4f& color, bool wideColor,
@@ -50,6 +50,11 @@ public:
 
     void addNewProxies(const sk_sp<GrTextureProxy>*, int numActiveProxies, const GrSamplerState&);
 
+    // Device space offset added to non-perspective positions, so that vertices uploaded for an
+    // earlier draw can be drawn again after the text has moved.
+    void setTranslation(const SkVector& translation) { fTranslation = translation; }
+    const SkVector& translation() const { return fTranslation; }
+
     void getGLSLProcessorKey(const GrShaderCaps& caps, GrProcessorKeyBuilder* b) const override;
 
     GrGLSLPrimitiveProcessor* createGLSLInstance(const GrShaderCaps& caps) const override;
@@ -64,6 +69,7 @@ private:
 
     SkPMColor4f      fColor;
     SkMatrix         fLocalMatrix;
+    SkVector         fTranslation;
     bool             fUsesW;
     SkISize          fAtlasSize;  // size for all textures used with fTextureSamplers[].
     TextureSampler   fTextureSamplers[kMaxTextures];
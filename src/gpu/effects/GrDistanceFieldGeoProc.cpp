@@ -56,13 +56,14 @@ public:
         varyingHandler->addPassThroughAttribute(dfTexEffect.inColor(), args.fOutputColor);
 
         // Setup position
-        gpArgs->fPositionVar = dfTexEffect.inPosition().asShaderVar();
+        append_translated_position(args, dfTexEffect.inPosition(), &fTranslateUniform,
+                                   &gpArgs->fPositionVar);
 
         // emit transforms
         this->emitTransforms(vertBuilder,
                              varyingHandler,
                              uniformHandler,
-                             dfTexEffect.inPosition().asShaderVar(),
+                             gpArgs->fPositionVar,
                              dfTexEffect.localMatrix(),
                              args.fFPCoordTransformHandler);
 
@@ -181,6 +182,10 @@ public:
             pdman.set2f(fAtlasSizeInvUniform, 1.0f / atlasSize.fWidth, 1.0f / atlasSize.fHeight);
             fAtlasSize = atlasSize;
         }
+        if (fTranslateUniform.isValid() && fTranslate != dfa8gp.translation()) {
+            pdman.set2f(fTranslateUniform, dfa8gp.translation().fX, dfa8gp.translation().fY);
+            fTranslate = dfa8gp.translation();
+        }
         this->setTransformDataHelper(dfa8gp.localMatrix(), pdman, &transformIter);
     }
 
@@ -200,6 +205,8 @@ private:
 #endif
     SkISize fAtlasSize = {0, 0};
     UniformHandle fAtlasSizeInvUniform;
+    SkVector fTranslate = {SK_ScalarNaN, 0};
+    UniformHandle fTranslateUniform;
 
     typedef GrGLSLGeometryProcessor INHERITED;
 };
@@ -638,13 +645,14 @@ public:
         varyingHandler->addPassThroughAttribute(dfTexEffect.inColor(), args.fOutputColor);
 
         // Setup position
-        gpArgs->fPositionVar = dfTexEffect.inPosition().asShaderVar();
+        append_translated_position(args, dfTexEffect.inPosition(), &fTranslateUniform,
+                                   &gpArgs->fPositionVar);
 
         // emit transforms
         this->emitTransforms(vertBuilder,
                              varyingHandler,
                              uniformHandler,
-                             dfTexEffect.inPosition().asShaderVar(),
+                             gpArgs->fPositionVar,
                              dfTexEffect.localMatrix(),
                              args.fFPCoordTransformHandler);
 
@@ -800,6 +808,10 @@ public:
             pdman.set2f(fAtlasSizeInvUniform, 1.0f / atlasSize.fWidth, 1.0f / atlasSize.fHeight);
             fAtlasSize = atlasSize;
         }
+        if (fTranslateUniform.isValid() && fTranslate != dflcd.translation()) {
+            pdman.set2f(fTranslateUniform, dflcd.translation().fX, dflcd.translation().fY);
+            fTranslate = dflcd.translation();
+        }
         this->setTransformDataHelper(dflcd.localMatrix(), pdman, &transformIter);
     }
 
@@ -820,6 +832,9 @@ private:
     SkISize                                       fAtlasSize;
     UniformHandle                                 fAtlasSizeInvUniform;
 
+    SkVector                                      fTranslate = {SK_ScalarNaN, 0};
+    UniformHandle                                 fTranslateUniform;
+
     typedef GrGLSLGeometryProcessor INHERITED;
 };
 
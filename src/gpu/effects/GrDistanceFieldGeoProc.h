@@ -53,7 +53,7 @@ enum GrDistanceFieldEffectFlags {
  */
 class GrDistanceFieldA8TextGeoProc : public GrGeometryProcessor {
 public:
-    static constexpr int kMaxTextures = 4;
+    static constexpr int kMaxTextures = 8;
 
     /** The local matrix should be identity if local coords are not required by the GrPipeline. */
 #ifdef SK_GAMMA_APPLY_TO_A8
@@ -92,6 +92,11 @@ public:
 
     void addNewProxies(const sk_sp<GrTextureProxy>* proxies, int numProxies, const GrSamplerState&);
 
+    // Device space offset added to non-perspective positions, so that vertices uploaded for an
+    // earlier draw can be drawn again after the text has moved.
+    void setTranslation(const SkVector& translation) { fTranslation = translation; }
+    const SkVector& translation() const { return fTranslation; }
+
     void getGLSLProcessorKey(const GrShaderCaps& caps, GrProcessorKeyBuilder* b) const override;
 
     GrGLSLPrimitiveProcessor* createGLSLInstance(const GrShaderCaps&) const override;
@@ -111,6 +116,7 @@ private:
     TextureSampler   fTextureSamplers[kMaxTextures];
     SkISize          fAtlasSize;  // size for all textures used with fTextureSamplers[].
     SkMatrix         fLocalMatrix;
+    SkVector         fTranslation = {0, 0};
     Attribute        fInPosition;
     Attribute        fInColor;
     Attribute        fInTextureCoords;
@@ -132,7 +138,7 @@ private:
  */
 class GrDistanceFieldPathGeoProc : public GrGeometryProcessor {
 public:
-    static constexpr int kMaxTextures = 4;
+    static constexpr int kMaxTextures = 8;
 
     /** The local matrix should be identity if local coords are not required by the GrPipeline. */
     static sk_sp<GrGeometryProcessor> Make(const GrShaderCaps& caps,
@@ -194,7 +200,7 @@ private:
  */
 class GrDistanceFieldLCDTextGeoProc : public GrGeometryProcessor {
 public:
-    static constexpr int kMaxTextures = 4;
+    static constexpr int kMaxTextures = 8;
 
     struct DistanceAdjust {
         SkScalar fR, fG, fB;
@@ -237,6 +243,11 @@ public:
 
     void addNewProxies(const sk_sp<GrTextureProxy>*, int numActiveProxies, const GrSamplerState&);
 
+    // Device space offset added to non-perspective positions, so that vertices uploaded for an
+    // earlier draw can be drawn again after the text has moved.
+    void setTranslation(const SkVector& translation) { fTranslation = translation; }
+    const SkVector& translation() const { return fTranslation; }
+
     void getGLSLProcessorKey(const GrShaderCaps& caps, GrProcessorKeyBuilder* b) const override;
 
     GrGLSLPrimitiveProcessor* createGLSLInstance(const GrShaderCaps&) const override;
@@ -251,6 +262,7 @@ private:
     TextureSampler   fTextureSamplers[kMaxTextures];
     SkISize          fAtlasSize;  // size for all textures used with fTextureSamplers[].
     const SkMatrix   fLocalMatrix;
+    SkVector         fTranslation = {0, 0};
     DistanceAdjust   fDistanceAdjust;
     Attribute        fInPosition;
     Attribute        fInColor;
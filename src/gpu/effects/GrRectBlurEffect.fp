@@ -60,7 +60,13 @@ uniform half profileSize;
                 return nullptr;
             }
 
-            SkBlurMask::ComputeBlurProfile(bitmap.getAddr8(0, 0), profileSize, sigma);
+            // Share the profile with the raster rect blur rather than recomputing it.
+            SkCachedData* profile = SkBlurMask::RefBlurProfile(sigma);
+            if (!profile) {
+                return nullptr;
+            }
+            memcpy(bitmap.getAddr8(0, 0), profile->data(), profileSize);
+            profile->unref();
             bitmap.setImmutable();
 
             sk_sp<SkImage> image = SkImage::MakeFromBitmap(bitmap);
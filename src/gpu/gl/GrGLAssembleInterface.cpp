@@ -101,6 +101,9 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLInterface(void *ctx, GrGLGetProc g
     GET_PROC(BlendEquation);
     GET_PROC(BlendFunc);
     GET_PROC(BufferData);
+    if (glVer >= GR_GL_VER(4,4) || extensions.has("GL_ARB_buffer_storage")) {
+        GET_PROC(BufferStorage);
+    }
     GET_PROC(BufferSubData);
     GET_PROC(Clear);
     GET_PROC(ClearColor);
@@ -389,6 +392,7 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLInterface(void *ctx, GrGLGetProc g
     }
 
     if (glVer >= GR_GL_VER(3, 2) || extensions.has("GL_ARB_sync")) {
+        GET_PROC(GetInteger64v);
         GET_PROC(FenceSync);
         GET_PROC(IsSync);
         GET_PROC(ClientWaitSync);
@@ -400,6 +404,12 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLInterface(void *ctx, GrGLGetProc g
         GET_PROC(GetInternalformativ);
     }
 
+    if (glVer >= GR_GL_VER(3,1) || extensions.has("GL_ARB_uniform_buffer_object")) {
+        GET_PROC(BindBufferRange);
+        GET_PROC(GetUniformBlockIndex);
+        GET_PROC(UniformBlockBinding);
+    }
+
     if (glVer >= GR_GL_VER(4, 1)) {
         GET_PROC(GetProgramBinary);
         GET_PROC(ProgramBinary);
@@ -478,6 +488,9 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLESInterface(void *ctx, GrGLGetProc
     GET_PROC(BlendEquation);
     GET_PROC(BlendFunc);
     GET_PROC(BufferData);
+    if (extensions.has("GL_EXT_buffer_storage")) {
+        GET_PROC_SUFFIX(BufferStorage, EXT);
+    }
     GET_PROC(BufferSubData);
     GET_PROC(Clear);
     GET_PROC(ClearColor);
@@ -537,6 +550,15 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLESInterface(void *ctx, GrGLGetProc
         GET_PROC(GetMultisamplefv);
     }
 
+    if (extensions.has("GL_EXT_disjoint_timer_query")) {
+        GET_PROC_SUFFIX(GenQueries, EXT);
+        GET_PROC_SUFFIX(DeleteQueries, EXT);
+        GET_PROC_SUFFIX(QueryCounter, EXT);
+        GET_PROC_SUFFIX(GetQueryObjectuiv, EXT);
+        GET_PROC_SUFFIX(GetQueryObjectui64v, EXT);
+        GET_PROC_SUFFIX(GetInteger64v, EXT);
+    }
+
     GET_PROC(GetProgramInfoLog);
     GET_PROC(GetProgramiv);
     GET_PROC(GetShaderInfoLog);
@@ -845,6 +867,12 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLESInterface(void *ctx, GrGLGetProc
         GET_PROC(GetInternalformativ);
     }
 
+    if (version >= GR_GL_VER(3,0)) {
+        GET_PROC(BindBufferRange);
+        GET_PROC(GetUniformBlockIndex);
+        GET_PROC(UniformBlockBinding);
+    }
+
     if (version >= GR_GL_VER(3, 0)) {
         GET_PROC(GetProgramBinary);
         GET_PROC(ProgramBinary);
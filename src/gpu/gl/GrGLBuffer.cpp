@@ -98,21 +98,44 @@ GrGLBuffer::GrGLBuffer(GrGLGpu* gpu, size_t size, GrBufferType intendedType,
     , fBufferID(0)
     , fUsage(gr_to_gl_access_pattern(intendedType, accessPattern))
     , fGLSizeInBytes(0)
-    , fHasAttachedToTexture(false) {
+    , fHasAttachedToTexture(false)
+    , fPersistentMapPtr(nullptr) {
+    bool persistent = gpu->caps()->persistentlyMappedBufferSupport() &&
+                      kStream_GrAccessPattern == accessPattern &&
+                      (kVertex_GrBufferType == intendedType ||
+                       kIndex_GrBufferType == intendedType);
     GL_CALL(GenBuffers(1, &fBufferID));
     if (fBufferID) {
         GrGLenum target = gpu->bindBuffer(fIntendedType, this);
         CLEAR_ERROR_BEFORE_ALLOC(gpu->glInterface());
         // make sure driver can allocate memory for this buffer
-        GL_ALLOC_CALL(gpu->glInterface(), BufferData(target,
-                                                     (GrGLsizeiptr) size,
-                                                     data,
-                                                     fUsage));
-        if (CHECK_ALLOC_ERROR(gpu->glInterface()) != GR_GL_NO_ERROR) {
-            GL_CALL(DeleteBuffers(1, &fBufferID));
-            fBufferID = 0;
+        if (persistent) {
+            static constexpr GrGLbitfield kFlags =
+                    GR_GL_MAP_WRITE_BIT | GR_GL_MAP_PERSISTENT_BIT | GR_GL_MAP_COHERENT_BIT;
+            GL_ALLOC_CALL(gpu->glInterface(), BufferStorage(target,
+                                                            (GrGLsizeiptr) size,
+                                                            data,
+                                                            kFlags));
+            if (CHECK_ALLOC_ERROR(gpu->glInterface()) == GR_GL_NO_ERROR) {
+                GL_CALL_RET(fPersistentMapPtr, MapBufferRange(target, 0, size, kFlags));
+            }
+            if (!fPersistentMapPtr) {
+                GL_CALL(DeleteBuffers(1, &fBufferID));
+                fBufferID = 0;
+            } else {
+                fGLSizeInBytes = size;
+            }
         } else {
-            fGLSizeInBytes = size;
+            GL_ALLOC_CALL(gpu->glInterface(), BufferData(target,
+                                                         (GrGLsizeiptr) size,
+                                                         data,
+                                                         fUsage));
+            if (CHECK_ALLOC_ERROR(gpu->glInterface()) != GR_GL_NO_ERROR) {
+                GL_CALL(DeleteBuffers(1, &fBufferID));
+                fBufferID = 0;
+            } else {
+                fGLSizeInBytes = size;
+            }
         }
     }
     VALIDATE();
@@ -136,11 +159,13 @@ void GrGLBuffer::onRelease() {
         VALIDATE();
         // make sure we've not been abandoned or already released
         if (fBufferID) {
+            // Deleting a buffer also unmaps it.
             GL_CALL(DeleteBuffers(1, &fBufferID));
             fBufferID = 0;
             fGLSizeInBytes = 0;
         }
         fMapPtr = nullptr;
+        fPersistentMapPtr = nullptr;
         VALIDATE();
     }
 
@@ -151,6 +176,7 @@ void GrGLBuffer::onAbandon() {
     fBufferID = 0;
     fGLSizeInBytes = 0;
     fMapPtr = nullptr;
+    fPersistentMapPtr = nullptr;
     VALIDATE();
     INHERITED::onAbandon();
 }
@@ -164,6 +190,11 @@ void GrGLBuffer::onMap() {
     VALIDATE();
     SkASSERT(!this->isMapped());
 
+    if (fPersistentMapPtr) {
+        fMapPtr = fPersistentMapPtr;
+        return;
+    }
+
     // TODO: Make this a function parameter.
     bool readOnly = (kXferGpuToCpu_GrBufferType == fIntendedType);
 
@@ -173,8 +204,9 @@ void GrGLBuffer::onMap() {
             break;
         case GrGLCaps::kMapBuffer_MapBufferType: {
             GrGLenum target = this->glGpu()->bindBuffer(fIntendedType, this);
-            // Let driver know it can discard the old data
-            if (this->glCaps().useBufferDataNullHint() || fGLSizeInBytes != this->sizeInBytes()) {
+            // Let driver know it can discard the old data, unless we're mapping to read it.
+            if (!readOnly && (this->glCaps().useBufferDataNullHint() ||
+                              fGLSizeInBytes != this->sizeInBytes())) {
                 GL_CALL(BufferData(target, this->sizeInBytes(), nullptr, fUsage));
             }
             GL_CALL_RET(fMapPtr, MapBuffer(target, readOnly ? GR_GL_READ_ONLY : GR_GL_WRITE_ONLY));
@@ -218,7 +250,7 @@ void GrGLBuffer::onUnmap() {
 
     VALIDATE();
     SkASSERT(this->isMapped());
-    if (0 == fBufferID) {
+    if (0 == fBufferID || fPersistentMapPtr) {
         fMapPtr = nullptr;
         return;
     }
@@ -253,6 +285,11 @@ bool GrGLBuffer::onUpdateData(const void* src, size_t srcSizeInBytes) {
         return false;
     }
     SkASSERT(srcSizeInBytes <= this->sizeInBytes());
+    if (fPersistentMapPtr) {
+        // The storage is immutable, so BufferData can't respecify it.
+        memcpy(fPersistentMapPtr, src, srcSizeInBytes);
+        return true;
+    }
     // bindbuffer handles dirty context
     GrGLenum target = this->glGpu()->bindBuffer(fIntendedType, this);
 
@@ -60,6 +60,9 @@ private:
     GrGLenum       fUsage;
     size_t         fGLSizeInBytes;
     bool           fHasAttachedToTexture;
+    // Non-null when the buffer has immutable storage that stays mapped until it is deleted. map()
+    // and unmap() then only hand out this pointer. See GrCaps::persistentlyMappedBufferSupport().
+    void*          fPersistentMapPtr;
 
     typedef GrBuffer INHERITED;
 };
@@ -36,6 +36,8 @@ GrGLCaps::GrGLCaps(const GrContextOptions& contextOptions,
     fMapBufferType = kNone_MapBufferType;
     fTransferBufferType = kNone_TransferBufferType;
     fMaxFragmentUniformVectors = 0;
+    fUniformBufferOffsetAlignment = 0;
+    fMaxUniformBlockSize = 0;
     fUnpackRowLengthSupport = false;
     fPackRowLengthSupport = false;
     fPackFlipYSupport = false;
@@ -67,7 +69,10 @@ GrGLCaps::GrGLCaps(const GrContextOptions& contextOptions,
     fDetachStencilFromMSAABuffersBeforeReadPixels = false;
     fDontSetBaseOrMaxLevelForExternalTextures = false;
     fProgramBinarySupport = false;
+    fParallelShaderCompileSupport = false;
     fSamplerObjectSupport = false;
+    fUniformBufferSupport = false;
+    fTimestampQuerySupport = false;
     fFBFetchRequiresEnablePerSample = false;
 
     fBlitFramebufferFlags = kNoSupport_BlitFramebufferFlag;
@@ -596,12 +601,38 @@ void GrGLCaps::init(const GrContextOptions& contextOptions,
         GR_GL_GetIntegerv(gli, GR_GL_NUM_PROGRAM_BINARY_FORMATS, &count);
         fProgramBinarySupport = count > 0;
     }
+    fParallelShaderCompileSupport = ctxInfo.hasExtension("GL_KHR_parallel_shader_compile") ||
+                                    ctxInfo.hasExtension("GL_ARB_parallel_shader_compile");
     if (kGL_GrGLStandard == standard) {
         fSamplerObjectSupport =
                 version >= GR_GL_VER(3,3) || ctxInfo.hasExtension("GL_ARB_sampler_objects");
     } else {
         fSamplerObjectSupport = version >= GR_GL_VER(3,0);
     }
+    if (kGL_GrGLStandard == standard) {
+        fUniformBufferSupport =
+                (version >= GR_GL_VER(3,1) || ctxInfo.hasExtension("GL_ARB_uniform_buffer_object")) &&
+                ctxInfo.glslGeneration() >= k140_GrGLSLGeneration;
+    } else {
+        fUniformBufferSupport = version >= GR_GL_VER(3,0) &&
+                                ctxInfo.glslGeneration() >= k330_GrGLSLGeneration;
+    }
+    if (fUniformBufferSupport) {
+        GR_GL_GetIntegerv(gli, GR_GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT,
+                          &fUniformBufferOffsetAlignment);
+        GR_GL_GetIntegerv(gli, GR_GL_MAX_UNIFORM_BLOCK_SIZE, &fMaxUniformBlockSize);
+        fUniformBufferSupport = fUniformBufferOffsetAlignment > 0 && fMaxUniformBlockSize > 0;
+    }
+    if (kGL_GrGLStandard == standard) {
+        fTimestampQuerySupport =
+                version >= GR_GL_VER(3,3) || ctxInfo.hasExtension("GL_ARB_timer_query");
+    } else {
+        fTimestampQuerySupport = ctxInfo.hasExtension("GL_EXT_disjoint_timer_query");
+    }
+    // The queries also need a way to read the GPU's clock, which comes from a different extension
+    // on desktop GL.
+    fTimestampQuerySupport = fTimestampQuerySupport && gli->fFunctions.fQueryCounter &&
+                             gli->fFunctions.fGetInteger64v;
     // Requires fTextureRedSupport, fTextureSwizzleSupport, msaa support, ES compatibility have
     // already been detected.
     this->initConfigTable(contextOptions, ctxInfo, gli, shaderCaps);
@@ -610,6 +641,21 @@ void GrGLCaps::init(const GrContextOptions& contextOptions,
         this->applyDriverCorrectnessWorkarounds(ctxInfo, contextOptions, shaderCaps);
     }
 
+    // Persistently mapped buffers are written without synchronizing with the driver, so we need
+    // fences to know when to reuse them. This is checked after the workarounds, which may disable
+    // buffer mapping or prefer client-side buffers instead.
+    if (kGL_GrGLStandard == standard) {
+        fPersistentlyMappedBufferSupport =
+                version >= GR_GL_VER(4,4) || ctxInfo.hasExtension("GL_ARB_buffer_storage");
+    } else {
+        fPersistentlyMappedBufferSupport = ctxInfo.hasExtension("GL_EXT_buffer_storage");
+    }
+    fPersistentlyMappedBufferSupport = fPersistentlyMappedBufferSupport &&
+                                       fFenceSyncSupport &&
+                                       kMapBufferRange_MapBufferType == fMapBufferType &&
+                                       !fPreferClientSideDynamicBuffers &&
+                                       gli->fFunctions.fBufferStorage;
+
     this->applyOptionsOverrides(contextOptions);
     shaderCaps->applyOptionsOverrides(contextOptions);
 
@@ -1137,6 +1183,9 @@ void GrGLCaps::onDumpJSON(SkJSONWriter* writer) const {
     writer->appendString("Invalidate FB Type", kInvalidateFBTypeStr[fInvalidateFBType]);
     writer->appendString("Map Buffer Type", kMapBufferTypeStr[fMapBufferType]);
     writer->appendS32("Max FS Uniform Vectors", fMaxFragmentUniformVectors);
+    writer->appendBool("Uniform buffer support", fUniformBufferSupport);
+    writer->appendS32("Uniform buffer offset alignment", fUniformBufferOffsetAlignment);
+    writer->appendS32("Max uniform block size", fMaxUniformBlockSize);
     writer->appendBool("Unpack Row length support", fUnpackRowLengthSupport);
     writer->appendBool("Pack Row length support", fPackRowLengthSupport);
     writer->appendBool("Pack Flip Y support", fPackFlipYSupport);
@@ -1943,6 +1992,36 @@ void GrGLCaps::initConfigTable(const GrContextOptions& contextOptions,
     }
     fConfigTable[kRGB_ETC1_GrPixelConfig].fSwizzle = GrSwizzle::RGBA();
 
+    auto setupCompressedConfig = [this](GrPixelConfig config, GrGLenum internalFormat,
+                                        bool supported) {
+        ConfigInfo& info = fConfigTable[config];
+        info.fFormats.fBaseInternalFormat = internalFormat;
+        info.fFormats.fSizedInternalFormat = internalFormat;
+        info.fFormats.fExternalFormat[kReadPixels_ExternalFormatUsage] = 0;
+        info.fFormats.fExternalType = 0;
+        info.fFormatType = kNormalizedFixedPoint_FormatType;
+        info.fSwizzle = GrSwizzle::RGBA();
+        if (supported) {
+            info.fFlags = ConfigInfo::kTextureable_Flag;
+        }
+    };
+    bool etc2Support = kGL_GrGLStandard == standard
+            ? version >= GR_GL_VER(4, 3) || ctxInfo.hasExtension("GL_ARB_ES3_compatibility")
+            : version >= GR_GL_VER(3, 0);
+    setupCompressedConfig(kRGBA_ETC2_GrPixelConfig, GR_GL_COMPRESSED_RGBA8_ETC2, etc2Support);
+    setupCompressedConfig(kRGBA_ASTC_4x4_GrPixelConfig, GR_GL_COMPRESSED_RGBA_ASTC_4x4,
+                          ctxInfo.hasExtension("GL_KHR_texture_compression_astc_ldr") ||
+                          ctxInfo.hasExtension("GL_OES_texture_compression_astc"));
+    bool s3tcSupport = ctxInfo.hasExtension("GL_EXT_texture_compression_s3tc");
+    setupCompressedConfig(kRGBA_BC1_GrPixelConfig, GR_GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,
+                          s3tcSupport || ctxInfo.hasExtension("GL_EXT_texture_compression_dxt1"));
+    setupCompressedConfig(kRGBA_BC3_GrPixelConfig, GR_GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+                          s3tcSupport);
+    bool bptcSupport = kGL_GrGLStandard == standard
+            ? version >= GR_GL_VER(4, 2) || ctxInfo.hasExtension("GL_ARB_texture_compression_bptc")
+            : ctxInfo.hasExtension("GL_EXT_texture_compression_bptc");
+    setupCompressedConfig(kRGBA_BC7_GrPixelConfig, GR_GL_COMPRESSED_RGBA_BPTC_UNORM, bptcSupport);
+
     // Bulk populate the texture internal/external formats here and then deal with exceptions below.
 
     // ES 2.0 requires that the internal/external formats match.
@@ -415,8 +415,29 @@ public:
 
     bool programBinarySupport() const { return fProgramBinarySupport; }
 
+    /**
+     * Can the driver compile and link programs off the calling thread, reporting when they are
+     * done through GL_COMPLETION_STATUS (KHR/ARB_parallel_shader_compile)?
+     */
+    bool parallelShaderCompileSupport() const { return fParallelShaderCompileSupport; }
+
     bool samplerObjectSupport() const { return fSamplerObjectSupport; }
 
+    /**
+     * Can non-sampler uniforms be sourced from a std140 uniform block backed by a buffer (GL 3.1,
+     * ARB_uniform_buffer_object or ES 3.0)?
+     */
+    bool uniformBufferSupport() const { return fUniformBufferSupport; }
+
+    /// Required alignment of the offset passed to glBindBufferRange for uniform buffers.
+    int uniformBufferOffsetAlignment() const { return fUniformBufferOffsetAlignment; }
+
+    /// The largest uniform block, in bytes, a program may declare.
+    int maxUniformBlockSize() const { return fMaxUniformBlockSize; }
+
+    /** Are glQueryCounter(GL_TIMESTAMP) and glGetInteger64v(GL_TIMESTAMP) available? */
+    bool timestampQuerySupport() const { return fTimestampQuerySupport; }
+
     bool fbFetchRequiresEnablePerSample() const { return fFBFetchRequiresEnablePerSample; }
 
     GrPixelConfig validateBackendRenderTarget(const GrBackendRenderTarget&,
@@ -471,6 +492,8 @@ private:
     SkTArray<StencilFormat, true> fStencilFormats;
 
     int fMaxFragmentUniformVectors;
+    int fUniformBufferOffsetAlignment;
+    int fMaxUniformBlockSize;
 
     MSFBOType           fMSFBOType;
     InvalidateFBType    fInvalidateFBType;
@@ -504,7 +527,10 @@ private:
     bool fUseBufferDataNullHint                : 1;
     bool fClearTextureSupport : 1;
     bool fProgramBinarySupport : 1;
+    bool fParallelShaderCompileSupport : 1;
     bool fSamplerObjectSupport : 1;
+    bool fUniformBufferSupport : 1;
+    bool fTimestampQuerySupport : 1;
     bool fFBFetchRequiresEnablePerSample : 1;
 
     // Driver workarounds
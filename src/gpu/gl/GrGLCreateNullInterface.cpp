@@ -272,6 +272,12 @@ public:
         fBoundBuffers[GetBufferIndex(target)] = buffer;
     }
 
+    GrGLvoid bindBufferRange(GrGLenum target, GrGLuint index, GrGLuint buffer, GrGLintptr offset,
+                             GrGLsizeiptr size) override {
+        // Binding a range also binds the buffer to the generic target.
+        fBoundBuffers[GetBufferIndex(target)] = buffer;
+    }
+
    // deleting a bound buffer has the side effect of binding 0
    GrGLvoid deleteBuffers(GrGLsizei n, const GrGLuint* ids) override {
         // First potentially unbind the buffers.
@@ -508,6 +514,12 @@ public:
             case GR_GL_MAX_FRAGMENT_UNIFORM_COMPONENTS:
                 *params = 16 * 4;
                 break;
+            case GR_GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+                *params = 256;
+                break;
+            case GR_GL_MAX_UNIFORM_BLOCK_SIZE:
+                *params = 16384;
+                break;
             case GR_GL_NUM_COMPRESSED_TEXTURE_FORMATS:
                 *params = 0;
                 break;
@@ -702,9 +714,10 @@ private:
             case GR_GL_DRAW_INDIRECT_BUFFER:   return 3;
             case GR_GL_PIXEL_PACK_BUFFER:      return 4;
             case GR_GL_PIXEL_UNPACK_BUFFER:    return 5;
+            case GR_GL_UNIFORM_BUFFER:         return 6;
         }
     }
-    constexpr int static kNumBufferTargets = 6;
+    constexpr int static kNumBufferTargets = 7;
 
     TGLObjectManager<Buffer>         fBufferManager;
     GrGLuint                         fBoundBuffers[kNumBufferTargets];
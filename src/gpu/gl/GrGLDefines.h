@@ -115,6 +115,7 @@
 #define GR_GL_DRAW_INDIRECT_BUFFER_BINDING   0x8F43
 #define GR_GL_PIXEL_PACK_BUFFER              0x88EB
 #define GR_GL_PIXEL_UNPACK_BUFFER            0x88EC
+#define GR_GL_UNIFORM_BUFFER                 0x8A11
 
 #define GR_GL_PIXEL_UNPACK_TRANSFER_BUFFER_CHROMIUM 0x78EC
 #define GR_GL_PIXEL_PACK_TRANSFER_BUFFER_CHROMIUM   0x78ED
@@ -543,6 +544,9 @@
 #define GR_GL_MAX_GEOMETRY_TEXTURE_IMAGE_UNITS         0x8C29
 #define GR_GL_MAX_TEXTURE_IMAGE_UNITS                  0x8872
 #define GR_GL_MAX_FRAGMENT_UNIFORM_VECTORS             0x8DFD
+#define GR_GL_MAX_UNIFORM_BLOCK_SIZE                   0x8A30
+#define GR_GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT          0x8A34
+#define GR_GL_INVALID_INDEX                            0xFFFFFFFF
 #define GR_GL_SHADER_TYPE                              0x8B4F
 #define GR_GL_DELETE_STATUS                            0x8B80
 #define GR_GL_LINK_STATUS                              0x8B82
@@ -836,6 +840,8 @@
 #define GR_GL_MAP_INVALIDATE_BUFFER_BIT          0x0008
 #define GR_GL_MAP_FLUSH_EXPLICIT_BIT             0x0010
 #define GR_GL_MAP_UNSYNCHRONIZED_BIT             0x0020
+#define GR_GL_MAP_PERSISTENT_BIT                 0x0040
+#define GR_GL_MAP_COHERENT_BIT                   0x0080
 
 /* Read Format */
 #define GR_GL_IMPLEMENTATION_COLOR_READ_TYPE   0x8B9A
@@ -871,6 +877,7 @@
 #define GR_GL_ANY_SAMPLES_PASSED             0x8C2F
 #define GR_GL_TIME_ELAPSED                   0x88BF
 #define GR_GL_TIMESTAMP                      0x8E28
+#define GR_GL_GPU_DISJOINT                   0x8FBB
 #define GR_GL_PRIMITIVES_GENERATED           0x8C87
 #define GR_GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN 0x8C88
 
@@ -1077,4 +1084,7 @@
 #define GR_GL_PROGRAM_BINARY_RETRIEVABLE_HINT               0x8257
 #define GL_PROGRAM_BINARY_LENGTH                            0x8741
 
+/* KHR_parallel_shader_compile */
+#define GR_GL_COMPLETION_STATUS                             0x91B1
+
 #endif
@@ -27,6 +27,7 @@
 #include "SkHalf.h"
 #include "SkMakeUnique.h"
 #include "SkMipMap.h"
+#include "SkOpts.h"
 #include "SkPixmap.h"
 #include "SkSLCompiler.h"
 #include "SkStrokeRec.h"
@@ -259,6 +260,8 @@ public:
         if (fHWBoundSamplers[unitIdx] != fSamplers[index]) {
             GR_GL_CALL(fGpu->glInterface(), BindSampler(unitIdx, fSamplers[index]));
             fHWBoundSamplers[unitIdx] = fSamplers[index];
+        } else {
+            fGpu->stats()->incSkippedStateChanges();
         }
     }
 
@@ -393,6 +396,9 @@ GrGLGpu::~GrGLGpu() {
     if (fStencilClearFBOID) {
         this->deleteFramebuffer(fStencilClearFBOID);
     }
+    if (fUniformRingID) {
+        GL_CALL(DeleteBuffers(1, &fUniformRingID));
+    }
 
     for (size_t i = 0; i < SK_ARRAY_COUNT(fCopyPrograms); ++i) {
         if (0 != fCopyPrograms[i].fProgram) {
@@ -406,6 +412,8 @@ GrGLGpu::~GrGLGpu() {
         }
     }
 
+    this->deleteTraceSpanQueries();
+
     delete fProgramCache;
     fSamplerObjectCache.reset();
 }
@@ -425,6 +433,9 @@ void GrGLGpu::disconnect(DisconnectType type) {
         if (fStencilClearFBOID) {
             this->deleteFramebuffer(fStencilClearFBOID);
         }
+        if (fUniformRingID) {
+            GL_CALL(DeleteBuffers(1, &fUniformRingID));
+        }
         for (size_t i = 0; i < SK_ARRAY_COUNT(fCopyPrograms); ++i) {
             if (fCopyPrograms[i].fProgram) {
                 GL_CALL(DeleteProgram(fCopyPrograms[i].fProgram));
@@ -439,6 +450,7 @@ void GrGLGpu::disconnect(DisconnectType type) {
         if (fSamplerObjectCache) {
             fSamplerObjectCache->release();
         }
+        this->deleteTraceSpanQueries();
     } else {
         if (fProgramCache) {
             fProgramCache->abandon();
@@ -456,6 +468,10 @@ void GrGLGpu::disconnect(DisconnectType type) {
     fTempSrcFBOID = 0;
     fTempDstFBOID = 0;
     fStencilClearFBOID = 0;
+    fUniformRingID = 0;
+    fUniformRingOffset = 0;
+    ++fUniformRingGeneration;
+    fHWUniformBlockSize = 0;
     fCopyProgramArrayBuffer.reset();
     for (size_t i = 0; i < SK_ARRAY_COUNT(fCopyPrograms); ++i) {
         fCopyPrograms[i].fProgram = 0;
@@ -464,6 +480,8 @@ void GrGLGpu::disconnect(DisconnectType type) {
     for (size_t i = 0; i < SK_ARRAY_COUNT(fMipmapPrograms); ++i) {
         fMipmapPrograms[i].fProgram = 0;
     }
+    fOpenTraceSpans.reset();
+    fPendingTraceSpans.reset();
 
     if (this->glCaps().shaderCaps()->pathRenderingSupport()) {
         this->glPathRendering()->disconnect(type);
@@ -488,6 +506,7 @@ void GrGLGpu::onResetContext(uint32_t resetBits) {
         fHWBufferState[kDrawIndirect_GrBufferType].invalidate();
         fHWBufferState[kXferCpuToGpu_GrBufferType].invalidate();
         fHWBufferState[kXferGpuToCpu_GrBufferType].invalidate();
+        fHWUniformBlockSize = 0;
 
         if (kGL_GrGLStandard == this->glStandard()) {
 #ifndef USE_NSIGHT
@@ -838,6 +857,11 @@ static inline GrGLint config_alignment(GrPixelConfig config) {
         case kRG_float_GrPixelConfig:
             return 4;
         case kRGB_ETC1_GrPixelConfig:
+        case kRGBA_ETC2_GrPixelConfig:
+        case kRGBA_ASTC_4x4_GrPixelConfig:
+        case kRGBA_BC1_GrPixelConfig:
+        case kRGBA_BC3_GrPixelConfig:
+        case kRGBA_BC7_GrPixelConfig:
         case kUnknown_GrPixelConfig:
             return 0;
     }
@@ -1158,6 +1182,18 @@ void GrGLGpu::unbindCpuToGpuXferBuffer() {
 
 }
 
+void GrGLGpu::unbindGpuToCpuXferBuffer() {
+    if (GrGLCaps::kNone_TransferBufferType == this->glCaps().transferBufferType()) {
+        return;
+    }
+    auto& xferBufferState = fHWBufferState[kXferGpuToCpu_GrBufferType];
+    if (!xferBufferState.fBufferZeroKnownBound) {
+        GL_CALL(BindBuffer(xferBufferState.fGLTarget, 0));
+        xferBufferState.fBoundBufferUniqueID.makeInvalid();
+        xferBufferState.fBufferZeroKnownBound = true;
+    }
+}
+
 // TODO: Make this take a GrColorType instead of dataConfig. This requires updating GrGLCaps to
 // convert from GrColorType to externalFormat/externalType GLenum values.
 bool GrGLGpu::uploadTexData(GrPixelConfig texConfig, int texWidth, int texHeight, GrGLenum target,
@@ -2042,6 +2078,7 @@ void GrGLGpu::flushProgram(sk_sp<GrGLProgram> program) {
     }
     SkASSERT((program == fHWProgram) == (fHWProgramID == program->programID()));
     if (program == fHWProgram) {
+        fStats.incSkippedStateChanges();
         return;
     }
     auto id = program->programID();
@@ -2055,6 +2092,7 @@ void GrGLGpu::flushProgram(GrGLuint id) {
     SkASSERT(id);
     if (fHWProgramID == id) {
         SkASSERT(!fHWProgram);
+        fStats.incSkippedStateChanges();
         return;
     }
     fHWProgram.reset();
@@ -2313,6 +2351,27 @@ bool GrGLGpu::readPixelsSupported(GrSurface* surfaceForConfig, GrPixelConfig rea
 
 bool GrGLGpu::onReadPixels(GrSurface* surface, int left, int top, int width, int height,
                            GrColorType dstColorType, void* buffer, size_t rowBytes) {
+    this->unbindGpuToCpuXferBuffer();
+    return this->readOrTransferPixelsFrom(surface, left, top, width, height, dstColorType, buffer,
+                                          rowBytes);
+}
+
+bool GrGLGpu::onTransferPixelsFrom(GrSurface* surface, int left, int top, int width, int height,
+                                   GrColorType dstColorType, GrBuffer* transferBuffer,
+                                   size_t offset) {
+    SkASSERT(!transferBuffer->isMapped());
+    SkASSERT(!transferBuffer->isCPUBacked());
+    const GrGLBuffer* glBuffer = static_cast<const GrGLBuffer*>(transferBuffer);
+    this->bindBuffer(kXferGpuToCpu_GrBufferType, glBuffer);
+    // Tight rows never need the scratch copy, which would read the buffer back on the CPU.
+    size_t rowBytes = GrColorTypeBytesPerPixel(dstColorType) * width;
+    return this->readOrTransferPixelsFrom(surface, left, top, width, height, dstColorType,
+                                          reinterpret_cast<void*>(offset), rowBytes);
+}
+
+bool GrGLGpu::readOrTransferPixelsFrom(GrSurface* surface, int left, int top, int width,
+                                       int height, GrColorType dstColorType, void* buffer,
+                                       size_t rowBytes) {
     SkASSERT(surface);
 
     GrGLRenderTarget* renderTarget = static_cast<GrGLRenderTarget*>(surface->asRenderTarget());
@@ -2520,6 +2579,84 @@ void GrGLGpu::flushViewport(const GrGLIRect& viewport) {
     #endif
 #endif
 
+static bool textures_are_instantiated(const GrFragmentProcessor& fp) {
+    for (int i = 0; i < fp.numTextureSamplers(); ++i) {
+        if (!fp.textureSampler(i).peekTexture()) {
+            return false;
+        }
+    }
+    for (int i = 0; i < fp.numChildProcessors(); ++i) {
+        if (!textures_are_instantiated(fp.childProcessor(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void GrGLGpu::willUseProgram(GrRenderTarget* renderTarget, GrSurfaceOrigin origin,
+                             const GrPrimitiveProcessor& primProc,
+                             const GrTextureProxy* const primProcProxies[],
+                             const GrPipeline& pipeline,
+                             bool willDrawPoints) {
+    if (!this->glCaps().parallelShaderCompileSupport() || !renderTarget || pipeline.isBad()) {
+        return;
+    }
+    // Building the program looks at the textures. If some aren't there yet, the program is just
+    // compiled when the draw is executed.
+    for (int i = 0; i < primProc.numTextureSamplers(); ++i) {
+        if (!primProcProxies[i]->peekTexture()) {
+            return;
+        }
+    }
+    for (int i = 0; i < pipeline.numFragmentProcessors(); ++i) {
+        if (!textures_are_instantiated(pipeline.getFragmentProcessor(i))) {
+            return;
+        }
+    }
+    if (pipeline.dstTextureProxy() && !pipeline.peekDstTexture()) {
+        return;
+    }
+    fProgramCache->precompileProgram(this, renderTarget, origin, primProc, primProcProxies,
+                                     pipeline, willDrawPoints);
+}
+
+void GrGLGpu::bindUniformBlock(const void* data, uint32_t size, bool dirty, uint32_t* generation,
+                               GrGLintptr* offset) {
+    SkASSERT(this->glCaps().uniformBufferSupport());
+    SkASSERT(size <= (uint32_t)this->glCaps().maxUniformBlockSize());
+    if (!fUniformRingID) {
+        GL_CALL(GenBuffers(1, &fUniformRingID));
+        GL_CALL(BindBuffer(GR_GL_UNIFORM_BUFFER, fUniformRingID));
+        GL_CALL(BufferData(GR_GL_UNIFORM_BUFFER, kUniformRingSize, nullptr, GR_GL_STREAM_DRAW));
+        fUniformRingOffset = 0;
+        ++fUniformRingGeneration;
+        fHWUniformBlockSize = 0;
+    }
+    if (dirty || *generation != fUniformRingGeneration) {
+        GrGLsizeiptr alignment = this->glCaps().uniformBufferOffsetAlignment();
+        GrGLsizeiptr start = (fUniformRingOffset + alignment - 1) / alignment * alignment;
+        GL_CALL(BindBuffer(GR_GL_UNIFORM_BUFFER, fUniformRingID));
+        if (start + (GrGLsizeiptr)size > kUniformRingSize) {
+            // Orphan the ring rather than wait on draws that may still read from it.
+            GL_CALL(BufferData(GR_GL_UNIFORM_BUFFER, kUniformRingSize, nullptr,
+                               GR_GL_STREAM_DRAW));
+            ++fUniformRingGeneration;
+            start = 0;
+        }
+        GL_CALL(BufferSubData(GR_GL_UNIFORM_BUFFER, start, size, data));
+        fUniformRingOffset = start + size;
+        *generation = fUniformRingGeneration;
+        *offset = start;
+    } else {
+        fStats.incSkippedStateChanges();
+    }
+    if (fHWUniformBlockSize != (GrGLsizeiptr)size || fHWUniformBlockOffset != *offset) {
+        GL_CALL(BindBufferRange(GR_GL_UNIFORM_BUFFER, 0, fUniformRingID, *offset, size));
+        fHWUniformBlockOffset = *offset;
+        fHWUniformBlockSize = size;
+    }
+}
+
 void GrGLGpu::draw(GrRenderTarget* renderTarget, GrSurfaceOrigin origin,
                    const GrPrimitiveProcessor& primProc,
                    const GrPipeline& pipeline,
@@ -2960,6 +3097,8 @@ void GrGLGpu::bindTexture(int unitIdx, GrSamplerState samplerState, GrGLTexture*
         this->setTextureUnit(unitIdx);
         GL_CALL(BindTexture(target, texture->textureID()));
         fHWBoundTextureUniqueIDs[unitIdx] = textureID;
+    } else {
+        fStats.incSkippedStateChanges();
     }
 
     if (samplerState.filter() == GrSamplerState::Filter::kMipMap) {
@@ -3776,24 +3915,53 @@ bool GrGLGpu::onRegenerateMipMapLevels(GrTexture* texture) {
         return false;
     }
 
-    // Manual implementation of mipmap generation, to work around driver bugs w/sRGB.
-    // Uses draw calls to do a series of downsample operations to successive mips.
+    if (!this->canManuallyMipMap(glTex)) {
+        this->generateMipmap(glTex);
+        return true;
+    }
+    return this->setupManualMipMapping() && this->drawMipMapLevels(glTex);
+}
+
+void GrGLGpu::onBatchRegenerateMipMapLevels(GrTexture* const textures[], int count,
+                                            bool regenerated[]) {
+    // The temp FBO, vertex array and fixed function state are shared by every texture, so set
+    // them up once for the whole batch.
+    bool setupManual = false, setupFailed = false;
+    for (int i = 0; i < count; ++i) {
+        auto glTex = static_cast<GrGLTexture*>(textures[i]);
+        if (GR_GL_TEXTURE_2D != glTex->target()) {
+            continue;
+        }
+        if (!this->canManuallyMipMap(glTex)) {
+            this->generateMipmap(glTex);
+            regenerated[i] = true;
+            continue;
+        }
+        if (!setupManual && !setupFailed) {
+            setupManual = this->setupManualMipMapping();
+            setupFailed = !setupManual;
+        }
+        regenerated[i] = setupManual && this->drawMipMapLevels(glTex);
+    }
+}
 
+bool GrGLGpu::canManuallyMipMap(const GrGLTexture* glTex) const {
     // The manual approach requires the ability to limit which level we're sampling and that the
     // destination can be bound to a FBO:
-    if (!this->glCaps().doManualMipmapping() ||
-        !this->glCaps().canConfigBeFBOColorAttachment(texture->config())) {
-        GrGLenum target = glTex->target();
-        this->setScratchTextureUnit();
-        GL_CALL(BindTexture(target, glTex->textureID()));
-        GL_CALL(GenerateMipmap(glTex->target()));
-        return true;
-    }
+    return this->glCaps().doManualMipmapping() &&
+           this->glCaps().canConfigBeFBOColorAttachment(glTex->config());
+}
 
-    int width = texture->width();
-    int height = texture->height();
-    int levelCount = SkMipMap::ComputeLevelCount(width, height) + 1;
-    SkASSERT(levelCount == texture->texturePriv().maxMipMapLevel() + 1);
+void GrGLGpu::generateMipmap(GrGLTexture* glTex) {
+    GrGLenum target = glTex->target();
+    this->setScratchTextureUnit();
+    GL_CALL(BindTexture(target, glTex->textureID()));
+    GL_CALL(GenerateMipmap(glTex->target()));
+}
+
+bool GrGLGpu::setupManualMipMapping() {
+    // Manual implementation of mipmap generation, to work around driver bugs w/sRGB.
+    // Uses draw calls to do a series of downsample operations to successive mips.
 
     // Create (if necessary), then bind temporary FBO:
     if (0 == fTempDstFBOID) {
@@ -3802,11 +3970,6 @@ bool GrGLGpu::onRegenerateMipMapLevels(GrTexture* texture) {
     this->bindFramebuffer(GR_GL_FRAMEBUFFER, fTempDstFBOID);
     fHWBoundRenderTargetUniqueID.makeInvalid();
 
-    // Bind the texture, to get things configured for filtering.
-    // We'll be changing our base level further below:
-    this->setTextureUnit(0);
-    this->bindTexture(0, GrSamplerState::ClampBilerp(), glTex);
-
     // Vertex data:
     if (!fMipmapProgramArrayBuffer) {
         static const GrGLfloat vdata[] = {
@@ -3838,10 +4001,21 @@ bool GrGLGpu::onRegenerateMipMapLevels(GrTexture* texture) {
     this->disableScissor();
     this->disableWindowRectangles();
     this->disableStencil();
+    return true;
+}
+
+bool GrGLGpu::drawMipMapLevels(GrGLTexture* glTex) {
+    int width = glTex->width();
+    int height = glTex->height();
+    int levelCount = SkMipMap::ComputeLevelCount(width, height) + 1;
+    SkASSERT(levelCount == glTex->texturePriv().maxMipMapLevel() + 1);
+
+    // Bind the texture, to get things configured for filtering.
+    // We'll be changing our base level further below:
+    this->setTextureUnit(0);
+    this->bindTexture(0, GrSamplerState::ClampBilerp(), glTex);
 
     // Do all the blits:
-    width = texture->width();
-    height = texture->height();
     GrGLIRect viewport;
     viewport.fLeft = 0;
     viewport.fBottom = 0;
@@ -4231,6 +4405,82 @@ void GrGLGpu::onFinishFlush(bool insertedSemaphore) {
     if (insertedSemaphore) {
         GL_CALL(Flush());
     }
+    this->reportTraceSpans();
+}
+
+bool GrGLGpu::onBeginTraceSpan(const char* name) {
+    if (!this->glCaps().timestampQuerySupport() ||
+        fPendingTraceSpans.count() + fOpenTraceSpans.count() >= kMaxPendingTraceSpans) {
+        return false;
+    }
+    TraceSpan& span = fOpenTraceSpans.push_back();
+    span.fName = name;
+    GL_CALL(GenQueries(1, &span.fBeginQuery));
+    GL_CALL(GenQueries(1, &span.fEndQuery));
+    GL_CALL(QueryCounter(span.fBeginQuery, GR_GL_TIMESTAMP));
+    return true;
+}
+
+void GrGLGpu::onEndTraceSpan() {
+    SkASSERT(!fOpenTraceSpans.empty());
+    TraceSpan span = fOpenTraceSpans.back();
+    fOpenTraceSpans.pop_back();
+    GL_CALL(QueryCounter(span.fEndQuery, GR_GL_TIMESTAMP));
+    fPendingTraceSpans.push_back(span);
+}
+
+void GrGLGpu::reportTraceSpans() {
+    if (fPendingTraceSpans.empty()) {
+        return;
+    }
+    // With EXT_disjoint_timer_query, something like a power state change can make the results of
+    // the queries in flight meaningless. Desktop GL has no such notion.
+    GrGLint disjoint = 0;
+    if (kGLES_GrGLStandard == this->glStandard()) {
+        GL_CALL(GetIntegerv(GR_GL_GPU_DISJOINT, &disjoint));
+    }
+    // The GPU's clock when the commands issued so far reach it. The spans are reported relative to
+    // it, which places them correctly on the CPU's timeline without knowing how the clocks relate.
+    GrGLint64 now = 0;
+    GL_CALL(GetInteger64v(GR_GL_TIMESTAMP, &now));
+
+    int done = 0;
+    for (; done < fPendingTraceSpans.count(); ++done) {
+        const TraceSpan& span = fPendingTraceSpans[done];
+        if (!disjoint) {
+            GrGLuint available = 0;
+            GL_CALL(GetQueryObjectuiv(span.fEndQuery, GR_GL_QUERY_RESULT_AVAILABLE, &available));
+            if (!available) {
+                // The timestamps are written in order, so the later spans aren't ready either.
+                break;
+            }
+            GrGLuint64 begin = 0, end = 0;
+            GL_CALL(GetQueryObjectui64v(span.fBeginQuery, GR_GL_QUERY_RESULT, &begin));
+            GL_CALL(GetQueryObjectui64v(span.fEndQuery, GR_GL_QUERY_RESULT, &end));
+            if (begin <= end && end <= static_cast<GrGLuint64>(now)) {
+                ReportTraceSpan(span.fName, now - begin, end - begin);
+            }
+        }
+        GL_CALL(DeleteQueries(1, &span.fBeginQuery));
+        GL_CALL(DeleteQueries(1, &span.fEndQuery));
+    }
+    for (int i = done; i < fPendingTraceSpans.count(); ++i) {
+        fPendingTraceSpans[i - done] = fPendingTraceSpans[i];
+    }
+    fPendingTraceSpans.pop_back_n(done);
+}
+
+void GrGLGpu::deleteTraceSpanQueries() {
+    for (const TraceSpan& span : fOpenTraceSpans) {
+        GL_CALL(DeleteQueries(1, &span.fBeginQuery));
+        GL_CALL(DeleteQueries(1, &span.fEndQuery));
+    }
+    for (const TraceSpan& span : fPendingTraceSpans) {
+        GL_CALL(DeleteQueries(1, &span.fBeginQuery));
+        GL_CALL(DeleteQueries(1, &span.fEndQuery));
+    }
+    fOpenTraceSpans.reset();
+    fPendingTraceSpans.reset();
 }
 
 void GrGLGpu::submit(GrGpuCommandBuffer* buffer) {
@@ -4254,7 +4504,7 @@ GrFence SK_WARN_UNUSED_RESULT GrGLGpu::insertFence() {
 bool GrGLGpu::waitFence(GrFence fence, uint64_t timeout) {
     GrGLenum result;
     GL_CALL_RET(result, ClientWaitSync((GrGLsync)fence, GR_GL_SYNC_FLUSH_COMMANDS_BIT, timeout));
-    return (GR_GL_CONDITION_SATISFIED == result);
+    return (GR_GL_CONDITION_SATISFIED == result || GR_GL_ALREADY_SIGNALED == result);
 }
 
 void GrGLGpu::deleteFence(GrFence fence) const {
@@ -4319,6 +4569,21 @@ int GrGLGpu::TextureToCopyProgramIdx(GrTexture* texture) {
     }
 }
 
+uint32_t GrGLGpu::shaderCacheScope() const {
+    // Contexts on the same GL implementation accept each other's GLSL and program binaries.
+    uint32_t hash = SkOpts::hash_fn("GL", 2, 0);
+    for (GrGLenum name : {GR_GL_VENDOR, GR_GL_RENDERER, GR_GL_VERSION,
+                          GR_GL_SHADING_LANGUAGE_VERSION}) {
+        const GrGLubyte* str;
+        GL_CALL_RET(str, GetString(name));
+        if (!str) {
+            return 0;
+        }
+        hash = SkOpts::hash_fn(str, strlen((const char*)str), hash);
+    }
+    return hash ? hash : 1;
+}
+
 #ifdef SK_ENABLE_DUMP_GPU
 #include "SkJSONWriter.h"
 void GrGLGpu::onDumpJSON(SkJSONWriter* writer) const {
@@ -76,6 +76,12 @@ public:
     // If the caller wishes to bind an index buffer to a specific VAO, it can call glBind directly.
     GrGLenum bindBuffer(GrBufferType type, const GrBuffer*);
 
+    // Binds size bytes of a program's std140 uniform block to uniform buffer binding 0, streaming
+    // them into a ring buffer first when they are dirty or when the ring has been orphaned since
+    // they were streamed to *offset. *generation and *offset remember where they were streamed.
+    void bindUniformBlock(const void* data, uint32_t size, bool dirty, uint32_t* generation,
+                          GrGLintptr* offset);
+
     // The GrGLGpuRTCommandBuffer does not buffer up draws before submitting them to the gpu.
     // Thus this is the implementation of the draw call for the corresponding passthrough function
     // on GrGLRTGpuCommandBuffer.
@@ -87,6 +93,10 @@ public:
               const GrMesh[],
               int meshCount);
 
+    void willUseProgram(GrRenderTarget*, GrSurfaceOrigin, const GrPrimitiveProcessor&,
+                        const GrTextureProxy* const primProcProxies[], const GrPipeline&,
+                        bool willDrawPoints) override;
+
     // GrMesh::SendToGpuImpl methods. These issue the actual GL draw calls.
     // Marked final as a hint to the compiler to not use virtual dispatch.
     void sendMeshToGpu(GrPrimitiveType, const GrBuffer* vertexBuffer, int vertexCount,
@@ -151,6 +161,8 @@ public:
 
     void resetShaderCacheForTesting() const override { fProgramCache->abandon(); }
 
+    uint32_t shaderCacheScope() const override;
+
     void testingOnly_flushGpuAndSync() override;
 #endif
 
@@ -229,6 +241,14 @@ private:
     bool onReadPixels(GrSurface*, int left, int top, int width, int height, GrColorType,
                       void* buffer, size_t rowBytes) override;
 
+    bool onTransferPixelsFrom(GrSurface*, int left, int top, int width, int height, GrColorType,
+                              GrBuffer* transferBuffer, size_t offset) override;
+
+    // Shared by onReadPixels and onTransferPixelsFrom. When a pack buffer is bound, buffer is an
+    // offset into it rather than a client pointer.
+    bool readOrTransferPixelsFrom(GrSurface*, int left, int top, int width, int height,
+                                  GrColorType, void* buffer, size_t rowBytes);
+
     bool onWritePixels(GrSurface*, int left, int top, int width, int height, GrColorType,
                        const GrMipLevel texels[], int mipLevelCount) override;
 
@@ -239,9 +259,22 @@ private:
     // PIXEL_UNPACK_BUFFER is unbound.
     void unbindCpuToGpuXferBuffer();
 
+    // Likewise ReadPixels writes into a bound pack buffer instead of client memory, and mapping a
+    // kXferGpuToCpu buffer leaves it bound.
+    void unbindGpuToCpuXferBuffer();
+
     void onResolveRenderTarget(GrRenderTarget* target) override;
 
     bool onRegenerateMipMapLevels(GrTexture*) override;
+    void onBatchRegenerateMipMapLevels(GrTexture* const textures[], int count,
+                                       bool regenerated[]) override;
+
+    // Helpers for mip level regeneration. Manual mipmapping draws each level from the one above
+    // it, after setupManualMipMapping() has bound the temp FBO and set the fixed function state.
+    bool canManuallyMipMap(const GrGLTexture*) const;
+    void generateMipmap(GrGLTexture*);
+    bool setupManualMipMapping();
+    bool drawMipMapLevels(GrGLTexture*);
 
     bool onCopySurface(GrSurface* dst, GrSurfaceOrigin dstOrigin,
                        GrSurface* src, GrSurfaceOrigin srcOrigin,
@@ -286,6 +319,12 @@ private:
 
     void onFinishFlush(bool insertedSemaphores) override;
 
+    bool onBeginTraceSpan(const char* name) override;
+    void onEndTraceSpan() override;
+    // Reports the spans whose timestamps the GPU has written, without waiting for the others.
+    void reportTraceSpans();
+    void deleteTraceSpanQueries();
+
     bool copySurfaceAsDraw(GrSurface* dst, GrSurfaceOrigin dstOrigin,
                            GrSurface* src, GrSurfaceOrigin srcOrigin,
                            const SkIRect& srcRect, const SkIPoint& dstPoint);
@@ -308,6 +347,12 @@ private:
                                 const GrPrimitiveProcessor&,
                                 const GrTextureProxy* const primProcProxies[],
                                 const GrPipeline&, bool hasPointSize);
+        // Starts linking the program for a draw that is about to be prepared, if it isn't cached
+        // yet, so that the driver can compile it in parallel until refProgram() needs it.
+        void precompileProgram(GrGLGpu*, GrRenderTarget*, GrSurfaceOrigin,
+                               const GrPrimitiveProcessor&,
+                               const GrTextureProxy* const primProcProxies[],
+                               const GrPipeline&, bool hasPointSize);
 
     private:
         // We may actually have kMaxEntries+1 shaders in the GL context because we create a new
@@ -316,6 +361,10 @@ private:
 
         struct Entry;
 
+        // Looks desc up, first as is and then with the origin key set, which leaves desc set to
+        // the key of the entry found or, if none, to the origin-specific key.
+        std::unique_ptr<Entry>* find(GrProgramDesc* desc, GrSurfaceOrigin);
+
         // binary search for entry matching desc. returns index into fEntries that matches desc or ~
         // of the index of where it should be inserted.
         int search(const GrProgramDesc& desc) const;
@@ -626,9 +675,30 @@ private:
     class SamplerObjectCache;
     std::unique_ptr<SamplerObjectCache> fSamplerObjectCache;
 
+    // Uniform blocks are streamed into this buffer back to back. When it fills up it is orphaned
+    // and the generation bumped, so blocks streamed before then must be streamed again.
+    static constexpr GrGLsizeiptr kUniformRingSize = 256 * 1024;
+    GrGLuint     fUniformRingID = 0;
+    GrGLsizeiptr fUniformRingOffset = 0;
+    uint32_t     fUniformRingGeneration = 1;
+    // The range last bound to uniform buffer binding 0, or a size of 0 if unknown.
+    GrGLintptr   fHWUniformBlockOffset = 0;
+    GrGLsizeiptr fHWUniformBlockSize = 0;
+
     std::unique_ptr<GrGLGpuRTCommandBuffer>      fCachedRTCommandBuffer;
     std::unique_ptr<GrGLGpuTextureCommandBuffer> fCachedTexCommandBuffer;
 
+    struct TraceSpan {
+        const char* fName;
+        GrGLuint    fBeginQuery;
+        GrGLuint    fEndQuery;
+    };
+    // If nothing reads the results, stop timing spans rather than pile up queries.
+    static constexpr int kMaxPendingTraceSpans = 1024;
+    SkTArray<TraceSpan, true> fOpenTraceSpans;
+    // Spans that have ended, in the order they ended, waiting for their results.
+    SkTArray<TraceSpan, true> fPendingTraceSpans;
+
     friend class GrGLPathRendering; // For accessing setTextureUnit.
 
     typedef GrGpu INHERITED;
@@ -24,8 +24,19 @@ typedef GrGLSLProgramDataManager::UniformHandle UniformHandle;
 
 struct GrGLGpu::ProgramCache::Entry {
     Entry(sk_sp<GrGLProgram> program) : fProgram(std::move(program)) {}
+    Entry(const GrProgramDesc& desc) { fPendingDesc = desc; }
+    ~Entry() {
+        if (fPendingBuilder) {
+            fPendingBuilder->cancel();
+        }
+    }
 
     sk_sp<GrGLProgram> fProgram;
+
+    // A program precompileProgram() started linking that no draw has used yet. The builder points
+    // at fPendingDesc.
+    GrProgramDesc fPendingDesc;
+    std::unique_ptr<GrGLProgramBuilder> fPendingBuilder;
 };
 
 GrGLGpu::ProgramCache::ProgramCache(GrGLGpu* gpu)
@@ -63,7 +74,11 @@ void GrGLGpu::ProgramCache::abandon() {
 #endif
 
     fMap.foreach([](std::unique_ptr<Entry>* e) {
-        (*e)->fProgram->abandon();
+        if ((*e)->fProgram) {
+            (*e)->fProgram->abandon();
+        }
+        // The GL objects went with the context.
+        (*e)->fPendingBuilder.reset();
     });
     fMap.reset();
 }
@@ -85,17 +100,30 @@ GrGLProgram* GrGLGpu::ProgramCache::refProgram(GrGLGpu* gpu,
         GrCapsDebugf(gpu->caps(), "Failed to gl program descriptor!\n");
         return nullptr;
     }
-    std::unique_ptr<Entry>* entry = fMap.find(desc);
-    if (!entry) {
-        // Didn't find an origin-independent version, check with the specific origin
-        desc.setSurfaceOriginKey(GrGLSLFragmentShaderBuilder::KeyForSurfaceOrigin(origin));
-        entry = fMap.find(desc);
-    }
-    if (!entry) {
+    std::unique_ptr<Entry>* entry = this->find(&desc, origin);
+    if (entry && (*entry)->fPendingBuilder) {
+        // The program was started when the draw was prepared. Finishing it only waits on the
+        // driver if the compile hasn't caught up yet.
+#ifdef PROGRAM_CACHE_STATS
+        ++fCacheMisses;
+#endif
+        ++fGpu->frameStats()->fShaderCacheMisses;
+        if (!(*entry)->fPendingBuilder->isLinkComplete()) {
+            ++fGpu->frameStats()->fCompileStalls;
+        }
+        GrGLProgram* program = (*entry)->fPendingBuilder->finishProgram();
+        (*entry)->fPendingBuilder.reset();
+        if (nullptr == program) {
+            fMap.remove(desc);
+            return nullptr;
+        }
+        (*entry)->fProgram.reset(program);
+    } else if (!entry) {
         // We have a cache miss
 #ifdef PROGRAM_CACHE_STATS
         ++fCacheMisses;
 #endif
+        ++fGpu->frameStats()->fShaderCacheMisses;
         GrGLProgram* program = GrGLProgramBuilder::CreateProgram(renderTarget, origin,
                                                                  primProc, primProcProxies,
                                                                  pipeline, &desc, fGpu);
@@ -103,7 +131,50 @@ GrGLProgram* GrGLGpu::ProgramCache::refProgram(GrGLGpu* gpu,
             return nullptr;
         }
         entry = fMap.insert(desc, std::unique_ptr<Entry>(new Entry(sk_sp<GrGLProgram>(program))));
+    } else {
+        ++fGpu->frameStats()->fShaderCacheHits;
     }
 
     return SkRef((*entry)->fProgram.get());
 }
+
+void GrGLGpu::ProgramCache::precompileProgram(GrGLGpu* gpu,
+                                              GrRenderTarget* renderTarget,
+                                              GrSurfaceOrigin origin,
+                                              const GrPrimitiveProcessor& primProc,
+                                              const GrTextureProxy* const primProcProxies[],
+                                              const GrPipeline& pipeline,
+                                              bool isPoints) {
+    SkASSERT(gpu->glCaps().parallelShaderCompileSupport());
+
+    GrProgramDesc desc;
+    if (!GrProgramDesc::Build(&desc, renderTarget->config(), primProc, isPoints, pipeline, gpu)) {
+        return;
+    }
+    if (this->find(&desc, origin)) {
+        return;
+    }
+    // The builder may move the desc to its origin-independent key, so it gets its own copy and
+    // the entry is keyed by wherever that ends up.
+    std::unique_ptr<Entry> entry(new Entry(desc));
+    entry->fPendingBuilder = GrGLProgramBuilder::StartProgram(renderTarget, origin, primProc,
+                                                              primProcProxies, pipeline,
+                                                              &entry->fPendingDesc, fGpu);
+    if (!entry->fPendingBuilder) {
+        return;
+    }
+    GrProgramDesc key;
+    key = entry->fPendingDesc;
+    fMap.insert(key, std::move(entry));
+}
+
+std::unique_ptr<GrGLGpu::ProgramCache::Entry>* GrGLGpu::ProgramCache::find(GrProgramDesc* desc,
+                                                                           GrSurfaceOrigin origin) {
+    std::unique_ptr<Entry>* entry = fMap.find(*desc);
+    if (!entry) {
+        // Didn't find an origin-independent version, check with the specific origin
+        desc->setSurfaceOriginKey(GrGLSLFragmentShaderBuilder::KeyForSurfaceOrigin(origin));
+        entry = fMap.find(*desc);
+    }
+    return entry;
+}
@@ -440,6 +440,14 @@ bool GrGLInterface::validate() const {
         }
     }
 
+    if ((kGL_GrGLStandard == fStandard &&
+         (glVer >= GR_GL_VER(4,4) || fExtensions.has("GL_ARB_buffer_storage"))) ||
+        (kGLES_GrGLStandard == fStandard && fExtensions.has("GL_EXT_buffer_storage"))) {
+        if (!fFunctions.fBufferStorage) {
+            RETURN_FALSE_INTERFACE;
+        }
+    }
+
     if ((kGL_GrGLStandard == fStandard &&
          (glVer >= GR_GL_VER(3,2) || fExtensions.has("GL_ARB_texture_multisample"))) ||
         (kGLES_GrGLStandard == fStandard && glVer >= GR_GL_VER(3,1))) {
@@ -628,6 +636,16 @@ bool GrGLInterface::validate() const {
         }
     }
 
+    if ((kGL_GrGLStandard == fStandard &&
+         (glVer >= GR_GL_VER(3,1) || fExtensions.has("GL_ARB_uniform_buffer_object"))) ||
+        (kGLES_GrGLStandard == fStandard && glVer >= GR_GL_VER(3,0))) {
+        if (!fFunctions.fBindBufferRange ||
+            !fFunctions.fGetUniformBlockIndex ||
+            !fFunctions.fUniformBlockBinding) {
+            RETURN_FALSE_INTERFACE;
+        }
+    }
+
     if ((kGL_GrGLStandard == fStandard && glVer >= GR_GL_VER(4,1)) ||
         (kGLES_GrGLStandard == fStandard && glVer >= GR_GL_VER(3,0))) {
         if (!fFunctions.fGetProgramBinary ||
@@ -30,6 +30,7 @@ GrGLProgram::GrGLProgram(
         const GrGLSLBuiltinUniformHandles& builtinUniforms,
         GrGLuint programID,
         const UniformInfoArray& uniforms,
+        uint32_t uniformBlockSize,
         const UniformInfoArray& textureSamplers,
         const VaryingInfoArray& pathProcVaryings,
         std::unique_ptr<GrGLSLPrimitiveProcessor> geometryProcessor,
@@ -53,11 +54,12 @@ GrGLProgram::GrGLProgram(
         , fVertexStride(vertexStride)
         , fInstanceStride(instanceStride)
         , fGpu(gpu)
-        , fProgramDataManager(gpu, programID, uniforms, pathProcVaryings)
+        , fProgramDataManager(gpu, programID, uniforms, uniformBlockSize, pathProcVaryings)
         , fNumTextureSamplers(textureSamplers.count()) {
     // Assign texture units to sampler uniforms one time up front.
     GL_CALL(UseProgram(fProgramID));
     fProgramDataManager.setSamplerUniforms(textureSamplers, 0);
+    fProgramDataManager.setUniformBlockBinding();
 }
 
 GrGLProgram::~GrGLProgram() {
@@ -104,6 +106,7 @@ void GrGLProgram::updateUniformsAndTextureBindings(const GrRenderTarget* renderT
                           static_cast<GrGLTexture*>(dstTexture));
     }
     SkASSERT(nextTexSamplerIdx == fNumTextureSamplers);
+    fProgramDataManager.uploadUniformBlock();
 }
 
 void GrGLProgram::updatePrimitiveProcessorTextureBindings(const GrPrimitiveProcessor& primProc,
@@ -51,6 +51,7 @@ public:
                 const GrGLSLBuiltinUniformHandles&,
                 GrGLuint programID,
                 const UniformInfoArray& uniforms,
+                uint32_t uniformBlockSize,
                 const UniformInfoArray& textureSamplers,
                 const VaryingInfoArray&, // used for NVPR only currently
                 std::unique_ptr<GrGLSLPrimitiveProcessor> geometryProcessor,
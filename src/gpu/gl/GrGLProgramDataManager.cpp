@@ -8,19 +8,49 @@
 #include "SkMatrix.h"
 #include "gl/GrGLProgramDataManager.h"
 #include "gl/GrGLGpu.h"
+#include "gl/GrGLUniformHandler.h"
 #include "glsl/GrGLSLUniformHandler.h"
 
 #define ASSERT_ARRAY_UPLOAD_IN_BOUNDS(UNI, COUNT) \
          SkASSERT((COUNT) <= (UNI).fArrayCount || \
                   (1 == (COUNT) && GrShaderVar::kNonArray == (UNI).fArrayCount))
 
+// The number of 32 bit values one element of a uniform of the given type is uploaded as.
+static int uniform_value_count(GrSLType type) {
+    switch (type) {
+        case kFloat2x2_GrSLType:
+        case kHalf2x2_GrSLType:
+            return 4;
+        case kFloat3x3_GrSLType:
+        case kHalf3x3_GrSLType:
+            return 9;
+        case kFloat4x4_GrSLType:
+        case kHalf4x4_GrSLType:
+            return 16;
+        default:
+            // Samplers are only set by setSamplerUniforms().
+            return SkTMax(GrSLTypeVecLength(type), 0);
+    }
+}
+
 GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu, GrGLuint programID,
                                                const UniformInfoArray& uniforms,
+                                               uint32_t uniformBlockSize,
                                                const VaryingInfoArray& pathProcVaryings)
-    : fGpu(gpu)
+    : fUniformBlock(uniformBlockSize)
+    , fUniformBlockSize(uniformBlockSize)
+    , fUniformBlockDirty(true)
+    , fUniformBlockGeneration(0)
+    , fUniformBlockOffset(0)
+    , fGpu(gpu)
     , fProgramID(programID) {
+    if (fUniformBlockSize) {
+        sk_bzero(fUniformBlock.get(), fUniformBlockSize);
+    }
     int count = uniforms.count();
     fUniforms.push_back_n(count);
+    fUploadedValueCounts.push_back_n(count, 0);
+    int shadowValueCount = 0;
     for (int i = 0; i < count; i++) {
         Uniform& uniform = fUniforms[i];
         const UniformInfo& builderUniform = uniforms[i];
@@ -31,7 +61,13 @@ GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu, GrGLuint programID,
             uniform.fType = builderUniform.fVariable.getType();
         )
         uniform.fLocation = builderUniform.fLocation;
+        uniform.fBlockOffset = builderUniform.fBlockOffset;
+        SkASSERT(uniform.fBlockOffset < 0 || fUniformBlockSize);
+        uniform.fShadowOffset = shadowValueCount;
+        shadowValueCount += uniform_value_count(builderUniform.fVariable.getType()) *
+                            SkTMax(builderUniform.fVariable.getArrayCount(), 1);
     }
+    fShadowValues.push_back_n(shadowValueCount);
 
     // NVPR programs have separable varyings
     count = pathProcVaryings.count();
@@ -61,11 +97,67 @@ void GrGLProgramDataManager::setSamplerUniforms(const UniformInfoArray& samplers
     }
 }
 
+void GrGLProgramDataManager::setUniformBlockBinding() const {
+    if (!fUniformBlockSize) {
+        return;
+    }
+    GrGLuint blockIndex;
+    GR_GL_CALL_RET(fGpu->glInterface(), blockIndex,
+                   GetUniformBlockIndex(fProgramID, GrGLUniformHandler::kUniformBlockName));
+    if (GR_GL_INVALID_INDEX != blockIndex) {
+        GR_GL_CALL(fGpu->glInterface(), UniformBlockBinding(fProgramID, blockIndex, 0));
+    }
+}
+
+void GrGLProgramDataManager::uploadUniformBlock() const {
+    if (fUniformBlockSize) {
+        fGpu->bindUniformBlock(fUniformBlock.get(), fUniformBlockSize, fUniformBlockDirty,
+                               &fUniformBlockGeneration, &fUniformBlockOffset);
+        fUniformBlockDirty = false;
+    }
+}
+
+void GrGLProgramDataManager::setBlockValues(const Uniform& uni, int vectorCount, int vectorLength,
+                                            const void* values) const {
+    SkASSERT(uni.fBlockOffset >= 0);
+    size_t vectorSize = vectorLength * sizeof(uint32_t);
+    // Lone vectors are packed tightly; array elements and matrix columns are 16 bytes apart.
+    size_t stride = 1 == vectorCount ? vectorSize : 16;
+    SkASSERT(uni.fBlockOffset + (vectorCount - 1) * stride + vectorSize <= fUniformBlockSize);
+    uint8_t* dst = fUniformBlock.get() + uni.fBlockOffset;
+    const uint8_t* src = static_cast<const uint8_t*>(values);
+    for (int i = 0; i < vectorCount; ++i, dst += stride, src += vectorSize) {
+        if (memcmp(dst, src, vectorSize)) {
+            memcpy(dst, src, vectorSize);
+            fUniformBlockDirty = true;
+        }
+    }
+}
+
+bool GrGLProgramDataManager::needsUpload(UniformHandle u, int count, const void* values) const {
+    GR_STATIC_ASSERT(sizeof(float) == sizeof(uint32_t) && sizeof(int32_t) == sizeof(uint32_t));
+    int index = u.toIndex();
+    uint32_t* shadow = fShadowValues.begin() + fUniforms[index].fShadowOffset;
+    size_t size = count * sizeof(uint32_t);
+    SkASSERT(shadow + count <= fShadowValues.end());
+    if (count <= fUploadedValueCounts[index] && !memcmp(shadow, values, size)) {
+        fGpu->stats()->incSkippedStateChanges();
+        return false;
+    }
+    memcpy(shadow, values, size);
+    fUploadedValueCounts[index] = SkTMax(fUploadedValueCounts[index], count);
+    return true;
+}
+
 void GrGLProgramDataManager::set1i(UniformHandle u, int32_t i) const {
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kInt_GrSLType || uni.fType == kShort_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, 1, 1, &i);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, 1, &i)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1i(uni.fLocation, i));
     }
 }
@@ -77,7 +169,11 @@ void GrGLProgramDataManager::set1iv(UniformHandle u,
     SkASSERT(uni.fType == kInt_GrSLType || uni.fType == kShort_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, arrayCount, 1, v);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -86,7 +182,11 @@ void GrGLProgramDataManager::set1f(UniformHandle u, float v0) const {
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kFloat_GrSLType || uni.fType == kHalf_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, 1, 1, &v0);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, 1, &v0)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1f(uni.fLocation, v0));
     }
 }
@@ -102,7 +202,11 @@ void GrGLProgramDataManager::set1fv(UniformHandle u,
     // Once the uniform manager is responsible for inserting the duplicate uniform
     // arrays in VS and FS driver bug workaround, this can be enabled.
     // this->printUni(uni);
-    if (kUnusedUniform != uni.fLocation) {
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, arrayCount, 1, v);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -111,7 +215,12 @@ void GrGLProgramDataManager::set2i(UniformHandle u, int32_t i0, int32_t i1) cons
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kInt2_GrSLType || uni.fType == kShort2_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t v[] = {i0, i1};
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, 1, 2, v);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, 2, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2i(uni.fLocation, i0, i1));
     }
 }
@@ -123,7 +232,11 @@ void GrGLProgramDataManager::set2iv(UniformHandle u,
     SkASSERT(uni.fType == kInt2_GrSLType || uni.fType == kShort2_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, arrayCount, 2, v);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, 2 * arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -132,7 +245,12 @@ void GrGLProgramDataManager::set2f(UniformHandle u, float v0, float v1) const {
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kFloat2_GrSLType || uni.fType == kHalf2_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float v[] = {v0, v1};
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, 1, 2, v);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, 2, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2f(uni.fLocation, v0, v1));
     }
 }
@@ -144,7 +262,11 @@ void GrGLProgramDataManager::set2fv(UniformHandle u,
     SkASSERT(uni.fType == kFloat2_GrSLType || uni.fType == kHalf2_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, arrayCount, 2, v);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, 2 * arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -153,7 +275,12 @@ void GrGLProgramDataManager::set3i(UniformHandle u, int32_t i0, int32_t i1, int3
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kInt3_GrSLType || uni.fType == kShort3_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t v[] = {i0, i1, i2};
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, 1, 3, v);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, 3, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3i(uni.fLocation, i0, i1, i2));
     }
 }
@@ -165,7 +292,11 @@ void GrGLProgramDataManager::set3iv(UniformHandle u,
     SkASSERT(uni.fType == kInt3_GrSLType || uni.fType == kShort3_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, arrayCount, 3, v);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, 3 * arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -174,7 +305,12 @@ void GrGLProgramDataManager::set3f(UniformHandle u, float v0, float v1, float v2
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kFloat3_GrSLType || uni.fType == kHalf3_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float v[] = {v0, v1, v2};
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, 1, 3, v);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, 3, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3f(uni.fLocation, v0, v1, v2));
     }
 }
@@ -186,7 +322,11 @@ void GrGLProgramDataManager::set3fv(UniformHandle u,
     SkASSERT(uni.fType == kFloat3_GrSLType || uni.fType == kHalf3_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, arrayCount, 3, v);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, 3 * arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -199,7 +339,12 @@ void GrGLProgramDataManager::set4i(UniformHandle u,
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kInt4_GrSLType || uni.fType == kShort4_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t v[] = {i0, i1, i2, i3};
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, 1, 4, v);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, 4, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4i(uni.fLocation, i0, i1, i2, i3));
     }
 }
@@ -211,7 +356,11 @@ void GrGLProgramDataManager::set4iv(UniformHandle u,
     SkASSERT(uni.fType == kInt4_GrSLType || uni.fType == kShort4_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, arrayCount, 4, v);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, 4 * arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -224,7 +373,12 @@ void GrGLProgramDataManager::set4f(UniformHandle u,
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kFloat4_GrSLType || uni.fType == kHalf4_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float v[] = {v0, v1, v2, v3};
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, 1, 4, v);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, 4, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4f(uni.fLocation, v0, v1, v2, v3));
     }
 }
@@ -236,7 +390,11 @@ void GrGLProgramDataManager::set4fv(UniformHandle u,
     SkASSERT(uni.fType == kFloat4_GrSLType || uni.fType == kHalf4_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, arrayCount, 4, v);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, 4 * arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -275,7 +433,11 @@ template<int N> inline void GrGLProgramDataManager::setMatrices(UniformHandle u,
              uni.fType == kHalf2x2_GrSLType + (N - 2));
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (uni.fBlockOffset >= 0) {
+        this->setBlockValues(uni, arrayCount * N, N, matrices);
+        return;
+    }
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(u, arrayCount * N * N, matrices)) {
         set_uniform_matrix<N>::set(fGpu->glInterface(), uni.fLocation, arrayCount, matrices);
     }
 }
@@ -14,6 +14,7 @@
 #include "glsl/GrGLSLProgramDataManager.h"
 
 #include "SkTArray.h"
+#include "SkTemplates.h"
 
 class GrGLGpu;
 class SkMatrix;
@@ -29,6 +30,9 @@ public:
         GrShaderVar fVariable;
         uint32_t        fVisibility;
         GrGLint         fLocation;
+        // Byte offset of the uniform in the program's std140 uniform block, or -1 if it is a plain
+        // program uniform.
+        int             fBlockOffset;
     };
 
     struct VaryingInfo {
@@ -43,10 +47,17 @@ public:
     typedef GrTAllocator<VaryingInfo> VaryingInfoArray;
 
     GrGLProgramDataManager(GrGLGpu*, GrGLuint programID, const UniformInfoArray&,
-                           const VaryingInfoArray&);
+                           uint32_t uniformBlockSize, const VaryingInfoArray&);
 
     void setSamplerUniforms(const UniformInfoArray& samplers, int startUnit) const;
 
+    // Points the program's uniform block, if it has one, at uniform buffer binding 0.
+    void setUniformBlockBinding() const;
+
+    // Binds the uniform block's current values for the next draw, streaming them into the GPU's
+    // uniform ring buffer first if they changed since it was last bound.
+    void uploadUniformBlock() const;
+
     /** Functions for uploading uniform values. The varities ending in v can be used to upload to an
     *  array of uniforms. arrayCount must be <= the array count of the uniform.
     */
@@ -86,6 +97,8 @@ private:
 
     struct Uniform {
         GrGLint     fLocation;
+        int         fShadowOffset;
+        int         fBlockOffset;
 #ifdef SK_DEBUG
         GrSLType    fType;
         int         fArrayCount;
@@ -106,8 +119,28 @@ private:
     template<int N> inline void setMatrices(UniformHandle, int arrayCount,
                                             const float matrices[]) const;
 
+    // Returns false if the uniform already holds the first count 32 bit values at values.
+    // Otherwise records them as its new value, and returns true so that the caller uploads them.
+    bool needsUpload(UniformHandle, int count, const void* values) const;
+
+    // Copies vectorCount vectors of vectorLength 32 bit values into the uniform's place in the
+    // std140 block, where each vector of an array or matrix starts 16 bytes after the previous.
+    void setBlockValues(const Uniform&, int vectorCount, int vectorLength,
+                        const void* values) const;
+
     SkTArray<Uniform, true> fUniforms;
+    // GL keeps uniform values in the program object, so they remain set across draws and flushes.
+    // fShadowValues holds the values last uploaded to each uniform, starting at its fShadowOffset,
+    // and fUploadedValueCounts how many of them have been uploaded.
+    mutable SkTArray<uint32_t, true> fShadowValues;
+    mutable SkTArray<int, true> fUploadedValueCounts;
     SkTArray<PathProcVarying, true> fPathProcVaryings;
+    // CPU copy of the std140 uniform block, and where the GPU's uniform ring last received it.
+    mutable SkAutoTMalloc<uint8_t> fUniformBlock;
+    uint32_t fUniformBlockSize;
+    mutable bool fUniformBlockDirty;
+    mutable uint32_t fUniformBlockGeneration;
+    mutable GrGLintptr fUniformBlockOffset;
     GrGLGpu* fGpu;
     GrGLuint fProgramID;
 
@@ -21,6 +21,7 @@ GrGLTestInterface::GrGLTestInterface() {
     fFunctions.fBeginQuery = bind_to_member(this, &GrGLTestInterface::beginQuery);
     fFunctions.fBindAttribLocation = bind_to_member(this, &GrGLTestInterface::bindAttribLocation);
     fFunctions.fBindBuffer = bind_to_member(this, &GrGLTestInterface::bindBuffer);
+    fFunctions.fBindBufferRange = bind_to_member(this, &GrGLTestInterface::bindBufferRange);
     fFunctions.fBindFramebuffer = bind_to_member(this, &GrGLTestInterface::bindFramebuffer);
     fFunctions.fBindRenderbuffer = bind_to_member(this, &GrGLTestInterface::bindRenderbuffer);
     fFunctions.fBindSampler = bind_to_member(this, &GrGLTestInterface::bindSampler);
@@ -90,6 +91,7 @@ GrGLTestInterface::GrGLTestInterface() {
     fFunctions.fGetError = bind_to_member(this, &GrGLTestInterface::getError);
     fFunctions.fGetFramebufferAttachmentParameteriv = bind_to_member(this, &GrGLTestInterface::getFramebufferAttachmentParameteriv);
     fFunctions.fGetIntegerv = bind_to_member(this, &GrGLTestInterface::getIntegerv);
+    fFunctions.fGetInteger64v = bind_to_member(this, &GrGLTestInterface::getInteger64v);
     fFunctions.fGetMultisamplefv = bind_to_member(this, &GrGLTestInterface::getMultisamplefv);
     fFunctions.fGetProgramInfoLog = bind_to_member(this, &GrGLTestInterface::getProgramInfoLog);
     fFunctions.fGetProgramiv = bind_to_member(this, &GrGLTestInterface::getProgramiv);
@@ -105,6 +107,7 @@ GrGLTestInterface::GrGLTestInterface() {
     fFunctions.fGetString = bind_to_member(this, &GrGLTestInterface::getString);
     fFunctions.fGetStringi = bind_to_member(this, &GrGLTestInterface::getStringi);
     fFunctions.fGetTexLevelParameteriv = bind_to_member(this, &GrGLTestInterface::getTexLevelParameteriv);
+    fFunctions.fGetUniformBlockIndex = bind_to_member(this, &GrGLTestInterface::getUniformBlockIndex);
     fFunctions.fGetUniformLocation = bind_to_member(this, &GrGLTestInterface::getUniformLocation);
     fFunctions.fInsertEventMarker = bind_to_member(this, &GrGLTestInterface::insertEventMarker);
     fFunctions.fInvalidateBufferData = bind_to_member(this, &GrGLTestInterface::invalidateBufferData);
@@ -168,6 +171,7 @@ GrGLTestInterface::GrGLTestInterface() {
     fFunctions.fUniform4i = bind_to_member(this, &GrGLTestInterface::uniform4i);
     fFunctions.fUniform4fv = bind_to_member(this, &GrGLTestInterface::uniform4fv);
     fFunctions.fUniform4iv = bind_to_member(this, &GrGLTestInterface::uniform4iv);
+    fFunctions.fUniformBlockBinding = bind_to_member(this, &GrGLTestInterface::uniformBlockBinding);
     fFunctions.fUniformMatrix2fv = bind_to_member(this, &GrGLTestInterface::uniformMatrix2fv);
     fFunctions.fUniformMatrix3fv = bind_to_member(this, &GrGLTestInterface::uniformMatrix3fv);
     fFunctions.fUniformMatrix4fv = bind_to_member(this, &GrGLTestInterface::uniformMatrix4fv);
@@ -22,6 +22,7 @@ public:
     virtual GrGLvoid beginQuery(GrGLenum target, GrGLuint id) {}
     virtual GrGLvoid bindAttribLocation(GrGLuint program, GrGLuint index, const char* name) {}
     virtual GrGLvoid bindBuffer(GrGLenum target, GrGLuint buffer) {}
+    virtual GrGLvoid bindBufferRange(GrGLenum target, GrGLuint index, GrGLuint buffer, GrGLintptr offset, GrGLsizeiptr size) {}
     virtual GrGLvoid bindFramebuffer(GrGLenum target, GrGLuint framebuffer) {}
     virtual GrGLvoid bindRenderbuffer(GrGLenum target, GrGLuint renderbuffer) {}
     virtual GrGLvoid bindSampler(GrGLuint unit, GrGLuint sampler) {}
@@ -91,6 +92,7 @@ public:
     virtual GrGLenum getError() { return GR_GL_NO_ERROR; }
     virtual GrGLvoid getFramebufferAttachmentParameteriv(GrGLenum target, GrGLenum attachment, GrGLenum pname, GrGLint* params) {}
     virtual GrGLvoid getIntegerv(GrGLenum pname, GrGLint* params) {}
+    virtual GrGLvoid getInteger64v(GrGLenum pname, GrGLint64* params) {}
     virtual GrGLvoid getMultisamplefv(GrGLenum pname, GrGLuint index, GrGLfloat* val) {}
     virtual GrGLvoid getProgramInfoLog(GrGLuint program, GrGLsizei bufsize, GrGLsizei* length, char* infolog) {}
     virtual GrGLvoid getProgramiv(GrGLuint program, GrGLenum pname, GrGLint* params) {}
@@ -106,6 +108,7 @@ public:
     virtual const GrGLubyte*  getString(GrGLenum name) { return nullptr; }
     virtual const GrGLubyte* getStringi(GrGLenum name, GrGLuint index) { return nullptr; }
     virtual GrGLvoid getTexLevelParameteriv(GrGLenum target, GrGLint level, GrGLenum pname, GrGLint* params) {}
+    virtual GrGLuint getUniformBlockIndex(GrGLuint program, const GrGLchar* uniformBlockName) { return 0; }
     virtual GrGLint getUniformLocation(GrGLuint program, const char* name) { return 0; }
     virtual GrGLvoid insertEventMarker(GrGLsizei length, const char* marker) {}
     virtual GrGLvoid invalidateBufferData(GrGLuint buffer) {}
@@ -169,6 +172,7 @@ public:
     virtual GrGLvoid uniform4i(GrGLint location, GrGLint v0, GrGLint v1, GrGLint v2, GrGLint v3) {}
     virtual GrGLvoid uniform4fv(GrGLint location, GrGLsizei count, const GrGLfloat* v) {}
     virtual GrGLvoid uniform4iv(GrGLint location, GrGLsizei count, const GrGLint* v) {}
+    virtual GrGLvoid uniformBlockBinding(GrGLuint program, GrGLuint uniformBlockIndex, GrGLuint uniformBlockBinding) {}
     virtual GrGLvoid uniformMatrix2fv(GrGLint location, GrGLsizei count, GrGLboolean transpose, const GrGLfloat* value) {}
     virtual GrGLvoid uniformMatrix3fv(GrGLint location, GrGLsizei count, GrGLboolean transpose, const GrGLfloat* value) {}
     virtual GrGLvoid uniformMatrix4fv(GrGLint location, GrGLsizei count, GrGLboolean transpose, const GrGLfloat* value) {}
@@ -55,6 +55,7 @@ GrGLSLUniformHandler::UniformHandle GrGLUniformHandler::internalAddUniformArray(
     uni.fVisibility = visibility;
     uni.fVariable.setPrecision(precision);
     uni.fLocation = -1;
+    uni.fBlockOffset = -1;
 
     if (outName) {
         *outName = uni.fVariable.c_str();
@@ -82,15 +83,97 @@ GrGLSLUniformHandler::SamplerHandle GrGLUniformHandler::addSampler(const GrTextu
     sampler.fVariable.setPrecision(precision);
     sampler.fVariable.setName(mangleName);
     sampler.fLocation = -1;
+    sampler.fBlockOffset = -1;
     sampler.fVisibility = kFragment_GrShaderFlag;
     fSamplerSwizzles.push_back(swizzle);
     SkASSERT(fSamplers.count() == fSamplerSwizzles.count());
     return GrGLSLUniformHandler::SamplerHandle(fSamplers.count() - 1);
 }
 
+// Returns the number of columns of a matrix type, or 0 for any other type.
+static int matrix_column_count(GrSLType type) {
+    switch (type) {
+        case kFloat2x2_GrSLType:
+        case kHalf2x2_GrSLType:
+            return 2;
+        case kFloat3x3_GrSLType:
+        case kHalf3x3_GrSLType:
+            return 3;
+        case kFloat4x4_GrSLType:
+        case kHalf4x4_GrSLType:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+// Returns the std140 base alignment of a uniform. Arrays and matrices are aligned to, and place
+// each element or column, 16 bytes apart. GLSL has no small integer types, so byte and short
+// uniforms are declared as, and take the room of, 32 bit ints.
+static uint32_t std140_alignment(GrSLType type, int arrayCount) {
+    if (GrShaderVar::kNonArray != arrayCount || matrix_column_count(type)) {
+        return 16;
+    }
+    switch (GrSLTypeVecLength(type)) {
+        case 1:
+            return 4;
+        case 2:
+            return 8;
+        default:
+            return 16;
+    }
+}
+
+// Returns the number of bytes a uniform takes up in a std140 block.
+static uint32_t std140_size(GrSLType type, int arrayCount) {
+    int columns = matrix_column_count(type);
+    if (GrShaderVar::kNonArray == arrayCount && !columns) {
+        return 4 * GrSLTypeVecLength(type);
+    }
+    return 16 * SkTMax(columns, 1) * SkTMax(arrayCount, 1);
+}
+
+void GrGLUniformHandler::assignUniformBlockOffsets(const GrGLCaps& caps) {
+    SkASSERT(!fUniformBlockSize);
+    if (!caps.uniformBufferSupport()) {
+        return;
+    }
+    uint32_t offset = 0;
+    for (int i = 0; i < fUniforms.count(); ++i) {
+        UniformInfo& uni = fUniforms[i];
+        GrSLType type = uni.fVariable.getType();
+        int arrayCount = uni.fVariable.getArrayCount();
+        SkASSERT(!GrSLTypeIsCombinedSamplerType(type));
+        uint32_t alignment = std140_alignment(type, arrayCount);
+        offset = (offset + alignment - 1) & ~(alignment - 1);
+        uni.fBlockOffset = offset;
+        offset += std140_size(type, arrayCount);
+    }
+    if (!offset || offset > (uint32_t)caps.maxUniformBlockSize()) {
+        for (int i = 0; i < fUniforms.count(); ++i) {
+            fUniforms[i].fBlockOffset = -1;
+        }
+        return;
+    }
+    fUniformBlockSize = offset;
+}
+
 void GrGLUniformHandler::appendUniformDecls(GrShaderFlags visibility, SkString* out) const {
+    // Every stage declares the whole block, since its definition must match across stages.
+    if (fUniformBlockSize) {
+        out->appendf("layout (std140) uniform %s\n{\n", kUniformBlockName);
+        for (int i = 0; i < fUniforms.count(); ++i) {
+            if (fUniforms[i].fBlockOffset >= 0) {
+                GrShaderVar member = fUniforms[i].fVariable;
+                member.setTypeModifier(GrShaderVar::kNone_TypeModifier);
+                member.appendDecl(fProgramBuilder->shaderCaps(), out);
+                out->append(";\n");
+            }
+        }
+        out->append("};\n");
+    }
     for (int i = 0; i < fUniforms.count(); ++i) {
-        if (fUniforms[i].fVisibility & visibility) {
+        if (fUniforms[i].fBlockOffset < 0 && (fUniforms[i].fVisibility & visibility)) {
             fUniforms[i].fVariable.appendDecl(fProgramBuilder->shaderCaps(), out);
             out->append(";");
         }
@@ -106,9 +189,12 @@ void GrGLUniformHandler::appendUniformDecls(GrShaderFlags visibility, SkString*
 void GrGLUniformHandler::bindUniformLocations(GrGLuint programID, const GrGLCaps& caps) {
     if (caps.bindUniformLocationSupport()) {
         int currUniform = 0;
-        for (int i = 0; i < fUniforms.count(); ++i, ++currUniform) {
+        for (int i = 0; i < fUniforms.count(); ++i) {
+            if (fUniforms[i].fBlockOffset >= 0) {
+                continue;
+            }
             GL_CALL(BindUniformLocation(programID, currUniform, fUniforms[i].fVariable.c_str()));
-            fUniforms[i].fLocation = currUniform;
+            fUniforms[i].fLocation = currUniform++;
         }
         for (int i = 0; i < fSamplers.count(); ++i, ++currUniform) {
             GL_CALL(BindUniformLocation(programID, currUniform, fSamplers[i].fVariable.c_str()));
@@ -121,6 +207,9 @@ void GrGLUniformHandler::getUniformLocations(GrGLuint programID, const GrGLCaps&
     if (!caps.bindUniformLocationSupport()) {
         int count = fUniforms.count();
         for (int i = 0; i < count; ++i) {
+            if (fUniforms[i].fBlockOffset >= 0) {
+                continue;
+            }
             GrGLint location;
             GL_CALL_RET(location, GetUniformLocation(programID, fUniforms[i].fVariable.c_str()));
             fUniforms[i].fLocation = location;
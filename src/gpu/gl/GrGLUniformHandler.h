@@ -18,6 +18,9 @@ class GrGLUniformHandler : public GrGLSLUniformHandler {
 public:
     static const int kUniformsPerBlock = 8;
 
+    // The name of the std140 block that holds the non-sampler uniforms, when there is one.
+    static constexpr const char* kUniformBlockName = "uniformBuffer";
+
     const GrShaderVar& getUniformVariable(UniformHandle u) const override {
         return fUniforms[u.toIndex()].fVariable;
     }
@@ -29,7 +32,8 @@ private:
     explicit GrGLUniformHandler(GrGLSLProgramBuilder* program)
         : INHERITED(program)
         , fUniforms(kUniformsPerBlock)
-        , fSamplers(kUniformsPerBlock) {}
+        , fSamplers(kUniformsPerBlock)
+        , fUniformBlockSize(0) {}
 
     UniformHandle internalAddUniformArray(uint32_t visibility,
                                           GrSLType type,
@@ -52,6 +56,11 @@ private:
 
     void appendUniformDecls(GrShaderFlags visibility, SkString*) const override;
 
+    // Lays the non-sampler uniforms out in a std140 uniform block when the caps support it and
+    // they fit, recording each one's byte offset and the block's size. Otherwise, and for uniforms
+    // added after this is called, the uniforms stay plain program uniforms.
+    void assignUniformBlockOffsets(const GrGLCaps& caps);
+
     // Manually set uniform locations for all our uniforms.
     void bindUniformLocations(GrGLuint programID, const GrGLCaps& caps);
 
@@ -66,6 +75,7 @@ private:
     UniformInfoArray    fUniforms;
     UniformInfoArray    fSamplers;
     SkTArray<GrSwizzle> fSamplerSwizzles;
+    uint32_t            fUniformBlockSize;
 
     friend class GrGLProgramBuilder;
 
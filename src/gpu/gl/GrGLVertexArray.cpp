@@ -118,6 +118,8 @@ void GrGLAttribArrayState::set(GrGLGpu* gpu,
         array->fGPUType = gpuType;
         array->fStride = stride;
         array->fOffset = offsetInBytes;
+    } else {
+        gpu->stats()->incSkippedStateChanges();
     }
     if (gpu->caps()->instanceAttribSupport() && array->fDivisor != divisor) {
         SkASSERT(0 == divisor || 1 == divisor); // not necessarily a requirement but what we expect.
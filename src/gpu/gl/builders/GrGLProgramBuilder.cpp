@@ -44,19 +44,42 @@ GrGLProgram* GrGLProgramBuilder::CreateProgram(GrRenderTarget* renderTarget, GrS
     // uniforms, varyings, textures, etc
     GrGLProgramBuilder builder(gpu, renderTarget, origin,
                                pipeline, primProc, primProcProxies, desc);
+    if (!builder.start()) {
+        return nullptr;
+    }
+    return builder.finishProgram();
+}
+
+std::unique_ptr<GrGLProgramBuilder> GrGLProgramBuilder::StartProgram(
+        GrRenderTarget* renderTarget, GrSurfaceOrigin origin, const GrPrimitiveProcessor& primProc,
+        const GrTextureProxy* const primProcProxies[], const GrPipeline& pipeline,
+        GrProgramDesc* desc, GrGLGpu* gpu) {
+    SkASSERT(!pipeline.isBad());
 
-    auto persistentCache = gpu->getContext()->contextPriv().getPersistentCache();
+    ATRACE_ANDROID_FRAMEWORK("Shader Compile");
+    GrAutoLocaleSetter als("C");
+
+    std::unique_ptr<GrGLProgramBuilder> builder(new GrGLProgramBuilder(
+            gpu, renderTarget, origin, pipeline, primProc, primProcProxies, desc));
+    if (!builder->start()) {
+        return nullptr;
+    }
+    return builder;
+}
+
+bool GrGLProgramBuilder::start() {
+    auto persistentCache = fGpu->getContext()->contextPriv().getPersistentCache();
     if (persistentCache) {
-        sk_sp<SkData> key = SkData::MakeWithoutCopy(desc->asKey(), desc->keyLength());
-        builder.fCached = persistentCache->load(*key);
+        sk_sp<SkData> key = SkData::MakeWithoutCopy(desc()->asKey(), desc()->keyLength());
+        fCached = persistentCache->load(*key);
         // the eventual end goal is to completely skip emitAndInstallProcs on a cache hit, but it's
         // doing necessary setup in addition to generating the SkSL code. Currently we are only able
         // to skip the SkSL->GLSL step on a cache hit.
     }
-    if (!builder.emitAndInstallProcs()) {
-        return nullptr;
+    if (!this->emitAndInstallProcs()) {
+        return false;
     }
-    return builder.finalize();
+    return this->link();
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -75,7 +98,11 @@ GrGLProgramBuilder::GrGLProgramBuilder(GrGLGpu* gpu,
         , fVertexAttributeCnt(0)
         , fInstanceAttributeCnt(0)
         , fVertexStride(0)
-        , fInstanceStride(0) {}
+        , fInstanceStride(0)
+        , fProgramID(0)
+        , fCheckLinked(false)
+        , fUseGeoShader(false)
+        , fStoreInCache(false) {}
 
 const GrCaps* GrGLProgramBuilder::caps() const {
     return fGpu->caps();
@@ -209,14 +236,14 @@ void GrGLProgramBuilder::storeShaderInCache(const SkSL::Program::Inputs& inputs,
     }
 }
 
-GrGLProgram* GrGLProgramBuilder::finalize() {
+bool GrGLProgramBuilder::link() {
     TRACE_EVENT0("skia", TRACE_FUNC);
 
     // verify we can get a program id
     GrGLuint programID;
     GL_CALL_RET(programID, CreateProgram());
     if (0 == programID) {
-        return nullptr;
+        return false;
     }
 
     if (this->gpu()->glCaps().programBinarySupport() &&
@@ -224,25 +251,26 @@ GrGLProgram* GrGLProgramBuilder::finalize() {
         GL_CALL(ProgramParameteri(programID, GR_GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GR_GL_TRUE));
     }
 
+    fUniformHandler.assignUniformBlockOffsets(this->gpu()->glCaps());
     this->finalizeShaders();
 
     // compile shaders and bind attributes / uniforms
     const GrPrimitiveProcessor& primProc = this->primitiveProcessor();
-    SkSL::Program::Settings settings;
+    SkSL::Program::Settings& settings = fSettings;
     settings.fCaps = this->gpu()->glCaps().shaderCaps();
     settings.fFlipY = this->origin() != kTopLeft_GrSurfaceOrigin;
     settings.fSharpenTextures = this->gpu()->getContext()->contextPriv().sharpenMipmappedTextures();
     settings.fFragColorIsInOut = this->fragColorIsInOut();
 
-    SkSL::Program::Inputs inputs;
-    SkTDArray<GrGLuint> shadersToDelete;
+    SkSL::Program::Inputs& inputs = fInputs;
+    SkTDArray<GrGLuint>& shadersToDelete = fShadersToDelete;
     // Calling GetProgramiv is expensive in Chromium. Assume success in release builds.
     bool checkLinked = kChromium_GrGLDriver != fGpu->ctxInfo().driver();
 #ifdef SK_DEBUG
     checkLinked = true;
 #endif
     bool cached = fCached.get() != nullptr;
-    SkSL::String glsl;
+    SkSL::String& glsl = fGLSL;
     if (cached) {
         const uint8_t* bytes = fCached->bytes();
         size_t offset = 0;
@@ -275,6 +303,7 @@ GrGLProgram* GrGLProgramBuilder::finalize() {
     }
     if (!cached || !fGpu->glCaps().programBinarySupport()) {
         // either a cache miss, or we can't store binaries in the cache
+        ++fGpu->frameStats()->fProgramsCompiled;
         if (glsl == "" || true) {
             // don't have cached GLSL, need to compile SkSL->GLSL
             if (fFS.fForceHighPrecision) {
@@ -289,7 +318,7 @@ GrGLProgram* GrGLProgramBuilder::finalize() {
                                                              &glsl);
             if (!fs) {
                 this->cleanupProgram(programID, shadersToDelete);
-                return nullptr;
+                return false;
             }
             inputs = fs->fInputs;
         } else {
@@ -302,7 +331,7 @@ GrGLProgram* GrGLProgramBuilder::finalize() {
                                            GR_GL_FRAGMENT_SHADER, &shadersToDelete, settings,
                                            inputs)) {
             this->cleanupProgram(programID, shadersToDelete);
-            return nullptr;
+            return false;
         }
 
         std::unique_ptr<SkSL::Program> vs = GrSkSLtoGLSL(gpu()->glContext(),
@@ -316,7 +345,7 @@ GrGLProgram* GrGLProgramBuilder::finalize() {
                                                   GR_GL_VERTEX_SHADER, &shadersToDelete, settings,
                                                   inputs)) {
             this->cleanupProgram(programID, shadersToDelete);
-            return nullptr;
+            return false;
         }
 
         // NVPR actually requires a vertex shader to compile
@@ -338,50 +367,79 @@ GrGLProgram* GrGLProgramBuilder::finalize() {
                                                       GR_GL_GEOMETRY_SHADER, &shadersToDelete,
                                                       settings, inputs)) {
                 this->cleanupProgram(programID, shadersToDelete);
-                return nullptr;
+                return false;
             }
         }
         this->bindProgramResourceLocations(programID);
 
         GL_CALL(LinkProgram(programID));
-        if (checkLinked) {
-            if (!this->checkLinkStatus(programID)) {
-                GL_CALL(DeleteProgram(programID));
-                SkDebugf("VS:\n");
-                GrGLPrintShader(fGpu->glContext(),
-                                GR_GL_VERTEX_SHADER,
-                                fVS.fCompilerStrings.begin(),
-                                fVS.fCompilerStringLengths.begin(),
-                                fVS.fCompilerStrings.count(),
-                                settings);
-                if (primProc.willUseGeoShader()) {
-                    SkDebugf("\nGS:\n");
-                    GrGLPrintShader(fGpu->glContext(),
-                                    GR_GL_GEOMETRY_SHADER,
-                                    fGS.fCompilerStrings.begin(),
-                                    fGS.fCompilerStringLengths.begin(),
-                                    fGS.fCompilerStrings.count(), settings);
-                }
-                SkDebugf("\nFS:\n");
+        fCheckLinked = checkLinked;
+        fUseGeoShader = primProc.willUseGeoShader();
+    }
+    fProgramID = programID;
+    fStoreInCache = !cached;
+    return true;
+}
+
+bool GrGLProgramBuilder::isLinkComplete() const {
+    if (!fGpu->glCaps().parallelShaderCompileSupport()) {
+        return true;
+    }
+    GrGLint complete = GR_GL_INIT_ZERO;
+    GL_CALL(GetProgramiv(fProgramID, GR_GL_COMPLETION_STATUS, &complete));
+    return SkToBool(complete);
+}
+
+GrGLProgram* GrGLProgramBuilder::finishProgram() {
+    TRACE_EVENT0("skia", TRACE_FUNC);
+    SkASSERT(fProgramID);
+
+    GrGLuint programID = fProgramID;
+    fProgramID = 0;
+    if (fCheckLinked) {
+        if (!this->checkLinkStatus(programID)) {
+            GL_CALL(DeleteProgram(programID));
+            SkDebugf("VS:\n");
+            GrGLPrintShader(fGpu->glContext(),
+                            GR_GL_VERTEX_SHADER,
+                            fVS.fCompilerStrings.begin(),
+                            fVS.fCompilerStringLengths.begin(),
+                            fVS.fCompilerStrings.count(),
+                            fSettings);
+            if (fUseGeoShader) {
+                SkDebugf("\nGS:\n");
                 GrGLPrintShader(fGpu->glContext(),
-                                GR_GL_FRAGMENT_SHADER,
-                                fFS.fCompilerStrings.begin(),
-                                fFS.fCompilerStringLengths.begin(),
-                                fFS.fCompilerStrings.count(),
-                                settings);
-                return nullptr;
+                                GR_GL_GEOMETRY_SHADER,
+                                fGS.fCompilerStrings.begin(),
+                                fGS.fCompilerStringLengths.begin(),
+                                fGS.fCompilerStrings.count(), fSettings);
             }
+            SkDebugf("\nFS:\n");
+            GrGLPrintShader(fGpu->glContext(),
+                            GR_GL_FRAGMENT_SHADER,
+                            fFS.fCompilerStrings.begin(),
+                            fFS.fCompilerStringLengths.begin(),
+                            fFS.fCompilerStrings.count(),
+                            fSettings);
+            return nullptr;
         }
     }
     this->resolveProgramResourceLocations(programID);
 
-    this->cleanupShaders(shadersToDelete);
-    if (!cached) {
-        this->storeShaderInCache(inputs, programID, glsl);
+    this->cleanupShaders(fShadersToDelete);
+    if (fStoreInCache) {
+        this->storeShaderInCache(fInputs, programID, fGLSL);
     }
     return this->createProgram(programID);
 }
 
+void GrGLProgramBuilder::cancel() {
+    if (fProgramID) {
+        this->cleanupProgram(fProgramID, fShadersToDelete);
+        fProgramID = 0;
+    }
+}
+
 void GrGLProgramBuilder::bindProgramResourceLocations(GrGLuint programID) {
     fUniformHandler.bindUniformLocations(programID, fGpu->glCaps());
 
@@ -464,6 +522,7 @@ GrGLProgram* GrGLProgramBuilder::createProgram(GrGLuint programID) {
                            fUniformHandles,
                            programID,
                            fUniformHandler.fUniforms,
+                           fUniformHandler.fUniformBlockSize,
                            fUniformHandler.fSamplers,
                            fVaryingHandler.fPathProcVaryingInfos,
                            std::move(fGeometryProcessor),
@@ -42,6 +42,30 @@ public:
                                       GrProgramDesc*,
                                       GrGLGpu*);
 
+    /**
+     * Like CreateProgram(), but stops once the program has been handed to glLinkProgram() so a
+     * driver that compiles in parallel can work on it while the caller carries on. Call
+     * finishProgram() (or cancel()) later to get the program. From here on the builder does not
+     * look at the pipeline, processors or proxies it was given, but the GrProgramDesc must outlive
+     * it. Returns null if generation failed.
+     */
+    static std::unique_ptr<GrGLProgramBuilder> StartProgram(
+            GrRenderTarget*, GrSurfaceOrigin, const GrPrimitiveProcessor&,
+            const GrTextureProxy* const primProcProxies[], const GrPipeline&, GrProgramDesc*,
+            GrGLGpu*);
+
+    /** Returns true if finishProgram() would not have to wait on the driver's compiler. */
+    bool isLinkComplete() const;
+
+    /**
+     * Checks the link status, looks up uniform locations and returns the finished program, or
+     * null if it failed to link.
+     */
+    GrGLProgram* finishProgram();
+
+    /** Deletes the GL program and shaders of a started program that won't be finished. */
+    void cancel();
+
     const GrCaps* caps() const override;
 
     GrGLGpu* gpu() const { return fGpu; }
@@ -70,7 +94,8 @@ private:
                                  bool bindAttribLocations);
     void storeShaderInCache(const SkSL::Program::Inputs& inputs, GrGLuint programID,
                             const SkSL::String& glsl);
-    GrGLProgram* finalize();
+    bool start();
+    bool link();
     void bindProgramResourceLocations(GrGLuint programID);
     bool checkLinkStatus(GrGLuint programID);
     void resolveProgramResourceLocations(GrGLuint programID);
@@ -100,6 +125,16 @@ private:
     // (all remaining bytes) char[] binary
     sk_sp<SkData> fCached;
 
+    // State carried from link() to finishProgram().
+    GrGLuint                fProgramID;
+    SkTDArray<GrGLuint>     fShadersToDelete;
+    SkSL::Program::Settings fSettings;
+    SkSL::Program::Inputs   fInputs;
+    SkSL::String            fGLSL;
+    bool                    fCheckLinked;
+    bool                    fUseGeoShader;
+    bool                    fStoreInCache;
+
     typedef GrGLSLProgramBuilder INHERITED;
 };
 #endif
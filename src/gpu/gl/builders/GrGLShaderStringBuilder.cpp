@@ -130,8 +130,11 @@ GrGLuint GrGLCompileAndAttachShader(const GrGLContext& glCtx,
     stats->incShaderCompilations();
     GR_GL_CALL(gli, CompileShader(shaderId));
 
-    // Calling GetShaderiv in Chromium is quite expensive. Assume success in release builds.
-    bool checkCompiled = kChromium_GrGLDriver != glCtx.driver();
+    // Calling GetShaderiv in Chromium is quite expensive. Assume success in release builds. The
+    // same goes for drivers that compile in parallel, where asking would wait for the compile; a
+    // failure still shows up when the program's link status is checked.
+    bool checkCompiled = kChromium_GrGLDriver != glCtx.driver() &&
+                         !glCtx.caps()->parallelShaderCompileSupport();
 #ifdef SK_DEBUG
     checkCompiled = true;
 #endif
@@ -19,9 +19,9 @@
 #include "GrSingleIntervalGradientColorizer.h"
 #include "GrTextureGradientColorizer.h"
 #include "GrUnrolledBinaryGradientColorizer.h"
-#include "GrGradientBitmapCache.h"
 
 #include "SkGr.h"
+#include "SkGradientLUT.h"
 #include "GrColor.h"
 #include "GrContext.h"
 #include "GrContextPriv.h"
@@ -30,16 +30,11 @@
 // use the textured gradient
 static const SkScalar kLowPrecisionIntervalLimit = 0.01f;
 
-// Each cache entry costs 1K or 2K of RAM. Each bitmap will be 1x256 at either 32bpp or 64bpp.
-static const int kMaxNumCachedGradientBitmaps = 32;
-static const int kGradientTextureSize = 256;
 
 // NOTE: signature takes raw pointers to the color/pos arrays and a count to make it easy for
 // MakeColorizer to transparently take care of hard stops at the end points of the gradient.
 static std::unique_ptr<GrFragmentProcessor> make_textured_colorizer(const SkPMColor4f* colors,
         const SkScalar* positions, int count, bool premul, const GrFPArgs& args) {
-    static GrGradientBitmapCache gCache(kMaxNumCachedGradientBitmaps, kGradientTextureSize);
-
     // Use 8888 or F16, depending on the destination config.
     // TODO: Use 1010102 for opaque gradients, at least if destination is 1010102?
     SkColorType colorType = kRGBA_8888_SkColorType;
@@ -49,8 +44,15 @@ static std::unique_ptr<GrFragmentProcessor> make_textured_colorizer(const SkPMCo
     }
     SkAlphaType alphaType = premul ? kPremul_SkAlphaType : kUnpremul_SkAlphaType;
 
+    // Each bitmap will be 1x256 or 1x1024 at either 32bpp or 64bpp, and lives in SkResourceCache
+    // where the raster backend finds the 8888 ones too.
+    int resolution = SkGradientLUT::ResolutionFor(positions, count);
+    if (resolution > args.fContext->contextPriv().caps()->maxTextureSize()) {
+        resolution = SkGradientLUT::kDefaultResolution;
+    }
+
     SkBitmap bitmap;
-    gCache.getGradient(colors, positions, count, colorType, alphaType, &bitmap);
+    SkGradientLUT::Get(colors, positions, count, resolution, colorType, alphaType, &bitmap);
     SkASSERT(1 == bitmap.height() && SkIsPow2(bitmap.width()));
     SkASSERT(bitmap.isImmutable());
 
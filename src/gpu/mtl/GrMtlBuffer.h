@@ -48,6 +48,8 @@ private:
     bool fIsDynamic;
     id<MTLBuffer> fMtlBuffer;
     id<MTLBuffer> fMappedBuffer;
+    // Where the mapped bytes start in fMappedBuffer, which may be shared with other allocations.
+    size_t fMappedOffset;
 
     typedef GrBuffer INHERITED;
 };
@@ -32,7 +32,8 @@ GrMtlBuffer::GrMtlBuffer(GrMtlGpu* gpu, size_t size, GrBufferType intendedType,
                          GrAccessPattern accessPattern)
         : INHERITED(gpu, size, intendedType, accessPattern)
         , fIntendedType(intendedType)
-        , fIsDynamic(accessPattern == kDynamic_GrAccessPattern) {
+        , fIsDynamic(accessPattern == kDynamic_GrAccessPattern)
+        , fMappedOffset(0) {
     // TODO: We are treating all buffers as static access since we don't have an implementation to
     // synchronize gpu and cpu access of a resource yet. See comments in GrMtlBuffer::internalMap()
     // and interalUnmap() for more details.
@@ -75,7 +76,7 @@ bool GrMtlBuffer::onUpdateData(const void* src, size_t srcInBytes) {
         return false;
     }
     SkASSERT(fMappedBuffer);
-    SkASSERT(srcInBytes == fMappedBuffer.length);
+    SkASSERT(fMappedOffset + srcInBytes <= fMappedBuffer.length);
     memcpy(fMapPtr, src, srcInBytes);
     this->internalUnmap(srcInBytes);
 
@@ -118,19 +119,17 @@ void GrMtlBuffer::internalMap(size_t sizeInBytes) {
         // TODO: We will want to decide if we need to create a new buffer here in order to avoid
         // possibly invalidating a buffer which is being used by the gpu.
         fMappedBuffer = fMtlBuffer;
+        fMappedOffset = 0;
         fMapPtr = fMappedBuffer.contents;
     } else {
         // TODO: We can't ensure that map will only be called once on static access buffers until
         // we actually enable dynamic access.
         // SkASSERT(fMappedBuffer == nil);
-        fMappedBuffer =
-                [this->mtlGpu()->device() newBufferWithLength: sizeInBytes
-#ifdef SK_BUILD_FOR_MAC
-                                                      options: MTLResourceStorageModeManaged];
-#else
-                                                      options: MTLResourceStorageModeShared];
-#endif
-        fMapPtr = fMappedBuffer.contents;
+        // The staging space comes from the resource provider's recycled buffers, so uploads don't
+        // create a new MTLBuffer each time.
+        fMappedBuffer = this->mtlGpu()->resourceProvider().getDynamicBuffer(sizeInBytes,
+                                                                            &fMappedOffset);
+        fMapPtr = static_cast<char*>(fMappedBuffer.contents) + fMappedOffset;
     }
     VALIDATE();
 }
@@ -144,25 +143,27 @@ void GrMtlBuffer::internalUnmap(size_t sizeInBytes) {
     SkASSERT(this->isMapped());
     if (fMtlBuffer == nil) {
         fMappedBuffer = nil;
+        fMappedOffset = 0;
         fMapPtr = nullptr;
         return;
     }
 #ifdef SK_BUILD_FOR_MAC
     // TODO: by calling didModifyRange here we invalidate the buffer. This will cause problems for
     // dynamic access buffers if they are being used by the gpu.
-    [fMappedBuffer didModifyRange: NSMakeRange(0, sizeInBytes)];
+    [fMappedBuffer didModifyRange: NSMakeRange(fMappedOffset, sizeInBytes)];
 #endif
     if (!fIsDynamic) {
         id<MTLBlitCommandEncoder> blitCmdEncoder =
                 [this->mtlGpu()->commandBuffer() blitCommandEncoder];
         [blitCmdEncoder copyFromBuffer: fMappedBuffer
-                          sourceOffset: 0
+                          sourceOffset: fMappedOffset
                               toBuffer: fMtlBuffer
                      destinationOffset: 0
                                   size: sizeInBytes];
         [blitCmdEncoder endEncoding];
     }
     fMappedBuffer = nil;
+    fMappedOffset = 0;
     fMapPtr = nullptr;
 }
 
@@ -171,7 +172,7 @@ void GrMtlBuffer::onMap() {
 }
 
 void GrMtlBuffer::onUnmap() {
-    this->internalUnmap(fMappedBuffer.length);
+    this->internalUnmap(fMtlBuffer.length);
 }
 
 #ifdef SK_DEBUG
@@ -182,8 +183,7 @@ void GrMtlBuffer::validate() const {
              fIntendedType == kXferCpuToGpu_GrBufferType ||
              fIntendedType == kXferGpuToCpu_GrBufferType);
 //           fIntendedType == kDrawIndirect_GrBufferType not yet supported
-    SkASSERT(fMappedBuffer == nil || fMtlBuffer == nil ||
-             fMappedBuffer.length <= fMtlBuffer.length);
+    SkASSERT(fMappedBuffer != nil || fMappedOffset == 0);
     SkASSERT(fIsDynamic == false); // TODO: implement synchronization to allow dynamic access.
 }
 #endif
@@ -124,6 +124,7 @@ void GrMtlGpu::submit(GrGpuCommandBuffer* buffer) {
 
 void GrMtlGpu::submitCommandBuffer(SyncQueue sync) {
     SkASSERT(fCmdBuffer);
+    fResourceProvider.addBufferCompletionHandler(fCmdBuffer);
     [fCmdBuffer commit];
     if (SyncQueue::kForce_SyncQueue == sync) {
         [fCmdBuffer waitUntilCompleted];
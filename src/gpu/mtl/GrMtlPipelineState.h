@@ -8,7 +8,6 @@
 #ifndef GrMtlPipelineState_DEFINED
 #define GrMtlPipelineState_DEFINED
 
-#include "GrMtlBuffer.h"
 #include "GrMtlPipelineStateDataManager.h"
 #include "GrStencilSettings.h"
 #include "GrTypesPriv.h"
@@ -37,8 +36,8 @@ public:
             MTLPixelFormat pixelFormat,
             const GrGLSLBuiltinUniformHandles& builtinUniformHandles,
             const UniformInfoArray& uniforms,
-            sk_sp<GrMtlBuffer> geometryUniformBuffer,
-            sk_sp<GrMtlBuffer> fragmentUniformBuffer,
+            uint32_t geometryUniformSize,
+            uint32_t fragmentUniformSize,
             uint32_t numSamplers,
             std::unique_ptr<GrGLSLPrimitiveProcessor> geometryProcessor,
             std::unique_ptr<GrGLSLXferProcessor> xferPRocessor,
@@ -112,9 +111,6 @@ private:
 
     GrStencilSettings fStencil;
 
-    sk_sp<GrMtlBuffer> fGeometryUniformBuffer;
-    sk_sp<GrMtlBuffer> fFragmentUniformBuffer;
-
     int fNumSamplers;
     SkTArray<SamplerBindings> fSamplerBindings;
 
@@ -13,7 +13,6 @@
 #include "GrRenderTarget.h"
 #include "GrRenderTargetPriv.h"
 #include "GrTexturePriv.h"
-#include "GrMtlBuffer.h"
 #include "GrMtlGpu.h"
 #include "GrMtlSampler.h"
 #include "GrMtlTexture.h"
@@ -37,8 +36,8 @@ GrMtlPipelineState::GrMtlPipelineState(
         MTLPixelFormat pixelFormat,
         const GrGLSLBuiltinUniformHandles& builtinUniformHandles,
         const UniformInfoArray& uniforms,
-        sk_sp<GrMtlBuffer> geometryUniformBuffer,
-        sk_sp<GrMtlBuffer> fragmentUniformBuffer,
+        uint32_t geometryUniformSize,
+        uint32_t fragmentUniformSize,
         uint32_t numSamplers,
         std::unique_ptr<GrGLSLPrimitiveProcessor> geometryProcessor,
         std::unique_ptr<GrGLSLXferProcessor> xferProcessor,
@@ -48,15 +47,12 @@ GrMtlPipelineState::GrMtlPipelineState(
         , fPipelineState(pipelineState)
         , fPixelFormat(pixelFormat)
         , fBuiltinUniformHandles(builtinUniformHandles)
-        , fGeometryUniformBuffer(std::move(geometryUniformBuffer))
-        , fFragmentUniformBuffer(std::move(fragmentUniformBuffer))
         , fNumSamplers(numSamplers)
         , fGeometryProcessor(std::move(geometryProcessor))
         , fXferProcessor(std::move(xferProcessor))
         , fFragmentProcessors(std::move(fragmentProcessors))
         , fFragmentProcessorCnt(fragmentProcessorCnt)
-        , fDataManager(uniforms, fGeometryUniformBuffer->sizeInBytes(),
-                       fFragmentUniformBuffer->sizeInBytes()) {
+        , fDataManager(uniforms, geometryUniformSize, fragmentUniformSize) {
     (void) fPixelFormat; // Suppress unused-var warning.
 }
 
@@ -106,10 +102,6 @@ void GrMtlPipelineState::setData(const GrRenderTarget* renderTarget,
     }
 
     SkASSERT(fNumSamplers == fSamplerBindings.count());
-    if (fGeometryUniformBuffer || fFragmentUniformBuffer) {
-        fDataManager.uploadUniformBuffers(fGpu, fGeometryUniformBuffer.get(),
-                                          fFragmentUniformBuffer.get());
-    }
 
     if (pipeline.isStencilEnabled()) {
         SkASSERT(renderTarget->renderTargetPriv().getStencilAttachment());
@@ -119,16 +111,7 @@ void GrMtlPipelineState::setData(const GrRenderTarget* renderTarget,
 }
 
 void GrMtlPipelineState::bind(id<MTLRenderCommandEncoder> renderCmdEncoder) {
-    if (fGeometryUniformBuffer) {
-        [renderCmdEncoder setVertexBuffer: fGeometryUniformBuffer->mtlBuffer()
-                                   offset: 0
-                                  atIndex: GrMtlUniformHandler::kGeometryBinding];
-    }
-    if (fFragmentUniformBuffer) {
-        [renderCmdEncoder setFragmentBuffer: fFragmentUniformBuffer->mtlBuffer()
-                                     offset: 0
-                                    atIndex: GrMtlUniformHandler::kFragBinding];
-    }
+    fDataManager.uploadAndBindUniformBuffers(fGpu, renderCmdEncoder);
     SkASSERT(fNumSamplers == fSamplerBindings.count());
     for (int index = 0; index < fNumSamplers; ++index) {
         [renderCmdEncoder setFragmentTexture: fSamplerBindings[index].fTexture
@@ -48,16 +48,29 @@ private:
 
     void finalizeFragmentSecondaryColor(GrShaderVar& outputColor) override;
 
+    // Compiles msl, first converting the builder's SkSL into it and filling out inputs if msl is
+    // empty.
     id<MTLLibrary> createMtlShaderLibrary(const GrGLSLShaderBuilder& builder,
                                           SkSL::Program::Kind kind,
                                           const SkSL::Program::Settings& settings,
-                                          GrProgramDesc* desc);
+                                          GrProgramDesc* desc,
+                                          SkSL::String* msl,
+                                          SkSL::Program::Inputs* inputs);
+
+    bool loadMSLFromCache(SkSL::String* vertexMSL, SkSL::Program::Inputs* vertexInputs,
+                          SkSL::String* fragmentMSL, SkSL::Program::Inputs* fragmentInputs);
+    void storeMSLInCache(const SkSL::String& vertexMSL, const SkSL::Program::Inputs& vertexInputs,
+                         const SkSL::String& fragmentMSL,
+                         const SkSL::Program::Inputs& fragmentInputs);
 
     GrMtlPipelineState* finalize(const GrPrimitiveProcessor&, const GrPipeline&, GrProgramDesc*);
 
     GrMtlGpu* fGpu;
     GrMtlUniformHandler fUniformHandler;
     GrMtlVaryingHandler fVaryingHandler;
+    // Set when the context has a persistent cache. fCached holds what it returned for fCacheKey.
+    sk_sp<SkData> fCacheKey;
+    sk_sp<SkData> fCached;
 
     typedef GrGLSLProgramBuilder INHERITED;
 };
@@ -13,6 +13,7 @@
 #include "GrMtlGpu.h"
 #include "GrMtlPipelineState.h"
 #include "GrMtlUtil.h"
+#include "SkTo.h"
 
 #import <simd/simd.h>
 
@@ -26,6 +27,12 @@ GrMtlPipelineState* GrMtlPipelineStateBuilder::CreatePipelineState(
     GrMtlPipelineStateBuilder builder(renderTarget, origin, primProc, primProcProxies, pipeline,
                                       desc, gpu);
 
+    auto persistentCache = gpu->getContext()->contextPriv().getPersistentCache();
+    if (persistentCache) {
+        // Generating the shaders may change the desc, so keep the key it was looked up with.
+        builder.fCacheKey = SkData::MakeWithCopy(desc->asKey(), desc->keyLength());
+        builder.fCached = persistentCache->load(*builder.fCacheKey);
+    }
     if (!builder.emitAndInstallProcs()) {
         return nullptr;
     }
@@ -60,30 +67,86 @@ id<MTLLibrary> GrMtlPipelineStateBuilder::createMtlShaderLibrary(
         const GrGLSLShaderBuilder& builder,
         SkSL::Program::Kind kind,
         const SkSL::Program::Settings& settings,
-        GrProgramDesc* desc) {
-    SkString shaderString;
-    for (int i = 0; i < builder.fCompilerStrings.count(); ++i) {
-        if (builder.fCompilerStrings[i]) {
-            shaderString.append(builder.fCompilerStrings[i]);
-            shaderString.append("\n");
+        GrProgramDesc* desc,
+        SkSL::String* msl,
+        SkSL::Program::Inputs* inputs) {
+    if (msl->empty()) {
+        SkString shaderString;
+        for (int i = 0; i < builder.fCompilerStrings.count(); ++i) {
+            if (builder.fCompilerStrings[i]) {
+                shaderString.append(builder.fCompilerStrings[i]);
+                shaderString.append("\n");
+            }
+        }
+        if (!GrSkSLToMSL(fGpu, shaderString.c_str(), kind, settings, msl, inputs)) {
+            return nil;
         }
     }
 
-    SkSL::Program::Inputs inputs;
-    id<MTLLibrary> shaderLibrary = GrCompileMtlShaderLibrary(fGpu, shaderString.c_str(),
-                                                             kind, settings, &inputs);
+    id<MTLLibrary> shaderLibrary = GrCompileMtlShaderLibrary(fGpu, *msl);
     if (shaderLibrary == nil) {
         return nil;
     }
-    if (inputs.fRTHeight) {
+    if (inputs->fRTHeight) {
         this->addRTHeightUniform(SKSL_RTHEIGHT_NAME);
     }
-    if (inputs.fFlipY) {
+    if (inputs->fFlipY) {
         desc->setSurfaceOriginKey(GrGLSLFragmentShaderBuilder::KeyForSurfaceOrigin(this->origin()));
     }
     return shaderLibrary;
 }
 
+// The cached data is the vertex and fragment shaders' inputs, followed by the length of the vertex
+// shader's MSL, and then the MSL of both shaders.
+bool GrMtlPipelineStateBuilder::loadMSLFromCache(SkSL::String* vertexMSL,
+                                                 SkSL::Program::Inputs* vertexInputs,
+                                                 SkSL::String* fragmentMSL,
+                                                 SkSL::Program::Inputs* fragmentInputs) {
+    static constexpr size_t kHeaderSize = 2 * sizeof(SkSL::Program::Inputs) + sizeof(uint32_t);
+    const uint8_t* bytes = fCached->bytes();
+    size_t size = fCached->size();
+    if (size < kHeaderSize) {
+        return false;
+    }
+    size_t offset = 0;
+    memcpy(vertexInputs, bytes + offset, sizeof(*vertexInputs));
+    offset += sizeof(*vertexInputs);
+    memcpy(fragmentInputs, bytes + offset, sizeof(*fragmentInputs));
+    offset += sizeof(*fragmentInputs);
+    uint32_t vertexLength;
+    memcpy(&vertexLength, bytes + offset, sizeof(vertexLength));
+    offset += sizeof(vertexLength);
+    if (!vertexLength || vertexLength >= size - offset) {
+        return false;
+    }
+    *vertexMSL = SkSL::String((const char*) bytes + offset, vertexLength);
+    offset += vertexLength;
+    *fragmentMSL = SkSL::String((const char*) bytes + offset, size - offset);
+    return true;
+}
+
+void GrMtlPipelineStateBuilder::storeMSLInCache(const SkSL::String& vertexMSL,
+                                                const SkSL::Program::Inputs& vertexInputs,
+                                                const SkSL::String& fragmentMSL,
+                                                const SkSL::Program::Inputs& fragmentInputs) {
+    uint32_t vertexLength = SkToU32(vertexMSL.length());
+    size_t dataLength = sizeof(vertexInputs) + sizeof(fragmentInputs) + sizeof(vertexLength) +
+                        vertexMSL.length() + fragmentMSL.length();
+    std::unique_ptr<uint8_t[]> data(new uint8_t[dataLength]);
+    size_t offset = 0;
+    memcpy(data.get() + offset, &vertexInputs, sizeof(vertexInputs));
+    offset += sizeof(vertexInputs);
+    memcpy(data.get() + offset, &fragmentInputs, sizeof(fragmentInputs));
+    offset += sizeof(fragmentInputs);
+    memcpy(data.get() + offset, &vertexLength, sizeof(vertexLength));
+    offset += sizeof(vertexLength);
+    memcpy(data.get() + offset, vertexMSL.data(), vertexMSL.length());
+    offset += vertexMSL.length();
+    memcpy(data.get() + offset, fragmentMSL.data(), fragmentMSL.length());
+    fGpu->getContext()->contextPriv().getPersistentCache()->store(
+            *fCacheKey, *SkData::MakeWithoutCopy(data.get(), dataLength));
+}
+
 static inline MTLVertexFormat attribute_type_to_mtlformat(GrVertexAttribType type) {
     // All half types will actually be float types. We are currently not using half types with
     // metal to avoid an issue with narrow type coercions (float->half) http://skbug.com/8221
@@ -322,20 +385,36 @@ GrMtlPipelineState* GrMtlPipelineStateBuilder::finalize(const GrPrimitiveProcess
     settings.fSharpenTextures = fGpu->getContext()->contextPriv().sharpenMipmappedTextures();
     SkASSERT(!this->fragColorIsInOut());
 
+    // On a cache hit we still generate the SkSL, which sets up the uniforms and processors, but
+    // skip converting it to MSL.
+    SkSL::String vertexMSL, fragmentMSL;
+    SkSL::Program::Inputs vertexInputs, fragmentInputs;
+    bool cached = fCached && this->loadMSLFromCache(&vertexMSL, &vertexInputs,
+                                                    &fragmentMSL, &fragmentInputs);
+    if (!cached) {
+        vertexMSL.clear();
+        fragmentMSL.clear();
+    }
+
     id<MTLLibrary> vertexLibrary = nil;
     id<MTLLibrary> fragmentLibrary = nil;
     vertexLibrary = this->createMtlShaderLibrary(fVS,
                                                  SkSL::Program::kVertex_Kind,
                                                  settings,
-                                                 desc);
+                                                 desc,
+                                                 &vertexMSL,
+                                                 &vertexInputs);
     fragmentLibrary = this->createMtlShaderLibrary(fFS,
                                                    SkSL::Program::kFragment_Kind,
                                                    settings,
-                                                   desc);
+                                                   desc,
+                                                   &fragmentMSL,
+                                                   &fragmentInputs);
     SkASSERT(!this->primitiveProcessor().willUseGeoShader());
 
-    SkASSERT(vertexLibrary);
-    SkASSERT(fragmentLibrary);
+    if (!vertexLibrary || !fragmentLibrary) {
+        return nullptr;
+    }
 
     id<MTLFunction> vertexFunction = [vertexLibrary newFunctionWithName: @"vertexMain"];
     id<MTLFunction> fragmentFunction = [fragmentLibrary newFunctionWithName: @"fragmentMain"];
@@ -359,19 +438,16 @@ GrMtlPipelineState* GrMtlPipelineStateBuilder::finalize(const GrPrimitiveProcess
                  [[error localizedDescription] cStringUsingEncoding: NSASCIIStringEncoding]);
         return nullptr;
     }
+    if (fCacheKey && !cached) {
+        this->storeMSLInCache(vertexMSL, vertexInputs, fragmentMSL, fragmentInputs);
+    }
     return new GrMtlPipelineState(fGpu,
                                   pipelineState,
                                   pipelineDescriptor.colorAttachments[0].pixelFormat,
                                   fUniformHandles,
                                   fUniformHandler.fUniforms,
-                                  GrMtlBuffer::Make(fGpu,
-                                                    fUniformHandler.fCurrentGeometryUBOOffset,
-                                                    kVertex_GrBufferType,
-                                                    kStatic_GrAccessPattern),
-                                  GrMtlBuffer::Make(fGpu,
-                                                    fUniformHandler.fCurrentFragmentUBOOffset,
-                                                    kVertex_GrBufferType,
-                                                    kStatic_GrAccessPattern),
+                                  fUniformHandler.fCurrentGeometryUBOOffset,
+                                  fUniformHandler.fCurrentFragmentUBOOffset,
                                   (uint32_t)fUniformHandler.numSamplers(),
                                   std::move(fGeometryProcessor),
                                   std::move(fXferProcessor),
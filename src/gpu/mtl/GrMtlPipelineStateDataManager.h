@@ -12,7 +12,8 @@
 #include "GrMtlUniformHandler.h"
 #include "SkAutoMalloc.h"
 
-class GrMtlBuffer;
+#import <metal/metal.h>
+
 class GrMtlGpu;
 
 class GrMtlPipelineStateDataManager : public GrGLSLProgramDataManager {
@@ -54,9 +55,11 @@ public:
         SK_ABORT("Only supported in NVPR, which is not in Metal");
     }
 
-    void uploadUniformBuffers(GrMtlGpu* gpu,
-                              GrMtlBuffer* geometryBuffer,
-                              GrMtlBuffer* fragmentBuffer) const;
+    // Copies the uniform values into space from the resource provider's dynamic buffers and binds
+    // them. The copy is made on every bind since that space is only valid for the current command
+    // buffer.
+    void uploadAndBindUniformBuffers(GrMtlGpu* gpu,
+                                     id<MTLRenderCommandEncoder> renderCmdEncoder) const;
 
 private:
     struct Uniform {
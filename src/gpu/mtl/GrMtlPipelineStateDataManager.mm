@@ -7,7 +7,6 @@
 
 #include "GrMtlPipelineStateDataManager.h"
 
-#include "GrMtlBuffer.h"
 #include "GrMtlGpu.h"
 
 GrMtlPipelineStateDataManager::GrMtlPipelineStateDataManager(const UniformInfoArray& uniforms,
@@ -360,17 +359,35 @@ template<> struct set_uniform_matrix<4> {
     }
 };
 
-void GrMtlPipelineStateDataManager::uploadUniformBuffers(GrMtlGpu* gpu,
-                                                         GrMtlBuffer* geometryBuffer,
-                                                         GrMtlBuffer* fragmentBuffer) const {
-    if (geometryBuffer && fGeometryUniformsDirty) {
-        SkAssertResult(geometryBuffer->updateData(fGeometryUniformData.get(),
-                                                  fGeometryUniformSize));
+static id<MTLBuffer> upload_uniform_data(GrMtlGpu* gpu, const void* data, size_t size,
+                                         size_t* offset) {
+    id<MTLBuffer> buffer = gpu->resourceProvider().getDynamicBuffer(size, offset);
+    memcpy(static_cast<char*>(buffer.contents) + *offset, data, size);
+#ifdef SK_BUILD_FOR_MAC
+    [buffer didModifyRange: NSMakeRange(*offset, size)];
+#endif
+    return buffer;
+}
+
+void GrMtlPipelineStateDataManager::uploadAndBindUniformBuffers(
+        GrMtlGpu* gpu,
+        id<MTLRenderCommandEncoder> renderCmdEncoder) const {
+    if (fGeometryUniformSize) {
+        size_t offset;
+        id<MTLBuffer> buffer = upload_uniform_data(gpu, fGeometryUniformData.get(),
+                                                   fGeometryUniformSize, &offset);
+        [renderCmdEncoder setVertexBuffer: buffer
+                                   offset: offset
+                                  atIndex: GrMtlUniformHandler::kGeometryBinding];
         fGeometryUniformsDirty = false;
     }
-    if (fragmentBuffer && fFragmentUniformsDirty) {
-        SkAssertResult(fragmentBuffer->updateData(fFragmentUniformData.get(),
-                                                  fFragmentUniformSize));
+    if (fFragmentUniformSize) {
+        size_t offset;
+        id<MTLBuffer> buffer = upload_uniform_data(gpu, fFragmentUniformData.get(),
+                                                   fFragmentUniformSize, &offset);
+        [renderCmdEncoder setFragmentBuffer: buffer
+                                     offset: offset
+                                    atIndex: GrMtlUniformHandler::kFragBinding];
         fFragmentUniformsDirty = false;
     }
 }
@@ -9,6 +9,8 @@
 #define GrMtlResourceProvider_DEFINED
 
 #include "GrMtlCopyPipelineState.h"
+#include "SkMutex.h"
+#include "SkRefCnt.h"
 #include "SkTArray.h"
 
 #import <metal/metal.h>
@@ -17,16 +19,62 @@ class GrMtlGpu;
 
 class GrMtlResourceProvider {
 public:
-    GrMtlResourceProvider(GrMtlGpu* gpu) : fGpu(gpu) {}
+    GrMtlResourceProvider(GrMtlGpu* gpu);
 
     GrMtlCopyPipelineState* findOrCreateCopyPipelineState(MTLPixelFormat dstPixelFormat,
                                                           id<MTLFunction> vertexFunction,
                                                           id<MTLFunction> fragmentFunction,
                                                           MTLVertexDescriptor* vertexDescriptor);
 
+    /**
+     * Returns a CPU-visible buffer with size bytes at *offset that the caller may write for use by
+     * the current command buffer. On macOS the caller must call didModifyRange: for what it wrote.
+     * The space stays reserved until that command buffer completes.
+     */
+    id<MTLBuffer> getDynamicBuffer(size_t size, size_t* offset);
+
+    /**
+     * Called before the command buffer is committed. Once it completes, the buffers handed out by
+     * getDynamicBuffer() since the last call are reused for later command buffers.
+     */
+    void addBufferCompletionHandler(id<MTLCommandBuffer> cmdBuffer);
+
 private:
+    // Suballocates getDynamicBuffer() requests from a handful of large buffers. With a few command
+    // buffers in flight this cycles through the same buffers, so a steady stream of frames does not
+    // create any new MTLBuffers. It is ref counted because the completion handlers, which Metal
+    // runs on its own thread, may outlive the resource provider.
+    class BufferSuballocator : public SkRefCnt {
+    public:
+        BufferSuballocator(id<MTLDevice> device) : fDevice(device), fUsedBuffers(nil), fHead(0) {}
+
+        id<MTLBuffer> getAllocation(size_t size, size_t* offset);
+        void addCompletionHandler(id<MTLCommandBuffer> cmdBuffer);
+
+    private:
+        static constexpr size_t kBufferSize = 256 * 1024;
+        // Satisfies the constant buffer offset alignment on all Metal devices.
+        static constexpr size_t kAlignment = 256;
+        static constexpr int kMaxFreeBuffers = 8;
+
+        id<MTLBuffer> newBuffer(size_t size);
+        void recycle(NSArray<id<MTLBuffer>>* buffers);
+
+        id<MTLDevice> fDevice;
+
+        // Only used on the thread recording the command buffer.
+        NSMutableArray<id<MTLBuffer>>* fUsedBuffers;
+        id<MTLBuffer> fCurrentBuffer;
+        size_t fHead;
+
+        SkMutex fFreeBuffersMutex;
+        SkTArray<id<MTLBuffer>> fFreeBuffers;
+    };
+
     SkTArray<std::unique_ptr<GrMtlCopyPipelineState>> fCopyPipelineStateCache;
 
+    sk_sp<BufferSuballocator> fBufferSuballocator;
+
     GrMtlGpu* fGpu;
 };
 
@@ -11,8 +11,13 @@
 #include "GrMtlGpu.h"
 #include "GrMtlUtil.h"
 
+#include "GrTypes.h"
 #include "SkSLCompiler.h"
 
+GrMtlResourceProvider::GrMtlResourceProvider(GrMtlGpu* gpu)
+        : fGpu(gpu)
+        , fBufferSuballocator(new BufferSuballocator(gpu->device())) {}
+
 GrMtlCopyPipelineState* GrMtlResourceProvider::findOrCreateCopyPipelineState(
         MTLPixelFormat dstPixelFormat,
         id<MTLFunction> vertexFunction,
@@ -29,3 +34,85 @@ GrMtlCopyPipelineState* GrMtlResourceProvider::findOrCreateCopyPipelineState(
              fGpu, dstPixelFormat, vertexFunction, fragmentFunction, vertexDescriptor));
     return fCopyPipelineStateCache.back().get();
 }
+
+id<MTLBuffer> GrMtlResourceProvider::getDynamicBuffer(size_t size, size_t* offset) {
+    return fBufferSuballocator->getAllocation(size, offset);
+}
+
+void GrMtlResourceProvider::addBufferCompletionHandler(id<MTLCommandBuffer> cmdBuffer) {
+    fBufferSuballocator->addCompletionHandler(cmdBuffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+id<MTLBuffer> GrMtlResourceProvider::BufferSuballocator::newBuffer(size_t size) {
+    // The managed resource mode is only available for macOS. iOS should use shared.
+    return [fDevice newBufferWithLength: size
+#ifdef SK_BUILD_FOR_MAC
+                                options: MTLResourceStorageModeManaged];
+#else
+                                options: MTLResourceStorageModeShared];
+#endif
+}
+
+id<MTLBuffer> GrMtlResourceProvider::BufferSuballocator::getAllocation(size_t size,
+                                                                        size_t* offset) {
+    if (!fUsedBuffers) {
+        fUsedBuffers = [NSMutableArray array];
+    }
+    // Requests too big to share a buffer get one of their own, which is not recycled.
+    if (size > kBufferSize) {
+        id<MTLBuffer> buffer = this->newBuffer(size);
+        [fUsedBuffers addObject: buffer];
+        *offset = 0;
+        return buffer;
+    }
+
+    size_t alignedHead = GrSizeAlignUp(fHead, kAlignment);
+    if (fCurrentBuffer && alignedHead + size <= kBufferSize) {
+        *offset = alignedHead;
+        fHead = alignedHead + size;
+        return fCurrentBuffer;
+    }
+
+    fCurrentBuffer = nil;
+    {
+        SkAutoMutexAcquire lock(fFreeBuffersMutex);
+        if (!fFreeBuffers.empty()) {
+            fCurrentBuffer = fFreeBuffers.back();
+            fFreeBuffers.pop_back();
+        }
+    }
+    if (!fCurrentBuffer) {
+        fCurrentBuffer = this->newBuffer(kBufferSize);
+    }
+    [fUsedBuffers addObject: fCurrentBuffer];
+    *offset = 0;
+    fHead = size;
+    return fCurrentBuffer;
+}
+
+void GrMtlResourceProvider::BufferSuballocator::addCompletionHandler(
+        id<MTLCommandBuffer> cmdBuffer) {
+    if (!fUsedBuffers.count) {
+        return;
+    }
+    NSArray<id<MTLBuffer>>* buffers = fUsedBuffers;
+    fUsedBuffers = nil;
+    fCurrentBuffer = nil;
+    fHead = 0;
+
+    sk_sp<BufferSuballocator> allocator = sk_ref_sp(this);
+    [cmdBuffer addCompletedHandler: ^(id<MTLCommandBuffer> commandBuffer) {
+        allocator->recycle(buffers);
+    }];
+}
+
+void GrMtlResourceProvider::BufferSuballocator::recycle(NSArray<id<MTLBuffer>>* buffers) {
+    SkAutoMutexAcquire lock(fFreeBuffersMutex);
+    for (id<MTLBuffer> buffer in buffers) {
+        if (buffer.length == kBufferSize && fFreeBuffers.count() < kMaxFreeBuffers) {
+            fFreeBuffers.push_back(buffer);
+        }
+    }
+}
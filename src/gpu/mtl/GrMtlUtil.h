@@ -57,6 +57,21 @@ id<MTLLibrary> GrCompileMtlShaderLibrary(const GrMtlGpu* gpu,
                                          const SkSL::Program::Settings& settings,
                                          SkSL::Program::Inputs* outInputs);
 
+/**
+ * Converts SkSL code to MSL. Returns false if SkSLC reports an error.
+ */
+bool GrSkSLToMSL(const GrMtlGpu* gpu,
+                 const char* shaderString,
+                 SkSL::Program::Kind kind,
+                 const SkSL::Program::Settings& settings,
+                 SkSL::String* msl,
+                 SkSL::Program::Inputs* outInputs);
+
+/**
+ * Returns a compiled MTLLibrary created from MSL code, such as the output of GrSkSLToMSL
+ */
+id<MTLLibrary> GrCompileMtlShaderLibrary(const GrMtlGpu* gpu, const SkSL::String& msl);
+
 /**
  * Returns a MTLTexture corresponding to the GrSurface. Optionally can do a resolve.
  */
@@ -93,6 +93,41 @@ bool GrPixelConfigToMTLFormat(GrPixelConfig config, MTLPixelFormat* format) {
             return true;
 #else
             return false;
+#endif
+        case kRGBA_ETC2_GrPixelConfig:
+#ifdef SK_BUILD_FOR_IOS
+            *format = MTLPixelFormatEAC_RGBA8;
+            return true;
+#else
+            return false;
+#endif
+        case kRGBA_ASTC_4x4_GrPixelConfig:
+#ifdef SK_BUILD_FOR_IOS
+            *format = MTLPixelFormatASTC_4x4_LDR;
+            return true;
+#else
+            return false;
+#endif
+        case kRGBA_BC1_GrPixelConfig:
+#ifdef SK_BUILD_FOR_MAC
+            *format = MTLPixelFormatBC1_RGBA;
+            return true;
+#else
+            return false;
+#endif
+        case kRGBA_BC3_GrPixelConfig:
+#ifdef SK_BUILD_FOR_MAC
+            *format = MTLPixelFormatBC3_RGBA;
+            return true;
+#else
+            return false;
+#endif
+        case kRGBA_BC7_GrPixelConfig:
+#ifdef SK_BUILD_FOR_MAC
+            *format = MTLPixelFormatBC7_RGBAUnorm;
+            return true;
+#else
+            return false;
 #endif
     }
     SK_ABORT("Unexpected config");
@@ -133,6 +168,18 @@ GrPixelConfig GrMTLFormatToPixelConfig(MTLPixelFormat format) {
 #ifdef SK_BUILD_FOR_IOS
         case MTLPixelFormatETC2_RGB8:
             return kRGB_ETC1_GrPixelConfig;
+        case MTLPixelFormatEAC_RGBA8:
+            return kRGBA_ETC2_GrPixelConfig;
+        case MTLPixelFormatASTC_4x4_LDR:
+            return kRGBA_ASTC_4x4_GrPixelConfig;
+#endif
+#ifdef SK_BUILD_FOR_MAC
+        case MTLPixelFormatBC1_RGBA:
+            return kRGBA_BC1_GrPixelConfig;
+        case MTLPixelFormatBC3_RGBA:
+            return kRGBA_BC3_GrPixelConfig;
+        case MTLPixelFormatBC7_RGBAUnorm:
+            return kRGBA_BC7_GrPixelConfig;
 #endif
         default:
             return kUnknown_GrPixelConfig;
@@ -186,6 +233,19 @@ id<MTLLibrary> GrCompileMtlShaderLibrary(const GrMtlGpu* gpu,
                                          SkSL::Program::Kind kind,
                                          const SkSL::Program::Settings& settings,
                                          SkSL::Program::Inputs* outInputs) {
+    SkSL::String code;
+    if (!GrSkSLToMSL(gpu, shaderString, kind, settings, &code, outInputs)) {
+        return nil;
+    }
+    return GrCompileMtlShaderLibrary(gpu, code);
+}
+
+bool GrSkSLToMSL(const GrMtlGpu* gpu,
+                 const char* shaderString,
+                 SkSL::Program::Kind kind,
+                 const SkSL::Program::Settings& settings,
+                 SkSL::String* msl,
+                 SkSL::Program::Inputs* outInputs) {
     std::unique_ptr<SkSL::Program> program =
             gpu->shaderCompiler()->convertProgram(kind,
                                                   SkSL::String(shaderString),
@@ -194,15 +254,19 @@ id<MTLLibrary> GrCompileMtlShaderLibrary(const GrMtlGpu* gpu,
     if (!program) {
         SkDebugf("SkSL error:\n%s\n", gpu->shaderCompiler()->errorText().c_str());
         SkASSERT(false);
+        return false;
     }
 
     *outInputs = program->fInputs;
-    SkSL::String code;
-    if (!gpu->shaderCompiler()->toMetal(*program, &code)) {
+    if (!gpu->shaderCompiler()->toMetal(*program, msl)) {
         SkDebugf("%s\n", gpu->shaderCompiler()->errorText().c_str());
         SkASSERT(false);
-        return nil;
+        return false;
     }
+    return true;
+}
+
+id<MTLLibrary> GrCompileMtlShaderLibrary(const GrMtlGpu* gpu, const SkSL::String& code) {
     NSString* mtlCode = [[NSString alloc] initWithCString: code.c_str()
                                                  encoding: NSASCIIStringEncoding];
 #if PRINT_MSL
@@ -36,18 +36,34 @@ std::unique_ptr<GrAAFillRRectOp> GrAAFillRRectOp::Make(
     }
 
     GrOpMemoryPool* pool = ctx->contextPriv().opMemoryPool();
-    return pool->allocate<GrAAFillRRectOp>(*caps.shaderCaps(), viewMatrix, rrect, std::move(paint));
+    return pool->allocate<GrAAFillRRectOp>(*caps.shaderCaps(), viewMatrix, rrect, rrect.rect(),
+                                           std::move(paint));
+}
+
+std::unique_ptr<GrAAFillRRectOp> GrAAFillRRectOp::MakeRect(
+        GrContext* ctx, const SkMatrix& viewMatrix, const SkRect& rect, const SkRect& localRect,
+        const GrCaps& caps, GrPaint&& paint) {
+    if (!caps.instanceAttribSupport() || viewMatrix.hasPerspective() || rect.isEmpty()) {
+        return nullptr;
+    }
+
+    GrOpMemoryPool* pool = ctx->contextPriv().opMemoryPool();
+    return pool->allocate<GrAAFillRRectOp>(*caps.shaderCaps(), viewMatrix, SkRRect::MakeRect(rect),
+                                           localRect, std::move(paint));
 }
 
 GrAAFillRRectOp::GrAAFillRRectOp(const GrShaderCaps& shaderCaps, const SkMatrix& viewMatrix,
-                                 const SkRRect& rrect, GrPaint&& paint)
+                                 const SkRRect& rrect, const SkRect& localRect, GrPaint&& paint)
         : GrDrawOp(ClassID())
         , fOriginalColor(paint.getColor4f())
-        , fLocalRect(rrect.rect())
+        , fLocalRect(localRect)
         , fProcessors(std::move(paint)) {
     if (can_use_hw_derivatives(shaderCaps, viewMatrix, rrect)) {
         fFlags |= Flags::kUseHWDerivatives;
     }
+    if (rrect.isRect()) {
+        fFlags |= Flags::kIsRect;
+    }
 
     // Produce a matrix that draws the round rect from normalized [-1, -1, +1, +1] space.
     float l = rrect.rect().left(), r = rrect.rect().right(),
@@ -101,13 +117,19 @@ GrProcessorSet::Analysis GrAAFillRRectOp::finalize(const GrCaps& caps, const GrA
 
 GrDrawOp::CombineResult GrAAFillRRectOp::onCombineIfPossible(GrOp* op, const GrCaps&) {
     const auto& that = *op->cast<GrAAFillRRectOp>();
-    if (fFlags != that.fFlags || fProcessors != that.fProcessors ||
+    // Rects have the same instance data as round rects, so the two can be drawn together with the
+    // round rect geometry.
+    if ((fFlags & ~Flags::kIsRect) != (that.fFlags & ~Flags::kIsRect) ||
+        fProcessors != that.fProcessors ||
         fInstanceData.count() > std::numeric_limits<int>::max() - that.fInstanceData.count()) {
         return CombineResult::kCannotCombine;
     }
 
     fInstanceData.push_back_n(that.fInstanceData.count(), that.fInstanceData.begin());
     fInstanceCount += that.fInstanceCount;
+    if (!(that.fFlags & Flags::kIsRect)) {
+        fFlags &= ~Flags::kIsRect;
+    }
     SkASSERT(fInstanceStride == that.fInstanceStride);
     return CombineResult::kMerged;
 }
@@ -250,6 +272,37 @@ static constexpr uint16_t kIndexData[] = {
 
 GR_DECLARE_STATIC_UNIQUE_KEY(gIndexBufferKey);
 
+// The geometry of an AA rect: an inset quad with solid coverage, surrounded by an outset quad that
+// the coverage ramps down to. Since rects have no radii, the shader demotes their corners to sharp
+// ones and only ever takes the linear coverage path.
+static constexpr Vertex kRectVertexData[] = {
+        // Inset corners.
+        {{{1,0,0,0}},  {{-1,-1}},  {{0,0}},  {{+1,+1}},  1,  1},
+        {{{0,1,0,0}},  {{+1,-1}},  {{0,0}},  {{-1,+1}},  1,  1},
+        {{{0,0,1,0}},  {{+1,+1}},  {{0,0}},  {{-1,-1}},  1,  1},
+        {{{0,0,0,1}},  {{-1,+1}},  {{0,0}},  {{+1,-1}},  1,  1},
+
+        // Outset corners.
+        {{{1,0,0,0}},  {{-1,-1}},  {{0,0}},  {{-1,-1}},  0,  1},
+        {{{0,1,0,0}},  {{+1,-1}},  {{0,0}},  {{+1,-1}},  0,  1},
+        {{{0,0,1,0}},  {{+1,+1}},  {{0,0}},  {{+1,+1}},  0,  1},
+        {{{0,0,0,1}},  {{-1,+1}},  {{0,0}},  {{-1,+1}},  0,  1}};
+
+GR_DECLARE_STATIC_UNIQUE_KEY(gRectVertexBufferKey);
+
+static constexpr uint16_t kRectIndexData[] = {
+        // Inset quad (solid coverage).
+        0, 1, 2,
+        0, 2, 3,
+
+        // AA borders (linear coverage).
+        0, 4, 5, 0, 5, 1,
+        1, 5, 6, 1, 6, 2,
+        2, 6, 7, 2, 7, 3,
+        3, 7, 4, 3, 4, 0};
+
+GR_DECLARE_STATIC_UNIQUE_KEY(gRectIndexBufferKey);
+
 }
 
 class GrAAFillRRectOp::Processor : public GrGeometryProcessor {
@@ -265,7 +318,7 @@ public:
     const char* name() const override { return "GrAAFillRRectOp::Processor"; }
 
     void getGLSLProcessorKey(const GrShaderCaps& caps, GrProcessorKeyBuilder* b) const override {
-        b->add32(static_cast<uint32_t>(fFlags));
+        b->add32(static_cast<uint32_t>(fFlags & ~Flags::kIsRect));
     }
 
     GrGLSLPrimitiveProcessor* createGLSLInstance(const GrShaderCaps&) const override;
@@ -439,19 +492,29 @@ void GrAAFillRRectOp::onExecute(GrOpFlushState* flushState, const SkRect& chainB
     }
 
     GR_DEFINE_STATIC_UNIQUE_KEY(gIndexBufferKey);
-
-    sk_sp<const GrBuffer> indexBuffer =
-            flushState->resourceProvider()->findOrMakeStaticBuffer(
-                    kIndex_GrBufferType, sizeof(kIndexData), kIndexData, gIndexBufferKey);
+    GR_DEFINE_STATIC_UNIQUE_KEY(gVertexBufferKey);
+    GR_DEFINE_STATIC_UNIQUE_KEY(gRectIndexBufferKey);
+    GR_DEFINE_STATIC_UNIQUE_KEY(gRectVertexBufferKey);
+
+    bool isRect = SkToBool(fFlags & Flags::kIsRect);
+    int indexCount = isRect ? SK_ARRAY_COUNT(kRectIndexData) : SK_ARRAY_COUNT(kIndexData);
+
+    sk_sp<const GrBuffer> indexBuffer = isRect
+            ? flushState->resourceProvider()->findOrMakeStaticBuffer(
+                      kIndex_GrBufferType, sizeof(kRectIndexData), kRectIndexData,
+                      gRectIndexBufferKey)
+            : flushState->resourceProvider()->findOrMakeStaticBuffer(
+                      kIndex_GrBufferType, sizeof(kIndexData), kIndexData, gIndexBufferKey);
     if (!indexBuffer) {
         return;
     }
 
-    GR_DEFINE_STATIC_UNIQUE_KEY(gVertexBufferKey);
-
-    sk_sp<const GrBuffer> vertexBuffer =
-            flushState->resourceProvider()->findOrMakeStaticBuffer(
-                    kVertex_GrBufferType, sizeof(kVertexData), kVertexData, gVertexBufferKey);
+    sk_sp<const GrBuffer> vertexBuffer = isRect
+            ? flushState->resourceProvider()->findOrMakeStaticBuffer(
+                      kVertex_GrBufferType, sizeof(kRectVertexData), kRectVertexData,
+                      gRectVertexBufferKey)
+            : flushState->resourceProvider()->findOrMakeStaticBuffer(
+                      kVertex_GrBufferType, sizeof(kVertexData), kVertexData, gVertexBufferKey);
     if (!vertexBuffer) {
         return;
     }
@@ -468,7 +531,7 @@ void GrAAFillRRectOp::onExecute(GrOpFlushState* flushState, const SkRect& chainB
     GrPipeline pipeline(initArgs, std::move(fProcessors), std::move(clip));
 
     GrMesh mesh(GrPrimitiveType::kTriangles);
-    mesh.setIndexedInstanced(std::move(indexBuffer), SK_ARRAY_COUNT(kIndexData), fInstanceBuffer,
+    mesh.setIndexedInstanced(std::move(indexBuffer), indexCount, fInstanceBuffer,
                              fInstanceCount, fBaseInstance, GrPrimitiveRestart::kNo);
     mesh.setVertexData(std::move(vertexBuffer));
     flushState->rtCommandBuffer()->draw(proc, pipeline, &fixedDynamicState, nullptr, &mesh, 1,
@@ -17,6 +17,12 @@ public:
     static std::unique_ptr<GrAAFillRRectOp> Make(GrContext*, const SkMatrix&, const SkRRect&,
                                                  const GrCaps&, GrPaint&&);
 
+    // Draws a rect whose local coords map to 'localRect'. Ops made from rects only draw the
+    // geometry of an AA rect, but they still combine with round rect ops.
+    static std::unique_ptr<GrAAFillRRectOp> MakeRect(GrContext*, const SkMatrix&,
+                                                     const SkRect& rect, const SkRect& localRect,
+                                                     const GrCaps&, GrPaint&&);
+
     const char* name() const override { return "GrAAFillRRectOp"; }
     FixedFunctionFlags fixedFunctionFlags() const override { return FixedFunctionFlags::kNone; }
     GrProcessorSet::Analysis finalize(const GrCaps&, const GrAppliedClip*) override;
@@ -32,14 +38,17 @@ private:
     enum class Flags {
         kNone = 0,
         kUseHWDerivatives = 1 << 0,
-        kHasLocalCoords = 1 << 1
+        kHasLocalCoords = 1 << 1,
+        // Every instance is a rect. The processor ignores this flag.
+        kIsRect = 1 << 2
     };
 
     GR_DECL_BITFIELD_CLASS_OPS_FRIENDS(Flags)
 
     class Processor;
 
-    GrAAFillRRectOp(const GrShaderCaps&, const SkMatrix&, const SkRRect&, GrPaint&&);
+    GrAAFillRRectOp(const GrShaderCaps&, const SkMatrix&, const SkRRect&, const SkRect& localRect,
+                    GrPaint&&);
 
     // These methods are used to append data of various POD types to our internal array of instance
     // data. The actual layout of the instance buffer can vary from Op to Op.
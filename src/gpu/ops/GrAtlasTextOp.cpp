@@ -193,12 +193,11 @@ static void clip_quads(const SkIRect& clipRect, char* currVertex, const char* bl
             auto* blobCoordsRB = reinterpret_cast<const uint16_t*>(blobVertices + 3 * vertexStride +
                                                                    coordOffset);
             // Pull out the texel coordinates and texture index bits
-            uint16_t coordsRectL = blobCoordsLT[0] >> 1;
-            uint16_t coordsRectT = blobCoordsLT[1] >> 1;
-            uint16_t coordsRectR = blobCoordsRB[0] >> 1;
-            uint16_t coordsRectB = blobCoordsRB[1] >> 1;
-            uint16_t pageIndexX = blobCoordsLT[0] & 0x1;
-            uint16_t pageIndexY = blobCoordsLT[1] & 0x1;
+            uint16_t coordsRectL = GrDrawOpAtlas::UnpackU(blobCoordsLT[0]);
+            uint16_t coordsRectT = GrDrawOpAtlas::UnpackV(blobCoordsLT[1]);
+            uint16_t coordsRectR = GrDrawOpAtlas::UnpackU(blobCoordsRB[0]);
+            uint16_t coordsRectB = GrDrawOpAtlas::UnpackV(blobCoordsRB[1]);
+            uint32_t pageIndex = GrDrawOpAtlas::UnpackPageIndex(blobCoordsLT[0], blobCoordsLT[1]);
 
             int positionRectWidth = positionRect.width();
             int positionRectHeight = positionRect.height();
@@ -224,10 +223,10 @@ static void clip_quads(const SkIRect& clipRect, char* currVertex, const char* bl
             positionRect.fBottom -= delta;
 
             // Repack texel coordinates and index
-            coordsRectL = coordsRectL << 1 | pageIndexX;
-            coordsRectT = coordsRectT << 1 | pageIndexY;
-            coordsRectR = coordsRectR << 1 | pageIndexX;
-            coordsRectB = coordsRectB << 1 | pageIndexY;
+            coordsRectL = GrDrawOpAtlas::PackU(coordsRectL, pageIndex);
+            coordsRectT = GrDrawOpAtlas::PackV(coordsRectT, pageIndex);
+            coordsRectR = GrDrawOpAtlas::PackU(coordsRectR, pageIndex);
+            coordsRectB = GrDrawOpAtlas::PackV(coordsRectB, pageIndex);
 
             // Set new positions and coords
             SkPoint* currPosition = reinterpret_cast<SkPoint*>(currVertex);
@@ -297,6 +296,7 @@ void GrAtlasTextOp::onPrepareDraws(Target* target) {
     static constexpr int kMaxTextures = GrBitmapTextGeoProc::kMaxTextures;
     GR_STATIC_ASSERT(GrDistanceFieldA8TextGeoProc::kMaxTextures == kMaxTextures);
     GR_STATIC_ASSERT(GrDistanceFieldLCDTextGeoProc::kMaxTextures == kMaxTextures);
+    GR_STATIC_ASSERT(GrDrawOpAtlas::kMaxMultitexturePages <= kMaxTextures);
 
     static const uint32_t kPipelineFlags = 0;
     auto pipe = target->makePipeline(kPipelineFlags, std::move(fProcessors),
@@ -310,27 +310,49 @@ void GrAtlasTextOp::onPrepareDraws(Target* target) {
     flushInfo.fFixedDynamicState = pipe.fFixedDynamicState;
 
     bool vmPerspective = fGeoData[0].fViewMatrix.hasPerspective();
-    if (this->usesDistanceFields()) {
-        flushInfo.fGeometryProcessor = this->setupDfProcessor(*target->caps().shaderCaps(),
-                                                              proxies, numActiveProxies);
-    } else {
-        GrSamplerState samplerState = fNeedsGlyphTransform ? GrSamplerState::ClampBilerp()
-                                                           : GrSamplerState::ClampNearest();
-        flushInfo.fGeometryProcessor = GrBitmapTextGeoProc::Make(
-            *target->caps().shaderCaps(), this->color(), false, proxies, numActiveProxies,
-            samplerState, maskFormat, localMatrix, vmPerspective);
-    }
+    flushInfo.fGeometryProcessor = this->makeGeometryProcessor(
+            *target->caps().shaderCaps(), proxies, numActiveProxies, localMatrix, {0, 0});
 
     flushInfo.fGlyphsToFlush = 0;
     size_t vertexStride = flushInfo.fGeometryProcessor->vertexStride();
 
+    // Subruns whose vertices are still on the GPU from an earlier draw are drawn from there,
+    // moved by a uniform, rather than being copied again.
+    struct CachedVertices {
+        sk_sp<const GrBuffer> fBuffer;
+        SkVector fTranslation;
+        int fGlyphCount;
+    };
+    SkAutoSTArray<kMinGeometryAllocated, CachedVertices> cachedVertices(fGeoCount);
     int glyphCount = this->numGlyphs();
+    for (int i = 0; i < fGeoCount; i++) {
+        const Geometry& args = fGeoData[i];
+        if (!args.fClipRect.isEmpty()) {
+            continue;
+        }
+        CachedVertices& cached = cachedVertices[i];
+        cached.fBuffer = GrTextBlob::VertexRegenerator::FindCachedVertices(
+                args.fBlob, args.fRun, args.fSubRun, args.fViewMatrix, args.fX, args.fY,
+                args.fColor.toBytes_RGBA(), target->contextUniqueID(),
+                target->deferredUploadTarget(), glyphCache, atlasManager, &cached.fTranslation,
+                &cached.fGlyphCount);
+        if (cached.fBuffer) {
+            glyphCount -= cached.fGlyphCount;
+        }
+    }
 
-    void* vertices = target->makeVertexSpace(vertexStride, glyphCount * kVerticesPerGlyph,
-                                             &flushInfo.fVertexBuffer, &flushInfo.fVertexOffset);
+    void* vertices = nullptr;
+    if (glyphCount > 0) {
+        vertices = target->makeVertexSpace(vertexStride, glyphCount * kVerticesPerGlyph,
+                                           &flushInfo.fVertexBuffer, &flushInfo.fVertexOffset);
+        if (!vertices || !flushInfo.fVertexBuffer) {
+            SkDebugf("Could not allocate vertices\n");
+            return;
+        }
+    }
     flushInfo.fIndexBuffer = target->resourceProvider()->refQuadIndexBuffer();
-    if (!vertices || !flushInfo.fVertexBuffer) {
-        SkDebugf("Could not allocate vertices\n");
+    if (!flushInfo.fIndexBuffer) {
+        SkDebugf("Could not allocate indices\n");
         return;
     }
 
@@ -340,12 +362,21 @@ void GrAtlasTextOp::onPrepareDraws(Target* target) {
     // each of these is a SubRun
     for (int i = 0; i < fGeoCount; i++) {
         const Geometry& args = fGeoData[i];
+        if (cachedVertices[i].fBuffer) {
+            // Keep the glyphs in draw order.
+            this->flush(target, &flushInfo);
+            this->drawCachedVertices(target, &flushInfo, std::move(cachedVertices[i].fBuffer),
+                                     cachedVertices[i].fGlyphCount,
+                                     cachedVertices[i].fTranslation, localMatrix);
+            continue;
+        }
         Blob* blob = args.fBlob;
         // TODO4F: Preserve float colors
         GrTextBlob::VertexRegenerator regenerator(
                 resourceProvider, blob, args.fRun, args.fSubRun, args.fViewMatrix, args.fX, args.fY,
                 args.fColor.toBytes_RGBA(), target->deferredUploadTarget(), glyphCache,
                 atlasManager, &autoGlyphCache);
+        const char* subRunVertices = currVertex;
         bool done = false;
         while (!done) {
             GrTextBlob::VertexRegenerator::Result result;
@@ -385,28 +416,57 @@ void GrAtlasTextOp::onPrepareDraws(Target* target) {
             }
             currVertex += vertexBytes;
         }
+        // Text that only moved since its last draw is likely to keep doing so (e.g. scrolling),
+        // so keep its device space vertices on the GPU for the next draw to reuse.
+        if (done && args.fClipRect.isEmpty() && regenerator.canCacheVertices()) {
+            sk_sp<GrBuffer> vertexBuffer = resourceProvider->createBuffer(
+                    currVertex - subRunVertices, kVertex_GrBufferType, kStatic_GrAccessPattern,
+                    GrResourceProvider::Flags::kNone, subRunVertices);
+            if (vertexBuffer) {
+                regenerator.setCachedVertices(std::move(vertexBuffer), target->contextUniqueID());
+            }
+        }
     }
     this->flush(target, &flushInfo);
 }
 
-void GrAtlasTextOp::flush(GrMeshDrawOp::Target* target, FlushInfo* flushInfo) const {
-    if (!flushInfo->fGlyphsToFlush) {
-        return;
+void GrAtlasTextOp::drawCachedVertices(GrMeshDrawOp::Target* target, FlushInfo* flushInfo,
+                                       sk_sp<const GrBuffer> vertexBuffer, int glyphCount,
+                                       const SkVector& translation,
+                                       const SkMatrix& localMatrix) const {
+    if (!flushInfo->fTranslatedGeometryProcessor || flushInfo->fTranslation != translation) {
+        unsigned int numActiveProxies;
+        const sk_sp<GrTextureProxy>* proxies =
+                target->atlasManager()->getProxies(this->maskFormat(), &numActiveProxies);
+        flushInfo->fTranslatedGeometryProcessor = this->makeGeometryProcessor(
+                *target->caps().shaderCaps(), proxies, numActiveProxies, localMatrix,
+                translation);
+        flushInfo->fTranslation = translation;
     }
+    this->addNewAtlasProxies(target, flushInfo->fTranslatedGeometryProcessor.get(),
+                             flushInfo->fFixedDynamicState);
 
-    auto atlasManager = target->atlasManager();
-
-    GrGeometryProcessor* gp = flushInfo->fGeometryProcessor.get();
-    GrMaskFormat maskFormat = this->maskFormat();
+    int maxGlyphsPerDraw =
+            static_cast<int>(flushInfo->fIndexBuffer->gpuMemorySize() / sizeof(uint16_t) / 6);
+    GrMesh* mesh = target->allocMesh(GrPrimitiveType::kTriangles);
+    mesh->setIndexedPatterned(flushInfo->fIndexBuffer, kIndicesPerGlyph, kVerticesPerGlyph,
+                              glyphCount, maxGlyphsPerDraw);
+    mesh->setVertexData(std::move(vertexBuffer), 0);
+    target->draw(flushInfo->fTranslatedGeometryProcessor, flushInfo->fPipeline,
+                 flushInfo->fFixedDynamicState, mesh);
+}
 
+void GrAtlasTextOp::addNewAtlasProxies(GrMeshDrawOp::Target* target, GrGeometryProcessor* gp,
+                                       GrPipeline::FixedDynamicState* fixedDynamicState) const {
     unsigned int numActiveProxies;
-    const sk_sp<GrTextureProxy>* proxies = atlasManager->getProxies(maskFormat, &numActiveProxies);
+    const sk_sp<GrTextureProxy>* proxies =
+            target->atlasManager()->getProxies(this->maskFormat(), &numActiveProxies);
     SkASSERT(proxies);
     if (gp->numTextureSamplers() != (int) numActiveProxies) {
         // During preparation the number of atlas pages has increased.
         // Update the proxies used in the GP to match.
         for (unsigned i = gp->numTextureSamplers(); i < numActiveProxies; ++i) {
-            flushInfo->fFixedDynamicState->fPrimitiveProcessorTextures[i] = proxies[i].get();
+            fixedDynamicState->fPrimitiveProcessorTextures[i] = proxies[i].get();
         }
         if (this->usesDistanceFields()) {
             if (this->isLCD()) {
@@ -423,6 +483,15 @@ void GrAtlasTextOp::flush(GrMeshDrawOp::Target* target, FlushInfo* flushInfo) co
                                                                       samplerState);
         }
     }
+}
+
+void GrAtlasTextOp::flush(GrMeshDrawOp::Target* target, FlushInfo* flushInfo) const {
+    if (!flushInfo->fGlyphsToFlush) {
+        return;
+    }
+
+    this->addNewAtlasProxies(target, flushInfo->fGeometryProcessor.get(),
+                             flushInfo->fFixedDynamicState);
     int maxGlyphsPerDraw =
             static_cast<int>(flushInfo->fIndexBuffer->gpuMemorySize() / sizeof(uint16_t) / 6);
     GrMesh* mesh = target->allocMesh(GrPrimitiveType::kTriangles);
@@ -563,3 +632,25 @@ sk_sp<GrGeometryProcessor> GrAtlasTextOp::setupDfProcessor(const GrShaderCaps& c
     }
 }
 
+sk_sp<GrGeometryProcessor> GrAtlasTextOp::makeGeometryProcessor(
+        const GrShaderCaps& caps, const sk_sp<GrTextureProxy>* proxies,
+        unsigned int numActiveProxies, const SkMatrix& localMatrix,
+        const SkVector& translation) const {
+    if (this->usesDistanceFields()) {
+        sk_sp<GrGeometryProcessor> gp = this->setupDfProcessor(caps, proxies, numActiveProxies);
+        if (this->isLCD()) {
+            static_cast<GrDistanceFieldLCDTextGeoProc*>(gp.get())->setTranslation(translation);
+        } else {
+            static_cast<GrDistanceFieldA8TextGeoProc*>(gp.get())->setTranslation(translation);
+        }
+        return gp;
+    }
+    GrSamplerState samplerState = fNeedsGlyphTransform ? GrSamplerState::ClampBilerp()
+                                                       : GrSamplerState::ClampNearest();
+    sk_sp<GrGeometryProcessor> gp = GrBitmapTextGeoProc::Make(
+            caps, this->color(), false, proxies, numActiveProxies, samplerState,
+            this->maskFormat(), localMatrix, fGeoData[0].fViewMatrix.hasPerspective());
+    static_cast<GrBitmapTextGeoProc*>(gp.get())->setTranslation(translation);
+    return gp;
+}
+
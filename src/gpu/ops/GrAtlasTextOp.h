@@ -111,6 +111,9 @@ private:
         GrPipeline::FixedDynamicState* fFixedDynamicState;
         int fGlyphsToFlush;
         int fVertexOffset;
+        // Shared by consecutive draws of vertices cached on the GPU that need the same offset.
+        sk_sp<GrGeometryProcessor> fTranslatedGeometryProcessor;
+        SkVector fTranslation;
     };
 
     void onPrepareDraws(Target*) override;
@@ -146,6 +149,17 @@ private:
 
     inline void flush(GrMeshDrawOp::Target* target, FlushInfo* flushInfo) const;
 
+    // Draws a subrun from the vertices an earlier draw of it cached on the GPU, moved by
+    // 'translation' in device space.
+    void drawCachedVertices(GrMeshDrawOp::Target*, FlushInfo*, sk_sp<const GrBuffer> vertexBuffer,
+                            int glyphCount, const SkVector& translation,
+                            const SkMatrix& localMatrix) const;
+
+    // Brings the textures of the pipeline and the geometry processor up to date with any atlas
+    // pages added while preparing.
+    void addNewAtlasProxies(GrMeshDrawOp::Target*, GrGeometryProcessor*,
+                            GrPipeline::FixedDynamicState*) const;
+
     const SkPMColor4f& color() const { SkASSERT(fGeoCount > 0); return fGeoData[0].fColor; }
     bool usesLocalCoords() const { return fUsesLocalCoords; }
     int numGlyphs() const { return fNumGlyphs; }
@@ -156,6 +170,12 @@ private:
                                                 const sk_sp<GrTextureProxy>* proxies,
                                                 unsigned int numActiveProxies) const;
 
+    sk_sp<GrGeometryProcessor> makeGeometryProcessor(const GrShaderCaps& caps,
+                                                     const sk_sp<GrTextureProxy>* proxies,
+                                                     unsigned int numActiveProxies,
+                                                     const SkMatrix& localMatrix,
+                                                     const SkVector& translation) const;
+
     SkAutoSTMalloc<kMinGeometryAllocated, Geometry> fGeoData;
     int fGeoDataAllocSize;
     GrProcessorSet fProcessors;
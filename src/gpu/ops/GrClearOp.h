@@ -29,6 +29,8 @@ public:
 
     const char* name() const override { return "Clear"; }
 
+    bool canExecuteRepeatedly() const override { return true; }
+
 #ifdef SK_DEBUG
     SkString dumpInfo() const override {
         SkString string;
@@ -25,6 +25,8 @@ public:
 
     const char* name() const override { return "ClearStencilClip"; }
 
+    bool canExecuteRepeatedly() const override { return true; }
+
 #ifdef SK_DEBUG
     SkString dumpInfo() const override {
         SkString string("Scissor [");
@@ -23,6 +23,8 @@ public:
 
     const char* name() const override { return "CopySurface"; }
 
+    bool canExecuteRepeatedly() const override { return true; }
+
     void visitProxies(const VisitProxyFunc& func, VisitorType) const override { func(fSrc.get()); }
 
 #ifdef SK_DEBUG
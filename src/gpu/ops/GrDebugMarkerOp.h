@@ -23,6 +23,8 @@ public:
 
     const char* name() const override { return "DebugMarker"; }
 
+    bool canExecuteRepeatedly() const override { return true; }
+
 #ifdef SK_DEBUG
     SkString dumpInfo() const override {
         SkString string;
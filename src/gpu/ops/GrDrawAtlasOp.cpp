@@ -6,12 +6,21 @@
  */
 
 #include "GrDrawAtlasOp.h"
+#include "GrCaps.h"
 #include "GrDrawOpTest.h"
+#include "GrGeometryProcessor.h"
 #include "GrOpFlushState.h"
+#include "GrResourceProvider.h"
 #include "SkGr.h"
 #include "SkRSXform.h"
 #include "SkRandom.h"
 #include "SkRectPriv.h"
+#include "glsl/GrGLSLFragmentShaderBuilder.h"
+#include "glsl/GrGLSLGeometryProcessor.h"
+#include "glsl/GrGLSLUniformHandler.h"
+#include "glsl/GrGLSLUtil.h"
+#include "glsl/GrGLSLVarying.h"
+#include "glsl/GrGLSLVertexGeoBuilder.h"
 
 static sk_sp<GrGeometryProcessor> make_gp(const GrShaderCaps* shaderCaps,
                                           bool hasColors,
@@ -27,6 +36,130 @@ static sk_sp<GrGeometryProcessor> make_gp(const GrShaderCaps* shaderCaps,
                                          LocalCoords::kHasExplicit_Type, viewMatrix);
 }
 
+namespace {
+
+/**
+ * Draws sprites as instances of a unit quad. Each instance is a sprite's RSXform, texture rect and
+ * optional color, which is all of the data the CPU path would write into each of four vertices.
+ */
+class SpriteProcessor : public GrGeometryProcessor {
+public:
+    static sk_sp<GrGeometryProcessor> Make(bool hasColors, const SkPMColor4f& color,
+                                           const SkMatrix& viewMatrix) {
+        return sk_sp<GrGeometryProcessor>(new SpriteProcessor(hasColors, color, viewMatrix));
+    }
+
+    const char* name() const override { return "SpriteProcessor"; }
+
+    void getGLSLProcessorKey(const GrShaderCaps&, GrProcessorKeyBuilder*) const override;
+
+    GrGLSLPrimitiveProcessor* createGLSLInstance(const GrShaderCaps&) const override;
+
+private:
+    SpriteProcessor(bool hasColors, const SkPMColor4f& color, const SkMatrix& viewMatrix)
+            : INHERITED(kGrDrawAtlasOp_SpriteProcessor_ClassID)
+            , fColor(color)
+            , fViewMatrix(viewMatrix)
+            , fHasColors(hasColors) {
+        this->setVertexAttributes(kVertexAttribs, SK_ARRAY_COUNT(kVertexAttribs));
+        this->setInstanceAttributes(kInstanceAttribs, hasColors ? 3 : 2);
+    }
+
+    static constexpr Attribute kVertexAttribs[] = {
+            {"corner", kFloat2_GrVertexAttribType, kFloat2_GrSLType}};
+
+    static constexpr Attribute kInstanceAttribs[] = {
+            {"xform", kFloat4_GrVertexAttribType, kFloat4_GrSLType},
+            {"texRect", kFloat4_GrVertexAttribType, kFloat4_GrSLType},
+            {"color", kUByte4_norm_GrVertexAttribType, kHalf4_GrSLType}};  // Conditional.
+
+    SkPMColor4f fColor;
+    SkMatrix fViewMatrix;
+    bool fHasColors;
+
+    class GLSLProcessor;
+
+    typedef GrGeometryProcessor INHERITED;
+};
+
+constexpr GrPrimitiveProcessor::Attribute SpriteProcessor::kVertexAttribs[];
+constexpr GrPrimitiveProcessor::Attribute SpriteProcessor::kInstanceAttribs[];
+
+class SpriteProcessor::GLSLProcessor : public GrGLSLGeometryProcessor {
+public:
+    static void GenKey(const SpriteProcessor& proc, GrProcessorKeyBuilder* b) {
+        b->add32((proc.fHasColors ? 0x1 : 0x0) | (ComputePosKey(proc.fViewMatrix) << 1));
+    }
+
+    void onEmitCode(EmitArgs& args, GrGPArgs* gpArgs) override {
+        const SpriteProcessor& proc = args.fGP.cast<SpriteProcessor>();
+        GrGLSLVertexBuilder* v = args.fVertBuilder;
+        GrGLSLVaryingHandler* varyings = args.fVaryingHandler;
+        GrGLSLUniformHandler* uniforms = args.fUniformHandler;
+
+        varyings->emitAttributes(proc);
+        if (proc.fHasColors) {
+            varyings->addPassThroughAttribute(kInstanceAttribs[2], args.fOutputColor,
+                                              GrGLSLVaryingHandler::Interpolation::kCanBeFlat);
+        } else {
+            this->setupUniformColor(args.fFragBuilder, uniforms, args.fOutputColor,
+                                    &fColorUniform);
+        }
+
+        // Same as SkRSXform::toTriStrip(): the corner is scaled by the texture rect's size and
+        // then rotated, scaled and translated by the RSXform.
+        v->codeAppend("float2 offset = corner * (texRect.zw - texRect.xy);");
+        v->codeAppend("float2 localcoord = texRect.xy + offset;");
+        v->codeAppend("float2 position = float2(xform.x * offset.x - xform.y * offset.y, "
+                                               "xform.y * offset.x + xform.x * offset.y) + "
+                                        "xform.zw;");
+
+        this->writeOutputPosition(v, uniforms, gpArgs, "position", proc.fViewMatrix,
+                                  &fViewMatrixUniform);
+        this->emitTransforms(v, varyings, uniforms, GrShaderVar("localcoord", kFloat2_GrSLType),
+                             args.fFPCoordTransformHandler);
+
+        args.fFragBuilder->codeAppendf("%s = half4(1);", args.fOutputCoverage);
+    }
+
+    void setData(const GrGLSLProgramDataManager& pdman, const GrPrimitiveProcessor& primProc,
+                 FPCoordTransformIter&& transformIter) override {
+        const SpriteProcessor& proc = primProc.cast<SpriteProcessor>();
+        if (!proc.fViewMatrix.isIdentity() && !fViewMatrix.cheapEqualTo(proc.fViewMatrix)) {
+            fViewMatrix = proc.fViewMatrix;
+            float viewMatrix[3 * 3];
+            GrGLSLGetMatrix<3>(viewMatrix, fViewMatrix);
+            pdman.setMatrix3f(fViewMatrixUniform, viewMatrix);
+        }
+        if (!proc.fHasColors && proc.fColor != fColor) {
+            pdman.set4fv(fColorUniform, 1, proc.fColor.vec());
+            fColor = proc.fColor;
+        }
+        this->setTransformDataHelper(SkMatrix::I(), pdman, &transformIter);
+    }
+
+private:
+    SkMatrix fViewMatrix = SkMatrix::InvalidMatrix();
+    SkPMColor4f fColor = SK_PMColor4fILLEGAL;
+    UniformHandle fViewMatrixUniform;
+    UniformHandle fColorUniform;
+};
+
+void SpriteProcessor::getGLSLProcessorKey(const GrShaderCaps&, GrProcessorKeyBuilder* b) const {
+    GLSLProcessor::GenKey(*this, b);
+}
+
+GrGLSLPrimitiveProcessor* SpriteProcessor::createGLSLInstance(const GrShaderCaps&) const {
+    return new GLSLProcessor();
+}
+
+// The corners of a sprite, in the order of SkRSXform::toTriStrip().
+static constexpr SkPoint kSpriteCorners[] = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+
+GR_DECLARE_STATIC_UNIQUE_KEY(gSpriteCornersKey);
+
+}  // anonymous namespace
+
 GrDrawAtlasOp::GrDrawAtlasOp(const Helper::MakeArgs& helperArgs, const SkPMColor4f& color,
                              const SkMatrix& viewMatrix, GrAAType aaType, int spriteCount,
                              const SkRSXform* xforms, const SkRect* rects, const SkColor* colors)
@@ -38,30 +171,19 @@ GrDrawAtlasOp::GrDrawAtlasOp(const Helper::MakeArgs& helperArgs, const SkPMColor
     Geometry& installedGeo = fGeoData.push_back();
     installedGeo.fColor = color;
 
-    // Figure out stride and offsets
-    // Order within the vertex is: position [color] texCoord
-    size_t texOffset = sizeof(SkPoint);
-    size_t vertexStride = 2 * sizeof(SkPoint);
     fHasColors = SkToBool(colors);
-    if (colors) {
-        texOffset += sizeof(GrColor);
-        vertexStride += sizeof(GrColor);
-    }
-
-    // Compute buffer size and alloc buffer
     fQuadCount = spriteCount;
-    int allocSize = static_cast<int>(4 * vertexStride * spriteCount);
-    installedGeo.fVerts.reset(allocSize);
-    uint8_t* currVertex = installedGeo.fVerts.begin();
+    size_t spriteStride = this->spriteStride();
+    installedGeo.fSprites.reset(static_cast<int>(spriteStride * spriteCount));
+    uint8_t* currSprite = installedGeo.fSprites.begin();
 
     SkRect bounds = SkRectPriv::MakeLargestInverted();
     // TODO4F: Preserve float colors
     int paintAlpha = GrColorUnpackA(installedGeo.fColor.toBytes_RGBA());
     for (int spriteIndex = 0; spriteIndex < spriteCount; ++spriteIndex) {
-        // Transform rect
-        SkPoint strip[4];
         const SkRect& currRect = rects[spriteIndex];
-        xforms[spriteIndex].toTriStrip(currRect.width(), currRect.height(), strip);
+        memcpy(currSprite, &xforms[spriteIndex], sizeof(SkRSXform));
+        memcpy(currSprite + sizeof(SkRSXform), &currRect, sizeof(SkRect));
 
         // Copy colors if necessary
         if (colors) {
@@ -71,50 +193,30 @@ GrDrawAtlasOp::GrDrawAtlasOp(const Helper::MakeArgs& helperArgs, const SkPMColor
                 color = SkColorSetA(color, SkMulDiv255Round(SkColorGetA(color), paintAlpha));
             }
             GrColor grColor = SkColorToPremulGrColor(color);
-
-            *(reinterpret_cast<GrColor*>(currVertex + sizeof(SkPoint))) = grColor;
-            *(reinterpret_cast<GrColor*>(currVertex + vertexStride + sizeof(SkPoint))) = grColor;
-            *(reinterpret_cast<GrColor*>(currVertex + 2 * vertexStride + sizeof(SkPoint))) =
-                    grColor;
-            *(reinterpret_cast<GrColor*>(currVertex + 3 * vertexStride + sizeof(SkPoint))) =
-                    grColor;
+            memcpy(currSprite + sizeof(SkRSXform) + sizeof(SkRect), &grColor, sizeof(GrColor));
         }
 
-        // Copy position and uv to verts
-        *(reinterpret_cast<SkPoint*>(currVertex)) = strip[0];
-        *(reinterpret_cast<SkPoint*>(currVertex + texOffset)) =
-                SkPoint::Make(currRect.fLeft, currRect.fTop);
-        SkRectPriv::GrowToInclude(&bounds, strip[0]);
-        currVertex += vertexStride;
-
-        *(reinterpret_cast<SkPoint*>(currVertex)) = strip[1];
-        *(reinterpret_cast<SkPoint*>(currVertex + texOffset)) =
-                SkPoint::Make(currRect.fLeft, currRect.fBottom);
-        SkRectPriv::GrowToInclude(&bounds, strip[1]);
-        currVertex += vertexStride;
-
-        *(reinterpret_cast<SkPoint*>(currVertex)) = strip[2];
-        *(reinterpret_cast<SkPoint*>(currVertex + texOffset)) =
-                SkPoint::Make(currRect.fRight, currRect.fTop);
-        SkRectPriv::GrowToInclude(&bounds, strip[2]);
-        currVertex += vertexStride;
-
-        *(reinterpret_cast<SkPoint*>(currVertex)) = strip[3];
-        *(reinterpret_cast<SkPoint*>(currVertex + texOffset)) =
-                SkPoint::Make(currRect.fRight, currRect.fBottom);
-        SkRectPriv::GrowToInclude(&bounds, strip[3]);
-        currVertex += vertexStride;
+        SkPoint strip[4];
+        xforms[spriteIndex].toTriStrip(currRect.width(), currRect.height(), strip);
+        for (const SkPoint& pt : strip) {
+            SkRectPriv::GrowToInclude(&bounds, pt);
+        }
+        currSprite += spriteStride;
     }
 
     this->setTransformedBounds(bounds, viewMatrix, HasAABloat::kNo, IsZeroArea::kNo);
 }
 
+size_t GrDrawAtlasOp::spriteStride() const {
+    return sizeof(SkRSXform) + sizeof(SkRect) + (fHasColors ? sizeof(GrColor) : 0);
+}
+
 #ifdef SK_DEBUG
 SkString GrDrawAtlasOp::dumpInfo() const {
     SkString string;
     for (const auto& geo : fGeoData) {
         string.appendf("Color: 0x%08x, Quads: %d\n", geo.fColor.toBytes_RGBA(),
-                       geo.fVerts.count() / 4);
+                       static_cast<int>(geo.fSprites.count() / this->spriteStride()));
     }
     string += fHelper.dumpInfo();
     string += INHERITED::dumpInfo();
@@ -123,30 +225,93 @@ SkString GrDrawAtlasOp::dumpInfo() const {
 #endif
 
 void GrDrawAtlasOp::onPrepareDraws(Target* target) {
+    if (target->caps().instanceAttribSupport()) {
+        this->prepareInstancedDraws(target);
+    } else {
+        this->prepareQuadDraws(target);
+    }
+}
+
+void GrDrawAtlasOp::prepareInstancedDraws(Target* target) {
+    GR_DEFINE_STATIC_UNIQUE_KEY(gSpriteCornersKey);
+    sk_sp<const GrBuffer> cornerBuffer = target->resourceProvider()->findOrMakeStaticBuffer(
+            kVertex_GrBufferType, sizeof(kSpriteCorners), kSpriteCorners, gSpriteCornersKey);
+    if (!cornerBuffer) {
+        SkDebugf("Could not allocate vertices\n");
+        return;
+    }
+
+    sk_sp<GrGeometryProcessor> gp(
+            SpriteProcessor::Make(this->hasColors(), this->color(), this->viewMatrix()));
+    SkASSERT(gp->instanceStride() == this->spriteStride());
+
+    sk_sp<const GrBuffer> instanceBuffer;
+    int firstInstance;
+    void* instances = target->makeVertexSpace(gp->instanceStride(), this->quadCount(),
+                                              &instanceBuffer, &firstInstance);
+    if (!instances) {
+        SkDebugf("Could not allocate instances\n");
+        return;
+    }
+
+    // The sprites are already stored in the instance layout.
+    uint8_t* instancePtr = reinterpret_cast<uint8_t*>(instances);
+    for (const Geometry& args : fGeoData) {
+        memcpy(instancePtr, args.fSprites.begin(), args.fSprites.count());
+        instancePtr += args.fSprites.count();
+    }
+
+    GrMesh* mesh = target->allocMesh(GrPrimitiveType::kTriangleStrip);
+    mesh->setInstanced(std::move(instanceBuffer), this->quadCount(), firstInstance,
+                       SK_ARRAY_COUNT(kSpriteCorners));
+    mesh->setVertexData(std::move(cornerBuffer));
+    auto pipe = fHelper.makePipeline(target);
+    target->draw(std::move(gp), pipe.fPipeline, pipe.fFixedDynamicState, mesh);
+}
+
+void GrDrawAtlasOp::prepareQuadDraws(Target* target) {
     // Setup geometry processor
     sk_sp<GrGeometryProcessor> gp(make_gp(target->caps().shaderCaps(),
                                           this->hasColors(),
                                           this->color(),
                                           this->viewMatrix()));
 
-    int instanceCount = fGeoData.count();
+    // Order within the vertex is: position [color] texCoord
     size_t vertexStride = gp->vertexStride();
+    size_t texOffset = sizeof(SkPoint) + (this->hasColors() ? sizeof(GrColor) : 0);
+    SkASSERT(vertexStride == texOffset + sizeof(SkPoint));
 
-    int numQuads = this->quadCount();
-    QuadHelper helper(target, vertexStride, numQuads);
+    QuadHelper helper(target, vertexStride, this->quadCount());
     void* verts = helper.vertices();
     if (!verts) {
         SkDebugf("Could not allocate vertices\n");
         return;
     }
 
-    uint8_t* vertPtr = reinterpret_cast<uint8_t*>(verts);
-    for (int i = 0; i < instanceCount; i++) {
-        const Geometry& args = fGeoData[i];
-
-        size_t allocSize = args.fVerts.count();
-        memcpy(vertPtr, args.fVerts.begin(), allocSize);
-        vertPtr += allocSize;
+    size_t spriteStride = this->spriteStride();
+    uint8_t* currVertex = reinterpret_cast<uint8_t*>(verts);
+    for (const Geometry& args : fGeoData) {
+        for (const uint8_t* currSprite = args.fSprites.begin();
+             currSprite < args.fSprites.end(); currSprite += spriteStride) {
+            SkRSXform xform;
+            SkRect rect;
+            memcpy(&xform, currSprite, sizeof(SkRSXform));
+            memcpy(&rect, currSprite + sizeof(SkRSXform), sizeof(SkRect));
+
+            SkPoint strip[4];
+            xform.toTriStrip(rect.width(), rect.height(), strip);
+            const SkPoint texCoords[4] = {{rect.fLeft, rect.fTop}, {rect.fLeft, rect.fBottom},
+                                          {rect.fRight, rect.fTop}, {rect.fRight, rect.fBottom}};
+            for (int i = 0; i < 4; ++i) {
+                *(reinterpret_cast<SkPoint*>(currVertex)) = strip[i];
+                if (this->hasColors()) {
+                    memcpy(currVertex + sizeof(SkPoint),
+                           currSprite + sizeof(SkRSXform) + sizeof(SkRect), sizeof(GrColor));
+                }
+                *(reinterpret_cast<SkPoint*>(currVertex + texOffset)) = texCoords[i];
+                currVertex += vertexStride;
+            }
+        }
     }
     auto pipe = fHelper.makePipeline(target);
     helper.recordDraw(target, std::move(gp), pipe.fPipeline, pipe.fFixedDynamicState);
@@ -191,8 +356,19 @@ GrProcessorSet::Analysis GrDrawAtlasOp::finalize(const GrCaps& caps, const GrApp
     }
     auto result = fHelper.finalizeProcessors(caps, clip, GrProcessorAnalysisCoverage::kNone,
                                              &gpColor);
-    if (gpColor.isConstant(&fColor)) {
+    if (gpColor.isConstant(&fColor) && fHasColors) {
+        // The colors were overridden, so drop them from the sprites.
+        size_t oldStride = this->spriteStride();
         fHasColors = false;
+        size_t newStride = this->spriteStride();
+        for (Geometry& geo : fGeoData) {
+            int spriteCount = static_cast<int>(geo.fSprites.count() / oldStride);
+            for (int i = 1; i < spriteCount; ++i) {
+                memmove(geo.fSprites.begin() + i * newStride,
+                        geo.fSprites.begin() + i * oldStride, newStride);
+            }
+            geo.fSprites.resize_back(static_cast<int>(spriteCount * newStride));
+        }
     }
     return result;
 }
@@ -53,6 +53,14 @@ public:
 private:
     void onPrepareDraws(Target*) override;
 
+    // Draws each sprite as an instance of a static quad, expanded by the vertex shader.
+    void prepareInstancedDraws(Target*);
+    // Writes the four vertices of each sprite on the CPU.
+    void prepareQuadDraws(Target*);
+
+    // The bytes each sprite takes in Geometry::fSprites.
+    size_t spriteStride() const;
+
     const SkPMColor4f& color() const { return fColor; }
     const SkMatrix& viewMatrix() const { return fViewMatrix; }
     bool hasColors() const { return fHasColors; }
@@ -60,9 +68,11 @@ private:
 
     CombineResult onCombineIfPossible(GrOp* t, const GrCaps&) override;
 
+    // Each sprite is stored as its SkRSXform and texture rect, followed by its premul GrColor if
+    // the op has colors. That is also the instance layout of the instanced draw.
     struct Geometry {
         SkPMColor4f fColor;
-        SkTArray<uint8_t, true> fVerts;
+        SkTArray<uint8_t, true> fSprites;
     };
 
     SkSTArray<1, Geometry, true> fGeoData;
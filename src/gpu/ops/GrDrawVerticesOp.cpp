@@ -8,7 +8,10 @@
 #include "GrDrawVerticesOp.h"
 #include "GrCaps.h"
 #include "GrDefaultGeoProcFactory.h"
+#include "GrGpu.h"
 #include "GrOpFlushState.h"
+#include "GrResourceProviderPriv.h"
+#include "SkAutoMalloc.h"
 #include "SkGr.h"
 #include "SkRectPriv.h"
 
@@ -208,8 +211,7 @@ sk_sp<GrGeometryProcessor> GrDrawVerticesOp::makeGP(const GrShaderCaps* shaderCa
 }
 
 void GrDrawVerticesOp::onPrepareDraws(Target* target) {
-    bool hasMapBufferSupport = GrCaps::kNone_MapFlags != target->caps().mapBufferFlags();
-    if (fMeshes[0].fVertices->isVolatile() || !hasMapBufferSupport) {
+    if (fMeshes[0].fVertices->isVolatile()) {
         this->drawVolatile(target);
     } else {
         this->drawNonVolatile(target);
@@ -253,6 +255,8 @@ void GrDrawVerticesOp::drawVolatile(Target* target) {
                       vertexStride,
                       verts,
                       indices);
+    target->resourceProvider()->priv().gpu()->stats()->incVertexUploadBytes(
+            fVertexCount * vertexStride + (indices ? fIndexCount * sizeof(uint16_t) : 0));
 
     // Draw the vertices.
     this->drawVertices(target, std::move(gp), std::move(vertexBuffer), firstVertex, indexBuffer,
@@ -275,12 +279,18 @@ void GrDrawVerticesOp::drawNonVolatile(Target* target) {
     // Get the resource provider.
     GrResourceProvider* rp = target->resourceProvider();
 
-    // Generate keys for the buffers.
+    // Generate keys for the buffers. The same SkVertices may be drawn with paints that need
+    // different attributes, so the vertex key includes the layout of the vertex data.
+    uint32_t vertexLayout = (hasColorAttribute ? 0x1 : 0) |
+                            (hasLocalCoordsAttribute ? 0x2 : 0) |
+                            (hasBoneAttribute ? 0x4 : 0) |
+                            (ColorArrayType::kSkColor == fColorArrayType ? 0x8 : 0);
     GrUniqueKey vertexKey, indexKey;
-    GrUniqueKey::Builder vertexKeyBuilder(&vertexKey, kDomain, 2);
+    GrUniqueKey::Builder vertexKeyBuilder(&vertexKey, kDomain, 3);
     GrUniqueKey::Builder indexKeyBuilder(&indexKey, kDomain, 2);
     vertexKeyBuilder[0] = indexKeyBuilder[0] = fMeshes[0].fVertices->uniqueID();
     vertexKeyBuilder[1] = 0;
+    vertexKeyBuilder[2] = vertexLayout;
     indexKeyBuilder[1] = 1;
     vertexKeyBuilder.finish();
     indexKeyBuilder.finish();
@@ -291,52 +301,86 @@ void GrDrawVerticesOp::drawNonVolatile(Target* target) {
             rp->findByUniqueKey<GrBuffer>(indexKey) :
             nullptr;
 
-    // Draw using the cached buffers if possible.
+    // Draw using the cached buffers if possible. The view matrix is a uniform of the GP, so only
+    // the first draw of the SkVertices uploads anything.
     if (vertexBuffer && (!this->isIndexed() || indexBuffer)) {
         this->drawVertices(target, std::move(gp), std::move(vertexBuffer), 0,
                            std::move(indexBuffer), 0);
         return;
     }
 
-    // Allocate vertex buffer.
     size_t vertexStride = gp->vertexStride();
-    vertexBuffer = rp->createBuffer(fVertexCount * vertexStride,
-                                    kVertex_GrBufferType,
-                                    kStatic_GrAccessPattern,
-                                    GrResourceProvider::Flags::kNone);
-    void* verts = vertexBuffer ? vertexBuffer->map() : nullptr;
-    if (!verts) {
-        SkDebugf("Could not allocate vertices\n");
-        return;
-    }
-
-    // Allocate index buffer.
-    uint16_t* indices = nullptr;
-    if (this->isIndexed()) {
-        indexBuffer = rp->createBuffer(fIndexCount * sizeof(uint16_t),
-                                       kIndex_GrBufferType,
-                                       kStatic_GrAccessPattern,
-                                       GrResourceProvider::Flags::kNone);
-        indices = indexBuffer ? static_cast<uint16_t*>(indexBuffer->map()) : nullptr;
-        if (!indices) {
-            SkDebugf("Could not allocate indices\n");
+    size_t vertexBytes = fVertexCount * vertexStride;
+    size_t indexBytes = this->isIndexed() ? fIndexCount * sizeof(uint16_t) : 0;
+
+    if (GrCaps::kNone_MapFlags == target->caps().mapBufferFlags()) {
+        // Without buffer mapping, fill the data on the CPU and upload it when making the buffers.
+        SkAutoMalloc storage(vertexBytes + indexBytes);
+        void* verts = storage.get();
+        uint16_t* indices = indexBytes ? SkTAddOffset<uint16_t>(verts, vertexBytes) : nullptr;
+        this->fillBuffers(hasColorAttribute,
+                          hasLocalCoordsAttribute,
+                          hasBoneAttribute,
+                          vertexStride,
+                          verts,
+                          indices);
+        vertexBuffer = rp->createBuffer(vertexBytes, kVertex_GrBufferType,
+                                        kStatic_GrAccessPattern,
+                                        GrResourceProvider::Flags::kNone, verts);
+        if (!vertexBuffer) {
+            SkDebugf("Could not allocate vertices\n");
+            return;
+        }
+        if (indices) {
+            indexBuffer = rp->createBuffer(indexBytes, kIndex_GrBufferType,
+                                           kStatic_GrAccessPattern,
+                                           GrResourceProvider::Flags::kNone, indices);
+            if (!indexBuffer) {
+                SkDebugf("Could not allocate indices\n");
+                return;
+            }
+        }
+    } else {
+        // Allocate vertex buffer.
+        vertexBuffer = rp->createBuffer(vertexBytes,
+                                        kVertex_GrBufferType,
+                                        kStatic_GrAccessPattern,
+                                        GrResourceProvider::Flags::kNone);
+        void* verts = vertexBuffer ? vertexBuffer->map() : nullptr;
+        if (!verts) {
+            SkDebugf("Could not allocate vertices\n");
             return;
         }
-    }
 
-    // Fill the buffers.
-    this->fillBuffers(hasColorAttribute,
-                      hasLocalCoordsAttribute,
-                      hasBoneAttribute,
-                      vertexStride,
-                      verts,
-                      indices);
+        // Allocate index buffer.
+        uint16_t* indices = nullptr;
+        if (this->isIndexed()) {
+            indexBuffer = rp->createBuffer(indexBytes,
+                                           kIndex_GrBufferType,
+                                           kStatic_GrAccessPattern,
+                                           GrResourceProvider::Flags::kNone);
+            indices = indexBuffer ? static_cast<uint16_t*>(indexBuffer->map()) : nullptr;
+            if (!indices) {
+                SkDebugf("Could not allocate indices\n");
+                return;
+            }
+        }
 
-    // Unmap the buffers.
-    vertexBuffer->unmap();
-    if (indexBuffer) {
-        indexBuffer->unmap();
+        // Fill the buffers.
+        this->fillBuffers(hasColorAttribute,
+                          hasLocalCoordsAttribute,
+                          hasBoneAttribute,
+                          vertexStride,
+                          verts,
+                          indices);
+
+        // Unmap the buffers.
+        vertexBuffer->unmap();
+        if (indexBuffer) {
+            indexBuffer->unmap();
+        }
     }
+    rp->priv().gpu()->stats()->incVertexUploadBytes(vertexBytes + indexBytes);
 
     // Cache the buffers.
     rp->assignUniqueKeyToResource(vertexKey, vertexBuffer.get());
@@ -7,6 +7,9 @@
 
 #include "GrFillRectOp.h"
 
+#include "GrAAFillRRectOp.h"
+#include "GrCaps.h"
+#include "GrContextPriv.h"
 #include "GrGeometryProcessor.h"
 #include "GrMeshDrawOp.h"
 #include "GrPaint.h"
@@ -329,6 +332,36 @@ private:
 
 } // anonymous namespace
 
+// Coverage AA rects with all edges anti-aliased are drawn as instances of GrAAFillRRectOp, when
+// that is supported. That writes a single instance for each rect instead of the eight AA vertices
+// whose outsets FillRectOp would compute on the CPU.
+static std::unique_ptr<GrDrawOp> make_instanced_rect(GrContext* context, GrPaint* paint,
+                                                     GrAAType aaType, GrQuadAAFlags edgeAA,
+                                                     const SkMatrix& viewMatrix,
+                                                     const SkRect& rect, const SkRect& localRect,
+                                                     const GrUserStencilSettings* stencil) {
+    if (GrAAType::kCoverage != aaType || GrQuadAAFlags::kAll != edgeAA || stencil) {
+        return nullptr;
+    }
+    // GrAAFillRRectOp stores its colors as bytes.
+    if (!SkPMColor4fFitsInBytes(paint->getColor4f())) {
+        return nullptr;
+    }
+
+    // Pixel-aligned rects don't need AA, and are cheaper to draw without coverage.
+    GrPerspQuad deviceQuad(rect, viewMatrix);
+    GrAAType resolvedAA;
+    GrQuadAAFlags resolvedEdgeAA;
+    GrResolveAATypeForQuad(aaType, edgeAA, deviceQuad, GrQuadTypeForTransformedRect(viewMatrix),
+                           &resolvedAA, &resolvedEdgeAA);
+    if (GrAAType::kCoverage != resolvedAA) {
+        return nullptr;
+    }
+
+    return GrAAFillRRectOp::MakeRect(context, viewMatrix, rect, localRect,
+                                     *context->contextPriv().caps(), std::move(*paint));
+}
+
 namespace GrFillRectOp {
 
 std::unique_ptr<GrDrawOp> MakePerEdge(GrContext* context,
@@ -338,6 +371,10 @@ std::unique_ptr<GrDrawOp> MakePerEdge(GrContext* context,
                                       const SkMatrix& viewMatrix,
                                       const SkRect& rect,
                                       const GrUserStencilSettings* stencilSettings) {
+    if (auto op = make_instanced_rect(context, &paint, aaType, edgeAA, viewMatrix, rect, rect,
+                                      stencilSettings)) {
+        return op;
+    }
     return FillRectOp::Make(context, std::move(paint), aaType, edgeAA, stencilSettings,
                             GrPerspQuad(rect, viewMatrix), GrQuadTypeForTransformedRect(viewMatrix),
                             GrPerspQuad(rect, SkMatrix::I()), GrQuadType::kRect);
@@ -365,6 +402,10 @@ std::unique_ptr<GrDrawOp> MakePerEdgeWithLocalRect(GrContext* context,
                                                    const SkRect& rect,
                                                    const SkRect& localRect,
                                                    const GrUserStencilSettings* stencilSettings) {
+    if (auto op = make_instanced_rect(context, &paint, aaType, edgeAA, viewMatrix, rect,
+                                      localRect, stencilSettings)) {
+        return op;
+    }
     return FillRectOp::Make(context, std::move(paint), aaType, edgeAA, stencilSettings,
                             GrPerspQuad(rect, viewMatrix), GrQuadTypeForTransformedRect(viewMatrix),
                             GrPerspQuad(localRect, SkMatrix::I()), GrQuadType::kRect);
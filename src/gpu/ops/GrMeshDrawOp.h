@@ -27,6 +27,9 @@ public:
     /** Abstract interface that represents a destination for a GrMeshDrawOp. */
     class Target;
 
+    // Executing only issues the draws recorded by onPrepareDraws(), which retained opLists keep.
+    bool canExecuteRepeatedly() const override { return true; }
+
 protected:
     GrMeshDrawOp(uint32_t classID);
 
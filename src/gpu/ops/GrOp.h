@@ -169,12 +169,27 @@ public:
         return fUniqueID;
     }
 
+    /**
+     * Called on every op being flushed, including ops in a chain, before any op is prepared. This
+     * may be called on a worker thread, concurrently with other ops' prePrepare(). The op may do
+     * CPU-only work here (e.g. tessellation) to shorten prepare(), but must not touch GPU
+     * resources, the resource provider, or any other op.
+     */
+    void prePrepare() { this->onPrePrepare(); }
+
     /**
      * Called prior to executing. The op should perform any resource creation or data transfers
      * necessary before execute() is called.
      */
     void prepare(GrOpFlushState* state) { this->onPrepare(state); }
 
+    /**
+     * Ops in a retained opList are prepared on its first flush only and executed on every flush.
+     * Ops that can issue their commands again without being prepared again, and that don't
+     * consume any of their state while executing, return true.
+     */
+    virtual bool canExecuteRepeatedly() const { return false; }
+
     /** Issues the op's commands to GrGpu. */
     void execute(GrOpFlushState* state, const SkRect& chainBounds) {
         TRACE_EVENT0("skia", name());
@@ -298,6 +313,7 @@ private:
         return CombineResult::kCannotCombine;
     }
 
+    virtual void onPrePrepare() {}
     virtual void onPrepare(GrOpFlushState*) = 0;
     // If this op is chained then chainBounds is the union of the bounds of all ops in the chain.
     // Otherwise, this op's bounds.
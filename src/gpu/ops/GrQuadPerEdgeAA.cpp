@@ -7,6 +7,7 @@
 
 #include "GrQuadPerEdgeAA.h"
 #include "GrQuad.h"
+#include "GrShaderCaps.h"
 #include "GrVertexWriter.h"
 #include "glsl/GrGLSLColorSpaceXformHelper.h"
 #include "glsl/GrGLSLGeometryProcessor.h"
@@ -334,7 +335,7 @@ static CoverageMode get_mode_for_spec(const GrQuadPerEdgeAA::VertexSpec& spec) {
 static void write_quad(GrVertexWriter* vb, const GrQuadPerEdgeAA::VertexSpec& spec,
                        CoverageMode mode, float coverage,
                        SkPMColor4f color4f, bool wideColor,
-                       const SkRect& domain,
+                       const SkRect& domain, float textureIndex,
                        const Sk4f& x, const Sk4f& y, const Sk4f& w,
                        const Sk4f& u, const Sk4f& v, const Sk4f& r) {
     static constexpr auto If = GrVertexWriter::If<float>;
@@ -366,6 +367,11 @@ static void write_quad(GrVertexWriter* vb, const GrQuadPerEdgeAA::VertexSpec& sp
         if (spec.hasDomain()) {
             vb->write(domain);
         }
+
+        // save the texture index
+        if (spec.hasTextureIndex()) {
+            vb->write(textureIndex);
+        }
     }
 }
 
@@ -401,7 +407,7 @@ namespace GrQuadPerEdgeAA {
 
 void* Tessellate(void* vertices, const VertexSpec& spec, const GrPerspQuad& deviceQuad,
                  const SkPMColor4f& color4f, const GrPerspQuad& localQuad, const SkRect& domain,
-                 GrQuadAAFlags aaFlags) {
+                 GrQuadAAFlags aaFlags, int textureIndex) {
     bool wideColor = GrQuadPerEdgeAA::ColorType::kHalf == spec.colorType();
     CoverageMode mode = get_mode_for_spec(spec);
 
@@ -451,13 +457,15 @@ void* Tessellate(void* vertices, const VertexSpec& spec, const GrPerspQuad& devi
         } // else don't adjust any positions, let the outer quad form degenerate triangles
 
         // Write two quads for inner and outer, inner will use the
-        write_quad(&vb, spec, mode, maxCoverage, color4f, wideColor, domain,
+        write_quad(&vb, spec, mode, maxCoverage, color4f, wideColor, domain, textureIndex,
                    iX, iY, iW, iU, iV, iR);
-        write_quad(&vb, spec, mode, 0.f, color4f, wideColor, domain, oX, oY, oW, oU, oV, oR);
+        write_quad(&vb, spec, mode, 0.f, color4f, wideColor, domain, textureIndex,
+                   oX, oY, oW, oU, oV, oR);
     } else {
         // No outsetting needed, just write a single quad with full coverage
         SkASSERT(mode == CoverageMode::kNone);
-        write_quad(&vb, spec, mode, 1.f, color4f, wideColor, domain, oX, oY, oW, oU, oV, oR);
+        write_quad(&vb, spec, mode, 1.f, color4f, wideColor, domain, textureIndex,
+                   oX, oY, oW, oU, oV, oR);
     }
 
     return vb.fPtr;
@@ -516,12 +524,12 @@ public:
 
     static sk_sp<GrGeometryProcessor> Make(const VertexSpec& vertexSpec, const GrShaderCaps& caps,
                                            GrTextureType textureType, GrPixelConfig textureConfig,
-                                           const GrSamplerState& samplerState,
+                                           int textureCnt, const GrSamplerState& samplerState,
                                            uint32_t extraSamplerKey,
                                            sk_sp<GrColorSpaceXform> textureColorSpaceXform) {
         return sk_sp<QuadPerEdgeAAGeometryProcessor>(new QuadPerEdgeAAGeometryProcessor(
-                vertexSpec, caps, textureType, textureConfig, samplerState, extraSamplerKey,
-                std::move(textureColorSpaceXform)));
+                vertexSpec, caps, textureType, textureConfig, textureCnt, samplerState,
+                extraSamplerKey, std::move(textureColorSpaceXform)));
     }
 
     const char* name() const override { return "QuadPerEdgeAAGeometryProcessor"; }
@@ -529,7 +537,7 @@ public:
     void getGLSLProcessorKey(const GrShaderCaps&, GrProcessorKeyBuilder* b) const override {
         // domain, texturing, device-dimensions are single bit flags
         uint32_t x = fDomain.isInitialized() ? 0 : 1;
-        x |= fSampler.isInitialized() ? 0 : 2;
+        x |= fSamplers[0].isInitialized() ? 0 : 2;
         x |= fNeedsPerspective ? 0 : 4;
         // local coords require 2 bits (3 choices), 00 for none, 01 for 2d, 10 for 3d
         if (fLocalCoord.isInitialized()) {
@@ -543,6 +551,8 @@ public:
         if (fCoverageMode != CoverageMode::kNone) {
             x |= CoverageMode::kWithPosition == fCoverageMode ? 128 : 256;
         }
+        // and the number of textures, which is also whether there is a texture index
+        x |= this->numTextureSamplers() << 9;
 
         b->add32(GrColorSpaceXform::XformKey(fTextureColorSpaceXform.get()));
         b->add32(x);
@@ -614,7 +624,7 @@ public:
 
                 // If there is a texture, must also handle texture coordinates and reading from
                 // the texture in the fragment shader before continuing to fragment processors.
-                if (gp.fSampler.isInitialized()) {
+                if (gp.fSamplers[0].isInitialized()) {
                     // Texture coordinates clamped by the domain on the fragment shader; if the GP
                     // has a texture, it's guaranteed to have local coordinates
                     args.fFragBuilder->codeAppend("float2 texCoord;");
@@ -639,12 +649,31 @@ public:
                                 "texCoord = clamp(texCoord, domain.xy, domain.zw);");
                     }
 
-                    // Now modulate the starting output color by the texture lookup
-                    args.fFragBuilder->codeAppendf("%s = ", args.fOutputColor);
-                    args.fFragBuilder->appendTextureLookupAndModulate(
-                        args.fOutputColor, args.fTexSamplers[0], "texCoord", kFloat2_GrSLType,
-                        &fTextureColorSpaceXformHelper);
-                    args.fFragBuilder->codeAppend(";");
+                    // Now modulate the starting output color by the texture lookup. With multiple
+                    // textures the quad's index picks which one. It is the same for all of the
+                    // quad's vertices, so it is exact even if it can't be a flat varying.
+                    int textureCnt = gp.numTextureSamplers();
+                    if (textureCnt > 1) {
+                        args.fFragBuilder->codeAppend("float texIdx;");
+                        args.fVaryingHandler->addPassThroughAttribute(gp.fTextureIndex, "texIdx",
+                                                                      Interpolation::kCanBeFlat);
+                    }
+                    for (int t = 0; t < textureCnt; ++t) {
+                        if (t < textureCnt - 1) {
+                            args.fFragBuilder->codeAppendf("%sif (texIdx < %d.5) {",
+                                                           t ? "else " : "", t);
+                        } else if (t) {
+                            args.fFragBuilder->codeAppend("else {");
+                        }
+                        args.fFragBuilder->codeAppendf("%s = ", args.fOutputColor);
+                        args.fFragBuilder->appendTextureLookupAndModulate(
+                            args.fOutputColor, args.fTexSamplers[t], "texCoord", kFloat2_GrSLType,
+                            &fTextureColorSpaceXformHelper);
+                        args.fFragBuilder->codeAppend(";");
+                        if (textureCnt > 1) {
+                            args.fFragBuilder->codeAppend("}");
+                        }
+                    }
                 }
 
                 // And lastly, output the coverage calculation code
@@ -683,15 +712,20 @@ private:
 
     QuadPerEdgeAAGeometryProcessor(const VertexSpec& spec, const GrShaderCaps& caps,
                                    GrTextureType textureType, GrPixelConfig textureConfig,
-                                   const GrSamplerState& samplerState,
+                                   int textureCnt, const GrSamplerState& samplerState,
                                    uint32_t extraSamplerKey,
                                    sk_sp<GrColorSpaceXform> textureColorSpaceXform)
             : INHERITED(kQuadPerEdgeAAGeometryProcessor_ClassID)
-            , fTextureColorSpaceXform(std::move(textureColorSpaceXform))
-            , fSampler(textureType, textureConfig, samplerState, extraSamplerKey) {
+            , fTextureColorSpaceXform(std::move(textureColorSpaceXform)) {
         SkASSERT(spec.hasLocalCoords());
+        SkASSERT(textureCnt > 0 && textureCnt <= kMaxTextures);
+        SkASSERT(textureCnt <= caps.maxFragmentSamplers());
+        SkASSERT(spec.hasTextureIndex() == (textureCnt > 1));
+        for (int t = 0; t < textureCnt; ++t) {
+            fSamplers[t].reset(textureType, textureConfig, samplerState, extraSamplerKey);
+        }
         this->initializeAttrs(spec);
-        this->setTextureSamplerCnt(1);
+        this->setTextureSamplerCnt(textureCnt);
     }
 
     void initializeAttrs(const VertexSpec& spec) {
@@ -729,25 +763,30 @@ private:
             fDomain = {"domain", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
         }
 
-        this->setVertexAttributes(&fPosition, 4);
+        if (spec.hasTextureIndex()) {
+            fTextureIndex = {"textureIndex", kFloat_GrVertexAttribType, kFloat_GrSLType};
+        }
+
+        this->setVertexAttributes(&fPosition, 5);
     }
 
-    const TextureSampler& onTextureSampler(int) const override { return fSampler; }
+    const TextureSampler& onTextureSampler(int i) const override { return fSamplers[i]; }
 
     Attribute fPosition; // May contain coverage as last channel
     Attribute fColor; // May have coverage modulated in if the FPs support it
     Attribute fLocalCoord;
     Attribute fDomain;
+    Attribute fTextureIndex;
 
     // The positions attribute may have coverage built into it, so float3 is an ambiguous type
     // and may mean 2d with coverage, or 3d with no coverage
     bool fNeedsPerspective;
     CoverageMode fCoverageMode;
 
-    // Color space will be null and fSampler.isInitialized() returns false when the GP is configured
-    // to skip texturing.
+    // Color space will be null and fSamplers[0].isInitialized() returns false when the GP is
+    // configured to skip texturing.
     sk_sp<GrColorSpaceXform> fTextureColorSpaceXform;
-    TextureSampler fSampler;
+    TextureSampler fSamplers[kMaxTextures];
 
     typedef GrGeometryProcessor INHERITED;
 };
@@ -757,11 +796,11 @@ sk_sp<GrGeometryProcessor> MakeProcessor(const VertexSpec& spec) {
 }
 
 sk_sp<GrGeometryProcessor> MakeTexturedProcessor(const VertexSpec& spec, const GrShaderCaps& caps,
-        GrTextureType textureType, GrPixelConfig textureConfig,
+        GrTextureType textureType, GrPixelConfig textureConfig, int textureCnt,
         const GrSamplerState& samplerState, uint32_t extraSamplerKey,
         sk_sp<GrColorSpaceXform> textureColorSpaceXform) {
     return QuadPerEdgeAAGeometryProcessor::Make(spec, caps, textureType, textureConfig,
-                                                samplerState, extraSamplerKey,
+                                                textureCnt, samplerState, extraSamplerKey,
                                                 std::move(textureColorSpaceXform));
 }
 
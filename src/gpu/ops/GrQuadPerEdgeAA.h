@@ -26,19 +26,25 @@ namespace GrQuadPerEdgeAA {
     enum class ColorType { kNone, kByte, kHalf, kLast = kHalf };
     static const int kColorTypeCount = static_cast<int>(ColorType::kLast) + 1;
 
+    // The most textures a textured processor can sample from, selecting one per quad.
+    static constexpr int kMaxTextures = 8;
+
     // Specifies the vertex configuration for an op that renders per-edge AA quads. The vertex
-    // order (when enabled) is device position, color, local position, domain, aa edge equations.
-    // This order matches the constructor argument order of VertexSpec and is the order that
-    // GPAttributes maintains. If hasLocalCoords is false, then the local quad type can be ignored.
+    // order (when enabled) is device position, color, local position, domain, texture index, aa
+    // edge equations. This order matches the constructor argument order of VertexSpec and is the
+    // order that GPAttributes maintains. If hasLocalCoords is false, then the local quad type can
+    // be ignored. The texture index is only needed when a processor samples multiple textures.
     struct VertexSpec {
     public:
         VertexSpec(GrQuadType deviceQuadType, ColorType colorType, GrQuadType localQuadType,
-                   bool hasLocalCoords, Domain domain, GrAAType aa, bool alphaAsCoverage)
+                   bool hasLocalCoords, Domain domain, GrAAType aa, bool alphaAsCoverage,
+                   bool hasTextureIndex = false)
                 : fDeviceQuadType(static_cast<unsigned>(deviceQuadType))
                 , fLocalQuadType(static_cast<unsigned>(localQuadType))
                 , fHasLocalCoords(hasLocalCoords)
                 , fColorType(static_cast<unsigned>(colorType))
                 , fHasDomain(static_cast<unsigned>(domain))
+                , fHasTextureIndex(hasTextureIndex)
                 , fUsesCoverageAA(aa == GrAAType::kCoverage)
                 , fCompatibleWithAlphaAsCoverage(alphaAsCoverage) { }
 
@@ -48,6 +54,7 @@ namespace GrQuadPerEdgeAA {
         ColorType colorType() const { return static_cast<ColorType>(fColorType); }
         bool hasVertexColors() const { return ColorType::kNone != this->colorType(); }
         bool hasDomain() const { return fHasDomain; }
+        bool hasTextureIndex() const { return fHasTextureIndex; }
         bool usesCoverageAA() const { return fUsesCoverageAA; }
         bool compatibleWithAlphaAsCoverage() const { return fCompatibleWithAlphaAsCoverage; }
 
@@ -66,26 +73,30 @@ namespace GrQuadPerEdgeAA {
         unsigned fHasLocalCoords: 1;
         unsigned fColorType : 2;
         unsigned fHasDomain: 1;
+        unsigned fHasTextureIndex: 1;
         unsigned fUsesCoverageAA: 1;
         unsigned fCompatibleWithAlphaAsCoverage: 1;
     };
 
     sk_sp<GrGeometryProcessor> MakeProcessor(const VertexSpec& spec);
 
+    // Samples one of textureCnt textures (at most kMaxTextures) with the same type, config and
+    // sampler state. If textureCnt is greater than 1 the spec must have a texture index, which
+    // selects the texture for each quad.
     sk_sp<GrGeometryProcessor> MakeTexturedProcessor(const VertexSpec& spec,
             const GrShaderCaps& caps, GrTextureType textureType, GrPixelConfig textureConfig,
-            const GrSamplerState& samplerState, uint32_t extraSamplerKey,
+            int textureCnt, const GrSamplerState& samplerState, uint32_t extraSamplerKey,
             sk_sp<GrColorSpaceXform> textureColorSpaceXform);
 
     // Fill vertices with the vertex data needed to represent the given quad. The device position,
-    // local coords, vertex color, domain, and edge coefficients will be written and/or computed
-    // based on the configuration in the vertex spec; if that attribute is disabled in the spec,
-    // then its corresponding function argument is ignored.
+    // local coords, vertex color, domain, texture index, and edge coefficients will be written
+    // and/or computed based on the configuration in the vertex spec; if that attribute is disabled
+    // in the spec, then its corresponding function argument is ignored.
     //
     // Returns the advanced pointer in vertices.
     void* Tessellate(void* vertices, const VertexSpec& spec, const GrPerspQuad& deviceQuad,
                      const SkPMColor4f& color, const GrPerspQuad& localQuad, const SkRect& domain,
-                     GrQuadAAFlags aa);
+                     GrQuadAAFlags aa, int textureIndex = 0);
 
     // The mesh will have its index data configured to meet the expectations of the Tessellate()
     // function, but it the calling code must handle filling a vertex buffer via Tessellate() and
@@ -0,0 +1,405 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrShadowConvexOp.h"
+
+#include "GrContext.h"
+#include "GrContextPriv.h"
+#include "GrDrawOpTest.h"
+#include "GrMemoryPool.h"
+#include "GrOpFlushState.h"
+#include "SkPointPriv.h"
+#include "effects/GrShadowGeoProc.h"
+#include "ops/GrMeshDrawOp.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// The shadow of a convex polygon P is drawn like the rrect shadows: its outer border is P outset
+// by the outset distance, and coverage ramps up over the blur width from that border inwards.
+// Like the rrect op, when the blur is wider than the outset we treat the shadow as the polygon
+// Q, P inset by the difference, outset by the blur width. That rounds the corners by the larger
+// of the two, and keeps the point of full coverage at a fixed distance R from the border.
+//
+// Everything is drawn with GrRRectShadowGeoProc. Its offset is the vector from the nearest point
+// of Q, scaled so the outer border has length 1:
+//   * Q itself is a fan with offset 0.
+//   * Each edge of Q has a quad out to the border with offsets along the edge's normal.
+//   * Each corner of Q has a fan of the border's arc. The arc is circumscribed by tangent lines,
+//     and since the offsets are exactly (pos - corner)/R the shader still finds the true circle.
+
+// Each corner's arc is split into steps of at most this angle.
+static constexpr SkScalar kMaxArcStep = SK_ScalarPI / 4;
+// 1/cos(kMaxArcStep/2): how far past R the circumscribed arcs can reach.
+static constexpr SkScalar kArcOvershoot = 1.08239220029f;
+
+static int arc_step_count(const SkVector& n0, const SkVector& n1) {
+    SkScalar angle = SkScalarATan2(SkTAbs(n0.cross(n1)), n0.dot(n1));
+    return SkTMax(1, SkScalarCeilToInt(angle / kMaxArcStep));
+}
+
+namespace {
+
+class ShadowConvexOp final : public GrMeshDrawOp {
+public:
+    DEFINE_OP_CLASS_ID
+
+    // 'points' is the inset polygon Q, wound so that the normals computed in the constructor
+    // point outward.
+    ShadowConvexOp(GrColor color, SkTArray<SkPoint, true>&& points, SkScalar radius,
+                   SkScalar blurRadius)
+            : INHERITED(ClassID()) {
+        Geometry& geo = fGeoData.push_back();
+        geo.fColor = color;
+        geo.fPoints = std::move(points);
+        geo.fRadius = radius;
+        geo.fBlurRadius = blurRadius;
+
+        int n = geo.fPoints.count();
+        geo.fNormals.reset(n);
+        SkScalar winding = 0;
+        for (int i = 0; i < n; ++i) {
+            winding += geo.fPoints[i].cross(geo.fPoints[(i + 1) % n]);
+        }
+        SkScalar sign = winding > 0 ? 1 : -1;
+        for (int i = 0; i < n; ++i) {
+            SkVector e = geo.fPoints[(i + 1) % n] - geo.fPoints[i];
+            geo.fNormals[i].set(sign * e.fY, -sign * e.fX);
+            SkAssertResult(geo.fNormals[i].normalize());
+        }
+
+        // Q, two border points per edge, and the inner points of each corner's arc.
+        geo.fVertCount = 3 * n;
+        // Q's fan, two triangles per edge, and one more triangle than inner points per corner.
+        geo.fIndexCount = 3 * (n - 2) + 6 * n;
+        for (int i = 0; i < n; ++i) {
+            int steps = arc_step_count(geo.fNormals[(i + n - 1) % n], geo.fNormals[i]);
+            geo.fVertCount += steps;
+            geo.fIndexCount += 3 * (steps + 1);
+        }
+        fVertCount = geo.fVertCount;
+        fIndexCount = geo.fIndexCount;
+
+        SkRect bounds;
+        bounds.setBounds(geo.fPoints.begin(), n);
+        bounds.outset(radius * kArcOvershoot, radius * kArcOvershoot);
+        this->setBounds(bounds, HasAABloat::kNo, IsZeroArea::kNo);
+    }
+
+    const char* name() const override { return "ShadowConvexOp"; }
+
+#ifdef SK_DEBUG
+    SkString dumpInfo() const override {
+        SkString string;
+        for (const Geometry& geo : fGeoData) {
+            string.appendf("Color: 0x%08x Points: %d, Radius: %.2f, BlurRad: %.2f\n",
+                           geo.fColor, geo.fPoints.count(), geo.fRadius, geo.fBlurRadius);
+        }
+        string.append(INHERITED::dumpInfo());
+        return string;
+    }
+#endif
+
+    FixedFunctionFlags fixedFunctionFlags() const override { return FixedFunctionFlags::kNone; }
+
+    GrProcessorSet::Analysis finalize(const GrCaps&, const GrAppliedClip*) override {
+        return GrProcessorSet::EmptySetAnalysis();
+    }
+
+private:
+    struct Geometry {
+        GrColor                  fColor;
+        SkTArray<SkPoint, true>  fPoints;
+        SkTArray<SkVector, true> fNormals;
+        SkScalar                 fRadius;
+        SkScalar                 fBlurRadius;
+        int                      fVertCount;
+        int                      fIndexCount;
+    };
+
+    struct ShadowVertex {
+        SkPoint  fPos;
+        GrColor  fColor;
+        SkPoint  fOffset;
+        SkScalar fDistanceCorrection;
+    };
+
+    void fillInVerts(const Geometry& geo, ShadowVertex* verts, uint16_t* indices,
+                     int baseVertex) const {
+        int n = geo.fPoints.count();
+        SkScalar r = geo.fRadius;
+        SkScalar distanceCorrection = r / geo.fBlurRadius;
+        int v = 0;
+        auto addVertex = [&](const SkPoint& pos, const SkVector& offset) {
+            verts[v] = {pos, geo.fColor, offset, distanceCorrection};
+            return baseVertex + v++;
+        };
+        auto addTriangle = [&indices](int a, int b, int c) {
+            *indices++ = a;
+            *indices++ = b;
+            *indices++ = c;
+        };
+
+        // Q, with full coverage.
+        for (int i = 0; i < n; ++i) {
+            addVertex(geo.fPoints[i], {0, 0});
+        }
+        for (int i = 1; i < n - 1; ++i) {
+            addTriangle(baseVertex, baseVertex + i, baseVertex + i + 1);
+        }
+
+        // The edges' ramps. Border point 2i is at the start of edge i and 2i+1 at its end.
+        int firstBorder = baseVertex + v;
+        for (int i = 0; i < n; ++i) {
+            const SkVector& normal = geo.fNormals[i];
+            int a = addVertex(geo.fPoints[i] + normal * r, normal);
+            int b = addVertex(geo.fPoints[(i + 1) % n] + normal * r, normal);
+            int q0 = baseVertex + i, q1 = baseVertex + (i + 1) % n;
+            addTriangle(q0, q1, b);
+            addTriangle(q0, b, a);
+        }
+
+        // The corners' arcs, from the end of the previous edge to the start of the next.
+        for (int i = 0; i < n; ++i) {
+            int prev = (i + n - 1) % n;
+            const SkVector& n0 = geo.fNormals[prev];
+            const SkVector& n1 = geo.fNormals[i];
+            int steps = arc_step_count(n0, n1);
+            SkScalar angle = SkScalarATan2(SkTAbs(n0.cross(n1)), n0.dot(n1));
+            SkScalar halfStep = angle / (2 * steps);
+            // The unit vector perpendicular to n0, on the side of n1.
+            SkVector perp = SkPointPriv::MakeOrthog(n0, n0.cross(n1) > 0
+                                                                ? SkPointPriv::kRight_Side
+                                                                : SkPointPriv::kLeft_Side);
+            SkScalar overshoot = SkScalarInvert(SkScalarCos(halfStep));
+
+            const SkPoint& corner = geo.fPoints[i];
+            int center = baseVertex + i;
+            int last = firstBorder + 2 * prev + 1;
+            for (int j = 1; j <= steps; ++j) {
+                SkScalar theta = (2 * j - 1) * halfStep;
+                SkVector offset = (n0 * SkScalarCos(theta) + perp * SkScalarSin(theta)) *
+                                  overshoot;
+                int next = addVertex(corner + offset * r, offset);
+                addTriangle(center, last, next);
+                last = next;
+            }
+            addTriangle(center, last, firstBorder + 2 * i);
+        }
+        SkASSERT(v == geo.fVertCount);
+    }
+
+    void onPrepareDraws(Target* target) override {
+        sk_sp<GrGeometryProcessor> gp = GrRRectShadowGeoProc::Make();
+        SkASSERT(sizeof(ShadowVertex) == gp->vertexStride());
+
+        sk_sp<const GrBuffer> vertexBuffer;
+        int firstVertex;
+        ShadowVertex* verts = (ShadowVertex*)target->makeVertexSpace(
+                sizeof(ShadowVertex), fVertCount, &vertexBuffer, &firstVertex);
+        if (!verts) {
+            SkDebugf("Could not allocate vertices\n");
+            return;
+        }
+
+        sk_sp<const GrBuffer> indexBuffer;
+        int firstIndex = 0;
+        uint16_t* indices = target->makeIndexSpace(fIndexCount, &indexBuffer, &firstIndex);
+        if (!indices) {
+            SkDebugf("Could not allocate indices\n");
+            return;
+        }
+
+        int currStartVertex = 0;
+        for (const Geometry& geo : fGeoData) {
+            this->fillInVerts(geo, verts, indices, currStartVertex);
+            verts += geo.fVertCount;
+            indices += geo.fIndexCount;
+            currStartVertex += geo.fVertCount;
+        }
+
+        static const uint32_t kPipelineFlags = 0;
+        auto pipe = target->makePipeline(kPipelineFlags, GrProcessorSet::MakeEmptySet(),
+                                         target->detachAppliedClip());
+
+        GrMesh* mesh = target->allocMesh(GrPrimitiveType::kTriangles);
+        mesh->setIndexed(std::move(indexBuffer), fIndexCount, firstIndex, 0, fVertCount - 1,
+                         GrPrimitiveRestart::kNo);
+        mesh->setVertexData(std::move(vertexBuffer), firstVertex);
+        target->draw(std::move(gp), pipe.fPipeline, pipe.fFixedDynamicState, mesh);
+    }
+
+    CombineResult onCombineIfPossible(GrOp* t, const GrCaps& caps) override {
+        ShadowConvexOp* that = t->cast<ShadowConvexOp>();
+        // The indices are 16 bit.
+        if (fVertCount + that->fVertCount > (1 << 16)) {
+            return CombineResult::kCannotCombine;
+        }
+        fGeoData.push_back_n(that->fGeoData.count(), that->fGeoData.begin());
+        fVertCount += that->fVertCount;
+        fIndexCount += that->fIndexCount;
+        return CombineResult::kMerged;
+    }
+
+    SkSTArray<1, Geometry> fGeoData;
+    int fVertCount;
+    int fIndexCount;
+
+    typedef GrMeshDrawOp INHERITED;
+};
+
+}  // anonymous namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Copies the polygon without repeated or collinear points. Returns false if what's left isn't a
+// strictly convex polygon.
+static bool simplify_polygon(const SkPoint devPoints[], int count,
+                             SkTArray<SkPoint, true>* points) {
+    for (int i = 0; i < count; ++i) {
+        if (points->empty() || !SkPointPriv::EqualsWithinTolerance(points->back(), devPoints[i])) {
+            points->push_back(devPoints[i]);
+        }
+    }
+    while (points->count() > 1 &&
+           SkPointPriv::EqualsWithinTolerance(points->back(), points->front())) {
+        points->pop_back();
+    }
+
+    // Drop collinear points. Removing one can make its neighbors collinear, so start over.
+    for (int i = 0; i < points->count() && points->count() >= 3;) {
+        int n = points->count();
+        SkVector e0 = (*points)[i] - (*points)[(i + n - 1) % n];
+        SkVector e1 = (*points)[(i + 1) % n] - (*points)[i];
+        if (SkScalarNearlyZero(e0.cross(e1) / (e0.length() * e1.length()))) {
+            if (e0.dot(e1) < 0) {
+                return false;  // The polygon doubles back on itself.
+            }
+            for (int j = i; j < n - 1; ++j) {
+                (*points)[j] = (*points)[j + 1];
+            }
+            points->pop_back();
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+
+    int n = points->count();
+    if (n < 3) {
+        return false;
+    }
+    SkScalar sign = 0;
+    for (int i = 0; i < n; ++i) {
+        SkVector e0 = (*points)[(i + 1) % n] - (*points)[i];
+        SkVector e1 = (*points)[(i + 2) % n] - (*points)[(i + 1) % n];
+        SkScalar cross = e0.cross(e1);
+        if (sign * cross < 0) {
+            return false;  // Not convex.
+        }
+        sign = cross;
+    }
+    return true;
+}
+
+// Insets a strictly convex polygon by 'inset'. Returns false if it collapses.
+static bool inset_polygon(SkTArray<SkPoint, true>* points, SkScalar inset) {
+    if (inset <= 0) {
+        return true;
+    }
+    int n = points->count();
+    SkScalar winding = 0;
+    for (int i = 0; i < n; ++i) {
+        winding += (*points)[i].cross((*points)[(i + 1) % n]);
+    }
+    SkScalar sign = winding > 0 ? 1 : -1;
+
+    SkSTArray<16, SkVector, true> normals(n);
+    for (int i = 0; i < n; ++i) {
+        SkVector e = (*points)[(i + 1) % n] - (*points)[i];
+        SkVector& normal = normals.push_back();
+        normal.set(sign * e.fY, -sign * e.fX);
+        if (!normal.normalize()) {
+            return false;
+        }
+    }
+
+    SkSTArray<16, SkPoint, true> insetPoints(n);
+    for (int i = 0; i < n; ++i) {
+        const SkVector& n0 = normals[(i + n - 1) % n];
+        const SkVector& n1 = normals[i];
+        // Where the previous and next edges' lines meet once both are moved in by 'inset'.
+        SkScalar denom = 1 + n0.dot(n1);
+        if (denom <= SK_ScalarNearlyZero) {
+            return false;
+        }
+        insetPoints.push_back((*points)[i] - (n0 + n1) * (inset / denom));
+    }
+
+    // If an edge flipped, the inset went past the polygon's inner skeleton.
+    for (int i = 0; i < n; ++i) {
+        SkVector before = (*points)[(i + 1) % n] - (*points)[i];
+        SkVector after = insetPoints[(i + 1) % n] - insetPoints[i];
+        if (before.dot(after) <= 0) {
+            return false;
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        (*points)[i] = insetPoints[i];
+    }
+    return true;
+}
+
+namespace GrShadowConvexOp {
+std::unique_ptr<GrDrawOp> Make(GrContext* context,
+                               GrColor color,
+                               const SkPoint devPoints[],
+                               int count,
+                               SkScalar outset,
+                               SkScalar blurWidth) {
+    if (count > kMaxEdges || !(blurWidth > 0) || !(outset >= 0)) {
+        return nullptr;
+    }
+    SkTArray<SkPoint, true> points(count);
+    if (!simplify_polygon(devPoints, count, &points)) {
+        return nullptr;
+    }
+
+    // As with the rrect op, full coverage starts the larger of the two distances in from the
+    // border.
+    SkScalar radius = SkTMax(outset, blurWidth);
+    if (!inset_polygon(&points, radius - outset)) {
+        return nullptr;
+    }
+
+    GrOpMemoryPool* pool = context->contextPriv().opMemoryPool();
+    return pool->allocate<ShadowConvexOp>(color, std::move(points), radius, blurWidth);
+}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#if GR_TEST_UTILS
+
+GR_DRAW_OP_TEST_DEFINE(ShadowConvexOp) {
+    // A random regular polygon.
+    int count = random->nextRangeU(3, 12);
+    SkPoint center = {random->nextRangeScalar(0, 1000), random->nextRangeScalar(0, 1000)};
+    // Large enough that the polygon can always be inset by the blur width.
+    SkScalar radius = random->nextRangeScalar(150, 300);
+    SkScalar rotate = random->nextRangeScalar(0, SK_ScalarPI);
+    SkSTArray<12, SkPoint, true> points;
+    for (int i = 0; i < count; ++i) {
+        SkScalar theta = rotate + 2 * SK_ScalarPI * i / count;
+        points.push_back(center + SkVector::Make(SkScalarCos(theta), SkScalarSin(theta)) * radius);
+    }
+    SkScalar outset = random->nextRangeScalar(0, 72);
+    SkScalar blurWidth = random->nextRangeScalar(1, 72);
+    // This op doesn't use a full GrPaint, just a color.
+    GrColor color = paint.getColor4f().toBytes_RGBA();
+    return GrShadowConvexOp::Make(context, color, points.begin(), count, outset, blurWidth);
+}
+
+#endif
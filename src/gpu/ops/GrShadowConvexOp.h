@@ -0,0 +1,37 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrShadowConvexOp_DEFINED
+#define GrShadowConvexOp_DEFINED
+
+#include <memory>
+#include "GrColor.h"
+
+class GrContext;
+class GrDrawOp;
+struct SkPoint;
+
+namespace GrShadowConvexOp {
+
+// Polygons with more edges than this are left to the shadow tessellator.
+static constexpr int kMaxEdges = 64;
+
+/**
+ * Makes an analytic shadow for a convex polygon given in device space. The shadow covers the
+ * polygon outset by 'outset', with rounded corners, and its coverage ramps up over 'blurWidth'
+ * from that border inwards. Returns null if the polygon is degenerate or too thin to be inset
+ * for the ramp.
+ */
+std::unique_ptr<GrDrawOp> Make(GrContext*,
+                               GrColor,
+                               const SkPoint devPoints[],
+                               int count,
+                               SkScalar outset,
+                               SkScalar blurWidth);
+}
+
+#endif
@@ -18,6 +18,7 @@
 #include "GrVertexWriter.h"
 #include "SkAutoMalloc.h"
 #include "SkAutoPixmapStorage.h"
+#include "SkData.h"
 #include "SkDistanceFieldGen.h"
 #include "SkDraw.h"
 #include "SkPaint.h"
@@ -44,10 +45,70 @@ static int g_NumFreedShapes = 0;
 static const SkScalar kIdealMinMIP = 12;
 static const SkScalar kMaxMIP = 162;
 
-static const SkScalar kMaxDim = 73;
+static const SkScalar kDefaultMaxDim = 73;
 static const SkScalar kMinSize = SK_ScalarHalf;
 static const SkScalar kMaxSize = 2*kMaxMIP;
 
+// Bump this whenever the distance fields generated for a given path and dimension change.
+static const uint32_t kPersistentDistanceFieldVersion = 1;
+
+// Persistent distance fields are keyed on the path itself, since shape keys may contain the
+// path's generation ID, which is only meaningful within this process.
+static sk_sp<SkData> make_persistent_distance_field_key(const SkPath& path, uint32_t dimension) {
+    size_t pathSize = path.writeToMemory(nullptr);
+    sk_sp<SkData> key = SkData::MakeUninitialized(2 * sizeof(uint32_t) + pathSize);
+    uint32_t* data = static_cast<uint32_t*>(key->writable_data());
+    data[0] = kPersistentDistanceFieldVersion;
+    data[1] = dimension;
+    path.writeToMemory(data + 2);
+    return key;
+}
+
+// Generates the distance field for path, drawn with drawMatrix into devPathBounds, into the
+// width x height distanceField.
+static bool generate_distance_field(const SkPath& path, const SkMatrix& drawMatrix,
+                                    const SkIRect& devPathBounds, int width, int height,
+                                    unsigned char* distanceField) {
+#ifndef SK_USE_LEGACY_DISTANCE_FIELDS
+    // Generate signed distance field directly from SkPath
+    bool succeed = GrGenerateDistanceFieldFromPath(distanceField,
+                                    path, drawMatrix,
+                                    width, height, width * sizeof(unsigned char));
+    if (!succeed) {
+#endif
+        // setup bitmap backing
+        SkAutoPixmapStorage dst;
+        if (!dst.tryAlloc(SkImageInfo::MakeA8(devPathBounds.width(),
+                                              devPathBounds.height()))) {
+            return false;
+        }
+        sk_bzero(dst.writable_addr(), dst.computeByteSize());
+
+        // rasterize path
+        SkPaint paint;
+        paint.setStyle(SkPaint::kFill_Style);
+        paint.setAntiAlias(true);
+
+        SkDraw draw;
+
+        SkRasterClip rasterClip;
+        rasterClip.setRect(devPathBounds);
+        draw.fRC = &rasterClip;
+        draw.fMatrix = &drawMatrix;
+        draw.fDst = dst;
+
+        draw.drawPathCoverage(path, paint);
+
+        // Generate signed distance field
+        SkGenerateDistanceFieldFromA8Image(distanceField,
+                                           (const unsigned char*)dst.addr(),
+                                           dst.width(), dst.height(), dst.rowBytes());
+#ifndef SK_USE_LEGACY_DISTANCE_FIELDS
+    }
+#endif
+    return true;
+}
+
 class ShapeDataKey {
 public:
     ShapeDataKey() {}
@@ -156,7 +217,11 @@ void GrSmallPathRenderer::HandleEviction(GrDrawOpAtlas::AtlasID id, void* pr) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-GrSmallPathRenderer::GrSmallPathRenderer() : fAtlas(nullptr) {}
+GrSmallPathRenderer::GrSmallPathRenderer(SkScalar maxDimension,
+                                         GrContextOptions::PersistentCache* distanceFieldCache)
+        : fAtlas(nullptr)
+        , fMaxDimension(maxDimension < 0 ? kDefaultMaxDim : maxDimension)
+        , fDistanceFieldCache(distanceFieldCache) {}
 
 GrSmallPathRenderer::~GrSmallPathRenderer() {
     ShapeDataList::Iter iter;
@@ -195,7 +260,7 @@ GrPathRenderer::CanDrawPath GrSmallPathRenderer::onCanDrawPath(const CanDrawPath
         return CanDrawPath::kNo;
     }
 
-    // Only support paths with bounds within kMaxDim by kMaxDim,
+    // Only support paths with bounds within fMaxDimension by fMaxDimension,
     // scaled to have bounds within kMaxSize by kMaxSize.
     // The goal is to accelerate rendering of lots of small paths that may be scaling.
     SkScalar scaleFactors[2] = { 1, 1 };
@@ -207,7 +272,7 @@ GrPathRenderer::CanDrawPath GrSmallPathRenderer::onCanDrawPath(const CanDrawPath
     SkScalar maxDim = SkMaxScalar(bounds.width(), bounds.height());
     SkScalar minSize = minDim * SkScalarAbs(scaleFactors[0]);
     SkScalar maxSize = maxDim * SkScalarAbs(scaleFactors[1]);
-    if (maxDim > kMaxDim || kMinSize > minSize || maxSize > kMaxSize) {
+    if (maxDim > fMaxDimension || kMinSize > minSize || maxSize > kMaxSize) {
         return CanDrawPath::kNo;
     }
 
@@ -236,17 +301,18 @@ public:
                                           GrDrawOpAtlas* atlas,
                                           ShapeCache* shapeCache,
                                           ShapeDataList* shapeList,
+                                          GrContextOptions::PersistentCache* distanceFieldCache,
                                           bool gammaCorrect,
                                           const GrUserStencilSettings* stencilSettings) {
         return Helper::FactoryHelper<SmallPathOp>(context, std::move(paint), shape, viewMatrix,
-                                                  atlas, shapeCache, shapeList, gammaCorrect,
-                                                  stencilSettings);
+                                                  atlas, shapeCache, shapeList, distanceFieldCache,
+                                                  gammaCorrect, stencilSettings);
     }
 
     SmallPathOp(Helper::MakeArgs helperArgs, const SkPMColor4f& color, const GrShape& shape,
                 const SkMatrix& viewMatrix, GrDrawOpAtlas* atlas, ShapeCache* shapeCache,
-                ShapeDataList* shapeList, bool gammaCorrect,
-                const GrUserStencilSettings* stencilSettings)
+                ShapeDataList* shapeList, GrContextOptions::PersistentCache* distanceFieldCache,
+                bool gammaCorrect, const GrUserStencilSettings* stencilSettings)
             : INHERITED(ClassID()), fHelper(helperArgs, GrAAType::kCoverage, stencilSettings) {
         SkASSERT(shape.hasUnstyledKey());
         // Compute bounds
@@ -266,6 +332,7 @@ public:
         fAtlas = atlas;
         fShapeCache = shapeCache;
         fShapeList = shapeList;
+        fDistanceFieldCache = distanceFieldCache;
         fGammaCorrect = gammaCorrect;
         fWideColor = !SkPMColor4fFitsInBytes(color);
 
@@ -563,55 +630,43 @@ private:
         SkIRect dfBounds = devPathBounds.makeOutset(SK_DistanceFieldPad, SK_DistanceFieldPad);
         width = dfBounds.width();
         height = dfBounds.height();
-        // TODO We should really generate this directly into the plot somehow
-        SkAutoSMalloc<1024> dfStorage(width * height * sizeof(unsigned char));
-
         SkPath path;
         shape.asPath(&path);
-#ifndef SK_USE_LEGACY_DISTANCE_FIELDS
-        // Generate signed distance field directly from SkPath
-        bool succeed = GrGenerateDistanceFieldFromPath((unsigned char*)dfStorage.get(),
-                                        path, drawMatrix,
-                                        width, height, width * sizeof(unsigned char));
-        if (!succeed) {
-#endif
-            // setup bitmap backing
-            SkAutoPixmapStorage dst;
-            if (!dst.tryAlloc(SkImageInfo::MakeA8(devPathBounds.width(),
-                                                  devPathBounds.height()))) {
-                return false;
-            }
-            sk_bzero(dst.writable_addr(), dst.computeByteSize());
 
-            // rasterize path
-            SkPaint paint;
-            paint.setStyle(SkPaint::kFill_Style);
-            paint.setAntiAlias(true);
-
-            SkDraw draw;
-
-            SkRasterClip rasterClip;
-            rasterClip.setRect(devPathBounds);
-            draw.fRC = &rasterClip;
-            draw.fMatrix = &drawMatrix;
-            draw.fDst = dst;
-
-            draw.drawPathCoverage(path, paint);
+        sk_sp<SkData> persistentKey;
+        sk_sp<SkData> persistentData;
+        if (fDistanceFieldCache) {
+            persistentKey = make_persistent_distance_field_key(path, dimension);
+            persistentData = fDistanceFieldCache->load(*persistentKey);
+            if (persistentData && persistentData->size() != (size_t)(width * height)) {
+                persistentData = nullptr;
+            }
+        }
 
-            // Generate signed distance field
-            SkGenerateDistanceFieldFromA8Image((unsigned char*)dfStorage.get(),
-                                               (const unsigned char*)dst.addr(),
-                                               dst.width(), dst.height(), dst.rowBytes());
-#ifndef SK_USE_LEGACY_DISTANCE_FIELDS
+        // TODO We should really generate this directly into the plot somehow
+        SkAutoSMalloc<1024> dfStorage;
+        const void* dfImage;
+        if (persistentData) {
+            dfImage = persistentData->data();
+        } else {
+            dfStorage.reset(width * height * sizeof(unsigned char));
+            dfImage = dfStorage.get();
+            if (!generate_distance_field(path, drawMatrix, devPathBounds, width, height,
+                                         (unsigned char*)dfStorage.get())) {
+                return false;
+            }
+            if (fDistanceFieldCache) {
+                fDistanceFieldCache->store(*persistentKey,
+                                           *SkData::MakeWithoutCopy(dfImage, width * height));
+            }
         }
-#endif
 
         // add to atlas
         SkIPoint16 atlasLocation;
         GrDrawOpAtlas::AtlasID id;
 
         if (!this->addToAtlas(target, flushInfo, atlas,
-                              width, height, dfStorage.get(), &id, &atlasLocation)) {
+                              width, height, dfImage, &id, &atlasLocation)) {
             return false;
         }
 
@@ -626,17 +681,15 @@ private:
         shapeData->fBounds.fRight /= scale;
         shapeData->fBounds.fBottom /= scale;
 
-        // We pack the 2bit page index in the low bit of the u and v texture coords
-        uint16_t pageIndex = GrDrawOpAtlas::GetPageIndexFromID(id);
-        SkASSERT(pageIndex < 4);
-        uint16_t uBit = (pageIndex >> 1) & 0x1;
-        uint16_t vBit = pageIndex & 0x1;
-        shapeData->fTextureCoords.set((atlasLocation.fX+SK_DistanceFieldPad) << 1 | uBit,
-                                      (atlasLocation.fY+SK_DistanceFieldPad) << 1 | vBit,
-                                      (atlasLocation.fX+SK_DistanceFieldPad+
-                                       devPathBounds.width()) << 1 | uBit,
-                                      (atlasLocation.fY+SK_DistanceFieldPad+
-                                       devPathBounds.height()) << 1 | vBit);
+        // We pack the page index in the low bits of the u and v texture coords
+        uint32_t pageIndex = GrDrawOpAtlas::GetPageIndexFromID(id);
+        shapeData->fTextureCoords.set(
+                GrDrawOpAtlas::PackU(atlasLocation.fX+SK_DistanceFieldPad, pageIndex),
+                GrDrawOpAtlas::PackV(atlasLocation.fY+SK_DistanceFieldPad, pageIndex),
+                GrDrawOpAtlas::PackU(atlasLocation.fX+SK_DistanceFieldPad+devPathBounds.width(),
+                                     pageIndex),
+                GrDrawOpAtlas::PackV(atlasLocation.fY+SK_DistanceFieldPad+devPathBounds.height(),
+                                     pageIndex));
 
         fShapeCache->add(shapeData);
         fShapeList->addToTail(shapeData);
@@ -724,14 +777,12 @@ private:
         shapeData->fBounds = SkRect::Make(devPathBounds);
         shapeData->fBounds.offset(-translateX, -translateY);
 
-        // We pack the 2bit page index in the low bit of the u and v texture coords
-        uint16_t pageIndex = GrDrawOpAtlas::GetPageIndexFromID(id);
-        SkASSERT(pageIndex < 4);
-        uint16_t uBit = (pageIndex >> 1) & 0x1;
-        uint16_t vBit = pageIndex & 0x1;
-        shapeData->fTextureCoords.set(atlasLocation.fX << 1 | uBit, atlasLocation.fY << 1 | vBit,
-                                      (atlasLocation.fX+width) << 1 | uBit,
-                                      (atlasLocation.fY+height) << 1 | vBit);
+        // We pack the page index in the low bits of the u and v texture coords
+        uint32_t pageIndex = GrDrawOpAtlas::GetPageIndexFromID(id);
+        shapeData->fTextureCoords.set(GrDrawOpAtlas::PackU(atlasLocation.fX, pageIndex),
+                                      GrDrawOpAtlas::PackV(atlasLocation.fY, pageIndex),
+                                      GrDrawOpAtlas::PackU(atlasLocation.fX+width, pageIndex),
+                                      GrDrawOpAtlas::PackV(atlasLocation.fY+height, pageIndex));
 
         fShapeCache->add(shapeData);
         fShapeList->addToTail(shapeData);
@@ -858,6 +909,7 @@ private:
     GrDrawOpAtlas* fAtlas;
     ShapeCache* fShapeCache;
     ShapeDataList* fShapeList;
+    GrContextOptions::PersistentCache* fDistanceFieldCache;
     bool fGammaCorrect;
     bool fWideColor;
 
@@ -890,7 +942,8 @@ bool GrSmallPathRenderer::onDrawPath(const DrawPathArgs& args) {
 
     std::unique_ptr<GrDrawOp> op = SmallPathOp::Make(
             args.fContext, std::move(args.fPaint), *args.fShape, *args.fViewMatrix, fAtlas.get(),
-            &fShapeCache, &fShapeList, args.fGammaCorrect, args.fUserStencilSettings);
+            &fShapeCache, &fShapeList, fDistanceFieldCache, args.fGammaCorrect,
+            args.fUserStencilSettings);
     args.fRenderTargetContext->addDrawOp(*args.fClip, std::move(op));
 
     return true;
@@ -951,8 +1004,8 @@ std::unique_ptr<GrDrawOp> GrSmallPathRenderer::createOp_TestingOnly(
                                                         const GrUserStencilSettings* stencil) {
 
     return GrSmallPathRenderer::SmallPathOp::Make(context, std::move(paint), shape, viewMatrix,
-                                                  atlas, shapeCache, shapeList, gammaCorrect,
-                                                  stencil);
+                                                  atlas, shapeCache, shapeList, nullptr,
+                                                  gammaCorrect, stencil);
 
 }
 
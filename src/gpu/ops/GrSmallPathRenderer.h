@@ -8,6 +8,7 @@
 #ifndef GrSmallPathRenderer_DEFINED
 #define GrSmallPathRenderer_DEFINED
 
+#include "GrContextOptions.h"
 #include "GrDrawOpAtlas.h"
 #include "GrOnFlushResourceProvider.h"
 #include "GrPathRenderer.h"
@@ -24,7 +25,10 @@ class ShapeDataKey;
 
 class GrSmallPathRenderer : public GrPathRenderer, public GrOnFlushCallbackObject {
 public:
-    GrSmallPathRenderer();
+    // A negative maxDimension selects the default limit on the local space size of shapes. Distance
+    // fields are looked up in and stored to distanceFieldCache when it is non-null.
+    GrSmallPathRenderer(SkScalar maxDimension = -1,
+                        GrContextOptions::PersistentCache* distanceFieldCache = nullptr);
     ~GrSmallPathRenderer() override;
 
     // GrOnFlushCallbackObject overrides
@@ -77,6 +81,8 @@ private:
     std::unique_ptr<GrDrawOpAtlas> fAtlas;
     ShapeCache fShapeCache;
     ShapeDataList fShapeList;
+    SkScalar fMaxDimension;
+    GrContextOptions::PersistentCache* fDistanceFieldCache;
 
     typedef GrPathRenderer INHERITED;
 };
@@ -20,6 +20,7 @@
 #include "GrSimpleMeshDrawOpHelper.h"
 #include "GrStyle.h"
 #include "GrTessellator.h"
+#include "SkAutoMalloc.h"
 #include "SkGeometry.h"
 #include "ops/GrMeshDrawOp.h"
 
@@ -108,6 +109,21 @@ private:
     void* fVertices;
 };
 
+// Tessellates into CPU memory so that the work can be done before the op has a flush target.
+class CpuVertexAllocator : public GrTessellator::VertexAllocator {
+public:
+    CpuVertexAllocator(size_t stride, SkAutoMalloc* storage)
+            : VertexAllocator(stride)
+            , fStorage(storage) {}
+    void* lock(int vertexCount) override {
+        return fStorage->reset(vertexCount * this->stride());
+    }
+    void unlock(int actualCount) override {}
+
+private:
+    SkAutoMalloc* fStorage;
+};
+
 class DynamicVertexAllocator : public GrTessellator::VertexAllocator {
 public:
     DynamicVertexAllocator(size_t stride, GrMeshDrawOp::Target* target)
@@ -137,7 +153,8 @@ private:
 
 }  // namespace
 
-GrTessellatingPathRenderer::GrTessellatingPathRenderer() {
+GrTessellatingPathRenderer::GrTessellatingPathRenderer()
+        : fTessellationCache(sk_make_sp<GrTessellationCache>()) {
 }
 
 GrPathRenderer::CanDrawPath
@@ -179,10 +196,12 @@ public:
                                           const SkMatrix& viewMatrix,
                                           SkIRect devClipBounds,
                                           GrAAType aaType,
-                                          const GrUserStencilSettings* stencilSettings) {
+                                          const GrUserStencilSettings* stencilSettings,
+                                          sk_sp<GrTessellationCache> tessellationCache) {
         return Helper::FactoryHelper<TessellatingPathOp>(context, std::move(paint), shape,
                                                          viewMatrix, devClipBounds,
-                                                         aaType, stencilSettings);
+                                                         aaType, stencilSettings,
+                                                         std::move(tessellationCache));
     }
 
     const char* name() const override { return "TessellatingPathOp"; }
@@ -207,14 +226,16 @@ public:
                        const SkMatrix& viewMatrix,
                        const SkIRect& devClipBounds,
                        GrAAType aaType,
-                       const GrUserStencilSettings* stencilSettings)
+                       const GrUserStencilSettings* stencilSettings,
+                       sk_sp<GrTessellationCache> tessellationCache)
             : INHERITED(ClassID())
             , fHelper(helperArgs, aaType, stencilSettings)
             , fColor(color)
             , fShape(shape)
             , fViewMatrix(viewMatrix)
             , fDevClipBounds(devClipBounds)
-            , fAntiAlias(GrAAType::kCoverage == aaType) {
+            , fAntiAlias(GrAAType::kCoverage == aaType)
+            , fTessellationCache(std::move(tessellationCache)) {
         SkRect devBounds;
         viewMatrix.mapRect(&devBounds, shape.bounds());
         if (shape.inverseFilled()) {
@@ -263,20 +284,47 @@ private:
         builder.finish();
         sk_sp<GrBuffer> cachedVertexBuffer(rp->findByUniqueKey<GrBuffer>(key));
         int actualCount;
-        SkScalar tol = GrPathUtils::kDefaultTolerance;
-        tol = GrPathUtils::scaleToleranceToSrc(tol, fViewMatrix, fShape.bounds());
+        SkScalar tol = this->srcTolerance();
         if (cache_match(cachedVertexBuffer.get(), tol, &actualCount)) {
+            fPrePreparedTessellation = GrTessellationCache::Tessellation();
             this->drawVertices(target, std::move(gp), std::move(cachedVertexBuffer), 0,
                                actualCount);
             return;
         }
 
-        SkRect clipBounds = SkRect::Make(fDevClipBounds);
-
         SkMatrix vmi;
         if (!fViewMatrix.invert(&vmi)) {
             return;
         }
+
+        if (this->canUseTessellationCache()) {
+            // Take the vertices from prePrepare(), or the CPU-side cache, before tessellating.
+            GrTessellationCache::Tessellation tess;
+            if (fPrePreparedTessellation.fVertices &&
+                fPrePreparedTessellation.fVertexStride == vertexStride) {
+                tess = std::move(fPrePreparedTessellation);
+                fTessellationCache->add(fShape, tol, tess);
+            } else if (!fTessellationCache->find(fShape, tol, vertexStride, &tess)) {
+                if (!this->tessellateForCache(tol, vertexStride, &tess)) {
+                    return;
+                }
+                fTessellationCache->add(fShape, tol, tess);
+            }
+            fPrePreparedTessellation = GrTessellationCache::Tessellation();
+            sk_sp<GrBuffer> vb = rp->createBuffer(tess.fVertexCount * vertexStride,
+                                                  kVertex_GrBufferType, kStatic_GrAccessPattern,
+                                                  GrResourceProvider::Flags::kNone,
+                                                  tess.fVertices->data());
+            if (!vb) {
+                return;
+            }
+            SkScalar vbTolerance = tess.fIsLinear ? 0 : GrTessellationCache::BucketTolerance(tol);
+            this->assignVertexBufferKey(target, &key, vb.get(), vbTolerance, tess.fVertexCount);
+            this->drawVertices(target, std::move(gp), std::move(vb), 0, tess.fVertexCount);
+            return;
+        }
+
+        SkRect clipBounds = SkRect::Make(fDevClipBounds);
         vmi.mapRect(&clipBounds);
         bool isLinear;
         bool canMapVB = GrCaps::kNone_MapFlags != target->caps().mapBufferFlags();
@@ -287,18 +335,106 @@ private:
             return;
         }
         sk_sp<GrBuffer> vb = allocator.detachVertexBuffer();
+        this->assignVertexBufferKey(target, &key, vb.get(), isLinear ? 0 : tol, count);
+        this->drawVertices(target, std::move(gp), std::move(vb), 0, count);
+    }
+
+    void assignVertexBufferKey(Target* target, GrUniqueKey* key, GrBuffer* vb, SkScalar tolerance,
+                               int count) {
         TessInfo info;
-        info.fTolerance = isLinear ? 0 : tol;
+        info.fTolerance = tolerance;
         info.fCount = count;
-        fShape.addGenIDChangeListener(sk_make_sp<PathInvalidator>(key, target->contextUniqueID()));
-        key.setCustomData(SkData::MakeWithCopy(&info, sizeof(info)));
-        rp->assignUniqueKeyToResource(key, vb.get());
+        fShape.addGenIDChangeListener(sk_make_sp<PathInvalidator>(*key,
+                                                                  target->contextUniqueID()));
+        key->setCustomData(SkData::MakeWithCopy(&info, sizeof(info)));
+        target->resourceProvider()->assignUniqueKeyToResource(*key, vb);
+    }
 
-        this->drawVertices(target, std::move(gp), std::move(vb), 0, count);
+    SkScalar srcTolerance() const {
+        return GrPathUtils::scaleToleranceToSrc(GrPathUtils::kDefaultTolerance, fViewMatrix,
+                                                fShape.bounds());
+    }
+
+    // Non-AA fills are tessellated in path space, so they are independent of the view matrix and
+    // can go through the CPU-side cache. Inverse fills also depend on the clip bounds.
+    bool canUseTessellationCache() const {
+        return fTessellationCache && !fAntiAlias && !fShape.inverseFilled();
+    }
+
+    // Tessellates into CPU memory at the tolerance of the cache bucket that contains 'tol'.
+    bool tessellateForCache(SkScalar tol, size_t vertexStride,
+                            GrTessellationCache::Tessellation* tess) const {
+        SkASSERT(this->canUseTessellationCache());
+        SkAutoMalloc storage;
+        CpuVertexAllocator allocator(vertexStride, &storage);
+        bool isLinear;
+        // The clip bounds are only used by inverse fills.
+        int count = GrTessellator::PathToTriangles(this->getPath(),
+                                                   GrTessellationCache::BucketTolerance(tol),
+                                                   SkRect::MakeEmpty(), &allocator, false,
+                                                   &isLinear);
+        if (count <= 0) {
+            return false;
+        }
+        tess->fVertices = SkData::MakeWithCopy(storage.get(), count * vertexStride);
+        tess->fVertexCount = count;
+        tess->fVertexStride = vertexStride;
+        tess->fIsLinear = isLinear;
+        return true;
+    }
+
+    // The antialiased tessellation is a position and a float coverage per vertex, and doesn't use
+    // the resource provider's cache, so it can be computed ahead of onPrepareDraws().
+    static constexpr size_t kAAVertexStride = sizeof(SkPoint) + sizeof(float);
+    // Non-AA vertices are just positions.
+    static constexpr size_t kNonAAVertexStride = sizeof(SkPoint);
+
+    void onPrePrepare() override {
+        if (this->canUseTessellationCache()) {
+            // The GPU-side vertex buffer cache can't be checked off the flush thread, so only
+            // tessellate paths that miss the CPU-side cache.
+            SkScalar tol = this->srcTolerance();
+            GrTessellationCache::Tessellation tess;
+            if (!fTessellationCache->find(fShape, tol, kNonAAVertexStride, &tess)) {
+                this->tessellateForCache(tol, kNonAAVertexStride, &fPrePreparedTessellation);
+            }
+            return;
+        }
+        if (!fAntiAlias) {
+            return;
+        }
+        SkPath path = getPath();
+        fPrePreparedCount = 0;
+        if (path.isEmpty()) {
+            return;
+        }
+        path.transform(fViewMatrix);
+        bool isLinear;
+        CpuVertexAllocator allocator(kAAVertexStride, &fPrePreparedVertices);
+        fPrePreparedCount = GrTessellator::PathToTriangles(path, GrPathUtils::kDefaultTolerance,
+                                                           SkRect::Make(fDevClipBounds),
+                                                           &allocator, true, &isLinear);
     }
 
     void drawAA(Target* target, sk_sp<const GrGeometryProcessor> gp, size_t vertexStride) {
         SkASSERT(fAntiAlias);
+        if (fPrePreparedCount >= 0 && vertexStride == kAAVertexStride) {
+            int count = fPrePreparedCount;
+            fPrePreparedCount = -1;
+            if (count == 0) {
+                return;
+            }
+            sk_sp<const GrBuffer> vb;
+            int firstVertex;
+            void* verts = target->makeVertexSpace(vertexStride, count, &vb, &firstVertex);
+            if (!verts) {
+                return;
+            }
+            memcpy(verts, fPrePreparedVertices.get(), count * vertexStride);
+            fPrePreparedVertices.reset(0);
+            this->drawVertices(target, std::move(gp), std::move(vb), firstVertex, count);
+            return;
+        }
         SkPath path = getPath();
         if (path.isEmpty()) {
             return;
@@ -373,6 +509,12 @@ private:
     SkMatrix                fViewMatrix;
     SkIRect                 fDevClipBounds;
     bool                    fAntiAlias;
+    // Set by onPrePrepare(); -1 means drawAA() must tessellate on its own.
+    int                     fPrePreparedCount = -1;
+    SkAutoMalloc            fPrePreparedVertices;
+    sk_sp<GrTessellationCache> fTessellationCache;
+    // Set by onPrePrepare() for non-AA paths that missed the tessellation cache.
+    GrTessellationCache::Tessellation fPrePreparedTessellation;
 
     typedef GrMeshDrawOp INHERITED;
 };
@@ -392,7 +534,8 @@ bool GrTessellatingPathRenderer::onDrawPath(const DrawPathArgs& args) {
                                                             *args.fViewMatrix,
                                                             clipBoundsI,
                                                             args.fAAType,
-                                                            args.fUserStencilSettings);
+                                                            args.fUserStencilSettings,
+                                                            fTessellationCache);
     args.fRenderTargetContext->addDrawOp(*args.fClip, std::move(op));
     return true;
 }
@@ -418,7 +561,7 @@ GR_DRAW_OP_TEST_DEFINE(TesselatingPathOp) {
     } while (!style.isSimpleFill());
     GrShape shape(path, style);
     return TessellatingPathOp::Make(context, std::move(paint), shape, viewMatrix, devClipBounds,
-                                    aaType, GrGetRandomStencil(random, context));
+                                    aaType, GrGetRandomStencil(random, context), nullptr);
 }
 
 #endif
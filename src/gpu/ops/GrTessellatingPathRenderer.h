@@ -9,6 +9,7 @@
 #define GrTessellatingPathRenderer_DEFINED
 
 #include "GrPathRenderer.h"
+#include "GrTessellationCache.h"
 
 /**
  *  Subclass that renders the path by converting to screen-space trapezoids plus
@@ -27,6 +28,9 @@ private:
 
     bool onDrawPath(const DrawPathArgs&) override;
 
+    // Non-AA tessellations are kept on the CPU so they can be re-uploaded under new matrices.
+    sk_sp<GrTessellationCache> fTessellationCache;
+
     typedef GrPathRenderer INHERITED;
 };
 
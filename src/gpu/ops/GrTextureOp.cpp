@@ -293,8 +293,9 @@ private:
         fWideColor = static_cast<unsigned>(false);
     }
 
-    void tess(void* v, const VertexSpec& spec, const GrTextureProxy* proxy, int start,
-              int cnt) const {
+    // Returns the advanced pointer in v.
+    void* tess(void* v, const VertexSpec& spec, const GrTextureProxy* proxy, int start, int cnt,
+               int textureIndex) const {
         TRACE_EVENT0("skia", TRACE_FUNC);
         auto origin = proxy->origin();
         const auto* texture = proxy->peekTexture();
@@ -316,8 +317,9 @@ private:
             SkRect domain =
                     compute_domain(info.domain(), this->filter(), origin, info.fSrcRect, iw, ih, h);
             v = GrQuadPerEdgeAA::Tessellate(v, spec, device, info.fColor, srcQuad, domain,
-                                            info.aaFlags());
+                                            info.aaFlags(), textureIndex);
         }
+        return v;
     }
 
     void onPrepareDraws(Target* target) override {
@@ -325,11 +327,18 @@ private:
         GrQuadType quadType = GrQuadType::kRect;
         Domain domain = Domain::kNo;
         bool wideColor = false;
-        int numProxies = 0;
         int numTotalQuads = 0;
         auto textureType = fProxies[0].fProxy->textureType();
         auto config = fProxies[0].fProxy->config();
         GrAAType aaType = this->aaType();
+        // The quads of each proxy in the chain, in draw order.
+        struct ProxyQuads {
+            const TextureOp* fOp;
+            GrTextureProxy* fProxy;
+            int fStart;
+            int fCnt;
+        };
+        SkSTArray<8, ProxyQuads, true> proxyQuads;
         for (const auto& op : ChainRange<TextureOp>(this)) {
             if (op.fQuads.quadType() > quadType) {
                 quadType = op.fQuads.quadType();
@@ -338,25 +347,25 @@ private:
                 domain = Domain::kYes;
             }
             wideColor |= op.fWideColor;
-            numProxies += op.fProxyCnt;
+            int q = 0;
             for (unsigned p = 0; p < op.fProxyCnt; ++p) {
-                numTotalQuads += op.fProxies[p].fQuadCnt;
+                int quadCnt = op.fProxies[p].fQuadCnt;
+                numTotalQuads += quadCnt;
                 auto* proxy = op.fProxies[p].fProxy;
                 if (!proxy->instantiate(target->resourceProvider())) {
                     return;
                 }
                 SkASSERT(proxy->config() == config);
                 SkASSERT(proxy->textureType() == textureType);
+                proxyQuads.push_back({&op, proxy, q, quadCnt});
+                q += quadCnt;
             }
             if (op.aaType() == GrAAType::kCoverage) {
                 SkASSERT(aaType == GrAAType::kCoverage || aaType == GrAAType::kNone);
                 aaType = GrAAType::kCoverage;
             }
         }
-
-        VertexSpec vertexSpec(quadType, wideColor ? ColorType::kHalf : ColorType::kByte,
-                              GrQuadType::kRect, /* hasLocal */ true, domain, aaType,
-                              /* alpha as coverage */ true);
+        int numProxies = proxyQuads.count();
 
         GrSamplerState samplerState = GrSamplerState(GrSamplerState::WrapMode::kClamp,
                                                      this->filter());
@@ -364,9 +373,25 @@ private:
         uint32_t extraSamplerKey = gpu->getExtraSamplerKeyForProgram(
                 samplerState, fProxies[0].fProxy->backendFormat());
 
+        // Each mesh samples from up to textureCnt of the proxies, picked per quad. External
+        // textures whose samplers need a key of their own (e.g. a Vulkan YCbCr conversion) are
+        // bound one at a time. Other extra keys only depend on the sampler state, which all the
+        // proxies share.
+        int textureCnt = 1;
+        if (!extraSamplerKey || GrTextureType::kExternal != fProxies[0].fProxy->textureType()) {
+            textureCnt = SkTMin(numProxies, SkTMin(GrQuadPerEdgeAA::kMaxTextures,
+                                target->caps().shaderCaps()->maxFragmentSamplers()));
+            textureCnt = SkTMax(textureCnt, 1);
+        }
+        int numMeshes = (numProxies + textureCnt - 1) / textureCnt;
+
+        VertexSpec vertexSpec(quadType, wideColor ? ColorType::kHalf : ColorType::kByte,
+                              GrQuadType::kRect, /* hasLocal */ true, domain, aaType,
+                              /* alpha as coverage */ true, /* texture index */ textureCnt > 1);
+
         sk_sp<GrGeometryProcessor> gp = GrQuadPerEdgeAA::MakeTexturedProcessor(
                 vertexSpec, *target->caps().shaderCaps(),
-                textureType, config, samplerState, extraSamplerKey,
+                textureType, config, textureCnt, samplerState, extraSamplerKey,
                 std::move(fTextureColorSpaceXform));
 
         GrPipeline::InitArgs args;
@@ -378,71 +403,75 @@ private:
         }
 
         auto clip = target->detachAppliedClip();
-        // We'll use a dynamic state array for the GP textures when there are multiple ops.
-        // Otherwise, we use fixed dynamic state to specify the single op's proxy.
+        // We'll use a dynamic state array for the GP textures when there are multiple meshes.
+        // Otherwise, we use fixed dynamic state to specify the single mesh's proxies.
         GrPipeline::DynamicStateArrays* dynamicStateArrays = nullptr;
         GrPipeline::FixedDynamicState* fixedDynamicState;
-        if (numProxies > 1) {
-            dynamicStateArrays = target->allocDynamicStateArrays(numProxies, 1, false);
+        GrTextureProxy** meshTextures;
+        if (numMeshes > 1) {
+            dynamicStateArrays = target->allocDynamicStateArrays(numMeshes, textureCnt, false);
             fixedDynamicState = target->allocFixedDynamicState(clip.scissorState().rect(), 0);
+            meshTextures = dynamicStateArrays->fPrimitiveProcessorTextures;
         } else {
-            fixedDynamicState = target->allocFixedDynamicState(clip.scissorState().rect(), 1);
-            fixedDynamicState->fPrimitiveProcessorTextures[0] = fProxies[0].fProxy;
+            fixedDynamicState = target->allocFixedDynamicState(clip.scissorState().rect(),
+                                                               textureCnt);
+            meshTextures = fixedDynamicState->fPrimitiveProcessorTextures;
         }
         const auto* pipeline =
                 target->allocPipeline(args, GrProcessorSet::MakeEmptySet(), std::move(clip));
 
         size_t vertexSize = gp->vertexStride();
 
-        GrMesh* meshes = target->allocMeshes(numProxies);
+        GrMesh* meshes = target->allocMeshes(numMeshes);
         sk_sp<const GrBuffer> vbuffer;
         int vertexOffsetInBuffer = 0;
         int numQuadVerticesLeft = numTotalQuads * vertexSpec.verticesPerQuad();
         int numAllocatedVertices = 0;
         void* vdata = nullptr;
 
-        int m = 0;
-        for (const auto& op : ChainRange<TextureOp>(this)) {
-            int q = 0;
-            for (unsigned p = 0; p < op.fProxyCnt; ++p) {
-                int quadCnt = op.fProxies[p].fQuadCnt;
-                auto* proxy = op.fProxies[p].fProxy;
-                int meshVertexCnt = quadCnt * vertexSpec.verticesPerQuad();
-                if (numAllocatedVertices < meshVertexCnt) {
-                    vdata = target->makeVertexSpaceAtLeast(
-                            vertexSize, meshVertexCnt, numQuadVerticesLeft, &vbuffer,
-                            &vertexOffsetInBuffer, &numAllocatedVertices);
-                    SkASSERT(numAllocatedVertices <= numQuadVerticesLeft);
-                    if (!vdata) {
-                        SkDebugf("Could not allocate vertices\n");
-                        return;
-                    }
+        for (int m = 0; m < numMeshes; ++m) {
+            int first = m * textureCnt;
+            int last = SkTMin(first + textureCnt, numProxies);
+            int quadCnt = 0;
+            for (int i = first; i < last; ++i) {
+                quadCnt += proxyQuads[i].fCnt;
+            }
+            int meshVertexCnt = quadCnt * vertexSpec.verticesPerQuad();
+            if (numAllocatedVertices < meshVertexCnt) {
+                vdata = target->makeVertexSpaceAtLeast(
+                        vertexSize, meshVertexCnt, numQuadVerticesLeft, &vbuffer,
+                        &vertexOffsetInBuffer, &numAllocatedVertices);
+                SkASSERT(numAllocatedVertices <= numQuadVerticesLeft);
+                if (!vdata) {
+                    SkDebugf("Could not allocate vertices\n");
+                    return;
                 }
-                SkASSERT(numAllocatedVertices >= meshVertexCnt);
+            }
+            SkASSERT(numAllocatedVertices >= meshVertexCnt);
 
-                op.tess(vdata, vertexSpec, proxy, q, quadCnt);
+            for (int i = first; i < last; ++i) {
+                const ProxyQuads& pq = proxyQuads[i];
+                vdata = pq.fOp->tess(vdata, vertexSpec, pq.fProxy, pq.fStart, pq.fCnt, i - first);
+            }
 
-                if (!GrQuadPerEdgeAA::ConfigureMeshIndices(target, &(meshes[m]), vertexSpec,
-                                                           quadCnt)) {
-                    SkDebugf("Could not allocate indices");
-                    return;
-                }
-                meshes[m].setVertexData(vbuffer, vertexOffsetInBuffer);
-                if (dynamicStateArrays) {
-                    dynamicStateArrays->fPrimitiveProcessorTextures[m] = proxy;
-                }
-                ++m;
-                numAllocatedVertices -= meshVertexCnt;
-                numQuadVerticesLeft -= meshVertexCnt;
-                vertexOffsetInBuffer += meshVertexCnt;
-                vdata = reinterpret_cast<char*>(vdata) + vertexSize * meshVertexCnt;
-                q += quadCnt;
+            if (!GrQuadPerEdgeAA::ConfigureMeshIndices(target, &(meshes[m]), vertexSpec,
+                                                       quadCnt)) {
+                SkDebugf("Could not allocate indices");
+                return;
+            }
+            meshes[m].setVertexData(vbuffer, vertexOffsetInBuffer);
+            // A last mesh with fewer proxies repeats its final one in the unused samplers.
+            for (int t = 0; t < textureCnt; ++t) {
+                meshTextures[m * textureCnt + t] = proxyQuads[SkTMin(first + t, last - 1)].fProxy;
             }
+            numAllocatedVertices -= meshVertexCnt;
+            numQuadVerticesLeft -= meshVertexCnt;
+            vertexOffsetInBuffer += meshVertexCnt;
         }
         SkASSERT(!numQuadVerticesLeft);
         SkASSERT(!numAllocatedVertices);
         target->draw(std::move(gp), pipeline, fixedDynamicState, dynamicStateArrays, meshes,
-                     numProxies);
+                     numMeshes);
     }
 
     CombineResult onCombineIfPossible(GrOp* t, const GrCaps& caps) override {
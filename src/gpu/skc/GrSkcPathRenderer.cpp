@@ -0,0 +1,417 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrSkcPathRenderer.h"
+
+#include "GrAuditTrail.h"
+#include "GrCaps.h"
+#include "GrRenderTargetContext.h"
+#include "GrSWMaskHelper.h"
+#include "GrShape.h"
+#include "GrSoftwarePathRenderer.h"
+#include "GrTextureProxy.h"
+#include "SkAutoPixmapStorage.h"
+#include "SkGeometry.h"
+#include "SkPath.h"
+#include "SkTemplates.h"
+
+extern "C" {
+#include "common/cl/find_cl.h"
+#include "skc.h"
+#include "platforms/cl_12/skc_cl.h"
+}
+
+namespace {
+
+enum Layer : skc_layer_id {
+    kNonZero_Layer,
+    kEvenOdd_Layer,
+
+    kLast_Layer = kEvenOdd_Layer
+};
+
+}  // anonymous namespace
+
+/**
+ * Owns the OpenCL device and the skc objects shared by every path this renderer draws. The styling
+ * never changes: both layers fill with opaque white over transparent black, so the coverage of the
+ * path ends up in every channel of the framebuffer.
+ */
+class GrSkcPathRenderer::Context {
+public:
+    static std::unique_ptr<Context> Make() {
+        // skc only has kernels for Intel's Gen9 GPUs.
+        cl_platform_id platformID;
+        cl_device_id deviceID;
+        if (CL_SUCCESS != clFindIdsByName("Intel", "Graphics", &platformID, &deviceID,
+                                          0, nullptr, nullptr, false)) {
+            return nullptr;
+        }
+        cl_context_properties properties[] = {
+            CL_CONTEXT_PLATFORM, (cl_context_properties)platformID,
+            0
+        };
+        cl_int err;
+        cl_context clContext = clCreateContext(properties, 1, &deviceID, nullptr, nullptr, &err);
+        if (CL_SUCCESS != err) {
+            return nullptr;
+        }
+        std::unique_ptr<Context> context(new Context(clContext, deviceID));
+        if (!context->init()) {
+            return nullptr;
+        }
+        return context;
+    }
+
+    ~Context() {
+        if (fImage) {
+            clReleaseMemObject(fImage);
+        }
+        if (fQueue) {
+            clReleaseCommandQueue(fQueue);
+        }
+        if (fSurface) {
+            skc_surface_release(fSurface);
+        }
+        if (fStyling) {
+            skc_styling_release(fStyling);
+        }
+        if (fComposition) {
+            skc_composition_release(fComposition);
+        }
+        if (fRasterBuilder) {
+            skc_raster_builder_release(fRasterBuilder);
+        }
+        if (fPathBuilder) {
+            skc_path_builder_release(fPathBuilder);
+        }
+        if (fContext) {
+            skc_context_release(fContext);
+        }
+        clReleaseContext(fCLContext);
+    }
+
+    // Rasterizes the path's coverage, as drawn with viewMatrix, into the A8 mask. maskBounds is
+    // the device space rect the mask covers.
+    bool rasterize(const SkPath& path, const SkMatrix& viewMatrix, const SkIRect& maskBounds,
+                   SkAutoPixmapStorage* mask) {
+        SkASSERT(!viewMatrix.hasPerspective());
+        SkASSERT(mask->width() == maskBounds.width() && mask->height() == maskBounds.height());
+
+        if (!this->ensureImage(maskBounds.width(), maskBounds.height())) {
+            return false;
+        }
+
+        skc_path_t skcPath;
+        if (!this->buildPath(path, &skcPath)) {
+            return false;
+        }
+
+        // skc transforms are a row-major projective 3x3 matrix with the last entry implied.
+        SkMatrix matrix = viewMatrix;
+        matrix.postTranslate(-SkIntToScalar(maskBounds.fLeft), -SkIntToScalar(maskBounds.fTop));
+        const float transform[8] = {
+            matrix.getScaleX(), matrix.getSkewX(),  matrix.getTranslateX(),
+            matrix.getSkewY(),  matrix.getScaleY(), matrix.getTranslateY(),
+            0, 0,
+        };
+        const float clip[4] = {
+            0, 0, SkIntToScalar(maskBounds.width()), SkIntToScalar(maskBounds.height())
+        };
+        skc_transform_weakref_t transformWeakref = SKC_WEAKREF_INVALID;
+        skc_raster_clip_weakref_t clipWeakref = SKC_WEAKREF_INVALID;
+
+        skc_raster_t raster;
+        bool ok = SKC_ERR_SUCCESS == skc_raster_begin(fRasterBuilder) &&
+                  SKC_ERR_SUCCESS == skc_raster_add_filled(fRasterBuilder, skcPath,
+                                                           &transformWeakref, transform,
+                                                           &clipWeakref, clip) &&
+                  SKC_ERR_SUCCESS == skc_raster_end(fRasterBuilder, &raster);
+        // The raster holds onto the path now.
+        skc_path_release(fContext, &skcPath, 1);
+        if (!ok) {
+            return false;
+        }
+
+        const skc_layer_id layer = path.getFillType() == SkPath::kEvenOdd_FillType
+                                           ? kEvenOdd_Layer : kNonZero_Layer;
+        ok = SKC_ERR_SUCCESS == skc_composition_unseal(fComposition, true) &&
+             SKC_ERR_SUCCESS == skc_composition_place(fComposition, &raster, &layer,
+                                                      nullptr, nullptr, 1) &&
+             SKC_ERR_SUCCESS == skc_composition_seal(fComposition);
+        // And the composition holds onto the raster.
+        skc_raster_release(fContext, &raster, 1);
+        if (!ok) {
+            return false;
+        }
+
+        skc_framebuffer_cl framebuffer = { SKC_FRAMEBUFFER_CL_IMAGE2D, fImage, nullptr, nullptr };
+        const uint32_t renderClip[4] = {
+            0, 0, (uint32_t)maskBounds.width(), (uint32_t)maskBounds.height()
+        };
+        const int32_t txty[2] = { 0, 0 };
+        bool rendered = false;
+        auto notify = [](skc_surface_t, skc_styling_t, skc_composition_t, skc_framebuffer_t,
+                         void* data) {
+            *static_cast<bool*>(data) = true;
+        };
+        if (SKC_ERR_SUCCESS != skc_surface_render(fSurface, fStyling, fComposition, &framebuffer,
+                                                  renderClip, txty, notify, &rendered)) {
+            return false;
+        }
+        while (!rendered) {
+            skc_context_wait(fContext);
+        }
+
+        return this->readCoverage(maskBounds.width(), maskBounds.height(), mask);
+    }
+
+private:
+    Context(cl_context clContext, cl_device_id deviceID)
+            : fCLContext(clContext), fDeviceID(deviceID) {}
+
+    bool init() {
+        // Every handle is left null if its creation fails, so the destructor can tell what to free.
+        auto created = [](skc_err err, auto* handle) {
+            if (SKC_ERR_SUCCESS != err) {
+                *handle = nullptr;
+                return false;
+            }
+            return true;
+        };
+        if (!created(skc_context_create_cl(&fContext, fCLContext, fDeviceID), &fContext) ||
+            !created(skc_path_builder_create(fContext, &fPathBuilder), &fPathBuilder) ||
+            !created(skc_raster_builder_create(fContext, &fRasterBuilder), &fRasterBuilder) ||
+            !created(skc_composition_create(fContext, &fComposition), &fComposition) ||
+            !created(skc_styling_create(fContext, &fStyling, kLast_Layer + 1, 1, 16), &fStyling) ||
+            !created(skc_surface_create(fContext, &fSurface), &fSurface)) {
+            return false;
+        }
+
+        skc_group_id group;
+        skc_styling_group_alloc(fStyling, &group);
+        skc_styling_group_parents(fStyling, group, 0, nullptr);
+        skc_styling_group_range_lo(fStyling, group, 0);
+        skc_styling_group_range_hi(fStyling, group, kLast_Layer);
+
+        const skc_styling_cmd_t enter[] = {
+            SKC_STYLING_OPCODE_COLOR_ACC_ZERO | SKC_STYLING_OPCODE_IS_FINAL
+        };
+        skc_styling_group_enter(fStyling, group, SK_ARRAY_COUNT(enter), enter);
+
+        const float transparent[4] = { 0, 0, 0, 0 };
+        skc_styling_cmd_t leave[3 + 1];
+        skc_styling_background_over_encoder(leave, transparent);
+        leave[3] = SKC_STYLING_OPCODE_SURFACE_COMPOSITE | SKC_STYLING_OPCODE_IS_FINAL;
+        skc_styling_group_leave(fStyling, group, SK_ARRAY_COUNT(leave), leave);
+
+        const float white[4] = { 1, 1, 1, 1 };
+        for (skc_layer_id layer : { kNonZero_Layer, kEvenOdd_Layer }) {
+            skc_styling_cmd_t cmds[1 + 3 + 1];
+            cmds[0] = kEvenOdd_Layer == layer ? SKC_STYLING_OPCODE_COVER_EVENODD
+                                              : SKC_STYLING_OPCODE_COVER_NONZERO;
+            skc_styling_layer_fill_rgba_encoder(cmds + 1, white);
+            cmds[4] = SKC_STYLING_OPCODE_BLEND_OVER | SKC_STYLING_OPCODE_IS_FINAL;
+            skc_styling_group_layer(fStyling, group, layer, SK_ARRAY_COUNT(cmds), cmds);
+        }
+        if (SKC_ERR_SUCCESS != skc_styling_seal(fStyling)) {
+            return false;
+        }
+
+        cl_int err;
+        fQueue = clCreateCommandQueue(fCLContext, fDeviceID, 0, &err);
+        return CL_SUCCESS == err;
+    }
+
+    // The framebuffer only ever grows, in powers of two, so that it is rarely reallocated.
+    bool ensureImage(int width, int height) {
+        if (fImage && width <= fImageWidth && height <= fImageHeight) {
+            return true;
+        }
+        if (fImage) {
+            clReleaseMemObject(fImage);
+            fImage = nullptr;
+        }
+        fImageWidth = SkTMax(fImageWidth, (int)SkNextPow2(width));
+        fImageHeight = SkTMax(fImageHeight, (int)SkNextPow2(height));
+
+        const cl_image_format format = { CL_RGBA, CL_UNORM_INT8 };
+        cl_image_desc desc;
+        memset(&desc, 0, sizeof(desc));
+        desc.image_type = CL_MEM_OBJECT_IMAGE2D;
+        desc.image_width = fImageWidth;
+        desc.image_height = fImageHeight;
+        cl_int err;
+        fImage = clCreateImage(fCLContext, CL_MEM_WRITE_ONLY, &format, &desc, nullptr, &err);
+        if (CL_SUCCESS != err) {
+            fImage = nullptr;
+            fImageWidth = fImageHeight = 0;
+            return false;
+        }
+        return true;
+    }
+
+    bool buildPath(const SkPath& path, skc_path_t* skcPath) {
+        if (SKC_ERR_SUCCESS != skc_path_begin(fPathBuilder)) {
+            return false;
+        }
+        SkPath::Iter iter(path, true);
+        SkPoint pts[4];
+        SkPath::Verb verb;
+        while ((verb = iter.next(pts, false)) != SkPath::kDone_Verb) {
+            switch (verb) {
+                case SkPath::kMove_Verb:
+                    skc_path_move_to(fPathBuilder, pts[0].fX, pts[0].fY);
+                    break;
+                case SkPath::kLine_Verb:
+                    skc_path_line_to(fPathBuilder, pts[1].fX, pts[1].fY);
+                    break;
+                case SkPath::kQuad_Verb:
+                    skc_path_quad_to(fPathBuilder, pts[1].fX, pts[1].fY, pts[2].fX, pts[2].fY);
+                    break;
+                case SkPath::kConic_Verb: {
+                    SkAutoConicToQuads converter;
+                    const SkPoint* quads = converter.computeQuads(pts, iter.conicWeight(), 0.25f);
+                    for (int i = 0; i < converter.countQuads(); ++i) {
+                        skc_path_quad_to(fPathBuilder, quads[2 * i + 1].fX, quads[2 * i + 1].fY,
+                                         quads[2 * i + 2].fX, quads[2 * i + 2].fY);
+                    }
+                    break;
+                }
+                case SkPath::kCubic_Verb:
+                    skc_path_cubic_to(fPathBuilder, pts[1].fX, pts[1].fY, pts[2].fX, pts[2].fY,
+                                      pts[3].fX, pts[3].fY);
+                    break;
+                case SkPath::kClose_Verb:
+                    skc_path_close(fPathBuilder);
+                    break;
+                case SkPath::kDone_Verb:
+                    break;
+            }
+        }
+        return SKC_ERR_SUCCESS == skc_path_end(fPathBuilder, skcPath);
+    }
+
+    bool readCoverage(int width, int height, SkAutoPixmapStorage* mask) {
+        fReadback.reset(width * height);
+        const size_t origin[3] = { 0, 0, 0 };
+        const size_t region[3] = { (size_t)width, (size_t)height, 1 };
+        if (CL_SUCCESS != clEnqueueReadImage(fQueue, fImage, CL_TRUE, origin, region,
+                                             width * sizeof(uint32_t), 0, fReadback.get(),
+                                             0, nullptr, nullptr)) {
+            return false;
+        }
+        // White over transparent black leaves the coverage in every channel; take alpha.
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(fReadback.get());
+        for (int y = 0; y < height; ++y) {
+            uint8_t* dst = mask->writable_addr8(0, y);
+            for (int x = 0; x < width; ++x) {
+                dst[x] = src[4 * (y * width + x) + 3];
+            }
+        }
+        return true;
+    }
+
+    cl_context            fCLContext;
+    cl_device_id          fDeviceID;
+    cl_command_queue      fQueue = nullptr;
+    cl_mem                fImage = nullptr;
+    int                   fImageWidth = 0;
+    int                   fImageHeight = 0;
+    SkAutoTMalloc<uint32_t> fReadback;
+
+    skc_context_t         fContext = nullptr;
+    skc_path_builder_t    fPathBuilder = nullptr;
+    skc_raster_builder_t  fRasterBuilder = nullptr;
+    skc_composition_t     fComposition = nullptr;
+    skc_styling_t         fStyling = nullptr;
+    skc_surface_t         fSurface = nullptr;
+};
+
+bool GrSkcPathRenderer::IsSupported(const GrCaps& caps) {
+    return caps.isConfigTexturable(kAlpha_8_GrPixelConfig);
+}
+
+sk_sp<GrSkcPathRenderer> GrSkcPathRenderer::CreateIfSupported(const GrCaps& caps) {
+    if (!IsSupported(caps)) {
+        return nullptr;
+    }
+    std::unique_ptr<Context> context = Context::Make();
+    if (!context) {
+        return nullptr;
+    }
+    return sk_sp<GrSkcPathRenderer>(new GrSkcPathRenderer(std::move(context)));
+}
+
+GrSkcPathRenderer::GrSkcPathRenderer(std::unique_ptr<Context> context)
+        : fContext(std::move(context)) {}
+
+GrSkcPathRenderer::~GrSkcPathRenderer() = default;
+
+GrPathRenderer::CanDrawPath GrSkcPathRenderer::onCanDrawPath(const CanDrawPathArgs& args) const {
+    // We pass on strokes, which may come back around as fills once their style is applied.
+    const GrShape& shape = *args.fShape;
+    if (!shape.style().isSimpleFill() || shape.inverseFilled() ||
+        GrAAType::kCoverage != args.fAAType || args.fViewMatrix->hasPerspective()) {
+        return CanDrawPath::kNo;
+    }
+
+    SkPath path;
+    shape.asPath(&path);
+    if (path.countVerbs() < kMinVerbCount) {
+        return CanDrawPath::kNo;
+    }
+
+    SkRect devBounds;
+    args.fViewMatrix->mapRect(&devBounds, shape.bounds());
+    SkIRect clippedBounds;
+    devBounds.roundOut(&clippedBounds);
+    if (!clippedBounds.intersect(*args.fClipConservativeBounds)) {
+        return CanDrawPath::kYes;
+    }
+    int maxSize = SkTMin(kMaxMaskSize, args.fCaps->maxTextureSize());
+    if (clippedBounds.width() > maxSize || clippedBounds.height() > maxSize) {
+        return CanDrawPath::kNo;
+    }
+    return CanDrawPath::kYes;
+}
+
+bool GrSkcPathRenderer::onDrawPath(const DrawPathArgs& args) {
+    GR_AUDIT_TRAIL_AUTO_FRAME(args.fRenderTargetContext->auditTrail(),
+                              "GrSkcPathRenderer::onDrawPath");
+    SkASSERT(!args.fShape->style().applies());
+    SkASSERT(!args.fShape->inverseFilled());
+
+    SkIRect unclippedDevShapeBounds, clippedDevShapeBounds, devClipBounds;
+    if (!GrSoftwarePathRenderer::GetShapeAndClipBounds(args.fRenderTargetContext,
+                                                       *args.fClip, *args.fShape,
+                                                       *args.fViewMatrix, &unclippedDevShapeBounds,
+                                                       &clippedDevShapeBounds, &devClipBounds)) {
+        return true;
+    }
+
+    SkPath path;
+    args.fShape->asPath(&path);
+
+    SkAutoPixmapStorage pixels;
+    GrSWMaskHelper helper(&pixels);
+    if (!helper.init(clippedDevShapeBounds) ||
+        !fContext->rasterize(path, *args.fViewMatrix, clippedDevShapeBounds, &pixels)) {
+        return false;
+    }
+    sk_sp<GrTextureProxy> proxy = helper.toTextureProxy(args.fContext, SkBackingFit::kApprox);
+    if (!proxy) {
+        return false;
+    }
+
+    GrSoftwarePathRenderer::DrawToTargetWithShapeMask(
+            std::move(proxy), args.fRenderTargetContext, std::move(args.fPaint),
+            *args.fUserStencilSettings, *args.fClip, *args.fViewMatrix,
+            SkIPoint{clippedDevShapeBounds.fLeft, clippedDevShapeBounds.fTop},
+            clippedDevShapeBounds);
+    return true;
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrSkcPathRenderer_DEFINED
+#define GrSkcPathRenderer_DEFINED
+
+#include "GrPathRenderer.h"
+
+class GrCaps;
+
+/**
+ * This path renderer rasterizes big, complicated fills with Spinel (src/compute/skc), which builds,
+ * rasterizes and composites paths in compute kernels on an OpenCL device, and then draws the
+ * resulting coverage as a mask. Paths with fewer than kMinVerbCount verbs are left to the other
+ * path renderers, since skc's fixed cost per path is higher than theirs.
+ *
+ * skc only has an OpenCL 1.2 backend, with kernels for Intel Gen9 GPUs, so there is no skc device
+ * for Vulkan or GL to share. Masks are read back from OpenCL and uploaded like software masks.
+ */
+class GrSkcPathRenderer : public GrPathRenderer {
+public:
+    static bool IsSupported(const GrCaps&);
+
+    static sk_sp<GrSkcPathRenderer> CreateIfSupported(const GrCaps&);
+
+    ~GrSkcPathRenderer() override;
+
+    static constexpr int kMinVerbCount = 256;
+
+    // skc's tile keys can't address a bigger surface than this.
+    static constexpr int kMaxMaskSize = 4096;
+
+private:
+    class Context;
+
+    GrSkcPathRenderer(std::unique_ptr<Context>);
+
+    StencilSupport onGetStencilSupport(const GrShape&) const override {
+        return GrPathRenderer::kNoSupport_StencilSupport;
+    }
+
+    CanDrawPath onCanDrawPath(const CanDrawPathArgs&) const override;
+
+    bool onDrawPath(const DrawPathArgs&) override;
+
+    std::unique_ptr<Context> fContext;
+
+    typedef GrPathRenderer INHERITED;
+};
+
+#endif
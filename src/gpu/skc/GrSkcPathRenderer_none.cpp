@@ -0,0 +1,16 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrSkcPathRenderer.h"
+
+bool GrSkcPathRenderer::IsSupported(const GrCaps& caps) {
+    return false;
+}
+
+sk_sp<GrSkcPathRenderer> GrSkcPathRenderer::CreateIfSupported(const GrCaps& caps) {
+    return nullptr;
+}
@@ -186,7 +186,7 @@ bool GrAtlasManager::initAtlas(GrMaskFormat format) {
         fAtlases[index] = GrDrawOpAtlas::Make(
                 fProxyProvider, format, config, atlasDimensions.width(), atlasDimensions.height(),
                 plotDimensions.width(), plotDimensions.height(), fAllowMultitexturing,
-                &GrStrikeCache::HandleEviction, fGlyphCache);
+                &GrStrikeCache::HandleEviction, fGlyphCache, &GrStrikeCache::HandleRelocation);
         if (!fAtlases[index]) {
             return false;
         }
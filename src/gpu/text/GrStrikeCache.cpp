@@ -56,6 +56,16 @@ void GrStrikeCache::HandleEviction(GrDrawOpAtlas::AtlasID id, void* ptr) {
     }
 }
 
+void GrStrikeCache::HandleRelocation(GrDrawOpAtlas::AtlasID oldID, GrDrawOpAtlas::AtlasID newID,
+                                     int dx, int dy, void* ptr) {
+    GrStrikeCache* glyphCache = reinterpret_cast<GrStrikeCache*>(ptr);
+
+    StrikeHash::Iter iter(&glyphCache->fCache);
+    for (; !iter.done(); ++iter) {
+        (*iter).relocateID(oldID, newID, dx, dy);
+    }
+}
+
 // expands each bit in a bitmask to 0 or ~0 of type INT_TYPE. Used to expand a BW glyph mask to
 // A8, RGB565, or RGBA8888.
 template <typename INT_TYPE>
@@ -190,6 +200,19 @@ void GrTextStrike::removeID(GrDrawOpAtlas::AtlasID id) {
     }
 }
 
+void GrTextStrike::relocateID(GrDrawOpAtlas::AtlasID oldID, GrDrawOpAtlas::AtlasID newID,
+                              int dx, int dy) {
+    SkTDynamicHash<GrGlyph, SkPackedGlyphID>::Iter iter(&fCache);
+    while (!iter.done()) {
+        if (oldID == (*iter).fID) {
+            (*iter).fID = newID;
+            (*iter).fAtlasLocation.fX += dx;
+            (*iter).fAtlasLocation.fY += dy;
+        }
+        ++iter;
+    }
+}
+
 GrDrawOpAtlas::ErrorCode GrTextStrike::addGlyphToAtlas(
                                    GrResourceProvider* resourceProvider,
                                    GrDeferredUploadTarget* target,
@@ -71,9 +71,16 @@ public:
     // remove any references to this plot
     void removeID(GrDrawOpAtlas::AtlasID);
 
+    // point any references to this plot at the plot its data was moved to
+    void relocateID(GrDrawOpAtlas::AtlasID oldID, GrDrawOpAtlas::AtlasID newID, int dx, int dy);
+
     // If a TextStrike is abandoned by the cache, then the caller must get a new strike
     bool isAbandoned() const { return fIsAbandoned; }
 
+    // Strikes from another cache (e.g., that of a DDL recorder) hold GrGlyphs the caller's atlas
+    // evictions never reach. The caller must get its own strike before adding them to its atlas.
+    bool isOwnedBy(const GrStrikeCache* cache) const { return fOwner == cache; }
+
     static const SkDescriptor& GetKey(const GrTextStrike& strike) {
         return *strike.fFontScalerKey.getDesc();
     }
@@ -85,6 +92,7 @@ private:
     SkAutoDescriptor fFontScalerKey;
     SkArenaAlloc fAlloc{512};
 
+    const GrStrikeCache* fOwner{nullptr};
     int fAtlasedGlyphs{0};
     bool fIsAbandoned{false};
 
@@ -125,11 +133,14 @@ public:
     void freeAll();
 
     static void HandleEviction(GrDrawOpAtlas::AtlasID, void*);
+    static void HandleRelocation(GrDrawOpAtlas::AtlasID oldID, GrDrawOpAtlas::AtlasID newID,
+                                 int dx, int dy, void*);
 
 private:
     sk_sp<GrTextStrike> generateStrike(const SkStrike* cache) {
         // 'fCache' get the construction ref
         sk_sp<GrTextStrike> strike = sk_ref_sp(new GrTextStrike(cache->getDescriptor()));
+        strike->fOwner = this;
         fCache.add(strike.get());
         return strike;
     }
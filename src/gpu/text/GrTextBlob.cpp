@@ -472,3 +472,30 @@ void GrTextBlob::SubRun::computeTranslation(const SkMatrix& viewMatrix,
     fX = x;
     fY = y;
 }
+
+bool GrTextBlob::SubRun::computeDeviceTranslation(const SkMatrix& viewMatrix,
+                                                  SkScalar x, SkScalar y,
+                                                  SkVector* translation) const {
+    if (viewMatrix.hasPerspective() || fCurrentViewMatrix.hasPerspective() ||
+        viewMatrix.getScaleX() != fCurrentViewMatrix.getScaleX() ||
+        viewMatrix.getScaleY() != fCurrentViewMatrix.getScaleY() ||
+        viewMatrix.getSkewX() != fCurrentViewMatrix.getSkewX() ||
+        viewMatrix.getSkewY() != fCurrentViewMatrix.getSkewY()) {
+        return false;
+    }
+    // Distance field and fallback vertices are kept in text space and mapped by the view matrix
+    // after they are copied; other glyphs are already in device space. A device space vertex
+    // buffer moves by the same offset either way, but only if this subrun is one or the other.
+    bool deviceSpaceGlyphs = !this->drawAsDistanceFields() && !fFlags.argbFallback;
+    bool transformedOnCpu = this->drawAsDistanceFields() || this->needsTransform();
+    if (deviceSpaceGlyphs == transformedOnCpu) {
+        return false;
+    }
+    calculate_translation(true, viewMatrix, x, y, fCurrentViewMatrix, fX, fY,
+                          &translation->fX, &translation->fY);
+    if (deviceSpaceGlyphs &&
+        (!SkScalarIsInt(translation->fX) || !SkScalarIsInt(translation->fY))) {
+        return false;
+    }
+    return true;
+}
@@ -8,6 +8,7 @@
 #ifndef GrTextBlob_DEFINED
 #define GrTextBlob_DEFINED
 
+#include "GrBuffer.h"
 #include "GrColor.h"
 #include "GrDrawOpAtlas.h"
 #include "GrStrikeCache.h"
@@ -334,6 +335,23 @@ private:
         void computeTranslation(const SkMatrix& viewMatrix, SkScalar x, SkScalar y,
                                 SkScalar* transX, SkScalar* transY);
 
+        // Returns the device space offset from where the subrun's vertices were last drawn to a
+        // draw with viewMatrix at (x, y), or false if that draw can't be had just by offsetting
+        // them. Bitmap glyphs may only move by whole pixels.
+        bool computeDeviceTranslation(const SkMatrix& viewMatrix, SkScalar x, SkScalar y,
+                                      SkVector* translation) const;
+
+        // The device space vertices of the subrun's last draw, uploaded to the GPU of the context
+        // with the given ID. They are dropped whenever the subrun's vertices are regenerated.
+        void setVertexBuffer(sk_sp<const GrBuffer> buffer, uint32_t contextID) {
+            fVertexBuffer = std::move(buffer);
+            fVertexBufferContextID = contextID;
+        }
+        const sk_sp<const GrBuffer>& vertexBuffer(uint32_t contextID) const {
+            static const sk_sp<const GrBuffer> kNone;
+            return fVertexBufferContextID == contextID ? fVertexBuffer : kNone;
+        }
+
         // df properties
         void setDrawAsDistanceFields() { fFlags.drawAsSdf = true; }
         bool drawAsDistanceFields() const { return fFlags.drawAsSdf; }
@@ -354,6 +372,8 @@ private:
         GrDrawOpAtlas::BulkUseTokenUpdater fBulkUseToken;
         sk_sp<GrTextStrike> fStrike;
         SkMatrix fCurrentViewMatrix;
+        sk_sp<const GrBuffer> fVertexBuffer;
+        uint32_t fVertexBufferContextID{SK_InvalidUniqueID};
         SkRect fVertexBounds = SkRectPriv::MakeLargestInverted();
         uint64_t fAtlasGeneration{GrDrawOpAtlas::kInvalidAtlasGeneration};
         size_t fVertexStartIndex{0};
@@ -595,6 +615,30 @@ public:
 
     bool regenerate(Result*);
 
+    /**
+     * After the sub run is finished, returns whether its vertices are worth keeping on the GPU:
+     * they were generated in one go, and this draw changed nothing about them but their position.
+     */
+    bool canCacheVertices() const;
+
+    /** Keeps the sub run's finished device space vertices, uploaded to the GPU, for later draws. */
+    void setCachedVertices(sk_sp<const GrBuffer> buffer, uint32_t contextID) {
+        fSubRun->setVertexBuffer(std::move(buffer), contextID);
+    }
+
+    /**
+     * If the sub run's vertices from an earlier draw are still on the GPU and valid for a draw
+     * with viewMatrix at (x, y), returns them along with the device space offset to draw them at,
+     * and marks the sub run's glyphs as used by the next draw. The vertices are never valid for
+     * draws that have to clip them.
+     */
+    static sk_sp<const GrBuffer> FindCachedVertices(GrTextBlob*, int runIdx, int subRunIdx,
+                                                    const SkMatrix& viewMatrix, SkScalar x,
+                                                    SkScalar y, GrColor color, uint32_t contextID,
+                                                    GrDeferredUploadTarget*, GrStrikeCache*,
+                                                    GrAtlasManager*, SkVector* translation,
+                                                    int* glyphCount);
+
 private:
     bool doRegen(Result*, bool regenPos, bool regenCol, bool regenTexCoords, bool regenGlyphs);
 
@@ -613,7 +657,9 @@ private:
 
     uint32_t fRegenFlags = 0;
     int fCurrGlyph = 0;
+    int fRegenCalls = 0;
     bool fBrokenRun = false;
+    bool fSameLinearTransform;
 };
 
 #endif  // GrTextBlob_DEFINED
@@ -63,19 +63,12 @@ static void regen_texcoords(char* vertex, size_t vertexStride, const GrGlyph* gl
         u1 = u0 + width;
         v1 = v0 + height;
     }
-    // We pack the 2bit page index in the low bit of the u and v texture coords
+    // We pack the page index in the low bits of the u and v texture coords
     uint32_t pageIndex = glyph->pageIndex();
-    SkASSERT(pageIndex < 4);
-    uint16_t uBit = (pageIndex >> 1) & 0x1;
-    uint16_t vBit = pageIndex & 0x1;
-    u0 <<= 1;
-    u0 |= uBit;
-    v0 <<= 1;
-    v0 |= vBit;
-    u1 <<= 1;
-    u1 |= uBit;
-    v1 <<= 1;
-    v1 |= vBit;
+    u0 = GrDrawOpAtlas::PackU(u0, pageIndex);
+    v0 = GrDrawOpAtlas::PackV(v0, pageIndex);
+    u1 = GrDrawOpAtlas::PackU(u1, pageIndex);
+    v1 = GrDrawOpAtlas::PackV(v1, pageIndex);
 
     uint16_t* textureCoords = reinterpret_cast<uint16_t*>(vertex + texCoordOffset);
     textureCoords[0] = u0;
@@ -134,6 +127,12 @@ GrTextBlob::VertexRegenerator::VertexRegenerator(GrResourceProvider* resourcePro
         , fRun(&blob->fRuns[runIdx])
         , fSubRun(&blob->fRuns[runIdx].fSubRunInfo[subRunIdx])
         , fColor(color) {
+    // The subrun's vertices are about to be moved or rebuilt, so any copy on the GPU is stale.
+    // It is only worth uploading a new one if this draw could have used the old one.
+    SkVector translation;
+    fSameLinearTransform = fSubRun->computeDeviceTranslation(fViewMatrix, x, y, &translation);
+    fSubRun->setVertexBuffer(nullptr, SK_InvalidUniqueID);
+
     // Compute translation if any
     fSubRun->computeTranslation(fViewMatrix, x, y, &fTransX, &fTransY);
 
@@ -144,8 +143,10 @@ GrTextBlob::VertexRegenerator::VertexRegenerator(GrResourceProvider* resourcePro
     // Because we do not have the packed ids, and thus can't look up our glyphs in the
     // new strike, we instead keep our ref to the old strike and use the packed ids from
     // it.  These ids will still be valid as long as we hold the ref.  When we are done
-    // updating our cache of the GrGlyph*s, we drop our ref on the old strike
-    if (fSubRun->strike()->isAbandoned()) {
+    // updating our cache of the GrGlyph*s, we drop our ref on the old strike.
+    // Blobs recorded into a DDL hold strikes from the recorder's cache. Moving them to the
+    // flushing cache means tiles recorded in parallel share one atlas entry per glyph.
+    if (fSubRun->strike()->isAbandoned() || !fSubRun->strike()->isOwnedBy(fGlyphCache)) {
         fRegenFlags |= kRegenGlyph;
         fRegenFlags |= kRegenTex;
     }
@@ -258,6 +259,7 @@ bool GrTextBlob::VertexRegenerator::doRegen(GrTextBlob::VertexRegenerator::Resul
 }
 
 bool GrTextBlob::VertexRegenerator::regenerate(GrTextBlob::VertexRegenerator::Result* result) {
+    ++fRegenCalls;
     uint64_t currentAtlasGen = fFullAtlasManager->atlasGeneration(fSubRun->maskFormat());
     // If regenerate() is called multiple times then the atlas gen may have changed. So we check
     // this each time.
@@ -290,3 +292,31 @@ bool GrTextBlob::VertexRegenerator::regenerate(GrTextBlob::VertexRegenerator::Re
     SK_ABORT("Should not get here");
     return false;
 }
+
+bool GrTextBlob::VertexRegenerator::canCacheVertices() const {
+    SkASSERT(fCurrGlyph == (int)fSubRun->glyphCount());
+    return fSameLinearTransform && 1 == fRegenCalls && !fBrokenRun &&
+           !(fRegenFlags & (kRegenCol | kRegenTex | kRegenGlyph));
+}
+
+sk_sp<const GrBuffer> GrTextBlob::VertexRegenerator::FindCachedVertices(
+        GrTextBlob* blob, int runIdx, int subRunIdx, const SkMatrix& viewMatrix,
+        SkScalar x, SkScalar y, GrColor color, uint32_t contextID,
+        GrDeferredUploadTarget* uploadTarget, GrStrikeCache* glyphCache,
+        GrAtlasManager* fullAtlasManager, SkVector* translation, int* glyphCount) {
+    SubRun* subRun = &blob->fRuns[runIdx].fSubRunInfo[subRunIdx];
+    const sk_sp<const GrBuffer>& buffer = subRun->vertexBuffer(contextID);
+    // These are the conditions under which the regenerator would rewrite more than positions.
+    if (!buffer ||
+        subRun->strike()->isAbandoned() || !subRun->strike()->isOwnedBy(glyphCache) ||
+        (kARGB_GrMaskFormat != subRun->maskFormat() && subRun->color() != color) ||
+        subRun->atlasGeneration() != fullAtlasManager->atlasGeneration(subRun->maskFormat()) ||
+        !subRun->computeDeviceTranslation(viewMatrix, x, y, translation)) {
+        return nullptr;
+    }
+    fullAtlasManager->setUseTokenBulk(*subRun->bulkUseToken(),
+                                      uploadTarget->tokenTracker()->nextDrawToken(),
+                                      subRun->maskFormat());
+    *glyphCount = subRun->glyphCount();
+    return buffer;
+}
@@ -8,6 +8,7 @@
 #ifndef GrTextContext_DEFINED
 #define GrTextContext_DEFINED
 
+#include "GrContextOptions.h"
 #include "GrDistanceFieldAdjustTable.h"
 #include "GrGeometryProcessor.h"
 #include "GrTextTarget.h"
@@ -19,6 +20,7 @@
 
 class GrDrawOp;
 class GrTextBlobCache;
+class SkExecutor;
 class SkGlyph;
 class GrTextBlob;
 
@@ -40,6 +42,13 @@ public:
         SkScalar fMaxDistanceFieldFontSize = -1.f;
         /** Forces all distance field vertices to use 3 components, not just when in perspective. */
         bool fDistanceFieldVerticesAlwaysHaveW = false;
+        /**
+         * If non-null, glyph images missing from the strike cache are rasterized on this executor
+         * while the blob is built, rather than one at a time on the recording thread.
+         */
+        SkExecutor* fExecutor = nullptr;
+        /** If non-null, distance field glyph masks are loaded from and stored to this cache. */
+        GrContextOptions::PersistentCache* fDistanceFieldGlyphCache = nullptr;
     };
 
     static std::unique_ptr<GrTextContext> Make(const Options& options);
@@ -336,6 +336,10 @@ void GrVkCaps::init(const GrContextOptions& contextOptions, const GrVkInterface*
         fPreferFullscreenClears = true;
     }
 
+    // GrVkGpuRTCommandBuffer stores the stencil between the render passes of one opList, so it is
+    // safe to let the last one discard it. Tilers can then keep it in tile memory.
+    fDiscardStencilValuesAfterRenderPass = true;
+
     this->initConfigTable(vkInterface, physDev, properties);
     this->initStencilFormat(vkInterface, physDev);
 
@@ -132,7 +132,8 @@ void GrVkCommandBuffer::pipelineBarrier(const GrVkGpu* gpu,
                                         VkPipelineStageFlags dstStageMask,
                                         bool byRegion,
                                         BarrierType barrierType,
-                                        void* barrier) const {
+                                        void* barrier,
+                                        uint32_t barrierCount) const {
     SkASSERT(!this->isWrapped());
     SkASSERT(fIsActive);
     // For images we can have barriers inside of render passes but they require us to add more
@@ -147,7 +148,7 @@ void GrVkCommandBuffer::pipelineBarrier(const GrVkGpu* gpu,
             const VkMemoryBarrier* barrierPtr = reinterpret_cast<VkMemoryBarrier*>(barrier);
             GR_VK_CALL(gpu->vkInterface(), CmdPipelineBarrier(fCmdBuffer, srcStageMask,
                                                               dstStageMask, dependencyFlags,
-                                                              1, barrierPtr,
+                                                              barrierCount, barrierPtr,
                                                               0, nullptr,
                                                               0, nullptr));
             break;
@@ -159,7 +160,7 @@ void GrVkCommandBuffer::pipelineBarrier(const GrVkGpu* gpu,
             GR_VK_CALL(gpu->vkInterface(), CmdPipelineBarrier(fCmdBuffer, srcStageMask,
                                                               dstStageMask, dependencyFlags,
                                                               0, nullptr,
-                                                              1, barrierPtr,
+                                                              barrierCount, barrierPtr,
                                                               0, nullptr));
             break;
         }
@@ -171,7 +172,7 @@ void GrVkCommandBuffer::pipelineBarrier(const GrVkGpu* gpu,
                                                               dstStageMask, dependencyFlags,
                                                               0, nullptr,
                                                               0, nullptr,
-                                                              1, barrierPtr));
+                                                              barrierCount, barrierPtr));
             break;
         }
     }
@@ -814,6 +815,16 @@ void GrVkPrimaryCommandBuffer::resolveImage(GrVkGpu* gpu,
                                                    regions));
 }
 
+void GrVkPrimaryCommandBuffer::writeTimestamp(const GrVkGpu* gpu, VkQueryPool pool,
+                                              uint32_t query) {
+    SkASSERT(fIsActive);
+    SkASSERT(!fActiveRenderPass);
+    GR_VK_CALL(gpu->vkInterface(), CmdResetQueryPool(fCmdBuffer, pool, query, 1));
+    GR_VK_CALL(gpu->vkInterface(), CmdWriteTimestamp(fCmdBuffer,
+                                                     VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                                     pool, query));
+}
+
 void GrVkPrimaryCommandBuffer::onFreeGPUData(GrVkGpu* gpu) const {
     SkASSERT(!fActiveRenderPass);
     // Destroy the fence, if any
@@ -43,7 +43,8 @@ public:
                          VkPipelineStageFlags dstStageMask,
                          bool byRegion,
                          BarrierType barrierType,
-                         void* barrier) const;
+                         void* barrier,
+                         uint32_t barrierCount = 1) const;
 
     void bindInputBuffer(GrVkGpu* gpu, uint32_t binding, const GrVkVertexBuffer* vbuffer);
 
@@ -297,6 +298,10 @@ public:
                       uint32_t regionCount,
                       const VkImageResolve* regions);
 
+    // Resets the query and has the GPU write a timestamp to it once all the preceding commands
+    // have finished.
+    void writeTimestamp(const GrVkGpu* gpu, VkQueryPool pool, uint32_t query);
+
     void submitToQueue(const GrVkGpu* gpu, VkQueue queue, GrVkGpu::SyncQueue sync,
                        SkTArray<GrVkSemaphore::Resource*>& signalSemaphores,
                        SkTArray<GrVkSemaphore::Resource*>& waitSemaphores);
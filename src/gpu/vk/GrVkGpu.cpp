@@ -36,12 +36,15 @@
 #include "GrVkVertexBuffer.h"
 #include "SkConvertPixels.h"
 #include "SkMipMap.h"
+#include "SkOpts.h"
 #include "SkSLCompiler.h"
 #include "SkTo.h"
+#include "SkTraceEvent.h"
 
 #include "vk/GrVkExtensions.h"
 #include "vk/GrVkTypes.h"
 
+#include <chrono>
 #include <utility>
 
 #if !defined(SK_BUILD_FOR_WIN)
@@ -192,12 +195,23 @@ GrVkGpu::GrVkGpu(GrContext* context, const GrContextOptions& options,
     VK_CALL(GetPhysicalDeviceProperties(backendContext.fPhysicalDevice, &fPhysDevProps));
     VK_CALL(GetPhysicalDeviceMemoryProperties(backendContext.fPhysicalDevice, &fPhysDevMemProps));
 
+    uint32_t queueFamilyCount = 0;
+    VK_CALL(GetPhysicalDeviceQueueFamilyProperties(backendContext.fPhysicalDevice,
+                                                   &queueFamilyCount, nullptr));
+    SkAutoTMalloc<VkQueueFamilyProperties> queueFamilyProps(queueFamilyCount);
+    VK_CALL(GetPhysicalDeviceQueueFamilyProperties(backendContext.fPhysicalDevice,
+                                                   &queueFamilyCount, queueFamilyProps.get()));
+    if (fQueueIndex < queueFamilyCount && fPhysDevProps.limits.timestampPeriod > 0) {
+        fTimestampValidBits = queueFamilyProps[fQueueIndex].timestampValidBits;
+    }
+
     fResourceProvider.init();
 
     fCmdPool = fResourceProvider.findOrCreateCommandPool();
     fCurrentCmdBuffer = fCmdPool->getPrimaryCommandBuffer();
     SkASSERT(fCurrentCmdBuffer);
     fCurrentCmdBuffer->begin(this);
+    this->anchorTraceSpans();
 }
 
 void GrVkGpu::destroyResources() {
@@ -232,6 +246,11 @@ void GrVkGpu::destroyResources() {
         fCmdPool = nullptr;
     }
 
+    if (VK_NULL_HANDLE != fTimestampQueryPool) {
+        VK_CALL(DestroyQueryPool(fDevice, fTimestampQueryPool, nullptr));
+        fTimestampQueryPool = VK_NULL_HANDLE;
+    }
+
     for (int i = 0; i < fSemaphoresToWaitOn.count(); ++i) {
         fSemaphoresToWaitOn[i]->unref(this);
     }
@@ -244,6 +263,7 @@ void GrVkGpu::destroyResources() {
 
 
     fCopyManager.destroyResources(this);
+    fStagingRing.reset();
 
     // must call this just before we destroy the command pool and VkDevice
     fResourceProvider.destroyResources(VK_ERROR_DEVICE_LOST == res);
@@ -280,6 +300,7 @@ void GrVkGpu::disconnect(DisconnectType type) {
                 fSemaphoresToSignal[i]->unrefAndAbandon();
             }
             fCopyManager.abandonResources();
+            fStagingRing.reset();
 
             // must call this just before we destroy the command pool and VkDevice
             fResourceProvider.abandonResources();
@@ -289,6 +310,12 @@ void GrVkGpu::disconnect(DisconnectType type) {
         fSemaphoresToWaitOn.reset();
         fSemaphoresToSignal.reset();
         fCurrentCmdBuffer = nullptr;
+        fTimestampQueryPool = VK_NULL_HANDLE;
+        fTimestampValidBits = 0;
+        fTraceAnchors.reset();
+        fCurrentCmdBufferAnchored = false;
+        fOpenTraceSpans.reset();
+        fPendingTraceSpans.reset();
         fDisconnected = true;
     }
 }
@@ -321,6 +348,11 @@ void GrVkGpu::submitCommandBuffer(SyncQueue sync) {
     fCurrentCmdBuffer->end(this);
     fCmdPool->close();
     fCurrentCmdBuffer->submitToQueue(this, fQueue, sync, fSemaphoresToSignal, fSemaphoresToWaitOn);
+    if (fCurrentCmdBufferAnchored) {
+        fTraceAnchors.back().fSubmitNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        fCurrentCmdBufferAnchored = false;
+    }
 
     // We must delete and drawables that have been waitint till submit for us to destroy.
     fDrawables.reset();
@@ -340,6 +372,144 @@ void GrVkGpu::submitCommandBuffer(SyncQueue sync) {
     fCmdPool = fResourceProvider.findOrCreateCommandPool();
     fCurrentCmdBuffer = fCmdPool->getPrimaryCommandBuffer();
     fCurrentCmdBuffer->begin(this);
+
+    this->reportTraceSpans();
+    this->anchorTraceSpans();
+}
+
+void GrVkGpu::anchorTraceSpans() {
+    SkASSERT(!fCurrentCmdBufferAnchored);
+    bool tracing;
+    TRACE_EVENT_CATEGORY_GROUP_ENABLED("skia.gpu", &tracing);
+    if (!tracing || !fTimestampValidBits) {
+        return;
+    }
+    if (VK_NULL_HANDLE == fTimestampQueryPool) {
+        VkQueryPoolCreateInfo createInfo;
+        memset(&createInfo, 0, sizeof(VkQueryPoolCreateInfo));
+        createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        createInfo.queryCount = kMaxTimestampQueries;
+        VkResult result = VK_CALL(CreateQueryPool(fDevice, &createInfo, nullptr,
+                                                  &fTimestampQueryPool));
+        if (VK_SUCCESS != result) {
+            fTimestampQueryPool = VK_NULL_HANDLE;
+            fTimestampValidBits = 0;
+            return;
+        }
+        for (uint32_t query = kMaxTimestampQueries; query > 0; --query) {
+            *fFreeTimestampQueries.append() = query - 1;
+        }
+    }
+    if (fFreeTimestampQueries.isEmpty()) {
+        return;
+    }
+    TraceAnchor& anchor = fTraceAnchors.push_back();
+    anchor.fSerial = fNextTraceAnchorSerial++;
+    fFreeTimestampQueries.pop(&anchor.fQuery);
+    anchor.fSubmitNs = 0;
+    fCurrentCmdBuffer->writeTimestamp(this, fTimestampQueryPool, anchor.fQuery);
+    fCurrentCmdBufferAnchored = true;
+}
+
+bool GrVkGpu::onBeginTraceSpan(const char* name) {
+    if (!fCurrentCmdBufferAnchored || fFreeTimestampQueries.count() < 2) {
+        return false;
+    }
+    TraceSpan& span = fOpenTraceSpans.push_back();
+    span.fName = name;
+    span.fAnchorSerial = fTraceAnchors.back().fSerial;
+    fFreeTimestampQueries.pop(&span.fBeginQuery);
+    fFreeTimestampQueries.pop(&span.fEndQuery);
+    fCurrentCmdBuffer->writeTimestamp(this, fTimestampQueryPool, span.fBeginQuery);
+    return true;
+}
+
+void GrVkGpu::onEndTraceSpan() {
+    SkASSERT(!fOpenTraceSpans.empty());
+    TraceSpan span = fOpenTraceSpans.back();
+    fOpenTraceSpans.pop_back();
+    // The span may have begun in a command buffer we have since submitted. Its end is written to
+    // the current one, which the GPU executes later on the same clock.
+    fCurrentCmdBuffer->writeTimestamp(this, fTimestampQueryPool, span.fEndQuery);
+    fPendingTraceSpans.push_back(span);
+}
+
+void GrVkGpu::reportTraceSpans() {
+    if (VK_NULL_HANDLE == fTimestampQueryPool) {
+        return;
+    }
+    auto readTimestamp = [this](uint32_t query, uint64_t* ticks) {
+        VkResult result = VK_CALL(GetQueryPoolResults(fDevice, fTimestampQueryPool, query, 1,
+                                                      sizeof(uint64_t), ticks, sizeof(uint64_t),
+                                                      VK_QUERY_RESULT_64_BIT));
+        return VK_SUCCESS == result;
+    };
+    auto findAnchor = [this](uint32_t serial) -> const TraceAnchor* {
+        for (const TraceAnchor& anchor : fTraceAnchors) {
+            if (anchor.fSerial == serial) {
+                return &anchor;
+            }
+        }
+        return nullptr;
+    };
+    uint64_t tickMask = fTimestampValidBits < 64 ? (uint64_t(1) << fTimestampValidBits) - 1
+                                                 : ~uint64_t(0);
+    double nsPerTick = fPhysDevProps.limits.timestampPeriod;
+    uint64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    int done = 0;
+    for (; done < fPendingTraceSpans.count(); ++done) {
+        const TraceSpan& span = fPendingTraceSpans[done];
+        const TraceAnchor* anchor = findAnchor(span.fAnchorSerial);
+        SkASSERT(anchor);
+        uint64_t anchorTicks, beginTicks, endTicks;
+        // The timestamps are written in order, so if this span isn't done the later ones aren't.
+        if (!anchor->fSubmitNs || !readTimestamp(span.fEndQuery, &endTicks)) {
+            break;
+        }
+        if (readTimestamp(anchor->fQuery, &anchorTicks) &&
+            readTimestamp(span.fBeginQuery, &beginTicks)) {
+            uint64_t startNs = anchor->fSubmitNs +
+                               static_cast<uint64_t>(((beginTicks - anchorTicks) & tickMask) *
+                                                     nsPerTick);
+            uint64_t durationNs =
+                    static_cast<uint64_t>(((endTicks - beginTicks) & tickMask) * nsPerTick);
+            if (startNs <= nowNs) {
+                ReportTraceSpan(span.fName, nowNs - startNs, durationNs);
+            }
+        }
+        *fFreeTimestampQueries.append() = span.fBeginQuery;
+        *fFreeTimestampQueries.append() = span.fEndQuery;
+    }
+    for (int i = done; i < fPendingTraceSpans.count(); ++i) {
+        fPendingTraceSpans[i - done] = fPendingTraceSpans[i];
+    }
+    fPendingTraceSpans.pop_back_n(done);
+
+    // Release the anchors that no span needs any more, once the GPU is done with their queries.
+    uint32_t oldestNeeded = fCurrentCmdBufferAnchored ? fTraceAnchors.back().fSerial
+                                                      : fNextTraceAnchorSerial;
+    for (const TraceSpan& span : fOpenTraceSpans) {
+        oldestNeeded = SkTMin(oldestNeeded, span.fAnchorSerial);
+    }
+    for (const TraceSpan& span : fPendingTraceSpans) {
+        oldestNeeded = SkTMin(oldestNeeded, span.fAnchorSerial);
+    }
+    int released = 0;
+    for (; released < fTraceAnchors.count(); ++released) {
+        const TraceAnchor& anchor = fTraceAnchors[released];
+        uint64_t ticks;
+        if (anchor.fSerial >= oldestNeeded || !readTimestamp(anchor.fQuery, &ticks)) {
+            break;
+        }
+        *fFreeTimestampQueries.append() = anchor.fQuery;
+    }
+    for (int i = released; i < fTraceAnchors.count(); ++i) {
+        fTraceAnchors[i - released] = fTraceAnchors[i];
+    }
+    fTraceAnchors.pop_back_n(released);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -671,13 +841,6 @@ bool GrVkGpu::uploadTexDataOptimal(GrVkTexture* tex, int left, int top, int widt
         return true;
     }
 
-    // allocate buffer to hold our mip data
-    sk_sp<GrVkTransferBuffer> transferBuffer =
-            GrVkTransferBuffer::Make(this, combinedBufferSize, GrVkBuffer::kCopyRead_Type);
-    if (!transferBuffer) {
-        return false;
-    }
-
     int uploadLeft = left;
     int uploadTop = top;
     GrVkTexture* uploadTexture = tex;
@@ -717,7 +880,6 @@ bool GrVkGpu::uploadTexDataOptimal(GrVkTexture* tex, int left, int top, int widt
         uploadTop = 0;
     }
 
-    char* buffer = (char*) transferBuffer->map();
     SkTArray<VkBufferImageCopy> regions(mipLevelCount);
 
     currentWidth = width;
@@ -726,19 +888,10 @@ bool GrVkGpu::uploadTexDataOptimal(GrVkTexture* tex, int left, int top, int widt
     for (int currentMipLevel = 0; currentMipLevel < mipLevelCount; currentMipLevel++) {
         if (texelsShallowCopy[currentMipLevel].fPixels) {
             SkASSERT(1 == mipLevelCount || currentHeight == layerHeight);
-            const size_t trimRowBytes = currentWidth * bpp;
-            const size_t rowBytes = texelsShallowCopy[currentMipLevel].fRowBytes
-                                    ? texelsShallowCopy[currentMipLevel].fRowBytes
-                                    : trimRowBytes;
-
-            // copy data into the buffer, skipping the trailing bytes
-            char* dst = buffer + individualMipOffsets[currentMipLevel];
-            const char* src = (const char*)texelsShallowCopy[currentMipLevel].fPixels;
-            SkRectMemcpy(dst, trimRowBytes, src, rowBytes, trimRowBytes, currentHeight);
-
             VkBufferImageCopy& region = regions.push_back();
             memset(&region, 0, sizeof(VkBufferImageCopy));
-            region.bufferOffset = transferBuffer->offset() + individualMipOffsets[currentMipLevel];
+            // Relative to the start of the staged data until we know where that is.
+            region.bufferOffset = individualMipOffsets[currentMipLevel];
             region.bufferRowLength = currentWidth;
             region.bufferImageHeight = currentHeight;
             region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, SkToU32(currentMipLevel), 0, 1 };
@@ -750,8 +903,45 @@ bool GrVkGpu::uploadTexDataOptimal(GrVkTexture* tex, int left, int top, int widt
         layerHeight = currentHeight;
     }
 
-    // no need to flush non-coherent memory, unmap will do that for us
-    transferBuffer->unmap();
+    auto writeLevels = [&](char* buffer) {
+        int levelWidth = width;
+        int levelHeight = height;
+        for (int currentMipLevel = 0; currentMipLevel < mipLevelCount; currentMipLevel++) {
+            if (texelsShallowCopy[currentMipLevel].fPixels) {
+                const size_t trimRowBytes = levelWidth * bpp;
+                const size_t rowBytes = texelsShallowCopy[currentMipLevel].fRowBytes
+                                        ? texelsShallowCopy[currentMipLevel].fRowBytes
+                                        : trimRowBytes;
+
+                // copy data into the buffer, skipping the trailing bytes
+                char* dst = buffer + individualMipOffsets[currentMipLevel];
+                const char* src = (const char*)texelsShallowCopy[currentMipLevel].fPixels;
+                SkRectMemcpy(dst, trimRowBytes, src, rowBytes, trimRowBytes, levelHeight);
+            }
+            levelWidth = SkTMax(1, levelWidth/2);
+            levelHeight = SkTMax(1, levelHeight/2);
+        }
+    };
+
+    // Stage the mip data in the shared staging ring if it fits there, or else in a transfer buffer
+    // of its own.
+    GrVkStagingRing::Slice slice;
+    sk_sp<GrVkTransferBuffer> transferBuffer;
+    if (!fStagingRing.stage(this, combinedBufferSize, alignmentMask + 1, writeLevels, &slice)) {
+        transferBuffer =
+                GrVkTransferBuffer::Make(this, combinedBufferSize, GrVkBuffer::kCopyRead_Type);
+        if (!transferBuffer) {
+            return false;
+        }
+        writeLevels((char*) transferBuffer->map());
+        // no need to flush non-coherent memory, unmap will do that for us
+        transferBuffer->unmap();
+        slice.fBuffer = transferBuffer.get();
+        slice.fOffset = transferBuffer->offset();
+    }
+    for (VkBufferImageCopy& region : regions) {
+        region.bufferOffset += slice.fOffset;
+    }
 
     // Change layout of our target so it can be copied to
     uploadTexture->setImageLayout(this,
@@ -762,7 +952,7 @@ bool GrVkGpu::uploadTexDataOptimal(GrVkTexture* tex, int left, int top, int widt
 
     // Copy the buffer to the image
     fCurrentCmdBuffer->copyBufferToImage(this,
-                                         transferBuffer.get(),
+                                         slice.fBuffer,
                                          uploadTexture,
                                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                                          regions.count(),
@@ -1190,7 +1380,12 @@ sk_sp<GrRenderTarget> GrVkGpu::onWrapVulkanSecondaryCBAsRenderTarget(
 }
 
 bool GrVkGpu::onRegenerateMipMapLevels(GrTexture* tex) {
-    auto* vkTex = static_cast<GrVkTexture*>(tex);
+    bool regenerated = false;
+    this->onBatchRegenerateMipMapLevels(&tex, 1, &regenerated);
+    return regenerated;
+}
+
+bool GrVkGpu::canBlitMipMapLevels(const GrVkTexture* vkTex) const {
     // don't do anything for linearly tiled textures (can't have mipmaps)
     if (vkTex->isLinearTiled()) {
         SkDebugf("Trying to create mipmap for linear tiled texture");
@@ -1199,82 +1394,117 @@ bool GrVkGpu::onRegenerateMipMapLevels(GrTexture* tex) {
 
     // determine if we can blit to and from this format
     const GrVkCaps& caps = this->vkCaps();
-    if (!caps.configCanBeDstofBlit(tex->config(), false) ||
-        !caps.configCanBeSrcofBlit(tex->config(), false) ||
-        !caps.mipMapSupport()) {
-        return false;
-    }
-
-    int width = tex->width();
-    int height = tex->height();
-    VkImageBlit blitRegion;
-    memset(&blitRegion, 0, sizeof(VkImageBlit));
+    return caps.configCanBeDstofBlit(vkTex->config(), false) &&
+           caps.configCanBeSrcofBlit(vkTex->config(), false) &&
+           caps.mipMapSupport();
+}
 
-    // SkMipMap doesn't include the base level in the level count so we have to add 1
-    uint32_t levelCount = SkMipMap::ComputeLevelCount(tex->width(), tex->height()) + 1;
-    SkASSERT(levelCount == vkTex->mipLevels());
-
-    // change layout of the layers so we can write to them.
-    vkTex->setImageLayout(this, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT,
-                          VK_PIPELINE_STAGE_TRANSFER_BIT, false);
-
-    // setup memory barrier
-    SkASSERT(GrVkFormatIsSupported(vkTex->imageFormat()));
-    VkImageAspectFlags aspectFlags = VK_IMAGE_ASPECT_COLOR_BIT;
-    VkImageMemoryBarrier imageMemoryBarrier = {
-            VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,  // sType
-            nullptr,                                 // pNext
-            VK_ACCESS_TRANSFER_WRITE_BIT,            // srcAccessMask
-            VK_ACCESS_TRANSFER_READ_BIT,             // dstAccessMask
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,    // oldLayout
-            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,    // newLayout
-            VK_QUEUE_FAMILY_IGNORED,                 // srcQueueFamilyIndex
-            VK_QUEUE_FAMILY_IGNORED,                 // dstQueueFamilyIndex
-            vkTex->image(),                          // image
-            {aspectFlags, 0, 1, 0, 1}                // subresourceRange
+void GrVkGpu::onBatchRegenerateMipMapLevels(GrTexture* const textures[], int count,
+                                            bool regenerated[]) {
+    // The textures are blitted a level at a time, so that one pipeline barrier moves the source
+    // level of every texture into VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL before its blits.
+    SkSTArray<16, GrVkTexture*> vkTextures;
+    SkSTArray<16, uint32_t> levelCounts;
+    uint32_t maxLevelCount = 0;
+    for (int i = 0; i < count; ++i) {
+        auto* vkTex = static_cast<GrVkTexture*>(textures[i]);
+        if (!this->canBlitMipMapLevels(vkTex)) {
+            continue;
+        }
+        // SkMipMap doesn't include the base level in the level count so we have to add 1
+        uint32_t levelCount = SkMipMap::ComputeLevelCount(vkTex->width(), vkTex->height()) + 1;
+        SkASSERT(levelCount == vkTex->mipLevels());
+
+        // change layout of the layers so we can write to them.
+        vkTex->setImageLayout(this, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                              VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, false);
+        SkASSERT(GrVkFormatIsSupported(vkTex->imageFormat()));
+
+        vkTextures.push_back(vkTex);
+        levelCounts.push_back(levelCount);
+        maxLevelCount = SkTMax(maxLevelCount, levelCount);
+        regenerated[i] = true;
+    }
+    if (vkTextures.empty()) {
+        return;
+    }
+
+    // setup memory barriers
+    SkSTArray<16, VkImageMemoryBarrier> barriers;
+    auto addBarrier = [&barriers](const GrVkTexture* vkTex, uint32_t mipLevel) {
+        VkImageMemoryBarrier imageMemoryBarrier = {
+                VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,       // sType
+                nullptr,                                      // pNext
+                VK_ACCESS_TRANSFER_WRITE_BIT,                 // srcAccessMask
+                VK_ACCESS_TRANSFER_READ_BIT,                  // dstAccessMask
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,         // oldLayout
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,         // newLayout
+                VK_QUEUE_FAMILY_IGNORED,                      // srcQueueFamilyIndex
+                VK_QUEUE_FAMILY_IGNORED,                      // dstQueueFamilyIndex
+                vkTex->image(),                               // image
+                {VK_IMAGE_ASPECT_COLOR_BIT, mipLevel, 1, 0, 1}  // subresourceRange
+        };
+        barriers.push_back(imageMemoryBarrier);
+    };
+    auto flushBarriers = [this, &barriers]() {
+        if (!barriers.empty()) {
+            this->addImageMemoryBarriers(VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                         VK_PIPELINE_STAGE_TRANSFER_BIT, false,
+                                         barriers.begin(), barriers.count());
+            barriers.reset();
+        }
     };
 
     // Blit the miplevels
-    uint32_t mipLevel = 1;
-    while (mipLevel < levelCount) {
-        int prevWidth = width;
-        int prevHeight = height;
-        width = SkTMax(1, width / 2);
-        height = SkTMax(1, height / 2);
-
-        imageMemoryBarrier.subresourceRange.baseMipLevel = mipLevel - 1;
-        this->addImageMemoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                    false, &imageMemoryBarrier);
-
-        blitRegion.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, mipLevel - 1, 0, 1 };
-        blitRegion.srcOffsets[0] = { 0, 0, 0 };
-        blitRegion.srcOffsets[1] = { prevWidth, prevHeight, 1 };
-        blitRegion.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, mipLevel, 0, 1 };
-        blitRegion.dstOffsets[0] = { 0, 0, 0 };
-        blitRegion.dstOffsets[1] = { width, height, 1 };
-        fCurrentCmdBuffer->blitImage(this,
-                                     vkTex->resource(),
-                                     vkTex->image(),
-                                     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                                     vkTex->resource(),
-                                     vkTex->image(),
-                                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                     1,
-                                     &blitRegion,
-                                     VK_FILTER_LINEAR);
-        ++mipLevel;
+    VkImageBlit blitRegion;
+    memset(&blitRegion, 0, sizeof(VkImageBlit));
+    for (uint32_t mipLevel = 1; mipLevel < maxLevelCount; ++mipLevel) {
+        for (int i = 0; i < vkTextures.count(); ++i) {
+            if (mipLevel < levelCounts[i]) {
+                addBarrier(vkTextures[i], mipLevel - 1);
+            }
+        }
+        flushBarriers();
+
+        for (int i = 0; i < vkTextures.count(); ++i) {
+            if (mipLevel >= levelCounts[i]) {
+                continue;
+            }
+            GrVkTexture* vkTex = vkTextures[i];
+            int prevWidth = SkTMax(1, vkTex->width() >> (mipLevel - 1));
+            int prevHeight = SkTMax(1, vkTex->height() >> (mipLevel - 1));
+            int width = SkTMax(1, prevWidth / 2);
+            int height = SkTMax(1, prevHeight / 2);
+
+            blitRegion.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, mipLevel - 1, 0, 1 };
+            blitRegion.srcOffsets[0] = { 0, 0, 0 };
+            blitRegion.srcOffsets[1] = { prevWidth, prevHeight, 1 };
+            blitRegion.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, mipLevel, 0, 1 };
+            blitRegion.dstOffsets[0] = { 0, 0, 0 };
+            blitRegion.dstOffsets[1] = { width, height, 1 };
+            fCurrentCmdBuffer->blitImage(this,
+                                         vkTex->resource(),
+                                         vkTex->image(),
+                                         VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                         vkTex->resource(),
+                                         vkTex->image(),
+                                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                         1,
+                                         &blitRegion,
+                                         VK_FILTER_LINEAR);
+        }
     }
     // This barrier logically is not needed, but it changes the final level to the same layout as
     // all the others, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL. This makes tracking of the layouts and
     // future layout changes easier.
-    imageMemoryBarrier.subresourceRange.baseMipLevel = mipLevel - 1;
-    this->addImageMemoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                false, &imageMemoryBarrier);
-    vkTex->updateImageLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-    return true;
+    for (int i = 0; i < vkTextures.count(); ++i) {
+        addBarrier(vkTextures[i], levelCounts[i] - 1);
+        vkTextures[i]->updateImageLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+    }
+    flushBarriers();
 }
 
-////////////////////////////////////////////////////////////////////////////////
+////////
 
 GrStencilAttachment* GrVkGpu::createStencilAttachmentForRenderTarget(const GrRenderTarget* rt,
                                                                      int width,
@@ -1397,7 +1627,7 @@ bool GrVkGpu::createTestingOnlyVkImage(GrPixelConfig config, int w, int h, bool
     GR_VK_CALL_ERRCHECK(this->vkInterface(),
                         CreateImage(this->device(), &imageCreateInfo, nullptr, &image));
 
-    if (!GrVkMemory::AllocAndBindImageMemory(this, image, false, &alloc)) {
+    if (!GrVkMemory::AllocAndBindImageMemory(this, image, false, false, &alloc)) {
         VK_CALL(DestroyImage(this->device(), image, nullptr));
         return false;
     }
@@ -1790,6 +2020,21 @@ void GrVkGpu::addImageMemoryBarrier(VkPipelineStageFlags srcStageMask,
                                        barrier);
 }
 
+void GrVkGpu::addImageMemoryBarriers(VkPipelineStageFlags srcStageMask,
+                                     VkPipelineStageFlags dstStageMask,
+                                     bool byRegion,
+                                     VkImageMemoryBarrier* barriers,
+                                     uint32_t barrierCount) const {
+    SkASSERT(fCurrentCmdBuffer);
+    fCurrentCmdBuffer->pipelineBarrier(this,
+                                       srcStageMask,
+                                       dstStageMask,
+                                       byRegion,
+                                       GrVkCommandBuffer::kImageMemory_BarrierType,
+                                       barriers,
+                                       barrierCount);
+}
+
 void GrVkGpu::onFinishFlush(bool insertedSemaphore) {
     // Submit the current command buffer to the Queue. Whether we inserted semaphores or not does
     // not effect what we do here.
@@ -2381,7 +2626,7 @@ uint32_t GrVkGpu::getExtraSamplerKeyForProgram(const GrSamplerState& samplerStat
     const GrVkYcbcrConversionInfo* ycbcrInfo = format.getVkYcbcrConversionInfo();
     SkASSERT(ycbcrInfo);
     if (!ycbcrInfo->isValid()) {
-        return 0;
+        return this->getImmutableSamplerKeyForProgram(samplerState);
     }
 
     const GrVkSampler* sampler = this->resourceProvider().findOrCreateCompatibleSampler(
@@ -2390,6 +2635,33 @@ uint32_t GrVkGpu::getExtraSamplerKeyForProgram(const GrSamplerState& samplerStat
     return sampler->uniqueID();
 }
 
+uint32_t GrVkGpu::getImmutableSamplerKeyForProgram(const GrSamplerState& samplerState) {
+    if (!GrVkSampler::IsImmutableState(samplerState)) {
+        return 0;
+    }
+    // Unlike the sampler IDs used for conversions above, this stays the same across runs, so
+    // programs using it can still come from the persistent cache. The sampler IDs are too small
+    // to have the top bit set.
+    return (1u << 31) | GrVkSampler::GenerateKey(samplerState, GrVkYcbcrConversionInfo())
+                                .fSamplerKey;
+}
+
+uint32_t GrVkGpu::shaderCacheScope() const {
+    // SPIR-V and pipeline cache data are only valid for the device they came from.
+    struct {
+        uint32_t fVendorID;
+        uint32_t fDeviceID;
+        uint32_t fDriverVersion;
+        uint8_t  fPipelineCacheUUID[VK_UUID_SIZE];
+    } identity;
+    identity.fVendorID = fPhysDevProps.vendorID;
+    identity.fDeviceID = fPhysDevProps.deviceID;
+    identity.fDriverVersion = fPhysDevProps.driverVersion;
+    memcpy(identity.fPipelineCacheUUID, fPhysDevProps.pipelineCacheUUID, VK_UUID_SIZE);
+    uint32_t hash = SkOpts::hash_fn(&identity, sizeof(identity), SkOpts::hash_fn("Vk", 2, 0));
+    return hash ? hash : 1;
+}
+
 void GrVkGpu::storeVkPipelineCacheData() {
     if (this->getContext()->contextPriv().getPersistentCache()) {
         this->resourceProvider().storePipelineCacheData();
@@ -15,6 +15,7 @@
 #include "GrVkMemory.h"
 #include "GrVkResourceProvider.h"
 #include "GrVkSemaphore.h"
+#include "GrVkStagingRing.h"
 #include "GrVkVertexBuffer.h"
 #include "GrVkUtil.h"
 #include "vk/GrVkBackendContext.h"
@@ -112,12 +113,20 @@ public:
                                VkPipelineStageFlags dstStageMask,
                                bool byRegion,
                                VkImageMemoryBarrier* barrier) const;
+    void addImageMemoryBarriers(VkPipelineStageFlags srcStageMask,
+                                VkPipelineStageFlags dstStageMask,
+                                bool byRegion,
+                                VkImageMemoryBarrier* barriers,
+                                uint32_t barrierCount) const;
 
     SkSL::Compiler* shaderCompiler() const {
         return fCompiler;
     }
 
     bool onRegenerateMipMapLevels(GrTexture* tex) override;
+    void onBatchRegenerateMipMapLevels(GrTexture* const textures[], int count,
+                                       bool regenerated[]) override;
+    bool canBlitMipMapLevels(const GrVkTexture*) const;
 
     void resolveRenderTargetNoFlush(GrRenderTarget* target) {
         this->internalResolveRenderTarget(target, false);
@@ -165,6 +174,7 @@ public:
 
     uint32_t getExtraSamplerKeyForProgram(const GrSamplerState&,
                                           const GrBackendFormat& format) override;
+    uint32_t getImmutableSamplerKeyForProgram(const GrSamplerState&) override;
 
     enum PersistentCacheKeyType : uint32_t {
         kShader_PersistentCacheKeyType = 0,
@@ -173,6 +183,8 @@ public:
 
     void storeVkPipelineCacheData() override;
 
+    uint32_t shaderCacheScope() const override;
+
 private:
     GrVkGpu(GrContext*, const GrContextOptions&, const GrVkBackendContext&,
             sk_sp<const GrVkInterface>, uint32_t instanceVersion, uint32_t physicalDeviceVersion);
@@ -224,6 +236,14 @@ private:
     // wait semaphores to the submission of this command buffer.
     void submitCommandBuffer(SyncQueue sync);
 
+    bool onBeginTraceSpan(const char* name) override;
+    void onEndTraceSpan() override;
+    // While the "skia.gpu" category is traced, starts the current command buffer with the
+    // timestamp that the spans begun in it are placed relative to.
+    void anchorTraceSpans();
+    // Reports the spans whose timestamps the GPU has written, without waiting for the others.
+    void reportTraceSpans();
+
     void internalResolveRenderTarget(GrRenderTarget*, bool requiresSubmit);
 
     void copySurfaceAsCopyImage(GrSurface* dst, GrSurfaceOrigin dstOrigin,
@@ -287,6 +307,7 @@ private:
     VkPhysicalDeviceMemoryProperties                      fPhysDevMemProps;
 
     GrVkCopyManager                                       fCopyManager;
+    GrVkStagingRing                                       fStagingRing;
 
     // compiler used for compiling sksl into spirv. We only want to create the compiler once since
     // there is significant overhead to the first compile of any compiler.
@@ -299,6 +320,31 @@ private:
     std::unique_ptr<GrVkGpuRTCommandBuffer>               fCachedRTCommandBuffer;
     std::unique_ptr<GrVkGpuTextureCommandBuffer>          fCachedTexCommandBuffer;
 
+    // Core Vulkan can't read the GPU's clock, so the trace spans are placed relative to an anchor
+    // timestamp at the start of their command buffer, which we take to be when it was submitted.
+    struct TraceAnchor {
+        uint32_t fSerial;
+        uint32_t fQuery;
+        uint64_t fSubmitNs;  // On the steady clock, or 0 until the command buffer is submitted.
+    };
+    struct TraceSpan {
+        const char* fName;
+        uint32_t    fAnchorSerial;
+        uint32_t    fBeginQuery;
+        uint32_t    fEndQuery;
+    };
+    static constexpr uint32_t kMaxTimestampQueries = 1024;
+    VkQueryPool                                           fTimestampQueryPool = VK_NULL_HANDLE;
+    uint32_t                                              fTimestampValidBits = 0;
+    SkTDArray<uint32_t>                                   fFreeTimestampQueries;
+    // Oldest first. The last one belongs to fCurrentCmdBuffer if fCurrentCmdBufferAnchored.
+    SkTArray<TraceAnchor, true>                           fTraceAnchors;
+    bool                                                  fCurrentCmdBufferAnchored = false;
+    uint32_t                                              fNextTraceAnchorSerial = 0;
+    SkTArray<TraceSpan, true>                             fOpenTraceSpans;
+    // Spans that have ended, in the order they ended, waiting for their results.
+    SkTArray<TraceSpan, true>                             fPendingTraceSpans;
+
     typedef GrGpu INHERITED;
 };
 
@@ -324,7 +324,7 @@ void GrVkGpuRTCommandBuffer::discard() {
         GrVkRenderPass::LoadStoreOps vkColorOps(VK_ATTACHMENT_LOAD_OP_DONT_CARE,
                                                 VK_ATTACHMENT_STORE_OP_STORE);
         GrVkRenderPass::LoadStoreOps vkStencilOps(VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-                                                  VK_ATTACHMENT_STORE_OP_STORE);
+                                                  fVkStencilStoreOp);
 
         const GrVkRenderPass* oldRP = cbInfo.fRenderPass;
 
@@ -510,8 +510,27 @@ void GrVkGpuRTCommandBuffer::addAdditionalCommandBuffer() {
 
 void GrVkGpuRTCommandBuffer::addAdditionalRenderPass() {
     GrVkRenderTarget* vkRT = static_cast<GrVkRenderTarget*>(fRenderTarget);
+    const GrVkResourceProvider::CompatibleRPHandle& rpHandle =
+            vkRT->compatibleRenderPassHandle();
 
-    fCommandBufferInfos[fCurrentCmdInfo].currentCmdBuf()->end(fGpu);
+    CommandBufferInfo& prevInfo = fCommandBufferInfos[fCurrentCmdInfo];
+    prevInfo.currentCmdBuf()->end(fGpu);
+
+    const GrVkRenderPass* prevRP = prevInfo.fRenderPass;
+    if (VK_ATTACHMENT_STORE_OP_STORE != prevRP->stencilLoadStoreOps().fStoreOp) {
+        // Only the last render pass may discard the stencil values since the next one loads them.
+        GrVkRenderPass::LoadStoreOps vkStencilOps(prevRP->stencilLoadStoreOps().fLoadOp,
+                                                  VK_ATTACHMENT_STORE_OP_STORE);
+        if (rpHandle.isValid()) {
+            prevInfo.fRenderPass = fGpu->resourceProvider().findRenderPass(
+                    rpHandle, prevRP->colorLoadStoreOps(), vkStencilOps);
+        } else {
+            prevInfo.fRenderPass = fGpu->resourceProvider().findRenderPass(
+                    *vkRT, prevRP->colorLoadStoreOps(), vkStencilOps);
+        }
+        SkASSERT(prevInfo.fRenderPass->isCompatible(*prevRP));
+        prevRP->unref(fGpu);
+    }
 
     CommandBufferInfo& cbInfo = fCommandBufferInfos.push_back();
     fCurrentCmdInfo++;
@@ -519,10 +538,8 @@ void GrVkGpuRTCommandBuffer::addAdditionalRenderPass() {
     GrVkRenderPass::LoadStoreOps vkColorOps(VK_ATTACHMENT_LOAD_OP_LOAD,
                                             VK_ATTACHMENT_STORE_OP_STORE);
     GrVkRenderPass::LoadStoreOps vkStencilOps(VK_ATTACHMENT_LOAD_OP_LOAD,
-                                              VK_ATTACHMENT_STORE_OP_STORE);
+                                              fVkStencilStoreOp);
 
-    const GrVkResourceProvider::CompatibleRPHandle& rpHandle =
-            vkRT->compatibleRenderPassHandle();
     if (rpHandle.isValid()) {
         cbInfo.fRenderPass = fGpu->resourceProvider().findRenderPass(rpHandle,
                                                                      vkColorOps,
@@ -567,7 +584,7 @@ void GrVkGpuRTCommandBuffer::copy(GrSurface* src, GrSurfaceOrigin srcOrigin, con
         GrVkRenderPass::LoadStoreOps vkColorOps(VK_ATTACHMENT_LOAD_OP_LOAD,
                                                 VK_ATTACHMENT_STORE_OP_STORE);
         GrVkRenderPass::LoadStoreOps vkStencilOps(VK_ATTACHMENT_LOAD_OP_LOAD,
-                                                  VK_ATTACHMENT_STORE_OP_STORE);
+                                                  fVkStencilStoreOp);
 
         const GrVkRenderPass* oldRP = cbInfo.fRenderPass;
 
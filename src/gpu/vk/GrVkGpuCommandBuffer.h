@@ -58,6 +58,12 @@ private:
     typedef GrGpuTextureCommandBuffer INHERITED;
 };
 
+// Records a render pass into one or more GrVkSecondaryCommandBuffers, which submit() then executes
+// in order on the primary command buffer. All recording happens on the flush thread. Ops draw while
+// GrOpFlushState executes them, and a draw may record resolves and mip map regeneration on the
+// primary command buffer, look up and create pipeline states, or allocate uniform buffers and
+// descriptor sets, none of which are thread safe. The secondary buffers are also allocated from
+// the GrVkGpu's current command pool, which Vulkan requires the caller to synchronize.
 class GrVkGpuRTCommandBuffer : public GrGpuRTCommandBuffer, private GrMesh::SendToGpuImpl {
 public:
     GrVkGpuRTCommandBuffer(GrVkGpu*);
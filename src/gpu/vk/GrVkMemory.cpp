@@ -89,6 +89,7 @@ const VkDeviceSize kMaxSmallImageSize = 16 * 1024;
 bool GrVkMemory::AllocAndBindImageMemory(const GrVkGpu* gpu,
                                          VkImage image,
                                          bool linearTiling,
+                                         bool transient,
                                          GrVkAlloc* alloc) {
     SkASSERT(!linearTiling);
     GrVkMemoryAllocator* allocator = gpu->memoryAllocator();
@@ -103,6 +104,9 @@ bool GrVkMemory::AllocAndBindImageMemory(const GrVkGpu* gpu,
     } else {
         propFlags = AllocationPropertyFlags::kNone;
     }
+    if (transient) {
+        propFlags |= AllocationPropertyFlags::kLazyAllocation;
+    }
 
     if (!allocator->allocateMemoryForImage(image, propFlags, &memory)) {
         return false;
@@ -26,9 +26,12 @@ namespace GrVkMemory {
                                   GrVkAlloc* alloc);
     void FreeBufferMemory(const GrVkGpu* gpu, GrVkBuffer::Type type, const GrVkAlloc& alloc);
 
+    // A transient image is an attachment whose contents the device may never need to write out
+    // to memory, so we ask for lazily allocated memory for it.
     bool AllocAndBindImageMemory(const GrVkGpu* gpu,
                                  VkImage image,
                                  bool linearTiling,
+                                 bool transient,
                                  GrVkAlloc* alloc);
     void FreeImageMemory(const GrVkGpu* gpu, bool linearTiling, const GrVkAlloc& alloc);
 
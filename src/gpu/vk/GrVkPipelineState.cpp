@@ -45,7 +45,6 @@ GrVkPipelineState::GrVkPipelineState(
         : fPipeline(pipeline)
         , fPipelineLayout(new GrVkPipelineLayout(layout))
         , fUniformDescriptorSet(nullptr)
-        , fSamplerDescriptorSet(nullptr)
         , fSamplerDSHandle(samplerDSHandle)
         , fBuiltinUniformHandles(builtinUniformHandles)
         , fGeometryProcessor(std::move(geometryProcessor))
@@ -101,10 +100,10 @@ void GrVkPipelineState::freeGPUResources(GrVkGpu* gpu) {
         fUniformDescriptorSet = nullptr;
     }
 
-    if (fSamplerDescriptorSet) {
-        fSamplerDescriptorSet->recycle(const_cast<GrVkGpu*>(gpu));
-        fSamplerDescriptorSet = nullptr;
+    for (SamplerDescriptorSet& set : fSamplerDescriptorSets) {
+        this->releaseSamplerDescriptorSet(gpu, &set);
     }
+    fSamplerDescriptorSets.reset();
 }
 
 void GrVkPipelineState::abandonGPUResources() {
@@ -133,9 +132,29 @@ void GrVkPipelineState::abandonGPUResources() {
         fUniformDescriptorSet = nullptr;
     }
 
-    if (fSamplerDescriptorSet) {
-        fSamplerDescriptorSet->unrefAndAbandon();
-        fSamplerDescriptorSet = nullptr;
+    for (SamplerDescriptorSet& set : fSamplerDescriptorSets) {
+        this->abandonSamplerDescriptorSet(&set);
+    }
+    fSamplerDescriptorSets.reset();
+}
+
+void GrVkPipelineState::releaseSamplerDescriptorSet(GrVkGpu* gpu, SamplerDescriptorSet* set) {
+    set->fDescriptorSet->recycle(gpu);
+    for (const GrVkImageView* view : set->fImageViews) {
+        view->unref(gpu);
+    }
+    for (const GrVkSampler* sampler : set->fSamplers) {
+        sampler->unref(gpu);
+    }
+}
+
+void GrVkPipelineState::abandonSamplerDescriptorSet(SamplerDescriptorSet* set) {
+    set->fDescriptorSet->unrefAndAbandon();
+    for (const GrVkImageView* view : set->fImageViews) {
+        view->unrefAndAbandon();
+    }
+    for (const GrVkSampler* sampler : set->fSamplers) {
+        sampler->unrefAndAbandon();
     }
 }
 
@@ -237,40 +256,79 @@ void GrVkPipelineState::setAndBindTextures(GrVkGpu* gpu,
                 static_cast<GrVkTexture*>(dstTextureProxy->peekTexture())};
     }
 
-    // Get new descriptor set
     SkASSERT(fNumSamplers == currTextureBinding);
-    if (fNumSamplers) {
-        if (fSamplerDescriptorSet) {
-            fSamplerDescriptorSet->recycle(gpu);
+    if (!fNumSamplers) {
+        return;
+    }
+
+    // Find the view and sampler for each binding. The samplers come back reffed.
+    SkAutoSTMalloc<8, const GrVkImageView*> views(fNumSamplers);
+    SkAutoSTMalloc<8, const GrVkSampler*> samplers(fNumSamplers);
+    for (int i = 0; i < fNumSamplers; ++i) {
+        GrVkTexture* texture = samplerBindings[i].fTexture;
+        views[i] = texture->textureView();
+        if (fImmutableSamplers[i]) {
+            samplers[i] = fImmutableSamplers[i];
+            samplers[i]->ref();
+        } else {
+            samplers[i] = gpu->resourceProvider().findOrCreateCompatibleSampler(
+                    samplerBindings[i].fState, texture->ycbcrConversionInfo());
+        }
+        SkASSERT(samplers[i]);
+    }
+
+    // Image heavy content tends to draw the same few textures over and over, so look for a
+    // descriptor set that already holds these bindings before writing a new one.
+    int setIdx = -1;
+    for (int j = fSamplerDescriptorSets.count() - 1; j >= 0 && setIdx < 0; --j) {
+        const SamplerDescriptorSet& set = fSamplerDescriptorSets[j];
+        if (!memcmp(set.fImageViews.begin(), views.get(), fNumSamplers * sizeof(views[0])) &&
+            !memcmp(set.fSamplers.begin(), samplers.get(), fNumSamplers * sizeof(samplers[0]))) {
+            setIdx = j;
+        }
+    }
+    if (setIdx >= 0) {
+        // Keep the most recently used set at the end.
+        for (int j = setIdx; j < fSamplerDescriptorSets.count() - 1; ++j) {
+            using std::swap;
+            swap(fSamplerDescriptorSets[j], fSamplerDescriptorSets[j + 1]);
         }
-        fSamplerDescriptorSet = gpu->resourceProvider().getSamplerDescriptorSet(fSamplerDSHandle);
-        int samplerDSIdx = GrVkUniformHandler::kSamplerDescSet;
-        fDescriptorSets[samplerDSIdx] = fSamplerDescriptorSet->descriptorSet();
+        // The set holds its own refs; drop the ones we took above.
         for (int i = 0; i < fNumSamplers; ++i) {
-            const GrSamplerState& state = samplerBindings[i].fState;
-            GrVkTexture* texture = samplerBindings[i].fTexture;
-
-            const GrVkImageView* textureView = texture->textureView();
-            const GrVkSampler* sampler = nullptr;
-            if (fImmutableSamplers[i]) {
-                sampler = fImmutableSamplers[i];
-            } else {
-                sampler = gpu->resourceProvider().findOrCreateCompatibleSampler(
-                    state, texture->ycbcrConversionInfo());
+            samplers[i]->unref(gpu);
+        }
+    } else {
+        if (fSamplerDescriptorSets.count() == kMaxCachedSamplerDescriptorSets) {
+            // Evict the least recently used set.
+            this->releaseSamplerDescriptorSet(gpu, &fSamplerDescriptorSets[0]);
+            for (int j = 0; j < fSamplerDescriptorSets.count() - 1; ++j) {
+                using std::swap;
+                swap(fSamplerDescriptorSets[j], fSamplerDescriptorSets[j + 1]);
             }
-            SkASSERT(sampler);
+            fSamplerDescriptorSets.pop_back();
+        }
+        SamplerDescriptorSet& set = fSamplerDescriptorSets.push_back();
+        set.fDescriptorSet = gpu->resourceProvider().getSamplerDescriptorSet(fSamplerDSHandle);
 
-            VkDescriptorImageInfo imageInfo;
+        SkAutoSTMalloc<8, VkDescriptorImageInfo> imageInfos(fNumSamplers);
+        SkAutoSTMalloc<8, VkWriteDescriptorSet> writeInfos(fNumSamplers);
+        for (int i = 0; i < fNumSamplers; ++i) {
+            // The set takes over the sampler refs from above.
+            views[i]->ref();
+            set.fImageViews.push_back(views[i]);
+            set.fSamplers.push_back(samplers[i]);
+
+            VkDescriptorImageInfo& imageInfo = imageInfos[i];
             memset(&imageInfo, 0, sizeof(VkDescriptorImageInfo));
-            imageInfo.sampler = sampler->sampler();
-            imageInfo.imageView = textureView->imageView();
+            imageInfo.sampler = samplers[i]->sampler();
+            imageInfo.imageView = views[i]->imageView();
             imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
-            VkWriteDescriptorSet writeInfo;
+            VkWriteDescriptorSet& writeInfo = writeInfos[i];
             memset(&writeInfo, 0, sizeof(VkWriteDescriptorSet));
             writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
             writeInfo.pNext = nullptr;
-            writeInfo.dstSet = fDescriptorSets[GrVkUniformHandler::kSamplerDescSet];
+            writeInfo.dstSet = set.fDescriptorSet->descriptorSet();
             writeInfo.dstBinding = i;
             writeInfo.dstArrayElement = 0;
             writeInfo.descriptorCount = 1;
@@ -278,21 +336,23 @@ void GrVkPipelineState::setAndBindTextures(GrVkGpu* gpu,
             writeInfo.pImageInfo = &imageInfo;
             writeInfo.pBufferInfo = nullptr;
             writeInfo.pTexelBufferView = nullptr;
-
-            GR_VK_CALL(gpu->vkInterface(),
-                       UpdateDescriptorSets(gpu->device(), 1, &writeInfo, 0, nullptr));
-            commandBuffer->addResource(sampler);
-            if (!fImmutableSamplers[i]) {
-                sampler->unref(gpu);
-            }
-            commandBuffer->addResource(samplerBindings[i].fTexture->textureView());
-            commandBuffer->addResource(samplerBindings[i].fTexture->resource());
         }
+        GR_VK_CALL(gpu->vkInterface(), UpdateDescriptorSets(gpu->device(), fNumSamplers,
+                                                            writeInfos.get(), 0, nullptr));
+    }
 
-        commandBuffer->bindDescriptorSets(gpu, this, fPipelineLayout, samplerDSIdx, 1,
-                                          &fDescriptorSets[samplerDSIdx], 0, nullptr);
-        commandBuffer->addRecycledResource(fSamplerDescriptorSet);
+    const SamplerDescriptorSet& set = fSamplerDescriptorSets.back();
+    for (int i = 0; i < fNumSamplers; ++i) {
+        commandBuffer->addResource(set.fSamplers[i]);
+        commandBuffer->addResource(set.fImageViews[i]);
+        commandBuffer->addResource(samplerBindings[i].fTexture->resource());
     }
+
+    int samplerDSIdx = GrVkUniformHandler::kSamplerDescSet;
+    fDescriptorSets[samplerDSIdx] = set.fDescriptorSet->descriptorSet();
+    commandBuffer->bindDescriptorSets(gpu, this, fPipelineLayout, samplerDSIdx, 1,
+                                      &fDescriptorSets[samplerDSIdx], 0, nullptr);
+    commandBuffer->addRecycledResource(set.fDescriptorSet);
 }
 
 void set_uniform_descriptor_writes(VkWriteDescriptorSet* descriptorWrite,
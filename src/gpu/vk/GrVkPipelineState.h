@@ -131,7 +131,22 @@ private:
     VkDescriptorSet fDescriptorSets[3];
 
     const GrVkDescriptorSet* fUniformDescriptorSet;
-    const GrVkDescriptorSet* fSamplerDescriptorSet;
+
+    // A sampler descriptor set that has already been written, along with refs on the image views
+    // and samplers written into it. The refs keep those objects (and so their handles) alive, so
+    // an entry whose bindings match a draw's can be bound again without updating any descriptors.
+    struct SamplerDescriptorSet {
+        const GrVkDescriptorSet*             fDescriptorSet;
+        SkTArray<const GrVkImageView*, true> fImageViews;
+        SkTArray<const GrVkSampler*, true>   fSamplers;
+    };
+    static constexpr int kMaxCachedSamplerDescriptorSets = 8;
+
+    void releaseSamplerDescriptorSet(GrVkGpu*, SamplerDescriptorSet*);
+    void abandonSamplerDescriptorSet(SamplerDescriptorSet*);
+
+    // The most recently used entry is at the end.
+    SkSTArray<kMaxCachedSamplerDescriptorSets, SamplerDescriptorSet> fSamplerDescriptorSets;
 
     const GrVkDescriptorSetManager::Handle fSamplerDSHandle;
 
@@ -111,14 +111,17 @@ GrVkPipelineState* GrVkResourceProvider::PipelineStateCache::refPipelineState(
 #ifdef GR_PIPELINE_STATE_CACHE_STATS
         ++fCacheMisses;
 #endif
+        ++fGpu->frameStats()->fShaderCacheMisses;
         GrVkPipelineState* pipelineState(GrVkPipelineStateBuilder::CreatePipelineState(
                 fGpu, renderTarget, origin, primProc, primProcProxies, pipeline, stencil,
                 primitiveType, &desc, compatibleRenderPass));
         if (nullptr == pipelineState) {
             return nullptr;
         }
+        ++fGpu->frameStats()->fProgramsCompiled;
         entry = fMap.insert(desc, std::unique_ptr<Entry>(new Entry(fGpu, pipelineState)));
         return (*entry)->fPipelineState.get();
     }
+    ++fGpu->frameStats()->fShaderCacheHits;
     return (*entry)->fPipelineState.get();
 }
@@ -25,7 +25,8 @@ std::atomic<uint32_t> GrVkResource::fKeyCounter{0};
 
 GrVkResourceProvider::GrVkResourceProvider(GrVkGpu* gpu)
     : fGpu(gpu)
-    , fPipelineCache(VK_NULL_HANDLE) {
+    , fPipelineCache(VK_NULL_HANDLE)
+    , fPipelineCacheDirty(false) {
     fPipelineStateCache = new PipelineStateCache(gpu);
 }
 
@@ -36,50 +37,78 @@ GrVkResourceProvider::~GrVkResourceProvider() {
     delete fPipelineStateCache;
 }
 
+// The persistent cache key for our VkPipelineCache data. It includes the driver version, so that a
+// driver update starts a fresh cache rather than handing the new driver a blob it will reject.
+static sk_sp<SkData> pipeline_cache_key(const VkPhysicalDeviceProperties& devProps) {
+    uint32_t key[] = {
+        GrVkGpu::kPipelineCache_PersistentCacheKeyType,
+        devProps.vendorID,
+        devProps.deviceID,
+        devProps.driverVersion,
+    };
+    return SkData::MakeWithCopy(key, sizeof(key));
+}
+
+// Returns true if data has a pipeline cache header this device will accept.
+static bool is_compatible_pipeline_cache_data(const SkData& data,
+                                              const VkPhysicalDeviceProperties& devProps) {
+    // For version one of the header, the total header size is 16 bytes plus VK_UUID_SIZE bytes.
+    // See Section 9.6 (Pipeline Cache) in the vulkan spec to see the breakdown of these bytes.
+    static constexpr size_t kHeaderSize = 16 + VK_UUID_SIZE;
+    if (data.size() < kHeaderSize) {
+        return false;
+    }
+    uint32_t cacheHeader[4];
+    memcpy(cacheHeader, data.data(), sizeof(cacheHeader));
+    return cacheHeader[0] == kHeaderSize &&
+           cacheHeader[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           cacheHeader[2] == devProps.vendorID &&
+           cacheHeader[3] == devProps.deviceID &&
+           !memcmp(data.bytes() + sizeof(cacheHeader), devProps.pipelineCacheUUID, VK_UUID_SIZE);
+}
+
+// Loads this device's pipeline cache data from the context's persistent cache, if it has any.
+static sk_sp<SkData> load_pipeline_cache_data(GrVkGpu* gpu) {
+    auto persistentCache = gpu->getContext()->contextPriv().getPersistentCache();
+    if (!persistentCache) {
+        return nullptr;
+    }
+    const VkPhysicalDeviceProperties& devProps = gpu->physicalDeviceProperties();
+    sk_sp<SkData> cached = persistentCache->load(*pipeline_cache_key(devProps));
+    if (!cached || !is_compatible_pipeline_cache_data(*cached, devProps)) {
+        return nullptr;
+    }
+    return cached;
+}
+
+// Creates a VkPipelineCache, seeded with initialData if it isn't null.
+static VkPipelineCache create_pipeline_cache(GrVkGpu* gpu, const SkData* initialData) {
+    VkPipelineCacheCreateInfo createInfo;
+    memset(&createInfo, 0, sizeof(VkPipelineCacheCreateInfo));
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0;
+    createInfo.initialDataSize = initialData ? initialData->size() : 0;
+    createInfo.pInitialData = initialData ? initialData->data() : nullptr;
+
+    VkPipelineCache cache = VK_NULL_HANDLE;
+    VkResult result = GR_VK_CALL(gpu->vkInterface(),
+                                 CreatePipelineCache(gpu->device(), &createInfo, nullptr, &cache));
+    if (VK_SUCCESS != result) {
+        return VK_NULL_HANDLE;
+    }
+    return cache;
+}
+
 VkPipelineCache GrVkResourceProvider::pipelineCache() {
     if (fPipelineCache == VK_NULL_HANDLE) {
-        VkPipelineCacheCreateInfo createInfo;
-        memset(&createInfo, 0, sizeof(VkPipelineCacheCreateInfo));
-        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-        createInfo.pNext = nullptr;
-        createInfo.flags = 0;
-
-        auto persistentCache = fGpu->getContext()->contextPriv().getPersistentCache();
-        sk_sp<SkData> cached;
-        if (persistentCache) {
-            uint32_t key = GrVkGpu::kPipelineCache_PersistentCacheKeyType;
-            sk_sp<SkData> keyData = SkData::MakeWithoutCopy(&key, sizeof(uint32_t));
-            cached = persistentCache->load(*keyData);
-        }
-        bool usedCached = false;
-        if (cached) {
-            uint32_t* cacheHeader = (uint32_t*)cached->data();
-            if (cacheHeader[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
-                // For version one of the header, the total header size is 16 bytes plus
-                // VK_UUID_SIZE bytes. See Section 9.6 (Pipeline Cache) in the vulkan spec to see
-                // the breakdown of these bytes.
-                SkASSERT(cacheHeader[0] == 16 + VK_UUID_SIZE);
-                const VkPhysicalDeviceProperties& devProps = fGpu->physicalDeviceProperties();
-                const uint8_t* supportedPipelineCacheUUID = devProps.pipelineCacheUUID;
-                if (cacheHeader[2] == devProps.vendorID && cacheHeader[3] == devProps.deviceID &&
-                    !memcmp(&cacheHeader[4], supportedPipelineCacheUUID, VK_UUID_SIZE)) {
-                    createInfo.initialDataSize = cached->size();
-                    createInfo.pInitialData = cached->data();
-                    usedCached = true;
-                }
-            }
-        }
-        if (!usedCached) {
-            createInfo.initialDataSize = 0;
-            createInfo.pInitialData = nullptr;
-        }
-        VkResult result = GR_VK_CALL(fGpu->vkInterface(),
-                                     CreatePipelineCache(fGpu->device(), &createInfo, nullptr,
-                                                         &fPipelineCache));
-        SkASSERT(VK_SUCCESS == result);
-        if (VK_SUCCESS != result) {
-            fPipelineCache = VK_NULL_HANDLE;
+        sk_sp<SkData> cached = load_pipeline_cache_data(fGpu);
+        fPipelineCache = create_pipeline_cache(fGpu, cached.get());
+        if (fPipelineCache == VK_NULL_HANDLE && cached) {
+            // The driver rejected the stored data, so start over with an empty cache.
+            fPipelineCache = create_pipeline_cache(fGpu, nullptr);
         }
+        SkASSERT(VK_NULL_HANDLE != fPipelineCache);
     }
     return fPipelineCache;
 }
@@ -101,6 +130,7 @@ GrVkPipeline* GrVkResourceProvider::createPipeline(int numColorSamples,
                                                    GrPrimitiveType primitiveType,
                                                    VkRenderPass compatibleRenderPass,
                                                    VkPipelineLayout layout) {
+    fPipelineCacheDirty = true;
     return GrVkPipeline::Create(fGpu, numColorSamples, primProc, pipeline, stencil, shaderStageInfo,
                                 shaderStageCount, primitiveType, compatibleRenderPass, layout,
                                 this->pipelineCache());
@@ -126,6 +156,7 @@ GrVkCopyPipeline* GrVkResourceProvider::findOrCreateCopyPipeline(
         if (!pipeline) {
             return nullptr;
         }
+        fPipelineCacheDirty = true;
         fCopyPipelines.push_back(pipeline);
     }
     SkASSERT(pipeline);
@@ -391,6 +422,12 @@ void GrVkResourceProvider::destroyResources(bool deviceLost) {
         taskGroup->wait();
     }
 
+    // Don't throw away pipelines built since the client last stored the cache.
+    if (!deviceLost && fPipelineCacheDirty &&
+        fGpu->getContext()->contextPriv().getPersistentCache()) {
+        this->storePipelineCacheData();
+    }
+
     // Release all copy pipelines
     for (int i = 0; i < fCopyPipelines.count(); ++i) {
         fCopyPipelines[i]->unref(fGpu);
@@ -527,25 +564,47 @@ void GrVkResourceProvider::reset(GrVkCommandPool* pool) {
 }
 
 void GrVkResourceProvider::storePipelineCacheData() {
+    auto persistentCache = fGpu->getContext()->contextPriv().getPersistentCache();
+    VkPipelineCache pipelineCache = this->pipelineCache();
+    if (!persistentCache || VK_NULL_HANDLE == pipelineCache) {
+        return;
+    }
+
+    // Other contexts, in this process or others, may have stored pipelines to the same persistent
+    // cache since we loaded from it. Merge theirs into ours rather than overwriting them.
+    if (sk_sp<SkData> stored = load_pipeline_cache_data(fGpu)) {
+        VkPipelineCache storedCache = create_pipeline_cache(fGpu, stored.get());
+        if (VK_NULL_HANDLE != storedCache) {
+            VkResult result = GR_VK_CALL(fGpu->vkInterface(),
+                                         MergePipelineCaches(fGpu->device(), pipelineCache, 1,
+                                                             &storedCache));
+            SkASSERT(result == VK_SUCCESS);
+            GR_VK_CALL(fGpu->vkInterface(),
+                       DestroyPipelineCache(fGpu->device(), storedCache, nullptr));
+        }
+    }
+
     size_t dataSize = 0;
     VkResult result = GR_VK_CALL(fGpu->vkInterface(), GetPipelineCacheData(fGpu->device(),
-                                                                           this->pipelineCache(),
+                                                                           pipelineCache,
                                                                            &dataSize, nullptr));
-    SkASSERT(result == VK_SUCCESS);
+    if (result != VK_SUCCESS || !dataSize) {
+        return;
+    }
 
     std::unique_ptr<uint8_t[]> data(new uint8_t[dataSize]);
 
     result = GR_VK_CALL(fGpu->vkInterface(), GetPipelineCacheData(fGpu->device(),
-                                                                  this->pipelineCache(),
+                                                                  pipelineCache,
                                                                   &dataSize,
                                                                   (void*)data.get()));
-    SkASSERT(result == VK_SUCCESS);
-
-    uint32_t key = GrVkGpu::kPipelineCache_PersistentCacheKeyType;
-    sk_sp<SkData> keyData = SkData::MakeWithoutCopy(&key, sizeof(uint32_t));
+    if (result != VK_SUCCESS) {
+        return;
+    }
 
-    fGpu->getContext()->contextPriv().getPersistentCache()->store(
-            *keyData, *SkData::MakeWithoutCopy(data.get(), dataSize));
+    persistentCache->store(*pipeline_cache_key(fGpu->physicalDeviceProperties()),
+                           *SkData::MakeWithoutCopy(data.get(), dataSize));
+    fPipelineCacheDirty = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
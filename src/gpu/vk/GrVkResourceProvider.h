@@ -158,6 +158,9 @@ public:
     // can be reused by the next uniform buffer resource request.
     void recycleStandardUniformBufferResource(const GrVkResource*);
 
+    // Writes the pipeline cache to the context's persistent cache, merged with whatever other
+    // contexts have stored there since we loaded it. This also happens when the resources are
+    // destroyed, if pipelines have been created since the last store.
     void storePipelineCacheData();
 
     // Destroy any cached resources. To be called before destroying the VkDevice.
@@ -256,6 +259,8 @@ private:
 
     // Central cache for creating pipelines
     VkPipelineCache fPipelineCache;
+    // Whether pipelines have been added to fPipelineCache since it was last stored.
+    bool fPipelineCacheDirty;
 
     // Cache of previously created copy pipelines
     SkTArray<GrVkCopyPipeline*> fCopyPipelines;
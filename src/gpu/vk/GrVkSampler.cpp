@@ -126,6 +126,12 @@ void GrVkSampler::abandonGPUData() const {
     }
 }
 
+bool GrVkSampler::IsImmutableState(const GrSamplerState& samplerState) {
+    return GrSamplerState::WrapMode::kClamp == samplerState.wrapModeX() &&
+           GrSamplerState::WrapMode::kClamp == samplerState.wrapModeY() &&
+           GrSamplerState::Filter::kMipMap != samplerState.filter();
+}
+
 GrVkSampler::Key GrVkSampler::GenerateKey(const GrSamplerState& samplerState,
                                           const GrVkYcbcrConversionInfo& ycbcrInfo) {
     const int kTileModeXShift = 2;
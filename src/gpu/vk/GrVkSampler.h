@@ -21,6 +21,11 @@ class GrVkSampler : public GrVkResource {
 public:
     static GrVkSampler* Create(GrVkGpu* gpu, const GrSamplerState&, const GrVkYcbcrConversionInfo&);
 
+    // Samplers with the states most draws use are baked into the descriptor set layouts of the
+    // pipelines that use them. Then the draws don't have to find a sampler for each binding, and
+    // descriptor sets that hold the same image views can be shared regardless of the sampler.
+    static bool IsImmutableState(const GrSamplerState&);
+
     VkSampler sampler() const { return fSampler; }
     const VkSampler* samplerPtr() const { return &fSampler; }
 
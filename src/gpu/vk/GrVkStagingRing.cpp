@@ -0,0 +1,76 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrVkStagingRing.h"
+
+#include "GrVkGpu.h"
+#include "GrVkMemory.h"
+
+constexpr size_t GrVkStagingRing::kBufferSize;
+constexpr int GrVkStagingRing::kMaxBuffers;
+
+static bool is_idle(const GrVkTransferBuffer* buffer) {
+    // Command buffers that copy from the buffer ref its resource until they finish on the GPU.
+    return !buffer->wasDestroyed() && buffer->resource()->unique();
+}
+
+char* GrVkStagingRing::map(GrVkGpu* gpu, size_t size, size_t alignment, Slice* slice) {
+    SkASSERT(SkIsPow2(alignment));
+    // Big uploads amortize a buffer of their own, and would waste most of a shared one.
+    if (size > kBufferSize / 2) {
+        return nullptr;
+    }
+
+    size_t offset = SkAlign4(fCurrentUsed);
+    offset = (offset + alignment - 1) & ~(alignment - 1);
+    if (fCurrent < 0 || fBuffers[fCurrent]->wasDestroyed() || offset + size > kBufferSize) {
+        // Move on to a buffer the GPU is done with, making one if there is room for another.
+        fCurrent = -1;
+        for (int i = 0; i < fBuffers.count(); ++i) {
+            if (is_idle(fBuffers[i].get())) {
+                fCurrent = i;
+                break;
+            }
+        }
+        if (fCurrent < 0) {
+            if (fBuffers.count() >= kMaxBuffers) {
+                return nullptr;
+            }
+            sk_sp<GrVkTransferBuffer> buffer =
+                    GrVkTransferBuffer::Make(gpu, kBufferSize, GrVkBuffer::kCopyRead_Type);
+            if (!buffer) {
+                return nullptr;
+            }
+            fCurrent = fBuffers.count();
+            fBuffers.push_back(std::move(buffer));
+        }
+        offset = 0;
+    }
+
+    GrVkTransferBuffer* buffer = fBuffers[fCurrent].get();
+    char* mapped = static_cast<char*>(GrVkMemory::MapAlloc(gpu, buffer->alloc()));
+    if (!mapped) {
+        return nullptr;
+    }
+    fCurrentUsed = offset + size;
+    slice->fBuffer = buffer;
+    slice->fOffset = buffer->offset() + offset;
+    return mapped + offset;
+}
+
+void GrVkStagingRing::unmap(GrVkGpu* gpu, const Slice& slice, size_t size) {
+    const GrVkAlloc& alloc = slice.fBuffer->alloc();
+    // Noncoherent flushes have to start at the beginning of the allocation.
+    GrVkMemory::FlushMappedAlloc(gpu, alloc, 0, slice.fOffset - slice.fBuffer->offset() + size);
+    GrVkMemory::UnmapAlloc(gpu, alloc);
+}
+
+void GrVkStagingRing::reset() {
+    fBuffers.reset();
+    fCurrent = -1;
+    fCurrentUsed = 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrVkStagingRing_DEFINED
+#define GrVkStagingRing_DEFINED
+
+#include "GrVkTransferBuffer.h"
+#include "SkTArray.h"
+
+class GrVkGpu;
+
+/**
+ * Sub-allocates staging memory for texture uploads from a few large transfer buffers, so that an
+ * upload doesn't have to create and destroy a VkBuffer of its own. Slices of a buffer are handed
+ * out in order until it is full. A full buffer is only written again once no command buffer holds
+ * a ref on it, i.e. once the GPU has finished reading every upload staged in it.
+ */
+class GrVkStagingRing {
+public:
+    struct Slice {
+        GrVkTransferBuffer* fBuffer;
+        // Offset of the slice from the start of fBuffer's VkBuffer, for VkBufferImageCopy.
+        VkDeviceSize        fOffset;
+    };
+
+    /**
+     * Copies size bytes, produced by write(dst), into a slice aligned to alignment (a power of
+     * two). The slice must be read by a command recorded on the current command buffer before it
+     * is submitted. Returns false if the upload is too large to share a buffer, or if every buffer
+     * is still in flight; the caller should then make a transfer buffer of its own.
+     */
+    template <typename WriteFn>
+    bool stage(GrVkGpu* gpu, size_t size, size_t alignment, const WriteFn& write, Slice* slice) {
+        char* dst = this->map(gpu, size, alignment, slice);
+        if (!dst) {
+            return false;
+        }
+        write(dst);
+        this->unmap(gpu, *slice, size);
+        return true;
+    }
+
+    /** Drops the ring's buffers. Called when the GrVkGpu destroys or abandons its resources. */
+    void reset();
+
+private:
+    static constexpr size_t kBufferSize = 4 * 1024 * 1024;
+    static constexpr int kMaxBuffers = 4;
+
+    char* map(GrVkGpu*, size_t size, size_t alignment, Slice*);
+    void unmap(GrVkGpu*, const Slice&, size_t size);
+
+    SkTArray<sk_sp<GrVkTransferBuffer>> fBuffers;
+    int fCurrent = -1;
+    size_t fCurrentUsed = 0;
+};
+
+#endif
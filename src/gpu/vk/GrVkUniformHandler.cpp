@@ -284,9 +284,11 @@ GrGLSLUniformHandler::SamplerHandle GrVkUniformHandler::addSampler(const GrTextu
     info.fUBOffset = 0;
 
     // Check if we are dealing with an external texture and store the needed information if so
+    // Common sampler states are also made immutable. The program key has the state in that case
+    // (see GrVkGpu::getImmutableSamplerKeyForProgram()).
     const GrVkTexture* vkTexture = static_cast<const GrVkTexture*>(texture);
-    if (vkTexture->ycbcrConversionInfo().isValid()) {
-        SkASSERT(type == GrTextureType::kExternal);
+    if (vkTexture->ycbcrConversionInfo().isValid() || GrVkSampler::IsImmutableState(state)) {
+        SkASSERT(!vkTexture->ycbcrConversionInfo().isValid() || type == GrTextureType::kExternal);
         GrVkGpu* gpu = static_cast<GrVkPipelineStateBuilder*>(fProgramBuilder)->gpu();
         info.fImmutableSampler = gpu->resourceProvider().findOrCreateCompatibleSampler(
                 state, vkTexture->ycbcrConversionInfo());
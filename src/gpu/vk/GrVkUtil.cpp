@@ -73,6 +73,21 @@ bool GrPixelConfigToVkFormat(GrPixelConfig config, VkFormat* format) {
             // converting to ETC2 which is a superset of ETC1
             *format = VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK;
             return true;
+        case kRGBA_ETC2_GrPixelConfig:
+            *format = VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+            return true;
+        case kRGBA_ASTC_4x4_GrPixelConfig:
+            *format = VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+            return true;
+        case kRGBA_BC1_GrPixelConfig:
+            *format = VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+            return true;
+        case kRGBA_BC3_GrPixelConfig:
+            *format = VK_FORMAT_BC3_UNORM_BLOCK;
+            return true;
+        case kRGBA_BC7_GrPixelConfig:
+            *format = VK_FORMAT_BC7_UNORM_BLOCK;
+            return true;
         case kAlpha_half_GrPixelConfig: // fall through
         case kAlpha_half_as_Red_GrPixelConfig:
             *format = VK_FORMAT_R16_SFLOAT;
@@ -112,6 +127,16 @@ bool GrVkFormatPixelConfigPairIsValid(VkFormat format, GrPixelConfig config) {
                    kGray_8_as_Red_GrPixelConfig == config;
         case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
             return kRGB_ETC1_GrPixelConfig == config;
+        case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+            return kRGBA_ETC2_GrPixelConfig == config;
+        case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+            return kRGBA_ASTC_4x4_GrPixelConfig == config;
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+            return kRGBA_BC1_GrPixelConfig == config;
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+            return kRGBA_BC3_GrPixelConfig == config;
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+            return kRGBA_BC7_GrPixelConfig == config;
         case VK_FORMAT_R32G32B32A32_SFLOAT:
             return kRGBA_float_GrPixelConfig == config;
         case VK_FORMAT_R32G32_SFLOAT:
@@ -141,6 +166,11 @@ bool GrVkFormatIsSupported(VkFormat format) {
         case VK_FORMAT_B4G4R4A4_UNORM_PACK16:
         case VK_FORMAT_R8_UNORM:
         case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+        case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
         case VK_FORMAT_R32G32B32A32_SFLOAT:
         case VK_FORMAT_R32G32_SFLOAT:
         case VK_FORMAT_R16G16B16A16_SFLOAT:
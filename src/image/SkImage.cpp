@@ -14,6 +14,7 @@
 #include "SkImageEncoder.h"
 #include "SkImageFilter.h"
 #include "SkImageFilterCache.h"
+#include "SkImageFilterPriv.h"
 #include "SkImageGenerator.h"
 #include "SkImagePriv.h"
 #include "SkImageShader.h"
@@ -274,9 +275,11 @@ sk_sp<SkImage> SkImage::makeWithFilter(GrContext* grContext,
         SkImageFilterCache::Create(SkImageFilterCache::kDefaultTransientSize));
     SkImageFilter::OutputProperties outputProperties(as_IB(this)->onImageInfo().colorType(),
                                                      as_IB(this)->onImageInfo().colorSpace());
-    SkImageFilter::Context context(SkMatrix::I(), clipBounds, cache.get(), outputProperties);
+    SkImageFilter::Context context(SkMatrix::I(), clipBounds, cache.get(), outputProperties,
+                                   gSkImageFilterExecutor.load(std::memory_order_relaxed));
 
-    sk_sp<SkSpecialImage> result = filter->filterImage(srcSpecialImage.get(), context, offset);
+    sk_sp<SkSpecialImage> result = SkFilterImageInTiles(filter, srcSpecialImage.get(), context,
+                                                        offset);
     if (!result) {
         return nullptr;
     }
@@ -441,6 +444,16 @@ sk_sp<SkImage> SkImage::makeTextureImage(GrContext*, SkColorSpace* dstColorSpace
     return nullptr;
 }
 
+sk_sp<SkImage> SkImage::makeTextureImageAsync(GrContext*, SkColorSpace*, TextureReadyProc,
+                                              ReleaseContext) const {
+    return nullptr;
+}
+
+sk_sp<SkImage> SkImage::makeCompressedTextureImageAsync(GrContext*, SkColorSpace*,
+                                                        TextureReadyProc, ReleaseContext) const {
+    return nullptr;
+}
+
 sk_sp<SkImage> MakeFromNV12TexturesCopyWithExternalBackend(GrContext* context,
                                                            SkYUVColorSpace yuvColorSpace,
                                                            const GrBackendTexture nv12Textures[2],
@@ -18,6 +18,7 @@
 #include "GrColorSpaceXform.h"
 #include "GrContext.h"
 #include "GrContextPriv.h"
+#include "GrDeferredProxyUploader.h"
 #include "GrGpu.h"
 #include "GrImageTextureMaker.h"
 #include "GrProxyProvider.h"
@@ -39,8 +40,11 @@
 #include "SkImage_Gpu.h"
 #include "SkMipMap.h"
 #include "SkScopeExit.h"
+#include "SkSemaphore.h"
+#include "SkTaskGroup.h"
 #include "SkTraceEvent.h"
 #include "effects/GrYUVtoRGBEffect.h"
+#include "etc1.h"
 #include "gl/GrGLTexture.h"
 
 SkImage_Gpu::SkImage_Gpu(sk_sp<GrContext> context, uint32_t uniqueID, SkAlphaType at,
@@ -161,14 +165,35 @@ sk_sp<SkImage> SkImage::MakeFromCompressed(GrContext* context, sk_sp<SkData> dat
     desc.fFlags = kNone_GrSurfaceFlags;
     desc.fWidth = width;
     desc.fHeight = height;
+    SkAlphaType alphaType = kPremul_SkAlphaType;
     switch (type) {
         case kETC1_CompressionType:
             desc.fConfig = kRGB_ETC1_GrPixelConfig;
+            alphaType = kOpaque_SkAlphaType;
+            break;
+        case kETC2_RGBA_CompressionType:
+            desc.fConfig = kRGBA_ETC2_GrPixelConfig;
+            break;
+        case kASTC_4x4_CompressionType:
+            desc.fConfig = kRGBA_ASTC_4x4_GrPixelConfig;
+            break;
+        case kBC1_CompressionType:
+            desc.fConfig = kRGBA_BC1_GrPixelConfig;
+            break;
+        case kBC3_CompressionType:
+            desc.fConfig = kRGBA_BC3_GrPixelConfig;
+            break;
+        case kBC7_CompressionType:
+            desc.fConfig = kRGBA_BC7_GrPixelConfig;
             break;
         default:
             desc.fConfig = kUnknown_GrPixelConfig;
             break;
     }
+    if (kUnknown_GrPixelConfig == desc.fConfig ||
+        data->size() < GrCompressedFormatDataSize(desc.fConfig, width, height)) {
+        return nullptr;
+    }
     desc.fSampleCnt = 1;
 
     GrProxyProvider* proxyProvider = context->contextPriv().proxyProvider();
@@ -178,7 +203,7 @@ sk_sp<SkImage> SkImage::MakeFromCompressed(GrContext* context, sk_sp<SkData> dat
         return nullptr;
     }
 
-    return sk_make_sp<SkImage_Gpu>(sk_ref_sp(context), kNeedNewImageUniqueID, kOpaque_SkAlphaType,
+    return sk_make_sp<SkImage_Gpu>(sk_ref_sp(context), kNeedNewImageUniqueID, alphaType,
                                    std::move(proxy), nullptr);
 }
 
@@ -379,6 +404,210 @@ sk_sp<SkImage> SkImage::makeTextureImage(GrContext* context, SkColorSpace* dstCo
     return nullptr;
 }
 
+namespace {
+
+/**
+ * Uploads the pixels that a worker thread read out of the source image, then tells the client.
+ * The uploader is deleted right after the upload, or with its proxy if that is never drawn.
+ */
+class AsyncTextureUploader : public GrTDeferredProxyUploader<sk_sp<const SkImage>> {
+public:
+    AsyncTextureUploader(sk_sp<const SkImage> image, SkImage::TextureReadyProc readyProc,
+                         SkImage::ReleaseContext readyContext)
+            : GrTDeferredProxyUploader<sk_sp<const SkImage>>(std::move(image))
+            , fReadyProc(readyProc)
+            , fReadyContext(readyContext) {}
+
+    ~AsyncTextureUploader() override {
+        this->wait();
+        if (fReadyProc) {
+            fReadyProc(fReadyContext);
+        }
+    }
+
+private:
+    SkImage::TextureReadyProc fReadyProc;
+    SkImage::ReleaseContext   fReadyContext;
+};
+
+/**
+ * The ETC1 data a worker thread compressed from the source image. It is shared between the worker
+ * and the lazy proxy, which waits for the worker when it is instantiated.
+ */
+class AsyncCompressedData : public SkNVRefCnt<AsyncCompressedData> {
+public:
+    ~AsyncCompressedData() { SkASSERT(!fReadyProc); }
+
+    void setReadyProc(SkImage::TextureReadyProc readyProc, SkImage::ReleaseContext readyContext) {
+        fReadyProc = readyProc;
+        fReadyContext = readyContext;
+    }
+
+    void signal(sk_sp<SkData> data) {
+        fData = std::move(data);
+        fDone.signal();
+    }
+
+    // Waits for the worker, then returns its data; null if compression failed.
+    const SkData* wait() {
+        if (!fWaited) {
+            fDone.wait();
+            fWaited = true;
+        }
+        return fData.get();
+    }
+
+    // Called on the owning thread, once, when the proxy is instantiated or deleted.
+    void notifyReady() {
+        this->wait();
+        if (fReadyProc) {
+            fReadyProc(fReadyContext);
+            fReadyProc = nullptr;
+        }
+    }
+
+private:
+    SkSemaphore               fDone;
+    sk_sp<SkData>             fData;
+    bool                      fWaited = false;
+    SkImage::TextureReadyProc fReadyProc = nullptr;
+    SkImage::ReleaseContext   fReadyContext = nullptr;
+};
+
+}  // anonymous namespace
+
+sk_sp<SkImage> SkImage::makeCompressedTextureImageAsync(GrContext* context,
+                                                        SkColorSpace* dstColorSpace,
+                                                        TextureReadyProc readyProc,
+                                                        ReleaseContext readyContext) const {
+    SkTaskGroup* taskGroup = context ? context->contextPriv().getTaskGroup() : nullptr;
+    const GrCaps* caps = context ? context->contextPriv().caps() : nullptr;
+    if (!taskGroup || this->isTextureBacked() || context->abandoned() || !this->isOpaque() ||
+        !caps->isConfigTexturable(kRGB_ETC1_GrPixelConfig)) {
+        return this->makeTextureImageAsync(context, dstColorSpace, readyProc, readyContext);
+    }
+
+    GrSurfaceDesc desc;
+    desc.fWidth = this->width();
+    desc.fHeight = this->height();
+    desc.fConfig = kRGB_ETC1_GrPixelConfig;
+    const GrBackendFormat format =
+            caps->getBackendFormatFromGrColorType(GrColorType::kRGB_ETC1, GrSRGBEncoded::kNo);
+
+    sk_sp<AsyncCompressedData> shared(new AsyncCompressedData);
+    // Unlike the uncompressed path, the whole texture is created from the ETC1 data at once, so
+    // this is a lazy proxy rather than a deferred upload into an existing one.
+    sk_sp<GrTextureProxy> proxy = context->contextPriv().proxyProvider()->createLazyProxy(
+            [desc, shared](GrResourceProvider* resourceProvider) {
+                sk_sp<GrTexture> texture;
+                const SkData* data = shared->wait();
+                if (resourceProvider && data) {
+                    GrMipLevel texels;
+                    texels.fPixels = data->data();
+                    texels.fRowBytes = 0;
+                    texture = resourceProvider->createTexture(desc, SkBudgeted::kYes, &texels, 1);
+                }
+                shared->notifyReady();
+                return texture;
+            },
+            format, desc, kTopLeft_GrSurfaceOrigin, GrMipMapped::kNo, SkBackingFit::kExact,
+            SkBudgeted::kYes);
+    if (!proxy) {
+        return this->makeTextureImageAsync(context, dstColorSpace, readyProc, readyContext);
+    }
+    shared->setReadyProc(readyProc, readyContext);
+
+    sk_sp<const SkImage> source = sk_ref_sp(this);
+    auto compress = [source, shared] {
+        TRACE_EVENT0("skia", "Threaded Image Compress");
+        // The ETC1 encoder reads 565, which is also all the precision ETC1 keeps.
+        SkImageInfo info = SkImageInfo::Make(source->width(), source->height(),
+                                             kRGB_565_SkColorType, kOpaque_SkAlphaType);
+        SkAutoPixmapStorage pixels;
+        if (!pixels.tryAlloc(info) ||
+            !source->readPixels(pixels, 0, 0, SkImage::kDisallow_CachingHint)) {
+            shared->signal(nullptr);
+            return;
+        }
+        sk_sp<SkData> data = SkData::MakeUninitialized(
+                etc1_get_encoded_data_size(info.width(), info.height()));
+        if (etc1_encode_image(static_cast<const etc1_byte*>(pixels.addr()),
+                              info.width(), info.height(), 2, pixels.rowBytes(),
+                              static_cast<etc1_byte*>(data->writable_data()))) {
+            data = nullptr;
+        }
+        shared->signal(std::move(data));
+    };
+    taskGroup->add(std::move(compress));
+
+    return sk_make_sp<SkImage_Gpu>(sk_ref_sp(context), this->uniqueID(), kOpaque_SkAlphaType,
+                                   std::move(proxy), this->refColorSpace());
+}
+
+sk_sp<SkImage> SkImage::makeTextureImageAsync(GrContext* context, SkColorSpace* dstColorSpace,
+                                              TextureReadyProc readyProc,
+                                              ReleaseContext readyContext) const {
+    auto makeNow = [&]() -> sk_sp<SkImage> {
+        sk_sp<SkImage> image = this->makeTextureImage(context, dstColorSpace);
+        if (image && readyProc) {
+            readyProc(readyContext);
+        }
+        return image;
+    };
+
+    SkTaskGroup* taskGroup = context ? context->contextPriv().getTaskGroup() : nullptr;
+    if (!taskGroup || this->isTextureBacked() || context->abandoned()) {
+        return makeNow();
+    }
+
+    // Upload in the image's own color type if we can, otherwise convert to N32 on the worker.
+    const GrCaps* caps = context->contextPriv().caps();
+    SkImageInfo info = as_IB(this)->onImageInfo();
+    GrPixelConfig config = SkImageInfo2GrPixelConfig(info);
+    if (kUnknown_GrPixelConfig == config || !caps->isConfigTexturable(config)) {
+        info = info.makeColorType(kN32_SkColorType);
+        config = SkImageInfo2GrPixelConfig(info);
+    }
+    if (kUnpremul_SkAlphaType == info.alphaType() ||
+        kUnknown_GrPixelConfig == config || !caps->isConfigTexturable(config)) {
+        return makeNow();
+    }
+
+    GrSurfaceDesc desc;
+    desc.fWidth = info.width();
+    desc.fHeight = info.height();
+    desc.fConfig = config;
+    const GrBackendFormat format = caps->getBackendFormatFromColorType(info.colorType());
+
+    // Like the threaded software masks, the proxy is filled by an ASAP upload, which is out of
+    // order with respect to ops, so it can't have any pending IO.
+    sk_sp<GrTextureProxy> proxy = context->contextPriv().proxyProvider()->createProxy(
+            format, desc, kTopLeft_GrSurfaceOrigin, SkBackingFit::kExact, SkBudgeted::kYes,
+            GrInternalSurfaceFlags::kNoPendingIO);
+    if (!proxy) {
+        return makeNow();
+    }
+
+    auto uploader = skstd::make_unique<AsyncTextureUploader>(sk_ref_sp(this), readyProc,
+                                                             readyContext);
+    AsyncTextureUploader* uploaderRaw = uploader.get();
+    auto decodeAndConvert = [uploaderRaw, info] {
+        TRACE_EVENT0("skia", "Threaded Image Decode");
+        SkAutoPixmapStorage* pixels = uploaderRaw->getPixels();
+        // An empty pixmap leaves the texture uninitialized rather than failing the flush.
+        if (pixels->tryAlloc(info) &&
+            !uploaderRaw->data()->readPixels(*pixels, 0, 0, kDisallow_CachingHint)) {
+            pixels->reset();
+        }
+        uploaderRaw->signalAndFreeData();
+    };
+    taskGroup->add(std::move(decodeAndConvert));
+    proxy->texPriv().setDeferredUploader(std::move(uploader));
+
+    return sk_make_sp<SkImage_Gpu>(sk_ref_sp(context), this->uniqueID(), info.alphaType(),
+                                   std::move(proxy), info.refColorSpace());
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 sk_sp<SkImage> SkImage_Gpu::MakePromiseTexture(GrContext* context,
@@ -394,7 +623,8 @@ sk_sp<SkImage> SkImage_Gpu::MakePromiseTexture(GrContext* context,
                                                PromiseImageTextureReleaseProc textureReleaseProc,
                                                PromiseImageTextureDoneProc textureDoneProc,
                                                PromiseImageTextureContext textureContext,
-                                               DelayReleaseCallback delayReleaseCallback) {
+                                               DelayReleaseCallback delayReleaseCallback,
+                                               SkPromiseImageBatch* batch) {
     // The contract here is that if 'promiseDoneProc' is passed in it should always be called,
     // even if creation of the SkImage fails. Once we call MakePromiseImageLazyProxy it takes
     // responsibility for calling the done proc.
@@ -425,7 +655,8 @@ sk_sp<SkImage> SkImage_Gpu::MakePromiseTexture(GrContext* context,
     callDone.clear();
     auto proxy = MakePromiseImageLazyProxy(context, width, height, origin, config, backendFormat,
                                            mipMapped, textureFulfillProc, textureReleaseProc,
-                                           textureDoneProc, textureContext, delayReleaseCallback);
+                                           textureDoneProc, textureContext, delayReleaseCallback,
+                                           batch);
     if (!proxy) {
         return nullptr;
     }
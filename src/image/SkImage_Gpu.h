@@ -40,7 +40,8 @@ public:
     sk_sp<SkImage> onMakeColorTypeAndColorSpace(SkColorType, sk_sp<SkColorSpace>) const final;
 
     /**
-     * This is the implementation of SkDeferredDisplayListRecorder::makePromiseImage.
+     * This is the implementation of SkDeferredDisplayListRecorder::makePromiseImage. If 'batch'
+     * is not null the image is fulfilled through it.
      */
     static sk_sp<SkImage> MakePromiseTexture(GrContext* context,
                                              const GrBackendFormat& backendFormat,
@@ -55,7 +56,8 @@ public:
                                              PromiseImageTextureReleaseProc textureReleaseProc,
                                              PromiseImageTextureDoneProc textureDoneProc,
                                              PromiseImageTextureContext textureContext,
-                                             DelayReleaseCallback delayReleaseCallback);
+                                             DelayReleaseCallback delayReleaseCallback,
+                                             SkPromiseImageBatch* batch = nullptr);
 
     static sk_sp<SkImage> ConvertYUVATexturesToRGB(GrContext*, SkYUVColorSpace yuvColorSpace,
                                                    const GrBackendTexture yuvaTextures[],
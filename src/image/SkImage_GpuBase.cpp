@@ -15,6 +15,7 @@
 #include "GrTextureAdjuster.h"
 #include "SkBitmapCache.h"
 #include "SkImage_Gpu.h"
+#include "SkPromiseImageBatch.h"
 #include "SkPromiseImageTexture.h"
 #include "SkReadPixelsRec.h"
 #include "SkTLList.h"
@@ -372,7 +373,8 @@ sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
         PromiseImageTextureReleaseProc releaseProc,
         PromiseImageTextureDoneProc doneProc,
         PromiseImageTextureContext textureContext,
-        DelayReleaseCallback delayReleaseCallback) {
+        DelayReleaseCallback delayReleaseCallback,
+        SkPromiseImageBatch* batch) {
     SkASSERT(context);
     SkASSERT(width > 0 && height > 0);
     SkASSERT(doneProc);
@@ -407,6 +409,9 @@ sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
      * SkPromiseImageTexture is reused in Fulfill for the same promise SkImage. However, we'd
      * like to relax that so that a SkPromiseImageTexture can be reused with different promise
      * SkImages that will reuse a single GrTexture.
+     *
+     * If the image was made by a recorder with a batch fulfill proc, the texture that the batch
+     * fulfilled when the DDL was drawn is taken in place of calling the Fulfill proc.
      */
     class PromiseLazyInstantiateCallback {
     public:
@@ -415,13 +420,18 @@ sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
                                        PromiseImageTextureDoneProc doneProc,
                                        PromiseImageTextureContext context,
                                        DelayReleaseCallback delayReleaseCallback,
-                                       GrPixelConfig config)
+                                       GrPixelConfig config,
+                                       SkPromiseImageBatch* batch)
                 : fFulfillProc(fulfillProc)
                 , fConfig(config)
                 , fDelayReleaseCallback(delayReleaseCallback) {
             auto doneHelper = sk_make_sp<GrReleaseProcHelper>(doneProc, context);
+            sk_sp<SkPromiseImageBatch::Slot> batchSlot;
+            if (batch) {
+                batchSlot = batch->addSlot(context, releaseProc, doneHelper);
+            }
             fReleaseContext = sk_make_sp<IdleContext::PromiseImageReleaseContext>(
-                    releaseProc, context, std::move(doneHelper));
+                    releaseProc, context, std::move(doneHelper), std::move(batchSlot));
         }
 
         ~PromiseLazyInstantiateCallback() = default;
@@ -452,8 +462,10 @@ sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
                 return std::move(cachedTexture);
             }
             GrBackendTexture backendTexture;
-            sk_sp<SkPromiseImageTexture> promiseTexture =
-                    fFulfillProc(fReleaseContext->textureContext());
+            sk_sp<SkPromiseImageTexture> promiseTexture;
+            if (!fReleaseContext->takeBatchTexture(&promiseTexture)) {
+                promiseTexture = fFulfillProc(fReleaseContext->textureContext());
+            }
             fReleaseContext->notifyWasFulfilled();
             if (!promiseTexture) {
                 fReleaseContext->release();
@@ -549,10 +561,12 @@ sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
             public:
                 PromiseImageReleaseContext(PromiseImageTextureReleaseProc releaseProc,
                                            PromiseImageTextureContext textureContext,
-                                           sk_sp<GrReleaseProcHelper> doneHelper)
+                                           sk_sp<GrReleaseProcHelper> doneHelper,
+                                           sk_sp<SkPromiseImageBatch::Slot> batchSlot)
                         : fReleaseProc(releaseProc)
                         , fTextureContext(textureContext)
-                        , fDoneHelper(std::move(doneHelper)) {}
+                        , fDoneHelper(std::move(doneHelper))
+                        , fBatchSlot(std::move(batchSlot)) {}
 
                 ~PromiseImageReleaseContext() { SkASSERT(fIsReleased); }
 
@@ -560,9 +574,21 @@ sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
                     SkASSERT(!fIsReleased);
                     fReleaseProc(fTextureContext);
                     fIsReleased = true;
+                    if (fBatchSlot) {
+                        fBatchSlot->notifyWasReleased();
+                    }
                 }
 
-                void notifyWasFulfilled() { fIsReleased = false; }
+                bool takeBatchTexture(sk_sp<SkPromiseImageTexture>* texture) {
+                    return fBatchSlot && fBatchSlot->takeTexture(texture);
+                }
+
+                void notifyWasFulfilled() {
+                    fIsReleased = false;
+                    if (fBatchSlot) {
+                        fBatchSlot->notifyWasFulfilled();
+                    }
+                }
                 bool isReleased() const { return fIsReleased; }
 
                 PromiseImageTextureContext textureContext() const { return fTextureContext; }
@@ -571,6 +597,7 @@ sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
                 PromiseImageTextureReleaseProc fReleaseProc;
                 PromiseImageTextureContext fTextureContext;
                 sk_sp<GrReleaseProcHelper> fDoneHelper;
+                sk_sp<SkPromiseImageBatch::Slot> fBatchSlot;
                 bool fIsReleased = true;
             };
 
@@ -600,7 +627,8 @@ sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
         // ID of the GrContext that we are interacting with.
         uint32_t fContextID = SK_InvalidUniqueID;
         GrUniqueKey fLastFulfilledKey;
-    } callback(fulfillProc, releaseProc, doneProc, textureContext, delayReleaseCallback, config);
+    } callback(fulfillProc, releaseProc, doneProc, textureContext, delayReleaseCallback, config,
+               batch);
 
     GrProxyProvider* proxyProvider = context->contextPriv().proxyProvider();
 
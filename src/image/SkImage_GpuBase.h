@@ -16,6 +16,7 @@
 #include "SkYUVAIndex.h"
 
 class SkColorSpace;
+class SkPromiseImageBatch;
 
 class SkImage_GpuBase : public SkImage_Base {
 public:
@@ -81,11 +82,12 @@ protected:
     // Helper for making a lazy proxy for a promise image. The PromiseDoneProc we be called,
     // if not null, immediately if this function fails. Othwerwise, it is installed in the
     // proxy along with the TextureFulfillProc and TextureReleaseProc. PromiseDoneProc must not
-    // be null.
+    // be null. If 'batch' is not null the image is added to it.
     static sk_sp<GrTextureProxy> MakePromiseImageLazyProxy(
             GrContext*, int width, int height, GrSurfaceOrigin, GrPixelConfig, GrBackendFormat,
             GrMipMapped, PromiseImageTextureFulfillProc, PromiseImageTextureReleaseProc,
-            PromiseImageTextureDoneProc, PromiseImageTextureContext, DelayReleaseCallback);
+            PromiseImageTextureDoneProc, PromiseImageTextureContext, DelayReleaseCallback,
+            SkPromiseImageBatch* batch);
 
     static bool RenderYUVAToRGBA(GrContext* ctx, GrRenderTargetContext* renderTargetContext,
                                  const SkRect& rect, SkYUVColorSpace yuvColorSpace,
@@ -58,7 +58,8 @@ public:
     SkColorSpace* targetColorSpace() const { return fTargetColorSpace.get(); }
 
     /**
-     * This is the implementation of SkDeferredDisplayListRecorder::makeYUVAPromiseTexture.
+     * This is the implementation of SkDeferredDisplayListRecorder::makeYUVAPromiseTexture. If
+     * 'batch' is not null each plane is fulfilled through it.
      */
     static sk_sp<SkImage> MakePromiseYUVATexture(GrContext* context,
                                                  SkYUVColorSpace yuvColorSpace,
@@ -73,7 +74,8 @@ public:
                                                  PromiseImageTextureReleaseProc textureReleaseProc,
                                                  PromiseImageTextureDoneProc textureDoneProc,
                                                  PromiseImageTextureContext textureContexts[],
-                                                 DelayReleaseCallback delayReleaseCallback);
+                                                 DelayReleaseCallback delayReleaseCallback,
+                                                 SkPromiseImageBatch* batch = nullptr);
 
 private:
     SkImage_GpuYUVA(const SkImage_GpuYUVA* image, sk_sp<SkColorSpace>);
@@ -298,6 +298,11 @@ void SkImage_Lazy::makeCacheKeyFromOrigKey(const GrUniqueKey& origKey,
     }
 }
 
+bool SkImage_Lazy::generatesTexture() const {
+    ScopedGenerator generator(fSharedGenerator);
+    return SkImageGenerator::TexGenType::kNone != generator->onCanGenerateTexture();
+}
+
 class Generator_GrYUVProvider : public GrYUVProvider {
 public:
     Generator_GrYUVProvider(SkImageGenerator* gen) : fGen(gen) {}
@@ -424,8 +429,9 @@ sk_sp<GrTextureProxy> SkImage_Lazy::lockTextureProxy(
     }
 
     // 3. Ask the generator to return YUV planes, which the GPU can convert. If we will be mipping
-    //    the texture we fall through here and have the CPU generate the mip maps for us.
-    if (!proxy && !willBeMipped && !ctx->contextPriv().disableGpuYUVConversion()) {
+    //    the texture, the converted base level is copied into a mipped proxy below and the GPU
+    //    generates the rest of the mips, rather than converting to RGBA on the CPU.
+    if (!proxy && !ctx->contextPriv().disableGpuYUVConversion()) {
         const GrSurfaceDesc desc = GrImageInfoToSurfaceDesc(fInfo);
 
         SkColorType colorType = fInfo.colorType();
@@ -449,9 +455,11 @@ sk_sp<GrTextureProxy> SkImage_Lazy::lockTextureProxy(
             SK_HISTOGRAM_ENUMERATION("LockTexturePath", kYUV_LockTexturePath,
                                      kLockTexturePathCount);
             set_key_on_proxy(proxyProvider, proxy.get(), nullptr, key);
-            *fUniqueKeyInvalidatedMessages.append() =
-                    new GrUniqueKeyInvalidatedMessage(key, ctx->contextPriv().contextID());
-            return proxy;
+            if (!willBeMipped) {
+                *fUniqueKeyInvalidatedMessages.append() =
+                        new GrUniqueKeyInvalidatedMessage(key, ctx->contextPriv().contextID());
+                return proxy;
+            }
         }
     }
 
@@ -71,6 +71,10 @@ public:
                                            GrTextureMaker::AllowedTexGenType genType) const;
 
     void makeCacheKeyFromOrigKey(const GrUniqueKey& origKey, GrUniqueKey* cacheKey) const;
+
+    // Returns true if the generator makes textures itself (e.g. by drawing a picture), rather than
+    // having its pixels uploaded.
+    bool generatesTexture() const;
 #endif
 
 private:
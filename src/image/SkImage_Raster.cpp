@@ -295,6 +295,49 @@ sk_sp<SkImage> SkImage::MakeFromRaster(const SkPixmap& pmap, RasterReleaseProc p
     return sk_make_sp<SkImage_Raster>(pmap.info(), std::move(data), pmap.rowBytes());
 }
 
+#if defined(SK_BUILD_FOR_ANDROID) && __ANDROID_API__ >= 26
+sk_sp<SkImage> SkImage::MakeRasterFromAHardwareBuffer(AHardwareBuffer* hardwareBuffer,
+                                                      SkAlphaType at, sk_sp<SkColorSpace> cs) {
+    AHardwareBuffer_Desc desc;
+    AHardwareBuffer_describe(hardwareBuffer, &desc);
+    if (!(desc.usage & AHARDWAREBUFFER_USAGE_CPU_READ_MASK) || desc.layers != 1) {
+        return nullptr;
+    }
+
+    // Unlike the GPU path, we read these bytes directly, so formats must match exactly.
+    SkColorType ct;
+    switch (desc.format) {
+        case AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM:     ct = kRGBA_8888_SkColorType;    break;
+        case AHARDWAREBUFFER_FORMAT_R8G8B8X8_UNORM:     ct = kRGB_888x_SkColorType;     break;
+        case AHARDWAREBUFFER_FORMAT_R16G16B16A16_FLOAT: ct = kRGBA_F16_SkColorType;     break;
+        case AHARDWAREBUFFER_FORMAT_R5G6B5_UNORM:       ct = kRGB_565_SkColorType;      break;
+        case AHARDWAREBUFFER_FORMAT_R10G10B10A2_UNORM:  ct = kRGBA_1010102_SkColorType; break;
+        default: return nullptr;
+    }
+    SkImageInfo info = SkImageInfo::Make(desc.width, desc.height, ct, at, std::move(cs));
+
+    void* pixels = nullptr;
+    if (0 != AHardwareBuffer_lock(hardwareBuffer, AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN, -1,
+                                  nullptr, &pixels) || !pixels) {
+        return nullptr;
+    }
+    AHardwareBuffer_acquire(hardwareBuffer);
+
+    auto release = [](const void*, ReleaseContext ctx) {
+        auto buffer = static_cast<AHardwareBuffer*>(ctx);
+        AHardwareBuffer_unlock(buffer, nullptr);
+        AHardwareBuffer_release(buffer);
+    };
+    // desc.stride is measured in pixels.
+    SkPixmap pmap(info, pixels, desc.stride * info.bytesPerPixel());
+    sk_sp<SkImage> image = SkImage::MakeFromRaster(pmap, release, hardwareBuffer);
+    if (!image) {
+        release(pixels, hardwareBuffer);
+    }
+    return image;
+}
+#endif
+
 sk_sp<SkImage> SkMakeImageFromRasterBitmapPriv(const SkBitmap& bm, SkCopyPixelsMode cpm,
                                                uint32_t idForCopy) {
     if (kAlways_SkCopyPixelsMode == cpm || (!bm.isImmutable() && kNever_SkCopyPixelsMode != cpm)) {
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkPromiseImageBatch.h"
+
+#include "SkTemplates.h"
+
+SkPromiseImageBatch::Slot::~Slot() {
+    if (fHasTexture) {
+        // Keep our contract of always calling Fulfill and Release in pairs.
+        fReleaseProc(fTextureContext);
+    }
+}
+
+bool SkPromiseImageBatch::Slot::takeTexture(sk_sp<SkPromiseImageTexture>* texture) {
+    if (!fHasTexture) {
+        return false;
+    }
+    *texture = std::move(fTexture);
+    fHasTexture = false;
+    return true;
+}
+
+sk_sp<SkPromiseImageBatch::Slot> SkPromiseImageBatch::addSlot(
+        TextureContext textureContext, ReleaseProc releaseProc,
+        sk_sp<GrReleaseProcHelper> doneHelper) {
+    fSlots.push_back(sk_make_sp<Slot>(textureContext, releaseProc, std::move(doneHelper)));
+    return fSlots.back();
+}
+
+void SkPromiseImageBatch::fulfill() {
+    SkSTArray<16, Slot*> slots;
+    SkSTArray<16, TextureContext> textureContexts;
+    for (const sk_sp<Slot>& slot : fSlots) {
+        if (!slot->fIsFulfilled) {
+            slots.push_back(slot.get());
+            textureContexts.push_back(slot->fTextureContext);
+        }
+    }
+    if (slots.empty()) {
+        return;
+    }
+
+    SkAutoTArray<sk_sp<SkPromiseImageTexture>> textures(slots.count());
+    fFulfillProc(fBatchContext, textureContexts.begin(), textures.get(), slots.count());
+    for (int i = 0; i < slots.count(); ++i) {
+        slots[i]->fTexture = std::move(textures[i]);
+        slots[i]->fHasTexture = true;
+        slots[i]->fIsFulfilled = true;
+    }
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPromiseImageBatch_DEFINED
+#define SkPromiseImageBatch_DEFINED
+
+#include "GrTypesPriv.h"
+#include "SkDeferredDisplayListRecorder.h"
+#include "SkImage.h"
+#include "SkPromiseImageTexture.h"
+#include "SkTArray.h"
+
+/**
+ * The promise images made by a SkDeferredDisplayListRecorder that was given a batch fulfill proc.
+ * It is shared by the recorder and the DDL detached from it. When the DDL is drawn, fulfill()
+ * gets the textures for all of the images that aren't already fulfilled in one call to the
+ * client's proc. The images' lazy callbacks then take those textures instead of calling the
+ * per-image fulfill proc.
+ */
+class SkPromiseImageBatch : public SkRefCnt {
+public:
+    using BatchFulfillProc = SkDeferredDisplayListRecorder::PromiseImageTextureBatchFulfillProc;
+    using BatchContext = SkDeferredDisplayListRecorder::PromiseImageTextureBatchContext;
+    using TextureContext = SkDeferredDisplayListRecorder::PromiseImageTextureContext;
+    using ReleaseProc = SkDeferredDisplayListRecorder::PromiseImageTextureReleaseProc;
+
+    /**
+     * One promise image (or YUVA plane) in the batch. It is also reffed by the image's lazy
+     * callback, which reports each fulfill and release of the image.
+     */
+    class Slot : public SkNVRefCnt<Slot> {
+    public:
+        Slot(TextureContext textureContext, ReleaseProc releaseProc,
+             sk_sp<GrReleaseProcHelper> doneHelper)
+                : fTextureContext(textureContext)
+                , fReleaseProc(releaseProc)
+                , fDoneHelper(std::move(doneHelper)) {}
+
+        // A texture the batch fulfilled that no lazy callback took is released here.
+        ~Slot();
+
+        /**
+         * Called by the lazy callback in place of the fulfill proc. Returns false if the batch
+         * hasn't fulfilled the image since it was last released. Otherwise the texture is moved
+         * into 'texture'. It may be null, which the callback treats like a null return from the
+         * fulfill proc.
+         */
+        bool takeTexture(sk_sp<SkPromiseImageTexture>* texture);
+
+        void notifyWasFulfilled() { fIsFulfilled = true; }
+        void notifyWasReleased() { fIsFulfilled = false; }
+
+    private:
+        friend class SkPromiseImageBatch;
+
+        TextureContext fTextureContext;
+        ReleaseProc fReleaseProc;
+        // The done proc is called when the last ref to this is gone, so it follows our release.
+        sk_sp<GrReleaseProcHelper> fDoneHelper;
+        sk_sp<SkPromiseImageTexture> fTexture;
+        bool fHasTexture = false;
+        bool fIsFulfilled = false;
+    };
+
+    SkPromiseImageBatch(BatchFulfillProc fulfillProc, BatchContext batchContext)
+            : fFulfillProc(fulfillProc)
+            , fBatchContext(batchContext) {}
+
+    sk_sp<Slot> addSlot(TextureContext, ReleaseProc, sk_sp<GrReleaseProcHelper> doneHelper);
+
+    // Calls the client's proc once for every slot that isn't fulfilled, if there are any.
+    void fulfill();
+
+private:
+    BatchFulfillProc fFulfillProc;
+    BatchContext fBatchContext;
+    SkTArray<sk_sp<Slot>> fSlots;
+};
+
+#endif
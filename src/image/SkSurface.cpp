@@ -6,7 +6,9 @@
  */
 
 #include "GrBackendSurface.h"
+#include "SkAutoPixmapStorage.h"
 #include "SkCanvas.h"
+#include "SkClipOpPriv.h"
 #include "SkFontLCDConfig.h"
 #include "SkImagePriv.h"
 #include "SkSurface_Base.h"
@@ -86,6 +88,108 @@ void SkSurface_Base::onDraw(SkCanvas* canvas, SkScalar x, SkScalar y, const SkPa
     }
 }
 
+void SkSurface_Base::onAsyncReadPixels(const SkImageInfo& dstInfo, int srcX, int srcY,
+                                       ReadPixelsCallback callback, ReadPixelsContext context) {
+    SkAutoPixmapStorage pixels;
+    if (pixels.tryAlloc(dstInfo) && this->readPixels(pixels, srcX, srcY)) {
+        callback(context, pixels.addr(), pixels.rowBytes());
+    } else {
+        callback(context, nullptr, 0);
+    }
+}
+
+void SkSurface_Base::onAsyncReadPixelsYUV420(SkYUVColorSpace yuvColorSpace, const SkIRect& srcRect,
+                                             ReadPixelsYUV420Callback callback,
+                                             ReadPixelsContext context) {
+    int width = srcRect.width();
+    int height = srcRect.height();
+    SkAutoPixmapStorage rgba;
+    SkImageInfo rgbaInfo = SkImageInfo::Make(width, height, kRGBA_8888_SkColorType,
+                                             kUnpremul_SkAlphaType,
+                                             this->getCanvas()->imageInfo().refColorSpace());
+    if (!rgba.tryAlloc(rgbaInfo) || !this->readPixels(rgba, srcRect.fLeft, srcRect.fTop)) {
+        callback(context, nullptr, nullptr);
+        return;
+    }
+
+    float m[12];
+    RGBToYUVMatrix(yuvColorSpace, m);
+    auto toByte = [](float v) { return SkToU8(sk_float_round2int(SkTPin(v, 0.0f, 1.0f) * 255)); };
+    auto convert = [&m, &toByte](const float rgb[3], int row) {
+        return toByte(m[4*row] * rgb[0] + m[4*row + 1] * rgb[1] + m[4*row + 2] * rgb[2] +
+                      m[4*row + 3]);
+    };
+
+    SkAutoPixmapStorage planes[3];
+    planes[0].alloc(SkImageInfo::MakeA8(width, height));
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* src = static_cast<const uint8_t*>(rgba.addr(0, y));
+        uint8_t* dst = planes[0].writable_addr8(0, y);
+        for (int x = 0; x < width; ++x, src += 4) {
+            float rgb[3] = { src[0] / 255.0f, src[1] / 255.0f, src[2] / 255.0f };
+            dst[x] = convert(rgb, 0);
+        }
+    }
+
+    // The conversion is affine, so converting the average of each 2x2 block matches averaging its
+    // converted pixels.
+    int chromaWidth = (width + 1) / 2;
+    int chromaHeight = (height + 1) / 2;
+    planes[1].alloc(SkImageInfo::MakeA8(chromaWidth, chromaHeight));
+    planes[2].alloc(SkImageInfo::MakeA8(chromaWidth, chromaHeight));
+    for (int y = 0; y < chromaHeight; ++y) {
+        for (int x = 0; x < chromaWidth; ++x) {
+            float rgb[3] = { 0, 0, 0 };
+            int count = 0;
+            for (int sy = 2 * y; sy < SkTMin(2 * y + 2, height); ++sy) {
+                for (int sx = 2 * x; sx < SkTMin(2 * x + 2, width); ++sx) {
+                    const uint8_t* src = static_cast<const uint8_t*>(rgba.addr(sx, sy));
+                    for (int c = 0; c < 3; ++c) {
+                        rgb[c] += src[c];
+                    }
+                    ++count;
+                }
+            }
+            for (int c = 0; c < 3; ++c) {
+                rgb[c] /= 255.0f * count;
+            }
+            *planes[1].writable_addr8(x, y) = convert(rgb, 1);
+            *planes[2].writable_addr8(x, y) = convert(rgb, 2);
+        }
+    }
+
+    const void* data[3] = { planes[0].addr(), planes[1].addr(), planes[2].addr() };
+    const size_t rowBytes[3] = { planes[0].rowBytes(), planes[1].rowBytes(), planes[2].rowBytes() };
+    callback(context, data, rowBytes);
+}
+
+void SkSurface_Base::RGBToYUVMatrix(SkYUVColorSpace yuvColorSpace, float m[12]) {
+    // Rows of Y, U and V. The video spaces have the 8-bit ranges [16, 235] for Y and [16, 240]
+    // for U and V.
+    static constexpr float kJPEG[] = {
+         0.299f,     0.587f,     0.114f,    0.0f,
+        -0.168736f, -0.331264f,  0.5f,      0.5f,
+         0.5f,      -0.418688f, -0.081312f, 0.5f,
+    };
+    static constexpr float kRec601[] = {
+         65.481f / 255,  128.553f / 255,  24.966f / 255,  16.0f / 255,
+        -37.797f / 255,  -74.203f / 255, 112.0f   / 255, 128.0f / 255,
+        112.0f   / 255,  -93.786f / 255, -18.214f / 255, 128.0f / 255,
+    };
+    static constexpr float kRec709[] = {
+         46.559f / 255,  156.629f / 255,  15.812f / 255,  16.0f / 255,
+        -25.664f / 255,  -86.336f / 255, 112.0f   / 255, 128.0f / 255,
+        112.0f   / 255, -101.730f / 255, -10.270f / 255, 128.0f / 255,
+    };
+    const float* src = kJPEG;
+    switch (yuvColorSpace) {
+        case kJPEG_SkYUVColorSpace:   src = kJPEG;   break;
+        case kRec601_SkYUVColorSpace: src = kRec601; break;
+        case kRec709_SkYUVColorSpace: src = kRec709; break;
+    }
+    memcpy(m, src, 12 * sizeof(float));
+}
+
 bool SkSurface_Base::outstandingImageSnapshot() const {
     return fCachedImage && !fCachedImage->unique();
 }
@@ -158,6 +262,27 @@ void SkSurface::notifyContentWillChange(ContentChangeMode mode) {
     asSB(this)->aboutToDraw(mode);
 }
 
+void SkSurface::setDamageRect(const SkIRect& damage) {
+    SkIRect bounds = SkIRect::MakeWH(fWidth, fHeight);
+    if (damage.isEmpty() || damage.contains(bounds)) {
+        bounds.setEmpty();
+    } else if (!bounds.intersect(damage)) {
+        // Nothing may be drawn, but an empty restriction would lift it. Use a rect that no draw
+        // can reach instead.
+        bounds = SkIRect::MakeXYWH(-2, -2, 1, 1);
+    }
+    // The canvas keeps the restriction across saves and restores, and passes it to the device, so
+    // the GPU device's clip bounds, and with them its ops' bounds, stay within it.
+    SkCanvas* canvas = this->getCanvas();
+    canvas->androidFramework_setDeviceClipRestriction(bounds);
+    // The restriction only ever shrinks the clip, so reset the clip to the new restriction (or the
+    // whole surface) to undo the previous damage rect.
+    SkMatrix matrix = canvas->getTotalMatrix();
+    canvas->resetMatrix();
+    canvas->clipRect(SkRect::MakeIWH(fWidth, fHeight), kReplace_SkClipOp);
+    canvas->setMatrix(matrix);
+}
+
 SkCanvas* SkSurface::getCanvas() {
     return asSB(this)->getCachedCanvas();
 }
@@ -207,6 +332,26 @@ bool SkSurface::readPixels(const SkBitmap& bitmap, int srcX, int srcY) {
     return bitmap.peekPixels(&pm) && this->readPixels(pm, srcX, srcY);
 }
 
+void SkSurface::asyncReadPixels(const SkImageInfo& dstInfo, int srcX, int srcY,
+                                ReadPixelsCallback callback, ReadPixelsContext context) {
+    SkIRect srcRect = SkIRect::MakeXYWH(srcX, srcY, dstInfo.width(), dstInfo.height());
+    if (dstInfo.isEmpty() || !SkIRect::MakeWH(this->width(), this->height()).contains(srcRect)) {
+        callback(context, nullptr, 0);
+        return;
+    }
+    asSB(this)->onAsyncReadPixels(dstInfo, srcX, srcY, callback, context);
+}
+
+void SkSurface::asyncReadPixelsYUV420(SkYUVColorSpace yuvColorSpace, const SkIRect& srcRect,
+                                      ReadPixelsYUV420Callback callback,
+                                      ReadPixelsContext context) {
+    if (srcRect.isEmpty() || !SkIRect::MakeWH(this->width(), this->height()).contains(srcRect)) {
+        callback(context, nullptr, nullptr);
+        return;
+    }
+    asSB(this)->onAsyncReadPixelsYUV420(yuvColorSpace, srcRect, callback, context);
+}
+
 void SkSurface::writePixels(const SkPixmap& pmap, int x, int y) {
     if (pmap.addr() == nullptr || pmap.width() <= 0 || pmap.height() <= 0) {
         return;
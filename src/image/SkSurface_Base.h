@@ -45,6 +45,25 @@ public:
 
     virtual void onWritePixels(const SkPixmap&, int x, int y) = 0;
 
+    /**
+     *  Default implementation reads with readPixels() and calls back before returning. srcRect
+     *  has been checked to be inside the surface.
+     */
+    virtual void onAsyncReadPixels(const SkImageInfo&, int srcX, int srcY, ReadPixelsCallback,
+                                   ReadPixelsContext);
+
+    /**
+     *  Default implementation reads srcRect as unpremul RGBA and converts it on the CPU.
+     */
+    virtual void onAsyncReadPixelsYUV420(SkYUVColorSpace, const SkIRect& srcRect,
+                                         ReadPixelsYUV420Callback, ReadPixelsContext);
+
+    /**
+     *  Fills m with the 3x4 row-major matrix taking unpremul RGB (and 1) in [0, 1] to Y, U and V
+     *  in [0, 1], for yuvColorSpace.
+     */
+    static void RGBToYUVMatrix(SkYUVColorSpace yuvColorSpace, float m[12]);
+
     /**
      *  Default implementation:
      *
@@ -13,7 +13,10 @@
 #include "GrRenderTargetContextPriv.h"
 #include "GrRenderTargetProxyPriv.h"
 #include "GrTexture.h"
+#include "SkAutoPixmapStorage.h"
 #include "SkCanvas.h"
+#include "SkColorFilter.h"
+#include "SkConvertPixels.h"
 #include "SkDeferredDisplayList.h"
 #include "SkGpuDevice.h"
 #include "SkImagePriv.h"
@@ -21,6 +24,7 @@
 #include "SkImage_Gpu.h"
 #include "SkSurfaceCharacterization.h"
 #include "SkSurface_Base.h"
+#include "effects/GrSimpleTextureEffect.h"
 
 #if SK_SUPPORT_GPU
 
@@ -128,6 +132,139 @@ void SkSurface_Gpu::onWritePixels(const SkPixmap& src, int x, int y) {
     fDevice->writePixels(src, x, y);
 }
 
+void SkSurface_Gpu::onAsyncReadPixels(const SkImageInfo& info, int srcX, int srcY,
+                                      ReadPixelsCallback callback, ReadPixelsContext context) {
+    GrRenderTargetContext* rtc = fDevice->accessRenderTargetContext();
+    fDevice->context()->contextPriv().asyncReadSurfacePixels(rtc, srcX, srcY, info, callback,
+                                                             context);
+}
+
+namespace {
+// Gathers the three planes of asyncReadPixelsYUV420, which are read separately, and hands them to
+// the client's callback once the last one arrives.
+class YUV420Read {
+public:
+    struct Plane {
+        YUV420Read* fRead;
+        int         fIndex;
+    };
+
+    YUV420Read(SkSurface::ReadPixelsYUV420Callback callback, SkSurface::ReadPixelsContext context,
+               const SkISize sizes[3])
+            : fCallback(callback), fContext(context), fPending(3), fFailed(false) {
+        for (int i = 0; i < 3; ++i) {
+            fPlanes[i] = {this, i};
+            fPixels[i].alloc(SkImageInfo::MakeA8(sizes[i].width(), sizes[i].height()));
+        }
+    }
+
+    Plane* plane(int i) { return &fPlanes[i]; }
+
+    static void PlaneCallback(void* context, const void* data, size_t rowBytes) {
+        Plane* plane = static_cast<Plane*>(context);
+        YUV420Read* read = plane->fRead;
+        SkAutoPixmapStorage& pixels = read->fPixels[plane->fIndex];
+        if (data) {
+            SkRectMemcpy(pixels.writable_addr(), pixels.rowBytes(), data, rowBytes,
+                         pixels.info().minRowBytes(), pixels.height());
+        } else {
+            read->fFailed = true;
+        }
+        if (--read->fPending == 0) {
+            if (read->fFailed) {
+                read->fCallback(read->fContext, nullptr, nullptr);
+            } else {
+                const void* planes[3];
+                size_t planeRowBytes[3];
+                for (int i = 0; i < 3; ++i) {
+                    planes[i] = read->fPixels[i].addr();
+                    planeRowBytes[i] = read->fPixels[i].rowBytes();
+                }
+                read->fCallback(read->fContext, planes, planeRowBytes);
+            }
+            delete read;
+        }
+    }
+
+private:
+    SkSurface::ReadPixelsYUV420Callback fCallback;
+    SkSurface::ReadPixelsContext        fContext;
+    Plane                               fPlanes[3];
+    SkAutoPixmapStorage                 fPixels[3];
+    int                                 fPending;
+    bool                                fFailed;
+};
+} // namespace
+
+void SkSurface_Gpu::onAsyncReadPixelsYUV420(SkYUVColorSpace yuvColorSpace, const SkIRect& srcRect,
+                                            ReadPixelsYUV420Callback callback,
+                                            ReadPixelsContext context) {
+    GrContext* ctx = fDevice->context();
+    GrRenderTargetContext* rtc = fDevice->accessRenderTargetContext();
+    sk_sp<GrTextureProxy> srcProxy = rtc->asTextureProxyRef();
+    GrBackendFormat format =
+            ctx->contextPriv().caps()->getBackendFormatFromColorType(kAlpha_8_SkColorType);
+    if (!srcProxy || !format.isValid()) {
+        this->INHERITED::onAsyncReadPixelsYUV420(yuvColorSpace, srcRect, callback, context);
+        return;
+    }
+
+    float m[12];
+    RGBToYUVMatrix(yuvColorSpace, m);
+    int chromaWidth = (srcRect.width() + 1) / 2;
+    int chromaHeight = (srcRect.height() + 1) / 2;
+    const SkISize sizes[3] = {
+        srcRect.size(), {chromaWidth, chromaHeight}, {chromaWidth, chromaHeight}
+    };
+
+    // Draw each plane into an A8 target at its own size, so only the planes are read back.
+    sk_sp<GrRenderTargetContext> planeContexts[3];
+    GrPaint paints[3];
+    for (int i = 0; i < 3; ++i) {
+        planeContexts[i] = ctx->contextPriv().makeDeferredRenderTargetContext(
+                format, SkBackingFit::kApprox, sizes[i].width(), sizes[i].height(),
+                kAlpha_8_GrPixelConfig, nullptr, 1, GrMipMapped::kNo, kTopLeft_GrSurfaceOrigin);
+        if (!planeContexts[i]) {
+            this->INHERITED::onAsyncReadPixelsYUV420(yuvColorSpace, srcRect, callback, context);
+            return;
+        }
+
+        // The plane's row goes in the alpha row, the only channel an A8 target keeps.
+        SkScalar colorMatrix[20] = {};
+        for (int j = 0; j < 3; ++j) {
+            colorMatrix[15 + j] = m[4 * i + j];
+        }
+        colorMatrix[19] = m[4 * i + 3] * 255;
+        auto matrixFP = SkColorFilter::MakeMatrixFilterRowMajor255(colorMatrix)
+                                ->asFragmentProcessor(ctx, planeContexts[i]->colorSpaceInfo());
+        if (!matrixFP) {
+            this->INHERITED::onAsyncReadPixelsYUV420(yuvColorSpace, srcRect, callback, context);
+            return;
+        }
+        // Each chroma sample lands between the four texels of its 2x2 block, so bilerp averages
+        // them.
+        auto filter = i ? GrSamplerState::Filter::kBilerp : GrSamplerState::Filter::kNearest;
+        paints[i].addColorFragmentProcessor(
+                GrSimpleTextureEffect::Make(srcProxy, SkMatrix::I(), filter));
+        paints[i].addColorFragmentProcessor(std::move(matrixFP));
+        paints[i].setPorterDuffXPFactory(SkBlendMode::kSrc);
+    }
+
+    YUV420Read* read = new YUV420Read(callback, context, sizes);
+    for (int i = 0; i < 3; ++i) {
+        SkRect srcBounds = SkRect::MakeXYWH(srcRect.fLeft, srcRect.fTop,
+                                            sizes[i].width() * (i ? 2 : 1),
+                                            sizes[i].height() * (i ? 2 : 1));
+        planeContexts[i]->fillRectToRect(GrNoClip(), std::move(paints[i]), GrAA::kNo,
+                                         SkMatrix::I(), SkRect::Make(sizes[i]), srcBounds);
+        // The last plane to arrive deletes read.
+        ctx->contextPriv().asyncReadSurfacePixels(
+                planeContexts[i].get(), 0, 0,
+                SkImageInfo::MakeA8(sizes[i].width(), sizes[i].height()),
+                YUV420Read::PlaneCallback, read->plane(i));
+    }
+}
+
 // Create a new render target and, if necessary, copy the contents of the old
 // render target into it. Note that this flushes the SkGpuDevice but
 // doesn't force an OpenGL flush.
@@ -261,8 +398,7 @@ bool SkSurface_Gpu::onDraw(const SkDeferredDisplayList* ddl) {
     GrRenderTargetContext* rtc = fDevice->accessRenderTargetContext();
     GrContext* ctx = fDevice->context();
 
-    ctx->contextPriv().copyOpListsFromDDL(ddl, rtc->asRenderTargetProxy());
-    return true;
+    return ctx->contextPriv().copyOpListsFromDDL(ddl, rtc->asRenderTargetProxy());
 }
 
 
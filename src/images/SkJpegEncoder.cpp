@@ -15,9 +15,11 @@
 #include "SkJpegEncoder.h"
 #include "SkJPEGWriteUtility.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 
 #include <stdio.h>
+#include <vector>
 
 extern "C" {
     #include "jpeglib.h"
@@ -43,6 +45,9 @@ public:
 
     transform_scanline_proc proc() const { return fProc; }
 
+    // Writes numRows rows of src, starting at top, converting them through storage if needed.
+    void writeRows(const SkPixmap& src, int top, int numRows, JSAMPLE* storage);
+
     ~SkJpegEncoderMgr() {
         jpeg_destroy_compress(&fCInfo);
     }
@@ -163,6 +168,39 @@ bool SkJpegEncoderMgr::setParams(const SkImageInfo& srcInfo, const SkJpegEncoder
     return true;
 }
 
+void SkJpegEncoderMgr::writeRows(const SkPixmap& src, int top, int numRows, JSAMPLE* storage) {
+    const void* srcRow = src.addr(0, top);
+    for (int i = 0; i < numRows; i++) {
+        JSAMPLE* jpegSrcRow = (JSAMPLE*) srcRow;
+        if (fProc) {
+            fProc((char*)storage, (const char*)srcRow, src.width(), fCInfo.input_components);
+            jpegSrcRow = storage;
+        }
+
+        jpeg_write_scanlines(&fCInfo, &jpegSrcRow, 1);
+        srcRow = SkTAddOffset<const void>(srcRow, src.rowBytes());
+    }
+}
+
+static void write_icc_marker(jpeg_compress_struct* cinfo, const SkImageInfo& info) {
+    sk_sp<SkData> icc = icc_from_color_space(info);
+    if (!icc) {
+        return;
+    }
+
+    // Create a contiguous block of memory with the icc signature followed by the profile.
+    sk_sp<SkData> markerData =
+            SkData::MakeUninitialized(kICCMarkerHeaderSize + icc->size());
+    uint8_t* ptr = (uint8_t*) markerData->writable_data();
+    memcpy(ptr, kICCSig, sizeof(kICCSig));
+    ptr += sizeof(kICCSig);
+    *ptr++ = 1; // This is the first marker.
+    *ptr++ = 1; // Out of one total markers.
+    memcpy(ptr, icc->data(), icc->size());
+
+    jpeg_write_marker(cinfo, kICCMarker, markerData->bytes(), markerData->size());
+}
+
 std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst, const SkPixmap& src,
                                                const Options& options) {
     if (!SkPixmapIsValid(src)) {
@@ -182,21 +220,7 @@ std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst, const SkPixmap& s
 
     jpeg_set_quality(encoderMgr->cinfo(), options.fQuality, TRUE);
     jpeg_start_compress(encoderMgr->cinfo(), TRUE);
-
-    sk_sp<SkData> icc = icc_from_color_space(src.info());
-    if (icc) {
-        // Create a contiguous block of memory with the icc signature followed by the profile.
-        sk_sp<SkData> markerData =
-                SkData::MakeUninitialized(kICCMarkerHeaderSize + icc->size());
-        uint8_t* ptr = (uint8_t*) markerData->writable_data();
-        memcpy(ptr, kICCSig, sizeof(kICCSig));
-        ptr += sizeof(kICCSig);
-        *ptr++ = 1; // This is the first marker.
-        *ptr++ = 1; // Out of one total markers.
-        memcpy(ptr, icc->data(), icc->size());
-
-        jpeg_write_marker(encoderMgr->cinfo(), kICCMarker, markerData->bytes(), markerData->size());
-    }
+    write_icc_marker(encoderMgr->cinfo(), src.info());
 
     return std::unique_ptr<SkJpegEncoder>(new SkJpegEncoder(std::move(encoderMgr), src));
 }
@@ -214,20 +238,7 @@ bool SkJpegEncoder::onEncodeRows(int numRows) {
         return false;
     }
 
-    const void* srcRow = fSrc.addr(0, fCurrRow);
-    for (int i = 0; i < numRows; i++) {
-        JSAMPLE* jpegSrcRow = (JSAMPLE*) srcRow;
-        if (fEncoderMgr->proc()) {
-            fEncoderMgr->proc()((char*)fStorage.get(),
-                                (const char*)srcRow,
-                                fSrc.width(),
-                                fEncoderMgr->cinfo()->input_components);
-            jpegSrcRow = fStorage.get();
-        }
-
-        jpeg_write_scanlines(fEncoderMgr->cinfo(), &jpegSrcRow, 1);
-        srcRow = SkTAddOffset<const void>(srcRow, fSrc.rowBytes());
-    }
+    fEncoderMgr->writeRows(fSrc, fCurrRow, numRows, fStorage.get());
 
     fCurrRow += numRows;
     if (fCurrRow == fSrc.height()) {
@@ -237,9 +248,223 @@ bool SkJpegEncoder::onEncodeRows(int numRows) {
     return true;
 }
 
+static constexpr uint8_t kJpegRST0 = 0xD0,
+                         kJpegEOI  = 0xD9,
+                         kJpegSOS  = 0xDA;
+
+// Encodes rows [top, top + height) of src as a standalone jpeg, with a restart interval per row
+// of MCUs and libjpeg-turbo's standard Huffman tables, so that it can be stitched to the others.
+static sk_sp<SkData> encode_jpeg_stripe(const SkPixmap& src, int top, int height,
+                                        const SkJpegEncoder::Options& options) {
+    SkPixmap stripe;
+    if (!src.extractSubset(&stripe, SkIRect::MakeXYWH(0, top, src.width(), height))) {
+        return nullptr;
+    }
+
+    SkDynamicMemoryWStream stream;
+    std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(&stream);
+
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(encoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return nullptr;
+    }
+
+    if (!encoderMgr->setParams(stripe.info(), options)) {
+        return nullptr;
+    }
+    encoderMgr->cinfo()->optimize_coding = FALSE;
+    encoderMgr->cinfo()->restart_in_rows = 1;
+
+    jpeg_set_quality(encoderMgr->cinfo(), options.fQuality, TRUE);
+    jpeg_start_compress(encoderMgr->cinfo(), TRUE);
+    if (0 == top) {
+        // Only the first stripe's header is kept.
+        write_icc_marker(encoderMgr->cinfo(), src.info());
+    }
+
+    SkAutoTMalloc<JSAMPLE> storage(encoderMgr->proc()
+                                   ? encoderMgr->cinfo()->input_components * src.width() : 0);
+    encoderMgr->writeRows(stripe, 0, height, storage.get());
+    jpeg_finish_compress(encoderMgr->cinfo());
+
+    return stream.detachAsData();
+}
+
+// Returns the offset of the entropy coded data (just past the SOS segment) in a jpeg written by
+// encode_jpeg_stripe, and the offset of the frame height in its SOF segment, or 0 on failure.
+static size_t find_jpeg_scan(const uint8_t* data, size_t size, size_t* heightOffset) {
+    *heightOffset = 0;
+    size_t p = 2;  // skip SOI
+    while (p + 4 <= size && 0xFF == data[p]) {
+        const uint8_t marker = data[p + 1];
+        const size_t length = (data[p + 2] << 8) | data[p + 3];
+        if (marker >= 0xC0 && marker <= 0xC2) {
+            // SOFn: length, precision, then height.
+            *heightOffset = p + 5;
+        }
+        p += 2 + length;
+        if (kJpegSOS == marker) {
+            return *heightOffset && p + 2 <= size ? p : 0;
+        }
+    }
+    return 0;
+}
+
+static bool encode_jpeg_in_stripes(SkWStream* dst, const SkPixmap& src,
+                                   const SkJpegEncoder::Options& options, int stripeHeight) {
+    std::vector<sk_sp<SkData>> stripes((src.height() + stripeHeight - 1) / stripeHeight);
+    SkTaskGroup taskGroup(*options.fExecutor);
+    taskGroup.batch(SkToInt(stripes.size()), [&](int i) {
+        const int top = i * stripeHeight;
+        stripes[i] = encode_jpeg_stripe(src, top, SkTMin(stripeHeight, src.height() - top),
+                                        options);
+    });
+    taskGroup.wait();
+
+    for (const auto& stripe : stripes) {
+        if (!stripe || stripe->size() < 4 ||
+                0xFF != stripe->bytes()[stripe->size() - 2] ||
+                kJpegEOI != stripe->bytes()[stripe->size() - 1]) {
+            return false;
+        }
+    }
+
+    // The first stripe's header describes the whole image, once its height is patched.
+    size_t heightOffset;
+    const size_t headerSize = find_jpeg_scan(stripes[0]->bytes(), stripes[0]->size(),
+                                             &heightOffset);
+    if (!headerSize) {
+        return false;
+    }
+    SkAutoTMalloc<uint8_t> header(headerSize);
+    memcpy(header.get(), stripes[0]->bytes(), headerSize);
+    header[heightOffset + 0] = (uint8_t)(src.height() >> 8);
+    header[heightOffset + 1] = (uint8_t)(src.height() >> 0);
+    if (!dst->write(header.get(), headerSize)) {
+        return false;
+    }
+
+    // Each stripe numbers its restart markers from zero, so they are renumbered as the
+    // entropy coded segments are concatenated, with one more between stripes.
+    int restart = 0;
+    auto writeRestart = [&]() {
+        const uint8_t marker[2] = { 0xFF, (uint8_t)(kJpegRST0 + (restart++ & 7)) };
+        return dst->write(marker, sizeof(marker));
+    };
+    for (size_t i = 0; i < stripes.size(); ++i) {
+        size_t begin = headerSize;
+        if (i > 0) {
+            begin = find_jpeg_scan(stripes[i]->bytes(), stripes[i]->size(), &heightOffset);
+            if (!begin || !writeRestart()) {
+                return false;
+            }
+        }
+
+        const uint8_t* data = stripes[i]->bytes();
+        const size_t end = stripes[i]->size() - 2;
+        for (size_t p = begin; p < end; ++p) {
+            if (0xFF == data[p] && (data[p + 1] & 0xF8) == kJpegRST0) {
+                if (!dst->write(data + begin, p - begin) || !writeRestart()) {
+                    return false;
+                }
+                begin = ++p + 1;
+            }
+        }
+        if (!dst->write(data + begin, end - begin)) {
+            return false;
+        }
+    }
+
+    const uint8_t eoi[2] = { 0xFF, kJpegEOI };
+    return dst->write(eoi, sizeof(eoi));
+}
+
 bool SkJpegEncoder::Encode(SkWStream* dst, const SkPixmap& src, const Options& options) {
+    if (options.fExecutor && SkPixmapIsValid(src)) {
+        // Stripes are whole rows of MCUs, of roughly 64K pixels.
+        const int mcuHeight = kGray_8_SkColorType != src.colorType() &&
+                              Downsample::k420 == options.fDownsample ? 16 : 8;
+        const int mcuRows = SkTMax(1, (64 * 1024) / (src.width() * mcuHeight));
+        const int stripeHeight = mcuRows * mcuHeight;
+        if (stripeHeight < src.height()) {
+            return encode_jpeg_in_stripes(dst, src, options, stripeHeight);
+        }
+    }
+
     auto encoder = SkJpegEncoder::Make(dst, src, options);
     return encoder.get() && encoder->encodeRows(src.height());
 }
 
+bool SkJpegEncoder::EncodeYUV420(SkWStream* dst, const SkPixmap planes[3],
+                                 const Options& options) {
+    const int width = planes[0].width(),
+              height = planes[0].height();
+    for (int i = 0; i < 3; ++i) {
+        if (!SkPixmapIsValid(planes[i]) || kGray_8_SkColorType != planes[i].colorType()) {
+            return false;
+        }
+    }
+    for (int i = 1; i < 3; ++i) {
+        if (planes[i].width() != (width + 1) / 2 || planes[i].height() != (height + 1) / 2) {
+            return false;
+        }
+    }
+
+    std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(dst);
+
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(encoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return false;
+    }
+
+    jpeg_compress_struct* cinfo = encoderMgr->cinfo();
+    cinfo->image_width = width;
+    cinfo->image_height = height;
+    cinfo->in_color_space = JCS_YCbCr;
+    cinfo->input_components = 3;
+    // The defaults are 4:2:0 YCbCr.
+    jpeg_set_defaults(cinfo);
+    cinfo->raw_data_in = TRUE;
+#if JPEG_LIB_VERSION >= 70
+    cinfo->do_fancy_downsampling = FALSE;
+#endif
+    cinfo->optimize_coding = TRUE;
+    jpeg_set_quality(cinfo, options.fQuality, TRUE);
+    jpeg_start_compress(cinfo, TRUE);
+
+    // libjpeg reads whole iMCU rows of whole blocks, so the planes are padded out to them by
+    // repeating their edge pixels.
+    const int yWidth = (width + 15) & ~15,
+              uvWidth = yWidth / 2;
+    SkAutoTMalloc<JSAMPLE> storage(16 * yWidth + 2 * 8 * uvWidth);
+    JSAMPROW yRows[16], uRows[8], vRows[8];
+    for (int i = 0; i < 16; ++i) {
+        yRows[i] = storage.get() + i * yWidth;
+    }
+    for (int i = 0; i < 8; ++i) {
+        uRows[i] = storage.get() + 16 * yWidth + i * uvWidth;
+        vRows[i] = storage.get() + 16 * yWidth + (8 + i) * uvWidth;
+    }
+    JSAMPARRAY image[3] = { yRows, uRows, vRows };
+
+    auto copyRow = [](JSAMPLE* dstRow, const SkPixmap& plane, int y, int paddedWidth) {
+        const uint8_t* srcRow = plane.addr8(0, SkTMin(y, plane.height() - 1));
+        memcpy(dstRow, srcRow, plane.width());
+        memset(dstRow + plane.width(), srcRow[plane.width() - 1], paddedWidth - plane.width());
+    };
+    for (int y = 0; y < height; y += 16) {
+        for (int i = 0; i < 16; ++i) {
+            copyRow(yRows[i], planes[0], y + i, yWidth);
+        }
+        for (int i = 0; i < 8; ++i) {
+            copyRow(uRows[i], planes[1], y / 2 + i, uvWidth);
+            copyRow(vRows[i], planes[2], y / 2 + i, uvWidth);
+        }
+        jpeg_write_raw_data(cinfo, image, 16);
+    }
+    jpeg_finish_compress(cinfo);
+
+    return true;
+}
+
 #endif
@@ -12,13 +12,16 @@
 #include "SkColorTable.h"
 #include "SkImageEncoderFns.h"
 #include "SkImageInfoPriv.h"
+#include "SkNx.h"
 #include "SkStream.h"
 #include "SkString.h"
 #include "SkPngEncoder.h"
 #include "SkPngPriv.h"
+#include "SkTaskGroup.h"
 #include <vector>
 
 #include "png.h"
+#include "zlib.h"
 
 static_assert(PNG_FILTER_NONE  == (int)SkPngEncoder::FilterFlag::kNone,  "Skia libpng filter err.");
 static_assert(PNG_FILTER_SUB   == (int)SkPngEncoder::FilterFlag::kSub,   "Skia libpng filter err.");
@@ -44,6 +47,144 @@ static void sk_write_fn(png_structp png_ptr, png_bytep data, png_size_t len) {
     }
 }
 
+// The PNG filter types, as stored in the first byte of each filtered row.
+enum {
+    kNone_FilterType  = 0,
+    kSub_FilterType   = 1,
+    kUp_FilterType    = 2,
+    kPaeth_FilterType = 4,
+};
+
+// Each of these writes the bytes of row, filtered against the previous row (all zeros for the
+// first row) with bpp bytes per pixel, to dst.
+
+static void filter_sub(uint8_t* dst, const uint8_t* row, const uint8_t*, size_t len, size_t bpp) {
+    memcpy(dst, row, bpp);
+    size_t i = bpp;
+    for (; i + 16 <= len; i += 16) {
+        (Sk16b::Load(row + i) - Sk16b::Load(row + i - bpp)).store(dst + i);
+    }
+    for (; i < len; ++i) {
+        dst[i] = row[i] - row[i - bpp];
+    }
+}
+
+static void filter_up(uint8_t* dst, const uint8_t* row, const uint8_t* prev, size_t len, size_t) {
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        (Sk16b::Load(row + i) - Sk16b::Load(prev + i)).store(dst + i);
+    }
+    for (; i < len; ++i) {
+        dst[i] = row[i] - prev[i];
+    }
+}
+
+static inline uint8_t paeth_predictor(int a, int b, int c) {
+    const int pa = SkTAbs(b - c),
+              pb = SkTAbs(a - c),
+              pc = SkTAbs(a + b - 2 * c);
+    return (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+}
+
+static void filter_paeth(uint8_t* dst, const uint8_t* row, const uint8_t* prev,
+                         size_t len, size_t bpp) {
+    // With no left neighbors, the predictor is always the pixel above.
+    for (size_t i = 0; i < bpp; ++i) {
+        dst[i] = row[i] - prev[i];
+    }
+
+    size_t i = bpp;
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    // Unlike decoding, every predictor input is an unfiltered byte, so 8 bytes can be filtered
+    // at a time, in 16 bits.
+    const __m128i zero = _mm_setzero_si128();
+    auto load8 = [&](const uint8_t* p) {
+        return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)p), zero);
+    };
+    auto abs16 = [&](__m128i v) { return _mm_max_epi16(v, _mm_sub_epi16(zero, v)); };
+    for (; i + 8 <= len; i += 8) {
+        const __m128i x = load8(row + i),
+                      a = load8(row + i - bpp),
+                      b = load8(prev + i),
+                      c = load8(prev + i - bpp);
+        const __m128i pa = abs16(_mm_sub_epi16(b, c)),
+                      pb = abs16(_mm_sub_epi16(a, c)),
+                      pc = abs16(_mm_sub_epi16(_mm_add_epi16(a, b), _mm_add_epi16(c, c)));
+
+        // pred = (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c
+        const __m128i useC = _mm_cmpgt_epi16(pb, pc),
+                      notA = _mm_or_si128(_mm_cmpgt_epi16(pa, pb), _mm_cmpgt_epi16(pa, pc));
+        __m128i pred = _mm_or_si128(_mm_and_si128(useC, c), _mm_andnot_si128(useC, b));
+        pred = _mm_or_si128(_mm_and_si128(notA, pred), _mm_andnot_si128(notA, a));
+
+        const __m128i diff = _mm_and_si128(_mm_sub_epi16(x, pred), _mm_set1_epi16(0xff));
+        _mm_storel_epi64((__m128i*)(dst + i), _mm_packus_epi16(diff, diff));
+    }
+#endif
+    for (; i < len; ++i) {
+        dst[i] = row[i] - paeth_predictor(row[i - bpp], prev[i], prev[i - bpp]);
+    }
+}
+
+// Matches libpng's heuristic for choosing between filters: the smallest sum of the filtered
+// bytes, as signed values.
+static size_t filtered_row_cost(const uint8_t* row, size_t len) {
+    size_t cost = 0;
+    for (size_t i = 0; i < len; ++i) {
+        cost += SkTAbs((int)(int8_t)row[i]);
+    }
+    return cost;
+}
+
+// Writes the filter type byte and the filtered bytes of a len-byte row to dst, choosing among
+// the filter types set in filterTypes (bits shifted by type) when there is more than one.
+static void filter_row(uint8_t* dst, const uint8_t* row, const uint8_t* prev, size_t len,
+                       size_t bpp, unsigned filterTypes, uint8_t* scratch) {
+    static constexpr struct {
+        int fType;
+        void (*fProc)(uint8_t*, const uint8_t*, const uint8_t*, size_t, size_t);
+    } kFilters[] = {
+        { kSub_FilterType,   filter_sub   },
+        { kUp_FilterType,    filter_up    },
+        { kPaeth_FilterType, filter_paeth },
+    };
+
+    int bestType = kNone_FilterType;
+    memcpy(dst + 1, row, len);
+    size_t bestCost = (filterTypes & (1 << kNone_FilterType)) ? filtered_row_cost(row, len)
+                                                              : SIZE_MAX;
+    for (const auto& filter : kFilters) {
+        if (!(filterTypes & (1 << filter.fType))) {
+            continue;
+        }
+        if (bestCost == SIZE_MAX && !(filterTypes & ~((1u << (filter.fType + 1)) - 1))) {
+            // The only remaining choice, no need to compare.
+            filter.fProc(dst + 1, row, prev, len, bpp);
+            bestType = filter.fType;
+            break;
+        }
+        filter.fProc(scratch, row, prev, len, bpp);
+        const size_t cost = filtered_row_cost(scratch, len);
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestType = filter.fType;
+            memcpy(dst + 1, scratch, len);
+        }
+    }
+    dst[0] = bestType;
+}
+
+// One band of rows, deflated on its own (pigz-style) so that bands can be compressed
+// concurrently and concatenated into a single zlib stream.
+struct SkPngDeflatedBand {
+    int                  fTop;
+    int                  fBottom;
+    std::vector<uint8_t> fData;
+    uLong                fAdler;
+    size_t               fInputSize;
+    bool                 fSuccess;
+};
+
 class SkPngEncoderMgr final : SkNoncopyable {
 public:
 
@@ -57,6 +198,11 @@ public:
     bool setColorSpace(const SkImageInfo& info);
     bool writeInfo(const SkImageInfo& srcInfo);
     void chooseProc(const SkImageInfo& srcInfo);
+    void setExecutor(const SkImageInfo& srcInfo, const SkPngEncoder::Options& options);
+
+    // Filters and deflates rows [top, bottom) on fExecutor, writing them as IDAT chunks.
+    bool writeBands(const SkPixmap& src, int top, int bottom);
+    SkExecutor* executor() const { return fExecutor; }
 
     png_structp pngPtr() { return fPngPtr; }
     png_infop infoPtr() { return fInfoPtr; }
@@ -74,10 +220,18 @@ private:
         , fInfoPtr(infoPtr)
     {}
 
+    void deflateBand(const SkPixmap& src, SkPngDeflatedBand* band) const;
+
     png_structp             fPngPtr;
     png_infop               fInfoPtr;
     int                     fPngBytesPerPixel;
     transform_scanline_proc fProc;
+
+    // Only used when encoding the IDAT stream ourselves.
+    SkExecutor*             fExecutor = nullptr;
+    unsigned                fFilterTypes = 0;
+    int                     fZLibLevel = 6;
+    uLong                   fAdler = 0;
 };
 
 std::unique_ptr<SkPngEncoderMgr> SkPngEncoderMgr::Make(SkWStream* stream) {
@@ -367,6 +521,143 @@ void SkPngEncoderMgr::chooseProc(const SkImageInfo& srcInfo) {
     fProc = choose_proc(srcInfo);
 }
 
+void SkPngEncoderMgr::setExecutor(const SkImageInfo& srcInfo,
+                                  const SkPngEncoder::Options& options) {
+    const int flags = (int)options.fFilterFlags;
+    fFilterTypes = ((flags & (int)SkPngEncoder::FilterFlag::kNone)  ? 1 << kNone_FilterType : 0)
+                 | ((flags & (int)SkPngEncoder::FilterFlag::kSub)   ? 1 << kSub_FilterType  : 0)
+                 | ((flags & (int)SkPngEncoder::FilterFlag::kUp)    ? 1 << kUp_FilterType   : 0)
+                 | ((flags & (int)SkPngEncoder::FilterFlag::kPaeth) ? 1 << kPaeth_FilterType : 0);
+    fZLibLevel = SkTMin(SkTMax(0, options.fZLibLevel), 9);
+    fAdler = adler32(0L, Z_NULL, 0);
+
+    // Rows libpng would transform further (e.g. strip a filler channel) stay on libpng.
+    const bool rowsMatch = png_get_rowbytes(fPngPtr, fInfoPtr) ==
+                           SkToSizeT(fPngBytesPerPixel * srcInfo.width());
+    fExecutor = (fFilterTypes && rowsMatch) ? options.fExecutor : nullptr;
+}
+
+void SkPngEncoderMgr::deflateBand(const SkPixmap& src, SkPngDeflatedBand* band) const {
+    static constexpr size_t kWindowSize = 32768;
+
+    band->fSuccess = false;
+
+    const size_t rowBytes = fPngBytesPerPixel * src.width();
+    const size_t filteredRowBytes = rowBytes + 1;
+
+    // Filter enough rows before the band to prime the deflate window with them, so that
+    // splitting into bands costs little compression.
+    const int dictRows = SkToInt((kWindowSize + filteredRowBytes - 1) / filteredRowBytes);
+    const int firstRow = SkTMax(0, band->fTop - dictRows);
+
+    std::vector<uint8_t> filtered((band->fBottom - firstRow) * filteredRowBytes);
+    std::vector<uint8_t> rows(3 * rowBytes, 0);
+    uint8_t* prevRow = rows.data();
+    uint8_t* currRow = prevRow + rowBytes;
+    uint8_t* scratch = currRow + rowBytes;
+    const int srcBpp = SkColorTypeBytesPerPixel(src.colorType());
+    if (firstRow > 0) {
+        fProc((char*)prevRow, (const char*)src.addr(0, firstRow - 1), src.width(), srcBpp);
+    }
+    for (int y = firstRow; y < band->fBottom; ++y) {
+        fProc((char*)currRow, (const char*)src.addr(0, y), src.width(), srcBpp);
+        filter_row(filtered.data() + (y - firstRow) * filteredRowBytes, currRow, prevRow,
+                   rowBytes, fPngBytesPerPixel, fFilterTypes, scratch);
+        std::swap(prevRow, currRow);
+    }
+
+    const size_t dictSize = SkTMin((band->fTop - firstRow) * filteredRowBytes, kWindowSize);
+    const uint8_t* input = filtered.data() + (band->fTop - firstRow) * filteredRowBytes;
+    band->fInputSize = (band->fBottom - band->fTop) * filteredRowBytes;
+    band->fAdler = adler32(adler32(0L, Z_NULL, 0), input, band->fInputSize);
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    // Raw deflate: the zlib header and checksum are written once, around all the bands.
+    const int strategy = fFilterTypes == (1 << kNone_FilterType) ? Z_DEFAULT_STRATEGY
+                                                                  : Z_FILTERED;
+    if (Z_OK != deflateInit2(&stream, fZLibLevel, Z_DEFLATED, -15, 8, strategy)) {
+        return;
+    }
+    if (dictSize && Z_OK != deflateSetDictionary(&stream, input - dictSize, dictSize)) {
+        deflateEnd(&stream);
+        return;
+    }
+
+    // Only the last band ends the deflate stream.  The others end with a sync flush, which
+    // byte-aligns them so that the next band can simply follow.
+    const int flush = band->fBottom == src.height() ? Z_FINISH : Z_SYNC_FLUSH;
+    band->fData.resize(deflateBound(&stream, band->fInputSize) + 16);
+    stream.next_in = const_cast<Bytef*>(input);
+    stream.avail_in = SkToUInt(band->fInputSize);
+    stream.next_out = band->fData.data();
+    stream.avail_out = SkToUInt(band->fData.size());
+    for (;;) {
+        const int result = deflate(&stream, flush);
+        if (result == Z_STREAM_END || (result == Z_OK && flush == Z_SYNC_FLUSH &&
+                                       stream.avail_in == 0 && stream.avail_out > 0)) {
+            break;
+        }
+        if (result != Z_OK && result != Z_BUF_ERROR) {
+            deflateEnd(&stream);
+            return;
+        }
+        // Out of room.
+        const size_t used = band->fData.size() - stream.avail_out;
+        band->fData.resize(2 * band->fData.size());
+        stream.next_out = band->fData.data() + used;
+        stream.avail_out = SkToUInt(band->fData.size() - used);
+    }
+    band->fData.resize(stream.total_out);
+    // deflateEnd() reports Z_DATA_ERROR for the unfinished (sync flushed) streams.
+    deflateEnd(&stream);
+    band->fSuccess = true;
+}
+
+bool SkPngEncoderMgr::writeBands(const SkPixmap& src, int top, int bottom) {
+    SkASSERT(fExecutor);
+    static constexpr size_t kBandSize = 256 * 1024;
+
+    const size_t filteredRowBytes = fPngBytesPerPixel * src.width() + 1;
+    const int bandRows = SkTMax(1, SkToInt(kBandSize / filteredRowBytes));
+
+    std::vector<SkPngDeflatedBand> bands((bottom - top + bandRows - 1) / bandRows);
+    for (size_t i = 0; i < bands.size(); ++i) {
+        bands[i].fTop = top + SkToInt(i) * bandRows;
+        bands[i].fBottom = SkTMin(bottom, bands[i].fTop + bandRows);
+    }
+
+    SkTaskGroup taskGroup(*fExecutor);
+    taskGroup.batch(SkToInt(bands.size()), [&](int i) { this->deflateBand(src, &bands[i]); });
+    taskGroup.wait();
+
+    static const png_byte kIDAT[5] = { 'I', 'D', 'A', 'T', '\0' };
+    if (top == 0) {
+        // CM = deflate with a 32K window, no preset dictionary, and the FCHECK bits.
+        static const png_byte kZLibHeader[2] = { 0x78, 0x01 };
+        png_write_chunk(fPngPtr, kIDAT, kZLibHeader, sizeof(kZLibHeader));
+    }
+    for (const auto& band : bands) {
+        if (!band.fSuccess) {
+            return false;
+        }
+        png_write_chunk(fPngPtr, kIDAT, band.fData.data(), band.fData.size());
+        fAdler = adler32_combine(fAdler, band.fAdler, band.fInputSize);
+    }
+    if (bottom == src.height()) {
+        const png_byte adler[4] = {
+            (png_byte)(fAdler >> 24), (png_byte)(fAdler >> 16),
+            (png_byte)(fAdler >>  8), (png_byte)(fAdler >>  0),
+        };
+        png_write_chunk(fPngPtr, kIDAT, adler, sizeof(adler));
+
+        static const png_byte kIEND[5] = { 'I', 'E', 'N', 'D', '\0' };
+        png_write_chunk(fPngPtr, kIEND, nullptr, 0);
+    }
+
+    return true;
+}
+
 std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& src,
                                               const Options& options) {
     if (!SkPixmapIsValid(src)) {
@@ -391,6 +682,7 @@ std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& sr
     }
 
     encoderMgr->chooseProc(src.info());
+    encoderMgr->setExecutor(src.info(), options);
 
     return std::unique_ptr<SkPngEncoder>(new SkPngEncoder(std::move(encoderMgr), src));
 }
@@ -407,6 +699,14 @@ bool SkPngEncoder::onEncodeRows(int numRows) {
         return false;
     }
 
+    if (fEncoderMgr->executor()) {
+        if (!fEncoderMgr->writeBands(fSrc, fCurrRow, fCurrRow + numRows)) {
+            return false;
+        }
+        fCurrRow += numRows;
+        return true;
+    }
+
     const void* srcRow = fSrc.addr(0, fCurrRow);
     for (int y = 0; y < numRows; y++) {
         fEncoderMgr->proc()((char*)fStorage.get(),
@@ -152,6 +152,8 @@ bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Opti
         pic.use_argb = 1;
     }
 
+    webp_config.thread_level = opts.fUseThreads ? 1 : 0;
+
     // If there is no need to embed an ICC profile, we write directly to the input stream.
     // Otherwise, we will first encode to |tmp| and use a mux to add the ICC chunk.  libwebp
     // forces us to have an encoded image before we can add a profile.
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMaskBlurFilter_opts_DEFINED
+#define SkMaskBlurFilter_opts_DEFINED
+
+#include "SkNx.h"
+#include <cstring>
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    #include <immintrin.h>
+#endif
+
+namespace SK_OPTS_NS {
+
+// The three box blur passes of SkMaskBlurFilter, run over eight rows at a time. Each row gets a
+// 32-bit lane, so the running sums and the ring buffers behind them are eight lanes wide, and
+// every lane computes exactly what the scalar PlanGauss::Scan would for its row.
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    using BlurLanes = __m256i;
+
+    static inline BlurLanes blur_lanes_zero() { return _mm256_setzero_si256(); }
+    static inline BlurLanes blur_lanes_load(const uint32_t* p) {
+        return _mm256_loadu_si256((const __m256i*)p);
+    }
+    static inline void blur_lanes_store(uint32_t* p, BlurLanes v) {
+        _mm256_storeu_si256((__m256i*)p, v);
+    }
+    static inline BlurLanes blur_lanes_add(BlurLanes a, BlurLanes b) {
+        return _mm256_add_epi32(a, b);
+    }
+    static inline BlurLanes blur_lanes_sub(BlurLanes a, BlurLanes b) {
+        return _mm256_sub_epi32(a, b);
+    }
+    static inline BlurLanes blur_lanes_gather(const uint8_t* p, size_t rowBytes) {
+        return _mm256_setr_epi32(p[0 * rowBytes], p[1 * rowBytes], p[2 * rowBytes],
+                                 p[3 * rowBytes], p[4 * rowBytes], p[5 * rowBytes],
+                                 p[6 * rowBytes], p[7 * rowBytes]);
+    }
+    // Stores (weight * sum + 2^31) >> 32 for each lane as eight consecutive bytes.
+    static inline void blur_lanes_scale_and_store(uint8_t* dst, BlurLanes sum, uint32_t weight) {
+        const __m256i w    = _mm256_set1_epi64x(weight),
+                      half = _mm256_set1_epi64x(1ull << 31);
+        // The 64-bit products of the even lanes, and then of the odd lanes.
+        __m256i even = _mm256_add_epi64(_mm256_mul_epu32(sum, w), half),
+                odd  = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(sum, 32), w), half);
+        __m256i scaled = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+
+        // Every lane is now at most 255; gather their low bytes into the bottom of each half.
+        const __m256i lowBytes = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1,
+                                                  -1, -1, -1, -1, -1, -1, -1, -1,
+                                                  0, 4, 8, 12, -1, -1, -1, -1,
+                                                  -1, -1, -1, -1, -1, -1, -1, -1);
+        scaled = _mm256_shuffle_epi8(scaled, lowBytes);
+        uint32_t bytes[2] = {
+            (uint32_t)_mm_cvtsi128_si32(_mm256_castsi256_si128(scaled)),
+            (uint32_t)_mm_cvtsi128_si32(_mm256_extracti128_si256(scaled, 1)),
+        };
+        memcpy(dst, bytes, sizeof(bytes));
+    }
+#else
+    namespace {  // Sk4u is in an anonymous namespace too.
+        struct BlurLanes { Sk4u lo, hi; };
+    }
+
+    static inline BlurLanes blur_lanes_zero() { return {Sk4u(0), Sk4u(0)}; }
+    static inline BlurLanes blur_lanes_load(const uint32_t* p) {
+        return {Sk4u::Load(p), Sk4u::Load(p + 4)};
+    }
+    static inline void blur_lanes_store(uint32_t* p, const BlurLanes& v) {
+        v.lo.store(p);
+        v.hi.store(p + 4);
+    }
+    static inline BlurLanes blur_lanes_add(const BlurLanes& a, const BlurLanes& b) {
+        return {a.lo + b.lo, a.hi + b.hi};
+    }
+    static inline BlurLanes blur_lanes_sub(const BlurLanes& a, const BlurLanes& b) {
+        return {a.lo - b.lo, a.hi - b.hi};
+    }
+    static inline BlurLanes blur_lanes_gather(const uint8_t* p, size_t rowBytes) {
+        return {Sk4u(p[0 * rowBytes], p[1 * rowBytes], p[2 * rowBytes], p[3 * rowBytes]),
+                Sk4u(p[4 * rowBytes], p[5 * rowBytes], p[6 * rowBytes], p[7 * rowBytes])};
+    }
+    static inline Sk4u blur_lanes_scale(const Sk4u& sum, uint32_t weight) {
+        // (weight * sum + 2^31) >> 32 is the high half of the product, plus one if the low half
+        // is at least 2^31.
+        Sk4u w(weight);
+        return sum.mulHi(w) + ((sum * w) >> 31);
+    }
+    static inline void blur_lanes_scale_and_store(uint8_t* dst, const BlurLanes& sum,
+                                                  uint32_t weight) {
+        SkNx_cast<uint8_t>(blur_lanes_scale(sum.lo, weight)).store(dst);
+        SkNx_cast<uint8_t>(blur_lanes_scale(sum.hi, weight)).store(dst + 4);
+    }
+#endif
+
+    // Blurs eight rows, each srcWidth values long and srcRowBytes apart, with a box of width
+    // window. Output value x of row r goes to dst[x * dstStride + r], so rows come out transposed
+    // into eight consecutive bytes. buffer must hold 8 * (3 * window - 2) values.
+    static void box_blur_8_rows(const uint8_t* src, size_t srcRowBytes, int srcWidth,
+                                uint8_t* dst, size_t dstStride, int dstWidth,
+                                int window, uint32_t weight, uint32_t* buffer) {
+        const int pass0Size = window - 1,
+                  pass1Size = window - 1,
+                  pass2Size = (window & 1) == 1 ? window - 1 : window;
+        SkASSERT(pass0Size > 0);
+
+        uint32_t* buffer0 = buffer;
+        uint32_t* buffer1 = buffer0 + 8 * pass0Size;
+        uint32_t* buffer2 = buffer1 + 8 * pass1Size;
+        const size_t bufferBytes = 8 * (pass0Size + pass1Size + pass2Size) * sizeof(uint32_t);
+
+        // dstWidth is srcWidth plus the sliding window, less one.
+        const int slidingWindow = dstWidth - srcWidth + 1;
+        const int noChangeCount = slidingWindow > srcWidth ? slidingWindow - srcWidth : 0;
+
+        BlurLanes sum0, sum1, sum2;
+        int cursor0, cursor1, cursor2;
+        auto reset = [&] {
+            memset(buffer, 0, bufferBytes);
+            sum0 = sum1 = sum2 = blur_lanes_zero();
+            cursor0 = cursor1 = cursor2 = 0;
+        };
+        // Adds leadingEdge to the running sums, and returns the total before it slides on.
+        auto step = [&](const BlurLanes& leadingEdge) {
+            sum0 = blur_lanes_add(sum0, leadingEdge);
+            sum1 = blur_lanes_add(sum1, sum0);
+            sum2 = blur_lanes_add(sum2, sum1);
+            BlurLanes total = sum2;
+
+            sum2 = blur_lanes_sub(sum2, blur_lanes_load(buffer2 + 8 * cursor2));
+            blur_lanes_store(buffer2 + 8 * cursor2, sum1);
+            cursor2 = cursor2 + 1 < pass2Size ? cursor2 + 1 : 0;
+
+            sum1 = blur_lanes_sub(sum1, blur_lanes_load(buffer1 + 8 * cursor1));
+            blur_lanes_store(buffer1 + 8 * cursor1, sum0);
+            cursor1 = cursor1 + 1 < pass1Size ? cursor1 + 1 : 0;
+
+            sum0 = blur_lanes_sub(sum0, blur_lanes_load(buffer0 + 8 * cursor0));
+            blur_lanes_store(buffer0 + 8 * cursor0, leadingEdge);
+            cursor0 = cursor0 + 1 < pass0Size ? cursor0 + 1 : 0;
+
+            return total;
+        };
+
+        // Consume the source generating pixels.
+        reset();
+        uint8_t* dstCursor = dst;
+        for (int x = 0; x < srcWidth; x++, dstCursor += dstStride) {
+            blur_lanes_scale_and_store(dstCursor, step(blur_lanes_gather(src + x, srcRowBytes)),
+                                       weight);
+        }
+
+        // The leading edge is off the right side of the mask.
+        for (int i = 0; i < noChangeCount; i++, dstCursor += dstStride) {
+            blur_lanes_scale_and_store(dstCursor, step(blur_lanes_zero()), weight);
+        }
+
+        // Starting from the right, fill in the rest of the rows.
+        reset();
+        uint8_t* dstEnd = dst + dstWidth * dstStride;
+        for (int x = srcWidth; dstEnd > dstCursor;) {
+            dstEnd -= dstStride;
+            blur_lanes_scale_and_store(dstEnd, step(blur_lanes_gather(src + --x, srcRowBytes)),
+                                       weight);
+        }
+    }
+
+}  // namespace SK_OPTS_NS
+
+#endif//SkMaskBlurFilter_opts_DEFINED
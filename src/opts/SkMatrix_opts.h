@@ -0,0 +1,189 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMatrix_opts_DEFINED
+#define SkMatrix_opts_DEFINED
+
+#include "SkNx.h"
+#include "SkPoint.h"
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    #include <immintrin.h>
+#endif
+
+namespace SK_OPTS_NS {
+
+// m is the nine SkMatrix entries, in SkMatrix::get9() order:
+//     scaleX, skewX, transX, skewY, scaleY, transY, persp0, persp1, persp2.
+//
+// Every path below multiplies and adds in the same order as SkMatrix's portable point procs.
+// The hsw and skx tiers are built with -ffp-contract=fast, so their results may differ from the
+// portable ones by an FMA's rounding.
+
+static void matrix_map_affine(const float m[9], SkPoint dst[], const SkPoint src[], int count) {
+    const float sx = m[0], kx = m[1], tx = m[2],
+                ky = m[3], sy = m[4], ty = m[5];
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    // Eight points per register, sixteen per iteration.
+    const __m512 scale = _mm512_setr_ps(sx,sy,sx,sy,sx,sy,sx,sy,sx,sy,sx,sy,sx,sy,sx,sy),
+                 skew  = _mm512_setr_ps(kx,ky,kx,ky,kx,ky,kx,ky,kx,ky,kx,ky,kx,ky,kx,ky),
+                 trans = _mm512_setr_ps(tx,ty,tx,ty,tx,ty,tx,ty,tx,ty,tx,ty,tx,ty,tx,ty);
+    for (; count >= 16; count -= 16) {
+        __m512 lo = _mm512_loadu_ps(src + 0),
+               hi = _mm512_loadu_ps(src + 8);
+        lo = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(lo, scale),
+                                         _mm512_mul_ps(_mm512_permute_ps(lo, 0xB1), skew)), trans);
+        hi = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(hi, scale),
+                                         _mm512_mul_ps(_mm512_permute_ps(hi, 0xB1), skew)), trans);
+        _mm512_storeu_ps(dst + 0, lo);
+        _mm512_storeu_ps(dst + 8, hi);
+        src += 16;
+        dst += 16;
+    }
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    // Four points per register, eight per iteration.
+    const __m256 scale = _mm256_setr_ps(sx,sy,sx,sy,sx,sy,sx,sy),
+                 skew  = _mm256_setr_ps(kx,ky,kx,ky,kx,ky,kx,ky),
+                 trans = _mm256_setr_ps(tx,ty,tx,ty,tx,ty,tx,ty);
+    for (; count >= 8; count -= 8) {
+        __m256 lo = _mm256_loadu_ps(&src[0].fX),
+               hi = _mm256_loadu_ps(&src[4].fX);
+        lo = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(lo, scale),
+                                         _mm256_mul_ps(_mm256_permute_ps(lo, 0xB1), skew)), trans);
+        hi = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(hi, scale),
+                                         _mm256_mul_ps(_mm256_permute_ps(hi, 0xB1), skew)), trans);
+        _mm256_storeu_ps(&dst[0].fX, lo);
+        _mm256_storeu_ps(&dst[4].fX, hi);
+        src += 8;
+        dst += 8;
+    }
+#endif
+
+    const Sk4f scale4(sx, sy, sx, sy),
+               skew4 (kx, ky, kx, ky),    // applied to swizzle of src4
+               trans4(tx, ty, tx, ty);
+    for (; count >= 2; count -= 2) {
+        Sk4f src4 = Sk4f::Load(src),
+             swz4 = SkNx_shuffle<1,0,3,2>(src4);  // y0 x0, y1 x1
+        (src4 * scale4 + swz4 * skew4 + trans4).store(dst);
+        src += 2;
+        dst += 2;
+    }
+    if (count > 0) {
+        Sk2f src2 = Sk2f::Load(src),
+             swz2 = SkNx_shuffle<1,0>(src2);
+        (src2 * Sk2f(sx, sy) + swz2 * Sk2f(kx, ky) + Sk2f(tx, ty)).store(dst);
+    }
+}
+
+static void matrix_map_persp(const float m[9], SkPoint dst[], const SkPoint src[], int count) {
+    const float sx = m[0], kx = m[1], tx = m[2],
+                ky = m[3], sy = m[4], ty = m[5],
+                p0 = m[6], p1 = m[7], p2 = m[8];
+
+    // Each x is copied into both lanes of its point, and so is each y, so that one multiply
+    // produces both Ax and Dx.  A z of zero leaves its point mapped to (0,0), as in Persp_pts.
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    const __m512 colX  = _mm512_setr_ps(sx,ky,sx,ky,sx,ky,sx,ky,sx,ky,sx,ky,sx,ky,sx,ky),
+                 colY  = _mm512_setr_ps(kx,sy,kx,sy,kx,sy,kx,sy,kx,sy,kx,sy,kx,sy,kx,sy),
+                 trans = _mm512_setr_ps(tx,ty,tx,ty,tx,ty,tx,ty,tx,ty,tx,ty,tx,ty,tx,ty),
+                 P0 = _mm512_set1_ps(p0),
+                 P1 = _mm512_set1_ps(p1),
+                 P2 = _mm512_set1_ps(p2),
+                 one  = _mm512_set1_ps(1),
+                 zero = _mm512_setzero_ps();
+    auto map8 = [&](__m512 v) {
+        __m512 X = _mm512_moveldup_ps(v),
+               Y = _mm512_movehdup_ps(v);
+        __m512 xy = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(X, colX),
+                                                _mm512_mul_ps(Y, colY)), trans);
+    #ifdef SK_LEGACY_MATRIX_MATH_ORDER
+        __m512 z = _mm512_add_ps(_mm512_mul_ps(X, P0),
+                                 _mm512_add_ps(_mm512_mul_ps(Y, P1), P2));
+    #else
+        __m512 z = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(X, P0),
+                                               _mm512_mul_ps(Y, P1)), P2);
+    #endif
+        __mmask16 nonzero = _mm512_cmp_ps_mask(z, zero, _CMP_NEQ_UQ);
+        return _mm512_mul_ps(xy, _mm512_maskz_div_ps(nonzero, one, z));
+    };
+    for (; count >= 16; count -= 16) {
+        __m512 lo = map8(_mm512_loadu_ps(src + 0)),
+               hi = map8(_mm512_loadu_ps(src + 8));
+        _mm512_storeu_ps(dst + 0, lo);
+        _mm512_storeu_ps(dst + 8, hi);
+        src += 16;
+        dst += 16;
+    }
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    const __m256 colX  = _mm256_setr_ps(sx,ky,sx,ky,sx,ky,sx,ky),
+                 colY  = _mm256_setr_ps(kx,sy,kx,sy,kx,sy,kx,sy),
+                 trans = _mm256_setr_ps(tx,ty,tx,ty,tx,ty,tx,ty),
+                 P0 = _mm256_set1_ps(p0),
+                 P1 = _mm256_set1_ps(p1),
+                 P2 = _mm256_set1_ps(p2),
+                 one  = _mm256_set1_ps(1),
+                 zero = _mm256_setzero_ps();
+    auto map4 = [&](__m256 v) {
+        __m256 X = _mm256_moveldup_ps(v),
+               Y = _mm256_movehdup_ps(v);
+        __m256 xy = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(X, colX),
+                                                _mm256_mul_ps(Y, colY)), trans);
+    #ifdef SK_LEGACY_MATRIX_MATH_ORDER
+        __m256 z = _mm256_add_ps(_mm256_mul_ps(X, P0),
+                                 _mm256_add_ps(_mm256_mul_ps(Y, P1), P2));
+    #else
+        __m256 z = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(X, P0),
+                                               _mm256_mul_ps(Y, P1)), P2);
+    #endif
+        __m256 nonzero = _mm256_cmp_ps(z, zero, _CMP_NEQ_UQ);
+        return _mm256_mul_ps(xy, _mm256_and_ps(nonzero, _mm256_div_ps(one, z)));
+    };
+    for (; count >= 8; count -= 8) {
+        __m256 lo = map4(_mm256_loadu_ps(&src[0].fX)),
+               hi = map4(_mm256_loadu_ps(&src[4].fX));
+        _mm256_storeu_ps(&dst[0].fX, lo);
+        _mm256_storeu_ps(&dst[4].fX, hi);
+        src += 8;
+        dst += 8;
+    }
+#endif
+
+    const Sk4f colX4 (sx, ky, sx, ky),
+               colY4 (kx, sy, kx, sy),
+               trans4(tx, ty, tx, ty);
+    for (; count >= 2; count -= 2) {
+        Sk4f src4 = Sk4f::Load(src),
+             X = SkNx_shuffle<0,0,2,2>(src4),
+             Y = SkNx_shuffle<1,1,3,3>(src4);
+        Sk4f xy = X * colX4 + Y * colY4 + trans4;
+    #ifdef SK_LEGACY_MATRIX_MATH_ORDER
+        Sk4f z = X * p0 + (Y * p1 + p2);
+    #else
+        Sk4f z = X * p0 + Y * p1 + p2;
+    #endif
+        (xy * (z != 0).thenElse(1.0f / z, 0.0f)).store(dst);
+        src += 2;
+        dst += 2;
+    }
+    if (count > 0) {
+        Sk2f X = src->fX,
+             Y = src->fY;
+        Sk2f xy = X * Sk2f(sx, ky) + Y * Sk2f(kx, sy) + Sk2f(tx, ty);
+    #ifdef SK_LEGACY_MATRIX_MATH_ORDER
+        Sk2f z = X * p0 + (Y * p1 + p2);
+    #else
+        Sk2f z = X * p0 + Y * p1 + p2;
+    #endif
+        (xy * (z != 0).thenElse(1.0f / z, 0.0f)).store(dst);
+    }
+}
+
+}  // namespace SK_OPTS_NS
+
+#endif//SkMatrix_opts_DEFINED
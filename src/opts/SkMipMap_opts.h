@@ -0,0 +1,119 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMipMap_opts_DEFINED
+#define SkMipMap_opts_DEFINED
+
+#include "SkHalf.h"
+#include "SkNx.h"
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    #include <immintrin.h>
+#endif
+
+namespace SK_OPTS_NS {
+
+// Each of these averages the 2x2 blocks of two source rows into count destination pixels, with
+// the same arithmetic as SkMipMap's downsample_2_2: the sums are truncated for 8888, and added
+// in the same order for F16.
+
+static void downsample_2_2_8888(void* dst, const void* src, size_t srcRB, int count) {
+    auto p0 = static_cast<const uint8_t*>(src);
+    auto p1 = p0 + srcRB;
+    auto d  = static_cast<uint8_t*>(dst);
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    const __m256i zero = _mm256_setzero_si256();
+    for (; count >= 4; count -= 4) {
+        __m256i r0 = _mm256_loadu_si256((const __m256i*)p0),
+                r1 = _mm256_loadu_si256((const __m256i*)p1);
+        // 16-bit sums of the two rows: lo holds pixels 0,1|4,5 and hi holds pixels 2,3|6,7.
+        __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(r0, zero),
+                                      _mm256_unpacklo_epi8(r1, zero)),
+                hi = _mm256_add_epi16(_mm256_unpackhi_epi8(r0, zero),
+                                      _mm256_unpackhi_epi8(r1, zero));
+        // Add each even pixel to the odd one after it, giving destination pixels 0,1|2,3.
+        __m256i sum = _mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi),
+                                       _mm256_unpackhi_epi64(lo, hi));
+        sum = _mm256_srli_epi16(sum, 2);
+        __m256i px = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), 0x08);
+        _mm_storeu_si128((__m128i*)d, _mm256_castsi256_si128(px));
+        p0 += 32;
+        p1 += 32;
+        d  += 16;
+    }
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; count >= 2; count -= 2) {
+        __m128i r0 = _mm_loadu_si128((const __m128i*)p0),
+                r1 = _mm_loadu_si128((const __m128i*)p1);
+        // 16-bit sums of the two rows: lo holds pixels 0,1 and hi holds pixels 2,3.
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(r0, zero), _mm_unpacklo_epi8(r1, zero)),
+                hi = _mm_add_epi16(_mm_unpackhi_epi8(r0, zero), _mm_unpackhi_epi8(r1, zero));
+        __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+        sum = _mm_srli_epi16(sum, 2);
+        _mm_storel_epi64((__m128i*)d, _mm_packus_epi16(sum, sum));
+        p0 += 16;
+        p1 += 16;
+        d  += 8;
+    }
+#endif
+
+    for (; count > 0; --count) {
+        auto c00 = SkNx_cast<uint16_t>(Sk4b::Load(p0 + 0)),
+             c01 = SkNx_cast<uint16_t>(Sk4b::Load(p0 + 4)),
+             c10 = SkNx_cast<uint16_t>(Sk4b::Load(p1 + 0)),
+             c11 = SkNx_cast<uint16_t>(Sk4b::Load(p1 + 4));
+        SkNx_cast<uint8_t>((c00 + c10 + c01 + c11) >> 2).store(d);
+        p0 += 8;
+        p1 += 8;
+        d  += 4;
+    }
+}
+
+static void downsample_2_2_f16(void* dst, const void* src, size_t srcRB, int count) {
+    auto p0 = static_cast<const uint64_t*>(src);
+    auto p1 = (const uint64_t*)((const char*)p0 + srcRB);
+    auto d  = static_cast<uint64_t*>(dst);
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    // F16C converts denormal halfs rather than flushing them to zero, like the ARMv8 conversions
+    // in SkHalf.h. Rounding toward zero otherwise matches the portable truncation.
+    auto load_even_odd = [](const uint64_t* p, __m256* even, __m256* odd) {
+        __m256 a = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(p + 0))),   // pixels 0,1
+               b = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(p + 2)));   // pixels 2,3
+        *even = _mm256_permute2f128_ps(a, b, 0x20);                             // pixels 0,2
+        *odd  = _mm256_permute2f128_ps(a, b, 0x31);                             // pixels 1,3
+    };
+    for (; count >= 2; count -= 2) {
+        __m256 c00, c01, c10, c11;
+        load_even_odd(p0, &c00, &c01);
+        load_even_odd(p1, &c10, &c11);
+        __m256 c = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(c00, c10), c01), c11);
+        c = _mm256_mul_ps(c, _mm256_set1_ps(0.25f));
+        _mm_storeu_si128((__m128i*)d, _mm256_cvtps_ph(c, _MM_FROUND_TO_ZERO));
+        p0 += 4;
+        p1 += 4;
+        d  += 2;
+    }
+#endif
+
+    for (; count > 0; --count) {
+        auto c00 = SkHalfToFloat_finite_ftz(p0[0]),
+             c01 = SkHalfToFloat_finite_ftz(p0[1]),
+             c10 = SkHalfToFloat_finite_ftz(p1[0]),
+             c11 = SkHalfToFloat_finite_ftz(p1[1]);
+        SkFloatToHalf_finite_ftz((c00 + c10 + c01 + c11) * 0.25f).store(d);
+        p0 += 2;
+        p1 += 2;
+        d  += 1;
+    }
+}
+
+}  // namespace SK_OPTS_NS
+
+#endif//SkMipMap_opts_DEFINED
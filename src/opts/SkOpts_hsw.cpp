@@ -8,11 +8,22 @@
 #include "SkOpts.h"
 
 #define SK_OPTS_NS hsw
+#include "SkMaskBlurFilter_opts.h"
+#include "SkMatrix_opts.h"
+#include "SkMipMap_opts.h"
 #include "SkRasterPipeline_opts.h"
 #include "SkUtils_opts.h"
 
 namespace SkOpts {
     void Init_hsw() {
+        box_blur_8_rows = SK_OPTS_NS::box_blur_8_rows;
+
+        downsample_2_2_8888 = SK_OPTS_NS::downsample_2_2_8888;
+        downsample_2_2_f16  = SK_OPTS_NS::downsample_2_2_f16;
+
+        matrix_map_affine = SK_OPTS_NS::matrix_map_affine;
+        matrix_map_persp  = SK_OPTS_NS::matrix_map_persp;
+
     #define M(st) stages_highp[SkRasterPipeline::st] = (StageFn)SK_OPTS_NS::st;
         SK_RASTER_PIPELINE_STAGES(M)
         just_return_highp = (StageFn)SK_OPTS_NS::just_return;
@@ -83,8 +83,10 @@ struct Ctx {
     #define JUMPER_IS_SCALAR
 #elif defined(SK_ARM_HAS_NEON)
     #define JUMPER_IS_NEON
-#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX512
-    #define JUMPER_IS_AVX512
+#elif defined(__wasm_simd128__)
+    #define JUMPER_IS_WASM
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    #define JUMPER_IS_SKX
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
     #define JUMPER_IS_HSW
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX
@@ -111,7 +113,7 @@ struct Ctx {
     #endif
 #endif
 
-#if defined(JUMPER_IS_SCALAR)
+#if defined(JUMPER_IS_SCALAR) || defined(JUMPER_IS_WASM)
     #include <math.h>
 #elif defined(JUMPER_IS_NEON)
     #include <arm_neon.h>
@@ -289,7 +291,240 @@ namespace SK_OPTS_NS {
         }
     }
 
-#elif defined(JUMPER_IS_AVX) || defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_WASM)
+    // There are no wasm-simd128 intrinsics we can rely on yet, but Clang lowers its vector
+    // extensions straight to 128-bit wasm SIMD.  We polyfill the rest portably.
+    template <typename T> using V = T __attribute__((ext_vector_type(4)));
+    using F   = V<float   >;
+    using I32 = V< int32_t>;
+    using U64 = V<uint64_t>;
+    using U32 = V<uint32_t>;
+    using U16 = V<uint16_t>;
+    using U8  = V<uint8_t >;
+
+    SI F if_then_else(I32 c, F t, F e) { return (F)( ((I32)t & c) | ((I32)e & ~c) ); }
+
+    SI F   mad(F f, F m, F a)   { return f*m+a; }
+    SI F   min(F a, F b)        { return if_then_else(a < b, a, b); }
+    SI F   max(F a, F b)        { return if_then_else(a > b, a, b); }
+    SI F   abs_  (F v)          { return (F)((I32)v & 0x7fffffff); }
+    SI F   rcp   (F v)          { return 1.0f / v; }
+    SI F    sqrt_(F v)          { return F{sqrtf(v[0]), sqrtf(v[1]), sqrtf(v[2]), sqrtf(v[3])}; }
+    SI F   rsqrt (F v)          { return 1.0f / sqrt_(v); }
+    SI U32 round (F v, F scale) { return __builtin_convertvector(mad(v,scale,0.5f), U32); }
+    SI U16 pack(U32 v)          { return __builtin_convertvector(v, U16); }
+    SI U8  pack(U16 v)          { return __builtin_convertvector(v,  U8); }
+
+    SI F floor_(F v) {
+        F roundtrip = __builtin_convertvector(__builtin_convertvector(v, I32), F);
+        return roundtrip - if_then_else(roundtrip > v, F(1), F(0));
+    }
+
+    template <typename T>
+    SI V<T> gather(const T* p, U32 ix) {
+        return {p[ix[0]], p[ix[1]], p[ix[2]], p[ix[3]]};
+    }
+
+    SI void load3(const uint16_t* ptr, size_t tail, U16* r, U16* g, U16* b) {
+        U16 R = 0, G = 0, B = 0;
+        for (size_t i = 0; i < (tail ? tail : 4); i++) {
+            R[i] = ptr[3*i+0];
+            G[i] = ptr[3*i+1];
+            B[i] = ptr[3*i+2];
+        }
+        *r = R;
+        *g = G;
+        *b = B;
+    }
+    SI void load4(const uint16_t* ptr, size_t tail, U16* r, U16* g, U16* b, U16* a) {
+        U16 R = 0, G = 0, B = 0, A = 0;
+        for (size_t i = 0; i < (tail ? tail : 4); i++) {
+            R[i] = ptr[4*i+0];
+            G[i] = ptr[4*i+1];
+            B[i] = ptr[4*i+2];
+            A[i] = ptr[4*i+3];
+        }
+        *r = R;
+        *g = G;
+        *b = B;
+        *a = A;
+    }
+    SI void store4(uint16_t* ptr, size_t tail, U16 r, U16 g, U16 b, U16 a) {
+        for (size_t i = 0; i < (tail ? tail : 4); i++) {
+            ptr[4*i+0] = r[i];
+            ptr[4*i+1] = g[i];
+            ptr[4*i+2] = b[i];
+            ptr[4*i+3] = a[i];
+        }
+    }
+
+    SI void load4(const float* ptr, size_t tail, F* r, F* g, F* b, F* a) {
+        F R = 0, G = 0, B = 0, A = 0;
+        for (size_t i = 0; i < (tail ? tail : 4); i++) {
+            R[i] = ptr[4*i+0];
+            G[i] = ptr[4*i+1];
+            B[i] = ptr[4*i+2];
+            A[i] = ptr[4*i+3];
+        }
+        *r = R;
+        *g = G;
+        *b = B;
+        *a = A;
+    }
+    SI void store4(float* ptr, size_t tail, F r, F g, F b, F a) {
+        for (size_t i = 0; i < (tail ? tail : 4); i++) {
+            ptr[4*i+0] = r[i];
+            ptr[4*i+1] = g[i];
+            ptr[4*i+2] = b[i];
+            ptr[4*i+3] = a[i];
+        }
+    }
+
+#elif defined(JUMPER_IS_SKX)
+    // These are __m512 and __m512i, but friendlier and strongly-typed.
+    template <typename T> using V = T __attribute__((ext_vector_type(16)));
+    using F   = V<float   >;
+    using I32 = V< int32_t>;
+    using U64 = V<uint64_t>;
+    using U32 = V<uint32_t>;
+    using U16 = V<uint16_t>;
+    using U8  = V<uint8_t >;
+
+    SI F   mad(F f, F m, F a)   { return _mm512_fmadd_ps(f,m,a); }
+    SI F   min(F a, F b)        { return _mm512_min_ps(a,b);     }
+    SI F   max(F a, F b)        { return _mm512_max_ps(a,b);     }
+    SI F   abs_  (F v)          { return _mm512_and_ps(v, 0-v);  }
+    SI F   floor_(F v)          { return _mm512_floor_ps(v);     }
+    SI F   rcp   (F v)          { return _mm512_rcp14_ps  (v);   }
+    SI F   rsqrt (F v)          { return _mm512_rsqrt14_ps(v);   }
+    SI F    sqrt_(F v)          { return _mm512_sqrt_ps (v);     }
+    SI U32 round (F v, F scale) { return _mm512_cvtps_epi32(v*scale); }
+
+    SI U16 pack(U32 v) { return __builtin_convertvector(v, U16); }  // vpmovdw
+    SI U8  pack(U16 v) { return __builtin_convertvector(v,  U8); }  // vpmovwb
+
+    SI F if_then_else(I32 c, F t, F e) {
+        return _mm512_mask_blend_ps(_mm512_movepi32_mask(c), e,t);
+    }
+
+    template <typename T>
+    SI V<T> gather(const T* p, U32 ix) {
+        return { p[ix[ 0]], p[ix[ 1]], p[ix[ 2]], p[ix[ 3]],
+                 p[ix[ 4]], p[ix[ 5]], p[ix[ 6]], p[ix[ 7]],
+                 p[ix[ 8]], p[ix[ 9]], p[ix[10]], p[ix[11]],
+                 p[ix[12]], p[ix[13]], p[ix[14]], p[ix[15]], };
+    }
+    SI F   gather(const float*    p, U32 ix) { return _mm512_i32gather_ps   (ix, p, 4); }
+    SI U32 gather(const uint32_t* p, U32 ix) { return _mm512_i32gather_epi32(ix, p, 4); }
+    SI U64 gather(const uint64_t* p, U32 ix) {
+        __m512i parts[] = {
+            _mm512_i32gather_epi64(_mm512_castsi512_si256    (ix   ), p, 8),
+            _mm512_i32gather_epi64(_mm512_extracti64x4_epi64(ix, 1), p, 8),
+        };
+        return bit_cast<U64>(parts);
+    }
+
+    // Instead of trees of unpacks, we (de)interleave with one two-source permute per output,
+    // and let masked loads and stores handle the tail.
+
+    SI void load3(const uint16_t* ptr, size_t tail, U16* r, U16* g, U16* b) {
+        // 16 pixels are 48 uint16_t, the first 32 in _0 and the rest in _1.
+        uint64_t mask = tail ? (1ull << (3*tail)) - 1 : ~0ull;
+        __m512i _0 = _mm512_maskz_loadu_epi16((__mmask32)(mask      ), ptr +  0),
+                _1 = _mm512_castsi256_si512(
+                     _mm256_maskz_loadu_epi16((__mmask16)(mask >> 32), ptr + 32));
+
+        static const uint16_t ix[3][32] = {
+            { 0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 33, 36, 39, 42, 45 },
+            { 1, 4, 7,10, 13, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46 },
+            { 2, 5, 8,11, 14, 17, 20, 23, 26, 29, 32, 35, 38, 41, 44, 47 },
+        };
+        *r = _mm512_castsi512_si256(_mm512_permutex2var_epi16(_0, _mm512_loadu_si512(ix[0]), _1));
+        *g = _mm512_castsi512_si256(_mm512_permutex2var_epi16(_0, _mm512_loadu_si512(ix[1]), _1));
+        *b = _mm512_castsi512_si256(_mm512_permutex2var_epi16(_0, _mm512_loadu_si512(ix[2]), _1));
+    }
+    SI void load4(const uint16_t* ptr, size_t tail, U16* r, U16* g, U16* b, U16* a) {
+        // Each pixel is one uint64_t, pixels 0-7 in _0 and 8-15 in _1.
+        __mmask16 mask = tail ? (__mmask16)((1u << tail) - 1) : (__mmask16)0xffff;
+        __m512i _0 = _mm512_maskz_loadu_epi64((__mmask8)(mask     ), ptr +  0),
+                _1 = _mm512_maskz_loadu_epi64((__mmask8)(mask >> 8), ptr + 32);
+
+        static const uint16_t ix[4][32] = {
+            { 0, 4,  8, 12, 16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60 },
+            { 1, 5,  9, 13, 17, 21, 25, 29, 33, 37, 41, 45, 49, 53, 57, 61 },
+            { 2, 6, 10, 14, 18, 22, 26, 30, 34, 38, 42, 46, 50, 54, 58, 62 },
+            { 3, 7, 11, 15, 19, 23, 27, 31, 35, 39, 43, 47, 51, 55, 59, 63 },
+        };
+        *r = _mm512_castsi512_si256(_mm512_permutex2var_epi16(_0, _mm512_loadu_si512(ix[0]), _1));
+        *g = _mm512_castsi512_si256(_mm512_permutex2var_epi16(_0, _mm512_loadu_si512(ix[1]), _1));
+        *b = _mm512_castsi512_si256(_mm512_permutex2var_epi16(_0, _mm512_loadu_si512(ix[2]), _1));
+        *a = _mm512_castsi512_si256(_mm512_permutex2var_epi16(_0, _mm512_loadu_si512(ix[3]), _1));
+    }
+    SI void store4(uint16_t* ptr, size_t tail, U16 r, U16 g, U16 b, U16 a) {
+        __m512i rg = _mm512_inserti64x4(_mm512_castsi256_si512(r), g, 1),  // r0..r15 g0..g15
+                ba = _mm512_inserti64x4(_mm512_castsi256_si512(b), a, 1);  // b0..b15 a0..a15
+
+        static const uint16_t ix[2][32] = {
+            { 0,16,32,48,  1,17,33,49,  2,18,34,50,  3,19,35,51,
+              4,20,36,52,  5,21,37,53,  6,22,38,54,  7,23,39,55 },
+            { 8,24,40,56,  9,25,41,57, 10,26,42,58, 11,27,43,59,
+             12,28,44,60, 13,29,45,61, 14,30,46,62, 15,31,47,63 },
+        };
+        __m512i _0 = _mm512_permutex2var_epi16(rg, _mm512_loadu_si512(ix[0]), ba),  // pixels 0-7
+                _1 = _mm512_permutex2var_epi16(rg, _mm512_loadu_si512(ix[1]), ba);  // pixels 8-15
+
+        __mmask16 mask = tail ? (__mmask16)((1u << tail) - 1) : (__mmask16)0xffff;
+        _mm512_mask_storeu_epi64(ptr +  0, (__mmask8)(mask     ), _0);
+        _mm512_mask_storeu_epi64(ptr + 32, (__mmask8)(mask >> 8), _1);
+    }
+
+    SI void load4(const float* ptr, size_t tail, F* r, F* g, F* b, F* a) {
+        // Each pixel is 4 floats, so each of _0,_1,_2,_3 holds 4 pixels.
+        uint64_t mask = tail ? (1ull << (4*tail)) - 1 : ~0ull;
+        F _0 = _mm512_maskz_loadu_ps((__mmask16)(mask >>  0), ptr +  0),
+          _1 = _mm512_maskz_loadu_ps((__mmask16)(mask >> 16), ptr + 16),
+          _2 = _mm512_maskz_loadu_ps((__mmask16)(mask >> 32), ptr + 32),
+          _3 = _mm512_maskz_loadu_ps((__mmask16)(mask >> 48), ptr + 48);
+
+        const __m512i rg = _mm512_setr_epi32(0,4, 8,12,16,20,24,28, 1,5, 9,13,17,21,25,29),
+                      ba = _mm512_setr_epi32(2,6,10,14,18,22,26,30, 3,7,11,15,19,23,27,31),
+                      lo = _mm512_setr_epi32(0,1,2,3,4,5,6,7, 16,17,18,19,20,21,22,23),
+                      hi = _mm512_setr_epi32(8,9,10,11,12,13,14,15, 24,25,26,27,28,29,30,31);
+
+        F rg01 = _mm512_permutex2var_ps(_0, rg, _1),  // r0..r7  g0..g7
+          ba01 = _mm512_permutex2var_ps(_0, ba, _1),  // b0..b7  a0..a7
+          rg23 = _mm512_permutex2var_ps(_2, rg, _3),  // r8..r15 g8..g15
+          ba23 = _mm512_permutex2var_ps(_2, ba, _3);  // b8..b15 a8..a15
+
+        *r = _mm512_permutex2var_ps(rg01, lo, rg23);
+        *g = _mm512_permutex2var_ps(rg01, hi, rg23);
+        *b = _mm512_permutex2var_ps(ba01, lo, ba23);
+        *a = _mm512_permutex2var_ps(ba01, hi, ba23);
+    }
+    SI void store4(float* ptr, size_t tail, F r, F g, F b, F a) {
+        const __m512i lo = _mm512_setr_epi32(0,1,2,3,4,5,6,7, 16,17,18,19,20,21,22,23),
+                      hi = _mm512_setr_epi32(8,9,10,11,12,13,14,15, 24,25,26,27,28,29,30,31),
+                      _03 = _mm512_setr_epi32(0, 8,16,24, 1, 9,17,25, 2,10,18,26, 3,11,19,27),
+                      _47 = _mm512_setr_epi32(4,12,20,28, 5,13,21,29, 6,14,22,30, 7,15,23,31);
+
+        F rg01 = _mm512_permutex2var_ps(r, lo, g),  // r0..r7  g0..g7
+          rg23 = _mm512_permutex2var_ps(r, hi, g),  // r8..r15 g8..g15
+          ba01 = _mm512_permutex2var_ps(b, lo, a),  // b0..b7  a0..a7
+          ba23 = _mm512_permutex2var_ps(b, hi, a);  // b8..b15 a8..a15
+
+        F _0 = _mm512_permutex2var_ps(rg01, _03, ba01),  // pixels  0-3
+          _1 = _mm512_permutex2var_ps(rg01, _47, ba01),  // pixels  4-7
+          _2 = _mm512_permutex2var_ps(rg23, _03, ba23),  // pixels  8-11
+          _3 = _mm512_permutex2var_ps(rg23, _47, ba23);  // pixels 12-15
+
+        uint64_t mask = tail ? (1ull << (4*tail)) - 1 : ~0ull;
+        _mm512_mask_storeu_ps(ptr +  0, (__mmask16)(mask >>  0), _0);
+        _mm512_mask_storeu_ps(ptr + 16, (__mmask16)(mask >> 16), _1);
+        _mm512_mask_storeu_ps(ptr + 32, (__mmask16)(mask >> 32), _2);
+        _mm512_mask_storeu_ps(ptr + 48, (__mmask16)(mask >> 48), _3);
+    }
+
+#elif defined(JUMPER_IS_AVX) || defined(JUMPER_IS_HSW)
     // These are __m256 and __m256i, but friendlier and strongly-typed.
     template <typename T> using V = T __attribute__((ext_vector_type(8)));
     using F   = V<float   >;
@@ -300,7 +535,7 @@ namespace SK_OPTS_NS {
     using U8  = V<uint8_t >;
 
     SI F mad(F f, F m, F a)  {
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_HSW)
         return _mm256_fmadd_ps(f,m,a);
     #else
         return f*m+a;
@@ -332,7 +567,7 @@ namespace SK_OPTS_NS {
         return { p[ix[0]], p[ix[1]], p[ix[2]], p[ix[3]],
                  p[ix[4]], p[ix[5]], p[ix[6]], p[ix[7]], };
     }
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_HSW)
         SI F   gather(const float*    p, U32 ix) { return _mm256_i32gather_ps   (p, ix, 4); }
         SI U32 gather(const uint32_t* p, U32 ix) { return _mm256_i32gather_epi32(p, ix, 4); }
         SI U64 gather(const uint64_t* p, U32 ix) {
@@ -732,7 +967,10 @@ SI F from_half(U16 h) {
 #if defined(SK_CPU_ARM64) && !defined(SK_BUILD_FOR_GOOGLE3)  // Temporary workaround for some Google3 builds.
     return vcvt_f32_f16(h);
 
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_SKX)
+    return _mm512_cvtph_ps(h);
+
+#elif defined(JUMPER_IS_HSW)
     return _mm256_cvtph_ps(h);
 
 #else
@@ -752,7 +990,10 @@ SI U16 to_half(F f) {
 #if defined(SK_CPU_ARM64) && !defined(SK_BUILD_FOR_GOOGLE3)  // Temporary workaround for some Google3 builds.
     return vcvt_f16_f32(f);
 
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_SKX)
+    return _mm512_cvtps_ph(f, _MM_FROUND_CUR_DIRECTION);
+
+#elif defined(JUMPER_IS_HSW)
     return _mm256_cvtps_ph(f, _MM_FROUND_CUR_DIRECTION);
 
 #else
@@ -892,6 +1133,16 @@ SI V load(const T* src, size_t tail) {
     if (__builtin_expect(tail, 0)) {
         V v{};  // Any inactive lanes are zeroed.
         switch (tail) {
+        #if defined(JUMPER_IS_SKX)
+            case 15: v[14] = src[14];
+            case 14: v[13] = src[13];
+            case 13: v[12] = src[12];
+            case 12: v[11] = src[11];
+            case 11: v[10] = src[10];
+            case 10: v[ 9] = src[ 9];
+            case  9: v[ 8] = src[ 8];
+            case  8: memcpy(&v, src, 8*sizeof(T)); break;
+        #endif
             case 7: v[6] = src[6];
             case 6: v[5] = src[5];
             case 5: v[4] = src[4];
@@ -912,6 +1163,16 @@ SI void store(T* dst, V v, size_t tail) {
     __builtin_assume(tail < N);
     if (__builtin_expect(tail, 0)) {
         switch (tail) {
+        #if defined(JUMPER_IS_SKX)
+            case 15: dst[14] = v[14];
+            case 14: dst[13] = v[13];
+            case 13: dst[12] = v[12];
+            case 12: dst[11] = v[11];
+            case 11: dst[10] = v[10];
+            case 10: dst[ 9] = v[ 9];
+            case  9: dst[ 8] = v[ 8];
+            case  8: memcpy(dst, &v, 8*sizeof(T)); break;
+        #endif
             case 7: dst[6] = v[6];
             case 6: dst[5] = v[5];
             case 5: dst[4] = v[4];
@@ -1011,7 +1272,7 @@ STAGE(seed_shader, Ctx::None) {
 
 STAGE(dither, const float* rate) {
     // Get [(dx,dy), (dx+1,dy), (dx+2,dy), ...] loaded up in integer vectors.
-    uint32_t iota[] = {0,1,2,3,4,5,6,7};
+    uint32_t iota[] = {0,1,2,3,4,5,6,7, 8,9,10,11,12,13,14,15};
     U32 X = dx + unaligned_load<U32>(iota),
         Y = dy;
 
@@ -1557,6 +1818,28 @@ STAGE(gamma, const float* G) {
     b = fn(b);
 }
 
+// Lerps a table of N = limit+1 evenly spaced samples over [0,1], extrapolating past 1.
+SI F lerp_table(const float* table, float limit, F v) {
+    U32 sign;
+    v = strip_sign(v, &sign);
+
+    F x = v * limit,
+      i = min(max(0, floor_(x)), limit - 1);
+    U32 ix = trunc_(i);
+    return apply_sign(lerp(gather(table, ix), gather(table, ix + 1), x - i), sign);
+}
+
+STAGE(xform_lut, const SkRasterPipeline_XformLUTCtx* c) {
+    F lr = lerp_table(c->linearize, 255, r),
+      lg = lerp_table(c->linearize, 255, g),
+      lb = lerp_table(c->linearize, 255, b);
+
+    const float* m = c->matrix;
+    r = lerp_table(c->encode, 1023, mad(lr,m[0], mad(lg,m[3], lb*m[6])));
+    g = lerp_table(c->encode, 1023, mad(lr,m[1], mad(lg,m[4], lb*m[7])));
+    b = lerp_table(c->encode, 1023, mad(lr,m[2], mad(lg,m[5], lb*m[8])));
+}
+
 STAGE(from_srgb, Ctx::None) {
     auto fn = [](F s) {
         U32 sign;
@@ -1574,7 +1857,7 @@ STAGE(to_srgb, Ctx::None) {
         U32 sign;
         l = strip_sign(l, &sign);
         // We tweak c and d for each instruction set to make sure fn(1) is exactly 1.
-    #if defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_SKX)
         const float c = 1.130026340485f,
                     d = 0.141387879848f;
     #elif defined(JUMPER_IS_SSE2) || defined(JUMPER_IS_SSE41) || \
@@ -1917,7 +2200,21 @@ STAGE(matrix_perspective, const float* m) {
 SI void gradient_lookup(const SkRasterPipeline_GradientCtx* c, U32 idx, F t,
                         F* r, F* g, F* b, F* a) {
     F fr, br, fg, bg, fb, bb, fa, ba;
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_SKX)
+    if (c->stopCount <= 16) {
+        auto lookup = [&](const float* v) {
+            return _mm512_permutexvar_ps(idx, _mm512_maskz_loadu_ps((1u << c->stopCount) - 1, v));
+        };
+        fr = lookup(c->fs[0]);
+        br = lookup(c->bs[0]);
+        fg = lookup(c->fs[1]);
+        bg = lookup(c->bs[1]);
+        fb = lookup(c->fs[2]);
+        bb = lookup(c->bs[2]);
+        fa = lookup(c->fs[3]);
+        ba = lookup(c->bs[3]);
+    } else
+#elif defined(JUMPER_IS_HSW)
     if (c->stopCount <=8) {
         fr = _mm256_permutevar8x32_ps(_mm256_loadu_ps(c->fs[0]), idx);
         br = _mm256_permutevar8x32_ps(_mm256_loadu_ps(c->bs[0]), idx);
@@ -1976,6 +2273,80 @@ STAGE(evenly_spaced_2_stop_gradient, const void* ctx) {
     a = mad(t, c->f[3], c->b[3]);
 }
 
+STAGE(gradient_lut_8888, const SkRasterPipeline_GradientLUTCtx* c) {
+    F x = min(max(0, mad(r, c->scale, -0.5f)), c->limit);
+    U32 ix0 = trunc_(x),
+        ix1 = trunc_(min(x + 1, c->limit));
+    F t = fract(x);
+
+    F lr,lg,lb,la, rr,rg,rb,ra;
+    from_8888(gather(c->lut, ix0), &lr,&lg,&lb,&la);
+    from_8888(gather(c->lut, ix1), &rr,&rg,&rb,&ra);
+    r = lerp(lr,rr, t);
+    g = lerp(lg,rg, t);
+    b = lerp(lb,rb, t);
+    a = lerp(la,ra, t);
+}
+
+STAGE(perlin_noise, const SkRasterPipeline_PerlinNoiseCtx* c) {
+    // Noise is sampled at the nearest whole pixel; r and g sit at pixel centers.
+    F x = floor_(r + c->offsetX) * c->baseFrequencyX,
+      y = floor_(g + c->offsetY) * c->baseFrequencyY;
+
+    F sum[4] = { 0, 0, 0, 0 };
+    float scale = 1.0f;
+    for (int octave = 0; octave < c->numOctaves; octave++) {
+        // The lattice is offset by 4096 to keep it positive, and doesn't depend on the channel.
+        F px = x + 4096.0f,
+          py = y + 4096.0f;
+        F fx = floor_(px),
+          fy = floor_(py);
+        F tx = px - fx,
+          ty = py - fy;
+        I32 ix0 = bit_cast<I32>(trunc_(fx)), ix1 = ix0 + 1,
+            iy0 = bit_cast<I32>(trunc_(fy)), iy1 = iy0 + 1;
+        if (c->stitch) {
+            const int* s = c->stitch + 4*octave;
+            ix0 = if_then_else(ix0 >= s[0], ix0 - s[1], ix0);
+            ix1 = if_then_else(ix1 >= s[0], ix1 - s[1], ix1);
+            iy0 = if_then_else(iy0 >= s[2], iy0 - s[3], iy0);
+            iy1 = if_then_else(iy1 >= s[2], iy1 - s[3], iy1);
+        }
+        U32 i = expand(gather(c->latticeSelector, bit_cast<U32>(ix0) & 255)),
+            j = expand(gather(c->latticeSelector, bit_cast<U32>(ix1) & 255));
+        U32 b00 = ((i + bit_cast<U32>(iy0)) & 255) * 2,
+            b10 = ((j + bit_cast<U32>(iy0)) & 255) * 2,
+            b01 = ((i + bit_cast<U32>(iy1)) & 255) * 2,
+            b11 = ((j + bit_cast<U32>(iy1)) & 255) * 2;
+        F sx = tx * tx * (3 - 2 * tx),
+          sy = ty * ty * (3 - 2 * ty);
+
+        for (int channel = 0; channel < 4; channel++) {
+            const float* gradients = c->gradients + 512*channel;
+            auto dot = [&](U32 b, F dx, F dy) {
+                return gather(gradients, b) * dx + gather(gradients, b + 1) * dy;
+            };
+            F ab = lerp(dot(b00, tx, ty    ), dot(b10, tx - 1, ty    ), sx),
+              cd = lerp(dot(b01, tx, ty - 1), dot(b11, tx - 1, ty - 1), sx);
+            F noise = lerp(ab, cd, sy);
+            sum[channel] += (c->fractalNoise ? noise : abs_(noise)) * scale;
+        }
+        x = x * 2;
+        y = y * 2;
+        scale *= 0.5f;
+    }
+
+    if (c->fractalNoise) {
+        for (int channel = 0; channel < 4; channel++) {
+            sum[channel] = (sum[channel] + 1) * 0.5f;
+        }
+    }
+    r = clamp_01(sum[0]);
+    g = clamp_01(sum[1]);
+    b = clamp_01(sum[2]);
+    a = clamp_01(sum[3]);
+}
+
 STAGE(xy_to_unit_angle, Ctx::None) {
     F X = r,
       Y = g;
@@ -2198,11 +2569,23 @@ STAGE(gauss_a_to_rgba, Ctx::None) {
     b = a;
 }
 
-// A specialized fused image shader for clamp-x, clamp-y, non-sRGB sampling.
-STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+// Tiles one sample coordinate for the fused samplers.  Clamping is left to ix_and_ptr().
+SI F tile(F v, SkRasterPipeline_TiledGatherCtx::TileMode mode,
+          const SkRasterPipeline_TileCtx* ctx) {
+    switch (mode) {
+        case SkRasterPipeline_TiledGatherCtx::kClamp:  return v;
+        case SkRasterPipeline_TiledGatherCtx::kRepeat: return exclusive_repeat(v, ctx);
+        case SkRasterPipeline_TiledGatherCtx::kMirror: return exclusive_mirror(v, ctx);
+    }
+    return v;
+}
+
+// Bilinear 8888 sampling shared by bilerp_clamp_8888 and bilerp_tiled_8888.
+// tiling is nullptr for clamp-x, clamp-y.
+SI void bilerp_8888(const SkRasterPipeline_GatherCtx* ctx,
+                    const SkRasterPipeline_TiledGatherCtx* tiling,
+                    F cx, F cy, F* r, F* g, F* b, F* a) {
     // (cx,cy) are the center of our sample.
-    F cx = r,
-      cy = g;
 
     // All sample points are at the same fractional offset (fx,fy).
     // They're the 4 corners of a logical 1x1 pixel surrounding (x,y) at (0.5,0.5) offsets.
@@ -2210,13 +2593,17 @@ STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
       fy = fract(cy + 0.5f);
 
     // We'll accumulate the color of all four samples into {r,g,b,a} directly.
-    r = g = b = a = 0;
+    *r = *g = *b = *a = 0;
 
     for (float dy = -0.5f; dy <= +0.5f; dy += 1.0f)
     for (float dx = -0.5f; dx <= +0.5f; dx += 1.0f) {
         // (x,y) are the coordinates of this sample point.
         F x = cx + dx,
           y = cy + dy;
+        if (tiling) {
+            x = tile(x, tiling->tileModeX, &tiling->tileX);
+            y = tile(y, tiling->tileModeY, &tiling->tileY);
+        }
 
         // ix_and_ptr() will clamp to the image's bounds for us.
         const uint32_t* ptr;
@@ -2233,13 +2620,98 @@ STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
           sy = (dy > 0) ? fy : 1.0f - fy,
           area = sx * sy;
 
-        r += sr * area;
-        g += sg * area;
-        b += sb * area;
-        a += sa * area;
+        *r += sr * area;
+        *g += sg * area;
+        *b += sb * area;
+        *a += sa * area;
+    }
+}
+
+// A specialized fused image shader for clamp-x, clamp-y, non-sRGB sampling.
+STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    bilerp_8888(ctx, nullptr, r,g, &r,&g,&b,&a);
+}
+
+// The same, for any mix of clamp, repeat, and mirror tiling.
+STAGE(bilerp_tiled_8888, const SkRasterPipeline_TiledGatherCtx* ctx) {
+    bilerp_8888(&ctx->gather, ctx, r,g, &r,&g,&b,&a);
+}
+
+SI void gather_px(const uint32_t* ptr, U32 ix, F* r, F* g, F* b, F* a) {
+    from_8888(gather(ptr, ix), r,g,b,a);
+}
+SI void gather_px(const uint64_t* ptr, U32 ix, F* r, F* g, F* b, F* a) {
+    auto px = gather(ptr, ix);
+
+    U16 R,G,B,A;
+    load4((const uint16_t*)&px,0, &R,&G,&B,&A);
+    *r = from_half(R);
+    *g = from_half(G);
+    *b = from_half(B);
+    *a = from_half(A);
+}
+
+// Fused bicubic sampling of 8888 (T == uint32_t) or F16 (T == uint64_t) images.  This samples the
+// same 16 pixels with the same filter as the bicubic_* stages, but the filter is separable, so we
+// compute only 4 x and 4 y weights and tile each coordinate once, then sum each row of 4 samples
+// weighted by x before weighting that row by y.
+template <typename T>
+SI void bicubic(const SkRasterPipeline_TiledGatherCtx* ctx, F cx, F cy,
+                F* r, F* g, F* b, F* a) {
+    F fx = fract(cx + 0.5f),
+      fy = fract(cy + 0.5f);
+    const F wx[] = { bicubic_far(1.0f - fx), bicubic_near(1.0f - fx),
+                     bicubic_near(       fx), bicubic_far (       fx) },
+            wy[] = { bicubic_far(1.0f - fy), bicubic_near(1.0f - fy),
+                     bicubic_near(       fy), bicubic_far (       fy) };
+
+    // The samples are at -1.5, -0.5, +0.5, and +1.5 from (cx,cy).
+    F xs[4], ys[4];
+    for (int i = 0; i < 4; i++) {
+        xs[i] = tile(cx + (i - 1.5f), ctx->tileModeX, &ctx->tileX);
+        ys[i] = tile(cy + (i - 1.5f), ctx->tileModeY, &ctx->tileY);
+    }
+
+    *r = *g = *b = *a = 0;
+    for (int j = 0; j < 4; j++) {
+        F rr = 0, rg = 0, rb = 0, ra = 0;
+        for (int i = 0; i < 4; i++) {
+            const T* ptr;
+            U32 ix = ix_and_ptr(&ptr, &ctx->gather, xs[i],ys[j]);
+
+            F sr,sg,sb,sa;
+            gather_px(ptr, ix, &sr,&sg,&sb,&sa);
+            rr = mad(sr, wx[i], rr);
+            rg = mad(sg, wx[i], rg);
+            rb = mad(sb, wx[i], rb);
+            ra = mad(sa, wx[i], ra);
+        }
+        *r = mad(rr, wy[j], *r);
+        *g = mad(rg, wy[j], *g);
+        *b = mad(rb, wy[j], *b);
+        *a = mad(ra, wy[j], *a);
     }
 }
 
+STAGE(bicubic_8888, const SkRasterPipeline_TiledGatherCtx* ctx) {
+    bicubic<uint32_t>(ctx, r,g, &r,&g,&b,&a);
+}
+STAGE(bicubic_f16, const SkRasterPipeline_TiledGatherCtx* ctx) {
+    bicubic<uint64_t>(ctx, r,g, &r,&g,&b,&a);
+}
+
+// ~~~~~~ Fused stages, substituted for common stage sequences by SkRasterPipeline::fuse() ~~~~~~ //
+
+STAGE(scale_u8_srcover_rgba_8888, const SkRasterPipeline_MaskedMemoryCtx* ctx) {
+    scale_u8_k         (ctx->mask, dx,dy,tail, r,g,b,a, dr,dg,db,da);
+    srcover_rgba_8888_k(ctx->dst,  dx,dy,tail, r,g,b,a, dr,dg,db,da);
+}
+
+STAGE(seed_shader_matrix_2x3, const float* m) {
+    seed_shader_k(Ctx::None{}, dx,dy,tail, r,g,b,a, dr,dg,db,da);
+    matrix_2x3_k (m,           dx,dy,tail, r,g,b,a, dr,dg,db,da);
+}
+
 namespace lowp {
 #if defined(JUMPER_IS_SCALAR) || defined(SK_DISABLE_LOWP_RASTER_PIPELINE)
     // If we're not compiled by Clang, or otherwise switched into scalar mode (old Clang, manually),
@@ -2254,7 +2726,7 @@ namespace lowp {
 
 #else  // We are compiling vector code with Clang... let's make some lowp stages!
 
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
     using U8  = uint8_t  __attribute__((ext_vector_type(16)));
     using U16 = uint16_t __attribute__((ext_vector_type(16)));
     using I16 =  int16_t __attribute__((ext_vector_type(16)));
@@ -2488,7 +2960,7 @@ SI F mad(F f, F m, F a) { return f*m+a; }
 SI U32 trunc_(F x) { return (U32)cast<I32>(x); }
 
 SI F rcp(F x) {
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(_mm256_rcp_ps(lo), _mm256_rcp_ps(hi));
@@ -2509,7 +2981,7 @@ SI F rcp(F x) {
 #endif
 }
 SI F sqrt_(F x) {
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(_mm256_sqrt_ps(lo), _mm256_sqrt_ps(hi));
@@ -2544,7 +3016,7 @@ SI F floor_(F x) {
     float32x4_t lo,hi;
     split(x, &lo,&hi);
     return join<F>(vrndmq_f32(lo), vrndmq_f32(hi));
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(_mm256_floor_ps(lo), _mm256_floor_ps(hi));
@@ -2594,6 +3066,20 @@ STAGE_GG(matrix_perspective, const float* m) {
     y = Y * rcp(Z);
 }
 
+STAGE_PP(matrix_4x5, const float* m) {
+    // The matrix works on unit-scale colors, so we do too.  Its output is clamped to [0,1] on the
+    // way back to 8-bit, which is all the clamp_0 and clamp_1 stages that follow it would do.
+    F R = cast<F>(r) * (1/255.0f),
+      G = cast<F>(g) * (1/255.0f),
+      B = cast<F>(b) * (1/255.0f),
+      A = cast<F>(a) * (1/255.0f);
+    auto to_U16 = [](F x) { return cast<U16>(min(max(0, x), 1) * 255.0f + 0.5f); };
+    r = to_U16(mad(R,m[0], mad(G,m[4], mad(B,m[ 8], mad(A,m[12], m[16])))));
+    g = to_U16(mad(R,m[1], mad(G,m[5], mad(B,m[ 9], mad(A,m[13], m[17])))));
+    b = to_U16(mad(R,m[2], mad(G,m[6], mad(B,m[10], mad(A,m[14], m[18])))));
+    a = to_U16(mad(R,m[3], mad(G,m[7], mad(B,m[11], mad(A,m[15], m[19])))));
+}
+
 STAGE_PP(uniform_color, const SkRasterPipeline_UniformColorCtx* c) {
     r = c->rgba[0];
     g = c->rgba[1];
@@ -2638,6 +3124,15 @@ STAGE_PP(premul_dst, Ctx::None) {
     dg = div255(dg * da);
     db = div255(db * da);
 }
+STAGE_PP(unpremul, Ctx::None) {
+    // Premul colors have r,g,b <= a, so this only overflows 255 by rounding.
+    F fa    = cast<F>(a),
+      scale = if_then_else(fa > 0, 255.0f / fa, 0);
+    auto unpremul = [&](U16 v) { return cast<U16>(min(cast<F>(v) * scale + 0.5f, 255.0f)); };
+    r = unpremul(r);
+    g = unpremul(g);
+    b = unpremul(b);
+}
 
 STAGE_PP(force_opaque    , Ctx::None) {  a = 255; }
 STAGE_PP(force_opaque_dst, Ctx::None) { da = 255; }
@@ -2747,7 +3242,7 @@ SI V load(const T* ptr, size_t tail) {
     V v = 0;
     switch (tail & (N-1)) {
         case  0: memcpy(&v, ptr, sizeof(v)); break;
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
         case 15: v[14] = ptr[14];
         case 14: v[13] = ptr[13];
         case 13: v[12] = ptr[12];
@@ -2771,7 +3266,7 @@ template <typename V, typename T>
 SI void store(T* ptr, size_t tail, V v) {
     switch (tail & (N-1)) {
         case  0: memcpy(ptr, &v, sizeof(v)); break;
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
         case 15: ptr[14] = v[14];
         case 14: ptr[13] = v[13];
         case 13: ptr[12] = v[12];
@@ -2791,7 +3286,7 @@ SI void store(T* ptr, size_t tail, V v) {
     }
 }
 
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
     template <typename V, typename T>
     SI V gather(const T* ptr, U32 ix) {
         return V{ ptr[ix[ 0]], ptr[ix[ 1]], ptr[ix[ 2]], ptr[ix[ 3]],
@@ -2829,7 +3324,7 @@ SI void store(T* ptr, size_t tail, V v) {
 // ~~~~~~ 32-bit memory loads and stores ~~~~~~ //
 
 SI void from_8888(U32 rgba, U16* r, U16* g, U16* b, U16* a) {
-#if 1 && defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if 1 && defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
     // Swap the middle 128-bit lanes to make _mm256_packus_epi32() in cast_U16() work out nicely.
     __m256i _01,_23;
     split(rgba, &_01, &_23);
@@ -3162,7 +3657,7 @@ SI void gradient_lookup(const SkRasterPipeline_GradientCtx* c, U32 idx, F t,
                         U16* r, U16* g, U16* b, U16* a) {
 
     F fr, fg, fb, fa, br, bg, bb, ba;
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
     if (c->stopCount <=8) {
         __m256i lo, hi;
         split(idx, &lo, &hi);
@@ -3258,6 +3753,94 @@ STAGE_GG(xy_to_radius, Ctx::None) {
     x = sqrt_(x*x + y*y);
 }
 
+// ~~~~~~ Fused bilinear 8888 sampling ~~~~~~ //
+
+SI F exclusive_repeat(F v, const SkRasterPipeline_TileCtx* ctx) {
+    return v - floor_(v*ctx->invScale)*ctx->scale;
+}
+SI F exclusive_mirror(F v, const SkRasterPipeline_TileCtx* ctx) {
+    auto limit = ctx->scale;
+    auto invLimit = ctx->invScale;
+    return abs_( (v-limit) - (limit+limit)*floor_((v-limit)*(invLimit*0.5f)) - limit );
+}
+
+SI F tile(F v, SkRasterPipeline_TiledGatherCtx::TileMode mode,
+          const SkRasterPipeline_TileCtx* ctx) {
+    switch (mode) {
+        case SkRasterPipeline_TiledGatherCtx::kClamp:  return v;
+        case SkRasterPipeline_TiledGatherCtx::kRepeat: return exclusive_repeat(v, ctx);
+        case SkRasterPipeline_TiledGatherCtx::kMirror: return exclusive_mirror(v, ctx);
+    }
+    return v;
+}
+
+// t is an 8.8 fixed point weight in [0,256], so the sum can't overflow 16 bits.
+SI U16 lerp_256(U16 from, U16 to, U16 t) {
+    return (from*(256-t) + to*t + 128) >> 8;
+}
+
+SI void gather_8888_at(const SkRasterPipeline_GatherCtx* ctx, F x, F y,
+                       U16* r, U16* g, U16* b, U16* a) {
+    const uint32_t* ptr;
+    U32 ix = ix_and_ptr(&ptr, ctx, x,y);
+    from_8888(gather<U32>(ptr, ix), r,g,b,a);
+}
+
+// Samples the same four pixels as the highp stages, lerping each row by fx and then the two rows
+// by fy.  tiling is nullptr for clamp-x, clamp-y.
+SI void bilerp_8888(const SkRasterPipeline_GatherCtx* ctx,
+                    const SkRasterPipeline_TiledGatherCtx* tiling,
+                    F cx, F cy, U16* r, U16* g, U16* b, U16* a) {
+    U16 wx = cast<U16>(fract(cx + 0.5f) * 256.0f + 0.5f),
+        wy = cast<U16>(fract(cy + 0.5f) * 256.0f + 0.5f);
+
+    F x0 = cx - 0.5f, x1 = cx + 0.5f,
+      y0 = cy - 0.5f, y1 = cy + 0.5f;
+    if (tiling) {
+        x0 = tile(x0, tiling->tileModeX, &tiling->tileX);
+        x1 = tile(x1, tiling->tileModeX, &tiling->tileX);
+        y0 = tile(y0, tiling->tileModeY, &tiling->tileY);
+        y1 = tile(y1, tiling->tileModeY, &tiling->tileY);
+    }
+
+    U16 lr,lg,lb,la, rr,rg,rb,ra;
+    gather_8888_at(ctx, x0,y0, &lr,&lg,&lb,&la);
+    gather_8888_at(ctx, x1,y0, &rr,&rg,&rb,&ra);
+    U16 tr = lerp_256(lr,rr, wx),
+        tg = lerp_256(lg,rg, wx),
+        tb = lerp_256(lb,rb, wx),
+        ta = lerp_256(la,ra, wx);
+
+    gather_8888_at(ctx, x0,y1, &lr,&lg,&lb,&la);
+    gather_8888_at(ctx, x1,y1, &rr,&rg,&rb,&ra);
+    *r = lerp_256(tr, lerp_256(lr,rr, wx), wy);
+    *g = lerp_256(tg, lerp_256(lg,rg, wx), wy);
+    *b = lerp_256(tb, lerp_256(lb,rb, wx), wy);
+    *a = lerp_256(ta, lerp_256(la,ra, wx), wy);
+}
+
+STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    bilerp_8888(ctx, nullptr, x,y, &r,&g,&b,&a);
+}
+STAGE_GP(bilerp_tiled_8888, const SkRasterPipeline_TiledGatherCtx* ctx) {
+    bilerp_8888(&ctx->gather, ctx, x,y, &r,&g,&b,&a);
+}
+
+STAGE_GP(gradient_lut_8888, const SkRasterPipeline_GradientLUTCtx* c) {
+    F fx = min(max(0, mad(x, c->scale, -0.5f)), c->limit);
+    U32 ix0 = trunc_(fx),
+        ix1 = trunc_(min(fx + 1, c->limit));
+    U16 t = cast<U16>(fract(fx) * 256.0f + 0.5f);
+
+    U16 lr,lg,lb,la, rr,rg,rb,ra;
+    from_8888(gather<U32>(c->lut, ix0), &lr,&lg,&lb,&la);
+    from_8888(gather<U32>(c->lut, ix1), &rr,&rg,&rb,&ra);
+    r = lerp_256(lr,rr, t);
+    g = lerp_256(lg,rg, t);
+    b = lerp_256(lb,rb, t);
+    a = lerp_256(la,ra, t);
+}
+
 // ~~~~~~ Compound stages ~~~~~~ //
 
 STAGE_PP(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
@@ -3271,6 +3854,18 @@ STAGE_PP(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
     store_8888_(ptr, tail, r,g,b,a);
 }
 
+// ~~~~~~ Fused stages, substituted for common stage sequences by SkRasterPipeline::fuse() ~~~~~~ //
+
+STAGE_PP(scale_u8_srcover_rgba_8888, const SkRasterPipeline_MaskedMemoryCtx* ctx) {
+    scale_u8_k         (ctx->mask, dx,dy,tail, 0,0, r,g,b,a, dr,dg,db,da);
+    srcover_rgba_8888_k(ctx->dst,  dx,dy,tail, 0,0, r,g,b,a, dr,dg,db,da);
+}
+
+STAGE_GG(seed_shader_matrix_2x3, const float* m) {
+    seed_shader_k(Ctx::None{}, dx,dy,tail, x,y, 0,0,0,0, 0,0,0,0);
+    matrix_2x3_k (m,           dx,dy,tail, x,y, 0,0,0,0, 0,0,0,0);
+}
+
 // Now we'll add null stand-ins for stages we haven't implemented in lowp.
 // If a pipeline uses these stages, it'll boot it out of lowp into highp.
 #define NOT_IMPLEMENTED(st) static void (*st)(void) = nullptr;
@@ -3279,7 +3874,6 @@ STAGE_PP(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
     NOT_IMPLEMENTED(store_rgba)
     NOT_IMPLEMENTED(unbounded_set_rgb)
     NOT_IMPLEMENTED(unbounded_uniform_color)
-    NOT_IMPLEMENTED(unpremul)
     NOT_IMPLEMENTED(dither)
     NOT_IMPLEMENTED(from_srgb)
     NOT_IMPLEMENTED(to_srgb)
@@ -3306,19 +3900,19 @@ STAGE_PP(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
     NOT_IMPLEMENTED(luminosity)
     NOT_IMPLEMENTED(matrix_3x3)
     NOT_IMPLEMENTED(matrix_3x4)
-    NOT_IMPLEMENTED(matrix_4x5)
     NOT_IMPLEMENTED(matrix_4x3)
     NOT_IMPLEMENTED(parametric)
     NOT_IMPLEMENTED(gamma)
+    NOT_IMPLEMENTED(xform_lut)
     NOT_IMPLEMENTED(rgb_to_hsl)
     NOT_IMPLEMENTED(hsl_to_rgb)
     NOT_IMPLEMENTED(gauss_a_to_rgba)
+    NOT_IMPLEMENTED(perlin_noise)
     NOT_IMPLEMENTED(mirror_x)
     NOT_IMPLEMENTED(repeat_x)
     NOT_IMPLEMENTED(mirror_y)
     NOT_IMPLEMENTED(repeat_y)
     NOT_IMPLEMENTED(negate_x)
-    NOT_IMPLEMENTED(bilerp_clamp_8888)
     NOT_IMPLEMENTED(bilinear_nx)
     NOT_IMPLEMENTED(bilinear_ny)
     NOT_IMPLEMENTED(bilinear_px)
@@ -3331,6 +3925,8 @@ STAGE_PP(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
     NOT_IMPLEMENTED(bicubic_n1y)
     NOT_IMPLEMENTED(bicubic_p1y)
     NOT_IMPLEMENTED(bicubic_p3y)
+    NOT_IMPLEMENTED(bicubic_8888)
+    NOT_IMPLEMENTED(bicubic_f16)
     NOT_IMPLEMENTED(save_xy)
     NOT_IMPLEMENTED(accumulate)
     NOT_IMPLEMENTED(xy_to_2pt_conical_well_behaved)
@@ -525,6 +525,40 @@ static void premul_should_swapRB(uint32_t* dst, const uint32_t* src, int count)
         *hi = _mm_unpackhi_epi16(rg, ba);                         // RGBARGBA RGBARGBA
     };
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    // With AVX-512 we premultiply 16 pixels at a time without going planar:
+    // each pixel's alpha is splatted across its own four 16-bit lanes.
+    auto premul16 = [](__m512i px) {
+        if (kSwapRB) {
+            px = _mm512_shuffle_epi8(px, _mm512_broadcast_i32x4(
+                     _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15)));
+        }
+
+        auto premul = [](__m512i v) {                             // r_g_b_a_ R_G_B_A_
+            // Splat alpha, but scale alpha itself by 255, leaving it unchanged.
+            __m512i a = _mm512_shufflehi_epi16(_mm512_shufflelo_epi16(v, 0xff), 0xff);
+            a = _mm512_mask_blend_epi16(0x88888888, a, _mm512_set1_epi16(255));
+
+            // (x+127)/255 == ((x+128)*257)>>16 for 0 <= x <= 255*255.
+            return _mm512_mulhi_epu16(_mm512_add_epi16(_mm512_mullo_epi16(v, a),
+                                                       _mm512_set1_epi16(128)),
+                                      _mm512_set1_epi16(257));
+        };
+
+        const __m512i zeros = _mm512_setzero_si512();
+        return _mm512_packus_epi16(premul(_mm512_unpacklo_epi8(px, zeros)),
+                                   premul(_mm512_unpackhi_epi8(px, zeros)));
+    };
+
+    while (count >= 16) {
+        _mm512_storeu_si512(dst, premul16(_mm512_loadu_si512(src)));
+
+        src += 16;
+        dst += 16;
+        count -= 16;
+    }
+#endif
+
     while (count >= 8) {
         __m128i lo = _mm_loadu_si128((const __m128i*) (src + 0)),
                 hi = _mm_loadu_si128((const __m128i*) (src + 4));
@@ -568,6 +602,18 @@ static void premul_should_swapRB(uint32_t* dst, const uint32_t* src, int count)
 /*not static*/ inline void RGBA_to_BGRA(uint32_t* dst, const uint32_t* src, int count) {
     const __m128i swapRB = _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15);
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    const __m512i swapRB16 = _mm512_broadcast_i32x4(swapRB);
+    while (count >= 16) {
+        __m512i rgba = _mm512_loadu_si512(src);
+        _mm512_storeu_si512(dst, _mm512_shuffle_epi8(rgba, swapRB16));
+
+        src += 16;
+        dst += 16;
+        count -= 16;
+    }
+#endif
+
     while (count >= 4) {
         __m128i rgba = _mm_loadu_si128((const __m128i*) src);
         __m128i bgra = _mm_shuffle_epi8(rgba, swapRB);
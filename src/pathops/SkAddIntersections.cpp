@@ -7,7 +7,11 @@
 #include "SkAddIntersections.h"
 #include "SkOpCoincidence.h"
 #include "SkPathOpsBounds.h"
+#include "SkTArray.h"
+#include "SkTSort.h"
 
+#include <algorithm>
+#include <memory>
 #include <utility>
 
 #if DEBUG_ADD_INTERSECTING_TS
@@ -256,6 +260,134 @@ static void debugShowCubicIntersection(int , const SkIntersectionHelper& ,
 }
 #endif
 
+// A bounding volume hierarchy over the segments of one contour. Comparing every segment of one
+// contour with every segment of another is quadratic, which dominates large inputs like map
+// outlines; the tree finds the segments whose bounds may intersect in logarithmic time instead.
+// Hits are returned in contour order, so intersections are added exactly as the linear walk
+// would add them.
+class SkOpSegmentTree {
+public:
+    // Contours with fewer segments than this are cheaper to walk than to build a tree for.
+    static constexpr int kMinSegments = 16;
+
+    explicit SkOpSegmentTree(SkOpContour* contour) {
+        int count = contour->count();
+        fSegments.reserve(count);
+        fLeaves.reserve(count);
+        SkOpSegment* segment = contour->first();
+        do {
+            fLeaves.push_back({segment->bounds(), fSegments.count()});
+            fSegments.push_back(segment);
+        } while ((segment = segment->next()));
+        fNodes.reserve(2 * count / kLeafSize + 1);
+        fNodes.push_back();
+        this->build(0, 0, fLeaves.count());
+    }
+
+    // Finds the segments numbered 'first' or later whose bounds intersect 'bounds', and points
+    // 'helper' at the first of them. Returns false if there are none.
+    bool search(const SkPathOpsBounds& bounds, int first, SkIntersectionHelper* helper) {
+        fHits.rewind();
+        int stack[64];
+        int depth = 0;
+        stack[depth++] = 0;
+        while (depth > 0) {
+            const Node& node = fNodes[stack[--depth]];
+            if (!SkPathOpsBounds::Intersects(bounds, node.fBounds)) {
+                continue;
+            }
+            if (node.fChild < 0) {
+                for (int index = node.fStart; index < node.fEnd; ++index) {
+                    const Leaf& leaf = fLeaves[index];
+                    if (leaf.fIndex >= first && SkPathOpsBounds::Intersects(bounds, leaf.fBounds)) {
+                        *fHits.append() = leaf.fIndex;
+                    }
+                }
+                continue;
+            }
+            SkASSERT(depth + 2 <= (int) SK_ARRAY_COUNT(stack));
+            stack[depth++] = node.fChild;
+            stack[depth++] = node.fChild + 1;
+        }
+        if (fHits.isEmpty()) {
+            return false;
+        }
+        SkTQSort(fHits.begin(), fHits.end() - 1);
+        fHit = 0;
+        helper->set(fSegments[fHits[0]]);
+        return true;
+    }
+
+    // Points 'helper' at the next segment found by search(). Returns false after the last one.
+    bool advance(SkIntersectionHelper* helper) {
+        if (++fHit >= fHits.count()) {
+            return false;
+        }
+        helper->set(fSegments[fHits[fHit]]);
+        return true;
+    }
+
+private:
+    static constexpr int kLeafSize = 4;
+
+    struct Leaf {
+        SkPathOpsBounds fBounds;
+        int fIndex;
+    };
+
+    struct Node {
+        SkPathOpsBounds fBounds;
+        int fStart;
+        int fEnd;
+        int fChild;  // the index of the first of two children, or -1 for a leaf
+    };
+
+    // Fills out fNodes[nodeIndex] to cover fLeaves[start..end), splitting it at the median of the
+    // wider axis until it holds at most kLeafSize leaves. Splitting at the median keeps the depth
+    // under log2(count), well within search()'s stack.
+    void build(int nodeIndex, int start, int end) {
+        // SkRect::join() skips the empty bounds of horizontal and vertical lines, so union by hand.
+        SkPathOpsBounds bounds = fLeaves[start].fBounds;
+        for (int index = start + 1; index < end; ++index) {
+            const SkPathOpsBounds& leaf = fLeaves[index].fBounds;
+            bounds.fLeft = SkTMin(bounds.fLeft, leaf.fLeft);
+            bounds.fTop = SkTMin(bounds.fTop, leaf.fTop);
+            bounds.fRight = SkTMax(bounds.fRight, leaf.fRight);
+            bounds.fBottom = SkTMax(bounds.fBottom, leaf.fBottom);
+        }
+        fNodes[nodeIndex] = {bounds, start, end, -1};
+        if (end - start <= kLeafSize) {
+            return;
+        }
+        int mid = start + (end - start) / 2;
+        if (bounds.width() >= bounds.height()) {
+            std::nth_element(&fLeaves[start], &fLeaves[mid], &fLeaves[end - 1] + 1,
+                    [](const Leaf& a, const Leaf& b) {
+                        return a.fBounds.fLeft + a.fBounds.fRight
+                                < b.fBounds.fLeft + b.fBounds.fRight;
+                    });
+        } else {
+            std::nth_element(&fLeaves[start], &fLeaves[mid], &fLeaves[end - 1] + 1,
+                    [](const Leaf& a, const Leaf& b) {
+                        return a.fBounds.fTop + a.fBounds.fBottom
+                                < b.fBounds.fTop + b.fBounds.fBottom;
+                    });
+        }
+        int child = fNodes.count();
+        fNodes[nodeIndex].fChild = child;
+        fNodes.push_back();
+        fNodes.push_back();
+        this->build(child, start, mid);
+        this->build(child + 1, mid, end);
+    }
+
+    SkTArray<SkOpSegment*, true> fSegments;
+    SkTArray<Leaf, true> fLeaves;
+    SkTArray<Node, true> fNodes;
+    SkTDArray<int> fHits;
+    int fHit = 0;
+};
+
 bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coincidence) {
     if (test != next) {
         if (AlmostLessUlps(test->bounds().fBottom, next->bounds().fTop)) {
@@ -266,14 +398,23 @@ bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coinc
             return true;
         }
     }
+    std::unique_ptr<SkOpSegmentTree> tree;
+    if (test->count() > 1 && next->count() >= SkOpSegmentTree::kMinSegments) {
+        tree.reset(new SkOpSegmentTree(next));
+    }
     SkIntersectionHelper wt;
     wt.init(test);
+    int testIndex = 0;
     do {
         SkIntersectionHelper wn;
         wn.init(next);
         test->debugValidate();
         next->debugValidate();
-        if (test == next && !wn.startAfter(wt)) {
+        if (tree) {
+            if (!tree->search(wt.bounds(), test == next ? testIndex + 1 : 0, &wn)) {
+                continue;
+            }
+        } else if (test == next && !wn.startAfter(wt)) {
             continue;
         }
         do {
@@ -573,7 +714,7 @@ bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coinc
                 coinIndex = -1;
             }
             SkOPOBJASSERT(coincidence, coinIndex < 0);  // expect coincidence to be paired
-        } while (wn.advance());
-    } while (wt.advance());
+        } while (tree ? tree->advance(&wn) : wn.advance());
+    } while (++testIndex, wt.advance());
     return true;
 }
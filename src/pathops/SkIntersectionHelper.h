@@ -59,6 +59,10 @@ public:
         return bounds().fRight;
     }
 
+    void set(SkOpSegment* segment) {
+        fSegment = segment;
+    }
+
     SkOpSegment* segment() const {
         return fSegment;
     }
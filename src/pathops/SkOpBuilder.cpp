@@ -120,6 +120,17 @@ void SkOpBuilder::reset() {
     fOps.reset();
 }
 
+static bool resolve_pairwise(const SkTArray<SkPath>& paths, const SkTDArray<SkPathOp>& ops,
+                             SkPath* result) {
+    *result = paths[0];
+    for (int index = 1; index < paths.count(); ++index) {
+        if (!Op(*result, paths[index], ops[index], result)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /* OPTIMIZATION: Union doesn't need to be all-or-nothing. A run of three or more convex
    paths with union ops could be locally resolved and still improve over doing the
    ops one at a time. */
@@ -146,48 +157,37 @@ bool SkOpBuilder::resolve(SkPath* result) {
             } else if (firstDir != dir) {
                 ReversePath(test);
             }
-            continue;
-        }
-        // If the path is not convex but its bounds do not intersect the others, simplify is enough.
-        const SkRect& testBounds = test->getBounds();
-        for (int inner = 0; inner < index; ++inner) {
-            // OPTIMIZE: check to see if the contour bounds do not intersect other contour bounds?
-            if (SkRect::Intersects(fPathRefs[inner].getBounds(), testBounds)) {
-                allUnion = false;
-                break;
-            }
         }
     }
     if (!allUnion) {
-        *result = fPathRefs[0];
-        for (int index = 1; index < count; ++index) {
-            if (!Op(*result, fPathRefs[index], fOps[index], result)) {
-                reset();
-                *result = original;
-                return false;
-            }
-        }
+        bool success = resolve_pairwise(fPathRefs, fOps, result);
         reset();
-        return true;
-    }
-    SkPath sum;
-    for (int index = 0; index < count; ++index) {
-        if (!Simplify(fPathRefs[index], &fPathRefs[index])) {
-            reset();
+        if (!success) {
             *result = original;
-            return false;
         }
-        if (!fPathRefs[index].isEmpty()) {
+        return success;
+    }
+    // Union all the paths in one pass, even if they overlap: once each is simplified and wound
+    // so every point is covered zero or once, a winding fill of their sum covers exactly their
+    // union. One Simplify() of the sum finds every intersection at once, instead of repeating
+    // the work of each earlier Op() for each later path.
+    bool success = true;
+    SkPath sum;
+    for (int index = 0; index < count && success; ++index) {
+        SkPath simplified;
+        success = Simplify(fPathRefs[index], &simplified);
+        if (success && !simplified.isEmpty()) {
             // convert the even odd result back to winding form before accumulating it
-            if (!FixWinding(&fPathRefs[index])) {
-                *result = original;
-                return false;
-            }
-            sum.addPath(fPathRefs[index]);
+            success = FixWinding(&simplified);
+            sum.addPath(simplified);
         }
     }
+    success = success && Simplify(sum, result);
+    if (!success) {
+        // Fall back to one union at a time, which copes with some paths that fail in one pass.
+        success = resolve_pairwise(fPathRefs, fOps, result);
+    }
     reset();
-    bool success = Simplify(sum, result);
     if (!success) {
         *result = original;
     }
@@ -84,20 +84,41 @@ bool SkGetJpegInfo(const void* data, size_t len,
                    SkEncodedOrigin* orientation) {
     static const uint16_t kSOI = 0xFFD8;
     static const uint16_t kAPP0 = 0xFFE0;
+    static const uint16_t kAPP1 = 0xFFE1;
+    static const uint16_t kAPP14 = 0xFFEE;
+    static const char kJfif[] = {'J', 'F', 'I', 'F', '\0'};
+    static const char kExif[] = {'E', 'x', 'i', 'f', '\0'};
+    static const char kAdobe[] = {'A', 'd', 'o', 'b', 'e'};
+    auto has_tag = [](JpegSegment* segment, const char* tag, size_t tagSize) {
+        SkASSERT(segment->data());
+        return SkToSizeT(segment->length()) >= tagSize &&
+               0 == memcmp(segment->data(), tag, tagSize);
+    };
     JpegSegment segment(data, len);
     if (!segment.read() || segment.marker() != kSOI) {
         return false;  // not a JPEG
     }
-    if (!segment.read() || segment.marker() != kAPP0) {
-        return false;  // not an APP0 segment
+    // JFIF files start with an APP0 segment, Adobe ones (often CMYK) with APP14.
+    if (!segment.read()) {
+        return false;
     }
-    static const char kJfif[] = {'J', 'F', 'I', 'F', '\0'};
-    SkASSERT(segment.data());
-    if (SkToSizeT(segment.length()) < sizeof(kJfif) ||
-        0 != memcmp(segment.data(), kJfif, sizeof(kJfif))) {
-        return false;  // Not JFIF JPEG
+    if (segment.marker() == kAPP0) {
+        if (!has_tag(&segment, kJfif, sizeof(kJfif))) {
+            return false;  // Not JFIF JPEG
+        }
+    } else if (segment.marker() != kAPP14 || !has_tag(&segment, kAdobe, sizeof(kAdobe))) {
+        return false;  // not an APP0 or Adobe APP14 segment
     }
+    // The Adobe segment's transform flag tells RGB from YCbCr and CMYK from YCCK.
+    int adobeTransform = -1;
     do {
+        if (segment.marker() == kAPP14 && has_tag(&segment, kAdobe, sizeof(kAdobe)) &&
+            segment.length() >= 12) {
+            adobeTransform = segment.data()[11];
+        }
+        if (segment.marker() == kAPP1 && has_tag(&segment, kExif, sizeof(kExif))) {
+            return false;  // Without a JPEG library we do not parse the EXIF orientation.
+        }
         if (!segment.read()) {
             return false;  // malformed JPEG
         }
@@ -109,16 +130,30 @@ bool SkGetJpegInfo(const void* data, size_t len,
         return false;  // Only support 8-bit precision
     }
     int numberOfComponents = segment.data()[5];
-    if (numberOfComponents != 1 && numberOfComponents != 3) {
-        return false;  // Invalid JFIF
+    SkEncodedInfo::Color color;
+    switch (numberOfComponents) {
+        case 1:
+            color = SkEncodedInfo::kGray_Color;
+            break;
+        case 3:
+            color = adobeTransform == 0 ? SkEncodedInfo::kRGB_Color : SkEncodedInfo::kYUV_Color;
+            break;
+        case 4:
+            if (adobeTransform < 0) {
+                return false;  // Invalid JFIF
+            }
+            color = adobeTransform == 2 ? SkEncodedInfo::kYCCK_Color
+                                        : SkEncodedInfo::kInvertedCMYK_Color;
+            break;
+        default:
+            return false;  // Invalid JFIF
     }
     if (size) {
         *size = {JpegSegment::GetBigendianUint16(&segment.data()[3]),
                  JpegSegment::GetBigendianUint16(&segment.data()[1])};
     }
     if (colorType) {
-        *colorType = numberOfComponents == 3 ? SkEncodedInfo::kYUV_Color
-                                             : SkEncodedInfo::kGray_Color;
+        *colorType = color;
     }
     if (orientation) {
         *orientation = kTopLeft_SkEncodedOrigin;
@@ -7,6 +7,7 @@
 
 #include "SkPDFBitmap.h"
 
+#include "SkCodec.h"
 #include "SkColorData.h"
 #include "SkData.h"
 #include "SkDeflate.h"
@@ -14,9 +15,11 @@
 #include "SkImage.h"
 #include "SkImageInfoPriv.h"
 #include "SkJpegInfo.h"
+#include "SkOpts.h"
 #include "SkPDFDocumentPriv.h"
 #include "SkPDFTypes.h"
 #include "SkPDFUtils.h"
+#include "SkResourceCache.h"
 #include "SkStream.h"
 #include "SkTo.h"
 
@@ -65,40 +68,83 @@ static SkColor get_neighbor_avg_color(const SkPixmap& bm, int xOrig, int yOrig)
                  : SK_ColorTRANSPARENT;
 }
 
-template <typename T>
+namespace {
+// The contents and description of an image XObject stream, ready to be written to a document.
+struct ImageStream {
+    sk_sp<SkData> fData;  // Filtered (and, with SK_PDF_BASE85_BINARY, base85-encoded) samples.
+    SkISize fSize = {0, 0};
+    const char* fColorSpace = "DeviceGray";
+    int fComponents = 1;
+    bool fIsJpeg = false;
+    bool fPngPredictor = false;  // Flate data holds PNG-filtered rows, as in a PNG's IDAT.
+    bool fInvertColors = false;  // Adobe CMYK JPEGs store inverted samples.
+    int fColorTransform = 0;     // DCTDecode's ColorTransform.
+};
+}  // namespace
+
+static sk_sp<SkData> finish_stream(SkDynamicMemoryWStream* buffer) {
+    #ifdef SK_PDF_BASE85_BINARY
+    SkPDFUtils::Base85Encode(buffer->detachAsStream(), buffer);
+    #endif
+    return buffer->detachAsData();
+}
+
 static void emit_image_stream(SkPDFDocument* doc,
                               SkPDFIndirectReference ref,
-                              T writeStream,
-                              SkISize size,
-                              const char* colorSpace,
-                              SkPDFIndirectReference sMask,
-                              int length,
-                              bool isJpeg) {
+                              const ImageStream& image,
+                              SkPDFIndirectReference sMask) {
     SkPDFDict pdfDict("XObject");
     pdfDict.insertName("Subtype", "Image");
-    pdfDict.insertInt("Width", size.width());
-    pdfDict.insertInt("Height", size.height());
-    pdfDict.insertName("ColorSpace", colorSpace);
+    pdfDict.insertInt("Width", image.fSize.width());
+    pdfDict.insertInt("Height", image.fSize.height());
+    pdfDict.insertName("ColorSpace", image.fColorSpace);
     if (sMask) {
         pdfDict.insertRef("SMask", sMask);
     }
     pdfDict.insertInt("BitsPerComponent", 8);
+    std::unique_ptr<SkPDFDict> decodeParms;
+    if (image.fPngPredictor) {
+        decodeParms = SkPDFMakeDict();
+        decodeParms->insertInt("Predictor", 15);
+        decodeParms->insertInt("Colors", image.fComponents);
+        decodeParms->insertInt("BitsPerComponent", 8);
+        decodeParms->insertInt("Columns", image.fSize.width());
+    }
     #ifdef SK_PDF_BASE85_BINARY
     auto filters = SkPDFMakeArray();
     filters->appendName("ASCII85Decode");
-    filters->appendName(isJpeg ? "DCTDecode" : "FlateDecode");
+    filters->appendName(image.fIsJpeg ? "DCTDecode" : "FlateDecode");
     pdfDict.insertObject("Filter", std::move(filters));
+    if (decodeParms) {
+        auto parms = SkPDFMakeArray();
+        parms->appendObject(SkPDFMakeDict());
+        parms->appendObject(std::move(decodeParms));
+        pdfDict.insertObject("DecodeParms", std::move(parms));
+    }
     #else
-    pdfDict.insertName("Filter", isJpeg ? "DCTDecode" : "FlateDecode");
+    pdfDict.insertName("Filter", image.fIsJpeg ? "DCTDecode" : "FlateDecode");
+    if (decodeParms) {
+        pdfDict.insertObject("DecodeParms", std::move(decodeParms));
+    }
     #endif
-    if (isJpeg) {
-        pdfDict.insertInt("ColorTransform", 0);
+    if (image.fInvertColors) {
+        auto decode = SkPDFMakeArray();
+        for (int i = 0; i < image.fComponents; ++i) {
+            decode->appendInt(1);
+            decode->appendInt(0);
+        }
+        pdfDict.insertObject("Decode", std::move(decode));
     }
-    pdfDict.insertInt("Length", length);
-    doc->emitStream(pdfDict, std::move(writeStream), ref);
+    if (image.fIsJpeg) {
+        pdfDict.insertInt("ColorTransform", image.fColorTransform);
+    }
+    pdfDict.insertInt("Length", SkToInt(image.fData->size()));
+    const SkData* data = image.fData.get();
+    doc->emitStream(pdfDict, [data](SkWStream* dst) { dst->write(data->data(), data->size()); },
+                    ref);
 }
 
-static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndirectReference ref) {
+static ImageStream deflate_alpha(const SkPixmap& pm) {
     SkDynamicMemoryWStream buffer;
     SkDeflateWStream deflateWStream(&buffer);
     if (kAlpha_8_SkColorType == pm.colorType()) {
@@ -125,37 +171,27 @@ static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndir
     }
     deflateWStream.finalize();
 
-    #ifdef SK_PDF_BASE85_BINARY
-    SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
-    #endif
-    int length = SkToInt(buffer.bytesWritten());
-    emit_image_stream(doc, ref, [&buffer](SkWStream* stream) { buffer.writeToAndReset(stream); },
-                      pm.info().dimensions(), "DeviceGray", SkPDFIndirectReference(),
-                      length, false);
+    ImageStream alpha;
+    alpha.fData = finish_stream(&buffer);
+    alpha.fSize = pm.info().dimensions();
+    return alpha;
 }
 
-static void do_deflated_image(const SkPixmap& pm,
-                              SkPDFDocument* doc,
-                              bool isOpaque,
-                              SkPDFIndirectReference ref) {
-    SkPDFIndirectReference sMask;
-    if (!isOpaque) {
-        sMask = doc->reserveRef();
-    }
+static ImageStream deflate_image(const SkPixmap& pm) {
     SkDynamicMemoryWStream buffer;
     SkDeflateWStream deflateWStream(&buffer);
-    const char* colorSpace = "DeviceGray";
+    ImageStream image;
     switch (pm.colorType()) {
         case kAlpha_8_SkColorType:
             fill_stream(&deflateWStream, '\x00', pm.width() * pm.height());
             break;
         case kGray_8_SkColorType:
-            SkASSERT(sMask.fValue = -1);
             SkASSERT(pm.rowBytes() == (size_t)pm.width());
             deflateWStream.write(pm.addr8(), pm.width() * pm.height());
             break;
         default:
-            colorSpace = "DeviceRGB";
+            image.fColorSpace = "DeviceRGB";
+            image.fComponents = 3;
             SkASSERT(pm.alphaType() == kUnpremul_SkAlphaType);
             SkASSERT(pm.colorType() == kBGRA_8888_SkColorType);
             SkASSERT(pm.rowBytes() == (size_t)pm.width() * 4);
@@ -182,19 +218,13 @@ static void do_deflated_image(const SkPixmap& pm,
             deflateWStream.write(byteBuffer, dst - byteBuffer);
     }
     deflateWStream.finalize();
-    #ifdef SK_PDF_BASE85_BINARY
-    SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
-    #endif
-    int length = SkToInt(buffer.bytesWritten());
-    emit_image_stream(doc, ref, [&buffer](SkWStream* stream) { buffer.writeToAndReset(stream); },
-                      pm.info().dimensions(), colorSpace, sMask, length, false);
-    if (!isOpaque) {
-        do_deflated_alpha(pm, doc, sMask);
-    }
+    image.fData = finish_stream(&buffer);
+    image.fSize = pm.info().dimensions();
+    return image;
 }
 
-static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
-                    SkPDFIndirectReference ref) {
+static bool jpeg_stream(sk_sp<SkData> data, SkISize size, ImageStream* out) {
+    ImageStream image;
     SkISize jpegSize;
     SkEncodedInfo::Color jpegColorType;
     SkEncodedOrigin exifOrientation;
@@ -202,23 +232,101 @@ static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
                        &jpegColorType, &exifOrientation)) {
         return false;
     }
-    bool yuv = jpegColorType == SkEncodedInfo::kYUV_Color;
-    bool goodColorType = yuv || jpegColorType == SkEncodedInfo::kGray_Color;
     if (jpegSize != size  // Sanity check.
-            || !goodColorType
             || kTopLeft_SkEncodedOrigin != exifOrientation) {
         return false;
     }
+    switch (jpegColorType) {
+        case SkEncodedInfo::kGray_Color:
+            break;
+        case SkEncodedInfo::kYUV_Color:
+            image.fColorSpace = "DeviceRGB";
+            image.fComponents = 3;
+            break;
+        // Like SkJpegCodec, treat four-channel JPEGs as the inverted CMYK Adobe apps write.
+        case SkEncodedInfo::kInvertedCMYK_Color:
+        case SkEncodedInfo::kYCCK_Color:
+            image.fColorSpace = "DeviceCMYK";
+            image.fComponents = 4;
+            image.fInvertColors = true;
+            image.fColorTransform = jpegColorType == SkEncodedInfo::kYCCK_Color ? 1 : 0;
+            break;
+        default:
+            return false;
+    }
     #ifdef SK_PDF_BASE85_BINARY
     SkDynamicMemoryWStream buffer;
     SkPDFUtils::Base85Encode(SkMemoryStream::MakeDirect(data->data(), data->size()), &buffer);
     data = buffer.detachAsData();
     #endif
+    image.fData = std::move(data);
+    image.fSize = jpegSize;
+    image.fIsJpeg = true;
+    *out = std::move(image);
+    return true;
+}
+
+static uint32_t png_uint32(const uint8_t* ptr) {
+    return (uint32_t)ptr[0] << 24 | (uint32_t)ptr[1] << 16 | (uint32_t)ptr[2] << 8 | ptr[3];
+}
 
-    emit_image_stream(doc, ref,
-                      [&data](SkWStream* dst) { dst->write(data->data(), data->size()); },
-                      jpegSize, yuv ? "DeviceRGB" : "DeviceGray",
-                      SkPDFIndirectReference(), SkToInt(data->size()), true);
+// FlateDecode with the PNG predictors reads a PNG's concatenated IDAT chunks as is, so 8-bit
+// gray or RGB PNGs without transparency or interlacing need no decoding.
+static bool png_stream(const SkData& data, SkISize size, ImageStream* out) {
+    static const uint8_t kSignature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    const uint8_t* ptr = data.bytes();
+    const uint8_t* end = ptr + data.size();
+    if (data.size() < sizeof(kSignature) || memcmp(ptr, kSignature, sizeof(kSignature))) {
+        return false;
+    }
+    ptr += sizeof(kSignature);
+    ImageStream image;
+    SkDynamicMemoryWStream idat;
+    bool sawHeader = false;
+    bool sawIDAT = false;
+    while (end - ptr >= 12) {
+        uint32_t length = png_uint32(ptr);
+        const uint8_t* type = ptr + 4;
+        const uint8_t* chunk = ptr + 8;
+        if (length > (size_t)(end - chunk) - 4) {
+            return false;  // Truncated.
+        }
+        ptr = chunk + length + 4;  // Skip the CRC too.
+        if (!sawHeader) {
+            // IHDR must come first.
+            if (memcmp(type, "IHDR", 4) || length != 13) {
+                return false;
+            }
+            int colorType = chunk[9];
+            if (png_uint32(chunk) != (uint32_t)size.width()
+                    || png_uint32(chunk + 4) != (uint32_t)size.height()
+                    || chunk[8] != 8                        // Bit depth.
+                    || (colorType != 0 && colorType != 2)   // Gray or RGB.
+                    || chunk[10] != 0 || chunk[11] != 0     // Deflate, adaptive filtering.
+                    || chunk[12] != 0) {                    // Not interlaced.
+                return false;
+            }
+            if (colorType == 2) {
+                image.fColorSpace = "DeviceRGB";
+                image.fComponents = 3;
+            }
+            sawHeader = true;
+        } else if (!memcmp(type, "tRNS", 4)) {
+            return false;  // Needs a soft mask.
+        } else if (!memcmp(type, "IDAT", 4)) {
+            idat.write(chunk, length);
+            sawIDAT = true;
+        } else if (!memcmp(type, "IEND", 4)) {
+            break;
+        }
+    }
+    if (!sawIDAT) {
+        return false;
+    }
+    image.fData = finish_stream(&idat);
+    image.fSize = size;
+    image.fPngPredictor = true;
+    *out = std::move(image);
     return true;
 }
 
@@ -245,6 +353,98 @@ static SkBitmap to_pixels(const SkImage* image) {
     return bm;
 }
 
+namespace {
+// Cross-document cache of the image streams that take work to make, keyed by the encoded data
+// when it describes the whole image, otherwise by the image's unique ID.
+static unsigned gImageStreamKeyNamespaceLabel;
+
+struct ImageStreamKey : public SkResourceCache::Key {
+public:
+    ImageStreamKey(const SkImage* img, const SkData* encoded, int encodingQuality)
+        : fID(encoded ? SkOpts::hash(encoded->data(), encoded->size()) : img->uniqueID())
+        , fEncodedSize(encoded ? SkToU32(encoded->size()) : 0)
+        , fWidth(img->width())
+        , fHeight(img->height())
+        , fEncodingQuality(encodingQuality) {
+        this->init(&gImageStreamKeyNamespaceLabel, 0,
+                   sizeof(fID) + sizeof(fEncodedSize) + sizeof(fWidth) + sizeof(fHeight) +
+                   sizeof(fEncodingQuality));
+    }
+
+    uint32_t fID;
+    uint32_t fEncodedSize;  // Zero when keyed by unique ID.
+    int32_t  fWidth;
+    int32_t  fHeight;
+    int32_t  fEncodingQuality;
+};
+
+struct ImageStreamRec : public SkResourceCache::Rec {
+    ImageStreamRec(const ImageStreamKey& key, sk_sp<SkData> encoded,
+                   const ImageStream& image, const ImageStream& alpha)
+        : fKey(key), fEncoded(std::move(encoded)), fImage(image), fAlpha(alpha) {}
+
+    ImageStreamKey fKey;
+    sk_sp<SkData>  fEncoded;
+    ImageStream    fImage;
+    ImageStream    fAlpha;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fImage.fData->size() + (fAlpha.fData ? fAlpha.fData->size() : 0);
+    }
+    const char* getCategory() const override { return "pdf-image-stream"; }
+
+    struct Query {
+        const SkData* fEncoded;
+        ImageStream*  fImage;
+        ImageStream*  fAlpha;
+    };
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const ImageStreamRec& rec = static_cast<const ImageStreamRec&>(baseRec);
+        Query* query = static_cast<Query*>(contextData);
+        if (query->fEncoded && !query->fEncoded->equals(rec.fEncoded.get())) {
+            return false;
+        }
+        *query->fImage = rec.fImage;
+        *query->fAlpha = rec.fAlpha;
+        return true;
+    }
+};
+}  // namespace
+
+// Subsets of lazy images share their parent's encoded data, so only key on it when it decodes
+// to exactly this image.
+static sk_sp<SkData> whole_image_encoded_data(const SkImage* img) {
+    sk_sp<SkData> data = img->refEncodedData();
+    if (data) {
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+        if (!codec || codec->dimensions() != img->dimensions()) {
+            data = nullptr;
+        }
+    }
+    return data;
+}
+
+static void make_image_streams(const SkImage* img,
+                               int encodingQuality,
+                               ImageStream* image,
+                               ImageStream* alpha) {
+    SkBitmap bm = to_pixels(img);
+    SkPixmap pm = bm.pixmap();
+    bool isOpaque = pm.isOpaque() || pm.computeIsOpaque();
+    if (encodingQuality <= 100 && isOpaque) {
+        sk_sp<SkData> data = img->encodeToData(SkEncodedImageFormat::kJPEG, encodingQuality);
+        if (data && jpeg_stream(std::move(data), img->dimensions(), image)) {
+            return;
+        }
+    }
+    *image = deflate_image(pm);
+    if (!isOpaque) {
+        *alpha = deflate_alpha(pm);
+    }
+}
+
 void serialize_image(const SkImage* img,
                      int encodingQuality,
                      SkPDFDocument* doc,
@@ -253,20 +453,31 @@ void serialize_image(const SkImage* img,
     SkASSERT(doc);
     SkASSERT(encodingQuality >= 0);
     SkISize dimensions = img->dimensions();
+    ImageStream image, alpha;
     sk_sp<SkData> data = img->refEncodedData();
-    if (data && do_jpeg(std::move(data), doc, dimensions, ref)) {
-        return;
-    }
-    SkBitmap bm = to_pixels(img);
-    SkPixmap pm = bm.pixmap();
-    bool isOpaque = pm.isOpaque() || pm.computeIsOpaque();
-    if (encodingQuality <= 100 && isOpaque) {
-        sk_sp<SkData> data = img->encodeToData(SkEncodedImageFormat::kJPEG, encodingQuality);
-        if (data && do_jpeg(std::move(data), doc, dimensions, ref)) {
-            return;
+    bool passthrough = data && (jpeg_stream(data, dimensions, &image) ||
+                                png_stream(*data, dimensions, &image));
+    if (!passthrough) {
+        if (doc->metadata().fCacheImageStreams) {
+            sk_sp<SkData> encoded = whole_image_encoded_data(img);
+            ImageStreamKey key(img, encoded.get(), encodingQuality);
+            ImageStreamRec::Query query{encoded.get(), &image, &alpha};
+            if (!SkResourceCache::Find(key, ImageStreamRec::Visitor, &query)) {
+                make_image_streams(img, encodingQuality, &image, &alpha);
+                SkResourceCache::Add(new ImageStreamRec(key, std::move(encoded), image, alpha));
+            }
+        } else {
+            make_image_streams(img, encodingQuality, &image, &alpha);
         }
     }
-    do_deflated_image(pm, doc, isOpaque, ref);
+    SkPDFIndirectReference sMask;
+    if (alpha.fData) {
+        sMask = doc->reserveRef();
+    }
+    emit_image_stream(doc, ref, image, sMask);
+    if (alpha.fData) {
+        emit_image_stream(doc, sMask, alpha, SkPDFIndirectReference());
+    }
 }
 
 SkPDFIndirectReference SkPDFSerializeImage(const SkImage* img,
@@ -113,18 +113,25 @@ static void serialize_footer(const SkPDFOffsetMap& offsetMap,
     wStream->writeText("\n%%EOF");
 }
 
+// The maximum number of children of a node in the page tree.
+static constexpr size_t kMaxPageTreeNodeSize = 8;
+
 static SkPDFIndirectReference generate_page_tree(
         SkPDFDocument* doc,
-        std::vector<std::unique_ptr<SkPDFDict>> pages,
+        std::unique_ptr<SkPDFDict> pendingPage,
+        const std::vector<SkPDFIndirectReference>& leafParents,
         const std::vector<SkPDFIndirectReference>& pageRefs) {
     // PDF wants a tree describing all the pages in the document.  We arbitrary
-    // choose 8 (kNodeSize) as the number of allowed children.  The internal
-    // nodes have type "Pages" with an array of children, a parent pointer, and
-    // the number of leaves below the node as "Count."  The leaves are passed
-    // into the method, have type "Page" and need a parent pointer. This method
-    // builds the tree bottom up, skipping internal nodes that would have only
-    // one child.
-    SkASSERT(pages.size() > 0);
+    // choose 8 (kMaxPageTreeNodeSize) as the number of allowed children.  The
+    // internal nodes have type "Pages" with an array of children, a parent
+    // pointer, and the number of leaves below the node as "Count."  The leaves
+    // have type "Page" and need a parent pointer.  This method builds the tree
+    // bottom up, skipping internal nodes that would have only one child.
+    //
+    // The leaves have already been emitted by onEndPage(), which reserved
+    // leafParents for each run of kMaxPageTreeNodeSize pages, except for
+    // pendingPage: a last page that starts a run of its own.
+    SkASSERT(pageRefs.size() > 0);
     struct PageTreeNode {
         std::unique_ptr<SkPDFDict> fNode;
         SkPDFIndirectReference fReservedRef;
@@ -132,10 +139,9 @@ static SkPDFIndirectReference generate_page_tree(
 
         static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
             std::vector<PageTreeNode> result;
-            static constexpr size_t kMaxNodeSize = 8;
             const size_t n = vec.size();
             SkASSERT(n >= 1);
-            const size_t result_len = (n - 1) / kMaxNodeSize + 1;
+            const size_t result_len = (n - 1) / kMaxPageTreeNodeSize + 1;
             SkASSERT(result_len >= 1);
             SkASSERT(n == 1 || result_len < n);
             result.reserve(result_len);
@@ -148,7 +154,7 @@ static SkPDFIndirectReference generate_page_tree(
                 SkPDFIndirectReference parent = doc->reserveRef();
                 auto kids_list = SkPDFMakeArray();
                 int descendantCount = 0;
-                for (size_t j = 0; j < kMaxNodeSize && index < n; ++j) {
+                for (size_t j = 0; j < kMaxPageTreeNodeSize && index < n; ++j) {
                     PageTreeNode& node = vec[index++];
                     node.fNode->insertRef("Parent", parent);
                     kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
@@ -163,12 +169,31 @@ static SkPDFIndirectReference generate_page_tree(
         }
     };
     std::vector<PageTreeNode> currentLayer;
-    currentLayer.reserve(pages.size());
-    SkASSERT(pages.size() == pageRefs.size());
-    for (size_t i = 0; i < pages.size(); ++i) {
-        currentLayer.push_back(PageTreeNode{std::move(pages[i]), pageRefs[i], 1});
+    const size_t pageCount = pageRefs.size();
+    if (pageCount == 1) {
+        // Even a lone page gets a "Pages" node above it, to be the root.
+        SkASSERT(pendingPage && leafParents.empty());
+        currentLayer.push_back(PageTreeNode{std::move(pendingPage), pageRefs[0], 1});
+        currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
+    } else {
+        currentLayer.reserve(leafParents.size() + 1);
+        for (size_t i = 0; i < leafParents.size(); ++i) {
+            const size_t first = i * kMaxPageTreeNodeSize;
+            const size_t end = SkTMin(first + kMaxPageTreeNodeSize, pageCount);
+            auto kids_list = SkPDFMakeArray();
+            for (size_t j = first; j < end; ++j) {
+                kids_list->appendRef(pageRefs[j]);
+            }
+            const int descendantCount = SkToInt(end - first);
+            auto node = SkPDFMakeDict("Pages");
+            node->insertInt("Count", descendantCount);
+            node->insertObject("Kids", std::move(kids_list));
+            currentLayer.push_back(PageTreeNode{std::move(node), leafParents[i], descendantCount});
+        }
+        if (pendingPage) {
+            currentLayer.push_back(PageTreeNode{std::move(pendingPage), pageRefs.back(), 1});
+        }
     }
-    currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
     while (currentLayer.size() > 1) {
         currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
     }
@@ -227,7 +252,7 @@ static SkSize operator*(SkSize u, SkScalar s) { return SkSize{u.width() * s, u.h
 
 SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         // if this is the first page if the document.
         {
             SkAutoMutexAcquire autoMutexAcquire(fMutex);
@@ -289,7 +314,23 @@ void SkPDFDocument::onEndPage() {
     // The StructParents unique identifier for each page is just its
     // 0-based page index.
     page->insertInt("StructParents", SkToInt(this->currentPageIndex()));
-    fPages.emplace_back(std::move(page));
+
+    const size_t pageIndex = fEndedPageCount++;
+    if (pageIndex % kMaxPageTreeNodeSize == 0) {
+        // This page starts a new run; hold it until we know if another page joins it.
+        SkASSERT(!fPendingPage);
+        fPendingPage = std::move(page);
+        return;
+    }
+    if (fPendingPage) {
+        SkASSERT(pageIndex % kMaxPageTreeNodeSize == 1);
+        fPageTreeLeafParents.push_back(this->reserveRef());
+        fPendingPage->insertRef("Parent", fPageTreeLeafParents.back());
+        this->emit(*fPendingPage, fPageRefs[pageIndex - 1]);
+        fPendingPage = nullptr;
+    }
+    page->insertRef("Parent", fPageTreeLeafParents.back());
+    this->emit(*page, fPageRefs[pageIndex]);
 }
 
 void SkPDFDocument::onAbort() {
@@ -453,7 +494,7 @@ static std::vector<const SkPDFFont*> get_fonts(const SkPDFDocument& canon) {
 
 void SkPDFDocument::onClose(SkWStream* stream) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         this->waitForJobs();
         return;
     }
@@ -466,7 +507,8 @@ void SkPDFDocument::onClose(SkWStream* stream) {
         docCatalog->insertObject("OutputIntents", make_srgb_output_intents(this));
     }
 
-    docCatalog->insertRef("Pages", generate_page_tree(this, std::move(fPages), fPageRefs));
+    docCatalog->insertRef("Pages", generate_page_tree(this, std::move(fPendingPage),
+                                                        fPageTreeLeafParents, fPageRefs));
 
     if (fDests.size() > 0) {
         docCatalog->insertRef("Dests", this->emit(fDests));
@@ -92,7 +92,7 @@ public:
     SkExecutor* executor() const { return fExecutor; }
     void incrementJobCount();
     void signalJobComplete();
-    size_t currentPageIndex() { return fPages.size(); }
+    size_t currentPageIndex() { return fEndedPageCount; }
     size_t pageCount() { return fPageRefs.size(); }
 
     // Canonicalized objects
@@ -114,8 +114,13 @@ public:
 private:
     SkPDFOffsetMap fOffsetMap;
     SkCanvas fCanvas;
-    std::vector<std::unique_ptr<SkPDFDict>> fPages;
     std::vector<SkPDFIndirectReference> fPageRefs;
+    // Pages are written out as soon as they end.  Each run of pages that shares a parent in
+    // the page tree gets that parent reserved when its second page ends; its first page is
+    // held here until then, since a lone last page is not given a parent of its own.
+    std::unique_ptr<SkPDFDict> fPendingPage;
+    std::vector<SkPDFIndirectReference> fPageTreeLeafParents;
+    size_t fEndedPageCount = 0;
     SkPDFDict fDests;
     sk_sp<SkPDFDevice> fPageDevice;
     std::atomic<int> fNextObjectNumber = {1};
@@ -8,6 +8,7 @@
 #include "SkPDFFont.h"
 
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkFont.h"
 #include "SkImagePriv.h"
 #include "SkMacros.h"
@@ -17,6 +18,7 @@
 #include "SkPDFConvertType1FontStream.h"
 #include "SkPDFDevice.h"
 #include "SkPDFDocumentPriv.h"
+#include "SkPDFFontCache.h"
 #include "SkPDFMakeCIDGlyphWidthsArray.h"
 #include "SkPDFMakeToUnicodeCmap.h"
 #include "SkPDFResourceDict.h"
@@ -117,9 +119,12 @@ const SkAdvancedTypefaceMetrics* SkPDFFont::GetMetrics(const SkTypeface* typefac
         canon->fTypefaceMetrics.set(id, nullptr);
         return nullptr;
     }
-    std::unique_ptr<SkAdvancedTypefaceMetrics> metrics = typeface->getAdvancedMetrics();
-    if (!metrics) {
-        metrics = skstd::make_unique<SkAdvancedTypefaceMetrics>();
+    auto metrics = skstd::make_unique<SkAdvancedTypefaceMetrics>();
+    if (SkPDFFontCache::FindMetrics(id, metrics.get())) {
+        return canon->fTypefaceMetrics.set(id, std::move(metrics))->get();
+    }
+    if (std::unique_ptr<SkAdvancedTypefaceMetrics> advanced = typeface->getAdvancedMetrics()) {
+        metrics = std::move(advanced);
     }
 
     if (0 == metrics->fStemV || 0 == metrics->fCapHeight) {
@@ -151,6 +156,7 @@ const SkAdvancedTypefaceMetrics* SkPDFFont::GetMetrics(const SkTypeface* typefac
             metrics->fCapHeight = SkToS16(SkScalarRoundToInt(capHeight / 2));
         }
     }
+    SkPDFFontCache::AddMetrics(id, *metrics);
     return canon->fTypefaceMetrics.set(id, std::move(metrics))->get();
 }
 
@@ -162,8 +168,12 @@ const std::vector<SkUnichar>& SkPDFFont::GetUnicodeMap(const SkTypeface* typefac
     if (std::vector<SkUnichar>* ptr = canon->fToUnicodeMap.find(id)) {
         return *ptr;
     }
-    std::vector<SkUnichar> buffer(typeface->countGlyphs());
-    typeface->getGlyphToUnicodeMap(buffer.data());
+    std::vector<SkUnichar> buffer;
+    if (!SkPDFFontCache::FindUnicodeMap(id, &buffer)) {
+        buffer.resize(typeface->countGlyphs());
+        typeface->getGlyphToUnicodeMap(buffer.data());
+        SkPDFFontCache::AddUnicodeMap(id, buffer);
+    }
     return *canon->fToUnicodeMap.set(id, std::move(buffer));
 }
 
@@ -283,8 +293,98 @@ static sk_sp<SkData> stream_to_data(std::unique_ptr<SkStreamAsset> stream) {
     }
     return SkData::MakeFromStream(stream.get(), size);
 }
+
+static void write_subset_font_file(std::unique_ptr<SkStreamAsset> fontAsset,
+                                   int ttcIndex,
+                                   const SkPDFGlyphUse& glyphUsage,
+                                   const char* fontName,
+                                   SkTypeface* face,
+                                   SkPDFDocument* doc,
+                                   SkPDFIndirectReference ref) {
+    SkDEBUGCODE(const size_t fontSize = fontAsset->getLength();)
+    // Documents tend to use the same glyphs of the same fonts over and over.
+    sk_sp<SkData> subsetFontData =
+            SkPDFFontCache::FindSubsetFont(face->uniqueID(), ttcIndex, glyphUsage);
+    if (!subsetFontData) {
+        subsetFontData = SkPDFSubsetFont(
+                stream_to_data(std::move(fontAsset)), glyphUsage, fontName, ttcIndex);
+        if (subsetFontData) {
+            SkPDFFontCache::AddSubsetFont(face->uniqueID(), ttcIndex, glyphUsage, subsetFontData);
+        }
+    }
+    std::unique_ptr<SkStreamAsset> fontFile;
+    if (subsetFontData) {
+        fontFile = SkMemoryStream::Make(std::move(subsetFontData));
+    } else {
+        // If subsetting fails, fall back to original font data.
+        fontFile.reset(face->openStream(&ttcIndex));
+        SkASSERT(fontFile);
+        SkASSERT(fontFile->getLength() == fontSize);
+        if (!fontFile) {
+            // ref has been handed out already, so it has to be written.
+            fontFile = skstd::make_unique<SkMemoryStream>();
+        }
+    }
+    std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
+    tmp->insertInt("Length1", fontFile->getLength());
+    SkPDFWriteStream(std::move(tmp), std::move(fontFile), doc, ref, true);
+}
+
+// Subsetting is the most expensive part of writing out a font, so like other
+// streams it is done on the document's executor if there is one.
+static SkPDFIndirectReference emit_subset_font_file(std::unique_ptr<SkStreamAsset> fontAsset,
+                                                    int ttcIndex,
+                                                    const SkPDFFont& font,
+                                                    const SkString& fontName,
+                                                    SkPDFDocument* doc) {
+    SkPDFIndirectReference ref = doc->reserveRef();
+    if (SkExecutor* executor = doc->executor()) {
+        SkStreamAsset* fontAssetPtr = fontAsset.release();
+        SkTypeface* face = SkRef(font.typeface());
+        const SkPDFGlyphUse* glyphUsage = &font.glyphUsage();
+        doc->incrementJobCount();
+        executor->add([=]() {
+            write_subset_font_file(std::unique_ptr<SkStreamAsset>(fontAssetPtr), ttcIndex,
+                                   *glyphUsage, fontName.c_str(), face, doc, ref);
+            face->unref();
+            doc->signalJobComplete();
+        });
+        return ref;
+    }
+    write_subset_font_file(std::move(fontAsset), ttcIndex, font.glyphUsage(), fontName.c_str(),
+                           font.typeface(), doc, ref);
+    return ref;
+}
 #endif  // SK_PDF_SUBSET_SUPPORTED
 
+// Returns advances in font units indexed by glyph ID, up to the last glyph used.  Only glyph 0
+// and the used glyphs are filled in; the rest are never read by SkPDFMakeCIDGlyphWidthsArray().
+static std::vector<int16_t> glyph_advances(SkTypeface* face, const SkPDFGlyphUse& glyphUsage,
+                                           int* emSize) {
+    // Match MakeVectorCache(), which is skipped on a cache hit.
+    *emSize = face->getUnitsPerEm() > 0 ? face->getUnitsPerEm() : 1024;
+    std::vector<int16_t> used;
+    if (!SkPDFFontCache::FindGlyphWidths(face->uniqueID(), glyphUsage, &used)) {
+        auto glyphCache = SkPDFFont::MakeVectorCache(face, emSize);
+        used.push_back((int16_t)glyphCache->getGlyphIDAdvance(0).fAdvanceX);
+        glyphUsage.getSetValues([&](unsigned gid) {
+            if (gid != 0) {
+                used.push_back((int16_t)glyphCache->getGlyphIDAdvance(gid).fAdvanceX);
+            }
+        });
+        SkPDFFontCache::AddGlyphWidths(face->uniqueID(), glyphUsage, used);
+    }
+    std::vector<int16_t> advances(1, used[0]);
+    size_t i = 1;
+    glyphUsage.getSetValues([&](unsigned gid) {
+        if (gid != 0) {
+            advances.resize(SkTMax<size_t>(advances.size(), gid + 1));
+            advances[gid] = used[i++];
+        }
+    });
+    return advances;
+}
+
 static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     const SkAdvancedTypefaceMetrics* metricsPtr =
         SkPDFFont::GetMetrics(font.typeface(), doc);
@@ -314,24 +414,10 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
                 if (!SkToBool(metrics.fFlags &
                               SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
                     SkASSERT(font.firstGlyphID() == 1);
-                    sk_sp<SkData> subsetFontData = SkPDFSubsetFont(
-                            stream_to_data(std::move(fontAsset)), font.glyphUsage(),
-                            metrics.fFontName.c_str(), ttcIndex);
-                    if (subsetFontData) {
-                        std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
-                        tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
-                        descriptor->insertRef(
-                                "FontFile2",
-                                SkPDFStreamOut(std::move(tmp),
-                                               SkMemoryStream::Make(std::move(subsetFontData)),
-                                               doc, true));
-                        break;
-                    }
-                    // If subsetting fails, fall back to original font data.
-                    fontAsset.reset(face->openStream(&ttcIndex));
-                    SkASSERT(fontAsset);
-                    SkASSERT(fontAsset->getLength() == fontSize);
-                    if (!fontAsset || fontAsset->getLength() == 0) { break; }
+                    descriptor->insertRef("FontFile2",
+                                          emit_subset_font_file(std::move(fontAsset), ttcIndex,
+                                                                font, metrics.fFontName, doc));
+                    break;
                 }
                 #endif  // SK_PDF_SUBSET_SUPPORTED
                 std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
@@ -378,9 +464,10 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     int16_t defaultWidth = 0;
     {
         int emSize;
-        auto glyphCache = SkPDFFont::MakeVectorCache(face, &emSize);
+        std::vector<int16_t> advances = glyph_advances(face, font.glyphUsage(), &emSize);
         std::unique_ptr<SkPDFArray> widths = SkPDFMakeCIDGlyphWidthsArray(
-                glyphCache.get(), &font.glyphUsage(), SkToS16(emSize), &defaultWidth);
+                advances.data(), SkToInt(advances.size()), &font.glyphUsage(),
+                SkToS16(emSize), &defaultWidth);
         if (widths && widths->size() > 0) {
             newCIDFont->insertObject("W", std::move(widths));
         }
@@ -398,16 +485,27 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     descendantFonts->appendRef(doc->emit(*newCIDFont));
     fontDict.insertObject("DescendantFonts", std::move(descendantFonts));
 
-    const std::vector<SkUnichar>& glyphToUnicode =
-        SkPDFFont::GetUnicodeMap(font.typeface(), doc);
-    SkASSERT(SkToSizeT(font.typeface()->countGlyphs()) == glyphToUnicode.size());
-    std::unique_ptr<SkStreamAsset> toUnicode =
-            SkPDFMakeToUnicodeCmap(glyphToUnicode.data(),
-                                   &font.glyphUsage(),
-                                   font.multiByteGlyphs(),
-                                   font.firstGlyphID(),
-                                   font.lastGlyphID());
-    fontDict.insertRef("ToUnicode", SkPDFStreamOut(nullptr, std::move(toUnicode), doc));
+    sk_sp<SkData> toUnicode = SkPDFFontCache::FindToUnicodeCmap(
+            face->uniqueID(), font.glyphUsage(), font.multiByteGlyphs(),
+            font.firstGlyphID(), font.lastGlyphID());
+    if (!toUnicode) {
+        const std::vector<SkUnichar>& glyphToUnicode =
+            SkPDFFont::GetUnicodeMap(font.typeface(), doc);
+        SkASSERT(SkToSizeT(font.typeface()->countGlyphs()) == glyphToUnicode.size());
+        std::unique_ptr<SkStreamAsset> cmap =
+                SkPDFMakeToUnicodeCmap(glyphToUnicode.data(),
+                                       &font.glyphUsage(),
+                                       font.multiByteGlyphs(),
+                                       font.firstGlyphID(),
+                                       font.lastGlyphID());
+        toUnicode = SkData::MakeFromStream(cmap.get(), cmap->getLength());
+        SkPDFFontCache::AddToUnicodeCmap(face->uniqueID(), font.glyphUsage(),
+                                         font.multiByteGlyphs(), font.firstGlyphID(),
+                                         font.lastGlyphID(), toUnicode);
+    }
+    fontDict.insertRef("ToUnicode", SkPDFStreamOut(nullptr,
+                                                   SkMemoryStream::Make(std::move(toUnicode)),
+                                                   doc));
 
     doc->emit(fontDict, font.indirectReference());
 }
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkPDFFontCache.h"
+
+#include "SkOpts.h"
+#include "SkResourceCache.h"
+#include "SkTo.h"
+
+namespace {
+static unsigned gMetricsKeyNamespaceLabel;
+static unsigned gUnicodeMapKeyNamespaceLabel;
+static unsigned gGlyphWidthsKeyNamespaceLabel;
+static unsigned gSubsetFontKeyNamespaceLabel;
+static unsigned gToUnicodeCmapKeyNamespaceLabel;
+
+static std::vector<SkGlyphID> glyph_list(const SkPDFGlyphUse* glyphUsage) {
+    std::vector<SkGlyphID> glyphs;
+    if (glyphUsage) {
+        glyphUsage->getSetValues([&glyphs](unsigned gid) { glyphs.push_back(SkToU16(gid)); });
+    }
+    return glyphs;
+}
+
+// Glyph sets can be large, so the key only holds their hash, and each rec keeps its glyphs to
+// tell apart sets that collide.
+struct FontKey : public SkResourceCache::Key {
+public:
+    FontKey(void* nameSpace, SkFontID fontID, const std::vector<SkGlyphID>& glyphs,
+            uint32_t extra = 0)
+        : fFontID(fontID)
+        , fExtra(extra)
+        , fGlyphCount(SkToU32(glyphs.size()))
+        , fGlyphHash(SkOpts::hash(glyphs.data(), glyphs.size() * sizeof(SkGlyphID)))
+    {
+        this->init(nameSpace, 0,
+                   sizeof(fFontID) + sizeof(fExtra) + sizeof(fGlyphCount) + sizeof(fGlyphHash));
+    }
+
+    SkFontID fFontID;
+    uint32_t fExtra;
+    uint32_t fGlyphCount;
+    uint32_t fGlyphHash;
+};
+
+template <typename T>
+struct FontRec : public SkResourceCache::Rec {
+    FontRec(const FontKey& key, std::vector<SkGlyphID> glyphs, T value, size_t valueBytes,
+            const char* category)
+        : fKey(key)
+        , fGlyphs(std::move(glyphs))
+        , fValue(std::move(value))
+        , fValueBytes(valueBytes)
+        , fCategory(category) {}
+
+    FontKey                 fKey;
+    std::vector<SkGlyphID>  fGlyphs;
+    T                       fValue;
+    size_t                  fValueBytes;
+    const char*             fCategory;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fGlyphs.size() * sizeof(SkGlyphID) + fValueBytes;
+    }
+    const char* getCategory() const override { return fCategory; }
+
+    struct Query {
+        const std::vector<SkGlyphID>& fGlyphs;
+        T*                            fResult;
+    };
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const FontRec& rec = static_cast<const FontRec&>(baseRec);
+        Query* query = static_cast<Query*>(contextData);
+        if (rec.fGlyphs != query->fGlyphs) {
+            return false;
+        }
+        *query->fResult = rec.fValue;
+        return true;
+    }
+};
+
+template <typename T>
+static bool find(void* nameSpace, SkFontID fontID, const SkPDFGlyphUse* glyphUsage,
+                 uint32_t extra, T* result) {
+    std::vector<SkGlyphID> glyphs = glyph_list(glyphUsage);
+    typename FontRec<T>::Query query{glyphs, result};
+    return SkResourceCache::Find(FontKey(nameSpace, fontID, glyphs, extra),
+                                 FontRec<T>::Visitor, &query);
+}
+
+template <typename T>
+static void add(void* nameSpace, SkFontID fontID, const SkPDFGlyphUse* glyphUsage,
+                uint32_t extra, T value, size_t valueBytes, const char* category) {
+    std::vector<SkGlyphID> glyphs = glyph_list(glyphUsage);
+    FontKey key(nameSpace, fontID, glyphs, extra);
+    SkResourceCache::Add(new FontRec<T>(key, std::move(glyphs), std::move(value), valueBytes,
+                                        category));
+}
+
+static uint32_t cmap_extra(bool multiByteGlyphs, SkGlyphID firstGlyphID, SkGlyphID lastGlyphID) {
+    // Glyph IDs only need 16 bits, so fold the flag into the top bit of the last one.
+    return ((uint32_t)firstGlyphID << 16) | lastGlyphID | (multiByteGlyphs ? 0x80000000 : 0);
+}
+}  // namespace
+
+bool SkPDFFontCache::FindMetrics(SkFontID fontID, SkAdvancedTypefaceMetrics* metrics) {
+    return find(&gMetricsKeyNamespaceLabel, fontID, nullptr, 0, metrics);
+}
+
+void SkPDFFontCache::AddMetrics(SkFontID fontID, const SkAdvancedTypefaceMetrics& metrics) {
+    size_t bytes = metrics.fPostScriptName.size() + metrics.fFontName.size();
+    add(&gMetricsKeyNamespaceLabel, fontID, nullptr, 0, metrics, bytes, "pdf-font-metrics");
+}
+
+bool SkPDFFontCache::FindUnicodeMap(SkFontID fontID, std::vector<SkUnichar>* map) {
+    return find(&gUnicodeMapKeyNamespaceLabel, fontID, nullptr, 0, map);
+}
+
+void SkPDFFontCache::AddUnicodeMap(SkFontID fontID, const std::vector<SkUnichar>& map) {
+    add(&gUnicodeMapKeyNamespaceLabel, fontID, nullptr, 0, map, map.size() * sizeof(SkUnichar),
+        "pdf-unicode-map");
+}
+
+bool SkPDFFontCache::FindGlyphWidths(SkFontID fontID, const SkPDFGlyphUse& glyphUsage,
+                                     std::vector<int16_t>* widths) {
+    return find(&gGlyphWidthsKeyNamespaceLabel, fontID, &glyphUsage, 0, widths);
+}
+
+void SkPDFFontCache::AddGlyphWidths(SkFontID fontID, const SkPDFGlyphUse& glyphUsage,
+                                    const std::vector<int16_t>& widths) {
+    add(&gGlyphWidthsKeyNamespaceLabel, fontID, &glyphUsage, 0, widths,
+        widths.size() * sizeof(int16_t), "pdf-glyph-widths");
+}
+
+sk_sp<SkData> SkPDFFontCache::FindSubsetFont(SkFontID fontID, int ttcIndex,
+                                             const SkPDFGlyphUse& glyphUsage) {
+    sk_sp<SkData> data;
+    find(&gSubsetFontKeyNamespaceLabel, fontID, &glyphUsage, SkToU32(ttcIndex), &data);
+    return data;
+}
+
+void SkPDFFontCache::AddSubsetFont(SkFontID fontID, int ttcIndex, const SkPDFGlyphUse& glyphUsage,
+                                   sk_sp<SkData> data) {
+    size_t bytes = data->size();
+    add(&gSubsetFontKeyNamespaceLabel, fontID, &glyphUsage, SkToU32(ttcIndex), std::move(data),
+        bytes, "pdf-subset-font");
+}
+
+sk_sp<SkData> SkPDFFontCache::FindToUnicodeCmap(SkFontID fontID, const SkPDFGlyphUse& glyphUsage,
+                                                bool multiByteGlyphs, SkGlyphID firstGlyphID,
+                                                SkGlyphID lastGlyphID) {
+    sk_sp<SkData> data;
+    find(&gToUnicodeCmapKeyNamespaceLabel, fontID, &glyphUsage,
+         cmap_extra(multiByteGlyphs, firstGlyphID, lastGlyphID), &data);
+    return data;
+}
+
+void SkPDFFontCache::AddToUnicodeCmap(SkFontID fontID, const SkPDFGlyphUse& glyphUsage,
+                                      bool multiByteGlyphs, SkGlyphID firstGlyphID,
+                                      SkGlyphID lastGlyphID, sk_sp<SkData> data) {
+    size_t bytes = data->size();
+    add(&gToUnicodeCmapKeyNamespaceLabel, fontID, &glyphUsage,
+        cmap_extra(multiByteGlyphs, firstGlyphID, lastGlyphID), std::move(data), bytes,
+        "pdf-tounicode-cmap");
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#ifndef SkPDFFontCache_DEFINED
+#define SkPDFFontCache_DEFINED
+
+#include "SkAdvancedTypefaceMetrics.h"
+#include "SkData.h"
+#include "SkPDFGlyphUse.h"
+#include "SkTypeface.h"
+
+#include <vector>
+
+/** \class SkPDFFontCache
+    Process-wide caches of what the PDF backend derives from a typeface, so that documents
+    using the same fonts share the work.  Entries live in the global SkResourceCache keyed by
+    SkTypeface::uniqueID(), plus the set of glyphs used for the data that depends on a subset.
+
+    Each Find() returns false (or nullptr) on a miss, and copies or refs the cached value on a
+    hit.
+*/
+class SkPDFFontCache {
+public:
+    static bool FindMetrics(SkFontID, SkAdvancedTypefaceMetrics*);
+    static void AddMetrics(SkFontID, const SkAdvancedTypefaceMetrics&);
+
+    /** The typeface's SkTypeface::getGlyphToUnicodeMap(). */
+    static bool FindUnicodeMap(SkFontID, std::vector<SkUnichar>*);
+    static void AddUnicodeMap(SkFontID, const std::vector<SkUnichar>&);
+
+    /** The advances, in font units, of glyph 0 followed by each glyph in the subset. */
+    static bool FindGlyphWidths(SkFontID, const SkPDFGlyphUse&, std::vector<int16_t>*);
+    static void AddGlyphWidths(SkFontID, const SkPDFGlyphUse&, const std::vector<int16_t>&);
+
+    /** The output of SkPDFSubsetFont(). */
+    static sk_sp<SkData> FindSubsetFont(SkFontID, int ttcIndex, const SkPDFGlyphUse&);
+    static void AddSubsetFont(SkFontID, int ttcIndex, const SkPDFGlyphUse&, sk_sp<SkData>);
+
+    /** The output of SkPDFMakeToUnicodeCmap(). */
+    static sk_sp<SkData> FindToUnicodeCmap(SkFontID, const SkPDFGlyphUse&, bool multiByteGlyphs,
+                                           SkGlyphID firstGlyphID, SkGlyphID lastGlyphID);
+    static void AddToUnicodeCmap(SkFontID, const SkPDFGlyphUse&, bool multiByteGlyphs,
+                                 SkGlyphID firstGlyphID, SkGlyphID lastGlyphID, sk_sp<SkData>);
+};
+
+#endif  // SkPDFFontCache_DEFINED
@@ -8,8 +8,6 @@
 #include "SkPDFMakeCIDGlyphWidthsArray.h"
 
 #include "SkPDFGlyphUse.h"
-#include "SkPaint.h"
-#include "SkStrike.h"
 #include "SkTo.h"
 
 #include <vector>
@@ -143,7 +141,8 @@ static void compose_advance_data(const AdvanceMetric& range,
 /** Retrieve advance data for glyphs. Used by the PDF backend. */
 // TODO(halcanary): this function is complex enough to need its logic
 // tested with unit tests.
-std::unique_ptr<SkPDFArray> SkPDFMakeCIDGlyphWidthsArray(SkStrike* cache,
+std::unique_ptr<SkPDFArray> SkPDFMakeCIDGlyphWidthsArray(const int16_t advances[],
+                                                         int glyphCount,
                                                          const SkPDFGlyphUse* subset,
                                                          uint16_t emSize,
                                                          int16_t* defaultAdvance) {
@@ -163,7 +162,6 @@ std::unique_ptr<SkPDFArray> SkPDFMakeCIDGlyphWidthsArray(SkStrike* cache,
     //  e. Removing 2 repeating advances is a win
 
     auto result = SkPDFMakeArray();
-    int num_glyphs = SkToInt(cache->getGlyphCount());
 
     bool prevRange = false;
 
@@ -173,7 +171,7 @@ std::unique_ptr<SkPDFArray> SkPDFMakeCIDGlyphWidthsArray(SkStrike* cache,
     int trailingWildCards = 0;
 
     // Limit the loop count to glyph id ranges provided.
-    int lastIndex = num_glyphs;
+    int lastIndex = glyphCount;
     if (subset) {
         while (!subset->has(lastIndex - 1) && lastIndex > 0) {
             --lastIndex;
@@ -185,7 +183,7 @@ std::unique_ptr<SkPDFArray> SkPDFMakeCIDGlyphWidthsArray(SkStrike* cache,
         int16_t advance = kInvalidAdvance;
         if (gId < lastIndex) {
             if (!subset || 0 == gId || subset->has(gId)) {
-                advance = (int16_t)cache->getGlyphIDAdvance(gId).fAdvanceX;
+                advance = advances[gId];
             } else {
                 advance = kDontCareAdvance;
             }
@@ -9,13 +9,16 @@
 
 #include "SkPDFTypes.h"
 
-class SkStrike;
 class SkPDFGlyphUse;
 
 /* PDF 32000-1:2008, page 270: "The array's elements have a variable
    format that can specify individual widths for consecutive CIDs or
-   one width for a range of CIDs". */
-std::unique_ptr<SkPDFArray> SkPDFMakeCIDGlyphWidthsArray(SkStrike* cache,
+   one width for a range of CIDs".
+
+   advances[] holds glyphCount advances in font units, indexed by glyph ID.
+   Only glyph 0 and the glyphs in subset (if any) are read. */
+std::unique_ptr<SkPDFArray> SkPDFMakeCIDGlyphWidthsArray(const int16_t advances[],
+                                                         int glyphCount,
                                                          const SkPDFGlyphUse* subset,
                                                          uint16_t emSize,
                                                          int16_t* defaultWidth);
@@ -484,3 +484,11 @@ SkPDFIndirectReference SkPDFStreamOut(std::unique_ptr<SkPDFDict> dict,
     serialize_stream(dict.get(), content.get(), deflate, doc, ref);
     return ref;
 }
+
+void SkPDFWriteStream(std::unique_ptr<SkPDFDict> dict,
+                      std::unique_ptr<SkStreamAsset> content,
+                      SkPDFDocument* doc,
+                      SkPDFIndirectReference ref,
+                      bool deflate) {
+    serialize_stream(dict.get(), content.get(), deflate, doc, ref);
+}
@@ -201,4 +201,12 @@ SkPDFIndirectReference SkPDFStreamOut(std::unique_ptr<SkPDFDict> dict,
                                       std::unique_ptr<SkStreamAsset> stream,
                                       SkPDFDocument* doc,
                                       bool deflate = kSkPDFDefaultDoDeflate);
+
+// Like SkPDFStreamOut(), but always on the calling thread, and into an already reserved ref.
+// For jobs that need to do more work on the executor before they have the stream to write.
+void SkPDFWriteStream(std::unique_ptr<SkPDFDict> dict,
+                      std::unique_ptr<SkStreamAsset> stream,
+                      SkPDFDocument* doc,
+                      SkPDFIndirectReference ref,
+                      bool deflate = kSkPDFDefaultDoDeflate);
 #endif
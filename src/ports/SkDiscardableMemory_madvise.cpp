@@ -0,0 +1,249 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkDiscardableMemory.h"
+#include "SkDiscardableMemoryPool.h"
+#include "SkMutex.h"
+#include "SkTInternalLList.h"
+#include "SkTemplates.h"
+#include "SkTypes.h"
+
+#include <atomic>
+#include <errno.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Each allocation gets its own anonymous pages.  While it is unlocked, the pages are marked
+// MADV_FREE, so the kernel can take them back under memory pressure without writing them out,
+// and a global budget purges the least recently used unlocked allocations on top of that.
+//
+// The kernel reclaims MADV_FREE pages one at a time, and a reclaimed page reads back as zeros.
+// To tell whether an allocation survived, unlock() moves the first word of every page aside and
+// stores a canary there.  lock() swaps each canary back with a compare-and-swap: the swap is a
+// write, so it either cancels the lazy free of a page that is still there, or finds the zeros
+// of a page that is not.
+
+namespace {
+
+constexpr uint64_t kCanary = 0xD15CA4DAB1E5EED5;
+
+class MadviseDiscardableMemory;
+
+class MadviseDiscardableMemoryPool : public SkDiscardableMemory::Factory {
+public:
+    explicit MadviseDiscardableMemoryPool(size_t budget);
+
+    SkDiscardableMemory* create(size_t bytes) override;
+
+private:
+    /** Frees unlocked memory, least recently used first, until fUsed <= budget. */
+    void dumpDownTo(size_t budget);
+    /** Unmaps dm's pages and forgets about them. */
+    void purge(MadviseDiscardableMemory* dm);
+
+    /** called by MadviseDiscardableMemory's destructor */
+    void removeFromPool(MadviseDiscardableMemory* dm);
+    /** called by MadviseDiscardableMemory::lock() */
+    bool lock(MadviseDiscardableMemory* dm);
+    /** called by MadviseDiscardableMemory::unlock() */
+    void unlock(MadviseDiscardableMemory* dm);
+
+    SkMutex      fMutex;
+    const size_t fPageSize;
+    const size_t fBudget;
+    size_t       fUsed;
+    bool         fUseMadvFree;  // Cleared if the kernel does not know MADV_FREE.
+    SkTInternalLList<MadviseDiscardableMemory> fList;
+
+    friend class MadviseDiscardableMemory;
+
+    typedef SkDiscardableMemory::Factory INHERITED;
+};
+
+class MadviseDiscardableMemory : public SkDiscardableMemory {
+public:
+    MadviseDiscardableMemory(sk_sp<MadviseDiscardableMemoryPool> pool, void* pages, size_t bytes,
+                             int pageCount);
+    ~MadviseDiscardableMemory() override;
+    bool lock() override;
+    void* data() override;
+    void unlock() override;
+    friend class MadviseDiscardableMemoryPool;
+private:
+    SK_DECLARE_INTERNAL_LLIST_INTERFACE(MadviseDiscardableMemory);
+    sk_sp<MadviseDiscardableMemoryPool> fPool;
+    bool                                fLocked;
+    bool                                fAdvised;     // Its pages are marked MADV_FREE.
+    void*                               fPages;       // nullptr once purged.
+    const size_t                        fBytes;       // A multiple of the page size.
+    const int                           fPageCount;
+    SkAutoTMalloc<uint64_t>             fSavedWords;  // The first word of each page.
+};
+
+MadviseDiscardableMemory::MadviseDiscardableMemory(sk_sp<MadviseDiscardableMemoryPool> pool,
+                                                   void* pages, size_t bytes, int pageCount)
+        : fPool(std::move(pool))
+        , fLocked(true)
+        , fAdvised(false)
+        , fPages(pages)
+        , fBytes(bytes)
+        , fPageCount(pageCount)
+        , fSavedWords(pageCount) {
+    SkASSERT(fPool != nullptr);
+    SkASSERT(fPages != nullptr);
+    SkASSERT(fBytes > 0);
+}
+
+MadviseDiscardableMemory::~MadviseDiscardableMemory() {
+    SkASSERT(!fLocked); // contract for SkDiscardableMemory
+    fPool->removeFromPool(this);
+}
+
+bool MadviseDiscardableMemory::lock() {
+    SkASSERT(!fLocked); // contract for SkDiscardableMemory
+    return fPool->lock(this);
+}
+
+void* MadviseDiscardableMemory::data() {
+    SkASSERT(fLocked); // contract for SkDiscardableMemory
+    return fPages;
+}
+
+void MadviseDiscardableMemory::unlock() {
+    SkASSERT(fLocked); // contract for SkDiscardableMemory
+    fPool->unlock(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MadviseDiscardableMemoryPool::MadviseDiscardableMemoryPool(size_t budget)
+    : fPageSize(sysconf(_SC_PAGESIZE))
+    , fBudget(budget)
+    , fUsed(0)
+#if defined(MADV_FREE)
+    , fUseMadvFree(true)
+#else
+    , fUseMadvFree(false)
+#endif
+{}
+
+SkDiscardableMemory* MadviseDiscardableMemoryPool::create(size_t bytes) {
+    const size_t pageCount = bytes / fPageSize + (0 != bytes % fPageSize);
+    if (0 == bytes || pageCount > SK_MaxS32) {
+        return nullptr;
+    }
+    const size_t size = pageCount * fPageSize;
+    void* pages = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == pages) {
+        return nullptr;
+    }
+    auto dm = new MadviseDiscardableMemory(sk_ref_sp(this), pages, size, (int)pageCount);
+    SkAutoMutexAcquire autoMutexAcquire(fMutex);
+    fList.addToHead(dm);
+    fUsed += size;
+    this->dumpDownTo(fBudget);
+    return dm;
+}
+
+void MadviseDiscardableMemoryPool::purge(MadviseDiscardableMemory* dm) {
+    fMutex.assertHeld();
+    SkASSERT(dm->fPages != nullptr);
+    munmap(dm->fPages, dm->fBytes);
+    dm->fPages = nullptr;
+    dm->fAdvised = false;
+    SkASSERT(fUsed >= dm->fBytes);
+    fUsed -= dm->fBytes;
+    // Purged DMs are taken out of the list.  Purged DMs are NOT deleted.
+    fList.remove(dm);
+}
+
+void MadviseDiscardableMemoryPool::dumpDownTo(size_t budget) {
+    fMutex.assertHeld();
+    using Iter = SkTInternalLList<MadviseDiscardableMemory>::Iter;
+    Iter iter;
+    MadviseDiscardableMemory* cur = iter.init(fList, Iter::kTail_IterStart);
+    while (fUsed > budget && cur) {
+        MadviseDiscardableMemory* dm = cur;
+        cur = iter.prev();
+        if (!dm->fLocked) {
+            this->purge(dm);
+        }
+    }
+}
+
+void MadviseDiscardableMemoryPool::removeFromPool(MadviseDiscardableMemory* dm) {
+    SkAutoMutexAcquire autoMutexAcquire(fMutex);
+    // This is called by dm's destructor.
+    if (dm->fPages != nullptr) {
+        this->purge(dm);
+    } else {
+        SkASSERT(!fList.isInList(dm));
+    }
+}
+
+bool MadviseDiscardableMemoryPool::lock(MadviseDiscardableMemory* dm) {
+    SkASSERT(dm != nullptr);
+    SkAutoMutexAcquire autoMutexAcquire(fMutex);
+    if (nullptr == dm->fPages) {
+        // Purged by the budget while unlocked.
+        return false;
+    }
+    if (dm->fAdvised) {
+        dm->fAdvised = false;
+        for (int i = 0; i < dm->fPageCount; i++) {
+            auto word = reinterpret_cast<std::atomic<uint64_t>*>(
+                    SkTAddOffset<void>(dm->fPages, i * fPageSize));
+            uint64_t expected = kCanary;
+            if (!word->compare_exchange_strong(expected, dm->fSavedWords[i])) {
+                // The kernel reclaimed this page.
+                this->purge(dm);
+                return false;
+            }
+        }
+    }
+    dm->fLocked = true;
+    fList.remove(dm);
+    fList.addToHead(dm);
+    return true;
+}
+
+void MadviseDiscardableMemoryPool::unlock(MadviseDiscardableMemory* dm) {
+    SkASSERT(dm != nullptr);
+    SkAutoMutexAcquire autoMutexAcquire(fMutex);
+    dm->fLocked = false;
+#if defined(MADV_FREE)
+    if (fUseMadvFree) {
+        for (int i = 0; i < dm->fPageCount; i++) {
+            auto word = static_cast<uint64_t*>(SkTAddOffset<void>(dm->fPages, i * fPageSize));
+            dm->fSavedWords[i] = *word;
+            *word = kCanary;
+        }
+        if (0 == madvise(dm->fPages, dm->fBytes, MADV_FREE)) {
+            dm->fAdvised = true;
+        } else {
+            if (EINVAL == errno) {
+                // Kernels before 4.5 do not support MADV_FREE; only the budget purges there.
+                fUseMadvFree = false;
+            }
+            for (int i = 0; i < dm->fPageCount; i++) {
+                auto word = static_cast<uint64_t*>(SkTAddOffset<void>(dm->fPages, i * fPageSize));
+                *word = dm->fSavedWords[i];
+            }
+        }
+    }
+#endif
+    this->dumpDownTo(fBudget);
+}
+
+}  // namespace
+
+SkDiscardableMemory* SkDiscardableMemory::Create(size_t bytes) {
+    // Intentionally leak this global pool.
+    static MadviseDiscardableMemoryPool* global =
+            new MadviseDiscardableMemoryPool(SK_DEFAULT_GLOBAL_DISCARDABLE_MEMORY_POOL_SIZE);
+    return global->create(bytes);
+}
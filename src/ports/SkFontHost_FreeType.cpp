@@ -289,6 +289,11 @@ struct SkFaceRec {
     // Manually keep track of when a named variation is requested for 2.6.1 until 2.7.1.
     bool fNamedVariationSpecified;
 
+    // FreeType allows different faces of one library to be used concurrently, as long as faces
+    // are only opened and closed under a lock (gFTMutex here). This guards everything else done
+    // with fFace and its sizes. When both are held, gFTMutex is locked first.
+    SkMutex fMutex;
+
     SkFaceRec(std::unique_ptr<SkStreamAsset> stream, uint32_t fontID);
 };
 
@@ -462,10 +467,14 @@ public:
         gFTMutex.acquire();
         SkASSERT_RELEASE(ref_ft_library());
         fFaceRec = ref_ft_face(tf);
+        if (fFaceRec) {
+            fFaceRec->fMutex.acquire();
+        }
     }
 
     ~AutoFTAccess() {
         if (fFaceRec) {
+            fFaceRec->fMutex.release();
             unref_ft_face(fFaceRec);
         }
         unref_ft_library();
@@ -502,6 +511,7 @@ protected:
     bool generateAdvance(SkGlyph* glyph) override;
     void generateMetrics(SkGlyph* glyph) override;
     void generateImage(const SkGlyph& glyph) override;
+    void generateImages(SkSpan<const SkGlyph*> glyphs) override;
     bool generatePath(SkGlyphID glyphID, SkPath* path) override;
     void generateFontMetrics(SkFontMetrics*) override;
 
@@ -509,7 +519,7 @@ private:
     using UnrefFTFace = SkFunctionWrapper<void, SkFaceRec, unref_ft_face>;
     std::unique_ptr<SkFaceRec, UnrefFTFace> fFaceRec;
 
-    FT_Face   fFace;  // Borrowed face from gFaceRecHead.
+    FT_Face   fFace;  // Borrowed face from gFaceRecHead, used under fFaceRec->fMutex.
     FT_Size   fFTSize;  // The size on the fFace for this scaler.
     FT_Int    fStrikeIndex;
 
@@ -528,12 +538,14 @@ private:
     bool      fLCDIsVert;
 
     FT_Error setupSize();
+    // Requires the face to be locked and set up by setupSize().
+    void generateImageLocked(const SkGlyph& glyph);
     void getBBoxForCurrentGlyph(const SkGlyph* glyph, FT_BBox* bbox,
                                 bool snapToPixelBoundary = false);
     bool getCBoxForLetter(char letter, FT_BBox* bbox);
-    // Caller must lock gFTMutex before calling this function.
+    // Caller must lock fFaceRec->fMutex before calling this function.
     void updateGlyphIfLCD(SkGlyph* glyph);
-    // Caller must lock gFTMutex before calling this function.
+    // Caller must lock fFaceRec->fMutex before calling this function.
     // update FreeType2 glyph slot with glyph emboldened
     void emboldenIfNeeded(FT_Face face, FT_GlyphSlot glyph, SkGlyphID gid);
     bool shouldSubpixelBitmap(const SkGlyph&, const SkMatrix&);
@@ -836,6 +848,7 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface> typeface,
         SkDEBUGF("Could not create FT_Face.\n");
         return;
     }
+    SkAutoMutexAcquire faceLock(fFaceRec->fMutex);
 
     fLCDIsVert = SkToBool(fRec.fFlags & SkScalerContext::kLCD_Vertical_Flag);
 
@@ -1004,6 +1017,7 @@ SkScalerContext_FreeType::~SkScalerContext_FreeType() {
     SkAutoMutexAcquire  ac(gFTMutex);
 
     if (fFTSize != nullptr) {
+        SkAutoMutexAcquire faceLock(fFaceRec->fMutex);
         FT_Done_Size(fFTSize);
     }
 
@@ -1016,7 +1030,7 @@ SkScalerContext_FreeType::~SkScalerContext_FreeType() {
     this face with other context (at different sizes).
 */
 FT_Error SkScalerContext_FreeType::setupSize() {
-    gFTMutex.assertHeld();
+    fFaceRec->fMutex.assertHeld();
     FT_Error err = FT_Activate_Size(fFTSize);
     if (err != 0) {
         return err;
@@ -1030,7 +1044,7 @@ unsigned SkScalerContext_FreeType::generateGlyphCount() {
 }
 
 uint16_t SkScalerContext_FreeType::generateCharToGlyph(SkUnichar uni) {
-    SkAutoMutexAcquire  ac(gFTMutex);
+    SkAutoMutexAcquire  ac(fFaceRec->fMutex);
     return SkToU16(FT_Get_Char_Index( fFace, uni ));
 }
 
@@ -1042,7 +1056,7 @@ bool SkScalerContext_FreeType::generateAdvance(SkGlyph* glyph) {
         return false;
     }
 
-    SkAutoMutexAcquire  ac(gFTMutex);
+    SkAutoMutexAcquire  ac(fFaceRec->fMutex);
 
     if (this->setupSize()) {
         glyph->zeroMetrics();
@@ -1147,7 +1161,7 @@ bool SkScalerContext_FreeType::shouldSubpixelBitmap(const SkGlyph& glyph, const
 }
 
 void SkScalerContext_FreeType::generateMetrics(SkGlyph* glyph) {
-    SkAutoMutexAcquire  ac(gFTMutex);
+    SkAutoMutexAcquire  ac(fFaceRec->fMutex);
 
     glyph->fMaskFormat = fRec.fMaskFormat;
 
@@ -1303,13 +1317,33 @@ static void clear_glyph_image(const SkGlyph& glyph) {
 }
 
 void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
-    SkAutoMutexAcquire  ac(gFTMutex);
+    SkAutoMutexAcquire  ac(fFaceRec->fMutex);
 
     if (this->setupSize()) {
         clear_glyph_image(glyph);
         return;
     }
 
+    this->generateImageLocked(glyph);
+}
+
+void SkScalerContext_FreeType::generateImages(SkSpan<const SkGlyph*> glyphs) {
+    // Lock and size the face once for the whole batch.
+    SkAutoMutexAcquire  ac(fFaceRec->fMutex);
+
+    if (this->setupSize()) {
+        for (const SkGlyph* glyph : glyphs) {
+            clear_glyph_image(*glyph);
+        }
+        return;
+    }
+
+    for (const SkGlyph* glyph : glyphs) {
+        this->generateImageLocked(*glyph);
+    }
+}
+
+void SkScalerContext_FreeType::generateImageLocked(const SkGlyph& glyph) {
     FT_Error err = FT_Load_Glyph(fFace, glyph.getGlyphID(), fLoadGlyphFlags);
     if (err != 0) {
         SK_TRACEFTR(err, "SkScalerContext_FreeType::generateImage: FT_Load_Glyph(glyph:%d "
@@ -1336,7 +1370,7 @@ void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
 bool SkScalerContext_FreeType::generatePath(SkGlyphID glyphID, SkPath* path) {
     SkASSERT(path);
 
-    SkAutoMutexAcquire  ac(gFTMutex);
+    SkAutoMutexAcquire  ac(fFaceRec->fMutex);
 
     // FT_IS_SCALABLE is documented to mean the face contains outline glyphs.
     if (!FT_IS_SCALABLE(fFace) || this->setupSize()) {
@@ -1377,7 +1411,7 @@ void SkScalerContext_FreeType::generateFontMetrics(SkFontMetrics* metrics) {
         return;
     }
 
-    SkAutoMutexAcquire ac(gFTMutex);
+    SkAutoMutexAcquire ac(fFaceRec->fMutex);
 
     if (this->setupSize()) {
         sk_bzero(metrics, sizeof(*metrics));
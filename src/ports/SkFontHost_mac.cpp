@@ -766,8 +766,11 @@ static sk_sp<SkTypeface> create_from_CTFontRef(SkUniqueCFRef<CTFontRef> font,
                                                bool isLocalStream) {
     SkASSERT(font);
 
+    // CFEqual() fonts have equal CFHash()es.
+    uint32_t hash = static_cast<uint32_t>(CFHash(font.get()));
     if (!isLocalStream) {
-        SkTypeface* face = SkTypefaceCache::FindByProcAndRef(find_by_CTFontRef, (void*)font.get());
+        SkTypeface* face = SkTypefaceCache::FindByProcAndRef(find_by_CTFontRef, (void*)font.get(),
+                                                             hash);
         if (face) {
             return sk_sp<SkTypeface>(face);
         }
@@ -781,7 +784,7 @@ static sk_sp<SkTypeface> create_from_CTFontRef(SkUniqueCFRef<CTFontRef> font,
     SkTypeface* face = new SkTypeface_Mac(std::move(font), std::move(resource),
                                           style, isFixedPitch, isLocalStream);
     if (!isLocalStream) {
-        SkTypefaceCache::Add(face);
+        SkTypefaceCache::Add(face, hash);
     }
     return sk_sp<SkTypeface>(face);
 }
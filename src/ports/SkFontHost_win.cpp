@@ -26,6 +26,7 @@
 #include "SkOTTable_name.h"
 #include "SkOTUtils.h"
 #include "SkOnce.h"
+#include "SkOpts.h"
 #include "SkPath.h"
 #include "SkSFNTHeader.h"
 #include "SkStream.h"
@@ -335,10 +336,11 @@ static bool FindByLogFont(SkTypeface* face, void* ctx) {
 SkTypeface* SkCreateTypefaceFromLOGFONT(const LOGFONT& origLF) {
     LOGFONT lf = origLF;
     make_canonical(&lf);
-    SkTypeface* face = SkTypefaceCache::FindByProcAndRef(FindByLogFont, &lf);
+    uint32_t hash = SkOpts::hash(&lf, sizeof(LOGFONT));
+    SkTypeface* face = SkTypefaceCache::FindByProcAndRef(FindByLogFont, &lf, hash);
     if (nullptr == face) {
         face = LogFontTypeface::Create(lf);
-        SkTypefaceCache::Add(face);
+        SkTypefaceCache::Add(face, hash);
     }
     return face;
 }
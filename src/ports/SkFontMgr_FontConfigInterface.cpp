@@ -13,6 +13,7 @@
 #include "SkFontStyle.h"
 #include "SkMakeUnique.h"
 #include "SkMutex.h"
+#include "SkOpts.h"
 #include "SkString.h"
 #include "SkTypeface.h"
 #include "SkTypefaceCache.h"
@@ -151,6 +152,11 @@ static bool find_by_FontIdentity(SkTypeface* cachedTypeface, void* ctx) {
     return cachedFCTypeface->getIdentity() == *identity;
 }
 
+static uint32_t hash_FontIdentity(const SkFontConfigInterface::FontIdentity& identity) {
+    uint32_t hash = SkOpts::hash(identity.fString.c_str(), identity.fString.size(), identity.fID);
+    return SkOpts::hash(&identity.fTTCIndex, sizeof(identity.fTTCIndex), hash);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 class SkFontMgr_FCI : public SkFontMgr {
@@ -206,11 +212,12 @@ protected:
         }
 
         // Check if a typeface with this FontIdentity is already in the FontIdentity cache.
-        SkTypeface* face = fTFCache.findByProcAndRef(find_by_FontIdentity, &identity);
+        uint32_t hash = hash_FontIdentity(identity);
+        SkTypeface* face = fTFCache.findByProcAndRef(find_by_FontIdentity, &identity, hash);
         if (!face) {
             face = SkTypeface_FCI::Create(fFCI, identity, std::move(outFamilyName), outStyle);
             // Add this FontIdentity to the FontIdentity cache.
-            fTFCache.add(face);
+            fTFCache.add(face, hash);
         }
         return face;
     }
@@ -315,11 +322,12 @@ protected:
         }
 
         // Check if a typeface with this FontIdentity is already in the FontIdentity cache.
-        face = fTFCache.findByProcAndRef(find_by_FontIdentity, &identity);
+        uint32_t hash = hash_FontIdentity(identity);
+        face = fTFCache.findByProcAndRef(find_by_FontIdentity, &identity, hash);
         if (!face) {
             face = SkTypeface_FCI::Create(fFCI, identity, std::move(outFamilyName), outStyle);
             // Add this FontIdentity to the FontIdentity cache.
-            fTFCache.add(face);
+            fTFCache.add(face, hash);
         }
         // Add this request to the request cache.
         fCache.add(face, request.release());
@@ -12,6 +12,7 @@
 #include "SkFontHost_FreeType_common.h"
 #include "SkFontMgr.h"
 #include "SkFontStyle.h"
+#include "SkLRUCache.h"
 #include "SkMakeUnique.h"
 #include "SkMath.h"
 #include "SkMutex.h"
@@ -687,26 +688,72 @@ class SkFontMgr_fontconfig : public SkFontMgr {
     SkTypeface* createTypefaceFromFcPattern(FcPattern* pattern) const {
         FCLocker::AssertHeld();
         SkAutoMutexAcquire ama(fTFCacheMutex);
-        SkTypeface* face = fTFCache.findByProcAndRef(FindByFcPattern, pattern);
+        // Equal patterns hash the same, so only typefaces with this hash need comparing.
+        uint32_t hash = FcPatternHash(pattern);
+        SkTypeface* face = fTFCache.findByProcAndRef(FindByFcPattern, pattern, hash);
         if (nullptr == face) {
             FcPatternReference(pattern);
             face = SkTypeface_fontconfig::Create(pattern);
             if (face) {
                 // Cannot hold the lock when calling add; an evicted typeface may need to lock.
                 FCLocker::Suspend suspend;
-                fTFCache.add(face);
+                fTFCache.add(face, hash);
             }
         }
         return face;
     }
 
+    /** Identifies a matchFamilyStyle or, if character is not kNoCharacter, a
+     *  matchFamilyStyleCharacter request.
+     */
+    static constexpr SkUnichar kNoCharacter = -1;
+    static SkString MatchKey(const char familyName[], const SkFontStyle& style,
+                             const char* bcp47[], int bcp47Count, SkUnichar character) {
+        SkString key;
+        key.appendf("%d,%d,%d,%d,", style.weight(), style.width(), style.slant(), character);
+        for (int i = 0; i < bcp47Count; ++i) {
+            key.appendf("%s,", bcp47[i]);
+        }
+        // The family goes last, since it may contain anything.
+        if (familyName) {
+            key.appendf("=%s", familyName);
+        }
+        return key;
+    }
+
+    /** Looks up or records the result of a match. Matches only depend on fFC, whose
+     *  configuration and fonts do not change while it is alive, so a recorded match holds for the
+     *  lifetime of the font manager. Returns true if key was found, with a ref in face.
+     */
+    bool findMatch(const SkString& key, SkTypeface** face) const {
+        SkAutoMutexAcquire ama(fMatchCacheMutex);
+        if (sk_sp<SkTypeface>* cached = fMatchCache.find(key)) {
+            *face = SkSafeRef(cached->get());
+            return true;
+        }
+        return false;
+    }
+    void addMatch(const SkString& key, SkTypeface* face) const {
+        // Not under FCLocker; an evicted typeface may need to lock.
+        SkAutoMutexAcquire ama(fMatchCacheMutex);
+        fMatchCache.insert(key, sk_ref_sp(face));
+    }
+
+    static constexpr int kMatchCacheCount = 256;
+    mutable SkMutex fMatchCacheMutex;
+    mutable SkLRUCache<SkString, sk_sp<SkTypeface>> fMatchCache;
+
 public:
     /** Takes control of the reference to 'config'. */
     explicit SkFontMgr_fontconfig(FcConfig* config)
         : fFC(config ? config : FcInitLoadConfigAndFonts())
-        , fFamilyNames(GetFamilyNames(fFC)) { }
+        , fFamilyNames(GetFamilyNames(fFC))
+        , fMatchCache(kMatchCacheCount) { }
 
     ~SkFontMgr_fontconfig() override {
+        // Release the matched typefaces first; they lock to unref their patterns.
+        fMatchCache.reset();
+
         // Hold the lock while unrefing the config.
         FCLocker lock;
         fFC.reset();
@@ -837,6 +884,32 @@ protected:
     virtual SkTypeface* onMatchFamilyStyle(const char familyName[],
                                            const SkFontStyle& style) const override
     {
+        SkString key = MatchKey(familyName, style, nullptr, 0, kNoCharacter);
+        SkTypeface* face;
+        if (!this->findMatch(key, &face)) {
+            face = this->fcMatchFamilyStyle(familyName, style);
+            this->addMatch(key, face);
+        }
+        return face;
+    }
+
+    virtual SkTypeface* onMatchFamilyStyleCharacter(const char familyName[],
+                                                    const SkFontStyle& style,
+                                                    const char* bcp47[],
+                                                    int bcp47Count,
+                                                    SkUnichar character) const override
+    {
+        SkString key = MatchKey(familyName, style, bcp47, bcp47Count, character);
+        SkTypeface* face;
+        if (!this->findMatch(key, &face)) {
+            face = this->fcMatchFamilyStyleCharacter(familyName, style, bcp47, bcp47Count,
+                                                     character);
+            this->addMatch(key, face);
+        }
+        return face;
+    }
+
+    SkTypeface* fcMatchFamilyStyle(const char familyName[], const SkFontStyle& style) const {
         FCLocker lock;
 
         SkAutoFcPattern pattern;
@@ -872,12 +945,11 @@ protected:
         return createTypefaceFromFcPattern(font);
     }
 
-    virtual SkTypeface* onMatchFamilyStyleCharacter(const char familyName[],
-                                                    const SkFontStyle& style,
-                                                    const char* bcp47[],
-                                                    int bcp47Count,
-                                                    SkUnichar character) const override
-    {
+    SkTypeface* fcMatchFamilyStyleCharacter(const char familyName[],
+                                            const SkFontStyle& style,
+                                            const char* bcp47[],
+                                            int bcp47Count,
+                                            SkUnichar character) const {
         FCLocker lock;
 
         SkAutoFcPattern pattern;
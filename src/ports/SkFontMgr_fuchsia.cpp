@@ -16,6 +16,7 @@
 #include "third_party/skia/src/core/SkFontDescriptor.h"
 #include "third_party/skia/src/ports/SkFontMgr_custom.h"
 
+#include "SkChecksum.h"
 #include "SkFontMgr.h"
 #include "SkStream.h"
 #include "SkTypeface.h"
@@ -398,14 +399,15 @@ sk_sp<SkTypeface> SkFontMgr_Fuchsia::GetOrCreateTypeface(TypefaceId id,
                                                          const fuchsia::mem::Buffer& buffer) const {
     SkAutoMutexAcquire mutexLock(fCacheMutex);
 
-    SkTypeface* cached = fTypefaceCache.findByProcAndRef(FindByTypefaceId, &id);
+    uint32_t hash = SkChecksum::Mix(id.bufferId) ^ id.ttcIndex;
+    SkTypeface* cached = fTypefaceCache.findByProcAndRef(FindByTypefaceId, &id, hash);
     if (cached) return sk_sp<SkTypeface>(cached);
 
     sk_sp<SkData> data = GetOrCreateSkData(id.bufferId, buffer);
     if (!data) return nullptr;
 
     auto result = CreateTypefaceFromSkData(std::move(data), id);
-    fTypefaceCache.add(result.get());
+    fTypefaceCache.add(result.get(), hash);
     return result;
 }
 
@@ -16,6 +16,7 @@
 #include "SkHRESULT.h"
 #include "SkMakeUnique.h"
 #include "SkMutex.h"
+#include "SkOpts.h"
 #include "SkStream.h"
 #include "SkTScopedComPtr.h"
 #include "SkTypeface.h"
@@ -454,17 +455,25 @@ static bool FindByDWriteFont(SkTypeface* cached, void* ctx) {
            wcscmp(cshFaceName.get(), ctxFaceName.get()) == 0;
 }
 
+// Fonts FindByDWriteFont() considers the same always have the same style.
+static uint32_t hash_DWriteFont_style(IDWriteFont* font) {
+    int style[] = { font->GetWeight(), font->GetStretch(), font->GetStyle(),
+                         font->GetSimulations() };
+    return SkOpts::hash(style, sizeof(style));
+}
+
 sk_sp<SkTypeface> SkFontMgr_DirectWrite::makeTypefaceFromDWriteFont(
         IDWriteFontFace* fontFace,
         IDWriteFont* font,
         IDWriteFontFamily* fontFamily) const {
     SkAutoMutexAcquire ama(fTFCacheMutex);
     ProtoDWriteTypeface spec = { fontFace, font, fontFamily };
-    SkTypeface* face = fTFCache.findByProcAndRef(FindByDWriteFont, &spec);
+    uint32_t hash = hash_DWriteFont_style(font);
+    SkTypeface* face = fTFCache.findByProcAndRef(FindByDWriteFont, &spec, hash);
     if (nullptr == face) {
         face = DWriteFontTypeface::Create(fFactory.get(), fontFace, font, fontFamily);
         if (face) {
-            fTFCache.add(face);
+            fTFCache.add(face, hash);
         }
     }
     return sk_sp<SkTypeface>(face);
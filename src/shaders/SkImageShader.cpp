@@ -267,7 +267,67 @@ sk_sp<SkShader> SkMakeBitmapShader(const SkBitmap& src, SkShader::TileMode tmx,
 
 void SkShaderBase::RegisterFlattenables() { SK_REGISTER_FLATTENABLE(SkImageShader); }
 
+// Holds the matrix read by the stages, in the layout of matrix_2x3 or matrix_perspective.
+class SkImageShader::StageUpdater final : public SkStageUpdater {
+public:
+    StageUpdater(const SkImageShader* shader, bool usePersp, bool nudgeTranslate)
+        : fShader(shader), fUsePersp(usePersp), fNudgeTranslate(nudgeTranslate) {}
+
+    bool update(const SkMatrix& ctm, const SkMatrix* localM) override {
+        SkMatrix matrix;
+        if (!fShader->computeTotalInverse(ctm, localM, &matrix)) {
+            return false;
+        }
+        if (fNudgeTranslate) {
+            NudgeTranslate(&matrix);
+        }
+        if (fUsePersp) {
+            matrix.get9(fMatrixStorage);
+        } else {
+            if (matrix.hasPerspective()) {
+                return false;
+            }
+            SkAssertResult(matrix.asAffine(fMatrixStorage));
+        }
+        return true;
+    }
+
+    // See skia:4649 and the GM image_scale_aligned.
+    static void NudgeTranslate(SkMatrix* matrix) {
+        if (matrix->getScaleX() >= 0) {
+            matrix->setTranslateX(nextafterf(matrix->getTranslateX(),
+                                             floorf(matrix->getTranslateX())));
+        }
+        if (matrix->getScaleY() >= 0) {
+            matrix->setTranslateY(nextafterf(matrix->getTranslateY(),
+                                             floorf(matrix->getTranslateY())));
+        }
+    }
+
+    const SkImageShader* fShader;
+    const bool           fUsePersp;
+    const bool           fNudgeTranslate;
+    float                fMatrixStorage[9];
+};
+
 bool SkImageShader::onAppendStages(const StageRec& rec) const {
+    return this->doStages(rec);
+}
+
+SkStageUpdater* SkImageShader::onAppendUpdatableStages(const StageRec& rec) const {
+    // Medium and high quality pick their mip level and filter from the matrix.
+    auto quality = rec.fPaint.getFilterQuality();
+    if (quality > kLow_SkFilterQuality) {
+        return nullptr;
+    }
+    bool usePersp = SkMatrix::Concat(rec.fCTM, *this->totalLocalMatrix(rec.fLocalM))
+                        .hasPerspective();
+    auto updater = rec.fAlloc->make<StageUpdater>(this, usePersp,
+                                                  quality == kNone_SkFilterQuality);
+    return this->doStages(rec, updater) ? updater : nullptr;
+}
+
+bool SkImageShader::doStages(const StageRec& rec, StageUpdater* updater) const {
     SkRasterPipeline* p = rec.fPipeline;
     SkArenaAlloc* alloc = rec.fAlloc;
 
@@ -289,27 +349,29 @@ bool SkImageShader::onAppendStages(const StageRec& rec) const {
     auto info = pm.info();
 
     // When the matrix is just an integer translate, bilerp == nearest neighbor.
-    if (quality == kLow_SkFilterQuality &&
+    // (We can't know that when the matrix may be updated.)
+    if (!updater &&
+        quality == kLow_SkFilterQuality &&
         matrix.getType() <= SkMatrix::kTranslate_Mask &&
         matrix.getTranslateX() == (int)matrix.getTranslateX() &&
         matrix.getTranslateY() == (int)matrix.getTranslateY()) {
         quality = kNone_SkFilterQuality;
     }
 
-    // See skia:4649 and the GM image_scale_aligned.
     if (quality == kNone_SkFilterQuality) {
-        if (matrix.getScaleX() >= 0) {
-            matrix.setTranslateX(nextafterf(matrix.getTranslateX(),
-                                            floorf(matrix.getTranslateX())));
-        }
-        if (matrix.getScaleY() >= 0) {
-            matrix.setTranslateY(nextafterf(matrix.getTranslateY(),
-                                            floorf(matrix.getTranslateY())));
-        }
+        StageUpdater::NudgeTranslate(&matrix);
     }
 
     p->append(SkRasterPipeline::seed_shader);
-    p->append_matrix(alloc, matrix);
+    if (updater) {
+        if (!updater->update(rec.fCTM, rec.fLocalM)) {
+            return false;
+        }
+        p->append(updater->fUsePersp ? SkRasterPipeline::matrix_perspective
+                                     : SkRasterPipeline::matrix_2x3, updater->fMatrixStorage);
+    } else {
+        p->append_matrix(alloc, matrix);
+    }
 
     auto gather = alloc->make<SkRasterPipeline_GatherCtx>();
     gather->pixels = pm.addr();
@@ -414,15 +476,44 @@ bool SkImageShader::onAppendStages(const StageRec& rec) const {
         return true;
     };
 
-    // We've got a fast path for 8888 bilinear clamp/clamp sampling.
+    // The fused samplers below tile each sample point themselves.
+    auto tiled_gather = [&] {
+        auto tile_mode = [](TileMode tm) {
+            switch (tm) {
+                case kRepeat_TileMode: return SkRasterPipeline_TiledGatherCtx::kRepeat;
+                case kMirror_TileMode: return SkRasterPipeline_TiledGatherCtx::kMirror;
+                default:               return SkRasterPipeline_TiledGatherCtx::kClamp;
+            }
+        };
+        auto ctx = alloc->make<SkRasterPipeline_TiledGatherCtx>();
+        ctx->gather    = *gather;
+        ctx->tileX     = *limit_x;
+        ctx->tileY     = *limit_y;
+        ctx->tileModeX = tile_mode(fTileModeX);
+        ctx->tileModeY = tile_mode(fTileModeY);
+        return ctx;
+    };
+
+    // We've got fast paths for 8888 bilinear sampling with any mix of clamp, repeat, and mirror,
+    // and for 8888 and F16 bicubic sampling likewise.
     auto ct = info.colorType();
+    bool is_8888 = ct == kRGBA_8888_SkColorType || ct == kBGRA_8888_SkColorType,
+         bilerp  = is_8888 && quality == kLow_SkFilterQuality,
+         bicubic = (is_8888 || ct == kRGBA_F16_SkColorType) && quality == kHigh_SkFilterQuality;
     if (true
-        && (ct == kRGBA_8888_SkColorType || ct == kBGRA_8888_SkColorType)
-        && quality == kLow_SkFilterQuality
-        && fTileModeX == SkShader::kClamp_TileMode
-        && fTileModeY == SkShader::kClamp_TileMode) {
-
-        p->append(SkRasterPipeline::bilerp_clamp_8888, gather);
+        && (bilerp || bicubic)
+        && fTileModeX != SkShader::kDecal_TileMode
+        && fTileModeY != SkShader::kDecal_TileMode) {
+
+        if (bicubic) {
+            p->append(is_8888 ? SkRasterPipeline::bicubic_8888
+                              : SkRasterPipeline::bicubic_f16, tiled_gather());
+        } else if (fTileModeX == SkShader::kClamp_TileMode &&
+                   fTileModeY == SkShader::kClamp_TileMode) {
+            p->append(SkRasterPipeline::bilerp_clamp_8888, gather);
+        } else {
+            p->append(SkRasterPipeline::bilerp_tiled_8888, tiled_gather());
+        }
         if (ct == kBGRA_8888_SkColorType) {
             p->append(SkRasterPipeline::swap_rb);
         }
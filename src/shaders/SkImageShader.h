@@ -43,6 +43,10 @@ private:
     SkImage* onIsAImage(SkMatrix*, SkShader::TileMode*) const override;
 
     bool onAppendStages(const StageRec&) const override;
+    SkStageUpdater* onAppendUpdatableStages(const StageRec&) const override;
+
+    class StageUpdater;
+    bool doStages(const StageRec&, StageUpdater* = nullptr) const;
 
     sk_sp<SkShader> onMakeColorSpace(SkColorSpaceXformer* xformer) const override {
         return xformer->apply(fImage.get())->makeShader(fTileModeX, fTileModeY,
@@ -10,7 +10,9 @@
 #include "SkArenaAlloc.h"
 #include "SkColorFilter.h"
 #include "SkMakeUnique.h"
+#include "SkRasterPipeline.h"
 #include "SkReadBuffer.h"
+#include "SkResourceCache.h"
 #include "SkShader.h"
 #include "SkString.h"
 #include "SkUnPreMultiply.h"
@@ -32,6 +34,8 @@ static const int kBlockSize = 256;
 static const int kBlockMask = kBlockSize - 1;
 static const int kPerlinNoise = 4096;
 static const int kRandMaximum = SK_MaxS32; // 2**31 - 1
+// Larger stitched tiles are evaluated per pixel rather than rendered and cached whole.
+static const int kMaxCachedTileArea = 512 * 512;
 
 static uint8_t improved_noise_permutations[] = {
     151, 160, 137,  91,  90,  15, 131,  13, 201,  95,  96,  53, 194, 233,   7, 225, 140,  36, 103,
@@ -98,17 +102,13 @@ public:
                      SkScalar baseFrequencyX, SkScalar baseFrequencyY,
                      const SkMatrix& matrix)
         {
-            SkVector tileVec;
-            matrix.mapVector(SkIntToScalar(tileSize.fWidth), SkIntToScalar(tileSize.fHeight),
-                             &tileVec);
-
             SkSize scale;
             if (!matrix.decomposeScale(&scale, nullptr)) {
                 scale.set(SK_ScalarNearlyZero, SK_ScalarNearlyZero);
             }
             fBaseFrequency.set(baseFrequencyX * SkScalarInvert(scale.width()),
                                baseFrequencyY * SkScalarInvert(scale.height()));
-            fTileSize.set(SkScalarRoundToInt(tileVec.fX), SkScalarRoundToInt(tileVec.fY));
+            fTileSize = DeviceTileSize(tileSize, matrix);
             this->init(seed);
             if (!fTileSize.isEmpty()) {
                 this->stitch();
@@ -166,6 +166,13 @@ public:
         }
     #endif
 
+        static SkISize DeviceTileSize(const SkISize& tileSize, const SkMatrix& matrix) {
+            SkVector tileVec;
+            matrix.mapVector(SkIntToScalar(tileSize.fWidth), SkIntToScalar(tileSize.fHeight),
+                             &tileVec);
+            return SkISize::Make(SkScalarRoundToInt(tileVec.fX), SkScalarRoundToInt(tileVec.fY));
+        }
+
         int         fSeed;
         uint8_t     fLatticeSelector[kBlockSize];
         uint16_t    fNoise[4][kBlockSize][2];
@@ -373,10 +380,15 @@ protected:
 #ifdef SK_ENABLE_LEGACY_SHADERCONTEXT
     Context* onMakeContext(const ContextRec&, SkArenaAlloc*) const override;
 #endif
+    bool onAppendStages(const StageRec&) const override;
 
 private:
     SK_FLATTENABLE_HOOKS(SkPerlinNoiseShaderImpl)
 
+    void appendNoiseStages(SkRasterPipeline*, SkArenaAlloc*, const PaintingData&,
+                           SkScalar offsetX, SkScalar offsetY) const;
+    void getTile(const SkMatrix&, const SkISize& deviceTileSize, SkBitmap*) const;
+
     const SkPerlinNoiseShaderImpl::Type fType;
     const SkScalar                  fBaseFrequencyX;
     const SkScalar                  fBaseFrequencyY;
@@ -654,6 +666,10 @@ SkPMColor SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::shade(
 #ifdef SK_ENABLE_LEGACY_SHADERCONTEXT
 SkShaderBase::Context* SkPerlinNoiseShaderImpl::onMakeContext(const ContextRec& rec,
                                                               SkArenaAlloc* alloc) const {
+    // Fractal noise and turbulence draw faster through onAppendStages().
+    if (kImprovedNoise_Type != fType) {
+        return nullptr;
+    }
     return alloc->make<PerlinNoiseShaderContext>(*this, rec);
 }
 #endif
@@ -691,6 +707,171 @@ void SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::shadeSpan(
     }
 }
 
+namespace {
+static unsigned gPerlinNoiseTileKeyNamespaceLabel;
+
+// Rendered tiles depend on the shader's parameters and the scale and skew of its matrix.
+struct PerlinNoiseTileKey : public SkResourceCache::Key {
+    PerlinNoiseTileKey(int type, SkScalar baseFrequencyX, SkScalar baseFrequencyY,
+                       int numOctaves, SkScalar seed, const SkISize& tileSize,
+                       const SkMatrix& matrix)
+        : fType(type)
+        , fBaseFrequencyX(baseFrequencyX)
+        , fBaseFrequencyY(baseFrequencyY)
+        , fNumOctaves(numOctaves)
+        , fSeed(seed)
+        , fTileWidth(tileSize.width())
+        , fTileHeight(tileSize.height())
+        , fScaleX(matrix.getScaleX())
+        , fSkewX(matrix.getSkewX())
+        , fSkewY(matrix.getSkewY())
+        , fScaleY(matrix.getScaleY()) {
+        this->init(&gPerlinNoiseTileKeyNamespaceLabel, 0,
+                   sizeof(*this) - sizeof(SkResourceCache::Key));
+    }
+
+    int32_t  fType;
+    SkScalar fBaseFrequencyX;
+    SkScalar fBaseFrequencyY;
+    int32_t  fNumOctaves;
+    SkScalar fSeed;
+    int32_t  fTileWidth;
+    int32_t  fTileHeight;
+    SkScalar fScaleX;
+    SkScalar fSkewX;
+    SkScalar fSkewY;
+    SkScalar fScaleY;
+};
+
+struct PerlinNoiseTileRec : public SkResourceCache::Rec {
+    PerlinNoiseTileRec(const PerlinNoiseTileKey& key, const SkBitmap& bitmap)
+        : fKey(key), fBitmap(bitmap) {}
+
+    PerlinNoiseTileKey fKey;
+    SkBitmap           fBitmap;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fBitmap.computeByteSize(); }
+    const char* getCategory() const override { return "perlin-noise-tile"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const PerlinNoiseTileRec& rec = static_cast<const PerlinNoiseTileRec&>(baseRec);
+        *static_cast<SkBitmap*>(contextData) = rec.fBitmap;
+        return true;
+    }
+};
+} // namespace
+
+void SkPerlinNoiseShaderImpl::appendNoiseStages(SkRasterPipeline* p, SkArenaAlloc* alloc,
+                                                const PaintingData& paintingData,
+                                                SkScalar offsetX, SkScalar offsetY) const {
+    SkASSERT(kImprovedNoise_Type != fType);
+
+    auto ctx = alloc->make<SkRasterPipeline_PerlinNoiseCtx>();
+    ctx->latticeSelector = paintingData.fLatticeSelector;
+    ctx->gradients = &paintingData.fGradient[0][0].fX;
+    ctx->stitch = nullptr;
+    if (fStitchTiles && !paintingData.fTileSize.isEmpty()) {
+        int* stitch = alloc->makeArrayDefault<int>(4 * fNumOctaves);
+        StitchData stitchData = paintingData.fStitchDataInit;
+        for (int octave = 0; octave < fNumOctaves; ++octave) {
+            stitch[4*octave + 0] = stitchData.fWrapX;
+            stitch[4*octave + 1] = stitchData.fWidth;
+            stitch[4*octave + 2] = stitchData.fWrapY;
+            stitch[4*octave + 3] = stitchData.fHeight;
+            stitchData = StitchData(SkIntToScalar(stitchData.fWidth)  * 2,
+                                    SkIntToScalar(stitchData.fHeight) * 2);
+        }
+        ctx->stitch = stitch;
+    }
+    ctx->offsetX = offsetX;
+    ctx->offsetY = offsetY;
+    ctx->baseFrequencyX = paintingData.fBaseFrequency.fX;
+    ctx->baseFrequencyY = paintingData.fBaseFrequency.fY;
+    ctx->numOctaves = fNumOctaves;
+    ctx->fractalNoise = kFractalNoise_Type == fType;
+
+    p->append(SkRasterPipeline::perlin_noise, ctx);
+    p->append(SkRasterPipeline::premul);
+}
+
+void SkPerlinNoiseShaderImpl::getTile(const SkMatrix& matrix, const SkISize& deviceTileSize,
+                                      SkBitmap* tile) const {
+    PerlinNoiseTileKey key(fType, fBaseFrequencyX, fBaseFrequencyY, fNumOctaves, fSeed,
+                           fTileSize, matrix);
+    if (SkResourceCache::Find(key, PerlinNoiseTileRec::Visitor, tile)) {
+        return;
+    }
+
+    tile->allocPixels(SkImageInfo::Make(deviceTileSize.width(), deviceTileSize.height(),
+                                        kRGBA_8888_SkColorType, kPremul_SkAlphaType));
+
+    // The tile's pixel (x,y) holds the noise at (x,y) on the noise's pixel grid.
+    SkSTArenaAlloc<1024> alloc;
+    const PaintingData* paintingData = alloc.make<PaintingData>(
+            fTileSize, fSeed, fBaseFrequencyX, fBaseFrequencyY, matrix);
+    SkRasterPipeline p(&alloc);
+    p.append(SkRasterPipeline::seed_shader);
+    this->appendNoiseStages(&p, &alloc, *paintingData, 0, 0);
+    SkRasterPipeline_MemoryCtx dst = { tile->getPixels(), (int)tile->rowBytesAsPixels() };
+    p.append(SkRasterPipeline::store_8888, &dst);
+    p.run(0, 0, deviceTileSize.width(), deviceTileSize.height());
+
+    tile->setImmutable();
+    SkResourceCache::Add(new PerlinNoiseTileRec(key, *tile));
+}
+
+bool SkPerlinNoiseShaderImpl::onAppendStages(const StageRec& rec) const {
+    if (kImprovedNoise_Type == fType) {
+        return this->INHERITED::onAppendStages(rec);
+    }
+
+    SkMatrix matrix = SkMatrix::Concat(rec.fCTM, this->getLocalMatrix());
+    if (rec.fLocalM) {
+        matrix.preConcat(*rec.fLocalM);
+    }
+    // The same (1,1) translation as PerlinNoiseShaderContext, for WebKit's 1 based coordinates.
+    SkScalar offsetX = -matrix.getTranslateX() + SK_Scalar1,
+             offsetY = -matrix.getTranslateY() + SK_Scalar1;
+
+    SkRasterPipeline* p = rec.fPipeline;
+    p->append(SkRasterPipeline::seed_shader);
+
+    // Stitched noise repeats with its tile, so repeated draws can sample one cached rendering.
+    SkISize deviceTileSize = PaintingData::DeviceTileSize(fTileSize, matrix);
+    if (fStitchTiles && !deviceTileSize.isEmpty() &&
+        (int64_t)deviceTileSize.width() * deviceTileSize.height() <= kMaxCachedTileArea) {
+        struct TileCtx {
+            SkBitmap                   tile;
+            float                      offset[2];
+            SkRasterPipeline_TileCtx   repeatX, repeatY;
+            SkRasterPipeline_GatherCtx gather;
+        };
+        auto ctx = rec.fAlloc->make<TileCtx>();
+        this->getTile(matrix, deviceTileSize, &ctx->tile);
+        ctx->offset[0] = offsetX;
+        ctx->offset[1] = offsetY;
+        ctx->repeatX = { (float)ctx->tile.width(),  1.0f / ctx->tile.width()  };
+        ctx->repeatY = { (float)ctx->tile.height(), 1.0f / ctx->tile.height() };
+        ctx->gather.pixels = ctx->tile.getPixels();
+        ctx->gather.stride = (int)ctx->tile.rowBytesAsPixels();
+        ctx->gather.width  = (float)ctx->tile.width();
+        ctx->gather.height = (float)ctx->tile.height();
+
+        p->append(SkRasterPipeline::matrix_translate, ctx->offset);
+        p->append(SkRasterPipeline::repeat_x, &ctx->repeatX);
+        p->append(SkRasterPipeline::repeat_y, &ctx->repeatY);
+        p->append(SkRasterPipeline::gather_8888, &ctx->gather);
+        return true;
+    }
+
+    const PaintingData* paintingData = rec.fAlloc->make<PaintingData>(
+            fTileSize, fSeed, fBaseFrequencyX, fBaseFrequencyY, matrix);
+    this->appendNoiseStages(p, rec.fAlloc, *paintingData, offsetX, offsetY);
+    return true;
+}
+
 /////////////////////////////////////////////////////////////////////
 
 #if SK_SUPPORT_GPU
@@ -94,6 +94,71 @@ struct BitmapShaderRec : public SkResourceCache::Rec {
     }
 };
 
+static unsigned gPictureTileKeyNamespaceLabel;
+
+// One cell of the grid a huge picture tile is cut into for SkPictureShader::refTiledBitmapShader().
+// Keyed by picture rather than shader, so shaders of the same picture and tile share cells.
+struct PictureTileKey : public SkResourceCache::Key {
+public:
+    PictureTileKey(SkColorSpace* colorSpace,
+                   SkImage::BitDepth bitDepth,
+                   uint32_t pictureID,
+                   const SkRect& tile,
+                   const SkSize& scale,
+                   int x, int y)
+        : fColorSpaceXYZHash(colorSpace->toXYZD50Hash())
+        , fColorSpaceTransferFnHash(colorSpace->transferFnHash())
+        , fBitDepth(bitDepth)
+        , fTile(tile)
+        , fScale(scale)
+        , fX(x)
+        , fY(y) {
+
+        static const size_t keySize = sizeof(fColorSpaceXYZHash) +
+                                      sizeof(fColorSpaceTransferFnHash) +
+                                      sizeof(fBitDepth) +
+                                      sizeof(fTile) +
+                                      sizeof(fScale) +
+                                      sizeof(fX) +
+                                      sizeof(fY);
+        // This better be packed.
+        SkASSERT(sizeof(uint32_t) * (&fEndOfStruct - &fColorSpaceXYZHash) == keySize);
+        uint64_t sharedID = SkSetFourByteTag('p', 't', 'i', 'l');
+        this->init(&gPictureTileKeyNamespaceLabel, (sharedID << 32) | pictureID, keySize);
+    }
+
+private:
+    uint32_t                   fColorSpaceXYZHash;
+    uint32_t                   fColorSpaceTransferFnHash;
+    SkImage::BitDepth          fBitDepth;
+    SkRect                     fTile;
+    SkSize                     fScale;
+    int32_t                    fX, fY;
+
+    SkDEBUGCODE(uint32_t fEndOfStruct;)
+};
+
+struct PictureTileRec : public SkResourceCache::Rec {
+    PictureTileRec(const PictureTileKey& key, const SkBitmap& bitmap)
+        : fKey(key)
+        , fBitmap(bitmap) {}
+
+    PictureTileKey fKey;
+    SkBitmap       fBitmap;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(fKey) + fBitmap.computeByteSize(); }
+    const char* getCategory() const override { return "picture-tile"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextBitmap) {
+        const PictureTileRec& rec = static_cast<const PictureTileRec&>(baseRec);
+        // Sharing the pixel ref keeps the pixels alive should the rec be purged.
+        *reinterpret_cast<SkBitmap*>(contextBitmap) = rec.fBitmap;
+        return true;
+    }
+};
+
 uint32_t next_id() {
     static std::atomic<uint32_t> nextID{1};
 
@@ -160,13 +225,17 @@ void SkPictureShader::flatten(SkWriteBuffer& buffer) const {
     SkPicturePriv::Flatten(fPicture, buffer);
 }
 
+// The most pixels we rasterize for one picture tile, about 4M.
+static const SkScalar kMaxTileArea = 2048 * 2048;
+
 // Returns a cached image shader, which wraps a single picture tile at the given
 // CTM/local matrix.  Also adjusts the local matrix for tile scaling.
 sk_sp<SkShader> SkPictureShader::refBitmapShader(const SkMatrix& viewMatrix,
                                                  SkTCopyOnFirstWrite<SkMatrix>* localMatrix,
                                                  SkColorType dstColorType,
                                                  SkColorSpace* dstColorSpace,
-                                                 const int maxTextureSize) const {
+                                                 const int maxTextureSize,
+                                                 const SkIRect* dstBounds) const {
     SkASSERT(fPicture && !fPicture->cullRect().isEmpty());
 
     const SkMatrix m = SkMatrix::Concat(viewMatrix, **localMatrix);
@@ -184,8 +253,30 @@ sk_sp<SkShader> SkPictureShader::refBitmapShader(const SkMatrix& viewMatrix,
     SkSize scaledSize = SkSize::Make(SkScalarAbs(scale.x() * fTile.width()),
                                      SkScalarAbs(scale.y() * fTile.height()));
 
+    // |fColorSpace| will only be set when using an SkColorSpaceXformCanvas to do pre-draw xforms.
+    // A non-null |dstColorSpace| indicates that the surface we're drawing to is tagged. In all
+    // cases, picture-backed images behave the same (using a tagged surface for rasterization),
+    // and (as sources) they require a valid color space, so default to sRGB.
+
+    // With SkColorSpaceXformCanvas, the surface should never have a color space attached.
+    SkASSERT(!fColorSpace || !dstColorSpace);
+
+    sk_sp<SkColorSpace> imgCS = dstColorSpace ? sk_ref_sp(dstColorSpace)
+                                              : fColorSpace ? fColorSpace
+                                                            : SkColorSpace::MakeSRGB();
+    SkImage::BitDepth bitDepth =
+            kRGBA_F16_SkColorType == dstColorType || kRGBA_F32_SkColorType == dstColorType
+            ? SkImage::BitDepth::kF16 : SkImage::BitDepth::kU8;
+
+    if (dstBounds) {
+        const SkPoint absScale = SkPoint::Make(SkScalarAbs(scale.x()), SkScalarAbs(scale.y()));
+        if (auto tiled = this->refTiledBitmapShader(m, localMatrix, *dstBounds, absScale,
+                                                    imgCS, bitDepth)) {
+            return tiled;
+        }
+    }
+
     // Clamp the tile size to about 4M pixels
-    static const SkScalar kMaxTileArea = 2048 * 2048;
     SkScalar tileArea = scaledSize.width() * scaledSize.height();
     if (tileArea > kMaxTileArea) {
         SkScalar clampScale = SkScalarSqrt(kMaxTileArea / tileArea);
@@ -212,21 +303,6 @@ sk_sp<SkShader> SkPictureShader::refBitmapShader(const SkMatrix& viewMatrix,
     const SkSize tileScale = SkSize::Make(SkIntToScalar(tileSize.width()) / fTile.width(),
                                           SkIntToScalar(tileSize.height()) / fTile.height());
 
-    // |fColorSpace| will only be set when using an SkColorSpaceXformCanvas to do pre-draw xforms.
-    // A non-null |dstColorSpace| indicates that the surface we're drawing to is tagged. In all
-    // cases, picture-backed images behave the same (using a tagged surface for rasterization),
-    // and (as sources) they require a valid color space, so default to sRGB.
-
-    // With SkColorSpaceXformCanvas, the surface should never have a color space attached.
-    SkASSERT(!fColorSpace || !dstColorSpace);
-
-    sk_sp<SkColorSpace> imgCS = dstColorSpace ? sk_ref_sp(dstColorSpace)
-                                              : fColorSpace ? fColorSpace
-                                                            : SkColorSpace::MakeSRGB();
-    SkImage::BitDepth bitDepth =
-            kRGBA_F16_SkColorType == dstColorType || kRGBA_F32_SkColorType == dstColorType
-            ? SkImage::BitDepth::kF16 : SkImage::BitDepth::kU8;
-
     BitmapShaderKey key(imgCS.get(), bitDepth, fUniqueID, tileScale);
 
     sk_sp<SkShader> tileShader;
@@ -254,12 +330,113 @@ sk_sp<SkShader> SkPictureShader::refBitmapShader(const SkMatrix& viewMatrix,
     return tileShader;
 }
 
+// Cells of the grid refTiledBitmapShader() cuts huge picture tiles into, in scaled pixels.
+static constexpr int kGridCellSize = 256;
+
+// Rounds a scale up to a quarter octave, so nearby zooms share grid cells.
+static SkScalar bucket_scale(SkScalar scale) {
+    return SkScalarPow(2, SkScalarCeilToScalar(SkScalarLog2(scale) * 4) / 4);
+}
+
+sk_sp<SkShader> SkPictureShader::refTiledBitmapShader(const SkMatrix& m,
+                                                      SkTCopyOnFirstWrite<SkMatrix>* localMatrix,
+                                                      const SkIRect& dstBounds,
+                                                      const SkPoint& scale,
+                                                      sk_sp<SkColorSpace> imgCS,
+                                                      SkImage::BitDepth bitDepth) const {
+    // Only worth it when the whole tile is big, and when the draw stays inside one repetition of
+    // it, so the tile modes never come into play.
+    static const SkScalar kMinTiledArea = 1024 * 1024;
+
+    SkMatrix inverse;
+    if (m.hasPerspective() || !m.invert(&inverse) ||
+        !SkScalarIsFinite(scale.x()) || !SkScalarIsFinite(scale.y()) ||
+        scale.x() <= 0 || scale.y() <= 0) {
+        return nullptr;
+    }
+    const SkSize cellScale = SkSize::Make(bucket_scale(scale.x()), bucket_scale(scale.y()));
+    const SkISize fullSize = SkSize::Make(cellScale.width()  * fTile.width(),
+                                          cellScale.height() * fTile.height()).toCeil();
+    if (SkScalar(fullSize.width()) * fullSize.height() < kMinTiledArea) {
+        return nullptr;
+    }
+
+    const SkRect sampled = inverse.mapRect(SkRect::Make(dstBounds));
+    if (!SkRect::MakeWH(fTile.width(), fTile.height()).contains(sampled)) {
+        return nullptr;
+    }
+    // Leave a pixel around what's sampled for filtering.
+    const SkIRect cells = SkIRect::MakeLTRB(
+            SkTMax(0, (SkScalarFloorToInt(sampled.fLeft * cellScale.width()) - 1) / kGridCellSize),
+            SkTMax(0, (SkScalarFloorToInt(sampled.fTop * cellScale.height()) - 1) / kGridCellSize),
+            SkTMin((fullSize.width() - 1) / kGridCellSize,
+                   (SkScalarCeilToInt(sampled.fRight * cellScale.width()) + 1) / kGridCellSize),
+            SkTMin((fullSize.height() - 1) / kGridCellSize,
+                   (SkScalarCeilToInt(sampled.fBottom * cellScale.height()) + 1) / kGridCellSize));
+    const SkIRect pixels = SkIRect::MakeLTRB(
+            cells.fLeft * kGridCellSize,
+            cells.fTop  * kGridCellSize,
+            SkTMin(fullSize.width(),  (cells.fRight  + 1) * kGridCellSize),
+            SkTMin(fullSize.height(), (cells.fBottom + 1) * kGridCellSize));
+    // Only if we get away with at most half the pixels, and not more than the untiled clamp.
+    if (2 * SkScalar(pixels.width()) * pixels.height() > SkScalar(fullSize.width())
+                                                         * fullSize.height() ||
+        SkScalar(pixels.width()) * pixels.height() > kMaxTileArea) {
+        return nullptr;
+    }
+
+    const SkColorType colorType = SkImage::BitDepth::kF16 == bitDepth ? kRGBA_F16_SkColorType
+                                                                      : kN32_SkColorType;
+    SkBitmap sampledCells;
+    if (!sampledCells.tryAllocPixels(SkImageInfo::Make(pixels.width(), pixels.height(), colorType,
+                                                       kPremul_SkAlphaType, imgCS))) {
+        return nullptr;
+    }
+    for (int y = cells.fTop; y <= cells.fBottom; ++y) {
+        for (int x = cells.fLeft; x <= cells.fRight; ++x) {
+            const SkIRect cell = SkIRect::MakeLTRB(
+                    x * kGridCellSize, y * kGridCellSize,
+                    SkTMin(fullSize.width(),  (x + 1) * kGridCellSize),
+                    SkTMin(fullSize.height(), (y + 1) * kGridCellSize));
+
+            PictureTileKey key(imgCS.get(), bitDepth, fPicture->uniqueID(), fTile, cellScale,
+                               x, y);
+            SkBitmap cellBitmap;
+            if (!SkResourceCache::Find(key, PictureTileRec::Visitor, &cellBitmap)) {
+                if (!cellBitmap.tryAllocPixels(sampledCells.info().makeWH(cell.width(),
+                                                                          cell.height()))) {
+                    return nullptr;
+                }
+                cellBitmap.eraseColor(SK_ColorTRANSPARENT);
+                SkCanvas canvas(cellBitmap);
+                canvas.translate(-cell.fLeft, -cell.fTop);
+                canvas.scale(cellScale.width(), cellScale.height());
+                canvas.translate(-fTile.fLeft, -fTile.fTop);
+                canvas.drawPicture(fPicture);
+                cellBitmap.setImmutable();
+                SkResourceCache::Add(new PictureTileRec(key, cellBitmap));
+            }
+
+            SkPixmap dst;
+            SkAssertResult(sampledCells.pixmap().extractSubset(
+                    &dst, cell.makeOffset(-pixels.fLeft, -pixels.fTop)));
+            cellBitmap.readPixels(dst);
+        }
+    }
+    sampledCells.setImmutable();
+
+    localMatrix->writable()->preScale(1 / cellScale.width(), 1 / cellScale.height());
+    localMatrix->writable()->preTranslate(pixels.fLeft, pixels.fTop);
+    return SkImage::MakeFromBitmap(sampledCells)->makeShader();
+}
+
 bool SkPictureShader::onAppendStages(const StageRec& rec) const {
     auto lm = this->totalLocalMatrix(rec.fLocalM);
 
     // Keep bitmapShader alive by using alloc instead of stack memory
     auto& bitmapShader = *rec.fAlloc->make<sk_sp<SkShader>>();
-    bitmapShader = this->refBitmapShader(rec.fCTM, &lm, rec.fDstColorType, rec.fDstCS);
+    bitmapShader = this->refBitmapShader(rec.fCTM, &lm, rec.fDstColorType, rec.fDstCS,
+                                         /*maxTextureSize=*/0, rec.fDstBounds);
 
     if (!bitmapShader) {
         return false;
@@ -278,7 +455,8 @@ SkShaderBase::Context* SkPictureShader::onMakeContext(const ContextRec& rec, SkA
 const {
     auto lm = this->totalLocalMatrix(rec.fLocalMatrix);
     sk_sp<SkShader> bitmapShader = this->refBitmapShader(*rec.fMatrix, &lm, rec.fDstColorType,
-                                                         rec.fDstColorSpace);
+                                                         rec.fDstColorSpace,
+                                                         /*maxTextureSize=*/0, rec.fDstBounds);
     if (!bitmapShader) {
         return nullptr;
     }
@@ -8,6 +8,7 @@
 #ifndef SkPictureShader_DEFINED
 #define SkPictureShader_DEFINED
 
+#include "SkImage.h"
 #include "SkShaderBase.h"
 #include <atomic>
 
@@ -47,9 +48,18 @@ private:
     SkPictureShader(sk_sp<SkPicture>, TileMode, TileMode, const SkMatrix*, const SkRect*,
                     sk_sp<SkColorSpace>);
 
+    // If dstBounds is given, only the part of the picture tile it covers may be rasterized.
     sk_sp<SkShader> refBitmapShader(const SkMatrix&, SkTCopyOnFirstWrite<SkMatrix>* localMatrix,
                                     SkColorType dstColorType, SkColorSpace* dstColorSpace,
-                                    const int maxTextureSize = 0) const;
+                                    const int maxTextureSize = 0,
+                                    const SkIRect* dstBounds = nullptr) const;
+
+    // Rasterizes (or finds cached) just the grid cells of the picture tile that dstBounds
+    // covers, for pictures too big to rasterize whole.  Returns null to fall back to that.
+    sk_sp<SkShader> refTiledBitmapShader(const SkMatrix&,
+                                         SkTCopyOnFirstWrite<SkMatrix>* localMatrix,
+                                         const SkIRect& dstBounds, const SkPoint& scale,
+                                         sk_sp<SkColorSpace>, SkImage::BitDepth) const;
 
     class PictureShaderContext : public Context {
     public:
@@ -30,6 +30,20 @@ struct SkImageInfo;
 class SkPaint;
 class SkRasterPipeline;
 
+/**
+ *  Lets the stages appended by SkShaderBase::appendUpdatableStages() be pointed at a new
+ *  transform, so the same pipeline can draw many pieces of geometry that each map the shader
+ *  differently.
+ */
+class SkStageUpdater {
+public:
+    virtual ~SkStageUpdater() {}
+
+    // Returns false if the stages can't draw with this transform, in which case nothing
+    // should be drawn with them until the next successful update().
+    virtual bool update(const SkMatrix& ctm, const SkMatrix* localM) = 0;
+};
+
 class SkShaderBase : public SkShader {
 public:
     ~SkShaderBase() override;
@@ -75,6 +89,7 @@ public:
         const SkMatrix* fLocalMatrix;      // optional local matrix
         SkColorType     fDstColorType;     // the color type of the dest surface
         SkColorSpace*   fDstColorSpace;    // the color space of the dest surface (if any)
+        const SkIRect*  fDstBounds = nullptr;  // optional device pixels that may be shaded
     };
 
     class Context : public ::SkNoncopyable {
@@ -170,11 +185,19 @@ public:
         const SkPaint&      fPaint;
         const SkMatrix*     fLocalM;        // may be nullptr
         SkMatrix            fCTM;
+        const SkIRect*      fDstBounds;     // may be nullptr; device pixels that may be shaded
     };
 
     // If this returns false, then we draw nothing (do not fall back to shader context)
     bool appendStages(const StageRec&) const;
 
+    // Like appendStages(), but the stages read their transform through the returned updater,
+    // which must be updated before each use.  Returns nullptr if this shader can't do that, in
+    // which case the caller falls back to appending stages for each transform.
+    SkStageUpdater* appendUpdatableStages(const StageRec& rec) const {
+        return this->onAppendUpdatableStages(rec);
+    }
+
     bool SK_WARN_UNUSED_RESULT computeTotalInverse(const SkMatrix& ctm,
                                                    const SkMatrix* outerLocalMatrix,
                                                    SkMatrix* totalInverse) const;
@@ -233,6 +256,8 @@ protected:
     // Default impl creates shadercontext and calls that (not very efficient)
     virtual bool onAppendStages(const StageRec&) const;
 
+    virtual SkStageUpdater* onAppendUpdatableStages(const StageRec&) const { return nullptr; }
+
 private:
     // This is essentially const, but not officially so it can be modified in constructors.
     SkMatrix fLocalMatrix;
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkGradientLUT.h"
+
+#include "SkFloatBits.h"
+#include "SkHalf.h"
+#include "SkResourceCache.h"
+#include "SkTemplates.h"
+
+namespace {
+static unsigned gGradientLUTKeyNamespaceLabel;
+
+// The fixed fields are followed by count colors and then count positions, as 32-bit words.
+struct GradientLUTKey : public SkResourceCache::Key {
+    static size_t DataSize(int count) {
+        return 4 * sizeof(int32_t) + count * (sizeof(SkPMColor4f) + sizeof(SkScalar));
+    }
+
+    void init(const SkPMColor4f* colors, const SkScalar* positions, int count, int resolution,
+              SkColorType colorType, SkAlphaType alphaType) {
+        fCount = count;
+        fResolution = resolution;
+        fColorType = colorType;
+        fAlphaType = alphaType;
+        uint32_t* data = reinterpret_cast<uint32_t*>(this + 1);
+        memcpy(data, colors, count * sizeof(SkPMColor4f));
+        data += count * sizeof(SkPMColor4f) / sizeof(uint32_t);
+        for (int i = 0; i < count; i++) {
+            *data++ = SkFloat2Bits(positions[i]);
+        }
+        this->INHERITED::init(&gGradientLUTKeyNamespaceLabel, 0, DataSize(count));
+    }
+
+    int32_t fCount;
+    int32_t fResolution;
+    int32_t fColorType;
+    int32_t fAlphaType;
+    /* uint32_t fData[] */
+
+    typedef SkResourceCache::Key INHERITED;
+};
+
+// Holds its key in a block sized for the colors and positions.
+class KeyStorage {
+public:
+    KeyStorage(const SkPMColor4f* colors, const SkScalar* positions, int count, int resolution,
+               SkColorType colorType, SkAlphaType alphaType)
+        : fStorage((sizeof(GradientLUTKey) + GradientLUTKey::DataSize(count)) / sizeof(uint32_t)) {
+        static_assert(sizeof(GradientLUTKey) % sizeof(uint32_t) == 0, "");
+        new (fStorage.get()) GradientLUTKey;
+        this->key()->init(colors, positions, count, resolution, colorType, alphaType);
+    }
+
+    KeyStorage(const SkResourceCache::Key& key) : fStorage(key.size() / sizeof(uint32_t)) {
+        memcpy(fStorage.get(), &key, key.size());
+    }
+
+    GradientLUTKey* key() const { return reinterpret_cast<GradientLUTKey*>(fStorage.get()); }
+
+private:
+    SkAutoSTMalloc<64, uint32_t> fStorage;
+};
+
+struct GradientLUTRec : public SkResourceCache::Rec {
+    GradientLUTRec(const SkResourceCache::Key& key, const SkBitmap& bitmap)
+        : fKey(key), fBitmap(bitmap) {}
+
+    KeyStorage fKey;
+    SkBitmap   fBitmap;
+
+    const Key& getKey() const override { return *fKey.key(); }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fKey.key()->size() + fBitmap.computeByteSize();
+    }
+    const char* getCategory() const override { return "gradient-lut"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const GradientLUTRec& rec = static_cast<const GradientLUTRec&>(baseRec);
+        *static_cast<SkBitmap*>(contextData) = rec.fBitmap;
+        return true;
+    }
+};
+
+void fill_gradient(const SkPMColor4f* colors, const SkScalar* positions, int count,
+                   SkBitmap* bitmap) {
+    const int resolution = bitmap->width();
+    const bool isF16 = kRGBA_F16_SkColorType == bitmap->colorType();
+    SkHalf* pixelsF16 = reinterpret_cast<SkHalf*>(bitmap->getPixels());
+    uint32_t* pixels32 = reinterpret_cast<uint32_t*>(bitmap->getPixels());
+
+    auto writePixel = [&](const Sk4f& c, int index) {
+        if (isF16) {
+            SkFloatToHalf_finite_ftz(c).store(pixelsF16 + 4*index);
+        } else {
+            pixels32[index] = Sk4f_toL32(c);
+        }
+    };
+
+    // Entry k holds the gradient at the center of texel k, where a GPU samples it. Snapping
+    // the stops to entries instead would move them by up to half an entry.
+    int stop = 1;
+    for (int k = 0; k < resolution; k++) {
+        SkScalar t = (k + 0.5f) / resolution;
+        while (stop < count - 1 && t >= positions[stop]) {
+            stop++;
+        }
+        SkScalar t0 = positions[stop - 1],
+                 t1 = positions[stop];
+        SkScalar f = t1 > t0 ? SkTPin((t - t0) / (t1 - t0), 0.0f, 1.0f) : 1.0f;
+
+        Sk4f c0 = Sk4f::Load(colors[stop - 1].vec()),
+             c1 = Sk4f::Load(colors[stop    ].vec());
+        writePixel(c0 + (c1 - c0) * f, k);
+    }
+}
+} // namespace
+
+int SkGradientLUT::ResolutionFor(const SkScalar* positions, int count) {
+    for (int i = 1; i < count; i++) {
+        SkScalar dt = positions[i] - positions[i - 1];
+        if (dt > 0 && dt * kDefaultResolution < 16) {
+            return kFineResolution;
+        }
+    }
+    return kDefaultResolution;
+}
+
+void SkGradientLUT::Get(const SkPMColor4f* colors, const SkScalar* positions, int count,
+                        int resolution, SkColorType colorType, SkAlphaType alphaType,
+                        SkBitmap* bitmap) {
+    SkASSERT(count >= 2 && SkIsPow2(resolution));
+    SkASSERT(kRGBA_8888_SkColorType == colorType || kRGBA_F16_SkColorType == colorType);
+
+    KeyStorage storage(colors, positions, count, resolution, colorType, alphaType);
+    const GradientLUTKey& key = *storage.key();
+    if (SkResourceCache::Find(key, GradientLUTRec::Visitor, bitmap)) {
+        return;
+    }
+
+    bitmap->allocPixels(SkImageInfo::Make(resolution, 1, colorType, alphaType));
+    fill_gradient(colors, positions, count, bitmap);
+    bitmap->setImmutable();
+    SkResourceCache::Add(new GradientLUTRec(key, *bitmap));
+}
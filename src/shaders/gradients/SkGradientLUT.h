@@ -0,0 +1,46 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGradientLUT_DEFINED
+#define SkGradientLUT_DEFINED
+
+#include "SkBitmap.h"
+#include "SkColorData.h"
+
+/**
+ * 1 x N bitmaps holding a gradient's colors sampled at N evenly spaced t, kept in
+ * SkResourceCache. The raster pipeline samples them in place of searching the stops for
+ * gradients with many colors, and GrTextureGradientColorizer uploads them as textures, so a
+ * gradient drawn by both backends is only filled once.
+ */
+class SkGradientLUT {
+public:
+    // Gradients with fewer colors are cheaper to evaluate per pixel than to sample a LUT for.
+    static constexpr int kMinColorCount = 16;
+
+    static constexpr int kDefaultResolution = 256;
+    static constexpr int kFineResolution    = 1024;
+
+    /**
+     * Returns kDefaultResolution, or kFineResolution if some interval between two positions
+     * (other than a hard stop) would span fewer than 16 entries at the default resolution.
+     * Sampling lerps between entries, which rounds off the colors at each stop.
+     */
+    static int ResolutionFor(const SkScalar* positions, int count);
+
+    /**
+     * Sets bitmap to an immutable 1 x resolution bitmap of colorType (kRGBA_8888 or kRGBA_F16)
+     * and alphaType, where entry k is the gradient at t = (k + 0.5) / resolution, the center
+     * of texel k. Assumes colors are compatible with alphaType (e.g. if it's premul then colors
+     * are already premultiplied), and positions run from 0 to 1. Thread safe.
+     */
+    static void Get(const SkPMColor4f* colors, const SkScalar* positions, int count,
+                    int resolution, SkColorType colorType, SkAlphaType alphaType,
+                    SkBitmap* bitmap);
+};
+
+#endif
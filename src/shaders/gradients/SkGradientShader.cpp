@@ -11,6 +11,7 @@
 #include "SkColorSpaceXformer.h"
 #include "SkConvertPixels.h"
 #include "SkFloatBits.h"
+#include "SkGradientLUT.h"
 #include "SkGradientShaderPriv.h"
 #include "SkHalf.h"
 #include "SkLinearGradient.h"
@@ -271,6 +272,31 @@ static void init_stop_pos(
     add_stop_color(ctx, stop, Fs, Bs);
 }
 
+// A LUT of 8888 colors can stand in for the color stops when the destination has no more
+// precision. Hard stops are left to the gradient stage, which keeps them sharp.
+bool SkGradientShaderBase::usesColorLUT(SkColorType dstColorType) const {
+    switch (dstColorType) {
+        case kRGBA_1010102_SkColorType:
+        case kRGB_101010x_SkColorType:
+        case kRGBA_F16_SkColorType:
+        case kRGBA_F32_SkColorType:
+            return false;
+        default:
+            break;
+    }
+    if (fColorCount < SkGradientLUT::kMinColorCount) {
+        return false;
+    }
+    if (fOrigPos) {
+        for (int i = 1; i < fColorCount; i++) {
+            if (fOrigPos[i] == fOrigPos[i - 1] && fOrigColors4f[i] != fOrigColors4f[i - 1]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 bool SkGradientShaderBase::onAppendStages(const StageRec& rec) const {
     SkRasterPipeline* p = rec.fPipeline;
     SkArenaAlloc* alloc = rec.fAlloc;
@@ -319,8 +345,28 @@ bool SkGradientShaderBase::onAppendStages(const StageRec& rec) const {
                           : SkPMColor4f{ c.fR, c.fG, c.fB, c.fA };
     };
 
-    // The two-stop case with stops at 0 and 1.
-    if (fColorCount == 2 && fOrigPos == nullptr) {
+    if (this->usesColorLUT(rec.fDstColorType)) {
+        SkAutoSTMalloc<16, SkPMColor4f> colors(fColorCount);
+        SkAutoSTMalloc<16, SkScalar> positions(fColorCount);
+        for (int i = 0; i < fColorCount; i++) {
+            colors[i] = prepareColor(i);
+            positions[i] = fOrigPos ? fOrigPos[i] : i / (fColorCount - 1.0f);
+        }
+        int resolution = SkGradientLUT::ResolutionFor(positions.get(), fColorCount);
+
+        // The arena keeps the LUT's pixels alive for as long as the pipeline.
+        SkBitmap* lut = alloc->make<SkBitmap>();
+        SkGradientLUT::Get(colors.get(), positions.get(), fColorCount, resolution,
+                           kRGBA_8888_SkColorType,
+                           premulGrad ? kPremul_SkAlphaType : kUnpremul_SkAlphaType, lut);
+
+        auto ctx = alloc->make<SkRasterPipeline_GradientLUTCtx>();
+        ctx->lut   = lut->getAddr32(0, 0);
+        ctx->scale = resolution;
+        ctx->limit = resolution - 1;
+        p->append(SkRasterPipeline::gradient_lut_8888, ctx);
+    } else if (fColorCount == 2 && fOrigPos == nullptr) {
+        // The two-stop case with stops at 0 and 1.
         const SkPMColor4f c_l = prepareColor(0),
                           c_r = prepareColor(1);
 
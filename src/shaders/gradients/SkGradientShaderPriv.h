@@ -82,6 +82,10 @@ protected:
     virtual void appendGradientStages(SkArenaAlloc* alloc, SkRasterPipeline* tPipeline,
                                       SkRasterPipeline* postPipeline) const = 0;
 
+    // True if onAppendStages() samples the colors from an SkGradientLUT when drawing into
+    // dstColorType, which beats the shader contexts too.
+    bool usesColorLUT(SkColorType dstColorType) const;
+
     template <typename T, typename... Args>
     static Context* CheckedMakeContext(SkArenaAlloc* alloc, Args&&... args) {
         auto* ctx = alloc->make<T>(std::forward<Args>(args)...);
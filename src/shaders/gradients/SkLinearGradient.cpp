@@ -56,7 +56,9 @@ void SkLinearGradient::flatten(SkWriteBuffer& buffer) const {
 SkShaderBase::Context* SkLinearGradient::onMakeContext(
     const ContextRec& rec, SkArenaAlloc* alloc) const
 {
-    return fTileMode != kDecal_TileMode
+    // Returning nullptr falls back to the stages, which handle decal and sample many colors
+    // from a LUT faster than the 4f context walks their intervals.
+    return fTileMode != kDecal_TileMode && !this->usesColorLUT(rec.fDstColorType)
         ? CheckedMakeContext<LinearGradient4fContext>(alloc, *this, rec)
         : nullptr;
 }
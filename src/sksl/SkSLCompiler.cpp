@@ -63,7 +63,14 @@ static const char* SKSL_PIPELINE_STAGE_INCLUDE =
 namespace SkSL {
 
 Compiler::Compiler(Flags flags)
-: fFlags(flags)
+// The vertex module is converted as a fragment program and the fragment module as a vertex one,
+// and the vertex, fragment and geometry modules each see the symbols of the one before.
+: fVertexModule(SKSL_VERT_INCLUDE, Program::kFragment_Kind, nullptr)
+, fFragmentModule(SKSL_FRAG_INCLUDE, Program::kVertex_Kind, &fVertexModule)
+, fGeometryModule(SKSL_GEOM_INCLUDE, Program::kGeometry_Kind, &fFragmentModule)
+, fFPModule(SKSL_FP_INCLUDE, Program::kFragmentProcessor_Kind, nullptr)
+, fPipelineStageModule(SKSL_PIPELINE_STAGE_INCLUDE, Program::kPipelineStage_Kind, nullptr)
+, fFlags(flags)
 , fContext(new Context())
 , fErrorCount(0) {
     auto types = std::shared_ptr<SymbolTable>(new SymbolTable(this));
@@ -225,31 +232,32 @@ Compiler::Compiler(Flags flags)
         printf("Unexpected errors: %s\n", fErrorText.c_str());
     }
     SkASSERT(!fErrorCount);
-
-    Program::Settings settings;
-    fIRGenerator->start(&settings, nullptr);
-    fIRGenerator->convertProgram(Program::kFragment_Kind, SKSL_VERT_INCLUDE,
-                                 strlen(SKSL_VERT_INCLUDE), *fTypes, &fVertexInclude);
-    fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
-    fVertexSymbolTable = fIRGenerator->fSymbolTable;
-
-    fIRGenerator->start(&settings, nullptr);
-    fIRGenerator->convertProgram(Program::kVertex_Kind, SKSL_FRAG_INCLUDE,
-                                 strlen(SKSL_FRAG_INCLUDE), *fTypes, &fFragmentInclude);
-    fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
-    fFragmentSymbolTable = fIRGenerator->fSymbolTable;
-
-    fIRGenerator->start(&settings, nullptr);
-    fIRGenerator->convertProgram(Program::kGeometry_Kind, SKSL_GEOM_INCLUDE,
-                                 strlen(SKSL_GEOM_INCLUDE), *fTypes, &fGeometryInclude);
-    fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
-    fGeometrySymbolTable = fIRGenerator->fSymbolTable;
 }
 
 Compiler::~Compiler() {
     delete fIRGenerator;
 }
 
+Compiler::Module& Compiler::loadModule(Module* module) {
+    if (!module->fLoaded) {
+        module->fLoaded = true;
+        fIRGenerator->fSymbolTable = module->fParent ? this->loadModule(module->fParent).fSymbolTable
+                                                     : fIRGenerator->fRootSymbolTable;
+        Program::Settings settings;
+        fIRGenerator->start(&settings, nullptr);
+        fIRGenerator->convertProgram(module->fKind, module->fSource, strlen(module->fSource),
+                                     *fTypes, &module->fElements);
+        fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
+        for (auto& element : module->fElements) {
+            if (element->fKind == ProgramElement::kEnum_Kind) {
+                ((Enum&) *element).fBuiltin = true;
+            }
+        }
+        module->fSymbolTable = fIRGenerator->fSymbolTable;
+    }
+    return *module;
+}
+
 // add the definition created by assigning to the lvalue to the definition set
 void Compiler::addDefinition(const Expression* lvalue, std::unique_ptr<Expression>* expr,
                              DefinitionMap* definitions) {
@@ -1235,44 +1243,28 @@ std::unique_ptr<Program> Compiler::convertProgram(Program::Kind kind, String tex
                                                   const Program::Settings& settings) {
     fErrorText = "";
     fErrorCount = 0;
-    std::vector<std::unique_ptr<ProgramElement>>* inherited;
-    std::vector<std::unique_ptr<ProgramElement>> elements;
+    Module* module = nullptr;
     switch (kind) {
         case Program::kVertex_Kind:
-            inherited = &fVertexInclude;
-            fIRGenerator->fSymbolTable = fVertexSymbolTable;
-            fIRGenerator->start(&settings, inherited);
+            module = &fVertexModule;
             break;
         case Program::kFragment_Kind:
-            inherited = &fFragmentInclude;
-            fIRGenerator->fSymbolTable = fFragmentSymbolTable;
-            fIRGenerator->start(&settings, inherited);
+            module = &fFragmentModule;
             break;
         case Program::kGeometry_Kind:
-            inherited = &fGeometryInclude;
-            fIRGenerator->fSymbolTable = fGeometrySymbolTable;
-            fIRGenerator->start(&settings, inherited);
+            module = &fGeometryModule;
             break;
         case Program::kFragmentProcessor_Kind:
-            inherited = nullptr;
-            fIRGenerator->start(&settings, nullptr);
-            fIRGenerator->convertProgram(kind, SKSL_FP_INCLUDE, strlen(SKSL_FP_INCLUDE), *fTypes,
-                                         &elements);
-            fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
+            module = &fFPModule;
             break;
         case Program::kPipelineStage_Kind:
-            inherited = nullptr;
-            fIRGenerator->start(&settings, nullptr);
-            fIRGenerator->convertProgram(kind, SKSL_PIPELINE_STAGE_INCLUDE,
-                                         strlen(SKSL_PIPELINE_STAGE_INCLUDE), *fTypes, &elements);
-            fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
+            module = &fPipelineStageModule;
             break;
     }
-    for (auto& element : elements) {
-        if (element->fKind == ProgramElement::kEnum_Kind) {
-            ((Enum&) *element).fBuiltin = true;
-        }
-    }
+    std::vector<std::unique_ptr<ProgramElement>>* inherited = &this->loadModule(module).fElements;
+    fIRGenerator->fSymbolTable = module->fSymbolTable;
+    fIRGenerator->start(&settings, inherited);
+    std::vector<std::unique_ptr<ProgramElement>> elements;
     std::unique_ptr<String> textPtr(new String(std::move(text)));
     fSource = textPtr.get();
     fIRGenerator->convertProgram(kind, textPtr->c_str(), textPtr->size(), *fTypes, &elements);
@@ -1309,9 +1301,10 @@ bool Compiler::optimize(Program& program) {
 std::unique_ptr<Program> Compiler::specialize(
                    Program& program,
                    const std::unordered_map<SkSL::String, SkSL::Program::Settings::Value>& inputs) {
+    // The inherited elements are shared with the new program rather than cloned into it.
     std::vector<std::unique_ptr<ProgramElement>> elements;
-    for (const auto& e : program) {
-        elements.push_back(e.clone());
+    for (const auto& e : program.fElements) {
+        elements.push_back(e->clone());
     }
     Program::Settings settings;
     settings.fCaps = program.fSettings.fCaps;
@@ -168,12 +168,34 @@ private:
 
     Position position(int offset);
 
-    std::vector<std::unique_ptr<ProgramElement>> fVertexInclude;
-    std::shared_ptr<SymbolTable> fVertexSymbolTable;
-    std::vector<std::unique_ptr<ProgramElement>> fFragmentInclude;
-    std::shared_ptr<SymbolTable> fFragmentSymbolTable;
-    std::vector<std::unique_ptr<ProgramElement>> fGeometryInclude;
-    std::shared_ptr<SymbolTable> fGeometrySymbolTable;
+    /**
+     * The built-in declarations for one kind of program. Only sksl.inc is parsed up front; each
+     * of these is parsed the first time a program that needs it is converted, and then shared by
+     * every later program of that kind.
+     */
+    struct Module {
+        Module(const char* source, Program::Kind kind, Module* parent)
+        : fSource(source)
+        , fKind(kind)
+        , fParent(parent) {}
+
+        const char* fSource;
+        // The kind of program the module is converted as.
+        Program::Kind fKind;
+        // The module whose symbols this one's can see, or null for just those of sksl.inc.
+        Module* fParent;
+        bool fLoaded = false;
+        std::vector<std::unique_ptr<ProgramElement>> fElements;
+        std::shared_ptr<SymbolTable> fSymbolTable;
+    };
+
+    Module& loadModule(Module* module);
+
+    Module fVertexModule;
+    Module fFragmentModule;
+    Module fGeometryModule;
+    Module fFPModule;
+    Module fPipelineStageModule;
 
     std::shared_ptr<SymbolTable> fTypes;
     IRGenerator* fIRGenerator;
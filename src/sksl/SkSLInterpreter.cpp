@@ -9,6 +9,7 @@
 
 #include "SkSLInterpreter.h"
 #include "ir/SkSLBinaryExpression.h"
+#include "ir/SkSLDoStatement.h"
 #include "ir/SkSLExpressionStatement.h"
 #include "ir/SkSLForStatement.h"
 #include "ir/SkSLFunctionCall.h"
@@ -18,20 +19,28 @@
 #include "ir/SkSLPostfixExpression.h"
 #include "ir/SkSLPrefixExpression.h"
 #include "ir/SkSLProgram.h"
+#include "ir/SkSLReturnStatement.h"
 #include "ir/SkSLStatement.h"
 #include "ir/SkSLTernaryExpression.h"
 #include "ir/SkSLVarDeclarations.h"
 #include "ir/SkSLVarDeclarationsStatement.h"
 #include "ir/SkSLVariableReference.h"
+#include "ir/SkSLWhileStatement.h"
 #include "SkRasterPipeline.h"
 
 namespace SkSL {
 
+static_assert(Interpreter::kMaxLanes == SkRasterPipeline_kMaxStride,
+              "a batch should hold every pixel of a callback stage");
+
 void Interpreter::run() {
     for (const auto& e : *fProgram) {
         if (ProgramElement::kFunction_Kind == e.fKind) {
             const FunctionDefinition& f = (const FunctionDefinition&) e;
             if ("appendStages" == f.fDeclaration.fName) {
+                // The SkRasterPipeline parameter is only named by append(), which fPipeline
+                // stands in for.
+                this->push(Value((int) 0xDEADBEEF));
                 this->run(f);
                 return;
             }
@@ -41,6 +50,10 @@ void Interpreter::run() {
 }
 
 static int SizeOf(const Type& type) {
+    if (Type::kArray_Kind == type.kind()) {
+        SkASSERT(type.columns() > 0);
+        return type.columns() * SizeOf(type.componentType());
+    }
     return 1;
 }
 
@@ -219,27 +232,31 @@ struct CallbackCtx : public SkRasterPipeline_CallbackCtx {
 
 static void do_callback(SkRasterPipeline_CallbackCtx* raw, int activePixels) {
     CallbackCtx& ctx = (CallbackCtx&) *raw;
+    Interpreter::Vector rgb[3];
+    for (int i = 0; i < activePixels; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            rgb[c].fLanes[i] = Interpreter::Value(ctx.rgba[i * 4 + c]);
+        }
+    }
+    ctx.fInterpreter->runBatch(*ctx.fFunction, rgb, activePixels);
     for (int i = 0; i < activePixels; ++i) {
-        ctx.fInterpreter->push(Interpreter::Value(ctx.rgba[i * 4 + 0]));
-        ctx.fInterpreter->push(Interpreter::Value(ctx.rgba[i * 4 + 1]));
-        ctx.fInterpreter->push(Interpreter::Value(ctx.rgba[i * 4 + 2]));
-        ctx.fInterpreter->run(*ctx.fFunction);
-        ctx.read_from[i * 4 + 2] = ctx.fInterpreter->pop().fFloat;
-        ctx.read_from[i * 4 + 1] = ctx.fInterpreter->pop().fFloat;
-        ctx.read_from[i * 4 + 0] = ctx.fInterpreter->pop().fFloat;
+        for (int c = 0; c < 3; ++c) {
+            ctx.read_from[i * 4 + c] = rgb[c].fLanes[i].fFloat;
+        }
     }
 }
 
 void Interpreter::appendStage(const AppendStage& a) {
     switch (a.fStage) {
+        // fArguments[0] is the pipeline itself.
         case SkRasterPipeline::matrix_4x5: {
-            SkASSERT(a.fArguments.size() == 1);
-            StackIndex transpose = evaluate(*a.fArguments[0]).fInt;
+            SkASSERT(a.fArguments.size() == 2);
+            StackIndex transpose = this->getLValue(*a.fArguments[1]);
             fPipeline.append(SkRasterPipeline::matrix_4x5, &fStack[transpose]);
             break;
         }
         case SkRasterPipeline::callback: {
-            SkASSERT(a.fArguments.size() == 1);
+            SkASSERT(a.fArguments.size() == 2);
             CallbackCtx* ctx = new CallbackCtx();
             ctx->fInterpreter = this;
             ctx->fn = do_callback;
@@ -247,7 +264,7 @@ void Interpreter::appendStage(const AppendStage& a) {
                 if (ProgramElement::kFunction_Kind == e.fKind) {
                     const FunctionDefinition& f = (const FunctionDefinition&) e;
                     if (&f.fDeclaration ==
-                                      ((const FunctionReference&) *a.fArguments[0]).fFunctions[0]) {
+                                      ((const FunctionReference&) *a.fArguments[1]).fFunctions[0]) {
                         ctx->fFunction = &f;
                     }
                 }
@@ -348,6 +365,8 @@ Interpreter::Value Interpreter::evaluate(const Expression& expr) {
                 case Token::GT:         LOGIC(>)
                 case Token::LTEQ:       LOGIC(<=)
                 case Token::GTEQ:       LOGIC(>=)
+                case Token::EQEQ:       LOGIC(==)
+                case Token::NEQ:        LOGIC(!=)
                 case Token::LOGICALAND: {
                     Value result = this->evaluate(*b.fLeft);
                     if (result.fBool) {
@@ -467,6 +486,458 @@ Interpreter::Value Interpreter::evaluate(const Expression& expr) {
     ABORT("unsupported expression: %s\n", expr.description().c_str());
 }
 
+Interpreter::StackIndex Interpreter::batchSlot(const Variable& var) {
+    auto found = fBatchVars.find(&var);
+    if (found != fBatchVars.end()) {
+        return found->second;
+    }
+    StackIndex result = (StackIndex) fBatchStack.size();
+    fBatchStack.resize(fBatchStack.size() + SizeOf(var.fType));
+    fBatchVars[&var] = result;
+    return result;
+}
+
+Interpreter::Mask Interpreter::batchTest(const Vector& value, Mask mask) const {
+    Mask result = 0;
+    for (int i = 0; i < fBatchCount; ++i) {
+        result |= (Mask) value.fLanes[i].fBool << i;
+    }
+    return result & mask;
+}
+
+void Interpreter::runBatch(const FunctionDefinition& f, Vector* args, int count) {
+    SkASSERT(count > 0 && count <= kMaxLanes);
+    fBatchCount = count;
+    const auto& params = f.fDeclaration.fParameters;
+    for (size_t i = 0; i < params.size(); ++i) {
+        SkASSERT(1 == SizeOf(params[i]->fType));
+        fBatchStack[this->batchSlot(*params[i])] = args[i];
+    }
+    fReturned = fBroken = fContinued = 0;
+    this->runBatchStatement(*f.fBody, ((Mask) 1 << count) - 1);
+    for (size_t i = 0; i < params.size(); ++i) {
+        args[i] = fBatchStack[fBatchVars[params[i]]];
+    }
+}
+
+void Interpreter::runBatchStatement(const Statement& stmt, Mask mask) {
+    mask &= ~(fReturned | fBroken | fContinued);
+    if (!mask) {
+        return;
+    }
+    switch (stmt.fKind) {
+        case Statement::kBlock_Kind:
+            for (const auto& s : ((const Block&) stmt).fStatements) {
+                this->runBatchStatement(*s, mask);
+            }
+            break;
+        case Statement::kBreak_Kind:
+            fBroken |= mask;
+            break;
+        case Statement::kContinue_Kind:
+            fContinued |= mask;
+            break;
+        case Statement::kDo_Kind: {
+            const DoStatement& d = (const DoStatement&) stmt;
+            Mask outerBroken = fBroken, outerContinued = fContinued;
+            fBroken = fContinued = 0;
+            while (mask) {
+                this->runBatchStatement(*d.fStatement, mask);
+                fContinued = 0;
+                mask &= ~(fReturned | fBroken);
+                if (mask) {
+                    Vector test;
+                    this->evaluateBatch(*d.fTest, mask, &test);
+                    mask = this->batchTest(test, mask);
+                }
+            }
+            fBroken = outerBroken;
+            fContinued = outerContinued;
+            break;
+        }
+        case Statement::kExpression_Kind: {
+            Vector ignored;
+            this->evaluateBatch(*((const ExpressionStatement&) stmt).fExpression, mask, &ignored);
+            break;
+        }
+        case Statement::kFor_Kind: {
+            const ForStatement& f = (const ForStatement&) stmt;
+            if (f.fInitializer) {
+                this->runBatchStatement(*f.fInitializer, mask);
+            }
+            Mask outerBroken = fBroken, outerContinued = fContinued;
+            fBroken = fContinued = 0;
+            for (;;) {
+                if (mask && f.fTest) {
+                    Vector test;
+                    this->evaluateBatch(*f.fTest, mask, &test);
+                    mask = this->batchTest(test, mask);
+                }
+                if (!mask) {
+                    break;
+                }
+                this->runBatchStatement(*f.fStatement, mask);
+                fContinued = 0;
+                mask &= ~(fReturned | fBroken);
+                if (mask && f.fNext) {
+                    Vector ignored;
+                    this->evaluateBatch(*f.fNext, mask, &ignored);
+                }
+            }
+            fBroken = outerBroken;
+            fContinued = outerContinued;
+            break;
+        }
+        case Statement::kIf_Kind: {
+            const IfStatement& i = (const IfStatement&) stmt;
+            Vector test;
+            this->evaluateBatch(*i.fTest, mask, &test);
+            Mask ifTrue = this->batchTest(test, mask);
+            if (ifTrue) {
+                this->runBatchStatement(*i.fIfTrue, ifTrue);
+            }
+            if (i.fIfFalse && (mask & ~ifTrue)) {
+                this->runBatchStatement(*i.fIfFalse, mask & ~ifTrue);
+            }
+            break;
+        }
+        case Statement::kNop_Kind:
+            break;
+        case Statement::kReturn_Kind:
+            if (((const ReturnStatement&) stmt).fExpression) {
+                ABORT("unsupported statement: %s\n", stmt.description().c_str());
+            }
+            fReturned |= mask;
+            break;
+        case Statement::kVarDeclarations_Kind:
+            for (const auto& decl :((const VarDeclarationsStatement&) stmt).fDeclaration->fVars) {
+                const Variable* var = ((VarDeclaration&) *decl).fVar;
+                StackIndex pos = this->batchSlot(*var);
+                if (var->fInitialValue) {
+                    LValue lvalue;
+                    for (int i = 0; i < fBatchCount; ++i) {
+                        lvalue.fSlots[i] = pos;
+                    }
+                    Vector value;
+                    this->evaluateBatch(*var->fInitialValue, mask, &value);
+                    this->storeBatch(lvalue, value, mask);
+                }
+            }
+            break;
+        case Statement::kWhile_Kind: {
+            const WhileStatement& w = (const WhileStatement&) stmt;
+            Mask outerBroken = fBroken, outerContinued = fContinued;
+            fBroken = fContinued = 0;
+            while (mask) {
+                Vector test;
+                this->evaluateBatch(*w.fTest, mask, &test);
+                mask = this->batchTest(test, mask);
+                if (mask) {
+                    this->runBatchStatement(*w.fStatement, mask);
+                    fContinued = 0;
+                    mask &= ~(fReturned | fBroken);
+                }
+            }
+            fBroken = outerBroken;
+            fContinued = outerContinued;
+            break;
+        }
+        default:
+            ABORT("unsupported statement: %s\n", stmt.description().c_str());
+    }
+}
+
+void Interpreter::getBatchLValue(const Expression& expr, Mask mask, LValue* result) {
+    switch (expr.fKind) {
+        case Expression::kIndex_Kind: {
+            const IndexExpression& idx = (const IndexExpression&) expr;
+            this->getBatchLValue(*idx.fBase, mask, result);
+            Vector index;
+            this->evaluateBatch(*idx.fIndex, mask, &index);
+            int last = idx.fBase->fType.columns() - 1;
+            int stride = SizeOf(idx.fType);
+            for (int i = 0; i < fBatchCount; ++i) {
+                result->fSlots[i] += SkTPin(index.fLanes[i].fInt, 0, last) * stride;
+            }
+            return;
+        }
+        case Expression::kVariableReference_Kind: {
+            StackIndex pos = this->batchSlot(((const VariableReference&) expr).fVariable);
+            for (int i = 0; i < fBatchCount; ++i) {
+                result->fSlots[i] = pos;
+            }
+            return;
+        }
+        case Expression::kTernary_Kind: {
+            const TernaryExpression& t = (const TernaryExpression&) expr;
+            Vector test;
+            this->evaluateBatch(*t.fTest, mask, &test);
+            Mask ifTrue = this->batchTest(test, mask);
+            LValue ifFalse;
+            if (ifTrue) {
+                this->getBatchLValue(*t.fIfTrue, ifTrue, result);
+            }
+            if (mask & ~ifTrue) {
+                this->getBatchLValue(*t.fIfFalse, mask & ~ifTrue, &ifFalse);
+                for (int i = 0; i < fBatchCount; ++i) {
+                    if (!(ifTrue & (1 << i))) {
+                        result->fSlots[i] = ifFalse.fSlots[i];
+                    }
+                }
+            }
+            return;
+        }
+        default:
+            break;
+    }
+    ABORT("unsupported lvalue");
+}
+
+void Interpreter::storeBatch(const LValue& lvalue, const Vector& value, Mask mask) {
+    for (int i = 0; i < fBatchCount; ++i) {
+        if (mask & (1 << i)) {
+            fBatchStack[lvalue.fSlots[i]].fLanes[i] = value.fLanes[i];
+        }
+    }
+}
+
+void Interpreter::evaluateBatch(const Expression& expr, Mask mask, Vector* result) {
+    SkASSERT(mask);
+    Value* out = result->fLanes;
+    const int count = fBatchCount;
+    switch (expr.fKind) {
+        case Expression::kBinary_Kind: {
+            // The arithmetic runs over every lane, masked or not, so the loops can vectorize.
+            // Masked lanes may hold leftover values, so integer division checks its lanes.
+            #define BATCH_BINARY(op, floatCase, intCase)                        \
+                Vector right;                                                   \
+                this->evaluateBatch(*b.fLeft, mask, result);                    \
+                this->evaluateBatch(*b.fRight, mask, &right);                   \
+                const Value* r = right.fLanes;                                  \
+                switch (type_kind(b.fLeft->fType)) {                            \
+                    case kFloat_TypeKind:                                       \
+                        for (int i = 0; i < count; ++i) {                       \
+                            floatCase;                                          \
+                        }                                                       \
+                        return;                                                 \
+                    case kInt_TypeKind:                                         \
+                        for (int i = 0; i < count; ++i) {                       \
+                            intCase;                                            \
+                        }                                                       \
+                        return;                                                 \
+                    default:                                                    \
+                        abort();                                                \
+                }
+            #define BATCH_ARITHMETIC(op) {                                      \
+                BATCH_BINARY(op, out[i].fFloat = out[i].fFloat op r[i].fFloat,  \
+                                 out[i].fInt = out[i].fInt op r[i].fInt)        \
+            }
+            #define BATCH_BITWISE(op) {                                         \
+                BATCH_BINARY(op, abort(), out[i].fInt = out[i].fInt op r[i].fInt) \
+            }
+            #define BATCH_LOGIC(op) {                                           \
+                BATCH_BINARY(op, out[i] = Value(out[i].fFloat op r[i].fFloat),  \
+                                 out[i] = Value(out[i].fInt op r[i].fInt))      \
+            }
+            #define BATCH_COMPOUND(op, floatCase, intCase) {                    \
+                LValue left;                                                    \
+                Vector right;                                                   \
+                this->getBatchLValue(*b.fLeft, mask, &left);                    \
+                this->evaluateBatch(*b.fRight, mask, &right);                   \
+                for (int i = 0; i < count; ++i) {                               \
+                    if (mask & (1 << i)) {                                      \
+                        out[i] = fBatchStack[left.fSlots[i]].fLanes[i];         \
+                    }                                                           \
+                }                                                               \
+                const Value* r = right.fLanes;                                  \
+                switch (type_kind(b.fLeft->fType)) {                            \
+                    case kFloat_TypeKind:                                       \
+                        for (int i = 0; i < count; ++i) {                       \
+                            floatCase;                                          \
+                        }                                                       \
+                        break;                                                  \
+                    case kInt_TypeKind:                                         \
+                        for (int i = 0; i < count; ++i) {                       \
+                            intCase;                                            \
+                        }                                                       \
+                        break;                                                  \
+                    default:                                                    \
+                        abort();                                                \
+                }                                                               \
+                this->storeBatch(left, *result, mask);                          \
+                return;                                                         \
+            }
+            #define BATCH_COMPOUND_ARITHMETIC(op) \
+                BATCH_COMPOUND(op, out[i].fFloat op r[i].fFloat, out[i].fInt op r[i].fInt)
+            #define BATCH_COMPOUND_BITWISE(op) \
+                BATCH_COMPOUND(op, abort(), out[i].fInt op r[i].fInt)
+            // Masked lanes are given a quotient of zero, rather than risk trapping.
+            #define BATCH_INT_DIVIDE(value, divisor)                            \
+                value = (mask & (1 << i)) && divisor != 0 ? value / divisor : 0
+            const BinaryExpression& b = (const BinaryExpression&) expr;
+            switch (b.fOperator) {
+                case Token::PLUS:       BATCH_ARITHMETIC(+)
+                case Token::MINUS:      BATCH_ARITHMETIC(-)
+                case Token::STAR:       BATCH_ARITHMETIC(*)
+                case Token::SLASH: {
+                    BATCH_BINARY(/, out[i].fFloat = out[i].fFloat / r[i].fFloat,
+                                    BATCH_INT_DIVIDE(out[i].fInt, r[i].fInt))
+                }
+                case Token::BITWISEAND: BATCH_BITWISE(&)
+                case Token::BITWISEOR:  BATCH_BITWISE(|)
+                case Token::BITWISEXOR: BATCH_BITWISE(^)
+                case Token::LT:         BATCH_LOGIC(<)
+                case Token::GT:         BATCH_LOGIC(>)
+                case Token::LTEQ:       BATCH_LOGIC(<=)
+                case Token::GTEQ:       BATCH_LOGIC(>=)
+                case Token::EQEQ:       BATCH_LOGIC(==)
+                case Token::NEQ:        BATCH_LOGIC(!=)
+                case Token::LOGICALAND:
+                case Token::LOGICALOR: {
+                    // Only the lanes the left side doesn't decide evaluate the right side.
+                    this->evaluateBatch(*b.fLeft, mask, result);
+                    Mask left = this->batchTest(*result, mask);
+                    Mask undecided = Token::LOGICALAND == b.fOperator ? left : mask & ~left;
+                    if (undecided) {
+                        Vector right;
+                        this->evaluateBatch(*b.fRight, undecided, &right);
+                        for (int i = 0; i < count; ++i) {
+                            if (undecided & (1 << i)) {
+                                out[i] = right.fLanes[i];
+                            }
+                        }
+                    }
+                    return;
+                }
+                case Token::EQ: {
+                    LValue left;
+                    this->getBatchLValue(*b.fLeft, mask, &left);
+                    this->evaluateBatch(*b.fRight, mask, result);
+                    this->storeBatch(left, *result, mask);
+                    return;
+                }
+                case Token::PLUSEQ:       BATCH_COMPOUND_ARITHMETIC(+=)
+                case Token::MINUSEQ:      BATCH_COMPOUND_ARITHMETIC(-=)
+                case Token::STAREQ:       BATCH_COMPOUND_ARITHMETIC(*=)
+                case Token::SLASHEQ: {
+                    BATCH_COMPOUND(/=, out[i].fFloat /= r[i].fFloat,
+                                       BATCH_INT_DIVIDE(out[i].fInt, r[i].fInt))
+                }
+                case Token::BITWISEANDEQ: BATCH_COMPOUND_BITWISE(&=)
+                case Token::BITWISEOREQ:  BATCH_COMPOUND_BITWISE(|=)
+                case Token::BITWISEXOREQ: BATCH_COMPOUND_BITWISE(^=)
+                default:
+                    ABORT("unsupported operator: %s\n", expr.description().c_str());
+            }
+            #undef BATCH_BINARY
+            #undef BATCH_ARITHMETIC
+            #undef BATCH_BITWISE
+            #undef BATCH_LOGIC
+            #undef BATCH_COMPOUND
+            #undef BATCH_COMPOUND_ARITHMETIC
+            #undef BATCH_COMPOUND_BITWISE
+            #undef BATCH_INT_DIVIDE
+            break;
+        }
+        case Expression::kBoolLiteral_Kind: {
+            Value value(((const BoolLiteral&) expr).fValue);
+            std::fill(out, out + count, value);
+            return;
+        }
+        case Expression::kIntLiteral_Kind: {
+            Value value((int) ((const IntLiteral&) expr).fValue);
+            std::fill(out, out + count, value);
+            return;
+        }
+        case Expression::kFloatLiteral_Kind: {
+            Value value((float) ((const FloatLiteral&) expr).fValue);
+            std::fill(out, out + count, value);
+            return;
+        }
+        case Expression::kIndex_Kind:
+        case Expression::kVariableReference_Kind: {
+            LValue lvalue;
+            this->getBatchLValue(expr, mask, &lvalue);
+            for (int i = 0; i < count; ++i) {
+                if (mask & (1 << i)) {
+                    out[i] = fBatchStack[lvalue.fSlots[i]].fLanes[i];
+                }
+            }
+            return;
+        }
+        case Expression::kPrefix_Kind: {
+            const PrefixExpression& p = (const PrefixExpression&) expr;
+            this->evaluateBatch(*p.fOperand, mask, result);
+            switch (p.fOperator) {
+                case Token::MINUS:
+                    switch (type_kind(p.fType)) {
+                        case kFloat_TypeKind:
+                            for (int i = 0; i < count; ++i) {
+                                out[i].fFloat = -out[i].fFloat;
+                            }
+                            return;
+                        case kInt_TypeKind:
+                            for (int i = 0; i < count; ++i) {
+                                out[i].fInt = -out[i].fInt;
+                            }
+                            return;
+                        default:
+                            abort();
+                    }
+                case Token::LOGICALNOT:
+                    for (int i = 0; i < count; ++i) {
+                        out[i] = Value(!out[i].fBool);
+                    }
+                    return;
+                default:
+                    abort();
+            }
+        }
+        case Expression::kPostfix_Kind: {
+            const PostfixExpression& p = (const PostfixExpression&) expr;
+            SkASSERT(Token::PLUSPLUS == p.fOperator || Token::MINUSMINUS == p.fOperator);
+            LValue lvalue;
+            this->getBatchLValue(*p.fOperand, mask, &lvalue);
+            int delta = Token::PLUSPLUS == p.fOperator ? 1 : -1;
+            TypeKind kind = type_kind(p.fType);
+            for (int i = 0; i < count; ++i) {
+                if (mask & (1 << i)) {
+                    Value& value = fBatchStack[lvalue.fSlots[i]].fLanes[i];
+                    out[i] = value;
+                    if (kFloat_TypeKind == kind) {
+                        value.fFloat += delta;
+                    } else {
+                        value.fInt += delta;
+                    }
+                }
+            }
+            return;
+        }
+        case Expression::kTernary_Kind: {
+            const TernaryExpression& t = (const TernaryExpression&) expr;
+            Vector test;
+            this->evaluateBatch(*t.fTest, mask, &test);
+            Mask ifTrue = this->batchTest(test, mask);
+            if (ifTrue) {
+                this->evaluateBatch(*t.fIfTrue, ifTrue, result);
+            }
+            if (mask & ~ifTrue) {
+                Vector ifFalse;
+                this->evaluateBatch(*t.fIfFalse, mask & ~ifTrue, &ifFalse);
+                for (int i = 0; i < count; ++i) {
+                    if (!(ifTrue & (1 << i))) {
+                        out[i] = ifFalse.fLanes[i];
+                    }
+                }
+            }
+            return;
+        }
+        default:
+            break;
+    }
+    ABORT("unsupported expression: %s\n", expr.description().c_str());
+}
+
 } // namespace
 
 #endif
@@ -31,6 +31,9 @@ class Interpreter {
 
 public:
     union Value {
+        Value()
+        : fInt(0) {}
+
         Value(float f)
         : fFloat(f) {}
 
@@ -51,6 +54,17 @@ public:
         kBool_TypeKind
     };
 
+    // The most invocations runBatch() executes at once; one per pixel of a callback stage.
+    static constexpr int kMaxLanes = 16;
+
+    // One Value for each lane of a batch.
+    struct Vector {
+        Value fLanes[kMaxLanes];
+    };
+
+    // Bit i is set when lane i is active.
+    typedef uint32_t Mask;
+
     Interpreter(std::unique_ptr<Program> program, SkRasterPipeline* pipeline, std::vector<Value>* stack)
     : fProgram(std::move(program))
     , fPipeline(*pipeline)
@@ -76,12 +90,49 @@ public:
 
     Value evaluate(const Expression& expr);
 
+    /**
+     * Runs f over 'count' invocations at once, each a lane of every Vector. args holds one Vector
+     * for each of f's parameters, and is updated with their final values. Every statement and
+     * expression is dispatched once for the whole batch; lanes that take different branches are
+     * masked off rather than run separately.
+     */
+    void runBatch(const FunctionDefinition& f, Vector* args, int count);
+
 private:
+    // The stack slot of an lvalue in each lane, as lanes may index arrays differently.
+    struct LValue {
+        StackIndex fSlots[kMaxLanes];
+    };
+
+    StackIndex batchSlot(const Variable& var);
+
+    // Returns the lanes in mask for which value is true.
+    Mask batchTest(const Vector& value, Mask mask) const;
+
+    void runBatchStatement(const Statement& stmt, Mask mask);
+
+    void getBatchLValue(const Expression& expr, Mask mask, LValue* result);
+
+    void storeBatch(const LValue& lvalue, const Vector& value, Mask mask);
+
+    // Sets the lanes of result in mask to expr's value. Other lanes are unspecified.
+    void evaluateBatch(const Expression& expr, Mask mask, Vector* result);
+
     std::unique_ptr<Program> fProgram;
     SkRasterPipeline& fPipeline;
     std::vector<StatementIndex> fCurrentIndex;
     std::vector<std::unordered_map<const Variable*, StackIndex>> fVars;
     std::vector<Value> &fStack;
+
+    // runBatch() gives each variable a slot the first time it is seen, and keeps it for later
+    // batches.
+    std::unordered_map<const Variable*, StackIndex> fBatchVars;
+    std::vector<Vector> fBatchStack;
+    int fBatchCount = 0;
+    // Lanes that have returned, or left or skipped to the end of the innermost loop.
+    Mask fReturned = 0;
+    Mask fBroken = 0;
+    Mask fContinued = 0;
 };
 
 } // namespace
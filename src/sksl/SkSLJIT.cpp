@@ -121,7 +121,8 @@ JIT::JIT(Compiler* compiler)
 }
 
 JIT::~JIT() {
-    LLVMOrcDisposeInstance(fJITStack);
+    // Each Module owns the JIT stack it was compiled into, and must go before the context.
+    fModuleCache.clear();
     LLVMContextDispose(fContext);
 }
 
@@ -1853,6 +1854,22 @@ std::unique_ptr<JIT::Module> JIT::compile(std::unique_ptr<Program> program) {
     return std::unique_ptr<Module>(new Module(std::move(fProgram), fSharedModule, fJITStack));
 }
 
+JIT::Module* JIT::getModule(Program::Kind kind, const String& source) {
+    String key = to_string((int) kind) + ":" + source;
+    auto found = fModuleCache.find(key);
+    if (found != fModuleCache.end()) {
+        return found->second.get();
+    }
+    Program::Settings settings;
+    std::unique_ptr<Program> program = fCompiler.convertProgram(kind, source, settings);
+    if (!program) {
+        return nullptr;
+    }
+    Module* result = this->compile(std::move(program)).release();
+    fModuleCache[key].reset(result);
+    return result;
+}
+
 void JIT::optimize() {
     LLVMPassManagerBuilderRef pmb = LLVMPassManagerBuilderCreate();
     LLVMPassManagerBuilderSetOptLevel(pmb, 3);
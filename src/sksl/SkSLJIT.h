@@ -92,6 +92,7 @@ public:
         void* getJumperStage(const char* name);
 
         ~Module() {
+            LLVMOrcDisposeInstance(fJITStack);
             LLVMOrcDisposeSharedModuleRef(fSharedModule);
         }
 
@@ -120,6 +121,14 @@ public:
      */
     std::unique_ptr<Module> compile(std::unique_ptr<Program> program);
 
+    /**
+     * Returns the Module for an SkSL program of the given kind, compiled with default settings.
+     * Each distinct source is only converted and compiled the first time it is seen, so callers
+     * that build the same pipelines repeatedly can look their stages up by program text. The
+     * Module is owned by the JIT. Returns null if the program fails to convert.
+     */
+    Module* getModule(Program::Kind kind, const String& source);
+
 private:
     static constexpr int CHANNELS = 4;
 
@@ -335,6 +344,7 @@ private:
     // LLVM function parameters are read-only, so when modifying function parameters we need to
     // first promote them to variables. This keeps track of which parameters have been promoted.
     std::set<const Variable*> fPromotedParameters;
+    std::unordered_map<String, std::unique_ptr<Module>> fModuleCache;
     std::vector<LLVMBasicBlockRef> fBreakTarget;
     std::vector<LLVMBasicBlockRef> fContinueTarget;
 
@@ -108,6 +108,7 @@ void Parser::InitLayoutMap() {
     TOKEN(BLEND_SUPPORT_HSL_COLOR,      "blend_support_hsl_color");
     TOKEN(BLEND_SUPPORT_HSL_LUMINOSITY, "blend_support_hsl_luminosity");
     TOKEN(PUSH_CONSTANT,                "push_constant");
+    TOKEN(STD140,                       "std140");
     TOKEN(POINTS,                       "points");
     TOKEN(LINES,                        "lines");
     TOKEN(LINE_STRIP,                   "line_strip");
@@ -852,6 +853,9 @@ Layout Parser::layout() {
                     case LayoutToken::PUSH_CONSTANT:
                         flags |= Layout::kPushConstant_Flag;
                         break;
+                    case LayoutToken::STD140:
+                        flags |= Layout::kStd140_Flag;
+                        break;
                     case LayoutToken::TRACKED:
                         flags |= Layout::kTracked_Flag;
                         break;
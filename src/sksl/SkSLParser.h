@@ -78,6 +78,7 @@ public:
         BLEND_SUPPORT_HSL_COLOR,
         BLEND_SUPPORT_HSL_LUMINOSITY,
         PUSH_CONSTANT,
+        STD140,
         POINTS,
         LINES,
         LINE_STRIP,
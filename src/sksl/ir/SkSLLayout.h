@@ -39,7 +39,8 @@ struct Layout {
         kBlendSupportHSLSaturation_Flag  = 1 << 16,
         kBlendSupportHSLColor_Flag       = 1 << 17,
         kBlendSupportHSLLuminosity_Flag  = 1 << 18,
-        kTracked_Flag                    = 1 << 19
+        kTracked_Flag                    = 1 << 19,
+        kStd140_Flag                     = 1 << 20
     };
 
     enum Primitive {
@@ -325,6 +326,10 @@ struct Layout {
             result += separator + "tracked";
             separator = ", ";
         }
+        if (fFlags & kStd140_Flag) {
+            result += separator + "std140";
+            separator = ", ";
+        }
         switch (fPrimitive) {
             case kPoints_Primitive:
                 result += separator + "points";
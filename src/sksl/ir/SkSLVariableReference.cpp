@@ -8,9 +8,11 @@
 #include "SkSLVariableReference.h"
 
 #include "SkSLConstructor.h"
+#include "SkSLFieldAccess.h"
 #include "SkSLFloatLiteral.h"
 #include "SkSLIRGenerator.h"
 #include "SkSLSetting.h"
+#include "SkSLSwizzle.h"
 
 namespace SkSL {
 
@@ -88,6 +90,31 @@ std::unique_ptr<Expression> VariableReference::copy_constant(const IRGenerator&
     }
 }
 
+/**
+ * Returns true if expr reads (part of) a variable which can't change while the program runs, such
+ * as a uniform or a parameter the function never writes to, so that it can stand in for a copy of
+ * itself anywhere.
+ */
+static bool is_invariant_read(const Expression& expr) {
+    switch (expr.fKind) {
+        case Expression::kVariableReference_Kind: {
+            const Variable& var = ((const VariableReference&) expr).fVariable;
+            if (var.fWriteCount || (var.fModifiers.fFlags & Modifiers::kOut_Flag)) {
+                return false;
+            }
+            return var.fStorage == Variable::kParameter_Storage ||
+                   (var.fStorage == Variable::kGlobal_Storage &&
+                    (var.fModifiers.fFlags & (Modifiers::kUniform_Flag | Modifiers::kIn_Flag)));
+        }
+        case Expression::kSwizzle_Kind:
+            return is_invariant_read(*((const Swizzle&) expr).fBase);
+        case Expression::kFieldAccess_Kind:
+            return is_invariant_read(*((const FieldAccess&) expr).fBase);
+        default:
+            return false;
+    }
+}
+
 std::unique_ptr<Expression> VariableReference::constantPropagate(const IRGenerator& irGenerator,
                                                                  const DefinitionMap& definitions) {
     if (fRefKind != kRead_RefKind) {
@@ -107,6 +134,12 @@ std::unique_ptr<Expression> VariableReference::constantPropagate(const IRGenerat
         (*exprIter->second)->isConstant()) {
         return copy_constant(irGenerator, exprIter->second->get());
     }
+    if (exprIter != definitions.end() && exprIter->second &&
+        is_invariant_read(**exprIter->second) && (*exprIter->second)->fType == fType) {
+        // A copy of something that can't change since: read the original instead, which leaves
+        // the copy dead when this was its last use.
+        return (*exprIter->second)->clone();
+    }
     return nullptr;
 }
 
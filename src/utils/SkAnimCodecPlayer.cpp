@@ -10,12 +10,15 @@
 #include "SkCodecImageGenerator.h"
 #include "SkData.h"
 #include "SkImage.h"
+#include "SkMakeUnique.h"
+#include "SkTaskGroup.h"
 #include <algorithm>
 
 SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(std::move(codec)) {
     fImageInfo = fCodec->getInfo();
     fFrameInfos = fCodec->getFrameInfo();
     fImages.resize(fFrameInfos.size());
+    fFrameData.resize(fFrameInfos.size());
 
     // change the interpretation of fDuration to a end-time for that frame
     size_t dur = 0;
@@ -34,12 +37,56 @@ SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(st
     }
 }
 
-SkAnimCodecPlayer::~SkAnimCodecPlayer() {}
+SkAnimCodecPlayer::~SkAnimCodecPlayer() {
+    if (fTaskGroup) {
+        fTaskGroup->wait();
+    }
+}
 
 SkISize SkAnimCodecPlayer::dimensions() {
     return { fImageInfo.width(), fImageInfo.height() };
 }
 
+void SkAnimCodecPlayer::purgeFrames(int index) {
+    const size_t frameSize = fImageInfo.computeMinByteSize();
+    const size_t maxFrames = frameSize ? fMemoryBudget / frameSize : SIZE_MAX;
+    if (SkToSizeT(fDecodedFrames) < maxFrames) {
+        return;
+    }
+
+    // Keep the frame about to be decoded, the current and prefetched frames, and the frames
+    // each of them is blended onto.
+    const int count = SkToInt(fFrameInfos.size());
+    std::vector<bool> keep(count, false);
+    auto keepFrame = [&](int i) {
+        keep[i] = true;
+        const int required = fFrameInfos[i].fRequiredFrame;
+        if (required != SkCodec::kNoFrame) {
+            keep[required] = true;
+        }
+    };
+    keepFrame(index);
+    for (int i = 0; i <= fPrefetchCount && i < count; ++i) {
+        keepFrame((fCurrIndex + i) % count);
+    }
+
+    // Evict the frames that will be shown last.
+    for (int i = count - 1; i > 0 && SkToSizeT(fDecodedFrames) >= maxFrames; --i) {
+        const int victim = (fCurrIndex + i) % count;
+        if (keep[victim] || !fImages[victim]) {
+            continue;
+        }
+
+        fImages[victim].reset();
+        // Unless a client still holds the image, its pixels can be reused for the next frame.
+        if (fFrameData[victim]->unique()) {
+            fFreeData.push_back(std::move(fFrameData[victim]));
+        }
+        fFrameData[victim].reset();
+        fDecodedFrames -= 1;
+    }
+}
+
 sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
     SkASSERT((unsigned)index < fFrameInfos.size());
 
@@ -47,9 +94,17 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
         return fImages[index];
     }
 
+    this->purgeFrames(index);
+
     size_t rb = fImageInfo.minRowBytes();
     size_t size = fImageInfo.computeByteSize(rb);
-    auto data = SkData::MakeUninitialized(size);
+    sk_sp<SkData> data;
+    if (!fFreeData.empty()) {
+        data = std::move(fFreeData.back());
+        fFreeData.pop_back();
+    } else {
+        data = SkData::MakeUninitialized(size);
+    }
 
     SkCodec::Options opts;
     opts.fFrameIndex = index;
@@ -64,17 +119,23 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
         }
     }
     if (SkCodec::kSuccess == fCodec->getPixels(fImageInfo, data->writable_data(), rb, &opts)) {
+        fFrameData[index] = data;
+        fDecodedFrames += 1;
         return fImages[index] = SkImage::MakeRasterData(fImageInfo, std::move(data), rb);
     }
+    fFreeData.push_back(std::move(data));
     return nullptr;
 }
 
 sk_sp<SkImage> SkAnimCodecPlayer::getFrame() {
     SkASSERT(fTotalDuration > 0 || fImages.size() == 1);
 
-    return fTotalDuration > 0
-        ? this->getFrameAt(fCurrIndex)
-        : fImages.front();
+    if (!fTotalDuration) {
+        return fImages.front();
+    }
+
+    SkAutoMutexAcquire lock(fMutex);
+    return this->getFrameAt(fCurrIndex);
 }
 
 bool SkAnimCodecPlayer::seek(uint32_t msec) {
@@ -89,8 +150,49 @@ bool SkAnimCodecPlayer::seek(uint32_t msec) {
                                       return (uint32_t)info.fDuration < msec;
                                   });
     int prevIndex = fCurrIndex;
-    fCurrIndex = lower - fFrameInfos.begin();
-    return fCurrIndex != prevIndex;
+    {
+        SkAutoMutexAcquire lock(fMutex);
+        fCurrIndex = lower - fFrameInfos.begin();
+    }
+    if (fCurrIndex == prevIndex) {
+        return false;
+    }
+
+    this->schedulePrefetch();
+    return true;
 }
 
+void SkAnimCodecPlayer::setPrefetch(SkExecutor* executor, int frameCount, size_t memoryBudget) {
+    if (fTaskGroup) {
+        fTaskGroup->wait();
+        fTaskGroup = nullptr;
+    }
+
+    fPrefetchCount = (executor && fTotalDuration) ? SkTMax(frameCount, 0) : 0;
+    fMemoryBudget = memoryBudget;
 
+    if (fPrefetchCount) {
+        fTaskGroup = skstd::make_unique<SkTaskGroup>(*executor);
+        this->schedulePrefetch();
+    }
+}
+
+void SkAnimCodecPlayer::schedulePrefetch() {
+    if (!fTaskGroup) {
+        return;
+    }
+
+    // Only this thread writes fCurrIndex, so it can be read here without the lock.
+    const int from = fCurrIndex;
+    fTaskGroup->add([this, from]() {
+        const int count = SkToInt(fFrameInfos.size());
+        for (int i = 1; i <= fPrefetchCount && i < count; ++i) {
+            SkAutoMutexAcquire lock(fMutex);
+            if (fCurrIndex != from) {
+                // A later seek() has scheduled a fresher prefetch.
+                return;
+            }
+            this->getFrameAt((from + i) % count);
+        }
+    });
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkAsyncNWayCanvas.h"
+#include "SkRecord.h"
+#include "SkRecordDraw.h"
+#include "SkRecorder.h"
+#include "SkSemaphore.h"
+
+// One run of recorded ops, shared by every child that replays it.
+struct SkAsyncNWayChunk : public SkNVRefCnt<SkAsyncNWayChunk> {
+    sk_sp<SkRecord>                 fRecord = sk_make_sp<SkRecord>();
+    std::unique_ptr<SkDrawableList> fDrawables;
+};
+
+SkAsyncNWayCanvas::SkAsyncNWayCanvas(int width, int height)
+    : INHERITED(width, height)
+    , fChunk(sk_make_sp<SkAsyncNWayChunk>()) {
+    fRecorder.reset(new SkRecorder(fChunk->fRecord.get(), width, height));
+    this->INHERITED::addCanvas(fRecorder.get());
+}
+
+SkAsyncNWayCanvas::~SkAsyncNWayCanvas() {
+    this->removeAll();
+}
+
+void SkAsyncNWayCanvas::addCanvas(SkCanvas* canvas) {
+    if (canvas) {
+        // Whatever has been recorded so far was meant for the children we had before.
+        this->submit();
+        fChildren.push_back({canvas, SkExecutor::MakeFIFOThreadPool(1)});
+    }
+}
+
+void SkAsyncNWayCanvas::removeCanvas(SkCanvas* canvas) {
+    this->finish();
+    for (int i = 0; i < fChildren.count(); ++i) {
+        if (fChildren[i].fCanvas == canvas) {
+            fChildren.removeShuffle(i);
+            return;
+        }
+    }
+}
+
+void SkAsyncNWayCanvas::removeAll() {
+    this->finish();
+    fChildren.reset();
+}
+
+void SkAsyncNWayCanvas::submit() {
+    if (fChunk->fRecord->count() == 0) {
+        return;
+    }
+    sk_sp<SkAsyncNWayChunk> chunk = std::move(fChunk);
+    chunk->fDrawables = fRecorder->detachDrawableList();
+
+    // Keep recording, with our matrix, clip and saves intact, into a fresh SkRecord.
+    fChunk = sk_make_sp<SkAsyncNWayChunk>();
+    fRecorder->swapRecord(fChunk->fRecord.get());
+
+    for (const Child& child : fChildren) {
+        SkCanvas* canvas = child.fCanvas;
+        child.fWorker->add([chunk, canvas] {
+            const SkDrawableList* drawables = chunk->fDrawables.get();
+            SkRecordDraw(*chunk->fRecord, canvas, nullptr,
+                         drawables ? drawables->begin() : nullptr,
+                         drawables ? drawables->count() : 0,
+                         nullptr, nullptr);
+        });
+    }
+}
+
+void SkAsyncNWayCanvas::finish() {
+    this->submit();
+
+    // Each worker runs its queue in order, so once it gets to this, it has drawn everything.
+    SkSemaphore done;
+    for (const Child& child : fChildren) {
+        SkCanvas* canvas = child.fCanvas;
+        child.fWorker->add([&done, canvas] {
+            canvas->flush();
+            done.signal();
+        });
+    }
+    for (int i = 0; i < fChildren.count(); ++i) {
+        done.wait();
+    }
+}
+
+void SkAsyncNWayCanvas::onFlush() {
+    this->INHERITED::onFlush();  // Records the flush for each child to replay.
+    this->submit();
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkAsyncNWayCanvas_DEFINED
+#define SkAsyncNWayCanvas_DEFINED
+
+#include "SkExecutor.h"
+#include "SkNWayCanvas.h"
+#include "SkTArray.h"
+
+#include <memory>
+
+class SkRecorder;
+struct SkAsyncNWayChunk;
+
+/**
+ *  Like SkNWayCanvas, but each child canvas draws on its own worker thread, so a slow child
+ *  (say a PDF device) doesn't hold up the others.  Calls are recorded once into an SkRecord,
+ *  and on every flush() the ops recorded since the last one are queued, as one shared chunk,
+ *  for each child to replay in order.
+ *
+ *  Children must not be touched from other threads until finish() returns.  Anything shared
+ *  by the recorded ops (drawables, picture-backed images, ...) must be safe to draw from
+ *  several threads at once.
+ */
+class SkAsyncNWayCanvas : public SkNWayCanvas {
+public:
+    SkAsyncNWayCanvas(int width, int height);
+    ~SkAsyncNWayCanvas() override;
+
+    void addCanvas(SkCanvas*) override;
+    void removeCanvas(SkCanvas*) override;
+    void removeAll() override;
+
+    // Queues what's been recorded, then blocks until every child has drawn all of it.
+    void finish();
+
+protected:
+    void onFlush() override;
+
+private:
+    struct Child {
+        SkCanvas*                   fCanvas;
+        std::unique_ptr<SkExecutor> fWorker;
+    };
+
+    // Hands the ops recorded since the last submit to every child's worker.
+    void submit();
+
+    sk_sp<SkAsyncNWayChunk>           fChunk;
+    std::unique_ptr<SkRecorder>       fRecorder;
+    SkTArray<Child>                   fChildren;
+
+    typedef SkNWayCanvas INHERITED;
+};
+
+#endif
@@ -6,6 +6,7 @@
  */
 
 #include "SkDashPathPriv.h"
+#include "SkMeasuredPath.h"
 #include "SkPathMeasure.h"
 #include "SkPointPriv.h"
 #include "SkStrokeRec.h"
@@ -357,6 +358,8 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
                 cullPathStorage.lineTo(midPoint - v);
             }
         }
+        // The culled path is only dashed once, so keep its measurement out of the cache.
+        cullPathStorage.setIsVolatile(true);
         srcPtr = &cullPathStorage;
     }
 
@@ -364,12 +367,14 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
     bool specialLine = (StrokeRecApplication::kAllow == strokeRecApplication) &&
                        lineRec.init(*srcPtr, dst, rec, count >> 1, intervalLength);
 
-    SkPathMeasure   meas(*srcPtr, false, rec->getResScale());
+    // Animated dashes re-dash the same path every frame, so its measurement comes from the
+    // cache.
+    sk_sp<SkMeasuredPath> meas = SkMeasuredPath::Make(*srcPtr, false, rec->getResScale());
 
-    do {
-        bool        skipFirstSegment = meas.isClosed();
+    for (int contour = 0; contour < meas->contourCount(); ++contour) {
+        bool        skipFirstSegment = meas->isClosed(contour);
         bool        addedSegment = false;
-        SkScalar    length = meas.getLength();
+        SkScalar    length = meas->length(contour);
         int         index = initialDashIndex;
 
         // Since the path length / dash length ratio may be arbitrarily large, we can exert
@@ -403,9 +408,9 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
                                        SkDoubleToScalar(distance + dlen),
                                        dst);
                 } else {
-                    meas.getSegment(SkDoubleToScalar(distance),
-                                    SkDoubleToScalar(distance + dlen),
-                                    dst, true);
+                    meas->getSegment(contour, SkDoubleToScalar(distance),
+                                     SkDoubleToScalar(distance + dlen),
+                                     dst, true);
                 }
             }
             distance += dlen;
@@ -425,12 +430,12 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
         }
 
         // extend if we ended on a segment and we need to join up with the (skipped) initial segment
-        if (meas.isClosed() && is_even(initialDashIndex) &&
+        if (meas->isClosed(contour) && is_even(initialDashIndex) &&
             initialDashLength >= 0) {
-            meas.getSegment(0, initialDashLength, dst, !addedSegment);
+            meas->getSegment(contour, 0, initialDashLength, dst, !addedSegment);
             ++segCount;
         }
-    } while (meas.nextContour());
+    }
 
     if (segCount > 1) {
         dst->setConvexity(SkPath::kConcave_Convexity);
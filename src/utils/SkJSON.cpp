@@ -17,6 +17,12 @@
 #include <tuple>
 #include <vector>
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#elif defined(SK_ARM_HAS_NEON) && defined(SK_CPU_ARM64)
+    #include <arm_neon.h>
+#endif
+
 namespace skjson {
 
 // #define SK_JSON_REPORT_ERRORS
@@ -261,6 +267,53 @@ static inline const char* skip_ws(const char* p) {
     return p;
 }
 
+// Skips plain (non-terminator) string chars 16 at a time, for as long as at least 16 chars are
+// left before p_end.  Returns the position to resume the scalar scan from (p itself when there's
+// no SIMD support).
+static inline const char* skip_string_chars(const char* p, const char* p_end) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    const __m128i quote     = _mm_set1_epi8('"'),
+                  backslash = _mm_set1_epi8('\\'),
+                  rbrace    = _mm_set1_epi8('}'),
+                  rbracket  = _mm_set1_epi8(']'),
+                  max_ctrl  = _mm_set1_epi8(0x1f);
+    for (; p_end - p >= 16; p += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i m = _mm_or_si128(
+                              _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                              _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, rbrace),
+                                                        _mm_cmpeq_epi8(v, rbracket)),
+                                           // Control chars (and \0) are <= 0x1f, unsigned.
+                                           _mm_cmpeq_epi8(_mm_min_epu8(v, max_ctrl), v)));
+        if (_mm_movemask_epi8(m)) {
+            // The scalar scan pinpoints the terminator.
+            break;
+        }
+    }
+#elif defined(SK_ARM_HAS_NEON) && defined(SK_CPU_ARM64)
+    const uint8x16_t quote     = vdupq_n_u8('"'),
+                     backslash = vdupq_n_u8('\\'),
+                     rbrace    = vdupq_n_u8('}'),
+                     rbracket  = vdupq_n_u8(']'),
+                     max_ctrl  = vdupq_n_u8(0x1f);
+    for (; p_end - p >= 16; p += 16) {
+        const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        const uint8x16_t m = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)),
+                                      vorrq_u8(vorrq_u8(vceqq_u8(v, rbrace),
+                                                        vceqq_u8(v, rbracket)),
+                                               vcleq_u8(v, max_ctrl)));
+        if (vmaxvq_u8(m)) {
+            // The scalar scan pinpoints the terminator.
+            break;
+        }
+    }
+#endif
+    return p;
+}
+
+// Exponents within this range can be applied with a single table lookup.
+static constexpr int32_t kMaxFastPow10Exp = 31;
+
 static inline float pow10(int32_t exp) {
     static constexpr float g_pow10_table[63] =
     {
@@ -275,12 +328,11 @@ static inline float pow10(int32_t exp) {
     };
 
     static constexpr int32_t k_exp_offset = SK_ARRAY_COUNT(g_pow10_table) / 2;
+    static_assert(k_exp_offset == kMaxFastPow10Exp, "");
 
-    // We only support negative exponents for now.
-    SkASSERT(exp <= 0);
-
-    return (exp >= -k_exp_offset) ? g_pow10_table[exp + k_exp_offset]
-                                  : std::pow(10.0f, static_cast<float>(exp));
+    return (exp >= -k_exp_offset && exp <= k_exp_offset)
+            ? g_pow10_table[exp + k_exp_offset]
+            : std::pow(10.0f, static_cast<float>(exp));
 }
 
 class DOMParser {
@@ -688,7 +740,7 @@ private:
         do {
             // Consume string chars.
             // This is the fast path, and hopefully we only hit it once then quick-exit below.
-            for (p = p + 1; !is_eostring(*p); ++p);
+            for (p = skip_string_chars(p + 1, p_stop); !is_eostring(*p); ++p);
 
             if (*p == '"') {
                 // Valid string found.
@@ -740,6 +792,10 @@ private:
             f = f * 10.f + (*p++ - '0'); --exp;
         }
 
+        if (*p == 'e' || *p == 'E') {
+            return this->matchFastFloatExponent(p + 1, sign, f, exp);
+        }
+
         const auto decimal_scale = pow10(exp);
         if (is_numeric(*p) || !decimal_scale) {
             SkASSERT((*p == '.' || *p == 'e' || *p == 'E') || !decimal_scale);
@@ -766,10 +822,45 @@ private:
             return p;
         }
 
+        if (*p == 'e' || *p == 'E') {
+            return this->matchFastFloatExponent(p + 1, sign, f, 0);
+        }
+
         return (*p == '.') ? this->matchFastFloatDecimalPart(p + 1, sign, f, 0)
                            : nullptr;
     }
 
+    // Applies an exponent (following the 'e'/'E') to the f * 10^exp mantissa.  Exponents which
+    // don't fit the pow10 table are left to the slow path, for accuracy.
+    const char* matchFastFloatExponent(const char* p, int sign, float f, int exp) {
+        int exp_sign = 1;
+        if (*p == '-') {
+            exp_sign = -1;
+            ++p;
+        } else if (*p == '+') {
+            ++p;
+        }
+
+        if (!is_digit(*p)) {
+            return nullptr;
+        }
+
+        int32_t e = 0;
+        for (; is_digit(*p) && e <= kMaxFastPow10Exp; ++p) {
+            e = e * 10 + (*p - '0');
+        }
+
+        exp += exp_sign * e;
+        if (is_numeric(*p) || exp < -kMaxFastPow10Exp || exp > kMaxFastPow10Exp) {
+            // Malformed input, or an exponent outside the fast range.
+            return nullptr;
+        }
+
+        this->pushFloat(sign * f * pow10(exp));
+
+        return p;
+    }
+
     const char* matchFast32OrFloat(const char* p) {
         int sign = 1;
         if (*p == '-') {
@@ -793,9 +884,11 @@ private:
             }
         }
 
+        const bool has_digits = p > digits_start;
+
         if (!is_numeric(*p)) {
             // Did we actually match any digits?
-            if (p > digits_start) {
+            if (has_digits) {
                 this->pushInt32(sign * n32);
                 return p;
             }
@@ -823,12 +916,21 @@ private:
                 return nullptr;
             }
 
+            if ((*p == 'e' || *p == 'E') && p > decimals_start) {
+                return this->matchFastFloatExponent(p + 1, sign, n32, exp);
+            }
+
             if (n32 > kMaxInt32) {
                 // we ran out on n32 bits
                 return this->matchFastFloatDecimalPart(p, sign, n32, exp);
             }
         }
 
+        if (!has_digits) {
+            // No mantissa digits ahead of an exponent (e.g. "-e5", ".e5").
+            return nullptr;
+        }
+
         return this->matchFastFloatPart(p, sign, n32);
     }
 
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkReadAheadStream.h"
+#include "SkExecutor.h"
+#include "SkSemaphore.h"
+#include "SkTemplates.h"
+
+#include <utility>
+
+class ReadAheadStream : public SkStream {
+public:
+    // Called by Make.
+    ReadAheadStream(std::unique_ptr<SkStream>, SkExecutor*, size_t chunkSize);
+    ~ReadAheadStream() override;
+
+    size_t read(void* buffer, size_t size) override;
+
+    size_t peek(void* buffer, size_t size) const override;
+
+    bool isAtEnd() const override;
+
+    bool hasPosition() const override { return true; }
+    size_t getPosition() const override { return fPosition; }
+
+    bool hasLength() const override { return fHasLength; }
+    size_t getLength() const override { return fLength; }
+
+private:
+    // Queues a read of the next chunk into fNext, unless the stream is exhausted.
+    void prefetch();
+    // Blocks until any queued read has landed in fNext.
+    void waitForNext();
+    // Makes the prefetched chunk current and queues the one after it.
+    // Returns false if there was no more data.
+    bool advance();
+
+    // Only touched by the queued read while fNextPending, and by us otherwise.
+    std::unique_ptr<SkStream> fStream;
+    SkExecutor*               fExecutor;
+    const size_t              fChunkSize;
+    const bool                fHasLength;
+    const size_t              fLength;
+
+    SkAutoTMalloc<char>       fCurrent;
+    size_t                    fCurrentSize   = 0;
+    size_t                    fCurrentOffset = 0;
+    size_t                    fPosition      = 0;
+
+    // Written by the queued read, published to us by fNextReady.
+    SkAutoTMalloc<char>       fNext;
+    size_t                    fNextSize      = 0;
+    bool                      fNextAtEnd     = false;
+
+    bool                      fNextPending   = false;
+    bool                      fStreamAtEnd   = false;
+    SkSemaphore               fNextReady;
+};
+
+std::unique_ptr<SkStream> SkReadAheadStream::Make(std::unique_ptr<SkStream> stream,
+                                                  SkExecutor* executor, size_t chunkSize) {
+    if (!stream || 0 == chunkSize) {
+        return nullptr;
+    }
+    if (!executor) {
+        executor = &SkExecutor::GetDefault();
+    }
+    return std::unique_ptr<SkStream>(new ReadAheadStream(std::move(stream), executor,
+                                                         chunkSize));
+}
+
+ReadAheadStream::ReadAheadStream(std::unique_ptr<SkStream> stream, SkExecutor* executor,
+                                 size_t chunkSize)
+    : fStream(std::move(stream))
+    , fExecutor(executor)
+    , fChunkSize(chunkSize)
+    , fHasLength(fStream->hasPosition() && fStream->hasLength())
+    , fLength(fHasLength ? fStream->getLength() - fStream->getPosition() : 0)
+    , fCurrent(chunkSize)
+    , fNext(chunkSize) {
+    this->prefetch();
+}
+
+ReadAheadStream::~ReadAheadStream() {
+    // The queued read writes into our members, so it has to finish before they go away.
+    this->waitForNext();
+}
+
+void ReadAheadStream::prefetch() {
+    SkASSERT(!fNextPending);
+    if (fStreamAtEnd) {
+        return;
+    }
+    fNextPending = true;
+    fExecutor->add([this] {
+        fNextSize = fStream->read(fNext.get(), fChunkSize);
+        // A short stream may not notice its end until a read comes back empty.
+        fNextAtEnd = 0 == fNextSize || fStream->isAtEnd();
+        fNextReady.signal();
+    });
+}
+
+void ReadAheadStream::waitForNext() {
+    if (fNextPending) {
+        fNextReady.wait();
+        fNextPending = false;
+        fStreamAtEnd = fNextAtEnd;
+    }
+}
+
+bool ReadAheadStream::advance() {
+    SkASSERT(fCurrentOffset == fCurrentSize);
+    this->waitForNext();
+    if (0 == fNextSize) {
+        return false;
+    }
+    std::swap(fCurrent, fNext);
+    fCurrentSize   = fNextSize;
+    fCurrentOffset = 0;
+    fNextSize      = 0;
+    this->prefetch();
+    return true;
+}
+
+size_t ReadAheadStream::read(void* voidDst, size_t size) {
+    char* dst = reinterpret_cast<char*>(voidDst);
+    const size_t start = fPosition;
+
+    while (size > 0) {
+        if (fCurrentOffset == fCurrentSize && !this->advance()) {
+            break;
+        }
+        const size_t bytesToCopy = SkTMin(size, fCurrentSize - fCurrentOffset);
+        if (dst != nullptr) {
+            memcpy(dst, fCurrent.get() + fCurrentOffset, bytesToCopy);
+            dst += bytesToCopy;
+        }
+        fCurrentOffset += bytesToCopy;
+        fPosition      += bytesToCopy;
+        size           -= bytesToCopy;
+    }
+
+    return fPosition - start;
+}
+
+size_t ReadAheadStream::peek(void* dst, size_t size) const {
+    if (fCurrentOffset == fCurrentSize) {
+        // Peeking is how codecs sniff headers, so make the first chunk visible.
+        ReadAheadStream* nonConstThis = const_cast<ReadAheadStream*>(this);
+        if (!nonConstThis->advance()) {
+            return 0;
+        }
+    }
+    size = SkTMin(size, fCurrentSize - fCurrentOffset);
+    memcpy(dst, fCurrent.get() + fCurrentOffset, size);
+    return size;
+}
+
+bool ReadAheadStream::isAtEnd() const {
+    if (fCurrentOffset < fCurrentSize) {
+        return false;
+    }
+    // Whether more data is coming depends on the queued read.
+    ReadAheadStream* nonConstThis = const_cast<ReadAheadStream*>(this);
+    nonConstThis->waitForNext();
+    return 0 == fNextSize && fStreamAtEnd;
+}
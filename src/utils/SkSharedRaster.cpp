@@ -0,0 +1,243 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkSharedRaster.h"
+
+#include "SkCanvas.h"
+#include "SkMakeUnique.h"
+#include "SkSurface.h"
+
+#include <string.h>
+
+#if !defined(SK_BUILD_FOR_WIN)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+#if defined(SK_BUILD_FOR_ANDROID) && __ANDROID_API__ >= 26
+    #include <android/sharedmem.h>
+#elif defined(__linux__)
+    #include <sys/syscall.h>
+    #ifndef MFD_CLOEXEC
+        #define MFD_CLOEXEC 0x0001U
+    #endif
+#endif
+
+#if !defined(SK_BUILD_FOR_WIN) && !defined(SK_BUILD_FOR_ANDROID) && !defined(__linux__)
+    #include "SkString.h"
+    #include <atomic>
+#endif
+
+// Returns a new file descriptor for size bytes of zeroed shared memory, or -1.
+static int create_shared_memory_fd(size_t size) {
+#if defined(SK_BUILD_FOR_WIN)
+    (void)size;
+    return -1;
+#elif defined(SK_BUILD_FOR_ANDROID)
+    #if __ANDROID_API__ >= 26
+        return ASharedMemory_create("skia-raster", size);
+    #else
+        (void)size;
+        return -1;
+    #endif
+#elif defined(__linux__)
+    #if defined(SYS_memfd_create)
+        int fd = (int)syscall(SYS_memfd_create, "skia-raster", MFD_CLOEXEC);
+        if (fd >= 0 && ftruncate(fd, size) != 0) {
+            close(fd);
+            fd = -1;
+        }
+        return fd;
+    #else
+        (void)size;
+        return -1;
+    #endif
+#else
+    // No anonymous shared memory here, so make a uniquely named object and unlink it right away.
+    static std::atomic<uint32_t> gNextID{0};
+    SkString name;
+    name.printf("/skia-raster-%d-%u", (int)getpid(), gNextID++);
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        return -1;
+    }
+    shm_unlink(name.c_str());
+    if (ftruncate(fd, size) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+#endif
+}
+
+sk_sp<SkSharedPixelMemory> SkSharedPixelMemory::Make(size_t size) {
+    if (size == 0) {
+        return nullptr;
+    }
+    int fd = create_shared_memory_fd(size);
+    if (fd < 0) {
+        return nullptr;
+    }
+    return MakeFromFD(fd, size);
+}
+
+sk_sp<SkSharedPixelMemory> SkSharedPixelMemory::MakeFromFD(int fd, size_t size) {
+#if defined(SK_BUILD_FOR_WIN)
+    (void)fd;
+    (void)size;
+    return nullptr;
+#else
+    if (fd < 0) {
+        return nullptr;
+    }
+    void* pixels = size ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                        : MAP_FAILED;
+    if (pixels == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+    return sk_sp<SkSharedPixelMemory>(new SkSharedPixelMemory(fd, pixels, size));
+#endif
+}
+
+SkSharedPixelMemory::~SkSharedPixelMemory() {
+#if !defined(SK_BUILD_FOR_WIN)
+    munmap(fPixels, fSize);
+    close(fFD);
+#endif
+}
+
+sk_sp<SkSurface> SkSharedPixelMemory::makeSurface(const SkImageInfo& info, size_t rowBytes) {
+    if (rowBytes == 0) {
+        rowBytes = info.minRowBytes();
+    }
+    size_t needed = info.computeByteSize(rowBytes);
+    if (SkImageInfo::ByteSizeOverflowed(needed) || needed > fSize) {
+        return nullptr;
+    }
+
+    this->ref();
+    auto release = [](void*, void* memory) { static_cast<SkSharedPixelMemory*>(memory)->unref(); };
+    sk_sp<SkSurface> surface = SkSurface::MakeRasterDirectReleaseProc(info, fPixels, rowBytes,
+                                                                      release, this);
+    if (!surface) {
+        this->unref();
+    }
+    return surface;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<SkCanvas> SkSharedRasterHandleAllocator::MakeCanvas(const SkImageInfo& info) {
+    return SkRasterHandleAllocator::MakeCanvas(skstd::make_unique<SkSharedRasterHandleAllocator>(),
+                                               info);
+}
+
+bool SkSharedRasterHandleAllocator::allocHandle(const SkImageInfo& info, Rec* rec) {
+    size_t rowBytes = info.minRowBytes();
+    size_t size = info.computeByteSize(rowBytes);
+    if (SkImageInfo::ByteSizeOverflowed(size)) {
+        return false;
+    }
+    sk_sp<SkSharedPixelMemory> memory = SkSharedPixelMemory::Make(size);
+    if (!memory) {
+        return false;
+    }
+
+    Layer* layer = new Layer{std::move(memory), info, rowBytes, SkMatrix::I(), info.bounds()};
+    rec->fReleaseProc = [](void*, void* ctx) { delete static_cast<Layer*>(ctx); };
+    rec->fReleaseCtx  = layer;
+    rec->fPixels      = layer->fMemory->pixels();
+    rec->fRowBytes    = rowBytes;
+    rec->fHandle      = layer;
+    return true;
+}
+
+void SkSharedRasterHandleAllocator::updateHandle(Handle handle, const SkMatrix& matrix,
+                                                 const SkIRect& clip) {
+    Layer* layer = static_cast<Layer*>(handle);
+    layer->fMatrix = matrix;
+    layer->fClip   = clip;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<SkSharedRasterSwapchain> SkSharedRasterSwapchain::Make(const SkImageInfo& info) {
+    size_t size = info.computeMinByteSize();
+    if (info.isEmpty() || SkImageInfo::ByteSizeOverflowed(size)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SkSharedRasterSwapchain> swapchain(new SkSharedRasterSwapchain(info));
+    for (Buffer& buffer : swapchain->fBuffers) {
+        buffer.fMemory = SkSharedPixelMemory::Make(size);
+        if (!buffer.fMemory) {
+            return nullptr;
+        }
+        buffer.fSurface = buffer.fMemory->makeSurface(info);
+        if (!buffer.fSurface) {
+            return nullptr;
+        }
+        // Every buffer starts out zeroed, so none is stale.
+        buffer.fStale.setEmpty();
+    }
+    return swapchain;
+}
+
+SkSurface* SkSharedRasterSwapchain::beginFrame(const SkIRect& damage) {
+    SkASSERT(fDrawing < 0);
+    int back = (fFront + 1) % kBufferCount;
+    Buffer& buffer = fBuffers[back];
+
+    fDamage = damage;
+    if (!fDamage.intersect(fInfo.bounds())) {
+        fDamage.setEmpty();
+    }
+
+    // Bring the back buffer up to date with the front buffer, except where it will be redrawn.
+    if (!buffer.fStale.isEmpty() && !fDamage.contains(buffer.fStale)) {
+        buffer.fSurface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+
+        const size_t rowBytes = this->rowBytes(),
+                     bpp      = fInfo.bytesPerPixel(),
+                     offset   = buffer.fStale.fTop * rowBytes + buffer.fStale.fLeft * bpp,
+                     width    = buffer.fStale.width() * bpp;
+        auto src = static_cast<const char*>(fBuffers[fFront].fMemory->pixels()) + offset;
+        auto dst = static_cast<      char*>(buffer.fMemory->pixels()) + offset;
+        for (int y = 0; y < buffer.fStale.height(); y++) {
+            memcpy(dst, src, width);
+            src += rowBytes;
+            dst += rowBytes;
+        }
+    }
+    buffer.fStale.setEmpty();
+
+    SkCanvas* canvas = buffer.fSurface->getCanvas();
+    canvas->save();
+    canvas->clipRect(SkRect::Make(fDamage));
+
+    fDrawing = back;
+    return buffer.fSurface.get();
+}
+
+int SkSharedRasterSwapchain::endFrame(SkIRect* damage) {
+    SkASSERT(fDrawing >= 0);
+    fBuffers[fDrawing].fSurface->getCanvas()->restore();
+
+    for (int i = 0; i < kBufferCount; i++) {
+        if (i != fDrawing) {
+            fBuffers[i].fStale.join(fDamage);
+        }
+    }
+    if (damage) {
+        *damage = fDamage;
+    }
+    fFront   = fDrawing;
+    fDrawing = -1;
+    return fFront;
+}
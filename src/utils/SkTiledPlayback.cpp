@@ -0,0 +1,78 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTiledPlayback.h"
+
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkExecutor.h"
+#include "SkPicture.h"
+#include "SkSurface.h"
+#include "SkTaskGroup.h"
+#include "SkTraceEvent.h"
+
+void SkTiledPlayback::Draw(const SkPicture* picture, SkSurface* surface, SkExecutor* executor,
+                           int tileW, int tileH) {
+    if (!picture || !surface) {
+        return;
+    }
+    TRACE_EVENT0("skia", TRACE_FUNC);
+
+    SkCanvas* canvas = surface->getCanvas();
+    if (canvas->isClipEmpty()) {
+        return;
+    }
+
+    // We draw straight into the surface's pixels, so we need them to be the top layer's
+    // pixels, and we need to be able to express the canvas' clip as a set of tiles.
+    SkPixmap pixmap, top;
+    if (tileW <= 0 || tileH <= 0 ||
+        !surface->peekPixels(&pixmap) ||
+        !canvas->peekPixels(&top) || top.addr() != pixmap.addr() ||
+        !canvas->isClipRect()) {
+        picture->playback(canvas);
+        return;
+    }
+
+    const SkIRect clip = canvas->getDeviceClipBounds();
+    const int tilesX = (clip.width()  + tileW - 1) / tileW,
+              tilesY = (clip.height() + tileH - 1) / tileH;
+    if (tilesX * tilesY <= 1) {
+        picture->playback(canvas);
+        return;
+    }
+
+    // Any snapshots of the surface need to keep their old contents.
+    surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+
+    SkBitmap bitmap;
+    if (!bitmap.installPixels(pixmap)) {
+        picture->playback(canvas);
+        return;
+    }
+
+    // Each tile's canvas covers the entire surface so that device-space effects like dithering
+    // line up exactly, and so saveLayers can still see pixels outside the tile.  Only the clip
+    // keeps each tile's drawing to its own pixels.
+    const SkMatrix ctm = canvas->getTotalMatrix();
+    const SkSurfaceProps props = surface->props();
+
+    SkTaskGroup tg(executor ? *executor : SkExecutor::GetDefault());
+    tg.batch(tilesX * tilesY, [&](int i) {
+        SkIRect tile = SkIRect::MakeXYWH(clip.fLeft + (i % tilesX) * tileW,
+                                         clip.fTop  + (i / tilesX) * tileH,
+                                         tileW, tileH);
+        if (!tile.intersect(clip)) {
+            return;
+        }
+        SkCanvas tileCanvas(bitmap, props);
+        tileCanvas.clipRect(SkRect::Make(tile));
+        tileCanvas.setMatrix(ctm);
+        picture->playback(&tileCanvas);
+    });
+    tg.wait();
+}
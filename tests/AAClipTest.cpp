@@ -429,6 +429,30 @@ static void test_huge(skiatest::Reporter* reporter) {
     clip.setRect(r);
 }
 
+static void test_quick_intersect_noop(skiatest::Reporter* reporter) {
+    SkRasterClip rc(SkIRect::MakeLTRB(10, 10, 50, 50));
+    const SkMatrix& I = SkMatrix::I();
+
+    REPORTER_ASSERT(reporter, rc.quickIntersectIsNoop(SkRect::MakeLTRB(10, 10, 50, 50), I, false));
+    REPORTER_ASSERT(reporter, rc.quickIntersectIsNoop(SkRect::MakeLTRB(9.6f, 10, 50, 50), I, false));
+    REPORTER_ASSERT(reporter, rc.quickIntersectIsNoop(SkRect::MakeLTRB(9.6f, 10, 50, 50), I, true));
+    REPORTER_ASSERT(reporter, !rc.quickIntersectIsNoop(SkRect::MakeLTRB(10.2f, 10, 50, 50), I,
+                                                       true));
+    REPORTER_ASSERT(reporter, !rc.quickIntersectIsNoop(SkRect::MakeLTRB(11, 10, 50, 50), I, false));
+    REPORTER_ASSERT(reporter, !rc.quickIntersectIsNoop(SkRect::MakeLTRB(0, 0, 100, 100),
+                                                       SkMatrix::MakeScale(0.1f), false));
+    REPORTER_ASSERT(reporter, !rc.quickIntersectIsNoop(SkRect::MakeLTRB(0, 0, 100, 100),
+                                                       SkMatrix::MakeAll(1, 0.1f, 0,
+                                                                         0, 1,    0,
+                                                                         0, 0,    1), false));
+
+    // A rect rrect clips like the rect.
+    SkRasterClip rrectClip(SkIRect::MakeLTRB(0, 0, 100, 100));
+    rrectClip.op(SkRRect::MakeRect(SkRect::MakeLTRB(10, 10, 50, 50)), I, rrectClip.getBounds(),
+                 SkRegion::kIntersect_Op, false);
+    REPORTER_ASSERT(reporter, rrectClip == rc);
+}
+
 DEF_TEST(AAClip, reporter) {
     test_empty(reporter);
     test_path_bounds(reporter);
@@ -440,4 +464,5 @@ DEF_TEST(AAClip, reporter) {
     test_really_a_rect(reporter);
     test_crbug_422693(reporter);
     test_huge(reporter);
+    test_quick_intersect_noop(reporter);
 }
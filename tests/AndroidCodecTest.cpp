@@ -295,3 +295,93 @@ DEF_TEST(AndroidCodec_sampledOrientation, r) {
         ERRORF(r, "got result \"%s\"\n", SkCodec::ResultToString(result));
     }
 }
+
+static bool decode_sampled(skiatest::Reporter* r, SkAndroidCodec* codec, int sampleSize,
+                           bool boxFilter, SkBitmap* bm) {
+    SkAndroidCodec::AndroidOptions options;
+    options.fSampleSize = sampleSize;
+    options.fBoxFilter = boxFilter;
+
+    auto dims = codec->getSampledDimensions(sampleSize);
+    auto info = codec->getInfo().makeWH(dims.width(), dims.height())
+                                .makeColorType(kN32_SkColorType)
+                                .makeAlphaType(kPremul_SkAlphaType);
+    bm->allocPixels(info);
+    auto result = codec->getAndroidPixels(info, bm->getPixels(), bm->rowBytes(), &options);
+    if (result != SkCodec::kSuccess) {
+        ERRORF(r, "got result \"%s\"\n", SkCodec::ResultToString(result));
+        return false;
+    }
+    return true;
+}
+
+DEF_TEST(AndroidCodec_sampled, r) {
+    // RGB, and RGBA that is premultiplied, are sampled through the optimized swizzles.
+    for (const char* path : { "images/mandrill_512.png", "images/yellow_rose.png" }) {
+        auto codec = SkAndroidCodec::MakeFromData(GetResourceAsData(path));
+        if (!codec) {
+            continue;
+        }
+
+        SkBitmap full;
+        if (!decode_sampled(r, codec.get(), 1, false, &full)) {
+            continue;
+        }
+
+        for (int sampleSize : { 2, 3, 5 }) {
+            SkBitmap sampled;
+            if (!decode_sampled(r, codec.get(), sampleSize, false, &sampled)) {
+                continue;
+            }
+            const int offset = sampleSize / 2;
+            for (int y = 0; y < sampled.height(); y++) {
+                for (int x = 0; x < sampled.width(); x++) {
+                    uint32_t expected = *full.getAddr32(offset + x * sampleSize,
+                                                        offset + y * sampleSize);
+                    if (*sampled.getAddr32(x, y) != expected) {
+                        ERRORF(r, "%s sampled by %d mismatches at (%d, %d)",
+                               path, sampleSize, x, y);
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
+
+DEF_TEST(AndroidCodec_boxFilter, r) {
+    // libjpeg-turbo cannot scale by 3 itself, so SkSampledCodec box filters the full decode.
+    constexpr int kSampleSize = 3;
+    auto path = "images/mandrill_512_q075.jpg";
+    auto codec = SkAndroidCodec::MakeFromData(GetResourceAsData(path));
+    if (!codec) {
+        return;
+    }
+
+    SkBitmap full, box;
+    if (!decode_sampled(r, codec.get(), 1, false, &full) ||
+            !decode_sampled(r, codec.get(), kSampleSize, true, &box)) {
+        return;
+    }
+
+    for (int y = 0; y < box.height(); y++) {
+        for (int x = 0; x < box.width(); x++) {
+            uint32_t actual = *box.getAddr32(x, y);
+            for (int shift = 0; shift < 32; shift += 8) {
+                int sum = 0;
+                for (int j = 0; j < kSampleSize; j++) {
+                    for (int i = 0; i < kSampleSize; i++) {
+                        sum += (*full.getAddr32(x * kSampleSize + i,
+                                                y * kSampleSize + j) >> shift) & 0xFF;
+                    }
+                }
+                int expected = (sum + kSampleSize * kSampleSize / 2) /
+                               (kSampleSize * kSampleSize);
+                if (SkTAbs(expected - (int)((actual >> shift) & 0xFF)) > 1) {
+                    ERRORF(r, "box filtered %s mismatches at (%d, %d)", path, x, y);
+                    return;
+                }
+            }
+        }
+    }
+}
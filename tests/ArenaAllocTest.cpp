@@ -6,6 +6,11 @@
  */
 
 #include "SkArenaAlloc.h"
+#include "SkArenaAllocPool.h"
+#include "SkCanvas.h"
+#include "SkGradientShader.h"
+#include "SkPaint.h"
+#include "SkSurface.h"
 #include "SkRefCnt.h"
 #include "SkTypes.h"
 #include "Test.h"
@@ -173,3 +178,43 @@ DEF_TEST(ArenaAlloc, r) {
     REPORTER_ASSERT(r, destroyed == 128);
 
 }
+
+DEF_TEST(ArenaAllocPool, r) {
+    // An arena that overflows its pooled block grows the blocks handed out after it.
+    {
+        SkPooledArenaAlloc arena;
+        arena.makeArrayDefault<char>(SkArenaAllocPool::BlockSize());
+        REPORTER_ASSERT(r, arena.heapBytes() > 0);
+    }
+    {
+        SkPooledArenaAlloc arena;
+    }
+    int heapAllocations = SkArenaAllocPool::HeapAllocations();
+    {
+        SkPooledArenaAlloc arena;
+        arena.makeArrayDefault<char>(SkArenaAllocPool::BlockSize() / 2);
+        REPORTER_ASSERT(r, arena.heapBytes() == 0);
+    }
+    REPORTER_ASSERT(r, heapAllocations == SkArenaAllocPool::HeapAllocations());
+
+    // Drawing the same thing over and over settles down to no heap allocations at all.
+    auto surface = SkSurface::MakeRasterN32Premul(64, 64);
+    SkPoint pts[] = {{0, 0}, {64, 64}};
+    SkColor colors[] = {SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorRED};
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, SK_ARRAY_COUNT(colors),
+                                                 SkShader::kMirror_TileMode));
+    auto draw = [&] {
+        surface->getCanvas()->drawCircle(32, 32, 30, paint);
+        surface->getCanvas()->drawRect({4, 4, 60, 60}, paint);
+    };
+    for (int i = 0; i < 4; i++) {
+        draw();
+    }
+    heapAllocations = SkArenaAllocPool::HeapAllocations();
+    for (int i = 0; i < 16; i++) {
+        draw();
+    }
+    REPORTER_ASSERT(r, heapAllocations == SkArenaAllocPool::HeapAllocations());
+}
@@ -16,10 +16,12 @@
 #include "SkColorPriv.h"
 #include "SkDrawLooper.h"
 #include "SkEmbossMaskFilter.h"
+#include "SkExecutor.h"
 #include "SkFloatBits.h"
 #include "SkImageInfo.h"
 #include "SkLayerDrawLooper.h"
 #include "SkMask.h"
+#include "SkMaskBlurFilter.h"
 #include "SkMaskFilter.h"
 #include "SkMaskFilterBase.h"
 #include "SkMath.h"
@@ -45,6 +47,7 @@
 #include <math.h>
 #include <string.h>
 #include <utility>
+#include <vector>
 
 #define WRITE_CSV 0
 
@@ -742,3 +745,94 @@ DEF_TEST(zero_blur, reporter) {
     bitmap.extractAlpha(&alpha, &paint, nullptr, &offset);
 }
 
+
+// Blurs a ring in src's format with SkMaskBlurFilter, returning the A8 result.
+static std::vector<uint8_t> mask_blur(double sigma, SkMask::Format format, int size) {
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeN32Premul(size, size));
+    SkCanvas canvas(bitmap);
+    canvas.clear(SK_ColorTRANSPARENT);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setStrokeWidth(size / 8.0f);
+    canvas.drawCircle(size / 2.0f, size / 3.0f, size / 4.0f, paint);
+
+    SkAutoTMalloc<uint8_t> pixels(size * size * 4);
+    SkMask src;
+    src.fBounds.set(0, 0, size, size);
+    src.fFormat = format;
+    src.fImage = pixels.get();
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            uint8_t alpha = SkGetPackedA32(*bitmap.getAddr32(x, y));
+            if (SkMask::kA8_Format == format) {
+                src.fRowBytes = size;
+                pixels[y * size + x] = alpha;
+            } else {
+                SkASSERT(SkMask::kARGB32_Format == format);
+                src.fRowBytes = size * 4;
+                reinterpret_cast<SkPMColor*>(pixels.get())[y * size + x] =
+                        SkPackARGB32(alpha, 0, 0, 0);
+            }
+        }
+    }
+
+    SkMask dst;
+    SkMaskBlurFilter{sigma, sigma}.blur(src, &dst);
+    SkAutoMaskFreeImage autoFree(dst.fImage);
+    return std::vector<uint8_t>(dst.fImage, dst.fImage + dst.computeImageSize());
+}
+
+DEF_TEST(MaskBlurFilter_Parallel, reporter) {
+    // Other tests may pick up the executor while it is set, so it has to outlive them.
+    static std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    // 40 and 120 rows are not multiples of eight, so some rows take the scalar path.
+    for (int size : {40, 120, 333}) {
+        for (double sigma : {3.0, 10.0, 50.0, 100.0}) {
+            std::vector<uint8_t> serial = mask_blur(sigma, SkMask::kA8_Format, size);
+
+            // The eight row kernel must match the scalar scan used for other formats.
+            if (sigma <= 64) {
+                REPORTER_ASSERT(reporter,
+                                serial == mask_blur(sigma, SkMask::kARGB32_Format, size));
+            }
+
+            gSkMaskBlurExecutor = executor.get();
+            std::vector<uint8_t> parallel = mask_blur(sigma, SkMask::kA8_Format, size);
+            gSkMaskBlurExecutor = nullptr;
+            REPORTER_ASSERT(reporter, serial == parallel);
+        }
+    }
+}
+
+DEF_TEST(MaskBlurFilter_Downsampled, reporter) {
+    // However a large sigma is blurred, a large square stays opaque in the middle, and the mass
+    // of the mask is preserved.
+    for (double sigma : {60.0, 70.0, 130.0}) {
+        constexpr int kSize = 1000;
+        SkAutoTMalloc<uint8_t> pixels(kSize * kSize);
+        memset(pixels.get(), 0xFF, kSize * kSize);
+        SkMask src;
+        src.fBounds.set(0, 0, kSize, kSize);
+        src.fRowBytes = kSize;
+        src.fFormat = SkMask::kA8_Format;
+        src.fImage = pixels.get();
+
+        SkMask dst;
+        SkIPoint border = SkMaskBlurFilter{sigma, sigma}.blur(src, &dst);
+        SkAutoMaskFreeImage autoFree(dst.fImage);
+        REPORTER_ASSERT(reporter, dst.fBounds.width() == kSize + 2 * border.fX);
+
+        int center = dst.fBounds.width() / 2;
+        REPORTER_ASSERT(reporter, dst.fImage[center * dst.fRowBytes + center] >= 254);
+        REPORTER_ASSERT(reporter, dst.fImage[0] <= 1);
+
+        double total = 0;
+        for (size_t i = 0; i < dst.computeImageSize(); ++i) {
+            total += dst.fImage[i];
+        }
+        REPORTER_ASSERT(reporter, std::abs(total / (255.0 * kSize * kSize) - 1) < 0.01);
+    }
+}
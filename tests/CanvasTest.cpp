@@ -45,6 +45,7 @@
  *      that the invoked method returns a non-zero value.
  */
 
+#include "SkAsyncNWayCanvas.h"
 #include "SkBitmap.h"
 #include "SkBlendMode.h"
 #include "SkCanvas.h"
@@ -752,6 +753,45 @@ DEF_TEST(NWayCanvas, r) {
     REPORTER_ASSERT(r, life[1]);
 }
 
+// Check that AsyncNWayCanvas draws the same thing into each child, across flushes and saves.
+DEF_TEST(AsyncNWayCanvas, r) {
+    const int w = 10;
+    const int h = 10;
+    SkBitmap bitmaps[2];
+    std::unique_ptr<SkCanvas> children[2];
+    for (int i = 0; i < 2; ++i) {
+        bitmaps[i].allocN32Pixels(w, h);
+        bitmaps[i].eraseColor(SK_ColorTRANSPARENT);
+        children[i].reset(new SkCanvas(bitmaps[i]));
+    }
+
+    {
+        SkAsyncNWayCanvas nway(w, h);
+        nway.addCanvas(children[0].get());
+        nway.addCanvas(children[1].get());
+
+        SkPaint paint;
+        paint.setColor(SK_ColorRED);
+        nway.save();
+        nway.translate(5, 0);
+        nway.drawRect(SkRect::MakeWH(5, 10), paint);
+        nway.flush();
+        // Still translated after the flush.
+        paint.setColor(SK_ColorBLUE);
+        nway.drawRect(SkRect::MakeWH(5, 5), paint);
+        nway.restore();
+        nway.drawRect(SkRect::MakeWH(5, 5), paint);
+        nway.finish();
+    }
+
+    for (const SkBitmap& bitmap : bitmaps) {
+        REPORTER_ASSERT(r, bitmap.getColor(2, 2) == SK_ColorBLUE);
+        REPORTER_ASSERT(r, bitmap.getColor(2, 7) == SK_ColorTRANSPARENT);
+        REPORTER_ASSERT(r, bitmap.getColor(7, 2) == SK_ColorBLUE);
+        REPORTER_ASSERT(r, bitmap.getColor(7, 7) == SK_ColorRED);
+    }
+}
+
 // Check that CanvasStack DOES manage the lifetime of its sub-canvases
 DEF_TEST(CanvasStack, r) {
     const int w = 10;
@@ -10,6 +10,7 @@
 #include "SkClipOpPriv.h"
 #include "SkClipStack.h"
 #include "SkImageInfo.h"
+#include "SkMakeUnique.h"
 #include "SkMatrix.h"
 #include "SkPath.h"
 #include "SkPoint.h"
@@ -28,6 +29,7 @@
 
 #include "GrCaps.h"
 #include "GrClip.h"
+#include "GrClipMaskAtlas.h"
 #include "GrClipStackClip.h"
 #include "GrConfig.h"
 #include "GrContext.h"
@@ -649,6 +651,27 @@ static void test_rect_merging(skiatest::Reporter* reporter) {
     }
 }
 
+// Intersecting with a rect that covers a rect clip is skipped, leaving the stack as it was.
+static void test_redundant_rect(skiatest::Reporter* reporter) {
+    SkClipStack stack;
+    stack.clipRect(SkRect::MakeLTRB(10.5f, 10, 50, 50), SkMatrix::I(), kIntersect_SkClipOp, false);
+    uint32_t genID = stack.getTopmostGenID();
+
+    stack.save();
+    stack.clipRect(SkRect::MakeLTRB(0, 0, 100, 100), SkMatrix::I(), kIntersect_SkClipOp, false);
+    stack.clipRRect(SkRRect::MakeRect(SkRect::MakeLTRB(10, 10, 50, 50)), SkMatrix::I(),
+                    kIntersect_SkClipOp, true);
+    REPORTER_ASSERT(reporter, 1 == count(stack));
+    REPORTER_ASSERT(reporter, genID == stack.getTopmostGenID());
+
+    // An antialiased edge inside a pixel the clip touches does change it.
+    stack.clipRect(SkRect::MakeLTRB(10.5f, 10, 50, 50), SkMatrix::I(), kIntersect_SkClipOp, true);
+    REPORTER_ASSERT(reporter, 2 == count(stack));
+    stack.restore();
+    REPORTER_ASSERT(reporter, 1 == count(stack));
+    REPORTER_ASSERT(reporter, genID == stack.getTopmostGenID());
+}
+
 static void test_quickContains(skiatest::Reporter* reporter) {
     SkRect testRect = SkRect::MakeLTRB(10, 10, 40, 40);
     SkRect insideRect = SkRect::MakeLTRB(20, 20, 30, 30);
@@ -1469,6 +1492,7 @@ DEF_TEST(ClipStack, reporter) {
     test_rect_replace(reporter);
     test_rect_inverse_fill(reporter);
     test_path_replace(reporter);
+    test_redundant_rect(reporter);
     test_quickContains(reporter);
     test_invfill_diff_bug(reporter);
 
@@ -1483,7 +1507,8 @@ DEF_TEST(ClipStack, reporter) {
 
 sk_sp<GrTextureProxy> GrClipStackClip::testingOnly_createClipMask(GrContext* context) const {
     const GrReducedClip reducedClip(*fStack, SkRect::MakeWH(512, 512), 0);
-    return this->createSoftwareClipMask(context, reducedClip, nullptr);
+    SkIPoint maskLocation;
+    return this->createSoftwareClipMask(context, reducedClip, nullptr, &maskLocation);
 }
 
 // Verify that clip masks are freed up when the clip state that generated them goes away.
@@ -1526,6 +1551,52 @@ DEF_GPUTEST_FOR_ALL_CONTEXTS(ClipMaskCache, reporter, ctxInfo) {
 #endif
 }
 
+static void make_mask_key(uint32_t id, GrUniqueKey* key) {
+    static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
+    GrUniqueKey::Builder builder(key, kDomain, 1);
+    builder[0] = id;
+}
+
+// Verify that small SW clip masks share an atlas page within a flush.
+DEF_GPUTEST_FOR_ALL_CONTEXTS(ClipMaskAtlas, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    GrClipMaskAtlas atlas(context->contextPriv().proxyProvider(), nullptr);
+
+    auto makeClip = [context](SkClipStack* stack, const SkRect& bounds) {
+        SkPath path;
+        path.addOval(bounds);
+        stack->clipPath(path, SkMatrix::I(), SkClipOp::kIntersect, true);
+        return skstd::make_unique<GrReducedClip>(*stack, SkRect::MakeWH(1024, 1024),
+                                                 context->contextPriv().caps());
+    };
+
+    SkClipStack stackA, stackB, bigStack;
+    auto clipA = makeClip(&stackA, SkRect::MakeXYWH(10.5f, 10.5f, 40, 40));
+    auto clipB = makeClip(&stackB, SkRect::MakeXYWH(100.5f, 20.5f, 60, 30));
+    auto bigClip = makeClip(&bigStack, SkRect::MakeWH(GrClipMaskAtlas::kMaxMaskSize + 10, 20));
+    REPORTER_ASSERT(reporter, !clipA->maskElements().isEmpty());
+    REPORTER_ASSERT(reporter, !bigClip->maskElements().isEmpty());
+
+    GrUniqueKey keyA, keyB, bigKey;
+    make_mask_key(1, &keyA);
+    make_mask_key(2, &keyB);
+    make_mask_key(3, &bigKey);
+
+    SkIPoint locA, locB, locA2, big;
+    sk_sp<GrTextureProxy> pageA = atlas.addMask(keyA, *clipA, &locA);
+    sk_sp<GrTextureProxy> pageB = atlas.addMask(keyB, *clipB, &locB);
+    sk_sp<GrTextureProxy> pageA2 = atlas.addMask(keyA, *clipA, &locA2);
+    REPORTER_ASSERT(reporter, pageA && pageA == pageB && pageA == pageA2);
+    REPORTER_ASSERT(reporter, locA != locB);
+    REPORTER_ASSERT(reporter, locA == locA2);
+    REPORTER_ASSERT(reporter, !atlas.addMask(bigKey, *bigClip, &big));
+
+    // Once the flush starts rasterizing the page, masks go in a new one.
+    atlas.preFlush(nullptr, nullptr, 0, nullptr);
+    sk_sp<GrTextureProxy> pageA3 = atlas.addMask(keyA, *clipA, &locA2);
+    REPORTER_ASSERT(reporter, pageA3 && pageA3 != pageA);
+}
+
 DEF_GPUTEST_FOR_ALL_CONTEXTS(canvas_private_clipRgn, reporter, ctxInfo) {
     GrContext* context = ctxInfo.grContext();
 
@@ -13,6 +13,8 @@
 #include "SkCodec.h"
 #include "SkCodecAnimation.h"
 #include "SkData.h"
+#include "SkExecutor.h"
+#include "SkImage.h"
 #include "SkImageInfo.h"
 #include "SkMakeUnique.h"
 #include "SkRefCnt.h"
@@ -484,3 +486,40 @@ DEF_TEST(AnimCodecPlayer, r) {
         REPORTER_ASSERT(r, f1->bounds().size() == test.fSize);
     }
 }
+
+DEF_TEST(AnimCodecPlayer_prefetch, r) {
+    const char* file = "images/alphabetAnim.gif";
+    auto data = GetResourceAsData(file);
+    if (!data) {
+        return;
+    }
+
+    SkAnimCodecPlayer reference(SkCodec::MakeFromData(data));
+    SkAnimCodecPlayer player(SkCodec::MakeFromData(data));
+
+    // A budget of three frames forces evictions (and buffer reuse) as the animation plays.
+    const auto frameInfo = SkImageInfo::MakeN32Premul(player.dimensions());
+    auto executor = SkExecutor::MakeFIFOThreadPool(1);
+    player.setPrefetch(executor.get(), 2, 3 * frameInfo.computeMinByteSize());
+
+    for (uint32_t msec = 0; msec < 2 * player.duration(); msec += 50) {
+        reference.seek(msec);
+        player.seek(msec);
+
+        auto expected = reference.getFrame(),
+             actual   = player.getFrame();
+        REPORTER_ASSERT(r, expected && actual);
+        if (!expected || !actual) {
+            return;
+        }
+
+        SkPixmap expectedPM, actualPM;
+        REPORTER_ASSERT(r, expected->peekPixels(&expectedPM) && actual->peekPixels(&actualPM));
+        REPORTER_ASSERT(r, expectedPM.computeByteSize() == actualPM.computeByteSize());
+        if (memcmp(expectedPM.addr(), actualPM.addr(), expectedPM.computeByteSize())) {
+            ERRORF(r, "%s: prefetched frame differs at %u ms", file, msec);
+        }
+    }
+
+    player.setPrefetch(nullptr, 0, SIZE_MAX);
+}
@@ -169,6 +169,68 @@ DEF_TEST(Codec_partialWuffs, r) {
     }
 }
 
+// Verify that a progressive jpeg shows the whole image once its first scan arrives, and
+// that refining it in place as the remaining scans arrive matches a full decode.
+DEF_TEST(Codec_partialProgressiveJpeg, r) {
+    for (const char* path : { "images/brickwork-texture.jpg",
+                              "images/brickwork_normal-map.jpg",
+                              "images/grayscale.jpg" }) {
+        sk_sp<SkData> file = GetResourceAsData(path);
+        if (!file) {
+            continue;
+        }
+
+        SkBitmap truth;
+        if (!create_truth(file, &truth)) {
+            ERRORF(r, "Failed to decode %s\n", path);
+            continue;
+        }
+
+        HaltingStream* stream(nullptr);
+        std::unique_ptr<SkCodec> partialCodec(nullptr);
+        for (size_t i = 0; !partialCodec && i < file->size(); i++) {
+            stream = new HaltingStream(file, i);
+            partialCodec = SkCodec::MakeFromStream(std::unique_ptr<SkStream>(stream));
+        }
+        if (!partialCodec) {
+            ERRORF(r, "Failed to create a partial codec for %s", path);
+            continue;
+        }
+
+        const SkImageInfo info = standardize_info(partialCodec.get());
+        SkBitmap incremental;
+        incremental.allocPixels(info);
+        if (SkCodec::kSuccess != partialCodec->startIncrementalDecode(info,
+                incremental.getPixels(), incremental.rowBytes())) {
+            ERRORF(r, "Failed to start incremental decode for %s", path);
+            continue;
+        }
+
+        const size_t increment = SkTMax<size_t>(file->size() / 32, 1);
+        bool sawPreview = false;
+        while (true) {
+            int rowsDecoded = 0;
+            const SkCodec::Result result = partialCodec->incrementalDecode(&rowsDecoded);
+            if (result == SkCodec::kSuccess) {
+                break;
+            }
+
+            REPORTER_ASSERT(r, result == SkCodec::kIncompleteInput);
+            REPORTER_ASSERT(r, rowsDecoded == 0 || rowsDecoded == info.height());
+            sawPreview |= rowsDecoded == info.height();
+
+            if (stream->isAllDataReceived()) {
+                ERRORF(r, "Failed to completely decode %s", path);
+                break;
+            }
+            stream->addNewData(increment);
+        }
+
+        REPORTER_ASSERT(r, sawPreview);
+        compare_bitmaps(r, truth, incremental);
+    }
+}
+
 // Verify that when decoding an animated gif byte by byte we report the correct
 // fRequiredFrame as soon as getFrameInfo reports the frame.
 DEF_TEST(Codec_requiredFrame, r) {
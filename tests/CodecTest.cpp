@@ -18,6 +18,7 @@
 #include "SkColorSpacePriv.h"
 #include "SkData.h"
 #include "SkEncodedImageFormat.h"
+#include "SkExecutor.h"
 #include "SkFrontBufferedStream.h"
 #include "SkImage.h"
 #include "SkImageGenerator.h"
@@ -529,6 +530,54 @@ DEF_TEST(Codec_png, r) {
     check(r, "images/yellow_rose.png", SkISize::Make(400, 301), false, false, true, true);
 }
 
+static void check_strip_decode(skiatest::Reporter* r, SkExecutor* executor, const char* path,
+                               size_t truncatedLength = 0) {
+    sk_sp<SkData> data(GetResourceAsData(path));
+    if (!data) {
+        return;
+    }
+    if (truncatedLength) {
+        data = SkData::MakeSubset(data.get(), 0, truncatedLength);
+    }
+
+    auto decode = [&](SkBitmap* bm, SkExecutor* exec) {
+        std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(data));
+        if (!codec) {
+            ERRORF(r, "Unable to create codec for %s", path);
+            return SkCodec::kInvalidInput;
+        }
+        bm->allocPixels(codec->getInfo().makeColorType(kN32_SkColorType));
+        SkCodec::Options opts;
+        opts.fExecutor = exec;
+        return codec->getPixels(bm->pixmap(), &opts);
+    };
+
+    SkBitmap serial, strips;
+    const SkCodec::Result serialResult = decode(&serial, nullptr);
+    const SkCodec::Result stripsResult = decode(&strips, executor);
+    REPORTER_ASSERT(r, serialResult == stripsResult, "%s", path);
+    if (serialResult != SkCodec::kSuccess && serialResult != SkCodec::kIncompleteInput) {
+        return;
+    }
+    SkMD5::Digest serialDigest;
+    md5(serial, &serialDigest);
+    compare_to_good_digest(r, serialDigest, strips);
+}
+
+DEF_TEST(Codec_decodeInStrips, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    check_strip_decode(r, executor.get(), "images/mandrill_512_q075.jpg");
+    check_strip_decode(r, executor.get(), "images/mandrill_512.png");
+    check_strip_decode(r, executor.get(), "images/CMYK.jpg");
+    check_strip_decode(r, executor.get(), "images/yellow_rose.png");
+    // Too short to split, and interlaced, so these take the serial path.
+    check_strip_decode(r, executor.get(), "images/plane_interlaced.png");
+    check_strip_decode(r, executor.get(), "images/color_wheel.jpg");
+    // A strip that runs out of data falls back to the serial decode, which fills the rest.
+    check_strip_decode(r, executor.get(), "images/mandrill_512_q075.jpg", 20000);
+    check_strip_decode(r, executor.get(), "images/mandrill_512.png", 200000);
+}
+
 // Disable RAW tests for Win32.
 #if defined(SK_CODEC_DECODES_RAW) && (!defined(_WIN32))
 DEF_TEST(Codec_raw, r) {
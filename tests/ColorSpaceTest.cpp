@@ -191,6 +191,35 @@ DEF_TEST(ColorSpace_Equals, r) {
     REPORTER_ASSERT(r, !SkColorSpace::Equals(srgb.get(), rgb4.get()));
 }
 
+DEF_TEST(ColorSpace_Intern, r) {
+    // Identical profiles should share one SkColorSpace, so images from one source share it too.
+    auto parse = [&](const char* path) {
+        sk_sp<SkData> data = GetResourceAsData(path);
+        skcms_ICCProfile profile;
+        REPORTER_ASSERT(r, skcms_Parse(data->data(), data->size(), &profile));
+        return SkColorSpace::Make(profile);
+    };
+    sk_sp<SkColorSpace> z30a = parse("icc_profiles/HP_ZR30w.icc"),
+                        z30b = parse("icc_profiles/HP_ZR30w.icc"),
+                        z32  = parse("icc_profiles/HP_Z32x.icc");
+    REPORTER_ASSERT(r, z30a && z30a == z30b);
+    REPORTER_ASSERT(r, z32 && z32 != z30a);
+
+    skcms_Matrix3x3 toXYZ = {{
+        { 0.5f, 0.25f, 0.25f },
+        { 0.25f, 0.5f, 0.25f },
+        { 0.25f, 0.25f, 0.5f },
+    }};
+    sk_sp<SkColorSpace> a = SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2, toXYZ),
+                        b = SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2, toXYZ);
+    REPORTER_ASSERT(r, a && a == b);
+
+    toXYZ.vals[0][0] = 0.5f + 1.0f/1024;
+    sk_sp<SkColorSpace> c = SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2, toXYZ);
+    REPORTER_ASSERT(r, c && c != a);
+    REPORTER_ASSERT(r, !SkColorSpace::Equals(a.get(), c.get()));
+}
+
 static inline bool matrix_almost_equal(const skcms_Matrix3x3& a, const skcms_Matrix3x3& b) {
     for (int r = 0; r < 3; ++r) {
         for (int c = 0; c < 3; ++c) {
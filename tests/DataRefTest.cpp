@@ -328,6 +328,33 @@ DEF_TEST(RWBuffer_size, r) {
     REPORTER_ASSERT(r, 0 == iter.size());
 }
 
+// Stream snapshots can be peeked across blocks, and expose their memory when it is contiguous.
+DEF_TEST(RWBuffer_streamPeek, r) {
+    SkRWBuffer buffer;
+    buffer.append(gABC, 26);
+    {
+        std::unique_ptr<SkStreamAsset> stream(buffer.makeStreamSnapshot());
+        REPORTER_ASSERT(r, stream->getMemoryBase());
+        REPORTER_ASSERT(r, !memcmp(stream->getMemoryBase(), gABC, 26));
+    }
+
+    // Spill into more blocks (the default capacity is 4096).
+    for (int i = 0; i < 400; ++i) {
+        buffer.append(gABC, 26);
+    }
+    std::unique_ptr<SkStreamAsset> stream(buffer.makeStreamSnapshot());
+    REPORTER_ASSERT(r, !stream->getMemoryBase());
+
+    char peeked[260], read[260];
+    while (!stream->isAtEnd()) {
+        size_t bytesPeeked = stream->peek(peeked, sizeof(peeked));
+        size_t bytesRead   = stream->read(read, sizeof(read));
+        REPORTER_ASSERT(r, bytesPeeked == bytesRead);
+        REPORTER_ASSERT(r, !memcmp(peeked, read, bytesRead));
+    }
+    REPORTER_ASSERT(r, 0 == stream->peek(peeked, sizeof(peeked)));
+}
+
 // Tests that operations (including the destructor) are safe on an SkRWBuffer
 // without any data appended.
 DEF_TEST(RWBuffer_noAppend, r) {
@@ -963,6 +963,55 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(DDLMultipleDDLs, reporter, ctxInfo) {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Check that a retained DDL can be drawn on several frames and that a DDL that isn't retained
+// can't be drawn again once it has been flushed
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(DDLRetainedReplay, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+
+    SkImageInfo ii = SkImageInfo::MakeN32Premul(32, 32);
+    sk_sp<SkSurface> s = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, ii);
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(ii);
+
+    SkSurfaceCharacterization characterization;
+    SkAssertResult(s->characterize(&characterization));
+
+    SkDeferredDisplayListRecorder recorder(characterization);
+
+    SkPaint p;
+    p.setColor(SK_ColorGREEN);
+    recorder.getCanvas()->drawRect(SkRect::MakeXYWH(0, 0, 16, 32), p);
+    std::unique_ptr<SkDeferredDisplayList> retained =
+            recorder.detach(SkDeferredDisplayListRecorder::Retain::kYes);
+
+    recorder.getCanvas()->drawRect(SkRect::MakeXYWH(16, 0, 16, 32), p);
+    std::unique_ptr<SkDeferredDisplayList> once = recorder.detach();
+
+    REPORTER_ASSERT(reporter, s->draw(once.get()));
+    s->flush();
+    REPORTER_ASSERT(reporter, !s->draw(once.get()));
+
+    for (int frame = 0; frame < 3; ++frame) {
+        s->getCanvas()->clear(SK_ColorRED);
+        REPORTER_ASSERT(reporter, s->draw(retained.get()));
+        s->flush();
+
+        s->readPixels(ii, bitmap.getPixels(), bitmap.rowBytes(), 0, 0);
+        for (int y = 0; y < 32; ++y) {
+            for (int x = 0; x < 32; ++x) {
+                SkColor expected = x < 16 ? SK_ColorGREEN : SK_ColorRED;
+                if (bitmap.getColor(x, y) != expected) {
+                    ERRORF(reporter, "frame %d: expected 0x%08x at (%d, %d), got 0x%08x", frame,
+                           expected, x, y, bitmap.getColor(x, y));
+                    return; // we only really need to report the error once
+                }
+            }
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Check that the texture-specific flags (i.e., for external & rectangle textures) work
 // for promise images. As such, this is a GL-only test.
@@ -55,6 +55,34 @@ DEF_TEST(DiscardableMemory_global, reporter) {
     test_dm(reporter, dm.get(), false);
 }
 
+DEF_TEST(DiscardableMemory_globalPages, reporter) {
+    // Spans several pages, and ends partway through one.
+    constexpr size_t kBytes = 3 * 4096 + 100;
+    std::unique_ptr<SkDiscardableMemory> dm(SkDiscardableMemory::Create(kBytes));
+    REPORTER_ASSERT(reporter, dm);
+    if (!dm) {
+        return;
+    }
+    uint8_t* ptr = static_cast<uint8_t*>(dm->data());
+    for (size_t i = 0; i < kBytes; i++) {
+        ptr[i] = (uint8_t)(7 * i + 3);
+    }
+    dm->unlock();
+
+    // The memory may have been reclaimed, but if lock() succeeds, every byte must be intact.
+    if (!dm->lock()) {
+        return;
+    }
+    ptr = static_cast<uint8_t*>(dm->data());
+    for (size_t i = 0; i < kBytes; i++) {
+        if (ptr[i] != (uint8_t)(7 * i + 3)) {
+            ERRORF(reporter, "byte %d changed while unlocked", (int)i);
+            break;
+        }
+    }
+    dm->unlock();
+}
+
 DEF_TEST(DiscardableMemory_nonglobal, reporter) {
     sk_sp<SkDiscardableMemoryPool> pool(
         SkDiscardableMemoryPool::Make(1024));
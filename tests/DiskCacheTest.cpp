@@ -0,0 +1,63 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "DiskCache.h"
+#include "SkExecutor.h"
+#include "SkOSPath.h"
+
+#include "Test.h"
+
+static sk_sp<SkData> make_data(const char* str) {
+    return SkData::MakeWithCString(str);
+}
+
+DEF_TEST(DiskCache, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    SkString path = SkOSPath::Join(tmpDir.c_str(), "disk_cache_test");
+    remove(path.c_str());
+
+    {
+        sk_gpu_test::DiskCache cache(path.c_str(), "tag");
+        REPORTER_ASSERT(reporter, !cache.load(*make_data("a")));
+        cache.store(*make_data("a"), *make_data("apple"));
+        cache.store(*make_data("bb"), *make_data("banana"));
+        REPORTER_ASSERT(reporter, cache.flush());
+    }
+
+    {
+        // Entries written by one cache are visible to the next, even when read in the background.
+        std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(1);
+        sk_gpu_test::DiskCache cache(path.c_str(), "tag");
+        cache.prefetch(executor.get());
+        REPORTER_ASSERT(reporter, cache.numEntries() == 2);
+        sk_sp<SkData> value = cache.load(*make_data("bb"));
+        REPORTER_ASSERT(reporter, value && value->equals(make_data("banana").get()));
+        REPORTER_ASSERT(reporter, cache.numCacheMisses() == 0);
+
+        // Add an entry, and make sure flushing preserves the ones we mapped from the file.
+        cache.store(*make_data("c"), *make_data("cherry"));
+    }
+
+    {
+        sk_gpu_test::DiskCache cache(path.c_str(), "tag");
+        REPORTER_ASSERT(reporter, cache.numEntries() == 3);
+        sk_sp<SkData> value = cache.load(*make_data("a"));
+        REPORTER_ASSERT(reporter, value && value->equals(make_data("apple").get()));
+    }
+
+    {
+        // A different version tag invalidates the file.
+        sk_gpu_test::DiskCache cache(path.c_str(), "other tag");
+        REPORTER_ASSERT(reporter, cache.numEntries() == 0);
+        REPORTER_ASSERT(reporter, !cache.load(*make_data("a")));
+    }
+
+    remove(path.c_str());
+}
@@ -146,24 +146,27 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(BasicDrawOpAtlas, reporter, ctxInfo) {
                                                 kAtlasSize/kNumPlots, kAtlasSize/kNumPlots,
                                                 GrDrawOpAtlas::AllowMultitexturing::kYes,
                                                 EvictionFunc, nullptr);
-    check(reporter, atlas.get(), 0, 4, 0);
+    // Multitextured atlases get between four and eight pages, depending on the sampler count.
+    uint32_t maxPages = atlas->maxPages();
+    REPORTER_ASSERT(reporter, maxPages >= 4 && maxPages <= 8);
+    check(reporter, atlas.get(), 0, maxPages, 0);
 
     // Fill up the first level
     GrDrawOpAtlas::AtlasID atlasIDs[kNumPlots * kNumPlots];
     for (int i = 0; i < kNumPlots * kNumPlots; ++i) {
         bool result = fill_plot(atlas.get(), resourceProvider, &uploadTarget, &atlasIDs[i], i*32);
         REPORTER_ASSERT(reporter, result);
-        check(reporter, atlas.get(), 1, 4, 1);
+        check(reporter, atlas.get(), 1, maxPages, 1);
     }
 
     atlas->instantiate(&onFlushResourceProvider);
-    check(reporter, atlas.get(), 1, 4, 1);
+    check(reporter, atlas.get(), 1, maxPages, 1);
 
     // Force allocation of a second level
     GrDrawOpAtlas::AtlasID atlasID;
     bool result = fill_plot(atlas.get(), resourceProvider, &uploadTarget, &atlasID, 4*32);
     REPORTER_ASSERT(reporter, result);
-    check(reporter, atlas.get(), 2, 4, 2);
+    check(reporter, atlas.get(), 2, maxPages, 2);
 
     // Simulate a lot of draws using only the first plot. The last texture should be compacted.
     for (int i = 0; i < 512; ++i) {
@@ -173,7 +176,84 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(BasicDrawOpAtlas, reporter, ctxInfo) {
         atlas->compact(uploadTarget.tokenTracker()->nextTokenToFlush());
     }
 
-    check(reporter, atlas.get(), 1, 4, 1);
+    check(reporter, atlas.get(), 1, maxPages, 1);
+}
+
+struct RelocationData {
+    GrDrawOpAtlas::AtlasID fID;
+    int fEvictions = 0;
+    int fRelocations = 0;
+};
+
+static void relocation_test_evict(GrDrawOpAtlas::AtlasID atlasID, void* ptr) {
+    auto data = static_cast<RelocationData*>(ptr);
+    SkASSERT(atlasID != data->fID);
+    ++data->fEvictions;
+}
+
+static void relocation_test_relocate(GrDrawOpAtlas::AtlasID oldID, GrDrawOpAtlas::AtlasID newID,
+                                     int dx, int dy, void* ptr) {
+    auto data = static_cast<RelocationData*>(ptr);
+    if (oldID == data->fID) {
+        data->fID = newID;
+    }
+    ++data->fRelocations;
+}
+
+// Verifies that compaction moves a plot that is still in use out of the last page, rather than
+// evicting it, when the atlas's client can follow the move.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(DrawOpAtlasRelocation, reporter, ctxInfo) {
+    auto context = ctxInfo.grContext();
+    auto proxyProvider = context->contextPriv().proxyProvider();
+    auto resourceProvider = context->contextPriv().resourceProvider();
+    auto drawingManager = context->contextPriv().drawingManager();
+
+    GrOnFlushResourceProvider onFlushResourceProvider(drawingManager);
+    TestingUploadTarget uploadTarget;
+
+    GrBackendFormat format =
+            context->contextPriv().caps()->getBackendFormatFromColorType(kAlpha_8_SkColorType);
+
+    RelocationData data;
+    std::unique_ptr<GrDrawOpAtlas> atlas = GrDrawOpAtlas::Make(
+                                                proxyProvider,
+                                                format,
+                                                kAlpha_8_GrPixelConfig,
+                                                kAtlasSize, kAtlasSize,
+                                                kAtlasSize/kNumPlots, kAtlasSize/kNumPlots,
+                                                GrDrawOpAtlas::AllowMultitexturing::kYes,
+                                                relocation_test_evict, &data,
+                                                relocation_test_relocate);
+    uint32_t maxPages = atlas->maxPages();
+
+    // Fill up the first page, then put one more plot on a second page.
+    GrDrawOpAtlas::AtlasID atlasIDs[kNumPlots * kNumPlots];
+    for (int i = 0; i < kNumPlots * kNumPlots; ++i) {
+        REPORTER_ASSERT(reporter, fill_plot(atlas.get(), resourceProvider, &uploadTarget,
+                                            &atlasIDs[i], i*32));
+    }
+    atlas->instantiate(&onFlushResourceProvider);
+    REPORTER_ASSERT(reporter, fill_plot(atlas.get(), resourceProvider, &uploadTarget, &data.fID,
+                                        4*32));
+    check(reporter, atlas.get(), 2, maxPages, 2);
+    REPORTER_ASSERT(reporter, 1 == GrDrawOpAtlas::GetPageIndexFromID(data.fID));
+
+    // Keep using the first plot and the second page's plot. Once the other plots on the first
+    // page age out, the second page's plot moves into one of them and the second page goes away.
+    for (int i = 0; i < 512; ++i) {
+        atlas->instantiate(&onFlushResourceProvider);
+        atlas->setLastUseToken(atlasIDs[0], uploadTarget.tokenTracker()->nextDrawToken());
+        atlas->setLastUseToken(data.fID, uploadTarget.tokenTracker()->nextDrawToken());
+        uploadTarget.issueDrawToken();
+        uploadTarget.flushToken();
+        atlas->compact(uploadTarget.tokenTracker()->nextTokenToFlush());
+    }
+
+    check(reporter, atlas.get(), 1, maxPages, 1);
+    REPORTER_ASSERT(reporter, 1 == data.fRelocations);
+    REPORTER_ASSERT(reporter, atlas->hasID(data.fID));
+    REPORTER_ASSERT(reporter, atlas->hasID(atlasIDs[0]));
+    REPORTER_ASSERT(reporter, 0 == GrDrawOpAtlas::GetPageIndexFromID(data.fID));
 }
 
 // This test verifies that the GrAtlasTextOp::onPrepare method correctly handles a failure
@@ -9,6 +9,7 @@
 #include "SkCanvas.h"
 #include "SkColor.h"
 #include "SkDashPathEffect.h"
+#include "SkExecutor.h"
 #include "SkImageInfo.h"
 #include "SkMatrix.h"
 #include "SkPaint.h"
@@ -16,9 +17,11 @@
 #include "SkPathEffect.h"
 #include "SkPoint.h"
 #include "SkRRect.h"
+#include "SkRandom.h"
 #include "SkRect.h"
 #include "SkRefCnt.h"
 #include "SkScalar.h"
+#include "SkScan.h"
 #include "SkStrokeRec.h"
 #include "SkSurface.h"
 #include "SkTypes.h"
@@ -371,3 +374,53 @@ DEF_TEST(DrawPath, reporter) {
     test_big_aa_rect(reporter);
     test_halfway();
 }
+
+static SkBitmap draw_daa_path(const SkPath& path, const SkRect* clip) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(320, 320);
+    bitmap.eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(bitmap);
+    if (clip) {
+        canvas.clipRect(*clip);
+    }
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    canvas.drawPath(path, paint);
+    return bitmap;
+}
+
+// Filling a very large path in bands on gSkDAAExecutor should match filling it in one go.
+DEF_TEST(DrawPath_DAABands, reporter) {
+    SkRandom rand;
+    SkPath path;
+    path.moveTo(160, 160);
+    for (int i = 0; i < 20000; ++i) {
+        if (i % 8) {
+            path.lineTo(rand.nextRangeScalar(5, 315), rand.nextRangeScalar(5, 315));
+        } else {
+            path.quadTo(rand.nextRangeScalar(5, 315), rand.nextRangeScalar(5, 315),
+                        rand.nextRangeScalar(5, 315), rand.nextRangeScalar(5, 315));
+        }
+    }
+    path.close();
+
+    // This path is complex enough that DAA fills it by default. We leave gSkForceDeltaAA alone
+    // since other tests may be drawing concurrently. They may also pick up the executor while it
+    // is set, so it has to outlive them.
+    static std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    const SkRect clip = SkRect::MakeLTRB(20.5f, 37.25f, 290, 300);
+    for (const SkRect* c : {(const SkRect*)nullptr, &clip}) {
+        SkBitmap expected = draw_daa_path(path, c);
+        gSkDAAExecutor = executor.get();
+        SkBitmap banded = draw_daa_path(path, c);
+        gSkDAAExecutor = nullptr;
+
+        bool match = true;
+        for (int y = 0; y < expected.height() && match; ++y) {
+            match = 0 == memcmp(expected.getAddr32(0, y), banded.getAddr32(0, y),
+                                expected.width() * sizeof(SkPMColor));
+        }
+        REPORTER_ASSERT(reporter, match);
+    }
+}
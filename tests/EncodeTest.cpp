@@ -11,6 +11,7 @@
 #include "SkBitmap.h"
 #include "SkColorPriv.h"
 #include "SkEncodedImageFormat.h"
+#include "SkExecutor.h"
 #include "SkImage.h"
 #include "SkJpegEncoder.h"
 #include "SkPngEncoder.h"
@@ -172,6 +173,95 @@ DEF_TEST(Encode_JpegDownsample, r) {
     REPORTER_ASSERT(r, almost_equals(bm1, bm2, 60));
 }
 
+DEF_TEST(Encode_JpegExecutor, r) {
+    SkBitmap bitmap;
+    bool success = GetResourceAsBitmap("images/mandrill_512.png", &bitmap);
+    if (!success) {
+        return;
+    }
+
+    SkPixmap src;
+    success = bitmap.peekPixels(&src);
+    REPORTER_ASSERT(r, success);
+    if (!success) {
+        return;
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (auto downsample : { SkJpegEncoder::Downsample::k420, SkJpegEncoder::Downsample::k422,
+                             SkJpegEncoder::Downsample::k444 }) {
+        SkJpegEncoder::Options options;
+        options.fDownsample = downsample;
+
+        SkDynamicMemoryWStream dst0, dst1;
+        success = SkJpegEncoder::Encode(&dst0, src, options);
+        REPORTER_ASSERT(r, success);
+
+        // The image is large enough to be split into several stripes.
+        options.fExecutor = executor.get();
+        success = SkJpegEncoder::Encode(&dst1, src, options);
+        REPORTER_ASSERT(r, success);
+
+        sk_sp<SkImage> image0 = SkImage::MakeFromEncoded(dst0.detachAsData());
+        sk_sp<SkImage> image1 = SkImage::MakeFromEncoded(dst1.detachAsData());
+        REPORTER_ASSERT(r, image0 && image1);
+        if (!image0 || !image1) {
+            continue;
+        }
+        SkBitmap bm0, bm1;
+        image0->asLegacyBitmap(&bm0);
+        image1->asLegacyBitmap(&bm1);
+        REPORTER_ASSERT(r, almost_equals(bm0, bm1, 0));
+    }
+}
+
+DEF_TEST(Encode_JpegYUV420, r) {
+    // A gradient in Y, with constant chroma, and sizes that are not a multiple of the MCU size.
+    constexpr int kWidth = 75, kHeight = 37;
+    SkBitmap y, u, v;
+    y.allocPixels(SkImageInfo::Make(kWidth, kHeight, kGray_8_SkColorType, kOpaque_SkAlphaType));
+    u.allocPixels(SkImageInfo::Make((kWidth + 1) / 2, (kHeight + 1) / 2,
+                                    kGray_8_SkColorType, kOpaque_SkAlphaType));
+    v.allocPixels(u.info());
+    for (int j = 0; j < kHeight; ++j) {
+        for (int i = 0; i < kWidth; ++i) {
+            *y.getAddr8(i, j) = (uint8_t)(3 * i + j);
+        }
+    }
+    u.eraseColor(SkColorSetARGB(0xFF, 0x80, 0x80, 0x80));
+    v.eraseColor(SkColorSetARGB(0xFF, 0x80, 0x80, 0x80));
+
+    SkPixmap planes[3];
+    REPORTER_ASSERT(r, y.peekPixels(&planes[0]) && u.peekPixels(&planes[1]) &&
+                       v.peekPixels(&planes[2]));
+
+    SkDynamicMemoryWStream dst;
+    bool success = SkJpegEncoder::EncodeYUV420(&dst, planes, SkJpegEncoder::Options());
+    REPORTER_ASSERT(r, success);
+
+    sk_sp<SkImage> image = SkImage::MakeFromEncoded(dst.detachAsData());
+    REPORTER_ASSERT(r, image && kWidth == image->width() && kHeight == image->height());
+    if (!image) {
+        return;
+    }
+
+    // With neutral chroma, each decoded channel is the luma.
+    SkBitmap expected, decoded;
+    expected.allocN32Pixels(kWidth, kHeight);
+    for (int j = 0; j < kHeight; ++j) {
+        for (int i = 0; i < kWidth; ++i) {
+            uint8_t l = *y.getAddr8(i, j);
+            *expected.getAddr32(i, j) = SkPackARGB32(0xFF, l, l, l);
+        }
+    }
+    image->asLegacyBitmap(&decoded);
+    REPORTER_ASSERT(r, almost_equals(expected, decoded, 8));
+
+    // Mismatched chroma planes are rejected.
+    planes[1] = SkPixmap(y.info(), y.getPixels(), y.rowBytes());
+    REPORTER_ASSERT(r, !SkJpegEncoder::EncodeYUV420(&dst, planes, SkJpegEncoder::Options()));
+}
+
 static inline void pushComment(
         std::vector<std::string>& comments, const char* keyword, const char* text) {
     comments.push_back(keyword);
@@ -286,6 +376,55 @@ DEF_TEST(Encode_PngOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 0));
 }
 
+DEF_TEST(Encode_PngExecutor, r) {
+    SkBitmap bitmap;
+    bool success = GetResourceAsBitmap("images/mandrill_512.png", &bitmap);
+    if (!success) {
+        return;
+    }
+
+    SkPixmap src;
+    success = bitmap.peekPixels(&src);
+    REPORTER_ASSERT(r, success);
+    if (!success) {
+        return;
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (auto filters : { SkPngEncoder::FilterFlag::kAll, SkPngEncoder::FilterFlag::kNone,
+                          SkPngEncoder::FilterFlag::kSub, SkPngEncoder::FilterFlag::kUp,
+                          SkPngEncoder::FilterFlag::kPaeth }) {
+        SkPngEncoder::Options options;
+        options.fFilterFlags = filters;
+        options.fExecutor = executor.get();
+
+        // The image is large enough to be split into several bands, and is encoded in two
+        // encodeRows() calls to cover continuing the stream across calls.
+        SkDynamicMemoryWStream dst0, dst1;
+        success = SkPngEncoder::Encode(&dst0, src, options);
+        REPORTER_ASSERT(r, success);
+
+        auto encoder = SkPngEncoder::Make(&dst1, src, options);
+        REPORTER_ASSERT(r, encoder);
+        if (!encoder) {
+            continue;
+        }
+        success = encoder->encodeRows(100) && encoder->encodeRows(src.height());
+        REPORTER_ASSERT(r, success);
+
+        for (auto* dst : { &dst0, &dst1 }) {
+            sk_sp<SkImage> image = SkImage::MakeFromEncoded(dst->detachAsData());
+            REPORTER_ASSERT(r, image);
+            if (!image) {
+                continue;
+            }
+            SkBitmap decoded;
+            image->asLegacyBitmap(&decoded);
+            REPORTER_ASSERT(r, almost_equals(bitmap, decoded, 0));
+        }
+    }
+}
+
 DEF_TEST(Encode_WebpOptions, r) {
     SkBitmap bitmap;
     bool success = GetResourceAsBitmap("images/google_chrome.ico", &bitmap);
@@ -337,4 +476,12 @@ DEF_TEST(Encode_WebpOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm1, 0));
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 90));
     REPORTER_ASSERT(r, almost_equals(bm2, bm3, 50));
+
+    // Threading must not change the lossy encode.
+    SkDynamicMemoryWStream dst4;
+    options.fUseThreads = true;
+    success = SkWebpEncoder::Encode(&dst4, src, options);
+    REPORTER_ASSERT(r, success);
+    sk_sp<SkData> data4 = dst4.detachAsData();
+    REPORTER_ASSERT(r, data4->equals(data3.get()));
 }
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkExecutor.h"
+#include "SkMutex.h"
+#include "SkSemaphore.h"
+#include "SkTArray.h"
+#include "SkTaskGroup.h"
+
+#include "Test.h"
+
+#include <atomic>
+
+DEF_TEST(SkExecutor_WorkStealing_Batch, r) {
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeWorkStealingThreadPool(4);
+
+    std::atomic<int> sum{0};
+    SkTaskGroup tg(*pool);
+    tg.batch(1000, [&](int i) { sum.fetch_add(i, std::memory_order_relaxed); });
+    tg.wait();
+
+    REPORTER_ASSERT(r, sum.load() == 999*1000/2);
+}
+
+DEF_TEST(SkExecutor_WorkStealing_Nested, r) {
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeWorkStealingThreadPool(4);
+
+    // Work added from inside the pool lands on the adding thread's own deque,
+    // and must still be found by waiting (and stealing) threads.
+    std::atomic<int> count{0};
+    SkTaskGroup outer(*pool);
+    outer.batch(64, [&](int) {
+        SkTaskGroup inner(*pool);
+        inner.batch(256, [&](int) { count.fetch_add(1, std::memory_order_relaxed); });
+        inner.wait();
+    });
+    outer.wait();
+
+    REPORTER_ASSERT(r, count.load() == 64*256);
+}
+
+DEF_TEST(SkExecutor_WorkStealing_DestroyIdle, r) {
+    // Creating and destroying a pool that never saw any work should not hang.
+    for (int i = 0; i < 8; i++) {
+        SkExecutor::MakeWorkStealingThreadPool(3);
+    }
+}
+
+// Blocks the only thread of a pool until released, so that work piles up behind it.
+struct BlockedPool {
+    explicit BlockedPool(std::unique_ptr<SkExecutor> pool) : fPool(std::move(pool)) {
+        fPool->add([this] { fReleased.wait(); });
+    }
+    ~BlockedPool() { this->release(); }
+
+    void release() {
+        if (!fWasReleased) {
+            fReleased.signal();
+            fWasReleased = true;
+        }
+    }
+
+    std::unique_ptr<SkExecutor> fPool;
+    SkSemaphore                 fReleased;
+    bool                        fWasReleased = false;
+};
+
+static void test_priorities(skiatest::Reporter* r, std::unique_ptr<SkExecutor> pool) {
+    BlockedPool blocked(std::move(pool));
+
+    SkMutex mutex;
+    SkTArray<SkExecutor::Priority> order;
+    SkTaskGroup tg(*blocked.fPool);
+    for (auto priority : { SkExecutor::Priority::kLow, SkExecutor::Priority::kNormal,
+                           SkExecutor::Priority::kHigh }) {
+        tg.batch(10, [&, priority](int) {
+            SkAutoMutexAcquire lock(mutex);
+            order.push_back(priority);
+        }, priority);
+    }
+    blocked.release();
+    tg.wait();
+
+    REPORTER_ASSERT(r, order.count() == 30);
+    for (int i = 1; i < order.count(); i++) {
+        REPORTER_ASSERT(r, order[i - 1] >= order[i]);
+    }
+}
+
+DEF_TEST(SkExecutor_Priority, r) {
+    test_priorities(r, SkExecutor::MakeFIFOThreadPool(1));
+    test_priorities(r, SkExecutor::MakeLIFOThreadPool(1));
+    test_priorities(r, SkExecutor::MakeWorkStealingThreadPool(1));
+}
+
+DEF_TEST(SkTaskGroup_Cancel, r) {
+    BlockedPool blocked(SkExecutor::MakeFIFOThreadPool(1));
+
+    std::atomic<int> ran{0};
+    SkTaskGroup tg(*blocked.fPool);
+    tg.batch(10, [&](int) { ran.fetch_add(1, std::memory_order_relaxed); });
+    tg.cancel();
+    tg.add([&] { ran.fetch_add(100, std::memory_order_relaxed); });
+    blocked.release();
+    tg.wait();
+
+    // Only the task added after cancel() runs.
+    REPORTER_ASSERT(r, ran.load() == 100);
+}
+
+DEF_TEST(SkTaskGroup_Then, r) {
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeWorkStealingThreadPool(4);
+
+    std::atomic<int> count{0};
+    int seenFirst = -1, seenSecond = -1;
+    SkTaskGroup tg(*pool);
+    tg.batch(100, [&](int) { count.fetch_add(1, std::memory_order_relaxed); });
+    tg.then([&] { seenFirst = count.load(); });
+    tg.batch(100, [&](int) { count.fetch_add(1, std::memory_order_relaxed); });
+    tg.then([&] { seenSecond = count.load(); });
+    tg.wait();
+
+    REPORTER_ASSERT(r, seenFirst >= 100);
+    REPORTER_ASSERT(r, seenSecond == 200);
+
+    // Without threads, then() tasks run as soon as everything before them has.
+    SkTaskGroup serial;
+    int steps = 0;
+    serial.then([&] { steps++; });
+    serial.add([&] { steps++; });
+    serial.then([&] { REPORTER_ASSERT(r, steps == 2); steps++; });
+    REPORTER_ASSERT(r, steps == 3);
+}
@@ -21,4 +21,19 @@ DEF_TEST(FlattenableNameToFactory, r) {
     if (SkFlattenable::NameToFactory("ZZZ-non-existent")) {
         ERRORF(r, "SkFlattenable::NameToFactory() succeeds with ZZZ-non-existent.");
     }
+
+    // Both lookups are table searches; they should agree with each other.
+    for (const char* name : { "SkImageShader", "SkPictureShader", "SkColorShader" }) {
+        SkFlattenable::Factory factory = SkFlattenable::NameToFactory(name);
+        if (!factory) {
+            continue;
+        }
+        const char* found = SkFlattenable::FactoryToName(factory);
+        if (!found || SkFlattenable::NameToFactory(found) != factory) {
+            ERRORF(r, "SkFlattenable::FactoryToName() does not round trip %s.", name);
+        }
+    }
+    if (SkFlattenable::FactoryToName(nullptr)) {
+        ERRORF(r, "SkFlattenable::FactoryToName() succeeds with nullptr.");
+    }
 }
@@ -390,3 +390,33 @@ DEF_TEST(Geometry, reporter) {
     test_classify_cubic(reporter);
     test_cubic_cusps(reporter);
 }
+
+// The batched evaluators must match their one-t counterparts exactly, for odd and even counts.
+DEF_TEST(Geometry_batchedEval, reporter) {
+    SkRandom rand;
+    for (int i = 0; i < 100; ++i) {
+        SkPoint pts[4];
+        for (int j = 0; j < 4; ++j) {
+            pts[j].set(rand.nextSScalar1() * 100, rand.nextSScalar1() * 100);
+        }
+        SkConic conic(pts, rand.nextUScalar1() * 2);
+
+        SkScalar t[33];
+        for (int j = 0; j < 33; ++j) {
+            t[j] = rand.nextUScalar1();
+        }
+        int count = 1 + (i % 33);
+
+        SkPoint quad[33], cubic[33], conics[33];
+        SkEvalQuadAt(pts, t, quad, count);
+        SkEvalCubicAt(pts, t, cubic, count);
+        conic.evalAt(t, conics, count);
+        for (int j = 0; j < count; ++j) {
+            SkPoint p;
+            SkEvalCubicAt(pts, t[j], &p, nullptr, nullptr);
+            REPORTER_ASSERT(reporter, quad[j] == SkEvalQuadAt(pts, t[j]));
+            REPORTER_ASSERT(reporter, cubic[j] == p);
+            REPORTER_ASSERT(reporter, conics[j] == conic.evalAt(t[j]));
+        }
+    }
+}
@@ -835,6 +835,63 @@ class CCPR_cache_partialInvalidate : public CCPRCacheTest {
 };
 DEF_CCPR_TEST(CCPR_cache_partialInvalidate)
 
+// Verifies that an A8 atlas fragmented by evictions gets compacted: its surviving masks are copied
+// into a new atlas and none of them need to be re-rendered.
+class CCPR_cache_compaction : public CCPRCacheTest {
+    void onRun(skiatest::Reporter* reporter, CCPRPathDrawer& ccpr,
+               const RecordLastMockAtlasIDs& atlasIDRecorder) override {
+        SkMatrix m = SkMatrix::MakeScale(20, 20);
+
+        for (int i = 0; i < 3; ++i) {
+            this->drawPathsAndFlush(ccpr, m);
+        }
+        // On draw 3 the masks get copied to an 8-bit atlas.
+        REPORTER_ASSERT(reporter, 0 != atlasIDRecorder.lastCopyAtlasID());
+        REPORTER_ASSERT(reporter, 0 == atlasIDRecorder.lastRenderedAtlasID());
+
+        // Delete 3/5 of the paths. The cache evicts their entries on the next flush, which leaves
+        // the A8 atlas more than 25% empty.
+        for (size_t i = 0; i < SK_ARRAY_COUNT(fPaths); ++i) {
+            if (i % 5 < 3) {
+                fPaths[i].reset();
+            }
+        }
+
+        auto drawSurvivorsAndFlush = [&]() {
+            for (size_t i = 0; i < SK_ARRAY_COUNT(fPaths); ++i) {
+                if (i % 5 >= 3) {
+                    ccpr.drawPath(fPaths[i], m);
+                }
+            }
+            ccpr.flush();
+        };
+
+        // The survivors should be copied out of the fragmented atlas rather than re-rendered.
+        drawSurvivorsAndFlush();
+        REPORTER_ASSERT(reporter, 0 != atlasIDRecorder.lastCopyAtlasID());
+        REPORTER_ASSERT(reporter, 0 == atlasIDRecorder.lastRenderedAtlasID());
+
+        auto cache = ccpr.ccpr()->testingOnly_getPathCache();
+        REPORTER_ASSERT(reporter, cache);
+        int count = 0;
+        for (const GrCCPathCacheEntry* entry : cache->testingOnly_getLRU()) {
+            const GrCCCachedAtlas* cachedAtlas = entry->cachedAtlas();
+            REPORTER_ASSERT(reporter, cachedAtlas);
+            REPORTER_ASSERT(reporter, !cachedAtlas->isCompacting());
+            ++count;
+        }
+        REPORTER_ASSERT(reporter, count == (int)SK_ARRAY_COUNT(fPaths) * 2 / 5);
+
+        // From now on everything should hit the compacted atlas.
+        for (int i = 0; i < 10; ++i) {
+            drawSurvivorsAndFlush();
+            REPORTER_ASSERT(reporter, 0 == atlasIDRecorder.lastCopyAtlasID());
+            REPORTER_ASSERT(reporter, 0 == atlasIDRecorder.lastRenderedAtlasID());
+        }
+    }
+};
+DEF_CCPR_TEST(CCPR_cache_compaction)
+
 class CCPR_unrefPerOpListPathsBeforeOps : public CCPRTest {
     void onRun(skiatest::Reporter* reporter, CCPRPathDrawer& ccpr) override {
         REPORTER_ASSERT(reporter, SkPathPriv::TestingOnly_unique(fPath));
@@ -11,6 +11,7 @@
 #include "GrContextPriv.h"
 #include "GrCaps.h"
 #include "SkExecutor.h"
+#include "SkSurface.h"
 #include "Test.h"
 
 using namespace sk_gpu_test;
@@ -145,3 +146,33 @@ DEF_GPUTEST_FOR_ALL_CONTEXTS(GrContextDump, reporter, ctxInfo) {
     REPORTER_ASSERT(reporter, !result.isEmpty());
 }
 #endif
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(GrContext_readFrameStats, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(
+            context, SkBudgeted::kNo, SkImageInfo::MakeN32Premul(64, 64));
+    if (!surface) {
+        ERRORF(reporter, "Could not create surface.");
+        return;
+    }
+    GrContext::FrameStats stats;
+    context->flush();
+    context->readFrameStats(&stats);
+
+    SkPaint paint;
+    for (int i = 0; i < 8; ++i) {
+        surface->getCanvas()->drawRect(SkRect::MakeXYWH(i * 8, i * 8, 4, 4), paint);
+    }
+    surface->getCanvas()->flush();
+    context->readFrameStats(&stats);
+    REPORTER_ASSERT(reporter, stats.fFlushes >= 1);
+    REPORTER_ASSERT(reporter, stats.fDraws >= 1);
+    // The rects should have been batched.
+    REPORTER_ASSERT(reporter, stats.fOpsMerged >= 1);
+
+    // Reading resets the counts.
+    context->readFrameStats(&stats);
+    REPORTER_ASSERT(reporter, 0 == stats.fFlushes);
+    REPORTER_ASSERT(reporter, 0 == stats.fDraws);
+    REPORTER_ASSERT(reporter, 0 == stats.fOpsMerged);
+}
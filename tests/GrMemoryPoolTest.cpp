@@ -7,6 +7,7 @@
 
 #include "Test.h"
 #include "GrMemoryPool.h"
+#include "ops/GrOp.h"
 #include "SkRandom.h"
 #include "SkTArray.h"
 #include "SkTDArray.h"
@@ -318,3 +319,58 @@ DEF_TEST(GrMemoryPoolAPI, reporter) {
         REPORTER_ASSERT(reporter, pool.size() == hugeBlockSize + kMinAllocSize);
     }
 }
+
+template <int N>
+class TestOp : public GrOp {
+public:
+    DEFINE_OP_CLASS_ID
+
+    const char* name() const override { return "TestOp"; }
+
+private:
+    friend class GrOpMemoryPool; // for ctor
+
+    TestOp() : INHERITED(ClassID()) {}
+
+    void onPrepare(GrOpFlushState*) override {}
+    void onExecute(GrOpFlushState*, const SkRect&) override {}
+
+    char fData[N];
+
+    typedef GrOp INHERITED;
+};
+
+DEF_TEST(GrOpMemoryPool, reporter) {
+    GrOpMemoryPool pool(0, 0);
+
+    // Every other op is released while its block is still in use. New ops of the same size must
+    // reuse that storage rather than grow the pool.
+    SkTArray<std::unique_ptr<GrOp>> ops;
+    for (int i = 0; i < 200; i++) {
+        if (i & 1) {
+            ops.push_back(pool.allocate<TestOp<100>>());
+        } else {
+            ops.push_back(pool.allocate<TestOp<300>>());
+        }
+    }
+    for (int i = 0; i < ops.count(); i += 2) {
+        pool.release(std::move(ops[i]));
+    }
+    REPORTER_ASSERT(reporter, !pool.isEmpty());
+    size_t size = pool.size();
+    for (int i = 0; i < ops.count(); i += 2) {
+        ops[i] = pool.allocate<TestOp<300>>();
+    }
+    REPORTER_ASSERT(reporter, pool.size() == size);
+
+    for (auto& op : ops) {
+        pool.release(std::move(op));
+    }
+    REPORTER_ASSERT(reporter, pool.isEmpty());
+
+    // Ops too big for a size class go straight back to the underlying pool.
+    pool.purgeFreeLists();
+    REPORTER_ASSERT(reporter, pool.size() == 0);
+    pool.release(pool.allocate<TestOp<4000>>());
+    REPORTER_ASSERT(reporter, pool.size() == 0);
+}
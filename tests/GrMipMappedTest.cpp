@@ -319,3 +319,50 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(Gr1x1TextureMipMappedTest, reporter, ctxInfo)
     surface->flush();
 }
 
+
+// Test that textures dirtied earlier in a flush and then sampled together by one opList all have
+// their mips regenerated, now that the drawing manager batches them.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(GrBatchedMipMapRegenerationTest, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    if (!context->contextPriv().caps()->mipMapSupport()) {
+        return;
+    }
+
+    SkImageInfo info = SkImageInfo::MakeN32(kSize, kSize, kPremul_SkAlphaType);
+    sk_sp<SkSurface> dst = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    if (!dst) {
+        return;
+    }
+
+    static constexpr int kTextureCount = 4;
+    sk_sp<SkImage> images[kTextureCount];
+    GrTexture* textures[kTextureCount];
+    for (int i = 0; i < kTextureCount; ++i) {
+        sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info, 0,
+                                                               kTopLeft_GrSurfaceOrigin, nullptr,
+                                                               true);
+        if (!surface) {
+            return;
+        }
+        surface->getCanvas()->clear(SK_ColorRED);
+        images[i] = surface->makeImageSnapshot();
+        GrTextureProxy* proxy = as_IB(images[i])->peekProxy();
+        REPORTER_ASSERT(reporter, proxy && GrMipMapped::kYes == proxy->mipMapped());
+        if (!proxy || !proxy->instantiate(context->contextPriv().resourceProvider())) {
+            return;
+        }
+        textures[i] = proxy->peekTexture();
+    }
+
+    SkPaint paint;
+    paint.setFilterQuality(kMedium_SkFilterQuality);
+    dst->getCanvas()->scale(0.25f, 0.25f);
+    for (int i = 0; i < kTextureCount; ++i) {
+        dst->getCanvas()->drawImage(images[i], SkIntToScalar(i * kSize), 0, &paint);
+    }
+    dst->flush();
+
+    for (int i = 0; i < kTextureCount; ++i) {
+        REPORTER_ASSERT(reporter, !textures[i]->texturePriv().mipMapsAreDirty());
+    }
+}
@@ -80,3 +80,59 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(GrOpListFlushCount, reporter, ctxInfo) {
     REPORTER_ASSERT(reporter, surface2->readPixels(readbackBitmap, 0, 0));
     REPORTER_ASSERT(reporter, check_read(reporter, readbackBitmap));
 }
+
+// Interleaves draws to two surfaces, which records a new opList at each switch, and checks that
+// reordering and merging the opLists of each surface keeps the results intact when the second
+// surface reads the first partway through.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(GrOpListMergeInterleaved, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    static constexpr int kWidth = 10;
+
+    SkImageInfo imageInfo = SkImageInfo::Make(kWidth, 2, kRGBA_8888_SkColorType,
+                                              kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface1 = SkSurface::MakeRenderTarget(context, SkBudgeted::kYes, imageInfo);
+    sk_sp<SkSurface> surface2 = SkSurface::MakeRenderTarget(context, SkBudgeted::kYes, imageInfo);
+    if (!surface1 || !surface2) {
+        return;
+    }
+    SkCanvas* canvas1 = surface1->getCanvas();
+    SkCanvas* canvas2 = surface2->getCanvas();
+    canvas1->clear(SK_ColorRED);
+    canvas2->clear(SK_ColorRED);
+
+    SkPaint green;
+    green.setColor(SK_ColorGREEN);
+    for (int x = 0; x < kWidth; ++x) {
+        canvas1->drawRect(SkRect::MakeXYWH(x, 0, 1, 1), green);
+        canvas2->drawRect(SkRect::MakeXYWH(x, 0, 1, 1), green);
+    }
+    // Copy the first surface's green row into the second row of the second surface, then make
+    // it blue. The blue draws must not move ahead of the copy.
+    sk_sp<SkImage> image = surface1->makeImageSnapshot();
+    canvas2->drawImageRect(image, SkRect::MakeWH(kWidth, 1), SkRect::MakeXYWH(0, 1, kWidth, 1),
+                           nullptr);
+    SkPaint blue;
+    blue.setColor(SK_ColorBLUE);
+    for (int x = 0; x < kWidth; ++x) {
+        canvas1->drawRect(SkRect::MakeXYWH(x, 0, 1, 1), blue);
+        canvas2->drawRect(SkRect::MakeXYWH(x, 0, 1, 1), green);
+    }
+    context->flush();
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(kWidth, 2);
+    auto check = [&](SkSurface* surface, int y, SkColor expected) {
+        REPORTER_ASSERT(reporter, surface->readPixels(bitmap, 0, 0));
+        for (int x = 0; x < kWidth; ++x) {
+            SkColor actual = bitmap.getColor(x, y);
+            if (actual != expected) {
+                ERRORF(reporter, "Expected 0x%08x, but got 0x%08x, at pixel (%d, %d).",
+                       expected, actual, x, y);
+                return;
+            }
+        }
+    };
+    check(surface1.get(), 0, SK_ColorBLUE);
+    check(surface2.get(), 0, SK_ColorGREEN);
+    check(surface2.get(), 1, SK_ColorGREEN);
+}
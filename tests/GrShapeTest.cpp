@@ -2124,6 +2124,43 @@ DEF_TEST(GrShape_short_path_keys, r) {
     compare(pathA, pathB, TestCase::kAllDifferent_ComparisonExpecation);
 }
 
+DEF_TEST(GrShape_dash_cache, r) {
+    SkPaint paint;
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setStrokeWidth(2.f);
+    paint.setPathEffect(make_dash());
+
+    SkPath path;
+    path.moveTo(0.f, 0.f);
+    path.cubicTo(100.f, 0.f, 0.f, 100.f, 100.f, 100.f);
+    path.lineTo(200.f, 0.f);
+    SkPath volatilePath = path;
+    volatilePath.setIsVolatile(true);
+
+    // The first dash of the path goes through the cache, the second is found in it. Both must
+    // match dashing without the cache.
+    GrShape uncached = GrShape(volatilePath, paint).applyStyle(GrStyle::Apply::kPathEffectOnly,
+                                                              1.f);
+    for (int i = 0; i < 2; ++i) {
+        GrShape dashed = GrShape(path, paint).applyStyle(GrStyle::Apply::kPathEffectOnly, 1.f);
+        SkPath dashedPath, uncachedPath;
+        dashed.asPath(&dashedPath);
+        uncached.asPath(&uncachedPath);
+        REPORTER_ASSERT(r, dashedPath == uncachedPath);
+        REPORTER_ASSERT(r, dashed.hasUnstyledKey());
+    }
+
+    // Changing the path must not return its old dashes.
+    path.lineTo(200.f, 200.f);
+    volatilePath = path;
+    volatilePath.setIsVolatile(true);
+    SkPath dashedPath, uncachedPath;
+    GrShape(path, paint).applyStyle(GrStyle::Apply::kPathEffectOnly, 1.f).asPath(&dashedPath);
+    GrShape(volatilePath, paint).applyStyle(GrStyle::Apply::kPathEffectOnly,
+                                            1.f).asPath(&uncachedPath);
+    REPORTER_ASSERT(r, dashedPath == uncachedPath);
+}
+
 DEF_TEST(GrShape, reporter) {
     SkTArray<std::unique_ptr<Geo>> geos;
     SkTArray<std::unique_ptr<RRectPathGeo>> rrectPathGeos;
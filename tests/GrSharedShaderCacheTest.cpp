@@ -0,0 +1,53 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrSharedShaderCache.h"
+#include "MemoryCache.h"
+
+#include "Test.h"
+
+static sk_sp<SkData> make_data(const char* str) {
+    return SkData::MakeWithCString(str);
+}
+
+static bool data_equals(const sk_sp<SkData>& data, const char* str) {
+    return data && data->equals(make_data(str).get());
+}
+
+DEF_TEST(GrSharedShaderCache, reporter) {
+    // The table is process-wide, so use scopes no other test does.
+    static constexpr uint32_t kScope = 0x5a4e0001;
+    static constexpr uint32_t kOtherScope = 0x5a4e0002;
+
+    sk_gpu_test::MemoryCache clientCacheA, clientCacheB, clientCacheC;
+    GrSharedShaderCache cacheA(kScope, &clientCacheA);
+    GrSharedShaderCache cacheB(kScope, &clientCacheB);
+    GrSharedShaderCache cacheC(kOtherScope, &clientCacheC);
+
+    // Stores reach the shared table and the storing context's own cache.
+    cacheA.store(*make_data("program"), *make_data("glsl"));
+    REPORTER_ASSERT(reporter, data_equals(clientCacheA.load(*make_data("program")), "glsl"));
+
+    // A context with the same scope finds it without asking its own cache.
+    clientCacheB.resetNumCacheMisses();
+    REPORTER_ASSERT(reporter, data_equals(cacheB.load(*make_data("program")), "glsl"));
+    REPORTER_ASSERT(reporter, 0 == clientCacheB.numCacheMisses());
+
+    // Other scopes don't see it.
+    REPORTER_ASSERT(reporter, !cacheC.load(*make_data("program")));
+    REPORTER_ASSERT(reporter, 1 == clientCacheC.numCacheMisses());
+
+    // Entries loaded from one context's cache are shared with the rest of the scope.
+    clientCacheC.store(*make_data("binary"), *make_data("bits"));
+    REPORTER_ASSERT(reporter, data_equals(cacheC.load(*make_data("binary")), "bits"));
+    GrSharedShaderCache cacheD(kOtherScope, nullptr);
+    REPORTER_ASSERT(reporter, data_equals(cacheD.load(*make_data("binary")), "bits"));
+
+    // Storing again replaces the shared entry.
+    cacheB.store(*make_data("program"), *make_data("glsl2"));
+    REPORTER_ASSERT(reporter, data_equals(cacheA.load(*make_data("program")), "glsl2"));
+}
@@ -70,6 +70,17 @@ DEF_GPUTEST_FOR_NULLGL_CONTEXT(GrSurface, reporter, ctxInfo) {
 
 // This test checks that the isConfigTexturable and isConfigRenderable are
 // consistent with createTexture's result.
+// Compressed formats are stored in 4x4 blocks, and partial blocks at the edges take up whole ones.
+DEF_TEST(GrCompressedFormatDataSize, reporter) {
+    REPORTER_ASSERT(reporter, 8 == GrCompressedFormatDataSize(kRGB_ETC1_GrPixelConfig, 4, 4));
+    REPORTER_ASSERT(reporter, 32 == GrCompressedFormatDataSize(kRGBA_BC1_GrPixelConfig, 5, 7));
+    REPORTER_ASSERT(reporter, 16 == GrCompressedFormatDataSize(kRGBA_ETC2_GrPixelConfig, 1, 1));
+    REPORTER_ASSERT(reporter,
+                    16 * 4 * 2 == GrCompressedFormatDataSize(kRGBA_ASTC_4x4_GrPixelConfig, 16, 8));
+    REPORTER_ASSERT(reporter, 16 * 9 == GrCompressedFormatDataSize(kRGBA_BC3_GrPixelConfig, 9, 9));
+    REPORTER_ASSERT(reporter, 16 * 4 == GrCompressedFormatDataSize(kRGBA_BC7_GrPixelConfig, 8, 8));
+}
+
 DEF_GPUTEST_FOR_ALL_CONTEXTS(GrSurfaceRenderability, reporter, ctxInfo) {
     GrContext* context = ctxInfo.grContext();
     GrProxyProvider* proxyProvider = context->contextPriv().proxyProvider();
@@ -99,6 +110,11 @@ DEF_GPUTEST_FOR_ALL_CONTEXTS(GrSurfaceRenderability, reporter, ctxInfo) {
         kAlpha_half_as_Red_GrPixelConfig,
         kRGBA_half_GrPixelConfig,
         kRGB_ETC1_GrPixelConfig,
+        kRGBA_ETC2_GrPixelConfig,
+        kRGBA_ASTC_4x4_GrPixelConfig,
+        kRGBA_BC1_GrPixelConfig,
+        kRGBA_BC3_GrPixelConfig,
+        kRGBA_BC7_GrPixelConfig,
     };
     GR_STATIC_ASSERT(kGrPixelConfigCnt == SK_ARRAY_COUNT(configs));
 
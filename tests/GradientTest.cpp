@@ -8,6 +8,7 @@
 #include "SkCanvas.h"
 #include "SkColorPriv.h"
 #include "SkColorShader.h"
+#include "SkGradientLUT.h"
 #include "SkGradientShader.h"
 #include "SkShader.h"
 #include "SkSurface.h"
@@ -538,6 +539,67 @@ static void test_sweep_fuzzer(skiatest::Reporter*) {
     }
 }
 
+// Gradients with many colors are sampled from a cached LUT when drawn into 8888. Check that against
+// the stops evaluated in float, and that the LUT is shared.
+static void test_many_stop_lut(skiatest::Reporter* reporter) {
+    const int kCount = 20;
+    SkColor colors[kCount];
+    SkScalar pos[kCount];
+    for (int i = 0; i < kCount; i++) {
+        colors[i] = SkColorSetARGB(i & 1 ? 0xFF : 0x80, i * 13, 255 - i * 11, (i % 3) * 100);
+        pos[i] = i * i / SkScalar((kCount - 1) * (kCount - 1));
+    }
+    const SkPoint pts[] = {{ 0, 0 }, { 1000, 0 }};
+    sk_sp<SkShader> shaders[] = {
+        SkGradientShader::MakeLinear(pts, colors, pos, kCount, SkShader::kClamp_TileMode),
+        SkGradientShader::MakeLinear(pts, colors, nullptr, kCount, SkShader::kRepeat_TileMode,
+                                     SkGradientShader::kInterpolateColorsInPremul_Flag,
+                                     nullptr),
+    };
+
+    for (const auto& shader : shaders) {
+        SkPaint paint;
+        paint.setShader(shader);
+        paint.setBlendMode(SkBlendMode::kSrc);
+
+        SkBitmap lut, ref;
+        lut.allocN32Pixels(1024, 1);
+        ref.allocPixels(SkImageInfo::Make(1024, 1, kRGBA_F32_SkColorType, kPremul_SkAlphaType));
+        SkCanvas(lut).drawPaint(paint);
+        SkCanvas(ref).drawPaint(paint);
+
+        SkBitmap expected;
+        expected.allocN32Pixels(1024, 1);
+        ref.readPixels(expected.pixmap());
+
+        int maxDiff = 0;
+        for (int x = 0; x < 1024; x++) {
+            SkPMColor a = *lut.getAddr32(x, 0),
+                      b = *expected.getAddr32(x, 0);
+            for (int shift = 0; shift < 32; shift += 8) {
+                maxDiff = SkTMax(maxDiff, SkAbs32(int((a >> shift) & 0xFF) -
+                                                  int((b >> shift) & 0xFF)));
+            }
+        }
+        REPORTER_ASSERT(reporter, maxDiff <= 3, "max diff %d", maxDiff);
+    }
+
+    SkPMColor4f pmColors[kCount];
+    for (int i = 0; i < kCount; i++) {
+        pmColors[i] = SkColor4f::FromColor(colors[i]).premul();
+    }
+    int resolution = SkGradientLUT::ResolutionFor(pos, kCount);
+    REPORTER_ASSERT(reporter, resolution == SkGradientLUT::kFineResolution);
+
+    SkBitmap first, second;
+    SkGradientLUT::Get(pmColors, pos, kCount, resolution, kRGBA_8888_SkColorType,
+                       kPremul_SkAlphaType, &first);
+    SkGradientLUT::Get(pmColors, pos, kCount, resolution, kRGBA_8888_SkColorType,
+                       kPremul_SkAlphaType, &second);
+    REPORTER_ASSERT(reporter, first.width() == resolution && first.isImmutable());
+    REPORTER_ASSERT(reporter, first.getPixels() == second.getPixels());
+}
+
 DEF_TEST(Gradient, reporter) {
     TestGradientShaders(reporter);
     TestGradientOptimization(reporter);
@@ -551,4 +613,5 @@ DEF_TEST(Gradient, reporter) {
     test_degenerate_linear(reporter);
     test_linear_fuzzer(reporter);
     test_sweep_fuzzer(reporter);
+    test_many_stop_lut(reporter);
 }
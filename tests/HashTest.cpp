@@ -7,7 +7,9 @@
 
 #include "SkChecksum.h"
 #include "SkRefCnt.h"
+#include "SkRandom.h"
 #include "SkString.h"
+#include "SkTFlatHash.h"
 #include "SkTHash.h"
 #include "Test.h"
 
@@ -199,3 +201,53 @@ DEF_TEST(HashFindOrNull, r) {
 
     REPORTER_ASSERT(r, &seven == table.findOrNull(7));
 }
+
+DEF_TEST(FlatHashTable, r) {
+    struct Entry {
+        int key = 0;
+        int val = 0;
+    };
+
+    // Only 64 distinct hashes, so groups overflow and tags collide all the time.
+    struct HashTraits {
+        static int GetKey(const Entry* e) { return e->key; }
+        static uint32_t Hash(int key) { return (uint32_t)key & 63; }
+    };
+
+    SkTFlatHashTable<Entry*, int, HashTraits> table;
+    REPORTER_ASSERT(r, nullptr == table.findOrNull(7));
+
+    const int N = 2000;
+    SkAutoTArray<Entry> entries(N);
+    SkTHashMap<int, Entry*> expected;
+    SkRandom rand;
+    for (int i = 0; i < 20000; i++) {
+        int key = rand.nextULessThan(N);
+        if (rand.nextBool() && expected.find(key)) {
+            table.remove(key);
+            expected.remove(key);
+        } else {
+            entries[key].key = key;
+            entries[key].val = i;
+            REPORTER_ASSERT(r, &entries[key] == *table.set(&entries[key]));
+            expected.set(key, &entries[key]);
+        }
+        REPORTER_ASSERT(r, table.count() == expected.count());
+    }
+
+    for (int key = 0; key < N; key++) {
+        Entry** e = expected.find(key);
+        REPORTER_ASSERT(r, table.findOrNull(key) == (e ? *e : nullptr));
+    }
+    int n = 0;
+    const auto& constTable = table;
+    constTable.foreach([&](const Entry* e) {
+        REPORTER_ASSERT(r, expected.find(e->key));
+        n++;
+    });
+    REPORTER_ASSERT(r, n == table.count());
+
+    table.reset();
+    REPORTER_ASSERT(r, table.count() == 0);
+    REPORTER_ASSERT(r, nullptr == table.findOrNull(entries[0].key));
+}
@@ -7,8 +7,11 @@
 
 #include "SkDiscardableMemory.h"
 #include "SkResourceCache.h"
+#include "SkTaskGroup.h"
 #include "Test.h"
 
+#include <atomic>
+
 namespace {
 static void* gGlobalAddress;
 struct TestingKey : public SkResourceCache::Key {
@@ -150,3 +153,34 @@ DEF_TEST(ImageCache_doubleAdd, r) {
     REPORTER_ASSERT(r, cache.find(key, TestingRec::Visitor, &value));
     REPORTER_ASSERT(r, 2 == value || 3 == value);
 }
+
+DEF_TEST(ImageCache_threaded, r) {
+    // Room for about a hundred recs, so the threads below keep the cache purging.
+    const size_t recSize = TestingRec(TestingKey(0), 0).bytesUsed();
+    SkResourceCache cache(100 * recSize);
+
+    std::atomic<int> wrongValues{0};
+    SkTaskGroup().batch(8, [&](int thread) {
+        for (int i = 0; i < 1000; ++i) {
+            // Half the keys are shared by all threads, half are private.
+            intptr_t value = (i & 1) ? i : thread * 1000 + i;
+            TestingKey key(value);
+            intptr_t found = -1;
+            if (cache.find(key, TestingRec::Visitor, &found)) {
+                wrongValues += found != value;
+            } else {
+                cache.add(new TestingRec(key, value));
+            }
+        }
+    });
+
+    REPORTER_ASSERT(r, 0 == wrongValues);
+    REPORTER_ASSERT(r, cache.getTotalBytesUsed() <= cache.getTotalByteLimit());
+    REPORTER_ASSERT(r, cache.getTotalBytesUsed() > 0);
+
+    // The most recently added key is still there.
+    intptr_t value = -1;
+    cache.add(new TestingRec(TestingKey(123456), 123456));
+    REPORTER_ASSERT(r, cache.find(TestingKey(123456), TestingRec::Visitor, &value));
+    REPORTER_ASSERT(r, 123456 == value);
+}
@@ -15,6 +15,7 @@
 #include "SkComposeImageFilter.h"
 #include "SkDisplacementMapEffect.h"
 #include "SkDropShadowImageFilter.h"
+#include "SkExecutor.h"
 #include "SkGradientShader.h"
 #include "SkImage.h"
 #include "SkImageFilterPriv.h"
@@ -30,6 +31,7 @@
 #include "SkPictureImageFilter.h"
 #include "SkPictureRecorder.h"
 #include "SkPoint3.h"
+#include "SkRandom.h"
 #include "SkReadBuffer.h"
 #include "SkRect.h"
 #include "SkSpecialImage.h"
@@ -1164,6 +1166,309 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(ImageFilterMatrixConvolutionBigKernel_Gpu,
     test_big_kernel(reporter, ctxInfo.grContext());
 }
 
+// A direct evaluation of a convolution with gain 1 and bias 0, for checking the separable path.
+static SkPMColor convolve_reference(const SkBitmap& src, int x, int y, const SkScalar kernel[],
+                                    const SkISize& kernelSize, const SkIPoint& kernelOffset,
+                                    SkMatrixConvolutionImageFilter::TileMode tileMode) {
+    const int w = src.width(), h = src.height();
+    double sums[4] = { 0, 0, 0, 0 };
+    for (int cy = 0; cy < kernelSize.height(); ++cy) {
+        for (int cx = 0; cx < kernelSize.width(); ++cx) {
+            int sx = x + cx - kernelOffset.fX, sy = y + cy - kernelOffset.fY;
+            if (tileMode == SkMatrixConvolutionImageFilter::kClamp_TileMode) {
+                sx = SkTPin(sx, 0, w - 1);
+                sy = SkTPin(sy, 0, h - 1);
+            } else if (tileMode == SkMatrixConvolutionImageFilter::kRepeat_TileMode) {
+                sx = (sx % w + w) % w;
+                sy = (sy % h + h) % h;
+            } else if (sx < 0 || sx >= w || sy < 0 || sy >= h) {
+                continue;
+            }
+            SkPMColor s = *src.getAddr32(sx, sy);
+            for (int i = 0; i < 4; ++i) {
+                sums[i] += ((s >> (8 * i)) & 0xFF) * (double)kernel[cy * kernelSize.width() + cx];
+            }
+        }
+    }
+    SkPMColor result = 0;
+    for (int i = 0; i < 4; ++i) {
+        result |= SkTPin((int)floor(sums[i]), 0, 255) << (8 * i);
+    }
+    return result;
+}
+
+DEF_TEST(ImageFilterMatrixConvolutionSeparable, reporter) {
+    const int kWidth = 40, kHeight = 30;
+    SkBitmap srcBM;
+    srcBM.allocN32Pixels(kWidth, kHeight);
+    SkRandom rand;
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            U8CPU a = rand.nextULessThan(256);
+            *srcBM.getAddr32(x, y) = SkPackARGB32(a, rand.nextULessThan(a + 1),
+                                                  rand.nextULessThan(a + 1),
+                                                  rand.nextULessThan(a + 1));
+        }
+    }
+    sk_sp<SkSpecialImage> srcImg(SkSpecialImage::MakeFromRaster(
+            SkIRect::MakeWH(kWidth, kHeight), srcBM));
+
+    // An outer product of row and column weights that each sum to 1, so premul is preserved.
+    const SkISize kernelSize = SkISize::Make(7, 5);
+    SkScalar row[7], col[5], kernel[35];
+    SkScalar rowSum = 0, colSum = 0;
+    for (SkScalar& v : row) { rowSum += (v = rand.nextUScalar1()); }
+    for (SkScalar& v : col) { colSum += (v = rand.nextUScalar1()); }
+    for (int y = 0; y < kernelSize.height(); ++y) {
+        for (int x = 0; x < kernelSize.width(); ++x) {
+            kernel[y * kernelSize.width() + x] = (col[y] / colSum) * (row[x] / rowSum);
+        }
+    }
+    const SkIPoint kernelOffset = SkIPoint::Make(2, 4);
+
+    // Crop to the source so that the result lines up with the reference.
+    SkImageFilter::CropRect cropRect(SkRect::MakeIWH(kWidth, kHeight));
+    for (auto tileMode : { SkMatrixConvolutionImageFilter::kClamp_TileMode,
+                           SkMatrixConvolutionImageFilter::kRepeat_TileMode,
+                           SkMatrixConvolutionImageFilter::kClampToBlack_TileMode }) {
+        sk_sp<SkImageFilter> filter(SkMatrixConvolutionImageFilter::Make(
+                kernelSize, kernel, SK_Scalar1, 0, kernelOffset, tileMode, true, nullptr,
+                &cropRect));
+
+        SkIPoint offset;
+        SkImageFilter::OutputProperties noColorSpace(kN32_SkColorType, nullptr);
+        SkImageFilter::Context ctx(SkMatrix::I(), SkIRect::MakeWH(kWidth, kHeight), nullptr,
+                                   noColorSpace);
+        sk_sp<SkSpecialImage> result(filter->filterImage(srcImg.get(), ctx, &offset));
+        REPORTER_ASSERT(reporter, result);
+        if (!result) {
+            continue;
+        }
+        REPORTER_ASSERT(reporter, result->width() == kWidth && result->height() == kHeight);
+        SkBitmap resultBM;
+        REPORTER_ASSERT(reporter, result->getROPixels(&resultBM));
+
+        // The two passes round differently from the direct sum, but by no more than 1.
+        int mismatches = 0;
+        for (int y = 0; y < kHeight; ++y) {
+            for (int x = 0; x < kWidth; ++x) {
+                SkPMColor actual = *resultBM.getAddr32(x, y),
+                          expected = convolve_reference(srcBM, x, y, kernel, kernelSize,
+                                                        kernelOffset, tileMode);
+                for (int i = 0; i < 32; i += 8) {
+                    if (SkTAbs((int)((actual >> i) & 0xFF) - (int)((expected >> i) & 0xFF)) > 1) {
+                        ++mismatches;
+                        break;
+                    }
+                }
+            }
+        }
+        REPORTER_ASSERT(reporter, 0 == mismatches, "tile mode %d: %d pixels differ",
+                        tileMode, mismatches);
+    }
+}
+
+// Morphology is separable, so the reference is a clamped 1D min/max along X and then along Y.
+static void morph_reference(const SkBitmap& src, SkBitmap* dst, int rx, int ry, bool dilate) {
+    SkBitmap tmp;
+    tmp.allocPixels(src.info());
+    dst->allocPixels(src.info());
+    auto extreme = [dilate](SkPMColor a, SkPMColor b) {
+        SkPMColor result = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            unsigned ca = (a >> shift) & 0xFF, cb = (b >> shift) & 0xFF;
+            result |= (dilate ? SkTMax(ca, cb) : SkTMin(ca, cb)) << shift;
+        }
+        return result;
+    };
+    const int w = src.width(), h = src.height();
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            SkPMColor c = *src.getAddr32(x, y);
+            for (int i = SkTMax(0, x - rx); i <= SkTMin(w - 1, x + rx); ++i) {
+                c = extreme(c, *src.getAddr32(i, y));
+            }
+            *tmp.getAddr32(x, y) = c;
+        }
+    }
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            SkPMColor c = *tmp.getAddr32(x, y);
+            for (int j = SkTMax(0, y - ry); j <= SkTMin(h - 1, y + ry); ++j) {
+                c = extreme(c, *tmp.getAddr32(x, j));
+            }
+            *dst->getAddr32(x, y) = c;
+        }
+    }
+}
+
+static void test_morphology_radii(skiatest::Reporter* reporter, GrContext* context) {
+    const int kWidth = 70, kHeight = 50;
+    SkBitmap srcBM;
+    srcBM.allocN32Pixels(kWidth, kHeight);
+    SkRandom rand;
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            U8CPU a = rand.nextULessThan(256);
+            *srcBM.getAddr32(x, y) = SkPackARGB32(a, rand.nextULessThan(a + 1),
+                                                  rand.nextULessThan(a + 1),
+                                                  rand.nextULessThan(a + 1));
+        }
+    }
+    sk_sp<SkSpecialImage> srcImg(SkSpecialImage::MakeFromRaster(
+            SkIRect::MakeWH(kWidth, kHeight), srcBM));
+    if (context) {
+        srcImg = srcImg->makeTextureImage(context);
+    }
+    REPORTER_ASSERT(reporter, srcImg);
+    if (!srcImg) {
+        return;
+    }
+
+    // Small radii, radii larger than the image, and the large radii used for outlines and glows.
+    const SkISize radii[] = { {1, 0}, {0, 3}, {5, 2}, {20, 45}, {33, 17}, {60, 60}, {100, 1} };
+    // Crop to the source so that the result lines up with the reference.
+    SkImageFilter::CropRect cropRect(SkRect::MakeIWH(kWidth, kHeight));
+    for (const SkISize& radius : radii) {
+        for (bool dilate : { true, false }) {
+            sk_sp<SkImageFilter> filter = dilate
+                    ? SkDilateImageFilter::Make(radius.width(), radius.height(), nullptr, &cropRect)
+                    : SkErodeImageFilter::Make(radius.width(), radius.height(), nullptr, &cropRect);
+
+            SkIPoint offset;
+            SkImageFilter::OutputProperties noColorSpace(kN32_SkColorType, nullptr);
+            SkImageFilter::Context ctx(SkMatrix::I(), SkIRect::MakeWH(kWidth, kHeight), nullptr,
+                                       noColorSpace);
+            sk_sp<SkSpecialImage> result(filter->filterImage(srcImg.get(), ctx, &offset));
+            REPORTER_ASSERT(reporter, result);
+            if (!result) {
+                continue;
+            }
+            REPORTER_ASSERT(reporter, offset.fX == 0 && offset.fY == 0);
+            REPORTER_ASSERT(reporter, result->width() == kWidth && result->height() == kHeight);
+
+            SkBitmap resultBM, expectedBM;
+            REPORTER_ASSERT(reporter, result->getROPixels(&resultBM));
+            morph_reference(srcBM, &expectedBM, radius.width(), radius.height(), dilate);
+
+            int mismatches = 0;
+            for (int y = 0; y < kHeight; ++y) {
+                for (int x = 0; x < kWidth; ++x) {
+                    if (*resultBM.getAddr32(x, y) != *expectedBM.getAddr32(x, y)) {
+                        ++mismatches;
+                    }
+                }
+            }
+            REPORTER_ASSERT(reporter, 0 == mismatches, "%s %dx%d: %d pixels differ",
+                            dilate ? "dilate" : "erode", radius.width(), radius.height(),
+                            mismatches);
+        }
+    }
+}
+
+DEF_TEST(ImageFilterMorphologyRadii, reporter) {
+    test_morphology_radii(reporter, nullptr);
+}
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(ImageFilterMorphologyRadii_Gpu, reporter, ctxInfo) {
+    test_morphology_radii(reporter, ctxInfo.grContext());
+}
+
+// Returns true if filter and expected produce the same pixels, to within tolerance, at the same
+// offset.
+static bool same_output(const SkImageFilter* filter, const SkImageFilter* expected,
+                        SkSpecialImage* src, int tolerance) {
+    SkImageFilter::OutputProperties noColorSpace(kN32_SkColorType, nullptr);
+    SkImageFilter::Context ctx(SkMatrix::I(), SkIRect::MakeLTRB(-10, -10, 30, 30), nullptr,
+                               noColorSpace);
+    SkIPoint offsets[2];
+    sk_sp<SkSpecialImage> results[2] = { filter->filterImage(src, ctx, &offsets[0]),
+                                         expected->filterImage(src, ctx, &offsets[1]) };
+    SkBitmap bitmaps[2];
+    if (!results[0] || !results[1] || offsets[0] != offsets[1] ||
+        !results[0]->getROPixels(&bitmaps[0]) || !results[1]->getROPixels(&bitmaps[1]) ||
+        bitmaps[0].dimensions() != bitmaps[1].dimensions()) {
+        return false;
+    }
+    for (int y = 0; y < bitmaps[0].height(); ++y) {
+        for (int x = 0; x < bitmaps[0].width(); ++x) {
+            SkPMColor a = *bitmaps[0].getAddr32(x, y), b = *bitmaps[1].getAddr32(x, y);
+            for (int shift = 0; shift < 32; shift += 8) {
+                if (SkTAbs((int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF)) > tolerance) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+DEF_TEST(ImageFilterColorFilterFolding, reporter) {
+    SkBitmap srcBM;
+    srcBM.allocN32Pixels(20, 20);
+    SkRandom rand;
+    for (int y = 0; y < 20; ++y) {
+        for (int x = 0; x < 20; ++x) {
+            U8CPU a = rand.nextULessThan(256);
+            *srcBM.getAddr32(x, y) = SkPackARGB32(a, rand.nextULessThan(a + 1),
+                                                  rand.nextULessThan(a + 1),
+                                                  rand.nextULessThan(a + 1));
+        }
+    }
+    sk_sp<SkSpecialImage> src(SkSpecialImage::MakeFromRaster(SkIRect::MakeWH(20, 20), srcBM));
+
+    const SkScalar half[20] = { 0.5f, 0, 0, 0, 0,
+                                0, 0.5f, 0, 0, 0,
+                                0, 0, 0.5f, 0, 0,
+                                0, 0, 0, 0.5f, 0 };
+    sk_sp<SkColorFilter> halfCF = SkColorFilter::MakeMatrixFilterRowMajor255(half);
+    // A crop rect that clips nothing, but stops the color filter from folding into its input.
+    SkImageFilter::CropRect noClip(SkRect::MakeLTRB(-100, -100, 100, 100));
+
+    {
+        // A composition of color filters becomes one color filter.
+        sk_sp<SkImageFilter> composed = SkComposeImageFilter::Make(make_scale(0.5f, nullptr),
+                                                                   make_blue(nullptr, nullptr));
+        REPORTER_ASSERT(reporter, composed->isColorFilterNode(nullptr));
+        REPORTER_ASSERT(reporter, !composed->getInput(0));
+    }
+
+    {
+        // A color filter moves below an offset and fuses with the color filter there.
+        sk_sp<SkImageFilter> folded = make_scale(0.5f, SkOffsetImageFilter::Make(
+                3, 4, make_scale(0.5f, nullptr)));
+        REPORTER_ASSERT(reporter, !folded->isColorFilterNode(nullptr));
+        SkImageFilter* input = folded->getInput(0);
+        REPORTER_ASSERT(reporter, input && input->isColorFilterNode(nullptr));
+        REPORTER_ASSERT(reporter, input && !input->getInput(0));
+
+        sk_sp<SkImageFilter> unfolded = SkColorFilterImageFilter::Make(
+                halfCF, SkOffsetImageFilter::Make(3, 4, make_scale(0.5f, nullptr)), &noClip);
+        REPORTER_ASSERT(reporter, unfolded->getInput(0)->getInput(0));
+        // The fused color filter doesn't round in between, which is all that differs.
+        REPORTER_ASSERT(reporter, same_output(folded.get(), unfolded.get(), src.get(), 1));
+    }
+
+    {
+        // A color filter over an SkPaintImageFilter moves into its paint.
+        SkPaint paint;
+        paint.setColor(0x80FF4020);
+        sk_sp<SkImageFilter> paintFilter = SkPaintImageFilter::Make(paint);
+        sk_sp<SkImageFilter> folded = SkColorFilterImageFilter::Make(halfCF, paintFilter);
+        REPORTER_ASSERT(reporter, 0 == folded->countInputs());
+
+        sk_sp<SkImageFilter> unfolded = SkColorFilterImageFilter::Make(halfCF, paintFilter,
+                                                                       &noClip);
+        REPORTER_ASSERT(reporter, 1 == unfolded->countInputs());
+        REPORTER_ASSERT(reporter, same_output(folded.get(), unfolded.get(), src.get(), 0));
+
+        // But not past a blend mode that reads the destination.
+        paint.setBlendMode(SkBlendMode::kDstOut);
+        folded = SkColorFilterImageFilter::Make(halfCF, SkPaintImageFilter::Make(paint));
+        REPORTER_ASSERT(reporter, 1 == folded->countInputs());
+    }
+}
+
 DEF_TEST(ImageFilterCropRect, reporter) {
     test_crop_rects(reporter, nullptr);
 }
@@ -2040,3 +2345,68 @@ DEF_TEST(ImageSourceBounds, reporter) {
                                                              &input));
 }
 
+
+// Returns the color of pixel (x, y) of a filter result drawn at offset, or transparent black off it.
+static SkColor result_color(const SkBitmap& result, const SkIPoint& offset, int x, int y) {
+    x -= offset.fX;
+    y -= offset.fY;
+    if (x < 0 || y < 0 || x >= result.width() || y >= result.height()) {
+        return SK_ColorTRANSPARENT;
+    }
+    return result.getColor(x, y);
+}
+
+// Returns how many pixels inside clip differ between filtering src serially and in tiles.
+static int tiled_mismatches(skiatest::Reporter* reporter, SkImageFilter* filter,
+                            SkSpecialImage* src, const SkIRect& clip, SkExecutor* executor) {
+    SkImageFilter::OutputProperties noColorSpace(kN32_SkColorType, nullptr);
+    SkImageFilter::Context serialCtx(SkMatrix::I(), clip, nullptr, noColorSpace);
+    SkImageFilter::Context parallelCtx(SkMatrix::I(), clip, nullptr, noColorSpace, executor);
+
+    SkIPoint serialOffset, tiledOffset;
+    sk_sp<SkSpecialImage> serial(SkFilterImageInTiles(filter, src, serialCtx, &serialOffset));
+    sk_sp<SkSpecialImage> tiled(SkFilterImageInTiles(filter, src, parallelCtx, &tiledOffset));
+    SkBitmap serialBM, tiledBM;
+    if (!serial || !tiled || !serial->getROPixels(&serialBM) || !tiled->getROPixels(&tiledBM)) {
+        ERRORF(reporter, "Failed to filter");
+        return -1;
+    }
+
+    int mismatches = 0;
+    for (int y = clip.fTop; y < clip.fBottom; ++y) {
+        for (int x = clip.fLeft; x < clip.fRight; ++x) {
+            mismatches += result_color(serialBM, serialOffset, x, y) !=
+                          result_color(tiledBM, tiledOffset, x, y);
+        }
+    }
+    return mismatches;
+}
+
+DEF_TEST(ImageFilterTiledParallel, reporter) {
+    const int width = 1300, height = 1100;
+    sk_sp<SkSpecialImage> src(SkSpecialImage::MakeFromRaster(SkIRect::MakeWH(width, height),
+                                                             make_gradient_circle(width, height)));
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    const SkIRect clip = SkIRect::MakeLTRB(10, 20, 1250, 1090);
+
+    // A DAG with a shared blur, morphology and two kinds of merging, which is filtered in tiles.
+    sk_sp<SkImageFilter> blur(SkBlurImageFilter::Make(3, 3, nullptr));
+    sk_sp<SkImageFilter> xfermode(SkXfermodeImageFilter::Make(
+            SkBlendMode::kMultiply, SkDilateImageFilter::Make(4, 2, blur), blur, nullptr));
+    sk_sp<SkImageFilter> filters[] = {
+        xfermode, SkOffsetImageFilter::Make(30, -20, blur), SkErodeImageFilter::Make(3, 3, nullptr),
+        nullptr,
+    };
+    sk_sp<SkImageFilter> dag(SkMergeImageFilter::Make(filters, SK_ARRAY_COUNT(filters)));
+    REPORTER_ASSERT(reporter, dag->canFilterInTiles());
+    int mismatches = tiled_mismatches(reporter, dag.get(), src.get(), clip, executor.get());
+    REPORTER_ASSERT(reporter, 0 == mismatches, "%d mismatched pixels", mismatches);
+
+    // Lighting treats the edges of its output as image edges, so it is never split into tiles,
+    // but its inputs may still be filtered in parallel.
+    sk_sp<SkImageFilter> lighting(SkLightingImageFilter::MakeDistantLitDiffuse(
+            SkPoint3::Make(1, 1, 1), SK_ColorWHITE, 2, 1, dag));
+    REPORTER_ASSERT(reporter, !lighting->canFilterInTiles());
+    mismatches = tiled_mismatches(reporter, lighting.get(), src.get(), clip, executor.get());
+    REPORTER_ASSERT(reporter, 0 == mismatches, "%d mismatched pixels", mismatches);
+}
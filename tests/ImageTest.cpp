@@ -11,9 +11,12 @@
 
 #include "SkAutoPixmapStorage.h"
 #include "SkBitmap.h"
+#include "SkCachedData.h"
 #include "SkCanvas.h"
+#include "SkCodec.h"
 #include "SkColorSpacePriv.h"
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkImageEncoder.h"
 #include "SkImageGenerator.h"
 #include "SkImage_Base.h"
@@ -26,6 +29,7 @@
 #include "SkStream.h"
 #include "SkSurface.h"
 #include "SkUtils.h"
+#include "SkYUVPlanesCache.h"
 #include "Test.h"
 
 #include "Resources.h"
@@ -454,6 +458,101 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkImage_makeTextureImage, reporter, contextIn
     }
 }
 
+DEF_GPUTEST(SkImage_makeTextureImageAsync, reporter, options) {
+    std::unique_ptr<SkExecutor> threadPool = SkExecutor::MakeFIFOThreadPool(2);
+    GrContextOptions contextOptions = options;
+    contextOptions.fExecutor = threadPool.get();
+    GrContextFactory factory(contextOptions);
+
+    for (int i = 0; i < GrContextFactory::kContextTypeCnt; ++i) {
+        GrContextFactory::ContextType ctxType = static_cast<GrContextFactory::ContextType>(i);
+        if (!GrContextFactory::IsRenderingContext(ctxType)) {
+            continue;
+        }
+        GrContext* context = factory.get(ctxType);
+        if (!context) {
+            continue;
+        }
+        SkImageInfo info = SkImageInfo::MakeN32Premul(20, 20);
+        sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+        if (!surface) {
+            continue;
+        }
+
+        for (auto makeImage : {create_image, create_codec_image, create_picture_image}) {
+            sk_sp<SkImage> image = makeImage();
+            int ready = 0;
+            auto readyProc = [](SkImage::ReleaseContext ctx) { ++*static_cast<int*>(ctx); };
+            sk_sp<SkImage> texImage = image->makeTextureImageAsync(context, nullptr, readyProc,
+                                                                   &ready);
+            if (!texImage || !texImage->isTextureBacked()) {
+                ERRORF(reporter, "makeTextureImageAsync failed.");
+                continue;
+            }
+            REPORTER_ASSERT(reporter, texImage->dimensions() == image->dimensions());
+
+            surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+            surface->getCanvas()->drawImage(texImage, 0, 0);
+            surface->flush();
+            REPORTER_ASSERT(reporter, 1 == ready);
+
+            SkBitmap expected, actual;
+            expected.allocPixels(info);
+            actual.allocPixels(info);
+            expected.eraseColor(SK_ColorTRANSPARENT);
+            SkCanvas(expected).drawImage(image, 0, 0);
+            REPORTER_ASSERT(reporter, surface->readPixels(actual, 0, 0));
+            REPORTER_ASSERT(reporter, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                                  expected.computeByteSize()));
+        }
+
+        // An image that is never drawn still reports back when it goes away.
+        int ready = 0;
+        auto readyProc = [](SkImage::ReleaseContext ctx) { ++*static_cast<int*>(ctx); };
+        create_image()->makeTextureImageAsync(context, nullptr, readyProc, &ready);
+        REPORTER_ASSERT(reporter, 1 == ready);
+    }
+}
+
+// Encoded images whose codec can produce YUV planes should be uploaded as planes and converted on
+// the GPU, whether or not the texture is mipped.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkImage_makeTextureImageFromYUVPlanes, reporter, contextInfo) {
+    GrContext* context = contextInfo.grContext();
+    if (context->contextPriv().disableGpuYUVConversion()) {
+        return;
+    }
+
+    sk_sp<SkData> data = GetResourceAsData("images/mandrill_512_q075.jpg");
+    if (!data) {
+        return;
+    }
+    SkYUVASizeInfo sizeInfo;
+    SkYUVColorSpace colorSpace;
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+    if (!codec || !codec->queryYUV8(&sizeInfo, &colorSpace)) {
+        return;
+    }
+
+    for (auto mipMapped : {GrMipMapped::kNo, GrMipMapped::kYes}) {
+        sk_sp<SkImage> image = SkImage::MakeFromEncoded(data);
+        sk_sp<SkImage> texImage = image->makeTextureImage(context, nullptr, mipMapped);
+        if (!texImage) {
+            ERRORF(reporter, "makeTextureImage failed (mipped: %d)", (int)mipMapped);
+            continue;
+        }
+
+        // The planes are only cached when the YUV path was taken.
+        SkYUVPlanesCache::Info yuvInfo;
+        sk_sp<SkCachedData> planes(SkYUVPlanesCache::FindAndRef(image->uniqueID(), &yuvInfo));
+        REPORTER_ASSERT(reporter, planes, "mipped: %d", (int)mipMapped);
+
+        if (GrMipMapped::kYes == mipMapped && context->contextPriv().caps()->mipMapSupport()) {
+            GrTextureProxy* proxy = as_IB(texImage)->peekProxy();
+            REPORTER_ASSERT(reporter, proxy && GrMipMapped::kYes == proxy->mipMapped());
+        }
+    }
+}
+
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkImage_makeNonTextureImage, reporter, contextInfo) {
     GrContext* context = contextInfo.grContext();
 
@@ -875,7 +974,7 @@ static void test_cross_context_image(skiatest::Reporter* reporter, const GrConte
 
         // If we don't have proper support for this feature, the factory will fallback to returning
         // codec-backed images. Those will "work", but some of our checks will fail because we
-        // expect the cross-context images not to work on multiple contexts at once.
+        // expect the cross-context images to know which contexts are borrowing them.
         if (!ctx->contextPriv().caps()->crossContextTextureSupport()) {
             continue;
         }
@@ -970,8 +1069,11 @@ static void test_cross_context_image(skiatest::Reporter* reporter, const GrConte
             otherCtx->contextPriv().getGpu()->testingOnly_flushGpuAndSync();
         }
 
-        // Case #6: Verify that only one context can be using the image at a time
+        // Case #6: Verify that only one context can be using the image at a time, unless the
+        // backend's semaphores can be waited on by several contexts (GL sync objects)
         {
+            const bool sharedBorrows = GrBackendApi::kOpenGL == ctx->backend() ||
+                                       GrBackendApi::kMock == ctx->backend();
             testContext->makeCurrent();
             sk_sp<SkImage> refImg(imageMaker(ctx));
 
@@ -980,11 +1082,13 @@ static void test_cross_context_image(skiatest::Reporter* reporter, const GrConte
                     ctx, GrSamplerState::ClampNearest(), nullptr);
             REPORTER_ASSERT(reporter, proxy);
 
-            // But once it's borrowed, no other context should be able to borrow
+            // But once it's borrowed, no other context should be able to borrow, unless borrows
+            // can be shared
             otherTestContext->makeCurrent();
             sk_sp<GrTextureProxy> otherProxy = as_IB(refImg)->asTextureProxyRef(
                     otherCtx, GrSamplerState::ClampNearest(), nullptr);
-            REPORTER_ASSERT(reporter, !otherProxy);
+            REPORTER_ASSERT(reporter, SkToBool(otherProxy) == sharedBorrows);
+            otherProxy.reset(nullptr);
 
             // Original context (that's already borrowing) should be okay
             testContext->makeCurrent();
@@ -1000,7 +1104,8 @@ static void test_cross_context_image(skiatest::Reporter* reporter, const GrConte
             otherTestContext->makeCurrent();
             otherProxy = as_IB(refImg)->asTextureProxyRef(otherCtx, GrSamplerState::ClampNearest(),
                                                           nullptr);
-            REPORTER_ASSERT(reporter, !otherProxy);
+            REPORTER_ASSERT(reporter, SkToBool(otherProxy) == sharedBorrows);
+            otherProxy.reset(nullptr);
 
             // Release second ref from the original context
             testContext->makeCurrent();
@@ -1373,3 +1478,43 @@ DEF_TEST(Image_nonfinite_dst, reporter) {
     }
 }
 
+
+// Draws that only sample a raster image at a fraction of its size should upload a downscaled copy
+// rather than the full resolution original, until a larger draw needs it.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(Image_DownscaledUpload_Gpu, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo,
+                                                           SkImageInfo::MakeN32Premul(64, 64));
+    SkBitmap bm;
+    bm.allocN32Pixels(512, 512);
+    bm.eraseArea(SkIRect::MakeWH(256, 512), SK_ColorRED);
+    bm.eraseArea(SkIRect::MakeXYWH(256, 0, 256, 512), SK_ColorBLUE);
+    bm.setImmutable();
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(bm);
+    const size_t fullSize = bm.computeByteSize();
+
+    SkPaint paint;
+    paint.setFilterQuality(kLow_SkFilterQuality);
+
+    context->flush();
+    size_t before;
+    context->getResourceCacheUsage(nullptr, &before);
+    surface->getCanvas()->drawImageRect(image, SkRect::MakeWH(64, 64), &paint);
+    surface->getCanvas()->flush();
+    size_t after;
+    context->getResourceCacheUsage(nullptr, &after);
+    REPORTER_ASSERT(reporter, after - before < fullSize);
+
+    SkBitmap readback;
+    readback.allocN32Pixels(64, 64);
+    REPORTER_ASSERT(reporter, surface->readPixels(readback, 0, 0));
+    REPORTER_ASSERT(reporter, readback.getColor(16, 32) == SK_ColorRED);
+    REPORTER_ASSERT(reporter, readback.getColor(48, 32) == SK_ColorBLUE);
+
+    // Drawing at full size uploads the original.
+    before = after;
+    surface->getCanvas()->drawImageRect(image, SkRect::MakeWH(512, 512), &paint);
+    surface->getCanvas()->flush();
+    context->getResourceCacheUsage(nullptr, &after);
+    REPORTER_ASSERT(reporter, after - before >= fullSize);
+}
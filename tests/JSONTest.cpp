@@ -48,6 +48,10 @@ DEF_TEST(JSON_Parse, reporter) {
         { "[1,2,]"  , nullptr },
         { "[,1,2]"  , nullptr },
 
+        { "[1e]"    , nullptr },
+        { "[-e5]"   , nullptr },
+        { "[1e5.0]" , nullptr },
+
         { "[ \"foo"       , nullptr },
         { "[ \"fo\0o\" ]" , nullptr },
 
@@ -84,7 +88,12 @@ DEF_TEST(JSON_Parse, reporter) {
         { "[ \"1234567\" ]"              , "[\"1234567\"]" },
         { "[ \"12345678\" ]"             , "[\"12345678\"]" },
         { "[ \"123456789\" ]"            , "[\"123456789\"]" },
+        { "[ \"0123456789abcdef0123456789abcdef\" ]", "[\"0123456789abcdef0123456789abcdef\"]" },
+        { "[ \"0123456789abcdef0123456789}bcdef\" ]", "[\"0123456789abcdef0123456789}bcdef\"]" },
+        { "[ \"0123456789abcdef\\n0123456789abcdef\" ]",
+          "[\"0123456789abcdef\\n0123456789abcdef\"]" },
         { "[ null , true, false,0,12.8 ]", "[null,true,false,0,12.8]" },
+        { "[ 1e3, -2.5E-1 ]"             , "[1000,-0.25]" },
 
         { "{}"                          , "{}" },
         { " \n\r\t { \n\r\t } \n\r\t "  , "{}" },
@@ -440,6 +449,14 @@ DEF_TEST(JSON_ParseNumber, reporter) {
 
         { "20.001111814444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444473",
           20.001f, 0.001f },
+
+        { "1e3"     ,  1000    , 0 },
+        { "1E+3"    ,  1000    , 0 },
+        { "-2.5e2"  ,  -250    , 0 },
+        { "1.5e-3"  ,  0.0015f , 1e-9f },
+        { "12.5E-10",  1.25e-9f, 1e-15f },
+        { "1e-45"   ,  1e-45f  , 0 },
+        { "3.4e38"  ,  3.4e38f , 0 },
     };
 
     for (const auto& test : gTests) {
@@ -102,3 +102,32 @@ DEF_TEST(RectsMaskCache, reporter) {
     check_data(reporter, data, 1, kNotInCache, kLocked);
     data->unref();
 }
+
+DEF_TEST(BlurProfileMaskCache, reporter) {
+    SkResourceCache cache(1024);
+
+    SkScalar sigma = 0.8f;
+
+    SkCachedData* data = SkMaskCache::FindAndRefBlurProfile(sigma, &cache);
+    REPORTER_ASSERT(reporter, nullptr == data);
+
+    size_t size = SkScalarCeilToInt(6 * sigma);
+    data = cache.newCachedData(size);
+    memset(data->writable_data(), 0xff, size);
+    SkMaskCache::AddBlurProfile(sigma, data, &cache);
+    check_data(reporter, data, 2, kInCache, kLocked);
+
+    data->unref();
+    check_data(reporter, data, 1, kInCache, kUnlocked);
+
+    REPORTER_ASSERT(reporter, nullptr == SkMaskCache::FindAndRefBlurProfile(2 * sigma, &cache));
+
+    data = SkMaskCache::FindAndRefBlurProfile(sigma, &cache);
+    REPORTER_ASSERT(reporter, data);
+    REPORTER_ASSERT(reporter, data->size() == size);
+    check_data(reporter, data, 2, kInCache, kLocked);
+
+    cache.purgeAll();
+    check_data(reporter, data, 1, kNotInCache, kLocked);
+    data->unref();
+}
@@ -7,6 +7,7 @@
 
 #include "SkMatrix44.h"
 #include "SkPoint3.h"
+#include "SkRandom.h"
 #include "Test.h"
 
 static bool nearly_equal_double(double a, double b) {
@@ -934,3 +935,43 @@ DEF_TEST(Matrix44, reporter) {
     test_preserves_2d_axis_alignment(reporter);
     test_toint(reporter);
 }
+
+DEF_TEST(Matrix44_map4, reporter) {
+    SkRandom rand;
+    SkMatrix44 a, b;
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            a.setFloat(row, col, rand.nextSScalar1());
+            b.setFloat(row, col, rand.nextSScalar1());
+        }
+    }
+
+    // setConcat(a, b) should map a vector the same as b and then a would, up to rounding.
+    SkMatrix44 ab;
+    ab.setConcat(a, b);
+
+    float src[7 * 4], dst[7 * 4];
+    for (float& v : src) {
+        v = rand.nextSScalar1() * 10;
+    }
+    ab.map4(src, 7, dst);
+    for (int n = 0; n < 7; ++n) {
+        float one[4], two[4];
+        ab.mapScalars(src + 4*n, one);
+        b.mapScalars(src + 4*n, two);
+        a.mapScalars(two);
+        for (int i = 0; i < 4; ++i) {
+            REPORTER_ASSERT(reporter, dst[4*n + i] == one[i]);
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(one[i], two[i], 1e-4f));
+        }
+    }
+
+    // map4() may map in place.
+    memcpy(dst, src, sizeof(src));
+    ab.map4(dst, 7, dst);
+    for (int n = 0; n < 7; ++n) {
+        float one[4];
+        ab.mapScalars(src + 4*n, one);
+        REPORTER_ASSERT(reporter, 0 == memcmp(one, dst + 4*n, sizeof(one)));
+    }
+}
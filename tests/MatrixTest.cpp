@@ -1066,3 +1066,44 @@ DEF_TEST(Matrix_maprects, r) {
         }
     }
 }
+
+// mapPoints() runs long arrays through SkOpts kernels; they must agree with mapXY() point by point.
+// The AVX2 and AVX-512 kernels may use FMAs, so allow for their rounding.
+static bool nearly_equal_pt(const SkPoint& a, const SkPoint& b) {
+    return SkScalarNearlyEqual(a.fX, b.fX, 1e-4f * SkTMax(1.0f, SkScalarAbs(b.fX))) &&
+           SkScalarNearlyEqual(a.fY, b.fY, 1e-4f * SkTMax(1.0f, SkScalarAbs(b.fY)));
+}
+
+DEF_TEST(Matrix_mapPointsBulk, r) {
+    SkRandom rand;
+    SkMatrix affine, persp;
+    affine.setRotate(30);
+    affine.postScale(1.5f, 0.75f);
+    affine.postTranslate(3, -7);
+    persp = affine;
+    persp.setPerspX(0.001f);
+    persp.setPerspY(-0.002f);
+
+    SkPoint src[67], dst[67];
+    for (int count : { 1, 2, 3, 7, 8, 9, 15, 16, 17, 31, 33, 67 }) {
+        for (int i = 0; i < count; ++i) {
+            src[i].set(rand.nextSScalar1() * 100, rand.nextSScalar1() * 100);
+        }
+        for (const SkMatrix& m : { affine, persp }) {
+            m.mapPoints(dst, src, count);
+            for (int i = 0; i < count; ++i) {
+                REPORTER_ASSERT(r, nearly_equal_pt(dst[i], m.mapXY(src[i].fX, src[i].fY)));
+            }
+
+            SkRect rects[10], mapped[10];
+            for (int i = 0; i < 10; ++i) {
+                rects[i].set(src[i], src[i + 1]);
+            }
+            bool stays = m.mapRects(mapped, rects, 10);
+            REPORTER_ASSERT(r, stays == m.rectStaysRect());
+            for (int i = 0; i < 10; ++i) {
+                REPORTER_ASSERT(r, mapped[i] == m.mapRect(rects[i]));
+            }
+        }
+    }
+}
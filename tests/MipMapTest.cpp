@@ -6,6 +6,7 @@
  */
 
 #include "SkBitmap.h"
+#include "SkExecutor.h"
 #include "SkMipMap.h"
 #include "SkRandom.h"
 #include "Test.h"
@@ -209,3 +210,63 @@ DEF_TEST(MipMap_F16, reporter) {
     bmp.eraseColor(0);
     sk_sp<SkMipMap> mipmap(SkMipMap::Build(bmp, nullptr));
 }
+
+static void make_noise_bitmap(SkBitmap* bm, int width, int height, SkColorType ct) {
+    SkBitmap noise;
+    noise.allocN32Pixels(width, height, true);
+    SkRandom rand;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            *noise.getAddr32(x, y) = rand.nextU() | 0xFF000000;
+        }
+    }
+    bm->allocPixels(noise.info().makeColorType(ct));
+    SkAssertResult(noise.readPixels(bm->pixmap()));
+}
+
+static bool same_levels(const SkMipMap* a, const SkMipMap* b) {
+    if (a->countLevels() != b->countLevels()) {
+        return false;
+    }
+    // Ask for the smallest level first, so that a lazy mipmap has to make all the levels at once.
+    for (int i = a->countLevels() - 1; i >= 0; --i) {
+        SkMipMap::Level la, lb;
+        if (!a->getLevel(i, &la) || !b->getLevel(i, &lb)) {
+            return false;
+        }
+        for (int y = 0; y < la.fPixmap.height(); ++y) {
+            if (memcmp(la.fPixmap.addr(0, y), lb.fPixmap.addr(0, y),
+                       la.fPixmap.info().minRowBytes())) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+DEF_TEST(MipMap_LazyAndParallel, reporter) {
+    // This executor has to outlive any other test that might see it in gSkMipMapExecutor.
+    static std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    for (SkColorType ct : { kN32_SkColorType, kRGBA_F16_SkColorType }) {
+        for (SkISize size : { SkISize{1200, 1100}, SkISize{1201, 1099}, SkISize{3, 1000} }) {
+            SkBitmap bm;
+            make_noise_bitmap(&bm, size.width(), size.height(), ct);
+            sk_sp<SkMipMap> eager(SkMipMap::Build(bm, nullptr));
+            sk_sp<SkMipMap> lazy(SkMipMap::Build(bm, nullptr, true));
+
+            gSkMipMapExecutor = executor.get();
+            sk_sp<SkMipMap> parallel(SkMipMap::Build(bm, nullptr));
+            gSkMipMapExecutor = nullptr;
+
+            // The lazy mipmap no longer needs the base level.
+            bm.reset();
+
+            REPORTER_ASSERT(reporter, eager && lazy && parallel);
+            if (eager && lazy && parallel) {
+                REPORTER_ASSERT(reporter, same_levels(eager.get(), lazy.get()));
+                REPORTER_ASSERT(reporter, same_levels(eager.get(), parallel.get()));
+            }
+        }
+    }
+}
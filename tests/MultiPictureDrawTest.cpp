@@ -0,0 +1,50 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCanvas.h"
+#include "SkExecutor.h"
+#include "SkMultiPictureDraw.h"
+#include "SkPicture.h"
+#include "SkPictureRecorder.h"
+#include "SkSurface.h"
+#include "Test.h"
+
+static sk_sp<SkPicture> make_fill(SkColor color) {
+    SkPictureRecorder recorder;
+    recorder.beginRecording(8, 8)->drawColor(color);
+    return recorder.finishRecordingAsPicture();
+}
+
+// Raster draws run in parallel across canvases, but in order on each canvas.
+DEF_TEST(MultiPictureDraw_Raster, r) {
+    static constexpr int kCanvases = 8;
+    sk_sp<SkSurface> surfaces[kCanvases];
+    for (auto& surface : surfaces) {
+        surface = SkSurface::MakeRasterN32Premul(8, 8);
+    }
+    sk_sp<SkPicture> red = make_fill(SK_ColorRED),
+                     green = make_fill(SK_ColorGREEN);
+
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeFIFOThreadPool(4);
+    SkMultiPictureDraw mpd;
+    for (int loop = 0; loop < 10; ++loop) {
+        for (auto& surface : surfaces) {
+            mpd.add(surface->getCanvas(), red.get());
+        }
+    }
+    for (auto& surface : surfaces) {
+        mpd.add(surface->getCanvas(), green.get());
+    }
+    mpd.draw(true, pool.get());
+
+    for (auto& surface : surfaces) {
+        SkBitmap bm;
+        bm.allocN32Pixels(8, 8);
+        REPORTER_ASSERT(r, surface->readPixels(bm, 0, 0));
+        REPORTER_ASSERT(r, SK_ColorGREEN == bm.getColor(4, 4));
+    }
+}
@@ -239,3 +239,97 @@ DEF_GPUTEST(OpChainTest, reporter, /*ctxInfo*/) {
         }
     }
 }
+
+namespace {
+/**
+ * Test ops that count how often they are merged. Ops of different classes can't combine, so a run
+ * of one class separates ops of the other.
+ */
+template <bool kMerges> class CountingOp : public GrOp {
+public:
+    DEFINE_OP_CLASS_ID
+
+    static std::unique_ptr<CountingOp> Make(GrContext* context, const SkRect& bounds,
+                                            int* numMerges) {
+        GrOpMemoryPool* pool = context->contextPriv().opMemoryPool();
+        return pool->allocate<CountingOp>(bounds, numMerges);
+    }
+
+    const char* name() const override { return "CountingOp"; }
+
+private:
+    friend class ::GrOpMemoryPool;  // for ctor
+
+    CountingOp(const SkRect& bounds, int* numMerges)
+            : INHERITED(ClassID()), fNumMerges(numMerges) {
+        this->setBounds(bounds, HasAABloat::kNo, IsZeroArea::kNo);
+    }
+
+    void onPrepare(GrOpFlushState*) override {}
+    void onExecute(GrOpFlushState*, const SkRect& chainBounds) override {}
+
+    CombineResult onCombineIfPossible(GrOp*, const GrCaps&) override {
+        if (!kMerges) {
+            return CombineResult::kCannotCombine;
+        }
+        ++*fNumMerges;
+        return CombineResult::kMerged;
+    }
+
+    int* fNumMerges;
+
+    typedef GrOp INHERITED;
+};
+}  // namespace
+
+/**
+ * Tests that ops merge with a chain further back than the recent chains that are always tried, but
+ * only if no chain in between overlaps them.
+ */
+DEF_GPUTEST(OpChainDistantMergeTest, reporter, /*ctxInfo*/) {
+    using MergingOp = CountingOp<true>;
+    using SeparatingOp = CountingOp<false>;
+    static constexpr int kNumSeparatingOps = 20;
+
+    auto context = GrContext::MakeMock(nullptr);
+    SkASSERT(context);
+    GrSurfaceDesc desc;
+    desc.fConfig = kRGBA_8888_GrPixelConfig;
+    desc.fWidth = 64;
+    desc.fHeight = 64;
+    desc.fFlags = kRenderTarget_GrSurfaceFlag;
+
+    const GrBackendFormat format =
+            context->contextPriv().caps()->getBackendFormatFromColorType(kRGBA_8888_SkColorType);
+
+    auto proxy = context->contextPriv().proxyProvider()->createProxy(
+            format, desc, kTopLeft_GrSurfaceOrigin, GrMipMapped::kNo, SkBackingFit::kExact,
+            SkBudgeted::kNo, GrInternalSurfaceFlags::kNone);
+    SkASSERT(proxy);
+    const GrCaps& caps = *context->contextPriv().caps();
+
+    for (bool blocked : {false, true}) {
+        GrRenderTargetOpList opList(context->contextPriv().resourceProvider(),
+                                    sk_ref_sp(context->contextPriv().opMemoryPool()),
+                                    proxy->asRenderTargetProxy(),
+                                    context->contextPriv().getAuditTrail());
+        int numMerges = 0;
+        opList.addOp(MergingOp::Make(context.get(), SkRect::MakeLTRB(0, 0, 4, 4), &numMerges),
+                     caps);
+        if (blocked) {
+            opList.addOp(SeparatingOp::Make(context.get(), SkRect::MakeLTRB(30, 30, 40, 40),
+                                            &numMerges),
+                         caps);
+        }
+        for (int i = 0; i < kNumSeparatingOps; ++i) {
+            opList.addOp(SeparatingOp::Make(context.get(), SkRect::MakeXYWH(2 * i, 20, 1, 1),
+                                            &numMerges),
+                         caps);
+        }
+        opList.addOp(MergingOp::Make(context.get(), SkRect::MakeLTRB(32, 32, 36, 36), &numMerges),
+                     caps);
+        REPORTER_ASSERT(reporter, numMerges == (blocked ? 0 : 1));
+        opList.makeClosed(caps);
+        opList.endFlush();
+    }
+}
@@ -256,3 +256,39 @@ DEF_TEST(SkPDF_abort_jobs, rep) {
     doc->abort();
 }
 
+
+static int count_page_objects(const SkDynamicMemoryWStream& stream) {
+    std::vector<uint8_t> bytes(stream.bytesWritten());
+    stream.copyTo(bytes.data());
+    static const char kPage[] = "/Type /Page\n";
+    const size_t len = strlen(kPage);
+    int count = 0;
+    for (size_t i = 0; i + len <= bytes.size(); ++i) {
+        if (0 == memcmp(bytes.data() + i, kPage, len)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Pages should be written as they end, not held until close().
+DEF_TEST(SkPDF_pages_written_as_they_end, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_pages_written_as_they_end, r);
+    for (int n : {1, 2, 8, 9, 17, 64, 65}) {
+        SkDynamicMemoryWStream stream;
+        auto doc = SkPDF::MakeDocument(&stream);
+        for (int i = 0; i < n; ++i) {
+            doc->beginPage(612, 792)->drawColor(SK_ColorGREEN);
+            doc->endPage();
+            // Only the first page of each run of eight can be waiting for a sibling.
+            int expected = i % 8 == 0 ? i : i + 1;
+            REPORTER_ASSERT(r, count_page_objects(stream) == expected, "%d of %d", i, n);
+        }
+        doc->close();
+        REPORTER_ASSERT(r, count_page_objects(stream) == n, "%d", n);
+        SkString count = SkStringPrintf("/Count %d\n", n);
+        std::vector<uint8_t> bytes(stream.bytesWritten());
+        stream.copyTo(bytes.data());
+        REPORTER_ASSERT(r, contains(bytes.data(), bytes.size(), count.c_str()), "%d", n);
+    }
+}
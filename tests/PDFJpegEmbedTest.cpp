@@ -75,9 +75,45 @@ DEF_TEST(SkPDF_JpegEmbedTest, r) {
     REPORTER_ASSERT(r, is_subset_of(mandrillData.get(), pdfData.get()));
     #endif
 
-    // This JPEG uses a nonstandard colorspace - it can not be
-    // embedded into the PDF directly.
-    REPORTER_ASSERT(r, !is_subset_of(cmykData.get(), pdfData.get()));
+    // Adobe CMYK JPEGs are embedded as DeviceCMYK with an inverting Decode array.
+    #ifndef SK_PDF_BASE85_BINARY
+    REPORTER_ASSERT(r, is_subset_of(cmykData.get(), pdfData.get()));
+    #endif
+}
+
+/**
+ *  Test that the IDAT data of opaque, non-interlaced 8-bit PNGs is embedded
+ *  into the PDF directly, to be read through the FlateDecode PNG predictors.
+ */
+DEF_TEST(SkPDF_PngEmbedTest, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_PngEmbedTest, r);
+    sk_sp<SkData> pngData(load_resource(r, "SkPDF_PngEmbedTest", "images/randPixels.png"));
+    if (!pngData) {
+        return;
+    }
+    SkDynamicMemoryWStream pdf;
+    auto document = SkPDF::MakeDocument(&pdf);
+    SkCanvas* canvas = document->beginPage(100, 100);
+    canvas->drawImage(SkImage::MakeFromEncoded(pngData), 0, 0);
+    document->endPage();
+    document->close();
+    sk_sp<SkData> pdfData = pdf.detachAsData();
+
+    // randPixels.png holds a single IDAT chunk.
+    const uint8_t* ptr = pngData->bytes() + 8;
+    while (memcmp(ptr + 4, "IDAT", 4)) {
+        ptr += 12 + ((ptr[0] << 24) | (ptr[1] << 16) | (ptr[2] << 8) | ptr[3]);
+        SkASSERT(ptr < pngData->bytes() + pngData->size());
+    }
+    size_t length = (ptr[0] << 24) | (ptr[1] << 16) | (ptr[2] << 8) | ptr[3];
+    sk_sp<SkData> idat = SkData::MakeWithoutCopy(ptr + 8, length);
+
+    #ifndef SK_PDF_BASE85_BINARY
+    REPORTER_ASSERT(r, is_subset_of(idat.get(), pdfData.get()));
+    #endif
+    static const char kPredictor[] = "/Predictor 15";
+    REPORTER_ASSERT(r, is_subset_of(SkData::MakeWithoutCopy(kPredictor, strlen(kPredictor)).get(),
+                                    pdfData.get()));
 }
 
 #ifdef SK_SUPPORT_PDF
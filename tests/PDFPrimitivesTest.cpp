@@ -23,6 +23,7 @@
 #include "SkPDFDevice.h"
 #include "SkPDFDocumentPriv.h"
 #include "SkPDFFont.h"
+#include "SkPDFFontCache.h"
 #include "SkPDFTypes.h"
 #include "SkPDFUnion.h"
 #include "SkPDFUtils.h"
@@ -440,4 +441,39 @@ DEF_TEST(SkPDF_Clusterator, reporter) {
     }
 }
 
+DEF_TEST(SkPDF_FontCache, reporter) {
+    // Typeface IDs count up from 1, so no real typeface will have this one.
+    const SkFontID fontID = UINT32_MAX;
+
+    SkPDFGlyphUse glyphUsage(1, 100);
+    glyphUsage.set(3);
+    glyphUsage.set(50);
+    SkPDFGlyphUse otherUsage(1, 100);
+    otherUsage.set(3);
+
+    std::vector<int16_t> widths;
+    REPORTER_ASSERT(reporter, !SkPDFFontCache::FindGlyphWidths(fontID, glyphUsage, &widths));
+    SkPDFFontCache::AddGlyphWidths(fontID, glyphUsage, {500, 600, 700});
+    REPORTER_ASSERT(reporter, SkPDFFontCache::FindGlyphWidths(fontID, glyphUsage, &widths));
+    REPORTER_ASSERT(reporter, widths == std::vector<int16_t>({500, 600, 700}));
+    REPORTER_ASSERT(reporter, !SkPDFFontCache::FindGlyphWidths(fontID, otherUsage, &widths));
+
+    SkAdvancedTypefaceMetrics metrics;
+    metrics.fFontName.set("Cached");
+    metrics.fStemV = 42;
+    SkPDFFontCache::AddMetrics(fontID, metrics);
+    SkAdvancedTypefaceMetrics found;
+    REPORTER_ASSERT(reporter, SkPDFFontCache::FindMetrics(fontID, &found));
+    REPORTER_ASSERT(reporter, found.fFontName.equals("Cached") && found.fStemV == 42);
+
+    sk_sp<SkData> cmap = SkData::MakeWithCString("cmap");
+    SkPDFFontCache::AddToUnicodeCmap(fontID, glyphUsage, false, 1, 100, cmap);
+    REPORTER_ASSERT(reporter,
+                    SkPDFFontCache::FindToUnicodeCmap(fontID, glyphUsage, false, 1, 100) == cmap);
+    REPORTER_ASSERT(reporter,
+                    !SkPDFFontCache::FindToUnicodeCmap(fontID, glyphUsage, true, 1, 100));
+    REPORTER_ASSERT(reporter,
+                    !SkPDFFontCache::FindSubsetFont(fontID, 0, glyphUsage));
+}
+
 #endif
@@ -7,6 +7,7 @@
 
 #include "SkAutoMalloc.h"
 #include "SkBlurMask.h"
+#include "SkColorFilter.h"
 #include "SkFont.h"
 #include "SkLayerDrawLooper.h"
 #include "SkMaskFilter.h"
@@ -156,6 +157,34 @@ DEF_TEST(Paint_copy, reporter) {
     REPORTER_ASSERT(reporter, cleanPaint == copiedPaint);
 }
 
+DEF_TEST(Paint_copyOnWrite, reporter) {
+    SkPaint paint;
+    sk_sp<SkMaskFilter> blur = SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 1);
+    paint.setMaskFilter(blur);
+
+    // Changing a copy's effects must leave the original alone.
+    SkPaint copy = paint;
+    copy.setColorFilter(SkColorFilter::MakeModeFilter(SK_ColorRED, SkBlendMode::kSrcIn));
+    REPORTER_ASSERT(reporter, !paint.getColorFilter());
+    REPORTER_ASSERT(reporter, copy.getColorFilter());
+    REPORTER_ASSERT(reporter, copy.getMaskFilter() == blur.get());
+    REPORTER_ASSERT(reporter, paint != copy);
+
+    copy.setMaskFilter(nullptr);
+    REPORTER_ASSERT(reporter, paint.getMaskFilter() == blur.get());
+
+    // Paints with the same effects are equal whether or not they share them.
+    SkPaint other;
+    other.setMaskFilter(blur);
+    REPORTER_ASSERT(reporter, paint == other);
+    REPORTER_ASSERT(reporter, paint.getHash() == other.getHash());
+
+    // Clearing every effect brings a paint back to the default.
+    copy.setColorFilter(nullptr);
+    REPORTER_ASSERT(reporter, copy == SkPaint());
+    REPORTER_ASSERT(reporter, copy.getHash() == SkPaint().getHash());
+}
+
 // found and fixed for webkit: mishandling when we hit recursion limit on
 // mostly degenerate cubic flatness test
 DEF_TEST(Paint_regression_cubic, reporter) {
@@ -5,7 +5,9 @@
  * found in the LICENSE file.
  */
 
+#include "SkMeasuredPath.h"
 #include "SkPathMeasure.h"
+#include "SkResourceCache.h"
 #include "Test.h"
 
 static void test_small_segment3() {
@@ -227,3 +229,69 @@ DEF_TEST(PathMeasure_nextctr, reporter) {
     // only expect 1 contour, even if we didn't explicitly call getLength() ourselves
     REPORTER_ASSERT(reporter, !meas.nextContour());
 }
+
+DEF_TEST(MeasuredPath, reporter) {
+    SkPath path;
+    path.moveTo(0, 0);
+    path.lineTo(100, 0);
+    path.quadTo(150, 50, 100, 100);
+    path.close();
+    path.moveTo(200, 0);
+    path.cubicTo(250, 50, 150, 150, 200, 200);
+    path.conicTo(300, 200, 300, 300, 0.5f);
+
+    // Every contour measures the same as it does through SkPathMeasure.
+    SkResourceCache cache(1024 * 1024);
+    sk_sp<SkMeasuredPath> measure = SkMeasuredPath::Make(path, false, 1, &cache);
+    SkPathMeasure meas(path, false);
+    SkScalar totalLength = 0;
+    int contour = 0;
+    do {
+        REPORTER_ASSERT(reporter, contour < measure->contourCount());
+        SkScalar length = meas.getLength();
+        REPORTER_ASSERT(reporter, measure->length(contour) == length);
+        REPORTER_ASSERT(reporter, measure->isClosed(contour) == meas.isClosed());
+        totalLength += length;
+
+        // Sorted queries walk the segments, unsorted ones search them; both match getPosTan().
+        constexpr int kCount = 100;
+        SkScalar distances[kCount];
+        for (int i = 0; i < kCount; ++i) {
+            distances[i] = length * (i < kCount / 2 ? i : kCount + kCount / 2 - i) / (kCount / 2)
+                         - 1;
+        }
+        SkPoint positions[kCount];
+        SkVector tangents[kCount];
+        REPORTER_ASSERT(reporter,
+                        measure->getPosTans(contour, distances, kCount, positions, tangents));
+        for (int i = 0; i < kCount; ++i) {
+            SkPoint pos;
+            SkVector tan;
+            REPORTER_ASSERT(reporter, meas.getPosTan(distances[i], &pos, &tan));
+            REPORTER_ASSERT(reporter, pos == positions[i] && tan == tangents[i]);
+        }
+
+        SkPath segment, expected;
+        REPORTER_ASSERT(reporter, measure->getSegment(contour, 10, length - 10, &segment, true));
+        REPORTER_ASSERT(reporter, meas.getSegment(10, length - 10, &expected, true));
+        REPORTER_ASSERT(reporter, segment == expected);
+        ++contour;
+    } while (meas.nextContour());
+    REPORTER_ASSERT(reporter, contour == measure->contourCount());
+    REPORTER_ASSERT(reporter, measure->totalLength() == totalLength);
+
+    // The measurement is shared while the path is unchanged, and purged once it changes.
+    REPORTER_ASSERT(reporter, SkMeasuredPath::Make(path, false, 1, &cache) == measure);
+    REPORTER_ASSERT(reporter, SkMeasuredPath::Make(path, true, 1, &cache) != measure);
+    SkPath copy = path;
+    REPORTER_ASSERT(reporter, SkMeasuredPath::Make(copy, false, 1, &cache) == measure);
+    path.lineTo(400, 400);
+    sk_sp<SkMeasuredPath> changed = SkMeasuredPath::Make(path, false, 1, &cache);
+    REPORTER_ASSERT(reporter, changed != measure);
+    REPORTER_ASSERT(reporter, changed->totalLength() > measure->totalLength());
+
+    // Volatile paths are measured each time.
+    path.setIsVolatile(true);
+    REPORTER_ASSERT(reporter, SkMeasuredPath::Make(path, false, 1, &cache) !=
+                              SkMeasuredPath::Make(path, false, 1, &cache));
+}
@@ -361,3 +361,27 @@ SkOpBuilder builder;
     builder.add(path1, SkPathOp::kUnion_SkPathOp);
     builder.resolve(&path);
 }
+
+DEF_TEST(SkOpBuilderOverlappingUnions, reporter) {
+    SkOpBuilder builder;
+    SkPath pairwise;
+    for (int index = 0; index < 6; ++index) {
+        // An L shape, stepped so each overlaps the ones before it.
+        SkScalar x = 7.f * index, y = 5.f * index;
+        SkPath path;
+        path.moveTo(x, y);
+        path.lineTo(x + 30, y);
+        path.lineTo(x + 30, y + 10);
+        path.lineTo(x + 10, y + 10);
+        path.lineTo(x + 10, y + 40);
+        path.lineTo(x, y + 40);
+        path.close();
+        REPORTER_ASSERT(reporter, !path.isConvex());
+        builder.add(path, kUnion_SkPathOp);
+        REPORTER_ASSERT(reporter, Op(pairwise, path, kUnion_SkPathOp, &pairwise));
+    }
+    SkPath result;
+    REPORTER_ASSERT(reporter, builder.resolve(&result));
+    int pixelDiff = comparePaths(reporter, __FUNCTION__, pairwise, result);
+    REPORTER_ASSERT(reporter, pixelDiff == 0);
+}
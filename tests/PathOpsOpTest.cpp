@@ -9103,6 +9103,25 @@ path2.close();
     testPathOp(reporter, path, path2, kIntersect_SkPathOp, filename);
 }
 
+// Two zigzags with enough segments to be intersected through SkOpSegmentTree.
+static void manySegments(skiatest::Reporter* reporter, const char* filename) {
+    SkPath path, pathB;
+    path.moveTo(0, 0);
+    pathB.moveTo(0, 3);
+    for (int x = 0; x <= 64; ++x) {
+        path.lineTo(2 * x + 1, x & 1 ? 8 : 2);
+        pathB.lineTo(2 * x + 1, x & 1 ? 1 : 9);
+    }
+    path.lineTo(130, 0);
+    path.close();
+    pathB.lineTo(130, 20);
+    pathB.lineTo(0, 20);
+    pathB.close();
+    testPathOp(reporter, path, pathB, kUnion_SkPathOp, filename);
+    testPathOp(reporter, path, pathB, kIntersect_SkPathOp, filename);
+    testPathOp(reporter, path, pathB, kDifference_SkPathOp, filename);
+}
+
 static void (*skipTest)(skiatest::Reporter* , const char* filename) = 0;
 static void (*firstTest)(skiatest::Reporter* , const char* filename) = 0;
 static void (*stopTest)(skiatest::Reporter* , const char* filename) = 0;
@@ -9110,6 +9129,7 @@ static void (*stopTest)(skiatest::Reporter* , const char* filename) = 0;
 #define TEST(name) { name, #name }
 
 static struct TestDesc tests[] = {
+    TEST(manySegments),
     TEST(bug8380),
     TEST(crbug_526025),
     TEST(bug8228),
@@ -14,6 +14,7 @@
 #include "GrShape.h"
 #include "GrSoftwarePathRenderer.h"
 #include "GrStyle.h"
+#include "GrTessellationCache.h"
 #include "SkPath.h"
 #include "effects/GrPorterDuffXferProcessor.h"
 #include "ops/GrTessellatingPathRenderer.h"
@@ -153,3 +154,80 @@ DEF_GPUTEST(SoftwarePathRendererCacheTest, reporter, /* options */) {
     test_path(reporter, create_concave_path, createPR, kExpectedResources, GrAAType::kCoverage,
               style);
 }
+
+static GrTessellationCache::Tessellation make_tessellation(int vertexCount, bool isLinear) {
+    GrTessellationCache::Tessellation tess;
+    tess.fVertices = SkData::MakeUninitialized(vertexCount * sizeof(SkPoint));
+    memset(tess.fVertices->writable_data(), 0, tess.fVertices->size());
+    tess.fVertexCount = vertexCount;
+    tess.fVertexStride = sizeof(SkPoint);
+    tess.fIsLinear = isLinear;
+    return tess;
+}
+
+// Test the tolerance buckets, budget and path invalidation of the tessellating path renderer's
+// CPU-side cache.
+DEF_TEST(TessellationCacheTest, reporter) {
+    SkPath path = create_concave_path();
+    // Enough verbs that the shape is keyed by the path's gen ID.
+    for (int i = 0; i < 20; ++i) {
+        path.quadTo(SkIntToScalar(i), 100, SkIntToScalar(i + 1), 0);
+    }
+    path.close();
+
+    sk_sp<GrTessellationCache> cache = sk_make_sp<GrTessellationCache>();
+    GrTessellationCache::Tessellation tess;
+    REPORTER_ASSERT(reporter, GrTessellationCache::BucketTolerance(.3f) == .25f);
+    REPORTER_ASSERT(reporter, GrTessellationCache::BucketTolerance(.25f) == .25f);
+    {
+        GrShape shape(path);
+        REPORTER_ASSERT(reporter, !cache->find(shape, .3f, sizeof(SkPoint), &tess));
+
+        cache->add(shape, .3f, make_tessellation(30, false));
+        REPORTER_ASSERT(reporter, 1 == cache->count());
+        REPORTER_ASSERT(reporter, cache->find(shape, .4f, sizeof(SkPoint), &tess));
+        REPORTER_ASSERT(reporter, 30 == tess.fVertexCount);
+        // A different bucket, or a different vertex layout, misses.
+        REPORTER_ASSERT(reporter, !cache->find(shape, .2f, sizeof(SkPoint), &tess));
+        REPORTER_ASSERT(reporter, !cache->find(shape, .5f, sizeof(SkPoint), &tess));
+        REPORTER_ASSERT(reporter, !cache->find(shape, .3f, 2 * sizeof(SkPoint), &tess));
+
+        cache->add(shape, .2f, make_tessellation(60, false));
+        REPORTER_ASSERT(reporter, 2 == cache->count());
+        REPORTER_ASSERT(reporter, cache->find(shape, .2f, sizeof(SkPoint), &tess));
+        REPORTER_ASSERT(reporter, 60 == tess.fVertexCount);
+    }
+
+    // Deleting the path removes its tessellations.
+    path.reset();
+    REPORTER_ASSERT(reporter, 0 == cache->count());
+    REPORTER_ASSERT(reporter, 0 == cache->bytesUsed());
+
+    // Linear tessellations are good for any tolerance.
+    SkPath linearPath = create_concave_path();
+    GrShape linearShape(linearPath);
+    cache->add(linearShape, .3f, make_tessellation(9, true));
+    REPORTER_ASSERT(reporter, cache->find(linearShape, .01f, sizeof(SkPoint), &tess));
+    REPORTER_ASSERT(reporter, cache->find(linearShape, 8, sizeof(SkPoint), &tess));
+    REPORTER_ASSERT(reporter, tess.fIsLinear);
+    cache->purgeAll();
+    REPORTER_ASSERT(reporter, 0 == cache->count());
+
+    // The least recently used tessellations are dropped to stay under budget.
+    static constexpr size_t kBudget = 4 * 100 * sizeof(SkPoint);
+    sk_sp<GrTessellationCache> smallCache = sk_make_sp<GrTessellationCache>(kBudget);
+    SkPath paths[6];
+    for (int i = 0; i < 6; ++i) {
+        paths[i] = create_concave_path();
+        paths[i].offset(SkIntToScalar(i), 0);
+        smallCache->add(GrShape(paths[i]), 1, make_tessellation(100, false));
+        REPORTER_ASSERT(reporter, smallCache->bytesUsed() <= kBudget);
+    }
+    REPORTER_ASSERT(reporter, 4 == smallCache->count());
+    REPORTER_ASSERT(reporter, !smallCache->find(GrShape(paths[0]), 1, sizeof(SkPoint), &tess));
+    REPORTER_ASSERT(reporter, smallCache->find(GrShape(paths[5]), 1, sizeof(SkPoint), &tess));
+
+    // Tessellations larger than a quarter of the budget aren't cached.
+    smallCache->add(GrShape(paths[0]), 1, make_tessellation(101, false));
+    REPORTER_ASSERT(reporter, !smallCache->find(GrShape(paths[0]), 1, sizeof(SkPoint), &tess));
+}
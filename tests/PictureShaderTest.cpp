@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkPicture.h"
 #include "SkPictureRecorder.h"
@@ -78,3 +79,30 @@ DEF_TEST(PictureShader_caching, reporter) {
     // All but the local ref should be gone now.
     REPORTER_ASSERT(reporter, picture->unique());
 }
+
+// Huge pictures seen through a small window are rasterized at full resolution, in pieces.
+DEF_TEST(PictureShader_tiled, reporter) {
+    SkPictureRecorder recorder;
+    SkCanvas* recordingCanvas = recorder.beginRecording(4000, 4000);
+    SkPaint red, green;
+    red.setColor(SK_ColorRED);
+    green.setColor(SK_ColorGREEN);
+    recordingCanvas->drawRect(SkRect::MakeWH(2001, 4000), red);
+    recordingCanvas->drawRect(SkRect::MakeLTRB(2001, 0, 4000, 4000), green);
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    const SkMatrix localMatrix = SkMatrix::MakeTrans(-1951, -1951);
+    SkPaint paint;
+    paint.setShader(SkPictureShader::Make(picture,
+                                          SkShader::kClamp_TileMode,
+                                          SkShader::kClamp_TileMode, &localMatrix, nullptr));
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(100, 100);
+    SkCanvas canvas(bitmap);
+    canvas.drawPaint(paint);
+
+    // Squeezing the whole picture into one 2048x2048 tile would blur the edge between the halves.
+    REPORTER_ASSERT(reporter, bitmap.getColor(49, 50) == SK_ColorRED);
+    REPORTER_ASSERT(reporter, bitmap.getColor(50, 50) == SK_ColorGREEN);
+}
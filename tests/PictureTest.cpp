@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "Resources.h"
 #include "SkBBHFactory.h"
 #include "SkBBoxHierarchy.h"
 #include "SkBigPicture.h"
@@ -15,9 +16,11 @@
 #include "SkColor.h"
 #include "SkData.h"
 #include "SkFontStyle.h"
+#include "SkImage.h"
 #include "SkImageInfo.h"
 #include "SkMatrix.h"
 #include "SkMiniRecorder.h"
+#include "SkNoDrawCanvas.h"
 #include "SkPaint.h"
 #include "SkPath.h"
 #include "SkPicturePriv.h"
@@ -28,8 +31,10 @@
 #include "SkRectPriv.h"
 #include "SkRefCnt.h"
 #include "SkScalar.h"
+#include "SkSerialProcs.h"
 #include "SkShader.h"
 #include "SkStream.h"
+#include "SkTArray.h"
 #include "SkTypeface.h"
 #include "SkTypes.h"
 #include "Test.h"
@@ -880,3 +885,95 @@ DEF_TEST(Picture_empty_serial, reporter) {
     REPORTER_ASSERT(reporter, pic2);
 }
 
+
+DEF_TEST(Picture_MakeFromDataWithoutCopy, reporter) {
+    sk_sp<SkImage> image = GetResourceAsImage("images/mandrill_128.png");
+    if (!image) {
+        return;
+    }
+    SkPictureRecorder rec;
+    rec.beginRecording(128, 128)->drawImage(image, 0, 0);
+    sk_sp<SkData> data = rec.finishRecordingAsPicture()->serialize();
+
+    struct ImageCatcher : public SkNoDrawCanvas {
+        ImageCatcher() : SkNoDrawCanvas(128, 128) {}
+        void onDrawImage(const SkImage* image, SkScalar, SkScalar, const SkPaint*) override {
+            fEncoded = image->refEncodedData();
+        }
+        sk_sp<SkData> fEncoded;
+    };
+    auto inData = [&](const sk_sp<SkData>& encoded) {
+        return encoded && data->bytes() <= encoded->bytes() &&
+               encoded->bytes() + encoded->size() <= data->bytes() + data->size();
+    };
+
+    ImageCatcher copied;
+    SkPicture::MakeFromData(data.get())->playback(&copied);
+    REPORTER_ASSERT(reporter, copied.fEncoded && !inData(copied.fEncoded));
+
+    sk_sp<SkPicture> pic = SkPicture::MakeFromDataWithoutCopy(data);
+    REPORTER_ASSERT(reporter, pic);
+    ImageCatcher shared;
+    pic->playback(&shared);
+    REPORTER_ASSERT(reporter, inData(shared.fEncoded));
+    REPORTER_ASSERT(reporter, shared.fEncoded->equals(copied.fEncoded.get()));
+
+    REPORTER_ASSERT(reporter, !SkPicture::MakeFromDataWithoutCopy(nullptr));
+    REPORTER_ASSERT(reporter,
+                    !SkPicture::MakeFromDataWithoutCopy(SkData::MakeSubset(data.get(), 0, 20)));
+}
+
+// Pages of a document often draw the same image; it should only be encoded (and stored) once,
+// even when each page holds its own SkImage decoded from the same file.
+DEF_TEST(Picture_sharedImages, reporter) {
+    sk_sp<SkData> encoded = GetResourceAsData("images/mandrill_128.png");
+    if (!encoded) {
+        return;
+    }
+    sk_sp<SkImage> image = SkImage::MakeFromEncoded(encoded);
+    sk_sp<SkImage> sameContent = SkImage::MakeFromEncoded(encoded);
+
+    auto make_page = [](sk_sp<SkImage> img) {
+        SkPictureRecorder rec;
+        SkCanvas* canvas = rec.beginRecording(128, 128);
+        canvas->drawImage(img, 0, 0);
+        canvas->drawRect(SkRect::MakeWH(10, 10), SkPaint());  // Keep the page from being inlined.
+        return rec.finishRecordingAsPicture();
+    };
+    SkPictureRecorder rec;
+    SkCanvas* canvas = rec.beginRecording(128, 384);
+    canvas->drawPicture(make_page(image));
+    canvas->translate(0, 128);
+    canvas->drawPicture(make_page(image));
+    canvas->translate(0, 128);
+    canvas->drawPicture(make_page(sameContent));
+    sk_sp<SkPicture> pic = rec.finishRecordingAsPicture();
+
+    int encodeCount = 0;
+    SkSerialProcs procs;
+    procs.fImageCtx = &encodeCount;
+    procs.fImageProc = [](SkImage*, void* ctx) -> sk_sp<SkData> {
+        *(int*)ctx += 1;
+        return nullptr;
+    };
+    sk_sp<SkData> data = pic->serialize(&procs);
+    REPORTER_ASSERT(reporter, 2 == encodeCount);  // Once per distinct SkImage...
+    REPORTER_ASSERT(reporter, data->size() < 2 * encoded->size());  // ...but stored once.
+
+    struct ImageCounter : public SkNoDrawCanvas {
+        ImageCounter() : SkNoDrawCanvas(128, 384) {}
+        void onDrawImage(const SkImage* img, SkScalar, SkScalar, const SkPaint*) override {
+            fImages.push_back(img);
+        }
+        SkTArray<const SkImage*> fImages;
+    };
+    sk_sp<SkPicture> copy = SkPicture::MakeFromData(data.get());
+    REPORTER_ASSERT(reporter, copy);
+    ImageCounter counter;
+    copy->playback(&counter);
+    REPORTER_ASSERT(reporter, 3 == counter.fImages.count());
+    for (const SkImage* img : counter.fImages) {
+        REPORTER_ASSERT(reporter, img == counter.fImages[0]);
+        REPORTER_ASSERT(reporter, img->width() == 128 && img->height() == 128);
+    }
+}
@@ -12,6 +12,7 @@
 #include "GrContextPriv.h"
 #include "GrGpu.h"
 #include "GrTexture.h"
+#include "SkDeferredDisplayListRecorder.h"
 #include "SkImage_Gpu.h"
 #include "SkPromiseImageTexture.h"
 
@@ -915,3 +916,82 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(PromiseImageTextureFullCache, reporter, ctxIn
     gpu->testingOnly_flushGpuAndSync();
     gpu->deleteTestingOnlyBackendTexture(backendTex);
 }
+
+// Fulfills each image with its PromiseTextureChecker's texture.
+static void promise_batch_fulfill(void* batchCount, void* const textureContexts[],
+                                  sk_sp<SkPromiseImageTexture> textures[], int count) {
+    ++*static_cast<int*>(batchCount);
+    for (int i = 0; i < count; ++i) {
+        auto checker = static_cast<PromiseTextureChecker*>(textureContexts[i]);
+        checker->fFulfillCount++;
+        textures[i] = checker->fTexture;
+    }
+}
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(PromiseImageBatchFulfill, reporter, ctxInfo) {
+    const int kWidth = 10;
+    const int kHeight = 10;
+
+    GrContext* ctx = ctxInfo.grContext();
+    GrGpu* gpu = ctx->contextPriv().getGpu();
+
+    GrBackendTexture backendTex = gpu->createTestingOnlyBackendTexture(
+            nullptr, kWidth, kHeight, GrColorType::kRGBA_8888, false, GrMipMapped::kNo);
+    REPORTER_ASSERT(reporter, backendTex.isValid());
+
+    SkImageInfo info = SkImageInfo::MakeN32Premul(kWidth, kHeight);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(ctx, SkBudgeted::kNo, info);
+    SkSurfaceCharacterization characterization;
+    SkAssertResult(surface->characterize(&characterization));
+
+    // The last image isn't drawn. Its texture is released with the DDL.
+    static constexpr int kNumImages = 3;
+    PromiseTextureChecker checkers[kNumImages] = {
+            PromiseTextureChecker(backendTex, reporter, false),
+            PromiseTextureChecker(backendTex, reporter, false),
+            PromiseTextureChecker(backendTex, reporter, false)};
+    int batchCount = 0;
+    {
+        SkDeferredDisplayListRecorder recorder(characterization);
+        recorder.setPromiseImageBatchFulfillProc(promise_batch_fulfill, &batchCount);
+        sk_sp<SkImage> images[kNumImages];
+        for (int i = 0; i < kNumImages; ++i) {
+            images[i] = recorder.makePromiseTexture(
+                    backendTex.getBackendFormat(), kWidth, kHeight, GrMipMapped::kNo,
+                    kTopLeft_GrSurfaceOrigin, kRGBA_8888_SkColorType, kPremul_SkAlphaType,
+                    nullptr, PromiseTextureChecker::Fulfill, PromiseTextureChecker::Release,
+                    PromiseTextureChecker::Done, &checkers[i],
+                    SkDeferredDisplayListRecorder::DelayReleaseCallback::kNo);
+            REPORTER_ASSERT(reporter, images[i]);
+        }
+        SkCanvas* canvas = recorder.getCanvas();
+        canvas->drawImage(images[0], 0, 0);
+        canvas->drawImage(images[1], 0, 0);
+        canvas->drawImage(images[1], 0, 0);
+        std::unique_ptr<SkDeferredDisplayList> ddl = recorder.detach();
+
+        REPORTER_ASSERT(reporter, surface->draw(ddl.get()));
+        REPORTER_ASSERT(reporter, 1 == batchCount);
+        for (const PromiseTextureChecker& checker : checkers) {
+            REPORTER_ASSERT(reporter, 1 == checker.fFulfillCount);
+            REPORTER_ASSERT(reporter, 0 == checker.fReleaseCount);
+        }
+
+        surface->flush();
+        gpu->testingOnly_flushGpuAndSync();
+        REPORTER_ASSERT(reporter, 1 == batchCount);
+        for (int i = 0; i < 2; ++i) {
+            REPORTER_ASSERT(reporter, 1 == checkers[i].fFulfillCount);
+            REPORTER_ASSERT(reporter, 1 == checkers[i].fReleaseCount);
+        }
+        REPORTER_ASSERT(reporter, 0 == checkers[2].fReleaseCount);
+    }
+
+    for (const PromiseTextureChecker& checker : checkers) {
+        REPORTER_ASSERT(reporter, 1 == checker.fFulfillCount);
+        REPORTER_ASSERT(reporter, 1 == checker.fReleaseCount);
+        REPORTER_ASSERT(reporter, 1 == checker.fDoneCount);
+    }
+
+    gpu->deleteTestingOnlyBackendTexture(backendTex);
+}
@@ -53,6 +53,36 @@ static void run_queries(skiatest::Reporter* reporter, SkRandom& rand, SkRect rec
     }
 }
 
+// Queries covering most of the tree take a different path through search().
+static void run_large_queries(skiatest::Reporter* reporter, SkRandom& rand, SkRect rects[],
+                              const SkRTree& tree) {
+    for (size_t i = 0; i < NUM_QUERIES; ++i) {
+        SkTDArray<int> hits;
+        SkRect query = tree.getRootBound();
+        query.fLeft   += rand.nextRangeF(0, 0.1f * query.width());
+        query.fTop    += rand.nextRangeF(0, 0.1f * query.height());
+        query.fRight  -= rand.nextRangeF(0, 0.1f * query.width());
+        query.fBottom -= rand.nextRangeF(0, 0.1f * query.height());
+        tree.search(query, &hits);
+        REPORTER_ASSERT(reporter, verify_query(query, rects, hits));
+    }
+}
+
+// searchAll() should find exactly what search() does for each query, including empty ones.
+static void run_batched_queries(skiatest::Reporter* reporter, SkRandom& rand, SkRect rects[],
+                                const SkRTree& tree) {
+    SkRect queries[NUM_QUERIES];
+    for (size_t i = 0; i < NUM_QUERIES; ++i) {
+        queries[i] = random_rect(rand);
+    }
+    queries[0].setEmpty();
+    SkTDArray<int> hits[NUM_QUERIES];
+    tree.searchAll(queries, NUM_QUERIES, hits);
+    for (size_t i = 0; i < NUM_QUERIES; ++i) {
+        REPORTER_ASSERT(reporter, verify_query(queries[i], rects, hits[i]));
+    }
+}
+
 DEF_TEST(RTree, reporter) {
     int expectedDepthMin = -1;
     int tmp = NUM_RECTS;
@@ -84,6 +114,8 @@ DEF_TEST(RTree, reporter) {
         SkASSERT(rects);  // SkRTree doesn't take ownership of rects.
 
         run_queries(reporter, rand, rects, rtree);
+        run_large_queries(reporter, rand, rects, rtree);
+        run_batched_queries(reporter, rand, rects, rtree);
         REPORTER_ASSERT(reporter, NUM_RECTS == rtree.getCount());
         REPORTER_ASSERT(reporter, expectedDepthMin <= rtree.getDepth() &&
                                   expectedDepthMax >= rtree.getDepth());
@@ -8,9 +8,13 @@
 #include <initializer_list>
 #include "SkCanvas.h"
 #include "SkColorData.h"
+#include "SkColorSpace.h"
+#include "SkConvertPixels.h"
+#include "SkExecutor.h"
 #include "SkHalf.h"
 #include "SkImageInfoPriv.h"
 #include "SkMathPriv.h"
+#include "SkRandom.h"
 #include "SkSurface.h"
 #include "Test.h"
 
@@ -688,3 +692,39 @@ DEF_TEST(ReadPixels_ValidConversion, reporter) {
         }
     }
 }
+
+DEF_TEST(ReadWritePixels_Parallel, reporter) {
+    // This executor has to outlive any other test that might see it in gSkConvertPixelsExecutor.
+    static std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    auto p3 = SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB, SkNamedGamut::kDCIP3);
+    SkBitmap src;
+    src.allocPixels(SkImageInfo::Make(601, 1003, kRGBA_8888_SkColorType, kUnpremul_SkAlphaType));
+    SkRandom rand;
+    for (int y = 0; y < src.height(); ++y) {
+        for (int x = 0; x < src.width(); ++x) {
+            *src.getAddr32(x, y) = rand.nextU();
+        }
+    }
+
+    for (SkColorType ct : { kBGRA_8888_SkColorType, kRGBA_F16_SkColorType }) {
+        SkImageInfo dstInfo = src.info().makeColorType(ct)
+                                        .makeAlphaType(kPremul_SkAlphaType)
+                                        .makeColorSpace(p3);
+        SkBitmap serial, parallel, written;
+        serial.allocPixels(dstInfo);
+        parallel.allocPixels(dstInfo);
+        written.allocPixels(dstInfo);
+
+        REPORTER_ASSERT(reporter, src.readPixels(serial.pixmap()));
+        gSkConvertPixelsExecutor = executor.get();
+        REPORTER_ASSERT(reporter, src.readPixels(parallel.pixmap()));
+        REPORTER_ASSERT(reporter, written.writePixels(src.pixmap()));
+        gSkConvertPixelsExecutor = nullptr;
+
+        REPORTER_ASSERT(reporter, !memcmp(serial.getPixels(), parallel.getPixels(),
+                                          serial.computeByteSize()));
+        REPORTER_ASSERT(reporter, !memcmp(serial.getPixels(), written.getPixels(),
+                                          serial.computeByteSize()));
+    }
+}
@@ -427,3 +427,202 @@ DEF_TEST(savelayer_srcmode_alpha, r) {
     do_savelayer_srcmode(r, 0x80FF0000);
 }
 
+
+DEF_TEST(RecordOpts_CullOccludedDraws, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    SkPaint opaque, translucent;
+    translucent.setAlpha(0x80);
+
+    recorder.drawRect(SkRect::MakeXYWH(10, 10, 50, 50), opaque);           // 0: covered by 4
+    recorder.drawRect(SkRect::MakeXYWH(500, 500, 50, 50), opaque);         // 1: not covered
+    recorder.drawAnnotation(SkRect::MakeXYWH(10, 10, 5, 5), "key", nullptr);  // 2: not a draw
+    recorder.drawRect(SkRect::MakeXYWH(20, 20, 50, 50), translucent);      // 3: covered by 4
+    recorder.drawRect(SkRect::MakeWH(200, 200), opaque);                   // 4
+    recorder.drawRect(SkRect::MakeXYWH(500, 500, 10, 10), opaque);         // 5: stays, 6 is
+    recorder.drawRect(SkRect::MakeWH(600, 600), translucent);              // 6: translucent
+
+    SkRecordCullOccludedDraws(&record, SkRect::MakeWH(W, H));
+    assert_type<SkRecords::NoOp>(r, record, 0);
+    assert_type<SkRecords::DrawRect>(r, record, 1);
+    assert_type<SkRecords::DrawAnnotation>(r, record, 2);
+    assert_type<SkRecords::NoOp>(r, record, 3);
+    assert_type<SkRecords::DrawRect>(r, record, 4);
+    assert_type<SkRecords::DrawRect>(r, record, 5);
+    assert_type<SkRecords::DrawRect>(r, record, 6);
+}
+
+DEF_TEST(RecordOpts_CullOccludedDrawsRespectsStateAndLayers, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    SkPaint opaque;
+    recorder.drawRect(SkRect::MakeXYWH(10, 10, 50, 50), opaque);      // 0: the clip saves it
+    recorder.save();
+        recorder.clipRect(SkRect::MakeWH(30, 30));                    // 2
+        recorder.drawRect(SkRect::MakeWH(200, 200), opaque);          // 3
+    recorder.restore();
+    recorder.drawRect(SkRect::MakeXYWH(10, 10, 50, 50), opaque);      // 5: the layer saves it
+    recorder.saveLayer(nullptr, nullptr);
+        recorder.drawRect(SkRect::MakeWH(200, 200), opaque);          // 7
+    recorder.restore();
+    recorder.translate(100, 100);
+    recorder.drawRect(SkRect::MakeXYWH(10, 10, 50, 50), opaque);      // 10: covered by 11
+    recorder.drawRect(SkRect::MakeWH(100, 100), opaque);              // 11
+
+    SkRecordCullOccludedDraws(&record, SkRect::MakeWH(W, H));
+    assert_type<SkRecords::DrawRect>(r, record, 0);
+    assert_type<SkRecords::DrawRect>(r, record, 5);
+    assert_type<SkRecords::NoOp>(r, record, 10);
+    assert_type<SkRecords::DrawRect>(r, record, 11);
+}
+
+DEF_TEST(RecordOpts_NoopRedundantStateChanges, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    recorder.setMatrix(SkMatrix::I());                      // 0: already identity
+    recorder.clipRect(SkRect::MakeWH(100, 100));            // 1: stays
+    recorder.clipRect(SkRect::MakeWH(200, 200));            // 2: contains the clip
+    recorder.clipRect(SkRect::MakeWH(50, 50));              // 3: stays
+    recorder.translate(10, 10);                             // 4: stays
+    recorder.setMatrix(SkMatrix::MakeTrans(10, 10));        // 5: already the matrix
+    recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());   // 6
+
+    SkRecordNoopRedundantStateChanges(&record);
+    assert_type<SkRecords::NoOp>(r, record, 0);
+    assert_type<SkRecords::ClipRect>(r, record, 1);
+    assert_type<SkRecords::NoOp>(r, record, 2);
+    assert_type<SkRecords::ClipRect>(r, record, 3);
+    assert_type<SkRecords::Translate>(r, record, 4);
+    assert_type<SkRecords::NoOp>(r, record, 5);
+    assert_type<SkRecords::DrawRect>(r, record, 6);
+}
+
+DEF_TEST(RecordOpts_MergeImageRects, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(10, 10);
+    bitmap.eraseColor(SK_ColorBLUE);
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(bitmap);
+
+    SkPaint paint, halfAlpha, multiply;
+    halfAlpha.setAlpha(0x80);
+    multiply.setBlendMode(SkBlendMode::kMultiply);
+    auto draw = [&](SkScalar x, const SkPaint& paint) {
+        recorder.drawImageRect(image, SkRect::MakeWH(10, 10), SkRect::MakeXYWH(x, 0, 10, 10),
+                               &paint, SkCanvas::kFast_SrcRectConstraint);
+    };
+    draw(0, paint);
+    draw(10, halfAlpha);
+    draw(20, paint);
+    draw(30, multiply);   // Blends differently, so it starts a new run...
+    draw(40, paint);      // ... and so does this.
+    recorder.drawImageRect(image, SkRect::MakeWH(10, 10), SkRect::MakeXYWH(50, 0, 10, 10),
+                           &paint, SkCanvas::kStrict_SrcRectConstraint);
+
+    SkRecordMergeImageRects(&record);
+    const SkRecords::DrawImageSet* set = assert_type<SkRecords::DrawImageSet>(r, record, 0);
+    REPORTER_ASSERT(r, set && 3 == set->count);
+    if (set && 3 == set->count) {
+        REPORTER_ASSERT(r, 0.5f < set->set[1].fAlpha && set->set[1].fAlpha < 0.51f);
+        REPORTER_ASSERT(r, SkRect::MakeXYWH(20, 0, 10, 10) == set->set[2].fDstRect);
+    }
+    assert_type<SkRecords::NoOp>(r, record, 1);
+    assert_type<SkRecords::NoOp>(r, record, 2);
+    assert_type<SkRecords::DrawImageRect>(r, record, 3);
+    assert_type<SkRecords::DrawImageRect>(r, record, 4);
+    assert_type<SkRecords::DrawImageRect>(r, record, 5);
+}
+
+DEF_TEST(RecordOpts_BoundSaveLayers, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    SkPaint translucent, dstIn, blurry;
+    translucent.setAlpha(0x80);
+    dstIn.setBlendMode(SkBlendMode::kDstIn);
+    blurry.setImageFilter(SkBlurImageFilter::Make(3, 3, nullptr));
+
+    recorder.translate(10, 10);
+    recorder.saveLayer(nullptr, &translucent);                          // 1: bounded
+        recorder.drawRect(SkRect::MakeWH(20, 20), SkPaint());
+        recorder.drawRect(SkRect::MakeXYWH(30, 5, 10, 10), SkPaint());
+    recorder.restore();
+    recorder.saveLayer(nullptr, &dstIn);                                // 5: changes the dst
+        recorder.drawRect(SkRect::MakeWH(20, 20), SkPaint());
+    recorder.restore();
+    recorder.saveLayer(nullptr, &blurry);                               // 8: filters its contents
+        recorder.drawRect(SkRect::MakeWH(20, 20), SkPaint());
+    recorder.restore();
+    SkRect hint = SkRect::MakeWH(100, 100);
+    recorder.saveLayer(&hint, nullptr);                                 // 11: already bounded
+        recorder.drawRect(SkRect::MakeWH(20, 20), SkPaint());
+    recorder.restore();
+
+    SkRecordBoundSaveLayers(&record, SkRect::MakeWH(W, H));
+    auto bounds = [&](int i) -> const SkRect* {
+        auto op = assert_type<SkRecords::SaveLayer>(r, record, i);
+        return op ? static_cast<const SkRect*>(op->bounds) : nullptr;
+    };
+    REPORTER_ASSERT(r, bounds(1) && *bounds(1) == SkRect::MakeWH(40, 20));
+    REPORTER_ASSERT(r, !bounds(5));
+    REPORTER_ASSERT(r, !bounds(8));
+    REPORTER_ASSERT(r, bounds(11) && *bounds(11) == hint);
+}
+
+// A picture optimized for playback should draw exactly what the original does.
+DEF_TEST(RecordOpts_OptimizeForPlaybackDrawsTheSame, r) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(16, 16, true);
+    bitmap.eraseColor(SK_ColorGREEN);
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(bitmap);
+
+    auto record = [&](uint32_t finishFlags) {
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(200, 200);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int i = 0; i < 20; i++) {
+            paint.setColor(0xFF000000 | (i * 0x0C0B0A));
+            canvas->drawCircle(10.5f * i, 7.25f * i, 12, paint);
+        }
+        canvas->save();
+            canvas->clipRect(SkRect::MakeXYWH(20, 20, 100, 100));
+            canvas->setMatrix(SkMatrix::I());
+            canvas->drawPaint(SkPaint());
+        canvas->restore();
+        for (int i = 0; i < 8; i++) {
+            paint.setAlpha(0x40 + 0x18 * i);
+            canvas->drawImageRect(image, SkRect::MakeWH(16, 16),
+                                  SkRect::MakeXYWH(4 * i + 120, 4 * i + 120, 24, 24), &paint,
+                                  SkCanvas::kFast_SrcRectConstraint);
+        }
+        canvas->drawRect(SkRect::MakeXYWH(0.5f, 150.5f, 60, 40), SkPaint());
+        canvas->save();
+            canvas->rotate(30, 150, 50);
+            canvas->saveLayerAlpha(nullptr, 0x80);
+                canvas->drawCircle(150, 50, 20.5f, paint);
+                canvas->drawRect(SkRect::MakeXYWH(160.25f, 40, 30, 8), paint);
+            canvas->restore();
+        canvas->restore();
+        return recorder.finishRecordingAsPicture(finishFlags);
+    };
+
+    sk_sp<SkPicture> pictures[] = {
+        record(0),
+        record(SkPictureRecorder::kOptimizeForPlayback_FinishFlag),
+    };
+    SkBitmap results[2];
+    for (int i = 0; i < 2; i++) {
+        results[i].allocN32Pixels(200, 200);
+        SkCanvas canvas(results[i]);
+        canvas.clear(SK_ColorWHITE);
+        canvas.drawPicture(pictures[i]);
+    }
+    REPORTER_ASSERT(r, 0 == memcmp(results[0].getPixels(), results[1].getPixels(),
+                                   results[0].computeByteSize()));
+}
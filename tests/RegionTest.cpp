@@ -515,3 +515,35 @@ DEF_TEST(region_empty_iter, reporter) {
     REPORTER_ASSERT(reporter, !left);
     REPORTER_ASSERT(reporter, !right);
 }
+
+// Ops on regions whose bands only partly overlap in Y copy one operand's intervals straight
+// through on the other bands. Check every op against a per-pixel evaluation.
+DEF_TEST(region_op_one_sided_bands, reporter) {
+    SkRegion a, b;
+    Union(&a, SkIRect::MakeLTRB( 0,  0, 10, 10));
+    Union(&a, SkIRect::MakeLTRB(20,  0, 30, 10));
+    Union(&a, SkIRect::MakeLTRB( 5, 20, 25, 30));
+    Union(&b, SkIRect::MakeLTRB( 8,  5, 22, 25));
+    Union(&b, SkIRect::MakeLTRB(28, 25, 40, 40));
+
+    for (int op = 0; op <= SkRegion::kLastOp; ++op) {
+        SkRegion result;
+        result.op(a, b, (SkRegion::Op)op);
+        for (int y = -1; y <= 41; ++y) {
+            for (int x = -1; x <= 41; ++x) {
+                bool inA = a.contains(x, y),
+                     inB = b.contains(x, y),
+                     expected = false;
+                switch ((SkRegion::Op)op) {
+                    case SkRegion::kDifference_Op:        expected = inA && !inB; break;
+                    case SkRegion::kIntersect_Op:         expected = inA &&  inB; break;
+                    case SkRegion::kUnion_Op:             expected = inA ||  inB; break;
+                    case SkRegion::kXOR_Op:               expected = inA !=  inB; break;
+                    case SkRegion::kReverseDifference_Op: expected = inB && !inA; break;
+                    case SkRegion::kReplace_Op:           expected = inB;         break;
+                }
+                REPORTER_ASSERT(reporter, result.contains(x, y) == expected);
+            }
+        }
+    }
+}
@@ -106,6 +106,8 @@ static void overlap_test(skiatest::Reporter* reporter, GrResourceProvider* resou
     REPORTER_ASSERT(reporter, p2->peekSurface());
     bool doTheBackingStoresMatch = p1->underlyingUniqueID() == p2->underlyingUniqueID();
     REPORTER_ASSERT(reporter, expectedResult == doTheBackingStoresMatch);
+    // Both surfaces are live at once
+    REPORTER_ASSERT(reporter, alloc.peakTransientBytes() == alloc.allocatedTransientBytes());
 }
 
 // Test various cases when two proxies do not have overlapping intervals.
@@ -129,6 +131,11 @@ static void non_overlap_test(skiatest::Reporter* reporter, GrResourceProvider* r
     REPORTER_ASSERT(reporter, p2->peekSurface());
     bool doTheBackingStoresMatch = p1->underlyingUniqueID() == p2->underlyingUniqueID();
     REPORTER_ASSERT(reporter, expectedResult == doTheBackingStoresMatch);
+    REPORTER_ASSERT(reporter, alloc.peakTransientBytes() <= alloc.allocatedTransientBytes());
+    if (doTheBackingStoresMatch) {
+        // The second interval reused the first's surface
+        REPORTER_ASSERT(reporter, alloc.peakTransientBytes() == alloc.allocatedTransientBytes());
+    }
 }
 
 bool GrResourceProvider::testingOnly_setExplicitlyAllocateGPUResources(bool newValue) {
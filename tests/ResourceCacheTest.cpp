@@ -21,6 +21,7 @@
 
 #include "SkCanvas.h"
 #include "SkGr.h"
+#include "SkGraphics.h"
 #include "SkMessageBus.h"
 #include "SkMipMap.h"
 #include "SkSurface.h"
@@ -1538,6 +1539,122 @@ static void test_tags(skiatest::Reporter* reporter) {
 #endif
 }
 
+static void test_category_budgets(skiatest::Reporter* reporter) {
+    Mock mock(10, 10 * TestResource::kDefaultSize);
+    GrContext* context = mock.context();
+    GrResourceCache* cache = mock.cache();
+    GrGpu* gpu = context->contextPriv().getGpu();
+
+    // Two image resources, followed by two more recently used scratch resources.
+    auto makeResources = [&] {
+        for (int i = 0; i < 2; ++i) {
+            GrUniqueKey key;
+            make_unique_key<0>(&key, i, "Image");
+            TestResource* r = new TestResource(gpu);
+            r->resourcePriv().setUniqueKey(key);
+            r->unref();
+        }
+        for (int i = 0; i < 2; ++i) {
+            TestResource::CreateScratch(gpu, SkBudgeted::kYes,
+                                        TestResource::kA_SimulatedProperty)->unref();
+        }
+    };
+    auto checkUsage = [&](int imageCnt, int scratchCnt) {
+        int count;
+        size_t bytes;
+        context->getResourceCategoryUsage(GrResourceCategory::kImage, &count, &bytes);
+        REPORTER_ASSERT(reporter, imageCnt == count);
+        REPORTER_ASSERT(reporter, imageCnt * TestResource::kDefaultSize == bytes);
+        context->getResourceCategoryUsage(GrResourceCategory::kScratch, &count, &bytes);
+        REPORTER_ASSERT(reporter, scratchCnt == count);
+        REPORTER_ASSERT(reporter, scratchCnt * TestResource::kDefaultSize == bytes);
+    };
+
+    makeResources();
+    checkUsage(2, 2);
+
+    // Without category budgets we purge in LRU order, so the images go first.
+    context->setResourceCacheLimits(10, 3 * TestResource::kDefaultSize);
+    checkUsage(1, 2);
+    cache->purgeAllUnlocked();
+    context->setResourceCacheLimits(10, 10 * TestResource::kDefaultSize);
+
+    // A category over its soft budget is purged first, even if it was used more recently.
+    makeResources();
+    context->setResourceCategoryBudget(GrResourceCategory::kScratch, 0);
+    context->setResourceCacheLimits(10, 3 * TestResource::kDefaultSize);
+    checkUsage(2, 1);
+    context->setResourceCategoryBudget(GrResourceCategory::kScratch, SIZE_MAX);
+    cache->purgeAllUnlocked();
+    context->setResourceCacheLimits(10, 10 * TestResource::kDefaultSize);
+
+    // A heavily weighted category is kept over more recently used resources.
+    makeResources();
+    context->setResourceCategoryBudget(GrResourceCategory::kImage, SIZE_MAX, 100);
+    context->setResourceCacheLimits(10, 2 * TestResource::kDefaultSize);
+    checkUsage(2, 0);
+    REPORTER_ASSERT(reporter, 2 == cache->getResourceCount());
+}
+
+static void test_memory_pressure(skiatest::Reporter* reporter) {
+    using Level = SkGraphics::MemoryPressureLevel;
+    Mock mock(10, 30000);
+    GrContext* context = mock.context();
+    GrResourceCache* cache = mock.cache();
+    GrGpu* gpu = context->contextPriv().getGpu();
+
+    // Two scratch resources and two uniquely keyed ones, all unlocked.
+    auto makeResources = [&]() {
+        for (int i = 0; i < 4; ++i) {
+            TestResource* r = TestResource::CreateScratch(gpu, SkBudgeted::kYes,
+                                                          TestResource::kA_SimulatedProperty, 10);
+            if (i >= 2) {
+                GrUniqueKey key;
+                make_unique_key<0>(&key, i);
+                r->resourcePriv().setUniqueKey(key);
+            }
+            r->unref();
+        }
+        REPORTER_ASSERT(reporter, 4 == cache->getResourceCount());
+    };
+
+    // Moderate pressure only drops the scratch resources.
+    makeResources();
+    context->trimForMemoryPressure(Level::kModerate);
+    REPORTER_ASSERT(reporter, 2 == cache->getResourceCount());
+
+    // High pressure keeps half of the uniquely keyed resources.
+    context->trimForMemoryPressure(Level::kHigh);
+    REPORTER_ASSERT(reporter, 1 == cache->getResourceCount());
+
+    // Critical pressure drops everything unlocked.
+    context->trimForMemoryPressure(Level::kCritical);
+    REPORTER_ASSERT(reporter, 0 == cache->getResourceCount());
+
+    // Global notifications are applied when the context next flushes, and only once.
+    makeResources();
+    SkGraphics::NotifyMemoryPressure(Level::kModerate);
+    REPORTER_ASSERT(reporter, 4 == cache->getResourceCount());
+    context->flush();
+    REPORTER_ASSERT(reporter, 2 == cache->getResourceCount());
+    makeResources();
+    context->flush();
+    REPORTER_ASSERT(reporter, 6 == cache->getResourceCount());
+
+    // The most severe level since the last check wins.
+    SkGraphics::NotifyMemoryPressure(Level::kCritical);
+    SkGraphics::NotifyMemoryPressure(Level::kModerate);
+    context->performDeferredCleanup(std::chrono::milliseconds(1000 * 60 * 60));
+    REPORTER_ASSERT(reporter, 0 == cache->getResourceCount());
+
+    REPORTER_ASSERT(reporter,
+                    Level::kModerate == SkGraphics::MemoryPressureLevelFromAndroidTrimLevel(5));
+    REPORTER_ASSERT(reporter,
+                    Level::kHigh == SkGraphics::MemoryPressureLevelFromAndroidTrimLevel(20));
+    REPORTER_ASSERT(reporter,
+                    Level::kCritical == SkGraphics::MemoryPressureLevelFromAndroidTrimLevel(80));
+}
+
 static void test_free_resource_messages(skiatest::Reporter* reporter) {
     Mock mock(10, 30000);
     GrContext* context = mock.context();
@@ -1609,7 +1726,9 @@ DEF_GPUTEST(ResourceCacheMisc, reporter, /* options */) {
     test_custom_data(reporter);
     test_abandoned(reporter);
     test_tags(reporter);
+    test_category_budgets(reporter);
     test_free_resource_messages(reporter);
+    test_memory_pressure(reporter);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -69,3 +69,28 @@ DEF_TEST(ComposeShaderSingle, reporter) {
     rr.setRectRadii({0, 0, 0, 0}, rd);
     canvas.drawRRect(rr, p);
 }
+
+// Stitched noise is drawn from one rendering of its tile, so it repeats exactly.
+DEF_TEST(PerlinNoise_StitchedTiles, reporter) {
+    const SkISize tileSize = SkISize::Make(24, 16);
+    SkPaint p;
+    p.setShader(SkPerlinNoiseShader::MakeTurbulence(0.1f, 0.1f, 3, 4.0f, &tileSize));
+    p.setBlendMode(SkBlendMode::kSrc);
+
+    SkBitmap bitmaps[2];
+    for (SkBitmap& bitmap : bitmaps) {
+        bitmap.allocN32Pixels(2 * tileSize.width(), 2 * tileSize.height());
+        bitmap.eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas canvas(bitmap);
+        canvas.drawPaint(p);
+    }
+
+    for (int y = 0; y < tileSize.height(); ++y) {
+        for (int x = 0; x < tileSize.width(); ++x) {
+            SkPMColor c = *bitmaps[0].getAddr32(x, y);
+            REPORTER_ASSERT(reporter, c == *bitmaps[0].getAddr32(x + tileSize.width(), y));
+            REPORTER_ASSERT(reporter, c == *bitmaps[0].getAddr32(x, y + tileSize.height()));
+            REPORTER_ASSERT(reporter, c == *bitmaps[1].getAddr32(x, y));
+        }
+    }
+}
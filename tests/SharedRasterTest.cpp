@@ -0,0 +1,100 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCanvas.h"
+#include "SkSharedRaster.h"
+#include "SkSurface.h"
+#include "Test.h"
+
+#if !defined(SK_BUILD_FOR_WIN)
+    #include <unistd.h>
+#endif
+
+static SkPMColor pixel_at(const SkSharedPixelMemory& memory, const SkImageInfo& info, int x, int y) {
+    return static_cast<const SkPMColor*>(memory.pixels())[y * info.width() + x];
+}
+
+DEF_TEST(SharedRaster_Memory, r) {
+    sk_sp<SkSharedPixelMemory> memory = SkSharedPixelMemory::Make(4096);
+    if (!memory) {
+        return;  // No shared memory on this platform.
+    }
+    REPORTER_ASSERT(r, memory->size() == 4096);
+    REPORTER_ASSERT(r, static_cast<const uint8_t*>(memory->pixels())[100] == 0);
+
+#if !defined(SK_BUILD_FOR_WIN)
+    // A second mapping of the same fd, as another process would make, sees the same pixels.
+    sk_sp<SkSharedPixelMemory> mirror = SkSharedPixelMemory::MakeFromFD(dup(memory->fd()), 4096);
+    REPORTER_ASSERT(r, mirror);
+    if (mirror) {
+        SkImageInfo info = SkImageInfo::MakeN32Premul(16, 16);
+        sk_sp<SkSurface> surface = memory->makeSurface(info);
+        REPORTER_ASSERT(r, surface);
+        surface->getCanvas()->clear(SK_ColorBLUE);
+        REPORTER_ASSERT(r, pixel_at(*mirror, info, 7, 9) == SkPreMultiplyColor(SK_ColorBLUE));
+    }
+#endif
+
+    // Surfaces must fit in the memory.
+    REPORTER_ASSERT(r, !memory->makeSurface(SkImageInfo::MakeN32Premul(64, 64)));
+}
+
+DEF_TEST(SharedRaster_HandleAllocator, r) {
+    SkImageInfo info = SkImageInfo::MakeN32Premul(32, 32);
+    std::unique_ptr<SkCanvas> canvas = SkSharedRasterHandleAllocator::MakeCanvas(info);
+    if (!canvas) {
+        return;  // No shared memory on this platform.
+    }
+    canvas->translate(3, 4);
+    canvas->clipRect(SkRect::MakeWH(10, 10));
+    canvas->clear(SK_ColorRED);
+
+    auto layer = static_cast<const SkSharedRasterHandleAllocator::Layer*>(
+            canvas->accessTopRasterHandle());
+    REPORTER_ASSERT(r, layer);
+    REPORTER_ASSERT(r, layer->fInfo.dimensions() == info.dimensions());
+    REPORTER_ASSERT(r, layer->fMatrix == SkMatrix::MakeTrans(3, 4));
+    REPORTER_ASSERT(r, layer->fClip == SkIRect::MakeXYWH(3, 4, 10, 10));
+    REPORTER_ASSERT(r, pixel_at(*layer->fMemory, info, 5, 5) == SkPreMultiplyColor(SK_ColorRED));
+    REPORTER_ASSERT(r, pixel_at(*layer->fMemory, info, 20, 20) == 0);
+}
+
+DEF_TEST(SharedRaster_Swapchain, r) {
+    SkImageInfo info = SkImageInfo::MakeN32Premul(32, 32);
+    std::unique_ptr<SkSharedRasterSwapchain> swapchain = SkSharedRasterSwapchain::Make(info);
+    if (!swapchain) {
+        return;  // No shared memory on this platform.
+    }
+    REPORTER_ASSERT(r, swapchain->frontIndex() == -1);
+
+    SkIRect damage;
+    swapchain->beginFrame(info.bounds())->getCanvas()->clear(SK_ColorRED);
+    REPORTER_ASSERT(r, swapchain->endFrame(&damage) == 0);
+    REPORTER_ASSERT(r, damage == info.bounds());
+
+    // Only the damaged area is drawn; the rest comes from the first frame.
+    const SkIRect blueRect = SkIRect::MakeXYWH(4, 4, 8, 8);
+    swapchain->beginFrame(blueRect)->getCanvas()->clear(SK_ColorBLUE);
+    REPORTER_ASSERT(r, swapchain->endFrame(&damage) == 1);
+    REPORTER_ASSERT(r, damage == blueRect);
+    REPORTER_ASSERT(r, pixel_at(swapchain->buffer(1), info, 6, 6) ==
+                       SkPreMultiplyColor(SK_ColorBLUE));
+    REPORTER_ASSERT(r, pixel_at(swapchain->buffer(1), info, 20, 20) ==
+                       SkPreMultiplyColor(SK_ColorRED));
+
+    // Buffer 0 picks up the blue rect from buffer 1 while green is drawn elsewhere.
+    const SkIRect greenRect = SkIRect::MakeXYWH(20, 20, 4, 4);
+    swapchain->beginFrame(greenRect)->getCanvas()->clear(SK_ColorGREEN);
+    REPORTER_ASSERT(r, swapchain->endFrame() == 0);
+    REPORTER_ASSERT(r, swapchain->frontIndex() == 0);
+    REPORTER_ASSERT(r, pixel_at(swapchain->buffer(0), info, 6, 6) ==
+                       SkPreMultiplyColor(SK_ColorBLUE));
+    REPORTER_ASSERT(r, pixel_at(swapchain->buffer(0), info, 21, 21) ==
+                       SkPreMultiplyColor(SK_ColorGREEN));
+    REPORTER_ASSERT(r, pixel_at(swapchain->buffer(0), info, 28, 2) ==
+                       SkPreMultiplyColor(SK_ColorRED));
+}
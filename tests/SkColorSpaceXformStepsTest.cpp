@@ -5,8 +5,10 @@
  * found in the LICENSE file.
  */
 
+#include "SkArenaAlloc.h"
 #include "SkColorSpacePriv.h"
 #include "SkColorSpaceXformSteps.h"
+#include "SkRasterPipeline.h"
 #include "Test.h"
 
 DEF_TEST(SkColorSpaceXformSteps, r) {
@@ -169,3 +171,52 @@ DEF_TEST(SkColorSpaceXformSteps, r) {
                 (t&16) ? " true" : "false");
     }
 }
+
+// xform_lut should match the precise transform on 8-bit inputs, once clamped to [0,1] for
+// the normalized destinations that use it.
+DEF_TEST(SkColorSpaceXformSteps_LUT, r) {
+    skcms_TransferFunction rec2020 = {2.22222f, 0.909672f, 0.0903276f, 0.222222f, 0.0812429f,0,0};
+    auto adobe  = SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2, SkNamedGamut::kAdobeRGB),
+         bt2020 = SkColorSpace::MakeRGB(rec2020, SkNamedGamut::kRec2020),
+         srgb   = SkColorSpace::MakeSRGB();
+
+    uint32_t src[256];
+    for (int i = 0; i < 256; i++) {
+        src[i] = 0xff000000 | ((i * 7 & 0xff) << 16) | ((255 - i) << 8) | i;
+    }
+
+    struct { sk_sp<SkColorSpace> src, dst; } tests[] = {
+        { adobe, srgb }, { bt2020, srgb }, { srgb, bt2020 }, { adobe, bt2020 },
+    };
+    for (const auto& test : tests) {
+        SkColorSpaceXformSteps steps(test.src.get(), kOpaque_SkAlphaType,
+                                     test.dst.get(), kOpaque_SkAlphaType);
+
+        float results[256 * 4];
+        SkSTArenaAlloc<256> alloc;
+        SkRasterPipeline p(&alloc);
+        SkRasterPipeline_MemoryCtx srcCtx = { src, 0 },
+                                   dstCtx = { results, 0 };
+        p.append(SkRasterPipeline::load_8888, &srcCtx);
+        steps.apply(&p, kRGBA_8888_SkColorType, &alloc);
+        p.append(SkRasterPipeline::clamp_0);
+        p.append(SkRasterPipeline::clamp_1);
+        p.append(SkRasterPipeline::store_f32, &dstCtx);
+        p.run(0,0, 256,1);
+
+        for (int i = 0; i < 256; i++) {
+            float rgba[4] = {
+                ((src[i] >>  0) & 0xff) * (1/255.0f),
+                ((src[i] >>  8) & 0xff) * (1/255.0f),
+                ((src[i] >> 16) & 0xff) * (1/255.0f),
+                1,
+            };
+            steps.apply(rgba);
+            for (int c = 0; c < 4; c++) {
+                float want = SkTPin(rgba[c], 0.0f, 1.0f),
+                      got  = results[4*i + c];
+                REPORTER_ASSERT(r, fabsf(want - got) < 0.001f, "%d: %g vs. %g", i, want, got);
+            }
+        }
+    }
+}
@@ -7,6 +7,7 @@
 
 #include "SkLiteDL.h"
 #include "SkLiteRecorder.h"
+#include "SkNoDrawCanvas.h"
 #include "SkRSXform.h"
 #include "Test.h"
 
@@ -63,3 +64,36 @@ DEF_TEST(SkLiteRecorder_RecordsFlush, r) {
     canvas.flush();
     REPORTER_ASSERT(r, !dl.empty());
 }
+
+DEF_TEST(SkLiteDL_CullsOutsideClip, r) {
+    SkLiteDL dl;
+    SkLiteRecorder rec;
+    rec.reset(&dl, {0,0,100,100});
+
+    rec.drawRect(SkRect{0,0,10,10}, SkPaint{});
+    rec.save();
+        rec.translate(60,0);
+        rec.drawRect(SkRect{0,0,10,10}, SkPaint{});
+    rec.restore();
+    rec.drawRect(SkRect{0,20,10,30}, SkPaint{});
+    rec.drawPaint(SkPaint{});
+
+    struct CountingCanvas : public SkNoDrawCanvas {
+        CountingCanvas() : SkNoDrawCanvas(100, 100) {}
+        void onDrawRect(const SkRect&, const SkPaint&) override { fRects++; }
+        void onDrawPaint(const SkPaint&) override { fPaints++; }
+        int fRects = 0, fPaints = 0;
+    };
+
+    CountingCanvas clipped;
+    clipped.clipRect(SkRect{0,0,50,50});
+    dl.draw(&clipped);
+    REPORTER_ASSERT(r, 2 == clipped.fRects);
+    REPORTER_ASSERT(r, 1 == clipped.fPaints);
+    REPORTER_ASSERT(r, 1 == clipped.getSaveCount());
+
+    CountingCanvas unclipped;
+    dl.draw(&unclipped);
+    REPORTER_ASSERT(r, 3 == unclipped.fRects);
+    REPORTER_ASSERT(r, 1 == unclipped.fPaints);
+}
@@ -5,6 +5,10 @@
  * found in the LICENSE file.
  */
 
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkColorPriv.h"
+#include "SkColorSpace.h"
 #include "SkHalf.h"
 #include "SkRasterPipeline.h"
 #include "SkTo.h"
@@ -202,3 +206,299 @@ DEF_TEST(SkRasterPipeline_lowp_clamp01, r) {
     p.append(SkRasterPipeline::store_8888, &ptr);
     p.run(0,0,1,1);
 }
+
+DEF_TEST(SkRasterPipeline_lowp_color_matrix, r) {
+    // The stages SkColorMatrixFilter appends, which can all run in lowp.
+    // This matrix swaps r and b, halves g, and adds 0.25 to a.
+    const float m[20] = {
+        0,0,1,0,
+        0,0.5f,0,0,
+        1,0,0,0,
+        0,0,0,1,
+        0,0,0,0.25f,
+    };
+
+    uint32_t rgba[64];
+    for (int i = 0; i < 64; i++) {
+        uint32_t a = 4*i+3;
+        rgba[i] = (a/3) << 0
+                | (a/2) << 8
+                | (a/1) << 16
+                | (a  ) << 24;
+    }
+
+    SkRasterPipeline_MemoryCtx ptr = { rgba, 0 };
+
+    SkRasterPipeline_<256> p;
+    p.append(SkRasterPipeline::load_8888, &ptr);
+    p.append(SkRasterPipeline::unpremul);
+    p.append(SkRasterPipeline::matrix_4x5, m);
+    p.append(SkRasterPipeline::clamp_0);
+    p.append(SkRasterPipeline::clamp_1);
+    p.append(SkRasterPipeline::premul);
+    p.append(SkRasterPipeline::store_8888, &ptr);
+    p.run(0,0,64,1);
+
+    for (int i = 0; i < 64; i++) {
+        float a  = (4*i+3) / 255.0f,
+              ur = (float)((4*i+3)/3) / (4*i+3),
+              ug = (float)((4*i+3)/2) / (4*i+3),
+              ub = 1.0f;
+        float A = SkTMin(a + 0.25f, 1.0f),
+              want[] = { ub*A, 0.5f*ug*A, ur*A, A };
+        for (int c = 0; c < 4; c++) {
+            float got = ((rgba[i] >> (8*c)) & 0xff) / 255.0f;
+            // Allow for the rounding of each 8-bit step in lowp.
+            if (SkTAbs(got - want[c]) > 2/255.0f) {
+                ERRORF(r, "pixel %d channel %d: got %g, want %g\n", i, c, got, want[c]);
+            }
+        }
+    }
+}
+
+DEF_TEST(SkRasterPipeline_fusion, r) {
+    // compile() fuses some common stage sequences; make sure they draw what run() does.
+    uint32_t src[19], dst[19], unfused[19], fused[19];
+    uint8_t cov[19];
+    for (int i = 0; i < 19; i++) {
+        uint8_t a = (uint8_t)(i * 13);
+        src[i] = (uint32_t)(a/2) << 16 | (uint32_t)(a/3) << 8 | (a/4) | (uint32_t)a << 24;
+        dst[i] = 0xff00ff00 + (uint32_t)(i * 9);
+        cov[i] = (uint8_t)(255 - i * 11);
+    }
+
+    for (bool mask : {false, true}) {
+        memcpy(unfused, dst, sizeof(dst));
+        memcpy(fused,   dst, sizeof(dst));
+
+        SkRasterPipeline_MemoryCtx src_ctx     = { src,     0 },
+                                   cov_ctx     = { cov,     0 },
+                                   unfused_ctx = { unfused, 0 },
+                                   fused_ctx   = { fused,   0 };
+
+        auto build = [&](SkRasterPipeline* p, SkRasterPipeline_MemoryCtx* dst_ctx) {
+            p->append(SkRasterPipeline::load_8888, &src_ctx);
+            if (mask) {
+                p->append(SkRasterPipeline::scale_u8, &cov_ctx);
+            }
+            p->append(SkRasterPipeline::load_8888_dst, dst_ctx);
+            p->append(SkRasterPipeline::srcover);
+            p->append(SkRasterPipeline::store_8888, dst_ctx);
+        };
+
+        SkSTArenaAlloc<1024> alloc;
+        SkRasterPipeline p(&alloc),
+                         q(&alloc);
+        build(&p, &unfused_ctx);
+        build(&q, &fused_ctx);
+        p.run(0,0,19,1);
+        q.compile()(0,0,19,1);
+
+        for (int i = 0; i < 19; i++) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                int want = (unfused[i] >> shift) & 0xff,
+                    got  = (  fused[i] >> shift) & 0xff;
+                REPORTER_ASSERT(r, SkTAbs(want - got) <= 1);
+            }
+        }
+    }
+}
+
+DEF_TEST(SkRasterPipeline_bilerp_tiled_8888, r) {
+    // bilerp_tiled_8888 should sample what the general bilinear_* and tiling stages do.
+    uint32_t img[16];
+    for (int i = 0; i < 16; i++) {
+        img[i] = 0xff000000 | ((i * 0x3f2d1b) & 0x00ffffff);
+    }
+    SkRasterPipeline_GatherCtx gather = { img, 4, 4, 4 };
+    SkRasterPipeline_TileCtx   limit  = { 4, 0.25f };
+
+    // Map 24 device pixels across about three tiles, starting left of and above the image.
+    const float matrix[] = { 0.55f, 0, 0, 1.1f, -3.3f, -2.1f };
+
+    const SkRasterPipeline_TiledGatherCtx::TileMode modes[] = {
+        SkRasterPipeline_TiledGatherCtx::kClamp,
+        SkRasterPipeline_TiledGatherCtx::kRepeat,
+        SkRasterPipeline_TiledGatherCtx::kMirror,
+    };
+    auto append_tile = [&](SkRasterPipeline* p, SkRasterPipeline_TiledGatherCtx::TileMode mode,
+                           SkRasterPipeline::StockStage repeat,
+                           SkRasterPipeline::StockStage mirror) {
+        switch (mode) {
+            case SkRasterPipeline_TiledGatherCtx::kClamp:                             break;
+            case SkRasterPipeline_TiledGatherCtx::kRepeat: p->append(repeat, &limit); break;
+            case SkRasterPipeline_TiledGatherCtx::kMirror: p->append(mirror, &limit); break;
+        }
+    };
+
+    for (auto modeX : modes)
+    for (auto modeY : modes) {
+        uint32_t want[24*8], got[24*8];
+        SkRasterPipeline_MemoryCtx want_ctx = { want, 24 },
+                                   got_ctx  = { got,  24 };
+        SkRasterPipeline_TiledGatherCtx bilerp = { gather, limit, limit, modeX, modeY };
+        SkRasterPipeline_SamplerCtx sampler;
+
+        SkSTArenaAlloc<1024> alloc;
+        SkRasterPipeline p(&alloc),
+                         q(&alloc);
+
+        p.append(SkRasterPipeline::seed_shader);
+        p.append(SkRasterPipeline::matrix_2x3, matrix);
+        p.append(SkRasterPipeline::save_xy, &sampler);
+        auto sample = [&](SkRasterPipeline::StockStage setup_x,
+                          SkRasterPipeline::StockStage setup_y) {
+            p.append(setup_x, &sampler);
+            p.append(setup_y, &sampler);
+            append_tile(&p, modeX, SkRasterPipeline::repeat_x, SkRasterPipeline::mirror_x);
+            append_tile(&p, modeY, SkRasterPipeline::repeat_y, SkRasterPipeline::mirror_y);
+            p.append(SkRasterPipeline::gather_8888, &gather);
+            p.append(SkRasterPipeline::accumulate, &sampler);
+        };
+        sample(SkRasterPipeline::bilinear_nx, SkRasterPipeline::bilinear_ny);
+        sample(SkRasterPipeline::bilinear_px, SkRasterPipeline::bilinear_ny);
+        sample(SkRasterPipeline::bilinear_nx, SkRasterPipeline::bilinear_py);
+        sample(SkRasterPipeline::bilinear_px, SkRasterPipeline::bilinear_py);
+        p.append(SkRasterPipeline::move_dst_src);
+        p.append(SkRasterPipeline::store_8888, &want_ctx);
+
+        q.append(SkRasterPipeline::seed_shader);
+        q.append(SkRasterPipeline::matrix_2x3, matrix);
+        q.append(SkRasterPipeline::bilerp_tiled_8888, &bilerp);
+        q.append(SkRasterPipeline::store_8888, &got_ctx);
+
+        p.run(0,0,24,8);
+        q.run(0,0,24,8);
+
+        for (int i = 0; i < 24*8; i++) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                int w = (want[i] >> shift) & 0xff,
+                    g = ( got[i] >> shift) & 0xff;
+                REPORTER_ASSERT(r, SkTAbs(w - g) <= 1);
+            }
+        }
+    }
+}
+
+DEF_TEST(SkRasterPipeline_bicubic_fused, r) {
+    // bicubic_8888 and bicubic_f16 should sample what the general bicubic_* and tiling stages do.
+    uint32_t img8888[16];
+    uint64_t imgF16[16];
+    for (int i = 0; i < 16; i++) {
+        img8888[i] = 0xff000000 | ((i * 0x3f2d1b) & 0x00ffffff);
+        uint64_t c = img8888[i];
+        imgF16[i] = (uint64_t)SkFloatToHalf(((c >>  0) & 0xff) / 255.0f) <<  0
+                  | (uint64_t)SkFloatToHalf(((c >>  8) & 0xff) / 255.0f) << 16
+                  | (uint64_t)SkFloatToHalf(((c >> 16) & 0xff) / 255.0f) << 32
+                  | (uint64_t)SkFloatToHalf(((c >> 24) & 0xff) / 255.0f) << 48;
+    }
+    SkRasterPipeline_TileCtx limit = { 4, 0.25f };
+
+    // Map 24 device pixels across about three tiles, starting left of and above the image.
+    const float matrix[] = { 0.55f, 0, 0, 1.1f, -3.3f, -2.1f };
+
+    const SkRasterPipeline_TiledGatherCtx::TileMode modes[] = {
+        SkRasterPipeline_TiledGatherCtx::kClamp,
+        SkRasterPipeline_TiledGatherCtx::kRepeat,
+        SkRasterPipeline_TiledGatherCtx::kMirror,
+    };
+    auto append_tile = [&](SkRasterPipeline* p, SkRasterPipeline_TiledGatherCtx::TileMode mode,
+                           SkRasterPipeline::StockStage repeat,
+                           SkRasterPipeline::StockStage mirror) {
+        switch (mode) {
+            case SkRasterPipeline_TiledGatherCtx::kClamp:                             break;
+            case SkRasterPipeline_TiledGatherCtx::kRepeat: p->append(repeat, &limit); break;
+            case SkRasterPipeline_TiledGatherCtx::kMirror: p->append(mirror, &limit); break;
+        }
+    };
+
+    for (bool f16 : {false, true})
+    for (auto modeX : modes)
+    for (auto modeY : modes) {
+        float want[24*8*4], got[24*8*4];
+        SkRasterPipeline_MemoryCtx want_ctx = { want, 24 },
+                                   got_ctx  = { got,  24 };
+        SkRasterPipeline_GatherCtx gather = { f16 ? (const void*)imgF16 : (const void*)img8888,
+                                              4, 4, 4 };
+        SkRasterPipeline_TiledGatherCtx tiled = { gather, limit, limit, modeX, modeY };
+        SkRasterPipeline_SamplerCtx sampler;
+
+        SkSTArenaAlloc<2048> alloc;
+        SkRasterPipeline p(&alloc),
+                         q(&alloc);
+
+        p.append(SkRasterPipeline::seed_shader);
+        p.append(SkRasterPipeline::matrix_2x3, matrix);
+        p.append(SkRasterPipeline::save_xy, &sampler);
+        const SkRasterPipeline::StockStage xs[] = {
+            SkRasterPipeline::bicubic_n3x, SkRasterPipeline::bicubic_n1x,
+            SkRasterPipeline::bicubic_p1x, SkRasterPipeline::bicubic_p3x,
+        }, ys[] = {
+            SkRasterPipeline::bicubic_n3y, SkRasterPipeline::bicubic_n1y,
+            SkRasterPipeline::bicubic_p1y, SkRasterPipeline::bicubic_p3y,
+        };
+        for (auto y : ys)
+        for (auto x : xs) {
+            p.append(x, &sampler);
+            p.append(y, &sampler);
+            append_tile(&p, modeX, SkRasterPipeline::repeat_x, SkRasterPipeline::mirror_x);
+            append_tile(&p, modeY, SkRasterPipeline::repeat_y, SkRasterPipeline::mirror_y);
+            p.append(f16 ? SkRasterPipeline::gather_f16 : SkRasterPipeline::gather_8888, &gather);
+            p.append(SkRasterPipeline::accumulate, &sampler);
+        }
+        p.append(SkRasterPipeline::move_dst_src);
+        p.append(SkRasterPipeline::store_f32, &want_ctx);
+
+        q.append(SkRasterPipeline::seed_shader);
+        q.append(SkRasterPipeline::matrix_2x3, matrix);
+        q.append(f16 ? SkRasterPipeline::bicubic_f16 : SkRasterPipeline::bicubic_8888, &tiled);
+        q.append(SkRasterPipeline::store_f32, &got_ctx);
+
+        p.run(0,0,24,8);
+        q.run(0,0,24,8);
+
+        for (int i = 0; i < 24*8*4; i++) {
+            REPORTER_ASSERT(r, SkTAbs(want[i] - got[i]) < 1e-5f);
+        }
+    }
+}
+
+DEF_TEST(SkRasterPipeline_blitRect_contiguous_rows, r) {
+    // The raster pipeline blitter runs rects whose rows are contiguous in memory as one long row.
+    // Make sure that draws the same as row by row, which it does when the rows are padded.
+    const int W = 37, H = 11;
+    auto info = SkImageInfo::Make(W,H, kRGBA_8888_SkColorType, kPremul_SkAlphaType,
+                                  SkColorSpace::MakeSRGB());
+
+    SkBitmap src;
+    src.allocPixels(info);
+    for (int y = 0; y < H; y++)
+    for (int x = 0; x < W; x++) {
+        *src.getAddr32(x,y) = SkPackARGB32(0xff, 7*x, 11*y, 13*(x+y));
+    }
+
+    auto draw = [&](size_t rowBytes, SkBitmap* dst) {
+        dst->allocPixels(info, rowBytes);
+        dst->eraseColor(0xff204080);
+        SkCanvas canvas(*dst);
+
+        SkPaint paint;
+        paint.setColor(0x80ff8040);               // A translucent rect can't memset.
+        canvas.drawRect(SkRect::MakeWH(W,H/2), paint);
+
+        paint.setColor(0x80ffffff);               // A translucent sprite.
+        canvas.drawBitmap(src, 0,H/2, &paint);
+    };
+
+    SkBitmap tight, padded;
+    draw(info.minRowBytes(),     &tight);
+    draw(info.minRowBytes() + 8, &padded);
+
+    for (int y = 0; y < H; y++)
+    for (int x = 0; x < W; x++) {
+        if (*tight.getAddr32(x,y) != *padded.getAddr32(x,y)) {
+            ERRORF(r, "(%d,%d): got %08x, want %08x\n",
+                   x,y, *tight.getAddr32(x,y), *padded.getAddr32(x,y));
+        }
+    }
+}
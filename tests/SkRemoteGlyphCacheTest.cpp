@@ -395,6 +395,61 @@ DEF_TEST(SkRemoteGlyphCache_PurgesServerEntries, reporter) {
     discardableManager->unlockAndDeleteAll();
 }
 
+DEF_TEST(SkRemoteGlyphCache_CacheMissHints, reporter) {
+    sk_sp<DiscardableManager> discardableManager = sk_make_sp<DiscardableManager>();
+    SkStrikeServer server(discardableManager.get());
+    SkStrikeClient client(discardableManager, false);
+
+    // Server sends the first half of the glyphs.
+    auto serverTf = SkTypeface::MakeFromName("monospace", SkFontStyle());
+    auto serverTfData = server.serializeTypeface(serverTf.get());
+    int glyphCount = 10;
+    auto serverBlob = buildTextBlob(serverTf, glyphCount / 2);
+
+    const SkSurfaceProps props(SkSurfaceProps::kLegacyFontHost_InitType);
+    SkTextBlobCacheDiffCanvas cache_diff_canvas(10, 10, SkMatrix::I(), props, &server);
+    SkPaint paint;
+    cache_diff_canvas.drawTextBlob(serverBlob.get(), 0, 0, paint);
+
+    std::vector<uint8_t> serverStrikeData;
+    server.writeStrikeData(&serverStrikeData);
+
+    // Client draws all of them, and misses the second half.
+    REPORTER_ASSERT(reporter,
+                    client.readStrikeData(serverStrikeData.data(), serverStrikeData.size()));
+    auto clientTf = client.deserializeTypeface(serverTfData->data(), serverTfData->size());
+    auto clientBlob = buildTextBlob(clientTf, glyphCount);
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(10, 10);
+    SkCanvas(bitmap, props).drawTextBlob(clientBlob.get(), 0, 0, paint);
+    int metricsMisses = discardableManager->cacheMissCount(SkStrikeClient::kGlyphMetrics);
+    REPORTER_ASSERT(reporter, metricsMisses > 0);
+
+    std::vector<uint8_t> hints;
+    client.writeCacheMissHints(&hints);
+    REPORTER_ASSERT(reporter, !hints.empty());
+    REPORTER_ASSERT(reporter, server.readCacheMissHints(hints.data(), hints.size()));
+
+    // Using the strike again sends the glyphs the client missed.
+    cache_diff_canvas.drawTextBlob(serverBlob.get(), 0, 0, paint);
+    serverStrikeData.clear();
+    server.writeStrikeData(&serverStrikeData);
+    REPORTER_ASSERT(reporter,
+                    client.readStrikeData(serverStrikeData.data(), serverStrikeData.size()));
+
+    // Once the client deletes the strike, the hints tell the server to forget it too.
+    REPORTER_ASSERT(reporter, server.remoteGlyphStateMapSizeForTesting() == 1u);
+    discardableManager->unlockAndDeleteAll();
+    SkGraphics::PurgeFontCache();
+    hints.clear();
+    client.writeCacheMissHints(&hints);
+    REPORTER_ASSERT(reporter, server.readCacheMissHints(hints.data(), hints.size()));
+    REPORTER_ASSERT(reporter, server.remoteGlyphStateMapSizeForTesting() == 0u);
+
+    // Must unlock everything on termination, otherwise valgrind complains about memory leaks.
+    discardableManager->unlockAndDeleteAll();
+}
+
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkRemoteGlyphCache_DrawTextAsPath, reporter, ctxInfo) {
     sk_sp<DiscardableManager> discardableManager = sk_make_sp<DiscardableManager>();
     SkStrikeServer server(discardableManager.get());
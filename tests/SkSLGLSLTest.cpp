@@ -1665,6 +1665,59 @@ DEF_TEST(SkSLDeadLoopVar, r) {
          );
 }
 
+DEF_TEST(SkSLCopyPropagation, r) {
+    test(r,
+         "uniform half4 color;"
+         "half4 scale(half4 c, half s) {"
+         "    half k = s;"
+         "    return c * k;"
+         "}"
+         "void main() {"
+         "    half4 c = color;"
+         "    half a = c.a;"
+         "    sk_FragColor = scale(c, a);"
+         "}",
+         *SkSL::ShaderCapsFactory::Default(),
+         "#version 400\n"
+         "out vec4 sk_FragColor;\n"
+         "uniform vec4 color;\n"
+         "vec4 scale(vec4 c, float s) {\n"
+         "    return c * s;\n"
+         "}\n"
+         "void main() {\n"
+         "    sk_FragColor = scale(color, color.w);\n"
+         "}\n");
+    // Copies of locals, and of parameters the function writes to, are left alone.
+    test(r,
+         "uniform half4 color;"
+         "half4 scale(half4 c, half s) {"
+         "    half k = s;"
+         "    s = 2;"
+         "    return c * k * s;"
+         "}"
+         "void main() {"
+         "    half4 c = color * 0.5;"
+         "    half4 d = c;"
+         "    c = half4(1);"
+         "    sk_FragColor = scale(d, c.a);"
+         "}",
+         *SkSL::ShaderCapsFactory::Default(),
+         "#version 400\n"
+         "out vec4 sk_FragColor;\n"
+         "uniform vec4 color;\n"
+         "vec4 scale(vec4 c, float s) {\n"
+         "    float k = s;\n"
+         "    s = 2.0;\n"
+         "    return (c * k) * s;\n"
+         "}\n"
+         "void main() {\n"
+         "    vec4 c = color * 0.5;\n"
+         "    vec4 d = c;\n"
+         "    c = vec4(1.0);\n"
+         "    sk_FragColor = scale(d, vec4(1.0).w);\n"
+         "}\n");
+}
+
 DEF_TEST(SkSLGeometryShaders, r) {
     test(r,
          "layout(points) in;"
@@ -1996,8 +2049,7 @@ DEF_TEST(SkSLIncompleteShortIntPrecision, r) {
          "in highp vec2 texcoord;\n"
          "in mediump ivec2 offset;\n"
          "void main() {\n"
-         "    mediump int scalar = offset.y;\n"
-         "    sk_FragColor = texture(tex, texcoord + vec2(offset * scalar));\n"
+         "    sk_FragColor = texture(tex, texcoord + vec2(offset * offset.y));\n"
          "}\n",
          SkSL::Program::kFragment_Kind);
     test(r,
@@ -2016,8 +2068,7 @@ DEF_TEST(SkSLIncompleteShortIntPrecision, r) {
          "in highp vec2 texcoord;\n"
          "in highp ivec2 offset;\n"
          "void main() {\n"
-         "    highp int scalar = offset.y;\n"
-         "    sk_FragColor = texture(tex, texcoord + vec2(offset * scalar));\n"
+         "    sk_FragColor = texture(tex, texcoord + vec2(offset * offset.y));\n"
          "}\n",
          SkSL::Program::kFragment_Kind);
 }
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkRasterPipeline.h"
+#include "SkSLCompiler.h"
+#include "SkSLInterpreter.h"
+
+#include "Test.h"
+
+// Runs the stages appended by src over pixels whose red values sweep from 0 to 1, and compares
+// each pixel against expected(). 21 pixels is at least one full batch, plus a partial one.
+static void test(skiatest::Reporter* r, const char* src, void (*expected)(float rgb[3])) {
+    SkSL::Compiler compiler;
+    SkSL::Program::Settings settings;
+    std::unique_ptr<SkSL::Program> program = compiler.convertProgram(
+                                                                 SkSL::Program::kPipelineStage_Kind,
+                                                                 SkSL::String(src), settings);
+    REPORTER_ASSERT(r, program);
+    if (!program) {
+        printf("%s", compiler.errorText().c_str());
+        return;
+    }
+
+    static constexpr int kCount = 21;
+    float pixels[4 * kCount];
+    for (int i = 0; i < kCount; ++i) {
+        pixels[4 * i + 0] = i / (kCount - 1.0f);
+        pixels[4 * i + 1] = 0.5f;
+        pixels[4 * i + 2] = 0.25f;
+        pixels[4 * i + 3] = 0.75f;
+    }
+    SkRasterPipeline_MemoryCtx ctx = { pixels, 0 };
+
+    SkRasterPipeline_<256> p;
+    std::vector<SkSL::Interpreter::Value> stack;
+    SkSL::Interpreter interpreter(std::move(program), &p, &stack);
+    p.append(SkRasterPipeline::load_f32, &ctx);
+    interpreter.run();
+    p.append(SkRasterPipeline::store_f32, &ctx);
+    p.run(0,0,kCount,1);
+
+    for (int i = 0; i < kCount; ++i) {
+        float want[3] = { i / (kCount - 1.0f), 0.5f, 0.25f };
+        expected(want);
+        const float* got = pixels + 4 * i;
+        if (got[0] != want[0] || got[1] != want[1] || got[2] != want[2] || got[3] != 0.75f) {
+            ERRORF(r, "pixel %d: expected (%g, %g, %g, 0.75), got (%g, %g, %g, %g)", i,
+                   want[0], want[1], want[2], got[0], got[1], got[2], got[3]);
+        }
+    }
+}
+
+DEF_TEST(SkSLInterpreterArithmetic, r) {
+    test(r,
+         "void shade(inout float r, inout float g, inout float b) {"
+         "    float t = r * 2 - g;"
+         "    g += t / 4;"
+         "    b = -t * b;"
+         "}"
+         "void appendStages(SkRasterPipeline p) { append(p, shade); }",
+         [](float c[3]) {
+             float t = c[0] * 2 - c[1];
+             c[1] += t / 4;
+             c[2] = -t * c[2];
+         });
+}
+
+DEF_TEST(SkSLInterpreterIf, r) {
+    test(r,
+         "void shade(inout float r, inout float g, inout float b) {"
+         "    if (r > 0.5) {"
+         "        g = 1;"
+         "    } else {"
+         "        g = 0;"
+         "        b = r > 0.25 && r < 0.4 ? 1 : r;"
+         "    }"
+         "}"
+         "void appendStages(SkRasterPipeline p) { append(p, shade); }",
+         [](float c[3]) {
+             if (c[0] > 0.5f) {
+                 c[1] = 1;
+             } else {
+                 c[1] = 0;
+                 c[2] = c[0] > 0.25f && c[0] < 0.4f ? 1 : c[0];
+             }
+         });
+}
+
+DEF_TEST(SkSLInterpreterLoops, r) {
+    // Each lane leaves the loops after a different number of iterations.
+    test(r,
+         "void shade(inout float r, inout float g, inout float b) {"
+         "    float n = 0;"
+         "    for (float i = 0; i < 10; i++) {"
+         "        if (i >= r * 8) {"
+         "            break;"
+         "        }"
+         "        if (i == 2) {"
+         "            continue;"
+         "        }"
+         "        n += 1;"
+         "    }"
+         "    g = n;"
+         "    float m = r;"
+         "    while (m < 1) {"
+         "        m += 0.3;"
+         "        if (m > 0.9) {"
+         "            return;"
+         "        }"
+         "        b += 1;"
+         "    }"
+         "}"
+         "void appendStages(SkRasterPipeline p) { append(p, shade); }",
+         [](float c[3]) {
+             float n = 0;
+             for (float i = 0; i < 10; i++) {
+                 if (i >= c[0] * 8) {
+                     break;
+                 }
+                 if (i == 2) {
+                     continue;
+                 }
+                 n += 1;
+             }
+             c[1] = n;
+             float m = c[0];
+             while (m < 1) {
+                 m += 0.3f;
+                 if (m > 0.9f) {
+                     return;
+                 }
+                 c[2] += 1;
+             }
+         });
+}
+
+DEF_TEST(SkSLInterpreterArrays, r) {
+    test(r,
+         "void shade(inout float r, inout float g, inout float b) {"
+         "    float a[4];"
+         "    float w = 0;"
+         "    for (int i = 0; i < 4; i++) {"
+         "        a[i] = r + g * w;"
+         "        w += 1;"
+         "    }"
+         "    int j = r > 0.5 ? 3 : 1;"
+         "    b = a[j];"
+         "}"
+         "void appendStages(SkRasterPipeline p) { append(p, shade); }",
+         [](float c[3]) {
+             c[2] = c[0] + c[1] * (c[0] > 0.5f ? 3 : 1);
+         });
+}
@@ -118,4 +118,28 @@ DEF_TEST(SkSLJITWhile, r) {
                  "}", 96, 200, 288);
 }
 
+DEF_TEST(SkSLJITModuleCache, r) {
+    SkSL::Compiler compiler;
+    SkSL::JIT jit(&compiler);
+    SkSL::String add("int test(int x, int y) { return x + y; }");
+    SkSL::JIT::Module* module = jit.getModule(SkSL::Program::kPipelineStage_Kind, add);
+    REPORTER_ASSERT(r, module);
+    if (!module) {
+        return;
+    }
+    int (*test)(int, int) = (int(*)(int, int)) module->getSymbol("test");
+    REPORTER_ASSERT(r, test(12, 5) == 17);
+    REPORTER_ASSERT(r, jit.getModule(SkSL::Program::kPipelineStage_Kind, add) == module);
+
+    SkSL::JIT::Module* sub = jit.getModule(SkSL::Program::kPipelineStage_Kind,
+                                           SkSL::String("int test(int x, int y) { return x - y; }"));
+    REPORTER_ASSERT(r, sub && sub != module);
+    if (sub) {
+        test = (int(*)(int, int)) sub->getSymbol("test");
+        REPORTER_ASSERT(r, test(12, 5) == 7);
+    }
+    REPORTER_ASSERT(r, !jit.getModule(SkSL::Program::kPipelineStage_Kind,
+                                      SkSL::String("int test(int x) { return y; }")));
+}
+
 #endif
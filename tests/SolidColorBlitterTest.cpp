@@ -0,0 +1,136 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkArenaAlloc.h"
+#include "SkBitmap.h"
+#include "SkBlitter.h"
+#include "SkCanvas.h"
+#include "SkColorData.h"
+#include "SkMask.h"
+#include "SkMaskFilter.h"
+#include "SkMatrix.h"
+#include "SkPath.h"
+#include "SkRandom.h"
+#include "Test.h"
+
+extern bool gSkForceRasterPipelineBlitter;
+
+// The specialized 565 and A8 solid color blitters should match SkRasterPipelineBlitter to within
+// rounding.  The 565 blitter scales the color by coverage before blending like the other legacy
+// blitters, which can land a couple of steps away from the pipeline's lerp, and its LCD path works
+// with 5-bit green coverage.
+
+static const SkColor kColors[] = {
+    SK_ColorBLACK, SK_ColorWHITE, 0xFF336699, 0x80FF8000, 0x40102030, 0xC0E0C0A0, 0x01FFFFFF,
+};
+
+static void draw(SkCanvas* canvas, SkColor color) {
+    SkPaint paint;
+    paint.setColor(color);
+
+    canvas->drawRect({3, 5, 61, 40}, paint);                    // blitRect()
+
+    paint.setAntiAlias(true);
+    canvas->drawRect({10.3f, 20.7f, 50.2f, 35.6f}, paint);      // blitAntiH(), blitV()
+    canvas->drawCircle(40, 40, 17.5f, paint);
+    canvas->drawLine(2, 60, 61, 7, paint);                      // hairlines
+
+    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 3));
+    canvas->drawRect({15, 45, 55, 58}, paint);                  // blitMask(kA8_Format)
+}
+
+static void draw_lcd(const SkPixmap& dst, SkColor color) {
+    SkRandom rand;
+    uint16_t coverage[32 * 16];
+    for (uint16_t& c : coverage) {
+        c = SkToU16(rand.nextU() & 0xFFFF);
+    }
+    coverage[0] = 0;
+    coverage[1] = 0xFFFF;
+
+    SkMask mask;
+    mask.fImage    = (uint8_t*)coverage;
+    mask.fBounds   = SkIRect::MakeXYWH(7, 9, 32, 16);
+    mask.fRowBytes = 32 * sizeof(uint16_t);
+    mask.fFormat   = SkMask::kLCD16_Format;
+
+    SkPaint paint;
+    paint.setColor(color);
+    SkSTArenaAlloc<2048> alloc;
+    SkBlitter* blitter = SkBlitter::Choose(dst, SkMatrix::I(), paint, &alloc, false);
+    blitter->blitMask(mask, SkIRect::MakeXYWH(8, 9, 29, 16));
+}
+
+// Largest per-channel difference over all pixels, in steps of the device's channels.
+static int max_diff(const SkBitmap& a, const SkBitmap& b) {
+    int diff = 0;
+    for (int y = 0; y < a.height(); y++) {
+        for (int x = 0; x < a.width(); x++) {
+            if (a.colorType() == kAlpha_8_SkColorType) {
+                diff = SkTMax(diff, SkTAbs(*a.getAddr8(x, y) - *b.getAddr8(x, y)));
+            } else {
+                uint16_t pa = *a.getAddr16(x, y),
+                         pb = *b.getAddr16(x, y);
+                diff = SkTMax(diff, SkTAbs((int)SkGetPackedR16(pa) - (int)SkGetPackedR16(pb)));
+                diff = SkTMax(diff, SkTAbs((int)SkGetPackedG16(pa) - (int)SkGetPackedG16(pb)));
+                diff = SkTMax(diff, SkTAbs((int)SkGetPackedB16(pa) - (int)SkGetPackedB16(pb)));
+            }
+        }
+    }
+    return diff;
+}
+
+static void test_color_type(skiatest::Reporter* r, SkColorType ct,
+                            int tolerance, int lcdTolerance) {
+    for (SkColor color : kColors) {
+        for (bool lcd : {false, true}) {
+            SkBitmap bm[2];
+            for (int i = 0; i < 2; i++) {
+                bm[i].allocPixels(SkImageInfo::Make(64, 64, ct, kPremul_SkAlphaType));
+                bm[i].eraseColor(0xFF808080);
+                bm[i].erase(0x20C04010, SkIRect::MakeWH(64, 24));
+
+                gSkForceRasterPipelineBlitter = (i == 1);
+                if (lcd) {
+                    draw_lcd(bm[i].pixmap(), color);
+                } else {
+                    SkCanvas canvas(bm[i]);
+                    draw(&canvas, color);
+                }
+                gSkForceRasterPipelineBlitter = false;
+            }
+
+            int diff = max_diff(bm[0], bm[1]);
+            REPORTER_ASSERT(r, diff <= (lcd ? lcdTolerance : tolerance),
+                            "ct %d, color %08x, lcd %d: diff %d", ct, color, lcd, diff);
+        }
+    }
+}
+
+DEF_TEST(SolidColorBlitter_565, r) {
+    test_color_type(r, kRGB_565_SkColorType, 2, 3);
+}
+
+DEF_TEST(SolidColorBlitter_A8, r) {
+    test_color_type(r, kAlpha_8_SkColorType, 1, 1);
+}
+
+DEF_TEST(SolidColorBlitter_565_opaqueIsExact, r) {
+    SkBitmap bm;
+    bm.allocPixels(SkImageInfo::Make(37, 5, kRGB_565_SkColorType, kOpaque_SkAlphaType));
+    bm.eraseColor(SK_ColorBLACK);
+
+    SkPaint paint;
+    paint.setColor(0xFF336699);
+    SkCanvas(bm).drawRect({1, 1, 36, 4}, paint);
+
+    const uint16_t expected = SkPixel32ToPixel16(SkPreMultiplyColor(0xFF336699));
+    REPORTER_ASSERT(r, *bm.getAddr16( 0, 0) == 0);
+    REPORTER_ASSERT(r, *bm.getAddr16( 1, 1) == expected);
+    REPORTER_ASSERT(r, *bm.getAddr16(35, 3) == expected);
+    REPORTER_ASSERT(r, *bm.getAddr16(36, 3) == 0);
+}
@@ -61,4 +61,42 @@ DEF_TEST(Sort, reporter) {
     }
 }
 
+DEF_TEST(SortCyclicBitonic, reporter) {
+    int sortedArray[100];
+    int bitonicArray[SK_ARRAY_COUNT(sortedArray)];
+    int workingArray[SK_ARRAY_COUNT(sortedArray)];
+    SkRandom rand;
+
+    for (int i = 0; i < 1000; i++) {
+        int count = rand.nextRangeU(1, SK_ARRAY_COUNT(sortedArray));
+        rand_array(rand, sortedArray, count);
+        qsort(sortedArray, count, sizeof(sortedArray[0]), compare_int);
+
+        // Deal the sorted entries out into a rising run and a falling run, then rotate.
+        int rise = 0, fall = count;
+        for (int j = 0; j < count; j++) {
+            if (rand.nextBool()) {
+                bitonicArray[rise++] = sortedArray[j];
+            } else {
+                bitonicArray[--fall] = sortedArray[j];
+            }
+        }
+        int rotate = rand.nextULessThan(count);
+        for (int j = 0; j < count; j++) {
+            workingArray[j] = bitonicArray[(j + rotate) % count];
+        }
+        REPORTER_ASSERT(reporter,
+                        SkTSortCyclicBitonic(workingArray, count, SkTCompareLT<int>()));
+        check_sort(reporter, "CyclicBitonic", workingArray, sortedArray, count);
+
+        // Anything else is either rejected untouched or sorted.
+        rand_array(rand, bitonicArray, count);
+        memcpy(workingArray, bitonicArray, count * sizeof(int));
+        if (SkTSortCyclicBitonic(workingArray, count, SkTCompareLT<int>())) {
+            qsort(bitonicArray, count, sizeof(bitonicArray[0]), compare_int);
+        }
+        check_sort(reporter, "CyclicBitonic", workingArray, bitonicArray, count);
+    }
+}
+
 // need tests for SkStrSearch
@@ -8,10 +8,13 @@
 #include "Resources.h"
 #include "SkAutoMalloc.h"
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkFrontBufferedStream.h"
+#include "SkMakeUnique.h"
 #include "SkOSFile.h"
 #include "SkOSPath.h"
 #include "SkRandom.h"
+#include "SkReadAheadStream.h"
 #include "SkStream.h"
 #include "SkStreamPriv.h"
 #include "SkTo.h"
@@ -470,6 +473,44 @@ DEF_TEST(StreamCopy, reporter) {
     stream_copy_test(reporter, src, N, &smartStream);
 }
 
+DEF_TEST(ReadAheadStream, r) {
+    SkRandom random(654321);
+    static const size_t N = 10000;
+    SkAutoTMalloc<uint8_t> src(N);
+    for (size_t j = 0; j < N; ++j) {
+        src[j] = random.nextU() & 0xff;
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(1);
+    // Chunk sizes that do and don't divide N, and reads that straddle chunks.
+    for (size_t chunkSize : { (size_t)1, (size_t)7, (size_t)1000, (size_t)4096, N, 2 * N }) {
+        auto stream = SkReadAheadStream::Make(skstd::make_unique<DumbStream>(src.get(), N),
+                                              executor.get(), chunkSize);
+        REPORTER_ASSERT(r, stream);
+
+        uint8_t peeked;
+        REPORTER_ASSERT(r, stream->peek(&peeked, 1) == 1 && peeked == src[0]);
+
+        SkAutoTMalloc<uint8_t> dst(N);
+        size_t offset = 0, readSize = 1;
+        while (!stream->isAtEnd()) {
+            offset += stream->read(dst.get() + offset, SkTMin(readSize, N - offset));
+            REPORTER_ASSERT(r, stream->getPosition() == offset);
+            readSize = readSize * 3 + 1;
+        }
+        REPORTER_ASSERT(r, offset == N);
+        REPORTER_ASSERT(r, !memcmp(dst.get(), src.get(), N));
+        REPORTER_ASSERT(r, 0 == stream->read(dst.get(), 1));
+    }
+
+    // Dropping the stream while a read is still queued must be safe.
+    auto stream = SkReadAheadStream::Make(skstd::make_unique<DumbStream>(src.get(), N),
+                                          executor.get(), 16);
+    stream.reset();
+
+    REPORTER_ASSERT(r, !SkReadAheadStream::Make(nullptr, executor.get()));
+}
+
 DEF_TEST(StreamEmptyStreamMemoryBase, r) {
     SkDynamicMemoryWStream tmp;
     std::unique_ptr<SkStreamAsset> asset(tmp.detachAsStream());
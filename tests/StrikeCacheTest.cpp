@@ -0,0 +1,78 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkFont.h"
+#include "SkPaint.h"
+#include "SkScalerContext.h"
+#include "SkStrikeCache.h"
+#include "SkSurfaceProps.h"
+#include "SkTaskGroup.h"
+#include "SkTypeface.h"
+#include "Test.h"
+
+#include <atomic>
+
+DEF_TEST(StrikeCache_Concurrent, reporter) {
+    SkStrikeCache strikeCache;
+    sk_sp<SkTypeface> typeface = SkTypeface::MakeDefault();
+
+    const int kThreads = 32,
+              kSizes   = 24;
+    std::atomic<int> glyphsFound{0};
+
+    // Many threads find or create strikes of the same few sizes, each using its strike
+    // exclusively for a moment before returning it to the cache.
+    SkTaskGroup().batch(kThreads, [&](int i) {
+        for (int j = 0; j < kSizes; j++) {
+            SkFont font(typeface, 8 + (i + j) % kSizes);
+
+            SkAutoDescriptor ad;
+            SkScalerContextEffects effects;
+            auto desc = SkScalerContext::CreateDescriptorAndEffectsUsingPaint(
+                    font, SkPaint(), SkSurfaceProps(SkSurfaceProps::kLegacyFontHost_InitType),
+                    kFakeGammaAndBoostContrast, SkMatrix::I(), &ad, &effects);
+
+            auto strike = strikeCache.findOrCreateStrikeExclusive(*desc, effects, *typeface);
+            REPORTER_ASSERT(reporter, strike->getDescriptor() == *desc);
+            strike->getGlyphIDMetrics(0);
+            glyphsFound++;
+        }
+    });
+    REPORTER_ASSERT(reporter, glyphsFound.load() == kThreads * kSizes);
+
+    // Every strike is back in the cache now, and we only duplicate a strike when two threads
+    // want it at the same time.
+    strikeCache.validate();
+    int count = strikeCache.getCacheCountUsed();
+    REPORTER_ASSERT(reporter, count >= kSizes);
+    REPORTER_ASSERT(reporter, count <= kThreads * kSizes);
+
+    strikeCache.purgeAll();
+    REPORTER_ASSERT(reporter, strikeCache.getCacheCountUsed() == 0);
+    REPORTER_ASSERT(reporter, strikeCache.getTotalMemoryUsed() == 0);
+}
+
+DEF_TEST(StrikeCache_PurgeToCountLimit, reporter) {
+    SkStrikeCache strikeCache;
+    sk_sp<SkTypeface> typeface = SkTypeface::MakeDefault();
+
+    // Strikes of these sizes spread across the cache's shards.
+    for (int size = 4; size < 68; size++) {
+        SkFont font(typeface, size);
+        SkAutoDescriptor ad;
+        SkScalerContextEffects effects;
+        auto desc = SkScalerContext::CreateDescriptorAndEffectsUsingPaint(
+                font, SkPaint(), SkSurfaceProps(SkSurfaceProps::kLegacyFontHost_InitType),
+                kFakeGammaAndBoostContrast, SkMatrix::I(), &ad, &effects);
+        strikeCache.findOrCreateStrikeExclusive(*desc, effects, *typeface);
+    }
+    REPORTER_ASSERT(reporter, strikeCache.getCacheCountUsed() == 64);
+
+    strikeCache.setCacheCountLimit(10);
+    REPORTER_ASSERT(reporter, strikeCache.getCacheCountUsed() <= 10);
+    strikeCache.validate();
+}
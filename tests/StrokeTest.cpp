@@ -9,6 +9,7 @@
 #include "SkPath.h"
 #include "SkRect.h"
 #include "SkStroke.h"
+#include "SkStrokeCache.h"
 #include "SkStrokeRec.h"
 #include "Test.h"
 
@@ -185,3 +186,58 @@ DEF_TEST(Stroke, reporter) {
     test_strokerec_equality(reporter);
     test_big_stroke(reporter);
 }
+
+DEF_TEST(StrokeCache, reporter) {
+    REPORTER_ASSERT(reporter, SkStrokeCache::BucketResScale(1) == 1);
+    REPORTER_ASSERT(reporter, SkStrokeCache::BucketResScale(1.5f) == 2);
+    REPORTER_ASSERT(reporter, SkStrokeCache::BucketResScale(2) == 2);
+    REPORTER_ASSERT(reporter, SkStrokeCache::BucketResScale(0.3f) == 0.5f);
+
+    SkPath path;
+    path.moveTo(0, 0);
+    for (int i = 1; i < 2 * SkStrokeCache::kMinPointCount; ++i) {
+        path.lineTo(10.f * i, i & 1 ? 10 : 0);
+    }
+    SkStrokeRec rec(SkStrokeRec::kHairline_InitStyle);
+    rec.setStrokeStyle(3);
+    rec.setStrokeParams(SkPaint::kRound_Cap, SkPaint::kMiter_Join, 4);
+    rec.setResScale(1.5f);
+    REPORTER_ASSERT(reporter, SkStrokeCache::CanCache(path, rec));
+
+    // The outline matches stroking at the bucket's scale, and is shared by later strokes in the
+    // same bucket.
+    SkPath first, second, expected;
+    REPORTER_ASSERT(reporter, rec.applyToPath(&first, path));
+    rec.setResScale(1.75f);
+    REPORTER_ASSERT(reporter, rec.applyToPath(&second, path));
+    SkStroke stroker;
+    stroker.setWidth(3);
+    stroker.setCap(SkPaint::kRound_Cap);
+    stroker.setJoin(SkPaint::kMiter_Join);
+    stroker.setMiterLimit(4);
+    stroker.setResScale(2);
+    stroker.strokePath(path, &expected);
+    REPORTER_ASSERT(reporter, first == expected);
+    REPORTER_ASSERT(reporter, first.getGenerationID() == second.getGenerationID());
+
+    // Other stroke parameters and changed paths are stroked anew.
+    SkPath other;
+    rec.setStrokeStyle(4);
+    REPORTER_ASSERT(reporter, rec.applyToPath(&other, path));
+    REPORTER_ASSERT(reporter, other.getGenerationID() != first.getGenerationID());
+    rec.setStrokeStyle(3);
+    path.lineTo(0, 100);
+    REPORTER_ASSERT(reporter, rec.applyToPath(&other, path));
+    REPORTER_ASSERT(reporter, other.getGenerationID() != first.getGenerationID());
+    REPORTER_ASSERT(reporter, other.getBounds().height() > first.getBounds().height());
+
+    // Stroking a path into itself caches the outline under the source.
+    path.lineTo(100, 100);
+    SkPath inPlace = path;
+    REPORTER_ASSERT(reporter, rec.applyToPath(&inPlace, inPlace));
+    REPORTER_ASSERT(reporter, rec.applyToPath(&other, path));
+    REPORTER_ASSERT(reporter, inPlace.getGenerationID() == other.getGenerationID());
+
+    path.setIsVolatile(true);
+    REPORTER_ASSERT(reporter, !SkStrokeCache::CanCache(path, rec));
+}
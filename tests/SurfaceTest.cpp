@@ -12,6 +12,7 @@
 #include "GrGpuResourcePriv.h"
 #include "GrRenderTargetContext.h"
 #include "GrResourceProvider.h"
+#include "SkAutoPixmapStorage.h"
 #include "SkCanvas.h"
 #include "SkData.h"
 #include "SkDevice.h"
@@ -976,3 +977,166 @@ DEF_TEST(surface_image_unity, reporter) {
         }
     }
 }
+
+namespace {
+struct AsyncReadResult {
+    bool fCalled = false;
+    SkAutoPixmapStorage fPixels;
+    SkAutoPixmapStorage fPlanes[3];
+};
+}  // namespace
+
+static void async_read_callback(void* context, const void* data, size_t rowBytes) {
+    auto* result = static_cast<AsyncReadResult*>(context);
+    SkASSERT(!result->fCalled);
+    result->fCalled = true;
+    if (data) {
+        SkPixmap pixels(result->fPixels.info(), data, rowBytes);
+        SkAssertResult(pixels.readPixels(result->fPixels));
+    } else {
+        result->fPixels.reset();
+    }
+}
+
+static void async_read_yuv420_callback(void* context, const void* data[3],
+                                       const size_t rowBytes[3]) {
+    auto* result = static_cast<AsyncReadResult*>(context);
+    SkASSERT(!result->fCalled);
+    result->fCalled = true;
+    for (int i = 0; data && i < 3; ++i) {
+        SkPixmap plane(result->fPlanes[i].info(), data[i], rowBytes[i]);
+        SkAssertResult(plane.readPixels(result->fPlanes[i]));
+    }
+    if (!data) {
+        result->fPlanes[0].reset();
+    }
+}
+
+static void wait_for_async_read(GrContext* context, const AsyncReadResult& result) {
+    while (!result.fCalled) {
+        SkASSERT(context);
+        context->checkAsyncWorkCompletion();
+    }
+}
+
+static void test_async_read_pixels(skiatest::Reporter* reporter, SkSurface* surface,
+                                   GrContext* context) {
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeXYWH(1, 2, 5, 3), paint);
+    paint.setColor(0x8000FF00);
+    canvas->drawRect(SkRect::MakeXYWH(4, 1, 4, 6), paint);
+
+    // Read a subset in another color type and alpha type, and compare with a synchronous read. The
+    // GPU may unpremul the synchronous read itself, so allow for rounding.
+    SkImageInfo dstInfo = SkImageInfo::Make(7, 6, kBGRA_8888_SkColorType, kUnpremul_SkAlphaType);
+    SkAutoPixmapStorage expected;
+    expected.alloc(dstInfo);
+    REPORTER_ASSERT(reporter, surface->readPixels(expected, 2, 3));
+
+    AsyncReadResult result;
+    result.fPixels.alloc(dstInfo);
+    surface->asyncReadPixels(dstInfo, 2, 3, async_read_callback, &result);
+    wait_for_async_read(context, result);
+    REPORTER_ASSERT(reporter, result.fPixels.addr());
+    if (result.fPixels.addr()) {
+        for (int y = 0; y < dstInfo.height(); ++y) {
+            const uint8_t* e = static_cast<const uint8_t*>(expected.addr(0, y));
+            const uint8_t* a = static_cast<const uint8_t*>(result.fPixels.addr(0, y));
+            for (size_t i = 0; i < dstInfo.minRowBytes(); ++i) {
+                REPORTER_ASSERT(reporter, SkTAbs(e[i] - a[i]) <= 1);
+            }
+        }
+    }
+
+    // Rects that aren't inside the surface fail, without waiting for the GPU.
+    AsyncReadResult outside;
+    outside.fPixels.alloc(dstInfo);
+    surface->asyncReadPixels(dstInfo, 5, 5, async_read_callback, &outside);
+    REPORTER_ASSERT(reporter, outside.fCalled && !outside.fPixels.addr());
+
+    // An opaque color converts to the same YUV everywhere, and the planes round their size up.
+    canvas->clear(SkColorSetRGB(200, 100, 50));
+    SkIRect srcRect = SkIRect::MakeXYWH(1, 1, 7, 5);
+    AsyncReadResult yuv;
+    yuv.fPlanes[0].alloc(SkImageInfo::MakeA8(7, 5));
+    yuv.fPlanes[1].alloc(SkImageInfo::MakeA8(4, 3));
+    yuv.fPlanes[2].alloc(SkImageInfo::MakeA8(4, 3));
+    surface->asyncReadPixelsYUV420(kJPEG_SkYUVColorSpace, srcRect, async_read_yuv420_callback,
+                                   &yuv);
+    wait_for_async_read(context, yuv);
+    REPORTER_ASSERT(reporter, yuv.fPlanes[0].addr());
+    if (yuv.fPlanes[0].addr()) {
+        // Y = 0.299 * 200 + 0.587 * 100 + 0.114 * 50, and so on.
+        const int expectedYUV[3] = { 124, 86, 182 };
+        for (int i = 0; i < 3; ++i) {
+            const SkAutoPixmapStorage& plane = yuv.fPlanes[i];
+            for (int y = 0; y < plane.height(); ++y) {
+                for (int x = 0; x < plane.width(); ++x) {
+                    int value = *plane.addr8(x, y);
+                    REPORTER_ASSERT(reporter, SkTAbs(value - expectedYUV[i]) <= 1,
+                                    "plane %d (%d, %d): %d", i, x, y, value);
+                }
+            }
+        }
+    }
+}
+
+DEF_TEST(SurfaceAsyncReadPixels, reporter) {
+    sk_sp<SkSurface> surface = create_surface();
+    test_async_read_pixels(reporter, surface.get(), nullptr);
+}
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SurfaceAsyncReadPixels_Gpu, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    sk_sp<SkSurface> surface = create_gpu_surface(context);
+    test_async_read_pixels(reporter, surface.get(), context);
+}
+
+static void test_damage_rect(skiatest::Reporter* reporter, SkSurface* surface) {
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorRED);
+
+    const SkIRect damage = SkIRect::MakeLTRB(2, 3, 6, 8);
+    surface->setDamageRect(damage);
+    canvas->save();
+    canvas->clipRect(SkRect::MakeWH(100, 100), kReplace_SkClipOp);
+    canvas->drawColor(SK_ColorBLUE);
+    canvas->restore();
+
+    SkBitmap bm;
+    bm.allocN32Pixels(surface->width(), surface->height());
+    REPORTER_ASSERT(reporter, surface->readPixels(bm, 0, 0));
+    for (int y = 0; y < bm.height(); ++y) {
+        for (int x = 0; x < bm.width(); ++x) {
+            SkColor expected = damage.contains(x, y) ? SK_ColorBLUE : SK_ColorRED;
+            if (bm.getColor(x, y) != expected) {
+                ERRORF(reporter, "(%d, %d): expected %08x, got %08x", x, y, expected,
+                       bm.getColor(x, y));
+                return;
+            }
+        }
+    }
+
+    // Damage that misses the surface draws nothing, and an empty rect lifts the restriction.
+    surface->setDamageRect(SkIRect::MakeXYWH(20, 20, 5, 5));
+    canvas->drawColor(SK_ColorGREEN);
+    REPORTER_ASSERT(reporter, surface->readPixels(bm, 0, 0));
+    REPORTER_ASSERT(reporter, bm.getColor(0, 0) == SK_ColorRED);
+    surface->setDamageRect(SkIRect::MakeEmpty());
+    canvas->drawColor(SK_ColorGREEN);
+    REPORTER_ASSERT(reporter, surface->readPixels(bm, 0, 0));
+    REPORTER_ASSERT(reporter, bm.getColor(0, 0) == SK_ColorGREEN);
+}
+
+DEF_TEST(SurfaceDamageRect, reporter) {
+    sk_sp<SkSurface> surface = create_surface();
+    test_damage_rect(reporter, surface.get());
+}
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SurfaceDamageRect_Gpu, reporter, ctxInfo) {
+    sk_sp<SkSurface> surface = create_gpu_surface(ctxInfo.grContext());
+    test_damage_rect(reporter, surface.get());
+}
@@ -349,6 +349,38 @@ DEF_TEST(TextBlob_extended, reporter) {
     }
 }
 
+// The builder presizes from the last blob and grows geometrically; neither may leak into the
+// blobs themselves.
+DEF_TEST(TextBlob_builderReuse, reporter) {
+    SkTextBlobBuilder builder;
+    SkFont font;
+    for (int runCount : { 40, 3, 1, 40 }) {
+        for (int i = 0; i < runCount; ++i) {
+            SkFont runFont = font;
+            runFont.setSize(10 + i);   // Distinct fonts keep the runs from merging.
+            const auto& run = builder.allocRunPosH(runFont, i + 1, SkIntToScalar(i));
+            for (int j = 0; j <= i; ++j) {
+                run.glyphs[j] = SkToU16(i + j);
+                run.pos[j] = SkIntToScalar(j);
+            }
+        }
+        sk_sp<SkTextBlob> blob = builder.make();
+        REPORTER_ASSERT(reporter, blob);
+
+        int i = 0;
+        for (SkTextBlobRunIterator it(blob.get()); !it.done(); it.next(), ++i) {
+            REPORTER_ASSERT(reporter, it.glyphCount() == SkToU32(i + 1));
+            REPORTER_ASSERT(reporter, it.offset().y() == SkIntToScalar(i));
+            for (int j = 0; j <= i; ++j) {
+                REPORTER_ASSERT(reporter, it.glyphs()[j] == i + j);
+                REPORTER_ASSERT(reporter, it.pos()[j] == SkIntToScalar(j));
+            }
+        }
+        REPORTER_ASSERT(reporter, i == runCount);
+    }
+    REPORTER_ASSERT(reporter, !builder.make());
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #include "SkCanvas.h"
 #include "SkSurface.h"
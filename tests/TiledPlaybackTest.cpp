@@ -0,0 +1,100 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBlurImageFilter.h"
+#include "SkCanvas.h"
+#include "SkExecutor.h"
+#include "SkGradientShader.h"
+#include "SkPicture.h"
+#include "SkPictureRecorder.h"
+#include "SkRandom.h"
+#include "SkSurface.h"
+#include "SkTiledPlayback.h"
+
+#include "Test.h"
+
+static sk_sp<SkPicture> make_picture(int w, int h) {
+    SkRTreeFactory factory;
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkIntToScalar(w), SkIntToScalar(h), &factory);
+
+    SkPoint pts[] = {{0, 0}, {SkIntToScalar(w), SkIntToScalar(h)}};
+    SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+    SkPaint gradient;
+    gradient.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                    SkShader::kClamp_TileMode));
+    gradient.setDither(true);
+    canvas->drawPaint(gradient);
+
+    SkRandom rand;
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int i = 0; i < 200; i++) {
+        paint.setColor(rand.nextU() | 0xff000000);
+        SkScalar x = rand.nextRangeScalar(0, SkIntToScalar(w)),
+                 y = rand.nextRangeScalar(0, SkIntToScalar(h)),
+                 r = rand.nextRangeScalar(2, 40);
+        if (i & 1) {
+            canvas->drawCircle(x, y, r, paint);
+        } else {
+            canvas->drawRect(SkRect::MakeXYWH(x, y, r, r*0.5f), paint);
+        }
+    }
+
+    // A layer whose filter reads pixels from across tile boundaries.
+    SkPaint layerPaint;
+    layerPaint.setImageFilter(SkBlurImageFilter::Make(5, 5, nullptr));
+    canvas->saveLayer(nullptr, &layerPaint);
+        paint.setColor(SK_ColorGREEN);
+        canvas->drawRect(SkRect::MakeXYWH(w*0.25f, h*0.25f, w*0.5f, h*0.5f), paint);
+    canvas->restore();
+
+    return recorder.finishRecordingAsPicture();
+}
+
+DEF_TEST(TiledPlayback, r) {
+    const int w = 600, h = 400;
+    sk_sp<SkPicture> picture = make_picture(w, h);
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    SkImageInfo info = SkImageInfo::MakeN32Premul(w, h);
+    sk_sp<SkSurface> expected = SkSurface::MakeRaster(info),
+                     actual   = SkSurface::MakeRaster(info);
+
+    for (int translate : {0, 37}) {
+        for (sk_sp<SkSurface> surface : {expected, actual}) {
+            surface->getCanvas()->clear(SK_ColorWHITE);
+            surface->getCanvas()->resetMatrix();
+            surface->getCanvas()->translate(SkIntToScalar(translate), SkIntToScalar(translate));
+        }
+
+        picture->playback(expected->getCanvas());
+        SkTiledPlayback::Draw(picture.get(), actual.get(), executor.get(), 64, 48);
+
+        SkPixmap e, a;
+        REPORTER_ASSERT(r, expected->peekPixels(&e) && actual->peekPixels(&a));
+        for (int y = 0; y < h; y++) {
+            if (0 != memcmp(e.addr32(0, y), a.addr32(0, y), w * sizeof(uint32_t))) {
+                ERRORF(r, "Row %d differs (translate %d).", y, translate);
+                break;
+            }
+        }
+    }
+}
+
+DEF_TEST(TiledPlayback_SnapshotUnchanged, r) {
+    sk_sp<SkPicture> picture = make_picture(300, 300);
+    sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(300, 300);
+    surface->getCanvas()->clear(SK_ColorWHITE);
+    sk_sp<SkImage> before = surface->makeImageSnapshot();
+
+    SkTiledPlayback::Draw(picture.get(), surface.get(), nullptr, 64, 64);
+
+    SkPixmap pm;
+    REPORTER_ASSERT(r, before->peekPixels(&pm));
+    REPORTER_ASSERT(r, *pm.addr32(150, 150) == SK_ColorWHITE);
+}
@@ -176,3 +176,38 @@ DEF_GPUTEST_FOR_GL_RENDERING_CONTEXTS(SkTraceMemoryDump_unownedGLRenderTarget, r
 
     ValidateMemoryDumps(reporter, context, rt->gpuMemorySize(), false /* isOwned */);
 }
+
+DEF_GPUTEST_FOR_GL_RENDERING_CONTEXTS(SkTraceMemoryDump_largestResources, reporter, ctxInfo) {
+    class LargestDump : public TestSkTraceMemoryDump {
+    public:
+        LargestDump() : TestSkTraceMemoryDump(true) {}
+
+        void dumpNumericValue(const char* dumpName, const char* valueName, const char* units,
+                              uint64_t value) override {
+            if (SkString("total_size") == SkString(valueName) &&
+                SkString(dumpName).startsWith("skia/gpu_largest/")) {
+                fSizes.push_back(value);
+            }
+        }
+
+        SkTArray<uint64_t> fSizes;
+    };
+
+    GrContext* context = ctxInfo.grContext();
+    context->freeGpuResources();
+    GrGLGpu* gpu = static_cast<GrGLGpu*>(context->contextPriv().getGpu());
+    sk_sp<GrGLBuffer> small =
+            GrGLBuffer::Make(gpu, 1024, kVertex_GrBufferType, kDynamic_GrAccessPattern);
+    sk_sp<GrGLBuffer> large =
+            GrGLBuffer::Make(gpu, 4096, kVertex_GrBufferType, kDynamic_GrAccessPattern);
+
+    LargestDump dump;
+    context->dumpLargestResources(&dump, 1);
+    REPORTER_ASSERT(reporter, 1 == dump.fSizes.count());
+    REPORTER_ASSERT(reporter, dump.fSizes.count() && 4096 == dump.fSizes[0]);
+
+    LargestDump all;
+    context->dumpLargestResources(&all, 100);
+    REPORTER_ASSERT(reporter, 2 == all.fSizes.count());
+    REPORTER_ASSERT(reporter, all.fSizes.count() == 2 && all.fSizes[0] >= all.fSizes[1]);
+}
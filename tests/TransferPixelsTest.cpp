@@ -11,12 +11,16 @@
 
 #include "GrContextFactory.h"
 #include "GrContextPriv.h"
+#include "GrContextThreadSafeProxyPriv.h"
 #include "GrGpu.h"
 #include "GrResourceProvider.h"
+#include "GrSurfaceContext.h"
 #include "GrSurfaceProxy.h"
 #include "GrTexture.h"
 #include "SkGr.h"
+#include "SkExecutor.h"
 #include "SkSurface.h"
+#include "SkTaskGroup.h"
 #include "Test.h"
 
 using sk_gpu_test::GrContextFactory;
@@ -187,3 +191,64 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(TransferPixelsTest, reporter, ctxInfo) {
     basic_transfer_test(reporter, ctxInfo.grContext(), GrColorType::kBGRA_8888, false);
     basic_transfer_test(reporter, ctxInfo.grContext(), GrColorType::kBGRA_8888, true);
 }
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(StagedUploadTest, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    sk_sp<GrContextThreadSafeProxy> threadSafeProxy = context->threadSafeProxy();
+
+    const int kCount = 4;
+    const int kSize = 24;
+    SkBitmap bitmaps[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        bitmaps[i].allocPixels(SkImageInfo::Make(kSize, kSize, i & 1 ? kRGBA_8888_SkColorType
+                                                                     : kBGRA_8888_SkColorType,
+                                                 kPremul_SkAlphaType));
+        for (int y = 0; y < kSize; ++y) {
+            for (int x = 0; x < kSize; ++x) {
+                *bitmaps[i].getAddr32(x, y) =
+                        SkPackARGB32(0xFF, 40 * i, 10 * x, 10 * y);
+            }
+        }
+    }
+
+    static std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    // Without staged buffers the uploads fall back to CPU memory; with them, they only need the
+    // buffer to texture transfer here.
+    for (bool stageBuffers : {false, true}) {
+        if (stageBuffers &&
+            context->contextPriv().stageUploadBuffers(kCount, kSize * kSize * 4) != kCount) {
+            continue;
+        }
+
+        std::unique_ptr<GrStagedUpload> uploads[kCount];
+        SkTaskGroup(*executor).batch(kCount, [&](int i) {
+            uploads[i] = threadSafeProxy->priv().stageUpload(bitmaps[i].pixmap());
+        });
+
+        for (int i = 0; i < kCount; ++i) {
+            REPORTER_ASSERT(reporter, uploads[i]);
+            if (!uploads[i]) {
+                continue;
+            }
+            REPORTER_ASSERT(reporter, uploads[i]->inTransferBuffer() == stageBuffers);
+            sk_sp<GrTextureProxy> proxy = context->contextPriv().makeTextureFromStagedUpload(
+                    std::move(uploads[i]), SkBudgeted::kYes);
+            REPORTER_ASSERT(reporter, proxy);
+            if (!proxy) {
+                continue;
+            }
+
+            sk_sp<GrSurfaceContext> sContext =
+                    context->contextPriv().makeWrappedSurfaceContext(std::move(proxy));
+            SkBitmap result;
+            result.allocPixels(bitmaps[i].info());
+            if (!sContext || !sContext->readPixels(result.info(), result.getPixels(),
+                                                   result.rowBytes(), 0, 0)) {
+                continue;
+            }
+            REPORTER_ASSERT(reporter, !memcmp(result.getPixels(), bitmaps[i].getPixels(),
+                                              bitmaps[i].computeByteSize()));
+        }
+    }
+}
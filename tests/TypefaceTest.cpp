@@ -297,6 +297,70 @@ DEF_TEST(TypefaceCache, reporter) {
     REPORTER_ASSERT(reporter, t1->unique());
 }
 
+static bool same_typeface_proc(SkTypeface* face, void* ctx) {
+    return face == ctx;
+}
+
+DEF_TEST(TypefaceCache_hashed, reporter) {
+    sk_sp<SkTypeface> t0(SkTestEmptyTypeface::Make());
+    sk_sp<SkTypeface> t1(SkTestEmptyTypeface::Make());
+    sk_sp<SkTypeface> t2(SkTestEmptyTypeface::Make());
+    SkTypefaceCache cache;
+    cache.add(t0.get(), 7);
+    cache.add(t1.get(), 7);
+    cache.add(t2.get());
+    REPORTER_ASSERT(reporter, count(reporter, cache) == 3);
+
+    // Only the typefaces added with a hash are found by it.
+    sk_sp<SkTypeface> found(cache.findByProcAndRef(same_typeface_proc, t0.get(), 7));
+    REPORTER_ASSERT(reporter, found == t0);
+    found.reset(cache.findByProcAndRef(same_typeface_proc, t1.get(), 7));
+    REPORTER_ASSERT(reporter, found == t1);
+    found.reset(cache.findByProcAndRef(same_typeface_proc, t0.get(), 8));
+    REPORTER_ASSERT(reporter, !found);
+    found.reset(cache.findByProcAndRef(same_typeface_proc, t2.get(), 7));
+    REPORTER_ASSERT(reporter, !found);
+    found.reset(cache.findByProcAndRef(same_typeface_proc, t2.get()));
+    REPORTER_ASSERT(reporter, found == t2);
+    found.reset();
+
+    // Purging keeps the hashed lookups of the typefaces that are left working.
+    t0.reset();
+    cache.purgeAll();
+    REPORTER_ASSERT(reporter, count(reporter, cache) == 2);
+    found.reset(cache.findByProcAndRef(same_typeface_proc, t1.get(), 7));
+    REPORTER_ASSERT(reporter, found == t1);
+}
+
+static bool same_id_proc(SkTypeface* face, void* ctx) {
+    return face->uniqueID() == *static_cast<SkFontID*>(ctx);
+}
+
+DEF_TEST(TypefaceCache_purgesLeastRecentlyUsed, reporter) {
+    // Fill the cache with typefaces only it owns, then look up the oldest one, so that when the
+    // cache is full and purges, it survives while the next oldest ones are dropped.
+    SkTypefaceCache cache;
+    SkFontID ids[2];
+    for (int i = 0; i < 1024; ++i) {
+        sk_sp<SkTypeface> face(SkTestEmptyTypeface::Make());
+        cache.add(face.get(), i);
+        if (i < 2) {
+            ids[i] = face->uniqueID();
+        }
+    }
+    sk_sp<SkTypeface> found(cache.findByProcAndRef(same_id_proc, &ids[0], 0));
+    REPORTER_ASSERT(reporter, found);
+    found.reset();
+
+    sk_sp<SkTypeface> face(SkTestEmptyTypeface::Make());
+    cache.add(face.get(), 1024);
+    REPORTER_ASSERT(reporter, count(reporter, cache) == 1024 - 256 + 1);
+    found.reset(cache.findByProcAndRef(same_id_proc, &ids[0], 0));
+    REPORTER_ASSERT(reporter, found);
+    found.reset(cache.findByProcAndRef(same_id_proc, &ids[1], 1));
+    REPORTER_ASSERT(reporter, !found);
+}
+
 static void check_serialize_behaviors(sk_sp<SkTypeface> tf, bool isLocalData,
                                       skiatest::Reporter* reporter) {
     if (!tf) {
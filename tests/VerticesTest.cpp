@@ -6,6 +6,7 @@
  */
 
 #include "SkCanvas.h"
+#include "SkImage.h"
 #include "SkSurface.h"
 #include "SkVertices.h"
 #include "sk_pixel_iter.h"
@@ -147,3 +148,45 @@ DEF_TEST(Vertices_clipping, reporter) {
         }
     }
 }
+
+DEF_TEST(Vertices_textures, reporter) {
+    // Textured vertices share one blitter across their triangles, updating the image shader's
+    // matrix as they go.  A mesh that maps an image 1:1 should draw just like the image.
+    const int W = 16, H = 16;
+    SkBitmap bm;
+    bm.allocN32Pixels(W, H, true);
+    for (int y = 0; y < H; y++)
+    for (int x = 0; x < W; x++) {
+        *bm.getAddr32(x,y) = SkPreMultiplyColor(SkColorSetRGB(16*x, 16*y, 8*(x+y)));
+    }
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(bm);
+
+    // Split the image into a 2x2 grid of quads, each drawn as two triangles.
+    SkPoint pts[24];
+    int n = 0;
+    for (int j = 0; j < 2; j++)
+    for (int i = 0; i < 2; i++) {
+        float l = i*W/2, t = j*H/2, r = l + W/2, b = t + H/2;
+        SkPoint quad[] = { {l,t}, {r,t}, {r,b}, {l,t}, {r,b}, {l,b} };
+        for (SkPoint pt : quad) {
+            pts[n++] = pt;
+        }
+    }
+    auto verts = SkVertices::MakeCopy(SkVertices::kTriangles_VertexMode, n, pts, pts, nullptr);
+
+    auto expected = SkSurface::MakeRasterN32Premul(W, H),
+         actual   = SkSurface::MakeRasterN32Premul(W, H);
+    expected->getCanvas()->drawImage(image, 0, 0);
+
+    SkPaint paint;
+    paint.setShader(image->makeShader());
+    actual->getCanvas()->drawVertices(verts, SkBlendMode::kModulate, paint);
+
+    SkPixmap want, got;
+    SkAssertResult(expected->peekPixels(&want) && actual->peekPixels(&got));
+    for (int y = 0; y < H; y++)
+    for (int x = 0; x < W; x++) {
+        REPORTER_ASSERT(reporter, *want.addr32(x,y) == *got.addr32(x,y),
+                        "(%d,%d): %08x vs %08x", x, y, *want.addr32(x,y), *got.addr32(x,y));
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+// This is a GPU-backend specific test. It relies on static intializers to work
+
+#include "SkTypes.h"
+
+#if SK_SUPPORT_GPU && defined(SK_VULKAN)
+
+#include "vk/GrVkVulkan.h"
+
+#include "GrContextFactory.h"
+#include "SkCanvas.h"
+#include "SkSurface.h"
+#include "Test.h"
+#include "vk/GrVkGpu.h"
+
+using sk_gpu_test::GrContextFactory;
+
+namespace {
+
+// Remembers the last VkPipelineCache blob stored, and how many times one was stored.
+class PipelineCacheRecorder : public GrContextOptions::PersistentCache {
+public:
+    sk_sp<SkData> load(const SkData& key) override {
+        return IsPipelineCacheKey(key) ? fData : nullptr;
+    }
+
+    void store(const SkData& key, const SkData& data) override {
+        if (IsPipelineCacheKey(key)) {
+            fData = SkData::MakeWithCopy(data.data(), data.size());
+            ++fStoreCount;
+        }
+    }
+
+    sk_sp<SkData> fData;
+    int fStoreCount = 0;
+
+private:
+    static bool IsPipelineCacheKey(const SkData& key) {
+        uint32_t type;
+        if (key.size() < sizeof(type)) {
+            return false;
+        }
+        memcpy(&type, key.data(), sizeof(type));
+        return type == GrVkGpu::kPipelineCache_PersistentCacheKeyType;
+    }
+};
+
+}  // namespace
+
+// Draws a rect, which has to build at least one pipeline.
+static bool draw_rect(GrContext* context) {
+    SkImageInfo info = SkImageInfo::MakeN32Premul(16, 16);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    if (!surface) {
+        return false;
+    }
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    surface->getCanvas()->drawRect(SkRect::MakeWH(8, 8), paint);
+    surface->flush();
+    return true;
+}
+
+DEF_GPUTEST(VkPipelineCachePersists, reporter, options) {
+    PipelineCacheRecorder cache;
+    GrContextOptions cacheOptions = options;
+    cacheOptions.fPersistentCache = &cache;
+
+    {
+        GrContextFactory factory(cacheOptions);
+        GrContext* context = factory.get(GrContextFactory::kVulkan_ContextType);
+        if (!context || !draw_rect(context)) {
+            return;
+        }
+        context->storeVkPipelineCacheData();
+        REPORTER_ASSERT(reporter, 1 == cache.fStoreCount);
+        REPORTER_ASSERT(reporter, cache.fData && cache.fData->size() >= 16 + VK_UUID_SIZE);
+    }
+    // Nothing was built after the explicit store, so tearing down the context doesn't store again.
+    REPORTER_ASSERT(reporter, 1 == cache.fStoreCount);
+
+    {
+        GrContextFactory factory(cacheOptions);
+        GrContext* context = factory.get(GrContextFactory::kVulkan_ContextType);
+        REPORTER_ASSERT(reporter, context && draw_rect(context));
+    }
+    // Pipelines built without an explicit store are stored when the context goes away.
+    REPORTER_ASSERT(reporter, 2 == cache.fStoreCount);
+    REPORTER_ASSERT(reporter, cache.fData && cache.fData->size() >= 16 + VK_UUID_SIZE);
+}
+
+#endif
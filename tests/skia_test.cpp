@@ -213,7 +213,7 @@ int main(int argc, char** argv) {
     // Now run them.
     int skipCount = 0;
 
-    SkTaskGroup::Enabler enabled(FLAGS_threads);
+    SkTaskGroup::Enabler enabled(FLAGS_threads, FLAGS_workStealing);
     SkTaskGroup cpuTests;
     SkTArray<const Test*> gpuTests;
 
@@ -42,7 +42,7 @@ void DDLTileHelper::TileData::createTileSpecificSKP(SkData* compressedPictureDat
     }
 }
 
-void DDLTileHelper::TileData::createDDL() {
+void DDLTileHelper::TileData::createDDL(bool retained) {
     SkASSERT(!fDisplayList);
 
     SkDeferredDisplayListRecorder recorder(fCharacterization);
@@ -72,13 +72,21 @@ void DDLTileHelper::TileData::createDDL() {
         subCanvas->drawPicture(fReconstitutedPicture);
     }
 
-    fDisplayList = recorder.detach();
+    fRetained = retained;
+    fDisplayList = recorder.detach(retained ? SkDeferredDisplayListRecorder::Retain::kYes
+                                            : SkDeferredDisplayListRecorder::Retain::kNo);
 }
 
 void DDLTileHelper::TileData::draw() {
     SkASSERT(fDisplayList);
 
-    fSurface->draw(fDisplayList.get());
+    if (!fSurface->draw(fDisplayList.get()) && fRetained) {
+        // The DDL couldn't be retained (e.g., it draws text through the atlases) so its first
+        // flush consumed it. Record it again.
+        fDisplayList = nullptr;
+        this->createDDL(true);
+        fSurface->draw(fDisplayList.get());
+    }
 }
 
 void DDLTileHelper::TileData::compose(SkCanvas* dst) {
@@ -90,8 +98,9 @@ void DDLTileHelper::TileData::compose(SkCanvas* dst) {
 }
 
 void DDLTileHelper::TileData::reset() {
-    // TODO: when DDLs are re-renderable we don't need to do this
-    fDisplayList = nullptr;
+    if (!fRetained) {
+        fDisplayList = nullptr;
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -136,14 +145,19 @@ void DDLTileHelper::createSKPPerTile(SkData* compressedPictureData,
     }
 }
 
-void DDLTileHelper::createDDLsInParallel() {
+void DDLTileHelper::createDDLsInParallel(bool retained) {
+    auto createDDL = [&](int i) {
+        if (!fTiles[i].hasDDL()) {
+            fTiles[i].createDDL(retained);
+        }
+    };
 #if 1
-    SkTaskGroup().batch(fTiles.count(), [&](int i) { fTiles[i].createDDL(); });
+    SkTaskGroup().batch(fTiles.count(), createDDL);
     SkTaskGroup().wait();
 #else
     // Use this code path to debug w/o threads
     for (int i = 0; i < fTiles.count(); ++i) {
-        fTiles[i].createDDL();
+        createDDL(i);
     }
 #endif
 
@@ -35,8 +35,11 @@ public:
                                    const DDLPromiseImageHelper& helper);
 
         // This method can be invoked in parallel
-        // Create the per-tile DDL from the per-tile SKP
-        void createDDL();
+        // Create the per-tile DDL from the per-tile SKP. A retained DDL is kept by reset() and
+        // can be drawn on every frame without being recorded again.
+        void createDDL(bool retained = false);
+
+        bool hasDDL() const { return SkToBool(fDisplayList); }
 
         // This method operates serially and replays the recorded DDL into the tile surface.
         void draw();
@@ -55,13 +58,15 @@ public:
         SkTArray<sk_sp<SkImage>>               fPromiseImages; // All the promise images in the
                                                                // reconstituted picture
         std::unique_ptr<SkDeferredDisplayList> fDisplayList;
+        bool                                   fRetained = false;
     };
 
     DDLTileHelper(SkCanvas* canvas, const SkIRect& viewport, int numDivisions);
 
     void createSKPPerTile(SkData* compressedPictureData, const DDLPromiseImageHelper& helper);
 
-    void createDDLsInParallel();
+    // Retained DDLs are only recorded for the tiles that don't have one yet.
+    void createDDLsInParallel(bool retained = false);
 
     void drawAllTilesAndFlush(GrContext*, bool flush);
 
@@ -0,0 +1,370 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "OverdrawProfiler.h"
+
+#include "SkBitmap.h"
+#include "SkDrawShadowInfo.h"
+#include "SkImage.h"
+#include "SkJSONWriter.h"
+#include "SkPath.h"
+#include "SkPicture.h"
+#include "SkRRect.h"
+#include "SkRegion.h"
+#include "SkTextBlob.h"
+
+static const char* kOpTypeNames[] = {
+    "paint",
+    "points",
+    "rect",
+    "region",
+    "oval",
+    "arc",
+    "rrect",
+    "drrect",
+    "path",
+    "textBlob",
+    "patch",
+    "vertices",
+    "atlas",
+    "image",
+    "imageRect",
+    "imageNine",
+    "imageLattice",
+    "imageSet",
+    "shadow",
+};
+
+// Roughly how much work blending costs per pixel, counting a pixel write or read as one.
+static int blend_cost(SkBlendMode mode, const SkPaint* paint) {
+    switch (mode) {
+        case SkBlendMode::kDst:
+            return 0;
+        case SkBlendMode::kClear:
+        case SkBlendMode::kSrc:
+            return 1;
+        case SkBlendMode::kSrcOver:
+            // Opaque solid colors just overwrite what's there.
+            if (paint && 0xFF == paint->getAlpha() && !paint->getShader() &&
+                !paint->getColorFilter() && !paint->getMaskFilter()) {
+                return 1;
+            }
+            return 2;
+        default:
+            break;
+    }
+    if (mode <= SkBlendMode::kLastCoeffMode) {
+        return 2;
+    }
+    return mode <= SkBlendMode::kLastSeparableMode ? 3 : 4;
+}
+
+OverdrawProfiler::OverdrawProfiler(SkCanvas* canvas) : INHERITED(canvas) {
+    SkAssertResult(canvas->peekPixels(&fCounts));
+    SkASSERT(kAlpha_8_SkColorType == fCounts.colorType());
+}
+
+uint64_t OverdrawProfiler::sumCounts(const SkIRect& bounds) const {
+    uint64_t sum = 0;
+    for (int y = bounds.fTop; y < bounds.fBottom; ++y) {
+        const uint8_t* row = fCounts.addr8(0, y);
+        for (int x = bounds.fLeft; x < bounds.fRight; ++x) {
+            sum += row[x];
+        }
+    }
+    return sum;
+}
+
+template <typename Fn>
+void OverdrawProfiler::profile(OpType type, SkBlendMode mode, const SkPaint* paint,
+                               const SkRect* localBounds, Fn&& draw) {
+    // SkOverdrawCanvas draws some ops (text, drawables, ...) as others, which we don't recount.
+    if (fInOp) {
+        draw();
+        return;
+    }
+
+    SkIRect bounds = this->getDeviceClipBounds();
+    if (localBounds && (!paint || paint->canComputeFastBounds())) {
+        SkRect storage;
+        const SkRect& fastBounds = paint ? paint->computeFastBounds(*localBounds, &storage)
+                                         : *localBounds;
+        SkRect devBounds = this->getTotalMatrix().mapRect(fastBounds);
+        // Leave room for antialiasing.
+        if (!bounds.intersect(devBounds.roundOut().makeOutset(1, 1))) {
+            bounds.setEmpty();
+        }
+    }
+    if (!bounds.intersect(fCounts.bounds())) {
+        bounds.setEmpty();
+    }
+
+    const uint64_t before = this->sumCounts(bounds);
+    fInOp = true;
+    draw();
+    fInOp = false;
+    const uint64_t pixels = this->sumCounts(bounds) - before;
+
+    OpStats& stats = fStats[type];
+    stats.fCount++;
+    stats.fPixels    += pixels;
+    stats.fBlendCost += pixels * blend_cost(mode, paint);
+}
+
+SkCanvas::SaveLayerStrategy OverdrawProfiler::getSaveLayerStrategy(const SaveLayerRec& rec) {
+    SkIRect bounds = this->getDeviceClipBounds();
+    if (rec.fBounds) {
+        if (!bounds.intersect(this->getTotalMatrix().mapRect(*rec.fBounds).roundOut())) {
+            bounds.setEmpty();
+        }
+    }
+    fSaveLayerCount++;
+    fSaveLayerPixels += (uint64_t)bounds.width() * bounds.height();
+
+    // Count what's drawn into the layer straight into our pixels.  The restore still has to pop
+    // something from the target canvas, so give it a save.
+    this->INHERITED::willSave();
+    return kNoLayer_SaveLayerStrategy;
+}
+
+void OverdrawProfiler::writeJSON(SkJSONWriter* writer) const {
+    uint64_t histogram[256] = {};
+    for (int y = 0; y < fCounts.height(); ++y) {
+        const uint8_t* row = fCounts.addr8(0, y);
+        for (int x = 0; x < fCounts.width(); ++x) {
+            histogram[row[x]]++;
+        }
+    }
+    int levels = 256;
+    while (levels > 1 && 0 == histogram[levels - 1]) {
+        levels--;
+    }
+
+    writer->appendS32("width", fCounts.width());
+    writer->appendS32("height", fCounts.height());
+    writer->beginArray("overdrawHistogram", false);
+    for (int i = 0; i < levels; ++i) {
+        writer->appendU64(histogram[i]);
+    }
+    writer->endArray();
+
+    uint64_t pixels = 0, blendCost = 0;
+    writer->beginObject("ops");
+    for (int i = 0; i < kOpTypeCount; ++i) {
+        const OpStats& stats = fStats[i];
+        if (0 == stats.fCount) {
+            continue;
+        }
+        writer->beginObject(kOpTypeNames[i], false);
+        writer->appendS32("count", stats.fCount);
+        writer->appendU64("pixels", stats.fPixels);
+        writer->appendU64("blendCost", stats.fBlendCost);
+        writer->endObject();
+        pixels    += stats.fPixels;
+        blendCost += stats.fBlendCost;
+    }
+    writer->endObject();
+
+    writer->appendU64("pixelsTouched", pixels);
+    writer->appendU64("blendCost", blendCost);
+    writer->appendS32("saveLayers", fSaveLayerCount);
+    writer->appendU64("saveLayerPixels", fSaveLayerPixels);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void OverdrawProfiler::onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
+                                      const SkPaint& paint) {
+    const SkRect bounds = blob->bounds().makeOffset(x, y);
+    this->profile(kTextBlob_OpType, paint.getBlendMode(), &paint, &bounds, [&] {
+        this->INHERITED::onDrawTextBlob(blob, x, y, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawPatch(const SkPoint cubics[12], const SkColor colors[4],
+                                   const SkPoint texCoords[4], SkBlendMode blendMode,
+                                   const SkPaint& paint) {
+    this->profile(kPatch_OpType, paint.getBlendMode(), &paint, nullptr, [&] {
+        this->INHERITED::onDrawPatch(cubics, colors, texCoords, blendMode, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawPaint(const SkPaint& paint) {
+    this->profile(kPaint_OpType, paint.getBlendMode(), &paint, nullptr, [&] {
+        this->INHERITED::onDrawPaint(paint);
+    });
+}
+
+void OverdrawProfiler::onDrawRect(const SkRect& rect, const SkPaint& paint) {
+    this->profile(kRect_OpType, paint.getBlendMode(), &paint, &rect, [&] {
+        this->INHERITED::onDrawRect(rect, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawEdgeAARect(const SkRect& rect, SkCanvas::QuadAAFlags aa,
+                                        SkColor color, SkBlendMode mode) {
+    SkPaint paint;
+    paint.setColor(color);
+    this->profile(kRect_OpType, mode, &paint, &rect, [&] {
+        this->INHERITED::onDrawEdgeAARect(rect, aa, color, mode);
+    });
+}
+
+void OverdrawProfiler::onDrawRegion(const SkRegion& region, const SkPaint& paint) {
+    const SkRect bounds = SkRect::Make(region.getBounds());
+    this->profile(kRegion_OpType, paint.getBlendMode(), &paint, &bounds, [&] {
+        this->INHERITED::onDrawRegion(region, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawOval(const SkRect& oval, const SkPaint& paint) {
+    this->profile(kOval_OpType, paint.getBlendMode(), &paint, &oval, [&] {
+        this->INHERITED::onDrawOval(oval, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawArc(const SkRect& arc, SkScalar startAngle, SkScalar sweepAngle,
+                                 bool useCenter, const SkPaint& paint) {
+    this->profile(kArc_OpType, paint.getBlendMode(), &paint, &arc, [&] {
+        this->INHERITED::onDrawArc(arc, startAngle, sweepAngle, useCenter, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawDRRect(const SkRRect& outer, const SkRRect& inner,
+                                    const SkPaint& paint) {
+    this->profile(kDRRect_OpType, paint.getBlendMode(), &paint, &outer.getBounds(), [&] {
+        this->INHERITED::onDrawDRRect(outer, inner, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawRRect(const SkRRect& rrect, const SkPaint& paint) {
+    this->profile(kRRect_OpType, paint.getBlendMode(), &paint, &rrect.getBounds(), [&] {
+        this->INHERITED::onDrawRRect(rrect, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawPoints(PointMode mode, size_t count, const SkPoint points[],
+                                    const SkPaint& paint) {
+    this->profile(kPoints_OpType, paint.getBlendMode(), &paint, nullptr, [&] {
+        this->INHERITED::onDrawPoints(mode, count, points, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawVerticesObject(const SkVertices* vertices,
+                                            const SkVertices::Bone bones[], int boneCount,
+                                            SkBlendMode blendMode, const SkPaint& paint) {
+    this->profile(kVertices_OpType, paint.getBlendMode(), &paint, nullptr, [&] {
+        this->INHERITED::onDrawVerticesObject(vertices, bones, boneCount, blendMode, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawAtlas(const SkImage* image, const SkRSXform xform[],
+                                   const SkRect texs[], const SkColor colors[], int count,
+                                   SkBlendMode mode, const SkRect* cull, const SkPaint* paint) {
+    this->profile(kAtlas_OpType, paint ? paint->getBlendMode() : SkBlendMode::kSrcOver, paint,
+                  cull, [&] {
+        this->INHERITED::onDrawAtlas(image, xform, texs, colors, count, mode, cull, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawPath(const SkPath& path, const SkPaint& paint) {
+    const SkRect& bounds = path.getBounds();
+    this->profile(kPath_OpType, paint.getBlendMode(), &paint,
+                  path.isInverseFillType() ? nullptr : &bounds, [&] {
+        this->INHERITED::onDrawPath(path, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawImage(const SkImage* image, SkScalar x, SkScalar y,
+                                   const SkPaint* paint) {
+    const SkRect bounds = SkRect::MakeXYWH(x, y, image->width(), image->height());
+    this->profile(kImage_OpType, paint ? paint->getBlendMode() : SkBlendMode::kSrcOver, paint,
+                  &bounds, [&] {
+        this->INHERITED::onDrawImage(image, x, y, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawImageRect(const SkImage* image, const SkRect* src, const SkRect& dst,
+                                       const SkPaint* paint, SrcRectConstraint constraint) {
+    this->profile(kImageRect_OpType, paint ? paint->getBlendMode() : SkBlendMode::kSrcOver, paint,
+                  &dst, [&] {
+        this->INHERITED::onDrawImageRect(image, src, dst, paint, constraint);
+    });
+}
+
+void OverdrawProfiler::onDrawImageNine(const SkImage* image, const SkIRect& center,
+                                       const SkRect& dst, const SkPaint* paint) {
+    this->profile(kImageNine_OpType, paint ? paint->getBlendMode() : SkBlendMode::kSrcOver, paint,
+                  &dst, [&] {
+        this->INHERITED::onDrawImageNine(image, center, dst, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawImageLattice(const SkImage* image, const Lattice& lattice,
+                                          const SkRect& dst, const SkPaint* paint) {
+    this->profile(kImageLattice_OpType, paint ? paint->getBlendMode() : SkBlendMode::kSrcOver,
+                  paint, &dst, [&] {
+        this->INHERITED::onDrawImageLattice(image, lattice, dst, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawImageSet(const ImageSetEntry set[], int count,
+                                      SkFilterQuality quality, SkBlendMode mode) {
+    SkRect bounds = SkRect::MakeEmpty();
+    for (int i = 0; i < count; ++i) {
+        bounds.join(set[i].fDstRect);
+    }
+    this->profile(kImageSet_OpType, mode, nullptr, &bounds, [&] {
+        this->INHERITED::onDrawImageSet(set, count, quality, mode);
+    });
+}
+
+void OverdrawProfiler::onDrawBitmap(const SkBitmap& bitmap, SkScalar x, SkScalar y,
+                                    const SkPaint* paint) {
+    const SkRect bounds = SkRect::MakeXYWH(x, y, bitmap.width(), bitmap.height());
+    this->profile(kImage_OpType, paint ? paint->getBlendMode() : SkBlendMode::kSrcOver, paint,
+                  &bounds, [&] {
+        this->INHERITED::onDrawBitmap(bitmap, x, y, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawBitmapRect(const SkBitmap& bitmap, const SkRect* src,
+                                        const SkRect& dst, const SkPaint* paint,
+                                        SrcRectConstraint constraint) {
+    this->profile(kImageRect_OpType, paint ? paint->getBlendMode() : SkBlendMode::kSrcOver, paint,
+                  &dst, [&] {
+        this->INHERITED::onDrawBitmapRect(bitmap, src, dst, paint, constraint);
+    });
+}
+
+void OverdrawProfiler::onDrawBitmapNine(const SkBitmap& bitmap, const SkIRect& center,
+                                        const SkRect& dst, const SkPaint* paint) {
+    this->profile(kImageNine_OpType, paint ? paint->getBlendMode() : SkBlendMode::kSrcOver, paint,
+                  &dst, [&] {
+        this->INHERITED::onDrawBitmapNine(bitmap, center, dst, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawBitmapLattice(const SkBitmap& bitmap, const Lattice& lattice,
+                                           const SkRect& dst, const SkPaint* paint) {
+    this->profile(kImageLattice_OpType, paint ? paint->getBlendMode() : SkBlendMode::kSrcOver,
+                  paint, &dst, [&] {
+        this->INHERITED::onDrawBitmapLattice(bitmap, lattice, dst, paint);
+    });
+}
+
+void OverdrawProfiler::onDrawPicture(const SkPicture* picture, const SkMatrix* matrix,
+                                     const SkPaint* paint) {
+    // Unlike SkOverdrawCanvas, which expects pictures to be unrolled, play them back op by op.
+    this->SkCanvas::onDrawPicture(picture, matrix, paint);
+}
+
+void OverdrawProfiler::onDrawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) {
+    this->profile(kShadow_OpType, SkBlendMode::kSrcOver, nullptr, nullptr, [&] {
+        this->INHERITED::onDrawShadowRec(path, rec);
+    });
+}
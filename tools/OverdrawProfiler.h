@@ -0,0 +1,116 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef OverdrawProfiler_DEFINED
+#define OverdrawProfiler_DEFINED
+
+#include "SkOverdrawCanvas.h"
+
+class SkJSONWriter;
+
+/**
+ *  An SkOverdrawCanvas that also measures what each draw costs.  Draws into a raster canvas over
+ *  kAlpha_8 pixels, whose alpha ends up counting how often each pixel was touched, and for every
+ *  op records how many pixels it touched and a rough blend cost: the pixels weighted by how much
+ *  work the op's blend mode does for each of them.
+ *
+ *  Layers are not allocated.  Their area is reported, and what's drawn into them counts as
+ *  touching the pixels underneath.
+ */
+class OverdrawProfiler : public SkOverdrawCanvas {
+public:
+    /* Does not take ownership of canvas, which must have peekable kAlpha_8 pixels */
+    OverdrawProfiler(SkCanvas*);
+
+    // Writes the overdraw histogram and the per-op-type totals as members of the current object.
+    void writeJSON(SkJSONWriter*) const;
+
+    void onDrawTextBlob(const SkTextBlob*, SkScalar, SkScalar, const SkPaint&) override;
+    void onDrawPatch(const SkPoint[12], const SkColor[4], const SkPoint[4], SkBlendMode,
+                     const SkPaint&) override;
+    void onDrawPaint(const SkPaint&) override;
+    void onDrawRect(const SkRect&, const SkPaint&) override;
+    void onDrawEdgeAARect(const SkRect&, SkCanvas::QuadAAFlags, SkColor, SkBlendMode) override;
+    void onDrawRegion(const SkRegion&, const SkPaint&) override;
+    void onDrawOval(const SkRect&, const SkPaint&) override;
+    void onDrawArc(const SkRect&, SkScalar, SkScalar, bool, const SkPaint&) override;
+    void onDrawDRRect(const SkRRect&, const SkRRect&, const SkPaint&) override;
+    void onDrawRRect(const SkRRect&, const SkPaint&) override;
+    void onDrawPoints(PointMode, size_t, const SkPoint[], const SkPaint&) override;
+    void onDrawVerticesObject(const SkVertices*, const SkVertices::Bone bones[], int boneCount,
+                              SkBlendMode, const SkPaint&) override;
+    void onDrawAtlas(const SkImage*, const SkRSXform[], const SkRect[], const SkColor[],
+                     int, SkBlendMode, const SkRect*, const SkPaint*) override;
+    void onDrawPath(const SkPath&, const SkPaint&) override;
+    void onDrawImage(const SkImage*, SkScalar, SkScalar, const SkPaint*) override;
+    void onDrawImageRect(const SkImage*, const SkRect*, const SkRect&, const SkPaint*,
+                         SrcRectConstraint) override;
+    void onDrawImageNine(const SkImage*, const SkIRect&, const SkRect&, const SkPaint*) override;
+    void onDrawImageLattice(const SkImage*, const Lattice&, const SkRect&, const SkPaint*) override;
+    void onDrawImageSet(const ImageSetEntry[], int count, SkFilterQuality, SkBlendMode) override;
+    void onDrawBitmap(const SkBitmap&, SkScalar, SkScalar, const SkPaint*) override;
+    void onDrawBitmapRect(const SkBitmap&, const SkRect*, const SkRect&, const SkPaint*,
+                          SrcRectConstraint) override;
+    void onDrawBitmapNine(const SkBitmap&, const SkIRect&, const SkRect&, const SkPaint*) override;
+    void onDrawBitmapLattice(const SkBitmap&, const Lattice&, const SkRect&,
+                             const SkPaint*) override;
+    void onDrawPicture(const SkPicture*, const SkMatrix*, const SkPaint*) override;
+    void onDrawShadowRec(const SkPath&, const SkDrawShadowRec&) override;
+
+protected:
+    SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec&) override;
+
+private:
+    enum OpType {
+        kPaint_OpType,
+        kPoints_OpType,
+        kRect_OpType,
+        kRegion_OpType,
+        kOval_OpType,
+        kArc_OpType,
+        kRRect_OpType,
+        kDRRect_OpType,
+        kPath_OpType,
+        kTextBlob_OpType,
+        kPatch_OpType,
+        kVertices_OpType,
+        kAtlas_OpType,
+        kImage_OpType,
+        kImageRect_OpType,
+        kImageNine_OpType,
+        kImageLattice_OpType,
+        kImageSet_OpType,
+        kShadow_OpType,
+
+        kLast_OpType = kShadow_OpType
+    };
+    static constexpr int kOpTypeCount = kLast_OpType + 1;
+
+    struct OpStats {
+        int      fCount     = 0;
+        uint64_t fPixels    = 0;
+        uint64_t fBlendCost = 0;
+    };
+
+    // Runs draw() and charges the pixels it touched to type.  localBounds, if given, bounds what
+    // the op may touch before the paint is applied.
+    template <typename Fn>
+    void profile(OpType type, SkBlendMode, const SkPaint*, const SkRect* localBounds, Fn&& draw);
+
+    // Sums the touch counts of the pixels in bounds.
+    uint64_t sumCounts(const SkIRect& bounds) const;
+
+    SkPixmap fCounts;
+    OpStats  fStats[kOpTypeCount];
+    uint64_t fSaveLayerPixels = 0;
+    int      fSaveLayerCount  = 0;
+    bool     fInOp            = false;
+
+    typedef SkOverdrawCanvas INHERITED;
+};
+
+#endif
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "PerfCounters.h"
+#include "SkTypes.h"
+
+#include <string.h>
+
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)  // N.B. perf_event is Linux-only.
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+
+    static int open_counter(uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        // pid 0 and cpu -1 count this thread on any cpu.
+        return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+
+    static constexpr uint64_t cache_miss(uint64_t cache) {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+    sk_tools::PerfCounters::PerfCounters() {
+        fFDs[kInstructions] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fFDs[kCycles]       = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        fFDs[kL1DMisses]    = open_counter(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D));
+        fFDs[kLLCMisses]    = open_counter(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL));
+        fFDs[kBranchMisses] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    }
+
+    sk_tools::PerfCounters::~PerfCounters() {
+        for (int fd : fFDs) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    void sk_tools::PerfCounters::start() {
+        for (int fd : fFDs) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    void sk_tools::PerfCounters::stop() {
+        for (int fd : fFDs) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+    }
+
+    int64_t sk_tools::PerfCounters::count(Counter counter) const {
+        int fd = fFDs[counter];
+        if (fd < 0) {
+            return -1;
+        }
+        // value, time enabled, time running
+        uint64_t data[3];
+        if (read(fd, data, sizeof(data)) != sizeof(data)) {
+            return -1;
+        }
+        if (0 == data[2]) {
+            return 0 == data[1] ? 0 : -1;
+        }
+        if (data[2] < data[1]) {
+            return (int64_t)((double)data[0] * data[1] / data[2]);
+        }
+        return (int64_t)data[0];
+    }
+#else
+    sk_tools::PerfCounters::PerfCounters() {
+        for (int& fd : fFDs) {
+            fd = -1;
+        }
+    }
+    sk_tools::PerfCounters::~PerfCounters() {}
+    void sk_tools::PerfCounters::start() {}
+    void sk_tools::PerfCounters::stop() {}
+    int64_t sk_tools::PerfCounters::count(Counter) const { return -1; }
+#endif
+
+bool sk_tools::PerfCounters::isValid() const {
+    for (int fd : fFDs) {
+        if (fd >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* sk_tools::PerfCounters::Name(Counter counter) {
+    switch (counter) {
+        case kInstructions: return "instructions";
+        case kCycles:       return "cycles";
+        case kL1DMisses:    return "l1d_misses";
+        case kLLCMisses:    return "llc_misses";
+        case kBranchMisses: return "branch_misses";
+    }
+    SkDEBUGFAIL("Unknown counter.");
+    return "";
+}
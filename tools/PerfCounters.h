@@ -0,0 +1,61 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef PerfCounters_DEFINED
+#define PerfCounters_DEFINED
+
+#include <stdint.h>
+
+namespace sk_tools {
+
+/**
+ *  PerfCounters - Counts hardware events of the calling thread between start() and stop().
+ *
+ *  Only implemented with Linux's perf_event_open(). Elsewhere, or if the kernel doesn't allow it
+ *  (see /proc/sys/kernel/perf_event_paranoid), no counters are available.
+ */
+class PerfCounters {
+public:
+    enum Counter {
+        kInstructions,
+        kCycles,
+        kL1DMisses,
+        kLLCMisses,
+        kBranchMisses,
+
+        kLast = kBranchMisses
+    };
+    static constexpr int kCount = kLast + 1;
+
+    // The metric name of the counter, e.g. "instructions".
+    static const char* Name(Counter);
+
+    PerfCounters();
+    ~PerfCounters();
+
+    // Returns true if any counter is available.
+    bool isValid() const;
+
+    void start();
+    void stop();
+
+    /**
+     *  Returns the count between the last start() and stop(), or -1 if the counter isn't available.
+     *  If the kernel had to multiplex the counters, the count is scaled up to the whole interval.
+     */
+    int64_t count(Counter) const;
+
+private:
+    int fFDs[kCount];
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+};
+
+}  // namespace sk_tools
+
+#endif  // PerfCounters_DEFINED
@@ -31,6 +31,7 @@ DECLARE_string(svgs);
 DECLARE_string(nimas);
 DECLARE_bool(nativeFonts);
 DECLARE_int32(threads);
+DECLARE_bool(workStealing);
 DECLARE_string(resourcePath);
 DECLARE_bool(verbose);
 DECLARE_bool(veryVerbose);
@@ -38,6 +38,8 @@ inline GpuPathRenderers get_named_pathrenderers_flags(const char* name) {
         return GpuPathRenderers::kSmall;
     } else if (!strcmp(name, "tess")) {
         return GpuPathRenderers::kTessellating;
+    } else if (!strcmp(name, "skc")) {
+        return GpuPathRenderers::kSkc;
     } else if (!strcmp(name, "all")) {
         return GpuPathRenderers::kAll;
     }
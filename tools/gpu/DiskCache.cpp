@@ -0,0 +1,161 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "DiskCache.h"
+#include "SkMakeUnique.h"
+#include "SkOSFile.h"
+#include "SkStream.h"
+#include "SkTraceEvent.h"
+
+#include <cstdio>
+
+// File layout, all little-endian uint32_t fields, each key and value padded to 4 bytes:
+//     header: kMagic, kFormatVersion, version tag hash, entry count
+//     entries: key size, value size, key bytes, value bytes
+static constexpr uint32_t kMagic         = SkSetFourByteTag('s', 'k', 'p', 'c');
+static constexpr uint32_t kFormatVersion = 1;
+static constexpr size_t   kHeaderSize    = 4 * sizeof(uint32_t);
+
+static size_t pad4(size_t size) { return SkAlign4(size); }
+
+namespace sk_gpu_test {
+
+DiskCache::DiskCache(const char* path, const char* versionTag)
+    : fPath(path)
+    , fVersionHash(SkOpts::hash_fn(versionTag, strlen(versionTag), 0)) {}
+
+DiskCache::~DiskCache() {
+    if (fPrefetchTasks) {
+        fPrefetchTasks->wait();
+    }
+    this->flush();
+}
+
+void DiskCache::readFile() {
+    TRACE_EVENT0("skia.gpu", TRACE_FUNC);
+    sk_sp<SkData> file = SkData::MakeFromFileName(fPath.c_str());
+    if (!file || file->size() < kHeaderSize) {
+        return;
+    }
+
+    const uint8_t* bytes = file->bytes();
+    uint32_t header[4];
+    memcpy(header, bytes, kHeaderSize);
+    if (header[0] != kMagic || header[1] != kFormatVersion || header[2] != fVersionHash) {
+        return;
+    }
+
+    SkAutoExclusive lock(fMutex);
+    size_t offset = kHeaderSize;
+    for (uint32_t i = 0; i < header[3]; ++i) {
+        uint32_t sizes[2];
+        if (file->size() - offset < sizeof(sizes)) {
+            break;
+        }
+        memcpy(sizes, bytes + offset, sizeof(sizes));
+        offset += sizeof(sizes);
+        size_t keySize = pad4(sizes[0]), valueSize = pad4(sizes[1]);
+        if (keySize < sizes[0] || valueSize < sizes[1] ||
+            file->size() - offset < keySize ||
+            file->size() - offset - keySize < valueSize) {
+            break;  // Truncated or corrupt.  Keep what we've read so far.
+        }
+        sk_sp<SkData> key = SkData::MakeSubset(file.get(), offset, sizes[0]);
+        offset += keySize;
+        // Values stay in the mapping; they're only copied if we need to rewrite the file.
+        fMap[Key(*key)] = SkData::MakeSubset(file.get(), offset, sizes[1]);
+        offset += valueSize;
+    }
+}
+
+sk_sp<SkData> DiskCache::load(const SkData& key) {
+    fReadOnce([this] { this->readFile(); });
+    SkAutoExclusive lock(fMutex);
+    return this->INHERITED::load(key);
+}
+
+void DiskCache::store(const SkData& key, const SkData& data) {
+    fReadOnce([this] { this->readFile(); });
+    SkAutoExclusive lock(fMutex);
+    this->INHERITED::store(key, data);
+    fDirty = true;
+}
+
+void DiskCache::prefetch(SkExecutor* executor) {
+    auto work = [this] {
+        fReadOnce([this] { this->readFile(); });
+        TRACE_EVENT0("skia.gpu", "DiskCache::pageIn");
+        SkAutoExclusive lock(fMutex);
+        // Touch each page of each value so first-frame loads never fault on the file.
+        volatile uint8_t sink = 0;
+        for (const auto& entry : fMap) {
+            const uint8_t* bytes = entry.second->bytes();
+            for (size_t i = 0; i < entry.second->size(); i += 4096) {
+                sink ^= bytes[i];
+            }
+        }
+        (void)sink;
+    };
+    if (!executor) {
+        return;  // Without an executor we just read the file on the first load().
+    }
+    if (!fPrefetchTasks) {
+        fPrefetchTasks = skstd::make_unique<SkTaskGroup>(*executor);
+    }
+    fPrefetchTasks->add(work);
+}
+
+bool DiskCache::flush() {
+    fReadOnce([this] { this->readFile(); });
+    SkAutoExclusive lock(fMutex);
+    if (!fDirty) {
+        return true;
+    }
+    TRACE_EVENT0("skia.gpu", TRACE_FUNC);
+
+    // Write to a temporary file, then swap it in.  Any values we handed out that still point
+    // into the old file's mapping stay valid, as the old file is only unlinked.
+    SkString tmpPath = SkStringPrintf("%s.tmp", fPath.c_str());
+    {
+        SkFILEWStream out(tmpPath.c_str());
+        if (!out.isValid()) {
+            return false;
+        }
+        const uint32_t header[4] = {kMagic, kFormatVersion, fVersionHash, (uint32_t)fMap.size()};
+        bool ok = out.write(header, sizeof(header));
+        static const uint8_t kZeros[4] = {0, 0, 0, 0};
+        for (const auto& entry : fMap) {
+            const SkData& key = *entry.first.fKey;
+            const SkData& value = *entry.second;
+            const uint32_t sizes[2] = {(uint32_t)key.size(), (uint32_t)value.size()};
+            ok = ok && out.write(sizes, sizeof(sizes))
+                    && out.write(key.data(), key.size())
+                    && out.write(kZeros, pad4(key.size()) - key.size())
+                    && out.write(value.data(), value.size())
+                    && out.write(kZeros, pad4(value.size()) - value.size());
+        }
+        out.flush();
+        if (!ok) {
+            remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    remove(fPath.c_str());
+    if (0 != rename(tmpPath.c_str(), fPath.c_str())) {
+        return false;
+    }
+    fDirty = false;
+    return true;
+}
+
+int DiskCache::numEntries() {
+    fReadOnce([this] { this->readFile(); });
+    SkAutoExclusive lock(fMutex);
+    return (int)fMap.size();
+}
+
+}  // namespace sk_gpu_test
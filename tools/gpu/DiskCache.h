@@ -0,0 +1,66 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef DiskCache_DEFINED
+#define DiskCache_DEFINED
+
+#include "MemoryCache.h"
+#include "SkMutex.h"
+#include "SkOnce.h"
+#include "SkString.h"
+#include "SkTaskGroup.h"
+
+#include <memory>
+
+namespace sk_gpu_test {
+
+/**
+ * A MemoryCache that persists itself to a single file. The file is memory-mapped when first
+ * needed and entries loaded from it point directly into the mapping. New entries are kept in
+ * memory until flush() (or destruction) rewrites the file.
+ *
+ * The file records a format version and a hash of the caller's version tag. If either does not
+ * match, the file's contents are ignored and replaced on the next flush. The tag should describe
+ * everything that can invalidate cached program binaries or pipeline caches, e.g. the GL vendor,
+ * renderer and version strings, or the Vulkan driver version.
+ *
+ * Like MemoryCache, one DiskCache may be shared by GrContexts with identical options and caps.
+ * Unlike MemoryCache, it is safe to use from multiple threads.
+ */
+class DiskCache : public MemoryCache {
+public:
+    DiskCache(const char* path, const char* versionTag);
+    ~DiskCache() override;
+
+    sk_sp<SkData> load(const SkData& key) override;
+    void store(const SkData& key, const SkData& data) override;
+
+    // Maps and indexes the file, then pages in every entry, on the executor if there is one.
+    void prefetch(SkExecutor*) override;
+
+    // Writes the cache to disk if it changed since it was read. Returns false on I/O failure.
+    bool flush();
+
+    int numEntries();
+
+private:
+    void readFile();
+
+    const SkString                fPath;
+    const uint32_t                fVersionHash;
+    SkOnce                        fReadOnce;
+    std::unique_ptr<SkTaskGroup>  fPrefetchTasks;
+    // Guards fMap, fCacheMissCnt and fDirty.
+    SkMutex                       fMutex;
+    bool                          fDirty = false;
+
+    typedef MemoryCache INHERITED;
+};
+
+}  // namespace sk_gpu_test
+
+#endif
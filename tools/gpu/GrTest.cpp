@@ -123,6 +123,12 @@ void GrGpu::Stats::dump(SkString* out) {
     out->appendf("Transfers to Texture: %d\n", fTransfersToTexture);
     out->appendf("Stencil Buffer Creates: %d\n", fStencilAttachmentCreates);
     out->appendf("Number of draws: %d\n", fNumDraws);
+    out->appendf("Skipped State Changes: %d\n", fSkippedStateChanges);
+    out->appendf("Atlas Flushes: %d\n", fAtlasFlushes);
+    out->appendf("Transient Peak Bytes: %zu (max %zu)\n", fTransientPeakBytes,
+                 fMaxTransientPeakBytes);
+    out->appendf("Transient Allocated Bytes: %zu\n", fTransientAllocatedBytes);
+    out->appendf("Vertex Upload Bytes: %zu\n", fVertexUploadBytes);
 }
 
 void GrGpu::Stats::dumpKeyValuePairs(SkTArray<SkString>* keys, SkTArray<double>* values) {
@@ -131,6 +137,11 @@ void GrGpu::Stats::dumpKeyValuePairs(SkTArray<SkString>* keys, SkTArray<double>*
     keys->push_back(SkString("texture_uploads")); values->push_back(fTextureUploads);
     keys->push_back(SkString("number_of_draws")); values->push_back(fNumDraws);
     keys->push_back(SkString("number_of_failed_draws")); values->push_back(fNumFailedDraws);
+    keys->push_back(SkString("skipped_state_changes")); values->push_back(fSkippedStateChanges);
+    keys->push_back(SkString("atlas_flushes")); values->push_back(fAtlasFlushes);
+    keys->push_back(SkString("max_transient_peak_bytes"));
+    values->push_back(fMaxTransientPeakBytes);
+    keys->push_back(SkString("vertex_upload_bytes")); values->push_back(fVertexUploadBytes);
 }
 
 #endif
@@ -354,6 +365,7 @@ DRAW_OP_TEST_EXTERN(GrDrawAtlasOp);
 DRAW_OP_TEST_EXTERN(GrDrawVerticesOp);
 DRAW_OP_TEST_EXTERN(NonAALatticeOp);
 DRAW_OP_TEST_EXTERN(NonAAStrokeRectOp);
+DRAW_OP_TEST_EXTERN(ShadowConvexOp);
 DRAW_OP_TEST_EXTERN(ShadowRRectOp);
 DRAW_OP_TEST_EXTERN(SmallPathOp);
 DRAW_OP_TEST_EXTERN(RegionOp);
@@ -380,6 +392,7 @@ void GrDrawRandomOp(SkRandom* random, GrRenderTargetContext* renderTargetContext
             DRAW_OP_TEST_ENTRY(GrDrawVerticesOp),
             DRAW_OP_TEST_ENTRY(NonAALatticeOp),
             DRAW_OP_TEST_ENTRY(NonAAStrokeRectOp),
+            DRAW_OP_TEST_ENTRY(ShadowConvexOp),
             DRAW_OP_TEST_ENTRY(ShadowRRectOp),
             DRAW_OP_TEST_ENTRY(SmallPathOp),
             DRAW_OP_TEST_ENTRY(RegionOp),
@@ -33,7 +33,7 @@ public:
     int numCacheMisses() const { return fCacheMissCnt; }
     void resetNumCacheMisses() { fCacheMissCnt = 0; }
 
-private:
+protected:
     struct Key {
         Key() = default;
         Key(const SkData& key) : fKey(SkData::MakeWithCopy(key.data(), key.size())) {}
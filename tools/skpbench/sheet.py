@@ -10,6 +10,7 @@ from _benchresult import BenchResult
 from argparse import ArgumentParser
 from collections import defaultdict, namedtuple
 from datetime import datetime
+import json
 import operator
 import os
 import sys
@@ -36,6 +37,10 @@ This script can also be used to generate a Google sheet:
 __argparse.add_argument('-r', '--result',
   choices=['accum', 'median', 'max', 'min'], default='accum',
   help="result to use for cell values")
+__argparse.add_argument('-b', '--breakdown',
+  choices=['cpu_ms', 'gpu_ms', 'count'],
+  help="read skpbench --breakdown .json files instead of results, and "
+       "tabulate this value for each op class")
 __argparse.add_argument('-f', '--force',
   action='store_true', help='silently ignore warnings')
 __argparse.add_argument('-o', '--open',
@@ -135,8 +140,45 @@ class Parser:
       outfile.write('%.4g,' % func(self.cols[fullconfig]))
     outfile.write('\n')
 
+class BreakdownParser:
+  PHASES = ('record', 'flush', 'prepare', 'execute', 'submit')
+
+  def __init__(self):
+    self.benches = list() # use list to preserve the order.
+    self.rows = defaultdict(dict)
+
+  def parse_file(self, infile):
+    breakdown = json.load(infile)
+    bench = '%s %s' % (breakdown['bench'], breakdown['config'])
+    if not bench in self.benches:
+      self.benches.append(bench)
+    if FLAGS.breakdown == 'cpu_ms':
+      for phase in self.PHASES:
+        self.rows['(%s)' % phase][bench] = breakdown['cpu_ms'][phase]
+    for op, values in breakdown['ops'].iteritems():
+      if FLAGS.breakdown in values:
+        self.rows[op][bench] = values[FLAGS.breakdown]
+
+  def print_csv(self, outfile=sys.stdout):
+    print(FLAGS.breakdown, file=outfile)
+    outfile.write('op,')
+    for bench in self.benches:
+      outfile.write('%s,' % bench)
+    outfile.write('\n')
+    # Phases first, then the op classes that cost the most overall.
+    def order(op):
+      if op.startswith('('):
+        return (0, self.PHASES.index(op[1:-1]))
+      return (1, -sum(self.rows[op].values()))
+    ops = sorted(self.rows.keys(), key=order)
+    for op in ops:
+      outfile.write('%s,' % op)
+      for bench in self.benches:
+        outfile.write('%.4g,' % self.rows[op].get(bench, 0))
+      outfile.write('\n')
+
 def main():
-  parser = Parser()
+  parser = BreakdownParser() if FLAGS.breakdown else Parser()
 
   # Parse the input files.
   for src in FLAGS.sources:
@@ -11,12 +11,15 @@
 #include "GrCaps.h"
 #include "GrContextFactory.h"
 #include "GrContextPriv.h"
+#include "GrFlushTimer.h"
+#include "ops/GrOp.h"
 #include "SkCanvas.h"
 #include "SkCommonFlags.h"
 #include "SkCommonFlagsGpu.h"
 #include "SkDeferredDisplayList.h"
 #include "SkGraphics.h"
 #include "SkGr.h"
+#include "SkJSONWriter.h"
 #include "SkOSFile.h"
 #include "SkOSPath.h"
 #include "SkPerlinNoiseShader.h"
@@ -40,6 +43,9 @@
 #include <array>
 #include <chrono>
 #include <cmath>
+#include <deque>
+#include <map>
+#include <string>
 #include <vector>
 
 /**
@@ -58,6 +64,7 @@ DEFINE_bool(ddl, false, "record the skp into DDLs before rendering");
 DEFINE_int32(ddlNumAdditionalThreads, 0, "number of DDL recording threads in addition to main one");
 DEFINE_int32(ddlTilingWidthHeight, 0, "number of tiles along one edge when in DDL mode");
 DEFINE_bool(ddlRecordTime, false, "report just the cpu time spent recording DDLs");
+DEFINE_bool(ddlRetain, false, "record retained DDLs once and redraw them on every frame");
 
 DEFINE_int32(duration, 5000, "number of milliseconds to run the benchmark");
 DEFINE_int32(sampleMs, 50, "minimum duration of a sample");
@@ -67,6 +74,8 @@ DEFINE_string(src, "", "path to a single .skp or .svg file, or 'warmup' for a bu
 DEFINE_string(png, "", "if set, save a .png proof to disk at this file location");
 DEFINE_int32(verbosity, 4, "level of verbosity (0=none to 5=debug)");
 DEFINE_bool(suppressHeader, false, "don't print a header row before the results");
+DEFINE_string(breakdown, "", "if set, time a few more frames by flush phase, opList and op class, "
+                             "and write the breakdown to this file as JSON");
 
 static const char* header =
 "   accum    median       max       min   stddev  samples  sample_ms  clock  metric  config    bench";
@@ -75,6 +84,7 @@ static const char* resultFormat =
 "%8.4g  %8.4g  %8.4g  %8.4g  %6.3g%%  %7li  %9i  %-5s  %-6s  %-9s %s";
 
 static constexpr int kNumFlushesToPrimeCache = 3;
+static constexpr int kNumBreakdownFrames = 20;
 
 struct Sample {
     using duration = std::chrono::nanoseconds;
@@ -125,7 +135,7 @@ static void ddl_sample(GrContext* context, DDLTileHelper* tiles, GpuSync* gpuSyn
 
     clock::time_point start = *startStopTime;
 
-    tiles->createDDLsInParallel();
+    tiles->createDDLsInParallel(FLAGS_ddlRetain);
 
     if (!FLAGS_ddlRecordTime) {
         tiles->drawAllTilesAndFlush(context, true);
@@ -290,6 +300,168 @@ static void run_gpu_time_benchmark(sk_gpu_test::GpuTimer* gpuTimer,
     gpuTimer->deleteQuery(previousTime);
 }
 
+/**
+ * Attributes the time of a few frames to the phases of their flushes, to their opLists and to the
+ * classes of their ops. The CPU time of an op is the time to encode it. If the context can time
+ * the GPU, each op also gets a timer query, which only measures the op's GPU work on backends that
+ * issue it as it is encoded (GL). These frames are separate from the benchmark's samples, since all
+ * the timing slows them down.
+ */
+class FlushBreakdown : public GrFlushTimer {
+public:
+    using clock = std::chrono::steady_clock;
+
+    FlushBreakdown(sk_gpu_test::GpuTimer* gpuTimer) : fGpuTimer(gpuTimer) {}
+
+    void run(GrContext* context, const sk_gpu_test::FenceSync* fenceSync, SkCanvas* canvas,
+             const SkPicture* skp) {
+        context->contextPriv().setFlushTimer(this);
+        for (int i = 0; i < kNumBreakdownFrames; ++i) {
+            fOpListIndex = -1;
+            fLastOpListID = SK_InvalidUniqueID;
+            clock::time_point start = clock::now();
+            canvas->drawPicture(skp);
+            clock::time_point recorded = clock::now();
+            canvas->flush();
+            fRecordTime += recorded - start;
+            fFlushTime += clock::now() - recorded;
+            // Wait for this frame's GPU work so its timer queries are ready.
+            GpuSync(fenceSync).syncToPreviousFrame();
+            this->resolveQueries();
+        }
+        context->contextPriv().setFlushTimer(nullptr);
+    }
+
+    void writeJSON(SkWStream* stream, const char* config, const char* bench) const {
+        SkJSONWriter writer(stream, SkJSONWriter::Mode::kPretty);
+        writer.beginObject();
+        writer.appendString("config", config);
+        writer.appendString("bench", bench);
+        writer.appendS32("frames", kNumBreakdownFrames);
+        writer.appendBool("gpu_timing", SkToBool(fGpuTimer));
+
+        // All times are in ms per frame.
+        writer.beginObject("cpu_ms");
+        writer.appendDouble("record", PerFrameMs(fRecordTime));
+        writer.appendDouble("flush", PerFrameMs(fFlushTime));
+        writer.appendDouble("prepare", PerFrameMs(fPhaseTimes[(int)Phase::kPrepare]));
+        writer.appendDouble("execute", PerFrameMs(fPhaseTimes[(int)Phase::kExecute]));
+        writer.appendDouble("submit", PerFrameMs(fPhaseTimes[(int)Phase::kSubmit]));
+        writer.endObject();
+
+        writer.beginObject("ops");
+        for (const auto& op : fOps) {
+            writer.beginObject(op.first.c_str());
+            op.second.write(&writer);
+            writer.endObject();
+        }
+        writer.endObject();
+
+        // The opLists in the order they executed, assuming every frame has the same ones.
+        writer.beginArray("opLists");
+        for (const Stats& opList : fOpLists) {
+            writer.beginObject();
+            opList.write(&writer);
+            writer.endObject();
+        }
+        writer.endArray();
+
+        writer.endObject();
+    }
+
+private:
+    struct Stats {
+        void write(SkJSONWriter* writer) const {
+            writer->appendDouble("count", (double)fCount / kNumBreakdownFrames);
+            writer->appendDouble("cpu_ms", PerFrameMs(fCpuTime));
+            if (fGpuTimes) {
+                // Scale up for the queries that were discarded.
+                writer->appendDouble("gpu_ms", PerFrameMs(fGpuTime) * fCount / fGpuTimes);
+            }
+        }
+
+        int              fCount = 0;
+        int              fGpuTimes = 0;
+        clock::duration  fCpuTime = clock::duration::zero();
+        std::chrono::nanoseconds fGpuTime = std::chrono::nanoseconds::zero();
+    };
+
+    struct PendingOp {
+        Stats*                          fOpStats;
+        Stats*                          fOpListStats;
+        sk_gpu_test::PlatformTimerQuery fQuery;
+    };
+
+    static double PerFrameMs(std::chrono::nanoseconds time) {
+        return std::chrono::duration<double, std::milli>(time).count() / kNumBreakdownFrames;
+    }
+
+    void beginPhase(Phase) override { fPhaseStart = clock::now(); }
+
+    void endPhase(Phase phase) override {
+        fPhaseTimes[(int)phase] += clock::now() - fPhaseStart;
+    }
+
+    void beginOp(const GrOp&, uint32_t opListID) override {
+        if (opListID != fLastOpListID) {
+            fLastOpListID = opListID;
+            if (++fOpListIndex == (int)fOpLists.size()) {
+                fOpLists.emplace_back();
+            }
+        }
+        if (fGpuTimer) {
+            fGpuTimer->queueStart();
+        }
+        fOpStart = clock::now();
+    }
+
+    void endOp(const GrOp& head, uint32_t) override {
+        clock::duration cpuTime = clock::now() - fOpStart;
+        Stats* opStats = &fOps[head.name()];
+        Stats* opListStats = &fOpLists[fOpListIndex];
+        for (Stats* stats : {opStats, opListStats}) {
+            ++stats->fCount;
+            stats->fCpuTime += cpuTime;
+        }
+        if (fGpuTimer) {
+            fPendingOps.push_back({opStats, opListStats, fGpuTimer->queueStop()});
+        }
+    }
+
+    void resolveQueries() {
+        for (const PendingOp& op : fPendingOps) {
+            if (sk_gpu_test::GpuTimer::QueryStatus::kAccurate ==
+                fGpuTimer->checkQueryStatus(op.fQuery)) {
+                std::chrono::nanoseconds gpuTime = fGpuTimer->getTimeElapsed(op.fQuery);
+                for (Stats* stats : {op.fOpStats, op.fOpListStats}) {
+                    ++stats->fGpuTimes;
+                    stats->fGpuTime += gpuTime;
+                }
+            }
+            fGpuTimer->deleteQuery(op.fQuery);
+        }
+        fPendingOps.clear();
+    }
+
+    sk_gpu_test::GpuTimer* const  fGpuTimer;
+
+    clock::duration               fRecordTime = clock::duration::zero();
+    clock::duration               fFlushTime = clock::duration::zero();
+    clock::duration               fPhaseTimes[3] = {clock::duration::zero(),
+                                                    clock::duration::zero(),
+                                                    clock::duration::zero()};
+    clock::time_point             fPhaseStart;
+    clock::time_point             fOpStart;
+
+    // The ops and opLists are keyed by node-stable containers, so PendingOp can point into them.
+    std::map<std::string, Stats>  fOps;
+    std::deque<Stats>             fOpLists;
+    std::vector<PendingOp>        fPendingOps;
+
+    int                           fOpListIndex = -1;
+    uint32_t                      fLastOpListID = SK_InvalidUniqueID;
+};
+
 void print_result(const std::vector<Sample>& samples, const char* config, const char* bench)  {
     if (0 == (samples.size() % 2)) {
         exitf(ExitErr::kSoftware, "attempted to gather stats on even number of samples");
@@ -462,6 +634,24 @@ int main(int argc, char** argv) {
     }
     print_result(samples, config->getTag().c_str(), srcname.c_str());
 
+    // Break the time down (if requested).
+    if (!FLAGS_breakdown.isEmpty()) {
+        if (FLAGS_ddl) {
+            exitf(ExitErr::kUnavailable, "DDL: flush breakdown not supported");
+        }
+        FlushBreakdown breakdown(testCtx->gpuTimingSupport() ? testCtx->gpuTimer() : nullptr);
+        breakdown.run(ctx, testCtx->fenceSync(), canvas, skp.get());
+        if (!mkdir_p(SkOSPath::Dirname(FLAGS_breakdown[0]))) {
+            exitf(ExitErr::kIO, "failed to create directory for breakdown \"%s\"",
+                  FLAGS_breakdown[0]);
+        }
+        SkFILEWStream stream(FLAGS_breakdown[0]);
+        if (!stream.isValid()) {
+            exitf(ExitErr::kIO, "failed to open breakdown file \"%s\"", FLAGS_breakdown[0]);
+        }
+        breakdown.writeJSON(&stream, config->getTag().c_str(), srcname.c_str());
+    }
+
     // Save a proof (if one was requested).
     if (!FLAGS_png.isEmpty()) {
         SkBitmap bmp;
@@ -45,6 +45,8 @@ __argparse.add_argument('-x', '--suffix',
   help="suffix to append on config (e.g. '_before', '_after')")
 __argparse.add_argument('-w','--write-path',
   help="directory to save .png proofs to disk.")
+__argparse.add_argument('-b','--breakdown-path',
+  help="directory to save per-phase and per-op time breakdowns (.json) to disk.")
 __argparse.add_argument('-v','--verbosity',
   type=int, default=1, help="level of verbosity (0=none to 5=debug)")
 __argparse.add_argument('-d', '--duration',
@@ -208,6 +210,10 @@ class SKPBench:
       pngfile = _path.join(FLAGS.write_path, self.config,
                            _path.basename(self.src) + '.png')
       commandline.extend(['--png', pngfile])
+    if FLAGS.breakdown_path:
+      jsonfile = _path.join(FLAGS.breakdown_path, self.config,
+                            _path.basename(self.src) + '.json')
+      commandline.extend(['--breakdown', jsonfile])
     dump_commandline_if_verbose(commandline)
     self._proc = subprocess.Popen(commandline, stdout=subprocess.PIPE,
                                   stderr=subprocess.STDOUT)
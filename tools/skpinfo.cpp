@@ -5,8 +5,12 @@
  * found in the LICENSE file.
  */
 
+#include "OverdrawProfiler.h"
+#include "SkBitmap.h"
+#include "SkCanvas.h"
 #include "SkCommandLineFlags.h"
 #include "SkFontDescriptor.h"
+#include "SkJSONWriter.h"
 #include "SkPicture.h"
 #include "SkPictureCommon.h"
 #include "SkPictureData.h"
@@ -19,10 +23,13 @@ DEFINE_bool2(cullRect, c, true, "cullRect");
 DEFINE_bool2(flags, f, true, "flags");
 DEFINE_bool2(tags, t, true, "tags");
 DEFINE_bool2(quiet, q, false, "quiet");
+DEFINE_string(overdraw, "", "If set, replay the skp and write overdraw and cost stats as JSON "
+                            "to this file.");
 
 // This tool can print simple information about an SKP but its main use
 // is just to check if an SKP has been truncated during the recording
-// process.
+// process.  With --overdraw it instead replays the SKP and reports how
+// often each pixel is drawn and what each type of op costs.
 // return codes:
 static const int kSuccess = 0;
 static const int kTruncatedFile = 1;
@@ -31,6 +38,35 @@ static const int kInvalidTag = 3;
 static const int kMissingInput = 4;
 static const int kIOError = 5;
 
+static int write_overdraw(SkStream* stream, const char* path) {
+    sk_sp<SkPicture> picture = SkPicture::MakeFromStream(stream);
+    if (!picture) {
+        return kTruncatedFile;
+    }
+    const SkIRect bounds = picture->cullRect().roundOut();
+    SkBitmap counts;
+    if (!counts.tryAllocPixels(SkImageInfo::MakeA8(bounds.width(), bounds.height()))) {
+        return kIOError;
+    }
+    counts.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas countsCanvas(counts);
+
+    OverdrawProfiler profiler(&countsCanvas);
+    profiler.translate(-bounds.fLeft, -bounds.fTop);
+    picture->playback(&profiler);
+
+    SkFILEWStream out(path);
+    if (!out.isValid()) {
+        return kIOError;
+    }
+    SkJSONWriter writer(&out, SkJSONWriter::Mode::kPretty);
+    writer.beginObject();
+    writer.appendString("skp", FLAGS_input[0]);
+    profiler.writeJSON(&writer);
+    writer.endObject();
+    return kSuccess;
+}
+
 int main(int argc, char** argv) {
     SkCommandLineFlags::SetUsage("Prints information about an skp file");
     SkCommandLineFlags::Parse(argc, argv);
@@ -57,6 +93,13 @@ int main(int argc, char** argv) {
         return kNotAnSKP;
     }
 
+    if (!FLAGS_overdraw.isEmpty()) {
+        if (!stream.rewind()) {
+            return kIOError;
+        }
+        return write_overdraw(&stream, FLAGS_overdraw[0]);
+    }
+
     if (FLAGS_version && !FLAGS_quiet) {
         SkDebugf("Version: %d\n", info.getVersion());
     }
@@ -17,6 +17,9 @@
 
 namespace {
 
+// The thread ID that the GPU's events are filed under. SkGetThreadID() never returns it.
+static constexpr SkThreadID kGpuThreadID = -1;
+
 /**
  * All events have a fixed block of information (TraceEvent), plus variable length payload:
  * {TraceEvent} {TraceEventArgs} {Inline Payload}
@@ -154,6 +157,23 @@ void SkChromeTracingTracer::updateTraceEventDuration(const uint8_t* categoryEnab
     traceEvent->fClockEnd = std::chrono::steady_clock::now().time_since_epoch().count();
 }
 
+void SkChromeTracingTracer::addGpuEvent(const uint8_t* categoryEnabledFlag,
+                                        const char* name,
+                                        uint64_t startedNsAgo,
+                                        uint64_t durationNs) {
+    TraceEvent traceEvent;
+    traceEvent.fPhase = TRACE_EVENT_PHASE_COMPLETE;
+    traceEvent.fNumArgs = 0;
+    traceEvent.fSize = SkAlign8(sizeof(TraceEvent));
+    traceEvent.fName = name;
+    traceEvent.fID = 0;
+    uint64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+    traceEvent.fClockBegin = now - startedNsAgo;
+    traceEvent.fClockEnd = traceEvent.fClockBegin + durationNs;
+    traceEvent.fThreadID = kGpuThreadID;
+    this->appendEvent(&traceEvent, traceEvent.fSize);
+}
+
 static void trace_value_to_json(SkJSONWriter* writer, uint64_t argValue, uint8_t argType,
                                 const char* stringTableBase) {
     skia::tracing_internals::TraceValueUnion value;
@@ -323,6 +343,18 @@ void SkChromeTracingTracer::flush() {
     }
     event_block_to_json(&writer, fCurBlock, &serializationState);
 
+    if (serializationState.fShortThreadIDMap.find(kGpuThreadID)) {
+        writer.beginObject();
+        writer.appendString("ph", "M");
+        writer.appendString("name", "thread_name");
+        writer.appendS64("tid", serializationState.getShortThreadID(kGpuThreadID));
+        writer.appendS32("pid", 0);
+        writer.beginObject("args");
+        writer.appendString("name", "GPU");
+        writer.endObject();
+        writer.endObject();
+    }
+
     writer.endArray();
     writer.flush();
     fileStream.flush();
@@ -38,6 +38,12 @@ public:
                                   const char* name,
                                   SkEventTracer::Handle handle) override;
 
+    // GPU events go on a track of their own, named "GPU".
+    void addGpuEvent(const uint8_t* categoryEnabledFlag,
+                     const char* name,
+                     uint64_t startedNsAgo,
+                     uint64_t durationNs) override;
+
     const uint8_t* getCategoryGroupEnabled(const char* name) override {
         return fCategories.getCategoryGroupEnabled(name);
     }
@@ -38,6 +38,7 @@
 #include "SvgSlide.h"
 #include "Viewer.h"
 #include "ccpr/GrCoverageCountingPathRenderer.h"
+#include "skc/GrSkcPathRenderer.h"
 
 #include <stdlib.h>
 #include <map>
@@ -202,6 +203,7 @@ Viewer::Viewer(int argc, char** argv, void* platformData)
     gPathRendererNames[GpuPathRenderers::kSmall] = "Small paths (cached sdf or alpha masks)";
     gPathRendererNames[GpuPathRenderers::kCoverageCounting] = "Coverage counting";
     gPathRendererNames[GpuPathRenderers::kTessellating] = "Tessellating";
+    gPathRendererNames[GpuPathRenderers::kSkc] = "Spinel (OpenCL compute)";
     gPathRendererNames[GpuPathRenderers::kNone] = "Software masks";
 
     SkDebugf("Command line arguments: ");
@@ -220,7 +222,7 @@ Viewer::Viewer(int argc, char** argv, void* platformData)
     }
 
     initializeEventTracingForTools();
-    static SkTaskGroup::Enabler kTaskGroupEnabler(FLAGS_threads);
+    static SkTaskGroup::Enabler kTaskGroupEnabler(FLAGS_threads, FLAGS_workStealing);
 
     fBackendType = get_backend_type(FLAGS_backend[0]);
     fWindow = Window::CreateNativeWindow(platformData);
@@ -1597,6 +1599,9 @@ void Viewer::drawImGui() {
                         }
                         prButton(GpuPathRenderers::kSmall);
                         prButton(GpuPathRenderers::kTessellating);
+                        if (GrSkcPathRenderer::IsSupported(*ctx->contextPriv().caps())) {
+                            prButton(GpuPathRenderers::kSkc);
+                        }
                         prButton(GpuPathRenderers::kNone);
                     }
                     ImGui::TreePop();
@@ -2088,6 +2093,9 @@ void Viewer::updateUIState() {
                             gPathRendererNames[GpuPathRenderers::kCoverageCounting].c_str());
                     }
                     writer.appendString(gPathRendererNames[GpuPathRenderers::kSmall].c_str());
+                    if (GrSkcPathRenderer::IsSupported(*caps)) {
+                        writer.appendString(gPathRendererNames[GpuPathRenderers::kSkc].c_str());
+                    }
                 }
                     writer.appendString(
                         gPathRendererNames[GpuPathRenderers::kTessellating].c_str());